@@ -0,0 +1,143 @@
+/**
+ * @file EARS_mpscRingDef.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief EARS Project bounded lock-free multi-producer, single-consumer ring.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @details
+ * Each slot carries a sequence number: it is free for position p while the
+ * sequence equals p, and holds data for p once it equals p + 1. Producers
+ * claim a position with one compare-exchange, fill the slot, then publish
+ * it; the consumer frees it for the producer one lap ahead (p + SIZE).
+ * Nothing blocks and a full ring refuses the claim, so producers may be any
+ * task or ISR. Only one task may consume.
+ *
+ *   T *item = ring.claim();      // nullptr: full, count the drop
+ *   item->... = ...;
+ *   ring.publish(item);
+ *
+ *   while ((item = ring.peek()) != nullptr) { use(*item); ring.pop(); }
+ *
+ * claim() and publish() are always inlined, so they run from IRAM when the
+ * caller is EARS_HOT or IRAM_ATTR. T must be standard-layout.
+ */
+#pragma once
+#ifndef __EARS_MPSC_RING_DEF_H__
+#define __EARS_MPSC_RING_DEF_H__
+
+#include <stdint.h>
+#include <atomic>
+#include <type_traits>
+
+template <typename T, uint32_t SIZE>
+class EARS_mpscRing
+{
+    static_assert(SIZE > 0 && (SIZE & (SIZE - 1)) == 0, "EARS_mpscRing SIZE must be a power of two");
+
+public:
+    EARS_mpscRing() { reset(); }
+
+    /**
+     * @brief Empty the ring and number every slot for its first lap
+     * @details Only while no producer or consumer can run.
+     */
+    void reset()
+    {
+        for (uint32_t i = 0; i < SIZE; i++)
+        {
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        _enqueuePos.store(0, std::memory_order_relaxed);
+        _dequeuePos = 0;
+    }
+
+    /**
+     * @brief Claim the next free slot (any task or ISR, never blocks)
+     * @return T* Slot to fill and publish(), or nullptr if the ring is full
+     */
+    inline __attribute__((always_inline)) T *claim()
+    {
+        uint32_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot &slot = _slots[pos & (SIZE - 1)];
+            int32_t diff = (int32_t)(slot.sequence.load(std::memory_order_acquire) - pos);
+
+            if (diff == 0)
+            {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    return &slot.item;
+                }
+            }
+            else if (diff < 0)
+            {
+                // The consumer has not freed this slot yet
+                return nullptr;
+            }
+            else
+            {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Hand a filled slot to the consumer
+     * @param item Slot from claim(); needs no ring, so any core may publish it
+     */
+    static inline __attribute__((always_inline)) void publish(T *item)
+    {
+        static_assert(std::is_standard_layout<Slot>::value, "EARS_mpscRing item must be standard-layout");
+
+        // A claimed slot still holds the position it was claimed for
+        Slot *slot = reinterpret_cast<Slot *>(item);
+        slot->sequence.store(slot->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Oldest published slot (consumer only)
+     * @return T* Slot to read before pop(), or nullptr if empty or still being written
+     */
+    T *peek()
+    {
+        Slot &slot = _slots[_dequeuePos & (SIZE - 1)];
+        if ((int32_t)(slot.sequence.load(std::memory_order_acquire) - (_dequeuePos + 1)) < 0)
+        {
+            return nullptr;
+        }
+        return &slot.item;
+    }
+
+    /**
+     * @brief Free the slot from peek() for the producer one lap ahead (consumer only)
+     */
+    void pop()
+    {
+        _slots[_dequeuePos & (SIZE - 1)].sequence.store(_dequeuePos + SIZE, std::memory_order_release);
+        _dequeuePos++;
+    }
+
+    /**
+     * @brief Claimed and not yet popped
+     * @return uint32_t Depth (exact on the consumer, approximate elsewhere)
+     */
+    uint32_t pending() const
+    {
+        return _enqueuePos.load(std::memory_order_relaxed) - _dequeuePos;
+    }
+
+private:
+    struct Slot
+    {
+        T item; // First, so publish() can step back from it
+        std::atomic<uint32_t> sequence;
+    };
+
+    Slot _slots[SIZE];
+    std::atomic<uint32_t> _enqueuePos;
+    uint32_t _dequeuePos; // Consumer only
+};
+
+#endif // __EARS_MPSC_RING_DEF_H__
@@ -0,0 +1,40 @@
+/**
+ * @file EARS_placementDef.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief EARS Project memory placement of hot-path code and data.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @details
+ * Code and constant data normally run from flash through the cache. After
+ * an SD, NVS or OTA flash operation the cache is refilled on demand, so
+ * the first frames afterwards pay for misses in the flush and touch paths.
+ *
+ * EARS_HOT puts a function in IRAM and EARS_HOT_DATA puts a table in DRAM.
+ * Use them on the display flush path, the touch reader, the ring-buffer
+ * primitives and the tables they read; LVGL's draw routines follow the
+ * same switch through LV_ATTRIBUTE_FAST_MEM in lv_conf.h.
+ *
+ * Build with -D EARS_HOT_IRAM=0 to leave everything in flash. The IRAM
+ * budget is reported after each link by scripts/iram_report.py.
+ *
+ * C-compatible: included from lv_conf.h.
+ */
+#pragma once
+#ifndef __EARS_PLACEMENT_DEF_H__
+#define __EARS_PLACEMENT_DEF_H__
+
+#if !defined(EARS_HOT_IRAM)
+#define EARS_HOT_IRAM 1
+#endif
+
+#if EARS_HOT_IRAM == 1 && defined(ESP_PLATFORM)
+#include <esp_attr.h>
+#define EARS_HOT IRAM_ATTR
+#define EARS_HOT_DATA DRAM_ATTR
+#else
+#define EARS_HOT
+#define EARS_HOT_DATA
+#endif
+
+#endif // __EARS_PLACEMENT_DEF_H__
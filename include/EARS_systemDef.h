@@ -2,12 +2,14 @@
  * @file EARS_systemDef.h
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief EARS Project System Header File.
- * @version 0.2.0
- * @date 20260130
+ * @version 0.3.0
+ * @date 20261014
  *
  * @details
  * System-wide definitions. Updated to use constexpr for type safety
  * while maintaining backward compatibility with existing code.
+ * Debug output is deferred through EARS_traceLib unless built with
+ * -D EARS_DEFERRED_TRACE=0.
  */
 #pragma once
 #ifndef __EARS_SYSTEM_DEF_H__
@@ -35,7 +37,25 @@ namespace EARS_Internal
  **********************************************************************/
 #define EARS_DEBUG_BAUD_RATE 115200
 
-#if EARS_DEBUG == 1
+// Record debug output in per-core rings and print it from a low-priority
+// task, so prints in hot paths do not block on USB CDC
+#if !defined(EARS_DEFERRED_TRACE)
+#define EARS_DEFERRED_TRACE 1
+#endif
+
+#if EARS_DEBUG == 1 && EARS_DEFERRED_TRACE == 1 && defined(__cplusplus)
+#include "EARS_traceLib.h"
+#define DEBUG_PRINT(x) using_trace().print(x)
+#define DEBUG_PRINTLN(x) using_trace().println(x)
+// The dead Serial.printf keeps compile-time format checking
+#define DEBUG_PRINTF(...)                   \
+    do                                      \
+    {                                       \
+        if (false)                          \
+            Serial.printf(__VA_ARGS__);     \
+        using_trace().printf(__VA_ARGS__);  \
+    } while (0)
+#elif EARS_DEBUG == 1
 #define DEBUG_PRINT(x) Serial.print(x)
 #define DEBUG_PRINTLN(x) Serial.println(x)
 #define DEBUG_PRINTF(...) Serial.printf(__VA_ARGS__)
@@ -58,6 +78,8 @@ namespace EARS_Internal
         constexpr const char *PASSWORD_HASH_STR = "EARS_PW";
         constexpr const char *BACKLIGHT_VALUE_STR = "EARS_BL";
         constexpr const char *CRC32_STR = "EARS_32";
+        constexpr const char *SD_SECRET_STR = "EARS_SK";
+        constexpr const char *AUDIT_SECRET_STR = "EARS_AK";
     }
 }
 
@@ -68,5 +90,7 @@ namespace EARS_Internal
 #define EARS_PASSWORD_HASH EARS_Internal::NVS::PASSWORD_HASH_STR
 #define EARS_BACKLIGHT_VALUE EARS_Internal::NVS::BACKLIGHT_VALUE_STR
 #define EARS_CRC32 EARS_Internal::NVS::CRC32_STR
+#define EARS_SD_SECRET EARS_Internal::NVS::SD_SECRET_STR
+#define EARS_AUDIT_SECRET EARS_Internal::NVS::AUDIT_SECRET_STR
 
 #endif // __EARS_SYSTEM_DEF_H__
\ No newline at end of file
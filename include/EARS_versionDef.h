@@ -2,12 +2,18 @@
  * @file EARS_versionDef.h
  * @author Julian (51fiftyone51fiftyone_at_gmail.com)
  * @brief Version encoding/decoding macros for EARS Project
- * @version 0.7.0
- * @date 20260122
+ * @version 0.8.0
+ * @date 20261015
  *
  * Converts version string components into a single integer for easy comparison
  * Format: MMMMMMPPPPPPBBBBBB (Major.Minor.Patch as 9 digits)
  * Example: 4.0.67 becomes 004000067
+ *
+ * Components are parsed by constexpr functions, so VERS_ENCODE is a
+ * compile-time constant wherever its arguments are (the VERSION_* constants
+ * and string literals always are). scripts/increment_build.py also writes
+ * every library's version to EARS_libVersionsDef.h for the boot report;
+ * that header is generated before each build and not kept in git.
  */
 #pragma once
 #ifndef __EARS_VERSION_DEF_H__
@@ -21,28 +27,59 @@
 
 #define EARS_APP_BUILD_TIMESTAMP 20260214124818
 
+/**
+ * @brief Decimal version component to integer, evaluated by the compiler
+ * @param s Component string (e.g., "46"); stops at the first non-digit
+ * @param value Accumulator (leave at 0)
+ * @return Component value (e.g., 46)
+ */
+constexpr uint32_t vers_atoi(const char *s, uint32_t value = 0)
+{
+    return (*s >= '0' && *s <= '9') ? vers_atoi(s + 1, value * 10 + (uint32_t)(*s - '0')) : value;
+}
+
+/**
+ * @brief Encode version components into single integer, evaluated by the compiler
+ */
+constexpr uint32_t vers_encode(const char *maj, const char *min, const char *pat)
+{
+    return vers_atoi(maj) * 1000000UL + vers_atoi(min) * 1000UL + vers_atoi(pat);
+}
+
+/**
+ * @brief Holds a value computed at compile time
+ * @details A template argument must be a constant expression, so anything
+ *          passed through here is folded by the compiler or fails to build.
+ */
+template <uint32_t V>
+struct EARS_versionConst
+{
+    static constexpr uint32_t value = V;
+};
+
 /**
  * @brief Convert string to integer at compile time
  * Helper macro for VERS_ENCODE
  */
-#define VERS_ATOI_HELPER(x) ((x[0] >= '0' && x[0] <= '9') ? ((x[0] - '0') * 100 +                                   \
-                                                             (x[1] >= '0' && x[1] <= '9' ? (x[1] - '0') * 10 : 0) + \
-                                                             (x[2] >= '0' && x[2] <= '9' ? (x[2] - '0') : 0))       \
-                                                          : 0)
+#define VERS_ATOI_HELPER(x) (vers_atoi(x))
 
 /**
  * @brief Encode version components into single integer
  * @param maj Major version string (e.g., "4")
  * @param min Minor version string (e.g., "0")
  * @param pat Patch version string (e.g., "67")
- * @return Integer version code (e.g., 4000067)
+ * @return Integer version code (e.g., 4000067), a compile-time constant
  *
  * Usage: uint32_t version = VERS_ENCODE(EARS_APP_VERSION_MAJOR, EARS_APP_VERSION_MINOR, EARS_APP_VERSION_PATCH);
  */
-#define VERS_ENCODE(maj, min, pat)                  \
-    ((uint32_t)(VERS_ATOI_HELPER(maj) * 1000000UL + \
-                VERS_ATOI_HELPER(min) * 1000UL +    \
-                VERS_ATOI_HELPER(pat)))
+#define VERS_ENCODE(maj, min, pat) (EARS_versionConst<vers_encode(maj, min, pat)>::value)
+
+/**
+ * @brief Application version as an encoded integer
+ */
+#define EARS_APP_VERSION_ENCODED VERS_ENCODE(EARS_APP_VERSION_MAJOR, EARS_APP_VERSION_MINOR, EARS_APP_VERSION_PATCH)
+
+static_assert(vers_encode("4", "0", "67") == 4000067UL, "VERS_ENCODE format");
 
 /**
  * @brief Extract major version from encoded integer
@@ -3,13 +3,15 @@
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief Defines pin assignments for the Waveshare 3.5" ESP32-S3 LCD display.
  * @details Pin definitions verified from Waveshare wiki schematic and I2C scanner
- * @version 0.3
- * @date 20260207
+ * @version 0.5
+ * @date 20261015
  *
  * CHANGE LOG:
  * v0.3 - CORRECTED Touch I2C pins from scanner results:
  *        Was: SDA=38, SCL=39 (INCORRECT)
  *        Now: SDA=8, SCL=7 (VERIFIED via I2C scanner)
+ * v0.4 - Barcode scanner UART on the UART0 header pins (Serial is USB CDC)
+ * v0.5 - LCD_TE for the ST7796 tearing-effect output (not routed, -1)
  */
 #pragma once
 #ifndef __EARS_WS35TLCD_PINS_H_
@@ -25,6 +27,7 @@
 #define LCD_CS -1  // Chip Select (not used)
 #define LCD_DC 3   // Data/Command
 #define LCD_RST -1 // Reset (not used)
+#define LCD_TE -1  // Tearing effect output (not routed on this board, a GPIO here enables TE pacing)
 
 // SD Card Pins (SD_MMC - SDIO 1-bit mode)
 // CORRECT pins verified from Waveshare schematic
@@ -40,6 +43,10 @@
 #define TOUCH_INT 18 // Touch interrupt pin
 #define TOUCH_RST -1 // Touch reset (controlled via TCA9554 GPIO expander)
 
+// Barcode Scanner (UART1, TTL level, on the UART0 header pins)
+#define SCANNER_UART_RX 44 // From the scanner's TX
+#define SCANNER_UART_TX 43 // To the scanner's RX (configuration commands)
+
 // Display Specifications
 #define TFT_WIDTH 480
 #define TFT_HEIGHT 320
@@ -11,16 +11,74 @@
 #define LV_COLOR_DEPTH 16
 #define LV_COLOR_16_SWAP 0
 
-/* Memory settings - BASELINE: Use regular malloc */
-#define LV_MEM_CUSTOM 0
+/* Memory settings (-D EARS_LVGL_HEAP_CAPS=0 for the builtin pool):
+ * lv_malloc() on the capability heaps, small blocks internal and large
+ * ones in PSRAM, each spilling to the other (MAIN_lvglMemLib) */
+#ifndef EARS_LVGL_HEAP_CAPS
+#define EARS_LVGL_HEAP_CAPS 1
+#endif
+
+#if EARS_LVGL_HEAP_CAPS == 1
+#define LV_USE_STDLIB_MALLOC LV_STDLIB_CUSTOM
+#else
+#define LV_USE_STDLIB_MALLOC LV_STDLIB_BUILTIN
 #define LV_MEM_SIZE (48 * 1024U)
+#endif
+
+/* Layers (opacity, transforms, blend modes) are rendered in slices of
+ * LV_DRAW_LAYER_SIMPLE_BUF_SIZE. With -D EARS_LVGL_LAYER_PSRAM=1 the layer
+ * buffers come from PSRAM (MAIN_lvglMemLib) and a slice is sized from the
+ * screen: a full-screen RGB565 layer in one slice, ARGB8888 in two. The cap
+ * lets both draw units hold a layer and a nested one; the memory plan's
+ * layers pool budgets the same (MEM_PLAN_LAYERS). */
+#include "EARS_ws35tlcdPins.h"
+#ifndef EARS_LVGL_LAYER_PSRAM
+#define EARS_LVGL_LAYER_PSRAM 1
+#endif
+
+#if EARS_LVGL_LAYER_PSRAM == 1
+#define LV_DRAW_LAYER_SIMPLE_BUF_SIZE (TFT_WIDTH * TFT_HEIGHT * 2)
+#define LV_DRAW_LAYER_MAX_MEMORY (4 * LV_DRAW_LAYER_SIMPLE_BUF_SIZE)
+#endif
 
 /* Display settings */
 #define LV_DPI_DEF 130
 
-/* Feature usage */
+/* Feature usage (both need LV_USE_SYSMON; the memory overlay would draw
+ * over the benchmark scenes) */
 #define LV_USE_PERF_MONITOR 1
-#define LV_USE_MEM_MONITOR 1
+#define LV_USE_MEM_MONITOR 0
+
+/* LVGL benchmark build (-D EARS_LVGL_BENCHMARK=1): lv_demo_benchmark, its
+ * widgets scene and the system monitor that measures every scene. Needs the
+ * built-in Montserrat 14, 20, 24 and 26 (not the glyph subsets). */
+#ifndef EARS_LVGL_BENCHMARK
+#define EARS_LVGL_BENCHMARK 0
+#endif
+
+#if EARS_LVGL_BENCHMARK == 1
+#define LV_USE_SYSMON 1
+#define LV_USE_DEMO_BENCHMARK 1
+#define LV_USE_DEMO_WIDGETS 1
+#endif
+
+/* Multi-threaded rendering (-D EARS_LVGL_OS=1): LVGL's FreeRTOS OSAL and two
+ * software draw units, one per core (MAIN_lvglLib pins the draw threads).
+ * Draw threads sit below the flush task so SPI transfers start on time;
+ * semaphores, not task notifications, so the UI task's wake-ups stay its own. */
+#ifndef EARS_LVGL_OS
+#define EARS_LVGL_OS 0
+#endif
+
+#if EARS_LVGL_OS == 1
+#define LV_USE_OS LV_OS_FREERTOS
+#define LV_USE_FREERTOS_TASK_NOTIFY 0
+#define LV_DRAW_SW_DRAW_UNIT_CNT 2
+#define LV_DRAW_THREAD_STACK_SIZE (8 * 1024)
+#define LV_DRAW_THREAD_PRIO LV_THREAD_PRIO_MID
+#else
+#define LV_USE_OS LV_OS_NONE
+#endif
 
 /* CRITICAL: Float support */
 #define LV_USE_FLOAT 1
@@ -28,41 +86,107 @@
 /* CRITICAL: Matrix support */
 #define LV_USE_MATRIX 1
 
-/* CRITICAL: Disable ARM-specific optimizations */
+/* Draw SW blend kernels: no ARM NEON/Helium on the ESP32-S3. With
+ * -D EARS_DRAW_SW_ASM=1 the RGB565 fills and image copies go through
+ * MAIN_drawSwAsmLib (PIE stores on the S3); measure with lvgl_benchmark. */
+#ifndef EARS_DRAW_SW_ASM
+#define EARS_DRAW_SW_ASM 0
+#endif
+
+#if EARS_DRAW_SW_ASM == 1
+#define LV_USE_DRAW_SW_ASM LV_DRAW_SW_ASM_CUSTOM
+#define LV_DRAW_SW_ASM_CUSTOM_INCLUDE "MAIN_drawSwAsmLib.h"
+#else
 #define LV_USE_DRAW_SW_ASM LV_DRAW_SW_ASM_NONE
+#endif
+
+/* Blend, mask and line inner loops (LVGL's LV_ATTRIBUTE_FAST_MEM functions)
+ * in IRAM, away from cache misses after flash writes. -D EARS_LVGL_IRAM=0
+ * hands the IRAM back to the heap; scripts/iram_report.py shows the cost. */
+#include "EARS_placementDef.h"
+#ifndef EARS_LVGL_IRAM
+#define EARS_LVGL_IRAM EARS_HOT_IRAM
+#endif
+
+#if EARS_LVGL_IRAM == 1
+#define LV_ATTRIBUTE_FAST_MEM EARS_HOT
+#endif
+
+/* Snapshots: screen transitions are drawn from two screen images in PSRAM
+ * (MAIN_transitionLib) instead of both live screens every frame */
+#define LV_USE_SNAPSHOT 1
 
 /* Filesystem support */
-#define LV_USE_FS_STDIO 1
-#define LV_FS_STDIO_LETTER 'S'
-#define LV_FS_STDIO_PATH "/sd"
-#define LV_FS_STDIO_CACHE_SIZE 0
+#define LV_USE_FS_STDIO 0         /* 'S' is MAIN_sdFsLib, on SDMMC_MOUNT_POINT */
+#define LV_USE_FS_MEMFS 1         /* Fonts from the mapped asset partition */
+#define LV_FS_MEMFS_LETTER 'M'
+
+/* Feature-trimmed LVGL (-D EARS_LVGL_TRIM=1, the production build): the
+ * UI's images are LVGL .bin files made on the host (convert_images.py
+ * rasterises SVG sources), so the BMP decoder, SVG parser and vector
+ * graphics are left out and only warnings and errors are logged. LVGL's
+ * PNG and JPEG decoders (LV_USE_LODEPNG, LV_USE_TJPGD) are off in every
+ * build: MAIN_pngDecoderLib streams PNG through the ROM inflater and
+ * MAIN_jpegDecoderLib decodes JPEG with the ROM TJpgDec instead. */
+#ifndef EARS_LVGL_TRIM
+#define EARS_LVGL_TRIM 0
+#endif
+
+#if EARS_LVGL_TRIM == 1
+#define EARS_LVGL_FULL 0
+#else
+#define EARS_LVGL_FULL 1
+#endif
 
 /* Image decoders */
-#define LV_USE_BMP 1
-#define LV_USE_PNG 1
-#define LV_USE_SJPG 1
-
-/* SVG support (works in 9.3.0) */
-#define LV_USE_VECTOR_GRAPHIC 1
-#define LV_USE_SVG 1
-
-/* Fonts */
-#define LV_FONT_MONTSERRAT_8 1
-#define LV_FONT_MONTSERRAT_10 1
-#define LV_FONT_MONTSERRAT_12 1
-#define LV_FONT_MONTSERRAT_14 1
-#define LV_FONT_MONTSERRAT_16 1
+#define LV_BIN_DECODER_RAM_LOAD 1 /* Needed for compressed .bin images */
+#define LV_USE_RLE 1              /* scripts/convert_images.py --compress */
+#define LV_USE_BMP EARS_LVGL_FULL
+
+/* SVG support (works in 9.3.0). ThorVG is the software vector renderer;
+ * MAIN_svgCacheLib runs it once per icon size and blits bitmaps after. */
+#define LV_USE_VECTOR_GRAPHIC EARS_LVGL_FULL
+#define LV_USE_SVG EARS_LVGL_FULL
+#define LV_USE_THORVG_INTERNAL EARS_LVGL_FULL
+
+/* Fonts: full built-in Montserrat, or the glyph subsets written by
+ * scripts/generate_font_subsets.py (build with -D EARS_FONT_SUBSETS=1).
+ * With subsets, 34 and 38 are loaded on demand by MAIN_fontLib. */
+#ifndef EARS_FONT_SUBSETS
+#define EARS_FONT_SUBSETS 0
+#endif
+
+#if EARS_FONT_SUBSETS == 1
+#define EARS_FONT_BUILTIN 0
+#define LV_FONT_CUSTOM_DECLARE                 \
+    LV_FONT_DECLARE(ears_font_montserrat_8)    \
+    LV_FONT_DECLARE(ears_font_montserrat_10)   \
+    LV_FONT_DECLARE(ears_font_montserrat_12)   \
+    LV_FONT_DECLARE(ears_font_montserrat_14)   \
+    LV_FONT_DECLARE(ears_font_montserrat_16)   \
+    LV_FONT_DECLARE(ears_font_montserrat_20)   \
+    LV_FONT_DECLARE(ears_font_montserrat_24)
+#define LV_FONT_DEFAULT &ears_font_montserrat_14
+#else
+#define EARS_FONT_BUILTIN 1
+#endif
+
+#define LV_FONT_MONTSERRAT_8 EARS_FONT_BUILTIN
+#define LV_FONT_MONTSERRAT_10 EARS_FONT_BUILTIN
+#define LV_FONT_MONTSERRAT_12 EARS_FONT_BUILTIN
+#define LV_FONT_MONTSERRAT_14 EARS_FONT_BUILTIN
+#define LV_FONT_MONTSERRAT_16 EARS_FONT_BUILTIN
 #define LV_FONT_MONTSERRAT_18 0
-#define LV_FONT_MONTSERRAT_20 1
+#define LV_FONT_MONTSERRAT_20 EARS_FONT_BUILTIN
 #define LV_FONT_MONTSERRAT_22 0
-#define LV_FONT_MONTSERRAT_24 1
-#define LV_FONT_MONTSERRAT_26 0
+#define LV_FONT_MONTSERRAT_24 EARS_FONT_BUILTIN
+#define LV_FONT_MONTSERRAT_26 EARS_LVGL_BENCHMARK
 #define LV_FONT_MONTSERRAT_28 0
 #define LV_FONT_MONTSERRAT_30 0
 #define LV_FONT_MONTSERRAT_32 0
-#define LV_FONT_MONTSERRAT_34 1
+#define LV_FONT_MONTSERRAT_34 EARS_FONT_BUILTIN
 #define LV_FONT_MONTSERRAT_36 0
-#define LV_FONT_MONTSERRAT_38 1
+#define LV_FONT_MONTSERRAT_38 EARS_FONT_BUILTIN
 #define LV_FONT_MONTSERRAT_40 0
 #define LV_FONT_MONTSERRAT_42 0
 #define LV_FONT_MONTSERRAT_44 0
@@ -71,8 +195,13 @@
 
 /* Logging */
 #define LV_USE_LOG 1
+#if EARS_LVGL_TRIM == 1
+#define LV_LOG_LEVEL LV_LOG_LEVEL_WARN
+#else
 #define LV_LOG_LEVEL LV_LOG_LEVEL_INFO
-#define LV_LOG_PRINTF 1
+#endif
+#define LV_LOG_PRINTF 0         /* Printed by MAIN_lvglLogLib through EARS_logger */
+#define LV_LOG_USE_TIMESTAMP 0  /* EARS_logger stamps each line */
 
 #endif /*LV_CONF_H*/
 
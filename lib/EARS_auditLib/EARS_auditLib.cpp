@@ -0,0 +1,498 @@
+/**
+ * @file EARS_auditLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Tamper-evident audit trail, hash-chained on the SHA peripheral
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EARS_auditLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_timeLib.h"
+#include <esp_heap_caps.h>
+#include <esp_random.h>
+#include <esp_timer.h>
+#include <mbedtls/md.h>
+
+#define AUDIT_CHECKPOINT_MAGIC 0x54445541UL   // "AUDT"
+#define AUDIT_SECRET_BYTES 32
+
+/******************************************************************************
+ * Construction
+ *****************************************************************************/
+EARS_audit::EARS_audit()
+    : _ready(false),
+      _sdCard(nullptr),
+      _store(nullptr),
+      _mutex(nullptr),
+      _count(0),
+      _storeRecords(0),
+      _lastAppendMs(0),
+      _verifyBuffer(nullptr),
+      _stats{}
+{
+    memset(_key, 0, sizeof(_key));
+    memset(_head, 0, sizeof(_head));
+}
+
+/******************************************************************************
+ * Private Helpers
+ *****************************************************************************/
+
+/**
+ * @brief The checkpoint key: a random secret in NVS, created the first time
+ */
+bool EARS_audit::loadKey(EARS_nvsEeprom* nvs)
+{
+    String hex = nvs->getHash(EARS_AUDIT_SECRET, "");
+    if (hex.length() == AUDIT_SECRET_BYTES * 2)
+    {
+        const char* text = hex.c_str();
+        for (size_t i = 0; i < AUDIT_SECRET_BYTES; i++)
+        {
+            char byteHex[3] = {text[i * 2], text[i * 2 + 1], '\0'};
+            _key[i] = (uint8_t)strtoul(byteHex, nullptr, 16);
+        }
+        return true;
+    }
+
+    esp_fill_random(_key, sizeof(_key));
+    char created[AUDIT_SECRET_BYTES * 2 + 1];
+    for (size_t i = 0; i < AUDIT_SECRET_BYTES; i++)
+    {
+        snprintf(created + i * 2, 3, "%02x", _key[i]);
+    }
+    bool ok = nvs->putHash(EARS_AUDIT_SECRET, String(created));
+    memset(created, 0, sizeof(created));
+    DEBUG_PRINTLN(ok ? "[INFO] Audit: checkpoint key created" : "[ERROR] Audit: key not saved");
+    return ok;
+}
+
+/**
+ * @brief Count the entries and take the head from the last one
+ * @details A torn last entry (reset mid-append) is cut off; a new log
+ *          starts with a genesis entry
+ */
+bool EARS_audit::loadHead()
+{
+    uint32_t size = _sdCard->fileExists(AUDIT_LOG_PATH) ? _sdCard->getFileSize(AUDIT_LOG_PATH) : 0;
+    if (size % AUDIT_ENTRY_SIZE != 0)
+    {
+        size -= size % AUDIT_ENTRY_SIZE;
+        if (!_sdCard->truncateFile(AUDIT_LOG_PATH, size))
+        {
+            return false;
+        }
+    }
+    _count = size / AUDIT_ENTRY_SIZE;
+    memset(_head, 0, sizeof(_head));
+
+    if (_count == 0)
+    {
+        EARS_auditEntry genesis;
+        memset(&genesis, 0, sizeof(genesis));
+        genesis.event = AUDIT_EVENT_GENESIS;
+        return appendLocked(genesis);
+    }
+
+    EARS_auditEntry last;
+    if (_sdCard->readDataAt(AUDIT_LOG_PATH, (_count - 1) * AUDIT_ENTRY_SIZE, (uint8_t*)&last,
+                            AUDIT_ENTRY_SIZE) != AUDIT_ENTRY_SIZE)
+    {
+        return false;
+    }
+    memcpy(_head, last.hash, sizeof(_head));
+    return true;
+}
+
+/**
+ * @brief HMAC-SHA256 of a checkpoint's fields before its MAC
+ */
+bool EARS_audit::signCheckpoint(const Checkpoint& cp, uint8_t* mac)
+{
+    const mbedtls_md_info_t* info = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+    return info != nullptr &&
+           mbedtls_md_hmac(info, _key, sizeof(_key), (const unsigned char*)&cp, offsetof(Checkpoint, mac),
+                           mac) == 0;
+}
+
+/**
+ * @brief Read the checkpoint and check its MAC
+ */
+bool EARS_audit::readCheckpoint(Checkpoint& cp)
+{
+    uint8_t mac[AUDIT_HASH_SIZE];
+    return _sdCard->fileExists(AUDIT_CHECKPOINT_PATH) &&
+           _sdCard->readDataAt(AUDIT_CHECKPOINT_PATH, 0, (uint8_t*)&cp, sizeof(cp)) == sizeof(cp) &&
+           cp.magic == AUDIT_CHECKPOINT_MAGIC && signCheckpoint(cp, mac) &&
+           memcmp(mac, cp.mac, sizeof(mac)) == 0;
+}
+
+/**
+ * @brief SHA-256(previous hash || entry up to its hash)
+ */
+bool EARS_audit::hashEntry(const uint8_t* previous, const EARS_auditEntry& entry, uint8_t* hash)
+{
+    uint8_t input[AUDIT_HASH_SIZE + AUDIT_HASHED_SIZE];
+    memcpy(input, previous, AUDIT_HASH_SIZE);
+    memcpy(input + AUDIT_HASH_SIZE, &entry, AUDIT_HASHED_SIZE);
+
+    const mbedtls_md_info_t* info = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+    return info != nullptr && mbedtls_md(info, input, sizeof(input), hash) == 0;
+}
+
+/**
+ * @brief Number, stamp, chain and write an entry; caller holds _mutex
+ */
+bool EARS_audit::appendLocked(EARS_auditEntry& entry)
+{
+    time_t now = using_time().now();
+    entry.index = _count;
+    entry.time = using_time().isValid() ? (uint32_t)now : 0;
+
+    int64_t start = esp_timer_get_time();
+    bool ok = hashEntry(_head, entry, entry.hash);
+    _stats.hashUs += (uint32_t)(esp_timer_get_time() - start);
+
+    if (ok)
+    {
+        ok = _sdCard->appendData(AUDIT_LOG_PATH, (const uint8_t*)&entry, AUDIT_ENTRY_SIZE);
+        _sdCard->flush(AUDIT_LOG_PATH);
+    }
+    if (!ok)
+    {
+        // Keep the log whole entries so the chain still reads
+        _sdCard->truncateFile(AUDIT_LOG_PATH, _count * AUDIT_ENTRY_SIZE);
+        _stats.appendErrors++;
+        return false;
+    }
+
+    memcpy(_head, entry.hash, sizeof(_head));
+    _count++;
+    _stats.entries = _count;
+    _stats.appended++;
+    _lastAppendMs = millis();
+    return true;
+}
+
+/**
+ * @brief Store listener: one entry per committed record, one per import
+ */
+void EARS_audit::onRecord(const EARS_record* record, bool existed, void* ctx)
+{
+    EARS_audit* self = (EARS_audit*)ctx;
+    EARS_auditEntry entry;
+    memset(&entry, 0, sizeof(entry));
+
+    xSemaphoreTake(self->_mutex, portMAX_DELAY);
+    if (record == nullptr)
+    {
+        uint32_t from = self->_storeRecords;
+        uint32_t to = self->_store->getRecordCount();
+        entry.event = AUDIT_EVENT_IMPORT;
+        entry.type = self->_store->getType();
+        entry.length = 8;
+        memcpy(entry.data, &from, 4);
+        memcpy(entry.data + 4, &to, 4);
+        self->_storeRecords = to;
+    }
+    else
+    {
+        bool deleted = (record->header.flags & RECORD_FLAG_DELETED) != 0;
+        entry.event = deleted ? AUDIT_EVENT_DELETE : existed ? AUDIT_EVENT_UPDATE : AUDIT_EVENT_CREATE;
+        entry.type = record->header.type;
+        entry.flags = record->header.flags;
+        entry.subject = record->header.id;
+        entry.length = RECORD_SIZE;
+        memcpy(entry.data, record, RECORD_SIZE);
+        self->_storeRecords++;
+    }
+    self->appendLocked(entry);
+    xSemaphoreGive(self->_mutex);
+}
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+bool EARS_audit::begin(EARS_sdCard* sdCard, EARS_nvsEeprom* nvs)
+{
+    if (_ready)
+    {
+        return true;
+    }
+    if (sdCard == nullptr || nvs == nullptr || !sdCard->isAvailable())
+    {
+        return false;
+    }
+    _sdCard = sdCard;
+
+    if (_mutex == nullptr)
+    {
+        _mutex = xSemaphoreCreateMutex();
+    }
+    if (_verifyBuffer == nullptr)
+    {
+        _verifyBuffer = (EARS_auditEntry*)heap_caps_malloc(AUDIT_VERIFY_ENTRIES * AUDIT_ENTRY_SIZE,
+                                                           MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+    if (_mutex == nullptr || _verifyBuffer == nullptr)
+    {
+        DEBUG_PRINTLN("[ERROR] Audit: no memory");
+        return false;
+    }
+
+    _sdCard->createDirectory(RECORD_STORE_DIR);
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    bool ok = loadKey(nvs) && loadHead();
+    xSemaphoreGive(_mutex);
+    if (!ok)
+    {
+        DEBUG_PRINTLN("[ERROR] Audit: log could not be opened");
+        return false;
+    }
+    _ready = true;
+
+    EARS_auditVerify result;
+    _stats.intact = true;
+    verify(false, result);
+    _stats.checkpointed = result.ok && result.checkpointValid ? result.from : 0;
+
+#if EARS_DEBUG == 1
+    Serial.printf("[AUDIT] %lu entries, %s from %lu (%lu checked, %lu ms)%s%s\n", (unsigned long)_count,
+                  result.ok ? "verified" : "FAILED", (unsigned long)result.from, (unsigned long)result.entries,
+                  (unsigned long)result.elapsedMs, result.checkpointValid ? "" : ", no valid checkpoint",
+                  result.truncated ? ", TRUNCATED" : "");
+#else
+    if (!result.ok)
+    {
+        DEBUG_PRINTLN("[ERROR] Audit: chain verification failed");
+    }
+#endif
+    return true;
+}
+
+void EARS_audit::attach(EARS_recordStore* store)
+{
+    if (!_ready || store == nullptr)
+    {
+        return;
+    }
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    _store = store;
+    _storeRecords = store->getRecordCount();
+    xSemaphoreGive(_mutex);
+    store->setListener(onRecord, this);
+}
+
+bool EARS_audit::append(uint16_t event, uint32_t subject, const void* data, size_t length)
+{
+    if (!_ready || event < AUDIT_EVENT_USER || length > AUDIT_DATA_SIZE)
+    {
+        return false;
+    }
+
+    EARS_auditEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.event = event;
+    entry.subject = subject;
+    entry.length = (uint16_t)length;
+    if (data != nullptr)
+    {
+        memcpy(entry.data, data, length);
+    }
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    bool ok = appendLocked(entry);
+    xSemaphoreGive(_mutex);
+    return ok;
+}
+
+/**
+ * @brief Walk the chain from genesis or from the latest good checkpoint
+ * @details Entries are read AUDIT_VERIFY_ENTRIES at a time outside the
+ *          lock; the log only grows, so appends meanwhile are left for
+ *          the next verification
+ */
+bool EARS_audit::verify(bool fromGenesis, EARS_auditVerify& result)
+{
+    memset(&result, 0, sizeof(result));
+    result.firstBad = UINT32_MAX;
+    if (!_ready)
+    {
+        return false;
+    }
+    uint32_t startMs = millis();
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    uint32_t count = _count;
+    xSemaphoreGive(_mutex);
+
+    Checkpoint cp;
+    result.checkpointValid = readCheckpoint(cp);
+    result.truncated = result.checkpointValid && cp.count > count;
+
+    uint8_t previous[AUDIT_HASH_SIZE];
+    memset(previous, 0, sizeof(previous));
+    uint32_t from = 0;
+    bool linked = true;
+
+    // The entry before the checkpoint must carry the signed head
+    if (result.checkpointValid && !result.truncated && cp.count > 0)
+    {
+        EARS_auditEntry last;
+        linked = _sdCard->readDataAt(AUDIT_LOG_PATH, (cp.count - 1) * AUDIT_ENTRY_SIZE, (uint8_t*)&last,
+                                     AUDIT_ENTRY_SIZE) == AUDIT_ENTRY_SIZE &&
+                 memcmp(last.hash, cp.head, AUDIT_HASH_SIZE) == 0;
+        if (!linked)
+        {
+            result.firstBad = cp.count - 1;
+        }
+        else if (!fromGenesis)
+        {
+            from = cp.count;
+            memcpy(previous, cp.head, sizeof(previous));
+        }
+    }
+    result.from = from;
+
+    for (uint32_t i = from; linked && i < count && result.firstBad == UINT32_MAX;)
+    {
+        uint32_t n = count - i;
+        if (n > AUDIT_VERIFY_ENTRIES)
+            n = AUDIT_VERIFY_ENTRIES;
+        size_t bytes = n * AUDIT_ENTRY_SIZE;
+        if (_sdCard->readDataAt(AUDIT_LOG_PATH, i * AUDIT_ENTRY_SIZE, (uint8_t*)_verifyBuffer, bytes) != bytes)
+        {
+            result.firstBad = i;
+            break;
+        }
+
+        for (uint32_t k = 0; k < n; k++, i++)
+        {
+            const EARS_auditEntry& entry = _verifyBuffer[k];
+            uint8_t hash[AUDIT_HASH_SIZE];
+            if (entry.index != i || !hashEntry(previous, entry, hash) ||
+                memcmp(hash, entry.hash, AUDIT_HASH_SIZE) != 0)
+            {
+                result.firstBad = i;
+                break;
+            }
+            memcpy(previous, hash, sizeof(previous));
+            result.entries++;
+        }
+    }
+
+    result.ok = result.firstBad == UINT32_MAX && !result.truncated;
+    result.elapsedMs = millis() - startMs;
+    if (!result.ok)
+    {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        _stats.intact = false;
+        xSemaphoreGive(_mutex);
+    }
+    return result.ok;
+}
+
+bool EARS_audit::checkpoint()
+{
+    if (!_ready)
+    {
+        return false;
+    }
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    bool ok = _stats.intact;
+    if (ok && _count != _stats.checkpointed)
+    {
+        Checkpoint cp;
+        memset(&cp, 0, sizeof(cp));
+        cp.magic = AUDIT_CHECKPOINT_MAGIC;
+        cp.count = _count;
+        cp.time = using_time().isValid() ? (uint32_t)using_time().now() : 0;
+        memcpy(cp.head, _head, sizeof(cp.head));
+
+        ok = signCheckpoint(cp, cp.mac) &&
+             _sdCard->writeFileAtomic(AUDIT_CHECKPOINT_PATH, (const uint8_t*)&cp, sizeof(cp));
+        if (ok)
+        {
+            _stats.checkpointed = _count;
+            _stats.checkpoints++;
+        }
+    }
+    xSemaphoreGive(_mutex);
+    return ok;
+}
+
+void EARS_audit::service()
+{
+    if (!_ready)
+    {
+        return;
+    }
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    uint32_t pending = _count - _stats.checkpointed;
+    bool quiet = millis() - _lastAppendMs >= AUDIT_CHECKPOINT_DELAY_MS;
+    xSemaphoreGive(_mutex);
+
+    if (_stats.intact && pending > 0 && (pending >= AUDIT_CHECKPOINT_ENTRIES || quiet))
+    {
+        checkpoint();
+    }
+}
+
+/**
+ * @brief Copy the counters
+ */
+EARS_auditStats EARS_audit::getStats() const
+{
+    if (_mutex == nullptr)
+    {
+        return _stats;
+    }
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    EARS_auditStats stats = _stats;
+    xSemaphoreGive(_mutex);
+    return stats;
+}
+
+/******************************************************************************
+ * Version Information
+ *****************************************************************************/
+const char* EARS_audit::getLibraryName()
+{
+    return EARS_Audit::LIB_NAME;
+}
+
+uint32_t EARS_audit::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_Audit::VERSION_MAJOR,
+                       EARS_Audit::VERSION_MINOR,
+                       EARS_Audit::VERSION_PATCH);
+}
+
+const char* EARS_audit::getVersionDate()
+{
+    return EARS_Audit::VERSION_DATE;
+}
+
+void EARS_audit::getVersionString(char* buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+EARS_audit &using_audit()
+{
+    static EARS_audit instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_auditLib.cpp
+ *****************************************************************************/
@@ -0,0 +1,249 @@
+/**
+ * @file EARS_auditLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Tamper-evident audit trail, hash-chained on the SHA peripheral
+ * @details Ammunition accountability needs a record of every change that
+ *          cannot be quietly edited afterwards. Each entry appended to
+ *          AUDIT_LOG_PATH is a fixed EARS_auditEntry whose hash is
+ *
+ *            SHA-256(previous entry's hash || this entry up to its hash)
+ *
+ *          starting from 32 zero bytes, so changing, removing or reordering
+ *          any entry breaks every hash after it. The chain head is kept in
+ *          RAM: an append is one SHA-256 over AUDIT_ENTRY_SIZE + 32 bytes
+ *          (mbedtls, on the SHA peripheral), whatever the log's length.
+ *
+ *          Checkpoints: after AUDIT_CHECKPOINT_ENTRIES entries, or once
+ *          appends have been quiet for AUDIT_CHECKPOINT_DELAY_MS, service()
+ *          writes AUDIT_CHECKPOINT_PATH: entry count, chain head, time, and
+ *          an HMAC-SHA256 over them keyed with a random device secret in
+ *          NVS (EARS_AUDIT_SECRET, created on first use). A factory reset
+ *          clears it; the next verification then starts from genesis.
+ *
+ *          - verify(false) checks the checkpoint's HMAC, that the entry
+ *            before it carries the signed head, and the chain from there
+ *            to the end: the cost is the entries since the last checkpoint,
+ *            however long the unit has been in service. begin() runs it.
+ *          - verify(true) walks the chain from genesis, for an inspection.
+ *          A log shorter than its checkpoint was cut back. Entries after
+ *          the last checkpoint can be rewritten with their hashes by
+ *          someone holding the card; only the signed prefix is fixed.
+ *          Once a verification has failed no further checkpoint is signed,
+ *          so a broken chain is never made to look whole again.
+ *
+ *          attach() follows a record store (the ammunition store) through
+ *          its listener, one entry per committed record with the record
+ *          as written; a putMany() import is one entry for its range of
+ *          the store's journal. append() adds any other event.
+ *
+ *          Build with -D EARS_AUDIT=0 to leave the trail out.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_AUDIT_LIB_H__
+#define __EARS_AUDIT_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "EARS_versionDef.h"
+#include "EARS_sdCardLib.h"
+#include "EARS_nvsEepromLib.h"
+#include "EARS_recordStoreLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_Audit
+{
+    constexpr const char* LIB_NAME = "EARS_audit";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+
+// 1 = ammunition changes written to the audit trail
+#ifndef EARS_AUDIT
+#define EARS_AUDIT 1
+#endif
+
+#define AUDIT_LOG_PATH RECORD_STORE_DIR "/audit.log"
+#define AUDIT_CHECKPOINT_PATH RECORD_STORE_DIR "/audit.chk"
+#define AUDIT_HASH_SIZE 32
+#define AUDIT_DATA_SIZE RECORD_SIZE           // A whole record fits
+#define AUDIT_CHECKPOINT_ENTRIES 256          // Entries between checkpoints under a steady stream
+#define AUDIT_CHECKPOINT_DELAY_MS 10000       // Or this quiet time after the last append
+#define AUDIT_VERIFY_ENTRIES 32               // Entries per read while verifying
+#define AUDIT_SERVICE_PERIOD_MS 1000          // Suggested job period
+
+// EARS_auditEntry.event
+#define AUDIT_EVENT_GENESIS 0                 // First entry of a new log
+#define AUDIT_EVENT_CREATE 1                  // Record for a new ID
+#define AUDIT_EVENT_UPDATE 2                  // New version of a live ID
+#define AUDIT_EVENT_DELETE 3                  // Tombstone
+#define AUDIT_EVENT_IMPORT 4                  // putMany(): journal records [data 0..3, data 4..7)
+#define AUDIT_EVENT_USER 16                   // First event number for append()
+
+/**
+ * @brief One audit entry as stored
+ */
+struct __attribute__((packed)) EARS_auditEntry
+{
+    uint32_t index;                  // Position in the log (0 = genesis)
+    uint32_t time;                   // Unix time, 0 if the clock was not set
+    uint16_t event;                  // AUDIT_EVENT_*
+    uint8_t type;                    // EARS_recordType, 0 for none
+    uint8_t flags;                   // RECORD_FLAG_* of the record
+    uint32_t subject;                // Item ID, 0 for none
+    uint16_t length;                 // Bytes of data used
+    uint8_t reserved[2];
+    uint8_t data[AUDIT_DATA_SIZE];   // The record as written, or event data
+    uint8_t hash[AUDIT_HASH_SIZE];   // SHA-256(previous hash || the fields above)
+};
+
+#define AUDIT_ENTRY_SIZE sizeof(EARS_auditEntry)
+#define AUDIT_HASHED_SIZE (AUDIT_ENTRY_SIZE - AUDIT_HASH_SIZE)
+
+/**
+ * @brief Outcome of verify()
+ */
+struct EARS_auditVerify
+{
+    bool ok;                         // Chain and checkpoint intact
+    bool checkpointValid;            // Checkpoint present with a good HMAC
+    uint32_t from;                   // First entry checked
+    uint32_t entries;                // Entries checked
+    uint32_t firstBad;               // Entry whose hash failed, or UINT32_MAX
+    bool truncated;                  // Fewer entries than the checkpoint counts
+    uint32_t elapsedMs;
+};
+
+/**
+ * @brief Audit counters
+ */
+struct EARS_auditStats
+{
+    uint32_t entries;                // In the log
+    uint32_t appended;               // Since boot
+    uint32_t appendErrors;
+    uint32_t checkpoints;            // Written since boot
+    uint32_t checkpointed;           // Entries covered by the latest checkpoint
+    uint32_t hashUs;                 // Time hashing appends
+    bool intact;                     // No verification has failed since boot
+};
+
+/******************************************************************************
+ * EARS_audit Class
+ *****************************************************************************/
+class EARS_audit
+{
+public:
+    EARS_audit();
+
+    // Version information getters
+    static const char* getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char* getVersionDate();
+    static void getVersionString(char* buffer);
+
+    /**
+     * @brief Load the key and the chain head, and verify from the checkpoint
+     * @param sdCard Mounted SD card
+     * @param nvs Initialised NVS
+     * @return true if ready (a failed verification is logged, not fatal)
+     */
+    bool begin(EARS_sdCard* sdCard, EARS_nvsEeprom* nvs);
+
+    bool isReady() const { return _ready; }
+
+    /**
+     * @brief Audit every record committed to a store
+     * @details Takes the store's listener
+     */
+    void attach(EARS_recordStore* store);
+
+    /**
+     * @brief Append an event
+     * @param event AUDIT_EVENT_USER or above
+     * @param subject Item ID or 0
+     * @param data Event data, NULL for none
+     * @param length Bytes of data, up to AUDIT_DATA_SIZE
+     * @return true if written
+     */
+    bool append(uint16_t event, uint32_t subject, const void* data, size_t length);
+
+    /**
+     * @brief Check the chain
+     * @param fromGenesis true: every entry; false: from the latest checkpoint
+     * @param result Receives the outcome
+     * @return result.ok
+     */
+    bool verify(bool fromGenesis, EARS_auditVerify& result);
+
+    /**
+     * @brief Write a checkpoint when due
+     * @details Call periodically from Core 1 (AUDIT_SERVICE_PERIOD_MS)
+     */
+    void service();
+
+    /**
+     * @brief Write a checkpoint now
+     * @return true if nothing was new or the write succeeded
+     */
+    bool checkpoint();
+
+    EARS_auditStats getStats() const;
+
+private:
+    struct __attribute__((packed)) Checkpoint
+    {
+        uint32_t magic;
+        uint32_t count;              // Entries covered
+        uint32_t time;
+        uint8_t head[AUDIT_HASH_SIZE];   // Hash of entry count - 1
+        uint8_t mac[AUDIT_HASH_SIZE];    // HMAC over the fields above
+    };
+
+    bool _ready;
+    EARS_sdCard* _sdCard;
+    EARS_recordStore* _store;
+    SemaphoreHandle_t _mutex;        // Guards the chain, the log and _stats
+    uint8_t _key[AUDIT_HASH_SIZE];   // Checkpoint HMAC key
+    uint8_t _head[AUDIT_HASH_SIZE];  // Hash of the last entry
+    uint32_t _count;                 // Entries in the log
+    uint32_t _storeRecords;          // Store journal length at the last entry
+    uint32_t _lastAppendMs;
+    EARS_auditEntry* _verifyBuffer;  // AUDIT_VERIFY_ENTRIES, PSRAM
+
+    EARS_auditStats _stats;
+
+    bool loadKey(EARS_nvsEeprom* nvs);
+    bool loadHead();
+    bool readCheckpoint(Checkpoint& cp);
+    bool signCheckpoint(const Checkpoint& cp, uint8_t* mac);
+    static bool hashEntry(const uint8_t* previous, const EARS_auditEntry& entry, uint8_t* hash);
+    bool appendLocked(EARS_auditEntry& entry);
+
+    static void onRecord(const EARS_record* record, bool existed, void* ctx);
+};
+
+// Global instance access function (Singleton pattern)
+EARS_audit &using_audit();
+
+#endif // __EARS_AUDIT_LIB_H__
+
+/******************************************************************************
+ * End of EARS_auditLib.h
+ ******************************************************************************/
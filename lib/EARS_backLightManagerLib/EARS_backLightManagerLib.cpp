@@ -2,24 +2,48 @@
  * @file EARS_backLightManagerLib.cpp
  * @author Julian (51fiftyone51fiftyone_at_gmail.com)
  * @brief Manages LCD backlight with PWM control, NVS storage, and screen saver integration
- * @version 2.0.0
- * @date 20260210
+ * @version 2.8.0
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
 #include "EARS_backLightManagerLib.h"
+#include "EARS_systemDef.h"
 
 // Constructor
 EARS_backLightManager::EARS_backLightManager()
     : _pin(0),
-      _pwmChannel(0),
-      _pwmResolution(8),
+      _pwmChannel(-1),
       _maxDutyCycle(255),
       _currentBrightness(0),
       _savedBrightness(0),
       _screenSaverActive(false),
-      _initialized(false)
+      _initialized(false),
+      _fadeTimer(nullptr),
+      _fading(false),
+      _fadeStartUs(0),
+      _fadeDurationUs(0),
+      _fadeStartLevel(0),
+      _fadeTargetLevel(0),
+      _fadeStartPos(0),
+      _fadeTargetPos(0),
+      _fadeCurve(BACKLIGHT_FADE_GAMMA),
+      _fadeCallback(nullptr),
+      _fadeUserData(nullptr),
+      _profile(BACKLIGHT_PROFILE_NORMAL),
+      _userBrightness(DEFAULT_BRIGHTNESS),
+      _screenMaximum(100),
+      _staticScale(100),
+      _batteryPercent(BACKLIGHT_BATTERY_UNKNOWN),
+      _effectiveBrightness(0),
+      _lastActivityMs(0),
+      _dutyIntegral(0),
+      _energyStartUs(0),
+      _lastIntegrateUs(0),
+      _eventSubscriber(-1)
 {
+    _policy = profilePolicy(_profile);
+    _fadeLock = portMUX_INITIALIZER_UNLOCKED;
 }
 
 // Initialize the backlight manager
@@ -27,13 +51,43 @@ bool EARS_backLightManager::begin(uint8_t pin, uint8_t pwmChannel,
                                   uint32_t pwmFrequency, uint8_t pwmResolution)
 {
     _pin = pin;
-    _pwmChannel = pwmChannel;
-    _pwmResolution = pwmResolution;
-    _maxDutyCycle = (1 << pwmResolution) - 1; // e.g., 255 for 8-bit
 
-    // Configure PWM
-    ledcSetup(_pwmChannel, pwmFrequency, _pwmResolution);
-    ledcAttachPin(_pin, _pwmChannel);
+    // Configure PWM (channel shared-timer checks live in the PWM manager)
+    if (_pwmChannel < 0)
+    {
+        _pwmChannel = using_pwmmanager().attach(_pin, pwmFrequency, pwmResolution,
+                                                "backlight", pwmChannel);
+        if (_pwmChannel < 0)
+        {
+            Serial.println("[BacklightManager] ERROR: No PWM channel available");
+            return false;
+        }
+    }
+    _maxDutyCycle = using_pwmmanager().getMaxDuty(_pwmChannel);
+
+    // Gamma table for fades: perceived step -> duty fraction (Q16), so the
+    // fade step itself is integer only
+    for (uint16_t i = 0; i <= BACKLIGHT_GAMMA_STEPS; i++)
+    {
+        float fraction = powf((float)i / BACKLIGHT_GAMMA_STEPS, BACKLIGHT_GAMMA);
+        _gammaTable[i] = (uint16_t)(fraction * 65535.0f + 0.5f);
+    }
+
+    // Fade timer runs in the esp_timer task, not the caller's
+    if (_fadeTimer == nullptr)
+    {
+        esp_timer_create_args_t timerArgs = {};
+        timerArgs.callback = &EARS_backLightManager::fadeTimerCallback;
+        timerArgs.arg = this;
+        timerArgs.dispatch_method = ESP_TIMER_TASK;
+        timerArgs.name = "bl_fade";
+
+        if (esp_timer_create(&timerArgs, &_fadeTimer) != ESP_OK)
+        {
+            _fadeTimer = nullptr;
+            Serial.println("[BacklightManager] WARNING: Fade timer unavailable - fades are instant");
+        }
+    }
 
     // Open NVS preferences
     if (!_preferences.begin(NVS_NAMESPACE, false))
@@ -53,15 +107,36 @@ bool EARS_backLightManager::begin(uint8_t pin, uint8_t pwmChannel,
     }
     else
     {
-        // Load saved brightness or use default
-        initialBrightness = _preferences.getUChar(NVS_BRIGHTNESS_KEY, DEFAULT_BRIGHTNESS);
+        // Brightness now lives in the EARS settings shadow; move a value
+        // left in this namespace by older firmware across once
+        if (_preferences.isKey(NVS_BRIGHTNESS_KEY))
+        {
+            using_nvseeprom().setBacklightValue(_preferences.getUChar(NVS_BRIGHTNESS_KEY, DEFAULT_BRIGHTNESS));
+            _preferences.remove(NVS_BRIGHTNESS_KEY);
+        }
+
+        initialBrightness = using_nvseeprom().getBacklightValue();
         Serial.printf("[BacklightManager] Loaded brightness: %d%%\n", initialBrightness);
     }
 
+    _initialized = true;
+
+    // Touches anywhere count as activity for idle dimming; the power
+    // monitor's battery reports drive the step-down
+    if (_eventSubscriber < 0)
+    {
+        _eventSubscriber = using_eventbus().subscribe(EVENT_MASK_USER_ACTIVITY | EVENT_MASK(EVENT_BATTERY), onEvent, this);
+    }
+
     // Set initial brightness immediately
     setBrightness(initialBrightness);
+    _userBrightness = initialBrightness;
+    _effectiveBrightness = initialBrightness;
+
+    // Start idle timing and energy accounting from here
+    _lastActivityMs = millis();
+    resetEnergy();
 
-    _initialized = true;
     Serial.printf("[BacklightManager] Initialized on pin %d, PWM channel %d, freq %d Hz\n",
                   _pin, _pwmChannel, pwmFrequency);
 
@@ -77,20 +152,27 @@ void EARS_backLightManager::setBrightness(uint8_t level)
         return;
     }
 
+    // An explicit level replaces any running fade
+    cancelFade();
+    integrateDuty();
+
     // Constrain to valid range
     level = constrain(level, 0, 100);
 
     _currentBrightness = level;
 
     // Convert to PWM duty cycle and apply
-    uint32_t dutyCycle = percentageToDutyCycle(level);
-    ledcWrite(_pwmChannel, dutyCycle);
+    uint32_t dutyCycle = using_pwmmanager().percentToDuty(_pwmChannel, level);
+    using_pwmmanager().writeDuty(_pwmChannel, dutyCycle);
 
-    Serial.printf("[BacklightManager] Brightness set to %d%% (duty: %d)\n", level, dutyCycle);
+    DEBUG_PRINTF("[BacklightManager] Brightness set to %d%% (duty: %d)\n", level, dutyCycle);
 }
 
-// Fade to brightness smoothly
-void EARS_backLightManager::fadeToBrightness(uint8_t targetLevel, uint16_t durationMs)
+// Fade to brightness smoothly (non-blocking)
+void EARS_backLightManager::fadeToBrightness(uint8_t targetLevel, uint16_t durationMs,
+                                             BacklightFadeCurve curve,
+                                             BacklightFadeCallback onComplete,
+                                             void *userData)
 {
     if (!_initialized)
     {
@@ -101,39 +183,130 @@ void EARS_backLightManager::fadeToBrightness(uint8_t targetLevel, uint16_t durat
     // Constrain target level
     targetLevel = constrain(targetLevel, 0, 100);
 
+    // Start from wherever a running fade has got to
+    cancelFade();
     uint8_t startLevel = _currentBrightness;
 
     // If already at target, do nothing
     if (startLevel == targetLevel)
     {
+        if (onComplete)
+        {
+            onComplete(targetLevel, userData);
+        }
         return;
     }
 
-    // Calculate step parameters
-    int16_t levelDiff = targetLevel - startLevel;
-    uint32_t startTime = millis();
-    uint32_t endTime = startTime + durationMs;
+    // No time or no timer - jump straight there
+    if (durationMs == 0 || _fadeTimer == nullptr)
+    {
+        setBrightness(targetLevel);
+        if (onComplete)
+        {
+            onComplete(targetLevel, userData);
+        }
+        return;
+    }
 
-    Serial.printf("[BacklightManager] Fading from %d%% to %d%% over %dms\n",
-                  startLevel, targetLevel, durationMs);
+    DEBUG_PRINTF("[BacklightManager] Fading from %d%% to %d%% over %dms\n",
+                 startLevel, targetLevel, durationMs);
+
+    // Curve positions are computed once here; fadeStep() only interpolates
+    uint16_t startPos = levelToCurvePos(startLevel, curve);
+    uint16_t targetPos = levelToCurvePos(targetLevel, curve);
+
+    portENTER_CRITICAL(&_fadeLock);
+    _fadeStartLevel = startLevel;
+    _fadeTargetLevel = targetLevel;
+    _fadeStartPos = startPos;
+    _fadeTargetPos = targetPos;
+    _fadeCurve = curve;
+    _fadeCallback = onComplete;
+    _fadeUserData = userData;
+    _fadeDurationUs = (uint32_t)durationMs * 1000;
+    _fadeStartUs = esp_timer_get_time();
+    _fading = true;
+    portEXIT_CRITICAL(&_fadeLock);
+
+    esp_timer_start_periodic(_fadeTimer, BACKLIGHT_FADE_STEP_MS * 1000);
+}
 
-    // Perform fade
-    while (millis() < endTime)
+// Check if a fade is running
+bool EARS_backLightManager::isFading() const
+{
+    return _fading;
+}
+
+// Stop a running fade at its current level
+void EARS_backLightManager::cancelFade()
+{
+    portENTER_CRITICAL(&_fadeLock);
+    bool wasFading = _fading;
+    _fading = false;
+    portEXIT_CRITICAL(&_fadeLock);
+
+    if (wasFading && _fadeTimer != nullptr)
     {
-        uint32_t elapsed = millis() - startTime;
-        float progress = (float)elapsed / (float)durationMs;
+        esp_timer_stop(_fadeTimer);
+    }
+}
 
-        // Linear interpolation
-        uint8_t currentLevel = startLevel + (levelDiff * progress);
+// Advance the running fade by one step
+void EARS_backLightManager::fadeStep()
+{
+    BacklightFadeCallback callback = nullptr;
+    void *userData = nullptr;
+    uint32_t dutyCycle;
+    uint8_t level;
+    bool done;
+
+    portENTER_CRITICAL(&_fadeLock);
+    if (!_fading)
+    {
+        portEXIT_CRITICAL(&_fadeLock);
+        return;
+    }
 
-        uint32_t dutyCycle = percentageToDutyCycle(currentLevel);
-        ledcWrite(_pwmChannel, dutyCycle);
+    uint32_t elapsed = (uint32_t)(esp_timer_get_time() - _fadeStartUs);
+    done = (elapsed >= _fadeDurationUs);
 
-        delay(10); // Small delay for smooth transition
+    if (done)
+    {
+        // End on the exact steady-state duty for the target
+        _fading = false;
+        level = _fadeTargetLevel;
+        dutyCycle = using_pwmmanager().percentToDuty(_pwmChannel, level);
+        callback = _fadeCallback;
+        userData = _fadeUserData;
     }
+    else
+    {
+        int32_t posSpan = (int32_t)_fadeTargetPos - _fadeStartPos;
+        int32_t levelSpan = (int32_t)_fadeTargetLevel - _fadeStartLevel;
+        uint16_t pos = _fadeStartPos + (int32_t)(((int64_t)posSpan * elapsed) / _fadeDurationUs);
+        level = _fadeStartLevel + (int32_t)(((int64_t)levelSpan * elapsed) / _fadeDurationUs);
+        dutyCycle = curvePosToDutyCycle(pos, _fadeCurve);
+    }
+
+    _currentBrightness = level;
+    portEXIT_CRITICAL(&_fadeLock);
+
+    using_pwmmanager().writeDuty(_pwmChannel, dutyCycle);
 
-    // Ensure we end at exact target
-    setBrightness(targetLevel);
+    if (done)
+    {
+        esp_timer_stop(_fadeTimer);
+        if (callback)
+        {
+            callback(level, userData);
+        }
+    }
+}
+
+// esp_timer trampoline
+void EARS_backLightManager::fadeTimerCallback(void *arg)
+{
+    static_cast<EARS_backLightManager *>(arg)->fadeStep();
 }
 
 // Get current brightness
@@ -142,7 +315,7 @@ uint8_t EARS_backLightManager::getBrightness() const
     return _currentBrightness;
 }
 
-// Save brightness to NVS
+// Save user brightness to NVS (coalesced write-back)
 bool EARS_backLightManager::saveBrightness()
 {
     if (!_initialized)
@@ -151,11 +324,10 @@ bool EARS_backLightManager::saveBrightness()
         return false;
     }
 
-    size_t written = _preferences.putUChar(NVS_BRIGHTNESS_KEY, _currentBrightness);
-
-    if (written)
+    // Deferred: EARS_nvsEeprom::service() commits it with the other settings
+    if (using_nvseeprom().setBacklightValue(_userBrightness))
     {
-        Serial.printf("[BacklightManager] Saved brightness: %d%%\n", _currentBrightness);
+        DEBUG_PRINTF("[BacklightManager] Saved brightness: %d%%\n", _userBrightness);
         return true;
     }
     else
@@ -174,18 +346,13 @@ bool EARS_backLightManager::loadBrightness()
         return false;
     }
 
-    if (_preferences.isKey(NVS_BRIGHTNESS_KEY))
-    {
-        uint8_t savedLevel = _preferences.getUChar(NVS_BRIGHTNESS_KEY, DEFAULT_BRIGHTNESS);
-        setBrightness(savedLevel);
-        Serial.printf("[BacklightManager] Loaded brightness: %d%%\n", savedLevel);
-        return true;
-    }
-    else
-    {
-        Serial.println("[BacklightManager] No saved brightness found");
-        return false;
-    }
+    // Served from the NVS RAM shadow
+    uint8_t savedLevel = using_nvseeprom().getBacklightValue();
+    _userBrightness = savedLevel;
+    _effectiveBrightness = computeEffectiveBrightness();
+    setBrightness(_effectiveBrightness);
+    DEBUG_PRINTF("[BacklightManager] Loaded brightness: %d%%\n", savedLevel);
+    return true;
 }
 
 // Turn backlight off
@@ -219,7 +386,7 @@ void EARS_backLightManager::completeInitialConfig()
 }
 
 // Store brightness before screen saver activates
-void EARS_backLightManager::screenSaverActivate()
+void EARS_backLightManager::screenSaverActivate(uint8_t dimLevel)
 {
     if (_screenSaverActive)
     {
@@ -229,11 +396,11 @@ void EARS_backLightManager::screenSaverActivate()
     _savedBrightness = _currentBrightness;
     _screenSaverActive = true;
 
-    Serial.printf("[BacklightManager] Screen saver activated - saved brightness: %d%%\n",
-                  _savedBrightness);
+    DEBUG_PRINTF("[BacklightManager] Screen saver activated - saved brightness: %d%%\n",
+                 _savedBrightness);
 
-    // Fade to off or dim level (you can make this configurable)
-    fadeToBrightness(0, 500); // 500ms fade to black
+    // Fade to off or dim level
+    fadeToBrightness(dimLevel, 500); // 500ms fade, runs in the background
 }
 
 // Restore brightness after screen saver deactivates
@@ -246,8 +413,8 @@ void EARS_backLightManager::screenSaverDeactivate()
 
     _screenSaverActive = false;
 
-    Serial.printf("[BacklightManager] Screen saver deactivated - restoring brightness: %d%%\n",
-                  _savedBrightness);
+    DEBUG_PRINTF("[BacklightManager] Screen saver deactivated - restoring brightness: %d%%\n",
+                 _savedBrightness);
 
     // Fade back to saved brightness
     fadeToBrightness(_savedBrightness, 300); // 300ms fade back
@@ -259,11 +426,262 @@ bool EARS_backLightManager::isScreenSaverActive() const
     return _screenSaverActive;
 }
 
-// Convert percentage to PWM duty cycle
-uint32_t EARS_backLightManager::percentageToDutyCycle(uint8_t percentage) const
+// Position of a brightness level on a fade curve
+uint16_t EARS_backLightManager::levelToCurvePos(uint8_t level, BacklightFadeCurve curve) const
+{
+    if (curve == BACKLIGHT_FADE_GAMMA)
+    {
+        // Inverse gamma: where this duty sits in perceived brightness
+        float perceived = powf(level / 100.0f, 1.0f / BACKLIGHT_GAMMA);
+        return (uint16_t)(perceived * BACKLIGHT_GAMMA_STEPS + 0.5f);
+    }
+
+    return (uint16_t)(((uint32_t)level * BACKLIGHT_GAMMA_STEPS + 50) / 100);
+}
+
+// Duty cycle for a position on a fade curve
+uint32_t EARS_backLightManager::curvePosToDutyCycle(uint16_t pos, BacklightFadeCurve curve) const
+{
+    if (pos > BACKLIGHT_GAMMA_STEPS)
+    {
+        pos = BACKLIGHT_GAMMA_STEPS;
+    }
+
+    if (curve == BACKLIGHT_FADE_GAMMA)
+    {
+        return (_maxDutyCycle * _gammaTable[pos]) >> 16;
+    }
+
+    return (_maxDutyCycle * pos) / BACKLIGHT_GAMMA_STEPS;
+}
+
+/******************************************************************************
+ * Policy Controller
+ *****************************************************************************/
+
+// Preset rules for a profile
+BacklightPolicy EARS_backLightManager::profilePolicy(BacklightProfile profile)
+{
+    BacklightPolicy policy;
+
+    switch (profile)
+    {
+    case BACKLIGHT_PROFILE_POWER_SAVER:
+        policy = {20000, 15, 40, 50, 15, 25};
+        break;
+
+    case BACKLIGHT_PROFILE_ALWAYS_ON:
+        policy = {0, 100, 0, 100, 0, 100};
+        break;
+
+    case BACKLIGHT_PROFILE_NORMAL:
+    default:
+        policy = {60000, 30, 20, 60, 10, 30};
+        break;
+    }
+
+    return policy;
+}
+
+// Select a preset policy
+void EARS_backLightManager::setProfile(BacklightProfile profile)
+{
+    if (profile == BACKLIGHT_PROFILE_CUSTOM)
+    {
+        return; // Use setPolicy()
+    }
+
+    _profile = profile;
+    _policy = profilePolicy(profile);
+}
+
+// Get the active profile
+BacklightProfile EARS_backLightManager::getProfile() const
+{
+    return _profile;
+}
+
+// Apply a custom policy
+void EARS_backLightManager::setPolicy(const BacklightPolicy &policy)
+{
+    _profile = BACKLIGHT_PROFILE_CUSTOM;
+    _policy = policy;
+}
+
+// Get the active policy
+BacklightPolicy EARS_backLightManager::getPolicy() const
+{
+    return _policy;
+}
+
+// Set the user's preferred brightness
+void EARS_backLightManager::setUserBrightness(uint8_t level, bool persist)
+{
+    _userBrightness = constrain(level, 0, 100);
+
+    // A deliberate change counts as activity
+    _lastActivityMs = millis();
+
+    if (persist && _initialized)
+    {
+        saveBrightness();
+    }
+}
+
+// Get the user's preferred brightness
+uint8_t EARS_backLightManager::getUserBrightness() const
+{
+    return _userBrightness;
+}
+
+// Set the brightness cap for the current screen
+void EARS_backLightManager::setScreenMaximum(uint8_t maxLevel)
+{
+    _screenMaximum = constrain(maxLevel, 0, 100);
+}
+
+// Scale the level while the screen content is static
+void EARS_backLightManager::setStaticScale(uint8_t percent)
+{
+    _staticScale = constrain(percent, 1, 100);
+}
+
+// Report the current battery charge
+void EARS_backLightManager::setBatteryLevel(uint8_t percent)
+{
+    _batteryPercent = constrain(percent, 0, 100);
+}
+
+// Get the battery charge last reported
+uint8_t EARS_backLightManager::getBatteryLevel() const
+{
+    return _batteryPercent;
+}
+
+// Report user activity
+void EARS_backLightManager::notifyActivity()
+{
+    // Picked up by the next service() call
+    _lastActivityMs = millis();
+}
+
+// Event bus subscriber
+void EARS_backLightManager::onEvent(const EARS_event &event, void *userData)
+{
+    EARS_backLightManager *manager = static_cast<EARS_backLightManager *>(userData);
+    if (event.type == EVENT_BATTERY)
+    {
+        // Low byte is the charge, 255 when no battery is fitted
+        uint8_t percent = event.value & 0xFF;
+        if (percent <= 100)
+        {
+            manager->setBatteryLevel(percent);
+        }
+        return;
+    }
+    manager->notifyActivity();
+}
+
+// Level after applying the screen maximum and policy caps
+uint8_t EARS_backLightManager::computeEffectiveBrightness() const
+{
+    uint8_t level = min(_userBrightness, _screenMaximum);
+
+    if (_batteryPercent != BACKLIGHT_BATTERY_UNKNOWN)
+    {
+        if (_policy.batteryCritPercent && _batteryPercent <= _policy.batteryCritPercent)
+        {
+            level = min(level, _policy.batteryCritMax);
+        }
+        else if (_policy.batteryLowPercent && _batteryPercent <= _policy.batteryLowPercent)
+        {
+            level = min(level, _policy.batteryLowMax);
+        }
+    }
+
+    if (_policy.idleDimMs && (millis() - _lastActivityMs) >= _policy.idleDimMs)
+    {
+        level = min(level, _policy.idleDimLevel);
+    }
+
+    // Rounded up, so a lit screen is never scaled to off
+    return (uint8_t)(((uint16_t)level * _staticScale + 99) / 100);
+}
+
+// Run the policy controller
+void EARS_backLightManager::service()
+{
+    if (!_initialized)
+    {
+        return;
+    }
+
+    integrateDuty();
+
+    // The screen saver owns the backlight while it is active
+    if (_screenSaverActive)
+    {
+        return;
+    }
+
+    uint8_t level = computeEffectiveBrightness();
+    if (level != _effectiveBrightness)
+    {
+        _effectiveBrightness = level;
+        fadeToBrightness(level, BACKLIGHT_POLICY_FADE_MS);
+    }
+}
+
+// Level the controller is currently driving towards
+uint8_t EARS_backLightManager::getEffectiveBrightness() const
+{
+    return _effectiveBrightness;
+}
+
+// Add the time since the last call to the duty integral
+void EARS_backLightManager::integrateDuty()
+{
+    int64_t now = esp_timer_get_time();
+    uint32_t elapsedMs = (uint32_t)((now - _lastIntegrateUs) / 1000);
+
+    if (elapsedMs > 0)
+    {
+        _dutyIntegral += (uint64_t)_currentBrightness * elapsedMs;
+        _lastIntegrateUs += (int64_t)elapsedMs * 1000; // Keep the remainder
+    }
+}
+
+// Full-brightness equivalent on-time since the last reset
+float EARS_backLightManager::getDutySeconds() const
+{
+    // Percent-milliseconds -> seconds at 100%
+    return (float)_dutyIntegral / 100000.0f;
+}
+
+// Average duty cycle since the last reset
+float EARS_backLightManager::getAverageDuty() const
+{
+    float elapsed = (float)(esp_timer_get_time() - _energyStartUs) / 1000000.0f;
+    if (elapsed <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    return getDutySeconds() / elapsed;
+}
+
+// Estimate backlight energy since the last reset
+float EARS_backLightManager::getEstimatedEnergyJoules(float fullBrightnessWatts) const
+{
+    return getDutySeconds() * fullBrightnessWatts;
+}
+
+// Restart the duty-cycle integral
+void EARS_backLightManager::resetEnergy()
 {
-    // Simple linear mapping: 0% = 0, 100% = maxDutyCycle
-    return (_maxDutyCycle * percentage) / 100;
+    _dutyIntegral = 0;
+    _energyStartUs = esp_timer_get_time();
+    _lastIntegrateUs = _energyStartUs;
 }
 
 /******************************************************************************
@@ -2,16 +2,21 @@
  * @file EARS_backLightManagerLib.h
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief Manages LCD backlight with PWM control, NVS storage, and screen saver integration
- * @version 2.0.0
- * @date 20260210
+ * @version 2.8.0
+ * @date 20261015
  *
  * Features:
  * - Analog PWM brightness control (0-100%)
- * - NVS storage for user preferences
+ * - NVS storage for user preferences (coalesced through EARS_nvsEeprom)
  * - Screen saver integration
- * - Smooth fade transitions
+ * - Non-blocking, gamma-corrected fade transitions (esp_timer driven)
  * - Initial device config detection (100% brightness)
  * - Default 75% after initial setup
+ * - Policy controller: idle dimming, battery step-down, per-screen maximum,
+ *   static-screen scale (MAIN_displayLib power states)
+ * - Duty-cycle integral for backlight energy estimates
+ * - LEDC channel allocated through EARS_pwmManager
+ * - Idle timer restarted by touch events from the event bus
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -26,6 +31,10 @@
 #include <Arduino.h>
 #include <Preferences.h>
 #include "EARS_versionDef.h"
+#include <esp_timer.h>
+#include "EARS_nvsEepromLib.h"
+#include "EARS_pwmManagerLib.h"
+#include "EARS_eventBusLib.h"
 
 /******************************************************************************
  * Library Version Information
@@ -34,11 +43,80 @@ namespace EARS_BackLight
 {
     constexpr const char *LIB_NAME = "EARS_BackLightManager";
     constexpr const char *VERSION_MAJOR = "2";
-    constexpr const char *VERSION_MINOR = "0";
+    constexpr const char *VERSION_MINOR = "8";
     constexpr const char *VERSION_PATCH = "0";
-    constexpr const char *VERSION_DATE = "2026-02-10";
+    constexpr const char *VERSION_DATE = "2026-10-15";
 }
 
+/******************************************************************************
+ * Fade Configuration
+ *****************************************************************************/
+
+// Fade update period (ms)
+#define BACKLIGHT_FADE_STEP_MS 10
+
+// Display gamma used for perceptually even fades
+#define BACKLIGHT_GAMMA 2.2f
+
+// Gamma table resolution (entries - 1)
+#define BACKLIGHT_GAMMA_STEPS 256
+
+/******************************************************************************
+ * Policy Controller Configuration
+ *****************************************************************************/
+
+// Fade used when the controller changes the effective level (ms)
+#define BACKLIGHT_POLICY_FADE_MS 400
+
+// Battery level reported before setBatteryLevel() is first called
+#define BACKLIGHT_BATTERY_UNKNOWN 255
+
+/**
+ * @enum BacklightProfile
+ * @brief Preset controller policies
+ */
+enum BacklightProfile : uint8_t
+{
+    BACKLIGHT_PROFILE_NORMAL = 0,      // Dim after 60 s, mild battery step-down
+    BACKLIGHT_PROFILE_POWER_SAVER = 1, // Dim after 20 s, early battery step-down
+    BACKLIGHT_PROFILE_ALWAYS_ON = 2,   // No idle dimming, no battery step-down
+    BACKLIGHT_PROFILE_CUSTOM = 3       // Set through setPolicy()
+};
+
+/**
+ * @struct BacklightPolicy
+ * @brief Rules the controller applies on top of the user brightness
+ *
+ * @details A time or threshold of 0 disables that rule. The effective level
+ *          is the lowest of the user level, the screen maximum and every
+ *          active rule cap.
+ */
+struct BacklightPolicy
+{
+    uint32_t idleDimMs;          // Idle time before dimming
+    uint8_t idleDimLevel;        // Level cap while idle
+    uint8_t batteryLowPercent;   // Battery at or below this...
+    uint8_t batteryLowMax;       // ...caps the level here
+    uint8_t batteryCritPercent;  // Battery at or below this...
+    uint8_t batteryCritMax;      // ...caps the level here
+};
+
+/**
+ * @enum BacklightFadeCurve
+ * @brief Interpolation used by fadeToBrightness()
+ */
+enum BacklightFadeCurve : uint8_t
+{
+    BACKLIGHT_FADE_LINEAR = 0, // Linear in duty cycle
+    BACKLIGHT_FADE_GAMMA = 1   // Linear in perceived brightness
+};
+
+/**
+ * @brief Fade completion callback
+ * @details Runs in the esp_timer task; keep it short and do not call LVGL.
+ */
+typedef void (*BacklightFadeCallback)(uint8_t level, void *userData);
+
 class EARS_backLightManager
 {
 public:
@@ -74,7 +152,7 @@ public:
     /**
      * @brief Initialize the backlight manager
      * @param pin GPIO pin for backlight control
-     * @param pwmChannel PWM channel to use (0-15)
+     * @param pwmChannel Preferred PWM channel (another is allocated if busy)
      * @param pwmFrequency PWM frequency in Hz (default 5000)
      * @param pwmResolution PWM resolution in bits (default 8)
      * @return true if initialization successful
@@ -89,11 +167,30 @@ public:
     void setBrightness(uint8_t level);
 
     /**
-     * @brief Fade to brightness level smoothly
+     * @brief Fade to brightness level smoothly (returns immediately)
      * @param level Target brightness level (0-100)
      * @param durationMs Fade duration in milliseconds (default 200)
+     * @param curve Interpolation curve (default gamma corrected)
+     * @param onComplete Called once the target is reached (optional)
+     * @param userData Passed to onComplete
+     * @note A new fade or setBrightness() replaces a running fade; the
+     *       replaced fade's callback is not called.
+     */
+    void fadeToBrightness(uint8_t level, uint16_t durationMs = 200,
+                          BacklightFadeCurve curve = BACKLIGHT_FADE_GAMMA,
+                          BacklightFadeCallback onComplete = nullptr,
+                          void *userData = nullptr);
+
+    /**
+     * @brief Check if a fade is running
+     * @return true while fading
+     */
+    bool isFading() const;
+
+    /**
+     * @brief Stop a running fade at its current level
      */
-    void fadeToBrightness(uint8_t level, uint16_t durationMs = 200);
+    void cancelFade();
 
     /**
      * @brief Get current brightness level
@@ -135,9 +232,10 @@ public:
     void completeInitialConfig();
 
     /**
-     * @brief Store brightness before screen saver activates
+     * @brief Store brightness and fade down for the screen saver
+     * @param dimLevel Level to fade to (0 = off)
      */
-    void screenSaverActivate();
+    void screenSaverActivate(uint8_t dimLevel = 0);
 
     /**
      * @brief Restore brightness after screen saver deactivates
@@ -150,17 +248,159 @@ public:
      */
     bool isScreenSaverActive() const;
 
+    // ========================================================================
+    // Policy controller
+    // ========================================================================
+
+    /**
+     * @brief Select a preset policy
+     * @param profile Preset to apply
+     */
+    void setProfile(BacklightProfile profile);
+
+    /**
+     * @brief Get the active profile
+     * @return BacklightProfile Active profile (CUSTOM after setPolicy())
+     */
+    BacklightProfile getProfile() const;
+
+    /**
+     * @brief Apply a custom policy
+     * @param policy Rules to apply
+     */
+    void setPolicy(const BacklightPolicy &policy);
+
+    /**
+     * @brief Get the active policy
+     * @return BacklightPolicy Active rules
+     */
+    BacklightPolicy getPolicy() const;
+
+    /**
+     * @brief Set the user's preferred brightness
+     * @param level Brightness level (0-100)
+     * @param persist Store it through the NVS settings write-back
+     * @details The controller never exceeds this level; policies only lower it.
+     */
+    void setUserBrightness(uint8_t level, bool persist = true);
+
+    /**
+     * @brief Get the user's preferred brightness
+     * @return uint8_t Brightness level (0-100)
+     */
+    uint8_t getUserBrightness() const;
+
+    /**
+     * @brief Set the brightness cap for the current screen
+     * @param maxLevel Maximum level (100 = no cap)
+     */
+    void setScreenMaximum(uint8_t maxLevel);
+
+    /**
+     * @brief Scale the level while the screen content is static
+     * @param percent Share of the effective level to keep (100 = no change)
+     */
+    void setStaticScale(uint8_t percent);
+
+    /**
+     * @brief Report the current battery charge
+     * @param percent Battery level (0-100)
+     * @note Called for each EVENT_BATTERY from MAIN_powerMonitorLib.
+     */
+    void setBatteryLevel(uint8_t percent);
+
+    /**
+     * @brief Get the battery charge last reported
+     * @return uint8_t Battery level (0-100), BACKLIGHT_BATTERY_UNKNOWN if never set
+     */
+    uint8_t getBatteryLevel() const;
+
+    /**
+     * @brief Report user activity (touch, button), restores an idle dim
+     */
+    void notifyActivity();
+
+    /**
+     * @brief Run the policy controller, call periodically (Core 1 loop)
+     * @details Fades to a new effective level when a rule changes it and
+     *          accumulates the duty-cycle integral.
+     */
+    void service();
+
+    /**
+     * @brief Level the controller is currently driving towards
+     * @return uint8_t Effective brightness (0-100)
+     */
+    uint8_t getEffectiveBrightness() const;
+
+    /**
+     * @brief Full-brightness equivalent on-time since the last reset
+     * @return float Seconds at 100% duty
+     */
+    float getDutySeconds() const;
+
+    /**
+     * @brief Average duty cycle since the last reset
+     * @return float Average duty (0.0-1.0)
+     */
+    float getAverageDuty() const;
+
+    /**
+     * @brief Estimate backlight energy since the last reset
+     * @param fullBrightnessWatts Backlight power at 100% duty for this board
+     * @return float Energy in joules
+     */
+    float getEstimatedEnergyJoules(float fullBrightnessWatts) const;
+
+    /**
+     * @brief Restart the duty-cycle integral
+     */
+    void resetEnergy();
+
 private:
     uint8_t _pin;
-    uint8_t _pwmChannel;
-    uint8_t _pwmResolution;
+    int8_t _pwmChannel;
     uint32_t _maxDutyCycle;
 
-    uint8_t _currentBrightness;
+    volatile uint8_t _currentBrightness;
     uint8_t _savedBrightness; // Brightness before screen saver
     bool _screenSaverActive;
     bool _initialized;
 
+    // Fade state (shared with the esp_timer task)
+    esp_timer_handle_t _fadeTimer;
+    portMUX_TYPE _fadeLock;
+    volatile bool _fading;
+    int64_t _fadeStartUs;
+    uint32_t _fadeDurationUs;
+    uint8_t _fadeStartLevel;
+    uint8_t _fadeTargetLevel;
+    uint16_t _fadeStartPos; // Position on the fade curve
+    uint16_t _fadeTargetPos;
+    BacklightFadeCurve _fadeCurve;
+    BacklightFadeCallback _fadeCallback;
+    void *_fadeUserData;
+
+    // Policy controller state
+    BacklightProfile _profile;
+    BacklightPolicy _policy;
+    uint8_t _userBrightness;
+    uint8_t _screenMaximum;
+    uint8_t _staticScale;
+    uint8_t _batteryPercent;
+    uint8_t _effectiveBrightness;
+    volatile uint32_t _lastActivityMs;
+
+    // Duty integral in percent-milliseconds
+    uint64_t _dutyIntegral;
+    int64_t _energyStartUs;
+    int64_t _lastIntegrateUs;
+
+    int8_t _eventSubscriber;
+
+    // Perceived brightness (index) -> duty fraction (Q16), built in begin()
+    uint16_t _gammaTable[BACKLIGHT_GAMMA_STEPS + 1];
+
     Preferences _preferences;
 
     // NVS keys
@@ -173,11 +413,53 @@ private:
     static constexpr uint8_t INITIAL_CONFIG_BRIGHTNESS = 100;
 
     /**
-     * @brief Convert percentage (0-100) to PWM duty cycle
-     * @param percentage Brightness percentage
+     * @brief Position of a brightness level on a fade curve
+     * @param level Brightness percentage
+     * @param curve Fade curve
+     * @return uint16_t Curve position (0-BACKLIGHT_GAMMA_STEPS)
+     */
+    uint16_t levelToCurvePos(uint8_t level, BacklightFadeCurve curve) const;
+
+    /**
+     * @brief Duty cycle for a position on a fade curve
+     * @param pos Curve position (0-BACKLIGHT_GAMMA_STEPS)
+     * @param curve Fade curve
      * @return uint32_t PWM duty cycle value
      */
-    uint32_t percentageToDutyCycle(uint8_t percentage) const;
+    uint32_t curvePosToDutyCycle(uint16_t pos, BacklightFadeCurve curve) const;
+
+    /**
+     * @brief Advance the running fade (esp_timer callback body)
+     */
+    void fadeStep();
+
+    static void fadeTimerCallback(void *arg);
+
+    /**
+     * @brief Event bus subscriber: user activity restarts the idle timer,
+     *        battery reports update the charge
+     * @param event Dispatched event
+     * @param userData Manager instance
+     */
+    static void onEvent(const EARS_event &event, void *userData);
+
+    /**
+     * @brief Preset rules for a profile
+     * @param profile Preset
+     * @return BacklightPolicy Rules
+     */
+    static BacklightPolicy profilePolicy(BacklightProfile profile);
+
+    /**
+     * @brief Level after applying the screen maximum and policy caps
+     * @return uint8_t Effective brightness (0-100)
+     */
+    uint8_t computeEffectiveBrightness() const;
+
+    /**
+     * @brief Add the time since the last call to the duty integral
+     */
+    void integrateDuty();
 };
 
 // Global instance access function
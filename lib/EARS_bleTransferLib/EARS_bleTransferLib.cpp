@@ -0,0 +1,504 @@
+/**
+ * @file EARS_bleTransferLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Report files to a companion phone over BLE (NimBLE)
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EARS_bleTransferLib.h"
+#include "EARS_systemDef.h"
+#include <NimBLEDevice.h>
+#include <esp_heap_caps.h>
+#include <esp_rom_crc.h>
+
+/******************************************************************************
+ * NimBLE Callbacks
+ *****************************************************************************/
+
+// Host task events passed on to the transfer
+class EARS_bleTransferCallbacks : public NimBLEServerCallbacks, public NimBLECharacteristicCallbacks
+{
+public:
+    void onConnect(NimBLEServer* server, ble_gap_conn_desc* desc) override
+    {
+        using_bletransfer().onConnect(desc->conn_handle);
+
+        // Ask for the fast link at once; the phone may settle on less
+        server->updateConnParams(desc->conn_handle, BLEXFER_INTERVAL_MIN, BLEXFER_INTERVAL_MAX, 0,
+                                 BLEXFER_SUPERVISION);
+        ble_gap_set_prefered_le_phy(desc->conn_handle, BLE_GAP_LE_PHY_2M_MASK, BLE_GAP_LE_PHY_2M_MASK,
+                                    BLE_GAP_LE_PHY_CODED_ANY);
+        ble_gap_set_data_len(desc->conn_handle, BLEXFER_DATA_LEN, BLEXFER_DATA_TIME);
+    }
+
+    void onDisconnect(NimBLEServer* server, ble_gap_conn_desc* desc) override
+    {
+        using_bletransfer().onDisconnect();
+    }
+
+    void onMTUChange(uint16_t mtu, ble_gap_conn_desc* desc) override
+    {
+        using_bletransfer().onMtu(mtu);
+    }
+
+    void onWrite(NimBLECharacteristic* characteristic, ble_gap_conn_desc* desc) override
+    {
+        NimBLEAttValue value = characteristic->getValue();
+        if (value.length() > 0 && value.data()[0] == BLEXFER_CONTROL_CANCEL)
+        {
+            using_bletransfer().cancel();
+        }
+    }
+
+    void onSubscribe(NimBLECharacteristic* characteristic, ble_gap_conn_desc* desc, uint16_t subValue) override
+    {
+        using_bletransfer().onSubscribe((subValue & 0x0001) != 0);
+    }
+};
+
+static EARS_bleTransferCallbacks bleTransferCallbacks;
+
+/******************************************************************************
+ * Construction
+ *****************************************************************************/
+EARS_bleTransfer::EARS_bleTransfer()
+    : _running(false),
+      _info(nullptr),
+      _data(nullptr),
+      _conn(BLE_HS_CONN_HANDLE_NONE),
+      _mtu(BLE_ATT_MTU_DFLT),
+      _subscribed(false),
+      _phy2M(false),
+      _sdCard(nullptr),
+      _callback(nullptr),
+      _ctx(nullptr),
+      _cancel(false),
+      _buffer(nullptr),
+      _bufferLen(0),
+      _bufferPos(0),
+      _offset(0),
+      _crc(0),
+      _startMs(0)
+{
+    _path[0] = '\0';
+    memset(&_progress, 0, sizeof(_progress));
+    _mux = portMUX_INITIALIZER_UNLOCKED;
+}
+
+/******************************************************************************
+ * Link
+ *****************************************************************************/
+bool EARS_bleTransfer::begin()
+{
+    if (_running)
+    {
+        return true;
+    }
+
+    NimBLEDevice::init(BLEXFER_DEVICE_NAME);
+    NimBLEDevice::setMTU(BLEXFER_MTU);
+    NimBLEDevice::setPower(ESP_PWR_LVL_P9);
+
+    NimBLEServer* server = NimBLEDevice::createServer();
+    server->setCallbacks(&bleTransferCallbacks, false);
+
+    NimBLEService* service = server->createService(BLEXFER_SERVICE_UUID);
+    _info = service->createCharacteristic(BLEXFER_INFO_UUID, NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::NOTIFY);
+    _data = service->createCharacteristic(BLEXFER_DATA_UUID, NIMBLE_PROPERTY::NOTIFY);
+    NimBLECharacteristic* control = service->createCharacteristic(BLEXFER_CONTROL_UUID, NIMBLE_PROPERTY::WRITE);
+    _data->setCallbacks(&bleTransferCallbacks);
+    control->setCallbacks(&bleTransferCallbacks);
+    service->start();
+
+    NimBLEAdvertising* advertising = NimBLEDevice::getAdvertising();
+    advertising->addServiceUUID(BLEXFER_SERVICE_UUID);
+    advertising->setScanResponse(true);
+    _running = advertising->start();
+
+    DEBUG_PRINTLN(_running ? "[OK] BLE transfer advertising" : "[ERROR] BLE transfer: advertising failed");
+    return _running;
+}
+
+bool EARS_bleTransfer::isConnected() const
+{
+    portENTER_CRITICAL(&_mux);
+    bool connected = _conn != BLE_HS_CONN_HANDLE_NONE;
+    portEXIT_CRITICAL(&_mux);
+    return connected;
+}
+
+void EARS_bleTransfer::onConnect(uint16_t conn)
+{
+    portENTER_CRITICAL(&_mux);
+    _conn = conn;
+    _mtu = BLE_ATT_MTU_DFLT;
+    _subscribed = false;
+    _phy2M = false;
+    portEXIT_CRITICAL(&_mux);
+}
+
+void EARS_bleTransfer::onDisconnect()
+{
+    portENTER_CRITICAL(&_mux);
+    _conn = BLE_HS_CONN_HANDLE_NONE;
+    _subscribed = false;
+    portEXIT_CRITICAL(&_mux);
+}
+
+void EARS_bleTransfer::onMtu(uint16_t mtu)
+{
+    portENTER_CRITICAL(&_mux);
+    _mtu = mtu;
+    portEXIT_CRITICAL(&_mux);
+}
+
+void EARS_bleTransfer::onSubscribe(bool subscribed)
+{
+    portENTER_CRITICAL(&_mux);
+    _subscribed = subscribed;
+    portEXIT_CRITICAL(&_mux);
+}
+
+/******************************************************************************
+ * Control
+ *****************************************************************************/
+bool EARS_bleTransfer::start(EARS_sdCard* sdCard, const char* path, EARS_bleTransferProgressCb callback,
+                             void* ctx)
+{
+    if (!_running || !sdCard || !path || strlen(path) >= sizeof(_path))
+    {
+        return false;
+    }
+
+    portENTER_CRITICAL(&_mux);
+    bool idle = _progress.state != BLEXFER_WAITING && _progress.state != BLEXFER_SENDING;
+    if (idle)
+    {
+        _sdCard = sdCard;
+        strncpy(_path, path, sizeof(_path));
+        _callback = callback;
+        _ctx = ctx;
+        _cancel = false;
+        memset(&_progress, 0, sizeof(_progress));
+        _progress.state = BLEXFER_WAITING;
+    }
+    portEXIT_CRITICAL(&_mux);
+    return idle;
+}
+
+void EARS_bleTransfer::cancel()
+{
+    _cancel = true;
+}
+
+bool EARS_bleTransfer::isBusy() const
+{
+    portENTER_CRITICAL(&_mux);
+    bool busy = _progress.state == BLEXFER_WAITING || _progress.state == BLEXFER_SENDING;
+    portEXIT_CRITICAL(&_mux);
+    return busy;
+}
+
+EARS_bleTransferProgress EARS_bleTransfer::getProgress() const
+{
+    portENTER_CRITICAL(&_mux);
+    EARS_bleTransferProgress progress = _progress;
+    portEXIT_CRITICAL(&_mux);
+    return progress;
+}
+
+/******************************************************************************
+ * Transfer
+ *****************************************************************************/
+
+/**
+ * @brief Allocate the buffer, size the file and tell the phone it is coming
+ */
+bool EARS_bleTransfer::open()
+{
+    uint32_t size = _sdCard->fileExists(_path) ? _sdCard->getFileSize(_path) : 0;
+    if (size == 0)
+    {
+        return false;
+    }
+
+    _buffer = (uint8_t*)heap_caps_malloc(BLEXFER_BUFFER_BYTES, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (_buffer == nullptr)
+    {
+        return false;
+    }
+    _bufferLen = 0;
+    _bufferPos = 0;
+    _offset = 0;
+    _crc = 0;
+    _startMs = millis();
+
+    uint16_t conn;
+    uint8_t txPhy = 0;
+    uint8_t rxPhy = 0;
+    portENTER_CRITICAL(&_mux);
+    conn = _conn;
+    _progress.size = size;
+    _progress.mtu = _mtu;
+    portEXIT_CRITICAL(&_mux);
+
+    // The PHY update completes on its own; read what the link settled on
+    bool phy2M = ble_gap_read_le_phy(conn, &txPhy, &rxPhy) == 0 && txPhy == BLE_GAP_LE_PHY_2M;
+    portENTER_CRITICAL(&_mux);
+    _phy2M = phy2M;
+    _progress.phy2M = phy2M;
+    portEXIT_CRITICAL(&_mux);
+
+    return sendInfo(BLEXFER_INFO_START);
+}
+
+/**
+ * @brief Set and notify the Info characteristic
+ * @details Sent on the same path as the data, so it arrives after every
+ *          byte already queued and is retried while the host is out of buffers
+ */
+bool EARS_bleTransfer::sendInfo(uint8_t kind)
+{
+    EARS_bleTransferInfo info;
+    memset(&info, 0, sizeof(info));
+    info.kind = kind;
+    info.size = _progress.size;
+    info.crc = kind == BLEXFER_INFO_END ? _crc : 0;
+
+    const char* name = strrchr(_path, '/');
+    strncpy(info.name, name ? name + 1 : _path, sizeof(info.name) - 1);
+    _info->setValue((const uint8_t*)&info, sizeof(info));
+
+    portENTER_CRITICAL(&_mux);
+    uint16_t conn = _conn;
+    portEXIT_CRITICAL(&_mux);
+
+    uint32_t deadlineMs = millis() + BLEXFER_SLICE_MS;
+    while (conn != BLE_HS_CONN_HANDLE_NONE)
+    {
+        struct os_mbuf* om = ble_hs_mbuf_from_flat(&info, sizeof(info));
+        int rc = om ? ble_gattc_notify_custom(conn, _info->getHandle(), om) : BLE_HS_ENOMEM;
+        if (rc != BLE_HS_ENOMEM || (int32_t)(millis() - deadlineMs) >= 0)
+        {
+            return rc == 0;
+        }
+        vTaskDelay(1);
+    }
+    return false;
+}
+
+/**
+ * @brief Queue notifications until the file ends, the slice does, or the link goes
+ * @details Notifications go to the host without waiting for a response. Out
+ *          of buffers (BLE_HS_ENOMEM), the slice waits a tick for the
+ *          controller to send some and tries the same bytes again.
+ * @return true while there is more to send
+ */
+bool EARS_bleTransfer::sendSlice(uint32_t deadlineMs)
+{
+    uint16_t conn;
+    uint16_t mtu;
+    bool subscribed;
+    portENTER_CRITICAL(&_mux);
+    conn = _conn;
+    mtu = _mtu;
+    subscribed = _subscribed;
+    portEXIT_CRITICAL(&_mux);
+
+    if (conn == BLE_HS_CONN_HANDLE_NONE || !subscribed)
+    {
+        portENTER_CRITICAL(&_mux);
+        _progress.state = BLEXFER_FAILED;
+        portEXIT_CRITICAL(&_mux);
+        return false;
+    }
+
+    const size_t payload = mtu - 3;
+    const uint16_t handle = _data->getHandle();
+    uint32_t sent = 0;
+
+    while ((int32_t)(millis() - deadlineMs) < 0)
+    {
+        if (_bufferPos == _bufferLen)
+        {
+            if (_offset >= _progress.size)
+            {
+                break;
+            }
+            size_t want = _progress.size - _offset;
+            if (want > BLEXFER_BUFFER_BYTES)
+                want = BLEXFER_BUFFER_BYTES;
+            _bufferLen = _sdCard->readDataAt(_path, _offset, _buffer, want);
+            _bufferPos = 0;
+            if (_bufferLen == 0)
+            {
+                portENTER_CRITICAL(&_mux);
+                _progress.state = BLEXFER_FAILED;
+                portEXIT_CRITICAL(&_mux);
+                return false;
+            }
+            _crc = esp_rom_crc32_le(_crc, _buffer, _bufferLen);
+            _offset += _bufferLen;
+        }
+
+        size_t n = _bufferLen - _bufferPos;
+        if (n > payload)
+            n = payload;
+
+        struct os_mbuf* om = ble_hs_mbuf_from_flat(_buffer + _bufferPos, n);
+        int rc = om ? ble_gattc_notify_custom(conn, handle, om) : BLE_HS_ENOMEM;
+        if (rc == BLE_HS_ENOMEM)
+        {
+            vTaskDelay(1);
+            continue;
+        }
+        if (rc != 0)
+        {
+            portENTER_CRITICAL(&_mux);
+            _progress.state = BLEXFER_FAILED;
+            portEXIT_CRITICAL(&_mux);
+            return false;
+        }
+        _bufferPos += n;
+        sent += n;
+    }
+
+    portENTER_CRITICAL(&_mux);
+    _progress.bytes += sent;
+    portEXIT_CRITICAL(&_mux);
+
+    return _bufferPos < _bufferLen || _offset < _progress.size;
+}
+
+void EARS_bleTransfer::finish(EARS_bleTransferState state)
+{
+    if (state == BLEXFER_DONE || state == BLEXFER_CANCELLED)
+    {
+        sendInfo(state == BLEXFER_DONE ? BLEXFER_INFO_END : BLEXFER_INFO_CANCEL);
+    }
+
+    heap_caps_free(_buffer);
+    _buffer = nullptr;
+
+    portENTER_CRITICAL(&_mux);
+    _progress.state = state;
+    portEXIT_CRITICAL(&_mux);
+
+#if EARS_DEBUG == 1
+    Serial.printf("[BLEXFER] %s: state %u, %lu/%lu bytes, %lu ms, %lu B/s, MTU %u, %s\n",
+                  _path, (unsigned)state, (unsigned long)_progress.bytes, (unsigned long)_progress.size,
+                  (unsigned long)_progress.elapsedMs, (unsigned long)_progress.bytesPerSecond,
+                  (unsigned)_progress.mtu, _progress.phy2M ? "2M" : "1M");
+#endif
+}
+
+void EARS_bleTransfer::report()
+{
+    if (_callback)
+    {
+        EARS_bleTransferProgress progress = getProgress();
+        _callback(progress, _ctx);
+    }
+}
+
+void EARS_bleTransfer::service()
+{
+    portENTER_CRITICAL(&_mux);
+    EARS_bleTransferState state = _progress.state;
+    bool ready = _conn != BLE_HS_CONN_HANDLE_NONE && _subscribed;
+    portEXIT_CRITICAL(&_mux);
+
+    if (state != BLEXFER_WAITING && state != BLEXFER_SENDING)
+    {
+        return;
+    }
+
+    if (state == BLEXFER_WAITING)
+    {
+        if (_cancel)
+        {
+            portENTER_CRITICAL(&_mux);
+            _progress.state = BLEXFER_CANCELLED;
+            portEXIT_CRITICAL(&_mux);
+            report();
+            return;
+        }
+        if (!ready)
+        {
+            return;
+        }
+        if (!open())
+        {
+            finish(BLEXFER_FAILED);
+            report();
+            return;
+        }
+        portENTER_CRITICAL(&_mux);
+        _progress.state = BLEXFER_SENDING;
+        portEXIT_CRITICAL(&_mux);
+    }
+
+    uint32_t deadlineMs = millis() + BLEXFER_SLICE_MS;
+    bool more = sendSlice(deadlineMs);
+
+    uint32_t elapsedMs = millis() - _startMs;
+    portENTER_CRITICAL(&_mux);
+    _progress.elapsedMs = elapsedMs;
+    _progress.bytesPerSecond = elapsedMs ? (uint32_t)((uint64_t)_progress.bytes * 1000 / elapsedMs) : 0;
+    portEXIT_CRITICAL(&_mux);
+
+    if (_cancel)
+    {
+        finish(BLEXFER_CANCELLED);
+    }
+    else if (!more)
+    {
+        portENTER_CRITICAL(&_mux);
+        bool failed = _progress.state == BLEXFER_FAILED;
+        portEXIT_CRITICAL(&_mux);
+        finish(failed ? BLEXFER_FAILED : BLEXFER_DONE);
+    }
+    report();
+}
+
+/******************************************************************************
+ * Version Information
+ *****************************************************************************/
+const char* EARS_bleTransfer::getLibraryName()
+{
+    return EARS_BleTransfer::LIB_NAME;
+}
+
+uint32_t EARS_bleTransfer::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_BleTransfer::VERSION_MAJOR,
+                       EARS_BleTransfer::VERSION_MINOR,
+                       EARS_BleTransfer::VERSION_PATCH);
+}
+
+const char* EARS_bleTransfer::getVersionDate()
+{
+    return EARS_BleTransfer::VERSION_DATE;
+}
+
+void EARS_bleTransfer::getVersionString(char* buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+EARS_bleTransfer &using_bletransfer()
+{
+    static EARS_bleTransfer instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_bleTransferLib.cpp
+ *****************************************************************************/
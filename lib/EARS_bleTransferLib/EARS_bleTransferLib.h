@@ -0,0 +1,247 @@
+/**
+ * @file EARS_bleTransferLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Report files to a companion phone over BLE (NimBLE)
+ * @details Where there is no Wi-Fi, a finished report is sent from the SD
+ *          card to a phone as GATT notifications. Throughput comes from the
+ *          link, not the characteristic:
+ *
+ *          - MTU BLEXFER_MTU, so each notification carries MTU - 3 bytes
+ *          - the 2M PHY and data length extension (BLEXFER_DATA_LEN octets
+ *            per link-layer packet) requested as soon as a phone connects
+ *          - a short connection interval (BLEXFER_INTERVAL_MIN/MAX) so the
+ *            controller sends several packets every connection event
+ *          - notifications queued straight to the host (no response per
+ *            packet); when its buffers run out the send waits a tick and
+ *            carries on, so the queue stays full without dropping anything
+ *
+ *          The file is read BLEXFER_BUFFER_BYTES at a time into one fixed
+ *          buffer, so a multi-megabyte report needs no more memory than a
+ *          small one. Sending runs in slices of BLEXFER_SLICE_MS from
+ *          service() on Core 1, like a report.
+ *
+ *          Protocol (service BLEXFER_SERVICE_UUID, little-endian):
+ *          - Info (read, notify): one EARS_bleTransferInfo when a transfer
+ *            starts (size, name), ends (size, CRC-32 of the file) or is
+ *            cancelled
+ *          - Data (notify): the file's bytes in order, MTU - 3 per
+ *            notification; the phone appends them
+ *          - Control (write): BLEXFER_CONTROL_CANCEL stops the transfer
+ *          A transfer waits until the phone has subscribed to Data. A
+ *          dropped connection fails the transfer; it is started again.
+ *
+ *          The progress callback runs on Core 1 after every slice; UI code
+ *          posts it on with MAIN_ui_cmd_call().
+ *
+ *          Build with -D EARS_BLE_TRANSFER=1 to advertise from boot. The
+ *          link is not paired or encrypted.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_BLE_TRANSFER_LIB_H__
+#define __EARS_BLE_TRANSFER_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include "EARS_versionDef.h"
+#include "EARS_sdCardLib.h"
+
+class NimBLECharacteristic;
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_BleTransfer
+{
+    constexpr const char* LIB_NAME = "EARS_bleTransfer";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+
+// 1 = BLE transfer service advertised from boot
+#ifndef EARS_BLE_TRANSFER
+#define EARS_BLE_TRANSFER 0
+#endif
+
+#define BLEXFER_DEVICE_NAME "EARS"
+#define BLEXFER_SERVICE_UUID "45415253-0000-4b1e-9a4e-7265706f7274"
+#define BLEXFER_INFO_UUID "45415253-0001-4b1e-9a4e-7265706f7274"
+#define BLEXFER_DATA_UUID "45415253-0002-4b1e-9a4e-7265706f7274"
+#define BLEXFER_CONTROL_UUID "45415253-0003-4b1e-9a4e-7265706f7274"
+
+#define BLEXFER_MTU 517                 // Largest ATT MTU offered
+#define BLEXFER_DATA_LEN 251            // Link-layer payload octets (DLE)
+#define BLEXFER_DATA_TIME 2120          // Microseconds for one such packet
+#define BLEXFER_INTERVAL_MIN 6          // 7.5 ms, in 1.25 ms units
+#define BLEXFER_INTERVAL_MAX 12         // 15 ms
+#define BLEXFER_SUPERVISION 400         // 4 s, in 10 ms units
+#define BLEXFER_BUFFER_BYTES 8192       // File read buffer
+#define BLEXFER_SLICE_MS 40             // Work per service() call
+#define BLEXFER_SERVICE_PERIOD_MS 10    // Suggested job period
+#define BLEXFER_NAME_BYTES 48           // Longest file name sent + NUL
+
+// EARS_bleTransferInfo.kind
+#define BLEXFER_INFO_START 1
+#define BLEXFER_INFO_END 2
+#define BLEXFER_INFO_CANCEL 3
+
+// Control characteristic
+#define BLEXFER_CONTROL_CANCEL 0x01
+
+/**
+ * @brief Info characteristic value
+ */
+struct __attribute__((packed)) EARS_bleTransferInfo
+{
+    uint8_t kind;               // BLEXFER_INFO_*
+    uint8_t reserved[3];
+    uint32_t size;              // File bytes
+    uint32_t crc;               // CRC-32 (zlib) of the file, with BLEXFER_INFO_END
+    char name[BLEXFER_NAME_BYTES];
+};
+
+/**
+ * @brief Transfer life cycle
+ */
+enum EARS_bleTransferState : uint8_t
+{
+    BLEXFER_IDLE = 0,
+    BLEXFER_WAITING,            // Accepted, for a phone to connect and subscribe
+    BLEXFER_SENDING,
+    BLEXFER_DONE,
+    BLEXFER_FAILED,
+    BLEXFER_CANCELLED
+};
+
+/**
+ * @brief Where a transfer has got to
+ */
+struct EARS_bleTransferProgress
+{
+    EARS_bleTransferState state;
+    uint32_t bytes;             // Queued to the phone
+    uint32_t size;              // File size
+    uint32_t elapsedMs;         // Since sending started
+    uint32_t bytesPerSecond;
+    uint16_t mtu;               // Negotiated ATT MTU
+    bool phy2M;                 // Link on the 2M PHY
+};
+
+/**
+ * @brief Progress report (Core 1)
+ * @param progress Snapshot after the latest slice
+ * @param ctx Context given to start()
+ */
+typedef void (*EARS_bleTransferProgressCb)(const EARS_bleTransferProgress& progress, void* ctx);
+
+/******************************************************************************
+ * EARS_bleTransfer Class
+ *****************************************************************************/
+class EARS_bleTransfer
+{
+public:
+    EARS_bleTransfer();
+
+    // Version information getters
+    static const char* getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char* getVersionDate();
+    static void getVersionString(char* buffer);
+
+    /**
+     * @brief Start NimBLE, create the service and advertise
+     * @return true if advertising
+     */
+    bool begin();
+
+    bool isRunning() const { return _running; }
+    bool isConnected() const;
+
+    /**
+     * @brief Queue a file to send
+     * @param sdCard Mounted SD card
+     * @param path File to send (a finished report)
+     * @param callback Progress callback, NULL for none
+     * @param ctx Passed to callback
+     * @return true if accepted (running, and no transfer in progress)
+     */
+    bool start(EARS_sdCard* sdCard, const char* path, EARS_bleTransferProgressCb callback, void* ctx);
+
+    /**
+     * @brief Stop the transfer at the end of its slice
+     */
+    void cancel();
+
+    /**
+     * @brief Run one slice of the current transfer
+     * @details Call periodically from Core 1 (BLEXFER_SERVICE_PERIOD_MS)
+     */
+    void service();
+
+    bool isBusy() const;
+    EARS_bleTransferProgress getProgress() const;
+
+private:
+    friend class EARS_bleTransferCallbacks;
+
+    bool _running;
+    NimBLECharacteristic* _info;
+    NimBLECharacteristic* _data;
+
+    // Link (NimBLE host task, under _mux)
+    uint16_t _conn;              // BLE_HS_CONN_HANDLE_NONE when not connected
+    uint16_t _mtu;
+    bool _subscribed;            // Phone subscribed to Data
+    bool _phy2M;
+
+    // Request (written while idle, under _mux)
+    EARS_sdCard* _sdCard;
+    char _path[64];
+    EARS_bleTransferProgressCb _callback;
+    void* _ctx;
+    volatile bool _cancel;
+
+    // Working state (Core 1 only)
+    uint8_t* _buffer;            // BLEXFER_BUFFER_BYTES
+    size_t _bufferLen;
+    size_t _bufferPos;
+    uint32_t _offset;            // File offset of the next read
+    uint32_t _crc;
+    uint32_t _startMs;
+
+    EARS_bleTransferProgress _progress;
+    mutable portMUX_TYPE _mux;
+
+    bool open();
+    bool sendInfo(uint8_t kind);
+    bool sendSlice(uint32_t deadlineMs);
+    void finish(EARS_bleTransferState state);
+    void report();
+
+    void onConnect(uint16_t conn);
+    void onDisconnect();
+    void onMtu(uint16_t mtu);
+    void onSubscribe(bool subscribed);
+};
+
+// Global instance access function (Singleton pattern)
+EARS_bleTransfer &using_bletransfer();
+
+#endif // __EARS_BLE_TRANSFER_LIB_H__
+
+/******************************************************************************
+ * End of EARS_bleTransferLib.h
+ ******************************************************************************/
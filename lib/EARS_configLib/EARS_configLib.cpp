@@ -0,0 +1,803 @@
+/**
+ * @file EARS_configLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Centralised in-memory service for the unified ears.config file
+ * @version 1.8.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EARS_configLib.h"
+#include "EARS_systemDef.h"
+#include <esp_timer.h>
+#include <esp_rom_crc.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Journal Format
+ *****************************************************************************/
+#define CONFIG_JOURNAL_MAGIC 0x4C4E4A43 // "CJNL"
+#define CONFIG_JOURNAL_LAYOUT (CONFIG_SNAPSHOT_LAYOUT >> 16)
+
+// <file>.jnl: this header, then entries
+struct JournalHeader
+{
+    uint32_t magic;
+    uint32_t layout;       // Field meanings; sizes are checked per entry
+    SDSnapshotKey base;    // The file the entries apply to
+    uint32_t crc;          // CRC-32 of the fields above
+};
+
+// One section image: this, then length bytes
+struct JournalEntry
+{
+    uint32_t sequence;
+    uint8_t section;       // One EARS_configSection bit
+    uint8_t reserved;
+    uint16_t length;       // Section size when written
+    uint32_t crc;          // CRC-32 of the fields above, then the image
+};
+
+#define CONFIG_JOURNAL_APPEND_MAX (sizeof(JournalHeader) + 6 * sizeof(JournalEntry) + sizeof(EARS_configData))
+
+static uint32_t entryCrc(const JournalEntry& entry, const uint8_t* data)
+{
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)&entry, offsetof(JournalEntry, crc));
+    return esp_rom_crc32_le(crc, data, entry.length);
+}
+
+/******************************************************************************
+ * Helpers
+ *****************************************************************************/
+
+// Copy a JSON string into a fixed field, leaving it alone if absent
+static void copyField(char* dest, size_t size, JsonVariantConst value)
+{
+    const char* text = value.as<const char*>();
+    if (text)
+    {
+        strlcpy(dest, text, size);
+    }
+}
+
+// Existing section object (extra keys kept), created if absent
+static JsonObject sectionObject(JsonDocument& doc, const char* key)
+{
+    JsonObject obj = doc[key];
+    return obj.isNull() ? doc[key].to<JsonObject>() : obj;
+}
+
+/******************************************************************************
+ * Construction
+ *****************************************************************************/
+EARS_config::EARS_config()
+    : _sdCard(nullptr),
+      _mutex(nullptr),
+      _begun(false),
+      _loaded(false),
+      _dirty(0),
+      _lastChangeMs(0),
+      _loadReport(),
+      _saves(0),
+      _checkpoints(0),
+      _haveBase(false),
+      _journalBytes(0),
+      _journalSequence(0),
+      _journalMask(0),
+      _replayed(0)
+{
+    _path[0] = '\0';
+    _snapshotPath[0] = '\0';
+    _journalPath[0] = '\0';
+    memset(&_baseKey, 0, sizeof(_baseKey));
+    setDefaults(_data);
+}
+
+/**
+ * @brief Fill every section with the factory defaults
+ */
+void EARS_config::setDefaults(EARS_configData& data)
+{
+    memset(&data, 0, sizeof(data));
+
+    strlcpy(data.system.version, "1.0.0", sizeof(data.system.version));
+    strlcpy(data.system.deviceName, "EARS", sizeof(data.system.deviceName));
+
+    data.logger.maxFileSizeBytes = 1048576;
+    data.logger.flushIntervalMs = 2000;
+    data.logger.maxRotatedFiles = 3;
+    data.logger.buffered = true;
+    data.logger.async = true;
+    data.logger.binary = false;
+    data.logger.preallocate = true;
+    data.logger.compressRotated = true;
+    strlcpy(data.logger.logLevel, "DEBUG", sizeof(data.logger.logLevel));
+    strlcpy(data.logger.overflowPolicy, "DROP_OLDEST", sizeof(data.logger.overflowPolicy));
+    strlcpy(data.logger.lvglLogLevel, "WARN", sizeof(data.logger.lvglLogLevel));
+
+    data.display.brightness = 80;
+    data.display.timeoutSeconds = 30;
+    strlcpy(data.display.theme, "default", sizeof(data.display.theme));
+
+    data.network.syncIntervalMinutes = 15;
+
+    data.security.requirePassword = true;
+    data.security.autoLockMinutes = 5;
+
+    strlcpy(data.application.units, "metric", sizeof(data.application.units));
+    strlcpy(data.application.language, "en", sizeof(data.application.language));
+    strlcpy(data.application.dateFormat, "YYYY-MM-DD", sizeof(data.application.dateFormat));
+    strlcpy(data.application.timeFormat, "24h", sizeof(data.application.timeFormat));
+}
+
+/**
+ * @brief Copy the parsed document into the typed sections
+ * @details Missing keys keep the value already in data (the defaults)
+ */
+void EARS_config::readSections(JsonDocument& doc, EARS_configData& data)
+{
+    JsonObjectConst sys = doc["system"];
+    copyField(data.system.version, sizeof(data.system.version), sys["version"]);
+    copyField(data.system.zapNumber, sizeof(data.system.zapNumber), sys["zap_number"]);
+    copyField(data.system.deviceName, sizeof(data.system.deviceName), sys["device_name"]);
+    copyField(data.system.created, sizeof(data.system.created), sys["created"]);
+    copyField(data.system.lastModified, sizeof(data.system.lastModified), sys["last_modified"]);
+
+    JsonObjectConst log = doc["logger"];
+    EARS_configLogger& lg = data.logger;
+    lg.maxFileSizeBytes = log["max_file_size_bytes"] | lg.maxFileSizeBytes;
+    lg.flushIntervalMs = log["flush_interval_ms"] | lg.flushIntervalMs;
+    lg.maxRotatedFiles = log["max_rotated_files"] | lg.maxRotatedFiles;
+    lg.buffered = log["buffered"] | lg.buffered;
+    lg.async = log["async"] | lg.async;
+    lg.binary = log["binary"] | lg.binary;
+    lg.preallocate = log["preallocate"] | lg.preallocate;
+    lg.compressRotated = log["compress_rotated"] | lg.compressRotated;
+    copyField(lg.logLevel, sizeof(lg.logLevel), log["log_level"]);
+    copyField(lg.overflowPolicy, sizeof(lg.overflowPolicy), log["overflow_policy"]);
+    copyField(lg.lvglLogLevel, sizeof(lg.lvglLogLevel), log["lvgl_log_level"]);
+
+    JsonObjectConst disp = doc["display"];
+    data.display.brightness = disp["brightness"] | data.display.brightness;
+    data.display.timeoutSeconds = disp["timeout_seconds"] | data.display.timeoutSeconds;
+    copyField(data.display.theme, sizeof(data.display.theme), disp["theme"]);
+
+    JsonObjectConst net = doc["network"];
+    data.network.wifiEnabled = net["wifi_enabled"] | data.network.wifiEnabled;
+    data.network.autoConnect = net["auto_connect"] | data.network.autoConnect;
+    copyField(data.network.ssid, sizeof(data.network.ssid), net["ssid"]);
+    copyField(data.network.password, sizeof(data.network.password), net["password"]);
+    copyField(data.network.syncUrl, sizeof(data.network.syncUrl), net["sync_url"]);
+    data.network.syncIntervalMinutes = net["sync_interval_minutes"] | data.network.syncIntervalMinutes;
+
+    JsonObjectConst sec = doc["security"];
+    data.security.requirePassword = sec["require_password"] | data.security.requirePassword;
+    data.security.autoLockMinutes = sec["auto_lock_minutes"] | data.security.autoLockMinutes;
+    copyField(data.security.peerKey, sizeof(data.security.peerKey), sec["peer_key"]);
+    copyField(data.security.mirrorToken, sizeof(data.security.mirrorToken), sec["mirror_token"]);
+
+    JsonObjectConst app = doc["application"];
+    EARS_configApplication& ap = data.application;
+    copyField(ap.units, sizeof(ap.units), app["units"]);
+    copyField(ap.language, sizeof(ap.language), app["language"]);
+    copyField(ap.dateFormat, sizeof(ap.dateFormat), app["date_format"]);
+    copyField(ap.timeFormat, sizeof(ap.timeFormat), app["time_format"]);
+}
+
+/**
+ * @brief Write the sections selected by mask back into the document
+ */
+void EARS_config::writeSections(JsonDocument& doc, const EARS_configData& data, uint8_t mask)
+{
+    if (mask & CONFIG_SECTION_SYSTEM)
+    {
+        JsonObject sys = sectionObject(doc, "system");
+        sys["version"] = data.system.version;
+        sys["zap_number"] = data.system.zapNumber;
+        sys["device_name"] = data.system.deviceName;
+        sys["created"] = data.system.created;
+        sys["last_modified"] = data.system.lastModified;
+    }
+
+    if (mask & CONFIG_SECTION_LOGGER)
+    {
+        JsonObject log = sectionObject(doc, "logger");
+        log["log_level"] = data.logger.logLevel;
+        log["max_file_size_bytes"] = data.logger.maxFileSizeBytes;
+        log["max_rotated_files"] = data.logger.maxRotatedFiles;
+        log["buffered"] = data.logger.buffered;
+        log["flush_interval_ms"] = data.logger.flushIntervalMs;
+        log["async"] = data.logger.async;
+        log["overflow_policy"] = data.logger.overflowPolicy;
+        log["binary"] = data.logger.binary;
+        log["preallocate"] = data.logger.preallocate;
+        log["compress_rotated"] = data.logger.compressRotated;
+        log["lvgl_log_level"] = data.logger.lvglLogLevel;
+    }
+
+    if (mask & CONFIG_SECTION_DISPLAY)
+    {
+        JsonObject disp = sectionObject(doc, "display");
+        disp["brightness"] = data.display.brightness;
+        disp["timeout_seconds"] = data.display.timeoutSeconds;
+        disp["theme"] = data.display.theme;
+    }
+
+    if (mask & CONFIG_SECTION_NETWORK)
+    {
+        JsonObject net = sectionObject(doc, "network");
+        net["wifi_enabled"] = data.network.wifiEnabled;
+        net["ssid"] = data.network.ssid;
+        net["auto_connect"] = data.network.autoConnect;
+        net["password"] = data.network.password;
+        net["sync_url"] = data.network.syncUrl;
+        net["sync_interval_minutes"] = data.network.syncIntervalMinutes;
+    }
+
+    if (mask & CONFIG_SECTION_SECURITY)
+    {
+        JsonObject sec = sectionObject(doc, "security");
+        sec["require_password"] = data.security.requirePassword;
+        sec["auto_lock_minutes"] = data.security.autoLockMinutes;
+        sec["peer_key"] = data.security.peerKey;
+        sec["mirror_token"] = data.security.mirrorToken;
+    }
+
+    if (mask & CONFIG_SECTION_APPLICATION)
+    {
+        JsonObject app = sectionObject(doc, "application");
+        app["units"] = data.application.units;
+        app["language"] = data.application.language;
+        app["date_format"] = data.application.dateFormat;
+        app["time_format"] = data.application.timeFormat;
+    }
+}
+
+/**
+ * @brief Locate one section's bytes inside data
+ * @param section One EARS_configSection bit
+ * @param length Set to the section size
+ * @return Section start, NULL for an unknown bit
+ */
+uint8_t* EARS_config::sectionData(EARS_configData& data, uint8_t section, size_t& length)
+{
+    switch (section)
+    {
+    case CONFIG_SECTION_SYSTEM:
+        length = sizeof(data.system);
+        return (uint8_t *)&data.system;
+    case CONFIG_SECTION_LOGGER:
+        length = sizeof(data.logger);
+        return (uint8_t *)&data.logger;
+    case CONFIG_SECTION_DISPLAY:
+        length = sizeof(data.display);
+        return (uint8_t *)&data.display;
+    case CONFIG_SECTION_NETWORK:
+        length = sizeof(data.network);
+        return (uint8_t *)&data.network;
+    case CONFIG_SECTION_SECURITY:
+        length = sizeof(data.security);
+        return (uint8_t *)&data.security;
+    case CONFIG_SECTION_APPLICATION:
+        length = sizeof(data.application);
+        return (uint8_t *)&data.application;
+    default:
+        length = 0;
+        return nullptr;
+    }
+}
+
+/******************************************************************************
+ * Loading
+ *****************************************************************************/
+
+/**
+ * @brief Stream the file into doc through a read buffer
+ * @param filter Subtrees to keep, NULL for the whole document
+ * @param report Optional cost report
+ */
+static bool readDocument(EARS_sdCard* sdCard, const char* path, JsonDocument& doc,
+                         const JsonDocument* filter, SDParseReport* report)
+{
+    int64_t startUs = esp_timer_get_time();
+    uint32_t heapBefore = ESP.getFreeHeap();
+
+    File file = sdCard->openRead(path);
+    if (!file)
+    {
+        return false;
+    }
+
+    EARS_sdReader reader(file);
+    DeserializationError error = filter
+        ? deserializeJson(doc, reader, DeserializationOption::Filter(*filter))
+        : deserializeJson(doc, reader);
+    file.close();
+
+    if (report)
+    {
+        uint32_t heapAfter = ESP.getFreeHeap();
+        report->parseUs = (uint32_t)(esp_timer_get_time() - startUs);
+        report->bytesRead = reader.bytesRead();
+        report->heapUsed = (heapBefore > heapAfter) ? heapBefore - heapAfter : 0;
+    }
+
+    return reader.bytesRead() > 0 && !error;
+}
+
+bool EARS_config::begin(EARS_sdCard* sdCard, const char* path)
+{
+    if (_begun)
+    {
+        return _loaded;
+    }
+
+    if (!sdCard || !sdCard->isAvailable())
+    {
+        return false;
+    }
+
+    if (!_mutex)
+    {
+        _mutex = xSemaphoreCreateMutex();
+        if (!_mutex)
+        {
+            return false;
+        }
+    }
+
+    _sdCard = sdCard;
+    strlcpy(_path, path, sizeof(_path));
+    snprintf(_snapshotPath, sizeof(_snapshotPath), "%s%s", _path, CONFIG_SNAPSHOT_SUFFIX);
+    snprintf(_journalPath, sizeof(_journalPath), "%s%s", _path, CONFIG_JOURNAL_SUFFIX);
+    _begun = true;
+
+    // Finish a rewrite cut short by a reset before reading
+    _sdCard->recoverAtomicWrite(_path);
+
+#if CONFIG_SNAPSHOT_ENABLED == 1
+    int64_t startUs = esp_timer_get_time();
+#endif
+    // Identifies the file for the snapshot and the journal
+    SDSnapshotKey key;
+    bool haveKey = _sdCard->getSnapshotKey(_path, key);
+
+#if CONFIG_SNAPSHOT_ENABLED == 1
+    // Unchanged source: block-read the parsed image, no JSON at all
+    if (haveKey &&
+        _sdCard->readSnapshot(_snapshotPath, key, CONFIG_SNAPSHOT_LAYOUT, &_data, sizeof(_data)) == sizeof(_data))
+    {
+        _loaded = true;
+        _loadReport.fromSnapshot = true;
+        _loadReport.parseUs = (uint32_t)(esp_timer_get_time() - startUs);
+        _loadReport.bytesRead = sizeof(_data);
+    }
+    else
+    {
+        // A partial read may have landed in _data
+        setDefaults(_data);
+    }
+#endif
+
+    if (!_loaded)
+    {
+        // Only the sections held here are materialised
+        JsonDocument filter;
+        filter["system"] = true;
+        filter["logger"] = true;
+        filter["display"] = true;
+        filter["network"] = true;
+        filter["security"] = true;
+        filter["application"] = true;
+
+        JsonDocument doc;
+        _loaded = readDocument(_sdCard, _path, doc, &filter, &_loadReport);
+        if (_loaded)
+        {
+            readSections(doc, _data);
+        }
+    }
+
+#if CONFIG_SNAPSHOT_ENABLED == 1
+    if (_loaded && !_loadReport.fromSnapshot && haveKey)
+    {
+        _sdCard->writeSnapshot(_snapshotPath, key, CONFIG_SNAPSHOT_LAYOUT, &_data, sizeof(_data));
+    }
+#endif
+
+    // Changes made since the file was last rewritten
+    _haveBase = _loaded && haveKey;
+    if (_haveBase)
+    {
+        _baseKey = key;
+    }
+    replayJournal();
+
+    if (!_loaded)
+    {
+        // Missing or corrupt: write the defaults out on the next service()
+        _dirty = CONFIG_SECTION_ALL;
+        _lastChangeMs = millis();
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[CONFIG] %s %s: %lu bytes in %lu us, %lu bytes heap, %u journal entries\n", _path,
+                  _loadReport.fromSnapshot ? "from snapshot"
+                  : _loaded                ? "parsed"
+                                           : "missing, using defaults",
+                  (unsigned long)_loadReport.bytesRead,
+                  (unsigned long)_loadReport.parseUs,
+                  (unsigned long)_loadReport.heapUsed,
+                  (unsigned)_replayed);
+#endif
+
+    return _loaded;
+}
+
+/******************************************************************************
+ * Updates
+ *****************************************************************************/
+void EARS_config::update(void* dest, const void* src, size_t length, uint8_t section)
+{
+    lock();
+    if (memcmp(dest, src, length) != 0)
+    {
+        memcpy(dest, src, length);
+        _dirty |= section;
+        _lastChangeMs = millis();
+    }
+    unlock();
+}
+
+void EARS_config::setSystem(const EARS_configSystem& section)
+{
+    update(&_data.system, &section, sizeof(section), CONFIG_SECTION_SYSTEM);
+}
+
+void EARS_config::setLogger(const EARS_configLogger& section)
+{
+    update(&_data.logger, &section, sizeof(section), CONFIG_SECTION_LOGGER);
+}
+
+void EARS_config::setDisplay(const EARS_configDisplay& section)
+{
+    update(&_data.display, &section, sizeof(section), CONFIG_SECTION_DISPLAY);
+}
+
+void EARS_config::setNetwork(const EARS_configNetwork& section)
+{
+    update(&_data.network, &section, sizeof(section), CONFIG_SECTION_NETWORK);
+}
+
+void EARS_config::setSecurity(const EARS_configSecurity& section)
+{
+    update(&_data.security, &section, sizeof(section), CONFIG_SECTION_SECURITY);
+}
+
+void EARS_config::setApplication(const EARS_configApplication& section)
+{
+    update(&_data.application, &section, sizeof(section), CONFIG_SECTION_APPLICATION);
+}
+
+/******************************************************************************
+ * Journal
+ *****************************************************************************/
+
+/**
+ * @brief Apply the journal entries written since the file was last rewritten
+ * @details Stops at the first entry that is short or fails its CRC, the
+ *          tail of an append cut short, and truncates the journal there.
+ *          A journal for some other version of the file is removed.
+ */
+void EARS_config::replayJournal()
+{
+    uint32_t size = _sdCard->getFileSize(_journalPath);
+    if (size == 0)
+    {
+        return;
+    }
+
+    uint8_t *image = (_haveBase && size <= CONFIG_JOURNAL_MAX_BYTES) ? (uint8_t *)malloc(size) : nullptr;
+    uint32_t good = 0;
+
+    if (image && size >= sizeof(JournalHeader) && _sdCard->readInto(_journalPath, image, size) == size)
+    {
+        JournalHeader header;
+        memcpy(&header, image, sizeof(header));
+
+        if (header.magic == CONFIG_JOURNAL_MAGIC &&
+            header.layout == CONFIG_JOURNAL_LAYOUT &&
+            header.crc == esp_rom_crc32_le(0, (const uint8_t *)&header, offsetof(JournalHeader, crc)) &&
+            memcmp(&header.base, &_baseKey, sizeof(_baseKey)) == 0)
+        {
+            good = sizeof(header);
+            while (good + sizeof(JournalEntry) <= size)
+            {
+                JournalEntry entry;
+                memcpy(&entry, image + good, sizeof(entry));
+                const uint8_t *bytes = image + good + sizeof(entry);
+                if (good + sizeof(entry) + entry.length > size || entry.crc != entryCrc(entry, bytes))
+                {
+                    break;
+                }
+
+                // A section whose size changed with the firmware is skipped
+                size_t length;
+                uint8_t *dest = sectionData(_data, entry.section, length);
+                if (dest && length == entry.length)
+                {
+                    memcpy(dest, bytes, length);
+                    _journalMask |= entry.section;
+                    _replayed++;
+                }
+                _journalSequence = entry.sequence;
+                good += sizeof(entry) + entry.length;
+            }
+        }
+    }
+    free(image);
+
+    if (good == 0)
+    {
+        _sdCard->removeFile(_journalPath);
+    }
+    else if (good < size)
+    {
+        _sdCard->truncateFile(_journalPath, good);
+    }
+    _journalBytes = good;
+}
+
+/**
+ * @brief Append the sections in mask to the journal as one write
+ * @return false if the journal is full or the append failed (nothing
+ *         partial is left behind)
+ */
+bool EARS_config::appendJournal(EARS_configData& snapshot, uint8_t mask)
+{
+    uint8_t *image = (uint8_t *)malloc(CONFIG_JOURNAL_APPEND_MAX);
+    if (!image)
+    {
+        return false;
+    }
+
+    size_t used = 0;
+    if (_journalBytes == 0)
+    {
+        JournalHeader header;
+        header.magic = CONFIG_JOURNAL_MAGIC;
+        header.layout = CONFIG_JOURNAL_LAYOUT;
+        header.base = _baseKey;
+        header.crc = esp_rom_crc32_le(0, (const uint8_t *)&header, offsetof(JournalHeader, crc));
+        memcpy(image, &header, sizeof(header));
+        used = sizeof(header);
+    }
+
+    uint32_t sequence = _journalSequence;
+    for (uint8_t bit = 1; bit & CONFIG_SECTION_ALL; bit <<= 1)
+    {
+        size_t length;
+        uint8_t *data = (mask & bit) ? sectionData(snapshot, bit, length) : nullptr;
+        if (!data)
+        {
+            continue;
+        }
+
+        JournalEntry entry;
+        entry.sequence = ++sequence;
+        entry.section = bit;
+        entry.reserved = 0;
+        entry.length = (uint16_t)length;
+        entry.crc = entryCrc(entry, data);
+        memcpy(image + used, &entry, sizeof(entry));
+        memcpy(image + used + sizeof(entry), data, length);
+        used += sizeof(entry) + length;
+    }
+
+    if (_journalBytes + used > CONFIG_JOURNAL_MAX_BYTES)
+    {
+        free(image);
+        return false;
+    }
+
+    bool ok = _sdCard->appendData(_journalPath, image, used);
+    _sdCard->flush(_journalPath);
+    free(image);
+
+    if (ok)
+    {
+        _journalBytes += used;
+        _journalSequence = sequence;
+        _journalMask |= mask;
+    }
+    else if (!_sdCard->truncateFile(_journalPath, _journalBytes))
+    {
+        // A torn entry would hide later ones: rewrite the file until it is retired
+        _haveBase = false;
+    }
+    return ok;
+}
+
+/******************************************************************************
+ * Saving
+ *****************************************************************************/
+void EARS_config::service()
+{
+    if (_dirty == 0 || !_sdCard)
+    {
+        return;
+    }
+
+    if (millis() - _lastChangeMs < CONFIG_SAVE_DELAY_MS)
+    {
+        return;
+    }
+
+    save(false);
+}
+
+bool EARS_config::flush()
+{
+    if (_dirty == 0)
+    {
+        return true;
+    }
+    if (!_sdCard)
+    {
+        return false;
+    }
+    return save(false);
+}
+
+bool EARS_config::checkpoint()
+{
+    if (!_sdCard)
+    {
+        return false;
+    }
+    return save(true);
+}
+
+/**
+ * @brief Journal the dirty sections, or fold everything into the file
+ * @param fold Rewrite the file even if the journal has room
+ */
+bool EARS_config::save(bool fold)
+{
+    // Snapshot under the lock so setters never wait on the card
+    EARS_configData snapshot;
+    lock();
+    uint8_t mask = _dirty;
+    snapshot = _data;
+    _dirty = 0;
+    unlock();
+
+    if (mask == 0 && !(fold && _journalMask))
+    {
+        return true;
+    }
+
+    // The journal needs a file to extend; when full it is folded in
+    bool journaled = !fold && _haveBase && appendJournal(snapshot, mask);
+    bool ok = journaled || rewrite(snapshot, mask | _journalMask);
+
+    if (ok)
+    {
+        _saves++;
+    }
+    else
+    {
+        // Try again after the next quiet period
+        lock();
+        _dirty |= mask;
+        _lastChangeMs = millis();
+        unlock();
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[CONFIG] Saved sections 0x%02X to the %s: %s\n", mask,
+                  journaled ? "journal" : "file", ok ? "OK" : "FAILED");
+#endif
+
+    return ok;
+}
+
+/**
+ * @brief Merge sections into the file, replace it atomically, retire the journal
+ */
+bool EARS_config::rewrite(const EARS_configData& snapshot, uint8_t mask)
+{
+    // Keep sections and keys owned by nobody here
+    JsonDocument doc;
+    if (!readDocument(_sdCard, _path, doc, nullptr, nullptr))
+    {
+        doc.clear();
+        mask = CONFIG_SECTION_ALL;
+    }
+    writeSections(doc, snapshot, mask);
+
+    String json;
+    serializeJsonPretty(doc, json);
+    if (!_sdCard->writeFileAtomic(_path, json))
+    {
+        return false;
+    }
+    _checkpoints++;
+
+    // Everything journaled is in the file now; the next journal extends it.
+    // A reset before the remove leaves a journal naming the old file,
+    // which begin() discards.
+    _haveBase = _sdCard->getSnapshotKey(_path, _baseKey);
+    if (_journalBytes > 0)
+    {
+        _sdCard->removeFile(_journalPath);
+    }
+    _journalBytes = 0;
+    _journalMask = 0;
+
+#if CONFIG_SNAPSHOT_ENABLED == 1
+    // The file now matches the snapshot data, so the next boot can skip the parse
+    if (_haveBase)
+    {
+        _sdCard->writeSnapshot(_snapshotPath, _baseKey, CONFIG_SNAPSHOT_LAYOUT, &snapshot, sizeof(snapshot));
+    }
+#endif
+
+    return true;
+}
+
+void EARS_config::lock()
+{
+    if (_mutex)
+    {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+    }
+}
+
+void EARS_config::unlock()
+{
+    if (_mutex)
+    {
+        xSemaphoreGive(_mutex);
+    }
+}
+
+/******************************************************************************
+ * Version Information
+ *****************************************************************************/
+const char* EARS_config::getLibraryName()
+{
+    return EARS_Config::LIB_NAME;
+}
+
+uint32_t EARS_config::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_Config::VERSION_MAJOR,
+                       EARS_Config::VERSION_MINOR,
+                       EARS_Config::VERSION_PATCH);
+}
+
+const char* EARS_config::getVersionDate()
+{
+    return EARS_Config::VERSION_DATE;
+}
+
+void EARS_config::getVersionString(char* buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+EARS_config &using_config()
+{
+    static EARS_config instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_configLib.cpp
+ *****************************************************************************/
@@ -0,0 +1,303 @@
+/**
+ * @file EARS_configLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Centralised in-memory service for the unified ears.config file
+ * @details ears.config is read and parsed once at boot into EARS_configData,
+ *          a compact struct of fixed-size sections. Readers get const
+ *          references to their section, so nothing touches the SD card or
+ *          ArduinoJson after begin(). The boot parse streams the file
+ *          through EARS_sdReader with a filter, so unknown sections are
+ *          skipped rather than held in the document. When the file is
+ *          unchanged since the last parse, begin() block-reads a binary
+ *          snapshot of EARS_configData instead (CONFIG_SNAPSHOT_ENABLED).
+ *
+ *          set<Section>() copies a new section in and marks it dirty.
+ *          service() (a Core 1 job) waits until changes have been quiet for
+ *          CONFIG_SAVE_DELAY_MS, then appends each dirty section's binary
+ *          image to "<file>.jnl" as one sequence-numbered, CRC-checked
+ *          entry: one short sequential write, however large the file.
+ *
+ *          Once the journal passes CONFIG_JOURNAL_MAX_BYTES, or on
+ *          checkpoint(), the journaled sections are merged into the file,
+ *          which is replaced with writeFileAtomic(), and the journal starts
+ *          again. Keys this service does not know about are carried over
+ *          untouched. The journal names the file it extends (size, mtime,
+ *          CRC), so begin() replays it only onto that file: a reset during
+ *          a checkpoint, or an edit made on a PC, simply retires it. A torn
+ *          final entry fails its CRC and is cut off.
+ *
+ * @version 1.8.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_CONFIG_LIB_H__
+#define __EARS_CONFIG_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "EARS_versionDef.h"
+#include "EARS_sdCardLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_Config
+{
+    constexpr const char* LIB_NAME = "EARS_config";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "8";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+#define CONFIG_DEFAULT_PATH "/config/ears.config"
+
+// Quiet time after the last change before service() journals it
+#define CONFIG_SAVE_DELAY_MS 2000
+
+// Journal of section changes since the file was last rewritten
+#define CONFIG_JOURNAL_SUFFIX ".jnl"
+#define CONFIG_JOURNAL_MAX_BYTES 4096  // Fold into the file beyond this
+
+// Binary image of EARS_configData kept next to the file, used at boot
+// while the file's size, mtime and CRC still match
+#ifndef CONFIG_SNAPSHOT_ENABLED
+#define CONFIG_SNAPSHOT_ENABLED 1
+#endif
+#define CONFIG_SNAPSHOT_SUFFIX ".snap"
+// High half: bump when a field's meaning changes; low half tracks the size
+#define CONFIG_SNAPSHOT_LAYOUT ((1UL << 16) | sizeof(EARS_configData))
+
+/**
+ * @brief Section bits for the dirty mask
+ */
+enum EARS_configSection : uint8_t
+{
+    CONFIG_SECTION_SYSTEM = 0x01,
+    CONFIG_SECTION_LOGGER = 0x02,
+    CONFIG_SECTION_DISPLAY = 0x04,
+    CONFIG_SECTION_NETWORK = 0x08,
+    CONFIG_SECTION_SECURITY = 0x10,
+    CONFIG_SECTION_APPLICATION = 0x20,
+    CONFIG_SECTION_ALL = 0x3F
+};
+
+/******************************************************************************
+ * Section Structures
+ *****************************************************************************/
+
+/**
+ * @brief "system" section
+ */
+struct EARS_configSystem
+{
+    char version[12];
+    char zapNumber[16];
+    char deviceName[32];
+    char created[24];
+    char lastModified[24];
+};
+
+/**
+ * @brief "logger" section, level and policy kept as their config strings
+ */
+struct EARS_configLogger
+{
+    uint32_t maxFileSizeBytes;
+    uint32_t flushIntervalMs;
+    uint8_t maxRotatedFiles;
+    bool buffered;
+    bool async;
+    bool binary;
+    bool preallocate;
+    bool compressRotated;     // Rotated logs compressed to .hs in the background
+    char logLevel[8];         // "NONE", "ERROR", "WARN", "INFO", "DEBUG"
+    char overflowPolicy[12];  // "BLOCK", "DROP_NEWEST", "DROP_OLDEST"
+    char lvglLogLevel[8];     // LVGL messages logged: "NONE", "ERROR", "WARN", "INFO", "TRACE"
+};
+
+/**
+ * @brief "display" section
+ */
+struct EARS_configDisplay
+{
+    uint8_t brightness;       // Percent
+    uint16_t timeoutSeconds;
+    char theme[16];
+};
+
+/**
+ * @brief "network" section
+ */
+struct EARS_configNetwork
+{
+    bool wifiEnabled;
+    bool autoConnect;
+    char ssid[33];            // 32 characters maximum (802.11)
+    char password[65];        // WPA2 passphrase, 64 characters maximum
+    char syncUrl[96];         // Delta sync endpoint, "" = sync off
+    uint16_t syncIntervalMinutes;
+};
+
+/**
+ * @brief "security" section
+ */
+struct EARS_configSecurity
+{
+    bool requirePassword;
+    uint16_t autoLockMinutes;
+    char peerKey[65];         // Peer sync group key, 64 hex characters, "" = none
+    char mirrorToken[65];     // Screen mirror viewer token, "" = mirror off
+};
+
+/**
+ * @brief "application" section
+ */
+struct EARS_configApplication
+{
+    char units[12];
+    char language[8];
+    char dateFormat[16];
+    char timeFormat[8];
+};
+
+/**
+ * @brief The whole file as parsed at boot
+ */
+struct EARS_configData
+{
+    EARS_configSystem system;
+    EARS_configLogger logger;
+    EARS_configDisplay display;
+    EARS_configNetwork network;
+    EARS_configSecurity security;
+    EARS_configApplication application;
+};
+
+/******************************************************************************
+ * EARS_config Class
+ *****************************************************************************/
+class EARS_config
+{
+public:
+    EARS_config();
+
+    // Version information getters
+    static const char* getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char* getVersionDate();
+    static void getVersionString(char* buffer);
+
+    /**
+     * @brief Load and parse the config file once
+     * @details Finishes an interrupted atomic write first, then replays
+     *          the journal over it. A missing or unreadable file leaves the
+     *          defaults in place and schedules them to be written. Later
+     *          calls return the first result.
+     * @param sdCard Mounted filesystem: EARS_flashFs at boot (internal
+     *               flash, no card needed), or the SD card
+     * @param path Config file path
+     * @return true if the file was read and parsed
+     */
+    bool begin(EARS_sdCard* sdCard, const char* path = CONFIG_DEFAULT_PATH);
+
+    bool isLoaded() const { return _loaded; }
+
+    // Zero-copy section access, valid for the life of the program
+    const EARS_configSystem& system() const { return _data.system; }
+    const EARS_configLogger& logger() const { return _data.logger; }
+    const EARS_configDisplay& display() const { return _data.display; }
+    const EARS_configNetwork& network() const { return _data.network; }
+    const EARS_configSecurity& security() const { return _data.security; }
+    const EARS_configApplication& application() const { return _data.application; }
+
+    // Replace a section and schedule it to be saved (no-op if unchanged)
+    void setSystem(const EARS_configSystem& section);
+    void setLogger(const EARS_configLogger& section);
+    void setDisplay(const EARS_configDisplay& section);
+    void setNetwork(const EARS_configNetwork& section);
+    void setSecurity(const EARS_configSecurity& section);
+    void setApplication(const EARS_configApplication& section);
+
+    /**
+     * @brief Journal dirty sections once they have been quiet long enough
+     * @details Call periodically from Core 1
+     */
+    void service();
+
+    /**
+     * @brief Journal dirty sections now, skipping the quiet period
+     * @return true if nothing was dirty or the write succeeded
+     */
+    bool flush();
+
+    /**
+     * @brief Merge everything journaled into the file now
+     * @details For when the file itself must be current, e.g. before the
+     *          card is read on a PC
+     * @return true if the file holds every change
+     */
+    bool checkpoint();
+
+    uint8_t getDirtyMask() const { return _dirty; }
+    const SDParseReport& getLoadReport() const { return _loadReport; }
+    uint32_t getSaveCount() const { return _saves; }               // Journal appends and rewrites
+    uint32_t getCheckpointCount() const { return _checkpoints; }   // File rewrites
+    uint32_t getJournalBytes() const { return _journalBytes; }
+    uint16_t getReplayedEntries() const { return _replayed; }      // Applied at begin()
+
+private:
+    EARS_configData _data;
+    EARS_sdCard* _sdCard;
+    char _path[48];
+    char _snapshotPath[56];
+    char _journalPath[56];
+    SemaphoreHandle_t _mutex;
+    bool _begun;
+    bool _loaded;
+    volatile uint8_t _dirty;
+    uint32_t _lastChangeMs;
+    SDParseReport _loadReport;
+    uint32_t _saves;
+    uint32_t _checkpoints;
+
+    // Journal (Core 1 writer only)
+    SDSnapshotKey _baseKey;      // File the journal extends
+    bool _haveBase;
+    uint32_t _journalBytes;      // 0 = no journal on disk
+    uint32_t _journalSequence;
+    uint8_t _journalMask;        // Sections journaled since the last rewrite
+    uint16_t _replayed;
+
+    static void setDefaults(EARS_configData& data);
+    static void readSections(JsonDocument& doc, EARS_configData& data);
+    static void writeSections(JsonDocument& doc, const EARS_configData& data, uint8_t mask);
+    static uint8_t* sectionData(EARS_configData& data, uint8_t section, size_t& length);
+    void update(void* dest, const void* src, size_t length, uint8_t section);
+    bool save(bool fold);
+    bool appendJournal(EARS_configData& snapshot, uint8_t mask);
+    void replayJournal();
+    bool rewrite(const EARS_configData& snapshot, uint8_t mask);
+    void lock();
+    void unlock();
+};
+
+// Global instance access function (Singleton pattern)
+EARS_config &using_config();
+
+#endif // __EARS_CONFIG_LIB_H__
+
+/******************************************************************************
+ * End of EARS_configLib.h
+ ******************************************************************************/
@@ -0,0 +1,38 @@
+/**
+ * @file EARS_errorTable.h
+ * @brief Built-in error code table generated from data/config/errors.json
+ * @details Written by scripts/generate_error_table.py before every build; edit
+ *          errors.json, not this file. Entries are sorted by code for binary
+ *          search and live in flash (.rodata).
+ */
+
+#pragma once
+#ifndef __EARS_ERROR_TABLE_H__
+#define __EARS_ERROR_TABLE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @struct EARS_errorTableEntry
+ * @brief One built-in error code
+ */
+struct EARS_errorTableEntry {
+    uint16_t code;        // Error code
+    uint8_t level;        // Default EARS_errors::ErrorLevel
+    const char* message;  // Human-readable message
+};
+
+constexpr EARS_errorTableEntry EARS_ERROR_TABLE[] = {
+    {1001, 2, "SD Card read failed"},
+    {1002, 2, "SD Card write failed"},
+    {1003, 2, "SD Card not found"},
+    {2001, 1, "Low memory warning"},
+    {2002, 1, "Display update slow"},
+    {3001, 2, "LVGL initialization failed"},
+    {3002, 1, "Widget creation delayed"},
+};
+
+constexpr size_t EARS_ERROR_TABLE_SIZE = sizeof(EARS_ERROR_TABLE) / sizeof(EARS_ERROR_TABLE[0]);
+
+#endif // __EARS_ERROR_TABLE_H__
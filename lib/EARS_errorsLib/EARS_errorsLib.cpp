@@ -4,11 +4,75 @@
  * This library allows setting, retrieving, and logging errors and warnings.
  * It loads error messages from a JSON file on a TF card and logs occurrences to a history file.
  * @author Julian
- * @date 20260210
- * @version 2.0.0
+ * @date 20261015
+ * @version 2.9.1
  */
 
 #include "EARS_errorsLib.h"
+#include "EARS_loggerLib.h"
+#include "EARS_timeLib.h"
+#include "EARS_errorTable.h"  // Generated by scripts/generate_error_table.py
+#include <esp_timer.h>
+#include <esp_attr.h>
+#include <esp_rom_crc.h>
+#include <esp_system.h>
+
+static_assert(sizeof(EARS_errorHistoryEntry) == 20, "History record layout changed");
+
+//////////////////////////////////////////////////////////////////////////////
+// Error ring in RTC slow memory. RTC_NOINIT_ATTR keeps it through soft
+// resets, watchdog resets and panics; a power-on reset or a bad CRC starts
+// it again. Written under counterLock, mirrored to the card by Core 1.
+#define ERRORS_RTC_MAGIC 0x45525231UL      // "ERR1"
+#define ERRORS_INDEX_MAGIC 0x45524931UL    // "ERI1"
+
+typedef struct {
+    uint32_t sequence;                  // Position in the ring's history
+    EARS_errorHistoryEntry entry;       // previous is unused here
+    uint32_t crc;                       // Over the fields above
+} errors_rtc_slot_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t next;                      // Sequence of the next entry
+    uint32_t persisted;                 // Entries before this are on the card
+    uint8_t boot;
+    uint8_t reserved[3];
+    uint32_t crc;                       // Over the fields above
+    errors_rtc_slot_t slots[ERRORS_RTC_ENTRIES];
+} errors_rtc_t;
+
+RTC_NOINIT_ATTR static errors_rtc_t errors_rtc;
+
+static uint32_t errors_rtc_header_crc() {
+    return esp_rom_crc32_le(0, (const uint8_t*)&errors_rtc, offsetof(errors_rtc_t, crc));
+}
+
+static uint32_t errors_rtc_slot_crc(const errors_rtc_slot_t& slot) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&slot, offsetof(errors_rtc_slot_t, crc));
+}
+
+// Keep the ring from the last boot, or start a new one
+static void errors_rtc_restore() {
+    bool valid = esp_reset_reason() != ESP_RST_POWERON && errors_rtc.magic == ERRORS_RTC_MAGIC &&
+                 errors_rtc.crc == errors_rtc_header_crc() && errors_rtc.persisted <= errors_rtc.next;
+    if (valid) {
+        errors_rtc.boot++;
+    } else {
+        memset(&errors_rtc, 0, sizeof(errors_rtc));
+        errors_rtc.magic = ERRORS_RTC_MAGIC;
+    }
+    errors_rtc.crc = errors_rtc_header_crc();
+}
+
+// Index checkpoint: header, then historyCodeCount HistoryCode entries
+struct __attribute__((packed)) ErrorsIndexHeader {
+    uint32_t magic;
+    uint32_t records;                   // History records the table covers
+    uint16_t codes;
+    uint16_t entrySize;                 // sizeof(HistoryCode)
+    uint32_t crc;                       // Over the entries
+};
 
 //////////////////////////////////////////////////////////////////////////////
 // I do not understand why this is necessary?
@@ -23,6 +87,25 @@ EARS_errors::EARS_errors() {
     currentErrorLevel = NONE;
     errorTimestamp = 0;
     errorMessageCount = 0;
+    loadReport = SDParseReport();
+    sdCard = nullptr;
+    jsonStore = nullptr;
+    
+    droppedErrors.store(0, std::memory_order_relaxed);
+    
+    memset(counters, 0, sizeof(counters));
+    suppressedTotal = 0;
+    counterLock = portMUX_INITIALIZER_UNLOCKED;
+    
+    memset(historyCodes, 0, sizeof(historyCodes));
+    historyCodeCount = 0;
+    historyRecords = 0;
+    historyIndexed = 0;
+    historyReady = false;
+    historyMutex = nullptr;
+    
+    // Before anything can be raised, so a soft reset keeps the last boot's errors
+    errors_rtc_restore();
 }
 
 /**
@@ -36,11 +119,28 @@ EARS_errors::~EARS_errors() {
  * Initialize the library
  * @param errorJsonPath Path to errors.json on TF card
  * @param logFilePath Path to error_log.txt on TF card
+ * @param sdCard Mounted SD card (defaults to the shared instance)
+ * @param jsonStore Filesystem holding errors.json, nullptr = sdCard
  * @return true if initialization successful
  */
-bool EARS_errors::begin(const char* errorJsonPath, const char* logFilePath) {
+bool EARS_errors::begin(const char* errorJsonPath, const char* logFilePath, EARS_sdCard* sdCard,
+                        EARS_sdCard* jsonStore) {
     this->errorJsonPath = String(errorJsonPath);
     this->logFilePath = String(logFilePath);
+    this->sdCard = sdCard;
+    this->jsonStore = jsonStore ? jsonStore : sdCard;
+    
+    if (historyMutex == nullptr) {
+        historyMutex = xSemaphoreCreateMutex();
+    }
+    
+    // Binary history and its index, then whatever the ring holds that the
+    // card does not (errors from before a reset, or from before begin())
+    if (sdCard && historyMutex && xSemaphoreTake(historyMutex, portMAX_DELAY) == pdTRUE) {
+        historyReady = openHistory();
+        xSemaphoreGive(historyMutex);
+    }
+    mirrorHistory();
     
     // Load error messages from JSON
     return loadErrorMessages();
@@ -62,6 +162,11 @@ void EARS_errors::setError(uint16_t code, ErrorLevel level) {
     currentErrorLevel = level;
     errorTimestamp = millis();
     
+    // Repeats inside the window are only counted, summarised later
+    if (!countOccurrence(code, level, errorTimestamp)) {
+        return;
+    }
+    
     // Get the message for this code
     String message = findErrorMessage(code);
     
@@ -69,6 +174,202 @@ void EARS_errors::setError(uint16_t code, ErrorLevel level) {
     logToHistory(code, level, message.c_str());
 }
 
+/**
+ * Raise an error from any context (ISR safe, lock-free)
+ * @param code Error code number
+ * @param level Severity level (WARN or ERROR)
+ * @return true if queued, false if the queue was full (counted as dropped)
+ */
+bool IRAM_ATTR EARS_errors::raiseError(uint16_t code, ErrorLevel level) {
+    // Claim and publish are inlined here, so the whole path stays in IRAM
+    QueuedError* slot = errorQueue.claim();
+    if (slot == nullptr) {
+        // Consumer has not freed the next slot yet: queue full
+        droppedErrors.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    slot->code = code;
+    slot->level = (uint8_t)level;
+    slot->timestampUs = esp_timer_get_time();
+    errorQueue.publish(slot);
+    return true;
+}
+
+/**
+ * Resolve and persist queued errors (single consumer, Core 1)
+ * @param maxEntries Upper bound on entries handled this call
+ */
+void EARS_errors::processPending(uint32_t maxEntries) {
+    for (uint32_t i = 0; i < maxEntries; i++) {
+        QueuedError* slot = errorQueue.peek();
+        if (slot == nullptr) {
+            break;  // Empty (or producer still writing)
+        }
+        
+        uint16_t code = slot->code;
+        ErrorLevel level = (ErrorLevel)slot->level;
+        int64_t timestampUs = slot->timestampUs;
+        errorQueue.pop();
+        
+        setError(code, level);
+        if (level != NONE) {
+            errorTimestamp = (unsigned long)(timestampUs / 1000);  // Time of the raise, not of this drain
+        }
+    }
+    
+    // Write "x N in 10 s" lines for windows that have closed
+    flushSummaries(millis(), false);
+    
+    // Copy new ring entries to the binary history
+    mirrorHistory();
+}
+
+/**
+ * Count one occurrence of a code
+ * @param code Error code
+ * @param level Error level
+ * @param now millis() of the occurrence
+ * @return true if this occurrence should be written to the history
+ */
+bool EARS_errors::countOccurrence(uint16_t code, ErrorLevel level, uint32_t now) {
+    ErrorCounter closed;
+    bool haveClosed = false;
+    bool writeLine;
+    
+    portENTER_CRITICAL(&counterLock);
+    
+    ErrorCounter* counter = nullptr;
+    ErrorCounter* victim = &counters[0];
+    for (uint8_t i = 0; i < ERRORS_COUNTER_SLOTS; i++) {
+        if (counters[i].code == code) {
+            counter = &counters[i];
+            break;
+        }
+        if (counters[i].code == 0) {
+            if (victim->code != 0) {
+                victim = &counters[i];
+            }
+        } else if (victim->code != 0 && counters[i].lastMs < victim->lastMs) {
+            victim = &counters[i];
+        }
+    }
+    
+    if (!counter) {
+        // Evicting a code with folded repeats: keep its summary
+        if (victim->code != 0 && victim->windowCount > ERRORS_RATE_MAX_PER_WINDOW) {
+            closed = *victim;
+            haveClosed = true;
+        }
+        counter = victim;
+        counter->code = code;
+        counter->total = 0;
+        counter->windowStartMs = now;
+        counter->windowCount = 0;
+    } else if (now - counter->windowStartMs >= ERRORS_RATE_WINDOW_MS) {
+        // Window over: summarise it and start a new one
+        if (counter->windowCount > ERRORS_RATE_MAX_PER_WINDOW) {
+            closed = *counter;
+            haveClosed = true;
+        }
+        counter->windowStartMs = now;
+        counter->windowCount = 0;
+    }
+    
+    counter->level = (uint8_t)level;
+    counter->total++;
+    counter->windowCount++;
+    counter->lastMs = now;
+    writeLine = (counter->windowCount <= ERRORS_RATE_MAX_PER_WINDOW);
+    if (!writeLine) {
+        suppressedTotal++;
+    }
+    
+    portEXIT_CRITICAL(&counterLock);
+    
+    if (haveClosed) {
+        writeSummary(closed, now);
+    }
+    return writeLine;
+}
+
+/**
+ * Write summaries for dedup windows that have closed
+ * @param now Current millis()
+ * @param all true to summarise open windows too
+ */
+void EARS_errors::flushSummaries(uint32_t now, bool all) {
+    for (uint8_t i = 0; i < ERRORS_COUNTER_SLOTS; i++) {
+        ErrorCounter closed;
+        bool haveClosed = false;
+        
+        portENTER_CRITICAL(&counterLock);
+        ErrorCounter& counter = counters[i];
+        if (counter.code != 0 && counter.windowCount > ERRORS_RATE_MAX_PER_WINDOW &&
+            (all || now - counter.windowStartMs >= ERRORS_RATE_WINDOW_MS)) {
+            closed = counter;
+            haveClosed = true;
+            counter.windowStartMs = now;
+            counter.windowCount = 0;
+        }
+        portEXIT_CRITICAL(&counterLock);
+        
+        if (haveClosed) {
+            writeSummary(closed, now);
+        }
+    }
+}
+
+/**
+ * Write one folded history line: "Code:1001 x 347 in 10 s <message>"
+ * @param counter Snapshot of the closed window
+ * @param now Current millis()
+ */
+void EARS_errors::writeSummary(const ErrorCounter& counter, uint32_t now) {
+    uint32_t spanMs = now - counter.windowStartMs;
+    if (spanMs > ERRORS_RATE_WINDOW_MS) {
+        spanMs = ERRORS_RATE_WINDOW_MS;
+    }
+    
+    String message = findErrorMessage(counter.code);
+    char summary[192];
+    snprintf(summary, sizeof(summary), "x %lu in %lu s %s",
+             (unsigned long)counter.windowCount,
+             (unsigned long)((spanMs + 999) / 1000),
+             message.c_str());
+    logToHistory(counter.code, (ErrorLevel)counter.level, summary, counter.windowCount);
+}
+
+/**
+ * Get occurrences of a code since boot (or the last resetCounters)
+ * @param code Error code
+ * @return Occurrence count, 0 if the code is not tracked
+ */
+uint32_t EARS_errors::getErrorCount(uint16_t code) {
+    uint32_t total = 0;
+    portENTER_CRITICAL(&counterLock);
+    for (uint8_t i = 0; i < ERRORS_COUNTER_SLOTS; i++) {
+        if (counters[i].code == code) {
+            total = counters[i].total;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&counterLock);
+    return total;
+}
+
+/**
+ * Forget all per-code counters, writing pending summaries first
+ */
+void EARS_errors::resetCounters() {
+    flushSummaries(millis(), true);
+    
+    portENTER_CRITICAL(&counterLock);
+    memset(counters, 0, sizeof(counters));
+    suppressedTotal = 0;
+    portEXIT_CRITICAL(&counterLock);
+}
+
 /**
  * Get current error code
  * @return Current error code (0 if none)
@@ -138,35 +439,66 @@ bool EARS_errors::reloadErrorMessages() {
 }
 
 /**
- * Load error messages from JSON file on TF card
- * @return true if successful
+ * Load override error messages from JSON file on TF card
+ * @return true if successful (a missing file is fine, the flash table is used)
  */
 bool EARS_errors::loadErrorMessages() {
-    if (!SD.exists(errorJsonPath.c_str())) {
-        Serial.println("Error: errors.json not found on TF card");
-        return false;
+    // Clear existing overrides
+    errorMessageCount = 0;
+    loadReport = SDParseReport();
+    
+    if (!jsonStore || !jsonStore->isAvailable() || !jsonStore->fileExists(errorJsonPath.c_str())) {
+        Serial.print("Using ");
+        Serial.print(EARS_ERROR_TABLE_SIZE);
+        Serial.println(" built-in error messages");
+        return true;
     }
     
-    File file = SD.open(errorJsonPath.c_str(), FILE_READ);
+#if ERRORS_SNAPSHOT_ENABLED == 1
+    // Unchanged errors.json: take the resolved overrides from the snapshot
+    String snapshotPath = errorJsonPath + ERRORS_SNAPSHOT_SUFFIX;
+    SDSnapshotKey key;
+    bool haveKey = jsonStore->getSnapshotKey(errorJsonPath.c_str(), key);
+    if (haveKey && loadSnapshot(snapshotPath.c_str(), key)) {
+        Serial.print("Loaded ");
+        Serial.print(errorMessageCount);
+        Serial.printf(" error message overrides from snapshot in %lu us\n",
+                      (unsigned long)loadReport.parseUs);
+        return true;
+    }
+#endif
+    
+    // Only code and message are kept; level and unknown keys are skipped
+    JsonDocument filter;
+    filter["errors"][0]["code"] = true;
+    filter["errors"][0]["message"] = true;
+    
+    int64_t startUs = esp_timer_get_time();
+    uint32_t heapBefore = ESP.getFreeHeap();
+    
+    // Stream from the SD_MMC file through a read buffer
+    File file = jsonStore->openRead(errorJsonPath.c_str());
     if (!file) {
         Serial.println("Error: Could not open errors.json");
         return false;
     }
+    EARS_sdReader reader(file);
     
-    // Parse JSON
     JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, file);
+    DeserializationError error = deserializeJson(doc, reader, DeserializationOption::Filter(filter));
     file.close();
     
+    loadReport.parseUs = (uint32_t)(esp_timer_get_time() - startUs);
+    loadReport.bytesRead = reader.bytesRead();
+    uint32_t heapAfter = ESP.getFreeHeap();
+    loadReport.heapUsed = (heapBefore > heapAfter) ? heapBefore - heapAfter : 0;
+    
     if (error) {
         Serial.print("Error parsing errors.json: ");
         Serial.println(error.c_str());
         return false;
     }
     
-    // Clear existing messages
-    errorMessageCount = 0;
-    
     // Load error messages from JSON
     JsonArray errors = doc["errors"].as<JsonArray>();
     for (JsonObject error : errors) {
@@ -178,52 +510,467 @@ bool EARS_errors::loadErrorMessages() {
         uint16_t code = error["code"];
         const char* message = error["message"];
         
-        errorMessages[errorMessageCount].code = code;
-        errorMessages[errorMessageCount].message = String(message);
+        // Skip entries identical to the flash table, no heap copy needed
+        const char* builtin = getBuiltinMessage(code);
+        if (!message || (builtin && strcmp(builtin, message) == 0)) {
+            continue;
+        }
+        
+        // Insertion sort keeps the overrides ready for binary search
+        uint8_t pos = errorMessageCount;
+        while (pos > 0 && errorMessages[pos - 1].code > code) {
+            errorMessages[pos] = errorMessages[pos - 1];
+            pos--;
+        }
+        errorMessages[pos].code = code;
+        errorMessages[pos].message = String(message);
         errorMessageCount++;
     }
     
     Serial.print("Loaded ");
     Serial.print(errorMessageCount);
-    Serial.println(" error messages");
+    Serial.println(" error message overrides");
+    Serial.printf("errors.json: %lu bytes parsed in %lu us, %lu bytes heap\n",
+                  (unsigned long)loadReport.bytesRead,
+                  (unsigned long)loadReport.parseUs,
+                  (unsigned long)loadReport.heapUsed);
+    
+#if ERRORS_SNAPSHOT_ENABLED == 1
+    if (haveKey) {
+        saveSnapshot(snapshotPath.c_str(), key);
+    }
+#endif
     
     return true;
 }
 
+/**
+ * Restore the override table from a snapshot of an unchanged errors.json
+ * @param path Snapshot file path
+ * @param key Current errors.json identity
+ * @return true if the overrides were restored
+ * @details Image: count byte, then per entry code (2), length (1), text
+ */
+bool EARS_errors::loadSnapshot(const char* path, const SDSnapshotKey& key) {
+    int64_t startUs = esp_timer_get_time();
+    
+    size_t length = jsonStore->readSnapshot(path, key, ERRORS_SNAPSHOT_LAYOUT, nullptr, 0);
+    if (length == 0) {
+        return false;
+    }
+    
+    uint8_t* image = (uint8_t*)malloc(length);
+    if (!image) {
+        return false;
+    }
+    
+    bool ok = jsonStore->readSnapshot(path, key, ERRORS_SNAPSHOT_LAYOUT, image, length) == length;
+    size_t pos = 1;
+    uint8_t count = ok ? image[0] : 0;
+    ok = ok && count <= MAX_ERROR_MESSAGES;
+    
+    for (uint8_t i = 0; ok && i < count; i++) {
+        if (pos + 3 > length || pos + 3 + image[pos + 2] > length) {
+            ok = false;
+            break;
+        }
+        uint8_t textLength = image[pos + 2];
+        errorMessages[i].code = (uint16_t)(image[pos] | (image[pos + 1] << 8));
+        errorMessages[i].message = String((const char*)image + pos + 3, textLength);
+        pos += 3 + textLength;
+    }
+    free(image);
+    
+    errorMessageCount = ok ? count : 0;
+    if (ok) {
+        loadReport.fromSnapshot = true;
+        loadReport.parseUs = (uint32_t)(esp_timer_get_time() - startUs);
+        loadReport.bytesRead = length;
+    }
+    return ok;
+}
+
+/**
+ * Store the resolved override table for the next boot
+ * @param path Snapshot file path
+ * @param key errors.json identity the table was parsed from
+ */
+void EARS_errors::saveSnapshot(const char* path, const SDSnapshotKey& key) {
+    size_t length = 1;
+    for (uint8_t i = 0; i < errorMessageCount; i++) {
+        length += 3 + min(errorMessages[i].message.length(), (unsigned int)255);
+    }
+    
+    uint8_t* image = (uint8_t*)malloc(length);
+    if (!image) {
+        return;
+    }
+    
+    size_t pos = 0;
+    image[pos++] = errorMessageCount;
+    for (uint8_t i = 0; i < errorMessageCount; i++) {
+        uint8_t textLength = (uint8_t)min(errorMessages[i].message.length(), (unsigned int)255);
+        image[pos++] = errorMessages[i].code & 0xFF;
+        image[pos++] = errorMessages[i].code >> 8;
+        image[pos++] = textLength;
+        memcpy(image + pos, errorMessages[i].message.c_str(), textLength);
+        pos += textLength;
+    }
+    
+    jsonStore->writeSnapshot(path, key, ERRORS_SNAPSHOT_LAYOUT, image, length);
+    free(image);
+}
+
 /**
  * Log error to history file on TF card
  * @param code Error code
  * @param level Error level
  * @param message Error message
+ * @param count Occurrences the line stands for
  */
-void EARS_errors::logToHistory(uint16_t code, ErrorLevel level, const char* message) {
-    File file = SD.open(logFilePath.c_str(), FILE_APPEND);
-    if (!file) {
-        Serial.println("Error: Could not open error_log.txt for writing");
-        return;
+void EARS_errors::logToHistory(uint16_t code, ErrorLevel level, const char* message, uint32_t count) {
+    // RTC ring first: it survives a reset that the queued writes below do not
+    recordOccurrence(code, level, count);
+    
+    // Mirror into the main log; the async backend keeps SD I/O off this task
+    if (level == ERROR) {
+        LOG_ERRORF("[errors] Code:%u %s", (unsigned)code, message);
+    } else {
+        LOG_WARNF("[errors] Code:%u %s", (unsigned)code, message);
     }
     
-    // Create timestamp string
-    char timestamp[32];
-    unsigned long ms = millis();
-    unsigned long seconds = ms / 1000;
-    unsigned long minutes = seconds / 60;
-    unsigned long hours = minutes / 60;
+    // No isAvailable() check: with the card out the append is queued
+    if (!sdCard) {
+        return;
+    }
     
-    sprintf(timestamp, "%02lu:%02lu:%02lu.%03lu", 
-            hours % 24, minutes % 60, seconds % 60, ms % 1000);
+    // Same clock as the main log, with milliseconds
+    char timestamp[TIME_TEXT_MS_LEN + 1];
+    using_time().formatTimestamp(timestamp, sizeof(timestamp), true);
     
     // Write log entry: [timestamp] LEVEL Code:1234 Message
-    file.print("[");
-    file.print(timestamp);
-    file.print("] ");
-    file.print(levelToString(level));
-    file.print(" Code:");
-    file.print(code);
-    file.print(" ");
-    file.println(message);
+    char line[256];
+    int length = snprintf(line, sizeof(line), "[%s] %s Code:%u %s\r\n",
+                          timestamp, levelToString(level).c_str(), (unsigned)code, message);
+    if (length <= 0) {
+        return;
+    }
+    if ((size_t)length >= sizeof(line)) {
+        length = sizeof(line) - 1;
+    }
     
-    file.close();
+    // One append through the shared cached handle, no open/close per error
+    if (!sdCard->appendData(logFilePath.c_str(), (const uint8_t*)line, (size_t)length)) {
+        Serial.println("Error: Could not write error_log.txt");
+    }
+}
+
+/**
+ * Add an occurrence to the RTC ring (any task)
+ * @param code Error code
+ * @param level Error level
+ * @param count Occurrences the entry stands for
+ */
+void EARS_errors::recordOccurrence(uint16_t code, ErrorLevel level, uint32_t count) {
+    EARS_errorHistoryEntry entry;
+    entry.time = using_time().isValid() ? (uint32_t)using_time().now() : 0;
+    entry.uptimeMs = millis();
+    entry.code = code;
+    entry.level = (uint8_t)level;
+    entry.count = count;
+    entry.previous = ERRORS_HISTORY_NONE;
+    
+    portENTER_CRITICAL(&counterLock);
+    errors_rtc_slot_t& slot = errors_rtc.slots[errors_rtc.next % ERRORS_RTC_ENTRIES];
+    entry.boot = errors_rtc.boot;
+    slot.sequence = errors_rtc.next;
+    slot.entry = entry;
+    slot.crc = errors_rtc_slot_crc(slot);
+    errors_rtc.next++;
+    errors_rtc.crc = errors_rtc_header_crc();
+    portEXIT_CRITICAL(&counterLock);
+}
+
+/**
+ * Open the binary history and load its per-code index (historyMutex held)
+ * @return true if the history can be appended to
+ * @details Records after the index checkpoint are read back to bring the
+ *          table up to date, so a reset costs at most a checkpoint's worth
+ */
+bool EARS_errors::openHistory() {
+    const size_t recordSize = sizeof(EARS_errorHistoryEntry);
+    uint32_t size = sdCard->fileExists(ERRORS_HISTORY_PATH) ? sdCard->getFileSize(ERRORS_HISTORY_PATH) : 0;
+    if (size % recordSize) {
+        // Torn last record from a power cut
+        size -= size % recordSize;
+        if (!sdCard->truncateFile(ERRORS_HISTORY_PATH, size)) {
+            return false;
+        }
+    }
+    historyRecords = size / recordSize;
+    
+    // Index checkpoint, if it is intact and not ahead of the history
+    historyCodeCount = 0;
+    historyIndexed = 0;
+    ErrorsIndexHeader header;
+    if (sdCard->fileExists(ERRORS_HISTORY_INDEX_PATH) &&
+        sdCard->readDataAt(ERRORS_HISTORY_INDEX_PATH, 0, (uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+        header.magic == ERRORS_INDEX_MAGIC && header.entrySize == sizeof(HistoryCode) &&
+        header.codes <= ERRORS_HISTORY_CODES && header.records <= historyRecords) {
+        size_t bytes = header.codes * sizeof(HistoryCode);
+        if (sdCard->readDataAt(ERRORS_HISTORY_INDEX_PATH, sizeof(header), (uint8_t*)historyCodes, bytes) == bytes &&
+            esp_rom_crc32_le(0, (const uint8_t*)historyCodes, bytes) == header.crc) {
+            historyCodeCount = header.codes;
+            historyIndexed = header.records;
+        }
+    }
+    
+    // Replay the records the checkpoint does not cover
+    EARS_errorHistoryEntry batch[16];
+    uint32_t replayed = 0;
+    for (uint32_t i = historyIndexed; i < historyRecords; ) {
+        uint32_t n = min((uint32_t)(sizeof(batch) / recordSize), historyRecords - i);
+        if (sdCard->readDataAt(ERRORS_HISTORY_PATH, i * recordSize, (uint8_t*)batch, n * recordSize) != n * recordSize) {
+            return false;
+        }
+        for (uint32_t j = 0; j < n; j++, i++) {
+            HistoryCode* slot = findHistoryCode(batch[j].code, true);
+            if (slot) {
+                slot->last = i;
+                slot->count++;
+            }
+        }
+        replayed += n;
+    }
+    if (replayed >= ERRORS_HISTORY_CHECKPOINT) {
+        saveHistoryIndex();
+    }
+    
+    LOG_INFOF("[errors] History: %lu records, %u codes, %lu replayed",
+              (unsigned long)historyRecords, (unsigned)historyCodeCount, (unsigned long)replayed);
+    return true;
+}
+
+/**
+ * Copy ring entries the card does not have yet to the binary history
+ * @details Core 1 (processPending) and begin(). A write that fails is
+ *          tried again next time; entries the ring has overwritten since
+ *          are lost, which only happens with the card out for a long time.
+ */
+void EARS_errors::mirrorHistory() {
+    if (!historyReady || xSemaphoreTake(historyMutex, portMAX_DELAY) != pdTRUE) {
+        return;
+    }
+    
+    for (;;) {
+        errors_rtc_slot_t slot;
+        uint32_t sequence = 0;
+        bool valid = false;
+        
+        portENTER_CRITICAL(&counterLock);
+        if (errors_rtc.next - errors_rtc.persisted > ERRORS_RTC_ENTRIES) {
+            errors_rtc.persisted = errors_rtc.next - ERRORS_RTC_ENTRIES;
+        }
+        bool pending = errors_rtc.persisted != errors_rtc.next;
+        if (pending) {
+            sequence = errors_rtc.persisted;
+            slot = errors_rtc.slots[sequence % ERRORS_RTC_ENTRIES];
+            valid = slot.sequence == sequence && slot.crc == errors_rtc_slot_crc(slot);
+        }
+        portEXIT_CRITICAL(&counterLock);
+        
+        if (!pending) {
+            break;
+        }
+        // A slot torn by the reset is skipped
+        if (valid && !appendHistory(slot.entry)) {
+            break;
+        }
+        
+        portENTER_CRITICAL(&counterLock);
+        if (errors_rtc.persisted == sequence) {
+            errors_rtc.persisted++;
+        }
+        errors_rtc.crc = errors_rtc_header_crc();
+        portEXIT_CRITICAL(&counterLock);
+    }
+    
+    xSemaphoreGive(historyMutex);
+}
+
+/**
+ * Append one record, linked to the previous record of its code (historyMutex held)
+ * @param entry Record to write; previous is filled in
+ * @return true if queued to the card
+ */
+bool EARS_errors::appendHistory(EARS_errorHistoryEntry& entry) {
+    HistoryCode* slot = findHistoryCode(entry.code, true);
+    entry.previous = slot && slot->count ? slot->last : ERRORS_HISTORY_NONE;
+    
+    if (!sdCard->appendData(ERRORS_HISTORY_PATH, (const uint8_t*)&entry, sizeof(entry))) {
+        return false;
+    }
+    
+    if (slot) {
+        slot->last = historyRecords;
+        slot->count++;
+    }
+    historyRecords++;
+    
+    if (historyRecords - historyIndexed >= ERRORS_HISTORY_CHECKPOINT) {
+        saveHistoryIndex();
+    }
+    return true;
+}
+
+/**
+ * Find a code in the history index (sorted, binary search)
+ * @param code Error code
+ * @param add Insert the code if it is missing and there is room
+ * @return Entry, nullptr if missing (or the table is full)
+ */
+EARS_errors::HistoryCode* EARS_errors::findHistoryCode(uint16_t code, bool add) {
+    int low = 0;
+    int high = (int)historyCodeCount - 1;
+    while (low <= high) {
+        int mid = (low + high) / 2;
+        if (historyCodes[mid].code == code) {
+            return &historyCodes[mid];
+        }
+        if (historyCodes[mid].code < code) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    
+    if (!add || historyCodeCount >= ERRORS_HISTORY_CODES) {
+        return nullptr;
+    }
+    
+    // low is the insertion point
+    memmove(&historyCodes[low + 1], &historyCodes[low], (historyCodeCount - low) * sizeof(HistoryCode));
+    historyCodes[low].code = code;
+    historyCodes[low].last = 0;
+    historyCodes[low].count = 0;
+    historyCodeCount++;
+    return &historyCodes[low];
+}
+
+/**
+ * Checkpoint the per-code index (historyMutex held)
+ */
+void EARS_errors::saveHistoryIndex() {
+    size_t bytes = historyCodeCount * sizeof(HistoryCode);
+    uint8_t* image = (uint8_t*)malloc(sizeof(ErrorsIndexHeader) + bytes);
+    if (!image) {
+        return;
+    }
+    
+    ErrorsIndexHeader header;
+    header.magic = ERRORS_INDEX_MAGIC;
+    header.records = historyRecords;
+    header.codes = historyCodeCount;
+    header.entrySize = sizeof(HistoryCode);
+    header.crc = esp_rom_crc32_le(0, (const uint8_t*)historyCodes, bytes);
+    memcpy(image, &header, sizeof(header));
+    memcpy(image + sizeof(header), historyCodes, bytes);
+    
+    // The records it counts must reach the card before the index does
+    sdCard->flush(ERRORS_HISTORY_PATH);
+    if (sdCard->writeFileAtomic(ERRORS_HISTORY_INDEX_PATH, image, sizeof(header) + bytes)) {
+        historyIndexed = historyRecords;
+    }
+    free(image);
+}
+
+/**
+ * Newest history entries of a code, newest first
+ * @param code Error code, 0 for any
+ * @param out Destination
+ * @param max Entries out can hold
+ * @return Entries written to out
+ * @details Follows the records' links from the index, one read per entry
+ */
+size_t EARS_errors::getHistory(uint16_t code, EARS_errorHistoryEntry* out, size_t max) {
+    const size_t recordSize = sizeof(EARS_errorHistoryEntry);
+    if (!historyReady || out == nullptr || max == 0 ||
+        xSemaphoreTake(historyMutex, portMAX_DELAY) != pdTRUE) {
+        return 0;
+    }
+    
+    // Queued appends first, so the newest records are readable
+    sdCard->flush(ERRORS_HISTORY_PATH);
+    
+    size_t count = 0;
+    if (code == 0) {
+        // The tail of the file in one read, then reversed
+        count = min((uint32_t)max, historyRecords);
+        uint32_t first = historyRecords - count;
+        if (sdCard->readDataAt(ERRORS_HISTORY_PATH, first * recordSize, (uint8_t*)out, count * recordSize) !=
+            count * recordSize) {
+            count = 0;
+        }
+        for (size_t i = 0; i < count / 2; i++) {
+            EARS_errorHistoryEntry swap = out[i];
+            out[i] = out[count - 1 - i];
+            out[count - 1 - i] = swap;
+        }
+    } else {
+        HistoryCode* slot = findHistoryCode(code, false);
+        uint32_t record = slot && slot->count ? slot->last : ERRORS_HISTORY_NONE;
+        while (count < max && record < historyRecords) {
+            if (sdCard->readDataAt(ERRORS_HISTORY_PATH, record * recordSize, (uint8_t*)&out[count], recordSize) !=
+                    recordSize ||
+                out[count].code != code) {
+                break;
+            }
+            record = out[count].previous;
+            count++;
+        }
+    }
+    
+    xSemaphoreGive(historyMutex);
+    return count;
+}
+
+/**
+ * History entries of a code on the card
+ * @param code Error code, 0 for all
+ * @return Entry count (0 for a code beyond the index)
+ */
+uint32_t EARS_errors::getHistoryCount(uint16_t code) {
+    if (!historyReady || xSemaphoreTake(historyMutex, portMAX_DELAY) != pdTRUE) {
+        return 0;
+    }
+    uint32_t count = historyRecords;
+    if (code != 0) {
+        HistoryCode* slot = findHistoryCode(code, false);
+        count = slot ? slot->count : 0;
+    }
+    xSemaphoreGive(historyMutex);
+    return count;
+}
+
+/**
+ * Newest entries in the RTC ring, newest first
+ * @param out Destination
+ * @param max Entries out can hold
+ * @return Entries written to out
+ */
+size_t EARS_errors::getRecentErrors(EARS_errorHistoryEntry* out, size_t max) {
+    size_t count = 0;
+    portENTER_CRITICAL(&counterLock);
+    uint32_t next = errors_rtc.next;
+    for (uint32_t i = 0; i < ERRORS_RTC_ENTRIES && i < next && count < max; i++) {
+        const errors_rtc_slot_t& slot = errors_rtc.slots[(next - 1 - i) % ERRORS_RTC_ENTRIES];
+        if (slot.sequence != next - 1 - i || slot.crc != errors_rtc_slot_crc(slot)) {
+            continue;
+        }
+        out[count++] = slot.entry;
+    }
+    portEXIT_CRITICAL(&counterLock);
+    return count;
 }
 
 /**
@@ -232,14 +979,50 @@ void EARS_errors::logToHistory(uint16_t code, ErrorLevel level, const char* mess
  * @return Error message string or "Unknown error"
  */
 String EARS_errors::findErrorMessage(uint16_t code) {
-    for (uint8_t i = 0; i < errorMessageCount; i++) {
-        if (errorMessages[i].code == code) {
-            return errorMessages[i].message;
+    // SD overrides first (sorted, binary search)
+    int lo = 0;
+    int hi = (int)errorMessageCount - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (errorMessages[mid].code == code) {
+            return errorMessages[mid].message;
+        }
+        if (errorMessages[mid].code < code) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
         }
     }
+    
+    const char* builtin = getBuiltinMessage(code);
+    if (builtin) {
+        return String(builtin);
+    }
     return "Unknown error (code " + String(code) + ")";
 }
 
+/**
+ * Look up a code in the generated flash table
+ * @param code Error code to look up
+ * @return Message in flash, or nullptr if the code is not built in
+ */
+const char* EARS_errors::getBuiltinMessage(uint16_t code) {
+    size_t lo = 0;
+    size_t hi = EARS_ERROR_TABLE_SIZE;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (EARS_ERROR_TABLE[mid].code == code) {
+            return EARS_ERROR_TABLE[mid].message;
+        }
+        if (EARS_ERROR_TABLE[mid].code < code) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return nullptr;
+}
+
 /**
  * Convert error level to string
  * @param level Error level enum
@@ -260,24 +1043,24 @@ String EARS_errors::levelToString(ErrorLevel level) {
  *****************************************************************************/
 
 // Get library name
-const char* EARS_Errors::getLibraryName() {
+const char* EARS_errors::getLibraryName() {
     return EARS_Errors::LIB_NAME;
 }
 
 // Get encoded version as integer
-uint32_t EARS_Errors::getVersionEncoded() {
+uint32_t EARS_errors::getVersionEncoded() {
     return VERS_ENCODE(EARS_Errors::VERSION_MAJOR, 
                        EARS_Errors::VERSION_MINOR, 
                        EARS_Errors::VERSION_PATCH);
 }
 
 // Get version date
-const char* EARS_Errors::getVersionDate() {
+const char* EARS_errors::getVersionDate() {
     return EARS_Errors::VERSION_DATE;
 }
 
 // Format version as string
-void EARS_Errors::getVersionString(char* buffer) {
+void EARS_errors::getVersionString(char* buffer) {
     uint32_t encoded = getVersionEncoded();
     VERS_FORMAT(encoded, buffer);
 }
@@ -3,8 +3,8 @@
  * EARS_errorsLib.h
  *  * @author JTB & Claude Sonnet 4.2
  * @brief Error Management Library for EARS Project
- * @version 2.0.0
- * @date 20260210
+ * @version 2.9.1
+ * @date 20261015
  * 
  * @copyright Copyright (c) 2025
  */
@@ -18,8 +18,12 @@
  *****************************************************************************/
 #include <Arduino.h>
 #include "EARS_versionDef.h"
-#include <SD.h>
+#include "EARS_mpscRingDef.h"
 #include <ArduinoJson.h>
+#include "EARS_sdCardLib.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <atomic>
 
 
 /******************************************************************************
@@ -29,12 +33,62 @@ namespace EARS_Errors
 {
     constexpr const char* LIB_NAME = "EARS_Errors";
     constexpr const char* VERSION_MAJOR = "2";
-    constexpr const char* VERSION_MINOR = "0";
-    constexpr const char* VERSION_PATCH = "0";
-    constexpr const char* VERSION_DATE = "2026-02-10";
+    constexpr const char* VERSION_MINOR = "9";
+    constexpr const char* VERSION_PATCH = "1";
+    constexpr const char* VERSION_DATE = "2026-10-15";
 }
 
 
+/******************************************************************************
+ * Error Queue Configuration
+ *****************************************************************************/
+#define ERRORS_QUEUE_SIZE 32       // Pending raiseError() entries (power of two)
+#define ERRORS_QUEUE_DRAIN_MAX 8   // Entries resolved per processPending() call
+
+/******************************************************************************
+ * Rate Limiting Configuration
+ *****************************************************************************/
+#define ERRORS_RATE_WINDOW_MS 10000    // Dedup window per code
+#define ERRORS_RATE_MAX_PER_WINDOW 1   // History lines per code per window before folding
+#define ERRORS_COUNTER_SLOTS 16        // Distinct codes tracked (least recent evicted)
+
+/******************************************************************************
+ * Snapshot Cache Configuration
+ *****************************************************************************/
+#ifndef ERRORS_SNAPSHOT_ENABLED
+#define ERRORS_SNAPSHOT_ENABLED 1      // Skip the errors.json parse while it is unchanged
+#endif
+#define ERRORS_SNAPSHOT_SUFFIX ".snap"
+// Overrides are relative to the flash table, so its size is part of the layout
+#define ERRORS_SNAPSHOT_LAYOUT ((1UL << 16) | EARS_ERROR_TABLE_SIZE)
+
+/******************************************************************************
+ * Error History Configuration
+ *****************************************************************************/
+// Every history line also goes into a ring in RTC slow memory, which soft
+// resets and panics leave alone, and from there into a binary history on
+// the card. Each history record links to the previous one of its code and
+// an in-RAM table holds each code's newest record, so the last N of a code
+// are N reads however long the history is. Entries the ring holds but the
+// card never got (a reset before Core 1 wrote them) are written at begin().
+#define ERRORS_RTC_ENTRIES 32              // Ring in RTC slow memory
+#define ERRORS_HISTORY_PATH "/logs/errors.bin"
+#define ERRORS_HISTORY_INDEX_PATH "/logs/errors.idx"
+#define ERRORS_HISTORY_CODES 64            // Codes indexed; others are kept but not linked
+#define ERRORS_HISTORY_CHECKPOINT 64       // Records between index checkpoints
+#define ERRORS_HISTORY_NONE 0xFFFFFFFFUL   // No earlier record of the code
+
+// One history entry, as returned by the queries (and stored on the card)
+struct __attribute__((packed)) EARS_errorHistoryEntry {
+    uint32_t time;       // Unix time, 0 if the clock was not set
+    uint32_t uptimeMs;   // millis() at the occurrence
+    uint16_t code;
+    uint8_t level;       // EARS_errors::ErrorLevel
+    uint8_t boot;        // Boots since the ring was started (low byte)
+    uint32_t count;      // Occurrences (more than 1 for a folded summary)
+    uint32_t previous;   // Record number of the code's previous entry, or ERRORS_HISTORY_NONE
+};
+
 class EARS_errors {
 public:
     // Error severity levels (matching Logger functionality)
@@ -58,11 +112,49 @@ public:
     static void getVersionString(char* buffer);
 
     // Initialize the library (load error messages from TF card)
+    // All file access goes through EARS_sdCard (SD_MMC, cached handles);
+    // errors.json may come from another one (EARS_flashFs), the log stays
+    // on the card
     bool begin(const char* errorJsonPath = "/config/errors.json", 
-               const char* logFilePath = "/logs/error_log.txt");
+               const char* logFilePath = "/logs/error_log.txt",
+               EARS_sdCard* sdCard = &using_sdcard(),
+               EARS_sdCard* jsonStore = nullptr);
 
-    // Set an error or warning
+    // Set an error or warning (task context, resolves and logs immediately)
     void setError(uint16_t code, ErrorLevel level);
+
+    // Raise an error from any context (ISR, Core 0 render path, either core).
+    // Lock-free and constant time; returns false if the queue was full.
+    bool raiseError(uint16_t code, ErrorLevel level);
+
+    // Resolve and persist queued raiseError() entries (Core 1 consumer)
+    void processPending(uint32_t maxEntries = ERRORS_QUEUE_DRAIN_MAX);
+
+    // Entries lost because the queue was full
+    uint32_t getDroppedErrors() const { return droppedErrors.load(std::memory_order_relaxed); }
+
+    // Cost of the last errors.json parse (all zero if the file was absent)
+    const SDParseReport& getLoadReport() const { return loadReport; }
+
+    // Occurrences of a code since boot (or resetCounters), 0 if not tracked
+    uint32_t getErrorCount(uint16_t code);
+
+    // Occurrences folded into summary lines instead of written one by one
+    uint32_t getSuppressedCount() const { return suppressedTotal; }
+
+    // Forget all per-code counters (pending summaries are written first)
+    void resetCounters();
+
+    // Newest history entries of a code (0 = any code), newest first.
+    // Indexed: the cost is max reads, not the length of the history.
+    size_t getHistory(uint16_t code, EARS_errorHistoryEntry* out, size_t max);
+
+    // History entries of a code on the card (0 = all)
+    uint32_t getHistoryCount(uint16_t code);
+
+    // Newest entries in the RTC ring, newest first (no card access;
+    // includes what happened before the last soft reset or panic)
+    size_t getRecentErrors(EARS_errorHistoryEntry* out, size_t max);
     
     // Get current error information
     uint16_t getErrorCode();
@@ -82,6 +174,9 @@ public:
     // Manual reload of error messages (if JSON updated)
     bool reloadErrorMessages();
 
+    // Built-in message from the generated flash table (nullptr if unknown)
+    static const char* getBuiltinMessage(uint16_t code);
+
 private:
     // Current error state
     uint16_t currentErrorCode;
@@ -91,8 +186,11 @@ private:
     // File paths
     String errorJsonPath;
     String logFilePath;
+    EARS_sdCard* sdCard;
+    EARS_sdCard* jsonStore; // errors.json and its snapshot
     
-    // Error message storage (code -> message mapping)
+    // Optional SD override layer (code -> message), kept sorted by code.
+    // Built-in messages live in flash, see EARS_errorTable.h
     static const uint8_t MAX_ERROR_MESSAGES = 50;
     struct ErrorMessage {
         uint16_t code;
@@ -100,10 +198,59 @@ private:
     };
     ErrorMessage errorMessages[MAX_ERROR_MESSAGES];
     uint8_t errorMessageCount;
+    SDParseReport loadReport;
+
+    // Bounded multi-producer queue, consumed on Core 1
+    struct QueuedError {
+        uint16_t code;
+        uint8_t level;
+        int64_t timestampUs;
+    };
+    EARS_mpscRing<QueuedError, ERRORS_QUEUE_SIZE> errorQueue;
+    std::atomic<uint32_t> droppedErrors;
+
+    // Per-code occurrence counters for rate limiting / dedup
+    struct ErrorCounter {
+        uint16_t code;          // 0 = free slot
+        uint8_t level;          // Level of the latest occurrence
+        uint32_t total;         // Occurrences since boot or reset
+        uint32_t windowStartMs; // Start of the current dedup window
+        uint32_t windowCount;   // Occurrences in the current window
+        uint32_t lastMs;        // Latest occurrence (LRU eviction)
+    };
+    ErrorCounter counters[ERRORS_COUNTER_SLOTS];
+    uint32_t suppressedTotal;
+    portMUX_TYPE counterLock;
+
+    // Binary history on the card (Core 1 after begin())
+    struct HistoryCode {
+        uint16_t code;
+        uint32_t last;           // Newest record number
+        uint32_t count;
+    };
+    HistoryCode historyCodes[ERRORS_HISTORY_CODES]; // Sorted by code
+    uint8_t historyCodeCount;
+    uint32_t historyRecords;     // Records in the history file
+    uint32_t historyIndexed;     // Records covered by the index checkpoint
+    bool historyReady;
+    SemaphoreHandle_t historyMutex;
+
+    void recordOccurrence(uint16_t code, ErrorLevel level, uint32_t count);
+    bool openHistory();
+    void mirrorHistory();
+    bool appendHistory(EARS_errorHistoryEntry& entry);
+    HistoryCode* findHistoryCode(uint16_t code, bool add);
+    void saveHistoryIndex();
+
+    bool countOccurrence(uint16_t code, ErrorLevel level, uint32_t now);
+    void flushSummaries(uint32_t now, bool all);
+    void writeSummary(const ErrorCounter& counter, uint32_t now);
     
     // Internal methods
     bool loadErrorMessages();
-    void logToHistory(uint16_t code, ErrorLevel level, const char* message);
+    bool loadSnapshot(const char* path, const SDSnapshotKey& key);
+    void saveSnapshot(const char* path, const SDSnapshotKey& key);
+    void logToHistory(uint16_t code, ErrorLevel level, const char* message, uint32_t count = 1);
     String findErrorMessage(uint16_t code);
     String levelToString(ErrorLevel level);
 };
@@ -0,0 +1,244 @@
+/**
+ * @file EARS_eventBusLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Lightweight system event bus (fixed-size publish/subscribe)
+ * @version 1.3.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+#include "EARS_eventBusLib.h"
+
+static_assert(EVENT_BUS_MAX_SUBSCRIBERS <= 32,
+              "EVENT_BUS_MAX_SUBSCRIBERS must fit a 32-bit mask");
+static_assert(EVENT_TYPE_COUNT <= 32,
+              "Event types must fit a 32-bit subscription mask");
+
+// Names for logging, in EARS_eventType order
+static const char *const EVENT_TYPE_NAMES[EVENT_TYPE_COUNT] = {
+    "TOUCH_PRESS",
+    "TOUCH_RELEASE",
+    "HAPTIC_PLAY",
+    "NVS_COMMIT",
+    "SD_MOUNTED",
+    "SD_REMOVED",
+    "SD_COMMIT",
+    "SCREENSAVER_ON",
+    "SCREENSAVER_OFF",
+    "OTA_PROGRESS",
+    "OTA_DONE",
+    "BATTERY",
+};
+
+// Constructor
+EARS_eventBus::EARS_eventBus() : _dropped(0)
+{
+    _subscribeLock = portMUX_INITIALIZER_UNLOCKED;
+
+    for (uint8_t i = 0; i < EVENT_BUS_MAX_SUBSCRIBERS; i++)
+    {
+        _subscribers[i].callback = nullptr;
+        _subscribers[i].userData = nullptr;
+        _subscribers[i].mask = 0;
+    }
+
+    for (uint8_t t = 0; t < EVENT_TYPE_COUNT; t++)
+    {
+        _typeSubscribers[t].store(0);
+    }
+}
+
+// Register a callback for a set of event types
+int8_t EARS_eventBus::subscribe(uint32_t mask, EARS_eventCallback callback, void *userData)
+{
+    if (callback == nullptr || (mask & EVENT_MASK_ALL) == 0)
+    {
+        return -1;
+    }
+
+    int8_t id = -1;
+
+    portENTER_CRITICAL(&_subscribeLock);
+    for (uint8_t i = 0; i < EVENT_BUS_MAX_SUBSCRIBERS; i++)
+    {
+        if (_subscribers[i].callback == nullptr)
+        {
+            _subscribers[i].callback = callback;
+            _subscribers[i].userData = userData;
+            _subscribers[i].mask = mask;
+            id = i;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&_subscribeLock);
+
+    if (id < 0)
+    {
+        Serial.println("[EventBus] ERROR: Subscriber table full");
+        return -1;
+    }
+
+    // Publish the slot to dispatch() only once it is filled in
+    for (uint8_t t = 0; t < EVENT_TYPE_COUNT; t++)
+    {
+        if (mask & EVENT_MASK(t))
+        {
+            _typeSubscribers[t].fetch_or(1UL << id, std::memory_order_release);
+        }
+    }
+
+    return id;
+}
+
+// Remove a subscriber
+void EARS_eventBus::unsubscribe(int8_t id)
+{
+    if (id < 0 || id >= EVENT_BUS_MAX_SUBSCRIBERS)
+    {
+        return;
+    }
+
+    for (uint8_t t = 0; t < EVENT_TYPE_COUNT; t++)
+    {
+        _typeSubscribers[t].fetch_and(~(1UL << id), std::memory_order_release);
+    }
+
+    portENTER_CRITICAL(&_subscribeLock);
+    _subscribers[id].callback = nullptr;
+    _subscribers[id].userData = nullptr;
+    _subscribers[id].mask = 0;
+    portEXIT_CRITICAL(&_subscribeLock);
+}
+
+// Post an event
+bool EARS_eventBus::post(EARS_eventType type, uint32_t value)
+{
+    if (type >= EVENT_TYPE_COUNT)
+    {
+        return false;
+    }
+
+    // Nobody listening - nothing to queue
+    if (_typeSubscribers[type].load(std::memory_order_relaxed) == 0)
+    {
+        return true;
+    }
+
+    EARS_event *event = _ring.claim();
+    if (event == nullptr)
+    {
+        // Ring full: the dispatcher has not caught up
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    event->type = type;
+    event->value = value;
+    event->timestampMs = millis();
+
+    // Hand the event to the dispatcher
+    _ring.publish(event);
+    return true;
+}
+
+// Deliver queued events to their subscribers
+uint16_t EARS_eventBus::dispatch(uint16_t maxEvents)
+{
+    uint16_t count = 0;
+
+    while (count < maxEvents)
+    {
+        // Empty, or the producer is still writing the next event
+        EARS_event *next = _ring.peek();
+        if (next == nullptr)
+        {
+            break;
+        }
+
+        // Copy out and free the slot before the callbacks run
+        EARS_event event = *next;
+        _ring.pop();
+        count++;
+
+        // Only subscribers of this type are visited
+        uint32_t bits = _typeSubscribers[event.type].load(std::memory_order_acquire);
+        while (bits)
+        {
+            uint8_t id = __builtin_ctz(bits);
+            bits &= bits - 1;
+
+            EARS_eventCallback callback = _subscribers[id].callback;
+            if (callback)
+            {
+                callback(event, _subscribers[id].userData);
+            }
+        }
+    }
+
+    return count;
+}
+
+// Events dropped because the ring was full
+uint32_t EARS_eventBus::getDropped() const
+{
+    return _dropped.load(std::memory_order_relaxed);
+}
+
+// Events posted and not yet dispatched
+uint16_t EARS_eventBus::getPending() const
+{
+    uint32_t pending = _ring.pending();
+    return (pending > EVENT_BUS_QUEUE_SIZE) ? EVENT_BUS_QUEUE_SIZE : (uint16_t)pending;
+}
+
+// Readable name of an event type
+const char *EARS_eventBus::typeName(uint8_t type)
+{
+    return (type < EVENT_TYPE_COUNT) ? EVENT_TYPE_NAMES[type] : "UNKNOWN";
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char *EARS_eventBus::getLibraryName()
+{
+    return EARS_EventBus::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t EARS_eventBus::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_EventBus::VERSION_MAJOR,
+                       EARS_EventBus::VERSION_MINOR,
+                       EARS_EventBus::VERSION_PATCH);
+}
+
+// Get version date
+const char *EARS_eventBus::getVersionDate()
+{
+    return EARS_EventBus::VERSION_DATE;
+}
+
+// Format version as string
+void EARS_eventBus::getVersionString(char *buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/**
+ * @brief Get reference to global event bus instance (Singleton pattern)
+ *
+ * @return EARS_eventBus& Reference to the global event bus instance
+ */
+EARS_eventBus &using_eventbus()
+{
+    static EARS_eventBus instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_eventBusLib.cpp
+ *****************************************************************************/
@@ -0,0 +1,195 @@
+/**
+ * @file EARS_eventBusLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Lightweight system event bus (fixed-size publish/subscribe)
+ * @version 1.3.1
+ * @date 20261015
+ *
+ * Features:
+ * - Fixed subscriber table, no heap use after construction
+ * - post() is lock-free and constant time, from any task
+ * - Per-type subscriber masks: dispatch only visits interested subscribers
+ * - Callbacks run in the dispatching task (Core 1 background loop)
+ *
+ * @details
+ * Libraries post what happened (touch, haptic, NVS, SD, battery) without knowing who
+ * cares. Events go into a bounded multi-producer ring (EARS_mpscRing, one
+ * compare-and-swap per post). dispatch() drains the ring and
+ * calls each subscriber registered for the event type. A full ring drops
+ * the new event and counts it.
+ *
+ * Callbacks must be short and must not call LVGL: latch state and act on
+ * it from the owning task instead.
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_EVENT_BUS_LIB_H__
+#define __EARS_EVENT_BUS_LIB_H__
+
+/******************************************************************************
+ * Includes Information
+ *****************************************************************************/
+#include <Arduino.h>
+#include <atomic>
+#include "EARS_versionDef.h"
+#include "EARS_mpscRingDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_EventBus
+{
+    constexpr const char *LIB_NAME = "EARS_eventBus";
+    constexpr const char *VERSION_MAJOR = "1";
+    constexpr const char *VERSION_MINOR = "3";
+    constexpr const char *VERSION_PATCH = "1";
+    constexpr const char *VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Event Bus Configuration
+ *****************************************************************************/
+
+// Pending events (power of two)
+#define EVENT_BUS_QUEUE_SIZE 32
+
+// Subscriber table size (at most 32, one mask bit each)
+#define EVENT_BUS_MAX_SUBSCRIBERS 8
+
+/******************************************************************************
+ * Event Types
+ *****************************************************************************/
+
+/**
+ * @enum EARS_eventType
+ * @brief System events that can be posted to the bus
+ */
+enum EARS_eventType : uint8_t
+{
+    EVENT_TOUCH_PRESS = 0,   // Panel touched (value = x << 16 | y)
+    EVENT_TOUCH_RELEASE,     // Panel released (value = x << 16 | y)
+    EVENT_HAPTIC_PLAY,       // Haptic pattern accepted (value = priority)
+    EVENT_NVS_COMMIT,        // NVS shadow written back (value = field mask)
+    EVENT_SD_MOUNTED,        // SD card mounted (value = bus kHz)
+    EVENT_SD_REMOVED,        // SD card lost
+    EVENT_SD_COMMIT,         // Coalesced SD write committed (value = 1 ok)
+    EVENT_SCREENSAVER_ON,    // Screensaver activated
+    EVENT_SCREENSAVER_OFF,   // Screensaver deactivated
+    EVENT_OTA_PROGRESS,      // Update progress (value = target << 8 | percent)
+    EVENT_OTA_DONE,          // Update ended (value = target << 8 | EARS_otaError)
+    EVENT_BATTERY,           // Charge or state changed (value = MAIN_battery_state_t << 8 | percent)
+    EVENT_TYPE_COUNT
+};
+
+// Subscription mask helpers
+#define EVENT_MASK(type) (1UL << (type))
+#define EVENT_MASK_ALL ((1UL << EVENT_TYPE_COUNT) - 1)
+#define EVENT_MASK_USER_ACTIVITY (EVENT_MASK(EVENT_TOUCH_PRESS) | EVENT_MASK(EVENT_TOUCH_RELEASE))
+
+/**
+ * @struct EARS_event
+ * @brief One posted event
+ */
+struct EARS_event
+{
+    uint8_t type;         // EARS_eventType
+    uint32_t value;       // Type specific value
+    uint32_t timestampMs; // millis() at post
+};
+
+/**
+ * @brief Subscriber callback
+ * @param event The event being dispatched
+ * @param userData Pointer given to subscribe()
+ */
+typedef void (*EARS_eventCallback)(const EARS_event &event, void *userData);
+
+class EARS_eventBus
+{
+public:
+    /**
+     * @brief Construct a new Event Bus
+     */
+    EARS_eventBus();
+
+    // Version information getters
+    static const char *getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char *getVersionDate();
+    static void getVersionString(char *buffer);
+
+    /**
+     * @brief Register a callback for a set of event types
+     * @param mask EVENT_MASK() bits of the wanted types
+     * @param callback Function run from dispatch()
+     * @param userData Passed back to the callback
+     * @return int8_t Subscriber id, or -1 if the table is full
+     */
+    int8_t subscribe(uint32_t mask, EARS_eventCallback callback, void *userData = nullptr);
+
+    /**
+     * @brief Remove a subscriber
+     * @param id Id returned by subscribe()
+     */
+    void unsubscribe(int8_t id);
+
+    /**
+     * @brief Post an event (lock-free, constant time, any task)
+     * @param type EARS_eventType
+     * @param value Type specific value
+     * @return true if queued, false if the ring was full
+     */
+    bool post(EARS_eventType type, uint32_t value = 0);
+
+    /**
+     * @brief Deliver queued events to their subscribers
+     * @param maxEvents Upper bound on events handled this call
+     * @return uint16_t Events dispatched
+     * @note Call from one task only (the Core 1 background loop)
+     */
+    uint16_t dispatch(uint16_t maxEvents = EVENT_BUS_QUEUE_SIZE);
+
+    /**
+     * @brief Events dropped because the ring was full
+     * @return uint32_t Dropped count since boot
+     */
+    uint32_t getDropped() const;
+
+    /**
+     * @brief Events posted and not yet dispatched
+     * @return uint16_t Queue depth (approximate outside the dispatching task)
+     */
+    uint16_t getPending() const;
+
+    /**
+     * @brief Readable name of an event type
+     * @param type EARS_eventType
+     * @return const char* Name (static string)
+     */
+    static const char *typeName(uint8_t type);
+
+private:
+    struct Subscriber
+    {
+        EARS_eventCallback callback;
+        void *userData;
+        uint32_t mask;
+    };
+
+    Subscriber _subscribers[EVENT_BUS_MAX_SUBSCRIBERS];
+    std::atomic<uint32_t> _typeSubscribers[EVENT_TYPE_COUNT]; // Subscriber bits per type
+    EARS_mpscRing<EARS_event, EVENT_BUS_QUEUE_SIZE> _ring; // Dispatcher consumes
+    std::atomic<uint32_t> _dropped;
+    portMUX_TYPE _subscribeLock;
+};
+
+// Global instance access function
+EARS_eventBus &using_eventbus();
+
+#endif // __EARS_EVENT_BUS_LIB_H__
+
+/******************************************************************************
+ * End of EARS_eventBusLib.h
+ *****************************************************************************/
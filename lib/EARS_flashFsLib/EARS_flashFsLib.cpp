@@ -0,0 +1,138 @@
+/**
+ * @file EARS_flashFsLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Internal flash filesystem (LittleFS) for small, hot files
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#include "EARS_flashFsLib.h"
+#include <esp_timer.h>
+
+// Constructor: the EARS_sdCard file API over LittleFS
+EARS_flashFs::EARS_flashFs()
+    : EARS_sdCard(LittleFS, FLASHFS_MOUNT_POINT), _mountUs(0), _formatted(false)
+{
+}
+
+// Mount the partition
+bool EARS_flashFs::begin()
+{
+    if (isAvailable())
+    {
+        return true;
+    }
+
+    uint32_t start = (uint32_t)esp_timer_get_time();
+    bool mounted = LittleFS.begin(false, FLASHFS_MOUNT_POINT, FLASHFS_MAX_OPEN_FILES, FLASHFS_PARTITION_LABEL);
+
+#if FLASHFS_FORMAT_ON_FAIL == 1
+    if (!mounted)
+    {
+        Serial.println("[FLASHFS] Mount failed, formatting the partition");
+        mounted = LittleFS.begin(true, FLASHFS_MOUNT_POINT, FLASHFS_MAX_OPEN_FILES, FLASHFS_PARTITION_LABEL);
+        _formatted = mounted;
+    }
+#endif
+    _mountUs = (uint32_t)esp_timer_get_time() - start;
+
+    if (!mounted)
+    {
+        Serial.println("[FLASHFS] ERROR: No \"" FLASHFS_PARTITION_LABEL "\" partition mounted");
+        _state = SD_INIT_FAILED;
+        return false;
+    }
+
+    _state = SD_CARD_READY;
+    if (!directoryExists(FLASHFS_CONFIG_DIR))
+    {
+        createDirectory(FLASHFS_CONFIG_DIR);
+    }
+
+    // An interrupted atomic write is finished by its owner on begin()
+    return true;
+}
+
+uint32_t EARS_flashFs::getTotalKB() const
+{
+    if (!isAvailable())
+        return 0;
+    return (uint32_t)(LittleFS.totalBytes() / 1024);
+}
+
+uint32_t EARS_flashFs::getUsedKB() const
+{
+    if (!isAvailable())
+        return 0;
+    return (uint32_t)(LittleFS.usedBytes() / 1024);
+}
+
+FlashFsInitResult EARS_flashFs::performFullInitialization()
+{
+    FlashFsInitResult result;
+
+    begin();
+    result.state = getState();
+    result.totalKB = getTotalKB();
+    result.usedKB = getUsedKB();
+    result.mountUs = _mountUs;
+    result.formatted = _formatted;
+
+#if EARS_DEBUG == 1
+    if (result.state == SD_CARD_READY)
+    {
+        Serial.printf("[FLASHFS] LittleFS mounted in %lu us: %lu/%lu KB used%s\n",
+                      (unsigned long)result.mountUs, (unsigned long)result.usedKB,
+                      (unsigned long)result.totalKB, result.formatted ? " (formatted)" : "");
+    }
+#endif
+    return result;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char *EARS_flashFs::getLibraryName()
+{
+    return EARS_FlashFs::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t EARS_flashFs::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_FlashFs::VERSION_MAJOR,
+                       EARS_FlashFs::VERSION_MINOR,
+                       EARS_FlashFs::VERSION_PATCH);
+}
+
+// Get version date
+const char *EARS_flashFs::getVersionDate()
+{
+    return EARS_FlashFs::VERSION_DATE;
+}
+
+// Format version as string
+void EARS_flashFs::getVersionString(char *buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/**
+ * @brief Get reference to global flash filesystem instance (Singleton pattern)
+ *
+ * @return EARS_flashFs& Reference to the global instance
+ */
+EARS_flashFs &using_flashfs()
+{
+    static EARS_flashFs instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_flashFsLib.cpp
+ *****************************************************************************/
@@ -0,0 +1,124 @@
+/**
+ * @file EARS_flashFsLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Internal flash filesystem (LittleFS) for small, hot files
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * Features:
+ * - LittleFS on the "littlefs" partition (partitions_ears.csv)
+ * - The EARS_sdCard file API: cached handles, atomic and coalesced
+ *   writes, snapshots, truncate; anything taking an EARS_sdCard* works
+ * - Mounts in a few milliseconds with no card inserted
+ *
+ * @details
+ * ears.config, errors.json and their journal and snapshot files live here,
+ * under the same paths they had on the card (/config/...), so the system
+ * configures itself without waiting for SD_MMC and without a card. The SD
+ * card keeps bulk data: logs, records, images and asset updates.
+ *
+ * The partition image is built from data/ (board_build.filesystem =
+ * littlefs, "pio run -t uploadfs"). A partition that does not mount is
+ * formatted once (FLASHFS_FORMAT_ON_FAIL) and the owners write their
+ * defaults, as they do for a blank card.
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_FLASH_FS_LIB_H__
+#define __EARS_FLASH_FS_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "EARS_versionDef.h"
+#include "EARS_sdCardLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_FlashFs
+{
+    constexpr const char *LIB_NAME = "EARS_flashFs";
+    constexpr const char *VERSION_MAJOR = "1";
+    constexpr const char *VERSION_MINOR = "0";
+    constexpr const char *VERSION_PATCH = "0";
+    constexpr const char *VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Flash Filesystem Configuration
+ *****************************************************************************/
+
+#define FLASHFS_PARTITION_LABEL "littlefs"
+#define FLASHFS_MOUNT_POINT "/littlefs"                   // VFS mount point (POSIX calls need it)
+#define FLASHFS_MAX_OPEN_FILES (SD_HANDLE_CACHE_SIZE + 2) // Cached handles plus transient opens
+#define FLASHFS_FORMAT_ON_FAIL 1                          // Format a partition that does not mount
+#define FLASHFS_CONFIG_DIR "/config"
+
+/**
+ * @struct FlashFsInitResult
+ * @brief Result of performFullInitialization()
+ */
+struct FlashFsInitResult
+{
+    SDCardState state;  // SD_CARD_READY when mounted
+    uint32_t totalKB;   // Partition capacity
+    uint32_t usedKB;    // In use
+    uint32_t mountUs;   // Time to mount
+    bool formatted;     // Partition was formatted to mount
+
+    FlashFsInitResult() : state(SD_NOT_INITIALIZED),
+                          totalKB(0),
+                          usedKB(0),
+                          mountUs(0),
+                          formatted(false) {}
+};
+
+/******************************************************************************
+ * EARS_flashFs Class
+ *****************************************************************************/
+class EARS_flashFs : public EARS_sdCard
+{
+public:
+    EARS_flashFs();
+
+    // Version information getters
+    static const char *getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char *getVersionDate();
+    static void getVersionString(char *buffer);
+
+    /**
+     * @brief Mount the partition and create the config directory
+     * @return true if mounted
+     */
+    bool begin();
+
+    // Capacity of the partition (the card getters report the SD card)
+    uint32_t getTotalKB() const;
+    uint32_t getUsedKB() const;
+    uint32_t getMountUs() const { return _mountUs; }
+
+    /**
+     * @brief Mount and report, for the boot stage
+     * @return FlashFsInitResult State, capacity and mount time
+     */
+    FlashFsInitResult performFullInitialization();
+
+private:
+    uint32_t _mountUs;
+    bool _formatted;
+};
+
+// Global instance access function
+EARS_flashFs &using_flashfs();
+
+#endif // __EARS_FLASH_FS_LIB_H__
+
+/******************************************************************************
+ * End of EARS_flashFsLib.h
+ *****************************************************************************/
@@ -0,0 +1,454 @@
+/**
+ * @file EARS_gestureLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Software gesture recogniser on top of EARS_touch
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#include "EARS_gestureLib.h"
+
+// Squared distance between two points (screen coordinates fit in 32 bits)
+static inline uint32_t gesture_distance2(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    int32_t dx = x1 - x0;
+    int32_t dy = y1 - y0;
+    return (uint32_t)(dx * dx + dy * dy);
+}
+
+static inline int16_t gesture_clamp16(int32_t value)
+{
+    if (value > INT16_MAX)
+        return INT16_MAX;
+    if (value < -INT16_MAX)
+        return -INT16_MAX;
+    return (int16_t)value;
+}
+
+// Constructor
+EARS_gesture::EARS_gesture()
+    : _historyCount(0), _historyHead(0), _pressed(false), _multi(false), _longPressSent(false),
+      _pressUs(0), _pressX(0), _pressY(0), _maxTravel2(0),
+      _tapPending(false), _tapUs(0), _tapX(0), _tapY(0),
+      _twoFinger(false), _pinchActive(false), _rotateActive(false), _startSpanQ8(0), _startAngle(0),
+      _lastScaleQ8(GESTURE_SCALE_ONE), _lastAngle(0), _centreX(0), _centreY(0),
+      _head(0), _tail(0), _recognised(0), _dropped(0), _touch(nullptr), _eventCode(0)
+{
+    memset(_history, 0, sizeof(_history));
+    memset(_ring, 0, sizeof(_ring));
+}
+
+// Register the event code and install the touch hooks
+bool EARS_gesture::begin(EARS_touch &touch)
+{
+    if (_touch != nullptr)
+    {
+        return true;
+    }
+
+    if (!touch.isSamplingTaskRunning())
+    {
+        Serial.println("[GESTURE] ERROR: Touch sampling task not running");
+        return false;
+    }
+
+    _eventCode = lv_event_register_id();
+    _touch = &touch;
+
+    // Consumer first, so nothing is produced before it can be sent
+    touch.setReadHook(readHook);
+    touch.setSampleHook(sampleHook);
+
+#if EARS_DEBUG == 1
+    Serial.printf("[GESTURE] Recogniser on the sampling task, LVGL event %lu\n", (unsigned long)_eventCode);
+#endif
+    return true;
+}
+
+// Recognise from one press, move or release edge (sampling task)
+void EARS_gesture::feed(const TouchEvent &event)
+{
+    if (event.points == 0)
+    {
+        if (_twoFinger)
+        {
+            twoFingerEnd(event.timestampUs);
+        }
+        if (_pressed)
+        {
+            pressEnd(event.timestampUs);
+        }
+        return;
+    }
+
+    if (!_pressed)
+    {
+        pressStart(event);
+    }
+
+    if (event.points >= 2)
+    {
+        _multi = true;
+        _tapPending = false;
+        twoFingerMove(event);
+        return;
+    }
+
+    // One finger left of two: the pinch or rotate ends, nothing else starts
+    if (_twoFinger)
+    {
+        twoFingerEnd(event.timestampUs);
+    }
+    pressMove(event);
+}
+
+// Send the waiting gestures (LVGL task)
+void EARS_gesture::dispatch()
+{
+    uint32_t tail = _tail.load(std::memory_order_relaxed);
+    uint32_t head = _head.load(std::memory_order_acquire);
+
+    while (tail != head)
+    {
+        EARS_gestureInfo info = _ring[tail & (GESTURE_RING_SIZE - 1)];
+        _tail.store(++tail, std::memory_order_release);
+
+        lv_obj_t *screen = lv_screen_active();
+        if (screen == NULL)
+        {
+            continue;
+        }
+
+        lv_point_t point = {info.x, info.y};
+        lv_obj_t *target = lv_indev_search_obj(screen, &point);
+        if (target == NULL)
+        {
+            target = screen;
+        }
+
+        // The handler may delete the object: the indev event goes regardless
+        lv_obj_send_event(target, (lv_event_code_t)_eventCode, &info);
+        if (_touch != nullptr && _touch->getInputDevice() != NULL)
+        {
+            lv_indev_send_event(_touch->getInputDevice(), (lv_event_code_t)_eventCode, &info);
+        }
+    }
+}
+
+/******************************************************************************
+ * Recogniser (sampling task)
+ *****************************************************************************/
+
+void EARS_gesture::pressStart(const TouchEvent &event)
+{
+    _pressed = true;
+    _multi = false;
+    _longPressSent = false;
+    _pressUs = event.timestampUs;
+    _pressX = event.x;
+    _pressY = event.y;
+    _maxTravel2 = 0;
+    _historyCount = 0;
+    _historyHead = 0;
+
+    // A second press too late or too far away starts over
+    if (_tapPending &&
+        ((uint32_t)(event.timestampUs - _tapUs) > GESTURE_DOUBLE_TAP_GAP_MS * 1000UL ||
+         gesture_distance2(_tapX, _tapY, event.x, event.y) >
+             (uint32_t)GESTURE_DOUBLE_TAP_SLOP_PX * GESTURE_DOUBLE_TAP_SLOP_PX))
+    {
+        _tapPending = false;
+    }
+}
+
+void EARS_gesture::pressMove(const TouchEvent &event)
+{
+    Sample &sample = _history[_historyHead];
+    sample.timeUs = event.timestampUs;
+    sample.x = event.x;
+    sample.y = event.y;
+    _historyHead = (_historyHead + 1) & (GESTURE_HISTORY_SIZE - 1);
+    if (_historyCount < GESTURE_HISTORY_SIZE)
+    {
+        _historyCount++;
+    }
+
+    uint32_t travel2 = gesture_distance2(_pressX, _pressY, event.x, event.y);
+    if (travel2 > _maxTravel2)
+    {
+        _maxTravel2 = travel2;
+    }
+
+    if (!_multi && !_longPressSent && _maxTravel2 <= (uint32_t)GESTURE_TAP_SLOP_PX * GESTURE_TAP_SLOP_PX &&
+        (uint32_t)(event.timestampUs - _pressUs) >= GESTURE_LONG_PRESS_MS * 1000UL)
+    {
+        _longPressSent = true;
+        _tapPending = false;
+
+        EARS_gestureInfo info = {};
+        info.type = GESTURE_TYPE_LONG_PRESS;
+        info.phase = GESTURE_PHASE_END;
+        info.x = _pressX;
+        info.y = _pressY;
+        info.timestampUs = event.timestampUs;
+        emit(info);
+    }
+}
+
+void EARS_gesture::pressEnd(uint32_t nowUs)
+{
+    _pressed = false;
+    if (_multi || _longPressSent || _historyCount == 0)
+    {
+        return;
+    }
+
+    const Sample &last = _history[(_historyHead - 1) & (GESTURE_HISTORY_SIZE - 1)];
+    int32_t dx = last.x - _pressX;
+    int32_t dy = last.y - _pressY;
+
+    // Swipe: far enough, and still moving fast over the last samples
+    if ((uint32_t)(dx * dx + dy * dy) >= (uint32_t)GESTURE_SWIPE_MIN_PX * GESTURE_SWIPE_MIN_PX)
+    {
+        const Sample *oldest = &last;
+        for (uint8_t i = 1; i < _historyCount; i++)
+        {
+            const Sample &sample = _history[(_historyHead - 1 - i) & (GESTURE_HISTORY_SIZE - 1)];
+            if ((uint32_t)(last.timeUs - sample.timeUs) > GESTURE_SWIPE_WINDOW_MS * 1000UL)
+            {
+                break;
+            }
+            oldest = &sample;
+        }
+
+        uint32_t dtUs = last.timeUs - oldest->timeUs;
+        if (dtUs > 0)
+        {
+            // px * 1e6 / us: at most 480e6, within int32
+            int16_t vx = gesture_clamp16((int32_t)(last.x - oldest->x) * 1000000L / (int32_t)dtUs);
+            int16_t vy = gesture_clamp16((int32_t)(last.y - oldest->y) * 1000000L / (int32_t)dtUs);
+            uint32_t speed = lv_sqrt32((uint32_t)((int32_t)vx * vx) + (uint32_t)((int32_t)vy * vy));
+
+            if (speed >= GESTURE_SWIPE_MIN_SPEED)
+            {
+                EARS_gestureInfo info = {};
+                info.type = GESTURE_TYPE_SWIPE;
+                info.phase = GESTURE_PHASE_END;
+                if (LV_ABS(dx) >= LV_ABS(dy))
+                {
+                    info.direction = (dx < 0) ? LV_DIR_LEFT : LV_DIR_RIGHT;
+                }
+                else
+                {
+                    info.direction = (dy < 0) ? LV_DIR_TOP : LV_DIR_BOTTOM;
+                }
+                info.x = _pressX;
+                info.y = _pressY;
+                info.vx = vx;
+                info.vy = vy;
+                info.speed = (uint16_t)LV_MIN(speed, UINT16_MAX);
+                info.timestampUs = nowUs;
+                emit(info);
+                _tapPending = false;
+                return;
+            }
+        }
+    }
+
+    // Tap: short and still; a second one close to the first is a double-tap
+    if ((uint32_t)(nowUs - _pressUs) > GESTURE_TAP_MAX_MS * 1000UL ||
+        _maxTravel2 > (uint32_t)GESTURE_TAP_SLOP_PX * GESTURE_TAP_SLOP_PX)
+    {
+        _tapPending = false;
+        return;
+    }
+
+    if (_tapPending)
+    {
+        _tapPending = false;
+
+        EARS_gestureInfo info = {};
+        info.type = GESTURE_TYPE_DOUBLE_TAP;
+        info.phase = GESTURE_PHASE_END;
+        info.x = _tapX;
+        info.y = _tapY;
+        info.timestampUs = nowUs;
+        emit(info);
+        return;
+    }
+
+    _tapPending = true;
+    _tapUs = nowUs;
+    _tapX = _pressX;
+    _tapY = _pressY;
+}
+
+void EARS_gesture::twoFingerMove(const TouchEvent &event)
+{
+    int32_t dx = event.x2 - event.x;
+    int32_t dy = event.y2 - event.y;
+    uint32_t span2 = (uint32_t)(dx * dx + dy * dy);
+    if (span2 < (uint32_t)GESTURE_PINCH_MIN_SPAN_PX * GESTURE_PINCH_MIN_SPAN_PX)
+    {
+        return;
+    }
+
+    // Span in Q8 pixels; lv_atan2(y, x) is 0 along +X and, y down, grows clockwise
+    lv_sqrt_res_t root;
+    lv_sqrt(span2, &root, 0x8000);
+    uint32_t spanQ8 = ((uint32_t)root.i << 8) | root.f;
+    int16_t angle = (int16_t)lv_atan2(dy, dx);
+
+    _centreX = (event.x + event.x2) / 2;
+    _centreY = (event.y + event.y2) / 2;
+
+    if (!_twoFinger)
+    {
+        _twoFinger = true;
+        _pinchActive = false;
+        _rotateActive = false;
+        _startSpanQ8 = spanQ8;
+        _startAngle = angle;
+        _lastScaleQ8 = GESTURE_SCALE_ONE;
+        _lastAngle = 0;
+        return;
+    }
+
+    EARS_gestureInfo info = {};
+    info.x = _centreX;
+    info.y = _centreY;
+    info.timestampUs = event.timestampUs;
+
+    uint32_t scale = spanQ8 * GESTURE_SCALE_ONE / _startSpanQ8;
+    uint16_t scaleQ8 = (uint16_t)LV_MIN(scale, UINT16_MAX);
+    if (LV_ABS((int32_t)scaleQ8 - _lastScaleQ8) >= GESTURE_PINCH_STEP_Q8)
+    {
+        info.type = GESTURE_TYPE_PINCH;
+        info.phase = _pinchActive ? GESTURE_PHASE_CHANGE : GESTURE_PHASE_BEGIN;
+        info.scaleQ8 = scaleQ8;
+        info.angle = _lastAngle;
+        emit(info);
+        _pinchActive = true;
+        _lastScaleQ8 = scaleQ8;
+    }
+
+    int16_t delta = angle - _startAngle;
+    if (delta > 180)
+    {
+        delta -= 360;
+    }
+    else if (delta <= -180)
+    {
+        delta += 360;
+    }
+    if (LV_ABS(delta - _lastAngle) >= GESTURE_ROTATE_STEP_DEG)
+    {
+        info.type = GESTURE_TYPE_ROTATE;
+        info.phase = _rotateActive ? GESTURE_PHASE_CHANGE : GESTURE_PHASE_BEGIN;
+        info.scaleQ8 = _lastScaleQ8;
+        info.angle = delta;
+        emit(info);
+        _rotateActive = true;
+        _lastAngle = delta;
+    }
+}
+
+void EARS_gesture::twoFingerEnd(uint32_t nowUs)
+{
+    EARS_gestureInfo info = {};
+    info.phase = GESTURE_PHASE_END;
+    info.x = _centreX;
+    info.y = _centreY;
+    info.scaleQ8 = _lastScaleQ8;
+    info.angle = _lastAngle;
+    info.timestampUs = nowUs;
+
+    if (_pinchActive)
+    {
+        info.type = GESTURE_TYPE_PINCH;
+        emit(info);
+    }
+    if (_rotateActive)
+    {
+        info.type = GESTURE_TYPE_ROTATE;
+        emit(info);
+    }
+
+    _twoFinger = false;
+    _pinchActive = false;
+    _rotateActive = false;
+}
+
+void EARS_gesture::emit(const EARS_gestureInfo &info)
+{
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    uint32_t tail = _tail.load(std::memory_order_acquire);
+
+    if (head - tail >= GESTURE_RING_SIZE)
+    {
+        _dropped++;
+        return;
+    }
+
+    _ring[head & (GESTURE_RING_SIZE - 1)] = info;
+    _head.store(head + 1, std::memory_order_release);
+    _recognised++;
+}
+
+void EARS_gesture::sampleHook(const TouchEvent &event)
+{
+    using_gesture().feed(event);
+}
+
+void EARS_gesture::readHook()
+{
+    using_gesture().dispatch();
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char *EARS_gesture::getLibraryName()
+{
+    return EARS_Gesture::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t EARS_gesture::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_Gesture::VERSION_MAJOR,
+                       EARS_Gesture::VERSION_MINOR,
+                       EARS_Gesture::VERSION_PATCH);
+}
+
+// Get version date
+const char *EARS_gesture::getVersionDate()
+{
+    return EARS_Gesture::VERSION_DATE;
+}
+
+// Format version as string
+void EARS_gesture::getVersionString(char *buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/**
+ * @brief Get reference to global gesture recogniser (Singleton pattern)
+ *
+ * @return EARS_gesture& Reference to the global recogniser
+ */
+EARS_gesture &using_gesture()
+{
+    static EARS_gesture instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_gestureLib.cpp
+ *****************************************************************************/
@@ -0,0 +1,238 @@
+/**
+ * @file EARS_gestureLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Software gesture recogniser on top of EARS_touch
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * Features:
+ * - Two-finger pinch (scale) and rotate (angle) with begin/change/end
+ * - Swipe with direction and release velocity
+ * - Long-press and double-tap
+ * - Runs on the touch sampling task with a short history ring, integer and
+ *   fixed-point maths only (Q8 scale, lv_atan2/lv_sqrt)
+ * - Delivered on the LVGL task as one registered LVGL event code
+ *
+ * @details
+ * The FT6236 REG_GEST codes are only reported by some firmware and carry
+ * no amount, and LVGL's own recogniser runs inside the indev read on the
+ * UI task. Here every sample the sampling task queues (EARS_touch sample
+ * hook, both points) goes through feed() where it is made; recognised
+ * gestures wait in a lock-free single-producer/single-consumer ring and
+ * are sent from the indev read (EARS_touch read hook), so they arrive in
+ * order with the presses LVGL sees.
+ *
+ * Each gesture is sent with getEventCode() and an EARS_gestureInfo as the
+ * parameter, first to the object under the point (the two-finger centre
+ * for pinch and rotate, the active screen if there is none), then to the
+ * input device, where screen-wide handlers listen:
+ *
+ *   lv_indev_add_event_cb(using_touch().getInputDevice(), cb,
+ *                         (lv_event_code_t)using_gesture().getEventCode(), NULL);
+ *
+ * Needs the sampling task (TOUCH_SAMPLING_TASK_ENABLED); LVGL's own
+ * LV_EVENT_LONG_PRESSED and LV_EVENT_DOUBLE_CLICKED are not affected.
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_GESTURE_LIB_H__
+#define __EARS_GESTURE_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <lvgl.h>
+#include <atomic>
+#include "EARS_versionDef.h"
+#include "EARS_touchLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_Gesture
+{
+    constexpr const char *LIB_NAME = "EARS_gesture";
+    constexpr const char *VERSION_MAJOR = "1";
+    constexpr const char *VERSION_MINOR = "0";
+    constexpr const char *VERSION_PATCH = "0";
+    constexpr const char *VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Gesture Configuration
+ *****************************************************************************/
+
+#define GESTURE_HISTORY_SIZE 8         // Single-finger samples kept (power of two)
+#define GESTURE_RING_SIZE 16           // Gestures waiting for the LVGL task (power of two)
+
+#define GESTURE_TAP_SLOP_PX 10         // Travel still counted as a tap or hold
+#define GESTURE_TAP_MAX_MS 250         // Longest press counted as a tap
+#define GESTURE_DOUBLE_TAP_GAP_MS 300  // Release to second press
+#define GESTURE_DOUBLE_TAP_SLOP_PX 30  // Distance between the two taps
+#define GESTURE_LONG_PRESS_MS 600      // Hold before a long-press
+
+#define GESTURE_SWIPE_MIN_PX 40        // Travel from the press
+#define GESTURE_SWIPE_MIN_SPEED 300    // px/s at release
+#define GESTURE_SWIPE_WINDOW_MS 100    // Samples the release velocity is taken over
+
+#define GESTURE_SCALE_ONE 256          // Q8 pinch scale of 1.0
+#define GESTURE_PINCH_MIN_SPAN_PX 16   // Fingers closer than this are not tracked
+#define GESTURE_PINCH_STEP_Q8 8        // Scale change between events (~3%)
+#define GESTURE_ROTATE_STEP_DEG 2      // Angle change between events
+
+/******************************************************************************
+ * Gesture Types
+ *****************************************************************************/
+
+/**
+ * @enum EARS_gestureType
+ * @brief Recognised gesture
+ */
+enum EARS_gestureType : uint8_t
+{
+    GESTURE_TYPE_NONE = 0,
+    GESTURE_TYPE_SWIPE,      // One finger, on release
+    GESTURE_TYPE_PINCH,      // Two fingers, scale
+    GESTURE_TYPE_ROTATE,     // Two fingers, angle
+    GESTURE_TYPE_LONG_PRESS, // One finger, held still
+    GESTURE_TYPE_DOUBLE_TAP  // Two taps close in time and place
+};
+
+/**
+ * @enum EARS_gesturePhase
+ * @brief Stage of a continuous gesture (pinch, rotate); others are END
+ */
+enum EARS_gesturePhase : uint8_t
+{
+    GESTURE_PHASE_BEGIN = 0,
+    GESTURE_PHASE_CHANGE,
+    GESTURE_PHASE_END
+};
+
+/**
+ * @struct EARS_gestureInfo
+ * @brief Parameter of the gesture event
+ */
+struct EARS_gestureInfo
+{
+    EARS_gestureType type;
+    EARS_gesturePhase phase;
+    lv_dir_t direction;   // Swipe: LV_DIR_LEFT/RIGHT/TOP/BOTTOM
+    int16_t x;            // Point, or the two-finger centre
+    int16_t y;
+    uint16_t scaleQ8;     // Pinch: span / starting span, GESTURE_SCALE_ONE = 1.0
+    int16_t angle;        // Rotate: degrees since the start, clockwise positive
+    int16_t vx;           // Swipe: release velocity, px/s
+    int16_t vy;
+    uint16_t speed;       // Swipe: |v|, px/s
+    uint32_t timestampUs; // Sample that completed the gesture
+};
+
+/******************************************************************************
+ * EARS_gesture Class
+ *****************************************************************************/
+class EARS_gesture
+{
+public:
+    EARS_gesture();
+
+    // Version information getters
+    static const char *getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char *getVersionDate();
+    static void getVersionString(char *buffer);
+
+    /**
+     * @brief Register the event code and hook into the touch driver
+     * @details LVGL task, after lv_init(). Needs the sampling task.
+     * @param touch Touch driver whose samples are recognised
+     * @return true if gestures will be delivered
+     */
+    bool begin(EARS_touch &touch);
+
+    /**
+     * @brief LVGL event code the gestures are sent with
+     * @return Registered code, 0 before begin()
+     */
+    uint32_t getEventCode() const { return _eventCode; }
+
+    /**
+     * @brief Recognise from one touch event (sampling task)
+     * @param event Press, move or release edge with both points
+     */
+    void feed(const TouchEvent &event);
+
+    /**
+     * @brief Send the waiting gestures as LVGL events (LVGL task)
+     */
+    void dispatch();
+
+    uint32_t getRecognised() const { return _recognised; }
+    uint32_t getDropped() const { return _dropped; }
+
+private:
+    struct Sample
+    {
+        uint32_t timeUs;
+        int16_t x;
+        int16_t y;
+    };
+
+    // Recogniser state (sampling task only)
+    Sample _history[GESTURE_HISTORY_SIZE];
+    uint8_t _historyCount;
+    uint8_t _historyHead;
+    bool _pressed;
+    bool _multi;          // Two fingers seen during this press
+    bool _longPressSent;
+    uint32_t _pressUs;
+    int16_t _pressX;
+    int16_t _pressY;
+    uint32_t _maxTravel2; // Furthest from the press point, squared
+
+    bool _tapPending;     // First tap of a possible double-tap
+    uint32_t _tapUs;
+    int16_t _tapX;
+    int16_t _tapY;
+
+    bool _twoFinger;      // Two-finger baseline held
+    bool _pinchActive;
+    bool _rotateActive;
+    uint32_t _startSpanQ8;
+    int16_t _startAngle;
+    uint16_t _lastScaleQ8;
+    int16_t _lastAngle;
+    int16_t _centreX;
+    int16_t _centreY;
+
+    // SPSC gesture ring (producer: sampling task, consumer: LVGL task)
+    EARS_gestureInfo _ring[GESTURE_RING_SIZE];
+    std::atomic<uint32_t> _head;
+    std::atomic<uint32_t> _tail;
+    uint32_t _recognised;
+    uint32_t _dropped;
+
+    EARS_touch *_touch;
+    uint32_t _eventCode;
+
+    void pressStart(const TouchEvent &event);
+    void pressMove(const TouchEvent &event);
+    void pressEnd(uint32_t nowUs);
+    void twoFingerMove(const TouchEvent &event);
+    void twoFingerEnd(uint32_t nowUs);
+    void emit(const EARS_gestureInfo &info);
+    static void sampleHook(const TouchEvent &event);
+    static void readHook();
+};
+
+// Global instance access function
+EARS_gesture &using_gesture();
+
+#endif // __EARS_GESTURE_LIB_H__
+
+/******************************************************************************
+ * End of EARS_gestureLib.h
+ *****************************************************************************/
@@ -2,8 +2,8 @@
  * @file EARS_hapticLib.cpp
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief Manages haptic feedback motor with PWM intensity and duration control
- * @version 2.0.0
- * @date 20260210
+ * @version 2.3.0
+ * @date 20261014
  * 
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -12,25 +12,35 @@
 // Constructor
 EARS_haptic::EARS_haptic()
     : _pin(0),
-      _pwmChannel(0),
-      _pwmResolution(8),
-      _maxDutyCycle(255),
+      _pwmChannel(-1),
       _currentIntensity(0),
       _currentDuration(0),
-      _initialized(false) {
+      _initialized(false),
+      _stepTimer(nullptr),
+      _queueHead(0),
+      _queueCount(0),
+      _currentStep(0),
+      _playing(false) {
+    _seqLock = portMUX_INITIALIZER_UNLOCKED;
+    _current.count = 0;
+    _current.priority = HAPTIC_PRIORITY_LOW;
 }
 
 // Initialise the haptic manager
 bool EARS_haptic::begin(uint8_t pin, uint8_t pwmChannel, 
                         uint32_t pwmFrequency, uint8_t pwmResolution) {
     _pin = pin;
-    _pwmChannel = pwmChannel;
-    _pwmResolution = pwmResolution;
-    _maxDutyCycle = (1 << pwmResolution) - 1;  // e.g., 255 for 8-bit
 
-    // Configure PWM
-    ledcSetup(_pwmChannel, pwmFrequency, _pwmResolution);
-    ledcAttachPin(_pin, _pwmChannel);
+    // Configure PWM - the manager moves us off a channel whose timer runs
+    // at another frequency (e.g. the backlight's)
+    if (_pwmChannel < 0) {
+        _pwmChannel = using_pwmmanager().attach(_pin, pwmFrequency, pwmResolution,
+                                                "haptic", pwmChannel);
+        if (_pwmChannel < 0) {
+            Serial.println("[HapticManager] ERROR: No PWM channel available");
+            return false;
+        }
+    }
 
     // Open NVS preferences
     if (!_preferences.begin(NVS_NAMESPACE, false)) {
@@ -55,7 +65,21 @@ bool EARS_haptic::begin(uint8_t pin, uint8_t pwmChannel,
     }
 
     // Turn motor off initially
-    ledcWrite(_pwmChannel, 0);
+    using_pwmmanager().writeDuty(_pwmChannel, 0);
+
+    // Step timer runs patterns in the esp_timer task, not the caller's
+    if (_stepTimer == nullptr) {
+        esp_timer_create_args_t timerArgs = {};
+        timerArgs.callback = &EARS_haptic::stepTimerCallback;
+        timerArgs.arg = this;
+        timerArgs.dispatch_method = ESP_TIMER_TASK;
+        timerArgs.name = "haptic";
+
+        if (esp_timer_create(&timerArgs, &_stepTimer) != ESP_OK) {
+            _stepTimer = nullptr;
+            Serial.println("[HapticManager] WARNING: Step timer unavailable - patterns will block");
+        }
+    }
     
     _initialized = true;
     Serial.printf("[HapticManager] Initialised on pin %d, PWM channel %d, freq %d Hz\n", 
@@ -210,7 +234,121 @@ void EARS_haptic::off() {
         return;
     }
     
-    ledcWrite(_pwmChannel, 0);
+    stop();
+}
+
+// Play a pattern without blocking the caller
+bool EARS_haptic::playPattern(const HapticStep* steps, uint8_t count, HapticPriority priority) {
+    if (!_initialized || steps == nullptr || count == 0) {
+        return false;
+    }
+
+    // Copy and constrain the steps
+    PatternSlot slot;
+    slot.count = min(count, (uint8_t)HAPTIC_MAX_STEPS);
+    slot.priority = priority;
+    for (uint8_t i = 0; i < slot.count; i++) {
+        slot.steps[i].intensity = constrain(steps[i].intensity, 0, 100);
+        slot.steps[i].durationMs = constrain(steps[i].durationMs, MIN_DURATION, MAX_DURATION);
+    }
+
+    // No timer - fall back to playing inline
+    if (_stepTimer == nullptr) {
+        for (uint8_t i = 0; i < slot.count; i++) {
+            using_pwmmanager().writePercent(_pwmChannel, slot.steps[i].intensity);
+            delay(slot.steps[i].durationMs);
+        }
+        using_pwmmanager().writeDuty(_pwmChannel, 0);
+        using_eventbus().post(EVENT_HAPTIC_PLAY, priority);
+        return true;
+    }
+
+    bool startNow = false;
+    bool accepted = true;
+
+    portENTER_CRITICAL(&_seqLock);
+    if (!_playing || priority > _current.priority) {
+        // Idle, or preempt a lower priority pattern
+        _current = slot;
+        _currentStep = 0;
+        _playing = true;
+        startNow = true;
+    } else if (priority == HAPTIC_PRIORITY_LOW || _queueCount >= HAPTIC_QUEUE_SIZE) {
+        accepted = false;
+    } else {
+        _queue[(_queueHead + _queueCount) % HAPTIC_QUEUE_SIZE] = slot;
+        _queueCount++;
+    }
+    portEXIT_CRITICAL(&_seqLock);
+
+    if (startNow) {
+        // Fire the first step from the timer task straight away
+        esp_timer_stop(_stepTimer);
+        esp_timer_start_once(_stepTimer, 1);
+    }
+
+    if (accepted) {
+        using_eventbus().post(EVENT_HAPTIC_PLAY, priority);
+    }
+
+    return accepted;
+}
+
+// Stop the playing pattern and clear the queue
+void EARS_haptic::stop() {
+    portENTER_CRITICAL(&_seqLock);
+    _playing = false;
+    _queueCount = 0;
+    portEXIT_CRITICAL(&_seqLock);
+
+    if (_stepTimer != nullptr) {
+        esp_timer_stop(_stepTimer);
+    }
+
+    using_pwmmanager().writeDuty(_pwmChannel, 0);
+}
+
+// Check if a pattern is playing
+bool EARS_haptic::isPlaying() const {
+    return _playing;
+}
+
+// Start the next step or pattern
+void EARS_haptic::advanceStep() {
+    uint32_t dutyCycle = 0;
+    uint32_t waitUs = 0;
+
+    portENTER_CRITICAL(&_seqLock);
+    if (_playing && _currentStep >= _current.count) {
+        // Pattern finished - take the next queued one
+        if (_queueCount > 0) {
+            _current = _queue[_queueHead];
+            _queueHead = (_queueHead + 1) % HAPTIC_QUEUE_SIZE;
+            _queueCount--;
+            _currentStep = 0;
+        } else {
+            _playing = false;
+        }
+    }
+
+    if (_playing) {
+        const HapticStep& step = _current.steps[_currentStep++];
+        dutyCycle = using_pwmmanager().percentToDuty(_pwmChannel, step.intensity);
+        waitUs = (uint32_t)step.durationMs * 1000;
+    }
+    portEXIT_CRITICAL(&_seqLock);
+
+    // Motor off between patterns and once the queue is empty
+    using_pwmmanager().writeDuty(_pwmChannel, dutyCycle);
+
+    if (waitUs > 0) {
+        esp_timer_start_once(_stepTimer, waitUs);
+    }
+}
+
+// esp_timer trampoline
+void EARS_haptic::stepTimerCallback(void* arg) {
+    static_cast<EARS_haptic*>(arg)->advanceStep();
 }
 
 // Vibrate using stored settings
@@ -240,36 +378,22 @@ void EARS_haptic::pulse(uint8_t intensity, uint16_t durationMs) {
 
 // Double pulse using stored settings
 void EARS_haptic::doublePulse(uint16_t gapMs) {
-    if (!_initialized) {
-        return;
-    }
-    
-    vibrateInternal(_currentIntensity, _currentDuration);
-    delay(gapMs);
-    vibrateInternal(_currentIntensity, _currentDuration);
+    playPulses(2, gapMs);
 }
 
 // Triple pulse using stored settings
 void EARS_haptic::triplePulse(uint16_t gapMs) {
-    if (!_initialized) {
-        return;
-    }
-    
-    vibrateInternal(_currentIntensity, _currentDuration);
-    delay(gapMs);
-    vibrateInternal(_currentIntensity, _currentDuration);
-    delay(gapMs);
-    vibrateInternal(_currentIntensity, _currentDuration);
+    playPulses(3, gapMs);
 }
 
-// Button press feedback (20ms at stored intensity)
+// Button press feedback (20ms at stored intensity, never queued)
 void EARS_haptic::buttonPress() {
-    vibrateInternal(_currentIntensity, 20);
+    vibrateInternal(_currentIntensity, 20, HAPTIC_PRIORITY_LOW);
 }
 
-// Error feedback pattern (100ms at stored intensity)
+// Error feedback pattern (100ms at stored intensity, preempts others)
 void EARS_haptic::errorPattern() {
-    vibrateInternal(_currentIntensity, 100);
+    vibrateInternal(_currentIntensity, 100, HAPTIC_PRIORITY_HIGH);
 }
 
 // Success feedback pattern (double pulse at stored settings)
@@ -293,31 +417,25 @@ void EARS_haptic::completeInitialConfig() {
     Serial.println("[HapticManager] Initial config marked complete");
 }
 
-// Convert percentage to PWM duty cycle
-uint32_t EARS_haptic::percentageToDutyCycle(uint8_t percentage) const {
-    // Simple linear mapping: 0% = 0, 100% = maxDutyCycle
-    return (_maxDutyCycle * percentage) / 100;
+// Internal vibration function
+void EARS_haptic::vibrateInternal(uint8_t intensity, uint16_t durationMs, HapticPriority priority) {
+    HapticStep step = {intensity, durationMs};
+    playPattern(&step, 1, priority);
 }
 
-// Internal vibration function
-void EARS_haptic::vibrateInternal(uint8_t intensity, uint16_t durationMs) {
-    if (!_initialized) {
-        return;
+// Repeat the stored pulse with gaps between
+void EARS_haptic::playPulses(uint8_t pulses, uint16_t gapMs) {
+    HapticStep steps[HAPTIC_MAX_STEPS];
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < pulses && count + 2 <= HAPTIC_MAX_STEPS; i++) {
+        if (i > 0) {
+            steps[count++] = {0, gapMs};
+        }
+        steps[count++] = {_currentIntensity, _currentDuration};
     }
-    
-    // Constrain parameters
-    intensity = constrain(intensity, 0, 100);
-    durationMs = constrain(durationMs, MIN_DURATION, MAX_DURATION);
-    
-    // Turn on motor at specified intensity
-    uint32_t dutyCycle = percentageToDutyCycle(intensity);
-    ledcWrite(_pwmChannel, dutyCycle);
-    
-    // Wait for duration
-    delay(durationMs);
-    
-    // Turn off motor
-    ledcWrite(_pwmChannel, 0);
+
+    playPattern(steps, count, HAPTIC_PRIORITY_NORMAL);
 }
 
 /******************************************************************************
@@ -2,14 +2,16 @@
  * @file EARS_hapticLib.h
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief Manages haptic feedback motor with PWM intensity and duration control
- * @version 2.0.0
- * @date 20260210
+ * @version 2.3.0
+ * @date 20261014
  * 
  * Features:
  * - Analogue PWM intensity control (0-100%)
  * - Duration control (milliseconds)
  * - NVS storage for both intensity and duration preferences
  * - Vibration patterns using stored settings
+ * - Non-blocking pattern sequencer (esp_timer) with queuing and preemption
+ * - LEDC channel allocated through EARS_pwmManager
  * - Default 100% intensity, 50ms duration
  * - Compatible with EEZ Studio Flow dual-slider control
  *
@@ -26,6 +28,9 @@
 #include <Arduino.h>
 #include <Preferences.h>
 #include "EARS_versionDef.h"
+#include <esp_timer.h>
+#include "EARS_pwmManagerLib.h"
+#include "EARS_eventBusLib.h"
 
 /******************************************************************************
  * Library Version Information
@@ -34,11 +39,46 @@ namespace EARS_Haptic
 {
     constexpr const char* LIB_NAME = "EARS_haptic";
     constexpr const char* VERSION_MAJOR = "2";
-    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_MINOR = "3";
     constexpr const char* VERSION_PATCH = "0";
-    constexpr const char* VERSION_DATE = "2026-02-10";
+    constexpr const char* VERSION_DATE = "2026-10-14";
 }
 
+/******************************************************************************
+ * Sequencer Configuration
+ *****************************************************************************/
+
+// Longest pattern (steps, including gaps)
+#define HAPTIC_MAX_STEPS 8
+
+// Patterns waiting behind the one playing
+#define HAPTIC_QUEUE_SIZE 4
+
+/**
+ * @struct HapticStep
+ * @brief One pattern step - intensity 0 is a gap
+ */
+struct HapticStep {
+    uint8_t intensity;    // 0-100
+    uint16_t durationMs;  // 1-5000ms
+};
+
+/**
+ * @enum HapticPriority
+ * @brief Queuing and preemption class of a pattern
+ *
+ * @details
+ * - A higher priority pattern preempts the one playing (which is dropped).
+ * - Equal or lower priority patterns queue behind it, or are dropped when
+ *   the queue is full.
+ * - LOW patterns (button clicks) are never queued: a late click is noise.
+ */
+enum HapticPriority : uint8_t {
+    HAPTIC_PRIORITY_LOW = 0,     // UI clicks
+    HAPTIC_PRIORITY_NORMAL = 1,  // General feedback
+    HAPTIC_PRIORITY_HIGH = 2     // Errors and alerts
+};
+
 
 class EARS_haptic {
 public:
@@ -56,7 +96,7 @@ public:
     /**
      * @brief Initialise the haptic manager
      * @param pin GPIO pin for haptic motor control
-     * @param pwmChannel PWM channel to use (0-15)
+     * @param pwmChannel Preferred PWM channel (another is allocated if busy)
      * @param pwmFrequency PWM frequency in Hz (default 1000Hz for motors)
      * @param pwmResolution PWM resolution in bits (default 8)
      * @return true if initialisation successful
@@ -125,10 +165,31 @@ public:
     bool loadSettings();
 
     /**
-     * @brief Turn haptic motor off
+     * @brief Turn haptic motor off (also stops the sequencer)
      */
     void off();
 
+    /**
+     * @brief Play a pattern without blocking the caller
+     * @param steps Step array (copied, may be temporary)
+     * @param count Number of steps (at most HAPTIC_MAX_STEPS)
+     * @param priority Queuing and preemption class
+     * @return true if the pattern started or was queued
+     */
+    bool playPattern(const HapticStep* steps, uint8_t count,
+                     HapticPriority priority = HAPTIC_PRIORITY_NORMAL);
+
+    /**
+     * @brief Stop the playing pattern and clear the queue
+     */
+    void stop();
+
+    /**
+     * @brief Check if a pattern is playing
+     * @return true while the sequencer is running
+     */
+    bool isPlaying() const;
+
     /**
      * @brief Vibrate using stored intensity and duration
      */
@@ -199,9 +260,7 @@ public:
 
 private:
     uint8_t _pin;
-    uint8_t _pwmChannel;
-    uint8_t _pwmResolution;
-    uint32_t _maxDutyCycle;
+    int8_t _pwmChannel;
     
     uint8_t _currentIntensity;
     uint16_t _currentDuration;
@@ -209,6 +268,22 @@ private:
 
     Preferences _preferences;
 
+    // Sequencer state (shared with the esp_timer task)
+    struct PatternSlot {
+        HapticStep steps[HAPTIC_MAX_STEPS];
+        uint8_t count;
+        HapticPriority priority;
+    };
+
+    esp_timer_handle_t _stepTimer;
+    portMUX_TYPE _seqLock;
+    PatternSlot _current;
+    PatternSlot _queue[HAPTIC_QUEUE_SIZE];
+    uint8_t _queueHead;
+    uint8_t _queueCount;
+    uint8_t _currentStep;
+    volatile bool _playing;
+
     // NVS keys
     static constexpr const char* NVS_NAMESPACE = "haptic";
     static constexpr const char* NVS_INTENSITY_KEY = "intensity";
@@ -226,18 +301,27 @@ private:
     static constexpr uint16_t MAX_DURATION = 5000;
 
     /**
-     * @brief Convert percentage (0-100) to PWM duty cycle
-     * @param percentage Intensity percentage
-     * @return uint32_t PWM duty cycle value
+     * @brief Internal vibration function (single-step pattern)
+     * @param intensity Intensity (0-100)
+     * @param durationMs Duration in milliseconds
+     * @param priority Queuing and preemption class
      */
-    uint32_t percentageToDutyCycle(uint8_t percentage) const;
+    void vibrateInternal(uint8_t intensity, uint16_t durationMs,
+                         HapticPriority priority = HAPTIC_PRIORITY_NORMAL);
 
     /**
-     * @brief Internal vibration function
-     * @param intensity Intensity (0-100)
-     * @param durationMs Duration in milliseconds
+     * @brief Repeat the stored pulse with gaps between
+     * @param pulses Number of pulses
+     * @param gapMs Gap between pulses in milliseconds
      */
-    void vibrateInternal(uint8_t intensity, uint16_t durationMs);
+    void playPulses(uint8_t pulses, uint16_t gapMs);
+
+    /**
+     * @brief Start the next step or pattern (esp_timer callback body)
+     */
+    void advanceStep();
+
+    static void stepTimerCallback(void* arg);
 };
 
 // Global instance access function
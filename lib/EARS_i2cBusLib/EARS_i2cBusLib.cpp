@@ -0,0 +1,364 @@
+/**
+ * @file EARS_i2cBusLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Shared I2C bus: one owner task, queued transactions per device
+ * @version 1.0.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#include "EARS_i2cBusLib.h"
+#include <esp_timer.h>
+
+// Constructor
+EARS_i2cBus::EARS_i2cBus()
+    : _deviceCount(0), _task(nullptr), _sda(-1), _scl(-1), _clockHz(0)
+{
+    memset(_devices, 0, sizeof(_devices));
+    _queues[I2C_PRIORITY_NORMAL] = nullptr;
+    _queues[I2C_PRIORITY_HIGH] = nullptr;
+    _lock = portMUX_INITIALIZER_UNLOCKED;
+}
+
+// Install the driver and start the bus task
+bool EARS_i2cBus::begin(int sda, int scl)
+{
+    if (_task != nullptr)
+    {
+        return true;
+    }
+
+    _sda = sda;
+    _scl = scl;
+    if (!setClock(I2C_BUS_DEFAULT_CLOCK_HZ))
+    {
+        return false;
+    }
+
+    esp_err_t err = i2c_driver_install(I2C_BUS_PORT, I2C_MODE_MASTER, 0, 0, 0);
+    if (err != ESP_OK)
+    {
+        Serial.printf("[I2C] ERROR: Driver install failed: %s\n", esp_err_to_name(err));
+        return false;
+    }
+
+    for (uint8_t p = 0; p < 2; p++)
+    {
+        _queues[p] = xQueueCreate(I2C_BUS_QUEUE_SIZE, sizeof(EARS_i2cTransaction));
+        if (_queues[p] == nullptr)
+        {
+            Serial.println("[I2C] ERROR: No memory for the transaction queues");
+            i2c_driver_delete(I2C_BUS_PORT);
+            return false;
+        }
+    }
+
+    if (xTaskCreatePinnedToCore(taskFunction, "I2CBus", I2C_BUS_TASK_STACK_SIZE, this, I2C_BUS_TASK_PRIORITY, &_task,
+                                I2C_BUS_TASK_CORE) != pdPASS)
+    {
+        Serial.println("[I2C] ERROR: Failed to create bus task");
+        _task = nullptr;
+        i2c_driver_delete(I2C_BUS_PORT);
+        return false;
+    }
+
+    Serial.printf("[I2C] Bus on SDA=%d, SCL=%d, task on core %d\n", sda, scl, I2C_BUS_TASK_CORE);
+    return true;
+}
+
+// Register a device with its clock, timeout and priority
+EARS_i2cDeviceId EARS_i2cBus::addDevice(uint8_t address, uint32_t clockHz, uint16_t timeoutMs, EARS_i2cPriority priority)
+{
+    EARS_i2cDeviceId id = I2C_DEVICE_NONE;
+
+    portENTER_CRITICAL(&_lock);
+    for (uint8_t i = 0; i < _deviceCount; i++)
+    {
+        if (_devices[i].address == address)
+        {
+            id = i;
+            break;
+        }
+    }
+    if (id == I2C_DEVICE_NONE && _deviceCount < I2C_BUS_MAX_DEVICES)
+    {
+        id = _deviceCount++;
+    }
+    if (id != I2C_DEVICE_NONE)
+    {
+        Device &device = _devices[id];
+        device.address = address;
+        device.clockHz = clockHz;
+        device.timeoutMs = timeoutMs ? timeoutMs : 1;
+        device.priority = priority;
+    }
+    portEXIT_CRITICAL(&_lock);
+
+    if (id == I2C_DEVICE_NONE)
+    {
+        Serial.printf("[I2C] ERROR: No room for device 0x%02X\n", address);
+    }
+    return id;
+}
+
+// Queue a transaction
+bool EARS_i2cBus::submit(const EARS_i2cTransaction &transaction)
+{
+    if (_task == nullptr || transaction.device >= _deviceCount || transaction.writeLength > I2C_BUS_MAX_WRITE)
+    {
+        return false;
+    }
+
+    Device &device = _devices[transaction.device];
+    if (xQueueSend(_queues[device.priority], &transaction, 0) != pdTRUE)
+    {
+        device.dropped++;
+        return false;
+    }
+    xTaskNotifyGive(_task);
+    return true;
+}
+
+// Write then read and wait for the result
+esp_err_t EARS_i2cBus::transfer(EARS_i2cDeviceId device, const uint8_t *write, uint8_t writeLength,
+                                uint8_t *read, uint16_t readLength)
+{
+    if (writeLength > I2C_BUS_MAX_WRITE || (write == nullptr && writeLength > 0))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    EARS_i2cTransaction transaction = {};
+    transaction.device = device;
+    transaction.writeLength = writeLength;
+    if (writeLength > 0)
+    {
+        memcpy(transaction.write, write, writeLength);
+    }
+    transaction.read = read;
+    transaction.readLength = read ? readLength : 0;
+
+    esp_err_t result = ESP_ERR_INVALID_STATE;
+
+    // A callback on the bus task would wait for itself: run it in place
+    if (_task != nullptr && xTaskGetCurrentTaskHandle() == _task && device < _deviceCount)
+    {
+        transaction.result = &result;
+        run(transaction);
+        return result;
+    }
+
+    // Semaphore on the caller's stack: no heap, and no task notification
+    // taken from callers that use theirs (the UI task)
+    StaticSemaphore_t doneBuffer;
+    transaction.done = xSemaphoreCreateBinaryStatic(&doneBuffer);
+    transaction.result = &result;
+
+    if (submit(transaction))
+    {
+        // Always given: every transaction ends within its device timeout
+        xSemaphoreTake(transaction.done, portMAX_DELAY);
+    }
+    vSemaphoreDelete(transaction.done);
+    return result;
+}
+
+esp_err_t EARS_i2cBus::readRegisters(EARS_i2cDeviceId device, uint8_t reg, uint8_t *buffer, uint16_t length)
+{
+    return transfer(device, &reg, 1, buffer, length);
+}
+
+esp_err_t EARS_i2cBus::writeRegister(EARS_i2cDeviceId device, uint8_t reg, uint8_t value)
+{
+    uint8_t data[2] = {reg, value};
+    return transfer(device, data, sizeof(data), nullptr, 0);
+}
+
+bool EARS_i2cBus::readRegistersAsync(EARS_i2cDeviceId device, uint8_t reg, uint8_t *buffer, uint16_t length,
+                                     EARS_i2cCallback callback, void *ctx)
+{
+    EARS_i2cTransaction transaction = {};
+    transaction.device = device;
+    transaction.writeLength = 1;
+    transaction.write[0] = reg;
+    transaction.read = buffer;
+    transaction.readLength = buffer ? length : 0;
+    transaction.callback = callback;
+    transaction.ctx = ctx;
+    return submit(transaction);
+}
+
+bool EARS_i2cBus::getDeviceStats(EARS_i2cDeviceId device, EARS_i2cDeviceStats *stats) const
+{
+    if (stats == nullptr || device >= _deviceCount)
+    {
+        return false;
+    }
+
+    const Device &d = _devices[device];
+    stats->address = d.address;
+    stats->clockHz = d.clockHz;
+    stats->transactions = d.transactions;
+    stats->errors = d.errors;
+    stats->timeouts = d.timeouts;
+    stats->dropped = d.dropped;
+    stats->maxUs = d.maxUs;
+    return true;
+}
+
+// Configure the port for a clock (bus task, or begin() before the task)
+bool EARS_i2cBus::setClock(uint32_t clockHz)
+{
+    if (clockHz == _clockHz)
+    {
+        return true;
+    }
+
+    i2c_config_t config = {};
+    config.mode = I2C_MODE_MASTER;
+    config.sda_io_num = _sda;
+    config.scl_io_num = _scl;
+    config.sda_pullup_en = GPIO_PULLUP_ENABLE;
+    config.scl_pullup_en = GPIO_PULLUP_ENABLE;
+    config.master.clk_speed = clockHz;
+
+    esp_err_t err = i2c_param_config(I2C_BUS_PORT, &config);
+    if (err != ESP_OK)
+    {
+        Serial.printf("[I2C] ERROR: %lu Hz clock: %s\n", (unsigned long)clockHz, esp_err_to_name(err));
+        return false;
+    }
+    _clockHz = clockHz;
+    return true;
+}
+
+// Run one transaction on the wire and complete it
+void EARS_i2cBus::run(const EARS_i2cTransaction &transaction)
+{
+    Device &device = _devices[transaction.device];
+    TickType_t ticks = pdMS_TO_TICKS(device.timeoutMs);
+    if (ticks == 0)
+    {
+        ticks = 1;
+    }
+
+    esp_err_t err = ESP_FAIL;
+    uint32_t start = (uint32_t)esp_timer_get_time();
+    if (setClock(device.clockHz))
+    {
+        if (transaction.readLength == 0)
+        {
+            err = i2c_master_write_to_device(I2C_BUS_PORT, device.address, transaction.write,
+                                             transaction.writeLength, ticks);
+        }
+        else if (transaction.writeLength == 0)
+        {
+            err = i2c_master_read_from_device(I2C_BUS_PORT, device.address, transaction.read,
+                                              transaction.readLength, ticks);
+        }
+        else
+        {
+            err = i2c_master_write_read_device(I2C_BUS_PORT, device.address, transaction.write,
+                                               transaction.writeLength, transaction.read,
+                                               transaction.readLength, ticks);
+        }
+    }
+    uint32_t elapsed = (uint32_t)esp_timer_get_time() - start;
+
+    device.transactions++;
+    if (elapsed > device.maxUs)
+    {
+        device.maxUs = elapsed;
+    }
+    if (err != ESP_OK)
+    {
+        device.errors++;
+        if (err == ESP_ERR_TIMEOUT)
+        {
+            device.timeouts++;
+        }
+    }
+
+    if (transaction.result != nullptr)
+    {
+        *transaction.result = err;
+    }
+    if (transaction.callback != nullptr)
+    {
+        transaction.callback(err, transaction.ctx);
+    }
+    if (transaction.done != nullptr)
+    {
+        xSemaphoreGive(transaction.done);
+    }
+}
+
+// Bus task: high priority transactions first, one normal one at a time
+void EARS_i2cBus::taskFunction(void *param)
+{
+    EARS_i2cBus *self = (EARS_i2cBus *)param;
+    EARS_i2cTransaction transaction;
+
+    while (true)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (true)
+        {
+            if (xQueueReceive(self->_queues[I2C_PRIORITY_HIGH], &transaction, 0) == pdTRUE ||
+                xQueueReceive(self->_queues[I2C_PRIORITY_NORMAL], &transaction, 0) == pdTRUE)
+            {
+                self->run(transaction);
+                continue;
+            }
+            break;
+        }
+    }
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char *EARS_i2cBus::getLibraryName()
+{
+    return EARS_I2cBus::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t EARS_i2cBus::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_I2cBus::VERSION_MAJOR,
+                       EARS_I2cBus::VERSION_MINOR,
+                       EARS_I2cBus::VERSION_PATCH);
+}
+
+// Get version date
+const char *EARS_i2cBus::getVersionDate()
+{
+    return EARS_I2cBus::VERSION_DATE;
+}
+
+// Format version as string
+void EARS_i2cBus::getVersionString(char *buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/**
+ * @brief Get reference to global I2C bus instance (Singleton pattern)
+ *
+ * @return EARS_i2cBus& Reference to the global bus instance
+ */
+EARS_i2cBus &using_i2cBus()
+{
+    static EARS_i2cBus instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_i2cBusLib.cpp
+ *****************************************************************************/
@@ -0,0 +1,253 @@
+/**
+ * @file EARS_i2cBusLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Shared I2C bus: one owner task, queued transactions per device
+ * @version 1.0.1
+ * @date 20261015
+ *
+ * Features:
+ * - One task owns the I2C port; every device goes through it
+ * - Devices are registered with their own clock, timeout and priority
+ * - Transactions are queued: write, read, or write then repeated-start read
+ * - Asynchronous completion through a callback on the bus task, or a
+ *   synchronous call that blocks only its caller
+ * - Two queues: high priority transactions (touch) are always taken before
+ *   the next normal one, so a slow sensor or RTC never queues ahead of a
+ *   touch read
+ * - Per-device counters: transactions, errors, timeouts, longest time
+ *
+ * @details
+ * Uses the ESP-IDF 4.4 legacy I2C master driver (driver/i2c.h); the
+ * i2c_master bus/device driver needs IDF 5.2. A transfer already on the
+ * wire is not interrupted, so a touch read waits at most for the one
+ * transaction in progress, which its device's timeout bounds. The clock is
+ * switched between transactions when devices differ.
+ *
+ * Callbacks run on the bus task: keep them short and never make a
+ * synchronous call from one. Write data (up to I2C_BUS_MAX_WRITE bytes) is
+ * copied into the transaction; read buffers belong to the caller and must
+ * stay valid until completion.
+ *
+ * The TCA9554 GPIO expander (touch reset, EARS_ws35tlcdPins.h) sits on the
+ * same bus; a driver for it, sensors or an RTC registers its own device.
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_I2C_BUS_LIB_H__
+#define __EARS_I2C_BUS_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <driver/i2c.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include "EARS_versionDef.h"
+#include "EARS_taskPlanLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_I2cBus
+{
+    constexpr const char *LIB_NAME = "EARS_i2cBus";
+    constexpr const char *VERSION_MAJOR = "1";
+    constexpr const char *VERSION_MINOR = "0";
+    constexpr const char *VERSION_PATCH = "1";
+    constexpr const char *VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * I2C Bus Configuration
+ *****************************************************************************/
+
+#define I2C_BUS_PORT I2C_NUM_0
+#define I2C_BUS_MAX_DEVICES 8
+#define I2C_BUS_MAX_WRITE 8          // Register address + data copied per transaction
+#define I2C_BUS_QUEUE_SIZE 16        // Transactions waiting, per priority
+#define I2C_BUS_DEFAULT_CLOCK_HZ 400000
+#define I2C_BUS_DEFAULT_TIMEOUT_MS 20
+
+// Bus task: above the touch sampling task, which waits on it
+#define I2C_BUS_TASK_CORE using_taskplan().core(TASK_ROLE_I2C)
+#define I2C_BUS_TASK_PRIORITY using_taskplan().priority(TASK_ROLE_I2C)
+#define I2C_BUS_TASK_STACK_SIZE 3072
+
+// Returned by addDevice() when no device could be registered
+#define I2C_DEVICE_NONE 0xFF
+
+/******************************************************************************
+ * I2C Bus Types
+ *****************************************************************************/
+
+enum EARS_i2cPriority : uint8_t
+{
+    I2C_PRIORITY_NORMAL = 0, // Sensors, RTC, expander
+    I2C_PRIORITY_HIGH        // Input: taken before any waiting normal transaction
+};
+
+typedef uint8_t EARS_i2cDeviceId;
+
+/**
+ * @brief Completion callback, run on the bus task
+ * @param result ESP_OK, ESP_ERR_TIMEOUT, ESP_FAIL (NACK)...
+ * @param ctx Caller context from the transaction
+ */
+typedef void (*EARS_i2cCallback)(esp_err_t result, void *ctx);
+
+/**
+ * @struct EARS_i2cTransaction
+ * @brief One queued transfer: write, read, or write then read
+ */
+struct EARS_i2cTransaction
+{
+    EARS_i2cDeviceId device;
+    uint8_t writeLength;                // 0 = read only
+    uint8_t write[I2C_BUS_MAX_WRITE];   // Copied when queued
+    uint8_t *read;                      // Caller buffer, NULL = write only
+    uint16_t readLength;
+    EARS_i2cCallback callback;          // NULL = none
+    void *ctx;
+    SemaphoreHandle_t done;             // Synchronous callers only
+    esp_err_t *result;                  // Synchronous callers only
+};
+
+/**
+ * @struct EARS_i2cDeviceStats
+ * @brief Counters of one device
+ */
+struct EARS_i2cDeviceStats
+{
+    uint8_t address;
+    uint32_t clockHz;
+    uint32_t transactions; // Completed, successful or not
+    uint32_t errors;       // NACK, bus error or timeout
+    uint32_t timeouts;     // ESP_ERR_TIMEOUT
+    uint32_t dropped;      // Refused because the queue was full
+    uint32_t maxUs;        // Longest transaction on the wire
+};
+
+/******************************************************************************
+ * EARS_i2cBus Class
+ *****************************************************************************/
+class EARS_i2cBus
+{
+public:
+    EARS_i2cBus();
+
+    // Version information getters
+    static const char *getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char *getVersionDate();
+    static void getVersionString(char *buffer);
+
+    /**
+     * @brief Install the I2C driver and start the bus task
+     * @details Later calls return the first result; the pins of the first
+     *          call are kept.
+     * @param sda SDA pin
+     * @param scl SCL pin
+     * @return true if the bus is running
+     */
+    bool begin(int sda, int scl);
+
+    bool isRunning() const { return _task != nullptr; }
+
+    /**
+     * @brief Register a device
+     * @param address 7-bit address
+     * @param clockHz SCL frequency for its transactions
+     * @param timeoutMs Longest a transaction of it may hold the bus
+     * @param priority I2C_PRIORITY_HIGH for latency-critical input
+     * @return EARS_i2cDeviceId Handle, I2C_DEVICE_NONE if the table is full
+     */
+    EARS_i2cDeviceId addDevice(uint8_t address, uint32_t clockHz = I2C_BUS_DEFAULT_CLOCK_HZ,
+                               uint16_t timeoutMs = I2C_BUS_DEFAULT_TIMEOUT_MS,
+                               EARS_i2cPriority priority = I2C_PRIORITY_NORMAL);
+
+    /**
+     * @brief Queue a transaction and return at once
+     * @param transaction Copied into the queue (its read buffer is not)
+     * @return true if queued, false if the bus is not running, the device
+     *         is unknown or the queue is full
+     */
+    bool submit(const EARS_i2cTransaction &transaction);
+
+    /**
+     * @brief Write then read, waiting for the result (never from a callback)
+     * @param device Device handle
+     * @param write Bytes to write first (register address), may be NULL
+     * @param writeLength At most I2C_BUS_MAX_WRITE
+     * @param read Destination, may be NULL
+     * @param readLength Bytes to read
+     * @return esp_err_t Driver result, ESP_ERR_INVALID_STATE if not queued
+     */
+    esp_err_t transfer(EARS_i2cDeviceId device, const uint8_t *write, uint8_t writeLength,
+                       uint8_t *read, uint16_t readLength);
+
+    // Register access for the common one-byte register address layout
+    esp_err_t readRegisters(EARS_i2cDeviceId device, uint8_t reg, uint8_t *buffer, uint16_t length);
+    esp_err_t writeRegister(EARS_i2cDeviceId device, uint8_t reg, uint8_t value);
+
+    /**
+     * @brief Queue a register read with a completion callback
+     * @param device Device handle
+     * @param reg First register
+     * @param buffer Destination, valid until the callback
+     * @param length Bytes to read
+     * @param callback Run on the bus task with the result
+     * @param ctx Passed to callback
+     * @return true if queued
+     */
+    bool readRegistersAsync(EARS_i2cDeviceId device, uint8_t reg, uint8_t *buffer, uint16_t length,
+                            EARS_i2cCallback callback, void *ctx);
+
+    /**
+     * @brief Counters of one device
+     * @param device Device handle
+     * @param stats Receives the counters
+     * @return true if the device exists
+     */
+    bool getDeviceStats(EARS_i2cDeviceId device, EARS_i2cDeviceStats *stats) const;
+
+private:
+    struct Device
+    {
+        uint8_t address;
+        EARS_i2cPriority priority;
+        uint16_t timeoutMs;
+        uint32_t clockHz;
+        uint32_t transactions;
+        uint32_t errors;
+        uint32_t timeouts;
+        uint32_t dropped;
+        uint32_t maxUs;
+    };
+
+    Device _devices[I2C_BUS_MAX_DEVICES];
+    uint8_t _deviceCount;
+    QueueHandle_t _queues[2]; // Indexed by EARS_i2cPriority
+    TaskHandle_t _task;
+    int _sda;
+    int _scl;
+    uint32_t _clockHz;        // Clock the port is set to (bus task only)
+    portMUX_TYPE _lock;       // Device table
+
+    bool setClock(uint32_t clockHz);
+    void run(const EARS_i2cTransaction &transaction);
+    static void taskFunction(void *param);
+};
+
+// Global instance access function
+EARS_i2cBus &using_i2cBus();
+
+#endif // __EARS_I2C_BUS_LIB_H__
+
+/******************************************************************************
+ * End of EARS_i2cBusLib.h
+ *****************************************************************************/
@@ -2,14 +2,251 @@
  * @file EARS_loggerLib.cpp
  * @author JTB & Claude Sonnet 4.2
  * @brief Enhanced logging system with hierarchical levels and unified config
- * @version 3.0.0
- * @date 20260210
+ * @version 3.9.0
+ * @date 20261015
  * 
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
 #include "EARS_loggerLib.h"
+#include "EARS_profileLib.h"
+#include "EARS_rtosTraceLib.h"
 #include <time.h>
 #include <sys/time.h>
+#include <ctype.h>
+#include <esp_heap_caps.h>
+
+/**
+ * @brief Encode printf arguments in format-string order
+ * @param out Destination payload buffer
+ * @param outSize Destination size
+ * @param format printf-style format string
+ * @param args Arguments matching format
+ * @return size_t Payload bytes written (stops early when out is full)
+ */
+static size_t encodeBinaryArgs(char* out, size_t outSize, const char* format, va_list args) {
+    size_t used = 0;
+    
+    for (const char* p = format; *p; p++) {
+        if (*p != '%') {
+            continue;
+        }
+        p++;
+        if (*p == '%') {
+            continue;
+        }
+        
+        // Flags
+        while (*p && strchr("-+ #0", *p)) {
+            p++;
+        }
+        
+        // Width and precision, '*' consumes an int argument
+        for (int part = 0; part < 2; part++) {
+            if (*p == '*') {
+                int32_t value = va_arg(args, int);
+                if (used + sizeof(value) > outSize) {
+                    return used;
+                }
+                memcpy(out + used, &value, sizeof(value));
+                used += sizeof(value);
+                p++;
+            } else {
+                while (isdigit((unsigned char)*p)) {
+                    p++;
+                }
+            }
+            if (part == 0 && *p == '.') {
+                p++;
+            } else {
+                break;
+            }
+        }
+        
+        // Length modifiers (long is 32-bit on this target)
+        int longs = 0;
+        while (*p == 'h' || *p == 'l' || *p == 'L' || *p == 'z' || *p == 'j' || *p == 't') {
+            if (*p == 'l') longs++;
+            if (*p == 'j') longs = 2;
+            p++;
+        }
+        
+        switch (*p) {
+            case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+                if (longs >= 2) {
+                    int64_t value = va_arg(args, long long);
+                    if (used + sizeof(value) > outSize) {
+                        return used;
+                    }
+                    memcpy(out + used, &value, sizeof(value));
+                    used += sizeof(value);
+                } else {
+                    int32_t value = va_arg(args, int);
+                    if (used + sizeof(value) > outSize) {
+                        return used;
+                    }
+                    memcpy(out + used, &value, sizeof(value));
+                    used += sizeof(value);
+                }
+                break;
+                
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+                double value = va_arg(args, double);
+                if (used + sizeof(value) > outSize) {
+                    return used;
+                }
+                memcpy(out + used, &value, sizeof(value));
+                used += sizeof(value);
+                break;
+            }
+                
+            case 's': {
+                const char* str = va_arg(args, const char*);
+                if (!str) {
+                    str = "(null)";
+                }
+                size_t len = strnlen(str, LOGGER_BINARY_STRING_MAX);
+                if (used + 1 + len > outSize) {
+                    return used;
+                }
+                out[used++] = (char)len;
+                memcpy(out + used, str, len);
+                used += len;
+                break;
+            }
+                
+            case 'p': {
+                uint32_t value = (uint32_t)(uintptr_t)va_arg(args, void*);
+                if (used + sizeof(value) > outSize) {
+                    return used;
+                }
+                memcpy(out + used, &value, sizeof(value));
+                used += sizeof(value);
+                break;
+            }
+                
+            case 'n':
+                (void)va_arg(args, void*);
+                break;
+                
+            case '\0':
+                return used;
+                
+            default:
+                break;
+        }
+    }
+    
+    return used;
+}
+
+/**
+ * @brief Rotated log compressor: heatshrink-format LZSS
+ * @details A literal is a 1 bit and the byte, a match a 0 bit, the distance
+ *          - 1 in LOGGER_HS_WINDOW_BITS and the length - 1 in
+ *          LOGGER_HS_LOOKAHEAD_BITS, packed MSB first. Matches are found
+ *          through a hash of the next LOGGER_HS_MIN_MATCH bytes chained over
+ *          the window. About 41 KB, allocated only while a file is worked on.
+ */
+struct LogCompressor {
+    uint8_t window[2 << LOGGER_HS_WINDOW_BITS];       // History, then lookahead
+    uint32_t head[1 << LOGGER_HS_HASH_BITS];          // Newest position + 1 per hash
+    uint32_t chain[1 << LOGGER_HS_WINDOW_BITS];       // Previous position + 1, same hash
+    uint8_t out[LOGGER_COMPRESS_OUT_BYTES];
+    uint32_t base;       // Stream position of window[0]
+    uint32_t end;        // Stream position past the bytes read
+    uint32_t pos;        // Next stream position to encode
+    uint32_t srcSize;
+    size_t outUsed;
+    uint8_t bits;        // Pending output bits, MSB first
+    uint8_t bitCount;
+    uint8_t index;       // Rotated file being compressed
+    bool failed;
+};
+
+static inline uint32_t hsHash(const uint8_t* p) {
+    uint32_t v = ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+    return (v * 2654435761u) >> (32 - LOGGER_HS_HASH_BITS);
+}
+
+static void hsPutBits(LogCompressor* c, uint32_t value, uint8_t count) {
+    while (count--) {
+        c->bits = (uint8_t)((c->bits << 1) | ((value >> count) & 1));
+        if (++c->bitCount == 8) {
+            c->out[c->outUsed++] = c->bits;
+            c->bits = 0;
+            c->bitCount = 0;
+        }
+    }
+}
+
+/**
+ * @brief Encode what has been read, stopping with the output buffer full
+ * @param c Compressor
+ * @param final true once the whole file is read (encode to the end)
+ */
+static void hsEncode(LogCompressor* c, bool final) {
+    const uint32_t windowSize = 1 << LOGGER_HS_WINDOW_BITS;
+    const uint32_t maxMatch = 1 << LOGGER_HS_LOOKAHEAD_BITS;
+    
+    // A symbol is at most 18 bits, 3 bytes with the pending ones
+    while (c->pos < c->end && (final || c->end - c->pos >= maxMatch) &&
+           c->outUsed + 3 <= LOGGER_COMPRESS_OUT_BYTES) {
+        const uint8_t* p = c->window + (c->pos - c->base);
+        uint32_t avail = c->end - c->pos;
+        if (avail > maxMatch) {
+            avail = maxMatch;
+        }
+        
+        uint32_t bestLen = 0;
+        uint32_t bestDist = 0;
+        if (avail >= LOGGER_HS_MIN_MATCH) {
+            uint32_t candidate = c->head[hsHash(p)];
+            for (uint32_t depth = 0; candidate != 0 && depth < LOGGER_HS_CHAIN_MAX; depth++) {
+                uint32_t at = candidate - 1;
+                if (c->pos - at > windowSize) {
+                    break;
+                }
+                const uint8_t* q = c->window + (at - c->base);
+                uint32_t len = 0;
+                while (len < avail && q[len] == p[len]) {
+                    len++;
+                }
+                if (len > bestLen) {
+                    bestLen = len;
+                    bestDist = c->pos - at;
+                    if (len == avail) {
+                        break;
+                    }
+                }
+                // Older positions only; a slot reused by a newer one ends the chain
+                uint32_t next = c->chain[at & (windowSize - 1)];
+                if (next >= candidate) {
+                    break;
+                }
+                candidate = next;
+            }
+        }
+        
+        uint32_t step = 1;
+        if (bestLen >= LOGGER_HS_MIN_MATCH) {
+            hsPutBits(c, 0, 1);
+            hsPutBits(c, bestDist - 1, LOGGER_HS_WINDOW_BITS);
+            hsPutBits(c, bestLen - 1, LOGGER_HS_LOOKAHEAD_BITS);
+            step = bestLen;
+        } else {
+            hsPutBits(c, 1, 1);
+            hsPutBits(c, *p, 8);
+        }
+        
+        for (uint32_t i = 0; i < step; i++, c->pos++) {
+            if (c->end - c->pos >= LOGGER_HS_MIN_MATCH) {
+                uint32_t h = hsHash(c->window + (c->pos - c->base));
+                c->chain[c->pos & (windowSize - 1)] = c->head[h];
+                c->head[h] = c->pos + 1;
+            }
+        }
+    }
+}
 
 /**
  * @brief Get singleton instance.
@@ -27,13 +264,44 @@ EARS_logger::EARS_logger() :
     _initialized(false),
     _logFilePath(""),
     _configFilePath(""),
-    _sdCard(nullptr) {
+    _sdCard(nullptr),
+    _bufferUsed(0),
+    _lastFlushMs(0),
+    _fileSize(0),
+    _allocatedSize(0),
+    _rotationPending(false),
+    _mutex(nullptr),
+    _ring(nullptr),
+    _writerTask(nullptr),
+    _droppedRecords(0),
+    _reportedDrops(0),
+    _knownFormatCount(0),
+    _compressor(nullptr),
+    _compressPending(false),
+    _compressedFiles(0) {
 }
 
 /**
  * @brief Destructor.
  */
 EARS_logger::~EARS_logger() {
+    setAsync(false);
+    flush();
+    if (_mutex) {
+        vSemaphoreDelete(_mutex);
+    }
+}
+
+/**
+ * @brief Event bus subscriber, one DEBUG line per system event.
+ * @param event Dispatched event
+ * @param userData Logger instance
+ */
+static void logEvent(const EARS_event& event, void* userData) {
+    EARS_logger* logger = static_cast<EARS_logger*>(userData);
+    if (logger->wouldLog(LogLevel::DEBUG)) {
+        logger->debugf("[EVENT] %s value=%lu", EARS_eventBus::typeName(event.type), (unsigned long)event.value);
+    }
 }
 
 /**
@@ -54,6 +322,13 @@ bool EARS_logger::begin(const char* logFilePath, const char* configFilePath, EAR
         return false;
     }
     
+    if (!_mutex) {
+        _mutex = xSemaphoreCreateMutex();
+        if (!_mutex) {
+            return false;
+        }
+    }
+    
     _sdCard = sdCard;
     _logFilePath = String(logFilePath);
     _configFilePath = String(configFilePath);
@@ -76,10 +351,34 @@ bool EARS_logger::begin(const char* logFilePath, const char* configFilePath, EAR
         }
     }
     
-    // Load configuration (creates default if not exists)
+    // Load through the config service (recovers an interrupted rewrite,
+    // creates the default file if none exists)
     loadConfig();
     
+    // Size is tracked in RAM from here on; a preallocated file is zero
+    // padded past the data, so locate the real end once
+    _allocatedSize = _sdCard->getFileSize(_logFilePath.c_str());
+    _fileSize = (_allocatedSize > 0) ? findDataEnd(_allocatedSize) : 0;
+    _bufferUsed = 0;
+    _lastFlushMs = millis();
+    
     _initialized = true;
+
+    // Record system events at DEBUG level
+    using_eventbus().subscribe(EVENT_MASK_ALL, logEvent, this);
+    
+    // The tail of a padded binary file is ambiguous, start a fresh one
+    if (_config.binary && _fileSize < _allocatedSize) {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        performRotation();
+        xSemaphoreGive(_mutex);
+    }
+    
+    // Start async backend if configured (falls back to inline writes)
+    setAsync(_config.async);
+    
+    // Rotated files left plain by a reset or older firmware
+    _compressPending = _config.compressRotated;
     
     // Log initialization
     info("=== Logger v2.1 Initialized ===");
@@ -88,6 +387,10 @@ bool EARS_logger::begin(const char* logFilePath, const char* configFilePath, EAR
     infof("Log level: %s", getLogLevelString().c_str());
     infof("Max file size: %d bytes (%.2f MB)", _config.maxFileSizeBytes, _config.maxFileSizeBytes / 1048576.0);
     infof("Max rotated files: %d", _config.maxRotatedFiles);
+    infof("Buffered: %s", _config.buffered ? "yes" : "no");
+    infof("Async: %s", isAsync() ? "yes" : "no");
+    infof("Binary: %s", _config.binary ? "yes" : "no");
+    infof("Compress rotated: %s", _config.compressRotated ? "yes" : "no");
     
     return true;
 }
@@ -183,26 +486,467 @@ void EARS_logger::errorf(const char* format, ...) {
  * @return void
  */
 void EARS_logger::log(LogLevel level, const char* message) {
+    EARS_PROFILE_ZONE("log");
+    EARS_RTOS_TRACE_SCOPE(RTOS_TRACE_LOG_WRITE);
+
     if (!_initialized || !shouldLog(level)) {
         return;
     }
     
-    // Check if rotation needed
+    if (_config.binary) {
+        char record[LOGGER_LINE_MAX];
+        submitRecord(record, buildTextRecord(record, sizeof(record), level, message));
+        return;
+    }
+    
+    // Format "[timestamp] [LEVEL] message\n" on the stack, no heap use
+    char line[LOGGER_LINE_MAX];
+    size_t length = 0;
+    line[length++] = '[';
+    length += formatTimestamp(line + length, sizeof(line) - length);
+    int written = snprintf(line + length, sizeof(line) - length, "] [%s] %s\n",
+                           getLevelString(level), message);
+    if (written < 0) {
+        return;
+    }
+    length += (size_t)written;
+    if (length >= sizeof(line)) {
+        // Truncated - keep the line terminated
+        length = sizeof(line) - 1;
+        line[length - 1] = '\n';
+    }
+    
+    submitRecord(line, length);
+}
+
+/**
+ * @brief Route a finished record to the queue or the write buffer
+ * @param record Record bytes
+ * @param length Record length
+ * @return void
+ */
+void EARS_logger::submitRecord(const char* record, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    
+    // Async: hand the record to the writer, unless we are the writer
+    if (isAsync() && xTaskGetCurrentTaskHandle() != _writerTask) {
+        enqueueRecord(record, length);
+        return;
+    }
+    
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    
+    // Check if rotation needed; leave it to the writer when there is one
     if (needsRotation()) {
-        performRotation();
+        if (_writerTask && xTaskGetCurrentTaskHandle() != _writerTask) {
+            _rotationPending = true;
+        } else {
+            performRotation();
+        }
     }
     
-    // Format log entry
-    String logEntry = "[";
-    logEntry += getTimestamp();
-    logEntry += "] [";
-    logEntry += getLevelString(level);
-    logEntry += "] ";
-    logEntry += message;
-    logEntry += "\n";
+    appendLocked(record, length);
+    
+    xSemaphoreGive(_mutex);
+}
+
+/**
+ * @brief Build a binary TEXT record
+ * @param out Destination
+ * @param outSize Destination size
+ * @param level Log level
+ * @param message Message text
+ * @return size_t Record length
+ */
+size_t EARS_logger::buildTextRecord(char* out, size_t outSize, LogLevel level, const char* message) const {
+    LogRecordHeader header;
+    size_t length = strnlen(message, outSize - sizeof(header));
+    
+    header.type = (uint8_t)LogRecordType::TEXT;
+    header.level = (uint8_t)level;
+    header.length = (uint16_t)length;
+    header.timestampMs = millis();
+    header.formatId = 0;
     
-    // Write to file
-    _sdCard->appendFile(_logFilePath.c_str(), logEntry);
+    memcpy(out, &header, sizeof(header));
+    memcpy(out + sizeof(header), message, length);
+    return sizeof(header) + length;
+}
+
+/**
+ * @brief Queue a formatted line for the writer task
+ * @param line Line bytes including trailing newline
+ * @param length Line length
+ * @return void
+ */
+void EARS_logger::enqueueRecord(const char* line, size_t length) {
+    switch (_config.overflowPolicy) {
+        case LogOverflowPolicy::BLOCK:
+            xRingbufferSend(_ring, line, length, portMAX_DELAY);
+            return;
+            
+        case LogOverflowPolicy::DROP_NEWEST:
+            if (xRingbufferSend(_ring, line, length, 0) != pdTRUE) {
+                _droppedRecords++;
+            }
+            return;
+            
+        case LogOverflowPolicy::DROP_OLDEST:
+        default:
+            // Evict oldest records until the new one fits (bounded attempts)
+            for (uint8_t attempt = 0; attempt < 8; attempt++) {
+                if (xRingbufferSend(_ring, line, length, 0) == pdTRUE) {
+                    return;
+                }
+                size_t oldLength = 0;
+                void* old = xRingbufferReceive(_ring, &oldLength, 0);
+                if (old) {
+                    vRingbufferReturnItem(_ring, old);
+                }
+                _droppedRecords++;
+            }
+            return;
+    }
+}
+
+/**
+ * @brief Move queued records into the write buffer
+ * @param maxRecords Upper bound on records to move
+ * @return void
+ */
+void EARS_logger::drainQueue(uint32_t maxRecords) {
+    if (!_ring) {
+        return;
+    }
+    
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    
+    for (uint32_t i = 0; i < maxRecords; i++) {
+        size_t length = 0;
+        char* record = (char*)xRingbufferReceive(_ring, &length, 0);
+        if (!record) {
+            break;
+        }
+        
+        if (needsRotation()) {
+            performRotation();
+        }
+        appendLocked(record, length);
+        vRingbufferReturnItem(_ring, record);
+    }
+    
+    // Note overflow losses in the log itself
+    uint32_t dropped = _droppedRecords;
+    if (dropped != _reportedDrops) {
+        char note[64];
+        int n = snprintf(note, sizeof(note), "[logger] %lu records dropped (queue full)\n",
+                         (unsigned long)(dropped - _reportedDrops));
+        if (n > 0 && _config.binary) {
+            note[sizeof(note) - 1] = '\0';
+            char record[sizeof(LogRecordHeader) + sizeof(note)];
+            appendLocked(record, buildTextRecord(record, sizeof(record), LogLevel::WARN, note));
+        } else if (n > 0) {
+            appendLocked(note, (size_t)n < sizeof(note) ? (size_t)n : sizeof(note) - 1);
+        }
+        _reportedDrops = dropped;
+    }
+    
+    xSemaphoreGive(_mutex);
+}
+
+/**
+ * @brief Enable or disable the async backend
+ * @param enabled true to queue records for the writer task
+ * @return true if the requested mode is active
+ */
+bool EARS_logger::setAsync(bool enabled) {
+    _config.async = enabled;
+    
+    if (enabled) {
+        if (!_ring) {
+            _ring = xRingbufferCreate(LOGGER_ASYNC_RING_SIZE, RINGBUF_TYPE_NOSPLIT);
+        }
+        return _ring != nullptr;
+    }
+    
+    if (_ring) {
+        // Drain whatever is queued before going synchronous
+        drainQueue(UINT32_MAX);
+        vRingbufferDelete(_ring);
+        _ring = nullptr;
+    }
+    return true;
+}
+
+/**
+ * @brief Append one formatted line or record to the buffer or the file
+ * @param line Line bytes including trailing newline
+ * @param length Line length
+ * @return void
+ */
+void EARS_logger::appendLocked(const char* line, size_t length) {
+    if (_config.binary) {
+        // Every binary file starts with the magic and its own dictionary
+        if (getLogFileSize() == 0) {
+            _knownFormatCount = 0;
+            appendRaw(LOGGER_BINARY_MAGIC, LOGGER_BINARY_MAGIC_LEN);
+        }
+        
+        // Staged MESSAGE: strip the format pointer, define the format once
+        if ((uint8_t)line[0] == LOGGER_STAGE_TAG && length >= 1 + sizeof(const char*) + sizeof(LogRecordHeader)) {
+            const char* format;
+            memcpy(&format, line + 1, sizeof(format));
+            line += 1 + sizeof(format);
+            length -= 1 + sizeof(format);
+            
+            LogRecordHeader header;
+            memcpy(&header, line, sizeof(header));
+            
+            bool known = false;
+            for (uint8_t i = 0; i < _knownFormatCount; i++) {
+                if (_knownFormats[i] == header.formatId) {
+                    known = true;
+                    break;
+                }
+            }
+            
+            if (!known) {
+                if (_knownFormatCount >= LOGGER_BINARY_DICT_SIZE) {
+                    _knownFormatCount = 0;  // Forget and re-define as needed
+                }
+                _knownFormats[_knownFormatCount++] = header.formatId;
+                
+                LogRecordHeader def;
+                size_t formatLength = strnlen(format, LOGGER_LINE_MAX);
+                def.type = (uint8_t)LogRecordType::FORMAT;
+                def.level = 0;
+                def.length = (uint16_t)formatLength;
+                def.timestampMs = header.timestampMs;
+                def.formatId = header.formatId;
+                appendRaw((const char*)&def, sizeof(def));
+                appendRaw(format, formatLength);
+            }
+        }
+    }
+    
+    appendRaw(line, length);
+}
+
+/**
+ * @brief Write bytes to the buffer or the file
+ * @param line Bytes to write
+ * @param length Byte count
+ * @return void
+ */
+void EARS_logger::appendRaw(const char* line, size_t length) {
+    if (!_config.buffered) {
+        writeBlockLocked(line, length);
+        return;
+    }
+    
+    // Make room: drain everything if this line would not fit
+    if (_bufferUsed + length > LOGGER_BUFFER_SIZE) {
+        flushLocked(true);
+    }
+    
+    memcpy(_buffer + _bufferUsed, line, length);
+    _bufferUsed += length;
+    
+    // Write whole sectors once the threshold is reached
+    if (_bufferUsed >= LOGGER_FLUSH_THRESHOLD) {
+        flushLocked(false);
+    }
+}
+
+/**
+ * @brief Write buffered data to the SD card
+ * @param all true to write everything, false for whole sectors only
+ * @return true if write successful
+ * @return false if write failed
+ */
+bool EARS_logger::flushLocked(bool all) {
+    size_t toWrite = all ? _bufferUsed : (_bufferUsed / LOGGER_SECTOR_SIZE) * LOGGER_SECTOR_SIZE;
+    if (toWrite == 0) {
+        if (all) {
+            _lastFlushMs = millis();
+        }
+        return true;
+    }
+    
+    bool ok = writeBlockLocked(_buffer, toWrite);
+    
+    // Keep the partial sector (or drop the block on failure to stay bounded)
+    size_t remaining = _bufferUsed - toWrite;
+    if (remaining > 0) {
+        memmove(_buffer, _buffer + toWrite, remaining);
+    }
+    _bufferUsed = remaining;
+    _lastFlushMs = millis();
+    
+    return ok;
+}
+
+/**
+ * @brief Write a block at the logical end of the file
+ * @param data Bytes to write
+ * @param length Byte count
+ * @return true if write successful
+ * @return false if write failed
+ */
+bool EARS_logger::writeBlockLocked(const char* data, size_t length) {
+    // Grow the allocation first so the cluster chain extends in big steps
+    if (_config.preallocate && _fileSize + length > _allocatedSize) {
+        growLocked(_fileSize + length);
+    }
+    
+    bool ok;
+    if (_fileSize < _allocatedSize) {
+        // Overwrite padding in place
+        ok = _sdCard->writeDataAt(_logFilePath.c_str(), _fileSize, (const uint8_t*)data, length);
+    } else {
+        ok = _sdCard->appendData(_logFilePath.c_str(), (const uint8_t*)data, length);
+    }
+    
+    if (ok) {
+        _fileSize += length;
+        if (_fileSize > _allocatedSize) {
+            _allocatedSize = _fileSize;
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief Extend the preallocated file to cover minSize
+ * @param minSize Logical size the allocation must reach
+ * @return void
+ */
+void EARS_logger::growLocked(uint32_t minSize) {
+    uint32_t target = ((minSize + LOGGER_PREALLOC_CHUNK - 1) / LOGGER_PREALLOC_CHUNK) * LOGGER_PREALLOC_CHUNK;
+    
+    // No point reserving far beyond the rotation limit
+    uint32_t limit = _config.maxFileSizeBytes + LOGGER_SECTOR_SIZE;
+    if (target > limit && minSize <= limit) {
+        target = limit;
+    }
+    
+    if (target > _allocatedSize && _sdCard->extendFile(_logFilePath.c_str(), target)) {
+        _allocatedSize = target;
+    }
+}
+
+/**
+ * @brief Locate the end of log data in a zero padded file
+ * @param physicalSize File size on the card
+ * @return uint32_t Offset just past the last data byte
+ *
+ * Records never contain a whole zero sector, so binary search for the
+ * first all-zero sector, then trim trailing zeros of the one before it.
+ */
+uint32_t EARS_logger::findDataEnd(uint32_t physicalSize) {
+    uint8_t sector[LOGGER_SECTOR_SIZE];
+    uint32_t lo = 0;
+    uint32_t hi = (physicalSize + LOGGER_SECTOR_SIZE - 1) / LOGGER_SECTOR_SIZE;
+    
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        size_t got = _sdCard->readDataAt(_logFilePath.c_str(), mid * LOGGER_SECTOR_SIZE, sector, sizeof(sector));
+        bool zero = true;
+        for (size_t i = 0; i < got; i++) {
+            if (sector[i] != 0) {
+                zero = false;
+                break;
+            }
+        }
+        if (zero) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    
+    if (lo == 0) {
+        return 0;
+    }
+    
+    size_t got = _sdCard->readDataAt(_logFilePath.c_str(), (lo - 1) * LOGGER_SECTOR_SIZE, sector, sizeof(sector));
+    while (got > 0 && sector[got - 1] == 0) {
+        got--;
+    }
+    return (lo - 1) * LOGGER_SECTOR_SIZE + got;
+}
+
+/**
+ * @brief Write all buffered log data to the SD card
+ * @return true if the buffer was written (or was empty)
+ * @return false if the SD write failed
+ */
+bool EARS_logger::flush() {
+    if (!_initialized || !_mutex) {
+        return false;
+    }
+    
+    // Include anything still queued for the async writer
+    drainQueue(UINT32_MAX);
+    
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    bool ok = flushLocked(true);
+    xSemaphoreGive(_mutex);
+    
+    // Explicit flush is the durability point for the cached file handle
+    _sdCard->flush(_logFilePath.c_str());
+    
+    return ok;
+}
+
+/**
+ * @brief Periodic service hook for buffered mode
+ * @return void
+ */
+void EARS_logger::tick() {
+    if (!_initialized) {
+        return;
+    }
+    
+    // Caller of tick() is the async writer
+    _writerTask = xTaskGetCurrentTaskHandle();
+    drainQueue(LOGGER_ASYNC_DRAIN_MAX);
+    
+    // Rotation and file growth happen here, off the logging tasks
+    bool growDue = _config.preallocate && _fileSize < _config.maxFileSizeBytes &&
+                   _allocatedSize - _fileSize < LOGGER_PREALLOC_CHUNK / 4;
+    if (_rotationPending || growDue) {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        if (_rotationPending) {
+            performRotation();
+        }
+        if (_config.preallocate && _allocatedSize - _fileSize < LOGGER_PREALLOC_CHUNK / 4) {
+            growLocked(_fileSize + LOGGER_PREALLOC_CHUNK / 4);
+        }
+        xSemaphoreGive(_mutex);
+    }
+    
+    if (!_config.buffered || _bufferUsed == 0) {
+        return;
+    }
+    
+    if (millis() - _lastFlushMs >= _config.flushIntervalMs) {
+        flush();
+    }
+}
+
+/**
+ * @brief Enable or disable buffered mode
+ * @param enabled true to stage lines in RAM
+ * @return void
+ */
+void EARS_logger::setBuffered(bool enabled) {
+    if (!enabled) {
+        flush();
+    }
+    _config.buffered = enabled;
 }
 
 /**
@@ -217,11 +961,75 @@ void EARS_logger::logf(LogLevel level, const char* format, va_list args) {
         return;
     }
     
+    if (_config.binary) {
+        // Staged as [tag][format pointer][header][args]; the pointer lets the
+        // writer emit the dictionary entry, so format must be a literal
+        char record[LOGGER_LINE_MAX];
+        LogRecordHeader header;
+        size_t prefix = 1 + sizeof(format);
+        size_t payload = encodeBinaryArgs(record + prefix + sizeof(header),
+                                          sizeof(record) - prefix - sizeof(header),
+                                          format, args);
+        
+        header.type = (uint8_t)LogRecordType::MESSAGE;
+        header.level = (uint8_t)level;
+        header.length = (uint16_t)payload;
+        header.timestampMs = millis();
+        header.formatId = formatId(format);
+        
+        record[0] = (char)LOGGER_STAGE_TAG;
+        memcpy(record + 1, &format, sizeof(format));
+        memcpy(record + prefix, &header, sizeof(header));
+        submitRecord(record, prefix + sizeof(header) + payload);
+        return;
+    }
+    
     char buffer[512];
     vsnprintf(buffer, sizeof(buffer), format, args);
     log(level, buffer);
 }
 
+/**
+ * @brief Switch between text and binary records
+ * @param enabled true to write binary records
+ * @return void
+ */
+void EARS_logger::setBinary(bool enabled) {
+    if (enabled == _config.binary) {
+        return;
+    }
+    
+    if (!_initialized) {
+        _config.binary = enabled;
+        return;
+    }
+    
+    // Nothing of the old format may be left queued or staged
+    flush();
+    
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    if (_fileSize > 0) {
+        performRotation();
+    }
+    _config.binary = enabled;
+    _knownFormatCount = 0;
+    xSemaphoreGive(_mutex);
+}
+
+/**
+ * @brief Compute the binary record ID of a format string
+ * @param format printf-style format string
+ * @return uint32_t FNV-1a 32-bit hash
+ */
+uint32_t EARS_logger::formatId(const char* format) {
+    uint32_t hash = 2166136261u;
+    while (*format) {
+        hash ^= (uint8_t)*format++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 /**
  * @brief Check if level should be logged (hierarchical)
  * @param level Log level to check
@@ -269,24 +1077,22 @@ const char* EARS_logger::getLevelString(LogLevel level) const {
  * @return String Timestamp in "YYYY-MM-DD HH:MM:SS" format 
  */
 String EARS_logger::getTimestamp() const {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    
-    struct tm timeinfo;
-    localtime_r(&tv.tv_sec, &timeinfo);
-    
     char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d %02d:%02d:%02d",
-             timeinfo.tm_year + 1900,
-             timeinfo.tm_mon + 1,
-             timeinfo.tm_mday,
-             timeinfo.tm_hour,
-             timeinfo.tm_min,
-             timeinfo.tm_sec);
-    
+    formatTimestamp(buffer, sizeof(buffer));
     return String(buffer);
 }
 
+/**
+ * @brief Format current timestamp into a caller buffer
+ * @param buffer Destination
+ * @param bufferSize Destination size
+ * @return size_t Characters written
+ */
+size_t EARS_logger::formatTimestamp(char* buffer, size_t bufferSize) const {
+    // Shared cached clock text: a copy, or two digits, per line
+    return using_time().formatTimestamp(buffer, bufferSize);
+}
+
 /**
  * @brief Set current log level
  * @param level New log level (NONE, ERROR, WARN, INFO, DEBUG)
@@ -366,74 +1172,40 @@ String EARS_logger::levelToString(LogLevel level) const {
 }
 
 /**
- * @brief Load entire unified config file
- * @param doc JsonDocument to load into
- * @return true if load successful
- * @return false if load failed* 
- */
-bool EARS_logger::loadUnifiedConfig(JsonDocument& doc) {
-    if (!_sdCard || !_sdCard->fileExists(_configFilePath.c_str())) {
-        return false;
-    }
-    
-    String jsonString = _sdCard->readFile(_configFilePath.c_str());
-    if (jsonString.length() == 0) {
-        return false;
-    }
-    
-    DeserializationError error = deserializeJson(doc, jsonString);
-    return !error;
-}
-
-/**
- * @brief Save entire unified config file
- * @param doc JsonDocument to save
- * @return true if save successful
- * @return false if save failed
- */
-bool EARS_logger::saveUnifiedConfig(const JsonDocument& doc) {
-    String jsonString;
-    serializeJsonPretty(doc, jsonString);
-    return _sdCard->writeFile(_configFilePath.c_str(), jsonString);
-}
-
-/**
- * @brief Load logger config from unified ears.config
+ * @brief Load logger config from the in-memory ears.config service
  * @return true if load successful
  * @return false if load failed
  */
 bool EARS_logger::loadConfig() {
-    JsonDocument doc;
+    // Parsed once at boot; defaults (and a write-back) if the file is missing
+    bool loaded = using_config().begin(_sdCard, _configFilePath.c_str());
+    const EARS_configLogger& cfg = using_config().logger();
     
-    if (!loadUnifiedConfig(doc)) {
-        // Config doesn't exist, create default
-        doc["system"]["version"] = "1.0.0";
-        doc["system"]["zap_number"] = "";  // Will be populated from NVS
-        doc["system"]["device_name"] = "EARS";
-        
-        doc["logger"]["log_level"] = "DEBUG";
-        doc["logger"]["max_file_size_bytes"] = 1048576;
-        doc["logger"]["max_rotated_files"] = 3;
-        
-        saveUnifiedConfig(doc);
-    }
+    _config.currentLevel = parseLevelString(cfg.logLevel);
+    _config.maxFileSizeBytes = cfg.maxFileSizeBytes;
+    _config.maxRotatedFiles = cfg.maxRotatedFiles;
+    _config.buffered = cfg.buffered;
+    _config.flushIntervalMs = cfg.flushIntervalMs;
+    _config.async = cfg.async;
+    _config.binary = cfg.binary;
+    _config.preallocate = cfg.preallocate;
+    _config.compressRotated = cfg.compressRotated;
     
-    // Extract logger section
-    JsonObject loggerObj = doc["logger"];
-    if (loggerObj.isNull()) {
-        return false;
+    if (strcmp(cfg.overflowPolicy, "BLOCK") == 0) {
+        _config.overflowPolicy = LogOverflowPolicy::BLOCK;
+    } else if (strcmp(cfg.overflowPolicy, "DROP_NEWEST") == 0) {
+        _config.overflowPolicy = LogOverflowPolicy::DROP_NEWEST;
+    } else {
+        _config.overflowPolicy = LogOverflowPolicy::DROP_OLDEST;
     }
     
-    String levelStr = loggerObj["log_level"] | "DEBUG";
-    _config.currentLevel = parseLevelString(levelStr);
-    _config.maxFileSizeBytes = loggerObj["max_file_size_bytes"] | 1048576;
-    _config.maxRotatedFiles = loggerObj["max_rotated_files"] | 3;
-    
-    return true;
+    return loaded;
 }
 
 /**
  * @brief Save logger config to unified ears.config
+ * @details Hands the section to the config service, which writes it out
+ *          atomically once changes have settled
  * @return true if save successful
  * @return false if save failed
  */
@@ -442,17 +1214,24 @@ bool EARS_logger::saveConfig() {
         return false;
     }
     
-    JsonDocument doc;
-    
-    // Load existing config or create new
-    loadUnifiedConfig(doc);
-    
-    // Update logger section
-    doc["logger"]["log_level"] = levelToString(_config.currentLevel);
-    doc["logger"]["max_file_size_bytes"] = _config.maxFileSizeBytes;
-    doc["logger"]["max_rotated_files"] = _config.maxRotatedFiles;
+    EARS_configLogger cfg = using_config().logger();
+    strlcpy(cfg.logLevel, levelToString(_config.currentLevel).c_str(), sizeof(cfg.logLevel));
+    cfg.maxFileSizeBytes = _config.maxFileSizeBytes;
+    cfg.maxRotatedFiles = _config.maxRotatedFiles;
+    cfg.buffered = _config.buffered;
+    cfg.flushIntervalMs = _config.flushIntervalMs;
+    cfg.async = _config.async;
+    strlcpy(cfg.overflowPolicy,
+            (_config.overflowPolicy == LogOverflowPolicy::BLOCK)         ? "BLOCK"
+            : (_config.overflowPolicy == LogOverflowPolicy::DROP_NEWEST) ? "DROP_NEWEST"
+                                                                          : "DROP_OLDEST",
+            sizeof(cfg.overflowPolicy));
+    cfg.binary = _config.binary;
+    cfg.preallocate = _config.preallocate;
+    cfg.compressRotated = _config.compressRotated;
     
-    return saveUnifiedConfig(doc);
+    using_config().setLogger(cfg);
+    return true;
 }
 
 /**
@@ -465,7 +1244,14 @@ bool EARS_logger::clearLog() {
         return false;
     }
     
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    _bufferUsed = 0;
     bool result = _sdCard->removeFile(_logFilePath.c_str());
+    if (result) {
+        _fileSize = 0;
+        _allocatedSize = 0;
+    }
+    xSemaphoreGive(_mutex);
     
     if (result) {
         info("Log file cleared");
@@ -479,19 +1265,12 @@ bool EARS_logger::clearLog() {
  * @return uint32_t Log file size in bytes
  */
 uint32_t EARS_logger::getLogFileSize() {
-    if (!_initialized || !_sdCard->fileExists(_logFilePath.c_str())) {
-        return 0;
-    }
-    
-    File file = SD.open(_logFilePath.c_str(), FILE_READ);
-    if (!file) {
+    if (!_initialized) {
         return 0;
     }
     
-    uint32_t size = file.size();
-    file.close();
-    
-    return size;
+    // File contents plus anything still staged in RAM
+    return _fileSize + _bufferUsed;
 }
 
 /**
@@ -522,49 +1301,245 @@ bool EARS_logger::performRotation() {
         return false;
     }
     
-    info("Starting log rotation...");
+    // Push staged lines into the file being rotated (caller holds _mutex)
+    flushLocked(true);
+    _rotationPending = false;
+    
+    // Drop the preallocated padding so rotated files hold only data
+    if (_allocatedSize > _fileSize) {
+        _sdCard->truncateFile(_logFilePath.c_str(), _fileSize);
+    }
+    
+    // The file being compressed is about to be renamed
+    abortCompressionLocked();
+    
+    // Compressed files are kept by bytes, up to LOGGER_ROTATED_FILES_MAX
+    int oldest = _config.compressRotated ? LOGGER_ROTATED_FILES_MAX : _config.maxRotatedFiles;
     
     // Delete oldest rotated file if it exists
-    String oldestFile = _logFilePath + "." + String(_config.maxRotatedFiles);
-    if (_sdCard->fileExists(oldestFile.c_str())) {
-        _sdCard->removeFile(oldestFile.c_str());
+    for (int compressed = 0; compressed <= 1; compressed++) {
+        String oldestFile = rotatedName(oldest, compressed);
+        if (_sdCard->fileExists(oldestFile.c_str())) {
+            _sdCard->removeFile(oldestFile.c_str());
+        }
     }
     
-    // Shift all rotated files up by one
-    for (int i = _config.maxRotatedFiles - 1; i >= 1; i--) {
-        String oldName = _logFilePath + "." + String(i);
-        String newName = _logFilePath + "." + String(i + 1);
-        
-        if (_sdCard->fileExists(oldName.c_str())) {
-            // Read old file
-            String content = _sdCard->readFile(oldName.c_str());
-            // Write to new file
-            _sdCard->writeFile(newName.c_str(), content);
-            // Delete old file
-            _sdCard->removeFile(oldName.c_str());
+    // Shift all rotated files up by one (directory renames, no data copied)
+    for (int i = oldest - 1; i >= 1; i--) {
+        for (int compressed = 0; compressed <= 1; compressed++) {
+            String oldName = rotatedName(i, compressed);
+            if (_sdCard->fileExists(oldName.c_str())) {
+                _sdCard->renameFile(oldName.c_str(), rotatedName(i + 1, compressed).c_str());
+            }
         }
     }
     
     // Rename current log to .1
-    String rotatedName = _logFilePath + ".1";
+    String newest = rotatedName(1, false);
     if (_sdCard->fileExists(_logFilePath.c_str())) {
-        String content = _sdCard->readFile(_logFilePath.c_str());
-        _sdCard->writeFile(rotatedName.c_str(), content);
-        _sdCard->removeFile(_logFilePath.c_str());
+        _sdCard->renameFile(_logFilePath.c_str(), newest.c_str());
     }
+    _fileSize = 0;
+    _allocatedSize = 0;
     
-    info("Log rotation completed");
+    if (_config.compressRotated) {
+        _compressPending = true;
+        applyRetentionLocked();
+    }
     
     return true;
 }
 
+/**
+ * @brief Name of a rotated file
+ * @param index 1 for the newest
+ * @param compressed true for the .hs name
+ * @return String Path
+ */
+String EARS_logger::rotatedName(uint8_t index, bool compressed) const {
+    String name = _logFilePath + "." + String(index);
+    if (compressed) {
+        name += LOGGER_COMPRESS_SUFFIX;
+    }
+    return name;
+}
+
+/**
+ * @brief Drop a compression in progress, caller holds _mutex
+ * @return void
+ */
+void EARS_logger::abortCompressionLocked() {
+    if (_compressor == nullptr) {
+        return;
+    }
+    
+    String output = rotatedName(_compressor->index, true);
+    if (_sdCard->fileExists(output.c_str())) {
+        _sdCard->removeFile(output.c_str());
+    }
+    heap_caps_free(_compressor);
+    _compressor = nullptr;
+    _compressPending = true;
+}
+
+/**
+ * @brief Delete the oldest rotated files over the byte budget, caller holds _mutex
+ * @details Newest first, each file counted as it is on the card (a plain
+ *          file not compressed yet at its full size). The newest is always
+ *          kept.
+ * @return void
+ */
+void EARS_logger::applyRetentionLocked() {
+    uint64_t budget = (uint64_t)_config.maxRotatedFiles * _config.maxFileSizeBytes;
+    uint64_t used = 0;
+    
+    for (int i = 1; i <= LOGGER_ROTATED_FILES_MAX; i++) {
+        String plain = rotatedName(i, false);
+        String compressed = rotatedName(i, true);
+        bool hasPlain = _sdCard->fileExists(plain.c_str());
+        bool hasCompressed = _sdCard->fileExists(compressed.c_str());
+        if (!hasPlain && !hasCompressed) {
+            continue;
+        }
+        
+        // A .hs beside its plain file is unfinished, the plain one counts
+        used += hasPlain ? _sdCard->getFileSize(plain.c_str()) : _sdCard->getFileSize(compressed.c_str());
+        if (i == 1 || used <= budget) {
+            continue;
+        }
+        
+        if (_compressor != nullptr && _compressor->index == i) {
+            abortCompressionLocked();
+        }
+        if (hasPlain) {
+            _sdCard->removeFile(plain.c_str());
+        }
+        if (hasCompressed) {
+            _sdCard->removeFile(compressed.c_str());
+        }
+    }
+}
+
+/**
+ * @brief Compress the next step of a rotated log (Core 1 job)
+ * @return true if a file is still being compressed
+ */
+bool EARS_logger::serviceCompression() {
+    if (!_initialized || !_config.compressRotated || (!_compressPending && _compressor == nullptr)) {
+        return false;
+    }
+    
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    
+    // Newest plain rotated file first
+    if (_compressor == nullptr) {
+        uint8_t index = 0;
+        for (int i = 1; i <= LOGGER_ROTATED_FILES_MAX && index == 0; i++) {
+            if (_sdCard->fileExists(rotatedName(i, false).c_str())) {
+                index = i;
+            }
+        }
+        if (index == 0) {
+            _compressPending = false;
+            xSemaphoreGive(_mutex);
+            return false;
+        }
+        
+        _compressor = (LogCompressor*)heap_caps_calloc(1, sizeof(LogCompressor), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (_compressor == nullptr) {
+            _compressor = (LogCompressor*)heap_caps_calloc(1, sizeof(LogCompressor), MALLOC_CAP_8BIT);
+        }
+        if (_compressor == nullptr) {
+            xSemaphoreGive(_mutex);
+            return false;
+        }
+        _compressor->index = index;
+        _compressor->srcSize = _sdCard->getFileSize(rotatedName(index, false).c_str());
+        
+        // Left by a reset or a rotation: start it again
+        String output = rotatedName(index, true);
+        if (_sdCard->fileExists(output.c_str())) {
+            _sdCard->removeFile(output.c_str());
+        }
+    }
+    
+    LogCompressor* c = _compressor;
+    String plain = rotatedName(c->index, false);
+    String output = rotatedName(c->index, true);
+    const uint32_t windowSize = 1 << LOGGER_HS_WINDOW_BITS;
+    
+    // Keep one window of history behind the next position, then read on
+    if (c->pos - c->base > windowSize) {
+        uint32_t drop = c->pos - windowSize - c->base;
+        memmove(c->window, c->window + drop, c->end - c->base - drop);
+        c->base += drop;
+    }
+    uint32_t want = sizeof(c->window) - (c->end - c->base);
+    if (want > c->srcSize - c->end) {
+        want = c->srcSize - c->end;
+    }
+    if (want > LOGGER_COMPRESS_STEP_BYTES) {
+        want = LOGGER_COMPRESS_STEP_BYTES;
+    }
+    if (want > 0) {
+        size_t got = _sdCard->readDataAt(plain.c_str(), c->end, c->window + (c->end - c->base), want);
+        c->failed = (got != want);
+        c->end += got;
+    }
+    
+    bool final = (c->end == c->srcSize);
+    uint32_t before;
+    do {
+        before = c->pos;
+        hsEncode(c, final);
+        if (final && c->pos == c->end && c->bitCount > 0) {
+            c->out[c->outUsed++] = (uint8_t)(c->bits << (8 - c->bitCount));
+            c->bitCount = 0;
+        }
+        if (c->outUsed > 0 && !c->failed) {
+            c->failed = !_sdCard->appendData(output.c_str(), c->out, c->outUsed);
+        }
+        c->outUsed = 0;
+    } while (!c->failed && c->pos != before);
+    
+    bool busy = true;
+    if (c->failed) {
+        // Plain file kept; tried again after the next rotation or boot
+        abortCompressionLocked();
+        _compressPending = false;
+        busy = false;
+    } else if (final && c->pos == c->end) {
+        _sdCard->flush(output.c_str());
+        _sdCard->removeFile(plain.c_str());
+        heap_caps_free(_compressor);
+        _compressor = nullptr;
+        _compressedFiles++;
+        applyRetentionLocked();
+        busy = false;
+    }
+    
+    xSemaphoreGive(_mutex);
+    return busy;
+}
+
 /**
  * @brief Force log rotation (for testing)
  * @return true if rotation successful
  * @return false if rotation failed
  */
 bool EARS_logger::rotateLog() {
-    return performRotation();
+    if (!_initialized) {
+        return false;
+    }
+    
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    bool result = performRotation();
+    xSemaphoreGive(_mutex);
+    
+    if (result) {
+        info("Log rotation completed");
+    }
+    return result;
 }
 
 
@@ -573,24 +1548,24 @@ bool EARS_logger::rotateLog() {
  *****************************************************************************/
 
 // Get library name
-const char* EARS_Logger::getLibraryName() {
+const char* EARS_logger::getLibraryName() {
     return EARS_Logger::LIB_NAME;
 }
 
 // Get encoded version as integer
-uint32_t EARS_Logger::getVersionEncoded() {
+uint32_t EARS_logger::getVersionEncoded() {
     return VERS_ENCODE(EARS_Logger::VERSION_MAJOR, 
                        EARS_Logger::VERSION_MINOR, 
                        EARS_Logger::VERSION_PATCH);
 }
 
 // Get version date
-const char* EARS_Logger::getVersionDate() {
+const char* EARS_logger::getVersionDate() {
     return EARS_Logger::VERSION_DATE;
 }
 
 // Format version as string
-void EARS_Logger::getVersionString(char* buffer) {
+void EARS_logger::getVersionString(char* buffer) {
     uint32_t encoded = getVersionEncoded();
     VERS_FORMAT(encoded, buffer);
 }
@@ -2,8 +2,29 @@
  * @file EARS_loggerLib.h
  * @author JTB & Claude Sonnet 4.2
  * @brief Enhanced logging system with hierarchical levels and unified config
- * @version 3.0.0
- * @date 20260210
+ * @details Log lines are formatted straight into a preallocated RAM buffer
+ *          and written to the SD card in whole 512-byte sector blocks when
+ *          the fill threshold is reached, when the flush interval expires
+ *          (tick()), or on an explicit flush(). Text lines are stamped
+ *          from EARS_time's cached clock text, shared with EARS_errors.
+ *          In async mode producers only copy the formatted line into a
+ *          FreeRTOS ring buffer; the Core 1 background task drains it from
+ *          tick() and performs all SD I/O.
+ *          In binary mode each record is a fixed header (millis timestamp,
+ *          level, format-string ID) followed by the raw printf arguments;
+ *          scripts/decode_binary_log.py turns a file back into text.
+ *          Files grow in LOGGER_PREALLOC_CHUNK steps (zero padded, trimmed on
+ *          rotation) and rotation is deferred to the writer task, so a log
+ *          call never pays for cluster allocation or the rename cascade.
+ *          With compressRotated, a Core 1 job (serviceCompression())
+ *          compresses each rotated file to <log>.N.hs a step at a time and
+ *          retention counts the bytes on the card, so the space of
+ *          maxRotatedFiles plain files holds several times the history.
+ *          The .hs files are raw heatshrink streams (window
+ *          LOGGER_HS_WINDOW_BITS, lookahead LOGGER_HS_LOOKAHEAD_BITS):
+ *          scripts/decompress_log.py or "heatshrink -d -w 12 -l 5".
+ * @version 3.9.0
+ * @date 20261015
  * 
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -17,9 +38,13 @@
  *****************************************************************************/
 #include <Arduino.h>
 #include "EARS_versionDef.h"
-#include <SD.h>
-#include <ArduinoJson.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/ringbuf.h>
 #include "EARS_sdCardLib.h"
+#include "EARS_configLib.h"
+#include "EARS_eventBusLib.h"
+#include "EARS_timeLib.h"
 
 
 /******************************************************************************
@@ -29,12 +54,51 @@ namespace EARS_Logger
 {
     constexpr const char* LIB_NAME = "EARS_Logger";
     constexpr const char* VERSION_MAJOR = "3";
-    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_MINOR = "9";
     constexpr const char* VERSION_PATCH = "0";
-    constexpr const char* VERSION_DATE = "2026-02-10";
+    constexpr const char* VERSION_DATE = "2026-10-15";
 }
 
 
+/******************************************************************************
+ * Buffered Write Configuration
+ *****************************************************************************/
+#define LOGGER_BUFFER_SIZE 4096        // RAM staging buffer (8 sectors)
+#define LOGGER_SECTOR_SIZE 512         // SD sector size, flush granularity
+#define LOGGER_FLUSH_THRESHOLD 2048    // Fill level that triggers a block write
+#define LOGGER_FLUSH_INTERVAL_MS 2000  // Max age of buffered data before tick() flushes
+#define LOGGER_LINE_MAX 512            // Longest single formatted log line
+#define LOGGER_PREALLOC_CHUNK 65536    // File growth step when preallocating
+
+/******************************************************************************
+ * Async Backend Configuration
+ *****************************************************************************/
+#define LOGGER_ASYNC_RING_SIZE 8192    // Bytes of queued records for the writer
+#define LOGGER_ASYNC_DRAIN_MAX 64      // Records drained per tick() call
+
+/******************************************************************************
+ * Binary Log Configuration
+ *****************************************************************************/
+#define LOGGER_BINARY_MAGIC "EARSBLG1"  // First bytes of every binary log file
+#define LOGGER_BINARY_MAGIC_LEN 8
+#define LOGGER_BINARY_DICT_SIZE 64      // Format IDs remembered per file
+#define LOGGER_BINARY_STRING_MAX 255    // Longest %s argument stored
+#define LOGGER_STAGE_TAG 0xFF           // Queue-only prefix: record carries its format pointer
+
+/******************************************************************************
+ * Rotated Log Compression Configuration
+ *****************************************************************************/
+#define LOGGER_COMPRESS_SUFFIX ".hs"     // <log>.N.hs, heatshrink stream
+#define LOGGER_HS_WINDOW_BITS 12         // 4 KB of history for matches
+#define LOGGER_HS_LOOKAHEAD_BITS 5       // Matches of up to 32 bytes
+#define LOGGER_HS_MIN_MATCH 3            // Shorter matches cost more than literals
+#define LOGGER_HS_HASH_BITS 12           // Match finder hash table
+#define LOGGER_HS_CHAIN_MAX 32           // Candidates tried per position
+#define LOGGER_COMPRESS_STEP_BYTES 4096  // Input compressed per serviceCompression() call
+#define LOGGER_COMPRESS_OUT_BYTES 1024   // Output staged before each append
+#define LOGGER_COMPRESS_PERIOD_MS 20     // Job period; an idle call only checks a flag
+#define LOGGER_ROTATED_FILES_MAX 32      // Rotated files kept at most when compressing
+
 /**
  * @brief Hierarchical log level enumeration
  * 
@@ -53,6 +117,41 @@ enum class LogLevel {
     DEBUG = 4   // Everything (most verbose)
 };
 
+/**
+ * @brief What producers do when the async ring buffer is full
+ */
+enum class LogOverflowPolicy {
+    DROP_OLDEST = 0,  // Discard the oldest queued record to make room
+    DROP_NEWEST = 1,  // Discard the record being logged
+    BLOCK = 2         // Wait for the writer to make room
+};
+
+/**
+ * @enum LogRecordType
+ * @brief Record kinds in a binary log file
+ */
+enum class LogRecordType : uint8_t {
+    TEXT = 1,     // Payload is the message text (non-format calls)
+    FORMAT = 2,   // Payload is the format string for formatId (dictionary)
+    MESSAGE = 3   // Payload is the encoded printf arguments for formatId
+};
+
+/**
+ * @struct LogRecordHeader
+ * @brief Fixed 12-byte header in front of every binary record (little-endian)
+ * @details Arguments are stored in format-string order: integers as 4 bytes
+ *          (8 for ll/j), floating point as 8-byte doubles, pointers as 4 bytes
+ *          and strings as a length byte followed by up to
+ *          LOGGER_BINARY_STRING_MAX characters.
+ */
+struct __attribute__((packed)) LogRecordHeader {
+    uint8_t type;          // LogRecordType
+    uint8_t level;         // LogLevel
+    uint16_t length;       // Payload bytes following the header
+    uint32_t timestampMs;  // millis() when the record was produced
+    uint32_t formatId;     // FNV-1a hash of the format string (0 for TEXT)
+};
+
 /**
  * @brief Logger configuration structure
  */
@@ -60,14 +159,31 @@ struct LoggerConfig {
     LogLevel currentLevel;
     uint32_t maxFileSizeBytes;
     uint8_t maxRotatedFiles;
+    bool buffered;              // Stage lines in RAM, write in sector blocks
+    uint32_t flushIntervalMs;   // Timer flush interval for buffered mode
+    bool async;                 // Queue records for the Core 1 writer
+    LogOverflowPolicy overflowPolicy; // Async ring-full behaviour
+    bool binary;                // Write compact binary records instead of text
+    bool preallocate;           // Grow the file in LOGGER_PREALLOC_CHUNK steps
+    bool compressRotated;       // Compress rotated files, retain by bytes
     
     // Default constructor - Development defaults
     LoggerConfig() : 
         currentLevel(LogLevel::DEBUG),  // Most verbose for development
         maxFileSizeBytes(1048576),      // 1MB
-        maxRotatedFiles(3) {}
+        maxRotatedFiles(3),
+        buffered(true),
+        flushIntervalMs(LOGGER_FLUSH_INTERVAL_MS),
+        async(true),
+        overflowPolicy(LogOverflowPolicy::DROP_OLDEST),
+        binary(false),
+        preallocate(true),
+        compressRotated(true) {}
 };
 
+// Working state of the rotated log compressor (EARS_loggerLib.cpp)
+struct LogCompressor;
+
 /**
  * @brief Enhanced Logger class with hierarchical levels
  */
@@ -189,10 +305,12 @@ public:
     
     /**
      * @brief Save logger config to unified ears.config
-     * @return true if save successful
+     * @return true if save successful (or scheduled)
      * @return false if save failed
      * 
-     * Only updates the logger section, preserves other sections
+     * Only updates the logger section, preserves other sections.
+     * The file is replaced atomically and saves within
+     * SD_COALESCE_WINDOW_MS of each other reach the card as one write.
      */
     bool saveConfig();
     
@@ -238,6 +356,106 @@ public:
      * Useful for avoiding expensive string operations
      */
     bool wouldLog(LogLevel level) const;
+
+    /**
+     * @brief Write all buffered log data to the SD card
+     * @return true if the buffer was written (or was empty)
+     * @return false if the SD write failed
+     */
+    bool flush();
+
+    /**
+     * @brief Periodic service hook (writer side)
+     * @details Drains queued async records into the write buffer, then
+     *          flushes the buffer once its oldest data is older than
+     *          flushIntervalMs. Also runs deferred rotation and grows the
+     *          preallocated file ahead of the write position. Call from the
+     *          Core 1 background task loop; the calling task becomes the
+     *          async writer.
+     */
+    void tick();
+
+    /**
+     * @brief Enable or disable the async backend
+     * @param enabled true to queue records for the writer task
+     * @return true if the requested mode is active
+     * @note Disabling drains the queue synchronously first
+     */
+    bool setAsync(bool enabled);
+
+    /**
+     * @brief Check if the async backend is active
+     * @return true if records are queued for the writer task
+     */
+    bool isAsync() const { return _ring != nullptr && _config.async; }
+
+    /**
+     * @brief Set what producers do when the async queue is full
+     * @param policy DROP_OLDEST, DROP_NEWEST or BLOCK
+     */
+    void setOverflowPolicy(LogOverflowPolicy policy) { _config.overflowPolicy = policy; }
+
+    /**
+     * @brief Get number of records dropped by the overflow policy
+     * @return uint32_t Dropped record count since begin()
+     */
+    uint32_t getDroppedRecords() const { return _droppedRecords; }
+
+    /**
+     * @brief Enable or disable buffered mode
+     * @param enabled true to stage lines in RAM, false to write each line
+     * @note Disabling flushes any pending data first
+     */
+    void setBuffered(bool enabled);
+
+    /**
+     * @brief Check if buffered mode is enabled
+     * @return true if lines are staged in RAM
+     */
+    bool isBuffered() const { return _config.buffered; }
+
+    /**
+     * @brief Get number of bytes waiting in the RAM buffer
+     * @return size_t Buffered byte count
+     */
+    size_t getBufferedBytes() const { return _bufferUsed; }
+
+    /**
+     * @brief Switch between text and binary records
+     * @param enabled true to write binary records
+     * @note Flushes and rotates a non-empty log so each file holds one format
+     */
+    void setBinary(bool enabled);
+
+    /**
+     * @brief Check if binary records are written
+     * @return true if binary mode is active
+     */
+    bool isBinary() const { return _config.binary; }
+
+    /**
+     * @brief Compress the next step of a rotated log (Core 1 job)
+     * @details Takes the newest rotated file still in plain form, compresses
+     *          LOGGER_COMPRESS_STEP_BYTES of it into <file>.hs and, at its
+     *          end, removes the plain file and trims the oldest rotated files
+     *          to the budget of maxRotatedFiles x maxFileSizeBytes bytes.
+     *          A rotation meanwhile restarts the file under its new name.
+     * @return true if a file is still being compressed
+     */
+    bool serviceCompression();
+
+    /**
+     * @brief Get number of rotated files compressed
+     * @return uint32_t Files compressed since begin()
+     */
+    uint32_t getCompressedFiles() const { return _compressedFiles; }
+
+    /**
+     * @brief Compute the binary record ID of a format string
+     * @param format printf-style format string
+     * @return uint32_t FNV-1a 32-bit hash of the string
+     */
+    static uint32_t formatId(const char* format);
     
 private:
     // Singleton - private constructor
@@ -253,6 +471,132 @@ private:
     String _configFilePath;
     EARS_sdCard* _sdCard;
     LoggerConfig _config;
+
+    // Buffered write state (guarded by _mutex)
+    char _buffer[LOGGER_BUFFER_SIZE];
+    size_t _bufferUsed;
+    uint32_t _lastFlushMs;
+    uint32_t _fileSize;          // Tracked in RAM, avoids an open per line
+    uint32_t _allocatedSize;     // Physical size incl. preallocated padding
+    volatile bool _rotationPending; // Size limit hit, writer rotates in tick()
+    SemaphoreHandle_t _mutex;
+
+    // Async backend state
+    RingbufHandle_t _ring;       // Multi-producer record queue
+    TaskHandle_t _writerTask;    // Task that calls tick()
+    volatile uint32_t _droppedRecords;
+    uint32_t _reportedDrops;     // Drops already noted in the log
+
+    // Binary dictionary: format IDs already defined in the current file
+    uint32_t _knownFormats[LOGGER_BINARY_DICT_SIZE];
+    uint8_t _knownFormatCount;
+
+    // Rotated log compression (guarded by _mutex)
+    LogCompressor* _compressor;  // Allocated while a file is compressed
+    volatile bool _compressPending; // A rotated file may still be plain
+    uint32_t _compressedFiles;
+
+    /**
+     * @brief Name of a rotated file
+     * @param index 1 for the newest
+     * @param compressed true for the .hs name
+     * @return String Path
+     */
+    String rotatedName(uint8_t index, bool compressed) const;
+
+    /**
+     * @brief Drop a compression in progress, caller holds _mutex
+     * @details The partial .hs goes; the plain file stays for a later pass.
+     */
+    void abortCompressionLocked();
+
+    /**
+     * @brief Delete the oldest rotated files over the byte budget, caller holds _mutex
+     */
+    void applyRetentionLocked();
+
+    /**
+     * @brief Route a finished record to the queue or the write buffer
+     * @param record Record bytes
+     * @param length Record length
+     */
+    void submitRecord(const char* record, size_t length);
+
+    /**
+     * @brief Build a binary TEXT record
+     * @param out Destination
+     * @param outSize Destination size
+     * @param level LogLevel of the message
+     * @param message Message text
+     * @return size_t Record length
+     */
+    size_t buildTextRecord(char* out, size_t outSize, LogLevel level, const char* message) const;
+
+    /**
+     * @brief Write a block at the logical end of the file, caller holds _mutex
+     * @param data Bytes to write
+     * @param length Byte count
+     * @return true if the write succeeded
+     */
+    bool writeBlockLocked(const char* data, size_t length);
+
+    /**
+     * @brief Extend the preallocated file to cover minSize, caller holds _mutex
+     * @param minSize Logical size the allocation must reach
+     */
+    void growLocked(uint32_t minSize);
+
+    /**
+     * @brief Locate the end of log data in a zero padded file
+     * @param physicalSize File size on the card
+     * @return uint32_t Offset just past the last data byte
+     */
+    uint32_t findDataEnd(uint32_t physicalSize);
+
+    /**
+     * @brief Write bytes to the buffer or file, caller holds _mutex
+     * @param data Bytes to write
+     * @param length Byte count
+     */
+    void appendRaw(const char* data, size_t length);
+
+    /**
+     * @brief Queue a formatted line for the writer task
+     * @param line Line bytes including trailing newline
+     * @param length Line length
+     */
+    void enqueueRecord(const char* line, size_t length);
+
+    /**
+     * @brief Move queued records into the write buffer
+     * @param maxRecords Upper bound on records to move
+     */
+    void drainQueue(uint32_t maxRecords);
+
+    /**
+     * @brief Write buffered data, caller holds _mutex
+     * @param all true to write everything, false for whole sectors only
+     * @return true if the write succeeded
+     */
+    bool flushLocked(bool all);
+
+    /**
+     * @brief Append one formatted line or record, caller holds _mutex
+     * @details In binary mode this also writes the file magic and the
+     *          dictionary entry for a format seen for the first time.
+     * @param line Line bytes including trailing newline
+     * @param length Line length
+     */
+    void appendLocked(const char* line, size_t length);
+
+    /**
+     * @brief Format current timestamp into a caller buffer
+     * @details From EARS_time's cached text, the clock EARS_errors uses too
+     * @param buffer Destination
+     * @param bufferSize Destination size
+     * @return size_t Characters written
+     */
+    size_t formatTimestamp(char* buffer, size_t bufferSize) const;
     
     /**
      * @brief Core logging function
@@ -304,22 +648,6 @@ private:
      */
     bool performRotation();
     
-    /**
-     * @brief Load entire unified config file
-     * @param doc JsonDocument to load config into
-     * @return true if load successful
-     * @return false if load failed
-     */
-    bool loadUnifiedConfig(JsonDocument& doc);
-    
-    /**
-     * @brief Save entire unified config file
-     * @param doc JsonDocument containing config to save
-     * @return true if save successful
-     * @return false if save failed
-     */
-    bool saveUnifiedConfig(const JsonDocument& doc);
-    
     /**
      * @brief Parse log level from string
      * @param levelStr "NONE", "ERROR", "WARN", "INFO", or "DEBUG"
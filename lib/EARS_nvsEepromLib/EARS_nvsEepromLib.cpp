@@ -2,8 +2,8 @@
  * @file EARS_nvsEepromLib.cpp
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief NVS EEPROM wrapper class header
- * @version 2.0.0
- * @date 20260210
+ * @version 2.7.1
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -19,21 +19,99 @@ const uint16_t EARS_nvsEeprom::CURRENT_VERSION;
 // NVS Namespace - using definition from EARS_systemDef.h
 const char *EARS_nvsEeprom::NAMESPACE = EARS_NAMESPACE;
 
-// Standard NVS Keys - using definitions from EARS_systemDef.h
-const char *EARS_nvsEeprom::KEY_VERSION = EARS_VERSION_CODE;
-const char *EARS_nvsEeprom::KEY_ZAPNUMBER = EARS_ZAPCODE;
-const char *EARS_nvsEeprom::KEY_PASSWORD_HASH = EARS_PASSWORD_HASH;
-const char *EARS_nvsEeprom::KEY_BACKLIGHT = EARS_BACKLIGHT_VALUE;
-const char *EARS_nvsEeprom::KEY_NVS_CRC = EARS_CRC32;
+// Standard NVS Keys - names from the key registry (EARS_nvsKeys.h)
+const char *EARS_nvsEeprom::KEY_VERSION = EARS_NVSKeys::Version::name;
+const char *EARS_nvsEeprom::KEY_ZAPNUMBER = EARS_NVSKeys::ZapNumber::name;
+const char *EARS_nvsEeprom::KEY_PASSWORD_HASH = EARS_NVSKeys::PasswordHash::name;
+const char *EARS_nvsEeprom::KEY_BACKLIGHT = EARS_NVSKeys::Backlight::name;
+const char *EARS_nvsEeprom::KEY_NVS_CRC = EARS_NVSKeys::NvsCrc::name;
+
+// Migration steps, one per version bump. Add an entry (and bump
+// CURRENT_VERSION) whenever the NVS structure changes.
+const EARS_nvsEeprom::NVSMigration EARS_nvsEeprom::MIGRATIONS[] = {
+    {0, EARS_nvsEeprom::migrateV0toV1},
+};
+
+const size_t EARS_nvsEeprom::MIGRATION_COUNT = sizeof(MIGRATIONS) / sizeof(MIGRATIONS[0]);
+
+/******************************************************************************
+ * Password Hash Helpers
+ *****************************************************************************/
+
+// Write bytes as lowercase hex, out must hold 2 * length + 1
+static void bytesToHex(const uint8_t *data, size_t length, char *out)
+{
+    static const char digits[] = "0123456789abcdef";
+
+    for (size_t i = 0; i < length; i++)
+    {
+        out[2 * i] = digits[data[i] >> 4];
+        out[2 * i + 1] = digits[data[i] & 0x0F];
+    }
+    out[2 * length] = '\0';
+}
+
+// Parse exactly 2 * length hex characters, returns false on bad input
+static bool hexToBytes(const char *hex, size_t hexLength, uint8_t *out, size_t length)
+{
+    if (hexLength != 2 * length)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < hexLength; i++)
+    {
+        char c = hex[i];
+        uint8_t nibble;
+
+        if (c >= '0' && c <= '9')
+            nibble = c - '0';
+        else if (c >= 'a' && c <= 'f')
+            nibble = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            nibble = c - 'A' + 10;
+        else
+            return false;
+
+        if (i & 1)
+            out[i / 2] |= nibble;
+        else
+            out[i / 2] = nibble << 4;
+    }
+
+    return true;
+}
+
+// Compare without an early exit so timing does not leak the mismatch position
+static bool constantTimeEquals(const void *a, const void *b, size_t length)
+{
+    const volatile uint8_t *x = (const volatile uint8_t *)a;
+    const volatile uint8_t *y = (const volatile uint8_t *)b;
+    uint8_t diff = 0;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        diff |= x[i] ^ y[i];
+    }
+
+    return (diff == 0);
+}
 
 // NVS Constructor
-EARS_nvsEeprom::EARS_nvsEeprom()
+EARS_nvsEeprom::EARS_nvsEeprom() : _dirty(0), _lastChangeMs(0)
 {
+    _shadowLock = portMUX_INITIALIZER_UNLOCKED;
+    _flashMutex = xSemaphoreCreateMutex();
+    resetShadow(_shadow);
+    _shadow.loaded = false;
 }
 
 // NVS Destructor
 EARS_nvsEeprom::~EARS_nvsEeprom()
 {
+    commit();
+    if (_flashMutex)
+        vSemaphoreDelete(_flashMutex);
 }
 
 /**
@@ -55,20 +133,26 @@ bool EARS_nvsEeprom::begin()
 /**
  * @brief Get Hash from NVS
  *
+ * @note Reads flash directly and bypasses the RAM shadow.
+ *
  * @param key
  * @param defaultValue
  * @return Hash String
  */
 String EARS_nvsEeprom::getHash(const char *key, const String &defaultValue)
 {
+    lockFlash();
+
     // Open namespace in read-only mode
     if (!Preferences::begin(NAMESPACE, true))
     {
+        unlockFlash();
         return defaultValue;
     }
 
     String hash = getString(key, defaultValue);
     end();
+    unlockFlash();
 
     return hash;
 }
@@ -76,6 +160,9 @@ String EARS_nvsEeprom::getHash(const char *key, const String &defaultValue)
 /**
  * @brief Put Hash into NVS
  *
+ * @note Writes flash directly; call loadShadow() afterwards if the key is
+ *       one of the shadowed EARS keys.
+ *
  * @param key
  * @param value
  * @return true
@@ -83,14 +170,18 @@ String EARS_nvsEeprom::getHash(const char *key, const String &defaultValue)
  */
 bool EARS_nvsEeprom::putHash(const char *key, const String &value)
 {
+    lockFlash();
+
     // Open namespace in read-write mode
     if (!Preferences::begin(NAMESPACE, false))
     {
+        unlockFlash();
         return false;
     }
 
     size_t result = putString(key, value);
     end();
+    unlockFlash();
 
     return (result > 0);
 }
@@ -104,18 +195,8 @@ bool EARS_nvsEeprom::putHash(const char *key, const String &value)
  */
 uint32_t EARS_nvsEeprom::calculateCRC32(const uint8_t *data, size_t length)
 {
-    uint32_t crc = 0xFFFFFFFF;
-
-    for (size_t i = 0; i < length; i++)
-    {
-        crc ^= data[i];
-        for (uint8_t j = 0; j < 8; j++)
-        {
-            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
-        }
-    }
-
-    return ~crc;
+    // ROM implementation, same IEEE CRC-32 as the former bitwise loop
+    return esp_rom_crc32_le(0, data, length);
 }
 
 /**
@@ -158,14 +239,18 @@ bool EARS_nvsEeprom::compareHash(const String &data, const String &storedHash)
  */
 uint16_t EARS_nvsEeprom::getVersion(const char *key, uint16_t defaultVersion)
 {
+    lockFlash();
+
     // Open namespace in read-only mode
     if (!Preferences::begin(NAMESPACE, true))
     {
+        unlockFlash();
         return defaultVersion;
     }
 
     uint16_t version = getUShort(key, defaultVersion);
     end();
+    unlockFlash();
 
     return version;
 }
@@ -180,14 +265,18 @@ uint16_t EARS_nvsEeprom::getVersion(const char *key, uint16_t defaultVersion)
  */
 bool EARS_nvsEeprom::putVersion(const char *key, uint16_t version)
 {
+    lockFlash();
+
     // Open namespace in read-write mode
     if (!Preferences::begin(NAMESPACE, false))
     {
+        unlockFlash();
         return false;
     }
 
     size_t result = putUShort(key, version);
     end();
+    unlockFlash();
 
     return (result > 0);
 }
@@ -228,42 +317,53 @@ bool EARS_nvsEeprom::isValidZapNumber(const String &zapNumber)
 /**
  * @brief Calculate CRC32 for entire NVS contents (excluding the CRC itself)
  *
+ * @details
+ * Binary, fixed layout: the CRC32 of three little-endian CRC32 words, one
+ * each for the version (uint16_t), the ZapNumber and the password hash.
+ * The words are kept current in the RAM shadow as fields change, so this
+ * is a plain read; it reflects pending changes.
+ *
  * @return uint32_t CRC32 value
  */
 uint32_t EARS_nvsEeprom::calculateNVSCRC()
 {
-    String dataToHash = "";
+    ensureShadow();
 
-    // Open namespace in read-only mode
-    if (!Preferences::begin(NAMESPACE, true))
-    {
-        return 0;
-    }
-
-    // Concatenate all critical data in a specific order
-    // Version
-    uint16_t version = getUShort(KEY_VERSION, 0);
-    dataToHash += String(version);
-    dataToHash += "|";
+    portENTER_CRITICAL(&_shadowLock);
+    uint32_t crc = _shadow.liveCRC;
+    portEXIT_CRITICAL(&_shadowLock);
 
-    // ZapNumber
-    String zapNum = getString(KEY_ZAPNUMBER, "");
-    dataToHash += zapNum;
-    dataToHash += "|";
+    return crc;
+}
 
-    // Password Hash
-    String pwdHash = getString(KEY_PASSWORD_HASH, "");
-    dataToHash += pwdHash;
+/**
+ * @brief Calculate the pre-2.2.0 String based NVS CRC32
+ *
+ * @details Only used to accept and migrate a CRC stored by older firmware.
+ *
+ * @param version Version as the old code read it
+ * @return uint32_t CRC32 of "version|zapNumber|passwordHash"
+ */
+uint32_t EARS_nvsEeprom::calculateLegacyNVSCRC(uint16_t version)
+{
+    portENTER_CRITICAL(&_shadowLock);
+    NVSShadow shadow = _shadow;
+    portEXIT_CRITICAL(&_shadowLock);
 
-    end();
+    String dataToHash = String(version);
+    dataToHash += "|";
+    dataToHash += shadow.zapNumber;
+    dataToHash += "|";
+    dataToHash += shadow.passwordHash;
 
-    // Calculate CRC32 of concatenated data
     return calculateCRC32((const uint8_t *)dataToHash.c_str(), dataToHash.length());
 }
 
 /**
  * @brief Update the stored NVS CRC32 value
  *
+ * Stores the live shadow CRC and commits all dirty fields.
+ *
  * @return true Success
  * @return false Failed
  */
@@ -271,21 +371,25 @@ bool EARS_nvsEeprom::updateNVSCRC()
 {
     uint32_t crc = calculateNVSCRC();
 
-    // Open namespace in read-write mode
-    if (!Preferences::begin(NAMESPACE, false))
-    {
-        return false;
-    }
+    portENTER_CRITICAL(&_shadowLock);
+    _shadow.storedCRC = crc;
+    portEXIT_CRITICAL(&_shadowLock);
+    markDirty(FIELD_CRC);
 
-    size_t result = putUInt(KEY_NVS_CRC, crc);
-    end();
-
-    return (result > 0);
+    // Writes the CRC together with the fields that changed it
+    return commit();
 }
 
 /**
  * @brief Upgrade NVS from one version to another
  *
+ * @details
+ * Runs every registered step from fromVersion up to toVersion inside a
+ * single read-write session. Steps stage their changes in the RAM shadow;
+ * the new version, the staged fields and one CRC update are then written
+ * before the session closes. On failure the shadow is reloaded so no
+ * half-migrated state is kept in RAM.
+ *
  * @param fromVersion Current version
  * @param toVersion Target version
  * @return true Upgrade successful
@@ -305,37 +409,89 @@ bool EARS_nvsEeprom::upgradeNVS(uint16_t fromVersion, uint16_t toVersion)
         return false;
     }
 
+    lockFlash();
+
     // Open namespace in read-write mode
     if (!Preferences::begin(NAMESPACE, false))
     {
+        unlockFlash();
         return false;
     }
 
-    // Future: Add version-specific upgrade logic here
-    // For now, just update the version number
+    // Apply pending steps in version order; versions without a step only
+    // bump the version number
+    bool success = true;
+    for (uint16_t version = fromVersion; success && version < toVersion; version++)
+    {
+        for (size_t i = 0; i < MIGRATION_COUNT; i++)
+        {
+            if (MIGRATIONS[i].fromVersion == version)
+            {
+                success = MIGRATIONS[i].step(*this);
+                break;
+            }
+        }
+    }
 
-    // Example upgrade paths:
-    // if (fromVersion == 0 && toVersion >= 1) {
-    //     // Upgrade from version 0 to 1
-    //     // Add new keys, migrate data, etc.
-    // }
+    if (success)
+    {
+        // Stage the new version (refreshes the live CRC)
+        portENTER_CRITICAL(&_shadowLock);
+        _shadow.version = toVersion;
+        _shadow.hasVersion = true;
+        portEXIT_CRITICAL(&_shadowLock);
+        markDirty(FIELD_VERSION);
+
+        // One write burst: staged fields, version and CRC
+        portENTER_CRITICAL(&_shadowLock);
+        _shadow.storedCRC = _shadow.liveCRC;
+        uint8_t fields = _dirty | FIELD_CRC;
+        NVSShadow shadow = _shadow;
+        _dirty = 0;
+        portEXIT_CRITICAL(&_shadowLock);
+
+        success = (writeFields(fields, shadow) == 0);
+    }
 
-    // Update version
-    size_t result = putUShort(KEY_VERSION, toVersion);
     end();
+    unlockFlash();
 
-    if (result == 0)
+    if (!success)
     {
-        return false;
+        // Drop staged changes, keep what actually reached flash
+        loadShadow();
     }
 
-    // Recalculate and update CRC after upgrade
-    return updateNVSCRC();
+    return success;
+}
+
+/**
+ * @brief Migration 0 -> 1
+ *
+ * @details Version 0 namespaces may predate the backlight key; store the
+ *          default so every key exists after the upgrade.
+ *
+ * @param nvs Instance with the namespace open read-write
+ * @return true Step successful
+ */
+bool EARS_nvsEeprom::migrateV0toV1(EARS_nvsEeprom &nvs)
+{
+    if (!nvs.isKey(KEY_BACKLIGHT))
+    {
+        portENTER_CRITICAL(&nvs._shadowLock);
+        nvs._shadow.backlight = EARS_NVSKeys::Backlight::defaultValue;
+        portEXIT_CRITICAL(&nvs._shadowLock);
+        nvs.markDirty(FIELD_BACKLIGHT);
+    }
+
+    return true;
 }
 
 /**
  * @brief Validate entire NVS storage
  *
+ * Served from the RAM shadow; only an upgrade touches flash.
+ *
  * This function checks:
  * 1. Version matches or can be upgraded
  * 2. ZapNumber exists and is valid format
@@ -350,21 +506,19 @@ NVSValidationResult EARS_nvsEeprom::validateNVS()
     result.expectedVersion = CURRENT_VERSION;
 
     // Step 1: Check NVS initialization
-    if (!Preferences::begin(NAMESPACE, true))
+    ensureShadow();
+    if (!_shadow.present)
     {
         result.status = NVSStatus::INITIALIZATION_FAILED;
-        end();
         return result;
     }
 
     // Step 2: Get and check version
-    result.currentVersion = getUShort(KEY_VERSION, 0);
+    result.currentVersion = getNVSVersionInt();
 
     // Check if upgrade is needed
     if (result.currentVersion < CURRENT_VERSION)
     {
-        end(); // Close read-only session
-
         // Attempt upgrade
         if (upgradeNVS(result.currentVersion, CURRENT_VERSION))
         {
@@ -376,57 +530,56 @@ NVSValidationResult EARS_nvsEeprom::validateNVS()
             result.status = NVSStatus::INVALID_VERSION;
             return result;
         }
-
-        // Reopen for continued validation
-        if (!Preferences::begin(NAMESPACE, true))
-        {
-            result.status = NVSStatus::INITIALIZATION_FAILED;
-            return result;
-        }
     }
     else if (result.currentVersion > CURRENT_VERSION)
     {
         // Version from future - cannot handle
         result.status = NVSStatus::INVALID_VERSION;
-        end();
         return result;
     }
 
     // Step 3: Check ZapNumber
-    String zapNum = getString(KEY_ZAPNUMBER, "");
+    String zapNum = getZapNumber();
     if (zapNum.length() == 0 || !isValidZapNumber(zapNum))
     {
         result.zapNumberValid = false;
         result.status = NVSStatus::MISSING_ZAPNUMBER;
-        end();
         return result;
     }
     result.zapNumberValid = true;
     zapNum.toCharArray(result.zapNumber, 7);
 
     // Step 4: Check password hash
-    String pwdHash = getString(KEY_PASSWORD_HASH, "");
-    if (pwdHash.length() == 0)
+    if (!hasPassword())
     {
         result.passwordHashValid = false;
         result.status = NVSStatus::MISSING_PASSWORD;
-        end();
         return result;
     }
     result.passwordHashValid = true;
 
     // Step 5: Check overall CRC32
-    uint32_t storedCRC = getUInt(KEY_NVS_CRC, 0);
-    end(); // Close before calculating new CRC
+    portENTER_CRITICAL(&_shadowLock);
+    uint32_t storedCRC = _shadow.storedCRC;
+    portEXIT_CRITICAL(&_shadowLock);
 
     uint32_t calculatedCRC = calculateNVSCRC();
     result.calculatedCRC = calculatedCRC;
 
     if (storedCRC != calculatedCRC)
     {
-        result.crcValid = false;
-        result.status = NVSStatus::CRC_FAILED;
-        return result;
+        // Older firmware stored a String based CRC; its version read was
+        // either the u16 value or 0 for a string-typed key
+        if (storedCRC != calculateLegacyNVSCRC(result.currentVersion) &&
+            storedCRC != calculateLegacyNVSCRC(0))
+        {
+            result.crcValid = false;
+            result.status = NVSStatus::CRC_FAILED;
+            return result;
+        }
+
+        // Legacy CRC matches - migrate to the binary layout
+        updateNVSCRC();
     }
     result.crcValid = true;
 
@@ -446,20 +599,20 @@ NVSValidationResult EARS_nvsEeprom::validateNVS()
 /**
  * @brief Get ZapNumber from NVS
  *
+ * Served from the RAM shadow.
+ *
  * @return String The stored ZapNumber or empty string if not found
  */
 String EARS_nvsEeprom::getZapNumber()
 {
-    // Open namespace in read-only mode
-    if (!Preferences::begin(NAMESPACE, true))
-    {
-        return "";
-    }
+    ensureShadow();
 
-    String zapNumber = getString(KEY_ZAPNUMBER, "");
-    end();
+    char zapNumber[sizeof(_shadow.zapNumber)];
+    portENTER_CRITICAL(&_shadowLock);
+    memcpy(zapNumber, _shadow.zapNumber, sizeof(zapNumber));
+    portEXIT_CRITICAL(&_shadowLock);
 
-    return zapNumber;
+    return String(zapNumber);
 }
 
 /**
@@ -477,22 +630,15 @@ bool EARS_nvsEeprom::setZapNumber(const String &zapNumber)
         return false;
     }
 
-    // Open namespace in read-write mode
-    if (!Preferences::begin(NAMESPACE, false))
-    {
-        return false;
-    }
-
-    // Store in NVS
-    size_t result = putString(KEY_ZAPNUMBER, zapNumber);
-    end();
+    ensureShadow();
 
-    if (result == 0)
-    {
-        return false;
-    }
+    // Store in shadow
+    portENTER_CRITICAL(&_shadowLock);
+    zapNumber.toCharArray(_shadow.zapNumber, sizeof(_shadow.zapNumber));
+    portEXIT_CRITICAL(&_shadowLock);
+    markDirty(FIELD_ZAPNUMBER);
 
-    // Update CRC after successful write
+    // Update CRC and commit both
     return updateNVSCRC();
 }
 
@@ -506,15 +652,16 @@ bool EARS_nvsEeprom::setZapNumber(const String &zapNumber)
  */
 String EARS_nvsEeprom::getNVSVersionString()
 {
-    if (!Preferences::begin(NAMESPACE, true))
+    ensureShadow();
+    if (!_shadow.hasVersion)
     {
         return "00";
     }
 
-    String versionStr = getString(KEY_VERSION, "00");
-    end();
+    char hexStr[3];
+    sprintf(hexStr, "%02X", getNVSVersionInt());
 
-    return versionStr;
+    return String(hexStr);
 }
 
 /**
@@ -523,10 +670,13 @@ String EARS_nvsEeprom::getNVSVersionString()
  */
 uint16_t EARS_nvsEeprom::getNVSVersionInt()
 {
-    String versionStr = getNVSVersionString();
+    ensureShadow();
+
+    portENTER_CRITICAL(&_shadowLock);
+    uint16_t version = _shadow.version;
+    portEXIT_CRITICAL(&_shadowLock);
 
-    // Convert hex string to integer
-    return (uint16_t)strtol(versionStr.c_str(), NULL, 16);
+    return version;
 }
 
 /**
@@ -542,24 +692,16 @@ bool EARS_nvsEeprom::setNVSVersion(uint16_t version)
         return false;
     }
 
-    // Convert to 2-digit hex string (e.g., 1 â†’ "01", 15 â†’ "0F", 255 â†’ "FF")
-    char hexStr[3];
-    sprintf(hexStr, "%02X", version);
-
-    if (!Preferences::begin(NAMESPACE, false))
-    {
-        return false;
-    }
-
-    size_t result = putString(KEY_VERSION, String(hexStr));
-    end();
+    ensureShadow();
 
-    if (result == 0)
-    {
-        return false;
-    }
+    // Stored as a 2-digit hex string by commit() (e.g., 1 -> "01", 255 -> "FF")
+    portENTER_CRITICAL(&_shadowLock);
+    _shadow.version = version;
+    _shadow.hasVersion = true;
+    portEXIT_CRITICAL(&_shadowLock);
+    markDirty(FIELD_VERSION);
 
-    // Update CRC after successful write
+    // Update CRC and commit both
     return updateNVSCRC();
 }
 
@@ -569,44 +711,44 @@ bool EARS_nvsEeprom::setNVSVersion(uint16_t version)
 
 /**
  * @brief Get stored password hash
- * @return String CRC32 hash of password (8 hex characters)
+ * @return String Stored hash ("S1$..." or a legacy 8-character CRC32)
  */
 String EARS_nvsEeprom::getPasswordHash()
 {
-    return getHash(KEY_PASSWORD_HASH, "");
+    ensureShadow();
+
+    char hash[sizeof(_shadow.passwordHash)];
+    portENTER_CRITICAL(&_shadowLock);
+    memcpy(hash, _shadow.passwordHash, sizeof(hash));
+    portEXIT_CRITICAL(&_shadowLock);
+
+    return String(hash);
 }
 
 /**
- * @brief Set password (converts to CRC32 hash and stores)
+ * @brief Set password (salted PBKDF2-HMAC-SHA256 hash, then store)
  * @param password Plain text password
  * @return true if successful
  */
 bool EARS_nvsEeprom::setPassword(const String &password)
 {
-    if (password.length() == 0)
+    String passwordHash = makePasswordHash(password);
+    if (passwordHash.length() == 0)
     {
         return false;
     }
 
-    // Generate CRC32 hash of password
-    String passwordHash = makeHash(password);
-
-    // Store hash
-    bool result = putHash(KEY_PASSWORD_HASH, passwordHash);
-
-    if (result)
-    {
-        // Update overall CRC
-        return updateNVSCRC();
-    }
-
-    return false;
+    return storePasswordHash(passwordHash);
 }
 
 /**
  * @brief Verify password against stored hash
  * @param password Plain text password to verify
  * @return true if password matches stored hash
+ *
+ * @details
+ * A legacy 8-character CRC32 hash is still accepted and is replaced by a
+ * salted hash on success.
  */
 bool EARS_nvsEeprom::verifyPassword(const String &password)
 {
@@ -617,7 +759,112 @@ bool EARS_nvsEeprom::verifyPassword(const String &password)
         return false; // No password set
     }
 
-    return compareHash(password, storedHash);
+    // Legacy CRC32 hash from firmware before 2.3.0
+    if (!storedHash.startsWith(NVS_PASSWORD_SCHEME "$"))
+    {
+        String legacyHash = makeHash(password);
+        if (legacyHash.length() != storedHash.length() ||
+            !constantTimeEquals(legacyHash.c_str(), storedHash.c_str(), storedHash.length()))
+        {
+            return false;
+        }
+
+        // Upgrade to the salted hash while the plain text is at hand
+        setPassword(password);
+        return true;
+    }
+
+    return verifyPasswordHash(password, storedHash.c_str());
+}
+
+/**
+ * @brief Hash a password into the stored form
+ * @param password Plain text password
+ * @return String "S1$<iterations>$<salt hex>$<key hex>", empty on failure
+ *
+ * @details
+ * A fresh random salt is drawn for every call. The iteration count is part
+ * of the stored form, so it can be raised later without invalidating
+ * existing hashes. Touches no NVS state: safe from any task.
+ */
+String EARS_nvsEeprom::makePasswordHash(const String &password)
+{
+    if (password.length() == 0)
+    {
+        return String();
+    }
+
+    uint8_t salt[NVS_PASSWORD_SALT_BYTES];
+    uint8_t key[NVS_PASSWORD_KEY_BYTES];
+    esp_fill_random(salt, sizeof(salt));
+
+    if (!derivePasswordKey(password, salt, sizeof(salt), NVS_PASSWORD_ITERATIONS, key))
+    {
+        return String();
+    }
+
+    char saltHex[2 * NVS_PASSWORD_SALT_BYTES + 1];
+    char keyHex[2 * NVS_PASSWORD_KEY_BYTES + 1];
+    bytesToHex(salt, sizeof(salt), saltHex);
+    bytesToHex(key, sizeof(key), keyHex);
+
+    char passwordHash[NVS_PASSWORD_HASH_MAX + 1];
+    snprintf(passwordHash, sizeof(passwordHash), "%s$%u$%s$%s",
+             NVS_PASSWORD_SCHEME, (unsigned)NVS_PASSWORD_ITERATIONS, saltHex, keyHex);
+
+    return String(passwordHash);
+}
+
+/**
+ * @brief Verify a password against a hash in the stored form
+ * @param password Plain text password to verify
+ * @param storedHash "S1$<iterations>$<salt hex>$<key hex>"
+ * @return true if the password matches
+ *
+ * @details
+ * The derived key is compared in constant time. An iteration count outside
+ * 1..NVS_PASSWORD_ITERATIONS_MAX makes the hash invalid: a corrupted or
+ * planted count cannot stall the caller in PBKDF2. Touches no NVS state:
+ * safe from any task.
+ */
+bool EARS_nvsEeprom::verifyPasswordHash(const String &password, const char *storedHash)
+{
+    if (storedHash == nullptr || strncmp(storedHash, NVS_PASSWORD_SCHEME "$", strlen(NVS_PASSWORD_SCHEME "$")) != 0)
+    {
+        return false;
+    }
+
+    // Split "S1$<iterations>$<salt hex>$<key hex>"
+    const char *fields = storedHash + strlen(NVS_PASSWORD_SCHEME "$");
+    char *end = nullptr;
+    unsigned long iterations = strtoul(fields, &end, 10);
+    if (end == fields || *end != '$' || iterations == 0 || iterations > NVS_PASSWORD_ITERATIONS_MAX)
+    {
+        return false;
+    }
+
+    const char *saltHex = end + 1;
+    const char *keyHex = strchr(saltHex, '$');
+    if (keyHex == nullptr)
+    {
+        return false;
+    }
+
+    uint8_t salt[NVS_PASSWORD_SALT_BYTES];
+    uint8_t storedKey[NVS_PASSWORD_KEY_BYTES];
+    if (!hexToBytes(saltHex, keyHex - saltHex, salt, sizeof(salt)) ||
+        !hexToBytes(keyHex + 1, strlen(keyHex + 1), storedKey, sizeof(storedKey)))
+    {
+        return false;
+    }
+
+    uint8_t key[NVS_PASSWORD_KEY_BYTES];
+    if (!derivePasswordKey(password, salt, sizeof(salt), iterations, key))
+    {
+        return false;
+    }
+
+    return constantTimeEquals(key, storedKey, sizeof(key));
 }
 
 /**
@@ -626,8 +873,66 @@ bool EARS_nvsEeprom::verifyPassword(const String &password)
  */
 bool EARS_nvsEeprom::hasPassword()
 {
-    String hash = getPasswordHash();
-    return (hash.length() > 0);
+    ensureShadow();
+
+    return (_shadow.passwordHash[0] != '\0');
+}
+
+/**
+ * @brief Derive a password key with PBKDF2-HMAC-SHA256
+ *
+ * @details mbedtls routes SHA-256 through the ESP32-S3 SHA peripheral, so the
+ *          cost is fixed by the iteration count rather than CPU load.
+ *
+ * @param password Plain text password
+ * @param salt Salt bytes
+ * @param saltLength Salt length in bytes
+ * @param iterations PBKDF2 iteration count
+ * @param key Output, NVS_PASSWORD_KEY_BYTES long
+ * @return true if the key was derived
+ */
+bool EARS_nvsEeprom::derivePasswordKey(const String &password, const uint8_t *salt, size_t saltLength,
+                                       uint32_t iterations, uint8_t *key)
+{
+    const mbedtls_md_info_t *info = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+    if (info == nullptr)
+    {
+        return false;
+    }
+
+    mbedtls_md_context_t ctx;
+    mbedtls_md_init(&ctx);
+
+    int ret = mbedtls_md_setup(&ctx, info, 1);
+    if (ret == 0)
+    {
+        ret = mbedtls_pkcs5_pbkdf2_hmac(&ctx,
+                                        (const unsigned char *)password.c_str(), password.length(),
+                                        salt, saltLength, iterations,
+                                        NVS_PASSWORD_KEY_BYTES, key);
+    }
+
+    mbedtls_md_free(&ctx);
+
+    return (ret == 0);
+}
+
+/**
+ * @brief Put a password hash into the shadow and commit it with the CRC
+ * @param passwordHash Stored form of the hash
+ * @return true if successful
+ */
+bool EARS_nvsEeprom::storePasswordHash(const String &passwordHash)
+{
+    ensureShadow();
+
+    portENTER_CRITICAL(&_shadowLock);
+    passwordHash.toCharArray(_shadow.passwordHash, sizeof(_shadow.passwordHash));
+    portEXIT_CRITICAL(&_shadowLock);
+    markDirty(FIELD_PASSWORD);
+
+    // Update overall CRC and commit both
+    return updateNVSCRC();
 }
 
 /******************************************************************************
@@ -636,55 +941,43 @@ bool EARS_nvsEeprom::hasPassword()
 
 /**
  * @brief Get backlight value (0-100)
+ * @details Served from the RAM shadow, safe to call every frame.
  * @return uint8_t Backlight brightness (0-100)
  */
 uint8_t EARS_nvsEeprom::getBacklightValue()
 {
-    if (!Preferences::begin(NAMESPACE, true))
-    {
-        return 100; // Default to full brightness
-    }
-
-    uint8_t value = getUChar(KEY_BACKLIGHT, 100);
-    end();
+    ensureShadow();
 
-    // Ensure in valid range
-    if (value > 100)
-    {
-        value = 100;
-    }
-
-    return value;
+    // Range checked when loaded and when set
+    return _shadow.backlight;
 }
 
 /**
  * @brief Set backlight value (0-100)
  * @param value Brightness level (0-100)
- * @return true if successful
+ * @return true if accepted
+ *
+ * @note Not CRC protected. The change is committed by service() once the
+ *       value has been stable for NVS_COMMIT_DELAY_MS, so a slider can call
+ *       this every frame without wearing flash.
  */
 bool EARS_nvsEeprom::setBacklightValue(uint8_t value)
 {
     // Constrain to valid range
-    if (value > 100)
-    {
-        value = 100;
-    }
-
-    if (!Preferences::begin(NAMESPACE, false))
+    if (value > EARS_NVSKeys::Backlight::maxValue)
     {
-        return false;
+        value = EARS_NVSKeys::Backlight::maxValue;
     }
 
-    size_t result = putUChar(KEY_BACKLIGHT, value);
-    end();
+    ensureShadow();
 
-    if (result == 0)
+    if (_shadow.backlight != value)
     {
-        return false;
+        _shadow.backlight = value;
+        markDirty(FIELD_BACKLIGHT);
     }
 
-    // Update CRC after successful write
-    return updateNVSCRC();
+    return true;
 }
 
 /**
@@ -709,19 +1002,17 @@ uint8_t EARS_nvsEeprom::getBacklightPWM()
  */
 bool EARS_nvsEeprom::initializeNVS()
 {
-    // Set default version
-    if (!setNVSVersion(CURRENT_VERSION))
-    {
-        return false;
-    }
+    ensureShadow();
 
-    // Set default backlight (100%)
-    if (!setBacklightValue(100))
-    {
-        return false;
-    }
+    // Set default version and backlight (100%)
+    portENTER_CRITICAL(&_shadowLock);
+    _shadow.version = CURRENT_VERSION;
+    _shadow.hasVersion = true;
+    _shadow.backlight = EARS_NVSKeys::Backlight::defaultValue;
+    portEXIT_CRITICAL(&_shadowLock);
+    markDirty(FIELD_VERSION | FIELD_BACKLIGHT);
 
-    // Calculate and store initial CRC (with no ZapNumber or Password)
+    // Calculate initial CRC (with no ZapNumber or Password) and commit all
     return updateNVSCRC();
 }
 
@@ -731,15 +1022,9 @@ bool EARS_nvsEeprom::initializeNVS()
  */
 bool EARS_nvsEeprom::isInitialized()
 {
-    if (!Preferences::begin(NAMESPACE, true))
-    {
-        return false;
-    }
-
-    bool exists = isKey(KEY_VERSION);
-    end();
+    ensureShadow();
 
-    return exists;
+    return _shadow.hasVersion;
 }
 
 /**
@@ -748,14 +1033,29 @@ bool EARS_nvsEeprom::isInitialized()
  */
 bool EARS_nvsEeprom::factoryReset()
 {
+    lockFlash();
+
     if (!Preferences::begin(NAMESPACE, false))
     {
+        unlockFlash();
         return false;
     }
 
     bool result = clear();
     end();
 
+    // Shadow now mirrors the empty namespace
+    if (result)
+    {
+        portENTER_CRITICAL(&_shadowLock);
+        resetShadow(_shadow);
+        _shadow.present = true;
+        _dirty = 0;
+        portEXIT_CRITICAL(&_shadowLock);
+    }
+
+    unlockFlash();
+
     return result;
 }
 
@@ -769,7 +1069,7 @@ bool EARS_nvsEeprom::factoryReset()
  *
  * @details
  * This function orchestrates the complete 5-step NVS initialization:
- * 1. Initialize NVS flash
+ * 1. Initialize NVS flash and load the RAM shadow
  * 2. Check if NVS is initialized (first boot detection)
  * 3. Validate ZapNumber exists and is valid format
  * 4. Check if password exists
@@ -795,6 +1095,9 @@ NVSValidationResult EARS_nvsEeprom::performFullInitialization()
         return result;
     }
 
+    // Load the RAM shadow - the only full read of the namespace
+    loadShadow();
+
     // ========================================================================
     // STEP 2: Check if NVS is initialized (first boot?)
     // ========================================================================
@@ -864,6 +1167,294 @@ NVSValidationResult EARS_nvsEeprom::performFullInitialization()
     return result;
 }
 
+/******************************************************************************
+ * RAM Shadow
+ *****************************************************************************/
+
+/**
+ * @brief Load the RAM shadow from the EARS namespace
+ * @return true if the namespace was read
+ *
+ * @details
+ * Reads every shadowed key in one read-only session and discards any
+ * uncommitted changes. A missing namespace (first boot) loads defaults.
+ */
+bool EARS_nvsEeprom::loadShadow()
+{
+    lockFlash();
+
+    // Defaults for keys that are not stored yet
+    NVSShadow shadow;
+    resetShadow(shadow);
+
+    bool opened = Preferences::begin(NAMESPACE, true);
+    if (opened)
+    {
+        shadow.present = true;
+
+        // setNVSVersion() stores a hex string, older upgrades a u16
+        switch (getType(KEY_VERSION))
+        {
+        case PT_STR:
+            shadow.version = (uint16_t)strtol(getString(KEY_VERSION, "00").c_str(), NULL, 16);
+            shadow.hasVersion = true;
+            break;
+        case PT_U16:
+            shadow.version = getUShort(KEY_VERSION, EARS_NVSKeys::Version::defaultValue);
+            shadow.hasVersion = true;
+            break;
+        default:
+            break;
+        }
+
+        if (isKey(KEY_ZAPNUMBER))
+        {
+            getString(KEY_ZAPNUMBER, shadow.zapNumber, sizeof(shadow.zapNumber));
+        }
+        if (isKey(KEY_PASSWORD_HASH))
+        {
+            getString(KEY_PASSWORD_HASH, shadow.passwordHash, sizeof(shadow.passwordHash));
+        }
+
+        shadow.backlight = getUChar(KEY_BACKLIGHT, EARS_NVSKeys::Backlight::defaultValue);
+        if (shadow.backlight > EARS_NVSKeys::Backlight::maxValue)
+        {
+            shadow.backlight = EARS_NVSKeys::Backlight::maxValue;
+        }
+
+        shadow.storedCRC = getUInt(KEY_NVS_CRC, EARS_NVSKeys::NvsCrc::defaultValue);
+        end();
+    }
+
+    refreshCRC(shadow, FIELD_PROTECTED);
+
+    portENTER_CRITICAL(&_shadowLock);
+    _shadow = shadow;
+    _dirty = 0;
+    portEXIT_CRITICAL(&_shadowLock);
+
+    unlockFlash();
+
+    return opened;
+}
+
+/**
+ * @brief Write all dirty shadow fields back in one Preferences session
+ * @return true if nothing was dirty or every write succeeded
+ *
+ * @note Fields that fail to write stay dirty and are retried next commit.
+ */
+bool EARS_nvsEeprom::commit()
+{
+    lockFlash();
+
+    portENTER_CRITICAL(&_shadowLock);
+    uint8_t fields = _dirty;
+    NVSShadow shadow = _shadow;
+    _dirty = 0;
+    portEXIT_CRITICAL(&_shadowLock);
+
+    if (fields == 0)
+    {
+        unlockFlash();
+        return true;
+    }
+
+    if (!Preferences::begin(NAMESPACE, false))
+    {
+        markDirty(fields);
+        unlockFlash();
+        return false;
+    }
+
+    uint8_t failed = writeFields(fields, shadow);
+
+    end();
+    unlockFlash();
+
+    if (failed != fields)
+    {
+        using_eventbus().post(EVENT_NVS_COMMIT, fields & ~failed);
+    }
+
+    return (failed == 0);
+}
+
+/**
+ * @brief Write shadow fields into the open read-write session
+ *
+ * @param fields ShadowField bit mask to write
+ * @param shadow Snapshot to write from
+ * @return uint8_t Fields that failed (marked dirty again for a retry)
+ */
+uint8_t EARS_nvsEeprom::writeFields(uint8_t fields, const NVSShadow &shadow)
+{
+    uint8_t failed = 0;
+
+    if (fields & FIELD_VERSION)
+    {
+        char hexStr[3];
+        sprintf(hexStr, "%02X", shadow.version);
+
+        // Replace a legacy u16 entry rather than keeping two types
+        if (getType(KEY_VERSION) != PT_STR)
+        {
+            remove(KEY_VERSION);
+        }
+        if (putString(KEY_VERSION, hexStr) == 0)
+        {
+            failed |= FIELD_VERSION;
+        }
+    }
+
+    if ((fields & FIELD_ZAPNUMBER) && putString(KEY_ZAPNUMBER, shadow.zapNumber) == 0)
+    {
+        failed |= FIELD_ZAPNUMBER;
+    }
+
+    if ((fields & FIELD_PASSWORD) && putString(KEY_PASSWORD_HASH, shadow.passwordHash) == 0)
+    {
+        failed |= FIELD_PASSWORD;
+    }
+
+    if ((fields & FIELD_BACKLIGHT) && putUChar(KEY_BACKLIGHT, shadow.backlight) == 0)
+    {
+        failed |= FIELD_BACKLIGHT;
+    }
+
+    if ((fields & FIELD_CRC) && putUInt(KEY_NVS_CRC, shadow.storedCRC) == 0)
+    {
+        failed |= FIELD_CRC;
+    }
+
+    portENTER_CRITICAL(&_shadowLock);
+    _shadow.present = true;
+    _dirty |= failed;
+    portEXIT_CRITICAL(&_shadowLock);
+
+    return failed;
+}
+
+/**
+ * @brief Commit deferred changes once they have settled
+ *
+ * @details Call periodically from a background task (Core 1 loop).
+ */
+void EARS_nvsEeprom::service()
+{
+    if (_dirty != 0 && (millis() - _lastChangeMs) >= NVS_COMMIT_DELAY_MS)
+    {
+        commit();
+    }
+}
+
+/**
+ * @brief Check for uncommitted shadow changes
+ * @return true if any field is waiting for commit()
+ */
+bool EARS_nvsEeprom::isDirty()
+{
+    return (_dirty != 0);
+}
+
+/**
+ * @brief Load the shadow on first use
+ */
+void EARS_nvsEeprom::ensureShadow()
+{
+    if (!_shadow.loaded)
+    {
+        loadShadow();
+    }
+}
+
+/**
+ * @brief Set a shadow to first-boot defaults
+ * @param shadow Shadow to reset (hold _shadowLock if it is _shadow)
+ */
+void EARS_nvsEeprom::resetShadow(NVSShadow &shadow)
+{
+    memset(&shadow, 0, sizeof(shadow));
+    shadow.loaded = true;
+    shadow.version = EARS_NVSKeys::Version::defaultValue;
+    shadow.backlight = EARS_NVSKeys::Backlight::defaultValue;
+    shadow.storedCRC = EARS_NVSKeys::NvsCrc::defaultValue;
+    refreshCRC(shadow, FIELD_PROTECTED);
+}
+
+/**
+ * @brief Update the CRC words of changed protected fields
+ *
+ * @details Only the changed fields are rehashed, then the 12-byte word
+ *          array, all through the ROM crc32_le.
+ *
+ * @param shadow Shadow to update (hold _shadowLock if it is _shadow)
+ * @param fields ShadowField bit mask of changed fields
+ */
+void EARS_nvsEeprom::refreshCRC(NVSShadow &shadow, uint8_t fields)
+{
+    if (fields & FIELD_VERSION)
+    {
+        uint8_t version[2] = {(uint8_t)(shadow.version & 0xFF), (uint8_t)(shadow.version >> 8)};
+        shadow.fieldCRC[EARS_NVSKeys::SLOT_VERSION] = esp_rom_crc32_le(0, version, sizeof(version));
+    }
+
+    if (fields & FIELD_ZAPNUMBER)
+    {
+        shadow.fieldCRC[EARS_NVSKeys::SLOT_ZAPNUMBER] = esp_rom_crc32_le(0, (const uint8_t *)shadow.zapNumber, strlen(shadow.zapNumber));
+    }
+
+    if (fields & FIELD_PASSWORD)
+    {
+        shadow.fieldCRC[EARS_NVSKeys::SLOT_PASSWORD_HASH] = esp_rom_crc32_le(0, (const uint8_t *)shadow.passwordHash, strlen(shadow.passwordHash));
+    }
+
+    shadow.liveCRC = esp_rom_crc32_le(0, (const uint8_t *)shadow.fieldCRC, sizeof(shadow.fieldCRC));
+}
+
+/**
+ * @brief Mark shadow fields for the next commit
+ * @param fields ShadowField bit mask
+ */
+void EARS_nvsEeprom::markDirty(uint8_t fields)
+{
+    portENTER_CRITICAL(&_shadowLock);
+    if (fields & FIELD_PROTECTED)
+    {
+        refreshCRC(_shadow, fields & FIELD_PROTECTED);
+    }
+    _dirty |= fields;
+    _lastChangeMs = millis();
+    portEXIT_CRITICAL(&_shadowLock);
+}
+
+/**
+ * @brief Registry read of the stored CRC
+ * @return uint32_t CRC as last loaded or committed
+ */
+uint32_t EARS_nvsEeprom::read(EARS_NVSKeys::NvsCrc)
+{
+    ensureShadow();
+
+    portENTER_CRITICAL(&_shadowLock);
+    uint32_t crc = _shadow.storedCRC;
+    portEXIT_CRITICAL(&_shadowLock);
+
+    return crc;
+}
+
+void EARS_nvsEeprom::lockFlash()
+{
+    if (_flashMutex)
+        xSemaphoreTake(_flashMutex, portMAX_DELAY);
+}
+
+void EARS_nvsEeprom::unlockFlash()
+{
+    if (_flashMutex)
+        xSemaphoreGive(_flashMutex);
+}
+
 /******************************************************************************
  * Library Version Information Getters
  *****************************************************************************/
@@ -2,8 +2,8 @@
  * @file EARS_nvsEepromLib.h
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief NVS EEPROM wrapper class header
- * @version 2.0.0
- * @date 20260210
+ * @version 2.7.1
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -20,7 +20,15 @@
 #include <Arduino.h>
 #include <nvs.h>
 #include <nvs_flash.h>
+#include <esp_rom_crc.h>
+#include <esp_random.h>
+#include <mbedtls/md.h>
+#include <mbedtls/pkcs5.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 #include "EARS_systemDef.h"
+#include "EARS_nvsKeys.h"
+#include "EARS_eventBusLib.h"
 
 /******************************************************************************
  * Library Version Information
@@ -29,11 +37,31 @@ namespace EARS_NVSEeprom
 {
     constexpr const char* LIB_NAME = "EARS_nvsEeprom";
     constexpr const char* VERSION_MAJOR = "2";
-    constexpr const char* VERSION_MINOR = "0";
-    constexpr const char* VERSION_PATCH = "0";
-    constexpr const char* VERSION_DATE = "2026-02-10";
+    constexpr const char* VERSION_MINOR = "7";
+    constexpr const char* VERSION_PATCH = "1";
+    constexpr const char* VERSION_DATE = "2026-10-15";
 }
 
+/******************************************************************************
+ * RAM Shadow Configuration
+ *****************************************************************************/
+
+// Quiet time after the last deferred change before service() commits it
+#define NVS_COMMIT_DELAY_MS 2000
+
+/******************************************************************************
+ * Password Hash Configuration
+ *****************************************************************************/
+
+// Stored form: "S1$<iterations>$<salt hex>$<key hex>"
+#define NVS_PASSWORD_SCHEME "S1"
+
+// PBKDF2-HMAC-SHA256 parameters (SHA runs on the ESP32-S3 peripheral)
+#define NVS_PASSWORD_ITERATIONS 1000
+#define NVS_PASSWORD_ITERATIONS_MAX 100000 // A stored count above this is not a valid hash
+#define NVS_PASSWORD_SALT_BYTES 16
+#define NVS_PASSWORD_KEY_BYTES 32
+
 
 /******************************************************************************
  * Validation Status Enum
@@ -93,7 +121,15 @@ struct NVSValidationResult
  * @brief NVS EEPROM wrapper class.
  *
  * @details
- * All NVS key names are defined in EARS_systemDef.h
+ * All NVS key names are defined in EARS_systemDef.h and registered with
+ * their type, default and shadow slot in EARS_nvsKeys.h
+ *
+ * The EARS namespace is mirrored in a RAM shadow that is loaded once by
+ * performFullInitialization(). Getters are served from RAM. Setters update
+ * the shadow and mark fields dirty; dirty fields are written back in a
+ * single Preferences session by commit(). Protected data (version,
+ * ZapNumber, password) commits immediately together with its CRC, the
+ * backlight is committed by service() once it has settled.
  */
 class EARS_nvsEeprom : public Preferences
 {
@@ -150,6 +186,10 @@ public:
     bool verifyPassword(const String &password);
     bool hasPassword();
 
+    // Hashing alone, for secrets kept outside the EARS namespace (lock PIN)
+    static String makePasswordHash(const String &password);
+    static bool verifyPasswordHash(const String &password, const char *storedHash);
+
     // Backlight management
     uint8_t getBacklightValue();
     bool setBacklightValue(uint8_t value);
@@ -168,9 +208,100 @@ public:
     // High-level initialization orchestration - DEBLOAT Step 4
     NVSValidationResult performFullInitialization();
 
+    // RAM shadow - loaded once, dirty fields written back in one commit
+    bool loadShadow();
+    bool commit();
+    void service();
+    bool isDirty();
+
+    // Typed access through the key registry, e.g. get<EARS_NVSKeys::Backlight>()
+    template <typename K>
+    typename K::type get()
+    {
+        return read(K());
+    }
+
+    template <typename K>
+    bool set(const typename K::type &value)
+    {
+        return write(K(), value);
+    }
+
 private:
+    // Dirty flags for the shadow fields
+    enum ShadowField : uint8_t
+    {
+        FIELD_VERSION = EARS_NVSKeys::Version::field,
+        FIELD_ZAPNUMBER = EARS_NVSKeys::ZapNumber::field,
+        FIELD_PASSWORD = EARS_NVSKeys::PasswordHash::field,
+        FIELD_BACKLIGHT = EARS_NVSKeys::Backlight::field,
+        FIELD_CRC = EARS_NVSKeys::NvsCrc::field,
+        FIELD_PROTECTED = FIELD_VERSION | FIELD_ZAPNUMBER | FIELD_PASSWORD
+    };
+
+    // RAM copy of the EARS namespace
+    struct NVSShadow
+    {
+        bool loaded;     // loadShadow() has run
+        bool present;    // Namespace exists on flash
+        bool hasVersion; // KEY_VERSION stored (NVS initialized)
+        uint16_t version;
+        char zapNumber[EARS_NVSKeys::ZapNumber::size];
+        char passwordHash[EARS_NVSKeys::PasswordHash::size];
+        uint8_t backlight;
+        uint32_t storedCRC;
+        uint32_t fieldCRC[3]; // Per-field CRC32, indexed by slot
+        uint32_t liveCRC;     // CRC32 over fieldCRC[], kept current
+    };
+
+    // Migration step: upgrades fromVersion to fromVersion + 1. Runs inside
+    // the open read-write session and stages changes in the shadow.
+    typedef bool (*MigrationStep)(EARS_nvsEeprom &nvs);
+
+    struct NVSMigration
+    {
+        uint16_t fromVersion;
+        MigrationStep step;
+    };
+
+    // Registered steps, see EARS_nvsEepromLib.cpp
+    static const NVSMigration MIGRATIONS[];
+    static const size_t MIGRATION_COUNT;
+
+    static_assert(EARS_NVSKeys::SLOT_COUNT <= 8, "Dirty mask holds one bit per slot");
+    static_assert(EARS_NVSKeys::SLOT_PASSWORD_HASH < 3, "Protected keys need a CRC word");
+
+    NVSShadow _shadow;
+    uint8_t _dirty;
+    uint32_t _lastChangeMs;
+    portMUX_TYPE _shadowLock;       // Guards _shadow and _dirty (RAM only)
+    SemaphoreHandle_t _flashMutex;  // Serialises Preferences sessions
+
     uint32_t calculateCRC32(const uint8_t *data, size_t length);
     bool upgradeNVS(uint16_t fromVersion, uint16_t toVersion);
+    static bool migrateV0toV1(EARS_nvsEeprom &nvs);
+    uint8_t writeFields(uint8_t fields, const NVSShadow &shadow);
+    void ensureShadow();
+    static void resetShadow(NVSShadow &shadow);
+    static void refreshCRC(NVSShadow &shadow, uint8_t fields);
+    uint32_t calculateLegacyNVSCRC(uint16_t version);
+    static bool derivePasswordKey(const String &password, const uint8_t *salt, size_t saltLength,
+                                  uint32_t iterations, uint8_t *key);
+    bool storePasswordHash(const String &passwordHash);
+    void markDirty(uint8_t fields);
+    void lockFlash();
+    void unlockFlash();
+
+    // Registry dispatch - a key without an overload is read-only or unknown
+    uint16_t read(EARS_NVSKeys::Version) { return getNVSVersionInt(); }
+    String read(EARS_NVSKeys::ZapNumber) { return getZapNumber(); }
+    String read(EARS_NVSKeys::PasswordHash) { return getPasswordHash(); }
+    uint8_t read(EARS_NVSKeys::Backlight) { return getBacklightValue(); }
+    uint32_t read(EARS_NVSKeys::NvsCrc);
+
+    bool write(EARS_NVSKeys::Version, uint16_t value) { return setNVSVersion(value); }
+    bool write(EARS_NVSKeys::ZapNumber, const String &value) { return setZapNumber(value); }
+    bool write(EARS_NVSKeys::Backlight, uint8_t value) { return setBacklightValue(value); }
 };
 
 // Global instance access function (Singleton pattern)
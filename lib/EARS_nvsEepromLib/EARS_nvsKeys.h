@@ -0,0 +1,104 @@
+/**
+ * @file EARS_nvsKeys.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Compile-time registry of the EARS NVS keys
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @details
+ * Each key is a type that carries its NVS name, value type, default value,
+ * storage size and RAM shadow slot. EARS_nvsEeprom::get<Key>() and
+ * set<Key>() resolve at compile time to a shadow access, so a wrong value
+ * type or a write to a read-only key fails to compile. The key strings are
+ * only handed to NVS when the shadow is loaded or committed.
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_NVS_KEYS_H__
+#define __EARS_NVS_KEYS_H__
+
+/******************************************************************************
+ * Includes Information
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_systemDef.h"
+
+/******************************************************************************
+ * Key Storage Configuration
+ *****************************************************************************/
+
+// Longest password hash the shadow can hold (characters)
+#define NVS_PASSWORD_HASH_MAX 112
+
+/******************************************************************************
+ * Key Registry
+ *****************************************************************************/
+namespace EARS_NVSKeys
+{
+    // Shadow slot - also the dirty flag bit and the CRC word index
+    enum Slot : uint8_t
+    {
+        SLOT_VERSION = 0,
+        SLOT_ZAPNUMBER = 1,
+        SLOT_PASSWORD_HASH = 2,
+        SLOT_BACKLIGHT = 3,
+        SLOT_NVS_CRC = 4,
+        SLOT_COUNT = 5
+    };
+
+    /**
+     * @struct Key
+     * @brief Traits shared by every registered key
+     *
+     * @details T is the accessor type, StorageSize the bytes the shadow
+     *          reserves for the value.
+     */
+    template <typename T, Slot S, size_t StorageSize>
+    struct Key
+    {
+        typedef T type;
+        static constexpr Slot slot = S;
+        static constexpr uint8_t field = (uint8_t)(1 << S);
+        static constexpr size_t size = StorageSize;
+    };
+
+    // NVS structure version, stored as a 2-digit hex string
+    struct Version : Key<uint16_t, SLOT_VERSION, sizeof(uint16_t)>
+    {
+        static constexpr const char *name = EARS_Internal::NVS::VERSION_CODE_STR;
+        static constexpr uint16_t defaultValue = 0;
+    };
+
+    // ZapNumber, format AANNNN
+    struct ZapNumber : Key<String, SLOT_ZAPNUMBER, 7>
+    {
+        static constexpr const char *name = EARS_Internal::NVS::ZAPCODE_STR;
+        static constexpr const char *defaultValue = "";
+    };
+
+    // Password hash (read-only, written through setPassword())
+    struct PasswordHash : Key<String, SLOT_PASSWORD_HASH, NVS_PASSWORD_HASH_MAX + 1>
+    {
+        static constexpr const char *name = EARS_Internal::NVS::PASSWORD_HASH_STR;
+        static constexpr const char *defaultValue = "";
+    };
+
+    // Backlight brightness, 0-100
+    struct Backlight : Key<uint8_t, SLOT_BACKLIGHT, sizeof(uint8_t)>
+    {
+        static constexpr const char *name = EARS_Internal::NVS::BACKLIGHT_VALUE_STR;
+        static constexpr uint8_t defaultValue = 100;
+        static constexpr uint8_t maxValue = 100;
+    };
+
+    // Stored integrity CRC (read-only, written through updateNVSCRC())
+    struct NvsCrc : Key<uint32_t, SLOT_NVS_CRC, sizeof(uint32_t)>
+    {
+        static constexpr const char *name = EARS_Internal::NVS::CRC32_STR;
+        static constexpr uint32_t defaultValue = 0;
+    };
+}
+
+#endif // __EARS_NVS_KEYS_H__
@@ -0,0 +1,654 @@
+/**
+ * @file EARS_otaLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Over-the-air firmware and asset pack updates
+ * @version 1.0.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EARS_otaLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_eventBusLib.h"
+#include <esp_ota_ops.h>
+#include <esp_heap_caps.h>
+#include <mbedtls/md.h>
+
+/******************************************************************************
+ * Partitions
+ *****************************************************************************/
+
+// The asset pack partition and format, as MAIN_assetPackLib
+#define OTA_ASSETS_LABEL "assets"
+#define OTA_ASSETS_SUBTYPE 0x40
+#define OTA_ASSETS_MAGIC "EARSPAK1"
+
+#define OTA_STAGE_MAGIC 0x31475453 // "STG1"
+
+// Last sector of the inactive app slot: an asset pack waiting to be copied
+struct StageRecord
+{
+    uint32_t magic;
+    uint32_t size;          // Pack bytes from the start of the slot
+    uint8_t digest[32];     // SHA-256 of those bytes
+};
+
+/******************************************************************************
+ * Helpers
+ *****************************************************************************/
+
+// SHA-256 through mbedtls, which uses the SHA peripheral
+static bool shaBegin(mbedtls_md_context_t* ctx)
+{
+    mbedtls_md_init(ctx);
+    const mbedtls_md_info_t* info = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+    return info && mbedtls_md_setup(ctx, info, 0) == 0 && mbedtls_md_starts(ctx) == 0;
+}
+
+static bool shaEnd(mbedtls_md_context_t* ctx, uint8_t* digest)
+{
+    bool ok = mbedtls_md_finish(ctx, digest) == 0;
+    mbedtls_md_free(ctx);
+    return ok;
+}
+
+// Digest of the first size bytes of a partition
+static bool hashPartition(const esp_partition_t* partition, uint32_t size, uint8_t* buffer, uint8_t* digest)
+{
+    mbedtls_md_context_t sha;
+    bool ok = shaBegin(&sha);
+    for (uint32_t offset = 0; ok && offset < size; offset += OTA_CHUNK_SIZE)
+    {
+        uint32_t length = size - offset < OTA_CHUNK_SIZE ? size - offset : OTA_CHUNK_SIZE;
+        ok = esp_partition_read(partition, offset, buffer, length) == ESP_OK &&
+             mbedtls_md_update(&sha, buffer, length) == 0;
+    }
+    return shaEnd(&sha, digest) && ok;
+}
+
+static uint32_t sectorAlign(uint32_t size)
+{
+    return (size + SPI_FLASH_SEC_SIZE - 1) & ~(SPI_FLASH_SEC_SIZE - 1);
+}
+
+/******************************************************************************
+ * Construction
+ *****************************************************************************/
+EARS_ota::EARS_ota()
+    : _sdCard(nullptr),
+      _task(nullptr),
+      _buffer(nullptr),
+      _cancel(false)
+{
+    memset(&_request, 0, sizeof(_request));
+    memset(&_status, 0, sizeof(_status));
+    _mux = portMUX_INITIALIZER_UNLOCKED;
+}
+
+bool EARS_ota::begin(EARS_sdCard* sdCard)
+{
+    if (_task)
+    {
+        return true;
+    }
+    _sdCard = sdCard;
+
+    // Internal RAM: flash writes cannot read PSRAM with the cache off
+    _buffer = (uint8_t *)heap_caps_malloc(OTA_CHUNK_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!_buffer)
+    {
+        return false;
+    }
+
+    _http.setTimeout(OTA_HTTP_TIMEOUT_MS);
+
+    if (xTaskCreatePinnedToCore(taskFunction, "OTA", OTA_TASK_STACK_SIZE, this, OTA_TASK_PRIORITY, &_task,
+                                OTA_TASK_CORE) != pdPASS)
+    {
+        _task = nullptr;
+        heap_caps_free(_buffer);
+        _buffer = nullptr;
+#if EARS_DEBUG == 1
+        Serial.println("[OTA] ERROR: Failed to create OTA task");
+#endif
+        return false;
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Control
+ *****************************************************************************/
+bool EARS_ota::requestUpdate(EARS_otaTarget target, const char* source, const char* sha256Hex)
+{
+    if (!_task || !source || strlen(source) >= OTA_SOURCE_SIZE)
+    {
+        return false;
+    }
+
+    Request request;
+    request.target = target;
+    request.hasDigest = sha256Hex != nullptr;
+    strncpy(request.source, source, sizeof(request.source));
+    if (request.hasDigest && !parseDigest(sha256Hex, request.digest))
+    {
+        return false;
+    }
+
+    bool accepted = false;
+    portENTER_CRITICAL(&_mux);
+    if (_status.state != OTA_CONNECTING && _status.state != OTA_WRITING && _status.state != OTA_VERIFYING)
+    {
+        _request = request;
+        _status.state = OTA_CONNECTING;
+        _status.target = target;
+        _status.error = OTA_OK;
+        _status.percent = 0;
+        _status.written = 0;
+        _status.total = 0;
+        _cancel = false;
+        accepted = true;
+    }
+    portEXIT_CRITICAL(&_mux);
+
+    if (accepted)
+    {
+        xTaskNotifyGive(_task);
+    }
+    return accepted;
+}
+
+void EARS_ota::cancel()
+{
+    _cancel = true;
+}
+
+EARS_otaStatus EARS_ota::getStatus() const
+{
+    portENTER_CRITICAL(&_mux);
+    EARS_otaStatus status = _status;
+    portEXIT_CRITICAL(&_mux);
+    return status;
+}
+
+void EARS_ota::setProgress(EARS_otaState state, uint32_t written, uint32_t total)
+{
+    uint8_t percent = total ? (uint8_t)((uint64_t)written * 100 / total) : 0;
+
+    portENTER_CRITICAL(&_mux);
+    bool changed = percent != _status.percent;
+    _status.state = state;
+    _status.percent = percent;
+    _status.written = written;
+    _status.total = total;
+    EARS_otaTarget target = _status.target;
+    portEXIT_CRITICAL(&_mux);
+
+    if (changed)
+    {
+        using_eventbus().post(EVENT_OTA_PROGRESS, OTA_EVENT_VALUE(target, percent));
+    }
+}
+
+void EARS_ota::finish(EARS_otaTarget target, EARS_otaError error)
+{
+    portENTER_CRITICAL(&_mux);
+    _status.error = error;
+    _status.state = error == OTA_OK ? OTA_READY : (error == OTA_ERR_CANCELLED ? OTA_IDLE : OTA_FAILED);
+    portEXIT_CRITICAL(&_mux);
+
+    using_eventbus().post(EVENT_OTA_DONE, OTA_EVENT_VALUE(target, error));
+
+#if EARS_DEBUG == 1
+    EARS_otaStatus status = getStatus();
+    Serial.printf("[OTA] %s: %s, %lu of %lu bytes (HTTP %d)\n",
+                  target == OTA_TARGET_FIRMWARE ? "Firmware" : "Assets",
+                  error == OTA_OK ? "ready, restart to apply" : "failed",
+                  (unsigned long)status.written, (unsigned long)status.total, status.lastHttpCode);
+#endif
+}
+
+/******************************************************************************
+ * Sources
+ *****************************************************************************/
+bool EARS_ota::isUrl(const char* source)
+{
+    return strncmp(source, "http://", 7) == 0;
+}
+
+// 64 hex digits; anything after them (sha256sum's file name) is ignored
+bool EARS_ota::parseDigest(const char* hex, uint8_t* digest)
+{
+    for (uint8_t i = 0; i < 64; i++)
+    {
+        char c = hex[i];
+        uint8_t nibble;
+        if (c >= '0' && c <= '9')
+        {
+            nibble = c - '0';
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            nibble = c - 'a' + 10;
+        }
+        else if (c >= 'A' && c <= 'F')
+        {
+            nibble = c - 'A' + 10;
+        }
+        else
+        {
+            return false;
+        }
+        digest[i / 2] = (i & 1) ? (digest[i / 2] | nibble) : (nibble << 4);
+    }
+    return true;
+}
+
+bool EARS_ota::readDigest(const char* source, uint8_t* digest)
+{
+    char path[OTA_SOURCE_SIZE + sizeof(OTA_DIGEST_SUFFIX)];
+    snprintf(path, sizeof(path), "%s%s", source, OTA_DIGEST_SUFFIX);
+
+    char text[80];
+    size_t length = 0;
+    if (isUrl(source))
+    {
+        if (_http.begin(_client, path) && _http.GET() == HTTP_CODE_OK)
+        {
+            length = _http.getStream().readBytes(text, sizeof(text) - 1);
+        }
+        _http.end();
+    }
+    else if (_sdCard && _sdCard->isAvailable())
+    {
+        length = _sdCard->readInto(path, (uint8_t *)text, sizeof(text) - 1);
+    }
+    text[length] = '\0';
+    return length >= 64 && parseDigest(text, digest);
+}
+
+EARS_otaError EARS_ota::openSource(const Request& request, uint32_t& size)
+{
+    size = 0;
+    if (isUrl(request.source))
+    {
+        int code = -1;
+        if (_http.begin(_client, request.source))
+        {
+            // HTTP/1.0: a Content-Length, never a chunked body
+            _http.useHTTP10(true);
+            code = _http.GET();
+        }
+
+        portENTER_CRITICAL(&_mux);
+        _status.lastHttpCode = code;
+        portEXIT_CRITICAL(&_mux);
+
+        if (code != HTTP_CODE_OK)
+        {
+            return OTA_ERR_SOURCE;
+        }
+        int length = _http.getSize();
+        size = length > 0 ? length : 0;
+        return OTA_OK;
+    }
+
+    if (!_sdCard || !_sdCard->isAvailable())
+    {
+        return OTA_ERR_SOURCE;
+    }
+    _file = _sdCard->openRead(request.source);
+    if (!_file)
+    {
+        return OTA_ERR_SOURCE;
+    }
+    size = _file.size();
+    return OTA_OK;
+}
+
+// Fill the buffer unless the stream ends or stalls
+size_t EARS_ota::readSource(uint8_t* buffer, size_t length)
+{
+    if (_file)
+    {
+        return _file.read(buffer, length);
+    }
+
+    WiFiClient& stream = _http.getStream();
+    size_t total = 0;
+    while (total < length)
+    {
+        size_t read = stream.readBytes(buffer + total, length - total);
+        if (read == 0)
+        {
+            break;
+        }
+        total += read;
+    }
+    return total;
+}
+
+void EARS_ota::closeSource()
+{
+    if (_file)
+    {
+        _file.close();
+    }
+    _http.end();
+}
+
+bool EARS_ota::connect(const EARS_configNetwork& network)
+{
+    if (WiFi.status() == WL_CONNECTED)
+    {
+        return true;
+    }
+    if (!network.wifiEnabled || network.ssid[0] == '\0')
+    {
+        return false;
+    }
+
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(network.ssid, network.password[0] != '\0' ? network.password : nullptr);
+
+    uint32_t startMs = millis();
+    while (WiFi.status() != WL_CONNECTED)
+    {
+        if (millis() - startMs > OTA_CONNECT_TIMEOUT_MS)
+        {
+#if EARS_DEBUG == 1
+            Serial.printf("[OTA] Could not join \"%s\"\n", network.ssid);
+#endif
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(100));
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Update
+ *****************************************************************************/
+const esp_partition_t* EARS_ota::assetsPartition()
+{
+    return esp_partition_find_first(ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)OTA_ASSETS_SUBTYPE,
+                                    OTA_ASSETS_LABEL);
+}
+
+EARS_otaError EARS_ota::update(Request& request)
+{
+    bool firmware = request.target == OTA_TARGET_FIRMWARE;
+    const esp_partition_t* slot = esp_ota_get_next_update_partition(NULL);
+    const esp_partition_t* assets = firmware ? nullptr : assetsPartition();
+    if (!slot || (!firmware && !assets))
+    {
+        return OTA_ERR_FLASH;
+    }
+
+    // The inactive slot would be overwritten under a firmware waiting to boot
+    if (!firmware && esp_ota_get_boot_partition() != esp_ota_get_running_partition())
+    {
+        return OTA_ERR_PENDING;
+    }
+
+    if (!request.hasDigest)
+    {
+        if (!readDigest(request.source, request.digest))
+        {
+            return OTA_ERR_DIGEST_MISSING;
+        }
+        request.hasDigest = true;
+    }
+
+    uint32_t size;
+    EARS_otaError error = openSource(request, size);
+    uint32_t recordOffset = slot->size - OTA_STAGE_RECORD_SIZE;
+    uint32_t limit = firmware ? slot->size : (assets->size < recordOffset ? assets->size : recordOffset);
+    if (error == OTA_OK && (size == 0 || size > limit))
+    {
+        error = OTA_ERR_SIZE;
+    }
+
+    // Whatever happens, the slot no longer holds a staged pack
+    esp_ota_handle_t handle = 0;
+    if (error == OTA_OK && esp_partition_erase_range(slot, recordOffset, OTA_STAGE_RECORD_SIZE) != ESP_OK)
+    {
+        error = OTA_ERR_FLASH;
+    }
+    if (error == OTA_OK)
+    {
+        esp_err_t result = firmware ? esp_ota_begin(slot, size, &handle)
+                                    : esp_partition_erase_range(slot, 0, sectorAlign(size));
+        if (result != ESP_OK)
+        {
+            error = OTA_ERR_FLASH;
+        }
+    }
+    if (error != OTA_OK)
+    {
+        closeSource();
+        return error;
+    }
+
+    mbedtls_md_context_t sha;
+    bool hashing = shaBegin(&sha);
+    uint32_t written = 0;
+    setProgress(OTA_WRITING, 0, size);
+
+    while (written < size)
+    {
+        if (_cancel)
+        {
+            error = OTA_ERR_CANCELLED;
+            break;
+        }
+
+        uint32_t want = size - written < OTA_CHUNK_SIZE ? size - written : OTA_CHUNK_SIZE;
+        size_t length = readSource(_buffer, want);
+        if (length == 0)
+        {
+            error = OTA_ERR_READ;
+            break;
+        }
+
+        hashing = hashing && mbedtls_md_update(&sha, _buffer, length) == 0;
+        esp_err_t result = firmware ? esp_ota_write(handle, _buffer, length)
+                                    : esp_partition_write(slot, written, _buffer, length);
+        if (result != ESP_OK)
+        {
+            error = OTA_ERR_FLASH;
+            break;
+        }
+
+        written += length;
+        setProgress(OTA_WRITING, written, size);
+    }
+    closeSource();
+
+    setProgress(OTA_VERIFYING, written, size);
+    uint8_t digest[32];
+    hashing = shaEnd(&sha, digest) && hashing;
+    if (error == OTA_OK && (!hashing || memcmp(digest, request.digest, sizeof(digest)) != 0))
+    {
+        error = OTA_ERR_DIGEST;
+    }
+
+    if (firmware)
+    {
+        if (error != OTA_OK)
+        {
+            esp_ota_abort(handle);
+        }
+        else if (esp_ota_end(handle) != ESP_OK)
+        {
+            error = OTA_ERR_IMAGE;
+        }
+        else if (esp_ota_set_boot_partition(slot) != ESP_OK)
+        {
+            error = OTA_ERR_FLASH;
+        }
+        return error;
+    }
+
+    if (error == OTA_OK)
+    {
+        char magic[8];
+        if (esp_partition_read(slot, 0, magic, sizeof(magic)) != ESP_OK ||
+            memcmp(magic, OTA_ASSETS_MAGIC, sizeof(magic)) != 0)
+        {
+            return OTA_ERR_IMAGE;
+        }
+
+        StageRecord record;
+        record.magic = OTA_STAGE_MAGIC;
+        record.size = size;
+        memcpy(record.digest, digest, sizeof(record.digest));
+        if (esp_partition_write(slot, recordOffset, &record, sizeof(record)) != ESP_OK)
+        {
+            error = OTA_ERR_FLASH;
+        }
+    }
+    return error;
+}
+
+bool EARS_ota::applyStagedAssets()
+{
+    const esp_partition_t* slot = esp_ota_get_next_update_partition(NULL);
+    const esp_partition_t* assets = assetsPartition();
+    if (!slot || !assets)
+    {
+        return false;
+    }
+
+    StageRecord record;
+    uint32_t recordOffset = slot->size - OTA_STAGE_RECORD_SIZE;
+    if (esp_partition_read(slot, recordOffset, &record, sizeof(record)) != ESP_OK ||
+        record.magic != OTA_STAGE_MAGIC || record.size == 0 || record.size > assets->size ||
+        record.size > recordOffset)
+    {
+        return false;
+    }
+
+    uint8_t* buffer = (uint8_t *)heap_caps_malloc(OTA_CHUNK_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!buffer)
+    {
+        return false;
+    }
+
+    // Staged copy first: a damaged one is dropped, not applied
+    uint8_t digest[32];
+    bool staged = hashPartition(slot, record.size, buffer, digest) &&
+                  memcmp(digest, record.digest, sizeof(digest)) == 0;
+
+    bool applied = false;
+    if (staged && esp_partition_erase_range(assets, 0, sectorAlign(record.size)) == ESP_OK)
+    {
+        applied = true;
+        for (uint32_t offset = 0; applied && offset < record.size; offset += OTA_CHUNK_SIZE)
+        {
+            uint32_t length = record.size - offset < OTA_CHUNK_SIZE ? record.size - offset : OTA_CHUNK_SIZE;
+            applied = esp_partition_read(slot, offset, buffer, length) == ESP_OK &&
+                      esp_partition_write(assets, offset, buffer, length) == ESP_OK;
+        }
+        applied = applied && hashPartition(assets, record.size, buffer, digest) &&
+                  memcmp(digest, record.digest, sizeof(digest)) == 0;
+    }
+
+    // A failed copy keeps the record and is tried again at the next boot
+    if (!staged || applied)
+    {
+        esp_partition_erase_range(slot, recordOffset, OTA_STAGE_RECORD_SIZE);
+    }
+    heap_caps_free(buffer);
+
+#if EARS_DEBUG == 1
+    Serial.printf("[OTA] Staged asset pack (%lu bytes) %s\n", (unsigned long)record.size,
+                  applied ? "applied" : (staged ? "copy failed, retried next boot" : "damaged, dropped"));
+#endif
+    return applied;
+}
+
+/******************************************************************************
+ * Task
+ *****************************************************************************/
+void EARS_ota::run()
+{
+    while (true)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        portENTER_CRITICAL(&_mux);
+        Request request = _request;
+        portEXIT_CRITICAL(&_mux);
+
+        // Copied: Core 1 may replace the section meanwhile
+        EARS_configNetwork network = using_config().network();
+        bool url = isUrl(request.source);
+        bool joined = url && WiFi.status() != WL_CONNECTED;
+
+        EARS_otaError error = OTA_OK;
+        if (url && !connect(network))
+        {
+            error = OTA_ERR_WIFI;
+        }
+        if (error == OTA_OK)
+        {
+            error = update(request);
+        }
+
+        // Radio off again unless it was up before (MQTT, sync) or stays up
+        if (joined && !network.autoConnect)
+        {
+            _client.stop();
+            WiFi.disconnect(true);
+            WiFi.mode(WIFI_OFF);
+        }
+
+        finish(request.target, error);
+    }
+}
+
+void EARS_ota::taskFunction(void* param)
+{
+    ((EARS_ota *)param)->run();
+}
+
+/******************************************************************************
+ * Version Information
+ *****************************************************************************/
+const char* EARS_ota::getLibraryName()
+{
+    return EARS_Ota::LIB_NAME;
+}
+
+uint32_t EARS_ota::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_Ota::VERSION_MAJOR,
+                       EARS_Ota::VERSION_MINOR,
+                       EARS_Ota::VERSION_PATCH);
+}
+
+const char* EARS_ota::getVersionDate()
+{
+    return EARS_Ota::VERSION_DATE;
+}
+
+void EARS_ota::getVersionString(char* buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+EARS_ota &using_ota()
+{
+    static EARS_ota instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_otaLib.cpp
+ ******************************************************************************/
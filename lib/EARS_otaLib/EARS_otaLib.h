@@ -0,0 +1,232 @@
+/**
+ * @file EARS_otaLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Over-the-air firmware and asset pack updates
+ * @details A low-priority task on Core 1 streams an image from an http://
+ *          URL or an SD card file in OTA_CHUNK_SIZE pieces, hashing each with
+ *          SHA-256 as it is written, so nothing larger than one chunk is ever
+ *          held in RAM. The expected digest is given with the request or read
+ *          from "<source>.sha256" (64 hex digits).
+ *
+ *          Firmware goes through esp_ota into the inactive app slot; once the
+ *          digest matches and esp_ota_end() accepts the image, that slot
+ *          boots at the next restart. The running firmware is untouched
+ *          until then, and the Arduino core marks the new one valid on boot.
+ *
+ *          An asset pack (scripts/build_asset_pack.py) cannot be written over
+ *          the mapped "assets" partition while the UI draws from it. It is
+ *          streamed into the inactive app slot instead, with a stage record
+ *          in the slot's last sector. applyStagedAssets(), called at boot
+ *          before MAIN_initialise_asset_pack(), checks the digest again,
+ *          copies the pack into place and clears the record; power lost
+ *          during the copy just repeats it. Firmware and assets share the
+ *          slot, so an asset update is refused while a firmware update waits
+ *          for its restart.
+ *
+ *          Progress goes out on the event bus: EVENT_OTA_PROGRESS for every
+ *          whole percent, EVENT_OTA_DONE at the end. Neither restarts the
+ *          unit; the UI decides when.
+ *
+ * @version 1.0.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_OTA_LIB_H__
+#define __EARS_OTA_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_partition.h>
+#include "EARS_versionDef.h"
+#include "EARS_taskPlanLib.h"
+#include "EARS_sdCardLib.h"
+#include "EARS_configLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_Ota
+{
+    constexpr const char* LIB_NAME = "EARS_ota";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "1";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+#define OTA_CHUNK_SIZE 4096             // Read, hash and write unit (internal RAM)
+#define OTA_SOURCE_SIZE 128             // URL or SD path
+#define OTA_DIGEST_SUFFIX ".sha256"
+#define OTA_CONNECT_TIMEOUT_MS 15000    // Wi-Fi association
+#define OTA_HTTP_TIMEOUT_MS 10000       // Per read
+#define OTA_STAGE_RECORD_SIZE 4096      // Last sector of the staging slot
+
+// OTA task
+#define OTA_TASK_CORE using_taskplan().core(TASK_ROLE_NETWORK)
+#define OTA_TASK_PRIORITY using_taskplan().priority(TASK_ROLE_NETWORK)
+#define OTA_TASK_STACK_SIZE 6144
+
+/**
+ * @brief What is being updated
+ */
+enum EARS_otaTarget : uint8_t
+{
+    OTA_TARGET_FIRMWARE = 0,
+    OTA_TARGET_ASSETS
+};
+
+/**
+ * @brief What the OTA task is doing
+ */
+enum EARS_otaState : uint8_t
+{
+    OTA_IDLE = 0,
+    OTA_CONNECTING,
+    OTA_WRITING,
+    OTA_VERIFYING,
+    OTA_READY,                  // Verified, takes effect at the next restart
+    OTA_FAILED
+};
+
+/**
+ * @brief Why an update stopped
+ */
+enum EARS_otaError : uint8_t
+{
+    OTA_OK = 0,
+    OTA_ERR_SOURCE,             // File missing or HTTP request failed
+    OTA_ERR_WIFI,
+    OTA_ERR_DIGEST_MISSING,     // No digest given and no .sha256 beside the source
+    OTA_ERR_SIZE,               // Unknown length, or larger than the partition
+    OTA_ERR_READ,               // Stream ended early
+    OTA_ERR_FLASH,
+    OTA_ERR_DIGEST,             // SHA-256 mismatch
+    OTA_ERR_IMAGE,              // Not a valid app image or asset pack
+    OTA_ERR_PENDING,            // Assets refused: firmware update awaits restart
+    OTA_ERR_CANCELLED
+};
+
+/**
+ * @brief Update progress
+ */
+struct EARS_otaStatus
+{
+    EARS_otaState state;
+    EARS_otaTarget target;
+    EARS_otaError error;        // Of the last update
+    uint8_t percent;
+    int16_t lastHttpCode;       // Negative for a transport error
+    uint32_t written;           // Bytes written so far
+    uint32_t total;             // Image size
+};
+
+// Event bus values
+#define OTA_EVENT_VALUE(target, low) (((uint32_t)(target) << 8) | (low))
+#define OTA_EVENT_TARGET(value) ((EARS_otaTarget)((value) >> 8))
+#define OTA_EVENT_LOW(value) ((uint8_t)(value)) // Percent or EARS_otaError
+
+/******************************************************************************
+ * EARS_ota Class
+ *****************************************************************************/
+class EARS_ota
+{
+public:
+    EARS_ota();
+
+    // Version information getters
+    static const char* getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char* getVersionDate();
+    static void getVersionString(char* buffer);
+
+    /**
+     * @brief Start the OTA task
+     * @param sdCard SD card for file sources (may be NULL: HTTP only)
+     * @return true if the task is running
+     */
+    bool begin(EARS_sdCard* sdCard);
+
+    /**
+     * @brief Queue an update (any task)
+     * @param target Firmware or asset pack
+     * @param source "http://..." URL, or a path on the SD card
+     * @param sha256Hex Expected digest, or NULL to read "<source>.sha256"
+     * @return true if accepted; false if busy or the arguments are bad
+     */
+    bool requestUpdate(EARS_otaTarget target, const char* source, const char* sha256Hex = nullptr);
+
+    /**
+     * @brief Stop the running update at the next chunk (any task)
+     */
+    void cancel();
+
+    EARS_otaStatus getStatus() const;
+
+    /**
+     * @brief Copy a staged asset pack into the "assets" partition
+     * @return true if a pack was applied
+     * @note Boot only, before MAIN_initialise_asset_pack(); takes a few
+     *       seconds when there is one, nothing otherwise.
+     */
+    bool applyStagedAssets();
+
+private:
+    struct Request
+    {
+        EARS_otaTarget target;
+        bool hasDigest;
+        char source[OTA_SOURCE_SIZE];
+        uint8_t digest[32];
+    };
+
+    EARS_sdCard* _sdCard;
+    TaskHandle_t _task;
+
+    // OTA task only
+    uint8_t* _buffer;            // OTA_CHUNK_SIZE
+    WiFiClient _client;
+    HTTPClient _http;
+    File _file;
+
+    Request _request;            // Under _mux until taken
+    volatile bool _cancel;
+    EARS_otaStatus _status;
+    mutable portMUX_TYPE _mux;
+
+    void run();
+    EARS_otaError update(Request& request);
+    EARS_otaError openSource(const Request& request, uint32_t& size);
+    bool readDigest(const char* source, uint8_t* digest);
+    size_t readSource(uint8_t* buffer, size_t length);
+    void closeSource();
+    bool connect(const EARS_configNetwork& network);
+    void setProgress(EARS_otaState state, uint32_t written, uint32_t total);
+    void finish(EARS_otaTarget target, EARS_otaError error);
+
+    static bool isUrl(const char* source);
+    static bool parseDigest(const char* hex, uint8_t* digest);
+    static const esp_partition_t* assetsPartition();
+
+    static void taskFunction(void* param);
+};
+
+// Global instance access function (Singleton pattern)
+EARS_ota &using_ota();
+
+#endif // __EARS_OTA_LIB_H__
+
+/******************************************************************************
+ * End of EARS_otaLib.h
+ ******************************************************************************/
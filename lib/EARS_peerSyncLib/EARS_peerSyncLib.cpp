@@ -0,0 +1,1039 @@
+/**
+ * @file EARS_peerSyncLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Peer-to-peer delta sync of the record stores over ESP-NOW
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EARS_peerSyncLib.h"
+#include "EARS_systemDef.h"
+#include <WiFi.h>
+#include <esp_now.h>
+#include <esp_wifi.h>
+#include <esp_heap_caps.h>
+#include <esp_rom_crc.h>
+#include <mbedtls/md.h>
+
+/******************************************************************************
+ * Frame Format
+ *****************************************************************************/
+#define PEERSYNC_MAGIC 0xE5
+#define PEERSYNC_BODY_BYTES (RECORD_ZAP_SIZE + RECORD_PAYLOAD_SIZE)
+#define PEERSYNC_DATA_BYTES (PEERSYNC_FRAME_BYTES - PEERSYNC_MAC_BYTES)
+
+enum PeerFrameKind : uint8_t
+{
+    PEER_DELTA = 1,
+    PEER_BEACON = 2,
+    PEER_NACK = 3
+};
+
+// Every frame starts with this (little-endian throughout) and ends with
+// PEERSYNC_MAC_BYTES of HMAC-SHA256 over everything before them
+struct __attribute__((packed)) PeerFrameHeader
+{
+    uint8_t magic;
+    uint8_t kind;          // PeerFrameKind
+    uint8_t store;         // EARS_recordType
+    uint8_t count;         // Records in a delta
+    uint32_t group;        // EARS_PEER_GROUP
+    uint32_t node;         // Sender
+};
+
+// PEER_DELTA: the sender's journal range covered, then count records
+struct __attribute__((packed)) PeerDelta
+{
+    uint32_t from;
+    uint32_t to;
+};
+
+// One record of a delta, followed by length packed bytes of zap and payload
+struct __attribute__((packed)) PeerRecord
+{
+    uint32_t id;
+    uint32_t clock;        // Lamport stamp, with the sender's node
+    uint8_t flags;         // RECORD_FLAG_DELETED or 0
+    uint8_t length;        // 0 for a tombstone
+};
+
+// PEER_BEACON: the sender's journal head
+struct __attribute__((packed)) PeerBeacon
+{
+    uint32_t head;
+};
+
+// PEER_NACK: the origin asked to send again from watermark
+struct __attribute__((packed)) PeerNack
+{
+    uint32_t origin;
+    uint32_t watermark;
+};
+
+static const uint8_t peerBroadcast[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+/******************************************************************************
+ * State File
+ *****************************************************************************/
+#define PEERSYNC_STATE_MAGIC 0x52455045 // "EPER"
+
+// <name>.peer: header, origins, then stamps sorted by ID
+struct StateHeader
+{
+    uint32_t magic;
+    uint32_t layout;       // Origin and stamp sizes
+    uint32_t sequence;     // Store sequence when saved
+    uint32_t stamped;      // Own journal stamped up to here
+    uint32_t clock;
+    uint32_t originCount;
+    uint32_t stampCount;
+    uint32_t crc;          // CRC-32 of the origins and stamps
+};
+
+/******************************************************************************
+ * Helpers
+ *****************************************************************************/
+
+// Stamps and scratch: PSRAM when there is any
+static void *peerRealloc(void *ptr, size_t size)
+{
+    void *grown = heap_caps_realloc(ptr, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    return grown ? grown : heap_caps_realloc(ptr, size, MALLOC_CAP_8BIT);
+}
+
+static size_t fillHeader(uint8_t *frame, uint8_t kind, uint8_t store, uint32_t node)
+{
+    PeerFrameHeader header;
+    header.magic = PEERSYNC_MAGIC;
+    header.kind = kind;
+    header.store = store;
+    header.count = 0;
+    header.group = EARS_PEER_GROUP;
+    header.node = node;
+    memcpy(frame, &header, sizeof(header));
+    return sizeof(header);
+}
+
+// Parse exactly 2 * length hex characters, false on anything else
+static bool parseKey(const char *hex, uint8_t *key, size_t length)
+{
+    if (!hex || strlen(hex) != 2 * length)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < 2 * length; i++)
+    {
+        if (!isxdigit((unsigned char)hex[i]))
+        {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < length; i++)
+    {
+        char byteHex[3] = {hex[i * 2], hex[i * 2 + 1], '\0'};
+        key[i] = (uint8_t)strtoul(byteHex, nullptr, 16);
+    }
+    return true;
+}
+
+// Compare without an early exit, so timing does not show how much matched
+static bool macEquals(const uint8_t *a, const uint8_t *b)
+{
+    uint8_t diff = 0;
+    for (size_t i = 0; i < PEERSYNC_MAC_BYTES; i++)
+    {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
+
+/**
+ * @brief Squeeze out zero runs: a 0 byte is followed by the run length - 1
+ * @details Zap number and string fields are mostly padding
+ * @param out At least length * 3 / 2 + 1 bytes
+ * @return size_t Packed length
+ */
+static size_t packBody(const uint8_t *in, size_t length, uint8_t *out)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < length;)
+    {
+        if (in[i] != 0)
+        {
+            out[n++] = in[i++];
+            continue;
+        }
+
+        size_t run = 1;
+        while (i + run < length && in[i + run] == 0 && run < 256)
+        {
+            run++;
+        }
+        out[n++] = 0;
+        out[n++] = (uint8_t)(run - 1);
+        i += run;
+    }
+    return n;
+}
+
+// Undo packBody(); false unless it fills out exactly
+static bool unpackBody(const uint8_t *in, size_t length, uint8_t *out, size_t size)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        if (in[i] != 0)
+        {
+            if (n >= size)
+            {
+                return false;
+            }
+            out[n++] = in[i];
+            continue;
+        }
+
+        if (++i >= length || n + in[i] + 1 > size)
+        {
+            return false;
+        }
+        memset(out + n, 0, in[i] + 1);
+        n += in[i] + 1;
+    }
+    return n == size;
+}
+
+/******************************************************************************
+ * Construction
+ *****************************************************************************/
+EARS_peerSync::EARS_peerSync()
+    : _sdCard(nullptr),
+      _slotCount(0),
+      _running(false),
+      _node(0),
+      _clock(0),
+      _beaconMs(0),
+      _rx(nullptr),
+      _records(nullptr)
+{
+    memset(_slots, 0, sizeof(_slots));
+    memset(&_stats, 0, sizeof(_stats));
+    memset(_key, 0, sizeof(_key));
+    _mux = portMUX_INITIALIZER_UNLOCKED;
+}
+
+bool EARS_peerSync::addStore(EARS_recordStore* store, const char* name)
+{
+    if (_running || !store || !name || _slotCount >= PEERSYNC_MAX_STORES || slotFor(store->getType()))
+    {
+        return false;
+    }
+
+    Slot &slot = _slots[_slotCount++];
+    slot.store = store;
+    snprintf(slot.path, sizeof(slot.path), "%s/%s%s", RECORD_STORE_DIR, name, PEERSYNC_STATE_SUFFIX);
+    return true;
+}
+
+bool EARS_peerSync::begin(EARS_sdCard* sdCard, const char* keyHex)
+{
+    if (_running)
+    {
+        return true;
+    }
+    if (!sdCard || !sdCard->isAvailable() || _slotCount == 0)
+    {
+        return false;
+    }
+    if (!parseKey(keyHex, _key, sizeof(_key)))
+    {
+        Serial.println("[PEER] No valid security.peer_key, peer sync off");
+        return false;
+    }
+    _sdCard = sdCard;
+
+    if (!_records)
+    {
+        _records = (EARS_record *)peerRealloc(nullptr, sizeof(EARS_record) * PEERSYNC_STAMP_RECORDS);
+    }
+    if (!_rx)
+    {
+        _rx = xQueueCreate(PEERSYNC_RX_FRAMES, sizeof(RxFrame));
+    }
+    if (!_records || !_rx)
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < _slotCount; i++)
+    {
+        Slot &slot = _slots[i];
+        if (!loadState(slot))
+        {
+            slot.originCount = 0;
+            slot.stampCount = 0;
+            slot.stamped = 0;
+        }
+
+        // Older changes go out when a peer NACKs them
+        slot.sendFrom = slot.store->getRecordCount();
+    }
+
+    // Stamps saved after the last clock in the file may have gone higher
+    _clock += PEERSYNC_CLOCK_LEASE;
+
+    if (WiFi.getMode() == WIFI_OFF)
+    {
+        WiFi.mode(WIFI_STA);
+    }
+    uint8_t mac[6];
+    WiFi.macAddress(mac);
+    _node = ((uint32_t)mac[2] << 24) | ((uint32_t)mac[3] << 16) | ((uint32_t)mac[4] << 8) | mac[5];
+
+    _running = startRadio();
+
+#if EARS_DEBUG == 1
+    Serial.printf("[PEER] Node %08lx %s, %u stores\n", (unsigned long)_node,
+                  _running ? "listening" : "ESP-NOW failed", _slotCount);
+#endif
+    return _running;
+}
+
+/**
+ * @brief Start ESP-NOW with the broadcast peer
+ * @details Not joined to a network, every unit sits on PEERSYNC_CHANNEL;
+ *          joined, on the network's channel, which peers must share
+ */
+bool EARS_peerSync::startRadio()
+{
+    if (WiFi.getMode() == WIFI_OFF)
+    {
+        WiFi.mode(WIFI_STA);
+    }
+    if (WiFi.status() != WL_CONNECTED)
+    {
+        esp_wifi_set_channel(PEERSYNC_CHANNEL, WIFI_SECOND_CHAN_NONE);
+    }
+
+    esp_now_deinit();
+    if (esp_now_init() != ESP_OK || esp_now_register_recv_cb(onReceive) != ESP_OK)
+    {
+        return false;
+    }
+
+    esp_now_peer_info_t peer;
+    memset(&peer, 0, sizeof(peer));
+    memcpy(peer.peer_addr, peerBroadcast, sizeof(peerBroadcast));
+    peer.channel = 0;   // Current channel
+    peer.ifidx = WIFI_IF_STA;
+    peer.encrypt = false;
+    return esp_now_add_peer(&peer) == ESP_OK;
+}
+
+/******************************************************************************
+ * Counters
+ *****************************************************************************/
+void EARS_peerSync::count(uint32_t EARS_peerSyncStats::*field, uint32_t amount)
+{
+    portENTER_CRITICAL(&_mux);
+    _stats.*field += amount;
+    portEXIT_CRITICAL(&_mux);
+}
+
+EARS_peerSyncStats EARS_peerSync::getStats() const
+{
+    portENTER_CRITICAL(&_mux);
+    EARS_peerSyncStats stats = _stats;
+    portEXIT_CRITICAL(&_mux);
+    return stats;
+}
+
+uint8_t EARS_peerSync::getPeerCount() const
+{
+    if (_slotCount == 0)
+    {
+        return 0;
+    }
+
+    // Every unit beacons every store, so the first one sees them all
+    uint8_t peers = 0;
+    uint32_t now = millis();
+    for (uint8_t i = 0; i < _slots[0].originCount; i++)
+    {
+        if (_slots[0].origins[i].heardMs != 0 && now - _slots[0].origins[i].heardMs < PEERSYNC_PEER_TIMEOUT_MS)
+        {
+            peers++;
+        }
+    }
+    return peers;
+}
+
+/******************************************************************************
+ * Lookups
+ *****************************************************************************/
+EARS_peerSync::Slot* EARS_peerSync::slotFor(uint8_t type)
+{
+    for (uint8_t i = 0; i < _slotCount; i++)
+    {
+        if (_slots[i].store->getType() == type)
+        {
+            return &_slots[i];
+        }
+    }
+    return nullptr;
+}
+
+// Known origin, or a new one while there is room
+EARS_peerSync::Origin* EARS_peerSync::originFor(Slot& slot, uint32_t node)
+{
+    for (uint8_t i = 0; i < slot.originCount; i++)
+    {
+        if (slot.origins[i].node == node)
+        {
+            return &slot.origins[i];
+        }
+    }
+    if (slot.originCount >= PEERSYNC_MAX_NODES)
+    {
+        return nullptr;
+    }
+
+    Origin &origin = slot.origins[slot.originCount++];
+    memset(&origin, 0, sizeof(origin));
+    origin.node = node;
+    return &origin;
+}
+
+EARS_peerSync::Stamp* EARS_peerSync::findStamp(Slot& slot, uint32_t id)
+{
+    uint32_t lo = 0, hi = slot.stampCount;
+    while (lo < hi)
+    {
+        uint32_t mid = (lo + hi) / 2;
+        if (slot.stamps[mid].id < id)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return (lo < slot.stampCount && slot.stamps[lo].id == id) ? &slot.stamps[lo] : nullptr;
+}
+
+// Insert an empty stamp in ID order; nullptr if out of memory
+EARS_peerSync::Stamp* EARS_peerSync::addStamp(Slot& slot, uint32_t id)
+{
+    if (slot.stampCount == slot.stampCapacity)
+    {
+        uint32_t capacity = slot.stampCapacity ? slot.stampCapacity * 2 : PEERSYNC_STAMP_INITIAL;
+        Stamp *grown = (Stamp *)peerRealloc(slot.stamps, capacity * sizeof(Stamp));
+        if (!grown)
+        {
+            return nullptr;
+        }
+        slot.stamps = grown;
+        slot.stampCapacity = capacity;
+    }
+
+    uint32_t pos = slot.stampCount;
+    while (pos > 0 && slot.stamps[pos - 1].id > id)
+    {
+        pos--;
+    }
+    memmove(&slot.stamps[pos + 1], &slot.stamps[pos], (slot.stampCount - pos) * sizeof(Stamp));
+    slot.stampCount++;
+
+    Stamp *stamp = &slot.stamps[pos];
+    memset(stamp, 0, sizeof(Stamp));
+    stamp->id = id;
+    return stamp;
+}
+
+// Highest clock wins, ties to the higher node, so every unit picks the same
+bool EARS_peerSync::newer(const Stamp* stamp, uint32_t clock, uint32_t node)
+{
+    return clock > stamp->clock || (clock == stamp->clock && node > stamp->node);
+}
+
+/******************************************************************************
+ * Sending
+ *****************************************************************************/
+/**
+ * @brief Truncated HMAC-SHA256 of a frame under the group key
+ * @param mac Output, PEERSYNC_MAC_BYTES
+ */
+bool EARS_peerSync::frameMac(const uint8_t* data, size_t length, uint8_t* mac) const
+{
+    const mbedtls_md_info_t *info = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+    uint8_t full[32];
+    if (info == nullptr || mbedtls_md_hmac(info, _key, sizeof(_key), data, length, full) != 0)
+    {
+        return false;
+    }
+    memcpy(mac, full, PEERSYNC_MAC_BYTES);
+    return true;
+}
+
+// Append the MAC and broadcast; length is the frame before it
+bool EARS_peerSync::sendFrame(size_t length)
+{
+    bool ok = frameMac(_frame, length, _frame + length) &&
+              esp_now_send(peerBroadcast, _frame, length + PEERSYNC_MAC_BYTES) == ESP_OK;
+    count(ok ? &EARS_peerSyncStats::framesSent : &EARS_peerSyncStats::sendErrors);
+    return ok;
+}
+
+/**
+ * @brief Give this unit's new local versions a Lamport stamp
+ * @details Versions from peers are stamped when applied. A version that
+ *          already has its stamp (same local sequence) keeps it, so a
+ *          rescan after a reset does not change what peers see.
+ */
+void EARS_peerSync::stampLocal(Slot& slot)
+{
+    uint32_t head = slot.store->getRecordCount();
+    if (slot.stamped >= head)
+    {
+        return;
+    }
+
+    uint32_t next;
+    size_t found = slot.store->readChanges(slot.stamped, _records, PEERSYNC_STAMP_RECORDS, next);
+    for (size_t i = 0; i < found; i++)
+    {
+        const EARS_record &record = _records[i];
+        if (record.header.flags & RECORD_FLAG_PEER)
+        {
+            continue;
+        }
+
+        Stamp *stamp = findStamp(slot, record.header.id);
+        if (stamp && stamp->node == _node && stamp->sequence == record.header.sequence)
+        {
+            continue;
+        }
+        if (!stamp)
+        {
+            stamp = addStamp(slot, record.header.id);
+            if (!stamp)
+            {
+                continue;
+            }
+        }
+
+        _clock = (stamp->clock >= _clock ? stamp->clock : _clock) + 1;
+        stamp->clock = _clock;
+        stamp->node = _node;
+        stamp->sequence = record.header.sequence;
+    }
+
+    if (next != slot.stamped)
+    {
+        slot.stamped = next;
+        slot.dirty = true;
+        slot.changedMs = millis();
+    }
+}
+
+/**
+ * @brief Send stamped local versions from sendFrom, as many frames as the
+ *        run allows
+ * @details A frame covers the journal range it read, so one whose versions
+ *          were all superseded or came from peers still goes out empty and
+ *          moves the receivers' watermarks past it
+ */
+void EARS_peerSync::sendDeltas(Slot& slot)
+{
+    uint8_t body[PEERSYNC_BODY_BYTES];
+    uint8_t packed[PEERSYNC_BODY_BYTES * 3 / 2 + 1];
+
+    for (uint8_t f = 0; f < PEERSYNC_FRAMES_PER_SERVICE && slot.sendFrom < slot.stamped; f++)
+    {
+        size_t length = fillHeader(_frame, PEER_DELTA, slot.store->getType(), _node) + sizeof(PeerDelta);
+        uint32_t position = slot.sendFrom;
+        uint8_t records = 0;
+
+        while (position < slot.stamped && records < UINT8_MAX)
+        {
+            EARS_record record;
+            uint32_t next;
+            size_t found = slot.store->readChanges(position, &record, 1, next);
+            if (next == position)
+            {
+                break;   // Read failed
+            }
+            if (next > slot.stamped)
+            {
+                if (found > 0)
+                {
+                    break;   // A version not stamped yet
+                }
+                next = slot.stamped;
+            }
+
+            // Only this unit's current version, with the stamp it was given
+            const Stamp *stamp = found ? findStamp(slot, record.header.id) : nullptr;
+            if (!stamp || (record.header.flags & RECORD_FLAG_PEER) || stamp->node != _node ||
+                stamp->sequence != record.header.sequence)
+            {
+                position = next;
+                continue;
+            }
+
+            bool deleted = record.header.flags & RECORD_FLAG_DELETED;
+            size_t packedLength = 0;
+            if (!deleted)
+            {
+                memcpy(body, record.header.zap, RECORD_ZAP_SIZE);
+                memcpy(body + RECORD_ZAP_SIZE, record.payload, RECORD_PAYLOAD_SIZE);
+                packedLength = packBody(body, sizeof(body), packed);
+            }
+            if (length + sizeof(PeerRecord) + packedLength > PEERSYNC_DATA_BYTES)
+            {
+                break;
+            }
+
+            PeerRecord entry;
+            entry.id = record.header.id;
+            entry.clock = stamp->clock;
+            entry.flags = deleted ? RECORD_FLAG_DELETED : 0;
+            entry.length = (uint8_t)packedLength;
+            memcpy(_frame + length, &entry, sizeof(entry));
+            memcpy(_frame + length + sizeof(entry), packed, packedLength);
+            length += sizeof(entry) + packedLength;
+            records++;
+            position = next;
+        }
+
+        if (position == slot.sendFrom)
+        {
+            return;
+        }
+
+        PeerDelta delta;
+        delta.from = slot.sendFrom;
+        delta.to = position;
+        memcpy(_frame + sizeof(PeerFrameHeader), &delta, sizeof(delta));
+        _frame[offsetof(PeerFrameHeader, count)] = records;
+        if (!sendFrame(length))
+        {
+            return;   // Radio queue full: same frame next run
+        }
+
+        count(&EARS_peerSyncStats::recordsSent, records);
+        slot.sendFrom = position;
+    }
+}
+
+void EARS_peerSync::sendBeacon(const Slot& slot)
+{
+    size_t length = fillHeader(_frame, PEER_BEACON, slot.store->getType(), _node);
+    PeerBeacon beacon;
+    beacon.head = slot.store->getRecordCount();
+    memcpy(_frame + length, &beacon, sizeof(beacon));
+    sendFrame(length + sizeof(beacon));
+}
+
+void EARS_peerSync::sendNack(Slot& slot, Origin& origin)
+{
+    uint32_t now = millis();
+    if (origin.nackMs != 0 && now - origin.nackMs < PEERSYNC_NACK_MIN_MS)
+    {
+        return;
+    }
+    origin.nackMs = now ? now : 1;
+
+    size_t length = fillHeader(_frame, PEER_NACK, slot.store->getType(), _node);
+    PeerNack nack;
+    nack.origin = origin.node;
+    nack.watermark = origin.watermark;
+    memcpy(_frame + length, &nack, sizeof(nack));
+    if (sendFrame(length + sizeof(nack)))
+    {
+        count(&EARS_peerSyncStats::nacksSent);
+    }
+}
+
+/******************************************************************************
+ * Receiving
+ *****************************************************************************/
+
+/**
+ * @brief ESP-NOW receive callback (Wi-Fi task): queue the group's frames
+ */
+void EARS_peerSync::onReceive(const uint8_t* mac, const uint8_t* data, int length)
+{
+    EARS_peerSync &sync = using_peersync();
+    if (!sync._rx || length < (int)(sizeof(PeerFrameHeader) + PEERSYNC_MAC_BYTES) || length > PEERSYNC_FRAME_BYTES)
+    {
+        return;
+    }
+
+    PeerFrameHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != PEERSYNC_MAGIC || header.group != EARS_PEER_GROUP || header.node == sync._node)
+    {
+        return;
+    }
+
+    RxFrame frame;
+    frame.length = (uint8_t)length;
+    memcpy(frame.data, data, length);
+    if (xQueueSend(sync._rx, &frame, 0) != pdTRUE)
+    {
+        sync.count(&EARS_peerSyncStats::rxOverflows);
+    }
+}
+
+void EARS_peerSync::receive(const uint8_t* data, size_t length)
+{
+    // Forged or damaged frames go before they can claim an origin slot
+    uint8_t mac[PEERSYNC_MAC_BYTES];
+    length -= PEERSYNC_MAC_BYTES;
+    if (!frameMac(data, length, mac) || !macEquals(mac, data + length))
+    {
+        count(&EARS_peerSyncStats::rejected);
+        return;
+    }
+
+    PeerFrameHeader header;
+    memcpy(&header, data, sizeof(header));
+    Slot *slot = slotFor(header.store);
+    Origin *origin = slot ? originFor(*slot, header.node) : nullptr;
+    if (!origin)
+    {
+        return;
+    }
+
+    uint32_t now = millis();
+    origin->heardMs = now ? now : 1;
+    portENTER_CRITICAL(&_mux);
+    _stats.framesReceived++;
+    _stats.lastReceiveMs = origin->heardMs;
+    portEXIT_CRITICAL(&_mux);
+
+    data += sizeof(header);
+    length -= sizeof(header);
+
+    if (header.kind == PEER_DELTA)
+    {
+        applyDelta(*slot, *origin, data, length, header.count);
+    }
+    else if (header.kind == PEER_BEACON && length >= sizeof(PeerBeacon))
+    {
+        PeerBeacon beacon;
+        memcpy(&beacon, data, sizeof(beacon));
+        origin->head = beacon.head;
+
+        if (origin->watermark > beacon.head)
+        {
+            // Its store was replaced: record numbers start over
+            origin->watermark = 0;
+            slot->dirty = true;
+            slot->changedMs = now;
+        }
+        if (origin->watermark < beacon.head && now - origin->deltaMs >= PEERSYNC_NACK_MIN_MS)
+        {
+            sendNack(*slot, *origin);
+        }
+    }
+    else if (header.kind == PEER_NACK && length >= sizeof(PeerNack))
+    {
+        PeerNack nack;
+        memcpy(&nack, data, sizeof(nack));
+        if (nack.origin == _node && nack.watermark < slot->sendFrom)
+        {
+            slot->sendFrom = nack.watermark;
+            count(&EARS_peerSyncStats::rewinds);
+        }
+    }
+}
+
+/**
+ * @brief Apply a delta frame that continues the origin's watermark
+ * @details A malformed frame or a store that cannot take a record leaves
+ *          the watermark where it was, so the next frame is a gap and is
+ *          NACKed; records applied before that are stale the second time
+ */
+void EARS_peerSync::applyDelta(Slot& slot, Origin& origin, const uint8_t* data, size_t length, uint8_t records)
+{
+    PeerDelta range;
+    if (length < sizeof(range))
+    {
+        return;
+    }
+    memcpy(&range, data, sizeof(range));
+
+    if (range.to <= origin.watermark)
+    {
+        count(&EARS_peerSyncStats::repeats);
+        return;
+    }
+    if (range.from > origin.watermark)
+    {
+        count(&EARS_peerSyncStats::gaps);
+        sendNack(slot, origin);
+        return;
+    }
+
+    size_t offset = sizeof(range);
+    uint8_t body[PEERSYNC_BODY_BYTES];
+    for (uint8_t r = 0; r < records; r++)
+    {
+        PeerRecord entry;
+        if (offset + sizeof(entry) > length)
+        {
+            return;
+        }
+        memcpy(&entry, data + offset, sizeof(entry));
+        offset += sizeof(entry);
+
+        bool deleted = entry.flags & RECORD_FLAG_DELETED;
+        if (offset + entry.length > length)
+        {
+            return;
+        }
+        if (deleted)
+        {
+            memset(body, 0, sizeof(body));
+        }
+        else if (!unpackBody(data + offset, entry.length, body, sizeof(body)))
+        {
+            return;
+        }
+        offset += entry.length;
+
+        if (entry.clock > _clock)
+        {
+            _clock = entry.clock;
+        }
+
+        Stamp *stamp = findStamp(slot, entry.id);
+        if (stamp && !newer(stamp, entry.clock, origin.node))
+        {
+            count(&EARS_peerSyncStats::stale);
+            continue;
+        }
+
+        EARS_record record;
+        memset(&record, 0, sizeof(record));
+        record.header.id = entry.id;
+        record.header.flags = deleted ? RECORD_FLAG_DELETED : 0;
+        memcpy(record.header.zap, body, RECORD_ZAP_SIZE);
+        memcpy(record.payload, body + RECORD_ZAP_SIZE, RECORD_PAYLOAD_SIZE);
+        if (!slot.store->putPeer(record))
+        {
+            return;
+        }
+
+        if (!stamp)
+        {
+            stamp = addStamp(slot, entry.id);
+        }
+        if (stamp)
+        {
+            stamp->clock = entry.clock;
+            stamp->node = origin.node;
+            stamp->sequence = 0;
+        }
+        count(&EARS_peerSyncStats::recordsApplied);
+    }
+
+    uint32_t now = millis();
+    origin.watermark = range.to;
+    origin.deltaMs = now;
+    slot.dirty = true;
+    slot.changedMs = now;
+}
+
+/******************************************************************************
+ * State
+ *****************************************************************************/
+
+/**
+ * @brief Read a store's vector and stamps, unless the store was replaced
+ * @return true if loaded
+ */
+bool EARS_peerSync::loadState(Slot& slot)
+{
+    StateHeader header;
+    if (_sdCard->readDataAt(slot.path, 0, (uint8_t *)&header, sizeof(header)) != sizeof(header) ||
+        header.magic != PEERSYNC_STATE_MAGIC ||
+        header.layout != ((sizeof(Origin) << 16) | sizeof(Stamp)) ||
+        header.originCount > PEERSYNC_MAX_NODES ||
+        header.sequence > slot.store->getSequence() ||
+        header.stamped > slot.store->getRecordCount())
+    {
+        return false;
+    }
+
+    uint32_t capacity = PEERSYNC_STAMP_INITIAL;
+    while (capacity < header.stampCount)
+    {
+        capacity *= 2;
+    }
+    Stamp *stamps = (Stamp *)peerRealloc(slot.stamps, capacity * sizeof(Stamp));
+    if (!stamps)
+    {
+        return false;
+    }
+    slot.stamps = stamps;
+    slot.stampCapacity = capacity;
+
+    size_t origins = header.originCount * sizeof(Origin);
+    size_t stampBytes = header.stampCount * sizeof(Stamp);
+    if (_sdCard->readDataAt(slot.path, sizeof(header), (uint8_t *)slot.origins, origins) != origins ||
+        _sdCard->readDataAt(slot.path, sizeof(header) + origins, (uint8_t *)slot.stamps, stampBytes) != stampBytes)
+    {
+        return false;
+    }
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)slot.origins, origins);
+    if (esp_rom_crc32_le(crc, (const uint8_t *)slot.stamps, stampBytes) != header.crc)
+    {
+        return false;
+    }
+
+    // Times are from the last boot
+    for (uint32_t i = 0; i < header.originCount; i++)
+    {
+        slot.origins[i].heardMs = 0;
+        slot.origins[i].deltaMs = 0;
+        slot.origins[i].nackMs = 0;
+    }
+
+    slot.originCount = header.originCount;
+    slot.stampCount = header.stampCount;
+    slot.stamped = header.stamped;
+    if (header.clock > _clock)
+    {
+        _clock = header.clock;
+    }
+    return true;
+}
+
+bool EARS_peerSync::saveState(Slot& slot)
+{
+    size_t origins = slot.originCount * sizeof(Origin);
+    size_t stampBytes = slot.stampCount * sizeof(Stamp);
+    uint8_t *image = (uint8_t *)peerRealloc(nullptr, sizeof(StateHeader) + origins + stampBytes);
+    if (!image)
+    {
+        return false;
+    }
+
+    StateHeader *header = (StateHeader *)image;
+    header->magic = PEERSYNC_STATE_MAGIC;
+    header->layout = (sizeof(Origin) << 16) | sizeof(Stamp);
+    header->sequence = slot.store->getSequence();
+    header->stamped = slot.stamped;
+    header->clock = _clock;
+    header->originCount = slot.originCount;
+    header->stampCount = slot.stampCount;
+    memcpy(image + sizeof(StateHeader), slot.origins, origins);
+    memcpy(image + sizeof(StateHeader) + origins, slot.stamps, stampBytes);
+    header->crc = esp_rom_crc32_le(esp_rom_crc32_le(0, (const uint8_t *)slot.origins, origins),
+                                   (const uint8_t *)slot.stamps, stampBytes);
+
+    bool ok = _sdCard->writeFileAtomic(slot.path, image, sizeof(StateHeader) + origins + stampBytes);
+    heap_caps_free(image);
+    if (ok)
+    {
+        slot.dirty = false;
+    }
+    return ok;
+}
+
+/******************************************************************************
+ * Service
+ *****************************************************************************/
+void EARS_peerSync::service()
+{
+    if (!_running)
+    {
+        return;
+    }
+
+    // EARS_sync turns the radio off after a sync it joined for
+    if (WiFi.getMode() == WIFI_OFF)
+    {
+        if (!startRadio())
+        {
+            return;
+        }
+        count(&EARS_peerSyncStats::restarts);
+    }
+
+    // Local versions first, so a peer's version received now is weighed
+    // against them rather than against older stamps
+    for (uint8_t i = 0; i < _slotCount; i++)
+    {
+        stampLocal(_slots[i]);
+    }
+
+    RxFrame frame;
+    while (xQueueReceive(_rx, &frame, 0) == pdTRUE)
+    {
+        receive(frame.data, frame.length);
+    }
+
+    for (uint8_t i = 0; i < _slotCount; i++)
+    {
+        sendDeltas(_slots[i]);
+    }
+
+    uint32_t now = millis();
+    if (now - _beaconMs >= PEERSYNC_BEACON_MS)
+    {
+        _beaconMs = now;
+        for (uint8_t i = 0; i < _slotCount; i++)
+        {
+            sendBeacon(_slots[i]);
+        }
+    }
+
+    for (uint8_t i = 0; i < _slotCount; i++)
+    {
+        if (_slots[i].dirty && now - _slots[i].changedMs >= PEERSYNC_CHECKPOINT_DELAY_MS)
+        {
+            saveState(_slots[i]);
+        }
+    }
+}
+
+/******************************************************************************
+ * Version Information
+ *****************************************************************************/
+const char* EARS_peerSync::getLibraryName()
+{
+    return EARS_PeerSync::LIB_NAME;
+}
+
+uint32_t EARS_peerSync::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_PeerSync::VERSION_MAJOR,
+                       EARS_PeerSync::VERSION_MINOR,
+                       EARS_PeerSync::VERSION_PATCH);
+}
+
+const char* EARS_peerSync::getVersionDate()
+{
+    return EARS_PeerSync::VERSION_DATE;
+}
+
+void EARS_peerSync::getVersionString(char* buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+EARS_peerSync &using_peersync()
+{
+    static EARS_peerSync instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_peerSyncLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,269 @@
+/**
+ * @file EARS_peerSyncLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Peer-to-peer delta sync of the record stores over ESP-NOW
+ * @details Units working the same stores exchange their changes directly,
+ *          with no access point, as ESP-NOW broadcasts on one channel
+ *          (PEERSYNC_CHANNEL, or the joined network's).
+ *
+ *          - Deltas: each unit sends its own changes from its .dat journal,
+ *            as the server sync does (EARS_recordStore::readChanges()), in
+ *            frames of up to PEERSYNC_FRAME_BYTES covering journal record
+ *            numbers [from, to). Records go as ID, stamp, flags and the zap
+ *            number and payload with their zero runs squeezed out, so a
+ *            frame holds two or three. Versions received from peers are
+ *            written with putPeer() (RECORD_FLAG_PEER) and never sent on.
+ *          - Version vector: per store, the journal watermark this unit
+ *            holds from each origin (up to PEERSYNC_MAX_NODES units). A
+ *            frame starting past it is a gap: it is dropped and a NACK
+ *            asks the origin to rewind; a frame wholly below it is a
+ *            repeat. Every PEERSYNC_BEACON_MS each unit broadcasts its
+ *            journal head, so a lost tail or a unit that was away is
+ *            NACKed too. A unit starts from its head and sends older
+ *            changes only when asked.
+ *          - Merge: every version carries a Lamport stamp (clock, origin
+ *            unit), and an item keeps the highest it has seen, so units
+ *            converge on the same version of an item edited on two at
+ *            once. Stamps are kept per item in PSRAM.
+ *
+ *          - Authentication: every frame ends with the first
+ *            PEERSYNC_MAC_BYTES of an HMAC-SHA256 over the rest of it,
+ *            keyed by the group's shared PEERSYNC_KEY_BYTES key (ears.config
+ *            security.peer_key, provisioned on every unit). A frame whose
+ *            MAC does not match is dropped before it names an origin or
+ *            reaches a store. Without a key begin() fails. Frames are not
+ *            encrypted, and a replayed frame is only a repeat, a stale
+ *            version or an extra NACK.
+ *
+ *          Vector, stamps and clock are saved to <name>.peer next to the
+ *          store when quiet. Frames carry EARS_PEER_GROUP and units ignore
+ *          other groups.
+ *          service() runs as a job of the background scheduler
+ *          (MAIN_core1TasksLib), which the radio task plan moves to the
+ *          network core; the receive callback only queues frames for it.
+ *          An HTTP sync that turns the radio off is followed by a restart
+ *          of ESP-NOW at the next service().
+ *
+ *          Build with -D EARS_PEER_SYNC=1 to start it at boot.
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_PEER_SYNC_LIB_H__
+#define __EARS_PEER_SYNC_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "EARS_versionDef.h"
+#include "EARS_sdCardLib.h"
+#include "EARS_recordStoreLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_PeerSync
+{
+    constexpr const char* LIB_NAME = "EARS_peerSync";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "1";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+
+// 1 = peer sync started at boot
+#ifndef EARS_PEER_SYNC
+#define EARS_PEER_SYNC 0
+#endif
+
+// Units sync only with others of the same group
+#ifndef EARS_PEER_GROUP
+#define EARS_PEER_GROUP 0x53524145UL    // "EARS"
+#endif
+
+#define PEERSYNC_CHANNEL 1              // Wi-Fi channel while not joined to a network
+#define PEERSYNC_MAX_STORES 2
+#define PEERSYNC_MAX_NODES 8            // Other units tracked per store
+#define PEERSYNC_FRAME_BYTES 250        // ESP-NOW payload limit
+#define PEERSYNC_MAC_BYTES 16           // Truncated HMAC-SHA256 ending every frame
+#define PEERSYNC_KEY_BYTES 32           // Shared group key
+#define PEERSYNC_RX_FRAMES 16           // Received frames waiting for service()
+#define PEERSYNC_SERVICE_MS 50          // Job period
+#define PEERSYNC_FRAMES_PER_SERVICE 4   // Delta frames sent per store per run
+#define PEERSYNC_STAMP_RECORDS 32       // Local changes stamped per store per run
+#define PEERSYNC_BEACON_MS 2000         // Journal heads broadcast
+#define PEERSYNC_NACK_MIN_MS 250        // Between NACKs to one origin
+#define PEERSYNC_PEER_TIMEOUT_MS 10000  // Unheard for this long: not counted as nearby
+#define PEERSYNC_STAMP_INITIAL 256      // Stamps allocated per store, doubles as needed
+#define PEERSYNC_CLOCK_LEASE 1024       // Added to the saved clock at begin()
+#define PEERSYNC_CHECKPOINT_DELAY_MS 5000
+#define PEERSYNC_STATE_SUFFIX ".peer"
+
+/**
+ * @brief Peer sync counters
+ */
+struct EARS_peerSyncStats
+{
+    uint32_t framesSent;
+    uint32_t framesReceived;    // From this group, MAC checked
+    uint32_t rejected;          // Frames failing the MAC, dropped
+    uint32_t recordsSent;
+    uint32_t recordsApplied;    // Newer versions written to a store
+    uint32_t stale;             // Versions older than the item's, dropped
+    uint32_t repeats;           // Delta frames already held
+    uint32_t gaps;              // Delta frames past the watermark, dropped
+    uint32_t nacksSent;
+    uint32_t rewinds;           // NACKs that moved this unit's send position back
+    uint32_t rxOverflows;       // Frames lost to a full receive queue
+    uint32_t sendErrors;
+    uint32_t restarts;          // ESP-NOW restarted after the radio was turned off
+    uint32_t lastReceiveMs;     // millis() of the last frame, 0 = never
+};
+
+/******************************************************************************
+ * EARS_peerSync Class
+ *****************************************************************************/
+class EARS_peerSync
+{
+public:
+    EARS_peerSync();
+
+    // Version information getters
+    static const char* getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char* getVersionDate();
+    static void getVersionString(char* buffer);
+
+    /**
+     * @brief Add a store to sync (before begin())
+     * @details Stores are matched between units by record type
+     * @param store Opened store
+     * @param name Store name; used for the state file
+     * @return true if added
+     */
+    bool addStore(EARS_recordStore* store, const char* name);
+
+    /**
+     * @brief Load the saved state and start ESP-NOW
+     * @param sdCard Mounted SD card
+     * @param keyHex Group key, 2 * PEERSYNC_KEY_BYTES hex characters
+     * @return true if running; false without a valid key
+     */
+    bool begin(EARS_sdCard* sdCard, const char* keyHex);
+
+    bool isRunning() const { return _running; }
+
+    /**
+     * @brief Stamp local changes, apply received frames, send deltas,
+     *        beacons and NACKs, save the state when quiet
+     * @details Job of the background scheduler, every PEERSYNC_SERVICE_MS
+     */
+    void service();
+
+    uint32_t getNodeId() const { return _node; }
+
+    /**
+     * @brief Units heard within PEERSYNC_PEER_TIMEOUT_MS
+     */
+    uint8_t getPeerCount() const;
+
+    EARS_peerSyncStats getStats() const;
+
+private:
+    // Newest version of an item this unit has seen
+    struct Stamp
+    {
+        uint32_t id;
+        uint32_t clock;          // Lamport clock of the write
+        uint32_t node;           // Unit that wrote it
+        uint32_t sequence;       // Local store sequence (this unit's writes only)
+    };
+
+    // What this unit holds of one origin's journal
+    struct Origin
+    {
+        uint32_t node;
+        uint32_t watermark;      // First record number not yet held
+        uint32_t head;           // Last journal head it announced
+        uint32_t heardMs;        // Any frame
+        uint32_t deltaMs;        // Last delta taken
+        uint32_t nackMs;
+    };
+
+    struct Slot
+    {
+        EARS_recordStore* store;
+        char path[40];
+        uint32_t stamped;        // Own journal stamped up to here
+        uint32_t sendFrom;       // Own journal sent up to here
+        Origin origins[PEERSYNC_MAX_NODES];
+        uint8_t originCount;
+        Stamp* stamps;           // Sorted by ID
+        uint32_t stampCount;
+        uint32_t stampCapacity;
+        bool dirty;
+        uint32_t changedMs;
+    };
+
+    struct RxFrame
+    {
+        uint8_t length;
+        uint8_t data[PEERSYNC_FRAME_BYTES];
+    };
+
+    EARS_sdCard* _sdCard;
+    Slot _slots[PEERSYNC_MAX_STORES];
+    uint8_t _slotCount;
+    bool _running;
+    uint32_t _node;              // Low four bytes of the station MAC
+    uint32_t _clock;             // Lamport clock
+    uint32_t _beaconMs;
+    QueueHandle_t _rx;
+    EARS_record* _records;       // PEERSYNC_STAMP_RECORDS, stamping scratch
+    uint8_t _frame[PEERSYNC_FRAME_BYTES];
+    uint8_t _key[PEERSYNC_KEY_BYTES];
+
+    EARS_peerSyncStats _stats;
+    mutable portMUX_TYPE _mux;
+
+    bool startRadio();
+    bool frameMac(const uint8_t* data, size_t length, uint8_t* mac) const;
+    bool sendFrame(size_t length);
+    void sendDeltas(Slot& slot);
+    void sendBeacon(const Slot& slot);
+    void sendNack(Slot& slot, Origin& origin);
+    void stampLocal(Slot& slot);
+    void receive(const uint8_t* data, size_t length);
+    void applyDelta(Slot& slot, Origin& origin, const uint8_t* data, size_t length, uint8_t records);
+
+    Slot* slotFor(uint8_t type);
+    Origin* originFor(Slot& slot, uint32_t node);
+    Stamp* findStamp(Slot& slot, uint32_t id);
+    Stamp* addStamp(Slot& slot, uint32_t id);
+    static bool newer(const Stamp* stamp, uint32_t clock, uint32_t node);
+
+    bool loadState(Slot& slot);
+    bool saveState(Slot& slot);
+    void count(uint32_t EARS_peerSyncStats::*field, uint32_t amount = 1);
+
+    static void onReceive(const uint8_t* mac, const uint8_t* data, int length);
+};
+
+// Global instance access function (Singleton pattern)
+EARS_peerSync &using_peersync();
+
+#endif // __EARS_PEER_SYNC_LIB_H__
+
+/******************************************************************************
+ * End of EARS_peerSyncLib.h
+ ******************************************************************************/
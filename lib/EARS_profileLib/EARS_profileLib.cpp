@@ -0,0 +1,234 @@
+/**
+ * @file EARS_profileLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Scoped cycle-count profiler zones (per-core tables, no locks)
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+#include "EARS_profileLib.h"
+
+#if EARS_PROFILE == 1
+
+#include "EARS_placementDef.h"
+#include "EARS_sdCardLib.h"
+
+// Zero-initialised, so zones work before any constructor has run
+static EARS_profiler profiler_instance;
+
+// Take a table slot for a site, sharing the slot of an existing zone of the same name
+uint8_t EARS_profiler::registerSite(EARS_profileSite &site)
+{
+    uint8_t used = getZoneCount();
+    uint8_t zone = PROFILE_ZONE_FULL;
+    for (uint8_t i = 0; i < used; i++)
+    {
+        if (_names[i] != nullptr && strcmp(_names[i], site.name) == 0)
+        {
+            zone = i;
+            break;
+        }
+    }
+
+    if (zone == PROFILE_ZONE_FULL)
+    {
+        uint8_t claimed = _zoneCount.fetch_add(1, std::memory_order_relaxed);
+        if (claimed < PROFILE_MAX_ZONES)
+        {
+            zone = claimed;
+            _names[zone] = site.name;
+        }
+        else
+        {
+            // Stop the count wrapping over many full sites
+            _zoneCount.store(PROFILE_MAX_ZONES, std::memory_order_relaxed);
+        }
+    }
+
+    if (zone == PROFILE_ZONE_FULL)
+    {
+        _overflows.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // A site registered by both cores at once keeps the first slot
+    uint8_t expected = PROFILE_ZONE_UNSET;
+    if (!site.zone.compare_exchange_strong(expected, zone, std::memory_order_relaxed))
+    {
+        zone = expected;
+    }
+    return zone;
+}
+
+// Add one timed run to the calling core's table
+void EARS_HOT EARS_profiler::record(uint8_t zone, uint8_t core, uint32_t start)
+{
+    uint32_t elapsed = cycles() - start;
+    uint8_t now = (uint8_t)xPortGetCoreID();
+    if (now != core)
+    {
+        // The two CCOUNTs are unrelated
+        _migrated[now]++;
+        return;
+    }
+
+    EARS_profileZoneStats &stats = _zones[now][zone];
+    if (stats.count == 0 || elapsed < stats.minCycles)
+    {
+        stats.minCycles = elapsed;
+    }
+    if (elapsed > stats.maxCycles)
+    {
+        stats.maxCycles = elapsed;
+    }
+    stats.totalCycles += elapsed;
+    stats.count++;
+}
+
+// Print every zone, per core, to Serial
+void EARS_profiler::print()
+{
+    uint32_t mhz = getCpuFrequencyMhz();
+    uint8_t used = getZoneCount();
+
+    Serial.printf("[Profile] %u zones, us at %lu MHz, %lu overflows, %lu migrated\n", used, (unsigned long)mhz,
+                  (unsigned long)getOverflows(), (unsigned long)getMigrated());
+    Serial.println("[Profile] core zone                     count    total_us   avg_cyc   min_cyc   max_cyc");
+
+    for (uint8_t core = 0; core < 2; core++)
+    {
+        for (uint8_t zone = 0; zone < used; zone++)
+        {
+            EARS_profileZoneStats stats;
+            const char *name = getZone(zone, core, &stats);
+            if (name == nullptr || stats.count == 0)
+            {
+                continue;
+            }
+            Serial.printf("[Profile] %4u %-22s %8lu %11llu %9lu %9lu %9lu\n", core, name, (unsigned long)stats.count,
+                          (unsigned long long)(stats.totalCycles / mhz),
+                          (unsigned long)(stats.totalCycles / stats.count), (unsigned long)stats.minCycles,
+                          (unsigned long)stats.maxCycles);
+        }
+    }
+}
+
+// Append every zone, per core, to a CSV file on the SD card
+bool EARS_profiler::save(const char *path)
+{
+    EARS_sdCard &sd = using_sdcard();
+    if (!sd.isAvailable() || !sd.createDirectory(PROFILE_CSV_DIR))
+    {
+        return false;
+    }
+
+    if (!sd.fileExists(path) &&
+        !sd.appendFile(path, "build,version,uptime_ms,mhz,core,zone,count,total_cycles,min_cycles,max_cycles\n"))
+    {
+        return false;
+    }
+
+    uint32_t mhz = getCpuFrequencyMhz();
+    uint32_t uptime = millis();
+    uint8_t used = getZoneCount();
+    bool ok = true;
+
+    for (uint8_t core = 0; core < 2 && ok; core++)
+    {
+        for (uint8_t zone = 0; zone < used && ok; zone++)
+        {
+            EARS_profileZoneStats stats;
+            const char *name = getZone(zone, core, &stats);
+            if (name == nullptr || stats.count == 0)
+            {
+                continue;
+            }
+
+            char row[160];
+            snprintf(row, sizeof(row), "%llu,%s.%s.%s,%lu,%lu,%u,%s,%lu,%llu,%lu,%lu\n",
+                     (unsigned long long)EARS_APP_BUILD_TIMESTAMP,
+                     EARS_APP_VERSION_MAJOR, EARS_APP_VERSION_MINOR, EARS_APP_VERSION_PATCH,
+                     (unsigned long)uptime, (unsigned long)mhz, core, name, (unsigned long)stats.count,
+                     (unsigned long long)stats.totalCycles, (unsigned long)stats.minCycles,
+                     (unsigned long)stats.maxCycles);
+            ok = sd.appendFile(path, row);
+        }
+    }
+
+    sd.flush(path);
+    return ok;
+}
+
+// Clear the counts (zone slots are kept)
+void EARS_profiler::reset()
+{
+    memset(_zones, 0, sizeof(_zones));
+    _migrated[0] = 0;
+    _migrated[1] = 0;
+    _overflows.store(0, std::memory_order_relaxed);
+}
+
+// One zone's counts
+const char *EARS_profiler::getZone(uint8_t zone, uint8_t core, EARS_profileZoneStats *stats) const
+{
+    if (zone >= getZoneCount() || core > 1)
+    {
+        return nullptr;
+    }
+    *stats = _zones[core][zone];
+    return _names[zone];
+}
+
+// Slots in use
+uint8_t EARS_profiler::getZoneCount() const
+{
+    uint8_t used = _zoneCount.load(std::memory_order_relaxed);
+    return used < PROFILE_MAX_ZONES ? used : PROFILE_MAX_ZONES;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char *EARS_profiler::getLibraryName()
+{
+    return EARS_Profile::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t EARS_profiler::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_Profile::VERSION_MAJOR,
+                       EARS_Profile::VERSION_MINOR,
+                       EARS_Profile::VERSION_PATCH);
+}
+
+// Get version date
+const char *EARS_profiler::getVersionDate()
+{
+    return EARS_Profile::VERSION_DATE;
+}
+
+// Format version as string
+void EARS_profiler::getVersionString(char *buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/**
+ * @brief Get reference to global profiler instance
+ *
+ * @return EARS_profiler& Reference to the global profiler instance
+ */
+EARS_profiler &using_profiler()
+{
+    return profiler_instance;
+}
+
+#endif // EARS_PROFILE == 1
+
+/******************************************************************************
+ * End of EARS_profileLib.cpp
+ *****************************************************************************/
@@ -0,0 +1,255 @@
+/**
+ * @file EARS_profileLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Scoped cycle-count profiler zones (per-core tables, no locks)
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * Features:
+ * - EARS_PROFILE_ZONE("name") times the rest of the enclosing scope
+ * - Xtensa CCOUNT read on entry and exit, a few cycles each
+ * - Count, total, min and max per zone in one table per core
+ * - No locks and no allocation on the timing path
+ * - Tables printed to Serial or appended to an SD card CSV
+ * - Compiled out completely unless built with -D EARS_PROFILE=1
+ *
+ * @details
+ * The first time a zone runs it takes a table slot by name, with one
+ * fetch_add; zones of the same name in different functions share the slot,
+ * so "sd write" adds up every SD write path. Each core updates only its own
+ * table, so nothing is shared on the timing path.
+ *
+ * Times are inclusive: a zone inside another counts in both. They are CPU
+ * cycles, so the figures hold across MAIN_powerLib's clock changes; the
+ * microseconds printed beside them are at the clock when printed. A zone
+ * that starts on one core and ends on the other (an unpinned task that was
+ * moved) is dropped and counted as migrated. A task preempted mid-update by
+ * another task on the same core in the same zone can lose that one sample.
+ *
+ * Up to PROFILE_MAX_ZONES names; zones past that are counted as overflow
+ * and not timed. A zone must end within one CCOUNT wrap (about 17 s at
+ * 240 MHz).
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_PROFILE_LIB_H__
+#define __EARS_PROFILE_LIB_H__
+
+/******************************************************************************
+ * Profile Configuration
+ *****************************************************************************/
+
+// 1 = zones are timed (pio env profile), 0 = every macro compiles to nothing
+#ifndef EARS_PROFILE
+#define EARS_PROFILE 0
+#endif
+
+#if EARS_PROFILE == 1
+
+/******************************************************************************
+ * Includes Information
+ *****************************************************************************/
+#include <Arduino.h>
+#include <atomic>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_Profile
+{
+    constexpr const char *LIB_NAME = "EARS_profile";
+    constexpr const char *VERSION_MAJOR = "1";
+    constexpr const char *VERSION_MINOR = "0";
+    constexpr const char *VERSION_PATCH = "0";
+    constexpr const char *VERSION_DATE = "2026-10-15";
+}
+
+// Zone names kept (per core tables of this many entries)
+#define PROFILE_MAX_ZONES 32
+
+// Site states before a slot is taken
+#define PROFILE_ZONE_UNSET 0xFF
+#define PROFILE_ZONE_FULL 0xFE
+
+// Core 1 prints, saves and resets the tables this often
+#define PROFILE_REPORT_MS 60000
+
+// save() default file
+#define PROFILE_CSV_DIR "/bench"
+#define PROFILE_CSV_PATH "/bench/profile.csv"
+
+/******************************************************************************
+ * Profile
+ *****************************************************************************/
+
+/**
+ * @struct EARS_profileZoneStats
+ * @brief One zone on one core
+ */
+struct EARS_profileZoneStats
+{
+    uint32_t count;       // Times it ended on this core
+    uint64_t totalCycles; // Cycles in it
+    uint32_t minCycles;   // Quickest
+    uint32_t maxCycles;   // Slowest
+};
+
+/**
+ * @struct EARS_profileSite
+ * @brief One EARS_PROFILE_ZONE() in the source (a static, constant-initialised)
+ */
+struct EARS_profileSite
+{
+    constexpr EARS_profileSite(const char *zoneName) : name(zoneName), zone(PROFILE_ZONE_UNSET) {}
+
+    const char *name;
+    std::atomic<uint8_t> zone; // Table slot, or PROFILE_ZONE_UNSET / _FULL
+};
+
+class EARS_profiler
+{
+public:
+    // Version information getters
+    static const char *getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char *getVersionDate();
+    static void getVersionString(char *buffer);
+
+    /**
+     * @brief Read this core's cycle counter
+     * @return uint32_t CCOUNT
+     */
+    static inline uint32_t cycles()
+    {
+        uint32_t count;
+        __asm__ __volatile__("rsr %0, ccount" : "=a"(count));
+        return count;
+    }
+
+    /**
+     * @brief Table slot of a site, taken on its first use
+     * @param site The zone's site
+     * @return uint8_t Slot, or PROFILE_ZONE_FULL
+     */
+    inline uint8_t zoneOf(EARS_profileSite &site)
+    {
+        uint8_t zone = site.zone.load(std::memory_order_relaxed);
+        return zone != PROFILE_ZONE_UNSET ? zone : registerSite(site);
+    }
+
+    /**
+     * @brief Add one timed run to the calling core's table
+     * @param zone Slot from zoneOf()
+     * @param core Core the zone started on
+     * @param start CCOUNT when it started
+     */
+    void record(uint8_t zone, uint8_t core, uint32_t start);
+
+    /**
+     * @brief Print every zone, per core, to Serial
+     */
+    void print();
+
+    /**
+     * @brief Append every zone, per core, to a CSV file on the SD card
+     * @param path File (the header row is written if it does not exist)
+     * @return true if written
+     */
+    bool save(const char *path = PROFILE_CSV_PATH);
+
+    /**
+     * @brief Clear the counts (zone slots are kept)
+     * @note Runs ending on the other core meanwhile may survive the reset.
+     */
+    void reset();
+
+    /**
+     * @brief One zone's counts
+     * @param zone Slot, 0 to getZoneCount() - 1
+     * @param core Core 0 or 1
+     * @param stats Receives the counts
+     * @return const char* Zone name, or nullptr if the slot is unused
+     */
+    const char *getZone(uint8_t zone, uint8_t core, EARS_profileZoneStats *stats) const;
+
+    /**
+     * @brief Slots in use
+     * @return uint8_t Up to PROFILE_MAX_ZONES
+     */
+    uint8_t getZoneCount() const;
+
+    // Zones not timed for want of a slot, and runs dropped for changing core
+    uint32_t getOverflows() const { return _overflows.load(std::memory_order_relaxed); }
+    uint32_t getMigrated() const { return _migrated[0] + _migrated[1]; }
+
+private:
+    uint8_t registerSite(EARS_profileSite &site);
+
+    EARS_profileZoneStats _zones[2][PROFILE_MAX_ZONES];
+    const char *_names[PROFILE_MAX_ZONES];
+    std::atomic<uint8_t> _zoneCount;
+    std::atomic<uint32_t> _overflows;
+    uint32_t _migrated[2]; // Per ending core
+};
+
+// Global instance access function
+EARS_profiler &using_profiler();
+
+/**
+ * @class EARS_profileZone
+ * @brief Times from construction to the end of its scope
+ */
+class EARS_profileZone
+{
+public:
+    inline explicit EARS_profileZone(EARS_profileSite &site)
+        : _zone(using_profiler().zoneOf(site)), _core((uint8_t)xPortGetCoreID()), _start(EARS_profiler::cycles())
+    {
+    }
+
+    inline ~EARS_profileZone()
+    {
+        if (_zone != PROFILE_ZONE_FULL)
+        {
+            using_profiler().record(_zone, _core, _start);
+        }
+    }
+
+private:
+    EARS_profileZone(const EARS_profileZone &) = delete;
+    EARS_profileZone &operator=(const EARS_profileZone &) = delete;
+
+    uint8_t _zone;
+    uint8_t _core;
+    uint32_t _start;
+};
+
+#define EARS_PROFILE_CONCAT2(a, b) a##b
+#define EARS_PROFILE_CONCAT(a, b) EARS_PROFILE_CONCAT2(a, b)
+
+// Time the rest of the enclosing scope as zone "name" (a string literal)
+#define EARS_PROFILE_ZONE(name)                                                        \
+    static EARS_profileSite EARS_PROFILE_CONCAT(ears_profile_site_, __LINE__)(name); \
+    EARS_profileZone EARS_PROFILE_CONCAT(ears_profile_zone_, __LINE__)(EARS_PROFILE_CONCAT(ears_profile_site_, __LINE__))
+
+#define EARS_PROFILE_PRINT() using_profiler().print()
+#define EARS_PROFILE_SAVE() using_profiler().save()
+#define EARS_PROFILE_RESET() using_profiler().reset()
+
+#else
+
+#define EARS_PROFILE_ZONE(name)
+#define EARS_PROFILE_PRINT()
+#define EARS_PROFILE_SAVE()
+#define EARS_PROFILE_RESET()
+
+#endif // EARS_PROFILE == 1
+
+#endif // __EARS_PROFILE_LIB_H__
+
+/******************************************************************************
+ * End of EARS_profileLib.h
+ *****************************************************************************/
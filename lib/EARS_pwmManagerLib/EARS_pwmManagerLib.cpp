@@ -0,0 +1,295 @@
+/**
+ * @file EARS_pwmManagerLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Shared LEDC PWM channel and timer allocation
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+#include "EARS_pwmManagerLib.h"
+
+// Arduino LEDC: channel pairs share a timer, 8 channels per speed group
+static inline uint8_t timerPeer(uint8_t channel)
+{
+    return channel ^ 1;
+}
+
+// Constructor
+EARS_pwmManager::EARS_pwmManager() : _tableCount(0), _fadeInstalled(false)
+{
+    memset(_channels, 0, sizeof(_channels));
+}
+
+// Allocate and configure an LEDC channel for a pin
+int8_t EARS_pwmManager::attach(uint8_t pin, uint32_t frequency, uint8_t resolution,
+                               const char *owner, uint8_t preferredChannel)
+{
+    const uint16_t *table = dutyTableFor(resolution);
+    if (table == nullptr)
+    {
+        Serial.printf("[PWMManager] ERROR: No duty table slot for %d-bit resolution\n", resolution);
+        return -1;
+    }
+
+    // Preferred channel first, then any compatible one
+    int8_t channel = -1;
+    if (preferredChannel < PWM_MAX_CHANNELS && isCompatible(preferredChannel, frequency, resolution))
+    {
+        channel = preferredChannel;
+    }
+    else
+    {
+        for (uint8_t i = 0; i < PWM_MAX_CHANNELS; i++)
+        {
+            if (isCompatible(i, frequency, resolution))
+            {
+                channel = i;
+                break;
+            }
+        }
+    }
+
+    if (channel < 0)
+    {
+        Serial.printf("[PWMManager] ERROR: No compatible channel for %s (%d Hz, %d-bit)\n",
+                      owner ? owner : "?", frequency, resolution);
+        return -1;
+    }
+
+    if (preferredChannel != PWM_CHANNEL_ANY && channel != preferredChannel)
+    {
+        Serial.printf("[PWMManager] %s: channel %d busy or timer mismatch, using %d\n",
+                      owner ? owner : "?", preferredChannel, channel);
+    }
+
+    ledcSetup(channel, frequency, resolution);
+    ledcAttachPin(pin, channel);
+    ledcWrite(channel, 0);
+
+    ChannelSlot &slot = _channels[channel];
+    slot.used = true;
+    slot.pin = pin;
+    slot.resolution = resolution;
+    slot.frequency = frequency;
+    slot.owner = owner;
+    slot.dutyTable = table;
+
+    return channel;
+}
+
+// Release a channel and detach its pin
+void EARS_pwmManager::detach(int8_t channel)
+{
+    if (!isValid(channel))
+    {
+        return;
+    }
+
+    ledcWrite(channel, 0);
+    ledcDetachPin(_channels[channel].pin);
+    memset(&_channels[channel], 0, sizeof(ChannelSlot));
+}
+
+// Set duty from a percentage through the duty table
+void EARS_pwmManager::writePercent(int8_t channel, uint8_t percent)
+{
+    if (!isValid(channel))
+    {
+        return;
+    }
+
+    ledcWrite(channel, percentToDuty(channel, percent));
+}
+
+// Set a raw duty value
+void EARS_pwmManager::writeDuty(int8_t channel, uint32_t duty)
+{
+    if (!isValid(channel))
+    {
+        return;
+    }
+
+    ledcWrite(channel, duty);
+}
+
+// Duty value for a percentage
+uint32_t EARS_pwmManager::percentToDuty(int8_t channel, uint8_t percent) const
+{
+    if (!isValid(channel))
+    {
+        return 0;
+    }
+
+    if (percent > 100)
+    {
+        percent = 100;
+    }
+
+    return _channels[channel].dutyTable[percent];
+}
+
+// Largest duty value for a channel's resolution
+uint32_t EARS_pwmManager::getMaxDuty(int8_t channel) const
+{
+    if (!isValid(channel))
+    {
+        return 0;
+    }
+
+    return (1UL << _channels[channel].resolution) - 1;
+}
+
+// Start a hardware fade to a percentage
+bool EARS_pwmManager::fadePercent(int8_t channel, uint8_t percent, uint32_t durationMs)
+{
+    if (!isValid(channel))
+    {
+        return false;
+    }
+
+    // Fade service is shared by every channel, install it on first use
+    if (!_fadeInstalled)
+    {
+        if (ledc_fade_func_install(0) != ESP_OK)
+        {
+            Serial.println("[PWMManager] ERROR: LEDC fade service unavailable");
+            return false;
+        }
+        _fadeInstalled = true;
+    }
+
+    ledc_mode_t mode = (ledc_mode_t)(channel / 8);
+    ledc_channel_t ledcChannel = (ledc_channel_t)(channel % 8);
+
+    if (ledc_set_fade_with_time(mode, ledcChannel, percentToDuty(channel, percent), durationMs) != ESP_OK)
+    {
+        return false;
+    }
+
+    return (ledc_fade_start(mode, ledcChannel, LEDC_FADE_NO_WAIT) == ESP_OK);
+}
+
+// Owner of a channel
+const char *EARS_pwmManager::getOwner(int8_t channel) const
+{
+    return isValid(channel) ? _channels[channel].owner : nullptr;
+}
+
+// Print the channel allocation to Serial
+void EARS_pwmManager::printAllocation() const
+{
+    Serial.println("[PWMManager] Channel allocation:");
+    for (uint8_t i = 0; i < PWM_MAX_CHANNELS; i++)
+    {
+        const ChannelSlot &slot = _channels[i];
+        if (slot.used)
+        {
+            Serial.printf("  CH%d: pin %d, %d Hz, %d-bit (%s)\n",
+                          i, slot.pin, slot.frequency, slot.resolution,
+                          slot.owner ? slot.owner : "?");
+        }
+    }
+}
+
+// Check that a channel's timer can run at frequency/resolution
+bool EARS_pwmManager::isCompatible(uint8_t channel, uint32_t frequency, uint8_t resolution) const
+{
+    if (channel >= PWM_MAX_CHANNELS || _channels[channel].used)
+    {
+        return false;
+    }
+
+    uint8_t peer = timerPeer(channel);
+    if (peer < PWM_MAX_CHANNELS && _channels[peer].used)
+    {
+        return (_channels[peer].frequency == frequency && _channels[peer].resolution == resolution);
+    }
+
+    return true;
+}
+
+// Find or build the duty table for a resolution
+const uint16_t *EARS_pwmManager::dutyTableFor(uint8_t resolution)
+{
+    if (resolution == 0 || resolution > 14)
+    {
+        return nullptr;
+    }
+
+    for (uint8_t i = 0; i < _tableCount; i++)
+    {
+        if (_tables[i].resolution == resolution)
+        {
+            return _tables[i].duty;
+        }
+    }
+
+    if (_tableCount >= PWM_MAX_DUTY_TABLES)
+    {
+        return nullptr;
+    }
+
+    // Linear mapping: 0% = 0, 100% = max duty
+    DutyTable &table = _tables[_tableCount++];
+    uint32_t maxDuty = (1UL << resolution) - 1;
+    table.resolution = resolution;
+    for (uint8_t percent = 0; percent <= 100; percent++)
+    {
+        table.duty[percent] = (uint16_t)((maxDuty * percent) / 100);
+    }
+
+    return table.duty;
+}
+
+// Check a channel handle refers to an allocated channel
+bool EARS_pwmManager::isValid(int8_t channel) const
+{
+    return (channel >= 0 && channel < PWM_MAX_CHANNELS && _channels[channel].used);
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char *EARS_pwmManager::getLibraryName()
+{
+    return EARS_PwmManager::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t EARS_pwmManager::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_PwmManager::VERSION_MAJOR,
+                       EARS_PwmManager::VERSION_MINOR,
+                       EARS_PwmManager::VERSION_PATCH);
+}
+
+// Get version date
+const char *EARS_pwmManager::getVersionDate()
+{
+    return EARS_PwmManager::VERSION_DATE;
+}
+
+// Format version as string
+void EARS_pwmManager::getVersionString(char *buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/**
+ * @brief Get reference to global PWM manager instance (Singleton pattern)
+ *
+ * @return EARS_pwmManager& Reference to the global PWM manager instance
+ */
+EARS_pwmManager &using_pwmmanager()
+{
+    static EARS_pwmManager instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_pwmManagerLib.cpp
+ *****************************************************************************/
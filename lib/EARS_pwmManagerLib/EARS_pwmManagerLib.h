@@ -0,0 +1,196 @@
+/**
+ * @file EARS_pwmManagerLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Shared LEDC PWM channel and timer allocation
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * Features:
+ * - Allocates LEDC channels so consumers cannot collide
+ * - Keeps channels that share an LEDC timer on one frequency/resolution
+ * - Precomputed 0-100% duty table per resolution (constant-time writes)
+ * - Hardware fades (LEDC fade unit) for any consumer
+ *
+ * @details
+ * The Arduino LEDC driver ties channel pairs (0/1, 2/3, ...) to one timer,
+ * so ledcSetup() on one channel silently retunes its neighbour. attach()
+ * only hands out a channel whose timer is free or already runs at the
+ * requested frequency and resolution.
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_PWM_MANAGER_LIB_H__
+#define __EARS_PWM_MANAGER_LIB_H__
+
+/******************************************************************************
+ * Includes Information
+ *****************************************************************************/
+#include <Arduino.h>
+#include <driver/ledc.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_PwmManager
+{
+    constexpr const char *LIB_NAME = "EARS_pwmManager";
+    constexpr const char *VERSION_MAJOR = "1";
+    constexpr const char *VERSION_MINOR = "0";
+    constexpr const char *VERSION_PATCH = "0";
+    constexpr const char *VERSION_DATE = "2026-10-14";
+}
+
+/******************************************************************************
+ * PWM Configuration
+ *****************************************************************************/
+
+// LEDC channels available to the Arduino driver
+#define PWM_MAX_CHANNELS SOC_LEDC_CHANNEL_NUM
+
+// attach() may pick any free channel
+#define PWM_CHANNEL_ANY 0xFF
+
+// Distinct resolutions that can have a duty table at once
+#define PWM_MAX_DUTY_TABLES 4
+
+class EARS_pwmManager
+{
+public:
+    /**
+     * @brief Construct a new PWM Manager
+     */
+    EARS_pwmManager();
+
+    // Version information getters
+    static const char *getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char *getVersionDate();
+    static void getVersionString(char *buffer);
+
+    /**
+     * @brief Allocate and configure an LEDC channel for a pin
+     * @param pin GPIO pin to drive
+     * @param frequency PWM frequency in Hz
+     * @param resolution PWM resolution in bits (1-14)
+     * @param owner Consumer name for diagnostics (static string)
+     * @param preferredChannel Channel to use if compatible (PWM_CHANNEL_ANY)
+     * @return int8_t Allocated channel, or -1 if none is compatible
+     */
+    int8_t attach(uint8_t pin, uint32_t frequency, uint8_t resolution,
+                  const char *owner, uint8_t preferredChannel = PWM_CHANNEL_ANY);
+
+    /**
+     * @brief Release a channel and detach its pin
+     * @param channel Channel returned by attach()
+     */
+    void detach(int8_t channel);
+
+    /**
+     * @brief Set duty from a percentage through the duty table
+     * @param channel Allocated channel
+     * @param percent Duty percentage (0-100)
+     */
+    void writePercent(int8_t channel, uint8_t percent);
+
+    /**
+     * @brief Set a raw duty value
+     * @param channel Allocated channel
+     * @param duty Duty (0-getMaxDuty)
+     */
+    void writeDuty(int8_t channel, uint32_t duty);
+
+    /**
+     * @brief Duty value for a percentage (table lookup, ISR/critical safe)
+     * @param channel Allocated channel
+     * @param percent Duty percentage (0-100)
+     * @return uint32_t Raw duty
+     */
+    uint32_t percentToDuty(int8_t channel, uint8_t percent) const;
+
+    /**
+     * @brief Largest duty value for a channel's resolution
+     * @param channel Allocated channel
+     * @return uint32_t Maximum duty (0 if not allocated)
+     */
+    uint32_t getMaxDuty(int8_t channel) const;
+
+    /**
+     * @brief Start a hardware fade to a percentage (returns immediately)
+     * @param channel Allocated channel
+     * @param percent Target duty percentage (0-100)
+     * @param durationMs Fade time in milliseconds
+     * @return true if the LEDC fade unit accepted the fade
+     * @note Hardware fades are linear in duty. Do not start a software
+     *       ramp on the same channel while one is running.
+     */
+    bool fadePercent(int8_t channel, uint8_t percent, uint32_t durationMs);
+
+    /**
+     * @brief Owner of a channel
+     * @param channel Channel number
+     * @return const char* Owner name, or nullptr if free
+     */
+    const char *getOwner(int8_t channel) const;
+
+    /**
+     * @brief Print the channel allocation to Serial
+     */
+    void printAllocation() const;
+
+private:
+    struct ChannelSlot
+    {
+        bool used;
+        uint8_t pin;
+        uint8_t resolution;
+        uint32_t frequency;
+        const char *owner;
+        const uint16_t *dutyTable;
+    };
+
+    struct DutyTable
+    {
+        uint8_t resolution;
+        uint16_t duty[101];
+    };
+
+    ChannelSlot _channels[PWM_MAX_CHANNELS];
+    DutyTable _tables[PWM_MAX_DUTY_TABLES];
+    uint8_t _tableCount;
+    bool _fadeInstalled;
+
+    /**
+     * @brief Check that a channel's timer can run at frequency/resolution
+     * @param channel Candidate channel
+     * @param frequency PWM frequency in Hz
+     * @param resolution PWM resolution in bits
+     * @return true if the channel is free and its timer is free or matching
+     */
+    bool isCompatible(uint8_t channel, uint32_t frequency, uint8_t resolution) const;
+
+    /**
+     * @brief Find or build the duty table for a resolution
+     * @param resolution PWM resolution in bits
+     * @return const uint16_t* Table of 101 duty values, nullptr if full
+     */
+    const uint16_t *dutyTableFor(uint8_t resolution);
+
+    /**
+     * @brief Check a channel handle refers to an allocated channel
+     * @param channel Channel handle
+     * @return true if valid and allocated
+     */
+    bool isValid(int8_t channel) const;
+};
+
+// Global instance access function
+EARS_pwmManager &using_pwmmanager();
+
+#endif // __EARS_PWM_MANAGER_LIB_H__
+
+/******************************************************************************
+ * End of EARS_pwmManagerLib.h
+ *****************************************************************************/
@@ -0,0 +1,1478 @@
+/**
+ * @file EARS_recordStoreLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Indexed equipment and ammunition record store on the SD card
+ * @version 1.8.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EARS_recordStoreLib.h"
+#include "EARS_systemDef.h"
+#include <esp_timer.h>
+#include <esp_heap_caps.h>
+#include <esp_rom_crc.h>
+
+/******************************************************************************
+ * File Formats
+ *****************************************************************************/
+#define RECORD_INDEX_MAGIC 0x58444945 // "EIDX"
+#define RECORD_WAL_MAGIC 0x4C415745   // "EWAL"
+#define RECORD_INDEX_LAYOUT ((2UL << 16) | RECORD_SIZE)
+#define RECORD_GROUP_NONE 0xFFFF      // Tombstone entries count nowhere
+
+// <name>.idx: header, primaryCount PrimaryEntry, then the group table
+struct IndexHeader
+{
+    uint32_t magic;
+    uint32_t layout;
+    uint32_t datRecords;   // .dat records the entries account for
+    uint32_t sequence;
+    uint32_t primaryCount;
+    uint32_t groupCount;   // Group slots named
+    uint32_t crc;          // CRC-32 of the entries and the group table
+};
+
+// <name>.wal (before 1.5.0): count records, then this trailer
+struct WalTrailer
+{
+    uint32_t magic;
+    uint32_t datRecords;   // .dat length (records) before the batch
+    uint32_t count;
+    uint32_t crc;          // CRC-32 of the records
+};
+
+/******************************************************************************
+ * Helpers
+ *****************************************************************************/
+
+// Index arrays grow in PSRAM when there is any, internal RAM otherwise
+static void *storeRealloc(void *ptr, size_t size)
+{
+    void *grown = heap_caps_realloc(ptr, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    return grown ? grown : heap_caps_realloc(ptr, size, MALLOC_CAP_8BIT);
+}
+
+static int zapCompare(const char *a, const char *b)
+{
+    return strncmp(a, b, RECORD_ZAP_SIZE);
+}
+
+/******************************************************************************
+ * Construction
+ *****************************************************************************/
+EARS_recordStore::EARS_recordStore()
+    : _sdCard(nullptr),
+      _crypt(nullptr),
+      _datFile{},
+      _type(RECORD_EQUIPMENT),
+      _mutex(nullptr),
+      _ready(false),
+      _primary(nullptr),
+      _zaps(nullptr),
+      _primaryCount(0),
+      _zapCount(0),
+      _capacity(0),
+      _datRecords(0),
+      _checkpointRecords(0),
+      _sequence(0),
+      _replayed(0),
+      _openUs(0),
+      _indexDirty(false),
+      _lastWriteMs(0),
+      _unsorted(false),
+      _groupCount(0),
+      _listener(nullptr),
+      _listenerCtx(nullptr),
+      _batch(nullptr),
+      _batchCount(0),
+      _batchOpen(false)
+{
+    _datPath[0] = '\0';
+    _idxPath[0] = '\0';
+    _walPath[0] = '\0';
+    clearGroups();
+}
+
+bool EARS_recordStore::begin(EARS_sdCard* sdCard, const char* name, EARS_recordType type, EARS_sdCrypt* crypt)
+{
+    if (_ready)
+    {
+        return true;
+    }
+
+    if (!sdCard || !sdCard->isAvailable() || (crypt && !crypt->isReady()))
+    {
+        return false;
+    }
+
+    if (!_mutex)
+    {
+        _mutex = xSemaphoreCreateMutex();
+        if (!_mutex)
+        {
+            return false;
+        }
+    }
+
+    int64_t startUs = esp_timer_get_time();
+
+    _sdCard = sdCard;
+    _crypt = crypt;
+    _type = type;
+    snprintf(_datPath, sizeof(_datPath), "%s/%s.%s", RECORD_STORE_DIR, name, _crypt ? "edat" : "dat");
+    snprintf(_idxPath, sizeof(_idxPath), "%s/%s.%s", RECORD_STORE_DIR, name, _crypt ? "eidx" : "idx");
+    snprintf(_walPath, sizeof(_walPath), "%s/%s.wal", RECORD_STORE_DIR, name);
+
+    if (!_sdCard->directoryExists(RECORD_STORE_DIR))
+    {
+        _sdCard->createDirectory(RECORD_STORE_DIR);
+    }
+
+    // First encrypted boot: take over the plaintext store
+    if (_crypt && (!_crypt->openFile(*_sdCard, _datPath, _datFile) || !encryptPlain(name)))
+    {
+        return false;
+    }
+
+    if (!_batch)
+    {
+        _batch = (EARS_record *)malloc(sizeof(EARS_record) * RECORD_BATCH_MAX);
+    }
+    if (!_batch || !reserve(RECORD_INDEX_INITIAL))
+    {
+        return false;
+    }
+
+    // A WAL batch from older firmware that maybe did not reach .dat
+    recoverWal();
+
+    // Whole records only; a torn append leaves a short tail
+    uint32_t datBytes = _sdCard->getFileSize(_datPath);
+    _datRecords = datBytes / RECORD_SIZE;
+    if (datBytes % RECORD_SIZE)
+    {
+        datTruncate(_datRecords);
+    }
+    trimTail();
+
+    // Checkpoint first, then only what was appended after it
+    uint32_t covered = 0;
+    if (!loadIndex(covered))
+    {
+        _primaryCount = 0;
+        _sequence = 0;
+        covered = 0;
+        clearGroups();
+    }
+    _checkpointRecords = covered;
+    _replayed = 0;
+
+    _ready = replay(covered);
+    if (_ready && _replayed > 0)
+    {
+        _indexDirty = true;
+        _lastWriteMs = millis();
+    }
+
+    _openUs = (uint32_t)(esp_timer_get_time() - startUs);
+
+#if EARS_DEBUG == 1
+    Serial.printf("[RECORDS] %s: %lu items, %lu records (%lu replayed) in %lu us\n",
+                  _datPath, (unsigned long)_primaryCount, (unsigned long)_datRecords,
+                  (unsigned long)_replayed, (unsigned long)_openUs);
+#endif
+
+    return _ready;
+}
+
+/******************************************************************************
+ * Record Helpers
+ *****************************************************************************/
+uint32_t EARS_recordStore::recordCrc(const EARS_record& record)
+{
+    EARS_record copy = record;
+    copy.header.crc = 0;
+    return esp_rom_crc32_le(0, (const uint8_t *)&copy, sizeof(copy));
+}
+
+bool EARS_recordStore::recordValid(const EARS_record& record)
+{
+    return record.header.type != 0 && record.header.crc == recordCrc(record);
+}
+
+bool EARS_recordStore::readRecord(uint32_t recordNo, EARS_record& record)
+{
+    size_t got = datRead(recordNo, &record, 1);
+    return got == RECORD_SIZE && recordValid(record);
+}
+
+/******************************************************************************
+ * File Access
+ *****************************************************************************/
+
+// .dat reads and appends, through the encryption layer when there is one
+size_t EARS_recordStore::datRead(uint32_t recordNo, void* out, uint32_t count)
+{
+    size_t bytes = count * RECORD_SIZE;
+    return _crypt ? _crypt->readDataAt(*_sdCard, _datFile, recordNo * RECORD_SIZE, (uint8_t *)out, bytes)
+                  : _sdCard->readDataAt(_datPath, recordNo * RECORD_SIZE, (uint8_t *)out, bytes);
+}
+
+bool EARS_recordStore::datAppend(uint32_t recordNo, const void* records, uint32_t count)
+{
+    size_t bytes = count * RECORD_SIZE;
+    return _crypt ? _crypt->appendData(*_sdCard, _datFile, recordNo * RECORD_SIZE, (const uint8_t *)records, bytes)
+                  : _sdCard->appendData(_datPath, (const uint8_t *)records, bytes);
+}
+
+// Cut .dat back to whole records; an encrypted store's next append gets a new epoch
+bool EARS_recordStore::datTruncate(uint32_t records)
+{
+    return _crypt ? _crypt->truncateFile(*_sdCard, _datFile, records * RECORD_SIZE)
+                  : _sdCard->truncateFile(_datPath, records * RECORD_SIZE);
+}
+
+// Decrypt .idx bytes after the sealed image's IV; nothing to do for a plaintext store
+bool EARS_recordStore::cipher(const uint8_t* iv, uint32_t offset, void* data, size_t length)
+{
+    return !_crypt || _crypt->unsealImage(_idxPath, iv, offset, (uint8_t *)data, length);
+}
+
+/**
+ * @brief Encrypt a plaintext <name>.dat into .edat, then remove it and .idx
+ * @details The plaintext .dat goes last, so while it exists any .edat
+ *          beside it is from a copy a reset interrupted and is started
+ *          again. A failure removes the partial .edat and leaves the
+ *          plaintext files as they were.
+ * @return true if there was nothing to do or the store was encrypted
+ */
+bool EARS_recordStore::encryptPlain(const char* name)
+{
+    char plainDat[40];
+    char plainIdx[40];
+    snprintf(plainDat, sizeof(plainDat), "%s/%s.dat", RECORD_STORE_DIR, name);
+    snprintf(plainIdx, sizeof(plainIdx), "%s/%s.idx", RECORD_STORE_DIR, name);
+    if (!_sdCard->fileExists(plainDat))
+    {
+        return true;
+    }
+    if (_sdCard->fileExists(_datPath))
+    {
+        datTruncate(0);
+    }
+
+    EARS_record *chunk = (EARS_record *)malloc(sizeof(EARS_record) * RECORD_SCAN_RECORDS);
+    if (!chunk)
+    {
+        return false;
+    }
+
+    // Whole records only, as begin() would have trimmed them
+    uint32_t records = _sdCard->getFileSize(plainDat) / RECORD_SIZE;
+    bool ok = true;
+    for (uint32_t recordNo = 0; ok && recordNo < records;)
+    {
+        uint32_t want = records - recordNo;
+        if (want > RECORD_SCAN_RECORDS)
+            want = RECORD_SCAN_RECORDS;
+
+        ok = _sdCard->readDataAt(plainDat, recordNo * RECORD_SIZE, (uint8_t *)chunk, want * RECORD_SIZE) ==
+                 want * RECORD_SIZE &&
+             datAppend(recordNo, chunk, want);
+        recordNo += want;
+    }
+    free(chunk);
+    _sdCard->flush(_datPath);
+
+    if (!ok)
+    {
+        if (_sdCard->fileExists(_datPath))
+        {
+            datTruncate(0);
+        }
+        return false;
+    }
+
+    if (_sdCard->fileExists(plainIdx))
+    {
+        _sdCard->removeFile(plainIdx);
+    }
+    _sdCard->removeFile(plainDat);
+
+#if EARS_DEBUG == 1
+    Serial.printf("[RECORDS] %s: %lu records encrypted\n", _datPath, (unsigned long)records);
+#endif
+    return true;
+}
+
+/******************************************************************************
+ * Index Maintenance
+ *****************************************************************************/
+bool EARS_recordStore::reserve(uint32_t entries)
+{
+    if (entries <= _capacity)
+    {
+        return true;
+    }
+
+    uint32_t capacity = _capacity ? _capacity : RECORD_INDEX_INITIAL;
+    while (capacity < entries)
+    {
+        capacity *= 2;
+    }
+
+    PrimaryEntry *primary = (PrimaryEntry *)storeRealloc(_primary, capacity * sizeof(PrimaryEntry));
+    if (!primary)
+    {
+        return false;
+    }
+    _primary = primary;
+
+    ZapEntry *zaps = (ZapEntry *)storeRealloc(_zaps, capacity * sizeof(ZapEntry));
+    if (!zaps)
+    {
+        return false;
+    }
+    _zaps = zaps;
+
+    _capacity = capacity;
+    return true;
+}
+
+uint32_t EARS_recordStore::primaryLowerBound(uint32_t id) const
+{
+    uint32_t lo = 0;
+    uint32_t hi = _primaryCount;
+    while (lo < hi)
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (_primary[mid].id < id)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+uint32_t EARS_recordStore::zapLowerBound(const char* zap, uint32_t id) const
+{
+    uint32_t lo = 0;
+    uint32_t hi = _zapCount;
+    while (lo < hi)
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+        int order = zapCompare(_zaps[mid].zap, zap);
+        if (order < 0 || (order == 0 && _zaps[mid].id < id))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief Apply one committed record to both indexes (live writes)
+ */
+void EARS_recordStore::indexRecord(const EARS_record& record, uint32_t recordNo)
+{
+    uint32_t id = record.header.id;
+    unindex(id);
+
+    if (record.header.flags & RECORD_FLAG_DELETED)
+    {
+        return;
+    }
+    if (!reserve(_primaryCount + 1))
+    {
+        return;
+    }
+
+    uint32_t pos = primaryLowerBound(id);
+    memmove(&_primary[pos + 1], &_primary[pos], (_primaryCount - pos) * sizeof(PrimaryEntry));
+    fillEntry(_primary[pos], record, recordNo);
+    countEntry(_primary[pos], true);
+    _primaryCount++;
+
+    if (record.header.zap[0])
+    {
+        uint32_t zpos = zapLowerBound(record.header.zap, id);
+        memmove(&_zaps[zpos + 1], &_zaps[zpos], (_zapCount - zpos) * sizeof(ZapEntry));
+        memcpy(_zaps[zpos].zap, record.header.zap, RECORD_ZAP_SIZE);
+        _zaps[zpos].id = id;
+        _zaps[zpos].recordNo = recordNo;
+        _zapCount++;
+    }
+}
+
+void EARS_recordStore::unindex(uint32_t id)
+{
+    uint32_t pos = primaryLowerBound(id);
+    if (pos >= _primaryCount || _primary[pos].id != id)
+    {
+        return;
+    }
+    countEntry(_primary[pos], false);
+
+    if (_primary[pos].zap[0])
+    {
+        uint32_t zpos = zapLowerBound(_primary[pos].zap, id);
+        if (zpos < _zapCount && _zaps[zpos].id == id)
+        {
+            memmove(&_zaps[zpos], &_zaps[zpos + 1], (_zapCount - zpos - 1) * sizeof(ZapEntry));
+            _zapCount--;
+        }
+    }
+
+    memmove(&_primary[pos], &_primary[pos + 1], (_primaryCount - pos - 1) * sizeof(PrimaryEntry));
+    _primaryCount--;
+}
+
+// Replay order: by ID, then oldest version first
+int EARS_recordStore::comparePrimary(const void *a, const void *b)
+{
+    const PrimaryEntry *ea = (const PrimaryEntry *)a;
+    const PrimaryEntry *eb = (const PrimaryEntry *)b;
+    if (ea->id != eb->id)
+        return ea->id < eb->id ? -1 : 1;
+    uint32_t ra = ea->recordNo & ~RECORD_TOMBSTONE_BIT;
+    uint32_t rb = eb->recordNo & ~RECORD_TOMBSTONE_BIT;
+    return (ra > rb) - (ra < rb);
+}
+
+/**
+ * @brief Sort raw replayed entries and keep the newest live version per ID
+ * @details One sort instead of an insert per record, so a full rebuild of
+ *          thousands of records stays O(n log n)
+ */
+void EARS_recordStore::normalise()
+{
+    qsort(_primary, _primaryCount, sizeof(PrimaryEntry), comparePrimary);
+
+    uint32_t out = 0;
+    for (uint32_t i = 0; i < _primaryCount; i++)
+    {
+        if (i + 1 < _primaryCount && _primary[i + 1].id == _primary[i].id)
+        {
+            continue; // A newer version follows
+        }
+        if (_primary[i].recordNo & RECORD_TOMBSTONE_BIT)
+        {
+            continue;
+        }
+        _primary[out++] = _primary[i];
+    }
+    _primaryCount = out;
+
+    rebuildZaps();
+    rebuildGroups();
+}
+
+/**
+ * @brief Sort entries appended by putMany() before the index is used
+ */
+void EARS_recordStore::settle()
+{
+    if (_unsorted)
+    {
+        normalise();
+        _unsorted = false;
+    }
+}
+
+int EARS_recordStore::compareZap(const void *a, const void *b)
+{
+    const ZapEntry *za = (const ZapEntry *)a;
+    const ZapEntry *zb = (const ZapEntry *)b;
+    int order = zapCompare(za->zap, zb->zap);
+    if (order != 0)
+        return order;
+    return (za->id > zb->id) - (za->id < zb->id);
+}
+
+void EARS_recordStore::rebuildZaps()
+{
+    _zapCount = 0;
+    for (uint32_t i = 0; i < _primaryCount; i++)
+    {
+        if (_primary[i].zap[0])
+        {
+            memcpy(_zaps[_zapCount].zap, _primary[i].zap, RECORD_ZAP_SIZE);
+            _zaps[_zapCount].id = _primary[i].id;
+            _zaps[_zapCount].recordNo = _primary[i].recordNo;
+            _zapCount++;
+        }
+    }
+    qsort(_zaps, _zapCount, sizeof(ZapEntry), compareZap);
+}
+
+/******************************************************************************
+ * Group Totals
+ *****************************************************************************/
+
+/**
+ * @brief Set up an index entry for a record, group slot included
+ */
+void EARS_recordStore::fillEntry(PrimaryEntry& entry, const EARS_record& record, uint32_t recordNo)
+{
+    entry.id = record.header.id;
+    entry.recordNo = recordNo;
+    memcpy(entry.zap, record.header.zap, RECORD_ZAP_SIZE);
+    entry.reserved = 0;
+
+    if (record.header.flags & RECORD_FLAG_DELETED)
+    {
+        entry.quantity = 0;
+        entry.group = RECORD_GROUP_NONE;
+    }
+    else if (_type == RECORD_AMMUNITION)
+    {
+        entry.quantity = ((const EARS_ammunitionData *)record.payload)->quantity;
+        entry.group = groupSlot(record);
+    }
+    else
+    {
+        entry.quantity = ((const EARS_equipmentData *)record.payload)->quantity;
+        entry.group = groupSlot(record);
+    }
+}
+
+/**
+ * @brief Find or name the group slot for a record's category or calibre
+ * @details A full table reuses a slot whose items have all gone; failing
+ *          that the record counts under "(other)"
+ */
+uint16_t EARS_recordStore::groupSlot(const EARS_record& record)
+{
+    char name[RECORD_GROUP_NAME_SIZE];
+    const char *field = _type == RECORD_AMMUNITION
+                            ? ((const EARS_ammunitionData *)record.payload)->calibre
+                            : ((const EARS_equipmentData *)record.payload)->category;
+    memcpy(name, field, RECORD_GROUP_NAME_SIZE - 1);
+    name[RECORD_GROUP_NAME_SIZE - 1] = '\0';
+
+    uint16_t empty = RECORD_GROUP_NONE;
+    for (uint16_t i = 0; i < _groupCount; i++)
+    {
+        if (strcmp(_groups[i].name, name) == 0)
+        {
+            return i;
+        }
+        if (empty == RECORD_GROUP_NONE && _groups[i].items == 0)
+        {
+            empty = i;
+        }
+    }
+
+    uint16_t slot;
+    if (_groupCount < RECORD_GROUP_MAX)
+    {
+        slot = _groupCount++;
+    }
+    else if (empty != RECORD_GROUP_NONE)
+    {
+        slot = empty;
+    }
+    else
+    {
+        return RECORD_GROUP_MAX;
+    }
+
+    memcpy(_groups[slot].name, name, RECORD_GROUP_NAME_SIZE);
+    _groups[slot].items = 0;
+    _groups[slot].quantity = 0;
+    return slot;
+}
+
+void EARS_recordStore::countEntry(const PrimaryEntry& entry, bool add)
+{
+    if (entry.group > RECORD_GROUP_MAX)
+    {
+        return;
+    }
+
+    EARS_recordGroup &group = _groups[entry.group];
+    if (add)
+    {
+        group.items++;
+        group.quantity += entry.quantity;
+    }
+    else
+    {
+        group.items--;
+        group.quantity -= entry.quantity;
+    }
+}
+
+/**
+ * @brief Recount the totals from the index (after normalise())
+ * @details Slot names are kept, so the entries' group numbers stay valid
+ */
+void EARS_recordStore::rebuildGroups()
+{
+    for (uint16_t i = 0; i <= RECORD_GROUP_MAX; i++)
+    {
+        _groups[i].items = 0;
+        _groups[i].quantity = 0;
+    }
+    for (uint32_t i = 0; i < _primaryCount; i++)
+    {
+        countEntry(_primary[i], true);
+    }
+}
+
+void EARS_recordStore::clearGroups()
+{
+    memset(_groups, 0, sizeof(_groups));
+    strlcpy(_groups[RECORD_GROUP_MAX].name, "(other)", RECORD_GROUP_NAME_SIZE);
+    _groupCount = 0;
+}
+
+/******************************************************************************
+ * Index Checkpoint and Replay
+ *****************************************************************************/
+
+/**
+ * @brief Load the checkpoint written by checkpoint()
+ * @param covered Set to the .dat records the checkpoint accounts for
+ * @return true if the checkpoint is usable
+ */
+bool EARS_recordStore::loadIndex(uint32_t& covered)
+{
+    File file = _sdCard->openRead(_idxPath);
+    if (!file)
+    {
+        return false;
+    }
+
+    // Encrypted: the image's IV comes first, in clear
+    uint8_t iv[SDCRYPT_IV_BYTES];
+    size_t ivBytes = _crypt ? sizeof(iv) : 0;
+    IndexHeader header;
+    bool ok = file.read(iv, ivBytes) == ivBytes &&
+              file.read((uint8_t *)&header, sizeof(header)) == sizeof(header) &&
+              cipher(iv, 0, &header, sizeof(header)) &&
+              header.magic == RECORD_INDEX_MAGIC &&
+              header.layout == RECORD_INDEX_LAYOUT &&
+              header.datRecords <= _datRecords &&
+              header.groupCount <= RECORD_GROUP_MAX &&
+              file.size() == ivBytes + sizeof(header) + header.primaryCount * sizeof(PrimaryEntry) + sizeof(_groups) &&
+              reserve(header.primaryCount);
+
+    if (ok)
+    {
+        size_t bytes = header.primaryCount * sizeof(PrimaryEntry);
+        ok = file.read((uint8_t *)_primary, bytes) == bytes &&
+             cipher(iv, sizeof(header), _primary, bytes) &&
+             file.read((uint8_t *)_groups, sizeof(_groups)) == sizeof(_groups) &&
+             cipher(iv, sizeof(header) + bytes, _groups, sizeof(_groups));
+        ok = ok && esp_rom_crc32_le(esp_rom_crc32_le(0, (const uint8_t *)_primary, bytes),
+                                    (const uint8_t *)_groups, sizeof(_groups)) == header.crc;
+    }
+    file.close();
+
+    if (!ok)
+    {
+        return false;
+    }
+
+    _primaryCount = header.primaryCount;
+    _groupCount = header.groupCount;
+    _sequence = header.sequence;
+    covered = header.datRecords;
+    rebuildZaps();
+    return true;
+}
+
+/**
+ * @brief Add .dat records from fromRecord onwards to the indexes
+ * @return true unless the index could not grow
+ */
+bool EARS_recordStore::replay(uint32_t fromRecord)
+{
+    if (fromRecord >= _datRecords)
+    {
+        return true;
+    }
+
+    EARS_record *chunk = (EARS_record *)malloc(sizeof(EARS_record) * RECORD_SCAN_RECORDS);
+    if (!chunk)
+    {
+        return false;
+    }
+
+    bool ok = true;
+    uint32_t recordNo = fromRecord;
+    while (ok && recordNo < _datRecords)
+    {
+        uint32_t want = _datRecords - recordNo;
+        if (want > RECORD_SCAN_RECORDS)
+            want = RECORD_SCAN_RECORDS;
+
+        size_t got = datRead(recordNo, chunk, want);
+        uint32_t records = got / RECORD_SIZE;
+        if (records == 0)
+        {
+            break;
+        }
+
+        for (uint32_t i = 0; i < records; i++, recordNo++)
+        {
+            const EARS_record &record = chunk[i];
+            if (!recordValid(record))
+            {
+#if EARS_DEBUG == 1
+                Serial.printf("[RECORDS] %s: bad record %lu skipped\n", _datPath, (unsigned long)recordNo);
+#endif
+                continue;
+            }
+
+            if (!reserve(_primaryCount + 1))
+            {
+                ok = false;
+                break;
+            }
+
+            PrimaryEntry &entry = _primary[_primaryCount++];
+            fillEntry(entry, record, recordNo);
+            if (record.header.flags & RECORD_FLAG_DELETED)
+            {
+                entry.recordNo |= RECORD_TOMBSTONE_BIT;
+            }
+            countEntry(entry, true);
+
+            if (record.header.sequence > _sequence)
+            {
+                _sequence = record.header.sequence;
+            }
+            _replayed++;
+        }
+    }
+
+    free(chunk);
+    normalise();
+    return ok;
+}
+
+bool EARS_recordStore::checkpoint()
+{
+    if (!_ready)
+    {
+        return false;
+    }
+
+    lock();
+    if (!_indexDirty)
+    {
+        unlock();
+        return true;
+    }
+    settle();
+
+    // Encrypted: room for the IV sealImage() puts in front
+    size_t ivBytes = _crypt ? SDCRYPT_IV_BYTES : 0;
+    size_t entries = _primaryCount * sizeof(PrimaryEntry);
+    size_t total = ivBytes + sizeof(IndexHeader) + entries + sizeof(_groups);
+    uint8_t *image = (uint8_t *)storeRealloc(nullptr, total);
+    if (!image)
+    {
+        unlock();
+        return false;
+    }
+
+    IndexHeader *header = (IndexHeader *)(image + ivBytes);
+    header->magic = RECORD_INDEX_MAGIC;
+    header->layout = RECORD_INDEX_LAYOUT;
+    header->datRecords = _datRecords;
+    header->sequence = _sequence;
+    header->primaryCount = _primaryCount;
+    header->groupCount = _groupCount;
+    header->crc = esp_rom_crc32_le(esp_rom_crc32_le(0, (const uint8_t *)_primary, entries),
+                                   (const uint8_t *)_groups, sizeof(_groups));
+    memcpy(image + ivBytes + sizeof(IndexHeader), _primary, entries);
+    memcpy(image + ivBytes + sizeof(IndexHeader) + entries, _groups, sizeof(_groups));
+
+    bool ok = (!_crypt || _crypt->sealImage(_idxPath, image, total)) &&
+              _sdCard->writeFileAtomic(_idxPath, image, total);
+    heap_caps_free(image);
+
+    if (ok)
+    {
+        _indexDirty = false;
+        _checkpointRecords = _datRecords;
+    }
+    unlock();
+    return ok;
+}
+
+void EARS_recordStore::setListener(EARS_recordListener listener, void* ctx)
+{
+    lock();
+    _listener = listener;
+    _listenerCtx = ctx;
+    unlock();
+}
+
+void EARS_recordStore::service()
+{
+    if (!_ready || !_indexDirty)
+    {
+        return;
+    }
+
+    // A steady stream never goes quiet; bound the boot replay anyway
+    if (millis() - _lastWriteMs < RECORD_CHECKPOINT_DELAY_MS &&
+        _datRecords - _checkpointRecords < RECORD_CHECKPOINT_RECORDS)
+    {
+        return;
+    }
+
+    checkpoint();
+}
+
+/******************************************************************************
+ * Journal Recovery
+ *****************************************************************************/
+
+/**
+ * @brief Re-apply a committed batch left in a WAL by firmware before 1.5.0
+ * @return true if there was nothing to do or the batch was applied
+ */
+bool EARS_recordStore::recoverWal()
+{
+    if (!_sdCard->fileExists(_walPath))
+    {
+        return true;
+    }
+
+    uint32_t size = _sdCard->getFileSize(_walPath);
+    bool ok = false;
+    uint8_t *image = (size >= sizeof(WalTrailer) && size <= RECORD_BATCH_MAX * RECORD_SIZE + sizeof(WalTrailer))
+                         ? (uint8_t *)malloc(size)
+                         : nullptr;
+
+    if (image && _sdCard->readInto(_walPath, image, size) == size)
+    {
+        WalTrailer trailer;
+        memcpy(&trailer, image + size - sizeof(trailer), sizeof(trailer));
+        size_t bytes = trailer.count * RECORD_SIZE;
+
+        if (trailer.magic == RECORD_WAL_MAGIC &&
+            bytes + sizeof(trailer) == size &&
+            esp_rom_crc32_le(0, image, bytes) == trailer.crc)
+        {
+            // Undo any part of the batch that reached .dat, then append it whole
+            ok = datTruncate(trailer.datRecords) &&
+                 datAppend(trailer.datRecords, image, trailer.count);
+            _sdCard->flush(_datPath);
+
+#if EARS_DEBUG == 1
+            Serial.printf("[RECORDS] %s: WAL batch of %lu re-applied\n", _datPath, (unsigned long)trailer.count);
+#endif
+        }
+    }
+    free(image);
+
+    // Uncommitted, corrupt or now applied: the WAL is finished with
+    _sdCard->removeFile(_walPath);
+    return ok;
+}
+
+/**
+ * @brief Cut .dat back to the end of the last whole commit
+ * @details The final record of a commit has following == 0 and a good CRC.
+ *          Anything after the last such record is a torn append or part of
+ *          a batch the reset interrupted; a batch is at most
+ *          RECORD_BATCH_MAX records, so only that many are read.
+ */
+void EARS_recordStore::trimTail()
+{
+    uint32_t window = _datRecords < RECORD_BATCH_MAX ? _datRecords : RECORD_BATCH_MAX;
+    if (window == 0)
+    {
+        return;
+    }
+
+    EARS_record *tail = (EARS_record *)malloc(sizeof(EARS_record) * window);
+    if (!tail)
+    {
+        return;
+    }
+
+    uint32_t first = _datRecords - window;
+    uint32_t keep = _datRecords;
+    size_t got = datRead(first, tail, window);
+    if (got == window * RECORD_SIZE)
+    {
+        while (keep > first)
+        {
+            const EARS_record &record = tail[keep - 1 - first];
+            if (recordValid(record) && record.header.following == 0)
+            {
+                break;
+            }
+            keep--;
+        }
+    }
+    free(tail);
+
+    if (keep < _datRecords)
+    {
+#if EARS_DEBUG == 1
+        Serial.printf("[RECORDS] %s: %lu records of an unfinished commit dropped\n",
+                      _datPath, (unsigned long)(_datRecords - keep));
+#endif
+        _datRecords = keep;
+        datTruncate(_datRecords);
+    }
+}
+
+/**
+ * @brief Append committed records to .dat and index them
+ * @details The whole commit is one append. Each record is resealed with
+ *          the number of records after it, so begin() can tell a finished
+ *          batch from one a reset cut short.
+ */
+bool EARS_recordStore::applyRecords(EARS_record* records, uint8_t count)
+{
+    settle();
+
+    for (uint8_t i = 0; i + 1 < count; i++)
+    {
+        records[i].header.following = count - 1 - i;
+        records[i].header.crc = recordCrc(records[i]);
+    }
+
+    bool ok = datAppend(_datRecords, records, count);
+    _sdCard->flush(_datPath);
+
+    if (!ok)
+    {
+        // Back out a partial append so .dat stays whole records
+        datTruncate(_datRecords);
+    }
+    else
+    {
+        for (uint8_t i = 0; i < count; i++)
+        {
+            bool existed = false;
+            if (_listener)
+            {
+                uint32_t pos = primaryLowerBound(records[i].header.id);
+                existed = pos < _primaryCount && _primary[pos].id == records[i].header.id;
+            }
+            indexRecord(records[i], _datRecords + i);
+            if (_listener)
+            {
+                _listener(&records[i], existed, _listenerCtx);
+            }
+        }
+        _datRecords += count;
+        _indexDirty = true;
+        _lastWriteMs = millis();
+    }
+    return ok;
+}
+
+/******************************************************************************
+ * Writes
+ *****************************************************************************/
+
+/**
+ * @brief Seal a record and commit it, or stage it in the open batch
+ */
+bool EARS_recordStore::stage(EARS_record& record)
+{
+    record.header.type = _type;
+    record.header.following = 0;
+    record.header.sequence = ++_sequence;
+    record.header.crc = recordCrc(record);
+
+    if (_batchOpen)
+    {
+        if (_batchCount >= RECORD_BATCH_MAX)
+        {
+            return false;
+        }
+        _batch[_batchCount++] = record;
+        return true;
+    }
+
+    return applyRecords(&record, 1);
+}
+
+bool EARS_recordStore::put(const EARS_record& record)
+{
+    if (!_ready)
+    {
+        return false;
+    }
+
+    EARS_record copy = record;
+    copy.header.flags &= ~(RECORD_FLAG_DELETED | RECORD_FLAG_PEER);
+    copy.header.zap[RECORD_ZAP_SIZE - 1] = '\0';
+
+    lock();
+    bool ok = stage(copy);
+    unlock();
+    return ok;
+}
+
+bool EARS_recordStore::putPeer(const EARS_record& record)
+{
+    if (!_ready)
+    {
+        return false;
+    }
+
+    EARS_record copy = record;
+    bool deleted = copy.header.flags & RECORD_FLAG_DELETED;
+    copy.header.flags = (deleted ? RECORD_FLAG_DELETED : 0) | RECORD_FLAG_PEER;
+    copy.header.zap[RECORD_ZAP_SIZE - 1] = '\0';
+
+    lock();
+    bool ok = !_batchOpen;
+    bool needed = true;
+    if (ok && deleted)
+    {
+        settle();
+        uint32_t pos = primaryLowerBound(copy.header.id);
+        needed = pos < _primaryCount && _primary[pos].id == copy.header.id;
+    }
+    if (ok && needed)
+    {
+        ok = stage(copy);
+    }
+    unlock();
+    return ok;
+}
+
+bool EARS_recordStore::remove(uint32_t id)
+{
+    if (!_ready)
+    {
+        return false;
+    }
+
+    lock();
+    settle();
+    uint32_t pos = primaryLowerBound(id);
+    bool known = pos < _primaryCount && _primary[pos].id == id;
+
+    // An ID staged earlier in the open batch can be removed too
+    for (uint8_t i = 0; !known && i < _batchCount; i++)
+    {
+        known = _batch[i].header.id == id;
+    }
+
+    bool ok = false;
+    if (known)
+    {
+        EARS_record tombstone;
+        memset(&tombstone, 0, sizeof(tombstone));
+        tombstone.header.id = id;
+        tombstone.header.flags = RECORD_FLAG_DELETED;
+        ok = stage(tombstone);
+    }
+    unlock();
+    return ok;
+}
+
+bool EARS_recordStore::beginBatch()
+{
+    if (!_ready)
+    {
+        return false;
+    }
+
+    lock();
+    bool ok = !_batchOpen;
+    if (ok)
+    {
+        _batchOpen = true;
+        _batchCount = 0;
+    }
+    unlock();
+    return ok;
+}
+
+bool EARS_recordStore::commit()
+{
+    lock();
+    bool ok = _batchOpen && (_batchCount == 0 || applyRecords(_batch, _batchCount));
+    _batchOpen = false;
+    _batchCount = 0;
+    unlock();
+    return ok;
+}
+
+void EARS_recordStore::abortBatch()
+{
+    lock();
+    _batchOpen = false;
+    _batchCount = 0;
+    unlock();
+}
+
+bool EARS_recordStore::putMany(EARS_record* records, size_t count)
+{
+    if (!_ready || !records)
+    {
+        return false;
+    }
+    if (count == 0)
+    {
+        return true;
+    }
+
+    lock();
+    if (_batchOpen || !reserve(_primaryCount + count))
+    {
+        unlock();
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        EARS_record &record = records[i];
+        record.header.flags &= ~(RECORD_FLAG_DELETED | RECORD_FLAG_PEER);
+        record.header.zap[RECORD_ZAP_SIZE - 1] = '\0';
+        record.header.type = _type;
+        record.header.following = 0;
+        record.header.sequence = ++_sequence;
+        record.header.crc = recordCrc(record);
+    }
+
+    bool ok = datAppend(_datRecords, records, count);
+    if (!ok)
+    {
+        datTruncate(_datRecords);
+        unlock();
+        return false;
+    }
+
+    // Raw entries, sorted once by the next lookup (settle())
+    for (size_t i = 0; i < count; i++)
+    {
+        PrimaryEntry &entry = _primary[_primaryCount++];
+        fillEntry(entry, records[i], _datRecords + i);
+        countEntry(entry, true);
+    }
+    _datRecords += count;
+    _unsorted = true;
+    _indexDirty = true;
+    _lastWriteMs = millis();
+
+    if (_listener)
+    {
+        _listener(nullptr, false, _listenerCtx);
+    }
+    unlock();
+    return true;
+}
+
+uint32_t EARS_recordStore::count()
+{
+    lock();
+    settle();
+    uint32_t items = _primaryCount;
+    unlock();
+    return items;
+}
+
+EARS_recordTotals EARS_recordStore::getTotals()
+{
+    EARS_recordTotals totals;
+    memset(&totals, 0, sizeof(totals));
+
+    lock();
+    settle();
+    totals.items = _primaryCount;
+    totals.assigned = _zapCount;
+    for (uint16_t i = 0; i <= RECORD_GROUP_MAX; i++)
+    {
+        totals.quantity += _groups[i].quantity;
+        if (_groups[i].items)
+        {
+            totals.groups++;
+        }
+    }
+    unlock();
+    return totals;
+}
+
+size_t EARS_recordStore::getGroups(EARS_recordGroup* out, size_t max)
+{
+    if (!out)
+    {
+        return 0;
+    }
+
+    lock();
+    settle();
+    size_t found = 0;
+    for (uint16_t i = 0; i < _groupCount && found < max; i++)
+    {
+        if (_groups[i].items)
+        {
+            out[found++] = _groups[i];
+        }
+    }
+    if (_groups[RECORD_GROUP_MAX].items && found < max)
+    {
+        out[found++] = _groups[RECORD_GROUP_MAX];
+    }
+    unlock();
+    return found;
+}
+
+/******************************************************************************
+ * Queries
+ *****************************************************************************/
+bool EARS_recordStore::get(uint32_t id, EARS_record& record)
+{
+    if (!_ready)
+    {
+        return false;
+    }
+
+    lock();
+    settle();
+    uint32_t pos = primaryLowerBound(id);
+    bool ok = pos < _primaryCount && _primary[pos].id == id &&
+              readRecord(_primary[pos].recordNo, record);
+    unlock();
+    return ok;
+}
+
+bool EARS_recordStore::contains(uint32_t id)
+{
+    lock();
+    settle();
+    uint32_t pos = primaryLowerBound(id);
+    bool found = pos < _primaryCount && _primary[pos].id == id;
+    unlock();
+    return found;
+}
+
+size_t EARS_recordStore::queryRange(uint32_t firstId, uint32_t lastId, EARS_record* out, size_t max,
+                                    EARS_recordCursor& cursor)
+{
+    if (!_ready || !out || cursor.done)
+    {
+        return 0;
+    }
+
+    if (!cursor.started)
+    {
+        cursor.nextId = firstId;
+        cursor.started = true;
+    }
+
+    lock();
+    settle();
+    size_t found = 0;
+    uint32_t pos = primaryLowerBound(cursor.nextId);
+    while (found < max && pos < _primaryCount && _primary[pos].id <= lastId)
+    {
+        const PrimaryEntry &entry = _primary[pos++];
+        if (readRecord(entry.recordNo, out[found]))
+        {
+            found++;
+        }
+        if (entry.id == UINT32_MAX)
+        {
+            cursor.done = true;
+            break;
+        }
+        cursor.nextId = entry.id + 1;
+    }
+    if (pos >= _primaryCount || _primary[pos].id > lastId)
+    {
+        cursor.done = true;
+    }
+    unlock();
+    return found;
+}
+
+size_t EARS_recordStore::queryZap(const char* zap, EARS_record* out, size_t max, EARS_recordCursor& cursor)
+{
+    if (!_ready || !out || !zap || cursor.done)
+    {
+        return 0;
+    }
+
+    if (!cursor.started)
+    {
+        cursor.nextId = 0;
+        cursor.started = true;
+    }
+
+    lock();
+    settle();
+    size_t found = 0;
+    uint32_t pos = zapLowerBound(zap, cursor.nextId);
+    while (found < max && pos < _zapCount && zapCompare(_zaps[pos].zap, zap) == 0)
+    {
+        const ZapEntry &entry = _zaps[pos++];
+        if (readRecord(entry.recordNo, out[found]))
+        {
+            found++;
+        }
+        if (entry.id == UINT32_MAX)
+        {
+            cursor.done = true;
+            break;
+        }
+        cursor.nextId = entry.id + 1;
+    }
+    if (pos >= _zapCount || zapCompare(_zaps[pos].zap, zap) != 0)
+    {
+        cursor.done = true;
+    }
+    unlock();
+    return found;
+}
+
+size_t EARS_recordStore::readPage(uint32_t position, EARS_record* out, size_t max)
+{
+    if (!_ready || !out)
+    {
+        return 0;
+    }
+
+    lock();
+    settle();
+    size_t found = 0;
+    while (found < max && position < _primaryCount)
+    {
+        if (readRecord(_primary[position++].recordNo, out[found]))
+        {
+            found++;
+        }
+    }
+    unlock();
+    return found;
+}
+
+size_t EARS_recordStore::readChanges(uint32_t fromRecord, EARS_record* out, size_t max, uint32_t& nextRecord)
+{
+    nextRecord = fromRecord;
+    if (!_ready || !out)
+    {
+        return 0;
+    }
+
+    lock();
+    settle();
+    size_t found = 0;
+    uint32_t recordNo = fromRecord;
+    while (found < max && recordNo < _datRecords)
+    {
+        // Read straight into the free tail of out, then keep the current ones
+        uint32_t want = _datRecords - recordNo;
+        if (want > max - found)
+            want = max - found;
+
+        size_t got = datRead(recordNo, &out[found], want);
+        uint32_t records = got / RECORD_SIZE;
+        if (records == 0)
+        {
+            break;
+        }
+
+        size_t read = found;
+        for (uint32_t i = 0; i < records; i++, recordNo++)
+        {
+            const EARS_record &record = out[read + i];
+            if (!recordValid(record))
+            {
+                continue;
+            }
+
+            // Live versions are current if the index points at them;
+            // tombstones if the ID has not been written again since
+            uint32_t pos = primaryLowerBound(record.header.id);
+            bool indexed = pos < _primaryCount && _primary[pos].id == record.header.id;
+            bool current = (record.header.flags & RECORD_FLAG_DELETED)
+                               ? !indexed
+                               : indexed && _primary[pos].recordNo == recordNo;
+            if (current)
+            {
+                if (found != read + i)
+                {
+                    memcpy(&out[found], &record, RECORD_SIZE);
+                }
+                found++;
+            }
+        }
+    }
+    nextRecord = recordNo;
+    unlock();
+    return found;
+}
+
+/******************************************************************************
+ * Locking
+ *****************************************************************************/
+void EARS_recordStore::lock()
+{
+    if (_mutex)
+    {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+    }
+}
+
+void EARS_recordStore::unlock()
+{
+    if (_mutex)
+    {
+        xSemaphoreGive(_mutex);
+    }
+}
+
+/******************************************************************************
+ * Version Information
+ *****************************************************************************/
+const char* EARS_recordStore::getLibraryName()
+{
+    return EARS_RecordStore::LIB_NAME;
+}
+
+uint32_t EARS_recordStore::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_RecordStore::VERSION_MAJOR,
+                       EARS_RecordStore::VERSION_MINOR,
+                       EARS_RecordStore::VERSION_PATCH);
+}
+
+const char* EARS_recordStore::getVersionDate()
+{
+    return EARS_RecordStore::VERSION_DATE;
+}
+
+void EARS_recordStore::getVersionString(char* buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+EARS_recordStore &using_equipment()
+{
+    static EARS_recordStore instance;
+    return instance;
+}
+
+EARS_recordStore &using_ammunition()
+{
+    static EARS_recordStore instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_recordStoreLib.cpp
+ *****************************************************************************/
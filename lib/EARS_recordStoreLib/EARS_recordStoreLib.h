@@ -0,0 +1,477 @@
+/**
+ * @file EARS_recordStoreLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Indexed equipment and ammunition record store on the SD card
+ * @details Each store is three files under RECORD_STORE_DIR:
+ *
+ *          <name>.dat  Append-only segment of fixed RECORD_SIZE records.
+ *                      An update appends a new version of the record, a
+ *                      delete appends a tombstone; the newest version wins.
+ *          <name>.idx  Item ID index checkpointed from RAM, plus how many
+ *                      .dat records it covers. Records past that are
+ *                      replayed at begin(), so a stale index only costs a
+ *                      short scan; the zap number index is rebuilt from it.
+ *
+ *          .dat is the journal: every record carries a sequence number and
+ *          a CRC, and header.following counts the records after it in the
+ *          same commit(), so a batch is one sequential append with no side
+ *          file. begin() trims the tail back to the end of the last whole
+ *          commit, which drops a torn record or a batch cut short by a
+ *          reset; a batch lands completely or not at all. The index is
+ *          checkpointed when writes go quiet, and at least every
+ *          RECORD_CHECKPOINT_RECORDS records under a steady stream, so a
+ *          boot after an unclean shutdown replays only that short tail.
+ *          A <name>.wal left by firmware before 1.5.0 is still applied.
+ *
+ *          Both indexes live in RAM (PSRAM when present) as sorted arrays,
+ *          so a lookup is a binary search plus one 128-byte read, and range
+ *          and zap queries page through the index with a cursor.
+ *
+ *          putMany() is the bulk path for imports: one append per call,
+ *          each record standing alone, with the new index entries sorted
+ *          once by the next lookup rather than inserted one by one.
+ *
+ *          Since .dat is append-only, a record number is also a change
+ *          watermark: readChanges() returns what was written after it,
+ *          current versions and tombstones only, for delta sync.
+ *
+ *          Dashboard totals are kept as writes happen rather than counted
+ *          when shown: each index entry carries its item's quantity and
+ *          group (category for equipment, calibre for ammunition), every
+ *          insert, update or delete moves its quantity between the running
+ *          totals of up to RECORD_GROUP_MAX groups, and the table goes into
+ *          the .idx checkpoint with the entries. getTotals() and
+ *          getGroups() cost the same for ten items or a hundred thousand.
+ *
+ *          Given an EARS_sdCrypt at begin(), .dat and .idx are kept
+ *          encrypted as <name>.edat and <name>.eidx (AES-256-CTR, so every
+ *          .dat offset above is unchanged). .edat is an append-only
+ *          EARS_sdCryptFile with its epoch log <name>.edat.ep, so records
+ *          appended again after a trim or a failed append get a fresh
+ *          keystream; each .eidx checkpoint is sealed under a new IV.
+ *          Plaintext files found then are encrypted once and removed; the
+ *          index is rebuilt by replay.
+ *
+ *          putPeer() writes a version received from another unit
+ *          (EARS_peerSyncLib) like put(), flagged RECORD_FLAG_PEER so it is
+ *          not taken for a local change; put() and putMany() clear the flag.
+ *
+ * @version 1.8.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_RECORD_STORE_LIB_H__
+#define __EARS_RECORD_STORE_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "EARS_versionDef.h"
+#include "EARS_sdCardLib.h"
+#include "EARS_sdCryptLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_RecordStore
+{
+    constexpr const char* LIB_NAME = "EARS_recordStore";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "8";
+    constexpr const char* VERSION_PATCH = "1";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+#define RECORD_STORE_DIR "/data"
+#define RECORD_SIZE 128                // Bytes per record on disk (4 per sector)
+#define RECORD_ZAP_SIZE 8              // Zap number, 7 characters + NUL
+#define RECORD_INDEX_INITIAL 256       // Index entries allocated at begin(), doubles as needed
+#define RECORD_BATCH_MAX 16            // Records per commit()
+#define RECORD_SCAN_RECORDS 32         // Records per read while replaying .dat
+#define RECORD_CHECKPOINT_DELAY_MS 5000 // Quiet time before service() writes the index
+#define RECORD_CHECKPOINT_RECORDS 512  // Or this many records since the last one, quiet or not
+#define RECORD_GROUP_MAX 64            // Categories/calibres totalled; more share "(other)"
+#define RECORD_GROUP_NAME_SIZE 17      // Category/calibre field + NUL
+
+#define RECORD_FLAG_DELETED 0x01       // Tombstone: the ID no longer exists
+#define RECORD_FLAG_PEER 0x02          // Written by putPeer(): another unit's change
+#define RECORD_TOMBSTONE_BIT 0x80000000UL // Marks a tombstone in a raw index entry
+
+/**
+ * @brief What a record holds
+ */
+enum EARS_recordType : uint8_t
+{
+    RECORD_EQUIPMENT = 1,
+    RECORD_AMMUNITION = 2
+};
+
+/******************************************************************************
+ * Record Layout
+ *****************************************************************************/
+
+/**
+ * @brief Fixed header at the start of every record
+ */
+struct __attribute__((packed)) EARS_recordHeader
+{
+    uint32_t id;                 // Item ID (primary key)
+    char zap[RECORD_ZAP_SIZE];   // Zap number of the holder ("" = unassigned)
+    uint8_t type;                // EARS_recordType
+    uint8_t flags;               // RECORD_FLAG_*
+    uint16_t following;          // Records after this one in the same commit()
+    uint32_t sequence;           // Store-wide write counter
+    uint32_t crc;                // CRC-32 of the record with this field zero
+};
+
+#define RECORD_PAYLOAD_SIZE (RECORD_SIZE - sizeof(EARS_recordHeader))
+
+/**
+ * @brief One record as stored
+ */
+struct __attribute__((packed)) EARS_record
+{
+    EARS_recordHeader header;
+    uint8_t payload[RECORD_PAYLOAD_SIZE];
+};
+
+/**
+ * @brief Payload of a RECORD_EQUIPMENT record
+ */
+struct __attribute__((packed)) EARS_equipmentData
+{
+    char name[32];
+    char serial[24];
+    char category[16];
+    uint16_t quantity;
+    uint8_t status;              // Application defined (issued, stored, repair...)
+    uint8_t reserved;
+    uint32_t inspectedDate;      // YYYYMMDD, 0 = never
+    uint32_t issuedDate;         // YYYYMMDD, 0 = not issued
+    char nsn[20];                // NATO stock number, e.g. "1005-01-231-0973"
+};
+
+/**
+ * @brief Payload of a RECORD_AMMUNITION record
+ */
+struct __attribute__((packed)) EARS_ammunitionData
+{
+    char calibre[16];
+    char lot[24];
+    char description[32];
+    uint32_t quantity;
+    uint32_t expiryDate;         // YYYYMMDD, 0 = none
+    uint32_t receivedDate;       // YYYYMMDD
+};
+
+static_assert(sizeof(EARS_record) == RECORD_SIZE, "EARS_record must be RECORD_SIZE bytes");
+static_assert(sizeof(EARS_equipmentData) <= RECORD_PAYLOAD_SIZE, "Equipment payload too large");
+static_assert(sizeof(EARS_ammunitionData) <= RECORD_PAYLOAD_SIZE, "Ammunition payload too large");
+
+/**
+ * @brief Position in a paged query; zero-initialise before the first page
+ * @details Resumes by key, so writes between pages do not skip or repeat items
+ */
+struct EARS_recordCursor
+{
+    uint32_t nextId;             // Smallest ID the next page may return
+    bool started;
+    bool done;
+};
+
+/**
+ * @brief Running totals for one category (equipment) or calibre (ammunition)
+ */
+struct EARS_recordGroup
+{
+    char name[RECORD_GROUP_NAME_SIZE];
+    uint32_t items;
+    uint32_t quantity;
+};
+
+/**
+ * @brief Running totals for a whole store
+ */
+struct EARS_recordTotals
+{
+    uint32_t items;              // Live items
+    uint32_t quantity;           // Sum of their quantities
+    uint32_t assigned;           // Items held by a zap number
+    uint16_t groups;             // Groups with at least one item
+};
+
+/**
+ * @brief Called for each committed record, with the store locked
+ * @param record New version, or a tombstone (RECORD_FLAG_DELETED); NULL
+ *        after putMany(), when many records changed at once
+ * @param existed The ID was live before this record
+ * @param ctx Context given to setListener()
+ * @note Must not call back into the store
+ */
+typedef void (*EARS_recordListener)(const EARS_record* record, bool existed, void* ctx);
+
+/******************************************************************************
+ * EARS_recordStore Class
+ *****************************************************************************/
+class EARS_recordStore
+{
+public:
+    EARS_recordStore();
+
+    // Version information getters
+    static const char* getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char* getVersionDate();
+    static void getVersionString(char* buffer);
+
+    /**
+     * @brief Open (or create) a store and build its indexes
+     * @details Trims an unfinished commit off the end of .dat, loads
+     *          the index checkpoint and replays newer records.
+     * @param sdCard Mounted SD card
+     * @param name File name stem under RECORD_STORE_DIR
+     * @param type Record type this store holds
+     * @param crypt Ready encryption layer to keep the files encrypted (nullptr: plaintext)
+     * @return true if the store is usable
+     */
+    bool begin(EARS_sdCard* sdCard, const char* name, EARS_recordType type, EARS_sdCrypt* crypt = nullptr);
+
+    bool isReady() const { return _ready; }
+    EARS_recordType getType() const { return _type; }
+
+    /**
+     * @brief Insert or replace a record (ID taken from the header)
+     * @details Inside beginBatch()/commit() the record is staged;
+     *          otherwise it is committed on its own
+     * @return true if written (or staged)
+     */
+    bool put(const EARS_record& record);
+
+    /**
+     * @brief Delete an item by ID
+     * @return true if a tombstone was written (or staged); false if unknown
+     */
+    bool remove(uint32_t id);
+
+    /**
+     * @brief Write a version or tombstone received from another unit
+     * @details Flagged RECORD_FLAG_PEER. A tombstone for an ID that is not
+     *          live writes nothing. Not allowed inside a batch.
+     * @return true if written, or nothing was needed
+     */
+    bool putPeer(const EARS_record& record);
+
+    /**
+     * @brief Append many records at once (bulk import)
+     * @details Records are sealed in place and written with one append.
+     *          Each record is its own commit, so a reset keeps a whole
+     *          prefix of the call. Not allowed inside a batch.
+     * @param records Records to insert or replace (modified)
+     * @param count Number of records
+     * @return true if all were written
+     */
+    bool putMany(EARS_record* records, size_t count);
+
+    // Group up to RECORD_BATCH_MAX puts/removes into one all-or-nothing append
+    bool beginBatch();
+    bool commit();
+    void abortBatch();
+
+    /**
+     * @brief Fetch the current version of an item
+     * @return true if found
+     */
+    bool get(uint32_t id, EARS_record& record);
+
+    bool contains(uint32_t id);
+
+    /**
+     * @brief Page through items with firstId <= ID <= lastId in ID order
+     * @param out Records returned
+     * @param max Capacity of out
+     * @param cursor Zeroed for the first page, then passed back unchanged
+     * @return size_t Records returned, 0 once the range is exhausted
+     */
+    size_t queryRange(uint32_t firstId, uint32_t lastId, EARS_record* out, size_t max,
+                      EARS_recordCursor& cursor);
+
+    /**
+     * @brief Page through the items held by a zap number, in ID order
+     */
+    size_t queryZap(const char* zap, EARS_record* out, size_t max, EARS_recordCursor& cursor);
+
+    /**
+     * @brief Read items by position in ID order (0 = lowest ID)
+     * @details For views that address rows by number, such as a scrolled list
+     * @param position First index position
+     * @param out Records returned
+     * @param max Capacity of out
+     * @return size_t Records returned (fewer at the end of the store)
+     */
+    size_t readPage(uint32_t position, EARS_record* out, size_t max);
+
+    /**
+     * @brief Read records written at or after a .dat record number
+     * @details Versions superseded by a later write are skipped, so each
+     *          returned record is the item's current version or its
+     *          tombstone, in write order
+     * @param fromRecord First record number (0 = everything)
+     * @param out Records returned
+     * @param max Capacity of out
+     * @param nextRecord Receives the record number to resume from
+     * @return size_t Records returned; 0 with nextRecord == getRecordCount()
+     *         when there is nothing newer
+     */
+    size_t readChanges(uint32_t fromRecord, EARS_record* out, size_t max, uint32_t& nextRecord);
+
+    /**
+     * @brief Write the index checkpoint now
+     * @return true if nothing was pending or the write succeeded
+     */
+    bool checkpoint();
+
+    /**
+     * @brief Follow committed writes, for derived indexes kept elsewhere
+     * @param listener Called per record from put/remove/commit, NULL to stop
+     * @param ctx Passed to listener
+     */
+    void setListener(EARS_recordListener listener, void* ctx);
+
+    /**
+     * @brief Checkpoint the index once writes have been quiet long enough
+     * @details Call periodically from Core 1
+     */
+    void service();
+
+    uint32_t count();                                       // Live items
+    uint32_t getRecordCount() const { return _datRecords; }  // Versions on disk
+    uint32_t getReplayedRecords() const { return _replayed; } // Scanned at begin()
+    uint32_t getOpenTimeUs() const { return _openUs; }
+    uint32_t getSequence() const { return _sequence; }    // Last write counter issued
+    EARS_sdCrypt* getCrypt() const { return _crypt; }     // nullptr: plaintext files
+
+    /**
+     * @brief Store-wide totals, without reading any records
+     */
+    EARS_recordTotals getTotals();
+
+    /**
+     * @brief Totals per category or calibre, without reading any records
+     * @details Groups with no items are left out; groups beyond
+     *          RECORD_GROUP_MAX are summed into one named "(other)", last
+     * @param out Groups returned, in the order first seen
+     * @param max Capacity of out (RECORD_GROUP_MAX + 1 for all)
+     * @return size_t Groups returned
+     */
+    size_t getGroups(EARS_recordGroup* out, size_t max);
+
+private:
+    // Index entries, kept sorted; the zap index is rebuilt from the primary
+    struct PrimaryEntry
+    {
+        uint32_t id;
+        uint32_t recordNo;       // RECORD_TOMBSTONE_BIT set only while replaying
+        char zap[RECORD_ZAP_SIZE];
+        uint32_t quantity;       // Counted in _groups[group]
+        uint16_t group;
+        uint16_t reserved;
+    };
+    struct ZapEntry
+    {
+        char zap[RECORD_ZAP_SIZE];
+        uint32_t id;
+        uint32_t recordNo;
+    };
+
+    EARS_sdCard* _sdCard;
+    EARS_sdCrypt* _crypt;        // nullptr: plaintext files
+    EARS_sdCryptFile _datFile;   // .edat's epochs, with _crypt
+    EARS_recordType _type;
+    char _datPath[40];
+    char _idxPath[40];
+    char _walPath[40];
+    SemaphoreHandle_t _mutex;
+    bool _ready;
+
+    PrimaryEntry* _primary;
+    ZapEntry* _zaps;
+    uint32_t _primaryCount;
+    uint32_t _zapCount;
+    uint32_t _capacity;
+
+    uint32_t _datRecords;        // Whole records in .dat
+    uint32_t _checkpointRecords; // .dat records the last checkpoint covers
+    uint32_t _sequence;
+    uint32_t _replayed;
+    uint32_t _openUs;
+    bool _indexDirty;
+    uint32_t _lastWriteMs;
+    bool _unsorted;              // putMany() appended raw primary entries
+
+    // Totals of every entry in _primary, raw ones included until normalise()
+    EARS_recordGroup _groups[RECORD_GROUP_MAX + 1]; // The last is "(other)"
+    uint16_t _groupCount;        // Slots named
+
+    EARS_recordListener _listener;
+    void* _listenerCtx;
+
+    EARS_record* _batch;         // RECORD_BATCH_MAX staged records
+    uint8_t _batchCount;
+    bool _batchOpen;
+
+    // Index maintenance
+    bool reserve(uint32_t entries);
+    void normalise();
+    void settle();
+    void rebuildZaps();
+    static int comparePrimary(const void* a, const void* b);
+    static int compareZap(const void* a, const void* b);
+    uint32_t primaryLowerBound(uint32_t id) const;
+    uint32_t zapLowerBound(const char* zap, uint32_t id) const;
+    void indexRecord(const EARS_record& record, uint32_t recordNo);
+    void unindex(uint32_t id);
+    void fillEntry(PrimaryEntry& entry, const EARS_record& record, uint32_t recordNo);
+    uint16_t groupSlot(const EARS_record& record);
+    void countEntry(const PrimaryEntry& entry, bool add);
+    void rebuildGroups();
+    void clearGroups();
+
+    // Files
+    bool loadIndex(uint32_t& covered);
+    bool replay(uint32_t fromRecord);
+    bool recoverWal();
+    void trimTail();
+    bool applyRecords(EARS_record* records, uint8_t count);
+    bool readRecord(uint32_t recordNo, EARS_record& record);
+    bool stage(EARS_record& record);
+    size_t datRead(uint32_t recordNo, void* out, uint32_t count);
+    bool datAppend(uint32_t recordNo, const void* records, uint32_t count);
+    bool datTruncate(uint32_t records);
+    bool cipher(const uint8_t* iv, uint32_t offset, void* data, size_t length);
+    bool encryptPlain(const char* name);
+
+    static uint32_t recordCrc(const EARS_record& record);
+    static bool recordValid(const EARS_record& record);
+
+    void lock();
+    void unlock();
+};
+
+// Global instance access functions (Singleton pattern)
+EARS_recordStore &using_equipment();
+EARS_recordStore &using_ammunition();
+
+#endif // __EARS_RECORD_STORE_LIB_H__
+
+/******************************************************************************
+ * End of EARS_recordStoreLib.h
+ ******************************************************************************/
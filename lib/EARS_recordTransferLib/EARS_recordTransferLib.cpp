@@ -0,0 +1,881 @@
+/**
+ * @file EARS_recordTransferLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Streaming bulk import and export of record stores (CSV, JSON Lines)
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EARS_recordTransferLib.h"
+#include "EARS_systemDef.h"
+#include <esp_heap_caps.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Field Tables
+ *****************************************************************************/
+enum : uint8_t
+{
+    FIELD_TEXT = 0,
+    FIELD_U8,
+    FIELD_U16,
+    FIELD_U32
+};
+
+#define HEADER_FIELD(name, kind, member) \
+    { name, kind, (uint8_t)offsetof(EARS_recordHeader, member), (uint8_t)sizeof(((EARS_recordHeader *)0)->member) }
+#define PAYLOAD_FIELD(name, kind, type, member) \
+    { name, kind, (uint8_t)(offsetof(EARS_record, payload) + offsetof(type, member)), (uint8_t)sizeof(((type *)0)->member) }
+
+/******************************************************************************
+ * Helpers
+ *****************************************************************************/
+
+// Chunk and line buffers are large and short-lived: PSRAM when there is any
+static void *transferAlloc(size_t size)
+{
+    void *block = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    return block ? block : heap_caps_malloc(size, MALLOC_CAP_8BIT);
+}
+
+/******************************************************************************
+ * Construction
+ *****************************************************************************/
+EARS_recordTransfer::EARS_recordTransfer()
+    : _sdCard(nullptr),
+      _store(nullptr),
+      _format(TRANSFER_CSV),
+      _exporting(false),
+      _callback(nullptr),
+      _ctx(nullptr),
+      _cancel(false),
+      _buffer(nullptr),
+      _bufferPos(0),
+      _bufferLen(0),
+      _lineLen(0),
+      _lineOverflow(false),
+      _eof(false),
+      _chunk(nullptr),
+      _chunkCount(0),
+      _position(0),
+      _fields(nullptr),
+      _fieldCount(0),
+      _columnCount(0),
+      _headerDone(false),
+      _startMs(0)
+{
+    _path[0] = '\0';
+    _partPath[0] = '\0';
+    memset(&_progress, 0, sizeof(_progress));
+    _mux = portMUX_INITIALIZER_UNLOCKED;
+}
+
+// Column order of exports; imports match CSV columns and JSON keys by name
+const EARS_recordTransfer::FieldDef* EARS_recordTransfer::fieldsFor(EARS_recordType type, uint8_t& count)
+{
+    static const FieldDef equipment[] = {
+        HEADER_FIELD("id", FIELD_U32, id),
+        HEADER_FIELD("zap", FIELD_TEXT, zap),
+        PAYLOAD_FIELD("name", FIELD_TEXT, EARS_equipmentData, name),
+        PAYLOAD_FIELD("serial", FIELD_TEXT, EARS_equipmentData, serial),
+        PAYLOAD_FIELD("nsn", FIELD_TEXT, EARS_equipmentData, nsn),
+        PAYLOAD_FIELD("category", FIELD_TEXT, EARS_equipmentData, category),
+        PAYLOAD_FIELD("quantity", FIELD_U16, EARS_equipmentData, quantity),
+        PAYLOAD_FIELD("status", FIELD_U8, EARS_equipmentData, status),
+        PAYLOAD_FIELD("inspected", FIELD_U32, EARS_equipmentData, inspectedDate),
+        PAYLOAD_FIELD("issued", FIELD_U32, EARS_equipmentData, issuedDate),
+    };
+    static const FieldDef ammunition[] = {
+        HEADER_FIELD("id", FIELD_U32, id),
+        HEADER_FIELD("zap", FIELD_TEXT, zap),
+        PAYLOAD_FIELD("calibre", FIELD_TEXT, EARS_ammunitionData, calibre),
+        PAYLOAD_FIELD("lot", FIELD_TEXT, EARS_ammunitionData, lot),
+        PAYLOAD_FIELD("description", FIELD_TEXT, EARS_ammunitionData, description),
+        PAYLOAD_FIELD("quantity", FIELD_U32, EARS_ammunitionData, quantity),
+        PAYLOAD_FIELD("expiry", FIELD_U32, EARS_ammunitionData, expiryDate),
+        PAYLOAD_FIELD("received", FIELD_U32, EARS_ammunitionData, receivedDate),
+    };
+
+    if (type == RECORD_AMMUNITION)
+    {
+        count = sizeof(ammunition) / sizeof(ammunition[0]);
+        return ammunition;
+    }
+    count = sizeof(equipment) / sizeof(equipment[0]);
+    return equipment;
+}
+
+uint8_t EARS_recordTransfer::getColumns(EARS_recordType type, const char** names, uint8_t max)
+{
+    uint8_t count;
+    const FieldDef *fields = fieldsFor(type, count);
+    for (uint8_t i = 0; i < count && i < max; i++)
+    {
+        names[i] = fields[i].name;
+    }
+    return count < max ? count : max;
+}
+
+/******************************************************************************
+ * Control
+ *****************************************************************************/
+bool EARS_recordTransfer::start(EARS_sdCard* sdCard, EARS_recordStore* store, const char* path,
+                                EARS_transferFormat format, EARS_transferProgressCb callback, void* ctx,
+                                bool exporting)
+{
+    if (!sdCard || !store || !store->isReady() || !path || strlen(path) >= sizeof(_path))
+    {
+        return false;
+    }
+
+    portENTER_CRITICAL(&_mux);
+    bool idle = _progress.state != TRANSFER_STARTING && _progress.state != TRANSFER_RUNNING;
+    if (idle)
+    {
+        _sdCard = sdCard;
+        _store = store;
+        strncpy(_path, path, sizeof(_path));
+        snprintf(_partPath, sizeof(_partPath), "%s%s", path, TRANSFER_PART_SUFFIX);
+        _format = format;
+        _exporting = exporting;
+        _callback = callback;
+        _ctx = ctx;
+        _cancel = false;
+        memset(&_progress, 0, sizeof(_progress));
+        _progress.exporting = exporting;
+        _progress.state = TRANSFER_STARTING;
+    }
+    portEXIT_CRITICAL(&_mux);
+    return idle;
+}
+
+bool EARS_recordTransfer::startImport(EARS_sdCard* sdCard, EARS_recordStore* store, const char* path,
+                                      EARS_transferFormat format, EARS_transferProgressCb callback, void* ctx)
+{
+    return start(sdCard, store, path, format, callback, ctx, false);
+}
+
+bool EARS_recordTransfer::startExport(EARS_sdCard* sdCard, EARS_recordStore* store, const char* path,
+                                      EARS_transferFormat format, EARS_transferProgressCb callback, void* ctx)
+{
+    return start(sdCard, store, path, format, callback, ctx, true);
+}
+
+void EARS_recordTransfer::cancel()
+{
+    _cancel = true;
+}
+
+bool EARS_recordTransfer::isBusy() const
+{
+    portENTER_CRITICAL(&_mux);
+    bool busy = _progress.state == TRANSFER_STARTING || _progress.state == TRANSFER_RUNNING;
+    portEXIT_CRITICAL(&_mux);
+    return busy;
+}
+
+EARS_transferProgress EARS_recordTransfer::getProgress() const
+{
+    portENTER_CRITICAL(&_mux);
+    EARS_transferProgress progress = _progress;
+    portEXIT_CRITICAL(&_mux);
+    return progress;
+}
+
+/**
+ * @brief Allocate buffers and open the file (first slice)
+ * @return true if the transfer can run
+ */
+bool EARS_recordTransfer::open()
+{
+    if (!_buffer)
+    {
+        _buffer = (char *)transferAlloc(TRANSFER_BUFFER_SIZE);
+    }
+    if (!_chunk)
+    {
+        _chunk = (EARS_record *)transferAlloc(sizeof(EARS_record) * TRANSFER_CHUNK_RECORDS);
+    }
+    if (!_buffer || !_chunk)
+    {
+        return false;
+    }
+
+    _bufferPos = 0;
+    _bufferLen = 0;
+    _lineLen = 0;
+    _lineOverflow = false;
+    _eof = false;
+    _chunkCount = 0;
+    _position = 0;
+    _columnCount = 0;
+    _headerDone = false;
+    _fields = fieldsFor(_store->getType(), _fieldCount);
+    _startMs = millis();
+
+    if (_exporting)
+    {
+        _sdCard->removeFile(_partPath);
+        _progress.recordsTotal = _store->count();
+        return true;
+    }
+
+    _file = _sdCard->openRead(_path);
+    if (!_file)
+    {
+        return false;
+    }
+    _progress.bytesTotal = _file.size();
+    return true;
+}
+
+/**
+ * @brief End the transfer: close, publish the file, report
+ */
+void EARS_recordTransfer::finish(EARS_transferState state)
+{
+    if (_file)
+    {
+        _file.close();
+    }
+
+    if (_exporting)
+    {
+        if (state == TRANSFER_DONE && flushBuffer())
+        {
+            _sdCard->flush(_partPath);
+            if (_sdCard->fileExists(_path))
+            {
+                _sdCard->removeFile(_path);
+            }
+            if (!_sdCard->renameFile(_partPath, _path))
+            {
+                state = TRANSFER_FAILED;
+            }
+        }
+        else
+        {
+            if (state == TRANSFER_DONE)
+            {
+                state = TRANSFER_FAILED;
+            }
+            _sdCard->removeFile(_partPath);
+        }
+    }
+
+    // The scratch buffers are only needed while a transfer runs
+    heap_caps_free(_buffer);
+    heap_caps_free(_chunk);
+    _buffer = nullptr;
+    _chunk = nullptr;
+    _doc.clear();
+
+    portENTER_CRITICAL(&_mux);
+    _progress.state = state;
+    portEXIT_CRITICAL(&_mux);
+
+#if EARS_DEBUG == 1
+    Serial.printf("[TRANSFER] %s %s: state %u, %lu records, %lu skipped, %lu ms\n",
+                  _exporting ? "Export" : "Import", _path, (unsigned)state,
+                  (unsigned long)_progress.records, (unsigned long)_progress.skipped,
+                  (unsigned long)_progress.elapsedMs);
+#endif
+}
+
+void EARS_recordTransfer::report()
+{
+    if (_callback)
+    {
+        EARS_transferProgress progress = getProgress();
+        _callback(progress, _ctx);
+    }
+}
+
+void EARS_recordTransfer::service()
+{
+    portENTER_CRITICAL(&_mux);
+    EARS_transferState state = _progress.state;
+    portEXIT_CRITICAL(&_mux);
+
+    if (state != TRANSFER_STARTING && state != TRANSFER_RUNNING)
+    {
+        return;
+    }
+
+    if (state == TRANSFER_STARTING)
+    {
+        if (!open())
+        {
+            finish(TRANSFER_FAILED);
+            report();
+            return;
+        }
+        portENTER_CRITICAL(&_mux);
+        _progress.state = TRANSFER_RUNNING;
+        portEXIT_CRITICAL(&_mux);
+    }
+
+    uint32_t deadlineMs = millis() + TRANSFER_SLICE_MS;
+    bool more = _exporting ? exportSlice(deadlineMs) : importSlice(deadlineMs);
+
+    portENTER_CRITICAL(&_mux);
+    _progress.elapsedMs = millis() - _startMs;
+    portEXIT_CRITICAL(&_mux);
+
+    if (_cancel)
+    {
+        if (!_exporting)
+        {
+            flushChunk();
+        }
+        finish(TRANSFER_CANCELLED);
+    }
+    else if (!more)
+    {
+        portENTER_CRITICAL(&_mux);
+        bool failed = _progress.state == TRANSFER_FAILED;
+        portEXIT_CRITICAL(&_mux);
+        finish(failed ? TRANSFER_FAILED : TRANSFER_DONE);
+    }
+    report();
+}
+
+/******************************************************************************
+ * Import
+ *****************************************************************************/
+
+/**
+ * @brief Assemble the next line from the read buffer
+ * @return int 1 = line in _line, 0 = end of file, -1 = read error
+ */
+int EARS_recordTransfer::nextLine()
+{
+    _lineLen = 0;
+    _lineOverflow = false;
+
+    while (true)
+    {
+        if (_bufferPos >= _bufferLen)
+        {
+            if (_eof)
+            {
+                break;
+            }
+            int got = _file.read((uint8_t *)_buffer, TRANSFER_BUFFER_SIZE);
+            if (got < 0)
+            {
+                return -1;
+            }
+            _bufferPos = 0;
+            _bufferLen = (size_t)got;
+            _progress.bytes += got;
+            if (got == 0)
+            {
+                _eof = true;
+                break;
+            }
+        }
+
+        // Scan the buffer for the end of the line in one go
+        const char *start = _buffer + _bufferPos;
+        const char *newline = (const char *)memchr(start, '\n', _bufferLen - _bufferPos);
+        size_t take = newline ? (size_t)(newline - start) : _bufferLen - _bufferPos;
+
+        if (_lineLen + take < TRANSFER_LINE_SIZE)
+        {
+            memcpy(_line + _lineLen, start, take);
+            _lineLen += take;
+        }
+        else
+        {
+            _lineOverflow = true;
+        }
+        _bufferPos += take;
+
+        if (newline)
+        {
+            _bufferPos++;
+            break;
+        }
+    }
+
+    if (_lineLen == 0 && !_lineOverflow && _eof && _bufferPos >= _bufferLen)
+    {
+        return 0;
+    }
+
+    if (_lineLen > 0 && _line[_lineLen - 1] == '\r')
+    {
+        _lineLen--;
+    }
+    _line[_lineLen] = '\0';
+    _progress.lines++;
+    return 1;
+}
+
+/**
+ * @brief Split a CSV line in place (RFC 4180 quotes, "" for a quote)
+ * @return uint8_t Cells found
+ */
+uint8_t EARS_recordTransfer::splitCsv(char* line, char** cells, uint8_t max)
+{
+    uint8_t count = 0;
+    char *read = line;
+
+    while (count < max)
+    {
+        char *write = read;
+        cells[count++] = write;
+
+        if (*read == '"')
+        {
+            read++;
+            while (*read)
+            {
+                if (*read == '"')
+                {
+                    if (read[1] == '"')
+                    {
+                        *write++ = '"';
+                        read += 2;
+                        continue;
+                    }
+                    read++;
+                    break;
+                }
+                *write++ = *read++;
+            }
+            while (*read && *read != ',')
+            {
+                read++;
+            }
+        }
+        else
+        {
+            while (*read && *read != ',')
+            {
+                *write++ = *read++;
+            }
+        }
+
+        bool last = *read == '\0';
+        *write = '\0';
+        if (last)
+        {
+            break;
+        }
+        read++;
+    }
+    return count;
+}
+
+void EARS_recordTransfer::setField(EARS_record& record, const FieldDef& field, const char* text)
+{
+    uint8_t *dest = (uint8_t *)&record + field.offset;
+
+    if (field.kind == FIELD_TEXT)
+    {
+        size_t length = strnlen(text, field.size - 1);
+        memcpy(dest, text, length);
+        memset(dest + length, 0, field.size - length);
+        return;
+    }
+
+    uint32_t value = strtoul(text, nullptr, 10);
+    if (field.kind == FIELD_U8)
+    {
+        uint8_t v = value > UINT8_MAX ? UINT8_MAX : (uint8_t)value;
+        memcpy(dest, &v, sizeof(v));
+    }
+    else if (field.kind == FIELD_U16)
+    {
+        uint16_t v = value > UINT16_MAX ? UINT16_MAX : (uint16_t)value;
+        memcpy(dest, &v, sizeof(v));
+    }
+    else
+    {
+        memcpy(dest, &value, sizeof(value));
+    }
+}
+
+bool EARS_recordTransfer::parseCsvHeader(char* line)
+{
+    char *cells[TRANSFER_MAX_COLUMNS];
+    _columnCount = splitCsv(line, cells, TRANSFER_MAX_COLUMNS);
+
+    bool hasId = false;
+    for (uint8_t c = 0; c < _columnCount; c++)
+    {
+        _columns[c] = -1;
+        for (uint8_t f = 0; f < _fieldCount; f++)
+        {
+            if (strcasecmp(cells[c], _fields[f].name) == 0)
+            {
+                _columns[c] = f;
+                hasId |= f == 0;
+                break;
+            }
+        }
+    }
+    return hasId;
+}
+
+bool EARS_recordTransfer::parseCsvLine(char* line, EARS_record& record)
+{
+    char *cells[TRANSFER_MAX_COLUMNS];
+    uint8_t count = splitCsv(line, cells, _columnCount);
+
+    for (uint8_t c = 0; c < count; c++)
+    {
+        if (_columns[c] >= 0)
+        {
+            setField(record, _fields[_columns[c]], cells[c]);
+        }
+    }
+    return record.header.id != 0;
+}
+
+bool EARS_recordTransfer::parseJsonLine(const char* line, size_t length, EARS_record& record)
+{
+    if (deserializeJson(_doc, line, length) != DeserializationError::Ok)
+    {
+        return false;
+    }
+
+    char number[12];
+    for (uint8_t f = 0; f < _fieldCount; f++)
+    {
+        JsonVariantConst value = _doc[_fields[f].name];
+        if (value.isNull())
+        {
+            continue;
+        }
+        if (value.is<const char *>())
+        {
+            setField(record, _fields[f], value.as<const char *>());
+        }
+        else if (value.is<uint32_t>())
+        {
+            snprintf(number, sizeof(number), "%lu", (unsigned long)value.as<uint32_t>());
+            setField(record, _fields[f], number);
+        }
+    }
+    return record.header.id != 0;
+}
+
+bool EARS_recordTransfer::flushChunk()
+{
+    if (_chunkCount == 0)
+    {
+        return true;
+    }
+
+    bool ok = _store->putMany(_chunk, _chunkCount);
+    if (ok)
+    {
+        portENTER_CRITICAL(&_mux);
+        _progress.records += _chunkCount;
+        portEXIT_CRITICAL(&_mux);
+    }
+    _chunkCount = 0;
+    return ok;
+}
+
+/**
+ * @brief Parse lines until the deadline
+ * @return true if there is more to do
+ */
+bool EARS_recordTransfer::importSlice(uint32_t deadlineMs)
+{
+    while ((int32_t)(millis() - deadlineMs) < 0 && !_cancel)
+    {
+        int got = nextLine();
+        if (got <= 0)
+        {
+            bool ok = got == 0 && flushChunk();
+            if (!ok)
+            {
+                portENTER_CRITICAL(&_mux);
+                _progress.state = TRANSFER_FAILED;
+                portEXIT_CRITICAL(&_mux);
+            }
+            return false;
+        }
+
+        // Blank lines are not counted as skipped
+        if (_lineLen == 0 && !_lineOverflow)
+        {
+            continue;
+        }
+
+        if (_format == TRANSFER_CSV && !_headerDone)
+        {
+            _headerDone = true;
+            if (_lineOverflow || !parseCsvHeader(_line))
+            {
+                // No id column: nothing in the file can be imported
+                portENTER_CRITICAL(&_mux);
+                _progress.state = TRANSFER_FAILED;
+                portEXIT_CRITICAL(&_mux);
+                return false;
+            }
+            continue;
+        }
+
+        EARS_record &record = _chunk[_chunkCount];
+        memset(&record, 0, sizeof(record));
+        bool ok = !_lineOverflow &&
+                  (_format == TRANSFER_CSV ? parseCsvLine(_line, record) : parseJsonLine(_line, _lineLen, record));
+
+        if (!ok)
+        {
+            portENTER_CRITICAL(&_mux);
+            _progress.skipped++;
+            if (_progress.firstSkippedLine == 0)
+            {
+                _progress.firstSkippedLine = _progress.lines;
+            }
+            portEXIT_CRITICAL(&_mux);
+            continue;
+        }
+
+        if (++_chunkCount == TRANSFER_CHUNK_RECORDS && !flushChunk())
+        {
+            portENTER_CRITICAL(&_mux);
+            _progress.state = TRANSFER_FAILED;
+            portEXIT_CRITICAL(&_mux);
+            return false;
+        }
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Export
+ *****************************************************************************/
+
+bool EARS_recordTransfer::flushBuffer()
+{
+    if (_bufferLen == 0)
+    {
+        return true;
+    }
+
+    bool ok = _sdCard->appendData(_partPath, (const uint8_t *)_buffer, _bufferLen);
+    _bufferLen = 0;
+    return ok;
+}
+
+bool EARS_recordTransfer::emit(const char* text, size_t length)
+{
+    if (_bufferLen + length > TRANSFER_BUFFER_SIZE && !flushBuffer())
+    {
+        return false;
+    }
+
+    memcpy(_buffer + _bufferLen, text, length);
+    _bufferLen += length;
+    portENTER_CRITICAL(&_mux);
+    _progress.bytes += length;
+    _progress.lines++;
+    portEXIT_CRITICAL(&_mux);
+    return true;
+}
+
+size_t EARS_recordTransfer::formatHeader(char* out, size_t size) const
+{
+    size_t n = 0;
+    for (uint8_t f = 0; f < _fieldCount && n < size; f++)
+    {
+        n += snprintf(out + n, size - n, "%s%s", f ? "," : "", _fields[f].name);
+    }
+    if (n + 1 < size)
+    {
+        out[n++] = '\n';
+        out[n] = '\0';
+    }
+    return n;
+}
+
+// Append one value; text is quoted for CSV when it needs it, always for JSON
+static size_t transferValue(char* out, size_t size, const uint8_t* src, uint8_t kind, uint8_t fieldSize,
+                            bool json)
+{
+    if (kind != FIELD_TEXT)
+    {
+        uint32_t value = 0;
+        if (fieldSize == 1)
+            value = *src;
+        else if (fieldSize == 2)
+            value = (uint32_t)src[0] | ((uint32_t)src[1] << 8);
+        else
+            memcpy(&value, src, sizeof(value));
+        int n = snprintf(out, size, "%lu", (unsigned long)value);
+        return n < 0 ? 0 : ((size_t)n < size ? (size_t)n : size - 1);
+    }
+
+    const char *text = (const char *)src;
+    size_t length = strnlen(text, fieldSize);
+    bool quote = json;
+    for (size_t i = 0; !quote && i < length; i++)
+    {
+        quote = text[i] == ',' || text[i] == '"' || text[i] == '\n' || text[i] == '\r';
+    }
+
+    size_t n = 0;
+    if (quote && n + 1 < size)
+        out[n++] = '"';
+    for (size_t i = 0; i < length && n + 3 < size; i++)
+    {
+        char c = text[i];
+        if (c == '"')
+        {
+            out[n++] = json ? '\\' : '"';
+            out[n++] = '"';
+        }
+        else if (json && c == '\\')
+        {
+            out[n++] = '\\';
+            out[n++] = '\\';
+        }
+        else if (json && (uint8_t)c < 0x20)
+        {
+            out[n++] = ' ';
+        }
+        else
+        {
+            out[n++] = c;
+        }
+    }
+    if (quote && n + 1 < size)
+        out[n++] = '"';
+    out[n] = '\0';
+    return n;
+}
+
+size_t EARS_recordTransfer::formatCsv(const EARS_record& record, char* out, size_t size) const
+{
+    size_t n = 0;
+    for (uint8_t f = 0; f < _fieldCount && n + 2 < size; f++)
+    {
+        if (f)
+            out[n++] = ',';
+        const FieldDef &field = _fields[f];
+        n += transferValue(out + n, size - n, (const uint8_t *)&record + field.offset, field.kind, field.size, false);
+    }
+    out[n++] = '\n';
+    out[n] = '\0';
+    return n;
+}
+
+size_t EARS_recordTransfer::formatJson(const EARS_record& record, char* out, size_t size) const
+{
+    size_t n = 0;
+    out[n++] = '{';
+    for (uint8_t f = 0; f < _fieldCount && n + 8 < size; f++)
+    {
+        const FieldDef &field = _fields[f];
+        n += snprintf(out + n, size - n, "%s\"%s\":", f ? "," : "", field.name);
+        if (n + 4 >= size)
+            break;
+        n += transferValue(out + n, size - n, (const uint8_t *)&record + field.offset, field.kind, field.size, true);
+    }
+    if (n + 2 < size)
+    {
+        out[n++] = '}';
+        out[n++] = '\n';
+    }
+    out[n] = '\0';
+    return n;
+}
+
+/**
+ * @brief Format records until the deadline
+ * @return true if there is more to do
+ */
+bool EARS_recordTransfer::exportSlice(uint32_t deadlineMs)
+{
+    // Room for the widest record with every character escaped
+    char line[TRANSFER_LINE_SIZE * 2];
+
+    if (!_headerDone)
+    {
+        _headerDone = true;
+        if (_format == TRANSFER_CSV && !emit(line, formatHeader(line, sizeof(line))))
+        {
+            portENTER_CRITICAL(&_mux);
+            _progress.state = TRANSFER_FAILED;
+            portEXIT_CRITICAL(&_mux);
+            return false;
+        }
+    }
+
+    while ((int32_t)(millis() - deadlineMs) < 0 && !_cancel)
+    {
+        size_t got = _store->readPage(_position, _chunk, TRANSFER_CHUNK_RECORDS);
+        if (got == 0)
+        {
+            return false;
+        }
+        _position += got;
+
+        for (size_t r = 0; r < got; r++)
+        {
+            size_t length = _format == TRANSFER_CSV ? formatCsv(_chunk[r], line, sizeof(line))
+                                                    : formatJson(_chunk[r], line, sizeof(line));
+            if (!emit(line, length))
+            {
+                portENTER_CRITICAL(&_mux);
+                _progress.state = TRANSFER_FAILED;
+                portEXIT_CRITICAL(&_mux);
+                return false;
+            }
+        }
+
+        portENTER_CRITICAL(&_mux);
+        _progress.records += got;
+        portEXIT_CRITICAL(&_mux);
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Version Information
+ *****************************************************************************/
+const char* EARS_recordTransfer::getLibraryName()
+{
+    return EARS_RecordTransfer::LIB_NAME;
+}
+
+uint32_t EARS_recordTransfer::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_RecordTransfer::VERSION_MAJOR,
+                       EARS_RecordTransfer::VERSION_MINOR,
+                       EARS_RecordTransfer::VERSION_PATCH);
+}
+
+const char* EARS_recordTransfer::getVersionDate()
+{
+    return EARS_RecordTransfer::VERSION_DATE;
+}
+
+void EARS_recordTransfer::getVersionString(char* buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+EARS_recordTransfer &using_transfer()
+{
+    static EARS_recordTransfer instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_recordTransferLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,249 @@
+/**
+ * @file EARS_recordTransferLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Streaming bulk import and export of record stores (CSV, JSON Lines)
+ * @details One transfer runs at a time, in slices of TRANSFER_SLICE_MS from
+ *          service() on Core 1, so the rest of the job scheduler keeps
+ *          running during a long import.
+ *
+ *          Import reads the file through a TRANSFER_BUFFER_SIZE buffer and
+ *          parses it one line at a time (a CSV header row names the
+ *          columns; a JSON Lines file has one object per line, keyed the
+ *          same). Parsed records collect in a chunk of
+ *          TRANSFER_CHUNK_RECORDS and go to EARS_recordStore::putMany(), so
+ *          each chunk is one append and the index is sorted once, not per
+ *          record. Neither the file nor the record set is ever held whole.
+ *          Lines without a valid "id" are skipped and counted.
+ *
+ *          Export pages through the store in ID order and formats each
+ *          record into the same buffer, appending it to "<path>.part" when
+ *          full; the finished file is renamed over the target.
+ *
+ *          The progress callback runs on Core 1 after every slice; UI code
+ *          posts it on with MAIN_ui_cmd_call().
+ *
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_RECORD_TRANSFER_LIB_H__
+#define __EARS_RECORD_TRANSFER_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <freertos/FreeRTOS.h>
+#include "EARS_versionDef.h"
+#include "EARS_sdCardLib.h"
+#include "EARS_recordStoreLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_RecordTransfer
+{
+    constexpr const char* LIB_NAME = "EARS_recordTransfer";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+#define TRANSFER_BUFFER_SIZE 4096       // File read/write buffer
+#define TRANSFER_LINE_SIZE 256          // Longest line; longer lines are skipped
+#define TRANSFER_CHUNK_RECORDS 64       // Records per putMany() / readPage()
+#define TRANSFER_MAX_COLUMNS 16         // CSV columns mapped, the rest ignored
+#define TRANSFER_SLICE_MS 50            // Work per service() call
+#define TRANSFER_SERVICE_PERIOD_MS 20   // Suggested job period
+#define TRANSFER_PART_SUFFIX ".part"
+
+/**
+ * @brief File formats
+ */
+enum EARS_transferFormat : uint8_t
+{
+    TRANSFER_CSV = 0,
+    TRANSFER_JSONL
+};
+
+/**
+ * @brief Transfer life cycle
+ */
+enum EARS_transferState : uint8_t
+{
+    TRANSFER_IDLE = 0,
+    TRANSFER_STARTING,          // Accepted, opens on the next service()
+    TRANSFER_RUNNING,
+    TRANSFER_DONE,
+    TRANSFER_FAILED,
+    TRANSFER_CANCELLED
+};
+
+/**
+ * @brief Where a transfer has got to
+ */
+struct EARS_transferProgress
+{
+    EARS_transferState state;
+    bool exporting;
+    uint32_t bytes;             // File bytes read or written
+    uint32_t bytesTotal;        // Import: file size; export: 0 (unknown)
+    uint32_t lines;             // Lines read or written, header included
+    uint32_t records;           // Records imported or exported
+    uint32_t recordsTotal;      // Export: items in the store; import: 0
+    uint32_t skipped;           // Import lines rejected
+    uint32_t firstSkippedLine;  // 1-based, 0 = none
+    uint32_t elapsedMs;
+};
+
+/**
+ * @brief Progress report (Core 1)
+ * @param progress Snapshot after the latest slice
+ * @param ctx Context given to startImport/startExport
+ */
+typedef void (*EARS_transferProgressCb)(const EARS_transferProgress& progress, void* ctx);
+
+/******************************************************************************
+ * EARS_recordTransfer Class
+ *****************************************************************************/
+class EARS_recordTransfer
+{
+public:
+    EARS_recordTransfer();
+
+    // Version information getters
+    static const char* getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char* getVersionDate();
+    static void getVersionString(char* buffer);
+
+    /**
+     * @brief Queue an import of a file into a store
+     * @param sdCard Mounted SD card
+     * @param store Store to fill (its type picks the columns)
+     * @param path File to read
+     * @param format TRANSFER_CSV or TRANSFER_JSONL
+     * @param callback Progress callback, NULL for none
+     * @param ctx Passed to callback
+     * @return true if accepted (no transfer was running)
+     */
+    bool startImport(EARS_sdCard* sdCard, EARS_recordStore* store, const char* path,
+                     EARS_transferFormat format, EARS_transferProgressCb callback, void* ctx);
+
+    /**
+     * @brief Queue an export of a store to a file (replaced when complete)
+     * @return true if accepted (no transfer was running)
+     */
+    bool startExport(EARS_sdCard* sdCard, EARS_recordStore* store, const char* path,
+                     EARS_transferFormat format, EARS_transferProgressCb callback, void* ctx);
+
+    /**
+     * @brief Stop the running transfer at the end of its slice
+     * @details Records already imported stay; a partial export is removed
+     */
+    void cancel();
+
+    /**
+     * @brief Run one slice of the current transfer
+     * @details Call periodically from Core 1 (TRANSFER_SERVICE_PERIOD_MS)
+     */
+    void service();
+
+    bool isBusy() const;
+    EARS_transferProgress getProgress() const;
+
+    /**
+     * @brief Column (and JSON key) names for a record type
+     * @param type Record type
+     * @param names Receives up to max names
+     * @param max Capacity of names
+     * @return uint8_t Number of columns
+     */
+    static uint8_t getColumns(EARS_recordType type, const char** names, uint8_t max);
+
+private:
+    struct FieldDef
+    {
+        const char* name;
+        uint8_t kind;            // FIELD_*
+        uint8_t offset;          // Byte offset in EARS_record
+        uint8_t size;
+    };
+
+    // Request (written while idle, under _mux)
+    EARS_sdCard* _sdCard;
+    EARS_recordStore* _store;
+    char _path[64];
+    char _partPath[72];
+    EARS_transferFormat _format;
+    bool _exporting;
+    EARS_transferProgressCb _callback;
+    void* _ctx;
+    volatile bool _cancel;
+
+    // Working state (Core 1 only)
+    File _file;
+    char* _buffer;               // TRANSFER_BUFFER_SIZE
+    size_t _bufferPos;
+    size_t _bufferLen;
+    char _line[TRANSFER_LINE_SIZE];
+    size_t _lineLen;
+    bool _lineOverflow;
+    bool _eof;
+    EARS_record* _chunk;         // TRANSFER_CHUNK_RECORDS
+    size_t _chunkCount;
+    uint32_t _position;          // Export: next index position
+    const FieldDef* _fields;
+    uint8_t _fieldCount;
+    int8_t _columns[TRANSFER_MAX_COLUMNS]; // CSV column -> field, -1 = ignored
+    uint8_t _columnCount;
+    bool _headerDone;
+    JsonDocument _doc;
+    uint32_t _startMs;
+
+    EARS_transferProgress _progress;
+    mutable portMUX_TYPE _mux;
+
+    bool start(EARS_sdCard* sdCard, EARS_recordStore* store, const char* path,
+               EARS_transferFormat format, EARS_transferProgressCb callback, void* ctx, bool exporting);
+    bool open();
+    void finish(EARS_transferState state);
+    void report();
+
+    // Import
+    bool importSlice(uint32_t deadlineMs);
+    int nextLine();
+    bool parseCsvHeader(char* line);
+    bool parseCsvLine(char* line, EARS_record& record);
+    bool parseJsonLine(const char* line, size_t length, EARS_record& record);
+    bool flushChunk();
+    static uint8_t splitCsv(char* line, char** cells, uint8_t max);
+    static void setField(EARS_record& record, const FieldDef& field, const char* text);
+
+    // Export
+    bool exportSlice(uint32_t deadlineMs);
+    bool emit(const char* text, size_t length);
+    bool flushBuffer();
+    size_t formatCsv(const EARS_record& record, char* out, size_t size) const;
+    size_t formatJson(const EARS_record& record, char* out, size_t size) const;
+    size_t formatHeader(char* out, size_t size) const;
+
+    static const FieldDef* fieldsFor(EARS_recordType type, uint8_t& count);
+};
+
+// Global instance access function (Singleton pattern)
+EARS_recordTransfer &using_transfer();
+
+#endif // __EARS_RECORD_TRANSFER_LIB_H__
+
+/******************************************************************************
+ * End of EARS_recordTransferLib.h
+ ******************************************************************************/
@@ -0,0 +1,961 @@
+/**
+ * @file EARS_reportLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Inventory reports from the record stores, streamed to CSV or PDF
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EARS_reportLib.h"
+#include "EARS_systemDef.h"
+#include <esp_heap_caps.h>
+#include <stdarg.h>
+
+/******************************************************************************
+ * PDF Layout
+ *****************************************************************************/
+
+// Objects: 1 catalog, 2 page tree, 3 font, then content and page per page
+#define PDF_OBJECT_PAGES 2
+#define PDF_OBJECT_FIRST_PAGE 4
+#define PDF_OBJECTS(pages) (PDF_OBJECT_FIRST_PAGE + 2 * (pages))
+
+// Widest escaped line plus its operator
+#define PDF_LINE_MAX (REPORT_PDF_LINE_CHARS * 2 + 8)
+
+/******************************************************************************
+ * Helpers
+ *****************************************************************************/
+
+// Scratch buffers are large and short-lived: PSRAM when there is any
+static void *reportAlloc(size_t size)
+{
+    void *block = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    return block ? block : heap_caps_malloc(size, MALLOC_CAP_8BIT);
+}
+
+// YYYYMMDD as YYYY-MM-DD; none for 0
+static void reportDate(uint32_t date, const char* none, char* out, size_t size)
+{
+    if (date == 0)
+    {
+        strlcpy(out, none, size);
+        return;
+    }
+    snprintf(out, size, "%04lu-%02lu-%02lu", (unsigned long)(date / 10000),
+             (unsigned long)(date / 100 % 100), (unsigned long)(date % 100));
+}
+
+// Fixed record text field as a C string
+static void reportText(const char* field, size_t fieldSize, char* out, size_t size)
+{
+    size_t length = strnlen(field, fieldSize);
+    if (length >= size)
+    {
+        length = size - 1;
+    }
+    memcpy(out, field, length);
+    out[length] = '\0';
+}
+
+/******************************************************************************
+ * Construction
+ *****************************************************************************/
+EARS_report::EARS_report()
+    : _sdCard(nullptr),
+      _store(nullptr),
+      _kind(REPORT_STOCK),
+      _date(0),
+      _format(REPORT_CSV),
+      _callback(nullptr),
+      _ctx(nullptr),
+      _cancel(false),
+      _buffer(nullptr),
+      _bufferLen(0),
+      _written(0),
+      _chunk(nullptr),
+      _position(0),
+      _columns(nullptr),
+      _columnCount(0),
+      _groups(nullptr),
+      _groupCount(0),
+      _totalItems(0),
+      _totalQuantity(0),
+      _totalFlagged(0),
+      _startMs(0),
+      _page(nullptr),
+      _pageLen(0),
+      _pageLines(0),
+      _pages(0),
+      _offsets(nullptr)
+{
+    _path[0] = '\0';
+    _partPath[0] = '\0';
+    _title[0] = '\0';
+    memset(&_progress, 0, sizeof(_progress));
+    _mux = portMUX_INITIALIZER_UNLOCKED;
+}
+
+// Columns of each report; widths add up to REPORT_PDF_LINE_CHARS or less
+const EARS_report::Column* EARS_report::columnsFor(EARS_reportKind kind, EARS_recordType type, uint8_t& count)
+{
+    static const Column stockEquipment[] = {
+        {"Category", 24}, {"Items", 12}, {"Quantity", 12}, {"Issued", 12}};
+    static const Column stockAmmunition[] = {
+        {"Calibre", 24}, {"Lots", 12}, {"Quantity", 12}, {"Expiring", 12}};
+    static const Column holdings[] = {
+        {"Holder", 24}, {"Items", 12}, {"Quantity", 12}};
+    static const Column inspection[] = {
+        {"ID", 10}, {"Name", 33}, {"Serial", 25}, {"NSN", 21}, {"Holder", 9}, {"Inspected", 10}};
+    static const Column expiry[] = {
+        {"ID", 10}, {"Calibre", 17}, {"Lot", 25}, {"Description", 24}, {"Quantity", 12}, {"Expiry", 10}};
+
+    switch (kind)
+    {
+    case REPORT_STOCK:
+        if (type == RECORD_AMMUNITION)
+        {
+            count = sizeof(stockAmmunition) / sizeof(stockAmmunition[0]);
+            return stockAmmunition;
+        }
+        count = sizeof(stockEquipment) / sizeof(stockEquipment[0]);
+        return stockEquipment;
+    case REPORT_HOLDINGS:
+        count = sizeof(holdings) / sizeof(holdings[0]);
+        return holdings;
+    case REPORT_INSPECTION_DUE:
+        count = sizeof(inspection) / sizeof(inspection[0]);
+        return inspection;
+    default:
+        count = sizeof(expiry) / sizeof(expiry[0]);
+        return expiry;
+    }
+}
+
+/******************************************************************************
+ * Control
+ *****************************************************************************/
+bool EARS_report::start(EARS_sdCard* sdCard, EARS_recordStore* store, EARS_reportKind kind, uint32_t date,
+                        const char* path, EARS_reportFormat format, EARS_reportProgressCb callback, void* ctx)
+{
+    if (!sdCard || !store || !store->isReady() || !path || strlen(path) >= sizeof(_path))
+    {
+        return false;
+    }
+
+    // Listing reports read fields only one record type has
+    if ((kind == REPORT_INSPECTION_DUE && store->getType() != RECORD_EQUIPMENT) ||
+        (kind == REPORT_EXPIRY && store->getType() != RECORD_AMMUNITION))
+    {
+        return false;
+    }
+
+    portENTER_CRITICAL(&_mux);
+    bool idle = _progress.state != REPORT_STARTING && _progress.state != REPORT_RUNNING;
+    if (idle)
+    {
+        _sdCard = sdCard;
+        _store = store;
+        _kind = kind;
+        _date = date;
+        strncpy(_path, path, sizeof(_path));
+        snprintf(_partPath, sizeof(_partPath), "%s%s", path, REPORT_PART_SUFFIX);
+        _format = format;
+        _callback = callback;
+        _ctx = ctx;
+        _cancel = false;
+        memset(&_progress, 0, sizeof(_progress));
+        _progress.kind = kind;
+        _progress.state = REPORT_STARTING;
+    }
+    portEXIT_CRITICAL(&_mux);
+    return idle;
+}
+
+void EARS_report::cancel()
+{
+    _cancel = true;
+}
+
+bool EARS_report::isBusy() const
+{
+    portENTER_CRITICAL(&_mux);
+    bool busy = _progress.state == REPORT_STARTING || _progress.state == REPORT_RUNNING;
+    portEXIT_CRITICAL(&_mux);
+    return busy;
+}
+
+EARS_reportProgress EARS_report::getProgress() const
+{
+    portENTER_CRITICAL(&_mux);
+    EARS_reportProgress progress = _progress;
+    portEXIT_CRITICAL(&_mux);
+    return progress;
+}
+
+/**
+ * @brief Allocate buffers, start the file and write its heading (first slice)
+ * @return true if the report can run
+ */
+bool EARS_report::open()
+{
+    bool grouped = isGrouped();
+    bool pdf = _format == REPORT_PDF;
+
+    _buffer = (char *)reportAlloc(REPORT_BUFFER_SIZE);
+    _chunk = (EARS_record *)reportAlloc(sizeof(EARS_record) * REPORT_CHUNK_RECORDS);
+    _groups = grouped ? (Group *)reportAlloc(sizeof(Group) * (REPORT_MAX_GROUPS + 1)) : nullptr;
+    _page = pdf ? (char *)reportAlloc(REPORT_PDF_PAGE_SIZE) : nullptr;
+    _offsets = pdf ? (uint32_t *)reportAlloc(sizeof(uint32_t) * PDF_OBJECTS(REPORT_PDF_MAX_PAGES)) : nullptr;
+    if (!_buffer || !_chunk || (grouped && !_groups) || (pdf && (!_page || !_offsets)))
+    {
+        return false;
+    }
+
+    _bufferLen = 0;
+    _written = 0;
+    _position = 0;
+    _groupCount = 0;
+    _totalItems = 0;
+    _totalQuantity = 0;
+    _totalFlagged = 0;
+    _pageLen = 0;
+    _pageLines = 0;
+    _pages = 0;
+    _startMs = millis();
+    _columns = columnsFor(_kind, _store->getType(), _columnCount);
+
+    if (grouped)
+    {
+        // The overflow row sits past the sorted table
+        memset(&_groups[REPORT_MAX_GROUPS], 0, sizeof(Group));
+        strlcpy(_groups[REPORT_MAX_GROUPS].key, "(other)", REPORT_GROUP_KEY_SIZE);
+    }
+
+    const char *what = _store->getType() == RECORD_AMMUNITION ? "Ammunition" : "Equipment";
+    char date[12];
+    switch (_kind)
+    {
+    case REPORT_STOCK:
+        snprintf(_title, sizeof(_title), "%s stock by %s", what,
+                 _store->getType() == RECORD_AMMUNITION ? "calibre" : "category");
+        break;
+    case REPORT_HOLDINGS:
+        snprintf(_title, sizeof(_title), "%s holdings by zap number", what);
+        break;
+    case REPORT_INSPECTION_DUE:
+        reportDate(_date, "-", date, sizeof(date));
+        snprintf(_title, sizeof(_title), "Equipment not inspected since %s", date);
+        break;
+    case REPORT_EXPIRY:
+        reportDate(_date, "-", date, sizeof(date));
+        snprintf(_title, sizeof(_title), "Ammunition expiring by %s", date);
+        break;
+    }
+
+    _sdCard->removeFile(_partPath);
+    _progress.recordsTotal = _store->count();
+    return writeHeading();
+}
+
+/**
+ * @brief End the report: publish or remove the file, release the buffers
+ */
+void EARS_report::finish(EARS_reportState state)
+{
+    if (state == REPORT_DONE && flushBuffer())
+    {
+        _sdCard->flush(_partPath);
+        if (_sdCard->fileExists(_path))
+        {
+            _sdCard->removeFile(_path);
+        }
+        if (!_sdCard->renameFile(_partPath, _path))
+        {
+            state = REPORT_FAILED;
+        }
+    }
+    else
+    {
+        if (state == REPORT_DONE)
+        {
+            state = REPORT_FAILED;
+        }
+        _sdCard->removeFile(_partPath);
+    }
+
+    // The scratch buffers are only needed while a report runs
+    heap_caps_free(_buffer);
+    heap_caps_free(_chunk);
+    heap_caps_free(_groups);
+    heap_caps_free(_page);
+    heap_caps_free(_offsets);
+    _buffer = nullptr;
+    _chunk = nullptr;
+    _groups = nullptr;
+    _page = nullptr;
+    _offsets = nullptr;
+
+    portENTER_CRITICAL(&_mux);
+    _progress.state = state;
+    portEXIT_CRITICAL(&_mux);
+
+#if EARS_DEBUG == 1
+    Serial.printf("[REPORT] %s -> %s: state %u, %lu records, %lu rows, %lu bytes, %lu ms\n",
+                  _title, _path, (unsigned)state, (unsigned long)_progress.records,
+                  (unsigned long)_progress.rows, (unsigned long)_progress.bytes,
+                  (unsigned long)_progress.elapsedMs);
+#endif
+}
+
+void EARS_report::report()
+{
+    if (_callback)
+    {
+        EARS_reportProgress progress = getProgress();
+        _callback(progress, _ctx);
+    }
+}
+
+void EARS_report::fail()
+{
+    portENTER_CRITICAL(&_mux);
+    _progress.state = REPORT_FAILED;
+    portEXIT_CRITICAL(&_mux);
+}
+
+void EARS_report::service()
+{
+    portENTER_CRITICAL(&_mux);
+    EARS_reportState state = _progress.state;
+    portEXIT_CRITICAL(&_mux);
+
+    if (state != REPORT_STARTING && state != REPORT_RUNNING)
+    {
+        return;
+    }
+
+    if (state == REPORT_STARTING)
+    {
+        if (!open())
+        {
+            finish(REPORT_FAILED);
+            report();
+            return;
+        }
+        portENTER_CRITICAL(&_mux);
+        _progress.state = REPORT_RUNNING;
+        portEXIT_CRITICAL(&_mux);
+    }
+
+    uint32_t deadlineMs = millis() + REPORT_SLICE_MS;
+    bool more = scanSlice(deadlineMs);
+
+    portENTER_CRITICAL(&_mux);
+    _progress.elapsedMs = millis() - _startMs;
+    portEXIT_CRITICAL(&_mux);
+
+    if (_cancel)
+    {
+        finish(REPORT_CANCELLED);
+    }
+    else if (!more)
+    {
+        portENTER_CRITICAL(&_mux);
+        bool failed = _progress.state == REPORT_FAILED;
+        portEXIT_CRITICAL(&_mux);
+        finish(failed ? REPORT_FAILED : REPORT_DONE);
+    }
+    report();
+}
+
+/******************************************************************************
+ * Report Pass
+ *****************************************************************************/
+
+/**
+ * @brief Read and report records until the deadline
+ * @return true if there is more to do
+ */
+bool EARS_report::scanSlice(uint32_t deadlineMs)
+{
+    while ((int32_t)(millis() - deadlineMs) < 0 && !_cancel)
+    {
+        size_t got = _store->readPage(_position, _chunk, REPORT_CHUNK_RECORDS);
+        if (got == 0)
+        {
+            // End of the pass: group table, totals, PDF trailer
+            bool ok = (!isGrouped() || writeGroups()) && writeTotals() &&
+                      (_format != REPORT_PDF || pdfEnd());
+            if (!ok)
+            {
+                fail();
+            }
+            return false;
+        }
+        _position += got;
+
+        for (size_t r = 0; r < got; r++)
+        {
+            if (isGrouped())
+            {
+                groupRecord(_chunk[r]);
+            }
+            else if (!listRecord(_chunk[r]))
+            {
+                fail();
+                return false;
+            }
+        }
+
+        portENTER_CRITICAL(&_mux);
+        _progress.records += got;
+        portEXIT_CRITICAL(&_mux);
+    }
+    return true;
+}
+
+/**
+ * @brief Write one item of a listing report if it qualifies
+ * @return false only if the write failed
+ */
+bool EARS_report::listRecord(const EARS_record& record)
+{
+    char id[12];
+    char holder[RECORD_ZAP_SIZE];
+    char date[12];
+    snprintf(id, sizeof(id), "%lu", (unsigned long)record.header.id);
+    reportText(record.header.zap, RECORD_ZAP_SIZE, holder, sizeof(holder));
+
+    if (_kind == REPORT_INSPECTION_DUE)
+    {
+        const EARS_equipmentData *item = (const EARS_equipmentData *)record.payload;
+        if (item->inspectedDate >= _date)
+        {
+            return true;
+        }
+
+        char name[sizeof(item->name) + 1];
+        char serial[sizeof(item->serial) + 1];
+        char nsn[sizeof(item->nsn) + 1];
+        reportText(item->name, sizeof(item->name), name, sizeof(name));
+        reportText(item->serial, sizeof(item->serial), serial, sizeof(serial));
+        reportText(item->nsn, sizeof(item->nsn), nsn, sizeof(nsn));
+        reportDate(item->inspectedDate, "never", date, sizeof(date));
+
+        const char *cells[] = {id, name, serial, nsn, holder, date};
+        _totalItems++;
+        _totalQuantity += item->quantity;
+        return writeRow(cells);
+    }
+
+    const EARS_ammunitionData *lot = (const EARS_ammunitionData *)record.payload;
+    if (lot->expiryDate == 0 || lot->expiryDate > _date)
+    {
+        return true;
+    }
+
+    char calibre[sizeof(lot->calibre) + 1];
+    char lotNumber[sizeof(lot->lot) + 1];
+    char description[sizeof(lot->description) + 1];
+    char quantity[12];
+    reportText(lot->calibre, sizeof(lot->calibre), calibre, sizeof(calibre));
+    reportText(lot->lot, sizeof(lot->lot), lotNumber, sizeof(lotNumber));
+    reportText(lot->description, sizeof(lot->description), description, sizeof(description));
+    snprintf(quantity, sizeof(quantity), "%lu", (unsigned long)lot->quantity);
+    reportDate(lot->expiryDate, "-", date, sizeof(date));
+
+    const char *cells[] = {id, calibre, lotNumber, description, quantity, date};
+    _totalItems++;
+    _totalQuantity += lot->quantity;
+    return writeRow(cells);
+}
+
+/**
+ * @brief Find a group by key, adding it in order if there is room
+ * @return The group, or the "(other)" row once the table is full
+ */
+EARS_report::Group* EARS_report::findGroup(const char* key)
+{
+    uint16_t lo = 0;
+    uint16_t hi = _groupCount;
+    while (lo < hi)
+    {
+        uint16_t mid = lo + (hi - lo) / 2;
+        int order = strncmp(_groups[mid].key, key, REPORT_GROUP_KEY_SIZE);
+        if (order == 0)
+        {
+            return &_groups[mid];
+        }
+        if (order < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (_groupCount >= REPORT_MAX_GROUPS)
+    {
+        portENTER_CRITICAL(&_mux);
+        _progress.truncated = true;
+        portEXIT_CRITICAL(&_mux);
+        return &_groups[REPORT_MAX_GROUPS];
+    }
+
+    memmove(&_groups[lo + 1], &_groups[lo], (_groupCount - lo) * sizeof(Group));
+    memset(&_groups[lo], 0, sizeof(Group));
+    strlcpy(_groups[lo].key, key, REPORT_GROUP_KEY_SIZE);
+    _groupCount++;
+    return &_groups[lo];
+}
+
+/**
+ * @brief Add one item to its group
+ */
+void EARS_report::groupRecord(const EARS_record& record)
+{
+    char key[REPORT_GROUP_KEY_SIZE];
+    uint32_t quantity;
+    bool flagged;
+
+    if (record.header.type == RECORD_AMMUNITION)
+    {
+        const EARS_ammunitionData *lot = (const EARS_ammunitionData *)record.payload;
+        reportText(lot->calibre, sizeof(lot->calibre), key, sizeof(key));
+        quantity = lot->quantity;
+        flagged = _date != 0 && lot->expiryDate != 0 && lot->expiryDate <= _date;
+    }
+    else
+    {
+        const EARS_equipmentData *item = (const EARS_equipmentData *)record.payload;
+        reportText(item->category, sizeof(item->category), key, sizeof(key));
+        quantity = item->quantity;
+        flagged = record.header.zap[0] != '\0';
+    }
+
+    if (_kind == REPORT_HOLDINGS)
+    {
+        reportText(record.header.zap, RECORD_ZAP_SIZE, key, sizeof(key));
+        if (key[0] == '\0')
+        {
+            strlcpy(key, "(unassigned)", sizeof(key));
+        }
+    }
+    else if (key[0] == '\0')
+    {
+        strlcpy(key, "(none)", sizeof(key));
+    }
+
+    Group *group = findGroup(key);
+    group->items++;
+    group->quantity += quantity;
+    group->flagged += flagged ? 1 : 0;
+    _totalItems++;
+    _totalQuantity += quantity;
+    _totalFlagged += flagged ? 1 : 0;
+}
+
+/**
+ * @brief Write the group table (already in key order), then "(other)"
+ */
+bool EARS_report::writeGroups()
+{
+    char items[12];
+    char quantity[12];
+    char flagged[12];
+    const char *cells[] = {nullptr, items, quantity, flagged};
+
+    for (uint16_t g = 0; g <= _groupCount; g++)
+    {
+        // Slot _groupCount is unused unless it is the overflow row
+        const Group &group = g < _groupCount ? _groups[g] : _groups[REPORT_MAX_GROUPS];
+        if (group.items == 0)
+        {
+            continue;
+        }
+
+        cells[0] = group.key;
+        snprintf(items, sizeof(items), "%lu", (unsigned long)group.items);
+        snprintf(quantity, sizeof(quantity), "%lu", (unsigned long)group.quantity);
+        snprintf(flagged, sizeof(flagged), "%lu", (unsigned long)group.flagged);
+        if (!writeRow(cells))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Closing totals row
+ */
+bool EARS_report::writeTotals()
+{
+    char items[16];
+    char quantity[12];
+    char flagged[12];
+    const char *cells[6] = {"Total", "", "", "", "", ""};
+
+    snprintf(quantity, sizeof(quantity), "%lu", (unsigned long)_totalQuantity);
+    if (isGrouped())
+    {
+        snprintf(items, sizeof(items), "%lu", (unsigned long)_totalItems);
+        snprintf(flagged, sizeof(flagged), "%lu", (unsigned long)_totalFlagged);
+        cells[1] = items;
+        cells[2] = quantity;
+        cells[3] = flagged;
+    }
+    else
+    {
+        snprintf(items, sizeof(items), "%lu items", (unsigned long)_totalItems);
+        cells[1] = items;
+        if (_kind == REPORT_EXPIRY)
+        {
+            cells[4] = quantity;
+        }
+    }
+    return writeRow(cells);
+}
+
+/******************************************************************************
+ * Output
+ *****************************************************************************/
+
+bool EARS_report::flushBuffer()
+{
+    if (_bufferLen == 0)
+    {
+        return true;
+    }
+
+    bool ok = _sdCard->appendData(_partPath, (const uint8_t *)_buffer, _bufferLen);
+    _bufferLen = 0;
+    return ok;
+}
+
+bool EARS_report::emit(const char* text, size_t length)
+{
+    if (_bufferLen + length > REPORT_BUFFER_SIZE && !flushBuffer())
+    {
+        return false;
+    }
+
+    // A page stream can be larger than the buffer; it goes straight out
+    if (length > REPORT_BUFFER_SIZE)
+    {
+        if (!_sdCard->appendData(_partPath, (const uint8_t *)text, length))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        memcpy(_buffer + _bufferLen, text, length);
+        _bufferLen += length;
+    }
+
+    _written += length;
+    portENTER_CRITICAL(&_mux);
+    _progress.bytes += length;
+    portEXIT_CRITICAL(&_mux);
+    return true;
+}
+
+bool EARS_report::emitf(const char* format, ...)
+{
+    char text[160];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    return n > 0 && emit(text, (size_t)n < sizeof(text) ? (size_t)n : sizeof(text) - 1);
+}
+
+/**
+ * @brief CSV header row, or the start of the PDF
+ */
+bool EARS_report::writeHeading()
+{
+    if (_format == REPORT_PDF)
+    {
+        return pdfBegin();
+    }
+
+    const char *titles[8];
+    for (uint8_t c = 0; c < _columnCount; c++)
+    {
+        titles[c] = _columns[c].title;
+    }
+    bool ok = writeRow(titles);
+    portENTER_CRITICAL(&_mux);
+    _progress.rows = 0;
+    portEXIT_CRITICAL(&_mux);
+    return ok;
+}
+
+/**
+ * @brief Write one row of _columnCount cells
+ * @details CSV quotes a cell when it needs it; PDF pads each cell to its
+ *          column width and cuts all but the last one short, leaving a
+ *          space between
+ */
+bool EARS_report::writeRow(const char* const* cells)
+{
+    char line[PDF_LINE_MAX];
+    size_t n = 0;
+
+    if (_format == REPORT_PDF)
+    {
+        for (uint8_t c = 0; c < _columnCount; c++)
+        {
+            size_t width = _columns[c].width;
+            size_t length = strnlen(cells[c], c + 1 < _columnCount ? width - 1 : width);
+            memcpy(line + n, cells[c], length);
+            memset(line + n + length, ' ', width - length);
+            n += width;
+        }
+        while (n > 0 && line[n - 1] == ' ')
+        {
+            n--;
+        }
+        if (!pdfLine(line, n))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        for (uint8_t c = 0; c < _columnCount; c++)
+        {
+            const char *text = cells[c];
+            bool quote = strpbrk(text, ",\"\r\n") != nullptr;
+            if (c && n + 1 < sizeof(line))
+                line[n++] = ',';
+            if (quote && n + 1 < sizeof(line))
+                line[n++] = '"';
+            for (; *text && n + 3 < sizeof(line); text++)
+            {
+                if (*text == '"')
+                    line[n++] = '"';
+                line[n++] = *text;
+            }
+            if (quote && n + 1 < sizeof(line))
+                line[n++] = '"';
+        }
+        line[n++] = '\n';
+        if (!emit(line, n))
+        {
+            return false;
+        }
+    }
+
+    portENTER_CRITICAL(&_mux);
+    _progress.rows++;
+    portEXIT_CRITICAL(&_mux);
+    return true;
+}
+
+/******************************************************************************
+ * PDF
+ *****************************************************************************/
+
+/**
+ * @brief Note where an object starts, for the xref table
+ */
+bool EARS_report::pdfObject(uint16_t number)
+{
+    _offsets[number] = _written;
+    return true;
+}
+
+/**
+ * @brief Escape text for a PDF string; non-ASCII becomes '?'
+ */
+size_t EARS_report::pdfEscape(const char* text, size_t length, char* out, size_t size)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < length && n + 2 < size; i++)
+    {
+        char c = text[i];
+        if (c == '(' || c == ')' || c == '\\')
+        {
+            out[n++] = '\\';
+            out[n++] = c;
+        }
+        else
+        {
+            out[n++] = ((uint8_t)c < 0x20 || (uint8_t)c > 0x7E) ? '?' : c;
+        }
+    }
+    return n;
+}
+
+bool EARS_report::pdfBegin()
+{
+    // The binary comment marks the file as binary for transfer tools
+    return emitf("%%PDF-1.4\n%%\xE2\xE3\xCF\xD3\n") &&
+           pdfObject(1) &&
+           emitf("1 0 obj\n<< /Type /Catalog /Pages %u 0 R >>\nendobj\n", PDF_OBJECT_PAGES) &&
+           pdfObject(3) &&
+           emitf("3 0 obj\n<< /Type /Font /Subtype /Type1 /BaseFont /Courier"
+                 " /Encoding /WinAnsiEncoding >>\nendobj\n");
+}
+
+/**
+ * @brief Add one line to the page stream (no page bookkeeping)
+ */
+void EARS_report::pageText(const char* text, size_t length)
+{
+    // "'" moves to the next line, then shows the string
+    _page[_pageLen++] = '(';
+    _pageLen += pdfEscape(text, length, _page + _pageLen, REPORT_PDF_PAGE_SIZE - _pageLen - 4);
+    memcpy(_page + _pageLen, ") '\n", 4);
+    _pageLen += 4;
+    _pageLines++;
+}
+
+/**
+ * @brief Add a row line, starting a page (with headings) or ending one as needed
+ */
+bool EARS_report::pdfLine(const char* text, size_t length)
+{
+    if (_pageLines == 0)
+    {
+        if (_pages >= REPORT_PDF_MAX_PAGES)
+        {
+            portENTER_CRITICAL(&_mux);
+            _progress.truncated = true;
+            portEXIT_CRITICAL(&_mux);
+            return true;
+        }
+
+        // Courier 8 on 10 pt leading, from the top margin of an A4 page
+        static const char start[] = "BT\n/F1 8 Tf\n10 TL\n36 816 Td\n";
+        memcpy(_page, start, sizeof(start) - 1);
+        _pageLen = sizeof(start) - 1;
+
+        char heading[REPORT_PDF_LINE_CHARS + 1];
+        int n = snprintf(heading, sizeof(heading), "%-*s page %u", REPORT_PDF_LINE_CHARS - 10, _title,
+                         (unsigned)(_pages + 1));
+        pageText(heading, n < (int)sizeof(heading) ? (size_t)n : sizeof(heading) - 1);
+        pageText("", 0);
+
+        size_t w = 0;
+        for (uint8_t c = 0; c < _columnCount; c++)
+        {
+            size_t width = _columns[c].width;
+            size_t titleLength = strlen(_columns[c].title);
+            memcpy(heading + w, _columns[c].title, titleLength);
+            memset(heading + w + titleLength, ' ', width - titleLength);
+            w += width;
+        }
+        pageText(heading, w);
+        memset(heading, '-', w);
+        pageText(heading, w);
+    }
+
+    pageText(text, length);
+
+    // Full, or no room for another worst-case line
+    if (_pageLines >= REPORT_PDF_PAGE_LINES || _pageLen + PDF_LINE_MAX + 4 > REPORT_PDF_PAGE_SIZE)
+    {
+        return pdfEndPage();
+    }
+    return true;
+}
+
+/**
+ * @brief Write the page's content stream and page object
+ */
+bool EARS_report::pdfEndPage()
+{
+    memcpy(_page + _pageLen, "ET\n", 3);
+    _pageLen += 3;
+
+    uint16_t content = PDF_OBJECT_FIRST_PAGE + 2 * _pages;
+    bool ok = pdfObject(content) &&
+              emitf("%u 0 obj\n<< /Length %u >>\nstream\n", content, (unsigned)_pageLen) &&
+              emit(_page, _pageLen) &&
+              emitf("\nendstream\nendobj\n") &&
+              pdfObject(content + 1) &&
+              emitf("%u 0 obj\n<< /Type /Page /Parent %u 0 R /MediaBox [0 0 595 842]"
+                    " /Resources << /Font << /F1 3 0 R >> >> /Contents %u 0 R >>\nendobj\n",
+                    content + 1, PDF_OBJECT_PAGES, content);
+
+    _pages++;
+    _pageLen = 0;
+    _pageLines = 0;
+    portENTER_CRITICAL(&_mux);
+    _progress.pages = _pages;
+    portEXIT_CRITICAL(&_mux);
+    return ok;
+}
+
+/**
+ * @brief Close the last page, then write the page tree, xref and trailer
+ */
+bool EARS_report::pdfEnd()
+{
+    if (_pageLines > 0 && !pdfEndPage())
+    {
+        return false;
+    }
+
+    bool ok = pdfObject(PDF_OBJECT_PAGES) &&
+              emitf("%u 0 obj\n<< /Type /Pages /Count %u /Kids [", PDF_OBJECT_PAGES, (unsigned)_pages);
+    for (uint16_t p = 0; ok && p < _pages; p++)
+    {
+        ok = emitf(" %u 0 R", PDF_OBJECT_FIRST_PAGE + 2 * p + 1);
+    }
+    ok = ok && emitf(" ] >>\nendobj\n");
+
+    uint32_t xref = _written;
+    uint16_t objects = PDF_OBJECTS(_pages);
+    ok = ok && emitf("xref\n0 %u\n0000000000 65535 f \n", objects);
+    for (uint16_t i = 1; ok && i < objects; i++)
+    {
+        ok = emitf("%010lu 00000 n \n", (unsigned long)_offsets[i]);
+    }
+    return ok && emitf("trailer\n<< /Size %u /Root 1 0 R >>\nstartxref\n%lu\n%%%%EOF\n",
+                       objects, (unsigned long)xref);
+}
+
+/******************************************************************************
+ * Version Information
+ *****************************************************************************/
+const char* EARS_report::getLibraryName()
+{
+    return EARS_Report::LIB_NAME;
+}
+
+uint32_t EARS_report::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_Report::VERSION_MAJOR,
+                       EARS_Report::VERSION_MINOR,
+                       EARS_Report::VERSION_PATCH);
+}
+
+const char* EARS_report::getVersionDate()
+{
+    return EARS_Report::VERSION_DATE;
+}
+
+void EARS_report::getVersionString(char* buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+EARS_report &using_report()
+{
+    static EARS_report instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_reportLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,278 @@
+/**
+ * @file EARS_reportLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Inventory reports from the record stores, streamed to CSV or PDF
+ * @details One report runs at a time, in slices of REPORT_SLICE_MS from
+ *          service() on Core 1, like a bulk transfer, so a report over a
+ *          large inventory never holds up the UI or the other jobs.
+ *
+ *          Every report is one pass over the store in ID order, a chunk of
+ *          REPORT_CHUNK_RECORDS at a time:
+ *
+ *            REPORT_STOCK           Items and quantity per category
+ *                                   (equipment) or calibre (ammunition)
+ *            REPORT_HOLDINGS        Items and quantity per holder zap number
+ *            REPORT_INSPECTION_DUE  Equipment not inspected since the date
+ *            REPORT_EXPIRY          Ammunition expiring on or before the date
+ *
+ *          Listing reports write each matching item as it is read. Grouped
+ *          reports add into a fixed table of REPORT_MAX_GROUPS groups
+ *          (further groups are summed into one "(other)" row) and write the
+ *          table, sorted, after the pass. Memory is the same for ten items
+ *          or a hundred thousand.
+ *
+ *          Output goes through a REPORT_BUFFER_SIZE buffer appended to
+ *          "<path>.part", which is renamed over the target when complete;
+ *          a cancelled or failed report leaves nothing behind. A PDF is
+ *          plain PDF 1.4 in the built-in Courier font, so columns line up
+ *          without font metrics: each page is built in a fixed buffer and
+ *          written out whole, and only the object offsets are kept for the
+ *          cross-reference table, which caps a PDF at REPORT_PDF_MAX_PAGES.
+ *
+ *          The progress callback runs on Core 1 after every slice; UI code
+ *          posts it on with MAIN_ui_cmd_call().
+ *
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_REPORT_LIB_H__
+#define __EARS_REPORT_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include "EARS_versionDef.h"
+#include "EARS_sdCardLib.h"
+#include "EARS_recordStoreLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_Report
+{
+    constexpr const char* LIB_NAME = "EARS_report";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+#define REPORT_BUFFER_SIZE 4096         // File write buffer
+#define REPORT_CHUNK_RECORDS 32         // Records per readPage()
+#define REPORT_MAX_GROUPS 128           // Grouped report rows before "(other)"
+#define REPORT_GROUP_KEY_SIZE 24        // Longest group name + NUL
+#define REPORT_SLICE_MS 50              // Work per service() call
+#define REPORT_SERVICE_PERIOD_MS 20     // Suggested job period
+#define REPORT_PART_SUFFIX ".part"
+#define REPORT_TITLE_SIZE 64
+
+// PDF layout: A4, Courier 8 pt (4.8 pt per character)
+#define REPORT_PDF_PAGE_LINES 72        // Text lines per page, headings included
+#define REPORT_PDF_LINE_CHARS 108       // Characters across the printable width
+#define REPORT_PDF_PAGE_SIZE 12288      // One page's content stream
+#define REPORT_PDF_MAX_PAGES 256        // Rows beyond this are left out
+
+/**
+ * @brief What a report shows
+ */
+enum EARS_reportKind : uint8_t
+{
+    REPORT_STOCK = 0,
+    REPORT_HOLDINGS,
+    REPORT_INSPECTION_DUE,      // Equipment stores only
+    REPORT_EXPIRY               // Ammunition stores only
+};
+
+/**
+ * @brief Output formats
+ */
+enum EARS_reportFormat : uint8_t
+{
+    REPORT_CSV = 0,
+    REPORT_PDF
+};
+
+/**
+ * @brief Report life cycle
+ */
+enum EARS_reportState : uint8_t
+{
+    REPORT_IDLE = 0,
+    REPORT_STARTING,            // Accepted, opens on the next service()
+    REPORT_RUNNING,
+    REPORT_DONE,
+    REPORT_FAILED,
+    REPORT_CANCELLED
+};
+
+/**
+ * @brief Where a report has got to
+ */
+struct EARS_reportProgress
+{
+    EARS_reportState state;
+    EARS_reportKind kind;
+    uint32_t records;           // Items read
+    uint32_t recordsTotal;      // Items in the store when the report started
+    uint32_t rows;              // Rows written
+    uint32_t bytes;             // File bytes written
+    uint16_t pages;             // PDF pages written
+    bool truncated;             // Groups folded into "(other)", or PDF page cap hit
+    uint32_t elapsedMs;
+};
+
+/**
+ * @brief Progress report (Core 1)
+ * @param progress Snapshot after the latest slice
+ * @param ctx Context given to start()
+ */
+typedef void (*EARS_reportProgressCb)(const EARS_reportProgress& progress, void* ctx);
+
+/******************************************************************************
+ * EARS_report Class
+ *****************************************************************************/
+class EARS_report
+{
+public:
+    EARS_report();
+
+    // Version information getters
+    static const char* getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char* getVersionDate();
+    static void getVersionString(char* buffer);
+
+    /**
+     * @brief Queue a report
+     * @param sdCard Mounted SD card
+     * @param store Store to report on
+     * @param kind What to report (must suit the store's type)
+     * @param date YYYYMMDD for REPORT_INSPECTION_DUE and REPORT_EXPIRY;
+     *        with REPORT_STOCK on ammunition, lots expiring on or before it
+     *        are counted (0 = none)
+     * @param path File to write (replaced when complete)
+     * @param format REPORT_CSV or REPORT_PDF
+     * @param callback Progress callback, NULL for none
+     * @param ctx Passed to callback
+     * @return true if accepted (no report was running)
+     */
+    bool start(EARS_sdCard* sdCard, EARS_recordStore* store, EARS_reportKind kind, uint32_t date,
+               const char* path, EARS_reportFormat format, EARS_reportProgressCb callback, void* ctx);
+
+    /**
+     * @brief Stop the running report at the end of its slice
+     * @details The partial file is removed
+     */
+    void cancel();
+
+    /**
+     * @brief Run one slice of the current report
+     * @details Call periodically from Core 1 (REPORT_SERVICE_PERIOD_MS)
+     */
+    void service();
+
+    bool isBusy() const;
+    EARS_reportProgress getProgress() const;
+
+private:
+    struct Column
+    {
+        const char* title;
+        uint8_t width;           // PDF characters, separator included
+    };
+
+    struct Group
+    {
+        char key[REPORT_GROUP_KEY_SIZE];
+        uint32_t items;
+        uint32_t quantity;
+        uint32_t flagged;        // Issued (equipment) or expiring (ammunition)
+    };
+
+    // Request (written while idle, under _mux)
+    EARS_sdCard* _sdCard;
+    EARS_recordStore* _store;
+    EARS_reportKind _kind;
+    uint32_t _date;
+    char _path[64];
+    char _partPath[72];
+    EARS_reportFormat _format;
+    EARS_reportProgressCb _callback;
+    void* _ctx;
+    volatile bool _cancel;
+
+    // Working state (Core 1 only)
+    char* _buffer;               // REPORT_BUFFER_SIZE
+    size_t _bufferLen;
+    uint32_t _written;           // File offset of the next byte
+    EARS_record* _chunk;         // REPORT_CHUNK_RECORDS
+    uint32_t _position;          // Next index position
+    const Column* _columns;
+    uint8_t _columnCount;
+    char _title[REPORT_TITLE_SIZE];
+    Group* _groups;              // REPORT_MAX_GROUPS + 1, the last is "(other)"
+    uint16_t _groupCount;
+    uint32_t _totalItems;
+    uint32_t _totalQuantity;
+    uint32_t _totalFlagged;
+    uint32_t _startMs;
+
+    // PDF (Core 1 only)
+    char* _page;                 // REPORT_PDF_PAGE_SIZE
+    size_t _pageLen;
+    uint8_t _pageLines;
+    uint16_t _pages;
+    uint32_t* _offsets;          // Object offsets for the xref table
+
+    EARS_reportProgress _progress;
+    mutable portMUX_TYPE _mux;
+
+    bool open();
+    void finish(EARS_reportState state);
+    void report();
+    void fail();
+
+    // Report pass
+    bool scanSlice(uint32_t deadlineMs);
+    bool listRecord(const EARS_record& record);
+    void groupRecord(const EARS_record& record);
+    Group* findGroup(const char* key);
+    bool writeGroups();
+    bool writeTotals();
+    bool isGrouped() const { return _kind == REPORT_STOCK || _kind == REPORT_HOLDINGS; }
+    static const Column* columnsFor(EARS_reportKind kind, EARS_recordType type, uint8_t& count);
+
+    // Output
+    bool writeHeading();
+    bool writeRow(const char* const* cells);
+    bool emit(const char* text, size_t length);
+    bool emitf(const char* format, ...);
+    bool flushBuffer();
+
+    // PDF
+    bool pdfBegin();
+    bool pdfLine(const char* text, size_t length);
+    void pageText(const char* text, size_t length);
+    bool pdfEndPage();
+    bool pdfEnd();
+    bool pdfObject(uint16_t number);
+    static size_t pdfEscape(const char* text, size_t length, char* out, size_t size);
+};
+
+// Global instance access function (Singleton pattern)
+EARS_report &using_report();
+
+#endif // __EARS_REPORT_LIB_H__
+
+/******************************************************************************
+ * End of EARS_reportLib.h
+ ******************************************************************************/
@@ -0,0 +1,496 @@
+/**
+ * @file EARS_rtosTraceLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Scheduling trace: task runs per core and project events in a PSRAM snapshot
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+#include "EARS_rtosTraceLib.h"
+
+#if EARS_RTOS_TRACE == 1
+
+#include "EARS_sdCardLib.h"
+#include <esp_freertos_hooks.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <new>
+#if ESP_IDF_VERSION_MAJOR >= 5
+#include <esp_private/cache_utils.h>
+#else
+#include <esp_spi_flash.h>
+#endif
+
+static_assert((RTOS_TRACE_EVENTS & (RTOS_TRACE_EVENTS - 1)) == 0,
+              "RTOS_TRACE_EVENTS must be a power of two");
+
+// Task slot for tasks past RTOS_TRACE_MAX_TASKS
+#define RTOS_TRACE_TASK_OTHER 0xFF
+
+// Zero-initialised, so interrupts can reach it before any constructor has run
+static EARS_rtosTrace rtos_trace_instance;
+
+// Export names, in EARS_rtosTraceId order
+static const char *const rtos_trace_names[RTOS_TRACE_ID_COUNT] = {
+    "flush", "display mutex wait", "display mutex hold", "touch sample",
+    "log write", "touch irq", "te irq", "trigger"};
+
+// Tick hooks, one per core
+static void IRAM_ATTR rtos_trace_tick_core0(void)
+{
+    rtos_trace_instance.tick(0);
+}
+
+static void IRAM_ATTR rtos_trace_tick_core1(void)
+{
+    rtos_trace_instance.tick(1);
+}
+
+// Allocate the buffer, register the tick hooks and start a capture
+bool EARS_rtosTrace::begin(EARS_rtosTraceMode mode)
+{
+    if (_events == nullptr)
+    {
+        _events = (Event *)heap_caps_malloc(RTOS_TRACE_EVENTS * sizeof(Event), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (_events == nullptr)
+        {
+            Serial.println("[RTOS TRACE] ERROR: No PSRAM for the event buffer");
+            return false;
+        }
+        for (uint32_t i = 0; i < RTOS_TRACE_EVENTS; i++)
+        {
+            new (&_events[i].sequence) std::atomic<uint32_t>(0);
+        }
+
+        if (esp_register_freertos_tick_hook_for_cpu(rtos_trace_tick_core0, 0) != ESP_OK ||
+            esp_register_freertos_tick_hook_for_cpu(rtos_trace_tick_core1, 1) != ESP_OK)
+        {
+            // Events are still recorded, without the task runs
+            Serial.println("[RTOS TRACE] WARNING: Tick hooks unavailable, no task runs");
+        }
+    }
+
+    _mode = mode;
+    start();
+
+    Serial.printf("[RTOS TRACE] Recording %s, %d events\n", mode == RTOS_TRACE_RING ? "until trigger()" : "one shot",
+                  RTOS_TRACE_EVENTS);
+    return true;
+}
+
+// Start a new capture (the buffer is cleared)
+void EARS_rtosTrace::start()
+{
+    if (_events == nullptr)
+    {
+        return;
+    }
+
+    _recording.store(false, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < RTOS_TRACE_EVENTS; i++)
+    {
+        _events[i].sequence.store(0, std::memory_order_relaxed);
+    }
+    _lastTask[0] = nullptr;
+    _lastTask[1] = nullptr;
+    _dropped.store(0, std::memory_order_relaxed);
+    _head.store(0, std::memory_order_relaxed);
+    _stopAt.store(_mode == RTOS_TRACE_RING ? UINT32_MAX : RTOS_TRACE_EVENTS, std::memory_order_relaxed);
+    _saved = false;
+    _recording.store(true, std::memory_order_release);
+}
+
+// End the capture now
+void EARS_rtosTrace::stop()
+{
+    if (!_recording.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    uint32_t end = _head.load(std::memory_order_relaxed);
+    if (end < _stopAt.load(std::memory_order_relaxed))
+    {
+        _stopAt.store(end, std::memory_order_relaxed);
+    }
+    _recording.store(false, std::memory_order_release);
+}
+
+// Ring mode: end the capture half a buffer from now
+void EARS_rtosTrace::trigger()
+{
+    if (!_recording.load(std::memory_order_relaxed) || _stopAt.load(std::memory_order_relaxed) != UINT32_MAX)
+    {
+        return;
+    }
+    record(RTOS_TRACE_KIND_MARK, RTOS_TRACE_TRIGGER, 0);
+    _stopAt.store(_head.load(std::memory_order_relaxed) + RTOS_TRACE_EVENTS / 2, std::memory_order_relaxed);
+}
+
+// Record one event (any task or interrupt)
+void IRAM_ATTR EARS_rtosTrace::record(uint8_t kind, uint8_t id, uint32_t value)
+{
+    if (!_recording.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    // The buffer is in PSRAM, behind the cache an interrupt may find off
+    if (!spi_flash_cache_enabled())
+    {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    uint32_t position = _head.fetch_add(1, std::memory_order_relaxed);
+    if (position >= _stopAt.load(std::memory_order_relaxed))
+    {
+        _recording.store(false, std::memory_order_relaxed);
+        return;
+    }
+
+    Event &event = _events[position & (RTOS_TRACE_EVENTS - 1)];
+    event.sequence.store(0, std::memory_order_relaxed);
+    event.timeUs = (uint32_t)esp_timer_get_time();
+    event.kind = kind;
+    event.id = id;
+    event.core = (uint8_t)xPortGetCoreID();
+    event.value = value;
+    event.sequence.store(position + 1, std::memory_order_release);
+}
+
+// Tick hook body: record the interrupted task when it changed
+void IRAM_ATTR EARS_rtosTrace::tick(uint8_t core)
+{
+    if (!_recording.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+#if ESP_IDF_VERSION_MAJOR >= 5
+    void *task = xTaskGetCurrentTaskHandleForCore(core);
+#else
+    void *task = xTaskGetCurrentTaskHandleForCPU(core);
+#endif
+    if (task == _lastTask[core])
+    {
+        return;
+    }
+    _lastTask[core] = task;
+    record(RTOS_TRACE_KIND_TASK, taskSlot(task), 0);
+}
+
+// Slot of a task's name, taken the first time it is seen
+uint8_t IRAM_ATTR EARS_rtosTrace::taskSlot(void *handle)
+{
+    uint16_t used = _taskCount.load(std::memory_order_acquire);
+    if (used > RTOS_TRACE_MAX_TASKS)
+    {
+        used = RTOS_TRACE_MAX_TASKS;
+    }
+    for (uint16_t i = 0; i < used; i++)
+    {
+        if (_tasks[i].handle == handle)
+        {
+            return (uint8_t)i;
+        }
+    }
+
+    uint16_t slot = _taskCount.fetch_add(1, std::memory_order_relaxed);
+    if (slot >= RTOS_TRACE_MAX_TASKS)
+    {
+        _taskCount.store(RTOS_TRACE_MAX_TASKS, std::memory_order_relaxed);
+        return RTOS_TRACE_TASK_OTHER;
+    }
+
+    // Name first, handle last: a lookup only matches a complete slot
+    const char *name = pcTaskGetName((TaskHandle_t)handle);
+    uint8_t i = 0;
+    for (; name != nullptr && name[i] != '\0' && i < RTOS_TRACE_TASK_NAME_SIZE - 1; i++)
+    {
+        _tasks[slot].name[i] = name[i];
+    }
+    _tasks[slot].name[i] = '\0';
+    std::atomic_thread_fence(std::memory_order_release);
+    _tasks[slot].handle = handle;
+    return (uint8_t)slot;
+}
+
+// First and end positions of the events still in the buffer
+bool EARS_rtosTrace::bounds(uint32_t &first, uint32_t &end) const
+{
+    end = _head.load(std::memory_order_acquire);
+    uint32_t stopAt = _stopAt.load(std::memory_order_relaxed);
+    if (end > stopAt)
+    {
+        end = stopAt;
+    }
+    first = end > RTOS_TRACE_EVENTS ? end - RTOS_TRACE_EVENTS : 0;
+    return _events != nullptr && end > first;
+}
+
+// Write the capture as Chrome trace JSON through a writer
+void EARS_rtosTrace::exportJson(WriteFn write, void *ctx)
+{
+    uint32_t first, end;
+    if (!bounds(first, end))
+    {
+        first = end = 0;
+    }
+
+    // Lines gathered into blocks, so the SD card sees few large writes
+    char block[1024];
+    size_t used = 0;
+    char line[160];
+
+    auto emit = [&](int length) {
+        if (length <= 0)
+        {
+            return;
+        }
+        if ((size_t)length >= sizeof(line))
+        {
+            length = sizeof(line) - 1;
+        }
+        if (used + length > sizeof(block))
+        {
+            write(block, used, ctx);
+            used = 0;
+        }
+        memcpy(block + used, line, length);
+        used += length;
+    };
+
+    emit(snprintf(line, sizeof(line),
+                  "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+                  "{\"ph\":\"M\",\"pid\":0,\"name\":\"process_name\",\"args\":{\"name\":\"EARS\"}}"));
+    for (uint8_t core = 0; core < 2; core++)
+    {
+        emit(snprintf(line, sizeof(line),
+                      ",\n{\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"Core %u tasks\"}}"
+                      ",\n{\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"Core %u events\"}}",
+                      core * 2, core, core * 2 + 1, core));
+    }
+
+    // Task runs: from one task sample to the next on the same core
+    uint8_t runTask[2] = {RTOS_TRACE_TASK_OTHER, RTOS_TRACE_TASK_OTHER};
+    uint32_t runStart[2] = {0, 0};
+    bool running[2] = {false, false};
+    uint32_t t0 = 0;
+    uint32_t last = 0;
+    bool started = false;
+    uint16_t tasks = _taskCount.load(std::memory_order_acquire);
+
+    auto taskName = [&](uint8_t slot) -> const char * {
+        return slot < tasks && slot < RTOS_TRACE_MAX_TASKS ? _tasks[slot].name : "other";
+    };
+
+    for (uint32_t position = first; position < end; position++)
+    {
+        const Event &event = _events[position & (RTOS_TRACE_EVENTS - 1)];
+        if (event.sequence.load(std::memory_order_acquire) != position + 1)
+        {
+            // Not written yet, or overwritten while this ran
+            continue;
+        }
+
+        if (!started)
+        {
+            t0 = event.timeUs;
+            started = true;
+        }
+        uint32_t t = event.timeUs - t0;
+        last = t;
+        uint8_t core = event.core & 1;
+
+        switch (event.kind)
+        {
+        case RTOS_TRACE_KIND_TASK:
+            if (running[core])
+            {
+                emit(snprintf(line, sizeof(line),
+                              ",\n{\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"name\":\"%s\",\"ts\":%lu,\"dur\":%lu}",
+                              core * 2, taskName(runTask[core]), (unsigned long)runStart[core],
+                              (unsigned long)(t - runStart[core])));
+            }
+            runTask[core] = event.id;
+            runStart[core] = t;
+            running[core] = true;
+            break;
+
+        case RTOS_TRACE_KIND_BEGIN:
+        case RTOS_TRACE_KIND_END:
+            if (event.id < RTOS_TRACE_ID_COUNT)
+            {
+                emit(snprintf(line, sizeof(line),
+                              ",\n{\"ph\":\"%c\",\"cat\":\"ears\",\"id\":%u,\"pid\":0,\"tid\":%u,\"name\":\"%s\",\"ts\":%lu}",
+                              event.kind == RTOS_TRACE_KIND_BEGIN ? 'b' : 'e', core, core * 2 + 1,
+                              rtos_trace_names[event.id], (unsigned long)t));
+            }
+            break;
+
+        case RTOS_TRACE_KIND_MARK:
+            if (event.id < RTOS_TRACE_ID_COUNT)
+            {
+                emit(snprintf(line, sizeof(line),
+                              ",\n{\"ph\":\"i\",\"s\":\"t\",\"pid\":0,\"tid\":%u,\"name\":\"%s\",\"ts\":%lu,"
+                              "\"args\":{\"value\":%lu}}",
+                              core * 2 + 1, rtos_trace_names[event.id], (unsigned long)t,
+                              (unsigned long)event.value));
+            }
+            break;
+        }
+    }
+
+    // Runs still open at the last event
+    for (uint8_t core = 0; core < 2; core++)
+    {
+        if (running[core] && last > runStart[core])
+        {
+            emit(snprintf(line, sizeof(line),
+                          ",\n{\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"name\":\"%s\",\"ts\":%lu,\"dur\":%lu}",
+                          core * 2, taskName(runTask[core]), (unsigned long)runStart[core],
+                          (unsigned long)(last - runStart[core])));
+        }
+    }
+
+    emit(snprintf(line, sizeof(line), "\n]}\n"));
+    if (used > 0)
+    {
+        write(block, used, ctx);
+    }
+}
+
+// SD card writer: appends, remembers a failure
+struct RtosTraceFile
+{
+    const char *path;
+    bool ok;
+};
+
+static void rtos_trace_write_file(const char *text, size_t length, void *ctx)
+{
+    RtosTraceFile *file = (RtosTraceFile *)ctx;
+    if (file->ok)
+    {
+        file->ok = using_sdcard().appendData(file->path, (const uint8_t *)text, length);
+    }
+}
+
+static void rtos_trace_write_serial(const char *text, size_t length, void *ctx)
+{
+    (void)ctx;
+    Serial.write((const uint8_t *)text, length);
+}
+
+// Write the capture as Chrome trace JSON to the SD card
+bool EARS_rtosTrace::save(const char *path)
+{
+    stop();
+
+    EARS_sdCard &sd = using_sdcard();
+    if (!sd.isAvailable() || !sd.createDirectory(RTOS_TRACE_DIR))
+    {
+        return false;
+    }
+    if (sd.fileExists(path))
+    {
+        sd.removeFile(path);
+    }
+
+    RtosTraceFile file = {path, true};
+    exportJson(rtos_trace_write_file, &file);
+    sd.flush(path);
+    return file.ok;
+}
+
+// Write the capture as Chrome trace JSON to Serial (USB CDC)
+void EARS_rtosTrace::dump()
+{
+    stop();
+    exportJson(rtos_trace_write_serial, nullptr);
+}
+
+// Save a capture once it has ended (Core 1 job)
+void EARS_rtosTrace::service()
+{
+    if (_events == nullptr || _saved || _recording.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    EARS_rtosTraceStats stats;
+    getStats(&stats);
+    _saved = save();
+    if (_saved)
+    {
+        Serial.printf("[RTOS TRACE] %lu events over %lu ms (%lu dropped) saved to " RTOS_TRACE_PATH "\n",
+                      (unsigned long)stats.events, (unsigned long)(stats.spanUs / 1000),
+                      (unsigned long)stats.dropped);
+    }
+}
+
+// Capture counters
+void EARS_rtosTrace::getStats(EARS_rtosTraceStats *stats) const
+{
+    uint32_t first, end;
+    memset(stats, 0, sizeof(*stats));
+    stats->recording = _recording.load(std::memory_order_relaxed);
+    stats->saved = _saved;
+    stats->dropped = _dropped.load(std::memory_order_relaxed);
+    stats->tasks = _taskCount.load(std::memory_order_relaxed);
+    if (bounds(first, end))
+    {
+        stats->events = end - first;
+        const Event &oldest = _events[first & (RTOS_TRACE_EVENTS - 1)];
+        const Event &newest = _events[(end - 1) & (RTOS_TRACE_EVENTS - 1)];
+        stats->spanUs = newest.timeUs - oldest.timeUs;
+    }
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char *EARS_rtosTrace::getLibraryName()
+{
+    return EARS_RtosTrace::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t EARS_rtosTrace::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_RtosTrace::VERSION_MAJOR,
+                       EARS_RtosTrace::VERSION_MINOR,
+                       EARS_RtosTrace::VERSION_PATCH);
+}
+
+// Get version date
+const char *EARS_rtosTrace::getVersionDate()
+{
+    return EARS_RtosTrace::VERSION_DATE;
+}
+
+// Format version as string
+void EARS_rtosTrace::getVersionString(char *buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/**
+ * @brief Get reference to global RTOS trace instance
+ *
+ * @return EARS_rtosTrace& Reference to the global RTOS trace instance
+ */
+EARS_rtosTrace &IRAM_ATTR using_rtostrace()
+{
+    return rtos_trace_instance;
+}
+
+#endif // EARS_RTOS_TRACE == 1
+
+/******************************************************************************
+ * End of EARS_rtosTraceLib.cpp
+ *****************************************************************************/
@@ -0,0 +1,294 @@
+/**
+ * @file EARS_rtosTraceLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Scheduling trace: task runs per core and project events in a PSRAM snapshot
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * Features:
+ * - Which task runs on each core, sampled at every FreeRTOS tick
+ * - Project spans and marks: display flush, display mutex wait and hold,
+ *   touch sample, log write, touch and TE interrupts
+ * - One lock-free buffer in PSRAM, one fetch_add per event, ISR-safe
+ * - One-shot capture from begin(), or a ring frozen by trigger()
+ * - Exported as Chrome trace JSON (Perfetto, chrome://tracing), to the SD
+ *   card or over USB CDC
+ * - Compiled out completely unless built with -D EARS_RTOS_TRACE=1
+ *
+ * @details
+ * SystemView and the FreeRTOS trace recorders hook traceTASK_SWITCHED_IN
+ * inside the kernel, which the Arduino core ships prebuilt. This library
+ * uses the per-core tick hooks instead: each tick records the task it
+ * interrupted when that differs from the last tick's. A task that runs for
+ * less than a tick between two others is not seen; runs are accurate to
+ * one tick (1 ms).
+ *
+ * Events carry esp_timer microseconds, so the two cores share a timebase.
+ * PSRAM is not reachable while the flash cache is off (NVS and OTA writes);
+ * events raised from interrupts then are counted as dropped.
+ *
+ * In the export each core has two tracks: "Core N tasks" with the task
+ * runs, and "Core N events" with the spans and marks. Waits on the display
+ * mutex next to another task's hold are priority inversion candidates; the
+ * gap from a touch IRQ mark to its touch sample span is the input latency.
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_RTOS_TRACE_LIB_H__
+#define __EARS_RTOS_TRACE_LIB_H__
+
+/******************************************************************************
+ * RTOS Trace Configuration
+ *****************************************************************************/
+
+// 1 = events recorded (pio env rtos_trace), 0 = every macro compiles to nothing
+#ifndef EARS_RTOS_TRACE
+#define EARS_RTOS_TRACE 0
+#endif
+
+#include <stdint.h>
+
+/**
+ * @enum EARS_rtosTraceId
+ * @brief Project events (one name each in the export)
+ */
+enum EARS_rtosTraceId : uint8_t
+{
+    RTOS_TRACE_FLUSH = 0,       // Span: one area sent to the panel (MAIN_lvglLib)
+    RTOS_TRACE_MUTEX_WAIT,      // Span: waiting for xDisplayMutex
+    RTOS_TRACE_MUTEX_HOLD,      // Span: holding xDisplayMutex
+    RTOS_TRACE_TOUCH_SAMPLE,    // Span: one panel read (EARS_touch::getPoint)
+    RTOS_TRACE_LOG_WRITE,       // Span: one EARS_logger::log()
+    RTOS_TRACE_TOUCH_IRQ,       // Mark: touch INT edge
+    RTOS_TRACE_TE_IRQ,          // Mark: panel TE pulse
+    RTOS_TRACE_TRIGGER,         // Mark: trigger() called
+    RTOS_TRACE_ID_COUNT
+};
+
+#if EARS_RTOS_TRACE == 1
+
+/******************************************************************************
+ * Includes Information
+ *****************************************************************************/
+#include <Arduino.h>
+#include <atomic>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_RtosTrace
+{
+    constexpr const char *LIB_NAME = "EARS_rtosTrace";
+    constexpr const char *VERSION_MAJOR = "1";
+    constexpr const char *VERSION_MINOR = "0";
+    constexpr const char *VERSION_PATCH = "0";
+    constexpr const char *VERSION_DATE = "2026-10-15";
+}
+
+// Events held (power of two, 16 bytes each in PSRAM)
+#define RTOS_TRACE_EVENTS 32768
+
+// Task names kept for the export
+#define RTOS_TRACE_MAX_TASKS 24
+#define RTOS_TRACE_TASK_NAME_SIZE 16
+
+// Saved when a capture ends (service())
+#define RTOS_TRACE_DIR "/bench"
+#define RTOS_TRACE_PATH "/bench/trace.json"
+
+// service() period on Core 1
+#define RTOS_TRACE_SERVICE_MS 1000
+
+/**
+ * @enum EARS_rtosTraceMode
+ * @brief How a capture ends
+ */
+enum EARS_rtosTraceMode : uint8_t
+{
+    RTOS_TRACE_ONE_SHOT = 0, // When the buffer is full
+    RTOS_TRACE_RING          // Half a buffer after trigger(), oldest overwritten until then
+};
+
+/**
+ * @struct EARS_rtosTraceStats
+ * @brief Capture counters
+ */
+struct EARS_rtosTraceStats
+{
+    bool recording;    // Capture running
+    bool saved;        // Last capture written by service()
+    uint32_t events;   // Events in the buffer
+    uint32_t dropped;  // Events raised with the flash cache off
+    uint16_t tasks;    // Tasks seen
+    uint32_t spanUs;   // First to last event
+};
+
+class EARS_rtosTrace
+{
+public:
+    // Version information getters
+    static const char *getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char *getVersionDate();
+    static void getVersionString(char *buffer);
+
+    /**
+     * @brief Allocate the buffer, register the tick hooks and start a capture
+     * @param mode RTOS_TRACE_ONE_SHOT or RTOS_TRACE_RING
+     * @return true if recording
+     */
+    bool begin(EARS_rtosTraceMode mode = RTOS_TRACE_ONE_SHOT);
+
+    /**
+     * @brief Start a new capture (the buffer is cleared)
+     */
+    void start();
+
+    /**
+     * @brief End the capture now
+     */
+    void stop();
+
+    /**
+     * @brief Ring mode: end the capture half a buffer from now
+     */
+    void trigger();
+
+    /**
+     * @brief Record one event (any task or interrupt)
+     * @param kind RTOS_TRACE_KIND_*
+     * @param id EARS_rtosTraceId (or task slot for RTOS_TRACE_KIND_TASK)
+     * @param value Mark value
+     */
+    void record(uint8_t kind, uint8_t id, uint32_t value);
+
+    /**
+     * @brief Write the capture as Chrome trace JSON to the SD card
+     * @param path File (replaced)
+     * @return true if written
+     * @note Stops a running capture.
+     */
+    bool save(const char *path = RTOS_TRACE_PATH);
+
+    /**
+     * @brief Write the capture as Chrome trace JSON to Serial (USB CDC)
+     * @note Stops a running capture. Save it with the monitor's log option.
+     */
+    void dump();
+
+    /**
+     * @brief Save a capture once it has ended (Core 1 job)
+     */
+    void service();
+
+    /**
+     * @brief Capture counters
+     * @param stats Receives the counters
+     */
+    void getStats(EARS_rtosTraceStats *stats) const;
+
+    /**
+     * @brief Tick hook body (per core)
+     * @param core Core whose tick it is
+     */
+    void tick(uint8_t core);
+
+    enum : uint8_t
+    {
+        RTOS_TRACE_KIND_TASK = 0, // id = task slot: now running on this core
+        RTOS_TRACE_KIND_BEGIN,
+        RTOS_TRACE_KIND_END,
+        RTOS_TRACE_KIND_MARK
+    };
+
+private:
+    struct Event
+    {
+        std::atomic<uint32_t> sequence; // Position + 1 once written
+        uint32_t timeUs;
+        uint8_t kind;
+        uint8_t id;
+        uint8_t core;
+        uint8_t reserved;
+        uint32_t value;
+    };
+
+    struct Task
+    {
+        void *handle;
+        char name[RTOS_TRACE_TASK_NAME_SIZE];
+    };
+
+    typedef void (*WriteFn)(const char *text, size_t length, void *ctx);
+
+    uint8_t taskSlot(void *handle);
+    bool bounds(uint32_t &first, uint32_t &end) const;
+    void exportJson(WriteFn write, void *ctx);
+
+    Event *_events;
+    Task _tasks[RTOS_TRACE_MAX_TASKS];
+    std::atomic<uint16_t> _taskCount;
+    std::atomic<uint32_t> _head;      // Next position
+    std::atomic<uint32_t> _stopAt;    // Position the capture ends at
+    std::atomic<uint32_t> _dropped;
+    std::atomic<bool> _recording;
+    void *_lastTask[2];               // Per tick hook
+    EARS_rtosTraceMode _mode;
+    bool _saved;
+};
+
+// Global instance access function (ISR-safe)
+EARS_rtosTrace &using_rtostrace();
+
+/**
+ * @class EARS_rtosTraceScope
+ * @brief A span from construction to the end of its scope
+ */
+class EARS_rtosTraceScope
+{
+public:
+    inline explicit EARS_rtosTraceScope(EARS_rtosTraceId id) : _id(id)
+    {
+        using_rtostrace().record(EARS_rtosTrace::RTOS_TRACE_KIND_BEGIN, _id, 0);
+    }
+
+    inline ~EARS_rtosTraceScope()
+    {
+        using_rtostrace().record(EARS_rtosTrace::RTOS_TRACE_KIND_END, _id, 0);
+    }
+
+private:
+    EARS_rtosTraceScope(const EARS_rtosTraceScope &) = delete;
+    EARS_rtosTraceScope &operator=(const EARS_rtosTraceScope &) = delete;
+
+    EARS_rtosTraceId _id;
+};
+
+#define EARS_RTOS_TRACE_CONCAT2(a, b) a##b
+#define EARS_RTOS_TRACE_CONCAT(a, b) EARS_RTOS_TRACE_CONCAT2(a, b)
+
+// Spans, marks and the ring trigger
+#define EARS_RTOS_TRACE_SCOPE(id) EARS_rtosTraceScope EARS_RTOS_TRACE_CONCAT(ears_rtos_trace_, __LINE__)(id)
+#define EARS_RTOS_TRACE_BEGIN(id) using_rtostrace().record(EARS_rtosTrace::RTOS_TRACE_KIND_BEGIN, (id), 0)
+#define EARS_RTOS_TRACE_END(id) using_rtostrace().record(EARS_rtosTrace::RTOS_TRACE_KIND_END, (id), 0)
+#define EARS_RTOS_TRACE_MARK(id, value) using_rtostrace().record(EARS_rtosTrace::RTOS_TRACE_KIND_MARK, (id), (value))
+#define EARS_RTOS_TRACE_TRIGGER() using_rtostrace().trigger()
+
+#else
+
+#define EARS_RTOS_TRACE_SCOPE(id)
+#define EARS_RTOS_TRACE_BEGIN(id)
+#define EARS_RTOS_TRACE_END(id)
+#define EARS_RTOS_TRACE_MARK(id, value)
+#define EARS_RTOS_TRACE_TRIGGER()
+
+#endif // EARS_RTOS_TRACE == 1
+
+#endif // __EARS_RTOS_TRACE_LIB_H__
+
+/******************************************************************************
+ * End of EARS_rtosTraceLib.h
+ *****************************************************************************/
@@ -2,8 +2,8 @@
  * @file EARS_screenSaverLib.cpp
  * @author JTB & Claude Sonnet 4.2
  * @brief Screensaver library implementation header file
- * @version 2.0.0
- * @date 20260210
+ * @version 2.4.0
+ * @date 20261015
  * 
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -19,6 +19,19 @@ EARS_screenSaver::EARS_screenSaver() {
     _is_active = false;
     _last_activity_ms = 0;
     _screensaver_screen = nullptr;
+    _previous_screen = nullptr;
+    _logo = nullptr;
+    _anim_timer = nullptr;
+    _image_src = nullptr;
+    _dx = 0;
+    _dy = 0;
+    _is_deep_idle = false;
+    _activated_ms = 0;
+    _wake_count = 0;
+    _deep_idle_enter = nullptr;
+    _deep_idle_exit = nullptr;
+    _activity_pending = false;
+    _event_subscriber = -1;
     
     // Default settings
     _settings.enabled = true;
@@ -27,6 +40,7 @@ EARS_screenSaver::EARS_screenSaver() {
     _settings.animation_speed = 5;
     _settings.bounce_mode = true;
     _settings.backlight_restore = 255;
+    _settings.deep_idle_seconds = SS_DEEP_IDLE_DEFAULT_S;
 }
 
 /**
@@ -37,6 +51,10 @@ EARS_screenSaver::EARS_screenSaver() {
 void EARS_screenSaver::begin(lv_display_t* display) {
     _display = display;
     _last_activity_ms = millis();
+
+    if (_event_subscriber < 0) {
+        _event_subscriber = using_eventbus().subscribe(EVENT_MASK_USER_ACTIVITY, onEvent, this);
+    }
 }
 
 /**
@@ -102,6 +120,52 @@ void EARS_screenSaver::setBounceMode(bool bounce) {
     _settings.bounce_mode = bounce;
 }
 
+/**
+ * @brief  Set the logo image for the image modes
+ * @param src 
+ * @return void
+ */
+void EARS_screenSaver::setImageSource(const void* src) {
+    _image_src = src;
+}
+
+/**
+ * @brief  Set deep idle delay in seconds
+ * @param seconds 
+ * @return void
+ */
+void EARS_screenSaver::setDeepIdleDelay(uint16_t seconds) {
+    _settings.deep_idle_seconds = seconds;
+}
+
+/**
+ * @brief  Register deep idle entry/exit hooks
+ * @param enter 
+ * @param exit 
+ * @return void
+ */
+void EARS_screenSaver::setDeepIdleHooks(void (*enter)(void), void (*exit)(void)) {
+    _deep_idle_enter = enter;
+    _deep_idle_exit = exit;
+}
+
+/**
+ * @brief Check if deep idle is active
+ * @return true 
+ * @return false 
+ */
+bool EARS_screenSaver::isDeepIdle() const {
+    return _is_deep_idle;
+}
+
+/**
+ * @brief Get the screen the screensaver covers
+ * @return lv_obj_t* Screen shown before activation, nullptr when inactive
+ */
+lv_obj_t* EARS_screenSaver::getCoveredScreen() const {
+    return _is_active ? _previous_screen : nullptr;
+}
+
 /**
  * @brief Check if screensaver is active
  * @return true 
@@ -124,19 +188,44 @@ ScreensaverSettings EARS_screenSaver::getSettings() {
  * @return void
  */
 void EARS_screenSaver::update() {
+    if (_display == nullptr) return;
+
+    // Activity from the event bus restarts the timeout, or wakes the screen
+    if (_activity_pending) {
+        _activity_pending = false;
+        if (_is_active) {
+            deactivate();
+            return;
+        }
+    }
+
+    if (_is_active) {
+        // Any touch INT since activation wakes the screen
+        if (touchWakePending()) {
+            deactivate();
+            return;
+        }
+
+        // Deep idle needs the touch INT line to wake from
+        uint32_t deep_ms = (uint32_t)_settings.deep_idle_seconds * 1000;
+        if (!_is_deep_idle && deep_ms > 0 && using_touch().isInterruptEnabled() &&
+            millis() - _activated_ms >= deep_ms) {
+            enterDeepIdle();
+        }
+        return;
+    }
+
     if (!_settings.enabled) return;
     if (_settings.timeout_seconds == 0) return;  // Disabled via timeout
     
     uint32_t elapsed = millis() - _last_activity_ms;
     uint32_t timeout_ms = _settings.timeout_seconds * 1000;
     
-    if (!_is_active && elapsed >= timeout_ms) {
+    if (elapsed >= timeout_ms) {
         activate();
     }
-    
-    if (_is_active) {
-        updateAnimation();
-    }
+
+    // The logo moves from its own LVGL timer at SS_REFRESH_PERIOD_MS
 }
 
 /**
@@ -148,7 +237,11 @@ void EARS_screenSaver::activate() {
     
     saveBacklight();
     createScreensaverScreen();
+    _wake_count = using_touch().getInterruptCount();
+    _activated_ms = millis();
     _is_active = true;
+
+    using_eventbus().post(EVENT_SCREENSAVER_ON, _settings.mode);
 }
 
 /**
@@ -157,11 +250,17 @@ void EARS_screenSaver::activate() {
  */
 void EARS_screenSaver::deactivate() {
     if (!_is_active) return;
+
+    if (_is_deep_idle) {
+        exitDeepIdle();
+    }
     
     destroyScreensaverScreen();
     restoreBacklight();
     _is_active = false;
     reset();  // Reset timer
+
+    using_eventbus().post(EVENT_SCREENSAVER_OFF);
 }
 
 /**
@@ -169,7 +268,11 @@ void EARS_screenSaver::deactivate() {
  * @return void
  */
 void EARS_screenSaver::saveBacklight() {
-    // TODO: Implement backlight save
+    EARS_backLightManager& backlight = using_backlightmanager();
+    _settings.backlight_restore = backlight.getBrightness();
+
+    // Black mode shows nothing, so the backlight can go fully off
+    backlight.screenSaverActivate(_settings.mode == SS_MODE_BLACK ? 0 : SS_BACKLIGHT_DIM_LEVEL);
 }
 
 /**
@@ -177,7 +280,8 @@ void EARS_screenSaver::saveBacklight() {
  * @return void
  */
 void EARS_screenSaver::restoreBacklight() {
-    // TODO: Implement backlight restore
+    // The backlight manager fades back to the level it saved on activate
+    using_backlightmanager().screenSaverDeactivate();
 }
 
 /**
@@ -185,7 +289,46 @@ void EARS_screenSaver::restoreBacklight() {
  * @return void
  */
 void EARS_screenSaver::createScreensaverScreen() {
-    // TODO: Implement screen creation
+    if (_display == nullptr || _screensaver_screen != nullptr) return;
+
+    _previous_screen = lv_display_get_screen_active(_display);
+
+    // Plain black screen: no styles to draw beyond one fill
+    _screensaver_screen = lv_obj_create(NULL);
+    lv_obj_remove_style_all(_screensaver_screen);
+    lv_obj_set_style_bg_color(_screensaver_screen, lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(_screensaver_screen, LV_OPA_COVER, 0);
+    lv_obj_remove_flag(_screensaver_screen, LV_OBJ_FLAG_SCROLLABLE);
+
+    if (_settings.mode != SS_MODE_BLACK) {
+        bool imageMode = (_settings.mode == SS_MODE_BUILTIN_IMAGE ||
+                          _settings.mode == SS_MODE_USER_IMAGE);
+        if (imageMode && _image_src != nullptr) {
+            _logo = lv_image_create(_screensaver_screen);
+            lv_image_set_src(_logo, _image_src);
+        } else {
+            _logo = lv_label_create(_screensaver_screen);
+            lv_label_set_text(_logo, SS_LOGO_TEXT);
+            lv_obj_set_style_text_color(_logo, lv_color_white(), 0);
+        }
+        lv_obj_center(_logo);
+
+        int16_t step = _settings.animation_speed * SS_PIXELS_PER_SPEED;
+        _dx = step;
+        _dy = step;
+    }
+
+    lv_screen_load(_screensaver_screen);
+
+    // Few Hz is plenty for a logo step, and lets the UI task sleep longer
+    lv_timer_t* refr = lv_display_get_refr_timer(_display);
+    if (refr != nullptr) {
+        lv_timer_set_period(refr, SS_REFRESH_PERIOD_MS);
+    }
+
+    if (_logo != nullptr) {
+        _anim_timer = lv_timer_create(animationTimerCallback, SS_REFRESH_PERIOD_MS, this);
+    }
 }
 
 /**
@@ -193,7 +336,28 @@ void EARS_screenSaver::createScreensaverScreen() {
  * @return void
  */
 void EARS_screenSaver::destroyScreensaverScreen() {
-    // TODO: Implement screen destruction
+    if (_anim_timer != nullptr) {
+        lv_timer_delete(_anim_timer);
+        _anim_timer = nullptr;
+    }
+
+    if (_display != nullptr) {
+        lv_timer_t* refr = lv_display_get_refr_timer(_display);
+        if (refr != nullptr) {
+            lv_timer_set_period(refr, LV_DEF_REFR_PERIOD);
+        }
+    }
+
+    if (_screensaver_screen != nullptr) {
+        if (_previous_screen != nullptr) {
+            lv_screen_load(_previous_screen);
+        }
+        lv_obj_delete(_screensaver_screen);
+        _screensaver_screen = nullptr;
+    }
+
+    _previous_screen = nullptr;
+    _logo = nullptr;
 }
 
 /**
@@ -201,7 +365,116 @@ void EARS_screenSaver::destroyScreensaverScreen() {
  * @return void
  */
 void EARS_screenSaver::updateAnimation() {
-    // TODO: Implement animation
+    if (_logo == nullptr) return;
+
+    lv_obj_update_layout(_logo);
+    int32_t maxX = lv_display_get_horizontal_resolution(_display) - lv_obj_get_width(_logo);
+    int32_t maxY = lv_display_get_vertical_resolution(_display) - lv_obj_get_height(_logo);
+    if (maxX < 0) maxX = 0;
+    if (maxY < 0) maxY = 0;
+
+    int32_t x = lv_obj_get_x(_logo) + _dx;
+    int32_t y = lv_obj_get_y(_logo) + _dy;
+
+    if (_settings.bounce_mode) {
+        // Reflect off the edges
+        if (x < 0 || x > maxX) {
+            _dx = -_dx;
+            x = (x < 0) ? 0 : maxX;
+        }
+        if (y < 0 || y > maxY) {
+            _dy = -_dy;
+            y = (y < 0) ? 0 : maxY;
+        }
+    } else {
+        // Leave one edge, come back in at the opposite one
+        if (x > maxX) x = 0;
+        else if (x < 0) x = maxX;
+        if (y > maxY) y = 0;
+        else if (y < 0) y = maxY;
+    }
+
+    // Only the old and new logo areas are invalidated
+    lv_obj_set_pos(_logo, x, y);
+}
+
+/**
+ * @brief Private: LVGL timer trampoline for updateAnimation
+ * @param timer 
+ * @return void
+ */
+void EARS_screenSaver::animationTimerCallback(lv_timer_t* timer) {
+    EARS_screenSaver* self = (EARS_screenSaver*)lv_timer_get_user_data(timer);
+    if (self != nullptr) {
+        self->updateAnimation();
+    }
+}
+
+/**
+ * @brief Private: Suspend LVGL, backlight and touch scanning
+ * @return void
+ */
+void EARS_screenSaver::enterDeepIdle() {
+    // Panel is about to sleep, nothing needs lighting
+    using_backlightmanager().setBrightness(0);
+
+    // No refresh, indev or animation timers until wake
+    lv_timer_enable(false);
+
+    // Controller scans slowly and holds INT low while touched, so the
+    // low-rate wake check still sees a touch that spans a light sleep
+    using_touch().setPowerMode(POWER_MONITOR);
+    using_touch().setInterruptMode(FT6X36_INT_POLLING);
+    _wake_count = using_touch().getInterruptCount();
+
+    if (_deep_idle_enter) {
+        _deep_idle_enter();
+    }
+
+    _is_deep_idle = true;
+}
+
+/**
+ * @brief Private: Undo enterDeepIdle
+ * @return void
+ */
+void EARS_screenSaver::exitDeepIdle() {
+    if (_deep_idle_exit) {
+        _deep_idle_exit();
+    }
+
+    using_touch().setPowerMode(POWER_ACTIVE);
+    using_touch().setInterruptMode(FT6X36_INT_TRIGGER);
+    lv_timer_enable(true);
+
+    _is_deep_idle = false;
+}
+
+/**
+ * @brief Private: Event bus subscriber (runs in the dispatching task)
+ * @param event 
+ * @param userData 
+ * @return void
+ */
+void EARS_screenSaver::onEvent(const EARS_event& event, void* userData) {
+    EARS_screenSaver* self = (EARS_screenSaver*)userData;
+
+    // Latch only, LVGL work happens in update()
+    self->_last_activity_ms = millis();
+    self->_activity_pending = true;
+}
+
+/**
+ * @brief Private: Check for a touch INT since the screensaver was armed
+ * @return true 
+ * @return false 
+ */
+bool EARS_screenSaver::touchWakePending() {
+    if (!using_touch().isInterruptEnabled()) return false;
+
+    // Edges are lost in light sleep, the held level is not
+    return (using_touch().getInterruptCount() != _wake_count) ||
+           (_is_deep_idle && using_touch().isInterruptAsserted());
 }
 
 /******************************************************************************
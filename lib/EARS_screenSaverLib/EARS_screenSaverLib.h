@@ -2,8 +2,22 @@
  * @file EARS_screenSaverLib.h
  * @author JTB & Claude Sonnet 4.2
  * @brief Screensaver library implementation header file
- * @version 2.0.0
- * @date 20260210
+ * @details While active the screensaver shows a black screen with at most
+ *          one small bouncing logo, lowers the LVGL refresh rate to a few Hz
+ *          and dims the backlight through EARS_backLightManager. Only the
+ *          logo's old and new areas are invalidated each frame. Call
+ *          update(), activate() and deactivate() from the LVGL task.
+ *
+ *          After deep_idle_seconds more the screensaver enters deep idle:
+ *          LVGL timers are suspended, the backlight is off, the touch
+ *          controller drops to POWER_MONITOR and the registered deep idle
+ *          hooks put the panel and CPU to sleep. A touch (INT edge, or
+ *          INT held low in deep idle) wakes it all.
+ *
+ *          User activity arrives through the event bus (touch press and
+ *          release), so callers no longer need to call reset() themselves.
+ * @version 2.4.0
+ * @date 20261015
  * 
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -15,6 +29,9 @@
 #include <Arduino.h>
 #include "EARS_versionDef.h"
 #include <lvgl.h>
+#include "EARS_backLightManagerLib.h"
+#include "EARS_touchLib.h"
+#include "EARS_eventBusLib.h"
 
 
 /******************************************************************************
@@ -24,11 +41,30 @@ namespace EARS_ScreenSaver
 {
     constexpr const char* LIB_NAME = "EARS_screenSaver";
     constexpr const char* VERSION_MAJOR = "2";
-    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_MINOR = "4";
     constexpr const char* VERSION_PATCH = "0";
-    constexpr const char* VERSION_DATE = "2026-02-10";
+    constexpr const char* VERSION_DATE = "2026-10-15";
 }
 
+/******************************************************************************
+ * Screensaver Configuration
+ *****************************************************************************/
+
+// LVGL refresh and logo step period while active (4 Hz)
+#define SS_REFRESH_PERIOD_MS 250
+
+// Logo movement per step for each animation_speed unit (pixels)
+#define SS_PIXELS_PER_SPEED 2
+
+// Backlight level while a logo is shown (percent, black mode goes to 0)
+#define SS_BACKLIGHT_DIM_LEVEL 10
+
+// Text logo for SS_MODE_EARS_TEXT, and for image modes without an image
+#define SS_LOGO_TEXT "EARS"
+
+// Seconds of screensaver before deep idle (0 = never)
+#define SS_DEEP_IDLE_DEFAULT_S 60
+
 
 
 /**
@@ -38,8 +74,8 @@ namespace EARS_ScreenSaver
  * Modes:
  * - SS_MODE_BLACK: Blank screen
  * - SS_MODE_EARS_TEXT: "EARS" text animation
- * - SS_MODE_BUILTIN_IMAGE: Built-in image display
- * - SS_MODE_USER_IMAGE: User-defined image display
+ * - SS_MODE_BUILTIN_IMAGE: Built-in image display (see setImageSource)
+ * - SS_MODE_USER_IMAGE: User-defined image display (see setImageSource)
  */
 enum ScreensaverMode {
     SS_MODE_BLACK = 0,
@@ -59,6 +95,7 @@ enum ScreensaverMode {
  * - animation_speed: Animation speed (1-10 scale)
  * - bounce_mode: Bounce mode (true=bounce, false=wrap)
  * - backlight_restore: Backlight level to restore to
+ * - deep_idle_seconds: Screensaver time before deep idle (0 = never)
  */
 struct ScreensaverSettings {
     bool enabled;
@@ -67,6 +104,7 @@ struct ScreensaverSettings {
     uint8_t animation_speed;        // 1-10 scale
     bool bounce_mode;               // true=bounce, false=wrap
     uint8_t backlight_restore;      // Value to restore backlight to
+    uint16_t deep_idle_seconds;     // 0 = never enter deep idle
 };
 
 /**
@@ -98,6 +136,27 @@ public:
     void setMode(ScreensaverMode mode);
     void setAnimationSpeed(uint8_t speed);
     void setBounceMode(bool bounce);
+
+    /**
+     * @brief Set the logo image for the image modes
+     * @param src lv_image_dsc_t pointer or LVGL file path (nullptr = text logo)
+     * @note Keep the image small, the logo area is redrawn every step
+     */
+    void setImageSource(const void* src);
+
+    /**
+     * @brief Set how long the screensaver runs before deep idle
+     * @param seconds Delay after activation (0 = never)
+     */
+    void setDeepIdleDelay(uint16_t seconds);
+
+    /**
+     * @brief Register board hooks run on deep idle entry and exit
+     * @param enter Called last on entry (panel sleep, CPU power save)
+     * @param exit Called first on wake (undo enter)
+     * @note Both run in the LVGL task; either may be nullptr
+     */
+    void setDeepIdleHooks(void (*enter)(void), void (*exit)(void));
     
     // Control functions
     void reset();                   // Reset inactivity timer
@@ -107,6 +166,8 @@ public:
     
     // State queries
     bool isActive();
+    bool isDeepIdle() const;        // Safe from any task
+    lv_obj_t* getCoveredScreen() const; // Screen under the screensaver (nullptr when inactive)
     ScreensaverSettings getSettings();
     
 private:
@@ -115,6 +176,19 @@ private:
     uint32_t _last_activity_ms;
     bool _is_active;
     lv_obj_t* _screensaver_screen;
+    lv_obj_t* _previous_screen;
+    lv_obj_t* _logo;
+    lv_timer_t* _anim_timer;
+    const void* _image_src;
+    int16_t _dx;
+    int16_t _dy;
+    volatile bool _is_deep_idle;
+    uint32_t _activated_ms;
+    uint32_t _wake_count;           // Touch INT count when last armed
+    void (*_deep_idle_enter)(void);
+    void (*_deep_idle_exit)(void);
+    volatile bool _activity_pending;  // Set by the event bus subscriber
+    int8_t _event_subscriber;
     
     // Internal functions
     void createScreensaverScreen();
@@ -122,6 +196,11 @@ private:
     void saveBacklight();
     void restoreBacklight();
     void updateAnimation();
+    static void animationTimerCallback(lv_timer_t* timer);
+    void enterDeepIdle();
+    void exitDeepIdle();
+    bool touchWakePending();
+    static void onEvent(const EARS_event& event, void* userData);
 };
 
 /**
@@ -140,7 +219,7 @@ private:
  * // Set timeout
  * using_screensaver().setTimeout(30);
  * 
- * // Check in loop
+ * // Check in the LVGL task loop
  * using_screensaver().update();
  */
 EARS_screenSaver& using_screensaver();
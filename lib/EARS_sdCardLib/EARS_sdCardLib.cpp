@@ -2,45 +2,95 @@
  * @file EARS_sdCardLib.cpp
  * @author JTB & Claude Sonnet 4.2
  * @brief SD Card library implementation for ESP32-S3 using SD_MMC
- * @version 3.0.0
- * @date 20260210
+ * @version 3.16.0
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
 
 #include "EARS_sdCardLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_profileLib.h"
+#include <unistd.h>
+#include <esp_timer.h>
+#include <esp_heap_caps.h>
+#include <esp_rom_crc.h>
+#include <sdmmc_cmd.h>
+
+// Directories indexed in RAM, as created by performFullInitialization()
+static const char *const SD_INDEX_DIRS[SD_INDEX_DIR_COUNT] = {"/logs", "/config", "/images"};
+
+// SDMMCFS keeps its card handle protected; the CMD13 presence poll needs it
+class SDMMCCardAccess : public fs::SDMMCFS
+{
+public:
+    static sdmmc_card_t *card(fs::SDMMCFS &fs) { return static_cast<SDMMCCardAccess &>(fs)._card; }
+};
+
+EARS_sdCard::EARS_sdCard() : EARS_sdCard(SD_MMC, SDMMC_MOUNT_POINT)
+{
+}
 
-EARS_sdCard::EARS_sdCard() : _state(SD_NOT_INITIALIZED), _cardType(CARD_NONE)
+EARS_sdCard::EARS_sdCard(fs::FS &fs, const char *mountPoint)
+    : _fs(&fs), _mountPoint(mountPoint), _state(SD_NOT_INITIALIZED), _cardType(CARD_NONE),
+      _mode4bit(false), _frequencyKhz(0), _selfTestPassed(false),
+      _writeKBps(0), _readKBps(0), _useCounter(0), _index(nullptr), _indexCount(0),
+      _indexIncomplete(0), _indexReady(false), _indexTask(nullptr), _indexHits(0),
+      _indexFallbacks(0), _indexBuildMs(0), _monitor(false), _suspended(false), _lastPresenceMs(0), _nextRemountMs(0),
+      _remountDelayMs(SD_REMOUNT_RETRY_MS), _queueCount(0), _queueBytes(0), _queueDropped(0),
+      _interactiveReads(0), _lastInteractiveMs(0), _writeTotalUs(0), _readTotalUs(0)
 {
+    for (uint8_t i = 0; i < SD_WRITE_BUFFERS; i++)
+    {
+        _writeBuffers[i].data = nullptr;
+        _writeBuffers[i].start = 0;
+        _writeBuffers[i].length = 0;
+        _writeBuffers[i].firstMs = 0;
+    }
+    memset(&_ioStats, 0, sizeof(_ioStats));
+
+    _cacheMutex = xSemaphoreCreateRecursiveMutex();
 }
 
 EARS_sdCard::~EARS_sdCard()
 {
-    SD_MMC.end();
+    closeAll();
+    if (_fs == &SD_MMC)
+        SD_MMC.end();
+    if (_cacheMutex)
+        vSemaphoreDelete(_cacheMutex);
+    heap_caps_free(_index);
+    for (uint8_t i = 0; i < SD_WRITE_BUFFERS; i++)
+        heap_caps_free(_writeBuffers[i].data);
 }
 
 bool EARS_sdCard::begin()
 {
-    Serial.println("[SD] Initializing SD card (SD_MMC mode)...");
+    return begin(SDCardConfig());
+}
+
+bool EARS_sdCard::mount(bool mode4bit, int frequencyKhz)
+{
+    Serial.printf("[SD] Trying %s mode @ %d kHz\n", mode4bit ? "4-bit" : "1-bit", frequencyKhz);
 
     // Step 1: Set pins for SD_MMC (verified from Waveshare schematic)
-    if (!SD_MMC.setPins(SDMMC_CLK, SDMMC_CMD, SDMMC_D0))
+    bool pinsOk = mode4bit ? SD_MMC.setPins(SDMMC_CLK, SDMMC_CMD, SDMMC_D0, SDMMC_D1, SDMMC_D2, SDMMC_D3)
+                           : SD_MMC.setPins(SDMMC_CLK, SDMMC_CMD, SDMMC_D0);
+    if (!pinsOk)
     {
         Serial.println("[SD] ERROR: Failed to set SD_MMC pins!");
         _state = SD_INIT_FAILED;
         return false;
     }
-    Serial.println("[SD] Pins configured (CLK=11, CMD=10, D0=9)");
 
-    // Step 2: Begin SD_MMC in 1-bit mode
-    // Parameters: mountpoint, mode1bit, format_if_mount_failed
-    if (!SD_MMC.begin("/sdcard", true, false))
+    // Step 2: Begin SD_MMC
+    // Parameters: mountpoint, mode1bit, format_if_mount_failed, frequency, max open files
+    if (!SD_MMC.begin(SDMMC_MOUNT_POINT, !mode4bit, false, frequencyKhz, SD_MAX_OPEN_FILES))
     {
         Serial.println("[SD] ERROR: SD_MMC.begin() failed!");
         _state = SD_INIT_FAILED;
         return false;
     }
-    Serial.println("[SD] SD_MMC interface initialized");
 
     // Step 3: Check card type
     _cardType = SD_MMC.cardType();
@@ -53,6 +103,77 @@ bool EARS_sdCard::begin()
         return false;
     }
 
+    _mode4bit = mode4bit;
+    _frequencyKhz = frequencyKhz;
+    return true;
+}
+
+bool EARS_sdCard::begin(const SDCardConfig &config)
+{
+    Serial.println("[SD] Initializing SD card (SD_MMC mode)...");
+
+    // Preferred setup first, then narrower bus, then slower clock
+    struct
+    {
+        bool mode4bit;
+        int frequencyKhz;
+    } attempts[] = {
+        {config.mode4bit, config.frequencyKhz},
+        {config.mode4bit, SDMMC_FREQ_DEFAULT},
+        {false, config.frequencyKhz},
+        {false, SDMMC_FREQ_DEFAULT},
+    };
+
+    bool mounted = false;
+    for (uint8_t i = 0; i < sizeof(attempts) / sizeof(attempts[0]); i++)
+    {
+        // Skip duplicates (1-bit request, or already at the default clock)
+        bool duplicate = false;
+        for (uint8_t j = 0; j < i; j++)
+        {
+            if (attempts[j].mode4bit == attempts[i].mode4bit && attempts[j].frequencyKhz == attempts[i].frequencyKhz)
+                duplicate = true;
+        }
+        if (duplicate)
+            continue;
+
+        if (!mount(attempts[i].mode4bit, attempts[i].frequencyKhz))
+        {
+            if (_state == SD_NO_CARD)
+                return false; // Bus works, there is simply no card
+            continue;
+        }
+
+        _state = SD_CARD_READY;
+        _selfTestPassed = false;
+        _writeKBps = 0;
+        _readKBps = 0;
+
+        if (!config.selfTest)
+        {
+            mounted = true;
+            break;
+        }
+
+        // A mount at high speed can still corrupt data, verify before trusting it
+        _selfTestPassed = runSelfTest(_writeKBps, _readKBps);
+        if (_selfTestPassed)
+        {
+            mounted = true;
+            break;
+        }
+
+        Serial.println("[SD] Self-test failed, stepping down bus setup");
+        closeAll();
+        SD_MMC.end();
+        _state = SD_INIT_FAILED;
+    }
+
+    if (!mounted)
+        return false;
+
+    Serial.printf("[SD] Bus: %s @ %d kHz\n", _mode4bit ? "4-bit" : "1-bit", _frequencyKhz);
+
     // Step 4: Display card info
     Serial.print("[SD] Card Type: ");
     Serial.println(getCardType());
@@ -70,9 +191,10 @@ bool EARS_sdCard::begin()
     Serial.print(freeMB);
     Serial.println(" MB");
 
-    _state = SD_CARD_READY;
     Serial.println("[SD] âœ… SD card ready!");
 
+    using_eventbus().post(EVENT_SD_MOUNTED, _frequencyKhz);
+
     return true;
 }
 
@@ -132,10 +254,12 @@ bool EARS_sdCard::createDirectory(const char *path)
     if (!isAvailable())
         return false;
 
-    if (SD_MMC.mkdir(path))
+    if (_fs->mkdir(path))
     {
-        Serial.print("[SD] Directory created: ");
-        Serial.println(path);
+        lockCache();
+        indexPut(path, 0, true);
+        unlockCache();
+        DEBUG_PRINTF("[SD] Directory created: %s\n", path);
         return true;
     }
     else
@@ -153,7 +277,18 @@ bool EARS_sdCard::fileExists(const char *path)
     if (!isAvailable())
         return false;
 
-    File file = SD_MMC.open(path);
+    lockCache();
+    bool pending = (findPending(path) != nullptr);
+    bool exists = false, isDirectory = false;
+    uint32_t size = 0;
+    bool indexed = !pending && indexLookup(path, exists, size, isDirectory);
+    unlockCache();
+    if (pending)
+        return true;
+    if (indexed)
+        return exists && !isDirectory;
+
+    File file = _fs->open(path);
     if (file)
     {
         bool isFile = !file.isDirectory();
@@ -168,7 +303,15 @@ bool EARS_sdCard::directoryExists(const char *path)
     if (!isAvailable())
         return false;
 
-    File dir = SD_MMC.open(path);
+    lockCache();
+    bool exists = false, isDirectory = false;
+    uint32_t size = 0;
+    bool indexed = indexLookup(path, exists, size, isDirectory);
+    unlockCache();
+    if (indexed)
+        return exists && isDirectory;
+
+    File dir = _fs->open(path);
     if (dir)
     {
         bool isDir = dir.isDirectory();
@@ -183,10 +326,20 @@ bool EARS_sdCard::removeFile(const char *path)
     if (!isAvailable())
         return false;
 
-    if (SD_MMC.remove(path))
+    lockCache();
+    PendingWrite *slot = findPending(path);
+    if (slot)
+        slot->path = ""; // Removal wins over a pending rewrite
+    dropWriteBuffer(path);
+    closeHandle(path);
+    bool removed = _fs->remove(path);
+    if (removed)
+        indexRemove(path);
+    unlockCache();
+
+    if (removed)
     {
-        Serial.print("[SD] File removed: ");
-        Serial.println(path);
+        DEBUG_PRINTF("[SD] File removed: %s\n", path);
         return true;
     }
     Serial.print("[SD] Failed to remove file: ");
@@ -199,10 +352,12 @@ bool EARS_sdCard::removeDirectory(const char *path)
     if (!isAvailable())
         return false;
 
-    if (SD_MMC.rmdir(path))
+    if (_fs->rmdir(path))
     {
-        Serial.print("[SD] Directory removed: ");
-        Serial.println(path);
+        lockCache();
+        indexRemove(path);
+        unlockCache();
+        DEBUG_PRINTF("[SD] Directory removed: %s\n", path);
         return true;
     }
     Serial.print("[SD] Failed to remove directory: ");
@@ -215,7 +370,7 @@ void EARS_sdCard::listDirectory(const char *path, uint8_t indent)
     if (!isAvailable())
         return;
 
-    File dir = SD_MMC.open(path);
+    File dir = _fs->open(path);
     if (!dir)
     {
         Serial.print("[SD] Failed to open directory: ");
@@ -258,12 +413,80 @@ void EARS_sdCard::listDirectory(const char *path, uint8_t indent)
     dir.close();
 }
 
+uint16_t EARS_sdCard::listEntries(const char *path, SDDirCallback callback, void *context)
+{
+    if (!isAvailable() || !callback)
+        return 0;
+
+    uint16_t count = 0;
+
+    // Managed directory with a built index: no card access at all
+    lockCache();
+    for (uint8_t d = 0; d < SD_INDEX_DIR_COUNT; d++)
+    {
+        size_t len = strlen(SD_INDEX_DIRS[d]);
+        bool match = strncmp(path, SD_INDEX_DIRS[d], len) == 0 && (path[len] == '\0' || strcmp(path + len, "/") == 0);
+        if (!match)
+            continue;
+        if (!_index || !_indexReady || (_indexIncomplete & (1 << d)))
+            break;
+
+        _indexHits++;
+        for (uint16_t i = 0; i < SD_INDEX_SLOTS; i++)
+        {
+            const IndexEntry &entry = _index[i];
+            if (!entry.used || entry.dir != d)
+                continue;
+            count++;
+            if (!callback(entry.name, entry.size, entry.isDirectory, context))
+                break;
+        }
+        unlockCache();
+        return count;
+    }
+    _indexFallbacks++;
+    unlockCache();
+
+    File dir = _fs->open(path);
+    if (!dir || !dir.isDirectory())
+        return 0;
+
+    File file = dir.openNextFile();
+    while (file)
+    {
+        bool isDirectory = file.isDirectory();
+        count++;
+        bool more = callback(file.name(), isDirectory ? 0 : (uint32_t)file.size(), isDirectory, context);
+        file.close();
+        if (!more)
+            break;
+        file = dir.openNextFile();
+    }
+    dir.close();
+    return count;
+}
+
 String EARS_sdCard::readFile(const char *path)
 {
+    EARS_PROFILE_ZONE("sd read");
+
     if (!isAvailable())
         return "";
 
-    File file = SD_MMC.open(path, FILE_READ);
+    lockCache();
+    PendingWrite *slot = findPending(path);
+    if (slot)
+    {
+        String content = slot->content;
+        unlockCache();
+        return content;
+    }
+    unlockCache();
+
+    // Make cached writes visible to the separate read handle
+    flush(path);
+
+    File file = _fs->open(path, FILE_READ);
     if (!file)
     {
         Serial.print("[SD] Failed to open file for reading: ");
@@ -271,47 +494,151 @@ String EARS_sdCard::readFile(const char *path)
         return "";
     }
 
-    String content = "";
-    while (file.available())
-        content += char(file.read());
+    // One allocation up front, then block reads (not one call per byte)
+    String content;
+    if (!content.reserve(file.size()))
+    {
+        Serial.print("[SD] Not enough memory to read: ");
+        Serial.println(path);
+        file.close();
+        return "";
+    }
+
+    uint8_t buffer[SD_READ_CHUNK_SIZE];
+    size_t got;
+    while ((got = file.read(buffer, sizeof(buffer))) > 0)
+        content.concat((const char *)buffer, got);
 
     file.close();
     return content;
 }
 
-bool EARS_sdCard::writeFile(const char *path, const String &content)
+size_t EARS_sdCard::readInto(const char *path, uint8_t *buffer, size_t length)
 {
-    if (!isAvailable())
+    EARS_PROFILE_ZONE("sd read");
+
+    if (!isAvailable() || !buffer || length == 0)
+        return 0;
+
+    lockCache();
+    PendingWrite *slot = findPending(path);
+    if (slot)
+    {
+        size_t got = slot->content.length() < length ? slot->content.length() : length;
+        memcpy(buffer, slot->content.c_str(), got);
+        unlockCache();
+        return got;
+    }
+    unlockCache();
+
+    flush(path);
+
+    File file = _fs->open(path, FILE_READ);
+    if (!file)
+    {
+        Serial.print("[SD] Failed to open file for reading: ");
+        Serial.println(path);
+        return 0;
+    }
+
+    size_t size = file.size();
+    size_t got = file.read(buffer, size < length ? size : length);
+    file.close();
+    return got;
+}
+
+bool EARS_sdCard::readChunks(const char *path, SDChunkCallback callback, void *context)
+{
+    if (!isAvailable() || !callback)
         return false;
 
-    File file = SD_MMC.open(path, FILE_WRITE);
+    commitPending(path);
+    flush(path);
+
+    File file = _fs->open(path, FILE_READ);
     if (!file)
     {
-        Serial.print("[SD] Failed to open file for writing: ");
+        Serial.print("[SD] Failed to open file for reading: ");
         Serial.println(path);
         return false;
     }
 
-    size_t written = file.print(content);
+    uint8_t buffer[SD_READ_CHUNK_SIZE];
+    bool ok = true;
+    size_t got;
+    while (ok && (got = file.read(buffer, sizeof(buffer))) > 0)
+        ok = callback(buffer, got, context);
+
     file.close();
+    return ok;
+}
 
-    if (written == content.length())
-        return true;
+/******************************************************************************
+ * EARS_sdReader
+ *****************************************************************************/
+bool EARS_sdReader::fill()
+{
+    int got = _file.read(_buffer, sizeof(_buffer));
+    _pos = 0;
+    _len = (got > 0) ? (size_t)got : 0;
+    _total += _len;
+    return _len > 0;
+}
 
-    Serial.print("[SD] Write failed: ");
-    Serial.println(path);
-    return false;
+int EARS_sdReader::read()
+{
+    if (_pos >= _len && !fill())
+        return -1;
+    return _buffer[_pos++];
 }
 
-bool EARS_sdCard::appendFile(const char *path, const String &content)
+size_t EARS_sdReader::readBytes(char *buffer, size_t length)
+{
+    size_t copied = 0;
+    while (copied < length)
+    {
+        if (_pos >= _len && !fill())
+            break;
+        size_t n = _len - _pos;
+        if (n > length - copied)
+            n = length - copied;
+        memcpy(buffer + copied, _buffer + _pos, n);
+        _pos += n;
+        copied += n;
+    }
+    return copied;
+}
+
+File EARS_sdCard::openRead(const char *path)
 {
     if (!isAvailable())
-        return false;
+        return File();
+
+    commitPending(path);
+    flush(path);
+    return _fs->open(path, FILE_READ);
+}
 
-    File file = SD_MMC.open(path, FILE_APPEND);
+bool EARS_sdCard::writeFile(const char *path, const String &content)
+{
+    EARS_PROFILE_ZONE("sd write");
+
+    if (!isAvailable())
+        return queuesOffline() && queueWrite(QUEUED_WRITE, path, 0, (const uint8_t *)content.c_str(), content.length());
+
+    // Truncating rewrite, a cached handle would keep a stale position
+    lockCache();
+    PendingWrite *slot = findPending(path);
+    if (slot)
+        slot->path = ""; // This write supersedes the pending one
+    dropWriteBuffer(path);
+    closeHandle(path);
+    unlockCache();
+
+    File file = _fs->open(path, FILE_WRITE);
     if (!file)
     {
-        Serial.print("[SD] Failed to open file for appending: ");
+        Serial.print("[SD] Failed to open file for writing: ");
         Serial.println(path);
         return false;
     }
@@ -319,95 +646,1638 @@ bool EARS_sdCard::appendFile(const char *path, const String &content)
     size_t written = file.print(content);
     file.close();
 
+    lockCache();
+    indexPut(path, written, false);
+    unlockCache();
+
     if (written == content.length())
         return true;
 
-    Serial.print("[SD] Append failed: ");
+    Serial.print("[SD] Write failed: ");
     Serial.println(path);
     return false;
 }
 
-/******************************************************************************
- * High-Level Initialization Orchestration (DEBLOAT Step 5)
- *****************************************************************************/
+bool EARS_sdCard::appendFile(const char *path, const String &content)
+{
+    return appendData(path, (const uint8_t *)content.c_str(), content.length());
+}
 
-/**
- * @brief Perform complete SD card initialization sequence
- * @return SDCardInitResult Detailed result of initialization
- *
- * @details
- * This function orchestrates the complete SD card initialization:
- * 1. Initialize SD_MMC interface via begin()
- * 2. Check initialization result (success, failed, no card)
- * 3. If successful, retrieve card information
- * 4. Create essential directories (/logs, /config, /images)
- * 5. Return detailed status for caller interpretation
- *
- * This function was extracted from main.cpp during debloat Step 5.
- * It encapsulates all SD card initialization logic in one place.
- *
- * @note The caller should interpret the result to set LED patterns
- *       and update application state accordingly.
- */
-SDCardInitResult EARS_sdCard::performFullInitialization()
+bool EARS_sdCard::appendData(const char *path, const uint8_t *data, size_t length)
 {
-    SDCardInitResult result;
+    EARS_PROFILE_ZONE("sd write");
 
-    // ========================================================================
-    // STEP 1: Initialize SD card hardware
-    // ========================================================================
-    Serial.println("[INIT] Initializing SD card...");
+    if (!data)
+        return false;
+
+    if (length == 0)
+        return true;
+
+    if (!isAvailable())
+        return queuesOffline() && queueWrite(QUEUED_APPEND, path, 0, data, length);
+
+    // The end of the file is the end of its buffer, or of its cached handle
+    lockCache();
+    WriteBuffer *buffer = findWriteBuffer(path);
+    uint32_t end = 0;
+    bool ok = false;
+    if (buffer)
+        end = buffer->start + buffer->length;
+    if (buffer || (acquireHandle(path, true) && handleSize(path, end)))
+        ok = bufferWrite(path, end, data, length);
+    unlockCache();
+
+    if (ok)
+        return true;
+
+    Serial.print("[SD] Append failed: ");
+    Serial.println(path);
+    return false;
+}
+
+uint32_t EARS_sdCard::getFileSize(const char *path)
+{
+    if (!isAvailable())
+        return 0;
 
-    if (!begin())
+    // Cached handle knows about unflushed writes, the directory entry does not
+    lockCache();
+    flushWriteBuffer(path);
+    PendingWrite *pending = findPending(path);
+    if (pending)
     {
-        // begin() failed - check why
-        result.state = getState();
+        uint32_t size = pending->content.length();
+        unlockCache();
+        return size;
+    }
+    uint32_t size = 0;
+    bool exists = false, isDirectory = false;
+    if (handleSize(path, size))
+    {
+        unlockCache();
+        return size;
+    }
+    if (indexLookup(path, exists, size, isDirectory))
+    {
+        unlockCache();
+        return (exists && !isDirectory) ? size : 0;
+    }
+    unlockCache();
 
-        if (result.state == SD_INIT_FAILED)
-        {
-            Serial.println("[ERROR] SD card initialization failed!");
-        }
-        else if (result.state == SD_NO_CARD)
-        {
-            Serial.println("[WARNING] No SD card detected");
-        }
+    File file = _fs->open(path, FILE_READ);
+    if (!file)
+        return 0;
 
-        return result;
+    size = file.isDirectory() ? 0 : file.size();
+    file.close();
+    return size;
+}
+
+bool EARS_sdCard::renameFile(const char *from, const char *to)
+{
+    if (!isAvailable())
+        return false;
+
+    lockCache();
+    flushWriteBuffer(from);
+    dropWriteBuffer(to);
+    closeHandle(from);
+    closeHandle(to);
+    bool renamed = _fs->rename(from, to);
+    if (renamed)
+    {
+        indexRemove(from);
+        refreshIndex(to);
     }
+    unlockCache();
 
-    // ========================================================================
-    // STEP 2: Card successfully initialized - gather information
-    // ========================================================================
-    result.state = SD_CARD_READY;
-    result.cardType = getCardType();
-    result.cardSizeMB = getCardSizeMB();
-    result.freeMB = getFreeSpaceMB();
-    result.usedMB = getUsedSpaceMB();
+    if (renamed)
+        return true;
 
-    Serial.println("[OK] SD card initialized successfully");
-    Serial.printf("[INFO] Card type: %s\n", result.cardType.c_str());
-    Serial.printf("[INFO] Card size: %llu MB\n", result.cardSizeMB);
-    Serial.printf("[INFO] Free space: %llu MB\n", result.freeMB);
+    Serial.print("[SD] Failed to rename file: ");
+    Serial.println(from);
+    return false;
+}
 
-    // ========================================================================
-    // STEP 3: Create essential directories
-    // ========================================================================
-    Serial.println("[INFO] Creating essential directories...");
+bool EARS_sdCard::writeDataAt(const char *path, uint32_t offset, const uint8_t *data, size_t length)
+{
+    EARS_PROFILE_ZONE("sd write");
 
-    bool logsOk = createDirectory("/logs");
-    bool configOk = createDirectory("/config");
-    bool imagesOk = createDirectory("/images");
+    if (!data)
+        return false;
 
-    result.directoriesCreated = (logsOk && configOk && imagesOk);
+    if (length == 0)
+        return true;
 
-    if (result.directoriesCreated)
+    if (!isAvailable())
+        return queuesOffline() && queueWrite(QUEUED_WRITE_AT, path, offset, data, length);
+
+    // The file must exist (a buffered one does, or is about to)
+    lockCache();
+    bool ok = false;
+    if (findWriteBuffer(path) || acquireHandle(path, false))
+        ok = bufferWrite(path, offset, data, length);
+    unlockCache();
+
+    if (ok)
+        return true;
+
+    Serial.print("[SD] Write at offset failed: ");
+    Serial.println(path);
+    return false;
+}
+
+size_t EARS_sdCard::readDataAt(const char *path, uint32_t offset, uint8_t *buffer, size_t length)
+{
+    EARS_PROFILE_ZONE("sd read");
+
+    if (!isAvailable() || !buffer || length == 0)
+        return 0;
+
+    lockCache();
+    flushWriteBuffer(path);
+    HandleSlot *slot = acquireHandle(path, false);
+    size_t got = 0;
+    if (slot && slot->file.seek(offset))
+        got = slot->file.read(buffer, length);
+    unlockCache();
+    return got;
+}
+
+bool EARS_sdCard::extendFile(const char *path, uint32_t newSize)
+{
+    if (!isAvailable())
+        return false;
+
+    lockCache();
+    flushWriteBuffer(path);
+    HandleSlot *slot = acquireHandle(path, true);
+    if (!slot || !slot->file.seek(0, SeekEnd))
     {
-        Serial.println("[OK] Essential directories ready");
+        unlockCache();
+        Serial.print("[SD] Failed to open file for extending: ");
+        Serial.println(path);
+        return false;
     }
-    else
+
+    static const uint8_t zeros[512] = {0};
+    uint32_t size = slot->file.position();
+    while (size < newSize)
     {
-        Serial.println("[WARNING] Some directories could not be created");
+        size_t chunk = (newSize - size) < sizeof(zeros) ? (newSize - size) : sizeof(zeros);
+        size_t written = slot->file.write(zeros, chunk);
+        size += written;
+        slot->dirty = true;
+        if (written != chunk)
+            break;
     }
+    indexPut(path, size, false);
+    unlockCache();
+
+    if (size >= newSize)
+        return true;
+
+    Serial.print("[SD] Extend failed (card full?): ");
+    Serial.println(path);
+    return false;
+}
+
+bool EARS_sdCard::truncateFile(const char *path, uint32_t newSize)
+{
+    if (!isAvailable())
+        return false;
+
+    // FS::File has no truncate, go through the VFS path (file must be closed)
+    lockCache();
+    flushWriteBuffer(path);
+    closeHandle(path);
+    String fullPath = String(_mountPoint) + path;
+    bool truncated = (truncate(fullPath.c_str(), newSize) == 0);
+    if (truncated)
+        indexPut(path, newSize, false);
+    unlockCache();
+
+    if (truncated)
+        return true;
+
+    Serial.print("[SD] Failed to truncate file: ");
+    Serial.println(path);
+    return false;
+}
+
+bool EARS_sdCard::runSelfTest(uint32_t &writeKBps, uint32_t &readKBps)
+{
+    writeKBps = 0;
+    readKBps = 0;
+
+    if (!isAvailable())
+        return false;
+
+    // Internal RAM so the SDMMC driver does not have to bounce the data
+    uint8_t *buffer = (uint8_t *)heap_caps_malloc(SD_SELFTEST_CHUNK, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    if (!buffer)
+        return false;
+
+    bool ok = true;
+
+    File file = _fs->open(SD_SELFTEST_PATH, FILE_WRITE);
+    if (!file)
+    {
+        heap_caps_free(buffer);
+        return false;
+    }
+
+    int64_t start = esp_timer_get_time();
+    for (uint32_t offset = 0; offset < SD_SELFTEST_BYTES && ok; offset += SD_SELFTEST_CHUNK)
+    {
+        for (uint32_t i = 0; i < SD_SELFTEST_CHUNK; i++)
+            buffer[i] = (uint8_t)((offset + i) * 31u + 7u);
+        ok = (file.write(buffer, SD_SELFTEST_CHUNK) == SD_SELFTEST_CHUNK);
+    }
+    file.flush();
+    file.close();
+    int64_t writeUs = esp_timer_get_time() - start;
+
+    if (ok)
+    {
+        file = _fs->open(SD_SELFTEST_PATH, FILE_READ);
+        ok = (bool)file;
+    }
+
+    int64_t readUs = 0;
+    if (ok)
+    {
+        start = esp_timer_get_time();
+        for (uint32_t offset = 0; offset < SD_SELFTEST_BYTES && ok; offset += SD_SELFTEST_CHUNK)
+        {
+            ok = (file.read(buffer, SD_SELFTEST_CHUNK) == SD_SELFTEST_CHUNK);
+            for (uint32_t i = 0; i < SD_SELFTEST_CHUNK && ok; i++)
+                ok = (buffer[i] == (uint8_t)((offset + i) * 31u + 7u));
+        }
+        readUs = esp_timer_get_time() - start;
+        file.close();
+    }
+
+    _fs->remove(SD_SELFTEST_PATH);
+    heap_caps_free(buffer);
+
+    if (ok)
+    {
+        // bytes/us * 1e6 / 1024 = KB/s (read time includes the verify loop)
+        writeKBps = writeUs > 0 ? (uint32_t)((uint64_t)SD_SELFTEST_BYTES * 1000000ULL / 1024ULL / writeUs) : 0;
+        readKBps = readUs > 0 ? (uint32_t)((uint64_t)SD_SELFTEST_BYTES * 1000000ULL / 1024ULL / readUs) : 0;
+        Serial.printf("[SD] Self-test: write %lu KB/s, read %lu KB/s\n",
+                      (unsigned long)writeKBps, (unsigned long)readKBps);
+    }
+
+    return ok;
+}
+
+/******************************************************************************
+ * Atomic and Coalesced Writes
+ *****************************************************************************/
+
+bool EARS_sdCard::writeFileAtomic(const char *path, const String &content)
+{
+    return writeFileAtomic(path, (const uint8_t *)content.c_str(), content.length());
+}
+
+bool EARS_sdCard::writeFileAtomic(const char *path, const uint8_t *data, size_t length)
+{
+    EARS_PROFILE_ZONE("sd write");
+
+    if (!data && length > 0)
+        return false;
+
+    if (!isAvailable())
+        return queuesOffline() && queueWrite(QUEUED_WRITE_ATOMIC, path, 0, data, length);
+
+    String tmpPath = String(path) + ".tmp";
+    String bakPath = String(path) + ".bak";
+
+    lockCache();
+    recoverAtomicWrite(path);
+    dropWriteBuffer(path);
+    closeHandle(path);
+
+    // Step 1: complete, synced copy of the new contents
+    File file = _fs->open(tmpPath.c_str(), FILE_WRITE);
+    if (!file)
+    {
+        unlockCache();
+        Serial.print("[SD] Failed to open temp file: ");
+        Serial.println(tmpPath);
+        return false;
+    }
+    size_t written = (length > 0) ? file.write(data, length) : 0;
+    file.flush();
+    file.close();
+
+    if (written != length)
+    {
+        _fs->remove(tmpPath.c_str());
+        unlockCache();
+        Serial.print("[SD] Atomic write failed: ");
+        Serial.println(path);
+        return false;
+    }
+
+    // Step 2: FAT rename will not replace a file, so move the old one aside
+    bool hadOld = _fs->exists(path);
+    if (hadOld && !_fs->rename(path, bakPath.c_str()))
+    {
+        _fs->remove(tmpPath.c_str());
+        unlockCache();
+        Serial.print("[SD] Atomic write could not move old file: ");
+        Serial.println(path);
+        return false;
+    }
+
+    // Step 3: new contents take the real name, old copy goes
+    bool ok = _fs->rename(tmpPath.c_str(), path);
+    if (!ok && hadOld)
+        _fs->rename(bakPath.c_str(), path);
+    if (ok && hadOld)
+        _fs->remove(bakPath.c_str());
+    if (ok)
+        indexPut(path, length, false);
+    unlockCache();
+
+    if (ok)
+        return true;
+
+    Serial.print("[SD] Atomic rename failed: ");
+    Serial.println(path);
+    return false;
+}
+
+bool EARS_sdCard::recoverAtomicWrite(const char *path)
+{
+    if (!isAvailable())
+        return false;
+
+    String tmpPath = String(path) + ".tmp";
+    String bakPath = String(path) + ".bak";
+
+    lockCache();
+    bool ok = true;
+    if (_fs->exists(path))
+    {
+        // Interrupted before step 2 (partial temp) or after step 3 (stale backup)
+        if (_fs->exists(tmpPath.c_str()))
+            _fs->remove(tmpPath.c_str());
+        if (_fs->exists(bakPath.c_str()))
+            _fs->remove(bakPath.c_str());
+    }
+    else if (_fs->exists(tmpPath.c_str()))
+    {
+        // Interrupted between the renames: the temp file was already synced
+        ok = _fs->rename(tmpPath.c_str(), path);
+        if (ok && _fs->exists(bakPath.c_str()))
+            _fs->remove(bakPath.c_str());
+    }
+    else if (_fs->exists(bakPath.c_str()))
+    {
+        ok = _fs->rename(bakPath.c_str(), path);
+    }
+    else
+    {
+        ok = false; // Nothing to recover
+    }
+
+    // Leftovers are gone either way; a renamed file is re-read
+    indexRemove(tmpPath.c_str());
+    indexRemove(bakPath.c_str());
+    if (ok)
+        refreshIndex(path);
+    unlockCache();
+    return ok;
+}
+
+EARS_sdCard::PendingWrite *EARS_sdCard::findPending(const char *path)
+{
+    for (uint8_t i = 0; i < SD_COALESCE_SLOTS; i++)
+    {
+        if (_pending[i].path.length() > 0 && _pending[i].path == path)
+            return &_pending[i];
+    }
+    return nullptr;
+}
+
+/******************************************************************************
+ * Snapshot Cache
+ *****************************************************************************/
+
+// On-disk header in front of the image
+struct SDSnapshotHeader
+{
+    uint32_t magic;
+    uint32_t layout;
+    SDSnapshotKey key;
+    uint32_t length;
+    uint32_t dataCrc;
+};
+
+static bool snapshotCrcChunk(const uint8_t *data, size_t length, void *context)
+{
+    uint32_t *crc = (uint32_t *)context;
+    *crc = esp_rom_crc32_le(*crc, data, length);
+    return true;
+}
+
+bool EARS_sdCard::getSnapshotKey(const char *path, SDSnapshotKey &key)
+{
+    memset(&key, 0, sizeof(key));
+
+    File file = openRead(path);
+    if (!file)
+        return false;
+    key.size = file.size();
+    key.mtime = (uint32_t)file.getLastWrite();
+    file.close();
+
+    return readChunks(path, snapshotCrcChunk, &key.crc);
+}
+
+bool EARS_sdCard::writeSnapshot(const char *path, const SDSnapshotKey &key, uint32_t layout,
+                                const void *data, size_t length)
+{
+    if (!isAvailable() || !data)
+        return false;
+
+    size_t total = sizeof(SDSnapshotHeader) + length;
+    uint8_t *image = (uint8_t *)malloc(total);
+    if (!image)
+        return false;
+
+    SDSnapshotHeader *header = (SDSnapshotHeader *)image;
+    header->magic = SD_SNAPSHOT_MAGIC;
+    header->layout = layout;
+    header->key = key;
+    header->length = length;
+    header->dataCrc = esp_rom_crc32_le(0, (const uint8_t *)data, length);
+    memcpy(image + sizeof(SDSnapshotHeader), data, length);
+
+    bool ok = writeFileAtomic(path, image, total);
+    free(image);
+    return ok;
+}
+
+size_t EARS_sdCard::readSnapshot(const char *path, const SDSnapshotKey &key, uint32_t layout,
+                                 void *data, size_t capacity)
+{
+    File file = openRead(path);
+    if (!file)
+        return 0;
+
+    SDSnapshotHeader header;
+    bool valid = file.read((uint8_t *)&header, sizeof(header)) == sizeof(header) &&
+                 header.magic == SD_SNAPSHOT_MAGIC &&
+                 header.layout == layout &&
+                 memcmp(&header.key, &key, sizeof(key)) == 0 &&
+                 file.size() == sizeof(header) + header.length;
+
+    if (valid && data)
+    {
+        // Read straight into the caller's structure, then check it
+        valid = header.length <= capacity &&
+                file.read((uint8_t *)data, header.length) == header.length &&
+                esp_rom_crc32_le(0, (const uint8_t *)data, header.length) == header.dataCrc;
+    }
+
+    file.close();
+    return valid ? header.length : 0;
+}
+
+bool EARS_sdCard::writeFileCoalesced(const char *path, const String &content)
+{
+    // Without a card the contents simply stay pending until the remount
+    if (!isAvailable() && !queuesOffline())
+        return false;
+
+    lockCache();
+    uint32_t now = millis();
+    PendingWrite *slot = findPending(path);
+    if (!slot)
+    {
+        for (uint8_t i = 0; i < SD_COALESCE_SLOTS && !slot; i++)
+        {
+            if (_pending[i].path.length() == 0)
+            {
+                slot = &_pending[i];
+                slot->path = path;
+                slot->firstMs = now;
+            }
+        }
+    }
+
+    if (!slot)
+    {
+        // All slots busy: fall back to an immediate atomic write
+        unlockCache();
+        return writeFileAtomic(path, content);
+    }
+
+    slot->content = content;
+    slot->lastMs = now;
+    unlockCache();
+    return true;
+}
+
+bool EARS_sdCard::commitPending(const char *path)
+{
+    // Keep the slots until there is a card to commit them to
+    if (!isAvailable())
+        return false;
+
+    bool ok = true;
+
+    lockCache();
+    for (uint8_t i = 0; i < SD_COALESCE_SLOTS; i++)
+    {
+        PendingWrite &slot = _pending[i];
+        if (slot.path.length() == 0 || (path && slot.path != path))
+            continue;
+
+        // Release the slot before writing so readers fall through to the card
+        String target = slot.path;
+        String content = slot.content;
+        slot.path = "";
+        slot.content = "";
+        bool written = writeFileAtomic(target.c_str(), content);
+        using_eventbus().post(EVENT_SD_COMMIT, written ? 1 : 0);
+        ok = written && ok;
+    }
+    unlockCache();
+    return ok;
+}
+
+void EARS_sdCard::service()
+{
+    checkPresence();
+    if (!isAvailable())
+        return;
+
+    if (_queueCount > 0)
+        drainQueue();
+
+    serviceWrites();
+
+    uint32_t now = millis();
+    for (uint8_t i = 0; i < SD_COALESCE_SLOTS; i++)
+    {
+        lockCache();
+        PendingWrite &slot = _pending[i];
+        bool due = slot.path.length() > 0 &&
+                   (now - slot.lastMs >= SD_COALESCE_WINDOW_MS || now - slot.firstMs >= SD_COALESCE_MAX_DELAY_MS);
+        String target = due ? slot.path : String();
+        unlockCache();
+
+        if (due)
+            commitPending(target.c_str());
+    }
+}
+
+/******************************************************************************
+ * File Handle Cache
+ *****************************************************************************/
+
+uint8_t EARS_sdCard::getPendingWrites() const
+{
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < SD_COALESCE_SLOTS; i++)
+    {
+        if (_pending[i].path.length() > 0)
+            count++;
+    }
+    return count;
+}
+
+void EARS_sdCard::lockCache()
+{
+    if (_cacheMutex)
+        xSemaphoreTakeRecursive(_cacheMutex, portMAX_DELAY);
+}
+
+void EARS_sdCard::unlockCache()
+{
+    if (_cacheMutex)
+        xSemaphoreGiveRecursive(_cacheMutex);
+}
+
+EARS_sdCard::HandleSlot *EARS_sdCard::acquireHandle(const char *path, bool create)
+{
+    HandleSlot *victim = nullptr;
+
+    for (uint8_t i = 0; i < SD_HANDLE_CACHE_SIZE; i++)
+    {
+        HandleSlot &slot = _handles[i];
+        if (slot.file && slot.path == path)
+        {
+            slot.lastUse = ++_useCounter;
+            return &slot;
+        }
+
+        // Prefer a free slot, otherwise the least recently used one
+        if (!slot.file)
+        {
+            if (!victim || victim->file)
+                victim = &slot;
+        }
+        else if (!victim || (victim->file && slot.lastUse < victim->lastUse))
+        {
+            victim = &slot;
+        }
+    }
+
+    if (victim->file)
+        victim->file.close(); // Flushes the evicted file
+
+    // "r+" allows both in-place and end-of-file writes but needs the file
+    if (!_fs->exists(path))
+    {
+        if (!create)
+            return nullptr;
+        File created = _fs->open(path, FILE_WRITE);
+        if (!created)
+        {
+            Serial.print("[SD] Failed to create file: ");
+            Serial.println(path);
+            return nullptr;
+        }
+        created.close();
+    }
+
+    victim->file = _fs->open(path, "r+");
+    if (!victim->file)
+    {
+        Serial.print("[SD] Failed to open file for update: ");
+        Serial.println(path);
+        return nullptr;
+    }
+
+    victim->path = path;
+    victim->lastUse = ++_useCounter;
+    victim->dirty = false;
+    return victim;
+}
+
+void EARS_sdCard::closeHandle(const char *path)
+{
+    for (uint8_t i = 0; i < SD_HANDLE_CACHE_SIZE; i++)
+    {
+        if (_handles[i].file && _handles[i].path == path)
+        {
+            _handles[i].file.close();
+            _handles[i].path = "";
+            _handles[i].dirty = false;
+        }
+    }
+}
+
+void EARS_sdCard::flush(const char *path)
+{
+    EARS_PROFILE_ZONE("sd flush");
+
+    lockCache();
+    flushWriteBuffer(path);
+    for (uint8_t i = 0; i < SD_HANDLE_CACHE_SIZE; i++)
+    {
+        HandleSlot &slot = _handles[i];
+        if (slot.file && slot.dirty && (!path || slot.path == path))
+        {
+            slot.file.flush();
+            slot.dirty = false;
+        }
+    }
+    unlockCache();
+}
+
+void EARS_sdCard::closeAll()
+{
+    commitPending();
+
+    lockCache();
+    flushWriteBuffer(nullptr);
+    for (uint8_t i = 0; i < SD_HANDLE_CACHE_SIZE; i++)
+    {
+        if (_handles[i].file)
+            _handles[i].file.close();
+        _handles[i].path = "";
+        _handles[i].dirty = false;
+    }
+    unlockCache();
+}
+
+void EARS_sdCard::notifyCardRemoved()
+{
+    lockCache();
+    for (uint8_t i = 0; i < SD_HANDLE_CACHE_SIZE; i++)
+    {
+        // Nothing can reach the card any more, just release the FILE objects
+        _handles[i].file = File();
+        _handles[i].path = "";
+        _handles[i].dirty = false;
+    }
+
+    // Buffered writes were never on the card: replay them after the remount
+    for (uint8_t i = 0; i < SD_WRITE_BUFFERS; i++)
+    {
+        WriteBuffer &buffer = _writeBuffers[i];
+        if (buffer.path.length() > 0 && buffer.length > 0)
+            queueWrite(QUEUED_WRITE_AT, buffer.path.c_str(), buffer.start, buffer.data, buffer.length);
+        buffer.path = "";
+        buffer.length = 0;
+    }
+
+    // Another card may go in: rebuilt by the next performFullInitialization()
+    _indexReady = false;
+    if (_index)
+        memset(_index, 0, SD_INDEX_SLOTS * sizeof(IndexEntry));
+    _indexCount = 0;
+    _indexIncomplete = 0;
+    unlockCache();
+
+    SD_MMC.end();
+    _state = SD_NO_CARD;
+    _nextRemountMs = millis() + SD_REMOUNT_RETRY_MS;
+    _remountDelayMs = SD_REMOUNT_RETRY_MS;
+    Serial.println("[SD] Card removed, handle cache dropped, writes queued");
+
+    using_eventbus().post(EVENT_SD_REMOVED);
+}
+
+bool EARS_sdCard::suspend()
+{
+    if (!isAvailable() || !queuesOffline() || _indexTask)
+        return false;
+
+    // Everything held in RAM goes to the card while it is still ours
+    closeAll();
+
+    lockCache();
+    _indexReady = false;
+    if (_index)
+        memset(_index, 0, SD_INDEX_SLOTS * sizeof(IndexEntry));
+    _indexCount = 0;
+    _indexIncomplete = 0;
+    unlockCache();
+
+    SD_MMC.end();
+    _state = SD_NO_CARD;
+    _suspended = true;
+    Serial.println("[SD] Card handed over, writes queued");
+
+    using_eventbus().post(EVENT_SD_REMOVED);
+    return true;
+}
+
+bool EARS_sdCard::resume()
+{
+    if (!_suspended)
+        return isAvailable();
+
+    _suspended = false;
+    if (performFullInitialization(_config).state == SD_CARD_READY)
+    {
+        Serial.printf("[SD] Card taken back, %u queued writes to replay\n", _queueCount);
+        return true;
+    }
+
+    // Not back yet: the hot-plug remount takes over
+    _nextRemountMs = millis() + SD_REMOUNT_RETRY_MS;
+    _remountDelayMs = SD_REMOUNT_RETRY_MS;
+    return false;
+}
+
+bool EARS_sdCard::handleSize(const char *path, uint32_t &size)
+{
+    for (uint8_t i = 0; i < SD_HANDLE_CACHE_SIZE; i++)
+    {
+        if (_handles[i].file && _handles[i].path == path)
+        {
+            size = _handles[i].file.seek(0, SeekEnd) ? _handles[i].file.position() : 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+/******************************************************************************
+ * Write Scheduler
+ *****************************************************************************/
+
+uint32_t EARS_sdCard::beginInteractiveRead()
+{
+    _interactiveReads++;
+    _lastInteractiveMs = millis();
+    return (uint32_t)esp_timer_get_time();
+}
+
+void EARS_sdCard::endInteractiveRead(uint32_t startUs)
+{
+    uint32_t us = (uint32_t)esp_timer_get_time() - startUs;
+    _ioStats.reads++;
+    _readTotalUs += us;
+    if (us > _ioStats.readMaxUs)
+        _ioStats.readMaxUs = us;
+    _lastInteractiveMs = millis();
+    _interactiveReads--;
+}
+
+void EARS_sdCard::getIoStats(SDIoStats &stats)
+{
+    lockCache();
+    stats = _ioStats;
+    stats.bufferedFiles = 0;
+    stats.bufferedBytes = 0;
+    for (uint8_t i = 0; i < SD_WRITE_BUFFERS; i++)
+    {
+        if (_writeBuffers[i].path.length() > 0)
+        {
+            stats.bufferedFiles++;
+            stats.bufferedBytes += _writeBuffers[i].length;
+        }
+    }
+    stats.queuedWrites = getQueuedWrites();
+    stats.pendingWrites = getPendingWrites();
+    stats.writeAvgUs = _ioStats.cardWrites ? (uint32_t)(_writeTotalUs / _ioStats.cardWrites) : 0;
+    stats.readAvgUs = _ioStats.reads ? (uint32_t)(_readTotalUs / _ioStats.reads) : 0;
+    unlockCache();
+}
+
+EARS_sdCard::WriteBuffer *EARS_sdCard::findWriteBuffer(const char *path)
+{
+    for (uint8_t i = 0; i < SD_WRITE_BUFFERS; i++)
+    {
+        if (_writeBuffers[i].path.length() > 0 && _writeBuffers[i].path == path)
+            return &_writeBuffers[i];
+    }
+    return nullptr;
+}
+
+bool EARS_sdCard::writeAt(const char *path, uint32_t offset, const uint8_t *data, size_t length)
+{
+    HandleSlot *slot = acquireHandle(path, true);
+    size_t written = 0;
+    if (slot && slot->file.seek(offset))
+    {
+        written = slot->file.write(data, length);
+        slot->dirty = true;
+        indexGrow(path, offset + written);
+    }
+    if (slot && written != length)
+        closeHandle(path);
+
+    if (written == length)
+        return true;
+
+    Serial.printf("[SD] ERROR: Write of %u bytes at %lu failed: %s\n",
+                  (unsigned)length, (unsigned long)offset, path);
+    return false;
+}
+
+bool EARS_sdCard::bufferWrite(const char *path, uint32_t offset, const uint8_t *data, size_t length)
+{
+    // LittleFS has no erase blocks to align to and nothing calls its service()
+    if (!queuesOffline())
+        return writeAt(path, offset, data, length);
+
+    // Only a contiguous run is buffered: anything else writes the run out first
+    WriteBuffer *buffer = findWriteBuffer(path);
+    if (buffer && offset != buffer->start + buffer->length)
+    {
+        if (!writeBuffered(*buffer, false))
+            return false;
+        buffer->start = offset;
+        buffer->firstMs = millis();
+    }
+
+    if (!buffer)
+    {
+        WriteBuffer *oldest = nullptr;
+        for (uint8_t i = 0; i < SD_WRITE_BUFFERS && !buffer; i++)
+        {
+            if (_writeBuffers[i].path.length() == 0)
+                buffer = &_writeBuffers[i];
+            else if (!oldest || (int32_t)(_writeBuffers[i].firstMs - oldest->firstMs) < 0)
+                oldest = &_writeBuffers[i];
+        }
+        if (!buffer)
+        {
+            if (!writeBuffered(*oldest, false))
+                return false;
+            buffer = oldest;
+        }
+
+        if (!buffer->data)
+        {
+            buffer->data = (uint8_t *)heap_caps_malloc(SD_WRITE_BUFFER_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            if (!buffer->data)
+                buffer->data = (uint8_t *)heap_caps_malloc(SD_WRITE_BUFFER_SIZE, MALLOC_CAP_8BIT);
+        }
+        buffer->path = "";
+        if (!buffer->data)
+            return writeAt(path, offset, data, length);
+
+        buffer->path = path;
+        buffer->start = offset;
+        buffer->length = 0;
+        buffer->firstMs = millis();
+    }
+
+    // Make room: the aligned head first, all of it if that is not enough
+    if (buffer->length + length > SD_WRITE_BUFFER_SIZE)
+    {
+        if (!writeBuffered(*buffer, true))
+            return false;
+        if (buffer->length + length > SD_WRITE_BUFFER_SIZE && !writeBuffered(*buffer, false))
+            return false;
+    }
+    if (length > SD_WRITE_BUFFER_SIZE)
+    {
+        buffer->start = offset + length;
+        return writeAt(path, offset, data, length);
+    }
+
+    if (buffer->length == 0)
+    {
+        buffer->start = offset;
+        buffer->firstMs = millis();
+    }
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+    _ioStats.mergedWrites++;
+    indexGrow(path, buffer->start + buffer->length);
+    return true;
+}
+
+bool EARS_sdCard::writeBuffered(WriteBuffer &buffer, bool alignedOnly)
+{
+    // Cut at the last SD_WRITE_ALIGN boundary of the file, not of the buffer
+    uint32_t end = buffer.start + buffer.length;
+    uint32_t count = buffer.length;
+    if (alignedOnly)
+    {
+        uint32_t boundary = end - (end % SD_WRITE_ALIGN);
+        count = boundary > buffer.start ? boundary - buffer.start : 0;
+    }
+    if (count == 0)
+        return true;
+
+    int64_t start = esp_timer_get_time();
+    bool ok = writeAt(buffer.path.c_str(), buffer.start, buffer.data, count);
+    uint32_t us = (uint32_t)(esp_timer_get_time() - start);
+
+    if (!ok)
+        return false; // Kept: notifyCardRemoved() queues it if the card went
+
+    _ioStats.cardWrites++;
+    if ((buffer.start + count) % SD_WRITE_ALIGN == 0)
+        _ioStats.alignedWrites++;
+    _writeTotalUs += us;
+    if (us > _ioStats.writeMaxUs)
+        _ioStats.writeMaxUs = us;
+
+    buffer.length -= count;
+    buffer.start += count;
+    if (buffer.length > 0)
+        memmove(buffer.data, buffer.data + count, buffer.length);
+    return true;
+}
+
+void EARS_sdCard::flushWriteBuffer(const char *path)
+{
+    for (uint8_t i = 0; i < SD_WRITE_BUFFERS; i++)
+    {
+        WriteBuffer &buffer = _writeBuffers[i];
+        if (buffer.path.length() == 0 || (path && buffer.path != path))
+            continue;
+        if (writeBuffered(buffer, false))
+            buffer.path = "";
+    }
+}
+
+void EARS_sdCard::dropWriteBuffer(const char *path)
+{
+    WriteBuffer *buffer = findWriteBuffer(path);
+    if (buffer)
+    {
+        buffer->path = "";
+        buffer->length = 0;
+    }
+}
+
+void EARS_sdCard::serviceWrites()
+{
+    uint32_t now = millis();
+    bool holdoff = _interactiveReads > 0 || now - _lastInteractiveMs < SD_INTERACTIVE_HOLDOFF_MS;
+
+    lockCache();
+    for (uint8_t i = 0; i < SD_WRITE_BUFFERS && isAvailable(); i++)
+    {
+        WriteBuffer &buffer = _writeBuffers[i];
+        if (buffer.path.length() == 0)
+            continue;
+
+        uint32_t age = now - buffer.firstMs;
+        bool urgent = buffer.length >= SD_WRITE_BUFFER_SIZE * 3 / 4 || age >= 2 * SD_WRITE_MAX_DELAY_MS;
+        if (holdoff && !urgent)
+        {
+            _ioStats.deferrals++;
+            continue;
+        }
+
+        // Whole erase blocks go as they fill, the tail once it is old enough
+        writeBuffered(buffer, age < SD_WRITE_MAX_DELAY_MS);
+        if (buffer.length == 0)
+            buffer.path = "";
+    }
+    unlockCache();
+}
+
+/******************************************************************************
+ * Directory Index
+ *****************************************************************************/
+
+// FNV-1a of the name folded to lower case (FAT names ignore case)
+static uint32_t indexHash(uint8_t dir, const char *name)
+{
+    uint32_t hash = 2166136261u ^ dir;
+    while (*name)
+    {
+        hash ^= (uint8_t)tolower((uint8_t)*name++);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool EARS_sdCard::indexSplit(const char *path, uint8_t &dir, const char *&name) const
+{
+    for (uint8_t d = 0; d < SD_INDEX_DIR_COUNT; d++)
+    {
+        size_t len = strlen(SD_INDEX_DIRS[d]);
+        if (strncmp(path, SD_INDEX_DIRS[d], len) != 0 || path[len] != '/' || path[len + 1] == '\0')
+            continue;
+
+        // Direct children only; deeper paths go to the card
+        if (strchr(path + len + 1, '/') != nullptr)
+            return false;
+        dir = d;
+        name = path + len + 1;
+        return true;
+    }
+    return false;
+}
+
+int EARS_sdCard::indexFind(uint8_t dir, const char *name, uint32_t hash) const
+{
+    for (uint16_t probe = 0, i = hash & (SD_INDEX_SLOTS - 1); probe < SD_INDEX_SLOTS;
+         probe++, i = (i + 1) & (SD_INDEX_SLOTS - 1))
+    {
+        const IndexEntry &entry = _index[i];
+        if (!entry.used)
+            return -1;
+        if (entry.hash == hash && entry.dir == dir && strcasecmp(entry.name, name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+bool EARS_sdCard::indexLookup(const char *path, bool &exists, uint32_t &size, bool &isDirectory)
+{
+    uint8_t dir;
+    const char *name;
+    if (!_index || !_indexReady || !indexSplit(path, dir, name) || (_indexIncomplete & (1 << dir)))
+    {
+        _indexFallbacks++;
+        return false;
+    }
+
+    // A name too long to index would have marked its directory incomplete
+    _indexHits++;
+    int i = indexFind(dir, name, indexHash(dir, name));
+    exists = (i >= 0);
+    size = exists ? _index[i].size : 0;
+    isDirectory = exists && _index[i].isDirectory;
+    return true;
+}
+
+void EARS_sdCard::indexPutEntry(uint8_t dir, const char *name, uint32_t size, bool isDirectory)
+{
+    uint32_t hash = indexHash(dir, name);
+    int i = indexFind(dir, name, hash);
+    if (i < 0)
+    {
+        if (strlen(name) >= SD_INDEX_NAME_LEN || _indexCount >= SD_INDEX_SLOTS * 3 / 4)
+        {
+            if (!(_indexIncomplete & (1 << dir)))
+                Serial.printf("[SD] Index full or name too long, %s left to the card\n", SD_INDEX_DIRS[dir]);
+            _indexIncomplete |= (1 << dir);
+            return;
+        }
+
+        i = hash & (SD_INDEX_SLOTS - 1);
+        while (_index[i].used)
+            i = (i + 1) & (SD_INDEX_SLOTS - 1);
+
+        IndexEntry &entry = _index[i];
+        entry.used = true;
+        entry.hash = hash;
+        entry.dir = dir;
+        strlcpy(entry.name, name, sizeof(entry.name));
+        _indexCount++;
+    }
+
+    _index[i].size = isDirectory ? 0 : size;
+    _index[i].isDirectory = isDirectory;
+}
+
+void EARS_sdCard::indexPut(const char *path, uint32_t size, bool isDirectory)
+{
+    uint8_t dir;
+    const char *name;
+    if (_index && indexSplit(path, dir, name))
+        indexPutEntry(dir, name, size, isDirectory);
+}
+
+void EARS_sdCard::indexGrow(const char *path, uint32_t size)
+{
+    uint8_t dir;
+    const char *name;
+    if (!_index || !indexSplit(path, dir, name))
+        return;
+
+    int i = indexFind(dir, name, indexHash(dir, name));
+    if (i < 0 || _index[i].size < size)
+        indexPutEntry(dir, name, size, false);
+}
+
+void EARS_sdCard::indexRemove(const char *path)
+{
+    uint8_t dir;
+    const char *name;
+    if (!_index || !indexSplit(path, dir, name))
+        return;
+
+    int i = indexFind(dir, name, indexHash(dir, name));
+    if (i < 0)
+        return;
+
+    // Backward-shift delete keeps every probe chain unbroken (no tombstones)
+    _index[i].used = false;
+    _indexCount--;
+    uint16_t hole = i;
+    uint16_t j = i;
+    while (true)
+    {
+        j = (j + 1) & (SD_INDEX_SLOTS - 1);
+        if (!_index[j].used)
+            break;
+
+        uint16_t home = _index[j].hash & (SD_INDEX_SLOTS - 1);
+        bool movable = (hole <= j) ? (home <= hole || home > j) : (home <= hole && home > j);
+        if (movable)
+        {
+            _index[hole] = _index[j];
+            _index[j].used = false;
+            hole = j;
+        }
+    }
+}
+
+void EARS_sdCard::refreshIndex(const char *path)
+{
+    uint8_t dir;
+    const char *name;
+    if (!_index || !isAvailable() || !indexSplit(path, dir, name))
+        return;
+
+    lockCache();
+    uint32_t size = 0;
+    File file = _fs->open(path);
+    if (!file)
+    {
+        indexRemove(path);
+    }
+    else
+    {
+        bool isDirectory = file.isDirectory();
+        if (!isDirectory && !handleSize(path, size))
+            size = file.size();
+        file.close();
+        indexPutEntry(dir, name, size, isDirectory);
+    }
+    unlockCache();
+}
+
+void EARS_sdCard::indexScanDir(uint8_t dir)
+{
+    // Held for the whole directory so no write lands between read and insert
+    lockCache();
+    File root = _fs->open(SD_INDEX_DIRS[dir]);
+    if (root && root.isDirectory())
+    {
+        File file = root.openNextFile();
+        while (file)
+        {
+            // name() is the bare name on current cores, strip a path if not
+            const char *name = file.name();
+            const char *slash = strrchr(name, '/');
+            if (slash)
+                name = slash + 1;
+
+            bool isDirectory = file.isDirectory();
+            uint32_t size = 0;
+            if (!isDirectory)
+            {
+                // A dirty cached handle is ahead of the directory entry
+                String path = String(SD_INDEX_DIRS[dir]) + "/" + name;
+                if (!handleSize(path.c_str(), size))
+                    size = file.size();
+            }
+            indexPutEntry(dir, name, size, isDirectory);
+
+            file.close();
+            file = root.openNextFile();
+        }
+    }
+    if (root)
+        root.close();
+    unlockCache();
+}
+
+void EARS_sdCard::indexTask(void *param)
+{
+    EARS_sdCard *self = (EARS_sdCard *)param;
+    uint32_t start = millis();
+
+    for (uint8_t d = 0; d < SD_INDEX_DIR_COUNT && self->isAvailable(); d++)
+        self->indexScanDir(d);
+
+    self->lockCache();
+    self->_indexReady = self->isAvailable();
+    self->_indexBuildMs = millis() - start;
+    self->_indexTask = nullptr;
+    self->unlockCache();
+
+#if EARS_DEBUG == 1
+    Serial.printf("[SD] Directory index: %u entries in %lu ms\n", self->_indexCount,
+                  (unsigned long)self->_indexBuildMs);
+#endif
+    vTaskDelete(NULL);
+}
+
+bool EARS_sdCard::buildIndex()
+{
+    if (!isAvailable())
+        return false;
+    if (_indexReady || _indexTask)
+        return true;
+
+    if (!_index)
+    {
+        size_t bytes = SD_INDEX_SLOTS * sizeof(IndexEntry);
+        _index = (IndexEntry *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (!_index)
+            _index = (IndexEntry *)heap_caps_malloc(bytes, MALLOC_CAP_8BIT);
+        if (!_index)
+        {
+            Serial.println("[SD] ERROR: No memory for the directory index");
+            return false;
+        }
+        memset(_index, 0, bytes);
+    }
+
+    if (xTaskCreatePinnedToCore(indexTask, "SDIndex", SD_INDEX_TASK_STACK_SIZE, this, SD_INDEX_TASK_PRIORITY,
+                                &_indexTask, SD_INDEX_TASK_CORE) != pdPASS)
+    {
+        Serial.println("[SD] ERROR: Failed to create index task");
+        _indexTask = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void EARS_sdCard::getIndexStats(SDIndexStats &stats)
+{
+    lockCache();
+    stats.ready = _indexReady;
+    stats.entries = _indexCount;
+    stats.capacity = SD_INDEX_SLOTS * 3 / 4;
+    stats.unindexedDirs = _indexIncomplete;
+    stats.hits = _indexHits;
+    stats.fallbacks = _indexFallbacks;
+    stats.buildMs = _indexBuildMs;
+    unlockCache();
+}
+
+/******************************************************************************
+ * Hot-Plug and Offline Queue
+ *****************************************************************************/
+
+bool EARS_sdCard::cardPresent()
+{
+#if SD_DETECT_PIN >= 0
+    return digitalRead(SD_DETECT_PIN) == SD_DETECT_ACTIVE;
+#else
+    // CMD13 SEND_STATUS: one short command, serialised by the SDMMC host driver
+    sdmmc_card_t *card = SDMMCCardAccess::card(SD_MMC);
+    return card != nullptr && sdmmc_get_status(card) == ESP_OK;
+#endif
+}
+
+void EARS_sdCard::checkPresence()
+{
+    if (!_monitor || _suspended)
+        return;
+
+    uint32_t now = millis();
+    if (isAvailable())
+    {
+        if (now - _lastPresenceMs < SD_PRESENCE_CHECK_MS)
+            return;
+        _lastPresenceMs = now;
+        if (!cardPresent())
+            notifyCardRemoved();
+        return;
+    }
+
+#if SD_DETECT_PIN >= 0
+    if (digitalRead(SD_DETECT_PIN) != SD_DETECT_ACTIVE)
+        return; // Slot empty: nothing to try
+#endif
+    if ((int32_t)(now - _nextRemountMs) < 0)
+        return;
+
+    Serial.println("[SD] Trying to remount the card");
+    if (performFullInitialization(_config).state == SD_CARD_READY)
+    {
+        _remountDelayMs = SD_REMOUNT_RETRY_MS;
+        Serial.printf("[SD] Remounted, %u queued writes to replay\n", _queueCount);
+        return;
+    }
+
+    _nextRemountMs = millis() + _remountDelayMs;
+    _remountDelayMs = (_remountDelayMs * 2 > SD_REMOUNT_RETRY_MAX_MS) ? SD_REMOUNT_RETRY_MAX_MS : _remountDelayMs * 2;
+}
+
+bool EARS_sdCard::queueWrite(QueuedOp op, const char *path, uint32_t offset, const uint8_t *data, size_t length)
+{
+    lockCache();
+
+    // A whole-file write makes every earlier queued write to the path moot
+    if (op == QUEUED_WRITE || op == QUEUED_WRITE_ATOMIC)
+    {
+        uint8_t kept = 0;
+        for (uint8_t i = 0; i < _queueCount; i++)
+        {
+            if (_queue[i].path == path)
+            {
+                _queueBytes -= _queue[i].length;
+                heap_caps_free(_queue[i].data);
+                _queue[i].data = nullptr;
+                continue;
+            }
+            if (kept != i)
+                _queue[kept] = _queue[i];
+            kept++;
+        }
+        for (uint8_t i = kept; i < _queueCount; i++)
+        {
+            _queue[i].path = "";
+            _queue[i].data = nullptr;
+        }
+        _queueCount = kept;
+    }
+
+    if (_queueBytes + length > SD_OFFLINE_QUEUE_BYTES)
+    {
+        _queueDropped++;
+        unlockCache();
+        Serial.printf("[SD] ERROR: Offline queue full, write to %s dropped\n", path);
+        return false;
+    }
+
+    // Appends to the newest entry for the same file extend it in place
+    QueuedWrite *last = _queueCount > 0 ? &_queue[_queueCount - 1] : nullptr;
+    if (op == QUEUED_APPEND && last && last->op != QUEUED_WRITE_AT && last->path == path)
+    {
+        uint8_t *grown = (uint8_t *)heap_caps_realloc(last->data, last->length + length, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (!grown)
+            grown = (uint8_t *)heap_caps_realloc(last->data, last->length + length, MALLOC_CAP_8BIT);
+        if (grown)
+        {
+            memcpy(grown + last->length, data, length);
+            last->data = grown;
+            last->length += length;
+            _queueBytes += length;
+            unlockCache();
+            return true;
+        }
+    }
+
+    uint8_t *copy = nullptr;
+    if (length > 0)
+    {
+        copy = (uint8_t *)heap_caps_malloc(length, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (!copy)
+            copy = (uint8_t *)heap_caps_malloc(length, MALLOC_CAP_8BIT);
+    }
+    if (_queueCount >= SD_OFFLINE_QUEUE_ENTRIES || (length > 0 && !copy))
+    {
+        heap_caps_free(copy);
+        _queueDropped++;
+        unlockCache();
+        Serial.printf("[SD] ERROR: Offline queue full, write to %s dropped\n", path);
+        return false;
+    }
+
+    if (length > 0)
+        memcpy(copy, data, length);
+    QueuedWrite &entry = _queue[_queueCount++];
+    entry.op = op;
+    entry.path = path;
+    entry.offset = offset;
+    entry.data = copy;
+    entry.length = length;
+    _queueBytes += length;
+    unlockCache();
+    return true;
+}
+
+void EARS_sdCard::drainQueue()
+{
+    static const uint8_t empty = 0;
+
+    lockCache();
+    uint8_t done = 0;
+    while (done < _queueCount && isAvailable())
+    {
+        QueuedWrite &entry = _queue[done];
+        const char *path = entry.path.c_str();
+        const uint8_t *data = entry.data ? entry.data : &empty;
+        bool ok = false;
+
+        switch (entry.op)
+        {
+        case QUEUED_APPEND:
+            ok = appendData(path, data, entry.length);
+            break;
+        case QUEUED_WRITE:
+        {
+            // writeFile() takes a String; the queue holds raw bytes
+            String content;
+            content.concat((const char *)data, entry.length);
+            ok = writeFile(path, content);
+            break;
+        }
+        case QUEUED_WRITE_ATOMIC:
+            ok = writeFileAtomic(path, data, entry.length);
+            break;
+        case QUEUED_WRITE_AT:
+            ok = writeDataAt(path, entry.offset, data, entry.length);
+            break;
+        }
+
+        // Card gone again: keep this entry and the rest for the next remount
+        if (!ok && !isAvailable())
+            break;
+        if (!ok)
+            Serial.printf("[SD] ERROR: Queued write to %s failed, dropped\n", path);
+
+        _queueBytes -= entry.length;
+        heap_caps_free(entry.data);
+        entry.data = nullptr;
+        entry.path = "";
+        done++;
+    }
+
+    // Shift what is left to the front
+    uint8_t left = _queueCount - done;
+    for (uint8_t i = 0; i < left; i++)
+    {
+        _queue[i] = _queue[done + i];
+        _queue[done + i].data = nullptr;
+        _queue[done + i].path = "";
+    }
+    _queueCount = left;
+    unlockCache();
+
+#if EARS_DEBUG == 1
+    if (done > 0)
+        Serial.printf("[SD] Replayed %u queued writes, %u left\n", done, left);
+#endif
+}
+
+/******************************************************************************
+ * High-Level Initialization Orchestration (DEBLOAT Step 5)
+ *****************************************************************************/
+
+/**
+ * @brief Perform complete SD card initialization sequence
+ * @return SDCardInitResult Detailed result of initialization
+ *
+ * @details
+ * This function orchestrates the complete SD card initialization:
+ * 1. Initialize SD_MMC interface via begin()
+ * 2. Check initialization result (success, failed, no card)
+ * 3. If successful, retrieve card information
+ * 4. Create essential directories (/logs, /config, /images)
+ * 5. Return detailed status for caller interpretation
+ *
+ * This function was extracted from main.cpp during debloat Step 5.
+ * It encapsulates all SD card initialization logic in one place.
+ *
+ * @note The caller should interpret the result to set LED patterns
+ *       and update application state accordingly.
+ */
+SDCardInitResult EARS_sdCard::performFullInitialization(const SDCardConfig &config)
+{
+    SDCardInitResult result;
+
+    // From here on service() watches the slot and remounts with this setup
+    _config = config;
+    if (!_monitor)
+    {
+        _monitor = true;
+#if SD_DETECT_PIN >= 0
+        pinMode(SD_DETECT_PIN, INPUT_PULLUP);
+#endif
+    }
+    _lastPresenceMs = millis();
+
+    // ========================================================================
+    // STEP 1: Initialize SD card hardware
+    // ========================================================================
+    Serial.println("[INIT] Initializing SD card...");
+
+    if (!begin(config))
+    {
+        // begin() failed - check why
+        result.state = getState();
+
+        if (result.state == SD_INIT_FAILED)
+        {
+            Serial.println("[ERROR] SD card initialization failed!");
+        }
+        else if (result.state == SD_NO_CARD)
+        {
+            Serial.println("[WARNING] No SD card detected");
+        }
+
+        return result;
+    }
+
+    // ========================================================================
+    // STEP 2: Card successfully initialized - gather information
+    // ========================================================================
+    result.state = SD_CARD_READY;
+    result.cardType = getCardType();
+    result.cardSizeMB = getCardSizeMB();
+    result.freeMB = getFreeSpaceMB();
+    result.usedMB = getUsedSpaceMB();
+    result.mode4bit = _mode4bit;
+    result.frequencyKhz = _frequencyKhz;
+    result.selfTestPassed = _selfTestPassed;
+    result.writeKBps = _writeKBps;
+    result.readKBps = _readKBps;
+
+    Serial.println("[OK] SD card initialized successfully");
+    Serial.printf("[INFO] Card type: %s\n", result.cardType.c_str());
+    Serial.printf("[INFO] Card size: %llu MB\n", result.cardSizeMB);
+    Serial.printf("[INFO] Free space: %llu MB\n", result.freeMB);
+    Serial.printf("[INFO] Bus: %s @ %d kHz\n", result.mode4bit ? "4-bit" : "1-bit", result.frequencyKhz);
+    if (result.selfTestPassed)
+    {
+        Serial.printf("[INFO] Throughput: write %lu KB/s, read %lu KB/s\n",
+                      (unsigned long)result.writeKBps, (unsigned long)result.readKBps);
+    }
+
+    // ========================================================================
+    // STEP 3: Create essential directories
+    // ========================================================================
+    Serial.println("[INFO] Creating essential directories...");
+
+    bool logsOk = createDirectory("/logs");
+    bool configOk = createDirectory("/config");
+    bool imagesOk = createDirectory("/images");
+
+    result.directoriesCreated = (logsOk && configOk && imagesOk);
+
+    if (result.directoriesCreated)
+    {
+        Serial.println("[OK] Essential directories ready");
+    }
+    else
+    {
+        Serial.println("[WARNING] Some directories could not be created");
+    }
+
+    // ========================================================================
+    // STEP 4: Index the managed directories in the background
+    // ========================================================================
+    buildIndex();
 
     return result;
 }
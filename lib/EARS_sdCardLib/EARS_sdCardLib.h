@@ -1,9 +1,9 @@
 /**
  * @file EARS_sdCardLib.h
  * @author JTB & Claude Sonnet 4.2
- * @brief SD Card library for ESP32-S3 using SD_MMC (SDIO 1-bit mode)
- * @version 3.0.0
- * @date 20260210
+ * @brief SD Card library for ESP32-S3 using SD_MMC (SDIO 1-bit or 4-bit mode)
+ * @version 3.16.0
+ * @date 20261015
  *
  * @details
  * This library uses SD_MMC for SD card access (SDIO interface)
@@ -17,6 +17,57 @@
  *
  * NOTE: These pins do NOT conflict with display (which uses GPIOs 1,2,3,5,6)
  *
+ * Board variants that route D1-D3 can enable 4-bit mode (SDMMC_D1..D3 and
+ * SDMMC_USE_4BIT) and the 40 MHz high-speed clock. begin() steps down to
+ * 1-bit and then to the default clock if a mount or the self-test fails.
+ *
+ * Byte-level operations (appendData, writeDataAt, readDataAt, getFileSize)
+ * share a small LRU cache of open File handles, so frequent writers skip
+ * the FAT directory lookup and close/sync on every call. Data reaches the
+ * card at flush(), when a handle is evicted, or when the path is removed,
+ * renamed or rewritten.
+ *
+ * appendData() and writeDataAt() are merged per file in RAM write buffers
+ * and written by service() in SD_WRITE_ALIGN (erase-block sized) chunks
+ * cut on aligned file offsets, or whole once the oldest byte is
+ * SD_WRITE_MAX_DELAY_MS old. Readers of a buffered file see its data
+ * (the buffer is written first). Background writes hold off while an
+ * interactive read (UI images through the LVGL 'S' drive) is running or
+ * has just run, so image loads do not queue behind log chunks.
+ *
+ * writeFileAtomic() replaces a file via a temp file and rename, so a power
+ * cut leaves either the old or the new contents. writeFileCoalesced() keeps
+ * the latest contents in RAM and commits them atomically from service()
+ * once writes to that path have been quiet for SD_COALESCE_WINDOW_MS.
+ *
+ * File operations go through an fs::FS and its mount point rather than
+ * SD_MMC directly, so EARS_flashFs offers the same API on internal flash
+ * (LittleFS) for small, hot files such as ears.config.
+ *
+ * writeSnapshot()/readSnapshot() keep a binary image of something parsed
+ * from a source file, tagged with the source's size, mtime and CRC, so
+ * owners can skip the parse at boot while the source is unchanged.
+ *
+ * The managed directories (/logs, /config, /images) are indexed in RAM by
+ * a background task after mounting, and the index is kept current by this
+ * class's own create, write, rename and remove calls. fileExists(),
+ * directoryExists() and getFileSize() on their entries, and listEntries()
+ * on the directories, are hash lookups that never reach the card. Code
+ * that writes there by other means (POSIX, the LVGL 'S' drive) calls
+ * refreshIndex() for the path.
+ *
+ * After performFullInitialization() the card is watched from service()
+ * (Core 1): a CMD13 status poll, or SD_DETECT_PIN where the slot has a
+ * detect switch. A pulled card is unmounted and remounted once it is back,
+ * retrying with a backoff. While it is away, appends and whole-file or
+ * in-place writes go into a bounded RAM/PSRAM queue instead of being
+ * dropped, and coalesced writes stay pending; both reach the card in order
+ * after the remount. No call waits for a missing card.
+ *
+ * suspend() hands the card to another owner (USB mass storage, see
+ * MAIN_usbMscLib) the same way: everything is written, the card is
+ * unmounted and writes queue until resume() mounts it again.
+ *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
 
@@ -29,7 +80,12 @@
  *****************************************************************************/
 #include <Arduino.h>
 #include "EARS_versionDef.h"
+#include "EARS_taskPlanLib.h"
 #include <SD_MMC.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <atomic>
+#include "EARS_eventBusLib.h"
 
 /******************************************************************************
  * Library Version Information
@@ -38,9 +94,9 @@ namespace EARS_SDCard
 {
     constexpr const char* LIB_NAME = "EARS_sdCard";
     constexpr const char* VERSION_MAJOR = "3";
-    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_MINOR = "16";
     constexpr const char* VERSION_PATCH = "0";
-    constexpr const char* VERSION_DATE = "2026-02-10";
+    constexpr const char* VERSION_DATE = "2026-10-15";
 }
 
 
@@ -50,6 +106,135 @@ namespace EARS_SDCard
 #define SDMMC_CLK 11 // Clock (IO11)
 #define SDMMC_CMD 10 // Command (IO10)
 #define SDMMC_D0 9   // Data 0 (IO9)
+#define SDMMC_D1 -1  // Data 1 (not routed on this board, set for 4-bit variants)
+#define SDMMC_D2 -1  // Data 2
+#define SDMMC_D3 -1  // Data 3
+#define SDMMC_MOUNT_POINT "/sdcard" // VFS mount point (POSIX calls need it)
+
+/******************************************************************************
+ * Bus Configuration
+ *****************************************************************************/
+#define SDMMC_USE_4BIT 0                       // 1 = try 4-bit mode when D1-D3 are set
+#define SDMMC_FREQ_KHZ SDMMC_FREQ_HIGHSPEED    // Preferred clock, falls back to default
+#define SD_SELFTEST_ENABLED 1                  // Measure throughput during begin()
+#define SD_SELFTEST_BYTES 65536                // Bytes written and read back
+#define SD_SELFTEST_CHUNK 4096                 // Transfer size per call
+#define SD_SELFTEST_PATH "/.sdtest.bin"
+
+/******************************************************************************
+ * File Handle Cache Configuration
+ *****************************************************************************/
+#define SD_HANDLE_CACHE_SIZE 4                        // Open handles kept (LRU)
+#define SD_MAX_OPEN_FILES (SD_HANDLE_CACHE_SIZE + 6)  // VFS limit incl. transient opens
+#define SD_READ_CHUNK_SIZE 512                        // Bulk read size for streaming readers
+
+/******************************************************************************
+ * Atomic / Coalesced Write Configuration
+ *****************************************************************************/
+#define SD_COALESCE_SLOTS 2           // Files with pending coalesced contents
+#define SD_COALESCE_WINDOW_MS 1500    // Quiet time before a pending write commits
+#define SD_COALESCE_MAX_DELAY_MS 6000 // Upper bound from first change to commit
+
+/******************************************************************************
+ * Hot-Plug Configuration
+ *****************************************************************************/
+#define SD_DETECT_PIN -1              // Card detect switch (-1 = CMD13 status poll)
+#define SD_DETECT_ACTIVE LOW          // Detect level with a card in the slot
+#define SD_PRESENCE_CHECK_MS 1000     // Poll interval while mounted
+#define SD_REMOUNT_RETRY_MS 2000      // First remount retry, doubled per failure
+#define SD_REMOUNT_RETRY_MAX_MS 30000 // Longest remount retry interval
+#define SD_OFFLINE_QUEUE_ENTRIES 32   // Writes held while the card is away
+#define SD_OFFLINE_QUEUE_BYTES 65536  // Their total size (PSRAM when present)
+
+/******************************************************************************
+ * Write Scheduler Configuration
+ *****************************************************************************/
+#define SD_WRITE_BUFFERS 4                        // Files with merged writes in RAM
+#define SD_WRITE_ALIGN 16384                      // Chunk and file-offset alignment (erase-block sized)
+#define SD_WRITE_BUFFER_SIZE (2 * SD_WRITE_ALIGN) // Per file (PSRAM when present)
+#define SD_WRITE_MAX_DELAY_MS 2000                // Oldest buffered byte is written by then
+#define SD_INTERACTIVE_HOLDOFF_MS 150             // Background writes wait after an interactive read
+
+/******************************************************************************
+ * Directory Index Configuration
+ *****************************************************************************/
+#define SD_INDEX_DIR_COUNT 3          // /logs, /config, /images (performFullInitialization)
+#define SD_INDEX_SLOTS 512            // Hash slots (power of two), filled to 3/4 at most
+#define SD_INDEX_NAME_LEN 40          // Longest indexed name + 1; longer ones unindex their directory
+#define SD_INDEX_TASK_STACK_SIZE 4096
+#define SD_INDEX_TASK_PRIORITY using_taskplan().priority(TASK_ROLE_SD_INDEX)
+#define SD_INDEX_TASK_CORE using_taskplan().core(TASK_ROLE_SD_INDEX)
+
+/******************************************************************************
+ * Snapshot Cache Configuration
+ *****************************************************************************/
+#define SD_SNAPSHOT_MAGIC 0x50414E53 // "SNAP" little endian
+
+/**
+ * @brief Identity of a source file that a snapshot was built from
+ * @details The CRC is what decides; size and mtime are recorded as well,
+ *          but with no RTC every file carries the same FAT timestamp.
+ */
+struct SDSnapshotKey
+{
+    uint32_t size;
+    uint32_t mtime;
+    uint32_t crc; // CRC-32 of the source contents
+};
+
+/**
+ * @brief Callback for readChunks()
+ * @param data Chunk bytes (valid only during the call)
+ * @param length Chunk length
+ * @param context Caller context pointer
+ * @return true to continue, false to stop reading
+ */
+typedef bool (*SDChunkCallback)(const uint8_t *data, size_t length, void *context);
+
+/**
+ * @brief Callback for listEntries()
+ * @param name Entry name, without the directory (valid only during the call)
+ * @param size File size in bytes (0 for directories)
+ * @param isDirectory true for a subdirectory
+ * @param context Caller context pointer
+ * @return true to continue, false to stop listing
+ */
+typedef bool (*SDDirCallback)(const char *name, uint32_t size, bool isDirectory, void *context);
+
+/**
+ * @brief I/O scheduler queue depths and latencies, for getIoStats()
+ * @note Read counters are updated without a lock and may be one read stale.
+ */
+struct SDIoStats
+{
+    uint8_t bufferedFiles;  // Write buffers holding data
+    uint32_t bufferedBytes; // Bytes waiting in them
+    uint8_t queuedWrites;   // Offline queue (card out)
+    uint8_t pendingWrites;  // Coalesced whole-file writes
+    uint32_t mergedWrites;  // appendData()/writeDataAt() calls taken by a buffer
+    uint32_t cardWrites;    // Chunks written from the buffers
+    uint32_t alignedWrites; // Of those, ending on an SD_WRITE_ALIGN boundary
+    uint32_t deferrals;     // Background writes held back for interactive reads
+    uint32_t writeAvgUs;    // Chunk write latency
+    uint32_t writeMaxUs;
+    uint32_t reads;         // Interactive reads
+    uint32_t readAvgUs;     // Interactive read latency
+    uint32_t readMaxUs;
+};
+
+/**
+ * @brief Directory index counters, for getIndexStats()
+ */
+struct SDIndexStats
+{
+    bool ready;            // Built and answering lookups
+    uint16_t entries;      // Files and directories indexed
+    uint16_t capacity;     // Entries the table takes
+    uint8_t unindexedDirs; // Managed directories left to the card (bit per directory)
+    uint32_t hits;         // Lookups answered from RAM
+    uint32_t fallbacks;    // Lookups that went to the card
+    uint32_t buildMs;      // Time the background build took
+};
 
 /******************************************************************************
  * SD Card State Enum
@@ -62,6 +247,28 @@ enum SDCardState
     SD_CARD_READY
 };
 
+/******************************************************************************
+ * SD Card Bus Configuration Structure
+ *****************************************************************************/
+/**
+ * @struct SDCardConfig
+ * @brief Requested bus setup for begin()
+ *
+ * @details
+ * These are the preferred settings; begin() falls back to 1-bit mode and
+ * then SDMMC_FREQ_DEFAULT when a mount or the self-test fails.
+ */
+struct SDCardConfig
+{
+    bool mode4bit;         // Use D0-D3 (needs SDMMC_D1..D3 routed)
+    int frequencyKhz;      // SDMMC_FREQ_HIGHSPEED or SDMMC_FREQ_DEFAULT
+    bool selfTest;         // Run the throughput self-test after mounting
+
+    SDCardConfig() : mode4bit(SDMMC_USE_4BIT && SDMMC_D1 >= 0 && SDMMC_D2 >= 0 && SDMMC_D3 >= 0),
+                     frequencyKhz(SDMMC_FREQ_KHZ),
+                     selfTest(SD_SELFTEST_ENABLED) {}
+};
+
 /******************************************************************************
  * SD Card Initialization Result Structure (DEBLOAT Step 5)
  *****************************************************************************/
@@ -82,13 +289,23 @@ struct SDCardInitResult
     uint64_t freeMB;         // Free space in MB
     uint64_t usedMB;         // Used space in MB
     bool directoriesCreated; // Essential directories created successfully
+    bool mode4bit;           // Bus width actually mounted
+    int frequencyKhz;        // Clock actually mounted
+    bool selfTestPassed;     // Pattern written and read back correctly
+    uint32_t writeKBps;      // Self-test write throughput (0 if not run)
+    uint32_t readKBps;       // Self-test read throughput (0 if not run)
 
     SDCardInitResult() : state(SD_NOT_INITIALIZED),
                          cardType(""),
                          cardSizeMB(0),
                          freeMB(0),
                          usedMB(0),
-                         directoriesCreated(false) {}
+                         directoriesCreated(false),
+                         mode4bit(false),
+                         frequencyKhz(0),
+                         selfTestPassed(false),
+                         writeKBps(0),
+                         readKBps(0) {}
 };
 
 /******************************************************************************
@@ -107,12 +324,32 @@ public:
     static void getVersionString(char* buffer);
 
     /**
-     * @brief Initialize the SD card (SD_MMC 1-bit mode)
+     * @brief Initialize the SD card with the default bus configuration
      * @return true if SD card initialized successfully
      * @return false if SD card initialization failed
      */
     bool begin();
 
+    /**
+     * @brief Initialize the SD card, stepping down the bus setup on failure
+     * @param config Preferred bus width, clock and self-test option
+     * @return true if SD card initialized successfully
+     * @return false if every bus setup failed
+     */
+    bool begin(const SDCardConfig &config);
+
+    bool isBus4bit() const { return _mode4bit; }
+    int getBusFrequencyKhz() const { return _frequencyKhz; }
+
+    /**
+     * @brief Measure write/read throughput with a temporary file
+     * @param writeKBps Receives write throughput in KB/s
+     * @param readKBps Receives read throughput in KB/s
+     * @return true if the pattern read back matched
+     * @return false if the test file could not be written or verified
+     */
+    bool runSelfTest(uint32_t &writeKBps, uint32_t &readKBps);
+
     bool isAvailable() const;
     SDCardState getState() const;
     String getCardType() const;
@@ -127,10 +364,301 @@ public:
     bool removeDirectory(const char *path);
     void listDirectory(const char *path, uint8_t indent = 0);
 
+    /**
+     * @brief List one directory through a callback (no recursion, no printing)
+     * @param path Directory path
+     * @param callback Called for each entry, return false to stop
+     * @param context Passed through to the callback
+     * @return uint16_t Entries delivered
+     * @note Managed directories come from the index once it is built, in
+     *       no particular order, with the cache lock held during the calls.
+     */
+    uint16_t listEntries(const char *path, SDDirCallback callback, void *context);
+
+    /**
+     * @brief Start indexing the managed directories in the background
+     * @return true if the build task started or the index is already built
+     * @note Called by performFullInitialization(); lookups go to the card
+     *       until the build finishes.
+     */
+    bool buildIndex();
+
+    /**
+     * @brief Re-read one path into the index from the card
+     * @param path Path written without this class (no-op outside the
+     *             managed directories)
+     */
+    void refreshIndex(const char *path);
+
+    bool isIndexReady() const { return _indexReady; }
+
+    /**
+     * @brief Writes waiting for the card to come back
+     * @return uint8_t Queued writes (appends to one file count once)
+     */
+    uint8_t getQueuedWrites() const { return _queueCount; }
+    uint32_t getQueuedBytes() const { return _queueBytes; }
+    uint32_t getDroppedWrites() const { return _queueDropped; }
+
+    /**
+     * @brief Directory index counters
+     * @param stats Filled with the counters
+     */
+    void getIndexStats(SDIndexStats &stats);
+
+    /**
+     * @brief Read a whole file into a String
+     * @param path File path
+     * @return String File contents (empty on error)
+     * @note Presized from the file size and filled in SD_READ_CHUNK_SIZE
+     *       blocks; prefer readInto() or readChunks() for large files
+     */
     String readFile(const char *path);
+
+    /**
+     * @brief Bulk read the start of a file into a caller buffer
+     * @param path File path
+     * @param buffer Destination
+     * @param length Destination size (size it from getFileSize())
+     * @return size_t Bytes read (0 on error)
+     */
+    size_t readInto(const char *path, uint8_t *buffer, size_t length);
+
+    /**
+     * @brief Stream a file through a callback in SD_READ_CHUNK_SIZE blocks
+     * @param path File path
+     * @param callback Called for each chunk, return false to stop
+     * @param context Passed through to the callback
+     * @return true if the whole file was delivered
+     * @return false if the file could not be opened or the callback stopped
+     */
+    bool readChunks(const char *path, SDChunkCallback callback, void *context);
+
+    /**
+     * @brief Open a file for streaming reads (e.g. deserializeJson(doc, file))
+     * @param path File path
+     * @return File Read handle, false if missing; caller closes it
+     */
+    File openRead(const char *path);
     bool writeFile(const char *path, const String &content);
     bool appendFile(const char *path, const String &content);
 
+    /**
+     * @brief Append a raw byte block to a file (no String copy)
+     * @param path File path
+     * @param data Bytes to append
+     * @param length Number of bytes
+     * @return true if all bytes were written
+     * @return false if the card is unavailable or the write was short
+     */
+    bool appendData(const char *path, const uint8_t *data, size_t length);
+
+    /**
+     * @brief Get the size of a file
+     * @param path File path
+     * @return uint32_t File size in bytes (0 if missing or unavailable)
+     */
+    uint32_t getFileSize(const char *path);
+
+    /**
+     * @brief Rename (move) a file without copying its contents
+     * @param from Existing file path
+     * @param to New file path (must not exist)
+     * @return true if renamed
+     * @return false if the card is unavailable or the rename failed
+     */
+    bool renameFile(const char *from, const char *to);
+
+    /**
+     * @brief Overwrite bytes at an offset inside an existing file
+     * @param path File path
+     * @param offset Byte offset to write at (may equal the file size)
+     * @param data Bytes to write
+     * @param length Number of bytes
+     * @return true if all bytes were written
+     * @return false if the file could not be opened or the write was short
+     */
+    bool writeDataAt(const char *path, uint32_t offset, const uint8_t *data, size_t length);
+
+    /**
+     * @brief Read bytes from an offset inside a file
+     * @param path File path
+     * @param offset Byte offset to read from
+     * @param buffer Destination
+     * @param length Maximum bytes to read
+     * @return size_t Bytes actually read (0 on error or past end)
+     */
+    size_t readDataAt(const char *path, uint32_t offset, uint8_t *buffer, size_t length);
+
+    /**
+     * @brief Grow a file to a given size by appending zero bytes
+     * @param path File path (created if missing)
+     * @param newSize Target size in bytes
+     * @return true if the file is at least newSize bytes
+     * @return false if the card is full or unavailable
+     *
+     * Used to preallocate the FAT cluster chain in one pass instead of one
+     * cluster per small append.
+     */
+    bool extendFile(const char *path, uint32_t newSize);
+
+    /**
+     * @brief Shrink a file to a given size
+     * @param path File path
+     * @param newSize New size in bytes (must not exceed the current size)
+     * @return true if truncated
+     * @return false if the card is unavailable or the call failed
+     */
+    bool truncateFile(const char *path, uint32_t newSize);
+
+    /**
+     * @brief Replace a file atomically (write temp, then rename over)
+     * @param path File path
+     * @param data New contents
+     * @param length Content length
+     * @return true if the new contents are in place
+     * @return false if the old contents were kept
+     */
+    bool writeFileAtomic(const char *path, const uint8_t *data, size_t length);
+    bool writeFileAtomic(const char *path, const String &content);
+
+    /**
+     * @brief Finish or roll back an interrupted atomic write
+     * @param path File path
+     * @return true if path holds a complete file afterwards
+     */
+    bool recoverAtomicWrite(const char *path);
+
+    /**
+     * @brief Describe a source file for snapshot validation
+     * @details Streams the file once in SD_READ_CHUNK_SIZE blocks to CRC it;
+     *          far cheaper than parsing it
+     * @param path Source file path
+     * @param key Filled with size, mtime and CRC
+     * @return true if the file could be read
+     */
+    bool getSnapshotKey(const char *path, SDSnapshotKey &key);
+
+    /**
+     * @brief Store a binary image derived from a source file (atomic)
+     * @param path Snapshot file path
+     * @param key Source identity from getSnapshotKey()
+     * @param layout Caller's layout ID; change it when the image format changes
+     * @param data Image bytes
+     * @param length Image length
+     * @return true if written
+     */
+    bool writeSnapshot(const char *path, const SDSnapshotKey &key, uint32_t layout,
+                       const void *data, size_t length);
+
+    /**
+     * @brief Block-read a snapshot if it matches the source and layout
+     * @param path Snapshot file path
+     * @param key Current source identity
+     * @param layout Expected layout ID
+     * @param data Destination, or nullptr to only query the length
+     * @param capacity Destination size
+     * @return size_t Image length, 0 if missing, stale, corrupt or too large
+     */
+    size_t readSnapshot(const char *path, const SDSnapshotKey &key, uint32_t layout,
+                        void *data, size_t capacity);
+
+    /**
+     * @brief Schedule an atomic rewrite, collapsing bursts into one write
+     * @param path File path
+     * @param content New contents (replaces any pending contents)
+     * @return true if scheduled (or written, when no slot was free)
+     *
+     * Reads through readFile(), readInto(), getFileSize() and fileExists()
+     * see the pending contents before they reach the card.
+     */
+    bool writeFileCoalesced(const char *path, const String &content);
+
+    /**
+     * @brief Commit pending coalesced writes now
+     * @param path File to commit, or nullptr for all
+     * @return true if every commit succeeded
+     */
+    bool commitPending(const char *path = nullptr);
+
+    /**
+     * @brief Coalesced writes still waiting to reach the card
+     * @return uint8_t Pending slots in use
+     * @note Reads without the cache lock so a UI task never waits on a
+     *       commit; the count may be one write stale.
+     */
+    uint8_t getPendingWrites() const;
+
+    /**
+     * @brief Periodic service hook: card presence, remount, queued and
+     *        coalesced writes
+     * @details Call from the Core 1 background task loop. A remount runs
+     *          here, so this call can take a few hundred milliseconds.
+     */
+    void service();
+
+    /**
+     * @brief Write buffered data and flush cached handles to the card (fsync)
+     * @param path File to flush, or nullptr for every file
+     */
+    void flush(const char *path = nullptr);
+
+    /**
+     * @brief Flush and close every cached handle
+     */
+    void closeAll();
+
+    /**
+     * @brief Mark the start of an interactive read (UI image or font)
+     * @details Background writes from service() wait until interactive
+     *          reads have been quiet for SD_INTERACTIVE_HOLDOFF_MS. Any
+     *          task, no lock taken.
+     * @return uint32_t Start time, for endInteractiveRead()
+     */
+    uint32_t beginInteractiveRead();
+
+    /**
+     * @brief Mark the end of an interactive read
+     * @param startUs Value from beginInteractiveRead()
+     */
+    void endInteractiveRead(uint32_t startUs);
+
+    /**
+     * @brief Scheduler queue depths and latencies
+     * @param stats Filled with the counters
+     */
+    void getIoStats(SDIoStats &stats);
+
+    /**
+     * @brief Drop all cached handles after the card was pulled
+     * @details Handles are closed without flushing and the state becomes
+     *          SD_NO_CARD. Pending coalesced writes are kept; service()
+     *          remounts the card once it is back.
+     */
+    void notifyCardRemoved();
+
+    /**
+     * @brief Unmount the card to hand it to another owner (USB mass storage)
+     * @details Coalesced and buffered writes are committed, every handle is
+     *          flushed and closed, and the directory index is dropped (the
+     *          other owner may change anything). Until resume(), service()
+     *          leaves the slot alone and writes go into the offline queue
+     *          as if the card were pulled.
+     * @return true if the card is unmounted (false: not mounted, or the
+     *         index task is still reading it; try again later)
+     * @note Core 1, the task that calls service().
+     */
+    bool suspend();
+
+    /**
+     * @brief Take the card back after suspend() and remount it
+     * @return true if remounted (false: service() keeps retrying)
+     * @note Core 1, the task that calls service().
+     */
+    bool resume();
+
+    bool isSuspended() const { return _suspended; }
+
     /**
      * @brief Perform complete SD card initialization sequence (DEBLOAT Step 5)
      * @return SDCardInitResult Detailed result of initialization
@@ -148,15 +676,266 @@ public:
      * @note The caller should interpret the result to set LED patterns
      *       and update application state accordingly.
      */
-    SDCardInitResult performFullInitialization();
+    SDCardInitResult performFullInitialization(const SDCardConfig &config = SDCardConfig());
 
-private:
+protected:
+    /**
+     * @brief File API over another mounted filesystem (EARS_flashFs)
+     * @param fs Filesystem every file operation goes through
+     * @param mountPoint Its VFS mount point (POSIX calls need it)
+     */
+    EARS_sdCard(fs::FS &fs, const char *mountPoint);
+
+    fs::FS *_fs;             // SD_MMC, or the filesystem of a subclass
+    const char *_mountPoint; // VFS prefix of _fs
     SDCardState _state;
+
+private:
+    /**
+     * @struct HandleSlot
+     * @brief One cached open file
+     */
+    struct HandleSlot
+    {
+        File file;         // Open in "r+" mode, valid when true
+        String path;       // Cache key
+        uint32_t lastUse;  // LRU stamp from _useCounter
+        bool dirty;        // Written since the last flush
+    };
+
     uint8_t _cardType;
+    bool _mode4bit;
+    int _frequencyKhz;
+    bool _selfTestPassed;
+    uint32_t _writeKBps;
+    uint32_t _readKBps;
+
+    SDCardConfig _config;     // Last performFullInitialization() setup, for remounts
+    bool _monitor;            // Presence watched from service()
+    bool _suspended;          // Handed over by suspend(), not remounted
+    uint32_t _lastPresenceMs;
+    uint32_t _nextRemountMs;
+    uint32_t _remountDelayMs;
+
+    /**
+     * @brief Check the mounted card answers, or remount a returned one
+     */
+    void checkPresence();
+
+    /**
+     * @brief Card still in the slot and answering
+     * @return true if present
+     */
+    bool cardPresent();
+
+    /**
+     * @enum QueuedOp
+     * @brief Write held in the offline queue
+     */
+    enum QueuedOp : uint8_t
+    {
+        QUEUED_APPEND,
+        QUEUED_WRITE,        // writeFile()
+        QUEUED_WRITE_ATOMIC, // writeFileAtomic()
+        QUEUED_WRITE_AT      // writeDataAt()
+    };
+
+    struct QueuedWrite
+    {
+        QueuedOp op;
+        String path;
+        uint32_t offset;   // QUEUED_WRITE_AT
+        uint8_t *data;     // PSRAM when present
+        uint32_t length;
+    };
+
+    QueuedWrite _queue[SD_OFFLINE_QUEUE_ENTRIES];
+    uint8_t _queueCount;
+    uint32_t _queueBytes;
+    uint32_t _queueDropped;
+
+    /**
+     * @brief Hold a write until the card is back
+     * @return true if queued (false when full: the write is dropped)
+     */
+    bool queueWrite(QueuedOp op, const char *path, uint32_t offset, const uint8_t *data, size_t length);
+
+    /**
+     * @brief Replay queued writes in order, after a remount
+     */
+    void drainQueue();
+
+    // Writes are queued for the SD card only, not for EARS_flashFs
+    bool queuesOffline() const { return _fs == &SD_MMC; }
+
+    /**
+     * @brief Try one bus setup
+     * @param mode4bit true for D0-D3
+     * @param frequencyKhz Bus clock
+     * @return true if the card mounted and reported a type
+     */
+    bool mount(bool mode4bit, int frequencyKhz);
+
+    /**
+     * @struct PendingWrite
+     * @brief Latest contents of a coalesced file not yet on the card
+     */
+    struct PendingWrite
+    {
+        String path;       // Empty when the slot is free
+        String content;
+        uint32_t firstMs;  // millis() of the first uncommitted change
+        uint32_t lastMs;   // millis() of the latest change
+    };
+
+    PendingWrite _pending[SD_COALESCE_SLOTS];
+
+    /**
+     * @brief Find the pending slot for a path, caller holds the cache lock
+     * @param path File path
+     * @return PendingWrite* Slot or nullptr
+     */
+    PendingWrite *findPending(const char *path);
+
+    HandleSlot _handles[SD_HANDLE_CACHE_SIZE];
+    uint32_t _useCounter;
+    SemaphoreHandle_t _cacheMutex; // Recursive, guards _handles
+
+    /**
+     * @brief Get the cached handle for a path, opening it if needed
+     * @param path File path
+     * @param create true to create a missing file
+     * @return HandleSlot* Cache slot, or nullptr if the file could not be opened
+     */
+    HandleSlot *acquireHandle(const char *path, bool create);
+
+    /**
+     * @brief Close the cached handle for a path, if any
+     * @param path File path
+     */
+    void closeHandle(const char *path);
+
+    void lockCache();
+    void unlockCache();
+
+    /**
+     * @struct WriteBuffer
+     * @brief Contiguous run of writes to one file not yet on the card
+     */
+    struct WriteBuffer
+    {
+        String path;      // Empty when free
+        uint8_t *data;    // SD_WRITE_BUFFER_SIZE, kept once allocated
+        uint32_t start;   // File offset of data[0]
+        uint32_t length;
+        uint32_t firstMs; // millis() of the oldest byte
+    };
+
+    WriteBuffer _writeBuffers[SD_WRITE_BUFFERS];
+    std::atomic<uint8_t> _interactiveReads;
+    volatile uint32_t _lastInteractiveMs;
+    SDIoStats _ioStats;
+    uint64_t _writeTotalUs;
+    uint64_t _readTotalUs;
+
+    // Write scheduler helpers, callers hold the cache lock
+    WriteBuffer *findWriteBuffer(const char *path);
+    bool bufferWrite(const char *path, uint32_t offset, const uint8_t *data, size_t length);
+    bool writeBuffered(WriteBuffer &buffer, bool alignedOnly);
+    bool writeAt(const char *path, uint32_t offset, const uint8_t *data, size_t length);
+    void flushWriteBuffer(const char *path);
+    void dropWriteBuffer(const char *path);
+    void serviceWrites();
+
+    /**
+     * @brief Size of a file through its cached handle, caller holds the cache lock
+     * @param path File path
+     * @param size Receives the size, unflushed writes included
+     * @return true if the file has a cached handle
+     */
+    bool handleSize(const char *path, uint32_t &size);
+
+    /**
+     * @struct IndexEntry
+     * @brief One file or subdirectory of a managed directory
+     */
+    struct IndexEntry
+    {
+        uint32_t hash;                 // indexHash() of dir and name
+        uint32_t size;                 // File size (0 for directories)
+        bool used;                     // Slot holds an entry
+        bool isDirectory;
+        uint8_t dir;                   // Managed directory number
+        char name[SD_INDEX_NAME_LEN];
+    };
+
+    IndexEntry *_index;             // SD_INDEX_SLOTS entries (PSRAM), nullptr = no index
+    uint16_t _indexCount;
+    uint8_t _indexIncomplete;       // Bit per managed directory left to the card
+    volatile bool _indexReady;
+    TaskHandle_t _indexTask;
+    uint32_t _indexHits;
+    uint32_t _indexFallbacks;
+    uint32_t _indexBuildMs;
+
+    // Index helpers, callers hold the cache lock
+    bool indexSplit(const char *path, uint8_t &dir, const char *&name) const;
+    int indexFind(uint8_t dir, const char *name, uint32_t hash) const;
+    bool indexLookup(const char *path, bool &exists, uint32_t &size, bool &isDirectory);
+    void indexPutEntry(uint8_t dir, const char *name, uint32_t size, bool isDirectory);
+    void indexPut(const char *path, uint32_t size, bool isDirectory);
+    void indexGrow(const char *path, uint32_t size);
+    void indexRemove(const char *path);
+    void indexScanDir(uint8_t dir);
+    static void indexTask(void *param);
+};
+
+/******************************************************************************
+ * Buffered Stream Reader
+ *****************************************************************************/
+
+/**
+ * @brief Read buffer over an open File, usable as an ArduinoJson input
+ * @details deserializeJson() pulls input a byte at a time; each File::read()
+ *          is a VFS call. This serves those bytes from an SD_READ_CHUNK_SIZE
+ *          buffer refilled with one bulk read, so the parser streams the
+ *          file without a whole-file copy in RAM. Pair it with a
+ *          DeserializationOption::Filter to keep only the needed subtrees.
+ */
+class EARS_sdReader
+{
+public:
+    explicit EARS_sdReader(File &file) : _file(file), _pos(0), _len(0), _total(0) {}
+
+    int read();
+    size_t readBytes(char *buffer, size_t length);
+
+    uint32_t bytesRead() const { return _total; }
+
+private:
+    File &_file;
+    uint8_t _buffer[SD_READ_CHUNK_SIZE];
+    size_t _pos;
+    size_t _len;
+    uint32_t _total;
+
+    bool fill();
+};
+
+/**
+ * @brief What a streamed parse cost, for boot-time reporting
+ */
+struct SDParseReport
+{
+    bool fromSnapshot;  // Loaded from the binary snapshot, no parse
+    uint32_t parseUs;   // Open to end of deserializeJson (or snapshot read)
+    uint32_t bytesRead; // Source bytes pulled through the reader
+    uint32_t heapUsed;  // Heap held by the parsed document
 };
 
 /**
  * @brief Get reference to global SD Card instance (Singleton pattern)
+
  */
 EARS_sdCard &using_sdcard();
 
@@ -0,0 +1,517 @@
+/**
+ * @file EARS_sdCryptLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief At-rest encryption for SD card files on the AES peripheral
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EARS_sdCryptLib.h"
+#include "EARS_systemDef.h"
+#include <esp_heap_caps.h>
+#include <esp_random.h>
+#include <esp_timer.h>
+#include <mbedtls/md.h>
+
+/******************************************************************************
+ * Key Labels
+ *****************************************************************************/
+#define SDCRYPT_LABEL_AES "EARS SD AES-256-CTR key"
+#define SDCRYPT_LABEL_NONCE "EARS SD AES-256-CTR nonce"
+
+/******************************************************************************
+ * Construction
+ *****************************************************************************/
+EARS_sdCrypt::EARS_sdCrypt()
+    : _ready(false),
+      _chunk(nullptr),
+      _mutex(nullptr),
+      _stats{}
+{
+    memset(_nonceKey, 0, sizeof(_nonceKey));
+}
+
+/******************************************************************************
+ * Private Helpers
+ *****************************************************************************/
+
+/**
+ * @brief HMAC-SHA256 of a label under the device secret
+ * @param key Output, 32 bytes
+ */
+bool EARS_sdCrypt::deriveKey(const uint8_t *secret, const char *label, uint8_t *key)
+{
+    const mbedtls_md_info_t *info = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+    if (info == nullptr)
+    {
+        return false;
+    }
+    return mbedtls_md_hmac(info, secret, SDCRYPT_SECRET_BYTES,
+                           (const unsigned char *)label, strlen(label), key) == 0;
+}
+
+/**
+ * @brief The nonce: HMAC(nonce key, path, salt), first SDCRYPT_NONCE_BYTES
+ * @details A salt follows the path's NUL. Unsalted (epoch 0) is HMAC of the
+ *          path alone, as before the epoch log.
+ */
+bool EARS_sdCrypt::nonceFor(const char *path, const uint8_t *salt, size_t saltLength, uint8_t *nonce)
+{
+    const mbedtls_md_info_t *info = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+    if (info == nullptr)
+    {
+        return false;
+    }
+
+    uint8_t mac[32];
+    mbedtls_md_context_t ctx;
+    mbedtls_md_init(&ctx);
+    bool ok = mbedtls_md_setup(&ctx, info, 1) == 0 &&
+              mbedtls_md_hmac_starts(&ctx, _nonceKey, sizeof(_nonceKey)) == 0 &&
+              mbedtls_md_hmac_update(&ctx, (const unsigned char *)path, strlen(path) + (saltLength ? 1 : 0)) == 0 &&
+              (saltLength == 0 || mbedtls_md_hmac_update(&ctx, salt, saltLength) == 0) &&
+              mbedtls_md_hmac_finish(&ctx, mac) == 0;
+    mbedtls_md_free(&ctx);
+
+    if (ok)
+    {
+        memcpy(nonce, mac, SDCRYPT_NONCE_BYTES);
+    }
+    return ok;
+}
+
+/**
+ * @brief CTR over bytes at a file offset; caller holds _mutex
+ * @details The counter block is the nonce then the big-endian 16-byte block
+ *          number. Starting inside a block, that block's keystream is made
+ *          first and the peripheral picks up at the byte offset within it.
+ */
+bool EARS_sdCrypt::crypt(const uint8_t *nonce, uint32_t offset, const uint8_t *input, uint8_t *output,
+                         size_t length)
+{
+    uint8_t counter[16];
+    uint8_t stream[16];
+    size_t streamOffset = offset % 16;
+    uint64_t block = offset / 16;
+
+    memcpy(counter, nonce, SDCRYPT_NONCE_BYTES);
+    for (int i = 15; i >= SDCRYPT_NONCE_BYTES; i--)
+    {
+        counter[i] = (uint8_t)block;
+        block >>= 8;
+    }
+
+    if (streamOffset != 0)
+    {
+        if (esp_aes_crypt_ecb(&_aes, ESP_AES_ENCRYPT, counter, stream) != 0)
+        {
+            return false;
+        }
+        for (int i = 15; i >= SDCRYPT_NONCE_BYTES && ++counter[i] == 0; i--)
+        {
+        }
+    }
+
+    return esp_aes_crypt_ctr(&_aes, length, &streamOffset, counter, stream, input, output) == 0;
+}
+
+/**
+ * @brief CTR over bytes of an append-only file, epoch by epoch; caller holds _mutex
+ */
+bool EARS_sdCrypt::cryptFile(const EARS_sdCryptFile &file, uint32_t offset, const uint8_t *input,
+                             uint8_t *output, size_t length)
+{
+    bool ok = true;
+    for (size_t done = 0; ok && done < length;)
+    {
+        uint32_t at = offset + done;
+        uint32_t i = file.count - 1;
+        while (i > 0 && file.epochs[i].start > at)
+        {
+            i--;
+        }
+
+        size_t n = length - done;
+        if (i + 1 < file.count && file.epochs[i + 1].start - at < n)
+        {
+            n = file.epochs[i + 1].start - at;
+        }
+
+        uint8_t salt[4];
+        uint32_t epoch = file.epochs[i].epoch;
+        for (int b = 3; b >= 0; b--)
+        {
+            salt[b] = (uint8_t)epoch;
+            epoch >>= 8;
+        }
+
+        uint8_t nonce[SDCRYPT_NONCE_BYTES];
+        ok = nonceFor(file.path, salt, file.epochs[i].epoch ? sizeof(salt) : 0, nonce) &&
+             crypt(nonce, at, input + done, output + done, n);
+        done += n;
+    }
+    return ok;
+}
+
+/**
+ * @brief Grow the epoch table to hold count entries
+ */
+bool EARS_sdCrypt::reserveEpochs(EARS_sdCryptFile &file, uint32_t count)
+{
+    if (count <= file.capacity)
+    {
+        return true;
+    }
+
+    uint32_t capacity = file.capacity ? file.capacity * 2 : 4;
+    EARS_sdCryptEpoch *epochs = (EARS_sdCryptEpoch *)realloc(file.epochs, capacity * sizeof(EARS_sdCryptEpoch));
+    if (epochs == nullptr)
+    {
+        return false;
+    }
+    file.epochs = epochs;
+    file.capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Put an epoch in effect from its start; those starting there or later are gone
+ */
+void EARS_sdCrypt::addEpoch(EARS_sdCryptFile &file, const EARS_sdCryptEpoch &entry)
+{
+    while (file.count > 0 && file.epochs[file.count - 1].start >= entry.start)
+    {
+        file.count--;
+    }
+    file.epochs[file.count++] = entry;
+    if (entry.epoch > file.lastEpoch)
+    {
+        file.lastEpoch = entry.epoch;
+    }
+}
+
+/**
+ * @brief Log a new epoch from offset, then use it
+ * @details The entry is flushed before any byte under it is written, so
+ *          the log never lacks an epoch the file uses.
+ */
+bool EARS_sdCrypt::startEpoch(EARS_sdCard &sd, EARS_sdCryptFile &file, uint32_t offset)
+{
+    EARS_sdCryptEpoch entry = {offset, file.lastEpoch + 1};
+    if (!reserveEpochs(file, file.count + 1) ||
+        !sd.appendData(file.logPath, (const uint8_t *)&entry, sizeof(entry)))
+    {
+        return false;
+    }
+    sd.flush(file.logPath);
+
+    addEpoch(file, entry);
+    file.rekey = false;
+    return true;
+}
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/**
+ * @brief Load the device secret (created on first use) and derive the keys
+ */
+bool EARS_sdCrypt::begin(EARS_nvsEeprom *nvs)
+{
+    if (_ready)
+    {
+        return true;
+    }
+    if (nvs == nullptr)
+    {
+        return false;
+    }
+
+    if (_mutex == nullptr)
+    {
+        _mutex = xSemaphoreCreateMutex();
+    }
+    if (_chunk == nullptr)
+    {
+        _chunk = (uint8_t *)heap_caps_malloc(SDCRYPT_CHUNK_BYTES, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    }
+    if (_mutex == nullptr || _chunk == nullptr)
+    {
+        DEBUG_PRINTLN("[ERROR] SD encryption: no memory");
+        return false;
+    }
+
+    // Hex in NVS, created the first time
+    uint8_t secret[SDCRYPT_SECRET_BYTES];
+    String hex = nvs->getHash(EARS_SD_SECRET, "");
+    if (hex.length() == SDCRYPT_SECRET_BYTES * 2)
+    {
+        const char *text = hex.c_str();
+        for (size_t i = 0; i < SDCRYPT_SECRET_BYTES; i++)
+        {
+            char byteHex[3] = {text[i * 2], text[i * 2 + 1], '\0'};
+            secret[i] = (uint8_t)strtoul(byteHex, nullptr, 16);
+        }
+    }
+    else
+    {
+        esp_fill_random(secret, sizeof(secret));
+        char created[SDCRYPT_SECRET_BYTES * 2 + 1];
+        for (size_t i = 0; i < SDCRYPT_SECRET_BYTES; i++)
+        {
+            snprintf(created + i * 2, 3, "%02x", secret[i]);
+        }
+        if (!nvs->putHash(EARS_SD_SECRET, String(created)))
+        {
+            memset(secret, 0, sizeof(secret));
+            DEBUG_PRINTLN("[ERROR] SD encryption: secret not saved");
+            return false;
+        }
+        memset(created, 0, sizeof(created));
+        DEBUG_PRINTLN("[INFO] SD encryption: device secret created");
+    }
+
+    uint8_t aesKey[32];
+    bool ok = deriveKey(secret, SDCRYPT_LABEL_AES, aesKey) &&
+              deriveKey(secret, SDCRYPT_LABEL_NONCE, _nonceKey);
+    memset(secret, 0, sizeof(secret));
+    if (ok)
+    {
+        esp_aes_init(&_aes);
+        ok = esp_aes_setkey(&_aes, aesKey, 256) == 0;
+    }
+    memset(aesKey, 0, sizeof(aesKey));
+
+    _ready = ok;
+    DEBUG_PRINTLN(ok ? "[OK] SD encryption ready (AES-256-CTR)" : "[ERROR] SD encryption: key setup failed");
+    return ok;
+}
+
+/**
+ * @brief Encrypt an image under a new IV
+ */
+bool EARS_sdCrypt::sealImage(const char *path, uint8_t *image, size_t length)
+{
+    if (length < SDCRYPT_IV_BYTES)
+    {
+        return false;
+    }
+    esp_fill_random(image, SDCRYPT_IV_BYTES);
+    return unsealImage(path, image, 0, image + SDCRYPT_IV_BYTES, length - SDCRYPT_IV_BYTES);
+}
+
+/**
+ * @brief Decrypt part of a sealed image in place (CTR: also encrypts)
+ */
+bool EARS_sdCrypt::unsealImage(const char *path, const uint8_t *iv, uint32_t offset, uint8_t *data, size_t length)
+{
+    uint8_t nonce[SDCRYPT_NONCE_BYTES];
+    if (!_ready || !nonceFor(path, iv, SDCRYPT_IV_BYTES, nonce))
+    {
+        return false;
+    }
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    int64_t start = esp_timer_get_time();
+    bool ok = crypt(nonce, offset, data, data, length);
+    _stats.cryptUs += (uint32_t)(esp_timer_get_time() - start);
+    _stats.bytes += ok ? length : 0;
+    xSemaphoreGive(_mutex);
+
+    return ok;
+}
+
+/**
+ * @brief Load an append-only file's epoch log
+ * @details A torn last entry is cut off: nothing was written under it. A
+ *          log with no file to go with it (removed, or cut back to nothing)
+ *          means its epochs were used: the first append starts another.
+ */
+bool EARS_sdCrypt::openFile(EARS_sdCard &sd, const char *path, EARS_sdCryptFile &file)
+{
+    closeFile(file);
+    if (strlen(path) >= sizeof(file.path) || !reserveEpochs(file, 1))
+    {
+        return false;
+    }
+    strlcpy(file.path, path, sizeof(file.path));
+    snprintf(file.logPath, sizeof(file.logPath), "%s%s", path, SDCRYPT_LOG_SUFFIX);
+    file.epochs[0] = {0, 0};
+    file.count = 1;
+    file.lastEpoch = 0;
+    file.rekey = false;
+
+    uint32_t entries = sd.getFileSize(file.logPath) / sizeof(EARS_sdCryptEpoch);
+    if (sd.getFileSize(file.logPath) % sizeof(EARS_sdCryptEpoch))
+    {
+        sd.truncateFile(file.logPath, entries * sizeof(EARS_sdCryptEpoch));
+    }
+
+    EARS_sdCryptEpoch batch[32];
+    for (uint32_t done = 0; done < entries;)
+    {
+        uint32_t want = entries - done;
+        if (want > 32)
+            want = 32;
+        if (sd.readDataAt(file.logPath, done * sizeof(EARS_sdCryptEpoch), (uint8_t *)batch,
+                          want * sizeof(EARS_sdCryptEpoch)) != want * sizeof(EARS_sdCryptEpoch))
+        {
+            closeFile(file);
+            return false;
+        }
+        for (uint32_t i = 0; i < want; i++)
+        {
+            if (!reserveEpochs(file, file.count + 1))
+            {
+                closeFile(file);
+                return false;
+            }
+            addEpoch(file, batch[i]);
+        }
+        done += want;
+    }
+
+    file.rekey = entries > 0 && sd.getFileSize(path) == 0;
+    return true;
+}
+
+/**
+ * @brief Free the epoch table
+ */
+void EARS_sdCrypt::closeFile(EARS_sdCryptFile &file)
+{
+    free(file.epochs);
+    file.epochs = nullptr;
+    file.count = 0;
+    file.capacity = 0;
+}
+
+/**
+ * @brief Encrypt and append
+ * @details A failed append may have put part of its keystream on the card,
+ *          so the next one starts a new epoch.
+ */
+bool EARS_sdCrypt::appendData(EARS_sdCard &sd, EARS_sdCryptFile &file, uint32_t offset, const uint8_t *data,
+                              size_t length)
+{
+    if (!_ready || file.epochs == nullptr || (file.rekey && !startEpoch(sd, file, offset)))
+    {
+        return false;
+    }
+
+    bool ok = true;
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    for (size_t done = 0; ok && done < length;)
+    {
+        size_t n = length - done;
+        if (n > SDCRYPT_CHUNK_BYTES)
+            n = SDCRYPT_CHUNK_BYTES;
+        int64_t start = esp_timer_get_time();
+        ok = cryptFile(file, offset + done, data + done, _chunk, n);
+        _stats.cryptUs += (uint32_t)(esp_timer_get_time() - start);
+
+        if (ok)
+        {
+            ok = sd.appendData(file.path, _chunk, n);
+        }
+        if (ok)
+        {
+            _stats.bytes += n;
+        }
+        done += n;
+    }
+    xSemaphoreGive(_mutex);
+
+    if (!ok)
+    {
+        file.rekey = true;
+    }
+    return ok;
+}
+
+/**
+ * @brief Read and decrypt
+ */
+size_t EARS_sdCrypt::readDataAt(EARS_sdCard &sd, EARS_sdCryptFile &file, uint32_t offset, uint8_t *buffer,
+                                size_t length)
+{
+    if (!_ready || file.epochs == nullptr)
+    {
+        return 0;
+    }
+    size_t got = sd.readDataAt(file.path, offset, buffer, length);
+    if (got == 0)
+    {
+        return 0;
+    }
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    int64_t start = esp_timer_get_time();
+    bool ok = cryptFile(file, offset, buffer, buffer, got);
+    _stats.cryptUs += (uint32_t)(esp_timer_get_time() - start);
+    _stats.bytes += ok ? got : 0;
+    xSemaphoreGive(_mutex);
+
+    return ok ? got : 0;
+}
+
+/**
+ * @brief Cut the file back
+ * @details The cut bytes' keystream may be on the card, or in a copy of it:
+ *          the next append starts a new epoch even if this fails.
+ */
+bool EARS_sdCrypt::truncateFile(EARS_sdCard &sd, EARS_sdCryptFile &file, uint32_t size)
+{
+    file.rekey = true;
+    return sd.truncateFile(file.path, size);
+}
+
+/**
+ * @brief Copy the counters
+ */
+EARS_sdCryptStats EARS_sdCrypt::getStats() const
+{
+    return _stats;
+}
+
+/******************************************************************************
+ * Version Information
+ *****************************************************************************/
+const char* EARS_sdCrypt::getLibraryName()
+{
+    return EARS_SdCrypt::LIB_NAME;
+}
+
+uint32_t EARS_sdCrypt::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_SdCrypt::VERSION_MAJOR,
+                       EARS_SdCrypt::VERSION_MINOR,
+                       EARS_SdCrypt::VERSION_PATCH);
+}
+
+const char* EARS_sdCrypt::getVersionDate()
+{
+    return EARS_SdCrypt::VERSION_DATE;
+}
+
+void EARS_sdCrypt::getVersionString(char* buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+EARS_sdCrypt &using_sdcrypt()
+{
+    static EARS_sdCrypt instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_sdCryptLib.cpp
+ *****************************************************************************/
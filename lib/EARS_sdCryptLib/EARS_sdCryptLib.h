@@ -0,0 +1,228 @@
+/**
+ * @file EARS_sdCryptLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief At-rest encryption for SD card files on the AES peripheral
+ * @details Equipment and ammunition records on a removable card are readable
+ *          by anyone holding the card. This layer encrypts them with
+ *          AES-256-CTR on the ESP32-S3 AES peripheral (esp_aes, which moves
+ *          whole blocks by DMA), so the cost per record is a DMA transfer
+ *          rather than software rounds.
+ *
+ *          - Keys: a random SDCRYPT_SECRET_BYTES device secret is created in
+ *            NVS (EARS_SD_SECRET) on first use, and the AES key and a nonce
+ *            key are derived from it with HMAC-SHA256 (SHA peripheral). The
+ *            password is not used: changing it would strand the data. A
+ *            factory reset clears the secret, which makes the card's
+ *            encrypted files unreadable by design.
+ *          - Nonce: the first 8 bytes of HMAC(nonce key, path, salt), with
+ *            the 16-byte block number of the file offset as the counter.
+ *            Reads can start at any offset and a file keeps its plaintext
+ *            size, so offset arithmetic (fixed-size records) is unchanged.
+ *            A file must keep its name: renamed, it no longer decrypts.
+ *          - Writes are encrypted SDCRYPT_CHUNK_BYTES at a time into one
+ *            DMA-capable internal buffer and handed to EARS_sdCard, which
+ *            buffers and caches handles as for any other write.
+ *
+ *          CTR must never put two plaintexts under one keystream: two
+ *          copies of a card would give away their XOR. So no range is
+ *          encrypted twice under one salt:
+ *
+ *          - Images replaced whole (EARS_sdCard::writeFileAtomic()) go
+ *            through sealImage(), which salts each write with a random
+ *            SDCRYPT_IV_BYTES IV kept in clear at the front of the file.
+ *          - Append-only files (EARS_sdCryptFile) are salted with an epoch.
+ *            Cutting one back (truncateFile()) or a failed append leaves
+ *            bytes whose keystream may be on the card; the next append
+ *            starts a new epoch at its offset, logged in <path>.ep before
+ *            any byte under it is written. Bytes before it keep theirs.
+ *            Epoch 0 is unsalted, as files were before the log.
+ *
+ *          A write lost with the file's size (power cut before the
+ *          directory entry was updated) is not seen, and its offsets are
+ *          appended again under the same epoch.
+ *
+ *          There is no authentication: a changed byte decrypts to a changed
+ *          byte, which the record store's per-record CRC then rejects.
+ *
+ *          Build with -D EARS_SD_ENCRYPT=1 to encrypt the record stores
+ *          (EARS_recordStore::begin() takes this layer).
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_SD_CRYPT_LIB_H__
+#define __EARS_SD_CRYPT_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "aes/esp_aes.h"
+#include "EARS_versionDef.h"
+#include "EARS_sdCardLib.h"
+#include "EARS_nvsEepromLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_SdCrypt
+{
+    constexpr const char* LIB_NAME = "EARS_sdCrypt";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "1";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+
+// 1 = record stores encrypted at rest
+#ifndef EARS_SD_ENCRYPT
+#define EARS_SD_ENCRYPT 0
+#endif
+
+#define SDCRYPT_SECRET_BYTES 32         // Device secret in NVS (hex)
+#define SDCRYPT_CHUNK_BYTES 4096        // Encrypt-then-write unit (internal, DMA-capable)
+#define SDCRYPT_NONCE_BYTES 8           // Per-file nonce; the other 8 count blocks
+#define SDCRYPT_IV_BYTES 8              // Clear IV at the front of a sealed image
+#define SDCRYPT_PATH_MAX 40             // Longest append-only file path, with its NUL
+#define SDCRYPT_LOG_SUFFIX ".ep"        // Epoch log beside an append-only file
+
+/**
+ * @brief One epoch of an append-only file; also its entry in the log
+ */
+struct EARS_sdCryptEpoch
+{
+    uint32_t start;             // First byte under it
+    uint32_t epoch;
+};
+
+/**
+ * @brief An append-only encrypted file and its epochs, from openFile()
+ * @details Zero-initialise before the first openFile().
+ */
+struct EARS_sdCryptFile
+{
+    char path[SDCRYPT_PATH_MAX];
+    char logPath[SDCRYPT_PATH_MAX + sizeof(SDCRYPT_LOG_SUFFIX) - 1];
+    EARS_sdCryptEpoch* epochs;  // In effect, by start; nullptr until opened
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t lastEpoch;         // Highest in the log
+    bool rekey;                 // The next append starts an epoch
+};
+
+/**
+ * @brief Encryption counters
+ */
+struct EARS_sdCryptStats
+{
+    uint32_t bytes;             // Through the AES peripheral, both ways
+    uint32_t cryptUs;           // Time spent on them
+};
+
+/******************************************************************************
+ * EARS_sdCrypt Class
+ *****************************************************************************/
+class EARS_sdCrypt
+{
+public:
+    EARS_sdCrypt();
+
+    // Version information getters
+    static const char* getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char* getVersionDate();
+    static void getVersionString(char* buffer);
+
+    /**
+     * @brief Load the device secret (created on first use) and derive the keys
+     * @param nvs Initialised NVS
+     * @return true if ready
+     */
+    bool begin(EARS_nvsEeprom* nvs);
+
+    bool isReady() const { return _ready; }
+
+    /**
+     * @brief Encrypt an image for EARS_sdCard::writeFileAtomic() under a new IV
+     * @param path File it will be written as
+     * @param image SDCRYPT_IV_BYTES, filled with the IV, then the plaintext
+     * @param length Of the whole image, IV included
+     * @return true if done
+     */
+    bool sealImage(const char* path, uint8_t* image, size_t length);
+
+    /**
+     * @brief Decrypt part of a sealed image in place
+     * @param iv The image's first SDCRYPT_IV_BYTES
+     * @param offset Of the bytes after the IV
+     * @return true if done
+     */
+    bool unsealImage(const char* path, const uint8_t* iv, uint32_t offset, uint8_t* data, size_t length);
+
+    /**
+     * @brief Load an append-only file's epoch log
+     * @param path File path, shorter than SDCRYPT_PATH_MAX
+     * @param file Receives the epochs; kept for the file's other calls
+     * @return true if loaded (no log: one epoch, 0)
+     */
+    bool openFile(EARS_sdCard& sd, const char* path, EARS_sdCryptFile& file);
+
+    /**
+     * @brief Free what openFile() allocated
+     */
+    void closeFile(EARS_sdCryptFile& file);
+
+    /**
+     * @brief Encrypt and append; offset is the file's current size
+     */
+    bool appendData(EARS_sdCard& sd, EARS_sdCryptFile& file, uint32_t offset, const uint8_t* data, size_t length);
+
+    /**
+     * @brief Read and decrypt
+     * @return size_t Bytes read
+     */
+    size_t readDataAt(EARS_sdCard& sd, EARS_sdCryptFile& file, uint32_t offset, uint8_t* buffer, size_t length);
+
+    /**
+     * @brief Cut the file back; the next append starts a new epoch
+     */
+    bool truncateFile(EARS_sdCard& sd, EARS_sdCryptFile& file, uint32_t size);
+
+    EARS_sdCryptStats getStats() const;
+
+private:
+    bool _ready;
+    esp_aes_context _aes;
+    uint8_t _nonceKey[32];
+    uint8_t* _chunk;            // SDCRYPT_CHUNK_BYTES, internal DMA-capable
+    SemaphoreHandle_t _mutex;   // Guards _aes, _chunk and _stats
+
+    EARS_sdCryptStats _stats;
+
+    bool deriveKey(const uint8_t* secret, const char* label, uint8_t* key);
+    bool nonceFor(const char* path, const uint8_t* salt, size_t saltLength, uint8_t* nonce);
+    bool crypt(const uint8_t* nonce, uint32_t offset, const uint8_t* input, uint8_t* output, size_t length);
+    bool cryptFile(const EARS_sdCryptFile& file, uint32_t offset, const uint8_t* input, uint8_t* output,
+                   size_t length);
+    bool reserveEpochs(EARS_sdCryptFile& file, uint32_t count);
+    void addEpoch(EARS_sdCryptFile& file, const EARS_sdCryptEpoch& entry);
+    bool startEpoch(EARS_sdCard& sd, EARS_sdCryptFile& file, uint32_t offset);
+};
+
+// Global instance access function (Singleton pattern)
+EARS_sdCrypt &using_sdcrypt();
+
+#endif // __EARS_SD_CRYPT_LIB_H__
+
+/******************************************************************************
+ * End of EARS_sdCryptLib.h
+ ******************************************************************************/
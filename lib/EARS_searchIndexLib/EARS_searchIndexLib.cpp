@@ -0,0 +1,978 @@
+/**
+ * @file EARS_searchIndexLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Prefix search index over equipment records
+ * @version 1.3.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EARS_searchIndexLib.h"
+#include "EARS_systemDef.h"
+#include <esp_timer.h>
+#include <esp_heap_caps.h>
+#include <esp_rom_crc.h>
+
+/******************************************************************************
+ * File Format
+ *****************************************************************************/
+#define SEARCH_SEGMENT_MAGIC 0x58495345 // "ESIX"
+#define SEARCH_SEGMENT_LAYOUT ((1UL << 16) | (SEARCH_TOKEN_SIZE + sizeof(uint32_t)))
+
+// <name>.six: header, then count entries sorted by token then ID
+struct SegmentHeader
+{
+    uint32_t magic;
+    uint32_t layout;
+    uint32_t sequence;     // Store sequence the entries reflect
+    uint32_t count;
+    uint32_t crc;          // CRC-32 of the entries
+};
+
+/******************************************************************************
+ * Helpers
+ *****************************************************************************/
+
+// Entries and query scratch live in PSRAM when there is any
+static void *searchRealloc(void *ptr, size_t size)
+{
+    void *grown = heap_caps_realloc(ptr, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    return grown ? grown : heap_caps_realloc(ptr, size, MALLOC_CAP_8BIT);
+}
+
+// Splits words in names and queries; everything else that is not
+// alphanumeric is dropped, so "5.56mm" is one token "556mm"
+static bool isSeparator(char c)
+{
+    return c == ' ' || c == '\t' || c == ',' || c == '/' || c == ';' || c == '(' || c == ')';
+}
+
+/******************************************************************************
+ * Construction
+ *****************************************************************************/
+EARS_searchIndex::EARS_searchIndex()
+    : _sdCard(nullptr),
+      _store(nullptr),
+      _mutex(nullptr),
+      _ready(false),
+      _entries(nullptr),
+      _count(0),
+      _capacity(0),
+      _sequence(0),
+      _dirty(false),
+      _stale(false),
+      _lastChangeMs(0),
+      _rebuilt(false),
+      _openUs(0),
+      _lastQueryUs(0),
+      _filter(nullptr),
+      _filterMask(0),
+      _filterChecks(0),
+      _filterRejects(0)
+{
+    _path[0] = '\0';
+}
+
+bool EARS_searchIndex::begin(EARS_sdCard* sdCard, EARS_recordStore* store, const char* name)
+{
+    if (_ready)
+    {
+        return true;
+    }
+
+    if (!sdCard || !sdCard->isAvailable() || !store || !store->isReady())
+    {
+        return false;
+    }
+
+    if (!_mutex)
+    {
+        _mutex = xSemaphoreCreateMutex();
+        if (!_mutex)
+        {
+            return false;
+        }
+    }
+
+    int64_t startUs = esp_timer_get_time();
+
+    _sdCard = sdCard;
+    _store = store;
+    snprintf(_path, sizeof(_path), "%s/%s%s", RECORD_STORE_DIR, name, SEARCH_SEGMENT_SUFFIX);
+    if (_store->getCrypt())
+    {
+        // Tokens are item names: no plaintext copy next to an encrypted store
+        if (_sdCard->fileExists(_path))
+        {
+            _sdCard->removeFile(_path);
+        }
+        snprintf(_path, sizeof(_path), "%s/%s%s", RECORD_STORE_DIR, name, SEARCH_SEGMENT_CRYPT_SUFFIX);
+    }
+
+    if (!reserve(SEARCH_INDEX_INITIAL))
+    {
+        return false;
+    }
+
+    // The store is not being written yet, so its sequence is stable here
+    lock();
+    _rebuilt = !loadSegment();
+    unlock();
+    bool ok = !_rebuilt || rebuild();
+
+    if (!ok)
+    {
+        return false;
+    }
+
+    _store->setListener(onRecord, this);
+    _ready = true;
+    _openUs = (uint32_t)(esp_timer_get_time() - startUs);
+
+#if EARS_DEBUG == 1
+    Serial.printf("[SEARCH] %s: %lu tokens %s in %lu us\n", _path, (unsigned long)_count,
+                  _rebuilt ? "rebuilt" : "loaded", (unsigned long)_openUs);
+#endif
+
+    return true;
+}
+
+/******************************************************************************
+ * Tokens
+ *****************************************************************************/
+
+/**
+ * @brief Lower-case the alphanumerics of a term, cut to a token
+ * @return size_t Characters written (out is NUL-terminated)
+ */
+size_t EARS_searchIndex::normaliseTerm(const char* text, size_t length, char* out)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < length && text[i] && n < SEARCH_TOKEN_SIZE - 1; i++)
+    {
+        char c = text[i];
+        if (isalnum((unsigned char)c))
+        {
+            out[n++] = (char)tolower((unsigned char)c);
+        }
+    }
+    out[n] = '\0';
+    return n;
+}
+
+/**
+ * @brief Append the tokens of one field
+ * @param words true to split at separators, false to keep the field whole
+ * @return uint8_t New token count
+ */
+uint8_t EARS_searchIndex::addTokens(const char* text, size_t length, bool words, Entry* out, uint8_t count)
+{
+    size_t i = 0;
+    while (i < length && text[i] && count < SEARCH_TOKENS_PER_RECORD)
+    {
+        while (words && i < length && text[i] && isSeparator(text[i]))
+        {
+            i++;
+        }
+
+        size_t start = i;
+        while (i < length && text[i] && (!words || !isSeparator(text[i])))
+        {
+            i++;
+        }
+
+        if (i > start && normaliseTerm(text + start, i - start, out[count].token) > 0)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Distinct tokens of an equipment record, sorted, IDs filled in
+ * @param out SEARCH_TOKENS_PER_RECORD entries
+ * @return uint8_t Tokens written
+ */
+uint8_t EARS_searchIndex::tokenise(const EARS_record& record, Entry* out)
+{
+    if (record.header.type != RECORD_EQUIPMENT || (record.header.flags & RECORD_FLAG_DELETED))
+    {
+        return 0;
+    }
+
+    const EARS_equipmentData *item = (const EARS_equipmentData *)record.payload;
+    uint8_t count = 0;
+    count = addTokens(item->serial, sizeof(item->serial), false, out, count);
+    count = addTokens(item->nsn, sizeof(item->nsn), false, out, count);
+    count = addTokens(item->name, sizeof(item->name), true, out, count);
+    count = addTokens(item->category, sizeof(item->category), true, out, count);
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        memset(out[i].token + strlen(out[i].token), 0, SEARCH_TOKEN_SIZE - strlen(out[i].token));
+        out[i].id = record.header.id;
+    }
+    qsort(out, count, sizeof(Entry), compareEntry);
+
+    uint8_t unique = 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (unique == 0 || strncmp(out[unique - 1].token, out[i].token, SEARCH_TOKEN_SIZE) != 0)
+        {
+            out[unique++] = out[i];
+        }
+    }
+    return unique;
+}
+
+int EARS_searchIndex::compareEntry(const void* a, const void* b)
+{
+    const Entry *ea = (const Entry *)a;
+    const Entry *eb = (const Entry *)b;
+    int order = strncmp(ea->token, eb->token, SEARCH_TOKEN_SIZE);
+    if (order != 0)
+        return order;
+    return (ea->id > eb->id) - (ea->id < eb->id);
+}
+
+int EARS_searchIndex::compareId(const void* a, const void* b)
+{
+    uint32_t ia = *(const uint32_t *)a;
+    uint32_t ib = *(const uint32_t *)b;
+    return (ia > ib) - (ia < ib);
+}
+
+/******************************************************************************
+ * Presence Filter
+ *****************************************************************************/
+
+/**
+ * @brief FNV-1a of a whole field, normalised as search terms are
+ * @details Split into the two hashes of double hashing; h2 is odd so the
+ *          probes can reach every bit
+ * @return false for a field with no letters or digits
+ */
+bool EARS_searchIndex::filterHash(const char* text, size_t length, uint32_t& h1, uint32_t& h2)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    size_t n = 0;
+    for (size_t i = 0; i < length && text[i] && n < SEARCH_FILTER_KEY_SIZE - 1; i++)
+    {
+        char c = text[i];
+        if (isalnum((unsigned char)c))
+        {
+            hash = (hash ^ (uint8_t)tolower((unsigned char)c)) * 1099511628211ULL;
+            n++;
+        }
+    }
+    h1 = (uint32_t)hash;
+    h2 = (uint32_t)(hash >> 32) | 1;
+    return n > 0;
+}
+
+/**
+ * @brief Set the bits of an equipment record's serial and NSN
+ */
+void EARS_searchIndex::filterAdd(uint32_t* filter, uint32_t mask, const EARS_record& record)
+{
+    if (record.header.type != RECORD_EQUIPMENT || (record.header.flags & RECORD_FLAG_DELETED))
+    {
+        return;
+    }
+
+    const EARS_equipmentData *item = (const EARS_equipmentData *)record.payload;
+    const char *fields[SEARCH_FILTER_KEYS_PER_ITEM] = {item->serial, item->nsn};
+    const size_t sizes[SEARCH_FILTER_KEYS_PER_ITEM] = {sizeof(item->serial), sizeof(item->nsn)};
+
+    for (uint8_t f = 0; f < SEARCH_FILTER_KEYS_PER_ITEM; f++)
+    {
+        uint32_t h1, h2;
+        if (!filterHash(fields[f], sizes[f], h1, h2))
+        {
+            continue;
+        }
+        for (uint8_t k = 0; k < SEARCH_FILTER_HASHES; k++)
+        {
+            uint32_t bit = (h1 + k * h2) & mask;
+            filter[bit >> 5] |= 1UL << (bit & 31);
+        }
+    }
+}
+
+/**
+ * @brief Allocate an empty filter for the inventory size or the store's
+ *        count, whichever is larger, rounded up to a power of two bits
+ * @param mask Receives bits - 1
+ * @return uint32_t* Filter, nullptr if out of memory
+ */
+uint32_t* EARS_searchIndex::allocFilter(uint32_t& mask)
+{
+    uint32_t items = _store->count();
+    if (items < EARS_INVENTORY_ITEMS)
+    {
+        items = EARS_INVENTORY_ITEMS;
+    }
+
+    uint32_t wanted = items * SEARCH_FILTER_KEYS_PER_ITEM * SEARCH_FILTER_BITS_PER_KEY;
+    uint32_t bits = 1024;
+    while (bits < wanted)
+    {
+        bits *= 2;
+    }
+
+    uint32_t *filter = (uint32_t *)heap_caps_calloc(1, bits / 8, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!filter)
+    {
+        filter = (uint32_t *)heap_caps_calloc(1, bits / 8, MALLOC_CAP_8BIT);
+    }
+    mask = bits - 1;
+    return filter;
+}
+
+bool EARS_searchIndex::mayContain(const char* code)
+{
+    uint32_t h1, h2;
+    if (!code || !filterHash(code, strlen(code), h1, h2))
+    {
+        return false;
+    }
+    if (!_ready)
+    {
+        return true;
+    }
+
+    bool present = true;
+    lock();
+    if (_filter && !_stale)
+    {
+        for (uint8_t k = 0; k < SEARCH_FILTER_HASHES && present; k++)
+        {
+            uint32_t bit = (h1 + k * h2) & _filterMask;
+            present = (_filter[bit >> 5] >> (bit & 31)) & 1;
+        }
+        _filterChecks++;
+        if (!present)
+        {
+            _filterRejects++;
+        }
+    }
+    unlock();
+    return present;
+}
+
+/******************************************************************************
+ * Index Maintenance
+ *****************************************************************************/
+
+bool EARS_searchIndex::reserve(uint32_t entries)
+{
+    if (entries <= _capacity)
+    {
+        return true;
+    }
+
+    uint32_t capacity = _capacity ? _capacity : SEARCH_INDEX_INITIAL;
+    while (capacity < entries)
+    {
+        capacity *= 2;
+    }
+
+    Entry *grown = (Entry *)searchRealloc(_entries, capacity * sizeof(Entry));
+    if (!grown)
+    {
+        return false;
+    }
+    _entries = grown;
+    _capacity = capacity;
+    return true;
+}
+
+// First entry whose token is not below the prefix
+uint32_t EARS_searchIndex::lowerBound(const char* token, size_t length) const
+{
+    uint32_t lo = 0, hi = _count;
+    while (lo < hi)
+    {
+        uint32_t mid = (lo + hi) / 2;
+        if (strncmp(_entries[mid].token, token, length) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// First entry whose token is above every token starting with the prefix
+uint32_t EARS_searchIndex::upperBound(const char* token, size_t length) const
+{
+    uint32_t lo = 0, hi = _count;
+    while (lo < hi)
+    {
+        uint32_t mid = (lo + hi) / 2;
+        if (strncmp(_entries[mid].token, token, length) <= 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief Replace one item's tokens: drop the old ones, merge in the new
+ * @details One pass each, so an update costs O(entries) moves rather than
+ *          a memmove per token
+ */
+void EARS_searchIndex::update(const EARS_record& record, bool existed)
+{
+    uint32_t id = record.header.id;
+
+    if (existed)
+    {
+        uint32_t out = 0;
+        for (uint32_t i = 0; i < _count; i++)
+        {
+            if (_entries[i].id != id)
+            {
+                _entries[out++] = _entries[i];
+            }
+        }
+        _count = out;
+    }
+
+    Entry tokens[SEARCH_TOKENS_PER_RECORD];
+    uint8_t added = tokenise(record, tokens);
+
+    if (added > 0 && reserve(_count + added))
+    {
+        int32_t i = (int32_t)_count - 1;
+        int32_t j = added - 1;
+        uint32_t k = _count + added;
+        while (j >= 0)
+        {
+            if (i >= 0 && compareEntry(&_entries[i], &tokens[j]) > 0)
+                _entries[--k] = _entries[i--];
+            else
+                _entries[--k] = tokens[j--];
+        }
+        _count += added;
+    }
+
+    // Bits stay set when an item is removed or changes serial
+    if (_filter)
+    {
+        filterAdd(_filter, _filterMask, record);
+    }
+
+    _sequence = record.header.sequence;
+    _dirty = true;
+    _lastChangeMs = millis();
+}
+
+void EARS_searchIndex::onRecord(const EARS_record* record, bool existed, void* ctx)
+{
+    EARS_searchIndex *index = (EARS_searchIndex *)ctx;
+    index->lock();
+    if (record)
+    {
+        index->update(*record, existed);
+    }
+    else
+    {
+        // Rebuilding here would read the store while it is locked
+        index->_stale = true;
+        index->_lastChangeMs = millis();
+    }
+    index->unlock();
+}
+
+/******************************************************************************
+ * Segment Checkpoint and Rebuild
+ *****************************************************************************/
+
+/**
+ * @brief Load the checkpoint if it reflects the store's current sequence
+ * @return true if loaded
+ */
+bool EARS_searchIndex::loadSegment()
+{
+    File file = _sdCard->openRead(_path);
+    if (!file)
+    {
+        return false;
+    }
+
+    // Encrypted: the image's IV comes first, in clear
+    EARS_sdCrypt *crypt = _store->getCrypt();
+    uint8_t iv[SDCRYPT_IV_BYTES];
+    size_t ivBytes = crypt ? sizeof(iv) : 0;
+    SegmentHeader header;
+    bool ok = file.read(iv, ivBytes) == ivBytes &&
+              file.read((uint8_t *)&header, sizeof(header)) == sizeof(header) &&
+              (!crypt || crypt->unsealImage(_path, iv, 0, (uint8_t *)&header, sizeof(header))) &&
+              header.magic == SEARCH_SEGMENT_MAGIC &&
+              header.layout == SEARCH_SEGMENT_LAYOUT &&
+              header.sequence == _store->getSequence() &&
+              file.size() == ivBytes + sizeof(header) + header.count * sizeof(Entry) &&
+              reserve(header.count);
+
+    if (ok)
+    {
+        size_t bytes = header.count * sizeof(Entry);
+        ok = file.read((uint8_t *)_entries, bytes) == bytes &&
+             (!crypt || crypt->unsealImage(_path, iv, sizeof(header), (uint8_t *)_entries, bytes)) &&
+             esp_rom_crc32_le(0, (const uint8_t *)_entries, bytes) == header.crc;
+    }
+    file.close();
+
+    if (!ok)
+    {
+        return false;
+    }
+
+    _count = header.count;
+    _sequence = header.sequence;
+    return true;
+}
+
+/**
+ * @brief Tokenise every item in the store into a new array, sort it once
+ *        and swap it in, with a new presence filter built in the same pass
+ * @details Built without holding the lock (reading the store while holding
+ *          it could deadlock against a writer calling onRecord()). If the
+ *          store was written meanwhile the result is dropped and the index
+ *          stays stale for the next service().
+ * @return true if the new array was swapped in
+ */
+bool EARS_searchIndex::rebuild()
+{
+    EARS_record *chunk = (EARS_record *)malloc(sizeof(EARS_record) * RECORD_SCAN_RECORDS);
+    if (!chunk)
+    {
+        return false;
+    }
+
+    uint32_t sequence = _store->getSequence();
+    uint32_t capacity = _capacity ? _capacity : SEARCH_INDEX_INITIAL;
+    Entry *entries = (Entry *)searchRealloc(nullptr, capacity * sizeof(Entry));
+    uint32_t count = 0;
+    uint32_t filterMask = 0;
+    uint32_t *filter = allocFilter(filterMask);
+
+    bool ok = entries != nullptr;
+    uint32_t position = 0;
+    size_t got;
+    while (ok && (got = _store->readPage(position, chunk, RECORD_SCAN_RECORDS)) > 0)
+    {
+        for (size_t r = 0; r < got && ok; r++)
+        {
+            Entry tokens[SEARCH_TOKENS_PER_RECORD];
+            uint8_t added = tokenise(chunk[r], tokens);
+            if (filter)
+            {
+                filterAdd(filter, filterMask, chunk[r]);
+            }
+            if (count + added > capacity)
+            {
+                Entry *grown = (Entry *)searchRealloc(entries, capacity * 2 * sizeof(Entry));
+                ok = grown != nullptr;
+                if (ok)
+                {
+                    entries = grown;
+                    capacity *= 2;
+                }
+            }
+            if (ok)
+            {
+                memcpy(&entries[count], tokens, added * sizeof(Entry));
+                count += added;
+            }
+        }
+        position += got;
+    }
+    free(chunk);
+
+    if (ok)
+    {
+        qsort(entries, count, sizeof(Entry), compareEntry);
+    }
+
+    lock();
+    ok = ok && _store->getSequence() == sequence;
+    if (ok)
+    {
+        Entry *old = _entries;
+        _entries = entries;
+        _capacity = capacity;
+        _count = count;
+        _sequence = sequence;
+        _stale = false;
+        _dirty = true;
+        _lastChangeMs = millis();
+        entries = old;
+
+        // Without memory for a new one the old filter would miss the import
+        uint32_t *oldFilter = _filter;
+        _filter = filter;
+        _filterMask = filterMask;
+        filter = oldFilter;
+    }
+    unlock();
+
+    if (entries)
+    {
+        heap_caps_free(entries);
+    }
+    if (filter)
+    {
+        heap_caps_free(filter);
+    }
+    return ok;
+}
+
+/**
+ * @brief Build the presence filter alone, after the tokens came from the
+ *        segment
+ * @details Read outside the lock as rebuild() does, and dropped if the
+ *          store was written meanwhile (those keys would be missing)
+ * @return true if the filter was swapped in
+ */
+bool EARS_searchIndex::buildFilter()
+{
+    uint32_t mask = 0;
+    uint32_t *filter = allocFilter(mask);
+    if (!filter)
+    {
+        return false;
+    }
+
+    EARS_record *chunk = (EARS_record *)malloc(sizeof(EARS_record) * RECORD_SCAN_RECORDS);
+    if (!chunk)
+    {
+        heap_caps_free(filter);
+        return false;
+    }
+
+    uint32_t sequence = _store->getSequence();
+    uint32_t position = 0;
+    size_t got;
+    while ((got = _store->readPage(position, chunk, RECORD_SCAN_RECORDS)) > 0)
+    {
+        for (size_t r = 0; r < got; r++)
+        {
+            filterAdd(filter, mask, chunk[r]);
+        }
+        position += got;
+    }
+    free(chunk);
+
+    lock();
+    bool ok = _store->getSequence() == sequence && !_filter;
+    if (ok)
+    {
+        _filter = filter;
+        _filterMask = mask;
+        filter = nullptr;
+    }
+    unlock();
+
+    if (filter)
+    {
+        heap_caps_free(filter);
+    }
+
+#if EARS_DEBUG == 1
+    if (ok)
+    {
+        Serial.printf("[SEARCH] %s: presence filter %lu bytes\n", _path, (unsigned long)((mask + 1) / 8));
+    }
+#endif
+
+    return ok;
+}
+
+bool EARS_searchIndex::checkpoint()
+{
+    if (!_ready)
+    {
+        return false;
+    }
+
+    lock();
+    if (!_dirty)
+    {
+        unlock();
+        return true;
+    }
+
+    // Encrypted: room for the IV sealImage() puts in front
+    EARS_sdCrypt *crypt = _store->getCrypt();
+    size_t ivBytes = crypt ? SDCRYPT_IV_BYTES : 0;
+    size_t entries = _count * sizeof(Entry);
+    size_t total = ivBytes + sizeof(SegmentHeader) + entries;
+    uint8_t *image = (uint8_t *)searchRealloc(nullptr, total);
+    if (!image)
+    {
+        unlock();
+        return false;
+    }
+
+    SegmentHeader *header = (SegmentHeader *)(image + ivBytes);
+    header->magic = SEARCH_SEGMENT_MAGIC;
+    header->layout = SEARCH_SEGMENT_LAYOUT;
+    header->sequence = _sequence;
+    header->count = _count;
+    header->crc = esp_rom_crc32_le(0, (const uint8_t *)_entries, entries);
+    memcpy(image + ivBytes + sizeof(SegmentHeader), _entries, entries);
+    uint32_t written = _sequence;
+    unlock();
+
+    // Written outside the lock: updates during the write just leave it dirty
+    bool ok = (!crypt || crypt->sealImage(_path, image, total)) && _sdCard->writeFileAtomic(_path, image, total);
+    heap_caps_free(image);
+
+    lock();
+    if (ok && _sequence == written)
+    {
+        _dirty = false;
+    }
+    unlock();
+    return ok;
+}
+
+void EARS_searchIndex::service()
+{
+    if (!_ready)
+    {
+        return;
+    }
+
+    if (_stale)
+    {
+        if (millis() - _lastChangeMs >= SEARCH_REBUILD_DELAY_MS)
+        {
+            rebuild();
+        }
+        return;
+    }
+
+    // Segment loaded at begin(): the filter is built here, off the boot path
+    if (!_filter)
+    {
+        buildFilter();
+    }
+
+    if (!_dirty)
+    {
+        return;
+    }
+
+    if (millis() - _lastChangeMs < SEARCH_CHECKPOINT_DELAY_MS)
+    {
+        return;
+    }
+
+    checkpoint();
+}
+
+/******************************************************************************
+ * Queries
+ *****************************************************************************/
+
+uint32_t EARS_searchIndex::search(const char* query, EARS_searchResultCb callback, void* ctx, uint32_t max)
+{
+    if (!_ready || !query || !callback || max == 0)
+    {
+        return 0;
+    }
+
+    int64_t startUs = esp_timer_get_time();
+
+    // Terms as they are stored: separators split, punctuation dropped
+    char terms[SEARCH_MAX_TERMS][SEARCH_TOKEN_SIZE];
+    size_t lengths[SEARCH_MAX_TERMS];
+    uint8_t termCount = 0;
+    const char *p = query;
+    while (*p && termCount < SEARCH_MAX_TERMS)
+    {
+        while (*p && isSeparator(*p))
+        {
+            p++;
+        }
+        const char *start = p;
+        while (*p && !isSeparator(*p))
+        {
+            p++;
+        }
+        lengths[termCount] = normaliseTerm(start, p - start, terms[termCount]);
+        if (lengths[termCount] > 0)
+        {
+            termCount++;
+        }
+    }
+    if (termCount == 0)
+    {
+        return 0;
+    }
+
+    lock();
+
+    // Start from the narrowest term, then keep candidates every other term has
+    uint32_t lo[SEARCH_MAX_TERMS], hi[SEARCH_MAX_TERMS];
+    uint8_t narrowest = 0;
+    for (uint8_t t = 0; t < termCount; t++)
+    {
+        lo[t] = lowerBound(terms[t], lengths[t]);
+        hi[t] = upperBound(terms[t], lengths[t]);
+        if (hi[t] - lo[t] < hi[narrowest] - lo[narrowest])
+        {
+            narrowest = t;
+        }
+    }
+
+    uint32_t candidates = hi[narrowest] - lo[narrowest];
+    uint32_t *ids = candidates ? (uint32_t *)searchRealloc(nullptr, candidates * sizeof(uint32_t)) : nullptr;
+    if (!ids)
+    {
+        unlock();
+        _lastQueryUs = (uint32_t)(esp_timer_get_time() - startUs);
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < candidates; i++)
+    {
+        ids[i] = _entries[lo[narrowest] + i].id;
+    }
+    qsort(ids, candidates, sizeof(uint32_t), compareId);
+
+    uint32_t unique = 0;
+    for (uint32_t i = 0; i < candidates; i++)
+    {
+        if (unique == 0 || ids[unique - 1] != ids[i])
+        {
+            ids[unique++] = ids[i];
+        }
+    }
+    candidates = unique;
+
+    uint8_t *hits = (termCount > 1) ? (uint8_t *)searchRealloc(nullptr, candidates) : nullptr;
+    for (uint8_t t = 0; t < termCount && candidates > 0; t++)
+    {
+        if (t == narrowest)
+        {
+            continue;
+        }
+        if (!hits)
+        {
+            candidates = 0;
+            break;
+        }
+
+        memset(hits, 0, candidates);
+        for (uint32_t e = lo[t]; e < hi[t]; e++)
+        {
+            uint32_t *found = (uint32_t *)bsearch(&_entries[e].id, ids, candidates, sizeof(uint32_t), compareId);
+            if (found)
+            {
+                hits[found - ids] = 1;
+            }
+        }
+
+        uint32_t kept = 0;
+        for (uint32_t i = 0; i < candidates; i++)
+        {
+            if (hits[i])
+            {
+                ids[kept++] = ids[i];
+            }
+        }
+        candidates = kept;
+    }
+    if (hits)
+    {
+        heap_caps_free(hits);
+    }
+    unlock();
+
+    _lastQueryUs = (uint32_t)(esp_timer_get_time() - startUs);
+
+    // Deliver outside the lock so a slow consumer cannot hold up writes
+    uint32_t delivered = 0;
+    if (candidates > max)
+    {
+        candidates = max;
+    }
+    while (delivered < candidates)
+    {
+        uint32_t left = candidates - delivered;
+        uint16_t batch = (uint16_t)(left < SEARCH_RESULT_BATCH ? left : SEARCH_RESULT_BATCH);
+        bool more = callback(&ids[delivered], batch, ctx);
+        delivered += batch;
+        if (!more)
+        {
+            break;
+        }
+    }
+
+    heap_caps_free(ids);
+    return delivered;
+}
+
+/******************************************************************************
+ * Locking
+ *****************************************************************************/
+void EARS_searchIndex::lock()
+{
+    if (_mutex)
+    {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+    }
+}
+
+void EARS_searchIndex::unlock()
+{
+    if (_mutex)
+    {
+        xSemaphoreGive(_mutex);
+    }
+}
+
+/******************************************************************************
+ * Version Information
+ *****************************************************************************/
+const char* EARS_searchIndex::getLibraryName()
+{
+    return EARS_SearchIndex::LIB_NAME;
+}
+
+uint32_t EARS_searchIndex::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_SearchIndex::VERSION_MAJOR,
+                       EARS_SearchIndex::VERSION_MINOR,
+                       EARS_SearchIndex::VERSION_PATCH);
+}
+
+const char* EARS_searchIndex::getVersionDate()
+{
+    return EARS_SearchIndex::VERSION_DATE;
+}
+
+void EARS_searchIndex::getVersionString(char* buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+EARS_searchIndex &using_equipment_search()
+{
+    static EARS_searchIndex instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_searchIndexLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,228 @@
+/**
+ * @file EARS_searchIndexLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Prefix search index over equipment records
+ * @details Every equipment record is cut into tokens: each word of the name
+ *          and category, plus the serial number and NSN with their
+ *          punctuation removed, all lower case and cut to
+ *          SEARCH_TOKEN_SIZE - 1 characters. The index is one sorted array
+ *          of (token, item ID) in PSRAM, so a query term is matched as a
+ *          prefix by two binary searches; "m4 carb" finds items having a
+ *          token starting "m4" and one starting "carb", and "1005-01"
+ *          matches NSN 1005-01-231-0973.
+ *
+ *          The index follows the store through EARS_recordStore's listener:
+ *          each committed put or remove replaces that item's tokens in one
+ *          merge pass. A bulk putMany() only marks the index stale;
+ *          service() rebuilds it once the import has been quiet for
+ *          SEARCH_REBUILD_DELAY_MS, and queries meanwhile miss the new
+ *          items. A segment file next to the store (<name>.six) holds
+ *          a checkpoint stamped with the store's write sequence; begin()
+ *          loads it when the stamp matches and rebuilds from the store
+ *          otherwise. When the store is encrypted the segment is too
+ *          (<name>.esix, sealed under a new IV by the store's EARS_sdCrypt
+ *          at each checkpoint), and a plaintext .six left from before is
+ *          removed.
+ *
+ *          A scanned serial number or NSN is usually a new item, and each
+ *          search candidate costs a record read to compare. mayContain()
+ *          answers "no item has this" from a Bloom filter over every
+ *          item's whole serial and NSN, sized for EARS_INVENTORY_ITEMS
+ *          (or the store's count, if larger) at SEARCH_FILTER_BITS_PER_KEY
+ *          bits a key, about 1% false positives. It is built with a full
+ *          rebuild, or by service() after a segment load, gains the keys
+ *          of each put, and keeps those of removed items (a false positive
+ *          until the next rebuild). Until it is built, or while the index
+ *          is stale, every code may be present.
+ *
+ * @version 1.3.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_SEARCH_INDEX_LIB_H__
+#define __EARS_SEARCH_INDEX_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "EARS_versionDef.h"
+#include "EARS_sdCardLib.h"
+#include "EARS_recordStoreLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_SearchIndex
+{
+    constexpr const char* LIB_NAME = "EARS_searchIndex";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "3";
+    constexpr const char* VERSION_PATCH = "1";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+#define SEARCH_TOKEN_SIZE 16            // 15 characters + NUL (a whole NSN)
+#define SEARCH_TOKENS_PER_RECORD 16     // Distinct tokens kept per item
+#define SEARCH_MAX_TERMS 4              // Query terms used, the rest ignored
+#define SEARCH_RESULT_BATCH 16          // IDs per callback
+#define SEARCH_INDEX_INITIAL 1024       // Entries allocated at begin(), doubles as needed
+#define SEARCH_CHECKPOINT_DELAY_MS 5000 // Quiet time before service() writes the segment
+#define SEARCH_REBUILD_DELAY_MS 1000    // Quiet time after a bulk import before service() rebuilds
+#define SEARCH_SEGMENT_SUFFIX ".six"
+#define SEARCH_SEGMENT_CRYPT_SUFFIX ".esix" // Store encrypted
+
+// Items the serial/NSN presence filter is sized for
+#ifndef EARS_INVENTORY_ITEMS
+#define EARS_INVENTORY_ITEMS 5000
+#endif
+
+#define SEARCH_FILTER_KEYS_PER_ITEM 2   // Serial and NSN
+#define SEARCH_FILTER_BITS_PER_KEY 10   // With 7 hashes, about 1% false positives
+#define SEARCH_FILTER_HASHES 7
+#define SEARCH_FILTER_KEY_SIZE 32       // A whole serial or NSN, normalised, + NUL
+
+/**
+ * @brief Receives matching item IDs in ascending order
+ * @param ids IDs in this batch
+ * @param count IDs in this batch (1..SEARCH_RESULT_BATCH)
+ * @param ctx Context given to search()
+ * @return false to stop the search
+ */
+typedef bool (*EARS_searchResultCb)(const uint32_t* ids, uint16_t count, void* ctx);
+
+/******************************************************************************
+ * EARS_searchIndex Class
+ *****************************************************************************/
+class EARS_searchIndex
+{
+public:
+    EARS_searchIndex();
+
+    // Version information getters
+    static const char* getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char* getVersionDate();
+    static void getVersionString(char* buffer);
+
+    /**
+     * @brief Load or rebuild the index and start following the store
+     * @details Call after store->begin() and before anything writes to it
+     * @param sdCard Mounted SD card
+     * @param store Equipment store (must be ready)
+     * @param name File name stem under RECORD_STORE_DIR
+     * @return true if the index is usable
+     */
+    bool begin(EARS_sdCard* sdCard, EARS_recordStore* store, const char* name);
+
+    bool isReady() const { return _ready; }
+
+    /**
+     * @brief Find items matching every term of a query as a prefix
+     * @param query Terms separated by spaces, any case and punctuation
+     * @param callback Receives the IDs in batches
+     * @param ctx Passed to callback
+     * @param max Most IDs to return
+     * @return uint32_t IDs passed to callback
+     */
+    uint32_t search(const char* query, EARS_searchResultCb callback, void* ctx, uint32_t max);
+
+    /**
+     * @brief Check whether an item may have this serial number or NSN
+     * @details Compared whole, case and punctuation ignored, from RAM
+     * @param code Scanned text
+     * @return false if no item has it; true if one may (or the filter is
+     *         not built)
+     */
+    bool mayContain(const char* code);
+
+    /**
+     * @brief Write the segment checkpoint now
+     * @return true if nothing was pending or the write succeeded
+     */
+    bool checkpoint();
+
+    /**
+     * @brief Rebuild after a bulk import, checkpoint once updates have
+     *        been quiet long enough
+     * @details Call periodically from Core 1
+     */
+    void service();
+
+    uint32_t getEntryCount() const { return _count; }
+    uint32_t getOpenTimeUs() const { return _openUs; }
+    bool wasRebuilt() const { return _rebuilt; }
+    bool isStale() const { return _stale; }
+    uint32_t getLastQueryUs() const { return _lastQueryUs; }
+    bool isFilterReady() const { return _filter != nullptr && !_stale; }
+    uint32_t getFilterBytes() const { return _filter ? (_filterMask + 1) / 8 : 0; }
+    uint32_t getFilterChecks() const { return _filterChecks; }
+    uint32_t getFilterRejects() const { return _filterRejects; } // Answered "no" without a search
+
+private:
+    struct Entry
+    {
+        char token[SEARCH_TOKEN_SIZE];
+        uint32_t id;
+    };
+
+    EARS_sdCard* _sdCard;
+    EARS_recordStore* _store;
+    char _path[40];
+    SemaphoreHandle_t _mutex;
+    bool _ready;
+
+    Entry* _entries;
+    uint32_t _count;
+    uint32_t _capacity;
+    uint32_t _sequence;          // Store sequence the entries reflect
+
+    bool _dirty;
+    bool _stale;                 // Store changed in bulk, rebuild pending
+    uint32_t _lastChangeMs;
+    bool _rebuilt;
+    uint32_t _openUs;
+    uint32_t _lastQueryUs;
+
+    uint32_t* _filter;           // Bloom filter over whole serials and NSNs
+    uint32_t _filterMask;        // Bits - 1, a power of two
+    uint32_t _filterChecks;
+    uint32_t _filterRejects;
+
+    bool reserve(uint32_t entries);
+    bool loadSegment();
+    bool rebuild();
+    bool buildFilter();
+    uint32_t* allocFilter(uint32_t& mask);
+    static void filterAdd(uint32_t* filter, uint32_t mask, const EARS_record& record);
+    static bool filterHash(const char* text, size_t length, uint32_t& h1, uint32_t& h2);
+    void update(const EARS_record& record, bool existed);
+    uint32_t lowerBound(const char* token, size_t length) const;
+    uint32_t upperBound(const char* token, size_t length) const;
+    static uint8_t tokenise(const EARS_record& record, Entry* out);
+    static uint8_t addTokens(const char* text, size_t length, bool words, Entry* out, uint8_t count);
+    static size_t normaliseTerm(const char* text, size_t length, char* out);
+    static int compareEntry(const void* a, const void* b);
+    static int compareId(const void* a, const void* b);
+    static void onRecord(const EARS_record* record, bool existed, void* ctx);
+
+    void lock();
+    void unlock();
+};
+
+// Global instance access function (Singleton pattern)
+EARS_searchIndex &using_equipment_search();
+
+#endif // __EARS_SEARCH_INDEX_LIB_H__
+
+/******************************************************************************
+ * End of EARS_searchIndexLib.h
+ ******************************************************************************/
@@ -0,0 +1,583 @@
+/**
+ * @file EARS_syncLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Delta sync of the record stores to a server over Wi-Fi
+ * @version 1.1.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EARS_syncLib.h"
+#include "EARS_systemDef.h"
+#include <esp_heap_caps.h>
+#include <esp_rom_crc.h>
+
+/******************************************************************************
+ * File Format
+ *****************************************************************************/
+#define SYNC_WATERMARK_MAGIC 0x4E595345 // "ESYN"
+
+// <name>.sync: the acknowledged watermark of one store
+struct WatermarkFile
+{
+    uint32_t magic;
+    uint32_t watermark;    // First record number the server does not hold
+    uint32_t sequence;     // Store sequence when saved
+    uint32_t crc;          // CRC-32 of the fields above
+};
+
+/******************************************************************************
+ * CBOR Encoding
+ *****************************************************************************/
+#define CBOR_UINT 0
+#define CBOR_TEXT 3
+#define CBOR_ARRAY 4
+#define CBOR_MAP 5
+
+// Major type and argument, in the shortest form
+static uint8_t *cborHead(uint8_t *out, uint8_t major, uint32_t value)
+{
+    major <<= 5;
+    if (value < 24)
+    {
+        *out++ = major | value;
+    }
+    else if (value <= 0xFF)
+    {
+        *out++ = major | 24;
+        *out++ = value;
+    }
+    else if (value <= 0xFFFF)
+    {
+        *out++ = major | 25;
+        *out++ = value >> 8;
+        *out++ = value;
+    }
+    else
+    {
+        *out++ = major | 26;
+        *out++ = value >> 24;
+        *out++ = value >> 16;
+        *out++ = value >> 8;
+        *out++ = value;
+    }
+    return out;
+}
+
+// Text from a fixed-size field, without its padding
+static uint8_t *cborText(uint8_t *out, const char *text, size_t size)
+{
+    size_t length = strnlen(text, size);
+    out = cborHead(out, CBOR_TEXT, length);
+    memcpy(out, text, length);
+    return out + length;
+}
+
+#define CBOR_FIELD(out, field) cborText(out, field, sizeof(field))
+#define CBOR_KEY(out, key) cborText(out, key, sizeof(key) - 1)
+
+// One record as the array described in EARS_syncLib.h
+static uint8_t *encodeRecord(uint8_t *out, const EARS_record &record)
+{
+    const EARS_recordHeader &header = record.header;
+    bool deleted = header.flags & RECORD_FLAG_DELETED;
+
+    if (deleted)
+    {
+        out = cborHead(out, CBOR_ARRAY, 3);
+    }
+    else if (header.type == RECORD_AMMUNITION)
+    {
+        out = cborHead(out, CBOR_ARRAY, 10);
+    }
+    else
+    {
+        out = cborHead(out, CBOR_ARRAY, 12);
+    }
+    out = cborHead(out, CBOR_UINT, header.id);
+    out = cborHead(out, CBOR_UINT, header.sequence);
+    out = cborHead(out, CBOR_UINT, header.flags);
+    if (deleted)
+    {
+        return out;
+    }
+
+    out = CBOR_FIELD(out, header.zap);
+    if (header.type == RECORD_AMMUNITION)
+    {
+        const EARS_ammunitionData *data = (const EARS_ammunitionData *)record.payload;
+        out = CBOR_FIELD(out, data->calibre);
+        out = CBOR_FIELD(out, data->lot);
+        out = CBOR_FIELD(out, data->description);
+        out = cborHead(out, CBOR_UINT, data->quantity);
+        out = cborHead(out, CBOR_UINT, data->expiryDate);
+        out = cborHead(out, CBOR_UINT, data->receivedDate);
+    }
+    else
+    {
+        const EARS_equipmentData *data = (const EARS_equipmentData *)record.payload;
+        out = CBOR_FIELD(out, data->name);
+        out = CBOR_FIELD(out, data->serial);
+        out = CBOR_FIELD(out, data->nsn);
+        out = CBOR_FIELD(out, data->category);
+        out = cborHead(out, CBOR_UINT, data->quantity);
+        out = cborHead(out, CBOR_UINT, data->status);
+        out = cborHead(out, CBOR_UINT, data->inspectedDate);
+        out = cborHead(out, CBOR_UINT, data->issuedDate);
+    }
+    return out;
+}
+
+/******************************************************************************
+ * Helpers
+ *****************************************************************************/
+
+// Batch buffers: PSRAM when there is any
+static void *syncAlloc(size_t size)
+{
+    void *block = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    return block ? block : heap_caps_malloc(size, MALLOC_CAP_8BIT);
+}
+
+/******************************************************************************
+ * Construction
+ *****************************************************************************/
+EARS_sync::EARS_sync()
+    : _sdCard(nullptr),
+      _slotCount(0),
+      _task(nullptr),
+      _records(nullptr),
+      _buffer(nullptr)
+{
+    memset(_slots, 0, sizeof(_slots));
+    memset(&_stats, 0, sizeof(_stats));
+    _mux = portMUX_INITIALIZER_UNLOCKED;
+}
+
+bool EARS_sync::addStore(EARS_recordStore* store, const char* name)
+{
+    if (_task || !store || !name || _slotCount >= SYNC_MAX_STORES ||
+        strlen(name) >= sizeof(_slots[0].name))
+    {
+        return false;
+    }
+
+    Slot &slot = _slots[_slotCount++];
+    slot.store = store;
+    strncpy(slot.name, name, sizeof(slot.name));
+    snprintf(slot.path, sizeof(slot.path), "%s/%s%s", RECORD_STORE_DIR, name, SYNC_WATERMARK_SUFFIX);
+    slot.watermark = 0;
+    return true;
+}
+
+bool EARS_sync::begin(EARS_sdCard* sdCard)
+{
+    if (_task)
+    {
+        return true;
+    }
+    if (!sdCard || !sdCard->isAvailable() || _slotCount == 0)
+    {
+        return false;
+    }
+    _sdCard = sdCard;
+
+    _records = (EARS_record *)syncAlloc(sizeof(EARS_record) * SYNC_BATCH_RECORDS);
+    _buffer = (uint8_t *)syncAlloc(SYNC_BATCH_BYTES);
+    if (!_records || !_buffer)
+    {
+        heap_caps_free(_records);
+        heap_caps_free(_buffer);
+        _records = nullptr;
+        _buffer = nullptr;
+        return false;
+    }
+
+    for (uint8_t i = 0; i < _slotCount; i++)
+    {
+        loadWatermark(_slots[i]);
+    }
+
+    _http.setReuse(true);
+    _http.setTimeout(SYNC_HTTP_TIMEOUT_MS);
+
+    if (xTaskCreatePinnedToCore(taskFunction, "Sync", SYNC_TASK_STACK_SIZE, this, SYNC_TASK_PRIORITY, &_task,
+                                SYNC_TASK_CORE) != pdPASS)
+    {
+        _task = nullptr;
+#if EARS_DEBUG == 1
+        Serial.println("[SYNC] ERROR: Failed to create sync task");
+#endif
+        return false;
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[SYNC] %u stores, %lu records pending\n", _slotCount, (unsigned long)getPending());
+#endif
+    return true;
+}
+
+/******************************************************************************
+ * Control
+ *****************************************************************************/
+void EARS_sync::requestSync()
+{
+    if (_task)
+    {
+        xTaskNotifyGive(_task);
+    }
+}
+
+uint32_t EARS_sync::getPending() const
+{
+    uint32_t pending = 0;
+    for (uint8_t i = 0; i < _slotCount; i++)
+    {
+        uint32_t records = _slots[i].store->getRecordCount();
+        if (records > _slots[i].watermark)
+        {
+            pending += records - _slots[i].watermark;
+        }
+    }
+    return pending;
+}
+
+bool EARS_sync::hasPending() const
+{
+    for (uint8_t i = 0; i < _slotCount; i++)
+    {
+        if (_slots[i].store->getRecordCount() != _slots[i].watermark)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+EARS_syncStats EARS_sync::getStats() const
+{
+    portENTER_CRITICAL(&_mux);
+    EARS_syncStats stats = _stats;
+    portEXIT_CRITICAL(&_mux);
+    return stats;
+}
+
+void EARS_sync::setState(EARS_syncState state)
+{
+    portENTER_CRITICAL(&_mux);
+    _stats.state = state;
+    portEXIT_CRITICAL(&_mux);
+}
+
+/******************************************************************************
+ * Watermarks
+ *****************************************************************************/
+
+/**
+ * @brief Read a store's watermark, starting over if it does not fit the store
+ * @details A store recreated since (fewer records, or an older sequence)
+ *          is sent again in full
+ */
+bool EARS_sync::loadWatermark(Slot& slot)
+{
+    WatermarkFile file;
+    slot.watermark = 0;
+    if (_sdCard->readInto(slot.path, (uint8_t *)&file, sizeof(file)) != sizeof(file) ||
+        file.magic != SYNC_WATERMARK_MAGIC ||
+        file.crc != esp_rom_crc32_le(0, (const uint8_t *)&file, offsetof(WatermarkFile, crc)))
+    {
+        return false;
+    }
+    if (file.watermark > slot.store->getRecordCount() || file.sequence > slot.store->getSequence())
+    {
+#if EARS_DEBUG == 1
+        Serial.printf("[SYNC] %s: store replaced, full upload\n", slot.name);
+#endif
+        return false;
+    }
+
+    slot.watermark = file.watermark;
+    return true;
+}
+
+bool EARS_sync::saveWatermark(const Slot& slot)
+{
+    WatermarkFile file;
+    file.magic = SYNC_WATERMARK_MAGIC;
+    file.watermark = slot.watermark;
+    file.sequence = slot.store->getSequence();
+    file.crc = esp_rom_crc32_le(0, (const uint8_t *)&file, offsetof(WatermarkFile, crc));
+    return _sdCard->writeFileAtomic(slot.path, (const uint8_t *)&file, sizeof(file));
+}
+
+/******************************************************************************
+ * Upload
+ *****************************************************************************/
+size_t EARS_sync::encodeBatch(const Slot& slot, const char* device, uint32_t from, uint32_t to, size_t count)
+{
+    uint8_t *out = _buffer;
+    out = cborHead(out, CBOR_MAP, 5);
+    out = CBOR_KEY(out, "device");
+    out = cborText(out, device, sizeof(EARS_configSystem::deviceName));
+    out = CBOR_KEY(out, "store");
+    out = CBOR_FIELD(out, slot.name);
+    out = CBOR_KEY(out, "from");
+    out = cborHead(out, CBOR_UINT, from);
+    out = CBOR_KEY(out, "to");
+    out = cborHead(out, CBOR_UINT, to);
+    out = CBOR_KEY(out, "records");
+    out = cborHead(out, CBOR_ARRAY, count);
+    for (size_t i = 0; i < count; i++)
+    {
+        out = encodeRecord(out, _records[i]);
+    }
+    return out - _buffer;
+}
+
+/**
+ * @brief Upload a store's changes batch by batch until none are left
+ * @return true if the server holds everything written so far
+ */
+bool EARS_sync::syncStore(Slot& slot, const char* url, const char* device)
+{
+    bool rewound = false;
+
+    while (true)
+    {
+        uint32_t from = slot.watermark;
+        uint32_t to;
+        size_t count = slot.store->readChanges(from, _records, SYNC_BATCH_RECORDS, to);
+        if (to == from)
+        {
+            return true;
+        }
+
+        // Sent even when every version in the range was superseded, so the
+        // server's watermark moves past it too
+        size_t length = encodeBatch(slot, device, from, to, count);
+
+        _http.begin(_client, url);
+        _http.addHeader("Content-Type", "application/cbor");
+        int code = _http.POST(_buffer, length);
+        uint32_t acked = to;
+        if (code == HTTP_CODE_OK)
+        {
+            // The server's watermark; a body that is not a number acknowledges all
+            String body = _http.getString();
+            char *end;
+            uint32_t value = strtoul(body.c_str(), &end, 10);
+            if (end != body.c_str() && *end == '\0')
+            {
+                acked = value < to ? value : to;
+            }
+        }
+        _http.end();
+
+        portENTER_CRITICAL(&_mux);
+        _stats.lastHttpCode = code;
+        portEXIT_CRITICAL(&_mux);
+
+        if (code != HTTP_CODE_OK)
+        {
+#if EARS_DEBUG == 1
+            Serial.printf("[SYNC] %s: batch %lu-%lu failed (%d)\n", slot.name, (unsigned long)from,
+                          (unsigned long)to, code);
+#endif
+            return false;
+        }
+
+        if (acked <= from)
+        {
+            // Nothing taken (or the server lost data): wind back once per sync
+            if (rewound || (acked == from && count > 0))
+            {
+                return false;
+            }
+            rewound = true;
+            portENTER_CRITICAL(&_mux);
+            _stats.rewinds++;
+            portEXIT_CRITICAL(&_mux);
+        }
+
+        slot.watermark = acked;
+        saveWatermark(slot);
+
+        portENTER_CRITICAL(&_mux);
+        _stats.batches++;
+        _stats.records += count;
+        _stats.bytes += length;
+        portEXIT_CRITICAL(&_mux);
+    }
+}
+
+bool EARS_sync::connect(const EARS_configNetwork& network)
+{
+    if (WiFi.status() == WL_CONNECTED)
+    {
+        return true;
+    }
+
+    setState(SYNC_CONNECTING);
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(network.ssid, network.password[0] != '\0' ? network.password : nullptr);
+
+    uint32_t startMs = millis();
+    while (WiFi.status() != WL_CONNECTED)
+    {
+        if (millis() - startMs > SYNC_CONNECT_TIMEOUT_MS)
+        {
+#if EARS_DEBUG == 1
+            Serial.printf("[SYNC] Could not join \"%s\"\n", network.ssid);
+#endif
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(100));
+    }
+    return true;
+}
+
+// Radio off between manual syncs
+void EARS_sync::disconnect()
+{
+    _client.stop();
+    WiFi.disconnect(true);
+    WiFi.mode(WIFI_OFF);
+}
+
+bool EARS_sync::syncAll(const EARS_configNetwork& network, const char* device)
+{
+    bool ok = connect(network);
+    if (ok)
+    {
+        setState(SYNC_UPLOADING);
+
+        // "<sync_url>/<store>", whether or not the URL ends in '/'
+        size_t base = strnlen(network.syncUrl, sizeof(network.syncUrl));
+        if (base > 0 && network.syncUrl[base - 1] == '/')
+        {
+            base--;
+        }
+
+        for (uint8_t i = 0; ok && i < _slotCount; i++)
+        {
+            char url[sizeof(network.syncUrl) + sizeof(_slots[i].name) + 1];
+            snprintf(url, sizeof(url), "%.*s/%s", (int)base, network.syncUrl, _slots[i].name);
+            ok = syncStore(_slots[i], url, device);
+        }
+    }
+
+    portENTER_CRITICAL(&_mux);
+    if (ok)
+    {
+        _stats.syncs++;
+        _stats.lastSyncMs = millis();
+        _stats.state = SYNC_IDLE;
+    }
+    else
+    {
+        _stats.failures++;
+        _stats.state = SYNC_FAILED;
+    }
+    portEXIT_CRITICAL(&_mux);
+    return ok;
+}
+
+/******************************************************************************
+ * Task
+ *****************************************************************************/
+void EARS_sync::run()
+{
+    TickType_t wait = 0;      // First look straight away
+    bool retry = false;
+
+    while (true)
+    {
+        bool requested = ulTaskNotifyTake(pdTRUE, wait) > 0;
+
+        // Copied: Core 1 may replace the sections meanwhile
+        EARS_configNetwork network = using_config().network();
+        char device[sizeof(EARS_configSystem::deviceName)];
+        strncpy(device, using_config().system().deviceName, sizeof(device));
+
+        TickType_t interval = pdMS_TO_TICKS((network.syncIntervalMinutes ? network.syncIntervalMinutes : 1) * 60000UL);
+        wait = network.autoConnect ? interval : portMAX_DELAY;
+
+        if (!network.wifiEnabled || network.ssid[0] == '\0' || network.syncUrl[0] == '\0')
+        {
+            // Look again later in case the settings change
+            wait = interval;
+            retry = false;
+            continue;
+        }
+        if ((!requested && !retry && !network.autoConnect) || !hasPending())
+        {
+            retry = false;
+            continue;
+        }
+
+        // Leave Wi-Fi up if something else (MQTT) joined it
+        bool joined = WiFi.status() != WL_CONNECTED;
+        bool ok = syncAll(network, device);
+        if (!network.autoConnect && joined)
+        {
+            disconnect();
+        }
+
+        retry = !ok;
+        if (retry)
+        {
+            wait = pdMS_TO_TICKS(SYNC_RETRY_MS);
+        }
+
+#if EARS_DEBUG == 1
+        EARS_syncStats stats = getStats();
+        Serial.printf("[SYNC] %s: %lu records in %lu batches, %lu bytes\n", ok ? "Done" : "Failed",
+                      (unsigned long)stats.records, (unsigned long)stats.batches, (unsigned long)stats.bytes);
+#endif
+    }
+}
+
+void EARS_sync::taskFunction(void* param)
+{
+    ((EARS_sync *)param)->run();
+}
+
+/******************************************************************************
+ * Version Information
+ *****************************************************************************/
+const char* EARS_sync::getLibraryName()
+{
+    return EARS_Sync::LIB_NAME;
+}
+
+uint32_t EARS_sync::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_Sync::VERSION_MAJOR,
+                       EARS_Sync::VERSION_MINOR,
+                       EARS_Sync::VERSION_PATCH);
+}
+
+const char* EARS_sync::getVersionDate()
+{
+    return EARS_Sync::VERSION_DATE;
+}
+
+void EARS_sync::getVersionString(char* buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+EARS_sync &using_sync()
+{
+    static EARS_sync instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_syncLib.cpp
+ ******************************************************************************/
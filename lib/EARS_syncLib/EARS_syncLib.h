@@ -0,0 +1,203 @@
+/**
+ * @file EARS_syncLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Delta sync of the record stores to a server over Wi-Fi
+ * @details Each store's .dat file is append-only, so a record number is a
+ *          watermark: everything after it has changed since the last sync.
+ *          A low-priority task on Core 1 uploads only that tail, as CBOR
+ *          batches of up to SYNC_BATCH_RECORDS current versions and
+ *          tombstones (EARS_recordStore::readChanges()), one HTTP POST per
+ *          batch on a kept-alive connection to "<sync_url>/<store>".
+ *
+ *          The server answers each batch with the record number it now
+ *          holds (plain decimal). That becomes the new watermark, saved to
+ *          <store>.sync next to the store, so an interrupted sync resumes
+ *          at the last acknowledged batch and a server that lost data can
+ *          wind the device back. A batch is:
+ *
+ *            { "device": text, "store": text, "from": uint, "to": uint,
+ *              "records": [ record, ... ] }
+ *
+ *          each record an array, strings without their padding:
+ *
+ *            tombstone  [id, sequence, flags]
+ *            equipment  [id, sequence, flags, zap, name, serial, nsn,
+ *                        category, quantity, status, inspected, issued]
+ *            ammunition [id, sequence, flags, zap, calibre, lot,
+ *                        description, quantity, expiry, received]
+ *
+ *          Settings come from the ears.config "network" section. With
+ *          auto_connect the task syncs every sync_interval_minutes when
+ *          there is anything to send; otherwise only on requestSync(), and
+ *          the radio is switched off again afterwards, unless it was
+ *          already up (MQTT) before the sync.
+ *
+ * @version 1.1.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_SYNC_LIB_H__
+#define __EARS_SYNC_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "EARS_versionDef.h"
+#include "EARS_taskPlanLib.h"
+#include "EARS_sdCardLib.h"
+#include "EARS_configLib.h"
+#include "EARS_recordStoreLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_Sync
+{
+    constexpr const char* LIB_NAME = "EARS_sync";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "1";
+    constexpr const char* VERSION_PATCH = "1";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+#define SYNC_MAX_STORES 2
+#define SYNC_BATCH_RECORDS 64           // Records per POST
+#define SYNC_RECORD_CBOR_MAX (RECORD_SIZE + 32) // Worst case encoded record
+#define SYNC_BATCH_BYTES (SYNC_BATCH_RECORDS * SYNC_RECORD_CBOR_MAX + 128)
+#define SYNC_CONNECT_TIMEOUT_MS 15000   // Wi-Fi association
+#define SYNC_HTTP_TIMEOUT_MS 10000      // Per request
+#define SYNC_RETRY_MS 60000             // Wait after a failed sync
+#define SYNC_WATERMARK_SUFFIX ".sync"
+
+// Sync task
+#define SYNC_TASK_CORE using_taskplan().core(TASK_ROLE_NETWORK)
+#define SYNC_TASK_PRIORITY using_taskplan().priority(TASK_ROLE_NETWORK)
+#define SYNC_TASK_STACK_SIZE 6144
+
+/**
+ * @brief What the sync task is doing
+ */
+enum EARS_syncState : uint8_t
+{
+    SYNC_IDLE = 0,
+    SYNC_CONNECTING,
+    SYNC_UPLOADING,
+    SYNC_FAILED                 // Last attempt failed, retried after SYNC_RETRY_MS
+};
+
+/**
+ * @brief Sync counters
+ */
+struct EARS_syncStats
+{
+    EARS_syncState state;
+    int16_t lastHttpCode;       // Last response, negative for a transport error
+    uint32_t lastSyncMs;        // millis() of the last complete sync, 0 = never
+    uint32_t syncs;             // Complete syncs
+    uint32_t failures;
+    uint32_t batches;           // Batches acknowledged
+    uint32_t records;           // Records uploaded
+    uint32_t bytes;             // Payload bytes uploaded
+    uint32_t rewinds;           // Watermarks wound back by the server
+};
+
+/******************************************************************************
+ * EARS_sync Class
+ *****************************************************************************/
+class EARS_sync
+{
+public:
+    EARS_sync();
+
+    // Version information getters
+    static const char* getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char* getVersionDate();
+    static void getVersionString(char* buffer);
+
+    /**
+     * @brief Add a store to sync (before begin())
+     * @param store Opened store
+     * @param name Store name; used for the URL and the watermark file
+     * @return true if added
+     */
+    bool addStore(EARS_recordStore* store, const char* name);
+
+    /**
+     * @brief Load the watermarks and start the sync task
+     * @param sdCard Mounted SD card
+     * @return true if the task is running
+     */
+    bool begin(EARS_sdCard* sdCard);
+
+    /**
+     * @brief Sync as soon as possible (any task)
+     * @details Needed to sync at all when auto_connect is off
+     */
+    void requestSync();
+
+    /**
+     * @brief Record versions written since the last acknowledged batch
+     * @details An upper bound: superseded versions are not sent
+     */
+    uint32_t getPending() const;
+
+    EARS_syncStats getStats() const;
+
+private:
+    struct Slot
+    {
+        EARS_recordStore* store;
+        char name[16];
+        char path[40];
+        uint32_t watermark;      // First record number not yet acknowledged
+    };
+
+    EARS_sdCard* _sdCard;
+    Slot _slots[SYNC_MAX_STORES];
+    uint8_t _slotCount;
+    TaskHandle_t _task;
+
+    // Sync task only
+    EARS_record* _records;       // SYNC_BATCH_RECORDS
+    uint8_t* _buffer;            // SYNC_BATCH_BYTES
+    WiFiClient _client;
+    HTTPClient _http;
+
+    EARS_syncStats _stats;
+    mutable portMUX_TYPE _mux;
+
+    void run();
+    bool syncAll(const EARS_configNetwork& network, const char* device);
+    bool syncStore(Slot& slot, const char* url, const char* device);
+    bool connect(const EARS_configNetwork& network);
+    void disconnect();
+    bool hasPending() const;
+    void setState(EARS_syncState state);
+
+    bool loadWatermark(Slot& slot);
+    bool saveWatermark(const Slot& slot);
+    size_t encodeBatch(const Slot& slot, const char* device, uint32_t from, uint32_t to, size_t count);
+
+    static void taskFunction(void* param);
+};
+
+// Global instance access function (Singleton pattern)
+EARS_sync &using_sync();
+
+#endif // __EARS_SYNC_LIB_H__
+
+/******************************************************************************
+ * End of EARS_syncLib.h
+ ******************************************************************************/
@@ -0,0 +1,185 @@
+/**
+ * @file EARS_taskPlanLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Task placement plan: which core and priority each project task gets
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+#include "EARS_taskPlanLib.h"
+#include <Preferences.h>
+
+// Zero-initialised, so a task created before setup() still finds no plan and picks one
+static EARS_taskPlan taskplan_instance;
+
+static const char *const task_role_names[TASK_ROLE_COUNT] = {
+    "UI", "Flush", "Draw 0", "Draw 1", "Touch", "I2C", "Scanner",
+    "Background", "Flow", "SD index", "Network", "Trace", "Console"};
+
+/**
+ * Radios off: Core 0 is free, so it gets the UI and one draw thread, and
+ * Core 1 everything that feeds or services it.
+ */
+static const EARS_taskPlacement task_plan_default[TASK_ROLE_COUNT] = {
+    {0, 2}, // UI
+    {1, 3}, // Flush: above the background task
+    {0, 0}, // Draw 0: with the UI task
+    {1, 0}, // Draw 1
+    {1, 4}, // Touch: above flush and background
+    {1, 5}, // I2C: above the touch task, which waits on it
+    {1, 3}, // Scanner: a scan waits on nothing
+    {1, 1}, // Background
+    {1, 1}, // Flow
+    {1, 1}, // SD index
+    {1, 1}, // Network
+    {1, 1}, // Trace
+    {1, 0}, // Console: lowest, runs when Core 1 has nothing else
+};
+
+/**
+ * Radios on: the Wi-Fi/BT tasks (and lwIP) outrank every project task on
+ * Core 0, so the UI, its render path and touch move to Core 1 in the same
+ * order as before, and the work that can wait out a radio burst moves to
+ * Core 0. There the job scheduler and flow are raised above the network
+ * tasks, so a long MQTT or sync exchange cannot starve event dispatch and
+ * UI requests queued for the UI task.
+ */
+static const EARS_taskPlacement task_plan_radio[TASK_ROLE_COUNT] = {
+    {1, 2}, // UI
+    {1, 3}, // Flush: streams what the UI task renders
+    {1, 0}, // Draw 0: with the UI task
+    {0, 0}, // Draw 1: its pair on the other core
+    {1, 4}, // Touch
+    {1, 5}, // I2C
+    {0, 3}, // Scanner
+    {0, 2}, // Background
+    {0, 2}, // Flow
+    {0, 1}, // SD index
+    {0, 1}, // Network
+    {0, 1}, // Trace
+    {0, 0}, // Console
+};
+
+// Pick the plan (EARS_TASK_PLAN, and the NVS flag in auto mode)
+void EARS_taskPlan::begin()
+{
+    if (_table != nullptr)
+    {
+        return;
+    }
+
+#if EARS_TASK_PLAN == TASK_PLAN_RADIO
+    _radio = true;
+#elif EARS_TASK_PLAN == TASK_PLAN_AUTO
+    // The Arduino core has initialised NVS before setup()
+    Preferences prefs;
+    _radio = prefs.begin(TASK_PLAN_NVS_NAMESPACE, true) && prefs.getBool(TASK_PLAN_NVS_KEY, false);
+    prefs.end();
+#else
+    _radio = false;
+#endif
+
+    _table = _radio ? task_plan_radio : task_plan_default;
+}
+
+// Core for a role
+uint8_t EARS_taskPlan::core(EARS_taskRole role)
+{
+    begin();
+    return role < TASK_ROLE_COUNT ? _table[role].core : 1;
+}
+
+// Priority for a role
+uint8_t EARS_taskPlan::priority(EARS_taskRole role)
+{
+    begin();
+    return role < TASK_ROLE_COUNT ? _table[role].priority : 1;
+}
+
+// Record whether the radios are in use (auto mode)
+bool EARS_taskPlan::setRadioActive(bool active)
+{
+#if EARS_TASK_PLAN == TASK_PLAN_AUTO
+    Preferences prefs;
+    if (!prefs.begin(TASK_PLAN_NVS_NAMESPACE, false))
+    {
+        return false;
+    }
+
+    bool changed = prefs.getBool(TASK_PLAN_NVS_KEY, false) != active;
+    if (changed)
+    {
+        prefs.putBool(TASK_PLAN_NVS_KEY, active);
+    }
+    prefs.end();
+    return changed;
+#else
+    (void)active;
+    return false;
+#endif
+}
+
+// Radio plan in use this boot
+bool EARS_taskPlan::isRadioPlan()
+{
+    begin();
+    return _radio;
+}
+
+// Print every role's placement to Serial
+void EARS_taskPlan::print()
+{
+    begin();
+    Serial.printf("[TASKS] %s plan (EARS_TASK_PLAN=%d)\n", _radio ? "Radio" : "Default", EARS_TASK_PLAN);
+    for (uint8_t role = 0; role < TASK_ROLE_COUNT; role++)
+    {
+        Serial.printf("[TASKS]   %-10s core %u, priority %u\n", task_role_names[role], _table[role].core,
+                      _table[role].priority);
+    }
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char *EARS_taskPlan::getLibraryName()
+{
+    return EARS_TaskPlan::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t EARS_taskPlan::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_TaskPlan::VERSION_MAJOR,
+                       EARS_TaskPlan::VERSION_MINOR,
+                       EARS_TaskPlan::VERSION_PATCH);
+}
+
+// Get version date
+const char *EARS_taskPlan::getVersionDate()
+{
+    return EARS_TaskPlan::VERSION_DATE;
+}
+
+// Format version as string
+void EARS_taskPlan::getVersionString(char *buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/**
+ * @brief Get reference to global task plan instance
+ *
+ * @return EARS_taskPlan& Reference to the global task plan instance
+ */
+EARS_taskPlan &using_taskplan()
+{
+    return taskplan_instance;
+}
+
+/******************************************************************************
+ * End of EARS_taskPlanLib.cpp
+ *****************************************************************************/
@@ -0,0 +1,165 @@
+/**
+ * @file EARS_taskPlanLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Task placement plan: which core and priority each project task gets
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * Features:
+ * - One table of core and priority per task role, reviewed as a set
+ * - Default plan: the UI on Core 0, background, SD and network on Core 1
+ * - Radio plan: the UI, render and touch tasks on Core 1, background, SD
+ *   and network tasks on Core 0 beside the Wi-Fi/BT stacks
+ * - Plan picked at boot, before the first task is created
+ * - Radio plan followed automatically from ears.config network.wifi_enabled
+ *
+ * @details
+ * The ESP32 Wi-Fi and BT stacks run on Core 0, at priorities above every
+ * project task. With the radios off Core 0 is free and the default plan
+ * keeps the UI there; with them on their bursts would preempt rendering and
+ * touch handling, so the radio plan swaps the cores over.
+ *
+ * Tasks cannot move core once created, and ears.config is only read once
+ * the boot stages run, after the UI task exists. In auto mode the plan
+ * therefore comes from a flag in NVS, written by setRadioActive() once the
+ * config is loaded; a change to network.wifi_enabled moves the tasks at the
+ * next boot.
+ *
+ * Task names (Core0_UI, Core1_Background) and the MAIN_core0/core1 library
+ * names are kept for log and trace continuity; they name the roles, not the
+ * core under the radio plan.
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_TASK_PLAN_LIB_H__
+#define __EARS_TASK_PLAN_LIB_H__
+
+/******************************************************************************
+ * Includes Information
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_TaskPlan
+{
+    constexpr const char *LIB_NAME = "EARS_taskPlan";
+    constexpr const char *VERSION_MAJOR = "1";
+    constexpr const char *VERSION_MINOR = "1";
+    constexpr const char *VERSION_PATCH = "0";
+    constexpr const char *VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Task Plan Configuration
+ *****************************************************************************/
+
+// 0 = default plan, 1 = radio plan, 2 = radio plan while Wi-Fi is enabled (NVS flag)
+#ifndef EARS_TASK_PLAN
+#define EARS_TASK_PLAN 2
+#endif
+
+#define TASK_PLAN_DEFAULT 0
+#define TASK_PLAN_RADIO 1
+#define TASK_PLAN_AUTO 2
+
+// NVS flag for auto mode (own namespace, outside EARS_nvsEeprom's)
+#define TASK_PLAN_NVS_NAMESPACE "ears_tasks"
+#define TASK_PLAN_NVS_KEY "radio"
+
+/**
+ * @enum EARS_taskRole
+ * @brief Project tasks placed by the plan
+ */
+enum EARS_taskRole : uint8_t
+{
+    TASK_ROLE_UI = 0,     // Core0_UI: LVGL timers and rendering (MAIN_core0TasksLib)
+    TASK_ROLE_FLUSH,      // LVGL_Flush: SPI transfers to the panel (MAIN_lvglLib)
+    TASK_ROLE_DRAW0,      // First LVGL draw thread, with the UI task
+    TASK_ROLE_DRAW1,      // Second LVGL draw thread, on the other core
+    TASK_ROLE_TOUCH,      // Touch_Sample (EARS_touchLib)
+    TASK_ROLE_I2C,        // I2CBus, which the touch task waits on (EARS_i2cBusLib)
+    TASK_ROLE_SCANNER,    // Scanner UART (MAIN_scannerLib)
+    TASK_ROLE_BACKGROUND, // Core1_Background: job scheduler (MAIN_core1TasksLib)
+    TASK_ROLE_FLOW,       // Flow worker (MAIN_flowTaskLib)
+    TASK_ROLE_SD_INDEX,   // SDIndex directory scans (EARS_sdCardLib)
+    TASK_ROLE_NETWORK,    // MQTT, Sync and OTA
+    TASK_ROLE_TRACE,      // Debug trace emitter (EARS_traceLib)
+    TASK_ROLE_CONSOLE,    // Serial diagnostics console (MAIN_consoleLib)
+    TASK_ROLE_COUNT
+};
+
+/**
+ * @struct EARS_taskPlacement
+ * @brief Where one role runs
+ */
+struct EARS_taskPlacement
+{
+    uint8_t core;
+    uint8_t priority; // Unused for the draw threads (LVGL sets theirs)
+};
+
+class EARS_taskPlan
+{
+public:
+    // Version information getters
+    static const char *getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char *getVersionDate();
+    static void getVersionString(char *buffer);
+
+    /**
+     * @brief Pick the plan (EARS_TASK_PLAN, and the NVS flag in auto mode)
+     * @note Called at the start of setup(); core() and priority() call it
+     *       themselves if a task is created first.
+     */
+    void begin();
+
+    /**
+     * @brief Core for a role
+     * @param role Task role
+     * @return uint8_t 0 or 1
+     */
+    uint8_t core(EARS_taskRole role);
+
+    /**
+     * @brief Priority for a role
+     * @param role Task role
+     * @return uint8_t FreeRTOS priority
+     */
+    uint8_t priority(EARS_taskRole role);
+
+    /**
+     * @brief Record whether the radios are in use (auto mode)
+     * @param active network.wifi_enabled from ears.config
+     * @return true if the stored flag changed (the plan changes at the next boot)
+     */
+    bool setRadioActive(bool active);
+
+    /**
+     * @brief Radio plan in use this boot
+     */
+    bool isRadioPlan();
+
+    /**
+     * @brief Print every role's placement to Serial
+     */
+    void print();
+
+private:
+    const EARS_taskPlacement *_table;
+    bool _radio;
+};
+
+// Global instance access function
+EARS_taskPlan &using_taskplan();
+
+#endif // __EARS_TASK_PLAN_LIB_H__
+
+/******************************************************************************
+ * End of EARS_taskPlanLib.h
+ *****************************************************************************/
@@ -0,0 +1,419 @@
+/**
+ * @file EARS_timeLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Shared monotonic and wall-clock time with cached timestamp text
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#include "EARS_timeLib.h"
+#include <esp_timer.h>
+#include <esp_sntp.h>
+#include <sys/time.h>
+#include <WiFi.h>
+
+// PCF85063 time registers: seconds (bit 7 = oscillator stopped) to years
+#define PCF85063_REG_SECONDS 0x04
+#define PCF85063_OS_FLAG 0x80
+
+static inline uint8_t bcd_to_bin(uint8_t value)
+{
+    return (uint8_t)((value >> 4) * 10 + (value & 0x0F));
+}
+
+static inline uint8_t bin_to_bcd(uint8_t value)
+{
+    return (uint8_t)(((value / 10) << 4) | (value % 10));
+}
+
+// Constructor
+EARS_time::EARS_time()
+    : _rtc(I2C_DEVICE_NONE), _source(TIME_SOURCE_NONE), _offsetUs(0), _lastRtcReadUs(0),
+      _rtcWritePending(false), _ntpStarted(false), _rtcReads(0), _rtcWrites(0), _rtcErrors(0),
+      _syncs(0), _lastStepMs(0), _textSecond(-1), _textHits(0), _textDigits(0), _textFormats(0)
+{
+    _text[0] = '\0';
+    _lock = portMUX_INITIALIZER_UNLOCKED;
+}
+
+// Timezone, RTC, NTP
+bool EARS_time::begin(int sda, int scl)
+{
+    setTimezone(TIME_DEFAULT_TZ);
+
+#if TIME_RTC_ENABLED == 1
+    if (using_i2cBus().begin(sda, scl))
+    {
+        _rtc = using_i2cBus().addDevice(TIME_RTC_ADDRESS, TIME_RTC_CLOCK_HZ, TIME_RTC_TIMEOUT_MS);
+    }
+
+    time_t epoch;
+    if (readRtc(&epoch))
+    {
+        applyWallUs((int64_t)epoch * 1000000LL, TIME_SOURCE_RTC);
+    }
+#endif
+
+#if TIME_NTP_ENABLED == 1
+    // SNTP needs the network stack: start it on the first connection
+    WiFi.onEvent([](arduino_event_id_t event, arduino_event_info_t info) {
+        EARS_time &self = using_time();
+        if (self._ntpStarted)
+        {
+            return;
+        }
+        self._ntpStarted = true;
+        sntp_setoperatingmode(SNTP_OPMODE_POLL);
+        sntp_setservername(0, TIME_NTP_SERVER);
+        sntp_set_time_sync_notification_cb(onNtpSync);
+        sntp_init();
+    }, ARDUINO_EVENT_WIFI_STA_GOT_IP);
+#endif
+
+    char text[TIME_TEXT_LEN + 1];
+    formatTimestamp(text, sizeof(text));
+    Serial.printf("[TIME] %s (%s)\n", text, sourceName(_source));
+    return isValid();
+}
+
+// RTC drift correction and write-back (Core 1)
+void EARS_time::service()
+{
+    if (_rtc == I2C_DEVICE_NONE)
+    {
+        return;
+    }
+
+    if (_rtcWritePending)
+    {
+        _rtcWritePending = false;
+        if (writeRtc(now()))
+        {
+            _rtcWrites++;
+        }
+    }
+
+    // esp_timer runs on the 40 MHz crystal; the RTC's 32 kHz one is the
+    // reference while it is the best source we have
+    int64_t mono = esp_timer_get_time();
+    if (_source <= TIME_SOURCE_RTC && mono - _lastRtcReadUs >= (int64_t)TIME_RTC_RESYNC_MS * 1000LL)
+    {
+        time_t epoch;
+        if (readRtc(&epoch))
+        {
+            // Only whole seconds are known: keep the fraction unless the
+            // clocks disagree on the second
+            int64_t wall = nowUs();
+            if (wall / 1000000LL != (int64_t)epoch)
+            {
+                applyWallUs((int64_t)epoch * 1000000LL, TIME_SOURCE_RTC);
+            }
+        }
+    }
+}
+
+int64_t EARS_time::monotonicUs() const
+{
+    return esp_timer_get_time();
+}
+
+int64_t EARS_time::nowUs() const
+{
+    portENTER_CRITICAL(&_lock);
+    int64_t offset = _offsetUs;
+    portEXIT_CRITICAL(&_lock);
+    return esp_timer_get_time() + offset;
+}
+
+time_t EARS_time::now() const
+{
+    return (time_t)(nowUs() / 1000000LL);
+}
+
+// External fix (GPS receiver, manual entry)
+bool EARS_time::setTime(time_t epoch, uint32_t microseconds, EARS_timeSource source)
+{
+    if (source < _source || (int64_t)epoch < TIME_VALID_AFTER)
+    {
+        return false;
+    }
+
+    applyWallUs((int64_t)epoch * 1000000LL + microseconds, source);
+
+    struct timeval tv = {epoch, (suseconds_t)microseconds};
+    settimeofday(&tv, NULL);
+
+    _syncs++;
+    _rtcWritePending = source > TIME_SOURCE_RTC;
+    return true;
+}
+
+void EARS_time::setTimezone(const char *posixTz)
+{
+    if (posixTz == nullptr || posixTz[0] == '\0')
+    {
+        return;
+    }
+    setenv("TZ", posixTz, 1);
+    tzset();
+
+    // Offsets change the whole text
+    portENTER_CRITICAL(&_lock);
+    _textSecond = -1;
+    portEXIT_CRITICAL(&_lock);
+}
+
+// Cached local timestamp
+size_t EARS_time::formatTimestamp(char *buffer, size_t bufferSize, bool withMs)
+{
+    if (buffer == nullptr || bufferSize == 0)
+    {
+        return 0;
+    }
+
+    int64_t wall = nowUs();
+    int64_t second = wall / 1000000LL;
+    char text[TIME_TEXT_LEN + 1];
+    bool cached = false;
+
+    // Zones are whole minutes from UTC, so the local seconds are UTC's and
+    // only a new minute needs the calendar
+    portENTER_CRITICAL(&_lock);
+    if (second == _textSecond)
+    {
+        _textHits++;
+        cached = true;
+    }
+    else if (_textSecond >= 0 && second / 60 == _textSecond / 60)
+    {
+        uint8_t s = (uint8_t)(second % 60);
+        _text[17] = (char)('0' + s / 10);
+        _text[18] = (char)('0' + s % 10);
+        _textSecond = second;
+        _textDigits++;
+        cached = true;
+    }
+    if (cached)
+    {
+        memcpy(text, _text, sizeof(text));
+    }
+    portEXIT_CRITICAL(&_lock);
+
+    if (!cached)
+    {
+        time_t seconds = (time_t)second;
+        struct tm timeinfo;
+        localtime_r(&seconds, &timeinfo);
+        snprintf(text, sizeof(text), "%04d-%02d-%02d %02d:%02d:%02d",
+                 timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday,
+                 timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
+
+        portENTER_CRITICAL(&_lock);
+        memcpy(_text, text, sizeof(text));
+        _textSecond = second;
+        _textFormats++;
+        portEXIT_CRITICAL(&_lock);
+    }
+
+    size_t length = TIME_TEXT_LEN < bufferSize ? TIME_TEXT_LEN : bufferSize - 1;
+    memcpy(buffer, text, length);
+
+    if (withMs && length + 4 < bufferSize)
+    {
+        uint16_t ms = (uint16_t)((wall / 1000LL) % 1000);
+        buffer[length++] = '.';
+        buffer[length++] = (char)('0' + ms / 100);
+        buffer[length++] = (char)('0' + (ms / 10) % 10);
+        buffer[length++] = (char)('0' + ms % 10);
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+void EARS_time::getStats(EARS_timeStats *stats) const
+{
+    if (stats == nullptr)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&_lock);
+    stats->source = _source;
+    stats->rtcPresent = _rtc != I2C_DEVICE_NONE;
+    stats->rtcReads = _rtcReads;
+    stats->rtcWrites = _rtcWrites;
+    stats->rtcErrors = _rtcErrors;
+    stats->syncs = _syncs;
+    stats->lastStepMs = _lastStepMs;
+    stats->textHits = _textHits;
+    stats->textDigits = _textDigits;
+    stats->textFormats = _textFormats;
+    portEXIT_CRITICAL(&_lock);
+}
+
+const char *EARS_time::sourceName(EARS_timeSource source)
+{
+    switch (source)
+    {
+    case TIME_SOURCE_RTC:
+        return "RTC";
+    case TIME_SOURCE_NTP:
+        return "NTP";
+    case TIME_SOURCE_GPS:
+        return "GPS";
+    case TIME_SOURCE_NONE:
+    default:
+        return "unset";
+    }
+}
+
+// Move the wall clock; the text cache follows
+void EARS_time::applyWallUs(int64_t wallUs, EARS_timeSource source)
+{
+    int64_t offset = wallUs - esp_timer_get_time();
+
+    portENTER_CRITICAL(&_lock);
+    int64_t step = offset - _offsetUs;
+    _offsetUs = offset;
+    _source = source;
+    _lastStepMs = (int32_t)(step / 1000LL);
+    _textSecond = -1;
+    portEXIT_CRITICAL(&_lock);
+
+    if (source == TIME_SOURCE_RTC)
+    {
+        struct timeval tv = {(time_t)(wallUs / 1000000LL), (suseconds_t)(wallUs % 1000000LL)};
+        settimeofday(&tv, NULL);
+    }
+}
+
+// Blocking read on the shared bus (boot and Core 1 only)
+bool EARS_time::readRtc(time_t *epoch)
+{
+    if (_rtc == I2C_DEVICE_NONE)
+    {
+        return false;
+    }
+
+    _lastRtcReadUs = esp_timer_get_time();
+
+    uint8_t regs[7];
+    if (using_i2cBus().readRegisters(_rtc, PCF85063_REG_SECONDS, regs, sizeof(regs)) != ESP_OK)
+    {
+        _rtcErrors++;
+        return false;
+    }
+
+    // Oscillator stopped since the last write: the time is not kept
+    if (regs[0] & PCF85063_OS_FLAG)
+    {
+        _rtcErrors++;
+        return false;
+    }
+
+    time_t value = epochFromUtc(2000 + bcd_to_bin(regs[6]), bcd_to_bin(regs[5] & 0x1F),
+                                bcd_to_bin(regs[3] & 0x3F), bcd_to_bin(regs[2] & 0x3F),
+                                bcd_to_bin(regs[1] & 0x7F), bcd_to_bin(regs[0] & 0x7F));
+    if ((int64_t)value < TIME_VALID_AFTER)
+    {
+        _rtcErrors++;
+        return false;
+    }
+
+    _rtcReads++;
+    *epoch = value;
+    return true;
+}
+
+// Write UTC; clears the oscillator stop flag
+bool EARS_time::writeRtc(time_t epoch)
+{
+    struct tm utc;
+    gmtime_r(&epoch, &utc);
+
+    uint8_t data[8] = {
+        PCF85063_REG_SECONDS,
+        bin_to_bcd((uint8_t)utc.tm_sec),
+        bin_to_bcd((uint8_t)utc.tm_min),
+        bin_to_bcd((uint8_t)utc.tm_hour),
+        bin_to_bcd((uint8_t)utc.tm_mday),
+        (uint8_t)utc.tm_wday,
+        bin_to_bcd((uint8_t)(utc.tm_mon + 1)),
+        bin_to_bcd((uint8_t)(utc.tm_year - 100)),
+    };
+    if (using_i2cBus().transfer(_rtc, data, sizeof(data), nullptr, 0) != ESP_OK)
+    {
+        _rtcErrors++;
+        return false;
+    }
+    return true;
+}
+
+// SNTP has set the system time (lwIP task)
+void EARS_time::onNtpSync(struct timeval *tv)
+{
+    EARS_time &self = using_time();
+    self.applyWallUs((int64_t)tv->tv_sec * 1000000LL + tv->tv_usec, TIME_SOURCE_NTP);
+    self._syncs++;
+    self._rtcWritePending = true;
+}
+
+// Days from civil (proleptic Gregorian), no timezone involved
+time_t EARS_time::epochFromUtc(int year, int month, int day, int hour, int minute, int second)
+{
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yoe = year - era * 400;
+    int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    int64_t days = (int64_t)era * 146097 + doe - 719468;
+    return (time_t)(days * 86400 + hour * 3600 + minute * 60 + second);
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char *EARS_time::getLibraryName()
+{
+    return EARS_Time::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t EARS_time::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_Time::VERSION_MAJOR,
+                       EARS_Time::VERSION_MINOR,
+                       EARS_Time::VERSION_PATCH);
+}
+
+// Get version date
+const char *EARS_time::getVersionDate()
+{
+    return EARS_Time::VERSION_DATE;
+}
+
+// Format version as string
+void EARS_time::getVersionString(char *buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/**
+ * @brief Get reference to global time service instance (Singleton pattern)
+ *
+ * @return EARS_time& Reference to the global instance
+ */
+EARS_time &using_time()
+{
+    static EARS_time instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_timeLib.cpp
+ *****************************************************************************/
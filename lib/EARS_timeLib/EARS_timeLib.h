@@ -0,0 +1,224 @@
+/**
+ * @file EARS_timeLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Shared monotonic and wall-clock time with cached timestamp text
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * Features:
+ * - One monotonic source (esp_timer, microseconds since boot) and one wall
+ *   clock derived from it by an offset, so every library agrees on both
+ * - Wall clock set from the PCF85063 RTC at boot, from NTP whenever Wi-Fi
+ *   is up, or from a GPS fix (setTime()); the best source seen wins
+ * - The RTC is re-read every TIME_RTC_RESYNC_MS to take out esp_timer
+ *   drift, and written back after an NTP or GPS sync
+ * - Cached "YYYY-MM-DD HH:MM:SS" text: a call in the same second is a
+ *   memcpy, a new second in the same minute rewrites two digits, and only
+ *   a new minute runs localtime_r()/snprintf()
+ *
+ * @details
+ * The RTC is a normal priority device on the shared EARS_i2cBus (it holds
+ * UTC; the cached text is local time after setTimezone()). Its oscillator
+ * stop flag marks a clock that lost power, which is not used. Without an
+ * RTC or a sync the wall clock counts from 1970-01-01 at boot and
+ * isValid() is false.
+ *
+ * SNTP is started on the first Wi-Fi connection (EARS_sync joins the
+ * network); it keeps the system time in step and its sync notification
+ * moves the offset. settimeofday() is kept in step for the other sources,
+ * so time() and gettimeofday() agree with nowUs().
+ *
+ * service() runs the RTC re-read and write-back; call it from a Core 1 job.
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_TIME_LIB_H__
+#define __EARS_TIME_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <time.h>
+#include "EARS_versionDef.h"
+#include "EARS_i2cBusLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_Time
+{
+    constexpr const char *LIB_NAME = "EARS_time";
+    constexpr const char *VERSION_MAJOR = "1";
+    constexpr const char *VERSION_MINOR = "0";
+    constexpr const char *VERSION_PATCH = "0";
+    constexpr const char *VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Time Configuration
+ *****************************************************************************/
+
+// PCF85063 on the touch I2C bus (EARS_ws35tlcdPins.h TOUCH_SDA/TOUCH_SCL)
+#define TIME_RTC_ENABLED 1
+#define TIME_RTC_ADDRESS 0x51
+#define TIME_RTC_CLOCK_HZ 400000
+#define TIME_RTC_TIMEOUT_MS 10
+
+// esp_timer drift correction from the RTC, and service() period
+#define TIME_RTC_RESYNC_MS 3600000UL
+#define TIME_SERVICE_PERIOD_MS 10000
+
+// NTP (started on the first Wi-Fi connection)
+#define TIME_NTP_ENABLED 1
+#define TIME_NTP_SERVER "pool.ntp.org"
+
+// POSIX TZ applied at begin(), e.g. "GMT0BST,M3.5.0/1,M10.5.0"
+#define TIME_DEFAULT_TZ "UTC0"
+
+// Earliest wall clock taken as set (2026-01-01T00:00:00Z)
+#define TIME_VALID_AFTER 1767225600LL
+
+// "YYYY-MM-DD HH:MM:SS" and ".mmm"
+#define TIME_TEXT_LEN 19
+#define TIME_TEXT_MS_LEN 23
+
+/******************************************************************************
+ * Time Types
+ *****************************************************************************/
+
+// Wall clock sources, in rising order of trust
+enum EARS_timeSource : uint8_t
+{
+    TIME_SOURCE_NONE = 0, // Counting from 1970 at boot
+    TIME_SOURCE_RTC,
+    TIME_SOURCE_NTP,
+    TIME_SOURCE_GPS
+};
+
+/**
+ * @struct EARS_timeStats
+ * @brief Sources and cache counters
+ */
+struct EARS_timeStats
+{
+    EARS_timeSource source;
+    bool rtcPresent;
+    uint32_t rtcReads;       // RTC reads applied
+    uint32_t rtcWrites;      // RTC write-backs after a sync
+    uint32_t rtcErrors;      // Failed or invalid RTC transfers
+    uint32_t syncs;          // NTP and GPS syncs
+    int32_t lastStepMs;      // Wall clock step at the last sync or RTC read
+    uint32_t textHits;       // Timestamps copied from the cache
+    uint32_t textDigits;     // Timestamps that rewrote the seconds
+    uint32_t textFormats;    // Timestamps that ran localtime_r()
+};
+
+/******************************************************************************
+ * EARS_time Class
+ *****************************************************************************/
+class EARS_time
+{
+public:
+    EARS_time();
+
+    // Version information getters
+    static const char *getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char *getVersionDate();
+    static void getVersionString(char *buffer);
+
+    /**
+     * @brief Apply the default timezone, read the RTC and arm NTP
+     * @param sda I2C SDA pin (the shared bus keeps the first pins it got)
+     * @param scl I2C SCL pin
+     * @return true if the wall clock is valid
+     */
+    bool begin(int sda, int scl);
+
+    /**
+     * @brief RTC re-read and write-back (Core 1 job)
+     */
+    void service();
+
+    // Microseconds since boot (never steps)
+    int64_t monotonicUs() const;
+
+    // Wall clock, microseconds since 1970-01-01 UTC
+    int64_t nowUs() const;
+
+    // Wall clock, seconds since 1970-01-01 UTC
+    time_t now() const;
+
+    bool isValid() const { return _source != TIME_SOURCE_NONE; }
+    EARS_timeSource getSource() const { return _source; }
+
+    /**
+     * @brief Set the wall clock from an external fix (GPS, manual entry)
+     * @param epoch Seconds since 1970-01-01 UTC
+     * @param microseconds Fraction of the second
+     * @param source Ignored if lower than the source already in use
+     * @return true if applied
+     */
+    bool setTime(time_t epoch, uint32_t microseconds, EARS_timeSource source);
+
+    /**
+     * @brief Local timezone for the text
+     * @param posixTz POSIX TZ string
+     */
+    void setTimezone(const char *posixTz);
+
+    /**
+     * @brief Local "YYYY-MM-DD HH:MM:SS", optionally with ".mmm"
+     * @param buffer Destination (TIME_TEXT_LEN + 1, or TIME_TEXT_MS_LEN + 1)
+     * @param bufferSize Destination size
+     * @param withMs Append milliseconds
+     * @return size_t Characters written
+     * @note Any task; not from an ISR.
+     */
+    size_t formatTimestamp(char *buffer, size_t bufferSize, bool withMs = false);
+
+    void getStats(EARS_timeStats *stats) const;
+
+    // Source name for display
+    static const char *sourceName(EARS_timeSource source);
+
+private:
+    EARS_i2cDeviceId _rtc;
+    volatile EARS_timeSource _source;
+    int64_t _offsetUs;             // Wall clock minus esp_timer (under _lock)
+    int64_t _lastRtcReadUs;        // esp_timer time of the last RTC read
+    volatile bool _rtcWritePending;
+    bool _ntpStarted;
+    uint32_t _rtcReads;
+    uint32_t _rtcWrites;
+    uint32_t _rtcErrors;
+    uint32_t _syncs;
+    int32_t _lastStepMs;
+
+    // Text cache: local time of _textSecond (under _lock)
+    int64_t _textSecond;
+    char _text[TIME_TEXT_LEN + 1];
+    uint32_t _textHits;
+    uint32_t _textDigits;
+    uint32_t _textFormats;
+
+    mutable portMUX_TYPE _lock;
+
+    void applyWallUs(int64_t wallUs, EARS_timeSource source);
+    bool readRtc(time_t *epoch);
+    bool writeRtc(time_t epoch);
+    static void onNtpSync(struct timeval *tv);
+    static time_t epochFromUtc(int year, int month, int day, int hour, int minute, int second);
+};
+
+// Global instance access function
+EARS_time &using_time();
+
+#endif // __EARS_TIME_LIB_H__
+
+/******************************************************************************
+ * End of EARS_timeLib.h
+ *****************************************************************************/
@@ -2,52 +2,114 @@
  * @file EARS_touchLib.cpp
  * @author JTB & Claude Sonnet 4.5
  * @brief Touch controller library implementation for FT6236U/FT3267
- * @version 2.0.0
- * @date 20260210
+ * @version 2.13.0
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
 
 #include "EARS_touchLib.h"
+#include "EARS_traceLib.h"
+#include "EARS_placementDef.h"
+#include "EARS_profileLib.h"
+#include "EARS_rtosTraceLib.h"
+#include <esp_timer.h>
 
 // Singleton instance for LVGL callback
 EARS_touch *EARS_touch::_instance = nullptr;
 
-EARS_touch::EARS_touch() : _wire(nullptr),
+// Interrupt state shared with the INT ISR
+volatile bool EARS_touch::_dataReady = false;
+volatile uint32_t EARS_touch::_intCount = 0;
+volatile uint32_t EARS_touch::_intEdgeUs = 0;
+void (*EARS_touch::_isrCallback)(void) = nullptr;
+
+// Raw (portrait) to display mapping per Arduino_GFX rotation
+static const TouchTransform touch_transforms[4] = {
+    {1, 0, 0, 0, 1, 0},                                            // 0: x = rawX, y = rawY
+    {0, 1, 0, -1, 0, TOUCH_PANEL_WIDTH - 1},                       // 1: x = rawY, y = 319 - rawX
+    {-1, 0, TOUCH_PANEL_WIDTH - 1, 0, -1, TOUCH_PANEL_HEIGHT - 1}, // 2: x = 319 - rawX, y = 479 - rawY
+    {0, -1, TOUCH_PANEL_HEIGHT - 1, 1, 0, 0},                      // 3: x = 479 - rawY, y = rawX
+};
+
+EARS_touch::EARS_touch() : _device(I2C_DEVICE_NONE),
                            _state(TOUCH_NOT_INITIALIZED),
                            _address(FT6X36_SLAVE_ADDRESS),
                            _chipID(0),
                            _sda(0),
-                           _scl(0)
+                           _scl(0),
+                           _intPin(-1),
+                           _lastPressed(false),
+                           _lastX(0),
+                           _lastY(0),
+                           _readMode(TOUCH_READ_FAST),
+                           _rotation(TOUCH_DEFAULT_ROTATION),
+                           _transform(touch_transforms[TOUCH_DEFAULT_ROTATION]),
+                           _indev(nullptr),
+                           _scanLevel(TOUCH_SCAN_NORMAL),
+                           _samplePeriodMs(TOUCH_SAMPLE_PERIOD_MS),
+                           _periodActiveNormal(TOUCH_PERIOD_ACTIVE_DEFAULT),
+                           _periodActiveWritten(TOUCH_PERIOD_ACTIVE_DEFAULT),
+                           _scanChanges(0),
+                           _taskHandle(nullptr),
+                           _eventCallback(nullptr),
+                           _sampleHook(nullptr),
+                           _readHook(nullptr),
+                           _eventHead(0),
+                           _eventTail(0),
+                           _eventsDropped(0),
+                           _prevSampleUs(0),
+                           _lastInputUs(0),
+                           _filterChanged(false)
+#if EARS_TOUCH_TRACE == 1
+                           ,
+                           _traceHead(0),
+                           _traceTail(0),
+                           _traceDropped(0),
+                           _traceLastFlushMs(0)
+#endif
 {
     _instance = this;
+    _lastEvent = TouchEvent{0, 0, 0, 0, 0, 0, 0, GESTURE_NONE};
+    memset(&_filter, 0, sizeof(_filter));
 }
 
 EARS_touch::~EARS_touch()
 {
-    if (_wire)
+    if (_taskHandle)
     {
-        _wire->end();
+        vTaskDelete(_taskHandle);
+        _taskHandle = nullptr;
     }
+    disableInterrupt();
     if (_instance == this)
     {
         _instance = nullptr;
     }
 }
 
-bool EARS_touch::begin(TwoWire &wire, uint8_t sda, uint8_t scl, uint8_t address)
+bool EARS_touch::begin(uint8_t sda, uint8_t scl, uint8_t address)
 {
     Serial.println("[TOUCH] Initializing touch controller...");
 
-    _wire = &wire;
     _address = address;
     _sda = sda;
     _scl = scl;
 
-    // Step 1: Initialize I2C bus
-    _wire->begin(sda, scl);
-    _wire->setClock(400000); // 400kHz fast mode
-    Serial.printf("[TOUCH] I2C initialized (SDA=%d, SCL=%d, 400kHz)\n", sda, scl);
+    // Step 1: Join the shared I2C bus, ahead of the other devices on it
+    if (!using_i2cBus().begin(sda, scl))
+    {
+        _state = TOUCH_INIT_FAILED;
+        return false;
+    }
+    _device = using_i2cBus().addDevice(address, TOUCH_I2C_CLOCK_HZ, TOUCH_I2C_TIMEOUT_MS, I2C_PRIORITY_HIGH);
+    if (_device == I2C_DEVICE_NONE)
+    {
+        _state = TOUCH_INIT_FAILED;
+        return false;
+    }
+    Serial.printf("[TOUCH] I2C device 0x%02X (SDA=%d, SCL=%d, %luHz)\n",
+                  address, sda, scl, (unsigned long)TOUCH_I2C_CLOCK_HZ);
 
     delay(50); // Allow touch controller to stabilize
 
@@ -87,18 +149,26 @@ bool EARS_touch::begin(TwoWire &wire, uint8_t sda, uint8_t scl, uint8_t address)
     Serial.printf("[TOUCH] Active Rate: %d Hz\n", activeRate);
     Serial.printf("[TOUCH] Monitor Period: %d\n", monitorRate);
 
+    // NORMAL keeps the controller's own rate; TRACKING raises it
+    _periodActiveWritten = activeRate;
+    _periodActiveNormal = (activeRate >= TOUCH_PERIOD_ACTIVE_MIN && activeRate <= TOUCH_PERIOD_ACTIVE_TRACKING)
+                              ? activeRate
+                              : TOUCH_PERIOD_ACTIVE_DEFAULT;
+    _scanLevel = TOUCH_SCAN_NORMAL;
+    _samplePeriodMs = TOUCH_SAMPLE_PERIOD_MS;
+
     _state = TOUCH_READY;
     Serial.println("[TOUCH] ✅ Touch controller ready!");
 
     return true;
 }
 
-TouchInitResult EARS_touch::performFullInitialization(uint8_t sda, uint8_t scl)
+TouchInitResult EARS_touch::performFullInitialization(uint8_t sda, uint8_t scl, int8_t intPin, bool registerIndev)
 {
     TouchInitResult result;
 
     // Step 1: Initialize touch controller via begin()
-    if (!begin(Wire, sda, scl, FT6X36_SLAVE_ADDRESS))
+    if (!begin(sda, scl, FT6X36_SLAVE_ADDRESS))
     {
         result.state = TOUCH_INIT_FAILED;
         return result;
@@ -115,17 +185,40 @@ TouchInitResult EARS_touch::performFullInitialization(uint8_t sda, uint8_t scl)
     result.sclPin = scl;
     result.maxTouchPoints = 2; // FT6236U supports 2 touch points
 
-    // Step 3: Register LVGL input device
-    lv_indev_t *touch_indev = lv_indev_create();
-    lv_indev_set_type(touch_indev, LV_INDEV_TYPE_POINTER);
-    lv_indev_set_read_cb(touch_indev, EARS_touch::lvgl_touch_read);
-    result.lvglRegistered = true;
+    // Step 3: Register LVGL input device (or later, from the LVGL task)
+    if (registerIndev)
+    {
+        result.lvglRegistered = registerInputDevice();
+    }
 
-    Serial.println("[TOUCH] LVGL input device registered");
+    // Step 4: Switch to interrupt-driven sampling if an INT pin was given
+    if (intPin >= 0)
+    {
+        result.interruptEnabled = enableInterrupt(intPin);
+    }
 
     return result;
 }
 
+bool EARS_touch::registerInputDevice()
+{
+    if (_indev != nullptr)
+    {
+        return true;
+    }
+    if (_state != TOUCH_READY)
+    {
+        return false;
+    }
+
+    _indev = lv_indev_create();
+    lv_indev_set_type(_indev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(_indev, EARS_touch::lvgl_touch_read);
+
+    Serial.println("[TOUCH] LVGL input device registered");
+    return true;
+}
+
 bool EARS_touch::isAvailable() const
 {
     return (_state == TOUCH_READY);
@@ -168,6 +261,9 @@ String EARS_touch::getModelName() const
 
 uint8_t EARS_touch::getPoint(int16_t *x, int16_t *y)
 {
+    EARS_PROFILE_ZONE("touch read");
+    EARS_RTOS_TRACE_SCOPE(RTOS_TRACE_TOUCH_SAMPLE);
+
     uint8_t buffer[16];
 
     if (!x || !y)
@@ -176,6 +272,32 @@ uint8_t EARS_touch::getPoint(int16_t *x, int16_t *y)
     if (!isAvailable())
         return 0;
 
+    if (_readMode == TOUCH_READ_FAST)
+    {
+        // REG 0x02-0x06: status + first touch point in one burst
+        if (readRegisters(FT6X36_REG_STATUS, buffer, FT6X36_POINT1_BURST_LEN) != FT6X36_POINT1_BURST_LEN)
+            return 0;
+
+        uint8_t numPoints = buffer[0] & 0x0F;
+        if (numPoints == 0 || numPoints == 0x0F)
+            return 0;
+
+        x[0] = ((buffer[1] & 0x0F) << 8) | buffer[2];
+        y[0] = ((buffer[3] & 0x0F) << 8) | buffer[4];
+
+        if (numPoints == 2)
+        {
+            // REG 0x09-0x0C: second touch point, only when reported
+            if (readRegisters(FT6X36_REG_TOUCH2_XH, buffer, FT6X36_POINT2_BURST_LEN) != FT6X36_POINT2_BURST_LEN)
+                return 1;
+
+            x[1] = ((buffer[0] & 0x0F) << 8) | buffer[1];
+            y[1] = ((buffer[2] & 0x0F) << 8) | buffer[3];
+        }
+
+        return numPoints;
+    }
+
     // Read touch data registers (0x00 to 0x0F)
     if (readRegisters(FT6X36_REG_MODE, buffer, 16) != 16)
         return 0;
@@ -223,8 +345,11 @@ TouchGesture EARS_touch::getGesture() const
     if (!isAvailable())
         return GESTURE_NONE;
 
-    uint8_t gestureID = readRegister(FT6X36_REG_GEST);
+    return decodeGesture(readRegister(FT6X36_REG_GEST));
+}
 
+TouchGesture EARS_HOT EARS_touch::decodeGesture(uint8_t gestureID)
+{
     switch (gestureID)
     {
     case 0x10:
@@ -257,6 +382,63 @@ uint8_t EARS_touch::getThreshold() const
 void EARS_touch::setPowerMode(TouchPowerMode mode)
 {
     writeRegister(FT6X36_REG_POWER_MODE, (uint8_t)mode);
+    _scanLevel = TOUCH_SCAN_UNKNOWN;
+}
+
+void EARS_touch::updateScanRate(bool dragging, bool idle)
+{
+    TouchScanLevel level = TOUCH_SCAN_NORMAL;
+    if (dragging || (_scanLevel == TOUCH_SCAN_TRACKING && _lastPressed))
+    {
+        level = TOUCH_SCAN_TRACKING;
+    }
+    else if (idle && !_lastPressed)
+    {
+        level = TOUCH_SCAN_IDLE;
+    }
+    setScanLevel(level);
+}
+
+void EARS_touch::setScanLevel(TouchScanLevel level)
+{
+    if (!isAvailable() || level == _scanLevel || level == TOUCH_SCAN_UNKNOWN)
+    {
+        return;
+    }
+
+    if (level == TOUCH_SCAN_IDLE)
+    {
+        // Monitor mode scans slowly; a touch still raises INT
+        writeRegister(FT6X36_REG_POWER_MODE, POWER_MONITOR);
+        _samplePeriodMs = TOUCH_SAMPLE_IDLE_MS;
+    }
+    else
+    {
+        if (_scanLevel != TOUCH_SCAN_NORMAL && _scanLevel != TOUCH_SCAN_TRACKING)
+        {
+            writeRegister(FT6X36_REG_POWER_MODE, POWER_ACTIVE);
+        }
+        uint8_t period = (level == TOUCH_SCAN_TRACKING) ? TOUCH_PERIOD_ACTIVE_TRACKING : _periodActiveNormal;
+        if (period != _periodActiveWritten)
+        {
+            writeRegister(FT6X36_REG_PERIOD_ACTIVE, period);
+            _periodActiveWritten = period;
+        }
+        _samplePeriodMs = (level == TOUCH_SCAN_TRACKING) ? TOUCH_SAMPLE_TRACKING_MS : TOUCH_SAMPLE_PERIOD_MS;
+    }
+
+    _scanLevel = level;
+    _scanChanges++;
+}
+
+TouchScanLevel EARS_touch::getScanLevel() const
+{
+    return _scanLevel;
+}
+
+uint32_t EARS_touch::getScanChanges() const
+{
+    return _scanChanges;
 }
 
 void EARS_touch::sleep()
@@ -270,7 +452,321 @@ void EARS_touch::wakeup()
     delay(10);
 }
 
-void EARS_touch::lvgl_touch_read(lv_indev_t *indev, lv_indev_data_t *data)
+bool EARS_touch::enableInterrupt(int8_t intPin)
+{
+    if (intPin < 0 || !isAvailable())
+        return false;
+
+    disableInterrupt();
+
+    // One INT pulse per new report, including the release report
+    writeRegister(FT6X36_REG_INT_MODE, FT6X36_INT_TRIGGER);
+
+    _intPin = intPin;
+    _dataReady = true; // Force one read to sync state
+    pinMode(_intPin, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(_intPin), EARS_touch::handleInterrupt, FALLING);
+
+    Serial.printf("[TOUCH] Interrupt mode enabled (INT=%d)\n", _intPin);
+    return true;
+}
+
+void EARS_touch::disableInterrupt()
+{
+    if (_intPin < 0)
+        return;
+
+    detachInterrupt(digitalPinToInterrupt(_intPin));
+    _intPin = -1;
+}
+
+bool EARS_touch::isInterruptEnabled() const
+{
+    return (_intPin >= 0);
+}
+
+void EARS_touch::setInterruptMode(uint8_t mode)
+{
+    writeRegister(FT6X36_REG_INT_MODE, mode);
+}
+
+uint32_t EARS_touch::getInterruptCount() const
+{
+    return _intCount;
+}
+
+bool EARS_touch::isInterruptAsserted() const
+{
+    return (_intPin >= 0) && (digitalRead(_intPin) == LOW);
+}
+
+void EARS_touch::setInterruptCallback(void (*callback)(void))
+{
+    _isrCallback = callback;
+}
+
+bool EARS_touch::hasPendingData() const
+{
+    // Keep sampling while pressed, or while a press is being confirmed, so
+    // drags and the release are not missed
+    return (_intPin < 0) || _dataReady || _lastPressed || (_filter.pressCount > 0);
+}
+
+void IRAM_ATTR EARS_touch::handleInterrupt()
+{
+    EARS_RTOS_TRACE_MARK(RTOS_TRACE_TOUCH_IRQ, 0);
+    _intEdgeUs = (uint32_t)esp_timer_get_time();
+    _dataReady = true;
+    _intCount++;
+
+    // Sampling task does the I2C read and wakes the consumer itself
+    if (_instance && _instance->_taskHandle)
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        vTaskNotifyGiveFromISR(_instance->_taskHandle, &xHigherPriorityTaskWoken);
+        if (xHigherPriorityTaskWoken == pdTRUE)
+        {
+            portYIELD_FROM_ISR();
+        }
+        return;
+    }
+
+    if (_isrCallback)
+    {
+        _isrCallback();
+    }
+}
+
+bool EARS_touch::startSamplingTask(uint8_t core, uint8_t priority)
+{
+    if (!isAvailable())
+        return false;
+
+    if (_taskHandle)
+        return true;
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        EARS_touch::samplingTask,
+        "Touch_Sample",
+        TOUCH_TASK_STACK_SIZE,
+        this,
+        priority,
+        &_taskHandle,
+        core);
+
+    if (result != pdPASS || _taskHandle == nullptr)
+    {
+        _taskHandle = nullptr;
+        Serial.println("[TOUCH] ERROR: Failed to create sampling task");
+        return false;
+    }
+
+    Serial.printf("[TOUCH] Sampling task started (core %d, priority %d)\n", core, priority);
+    return true;
+}
+
+bool EARS_touch::isSamplingTaskRunning() const
+{
+    return (_taskHandle != nullptr);
+}
+
+void EARS_touch::setEventCallback(void (*callback)(void))
+{
+    _eventCallback = callback;
+}
+
+void EARS_touch::setSampleHook(void (*hook)(const TouchEvent &event))
+{
+    _sampleHook = hook;
+}
+
+void EARS_touch::setReadHook(void (*hook)(void))
+{
+    _readHook = hook;
+}
+
+uint32_t EARS_touch::getDroppedEvents() const
+{
+    return _eventsDropped;
+}
+
+uint32_t EARS_touch::getLastInputUs() const
+{
+    return _lastInputUs;
+}
+
+lv_indev_t *EARS_touch::getInputDevice() const
+{
+    return _indev;
+}
+
+uint32_t EARS_HOT EARS_touch::stampInput(uint32_t sampleUs)
+{
+    // An edge between the previous sample and this one announced this data
+    uint32_t edgeUs = _intEdgeUs;
+    bool announced = (_intPin >= 0) && (int32_t)(edgeUs - _prevSampleUs) > 0 && (int32_t)(sampleUs - edgeUs) >= 0;
+    _prevSampleUs = sampleUs;
+    return announced ? edgeUs : sampleUs;
+}
+
+bool EARS_HOT EARS_touch::pushEvent(const TouchEvent &event)
+{
+    uint32_t head = _eventHead.load(std::memory_order_relaxed);
+    uint32_t tail = _eventTail.load(std::memory_order_acquire);
+
+    if (head - tail >= TOUCH_EVENT_RING_SIZE)
+    {
+        _eventsDropped++;
+        return false;
+    }
+
+    _events[head & (TOUCH_EVENT_RING_SIZE - 1)] = event;
+    _eventHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool EARS_HOT EARS_touch::popEvent(TouchEvent &event)
+{
+    uint32_t tail = _eventTail.load(std::memory_order_relaxed);
+    uint32_t head = _eventHead.load(std::memory_order_acquire);
+
+    if (tail == head)
+        return false;
+
+    event = _events[tail & (TOUCH_EVENT_RING_SIZE - 1)];
+    _eventTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool EARS_HOT EARS_touch::readSample(TouchEvent &event)
+{
+    uint8_t buffer[FT6X36_SAMPLE_BURST_LEN];
+
+    // REG 0x01-0x06: gesture, status and first touch point in one burst
+    if (readRegisters(FT6X36_REG_GEST, buffer, FT6X36_SAMPLE_BURST_LEN) != FT6X36_SAMPLE_BURST_LEN)
+        return false;
+
+    event.timestampUs = (uint32_t)esp_timer_get_time();
+    event.inputUs = stampInput(event.timestampUs);
+    event.gesture = decodeGesture(buffer[0]);
+
+    uint8_t numPoints = buffer[1] & 0x0F;
+    if (numPoints == 0 || numPoints == 0x0F)
+    {
+        int16_t x = _lastX;
+        int16_t y = _lastY;
+        // A release still being confirmed reports the held position
+        event.points = filterSample(event.timestampUs, false, x, y) ? 1 : 0;
+        event.x = x;
+        event.y = y;
+        event.x2 = x;
+        event.y2 = y;
+        return true;
+    }
+
+    int16_t rawX = ((buffer[2] & 0x0F) << 8) | buffer[3];
+    int16_t rawY = ((buffer[4] & 0x0F) << 8) | buffer[5];
+
+    int16_t dispX, dispY;
+    mapPoint(rawX, rawY, dispX, dispY);
+    event.x2 = dispX;
+    event.y2 = dispY;
+
+#if EARS_TOUCH_TRACE == 1
+    recordTrace(rawX, rawY, dispX, dispY);
+#endif
+
+    if (!filterSample(event.timestampUs, true, dispX, dispY))
+    {
+        // Press not confirmed yet
+        event.points = 0;
+        event.x = _lastX;
+        event.y = _lastY;
+        return true;
+    }
+
+    event.points = numPoints;
+    event.x = dispX;
+    event.y = dispY;
+
+    // REG 0x09-0x0C: second touch point, only when reported
+    if (numPoints == 2)
+    {
+        uint8_t point2[FT6X36_POINT2_BURST_LEN];
+        if (readRegisters(FT6X36_REG_TOUCH2_XH, point2, FT6X36_POINT2_BURST_LEN) == FT6X36_POINT2_BURST_LEN)
+        {
+            mapPoint(((point2[0] & 0x0F) << 8) | point2[1], ((point2[2] & 0x0F) << 8) | point2[3],
+                     event.x2, event.y2);
+        }
+        else
+        {
+            event.points = 1;
+        }
+    }
+
+    // Only point 1 is filtered; keep the second on its raw path
+    if (event.points < 2)
+    {
+        event.x2 = event.x;
+        event.y2 = event.y;
+    }
+
+    return true;
+}
+
+void EARS_touch::samplingTask(void *parameter)
+{
+    EARS_touch *touch = static_cast<EARS_touch *>(parameter);
+
+    while (1)
+    {
+        // Period follows the scan level set by the UI task
+        const TickType_t xPeriod = pdMS_TO_TICKS(touch->_samplePeriodMs);
+
+        // Idle in interrupt mode: sleep until INT; otherwise pace by period
+        if (touch->isInterruptEnabled() && !touch->_lastPressed && touch->_filter.pressCount == 0)
+        {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+        else
+        {
+            ulTaskNotifyTake(pdTRUE, xPeriod);
+        }
+        _dataReady = false;
+
+        TouchEvent event;
+        if (!touch->readSample(event))
+            continue;
+
+        bool pressed = (event.points > 0);
+
+        // Only queue changes: presses, moves and the release edge
+        if (pressed || touch->_lastPressed)
+        {
+            if (pressed != touch->_lastPressed)
+            {
+                using_eventbus().post(pressed ? EVENT_TOUCH_PRESS : EVENT_TOUCH_RELEASE,
+                                      ((uint32_t)event.x << 16) | (uint16_t)event.y);
+            }
+
+            touch->_lastPressed = pressed;
+            touch->_lastX = event.x;
+            touch->_lastY = event.y;
+
+            if (touch->_sampleHook)
+            {
+                touch->_sampleHook(event);
+            }
+            touch->pushEvent(event);
+            if (touch->_eventCallback)
+            {
+                touch->_eventCallback();
+            }
+        }
+    }
+}
+
+void EARS_HOT EARS_touch::lvgl_touch_read(lv_indev_t *indev, lv_indev_data_t *data)
 {
     EARS_touch *touch = getInstance();
 
@@ -280,75 +776,368 @@ void EARS_touch::lvgl_touch_read(lv_indev_t *indev, lv_indev_data_t *data)
         return;
     }
 
+    // Sampling task mode: drain one buffered event per read
+    if (touch->isSamplingTaskRunning())
+    {
+        TouchEvent event;
+        if (touch->popEvent(event))
+        {
+            touch->_lastEvent = event;
+            touch->_lastInputUs = event.inputUs;
+        }
+
+        data->state = (touch->_lastEvent.points > 0) ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+        data->point.x = touch->_lastEvent.x;
+        data->point.y = touch->_lastEvent.y;
+        data->continue_reading = (touch->_eventTail.load() != touch->_eventHead.load());
+
+        if (touch->_readHook)
+        {
+            touch->_readHook();
+        }
+        return;
+    }
+
+    // Interrupt mode: nothing new since the last release, skip the I2C read
+    if (!touch->hasPendingData())
+    {
+        data->state = LV_INDEV_STATE_RELEASED;
+        data->point.x = touch->_lastX;
+        data->point.y = touch->_lastY;
+        return;
+    }
+    _dataReady = false;
+
     int16_t x[2], y[2];
     uint8_t touchCount = touch->getPoint(x, y);
+    touch->_lastInputUs = touch->stampInput((uint32_t)esp_timer_get_time());
 
+    // Touch panel reports in portrait; map to the display rotation
+    int16_t dispX = touch->_lastX;
+    int16_t dispY = touch->_lastY;
     if (touchCount > 0)
+    {
+        touch->mapPoint(x[0], y[0], dispX, dispY);
+#if EARS_TOUCH_TRACE == 1
+        touch->recordTrace(x[0], y[0], dispX, dispY);
+#endif
+    }
+
+    if (touch->filterSample(touch->_lastInputUs, touchCount > 0, dispX, dispY))
     {
         data->state = LV_INDEV_STATE_PRESSED;
+        data->point.x = dispX;
+        data->point.y = dispY;
 
-        // Standard rotation 1 (90° clockwise) transformation
-        // Touch panel reports in portrait: X=[0-319], Y=[0-479]
-        // Display is landscape: width=480, height=320
-        // Transform: new_x = old_y, new_y = 319 - old_x
-        data->point.x = y[0];
-        data->point.y = 319 - x[0];
+        if (!touch->_lastPressed)
+        {
+            using_eventbus().post(EVENT_TOUCH_PRESS, ((uint32_t)data->point.x << 16) | (uint16_t)data->point.y);
+        }
 
-#if EARS_DEBUG == 1
-        Serial.printf("[TOUCH DEBUG] Touch X=%d Y=%d → Display X=%d Y=%d\n",
-                      x[0], y[0], data->point.x, data->point.y);
-#endif
+        touch->_lastPressed = true;
+        touch->_lastX = data->point.x;
+        touch->_lastY = data->point.y;
     }
     else
     {
         data->state = LV_INDEV_STATE_RELEASED;
+        data->point.x = touch->_lastX;
+        data->point.y = touch->_lastY;
+
+        if (touch->_lastPressed)
+        {
+            using_eventbus().post(EVENT_TOUCH_RELEASE, ((uint32_t)touch->_lastX << 16) | (uint16_t)touch->_lastY);
+        }
+
+        touch->_lastPressed = false;
     }
 }
 
-uint8_t EARS_touch::readRegister(uint8_t reg) const
+void EARS_touch::setReadMode(TouchReadMode mode)
 {
-    if (!_wire)
-        return 0xFF;
+    _readMode = mode;
+}
+
+TouchReadMode EARS_touch::getReadMode() const
+{
+    return _readMode;
+}
+
+void EARS_touch::setRotation(uint8_t rotation)
+{
+    _rotation = rotation & 0x03;
+    _transform = touch_transforms[_rotation];
+}
 
-    _wire->beginTransmission(_address);
-    _wire->write(reg);
-    if (_wire->endTransmission(false) != 0)
+uint8_t EARS_touch::getRotation() const
+{
+    return _rotation;
+}
+
+void EARS_touch::setFilterConfig(const TouchFilterConfig &config)
+{
+    _filterNext = config;
+    _filterChanged.store(true, std::memory_order_release);
+}
+
+TouchFilterConfig EARS_touch::getFilterConfig() const
+{
+    return _filterChanged.load(std::memory_order_acquire) ? _filterNext : _filterConfig;
+}
+
+/**
+ * @brief Run one sample through the enabled input processing stages
+ * @param timeUs Sample time
+ * @param pressed Controller reports a touch
+ * @param x Display X in, processed X out (held position when released)
+ * @param y Display Y in, processed Y out
+ * @return Debounced pressed state
+ */
+bool EARS_HOT EARS_touch::filterSample(uint32_t timeUs, bool pressed, int16_t &x, int16_t &y)
+{
+    FilterState &f = _filter;
+
+    if (_filterChanged.load(std::memory_order_acquire))
+    {
+        _filterConfig = _filterNext;
+        _filterChanged.store(false, std::memory_order_relaxed);
+        f.tracking = false;
+    }
+    const TouchFilterConfig &config = _filterConfig;
+
+    // Debounce: a press or release takes effect after enough samples
+    uint8_t pressSamples = 1;
+    uint8_t releaseSamples = 1;
+    if (config.stages & TOUCH_STAGE_DEBOUNCE)
+    {
+        pressSamples = config.pressSamples ? config.pressSamples : 1;
+        releaseSamples = config.releaseSamples ? config.releaseSamples : 1;
+    }
+
+    if (!pressed)
+    {
+        f.pressCount = 0;
+        if (!f.pressed)
+        {
+            return false;
+        }
+        if (++f.releaseCount >= releaseSamples)
+        {
+            f.pressed = false;
+            f.tracking = false;
+        }
+        // Held, and finally released, at the last unpredicted position
+        x = f.outX;
+        y = f.outY;
+        return f.pressed;
+    }
+
+    f.releaseCount = 0;
+    if (!f.pressed)
+    {
+        if (++f.pressCount < pressSamples)
+        {
+            return false;
+        }
+        f.pressed = true;
+        f.pressCount = 0;
+    }
+
+    if (!f.tracking)
+    {
+        // First sample of a press: every stage starts from it
+        f.tracking = true;
+        f.medianCount = 0;
+        f.xQ4 = (int32_t)x << 4;
+        f.yQ4 = (int32_t)y << 4;
+        f.vx = 0;
+        f.vy = 0;
+        f.outX = x;
+        f.outY = y;
+        f.lastUs = timeUs;
+    }
+
+    // Median of 3: a single-sample spike never reaches the output
+    if (config.stages & TOUCH_STAGE_MEDIAN)
+    {
+        if (f.medianCount < 3)
+        {
+            f.medianCount++;
+        }
+        f.medianX[2] = f.medianX[1];
+        f.medianY[2] = f.medianY[1];
+        f.medianX[1] = f.medianX[0];
+        f.medianY[1] = f.medianY[0];
+        f.medianX[0] = x;
+        f.medianY[0] = y;
+        if (f.medianCount == 3)
+        {
+            x = LV_MAX(LV_MIN(f.medianX[0], f.medianX[1]), LV_MIN(LV_MAX(f.medianX[0], f.medianX[1]), f.medianX[2]));
+            y = LV_MAX(LV_MIN(f.medianY[0], f.medianY[1]), LV_MIN(LV_MAX(f.medianY[0], f.medianY[1]), f.medianY[2]));
+        }
+    }
+
+    // Sample interval, bounded for the velocity and so dt << 16 fits
+    uint32_t dtUs = timeUs - f.lastUs;
+    f.lastUs = timeUs;
+    if (dtUs < 1000)
+        dtUs = 1000;
+    else if (dtUs > 50000)
+        dtUs = 50000;
+
+    int32_t xQ4 = (int32_t)x << 4;
+    int32_t yQ4 = (int32_t)y << 4;
+
+    // Velocity in px/s: (1/16 px) * 62500 / us, within 32 bits
+    int32_t rawVx = LV_CLAMP(-TOUCH_FILTER_MAX_SPEED, (xQ4 - f.xQ4) * 62500 / (int32_t)dtUs, TOUCH_FILTER_MAX_SPEED);
+    int32_t rawVy = LV_CLAMP(-TOUCH_FILTER_MAX_SPEED, (yQ4 - f.yQ4) * 62500 / (int32_t)dtUs, TOUCH_FILTER_MAX_SPEED);
+
+    // Low-pass factor in Q16 for a cutoff in Q8 Hz: dt / (dt + 1 / (2 pi fc))
+    // 1e6 * 256 / (2 pi) = 40743665
+    uint32_t tauUs = 40743665UL / TOUCH_FILTER_DCUTOFF_Q8;
+    int32_t alphaD = (int32_t)(((uint32_t)dtUs << 16) / (dtUs + tauUs));
+    f.vx += (alphaD * (rawVx - f.vx)) >> 16;
+    f.vy += (alphaD * (rawVy - f.vy)) >> 16;
+
+    // One-euro: the cutoff rises with speed, steady at rest and quick moving
+    if (config.stages & TOUCH_STAGE_ONE_EURO)
+    {
+        int32_t speed = LV_MAX(LV_ABS(f.vx), LV_ABS(f.vy));
+        uint32_t cutoffQ8 = config.minCutoffQ8 + (((uint32_t)config.betaQ16 * (uint32_t)speed) >> 8);
+        if (cutoffQ8 == 0)
+        {
+            cutoffQ8 = 1;
+        }
+        tauUs = 40743665UL / cutoffQ8;
+        int32_t alpha = (int32_t)(((uint32_t)dtUs << 16) / (dtUs + tauUs));
+        f.xQ4 += (alpha * (xQ4 - f.xQ4)) >> 16;
+        f.yQ4 += (alpha * (yQ4 - f.yQ4)) >> 16;
+    }
+    else
+    {
+        f.xQ4 = xQ4;
+        f.yQ4 = yQ4;
+    }
+
+    int16_t outX = (int16_t)((f.xQ4 + 8) >> 4);
+    int16_t outY = (int16_t)((f.yQ4 + 8) >> 4);
+
+    // Deadband: LVGL sees no movement, and invalidates nothing, for jitter
+    if (config.stages & TOUCH_STAGE_DEADBAND)
+    {
+        if (LV_ABS(outX - f.outX) <= config.deadbandPx && LV_ABS(outY - f.outY) <= config.deadbandPx)
+        {
+            outX = f.outX;
+            outY = f.outY;
+        }
+    }
+    f.outX = outX;
+    f.outY = outY;
+
+    // Prediction: about one frame ahead along the smoothed velocity
+    if (config.stages & TOUCH_STAGE_PREDICT)
+    {
+        int32_t maxPx = config.predictMaxPx;
+        int32_t dx = LV_CLAMP(-maxPx, f.vx * (int32_t)config.predictUs / 1000000L, maxPx);
+        int32_t dy = LV_CLAMP(-maxPx, f.vy * (int32_t)config.predictUs / 1000000L, maxPx);
+        int32_t width = (_rotation & 1) ? TOUCH_PANEL_HEIGHT : TOUCH_PANEL_WIDTH;
+        int32_t height = (_rotation & 1) ? TOUCH_PANEL_WIDTH : TOUCH_PANEL_HEIGHT;
+        outX = (int16_t)LV_CLAMP(0, outX + dx, width - 1);
+        outY = (int16_t)LV_CLAMP(0, outY + dy, height - 1);
+    }
+
+    x = outX;
+    y = outY;
+    return true;
+}
+
+void EARS_touch::mapPoint(int16_t rawX, int16_t rawY, int16_t &x, int16_t &y) const
+{
+    x = _transform.xx * rawX + _transform.xy * rawY + _transform.x0;
+    y = _transform.yx * rawX + _transform.yy * rawY + _transform.y0;
+}
+
+#if EARS_TOUCH_TRACE == 1
+void EARS_touch::recordTrace(int16_t rawX, int16_t rawY, int16_t dispX, int16_t dispY)
+{
+    uint16_t head = _traceHead;
+    TraceSample &sample = _trace[head & (TOUCH_TRACE_SIZE - 1)];
+    sample.timeMs = millis();
+    sample.rawX = rawX;
+    sample.rawY = rawY;
+    sample.dispX = dispX;
+    sample.dispY = dispY;
+    _traceHead = head + 1;
+}
+#endif
+
+void EARS_touch::flushTrace()
+{
+#if EARS_TOUCH_TRACE == 1
+    uint32_t now = millis();
+    if (now - _traceLastFlushMs < TOUCH_TRACE_MIN_INTERVAL_MS)
+        return;
+    _traceLastFlushMs = now;
+
+    uint16_t head = _traceHead;
+    uint16_t pending = head - _traceTail;
+    if (pending > TOUCH_TRACE_SIZE)
+    {
+        // Writer lapped us, skip to the oldest sample still in the ring
+        _traceDropped += pending - TOUCH_TRACE_SIZE;
+        _traceTail = head - TOUCH_TRACE_SIZE;
+        pending = TOUCH_TRACE_SIZE;
+    }
+
+    uint8_t printed = 0;
+    while (_traceTail != head && printed < TOUCH_TRACE_MAX_PER_FLUSH)
+    {
+        const TraceSample &sample = _trace[_traceTail & (TOUCH_TRACE_SIZE - 1)];
+        using_trace().printf("[TOUCH DEBUG] %lu ms Touch X=%d Y=%d → Display X=%d Y=%d\n",
+                             (unsigned long)sample.timeMs, sample.rawX, sample.rawY, sample.dispX, sample.dispY);
+        _traceTail++;
+        printed++;
+    }
+
+    if (_traceTail != head || _traceDropped > 0)
+    {
+        using_trace().printf("[TOUCH DEBUG] %u pending, %lu dropped\n",
+                             (unsigned)(uint16_t)(head - _traceTail), (unsigned long)_traceDropped);
+        _traceDropped = 0;
+    }
+#endif
+}
+
+uint8_t EARS_HOT EARS_touch::readRegister(uint8_t reg) const
+{
+    uint8_t value = 0xFF;
+    if (_device == I2C_DEVICE_NONE)
         return 0xFF;
 
-    if (_wire->requestFrom(_address, (uint8_t)1) != 1)
+    if (using_i2cBus().readRegisters(_device, reg, &value, 1) != ESP_OK)
         return 0xFF;
 
-    return _wire->read();
+    return value;
 }
 
-uint8_t EARS_touch::readRegisters(uint8_t reg, uint8_t *buffer, uint8_t length) const
+uint8_t EARS_HOT EARS_touch::readRegisters(uint8_t reg, uint8_t *buffer, uint8_t length) const
 {
-    if (!_wire || !buffer)
+    if (_device == I2C_DEVICE_NONE || !buffer)
         return 0;
 
-    _wire->beginTransmission(_address);
-    _wire->write(reg);
-    if (_wire->endTransmission(false) != 0)
+    // Repeated-start burst: all of it or nothing
+    if (using_i2cBus().readRegisters(_device, reg, buffer, length) != ESP_OK)
         return 0;
 
-    uint8_t bytesRead = _wire->requestFrom(_address, length);
-    for (uint8_t i = 0; i < bytesRead; i++)
-    {
-        buffer[i] = _wire->read();
-    }
-
-    return bytesRead;
+    return length;
 }
 
 void EARS_touch::writeRegister(uint8_t reg, uint8_t value)
 {
-    if (!_wire)
+    if (_device == I2C_DEVICE_NONE)
         return;
 
-    _wire->beginTransmission(_address);
-    _wire->write(reg);
-    _wire->write(value);
-    _wire->endTransmission();
+    using_i2cBus().writeRegister(_device, reg, value);
 }
 
 /******************************************************************************
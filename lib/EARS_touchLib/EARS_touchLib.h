@@ -2,8 +2,8 @@
  * @file EARS_touchLib.h
  * @author JTB & Claude Sonnet 4.5
  * @brief Touch controller library for FT6236U/FT3267 chip
- * @version 2.0.0
- * @date 20260210
+ * @version 2.13.0
+ * @date 20261015
  *
  * @details
  * Touch controller library for Waveshare ESP32-S3 Touch LCD 3.5"
@@ -16,6 +16,66 @@
  * - I2C Pins: SDA=8, SCL=7
  * - Vendor: FocalTech (ID: 0x11)
  * - Maximum Touch Points: 2
+ * - Interrupt: TOUCH_INT (GPIO 18), trigger mode, falling edge
+ *
+ * INTERRUPT MODE:
+ * When enabled the INT falling edge latches a data-ready flag and
+ * lvgl_touch_read skips the I2C transaction while the panel is idle.
+ * Every edge also bumps an interrupt counter that power management uses
+ * to detect a wake touch without reading the controller.
+ *
+ * EVENT BUS:
+ * Press and release edges (not moves) are posted as EVENT_TOUCH_PRESS and
+ * EVENT_TOUCH_RELEASE with value = x << 16 | y in display coordinates.
+ *
+ * ROTATION:
+ * Raw points are mapped to display coordinates through a TouchTransform
+ * picked from a table by setRotation(), kept in step with the panel's
+ * MADCTL rotation by MAIN_display_set_orientation().
+ *
+ * READ MODES:
+ * TOUCH_READ_FAST (default) reads STATUS plus point 1 in one 5-byte burst
+ * and only fetches point 2 when two touches are reported. TOUCH_READ_FULL
+ * keeps the original 16-byte dump from REG_MODE.
+ *
+ * SAMPLING TASK:
+ * startSamplingTask() moves I2C sampling off the LVGL thread. A dedicated
+ * task pushes timestamped TouchEvent records (position, point count,
+ * gesture) into a lock-free single-producer/single-consumer ring and
+ * lvgl_touch_read drains it, one event per indev read. The reader, the
+ * ring and the register reads run from IRAM (EARS_HOT).
+ *
+ * INPUT PROCESSING:
+ * Each sample goes through a fixed-point stage after the display mapping,
+ * on whichever side reads the controller: press/release debounce, a
+ * median-of-3 spike filter, a one-euro adaptive low-pass, a deadband that
+ * stops sub-pixel jitter invalidating areas, and linear prediction about
+ * one frame ahead. Stages are enabled per flag in TouchFilterConfig.
+ *
+ * GESTURES:
+ * Events carry both points; the second is read only while two touches are
+ * reported. setSampleHook() sees each event on the sampling task and
+ * setReadHook() runs after each indev read, which is how EARS_gestureLib
+ * recognises gestures off the LVGL thread and delivers them on it.
+ *
+ * I2C BUS:
+ * The controller is a high priority device on the shared EARS_i2cBus, so
+ * its reads are taken ahead of any queued expander, sensor or RTC
+ * transaction and never wait behind more than the one on the wire.
+ *
+ * SCAN RATE:
+ * The controller's report rate follows the UI: updateScanRate(), called
+ * by the refresh governor every UI pass, raises FT6X36_REG_PERIOD_ACTIVE
+ * to TOUCH_PERIOD_ACTIVE_TRACKING while a drag or scroll is under way,
+ * keeps the rate read at begin() otherwise, and puts the controller in
+ * monitor mode when the UI is idle and nothing is touched. Registers are
+ * written only on a change of level, and the sampling task's period
+ * follows the level.
+ *
+ * DEBUG TRACE:
+ * With EARS_TOUCH_TRACE enabled, samples are recorded in a RAM ring buffer
+ * by lvgl_touch_read and printed later, rate limited, by flushTrace(),
+ * which hands the lines to the EARS_traceLib emitter task.
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -28,9 +88,14 @@
  * Includes
  *****************************************************************************/
 #include <Arduino.h>
-#include <Wire.h>
 #include <lvgl.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include "EARS_versionDef.h"
+#include "EARS_taskPlanLib.h"
+#include "EARS_eventBusLib.h"
+#include "EARS_i2cBusLib.h"
 
 /******************************************************************************
  * Library Version Information
@@ -39,9 +104,9 @@ namespace EARS_Touch
 {
     constexpr const char *LIB_NAME = "EARS_Touch";
     constexpr const char *VERSION_MAJOR = "2";
-    constexpr const char *VERSION_MINOR = "0";
+    constexpr const char *VERSION_MINOR = "13";
     constexpr const char *VERSION_PATCH = "0";
-    constexpr const char *VERSION_DATE = "2026-02-10";
+    constexpr const char *VERSION_DATE = "2026-10-15";
 }
 
 /******************************************************************************
@@ -61,6 +126,7 @@ namespace EARS_Touch
 #define FT6X36_REG_THRESHOLD 0x80
 #define FT6X36_REG_PERIOD_ACTIVE 0x88
 #define FT6X36_REG_PERIOD_MONITOR 0x89
+#define FT6X36_REG_INT_MODE 0xA4
 #define FT6X36_REG_POWER_MODE 0xA5
 #define FT6X36_REG_FIRM_VERS 0xA6
 #define FT6X36_REG_CHIP_ID 0xA3
@@ -80,6 +146,83 @@ namespace EARS_Touch
 #define FT6236U_CHIP_ID 0x64 // Also FT3267
 #define FT3267_CHIP_ID 0x64
 
+// Interrupt modes (FT6X36_REG_INT_MODE)
+#define FT6X36_INT_POLLING 0x00 // INT held low while touched
+#define FT6X36_INT_TRIGGER 0x01 // INT pulses once per new report
+
+// Burst lengths for the fast read path
+#define FT6X36_POINT1_BURST_LEN 5 // STATUS + TOUCH1 XH/XL/YH/YL (0x02-0x06)
+#define FT6X36_POINT2_BURST_LEN 4 // TOUCH2 XH/XL/YH/YL (0x09-0x0C)
+#define FT6X36_SAMPLE_BURST_LEN 6 // GEST + STATUS + TOUCH1 (0x01-0x06)
+
+// Device settings on the shared I2C bus
+#define TOUCH_I2C_CLOCK_HZ 400000 // Fast mode
+#define TOUCH_I2C_TIMEOUT_MS 10   // Longest a read may hold the bus
+
+/******************************************************************************
+ * Sampling Task Configuration
+ *****************************************************************************/
+#define TOUCH_SAMPLING_TASK_ENABLED 1 // 1 = MAIN_initialise_touch starts the task
+#define TOUCH_TASK_STACK_SIZE 3072    // Stack size (in words, not bytes)
+#define TOUCH_TASK_PRIORITY using_taskplan().priority(TASK_ROLE_TOUCH) // Above flush and background tasks
+#define TOUCH_TASK_CORE using_taskplan().core(TASK_ROLE_TOUCH)
+#define TOUCH_SAMPLE_PERIOD_MS 10     // Sample rate while pressed (100Hz)
+#define TOUCH_EVENT_RING_SIZE 32      // Buffered events (power of two)
+
+/******************************************************************************
+ * Scan Rate Configuration
+ *****************************************************************************/
+// FT6X36_REG_PERIOD_ACTIVE report rate codes (datasheet range 4-14, higher is faster)
+#define TOUCH_PERIOD_ACTIVE_MIN 4
+#define TOUCH_PERIOD_ACTIVE_TRACKING 14 // Drags and scrolls
+#define TOUCH_PERIOD_ACTIVE_DEFAULT 6   // When begin() reads a code out of range
+
+// Sampling task period per level (polled; with INT the edges pace it)
+#define TOUCH_SAMPLE_TRACKING_MS 8    // Drags and scrolls (125Hz)
+#define TOUCH_SAMPLE_IDLE_MS 50       // Monitor mode (20Hz)
+
+// Panel geometry: the FT6236U reports in the ST7796's native portrait frame
+#define TOUCH_PANEL_WIDTH 320  // Raw X range 0-319
+#define TOUCH_PANEL_HEIGHT 480 // Raw Y range 0-479
+#define TOUCH_DEFAULT_ROTATION 1 // Matches Arduino_GFX setRotation(1), landscape
+
+/******************************************************************************
+ * Input Processing Configuration
+ *****************************************************************************/
+// Stages applied to each sample after the display mapping (in this order)
+#define TOUCH_STAGE_DEBOUNCE 0x01 // Confirm press and release over several samples
+#define TOUCH_STAGE_MEDIAN 0x02   // Median of the last 3 positions: drops spikes
+#define TOUCH_STAGE_ONE_EURO 0x04 // Adaptive low-pass: steady at rest, little lag moving
+#define TOUCH_STAGE_DEADBAND 0x08 // Hold the output until it moves deadbandPx
+#define TOUCH_STAGE_PREDICT 0x10  // Extrapolate along the filtered velocity
+
+#define TOUCH_FILTER_DEFAULT_STAGES (TOUCH_STAGE_DEBOUNCE | TOUCH_STAGE_ONE_EURO | TOUCH_STAGE_DEADBAND | TOUCH_STAGE_PREDICT)
+#define TOUCH_FILTER_PRESS_SAMPLES 1     // Pressed samples before a press
+#define TOUCH_FILTER_RELEASE_SAMPLES 2   // Released samples before a release
+#define TOUCH_FILTER_MIN_CUTOFF_Q8 256   // One-euro cutoff at rest, Hz in Q8 (1 Hz)
+#define TOUCH_FILTER_BETA_Q16 655        // One-euro cutoff per px/s, Q16 (0.01)
+#define TOUCH_FILTER_DCUTOFF_Q8 1280     // Velocity smoothing cutoff, Hz in Q8 (5 Hz, also drives prediction)
+#define TOUCH_FILTER_DEADBAND_PX 1       // Movement that changes the output
+#define TOUCH_FILTER_PREDICT_US 16000    // Prediction lead, about one frame
+#define TOUCH_FILTER_PREDICT_MAX_PX 24   // Largest prediction offset
+#define TOUCH_FILTER_MAX_SPEED 20000     // px/s clamp keeping the maths in 32 bits
+
+/******************************************************************************
+ * Debug Trace Configuration
+ *****************************************************************************/
+// Trace ring buffer is compiled in for debug builds only
+#ifndef EARS_TOUCH_TRACE
+#if EARS_DEBUG == 1
+#define EARS_TOUCH_TRACE 1
+#else
+#define EARS_TOUCH_TRACE 0
+#endif
+#endif
+
+#define TOUCH_TRACE_SIZE 32          // Samples held in the ring (power of two)
+#define TOUCH_TRACE_MAX_PER_FLUSH 8  // Lines printed per flushTrace() call
+#define TOUCH_TRACE_MIN_INTERVAL_MS 250 // Minimum time between flushTrace() prints
+
 /******************************************************************************
  * Touch State Enum
  *****************************************************************************/
@@ -108,6 +251,19 @@ enum TouchGesture
     GESTURE_ZOOM_OUT
 };
 
+/******************************************************************************
+ * Touch Read Mode Enum
+ *****************************************************************************/
+/**
+ * @enum TouchReadMode
+ * @brief Register read strategy used by getPoint()
+ */
+enum TouchReadMode
+{
+    TOUCH_READ_FAST = 0, // STATUS + in-use point registers only
+    TOUCH_READ_FULL      // 16-byte burst from REG_MODE
+};
+
 /******************************************************************************
  * Touch Power Mode Enum
  *****************************************************************************/
@@ -122,6 +278,88 @@ enum TouchPowerMode
     POWER_DEEP_SLEEP = 3 // ~100uA (reset pin must be pulled down to wake)
 };
 
+/******************************************************************************
+ * Touch Scan Level Enum
+ *****************************************************************************/
+/**
+ * @enum TouchScanLevel
+ * @brief Controller scan rate, picked by updateScanRate()
+ */
+enum TouchScanLevel
+{
+    TOUCH_SCAN_NORMAL = 0, // Active, report rate read at begin()
+    TOUCH_SCAN_TRACKING,   // Active, TOUCH_PERIOD_ACTIVE_TRACKING
+    TOUCH_SCAN_IDLE,       // Monitor mode
+    TOUCH_SCAN_UNKNOWN     // Power mode set directly (setPowerMode)
+};
+
+/******************************************************************************
+ * Touch Event Structure
+ *****************************************************************************/
+/**
+ * @struct TouchEvent
+ * @brief One timestamped sample produced by the sampling task
+ */
+struct TouchEvent
+{
+    uint32_t timestampUs; // esp_timer time of the I2C sample (low 32 bits)
+    uint32_t inputUs;     // INT edge that announced it, else timestampUs
+    int16_t x;            // Display X (current rotation)
+    int16_t y;            // Display Y (current rotation)
+    int16_t x2;           // Second point display X (points == 2, else x)
+    int16_t y2;           // Second point display Y (points == 2, else y)
+    uint8_t points;       // Points reported (0 = released)
+    TouchGesture gesture; // Gesture code decoded from REG_GEST
+};
+
+/******************************************************************************
+ * Touch Filter Configuration Structure
+ *****************************************************************************/
+/**
+ * @struct TouchFilterConfig
+ * @brief Input processing stages and their parameters
+ */
+struct TouchFilterConfig
+{
+    uint8_t stages;         // TOUCH_STAGE_* flags
+    uint8_t pressSamples;   // Debounce: pressed samples before a press
+    uint8_t releaseSamples; // Debounce: released samples before a release
+    uint8_t deadbandPx;     // Deadband: movement that changes the output
+    uint16_t minCutoffQ8;   // One-euro: cutoff at rest, Hz Q8
+    uint16_t betaQ16;       // One-euro: cutoff gain per px/s, Q16
+    uint16_t predictUs;     // Prediction: lead time
+    uint8_t predictMaxPx;   // Prediction: largest offset
+
+    TouchFilterConfig() : stages(TOUCH_FILTER_DEFAULT_STAGES),
+                          pressSamples(TOUCH_FILTER_PRESS_SAMPLES),
+                          releaseSamples(TOUCH_FILTER_RELEASE_SAMPLES),
+                          deadbandPx(TOUCH_FILTER_DEADBAND_PX),
+                          minCutoffQ8(TOUCH_FILTER_MIN_CUTOFF_Q8),
+                          betaQ16(TOUCH_FILTER_BETA_Q16),
+                          predictUs(TOUCH_FILTER_PREDICT_US),
+                          predictMaxPx(TOUCH_FILTER_PREDICT_MAX_PX) {}
+};
+
+/******************************************************************************
+ * Touch Transform Structure
+ *****************************************************************************/
+/**
+ * @struct TouchTransform
+ * @brief Raw panel to display coordinate mapping for one rotation
+ * @details x = xx * rawX + xy * rawY + x0, y = yx * rawX + yy * rawY + y0.
+ *          Coefficients are -1, 0 or 1: each rotation is a quarter turn
+ *          plus offset, looked up once instead of branching per sample.
+ */
+struct TouchTransform
+{
+    int8_t xx;  // rawX weight in display X
+    int8_t xy;  // rawY weight in display X
+    int16_t x0; // Display X offset
+    int8_t yx;  // rawX weight in display Y
+    int8_t yy;  // rawY weight in display Y
+    int16_t y0; // Display Y offset
+};
+
 /******************************************************************************
  * Touch Initialization Result Structure
  *****************************************************************************/
@@ -146,6 +384,7 @@ struct TouchInitResult
     uint8_t sclPin;          // SCL pin number
     uint8_t maxTouchPoints;  // Maximum simultaneous touch points
     bool lvglRegistered;     // LVGL input device registered
+    bool interruptEnabled;   // TOUCH_INT data-ready interrupt active
 
     TouchInitResult() : state(TOUCH_NOT_INITIALIZED),
                         chipID(0),
@@ -156,7 +395,8 @@ struct TouchInitResult
                         sdaPin(0),
                         sclPin(0),
                         maxTouchPoints(0),
-                        lvglRegistered(false) {}
+                        lvglRegistered(false),
+                        interruptEnabled(false) {}
 };
 
 /******************************************************************************
@@ -176,14 +416,15 @@ public:
 
     /**
      * @brief Initialize touch controller
-     * @param wire I2C bus instance
+     * @details Starts the shared I2C bus on sda/scl if nothing has yet and
+     *          registers the controller on it.
      * @param sda I2C SDA pin number
      * @param scl I2C SCL pin number
      * @param address I2C device address
      * @return true if initialization successful
      * @return false if initialization failed
      */
-    bool begin(TwoWire &wire = Wire, uint8_t sda = 8, uint8_t scl = 7, uint8_t address = FT6X36_SLAVE_ADDRESS);
+    bool begin(uint8_t sda = 8, uint8_t scl = 7, uint8_t address = FT6X36_SLAVE_ADDRESS);
 
     bool isAvailable() const;
     TouchState getState() const;
@@ -200,6 +441,140 @@ public:
      */
     uint8_t getPoint(int16_t *x, int16_t *y);
 
+    /**
+     * @brief Start the dedicated touch sampling task
+     * @param core CPU core to pin the task to
+     * @param priority FreeRTOS task priority
+     * @return true if the task is running
+     * @return false if the controller is not ready or task creation failed
+     *
+     * @details
+     * Once running, the task does all touch reads: lvgl_touch_read only drains
+     * the event ring. In interrupt mode the task sleeps until INT fires and
+     * samples every TOUCH_SAMPLE_PERIOD_MS while pressed; otherwise it
+     * samples at that period continuously.
+     */
+    bool startSamplingTask(uint8_t core = TOUCH_TASK_CORE, uint8_t priority = TOUCH_TASK_PRIORITY);
+
+    /**
+     * @brief Check if the sampling task is running
+     * @return true if events come from the sampling task
+     */
+    bool isSamplingTaskRunning() const;
+
+    /**
+     * @brief Register a function called (task context) after each new event
+     * @param callback Function to call, NULL to clear
+     *
+     * @details
+     * Typically wakes the UI task so the event is consumed promptly.
+     */
+    void setEventCallback(void (*callback)(void));
+
+    /**
+     * @brief Register a function given each new event (sampling task)
+     * @param hook Function to call before the event is queued, NULL to clear
+     *
+     * @details
+     * Sees every press, move and release edge with both points; used by
+     * EARS_gestureLib to recognise gestures where the samples are made.
+     */
+    void setSampleHook(void (*hook)(const TouchEvent &event));
+
+    /**
+     * @brief Register a function called after each indev read (LVGL task)
+     * @param hook Function to call, NULL to clear
+     */
+    void setReadHook(void (*hook)(void));
+
+    /**
+     * @brief Pop the oldest buffered event (consumer side)
+     * @param event Destination for the event
+     * @return true if an event was returned
+     */
+    bool popEvent(TouchEvent &event);
+
+    /**
+     * @brief Get number of events dropped because the ring was full
+     * @return Dropped event count since start
+     */
+    uint32_t getDroppedEvents() const;
+
+    /**
+     * @brief Get the input time of the sample last handed to LVGL
+     * @return esp_timer time (low 32 bits) of its INT edge, or of its I2C
+     *         read when no edge announced it
+     * @note Start point of the touch-to-photon latency probe.
+     */
+    uint32_t getLastInputUs() const;
+
+    /**
+     * @brief Get the LVGL input device
+     * @return Input device, NULL until registerInputDevice()
+     */
+    lv_indev_t *getInputDevice() const;
+
+    /**
+     * @brief Select the register read strategy used by getPoint()
+     * @param mode TOUCH_READ_FAST or TOUCH_READ_FULL
+     */
+    void setReadMode(TouchReadMode mode);
+
+    /**
+     * @brief Get the register read strategy used by getPoint()
+     * @return Current read mode
+     */
+    TouchReadMode getReadMode() const;
+
+    /**
+     * @brief Select the raw to display transform for a panel rotation
+     * @details Rotation numbers match Arduino_GFX setRotation (ST7796
+     *          MADCTL): 0 portrait, 1 landscape, 2 and 3 the inverted pair.
+     *          The transform comes from a precomputed table; call from the
+     *          LVGL task (MAIN_display_set_orientation does) so no read
+     *          sees half an update.
+     * @param rotation 0-3, other values are taken modulo 4
+     */
+    void setRotation(uint8_t rotation);
+
+    /**
+     * @brief Get the rotation used to map raw touch coordinates
+     * @return uint8_t 0-3
+     */
+    uint8_t getRotation() const;
+
+    /**
+     * @brief Map a raw panel point to display coordinates
+     * @param rawX Panel X (portrait)
+     * @param rawY Panel Y (portrait)
+     * @param x Display X for the current rotation
+     * @param y Display Y for the current rotation
+     */
+    void mapPoint(int16_t rawX, int16_t rawY, int16_t &x, int16_t &y) const;
+
+    /**
+     * @brief Set the input processing stages and their parameters
+     * @details Taken by the reader (sampling task or indev read) at its
+     *          next sample; the smoothing restarts from that sample.
+     * @param config Stages and parameters
+     */
+    void setFilterConfig(const TouchFilterConfig &config);
+
+    /**
+     * @brief Get the input processing configuration
+     * @return Last configuration set
+     */
+    TouchFilterConfig getFilterConfig() const;
+
+    /**
+     * @brief Print buffered debug trace samples to Serial
+     * @details Prints at most TOUCH_TRACE_MAX_PER_FLUSH lines and does
+     *          nothing if called again within TOUCH_TRACE_MIN_INTERVAL_MS.
+     *          Call from a low-priority task, never from the UI task.
+     *          Compiles to nothing when EARS_TOUCH_TRACE is 0.
+     */
+    void flushTrace();
+
     /**
      * @brief Check if screen is currently being touched
      * @return true if touch detected
@@ -214,10 +589,115 @@ public:
 
     void setThreshold(uint8_t threshold);
     uint8_t getThreshold() const;
+
+    /**
+     * @brief Set the power mode register directly
+     * @details The scan level becomes TOUCH_SCAN_UNKNOWN, so the next
+     *          updateScanRate() writes its level again.
+     */
     void setPowerMode(TouchPowerMode mode);
     void sleep();
     void wakeup();
 
+    /**
+     * @brief Pick the scan level for what the UI is doing
+     * @param dragging A drag or scroll is under way
+     * @param idle No input for a while, or the screensaver is up
+     *
+     * @details
+     * TRACKING while dragging, and until the release once there; IDLE when
+     * idle and nothing is touched; NORMAL otherwise. A first touch in
+     * monitor mode is seen at the monitor rate and wakes the UI task, whose
+     * next call goes back to NORMAL.
+     *
+     * @note UI task (the refresh governor calls it every pass)
+     */
+    void updateScanRate(bool dragging, bool idle);
+
+    /**
+     * @brief Set the scan level, writing only the registers that change
+     * @param level TOUCH_SCAN_NORMAL, TOUCH_SCAN_TRACKING or TOUCH_SCAN_IDLE
+     * @note UI task
+     */
+    void setScanLevel(TouchScanLevel level);
+
+    /**
+     * @brief Get the scan level last set
+     * @return TouchScanLevel Level
+     */
+    TouchScanLevel getScanLevel() const;
+
+    /**
+     * @brief Number of scan level changes since boot
+     * @return uint32_t Changes (each one to three register writes)
+     */
+    uint32_t getScanChanges() const;
+
+    /**
+     * @brief Enable interrupt-driven sampling on the INT pin
+     * @param intPin GPIO connected to the controller INT line
+     * @return true if the interrupt was attached
+     * @return false if the pin is invalid or the controller is not ready
+     *
+     * @details
+     * Puts the controller into trigger mode and attaches a falling-edge
+     * ISR that latches a data-ready flag. While the panel is idle
+     * lvgl_touch_read returns without touching the I2C bus.
+     */
+    bool enableInterrupt(int8_t intPin);
+
+    /**
+     * @brief Detach the INT pin ISR and return to polled sampling
+     */
+    void disableInterrupt();
+
+    /**
+     * @brief Check if interrupt-driven sampling is active
+     * @return true if the INT ISR is attached
+     */
+    bool isInterruptEnabled() const;
+
+    /**
+     * @brief Select how the controller drives the INT line
+     * @param mode FT6X36_INT_TRIGGER (pulse per report) or
+     *             FT6X36_INT_POLLING (held low while touched)
+     *
+     * @details
+     * Level mode lets a low-rate poller see a touch that a short pulse
+     * would hide (e.g. across light sleep). enableInterrupt() selects
+     * trigger mode.
+     */
+    void setInterruptMode(uint8_t mode);
+
+    /**
+     * @brief Read the INT line level
+     * @return true if INT is attached and currently low
+     */
+    bool isInterruptAsserted() const;
+
+    /**
+     * @brief Number of INT edges seen since boot
+     * @return uint32_t Counter, wraps
+     */
+    uint32_t getInterruptCount() const;
+
+    /**
+     * @brief Register a function called from the INT ISR
+     * @param callback ISR-safe function (must be IRAM_ATTR), NULL to clear
+     *
+     * @details
+     * Typically used to wake the UI task so the new sample is processed
+     * without waiting for the next LVGL indev timer period.
+     */
+    void setInterruptCallback(void (*callback)(void));
+
+    /**
+     * @brief Check whether new touch data is waiting to be read
+     * @return true if the INT line fired since the last read, or the panel
+     *         is still pressed, or interrupt mode is disabled
+     */
+    bool hasPendingData() const;
+
     /**
      * @brief Perform complete touch controller initialization (matches EARS pattern)
      * @return TouchInitResult Detailed result of initialization
@@ -227,16 +707,25 @@ public:
      * 1. Initialize I2C interface via begin()
      * 2. Verify chip ID and vendor ID
      * 3. Configure touch sensitivity threshold
-     * 4. Register LVGL input device
+     * 4. Register LVGL input device (unless registerIndev is false)
      * 5. Return detailed status for caller interpretation
      *
      * This follows the same pattern as performFullInitialization() in other
      * EARS libraries (sdCard, nvsEeprom, etc.)
      *
      * @note The caller should interpret the result to set LED patterns
-     *       and update application state accordingly.
+     *       and update application state accordingly. With registerIndev
+     *       false no LVGL call is made, so the probe can run on another task
+     *       while LVGL starts; call registerInputDevice() from the LVGL task.
      */
-    TouchInitResult performFullInitialization(uint8_t sda = 8, uint8_t scl = 7);
+    TouchInitResult performFullInitialization(uint8_t sda = 8, uint8_t scl = 7, int8_t intPin = -1,
+                                              bool registerIndev = true);
+
+    /**
+     * @brief Register the LVGL pointer input device (LVGL task only)
+     * @return true if registered now or before, false if the touch is not ready
+     */
+    bool registerInputDevice();
 
     /**
      * @brief LVGL touch read callback (LVGL 9.3 compatible)
@@ -252,15 +741,98 @@ public:
     static EARS_touch *getInstance() { return _instance; }
 
 private:
-    TwoWire *_wire;    // I2C bus pointer
+    EARS_i2cDeviceId _device; // Handle on the shared I2C bus
     TouchState _state; // Current touch state
     uint8_t _address;  // I2C device address
     uint8_t _chipID;   // Detected chip ID
     uint8_t _sda;      // SDA pin number
     uint8_t _scl;      // SCL pin number
+    int8_t _intPin;    // INT pin number (-1 = polled)
+    bool _lastPressed; // Panel was pressed at the last read
+    int16_t _lastX;    // Last reported display X
+    int16_t _lastY;    // Last reported display Y
+    TouchReadMode _readMode; // Register read strategy
+    uint8_t _rotation;       // Display rotation (0-3)
+    TouchTransform _transform; // Raw to display mapping for _rotation
+    lv_indev_t *_indev;      // LVGL input device (NULL until registered)
+
+    // Scan rate (written by the UI task, period read by the sampling task)
+    volatile TouchScanLevel _scanLevel;
+    volatile uint8_t _samplePeriodMs;   // Sampling task period for the level
+    uint8_t _periodActiveNormal;        // FT6X36_REG_PERIOD_ACTIVE read at begin()
+    uint8_t _periodActiveWritten;       // FT6X36_REG_PERIOD_ACTIVE now
+    uint32_t _scanChanges;
+
+    // Sampling task and SPSC event ring (producer: task, consumer: LVGL)
+    TaskHandle_t _taskHandle;                  // Sampling task (NULL = inline reads)
+    void (*_eventCallback)(void);              // Called after each pushed event
+    void (*_sampleHook)(const TouchEvent &);   // Sees each event before it is queued
+    void (*_readHook)(void);                   // Called after each LVGL read
+    TouchEvent _events[TOUCH_EVENT_RING_SIZE]; // Ring storage
+    std::atomic<uint32_t> _eventHead;          // Written by producer only
+    std::atomic<uint32_t> _eventTail;          // Written by consumer only
+    uint32_t _eventsDropped;                   // Ring-full drops
+    TouchEvent _lastEvent;                     // Last event handed to LVGL
+    uint32_t _prevSampleUs;                    // Previous I2C sample time
+    uint32_t _lastInputUs;                     // Input time of the last LVGL read
+
+    // Input processing (reader side: sampling task, or indev read without it)
+    struct FilterState
+    {
+        bool pressed;         // Debounced state
+        bool tracking;        // Smoothing has a previous sample
+        uint8_t pressCount;   // Pressed samples towards a press
+        uint8_t releaseCount; // Released samples towards a release
+        uint8_t medianCount;
+        int16_t medianX[3];
+        int16_t medianY[3];
+        int32_t xQ4;          // One-euro output, 1/16 px
+        int32_t yQ4;
+        int32_t vx;           // Smoothed velocity, px/s
+        int32_t vy;
+        int16_t outX;         // Deadband output
+        int16_t outY;
+        uint32_t lastUs;
+    };
+    TouchFilterConfig _filterConfig;            // Active (reader only)
+    TouchFilterConfig _filterNext;              // Set by setFilterConfig()
+    std::atomic<bool> _filterChanged;           // _filterNext waiting
+    FilterState _filter;
+
+    bool filterSample(uint32_t timeUs, bool pressed, int16_t &x, int16_t &y);
+
+    static void samplingTask(void *parameter);
+    bool pushEvent(const TouchEvent &event);
+    bool readSample(TouchEvent &event);
+    uint32_t stampInput(uint32_t sampleUs);
+    static TouchGesture decodeGesture(uint8_t gestureID);
+
+#if EARS_TOUCH_TRACE == 1
+    struct TraceSample
+    {
+        uint32_t timeMs; // millis() at sample
+        int16_t rawX;    // Panel X (portrait)
+        int16_t rawY;    // Panel Y (portrait)
+        int16_t dispX;   // Display X (current rotation)
+        int16_t dispY;   // Display Y (current rotation)
+    };
+    TraceSample _trace[TOUCH_TRACE_SIZE]; // Ring storage
+    volatile uint16_t _traceHead;         // Next write slot (UI task)
+    uint16_t _traceTail;                  // Next read slot (flushTrace)
+    uint32_t _traceDropped;               // Samples overwritten before print
+    uint32_t _traceLastFlushMs;           // Rate limiter timestamp
+
+    void recordTrace(int16_t rawX, int16_t rawY, int16_t dispX, int16_t dispY);
+#endif
 
     static EARS_touch *_instance; // Singleton instance for LVGL callback
 
+    static volatile bool _dataReady;        // Set by INT ISR, cleared on read
+    static volatile uint32_t _intCount;     // INT edges since boot
+    static volatile uint32_t _intEdgeUs;    // esp_timer time of the last edge
+    static void (*_isrCallback)(void);      // Optional ISR hook (wake UI task)
+    static void IRAM_ATTR handleInterrupt(); // INT falling-edge ISR
+
     uint8_t readRegister(uint8_t reg) const;
     uint8_t readRegisters(uint8_t reg, uint8_t *buffer, uint8_t length) const;
     void writeRegister(uint8_t reg, uint8_t value);
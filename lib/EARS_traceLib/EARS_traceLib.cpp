@@ -0,0 +1,455 @@
+/**
+ * @file EARS_traceLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Deferred debug trace (per-core lock-free rings, low-priority emitter)
+ * @version 1.0.3
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+#include "EARS_traceLib.h"
+#include "EARS_placementDef.h"
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <new>
+
+static_assert(TRACE_TEXT_SIZE <= 255, "TRACE_TEXT_SIZE must fit a uint8_t");
+
+// Constructor
+EARS_trace::EARS_trace()
+    : _task(nullptr), _deferred(false), _recorded(0), _dropped(0), _truncated(0), _emitted(0), _droppedReported(0), _peak(0)
+{
+    _rings[0] = nullptr;
+    _rings[1] = nullptr;
+}
+
+// Allocate the rings and start the emitter task
+bool EARS_trace::begin()
+{
+    if (isDeferred())
+    {
+        return true;
+    }
+
+    for (uint8_t core = 0; core < 2 && _rings[core] == nullptr; core++)
+    {
+        // Internal RAM keeps the producer side fast; PSRAM if that is short
+        void *memory = heap_caps_malloc(sizeof(Ring), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (memory == nullptr)
+        {
+            memory = heap_caps_malloc(sizeof(Ring), MALLOC_CAP_8BIT);
+        }
+        if (memory == nullptr)
+        {
+            Serial.println("[Trace] ERROR: No memory for the trace rings, output stays synchronous");
+            return false;
+        }
+
+        _rings[core] = new (memory) Ring();
+    }
+
+    if (xTaskCreatePinnedToCore(taskFunction, "Trace", TRACE_TASK_STACK_SIZE, this, TRACE_TASK_PRIORITY, &_task,
+                                TRACE_TASK_CORE) != pdPASS)
+    {
+        Serial.println("[Trace] ERROR: Failed to create emitter task, output stays synchronous");
+        _task = nullptr;
+        return false;
+    }
+
+    Serial.printf("[Trace] Deferred output on core %d (%d records per core)\n", TRACE_TASK_CORE, TRACE_RING_SIZE);
+
+    // Producers only switch over once the rings are in place
+    _deferred.store(true, std::memory_order_release);
+    return true;
+}
+
+// Claim a record in the calling core's ring
+EARS_trace::Record EARS_HOT *EARS_trace::claim()
+{
+    Record *record = _rings[xPortGetCoreID() & 1]->claim();
+    if (record == nullptr)
+    {
+        // Ring full: the emitter has not caught up
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    record->timestampUs = (uint32_t)esp_timer_get_time();
+    record->format = nullptr;
+    record->argCount = 0;
+    record->textUsed = 0;
+    record->newline = false;
+    record->truncated = false;
+    return record;
+}
+
+// Hand a filled record to the emitter
+void EARS_HOT EARS_trace::publish(Record *record)
+{
+    if (record->truncated)
+    {
+        _truncated.fetch_add(1, std::memory_order_relaxed);
+    }
+    _recorded.fetch_add(1, std::memory_order_relaxed);
+
+    // The record may be published from the other core if the task moved
+    Ring::publish(record);
+}
+
+// Next argument slot of a record
+EARS_trace::Arg *EARS_trace::nextArg(Record *record, ArgType type)
+{
+    if (record->argCount >= TRACE_MAX_ARGS)
+    {
+        record->truncated = true;
+        return nullptr;
+    }
+
+    record->types[record->argCount] = type;
+    return &record->args[record->argCount++];
+}
+
+// Copy a string into the record, cut to the space left
+uint16_t EARS_trace::copyText(Record *record, const char *text)
+{
+    uint16_t offset = record->textUsed;
+    if (offset >= TRACE_TEXT_SIZE)
+    {
+        record->truncated = true;
+        return TRACE_TEXT_SIZE - 1; // The final NUL of a full pool
+    }
+
+    size_t room = TRACE_TEXT_SIZE - offset - 1;
+    size_t length = (text != nullptr) ? strnlen(text, room + 1) : 0;
+    if (length > room)
+    {
+        length = room;
+        record->truncated = true;
+    }
+
+    if (length > 0)
+    {
+        memcpy(&record->text[offset], text, length);
+    }
+    record->text[offset + length] = '\0';
+    record->textUsed = offset + length + 1;
+    return offset;
+}
+
+// %s argument
+void EARS_trace::packArg(Record *record, const char *value)
+{
+    Arg *arg = nextArg(record, ARG_TEXT);
+    if (arg != nullptr)
+    {
+        arg->text = copyText(record, (value != nullptr) ? value : "(null)");
+    }
+}
+
+// Floating point argument (float is promoted)
+void EARS_trace::packArg(Record *record, double value)
+{
+    Arg *arg = nextArg(record, ARG_DOUBLE);
+    if (arg != nullptr)
+    {
+        arg->d = value;
+    }
+}
+
+// Plain text from print()/println()
+void EARS_trace::text(const char *value, bool newline)
+{
+    if (!isDeferred())
+    {
+        newline ? Serial.println(value) : Serial.print(value);
+        return;
+    }
+
+    // Long text (banners) spans consecutive records, emitted back to back
+    const char *next = (value != nullptr) ? value : "";
+    do
+    {
+        Record *record = claim();
+        if (record == nullptr)
+        {
+            return;
+        }
+
+        size_t length = strnlen(next, TRACE_TEXT_SIZE - 1);
+        memcpy(record->text, next, length);
+        record->text[length] = '\0';
+        next += length;
+        record->newline = newline && (*next == '\0');
+        publish(record);
+    } while (*next != '\0');
+}
+
+// Oldest filled record of a ring, or nullptr
+EARS_trace::Record *EARS_trace::peek(uint8_t core)
+{
+    // Empty, or the producer is still writing the next record
+    Record *record = _rings[core]->peek();
+    if (record == nullptr)
+    {
+        return nullptr;
+    }
+
+    uint16_t pending = (uint16_t)_rings[core]->pending();
+    if (pending > _peak)
+    {
+        _peak = pending;
+    }
+    return record;
+}
+
+// Render one record
+size_t EARS_trace::format(const Record &record, char *line, size_t size) const
+{
+    size_t used = 0;
+
+    if (record.format == nullptr)
+    {
+        used = snprintf(line, size, record.newline ? "%s\r\n" : "%s", record.text);
+        return (used < size) ? used : size - 1;
+    }
+
+    const char *p = record.format;
+    uint8_t argIndex = 0;
+
+    while (*p != '\0' && used < size - 1)
+    {
+        if (*p != '%')
+        {
+            line[used++] = *p++;
+            continue;
+        }
+
+        if (p[1] == '%')
+        {
+            line[used++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // Flags, width and precision are kept; length modifiers are rebuilt
+        // to match how the argument was stored
+        char spec[16];
+        size_t specLength = 0;
+        const char *start = p;
+        spec[specLength++] = *p++;
+        while (*p != '\0' && strchr("-+ #0123456789.", *p) != nullptr && specLength < sizeof(spec) - 4)
+        {
+            spec[specLength++] = *p++;
+        }
+        while (*p != '\0' && strchr("hlLqjzt", *p) != nullptr)
+        {
+            p++;
+        }
+
+        char conversion = *p;
+        if (conversion == '\0' || conversion == '*' || argIndex >= record.argCount)
+        {
+            // Unsupported or missing argument: the rest goes out as written
+            used += snprintf(&line[used], size - used, "%s", start);
+            break;
+        }
+        p++;
+
+        uint8_t type = record.types[argIndex];
+        const Arg &arg = record.args[argIndex++];
+        int written = 0;
+
+        switch (conversion)
+        {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+        case 'c':
+            if (type == ARG_INT64)
+            {
+                spec[specLength++] = 'l';
+                spec[specLength++] = 'l';
+                spec[specLength++] = conversion;
+                spec[specLength] = '\0';
+                written = snprintf(&line[used], size - used, spec, (long long)arg.ll);
+            }
+            else
+            {
+                spec[specLength++] = conversion;
+                spec[specLength] = '\0';
+                written = snprintf(&line[used], size - used, spec, (int)arg.i);
+            }
+            break;
+
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            spec[specLength++] = conversion;
+            spec[specLength] = '\0';
+            written = snprintf(&line[used], size - used, spec, (type == ARG_DOUBLE) ? arg.d : 0.0);
+            break;
+
+        case 's':
+            spec[specLength++] = conversion;
+            spec[specLength] = '\0';
+            written = snprintf(&line[used], size - used, spec, (type == ARG_TEXT) ? &record.text[arg.text] : "?");
+            break;
+
+        case 'p':
+            spec[specLength++] = conversion;
+            spec[specLength] = '\0';
+            written = snprintf(&line[used], size - used, spec, (type == ARG_PTR) ? arg.p : nullptr);
+            break;
+
+        default:
+            // Unknown conversion: copy it through untouched
+            written = snprintf(&line[used], size - used, "%.*s", (int)(p - start), start);
+            break;
+        }
+
+        if (written > 0)
+        {
+            used += (size_t)written;
+        }
+    }
+
+    if (used >= size)
+    {
+        used = size - 1;
+    }
+    line[used] = '\0';
+    return used;
+}
+
+// Format and write queued records
+uint16_t EARS_trace::emit(uint16_t maxRecords)
+{
+    if (!isDeferred())
+    {
+        return 0;
+    }
+
+    char line[TRACE_LINE_SIZE];
+    uint16_t count = 0;
+
+    while (count < maxRecords)
+    {
+        // Oldest of the two ring heads keeps the cores in time order
+        Record *first = peek(0);
+        Record *second = peek(1);
+        uint8_t core = 0;
+        Record *record = first;
+
+        if (first == nullptr || (second != nullptr && (int32_t)(second->timestampUs - first->timestampUs) < 0))
+        {
+            record = second;
+            core = 1;
+        }
+        if (record == nullptr)
+        {
+            break;
+        }
+
+        size_t length = format(*record, line, sizeof(line));
+
+        // Free the record for the producers
+        _rings[core]->pop();
+
+        Serial.write((const uint8_t *)line, length);
+        _emitted++;
+        count++;
+    }
+
+    uint32_t dropped = _dropped.load(std::memory_order_relaxed);
+    if (dropped != _droppedReported)
+    {
+        Serial.printf("[Trace] %lu records dropped (ring full)\n", (unsigned long)(dropped - _droppedReported));
+        _droppedReported = dropped;
+    }
+
+    return count;
+}
+
+// Trace counters
+void EARS_trace::getStats(EARS_traceStats *stats) const
+{
+    if (stats == nullptr)
+    {
+        return;
+    }
+
+    stats->recorded = _recorded.load(std::memory_order_relaxed);
+    stats->emitted = _emitted;
+    stats->dropped = _dropped.load(std::memory_order_relaxed);
+    stats->truncated = _truncated.load(std::memory_order_relaxed);
+    stats->peak = _peak;
+    stats->deferred = isDeferred();
+}
+
+// Emitter task: drain both rings, then sleep (idle until begin() finishes)
+void EARS_trace::taskFunction(void *param)
+{
+    EARS_trace *self = (EARS_trace *)param;
+
+    while (true)
+    {
+        if (self->emit() == 0)
+        {
+            vTaskDelay(pdMS_TO_TICKS(TRACE_FLUSH_PERIOD_MS));
+        }
+    }
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char *EARS_trace::getLibraryName()
+{
+    return EARS_Trace::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t EARS_trace::getVersionEncoded()
+{
+    return VERS_ENCODE(EARS_Trace::VERSION_MAJOR,
+                       EARS_Trace::VERSION_MINOR,
+                       EARS_Trace::VERSION_PATCH);
+}
+
+// Get version date
+const char *EARS_trace::getVersionDate()
+{
+    return EARS_Trace::VERSION_DATE;
+}
+
+// Format version as string
+void EARS_trace::getVersionString(char *buffer)
+{
+    uint32_t encoded = getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/**
+ * @brief Get reference to global trace instance (Singleton pattern)
+ *
+ * @return EARS_trace& Reference to the global trace instance
+ */
+EARS_trace &using_trace()
+{
+    static EARS_trace instance;
+    return instance;
+}
+
+/******************************************************************************
+ * End of EARS_traceLib.cpp
+ *****************************************************************************/
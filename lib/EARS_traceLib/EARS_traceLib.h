@@ -0,0 +1,284 @@
+/**
+ * @file EARS_traceLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Deferred debug trace (per-core lock-free rings, low-priority emitter)
+ * @version 1.0.3
+ * @date 20261015
+ *
+ * Features:
+ * - printf() records the format pointer and the raw arguments, no formatting
+ * - One EARS_mpscRing per core, one compare-and-swap per record
+ * - A low-priority task formats the records and writes them to Serial
+ * - %s arguments are copied into the record, so stack buffers are safe
+ * - print() text longer than a record spans several records
+ * - A full ring drops the new record and counts it
+ *
+ * @details
+ * DEBUG_PRINT, DEBUG_PRINTLN and DEBUG_PRINTF (EARS_systemDef.h) route here
+ * in debug builds, so a print in the LVGL task or a fade costs a few hundred
+ * nanoseconds instead of a blocking USB CDC write, and development builds
+ * keep production timing.
+ *
+ * Until begin() starts the emitter everything is printed synchronously, as
+ * before. Records are emitted in timestamp order across both cores; plain
+ * Serial output is not ordered with them. Records still queued when the
+ * chip panics are lost, so error paths keep printing with Serial directly.
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_TRACE_LIB_H__
+#define __EARS_TRACE_LIB_H__
+
+/******************************************************************************
+ * Includes Information
+ *****************************************************************************/
+#include <Arduino.h>
+#include <atomic>
+#include <type_traits>
+#include "EARS_versionDef.h"
+#include "EARS_mpscRingDef.h"
+#include "EARS_taskPlanLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace EARS_Trace
+{
+    constexpr const char *LIB_NAME = "EARS_trace";
+    constexpr const char *VERSION_MAJOR = "1";
+    constexpr const char *VERSION_MINOR = "0";
+    constexpr const char *VERSION_PATCH = "3";
+    constexpr const char *VERSION_DATE = "2026-10-15";
+}
+
+/******************************************************************************
+ * Trace Configuration
+ *****************************************************************************/
+
+// Records per core (power of two)
+#define TRACE_RING_SIZE 64
+
+// Arguments kept per printf() record, and bytes for copied strings
+#define TRACE_MAX_ARGS 6
+#define TRACE_TEXT_SIZE 48
+
+// Longest emitted line, longer ones are cut
+#define TRACE_LINE_SIZE 192
+
+// Emitter task
+#define TRACE_TASK_CORE using_taskplan().core(TASK_ROLE_TRACE)
+#define TRACE_TASK_PRIORITY using_taskplan().priority(TASK_ROLE_TRACE)
+#define TRACE_TASK_STACK_SIZE 3072
+#define TRACE_FLUSH_PERIOD_MS 20
+
+/******************************************************************************
+ * Trace
+ *****************************************************************************/
+
+/**
+ * @struct EARS_traceStats
+ * @brief Trace counters
+ */
+struct EARS_traceStats
+{
+    uint32_t recorded;  // Records queued
+    uint32_t emitted;   // Records written to Serial
+    uint32_t dropped;   // Records lost to a full ring
+    uint32_t truncated; // Records whose strings or arguments did not fit
+    uint16_t peak;      // Most records pending in one ring
+    bool deferred;      // Emitter running
+};
+
+class EARS_trace
+{
+public:
+    /**
+     * @brief Construct a new Trace (synchronous until begin())
+     */
+    EARS_trace();
+
+    // Version information getters
+    static const char *getLibraryName();
+    static uint32_t getVersionEncoded();
+    static const char *getVersionDate();
+    static void getVersionString(char *buffer);
+
+    /**
+     * @brief Allocate the rings and start the emitter task
+     * @return true if output is now deferred
+     */
+    bool begin();
+
+    /**
+     * @brief Check if output is deferred
+     * @return true once begin() succeeded
+     */
+    bool isDeferred() const { return _deferred.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Record a printf-style message
+     * @param format Format string; must stay valid (a literal)
+     * @param args Integers, floats, pointers and C strings
+     * @note '*' widths and more than TRACE_MAX_ARGS arguments are not
+     *       supported: the format is emitted as it is.
+     */
+    template <typename... Args>
+    void printf(const char *format, Args... args)
+    {
+        if (!isDeferred())
+        {
+            Serial.printf(format, args...);
+            return;
+        }
+
+        Record *record = claim();
+        if (record == nullptr)
+        {
+            return;
+        }
+
+        record->format = format;
+        pack(record, args...);
+        publish(record);
+    }
+
+    // Print like Serial.print/println, deferred for text and numbers
+    template <typename T>
+    void print(const T &value) { put(value, false); }
+    template <typename T>
+    void println(const T &value) { put(value, true); }
+    void println() { put("", true); }
+
+    /**
+     * @brief Format and write queued records (emitter task)
+     * @param maxRecords Upper bound on records written this call
+     * @return uint16_t Records written
+     */
+    uint16_t emit(uint16_t maxRecords = 2 * TRACE_RING_SIZE);
+
+    /**
+     * @brief Trace counters
+     * @param stats Receives the counters
+     */
+    void getStats(EARS_traceStats *stats) const;
+
+private:
+    enum ArgType : uint8_t
+    {
+        ARG_INT = 0,
+        ARG_INT64,
+        ARG_DOUBLE,
+        ARG_PTR,
+        ARG_TEXT
+    };
+
+    union Arg
+    {
+        int32_t i;
+        int64_t ll;
+        double d;
+        const void *p;
+        uint16_t text; // Offset into Record::text
+    };
+
+    struct Record
+    {
+        uint32_t timestampUs;
+        const char *format; // nullptr: text[] holds the whole message
+        uint8_t argCount;
+        uint8_t textUsed;
+        bool newline;
+        bool truncated;
+        uint8_t types[TRACE_MAX_ARGS];
+        Arg args[TRACE_MAX_ARGS];
+        char text[TRACE_TEXT_SIZE];
+    };
+
+    typedef EARS_mpscRing<Record, TRACE_RING_SIZE> Ring; // Emitter consumes
+
+    Record *claim();
+    void publish(Record *record);
+    Record *peek(uint8_t core);
+    size_t format(const Record &record, char *line, size_t size) const;
+    uint16_t copyText(Record *record, const char *text);
+    static void taskFunction(void *param);
+
+    // printf() argument capture
+    Arg *nextArg(Record *record, ArgType type);
+    void pack(Record *) {}
+    template <typename T, typename... Rest>
+    void pack(Record *record, T value, Rest... rest)
+    {
+        packArg(record, value);
+        pack(record, rest...);
+    }
+    void packArg(Record *record, const char *value);
+    void packArg(Record *record, double value);
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+    packArg(Record *record, T value)
+    {
+        if (sizeof(T) > sizeof(int32_t))
+        {
+            Arg *arg = nextArg(record, ARG_INT64);
+            if (arg != nullptr)
+                arg->ll = (int64_t)value;
+        }
+        else
+        {
+            Arg *arg = nextArg(record, ARG_INT);
+            if (arg != nullptr)
+                arg->i = (int32_t)value;
+        }
+    }
+    template <typename T>
+    void packArg(Record *record, const T *value)
+    {
+        Arg *arg = nextArg(record, ARG_PTR);
+        if (arg != nullptr)
+            arg->p = value;
+    }
+
+    // print()/println() helpers, numbers go through the printf() path
+    void text(const char *value, bool newline);
+    void put(const char *value, bool newline) { text(value, newline); }
+    void put(const String &value, bool newline) { text(value.c_str(), newline); }
+    void put(const __FlashStringHelper *value, bool newline) { text((const char *)value, newline); }
+    void put(char value, bool newline) { newline ? printf("%c\r\n", value) : printf("%c", value); }
+    void put(int value, bool newline) { newline ? printf("%d\r\n", value) : printf("%d", value); }
+    void put(unsigned int value, bool newline) { newline ? printf("%u\r\n", value) : printf("%u", value); }
+    void put(long value, bool newline) { newline ? printf("%ld\r\n", value) : printf("%ld", value); }
+    void put(unsigned long value, bool newline) { newline ? printf("%lu\r\n", value) : printf("%lu", value); }
+    void put(long long value, bool newline) { newline ? printf("%lld\r\n", value) : printf("%lld", value); }
+    void put(unsigned long long value, bool newline) { newline ? printf("%llu\r\n", value) : printf("%llu", value); }
+    void put(double value, bool newline) { newline ? printf("%.2f\r\n", value) : printf("%.2f", value); }
+
+    // Anything else (Printable, IPAddress...) is printed synchronously
+    template <typename T>
+    typename std::enable_if<!std::is_arithmetic<T>::value && !std::is_enum<T>::value>::type
+    put(const T &value, bool newline)
+    {
+        newline ? Serial.println(value) : Serial.print(value);
+    }
+
+    Ring *_rings[2];
+    TaskHandle_t _task;
+    std::atomic<bool> _deferred;
+    std::atomic<uint32_t> _recorded;
+    std::atomic<uint32_t> _dropped;
+    std::atomic<uint32_t> _truncated;
+    uint32_t _emitted;         // Emitter only
+    uint32_t _droppedReported; // Emitter only
+    uint16_t _peak;
+};
+
+// Global instance access function
+EARS_trace &using_trace();
+
+#endif // __EARS_TRACE_LIB_H__
+
+/******************************************************************************
+ * End of EARS_traceLib.h
+ *****************************************************************************/
@@ -0,0 +1,1358 @@
+/**
+ * @file MAIN_animAssets.h
+ * @brief Compressed animation frames generated from assets/animation
+ * @details Written by scripts/generate_anim_assets.py before every build;
+ *          replace the frame files under assets/animation/<name>/, not this
+ *          file. Included by MAIN_animationLib.cpp only. Data lives in
+ *          flash (.rodata).
+ */
+
+#pragma once
+#ifndef __MAIN_ANIM_ASSETS_H__
+#define __MAIN_ANIM_ASSETS_H__
+
+#include "MAIN_animationLib.h"
+
+static const uint8_t MAIN_anim_soldier_frame0[7307] = {
+    0x7f, 0x61, 0x08, 0x67, 0x61, 0x08, 0x7f, 0x61, 0x08, 0x67, 0x61, 0x08, 0x7f, 0x61, 0x08, 0x67,
+    0x61, 0x08, 0x7f, 0x61, 0x08, 0x67, 0x61, 0x08, 0x7f, 0x61, 0x08, 0x67, 0x61, 0x08, 0x7f, 0x61,
+    0x08, 0x67, 0x61, 0x08, 0x7f, 0x61, 0x08, 0x67, 0x61, 0x08, 0x7f, 0x61, 0x08, 0x67, 0x61, 0x08,
+    0x7f, 0x61, 0x08, 0x67, 0x61, 0x08, 0x7f, 0x61, 0x08, 0x67, 0x61, 0x08, 0x7f, 0x61, 0x08, 0x67,
+    0x61, 0x08, 0x7f, 0x61, 0x08, 0x67, 0x61, 0x08, 0x7f, 0x61, 0x08, 0x67, 0x61, 0x08, 0x7f, 0x61,
+    0x08, 0x67, 0x61, 0x08, 0x6d, 0x61, 0x08, 0x42, 0x62, 0x08, 0x00, 0x41, 0x08, 0x46, 0x61, 0x08,
+    0x00, 0x41, 0x08, 0x42, 0x61, 0x08, 0x01, 0x62, 0x08, 0x61, 0x08, 0x41, 0x62, 0x08, 0x66, 0x61,
+    0x08, 0x6c, 0x61, 0x08, 0x00, 0x62, 0x08, 0x42, 0x41, 0x08, 0x00, 0xa3, 0x18, 0x44, 0x82, 0x10,
+    0x41, 0x62, 0x10, 0x01, 0x83, 0x10, 0x62, 0x08, 0x45, 0x41, 0x08, 0x00, 0x62, 0x08, 0x65, 0x61,
+    0x08, 0x6b, 0x61, 0x08, 0x05, 0x62, 0x08, 0x41, 0x08, 0xe3, 0x18, 0x45, 0x29, 0xe4, 0x20, 0x27,
+    0x42, 0x41, 0x24, 0x3a, 0x00, 0xa5, 0x4a, 0x41, 0xe5, 0x52, 0x06, 0xc5, 0x52, 0x04, 0x3a, 0xe5,
+    0x39, 0x2a, 0x63, 0x09, 0x5b, 0xa9, 0x52, 0xe3, 0x18, 0x42, 0xc3, 0x18, 0x00, 0x41, 0x08, 0x65,
+    0x61, 0x08, 0x6a, 0x61, 0x08, 0x06, 0x62, 0x08, 0x41, 0x08, 0xe4, 0x18, 0x48, 0x42, 0xe4, 0x31,
+    0x45, 0x42, 0xe5, 0x4a, 0x41, 0xa6, 0x63, 0x0a, 0xe7, 0x6b, 0x47, 0x74, 0x27, 0x74, 0x47, 0x7c,
+    0xc8, 0x8c, 0x46, 0x74, 0xa5, 0x63, 0x85, 0x5b, 0x24, 0x3a, 0xc6, 0x39, 0xc7, 0x39, 0x41, 0xa6,
+    0x39, 0x01, 0x04, 0x21, 0x41, 0x08, 0x64, 0x61, 0x08, 0x6a, 0x61, 0x08, 0x19, 0x41, 0x08, 0xc3,
+    0x18, 0x44, 0x21, 0xe3, 0x31, 0x25, 0x53, 0x45, 0x5b, 0x66, 0x5b, 0xa7, 0x63, 0xe7, 0x6b, 0x07,
+    0x6c, 0x48, 0x74, 0xe7, 0x6b, 0xc6, 0x63, 0xe6, 0x6b, 0x87, 0x7c, 0x85, 0x5b, 0x65, 0x42, 0xc6,
+    0x39, 0xe3, 0x20, 0x81, 0x10, 0x03, 0x19, 0x04, 0x19, 0x04, 0x21, 0xe3, 0x18, 0x41, 0x08, 0x62,
+    0x08, 0x62, 0x61, 0x08, 0x6a, 0x61, 0x08, 0x08, 0xc3, 0x18, 0x65, 0x29, 0xa2, 0x29, 0x84, 0x42,
+    0xc5, 0x4a, 0xe5, 0x4a, 0xe6, 0x4a, 0x26, 0x53, 0x46, 0x5b, 0x41, 0x66, 0x5b, 0x0e, 0x45, 0x5b,
+    0xe7, 0x6b, 0x67, 0x74, 0xa5, 0x63, 0x84, 0x31, 0x87, 0x39, 0x26, 0x29, 0x85, 0x29, 0x43, 0x19,
+    0xe5, 0x19, 0xc9, 0x2a, 0x82, 0x10, 0x45, 0x29, 0xa3, 0x10, 0x41, 0x08, 0x62, 0x61, 0x08, 0x68,
+    0x61, 0x08, 0x05, 0x41, 0x08, 0xc3, 0x18, 0x45, 0x29, 0x42, 0x21, 0x64, 0x42, 0x44, 0x3a, 0x41,
+    0xa5, 0x42, 0x01, 0xc5, 0x4a, 0xe5, 0x4a, 0x42, 0x05, 0x53, 0x0e, 0xe5, 0x4a, 0x86, 0x63, 0x27,
+    0x74, 0x04, 0x3a, 0xe8, 0x41, 0x07, 0x3a, 0x28, 0x3a, 0x68, 0x42, 0x25, 0x32, 0xc5, 0x21, 0x88,
+    0x22, 0xe7, 0x31, 0x82, 0x10, 0x08, 0x42, 0x41, 0x08, 0x62, 0x61, 0x08, 0x69, 0x61, 0x08, 0x07,
+    0x62, 0x10, 0x03, 0x21, 0xa2, 0x29, 0x23, 0x3a, 0x64, 0x3a, 0xc5, 0x4a, 0x84, 0x42, 0x83, 0x29,
+    0x41, 0xc3, 0x31, 0x00, 0x63, 0x29, 0x41, 0x62, 0x21, 0x0c, 0xa3, 0x29, 0xe3, 0x31, 0x64, 0x29,
+    0xe7, 0x39, 0x28, 0x42, 0x48, 0x42, 0x68, 0x42, 0x46, 0x32, 0xc5, 0x29, 0x27, 0x2a, 0x49, 0x3a,
+    0x82, 0x10, 0xe8, 0x41, 0x63, 0x61, 0x08, 0x68, 0x61, 0x08, 0x07, 0x21, 0x08, 0x65, 0x29, 0x44,
+    0x29, 0x42, 0x21, 0xa3, 0x31, 0xe4, 0x31, 0x04, 0x3a, 0xa3, 0x29, 0x41, 0xe2, 0x18, 0x10, 0x03,
+    0x21, 0xa4, 0x31, 0x84, 0x29, 0x23, 0x21, 0xe2, 0x18, 0xa1, 0x10, 0x44, 0x29, 0xe8, 0x39, 0x69,
+    0x4a, 0x08, 0x3a, 0x48, 0x42, 0x88, 0x42, 0x06, 0x32, 0x07, 0x32, 0x49, 0x3a, 0xc3, 0x18, 0xe8,
+    0x41, 0x63, 0x61, 0x08, 0x66, 0x61, 0x08, 0x06, 0x62, 0x08, 0x21, 0x08, 0x86, 0x31, 0xc7, 0x39,
+    0x40, 0x08, 0xa2, 0x18, 0xa2, 0x10, 0x41, 0xa2, 0x18, 0x0b, 0xc2, 0x18, 0x03, 0x21, 0xa2, 0x10,
+    0x86, 0x4a, 0xad, 0xad, 0x6b, 0xa5, 0x26, 0x5b, 0x62, 0x21, 0x02, 0x19, 0x03, 0x21, 0x45, 0x29,
+    0xa6, 0x31, 0x41, 0x86, 0x31, 0x05, 0xe7, 0x39, 0x65, 0x29, 0x03, 0x21, 0x44, 0x29, 0xa2, 0x10,
+    0xc7, 0x39, 0x63, 0x61, 0x08, 0x66, 0x61, 0x08, 0x06, 0x62, 0x10, 0x41, 0x08, 0xe7, 0x39, 0xa2,
+    0x10, 0x42, 0x21, 0x25, 0x3a, 0x85, 0x42, 0x41, 0xa5, 0x4a, 0x0d, 0x85, 0x4a, 0x64, 0x42, 0x44,
+    0x3a, 0x84, 0x42, 0x06, 0x53, 0xe6, 0x52, 0x65, 0x42, 0x24, 0x3a, 0xc3, 0x31, 0x22, 0x21, 0x60,
+    0x08, 0xa1, 0x10, 0xe2, 0x18, 0xc2, 0x18, 0x41, 0xe2, 0x18, 0x04, 0xc1, 0x18, 0x00, 0x00, 0x81,
+    0x10, 0x08, 0x42, 0x41, 0x08, 0x62, 0x61, 0x08, 0x68, 0x61, 0x08, 0x04, 0x82, 0x10, 0xa2, 0x10,
+    0x62, 0x29, 0x24, 0x3a, 0xa5, 0x4a, 0x41, 0xc5, 0x4a, 0x15, 0x64, 0x42, 0x24, 0x3a, 0xe3, 0x31,
+    0xc3, 0x29, 0xa3, 0x29, 0xc3, 0x31, 0x42, 0x21, 0x60, 0x08, 0x61, 0x08, 0xa1, 0x10, 0xe2, 0x10,
+    0xe1, 0x10, 0xc1, 0x10, 0xe1, 0x10, 0x22, 0x19, 0x21, 0x19, 0xa1, 0x10, 0xa3, 0x18, 0x08, 0x42,
+    0xa3, 0x18, 0x41, 0x08, 0x62, 0x08, 0x61, 0x61, 0x08, 0x68, 0x61, 0x08, 0x04, 0xa2, 0x10, 0x81,
+    0x10, 0x62, 0x21, 0x04, 0x3a, 0x45, 0x42, 0x41, 0x85, 0x42, 0x02, 0x62, 0x29, 0xc1, 0x10, 0x81,
+    0x10, 0x42, 0xa1, 0x10, 0x04, 0x20, 0x00, 0x44, 0x39, 0xa4, 0x49, 0x43, 0x39, 0x63, 0x41, 0x41,
+    0x84, 0x41, 0x07, 0x83, 0x41, 0x81, 0x18, 0xa3, 0x10, 0x05, 0x21, 0x04, 0x21, 0x82, 0x10, 0x41,
+    0x08, 0x62, 0x08, 0x62, 0x61, 0x08, 0x67, 0x61, 0x08, 0x03, 0x41, 0x08, 0xc3, 0x18, 0x04, 0x21,
+    0x81, 0x08, 0x42, 0x22, 0x21, 0x14, 0xe2, 0x18, 0x20, 0x00, 0x61, 0x18, 0x03, 0x39, 0x23, 0x39,
+    0x23, 0x41, 0x82, 0x10, 0x03, 0x21, 0x4b, 0xc4, 0x6b, 0xcc, 0x6c, 0xc4, 0x8c, 0xcc, 0x28, 0x93,
+    0xa4, 0x51, 0xa8, 0xb3, 0x67, 0x62, 0x66, 0x29, 0x82, 0x10, 0x41, 0x08, 0x61, 0x08, 0x62, 0x08,
+    0x63, 0x61, 0x08, 0x68, 0x61, 0x08, 0x00, 0x41, 0x08, 0x41, 0x04, 0x21, 0x12, 0x61, 0x08, 0x41,
+    0x08, 0x00, 0x00, 0x21, 0x08, 0x81, 0x10, 0xc5, 0x59, 0x67, 0x7a, 0x87, 0x7a, 0x87, 0x82, 0x41,
+    0x08, 0x43, 0x29, 0x0e, 0xdd, 0x90, 0xe5, 0x13, 0xee, 0x74, 0xf6, 0xd1, 0xe5, 0xad, 0xbc, 0x2e,
+    0xdd, 0x0c, 0xa4, 0x41, 0x41, 0x08, 0x00, 0x62, 0x08, 0x65, 0x61, 0x08, 0x69, 0x61, 0x08, 0x00,
+    0x41, 0x08, 0x41, 0x82, 0x10, 0x14, 0x65, 0x29, 0x41, 0x08, 0x81, 0x10, 0xc2, 0x18, 0xc8, 0x82,
+    0x0b, 0xbc, 0x6c, 0xcc, 0x8a, 0xa3, 0x00, 0x00, 0x23, 0x29, 0x0e, 0xdd, 0xd1, 0xed, 0x75, 0xf6,
+    0xd7, 0xfe, 0xd6, 0xfe, 0xd5, 0xfe, 0x73, 0xf6, 0xb0, 0xed, 0x85, 0x39, 0x21, 0x00, 0x62, 0x10,
+    0x65, 0x61, 0x08, 0x6b, 0x61, 0x08, 0x03, 0x41, 0x08, 0xc3, 0x18, 0x45, 0x29, 0x41, 0x08, 0x41,
+    0xc2, 0x18, 0x00, 0x24, 0x29, 0x41, 0x85, 0x39, 0x0c, 0x41, 0x08, 0x03, 0x29, 0xed, 0xd4, 0x6f,
+    0xe5, 0x33, 0xee, 0x95, 0xf6, 0xb6, 0xfe, 0xd6, 0xfe, 0xb0, 0xe5, 0x4e, 0xed, 0xc5, 0x49, 0x21,
+    0x00, 0x62, 0x10, 0x65, 0x61, 0x08, 0x63, 0x61, 0x08, 0x42, 0x62, 0x08, 0x42, 0x61, 0x08, 0x00,
+    0x62, 0x08, 0x42, 0x41, 0x08, 0x0c, 0x82, 0x10, 0xe4, 0x20, 0x41, 0x08, 0x84, 0x49, 0xa4, 0x51,
+    0x23, 0x39, 0xc2, 0x20, 0x61, 0x08, 0x03, 0x29, 0xed, 0xd4, 0x4e, 0xe5, 0x90, 0xe5, 0x33, 0xf6,
+    0x41, 0x95, 0xf6, 0x02, 0xcc, 0xdc, 0x05, 0x62, 0x82, 0x10, 0x67, 0x61, 0x08, 0x60, 0x61, 0x08,
+    0x02, 0x62, 0x08, 0x62, 0x10, 0x62, 0x08, 0x43, 0x41, 0x08, 0x41, 0x61, 0x08, 0x0d, 0x41, 0x08,
+    0xa2, 0x10, 0xc3, 0x18, 0x82, 0x10, 0xe4, 0x20, 0x65, 0x29, 0x82, 0x29, 0xe4, 0x51, 0xa6, 0x82,
+    0x69, 0xab, 0xca, 0xbb, 0xc5, 0x51, 0x61, 0x00, 0x67, 0x62, 0x41, 0x6f, 0xe5, 0x06, 0xd1, 0xe5,
+    0x12, 0xee, 0x6b, 0xc4, 0x0b, 0xc4, 0x45, 0x31, 0x21, 0x00, 0x62, 0x10, 0x66, 0x61, 0x08, 0x5e,
+    0x61, 0x08, 0x01, 0x62, 0x08, 0x41, 0x08, 0x41, 0x21, 0x08, 0x01, 0x41, 0x08, 0xe4, 0x18, 0x41,
+    0x86, 0x31, 0x19, 0x65, 0x29, 0x45, 0x29, 0xa3, 0x18, 0xc3, 0x18, 0xa6, 0x31, 0x44, 0x29, 0x63,
+    0x29, 0x84, 0x29, 0x43, 0x21, 0xe3, 0x31, 0x83, 0x42, 0x64, 0x42, 0x03, 0x42, 0x07, 0x83, 0x4a,
+    0xab, 0xe3, 0x28, 0x82, 0x10, 0x67, 0x5a, 0xad, 0xbc, 0xd0, 0xed, 0x11, 0xf6, 0xaf, 0xed, 0xab,
+    0x9b, 0xe4, 0x18, 0x41, 0x08, 0x62, 0x08, 0x66, 0x61, 0x08, 0x5d, 0x61, 0x08, 0x02, 0x62, 0x08,
+    0x41, 0x08, 0xc3, 0x18, 0x41, 0xa7, 0x39, 0x02, 0x48, 0x4a, 0xa5, 0x31, 0x04, 0x3a, 0x41, 0x63,
+    0x42, 0x02, 0x23, 0x3a, 0x64, 0x29, 0xe3, 0x18, 0x42, 0xe2, 0x18, 0x11, 0x22, 0x21, 0x43, 0x21,
+    0xc2, 0x10, 0x82, 0x29, 0xa4, 0x4a, 0x65, 0x5b, 0xa6, 0x63, 0xe6, 0x62, 0xc4, 0x51, 0x03, 0x31,
+    0x41, 0x00, 0x23, 0x21, 0x67, 0x62, 0x29, 0x7b, 0xc7, 0x72, 0x65, 0x31, 0xa3, 0x10, 0x41, 0x08,
+    0x67, 0x61, 0x08, 0x5d, 0x61, 0x08, 0x08, 0x41, 0x08, 0x82, 0x10, 0xe3, 0x18, 0x83, 0x29, 0x44,
+    0x42, 0xc5, 0x4a, 0x45, 0x53, 0x86, 0x63, 0xa6, 0x63, 0x41, 0x45, 0x53, 0x05, 0x25, 0x53, 0xe3,
+    0x31, 0xe1, 0x18, 0x22, 0x21, 0x02, 0x19, 0x42, 0x21, 0x41, 0x83, 0x29, 0x0d, 0xe1, 0x18, 0xa1,
+    0x10, 0xe3, 0x31, 0xc7, 0x6b, 0x67, 0x7c, 0xe7, 0x73, 0x25, 0x52, 0x43, 0x39, 0x81, 0x18, 0x20,
+    0x00, 0x00, 0x00, 0xa3, 0x10, 0x66, 0x31, 0x62, 0x10, 0x68, 0x61, 0x08, 0x5c, 0x61, 0x08, 0x1f,
+    0x41, 0x08, 0x04, 0x21, 0xc2, 0x10, 0xa2, 0x29, 0x45, 0x5b, 0xc6, 0x63, 0xa6, 0x5b, 0x66, 0x5b,
+    0x46, 0x5b, 0x25, 0x53, 0xe5, 0x4a, 0x44, 0x3a, 0x83, 0x29, 0xc1, 0x10, 0xa1, 0x10, 0xe2, 0x18,
+    0xc1, 0x10, 0xe2, 0x18, 0x83, 0x29, 0x65, 0x42, 0xa7, 0x4a, 0xa4, 0x29, 0xc2, 0x18, 0xa1, 0x10,
+    0x43, 0x42, 0xe9, 0x8c, 0x07, 0x74, 0x03, 0x42, 0x21, 0x29, 0x62, 0x10, 0x24, 0x29, 0x25, 0x29,
+    0x6a, 0x61, 0x08, 0x5b, 0x61, 0x08, 0x20, 0x62, 0x10, 0xe4, 0x20, 0x44, 0x29, 0x83, 0x42, 0xe4,
+    0x4a, 0x64, 0x3a, 0xe5, 0x4a, 0x26, 0x53, 0xe5, 0x4a, 0x05, 0x53, 0x25, 0x53, 0xc3, 0x31, 0xe2,
+    0x18, 0x81, 0x08, 0x00, 0x00, 0x81, 0x10, 0x62, 0x29, 0x22, 0x21, 0x02, 0x21, 0x20, 0x08, 0xc2,
+    0x18, 0xe5, 0x31, 0x64, 0x21, 0x05, 0x3a, 0xe5, 0x39, 0xa2, 0x10, 0x22, 0x21, 0x46, 0x5b, 0xc7,
+    0x73, 0xe2, 0x39, 0xa2, 0x10, 0x29, 0x42, 0xa3, 0x18, 0x6a, 0x61, 0x08, 0x59, 0x61, 0x08, 0x07,
+    0x62, 0x08, 0x41, 0x08, 0x25, 0x21, 0x24, 0x21, 0xe2, 0x31, 0x65, 0x5b, 0x84, 0x42, 0x85, 0x42,
+    0x41, 0xc5, 0x4a, 0x07, 0xc5, 0x42, 0xc5, 0x4a, 0xe3, 0x31, 0xe2, 0x18, 0xc2, 0x18, 0xa1, 0x10,
+    0x45, 0x42, 0xc7, 0x6b, 0x41, 0x85, 0x63, 0x10, 0xa6, 0x6b, 0x05, 0x53, 0xc3, 0x31, 0x61, 0x08,
+    0xc4, 0x31, 0x65, 0x42, 0x25, 0x3a, 0xe4, 0x31, 0x02, 0x19, 0x61, 0x08, 0x44, 0x42, 0x42, 0x21,
+    0x81, 0x29, 0x62, 0x42, 0xa4, 0x31, 0x05, 0x21, 0x62, 0x10, 0x68, 0x61, 0x08, 0x5a, 0x61, 0x08,
+    0x05, 0x62, 0x08, 0x21, 0x08, 0xe1, 0x18, 0x25, 0x53, 0x64, 0x42, 0x84, 0x42, 0x41, 0xc5, 0x4a,
+    0x1c, 0xa5, 0x42, 0xe5, 0x4a, 0xe3, 0x31, 0xc2, 0x18, 0xa1, 0x10, 0x61, 0x08, 0x27, 0x7c, 0xab,
+    0xa5, 0xc6, 0x6b, 0x45, 0x5b, 0x04, 0x53, 0x86, 0x63, 0x07, 0x74, 0xa5, 0x63, 0x62, 0x29, 0xe2,
+    0x18, 0xc4, 0x31, 0xa5, 0x4a, 0x67, 0x63, 0x09, 0x7c, 0x44, 0x42, 0xa1, 0x08, 0x81, 0x08, 0xc2,
+    0x29, 0xa3, 0x4a, 0x63, 0x42, 0x63, 0x29, 0x65, 0x29, 0x41, 0x08, 0x67, 0x61, 0x08, 0x59, 0x61,
+    0x08, 0x05, 0x62, 0x08, 0x41, 0x08, 0xc7, 0x39, 0x43, 0x21, 0x63, 0x42, 0x64, 0x3a, 0x41, 0xa5,
+    0x42, 0x1f, 0x84, 0x42, 0xc5, 0x4a, 0x44, 0x3a, 0xa1, 0x10, 0xc2, 0x10, 0x81, 0x10, 0x29, 0x7c,
+    0x6b, 0x9d, 0x68, 0x84, 0x09, 0x95, 0xe8, 0x8c, 0x25, 0x53, 0xc4, 0x4a, 0x65, 0x5b, 0xe6, 0x6b,
+    0xc6, 0x6b, 0x61, 0x08, 0x23, 0x21, 0x45, 0x42, 0x67, 0x63, 0xa7, 0x6b, 0x48, 0x7c, 0x46, 0x5b,
+    0x42, 0x21, 0xa1, 0x10, 0x02, 0x19, 0xc3, 0x31, 0x03, 0x32, 0x83, 0x29, 0x04, 0x21, 0x61, 0x08,
+    0x62, 0x08, 0x65, 0x61, 0x08, 0x58, 0x61, 0x08, 0x07, 0x62, 0x08, 0x41, 0x08, 0x24, 0x21, 0xa7,
+    0x39, 0xa2, 0x29, 0xc5, 0x4a, 0x44, 0x3a, 0x84, 0x42, 0x41, 0x64, 0x3a, 0x1f, 0x84, 0x42, 0x62,
+    0x21, 0x02, 0x19, 0x20, 0x00, 0xe3, 0x31, 0xc9, 0x8c, 0xc7, 0x6b, 0x48, 0x7c, 0x27, 0x7c, 0xe4,
+    0x4a, 0x65, 0x5b, 0xa4, 0x4a, 0x63, 0x42, 0xa8, 0x8c, 0x47, 0x7c, 0x43, 0x3a, 0xa2, 0x10, 0x03,
+    0x21, 0x45, 0x42, 0x67, 0x63, 0x87, 0x63, 0x28, 0x74, 0x26, 0x53, 0x22, 0x19, 0x24, 0x3a, 0x63,
+    0x29, 0xc3, 0x31, 0x41, 0x21, 0x45, 0x29, 0x04, 0x21, 0x21, 0x08, 0x62, 0x10, 0x64, 0x61, 0x08,
+    0x58, 0x61, 0x08, 0x07, 0x62, 0x08, 0x41, 0x08, 0x65, 0x29, 0x02, 0x19, 0x43, 0x3a, 0xc3, 0x29,
+    0x24, 0x32, 0x44, 0x3a, 0x41, 0x64, 0x3a, 0x1a, 0xc3, 0x29, 0x22, 0x19, 0x81, 0x08, 0xa3, 0x31,
+    0x06, 0x74, 0xe4, 0x52, 0x43, 0x3a, 0xc4, 0x4a, 0x84, 0x42, 0xe4, 0x4a, 0x68, 0x7c, 0x07, 0x74,
+    0xa3, 0x42, 0xa3, 0x4a, 0x65, 0x63, 0x25, 0x5b, 0x43, 0x29, 0x63, 0x29, 0xa2, 0x10, 0x65, 0x42,
+    0x05, 0x53, 0x44, 0x3a, 0x63, 0x3a, 0x62, 0x21, 0x63, 0x29, 0x83, 0x29, 0xe4, 0x31, 0x41, 0x82,
+    0x29, 0x03, 0x66, 0x31, 0x24, 0x21, 0x21, 0x08, 0x62, 0x08, 0x63, 0x61, 0x08, 0x58, 0x61, 0x08,
+    0x0e, 0x62, 0x10, 0x20, 0x00, 0x86, 0x31, 0x43, 0x21, 0x41, 0x21, 0x22, 0x21, 0xe3, 0x31, 0x44,
+    0x3a, 0x23, 0x32, 0x83, 0x29, 0xa1, 0x10, 0xe1, 0x18, 0x00, 0x00, 0x27, 0x7c, 0xa7, 0x84, 0x41,
+    0x04, 0x53, 0x0f, 0x86, 0x63, 0x24, 0x53, 0x07, 0x74, 0x4a, 0x9d, 0x09, 0x95, 0xa5, 0x63, 0xc2,
+    0x29, 0xc4, 0x4a, 0xe4, 0x52, 0xa4, 0x31, 0x48, 0x63, 0x23, 0x21, 0x02, 0x19, 0x03, 0x3a, 0x66,
+    0x63, 0xc7, 0x6b, 0x41, 0xa7, 0x6b, 0x06, 0xc3, 0x31, 0x83, 0x29, 0x62, 0x21, 0x23, 0x3a, 0x62,
+    0x21, 0xe7, 0x39, 0x82, 0x10, 0x64, 0x61, 0x08, 0x57, 0x61, 0x08, 0x12, 0x62, 0x08, 0x41, 0x08,
+    0xc3, 0x18, 0x65, 0x29, 0xe1, 0x18, 0xa1, 0x10, 0x81, 0x10, 0xc2, 0x18, 0x43, 0x21, 0x22, 0x21,
+    0xc2, 0x18, 0xa1, 0x10, 0x20, 0x00, 0x02, 0x19, 0xa6, 0x63, 0x85, 0x63, 0xe6, 0x6b, 0x47, 0x7c,
+    0xc9, 0x8c, 0x41, 0x47, 0x7c, 0x17, 0x4a, 0x9d, 0x88, 0x84, 0x43, 0x42, 0x23, 0x3a, 0xe4, 0x4a,
+    0xc1, 0x10, 0xc5, 0x39, 0x89, 0x6b, 0xe5, 0x39, 0x41, 0x08, 0xa3, 0x31, 0x48, 0x7c, 0xc7, 0x6b,
+    0x28, 0x7c, 0x89, 0x84, 0xc8, 0x6b, 0x47, 0x5b, 0x42, 0x21, 0x82, 0x21, 0xe2, 0x31, 0x43, 0x21,
+    0xe4, 0x18, 0x41, 0x08, 0x62, 0x08, 0x62, 0x61, 0x08, 0x57, 0x61, 0x08, 0x01, 0x62, 0x08, 0x41,
+    0x08, 0x41, 0x04, 0x21, 0x03, 0x21, 0x19, 0x22, 0x21, 0xa1, 0x10, 0xc2, 0x18, 0x41, 0xe2, 0x18,
+    0x18, 0xa1, 0x10, 0x40, 0x08, 0x20, 0x08, 0xe7, 0x73, 0x27, 0x7c, 0xa4, 0x4a, 0xa6, 0x6b, 0xa8,
+    0x84, 0x88, 0x84, 0x68, 0x7c, 0x47, 0x7c, 0x88, 0x84, 0x07, 0x74, 0xa2, 0x31, 0x23, 0x3a, 0x63,
+    0x42, 0x00, 0x00, 0x05, 0x3a, 0xca, 0x73, 0x26, 0x42, 0xa2, 0x10, 0x20, 0x08, 0xc5, 0x4a, 0x26,
+    0x53, 0x26, 0x5b, 0x41, 0x46, 0x5b, 0x05, 0xa6, 0x63, 0xa3, 0x31, 0x81, 0x10, 0xc3, 0x29, 0x42,
+    0x21, 0x62, 0x10, 0x64, 0x61, 0x08, 0x57, 0x61, 0x08, 0x07, 0x62, 0x08, 0x41, 0x08, 0xe3, 0x18,
+    0x03, 0x21, 0xa1, 0x10, 0xe1, 0x18, 0x02, 0x19, 0x42, 0x21, 0x41, 0x63, 0x21, 0x04, 0x02, 0x19,
+    0x00, 0x00, 0xa3, 0x31, 0x08, 0x95, 0x68, 0x7c, 0x41, 0xe4, 0x52, 0x41, 0xe6, 0x6b, 0x03, 0x06,
+    0x74, 0xc6, 0x6b, 0x65, 0x5b, 0x04, 0x53, 0x41, 0xc2, 0x31, 0x11, 0x42, 0x21, 0x41, 0x08, 0x05,
+    0x3a, 0xc7, 0x52, 0xe5, 0x39, 0x44, 0x21, 0x61, 0x08, 0x64, 0x42, 0x05, 0x53, 0xc5, 0x4a, 0x05,
+    0x53, 0x25, 0x53, 0x86, 0x63, 0xa3, 0x31, 0x20, 0x08, 0xa2, 0x29, 0x82, 0x29, 0xa3, 0x10, 0x64,
+    0x61, 0x08, 0x57, 0x61, 0x08, 0x0d, 0x41, 0x08, 0xc3, 0x18, 0xe3, 0x18, 0x22, 0x21, 0x42, 0x21,
+    0xa1, 0x10, 0xc1, 0x10, 0x83, 0x29, 0x04, 0x3a, 0xe4, 0x31, 0x02, 0x19, 0x40, 0x08, 0xc7, 0x73,
+    0xc8, 0x84, 0x41, 0x04, 0x53, 0x04, 0x44, 0x5b, 0xa5, 0x63, 0xe6, 0x6b, 0x26, 0x74, 0x85, 0x63,
+    0x41, 0xc4, 0x4a, 0x03, 0xc2, 0x31, 0xc1, 0x18, 0x00, 0x00, 0x02, 0x21, 0x41, 0x45, 0x42, 0x04,
+    0xa5, 0x31, 0xc6, 0x39, 0xc3, 0x18, 0xe2, 0x18, 0xe5, 0x52, 0x41, 0xc5, 0x4a, 0x06, 0x05, 0x53,
+    0xa7, 0x63, 0xe3, 0x31, 0x40, 0x08, 0x82, 0x21, 0x22, 0x19, 0xa3, 0x18, 0x64, 0x61, 0x08, 0x56,
+    0x61, 0x08, 0x12, 0x62, 0x08, 0x41, 0x08, 0x45, 0x29, 0x22, 0x21, 0x83, 0x3a, 0xe2, 0x31, 0x20,
+    0x00, 0xc1, 0x18, 0x04, 0x3a, 0x86, 0x63, 0x45, 0x53, 0x02, 0x19, 0xa2, 0x29, 0x46, 0x7c, 0xa8,
+    0x84, 0xe6, 0x6b, 0x65, 0x5b, 0xe6, 0x6b, 0xe6, 0x73, 0x41, 0x68, 0x84, 0x16, 0x24, 0x5b, 0xe4,
+    0x52, 0xa3, 0x4a, 0x21, 0x21, 0x00, 0x00, 0x20, 0x08, 0x63, 0x29, 0x83, 0x29, 0xa4, 0x31, 0x86,
+    0x31, 0x08, 0x42, 0x86, 0x31, 0x41, 0x08, 0xe1, 0x18, 0x64, 0x42, 0xe5, 0x4a, 0xa5, 0x4a, 0x26,
+    0x5b, 0xe3, 0x31, 0x61, 0x08, 0x41, 0x21, 0xc1, 0x10, 0xa3, 0x18, 0x64, 0x61, 0x08, 0x58, 0x61,
+    0x08, 0x1c, 0x62, 0x10, 0x22, 0x19, 0x63, 0x3a, 0xe3, 0x31, 0x61, 0x08, 0xc5, 0x4a, 0x46, 0x5b,
+    0x84, 0x42, 0xa2, 0x29, 0x81, 0x10, 0xc4, 0x4a, 0x64, 0x5b, 0x88, 0x84, 0x8c, 0xad, 0x0a, 0x95,
+    0xe9, 0x94, 0x44, 0x5b, 0xc6, 0x6b, 0xe6, 0x6b, 0x45, 0x5b, 0xc4, 0x4a, 0xc2, 0x31, 0x40, 0x08,
+    0x20, 0x08, 0x02, 0x21, 0xa3, 0x29, 0x63, 0x29, 0x44, 0x29, 0x86, 0x31, 0x41, 0xa6, 0x39, 0x0a,
+    0x65, 0x29, 0x81, 0x10, 0x61, 0x08, 0x42, 0x21, 0x82, 0x29, 0x83, 0x29, 0xe2, 0x18, 0xa1, 0x10,
+    0x82, 0x29, 0x03, 0x21, 0x82, 0x10, 0x64, 0x61, 0x08, 0x57, 0x61, 0x08, 0x0d, 0x41, 0x08, 0x65,
+    0x29, 0x42, 0x21, 0x23, 0x3a, 0x62, 0x21, 0x22, 0x21, 0xa5, 0x63, 0x23, 0x3a, 0xc3, 0x29, 0x40,
+    0x00, 0xc5, 0x52, 0x29, 0x95, 0x85, 0x63, 0x47, 0x7c, 0x41, 0x6b, 0xa5, 0x0e, 0x68, 0x7c, 0x44,
+    0x5b, 0xc4, 0x4a, 0x65, 0x5b, 0x24, 0x5b, 0x02, 0x3a, 0x40, 0x08, 0x20, 0x08, 0x01, 0x19, 0x63,
+    0x29, 0x63, 0x21, 0x23, 0x21, 0xc3, 0x18, 0xe4, 0x18, 0x04, 0x21, 0x41, 0x45, 0x29, 0x0a, 0x44,
+    0x29, 0xe2, 0x18, 0x61, 0x08, 0x81, 0x10, 0x41, 0x08, 0x00, 0x00, 0xa1, 0x10, 0x21, 0x19, 0xa6,
+    0x31, 0x82, 0x10, 0x41, 0x08, 0x63, 0x61, 0x08, 0x55, 0x61, 0x08, 0x1d, 0x62, 0x08, 0x41, 0x08,
+    0x04, 0x21, 0x28, 0x42, 0x62, 0x21, 0x23, 0x3a, 0xe1, 0x18, 0xa1, 0x10, 0x84, 0x42, 0xa3, 0x29,
+    0x22, 0x21, 0xc1, 0x10, 0xe9, 0x7b, 0x2a, 0x9d, 0x26, 0x74, 0xe6, 0x73, 0xc9, 0x8c, 0xe9, 0x94,
+    0x47, 0x7c, 0x04, 0x53, 0x83, 0x42, 0xc4, 0x4a, 0x03, 0x3a, 0x60, 0x08, 0x00, 0x00, 0x01, 0x19,
+    0xc3, 0x31, 0x83, 0x29, 0x02, 0x19, 0x23, 0x21, 0x41, 0xa4, 0x31, 0x0e, 0x84, 0x29, 0x03, 0x21,
+    0xc2, 0x18, 0xa4, 0x31, 0x45, 0x42, 0xe4, 0x39, 0xc2, 0x18, 0x22, 0x21, 0xe4, 0x39, 0x63, 0x29,
+    0x22, 0x21, 0xa3, 0x31, 0x24, 0x21, 0xa3, 0x18, 0x41, 0x08, 0x62, 0x61, 0x08, 0x55, 0x61, 0x08,
+    0x2d, 0x62, 0x10, 0x20, 0x00, 0x08, 0x42, 0xa6, 0x39, 0x41, 0x19, 0x44, 0x3a, 0xe2, 0x18, 0xc1,
+    0x10, 0xa3, 0x29, 0x42, 0x21, 0x80, 0x08, 0xa4, 0x31, 0xcc, 0xad, 0xea, 0x94, 0x25, 0x5b, 0x63,
+    0x42, 0x88, 0x84, 0x06, 0x74, 0x84, 0x63, 0xe3, 0x4a, 0xa3, 0x4a, 0x23, 0x3a, 0x41, 0x08, 0x00,
+    0x00, 0x61, 0x08, 0x42, 0x21, 0x83, 0x29, 0x22, 0x21, 0xc2, 0x18, 0x06, 0x5b, 0x29, 0x7c, 0x4a,
+    0x84, 0x09, 0x7c, 0x04, 0x3a, 0x43, 0x21, 0xc8, 0x73, 0xaa, 0x8c, 0xcb, 0x8c, 0xa6, 0x4a, 0x63,
+    0x29, 0x8d, 0xa5, 0xec, 0x94, 0x83, 0x29, 0xa9, 0x84, 0xc6, 0x52, 0xc8, 0x39, 0x63, 0x61, 0x08,
+    0x55, 0x61, 0x08, 0x16, 0x82, 0x10, 0x00, 0x00, 0x2c, 0x63, 0x48, 0x4a, 0x21, 0x19, 0x44, 0x3a,
+    0x02, 0x19, 0xa1, 0x10, 0xa3, 0x29, 0x42, 0x21, 0x01, 0x19, 0x46, 0x5b, 0x68, 0x84, 0xc9, 0x8c,
+    0xc4, 0x52, 0x43, 0x3a, 0xc6, 0x6b, 0x85, 0x63, 0xc3, 0x4a, 0xa3, 0x4a, 0xe2, 0x31, 0x81, 0x10,
+    0x40, 0x08, 0x41, 0x61, 0x08, 0x16, 0xc1, 0x10, 0xe2, 0x18, 0x81, 0x10, 0xa1, 0x10, 0xc5, 0x52,
+    0xa5, 0x4a, 0xc6, 0x52, 0xe6, 0x5a, 0x83, 0x29, 0xa1, 0x10, 0xe6, 0x52, 0xe5, 0x52, 0x06, 0x5b,
+    0x45, 0x42, 0xa2, 0x10, 0xe7, 0x73, 0x08, 0x7c, 0x23, 0x21, 0xe8, 0x6b, 0xe5, 0x52, 0x08, 0x42,
+    0x61, 0x08, 0x62, 0x08, 0x61, 0x61, 0x08, 0x55, 0x61, 0x08, 0x30, 0x62, 0x10, 0x00, 0x00, 0x8a,
+    0x52, 0x07, 0x42, 0x21, 0x19, 0x24, 0x32, 0xe2, 0x18, 0xc1, 0x10, 0x62, 0x21, 0xa1, 0x10, 0x22,
+    0x21, 0xc8, 0x8c, 0x25, 0x5b, 0xe6, 0x73, 0xc8, 0x8c, 0x47, 0x7c, 0x24, 0x53, 0xe4, 0x52, 0x83,
+    0x42, 0x22, 0x3a, 0x40, 0x08, 0x20, 0x00, 0xc1, 0x18, 0xe1, 0x18, 0xc1, 0x18, 0xe2, 0x18, 0x02,
+    0x19, 0xe2, 0x18, 0xc3, 0x31, 0x24, 0x42, 0x24, 0x3a, 0x24, 0x42, 0x44, 0x42, 0x81, 0x10, 0x83,
+    0x29, 0x84, 0x4a, 0x24, 0x42, 0x64, 0x42, 0x42, 0x21, 0x81, 0x10, 0x46, 0x63, 0x06, 0x5b, 0x23,
+    0x21, 0x26, 0x5b, 0x44, 0x42, 0x08, 0x42, 0x62, 0x08, 0x41, 0x08, 0x62, 0x08, 0x60, 0x61, 0x08,
+    0x55, 0x61, 0x08, 0x06, 0x62, 0x08, 0x21, 0x00, 0x65, 0x29, 0xa6, 0x39, 0x01, 0x19, 0x82, 0x21,
+    0xc1, 0x10, 0x41, 0x22, 0x19, 0x0d, 0x61, 0x08, 0x42, 0x21, 0x47, 0x7c, 0x45, 0x5b, 0xc4, 0x4a,
+    0x44, 0x5b, 0xa5, 0x63, 0xe4, 0x52, 0x43, 0x3a, 0x22, 0x32, 0x01, 0x19, 0x00, 0x00, 0x20, 0x08,
+    0x60, 0x08, 0x41, 0x61, 0x08, 0x03, 0xc1, 0x18, 0xa2, 0x10, 0x44, 0x42, 0x26, 0x5b, 0x41, 0xe6,
+    0x52, 0x10, 0xe6, 0x5a, 0xe6, 0x52, 0xc2, 0x10, 0x85, 0x4a, 0x87, 0x63, 0x26, 0x5b, 0x67, 0x63,
+    0x04, 0x3a, 0xa1, 0x10, 0xa8, 0x6b, 0x88, 0x6b, 0xa4, 0x31, 0xa7, 0x6b, 0x84, 0x42, 0x43, 0x21,
+    0x49, 0x4a, 0x82, 0x10, 0x61, 0x61, 0x08, 0x55, 0x61, 0x08, 0x1d, 0x62, 0x08, 0x41, 0x08, 0xa3,
+    0x18, 0x45, 0x29, 0xa1, 0x10, 0xe1, 0x10, 0xa1, 0x10, 0x22, 0x21, 0x01, 0x19, 0x40, 0x08, 0xa6,
+    0x52, 0xe9, 0x94, 0x44, 0x5b, 0xe4, 0x52, 0x63, 0x42, 0x43, 0x3a, 0x83, 0x42, 0xc2, 0x31, 0x82,
+    0x29, 0x00, 0x00, 0xe1, 0x18, 0x04, 0x3a, 0x85, 0x42, 0x65, 0x42, 0x85, 0x42, 0xc3, 0x31, 0x81,
+    0x10, 0x24, 0x42, 0x26, 0x5b, 0x06, 0x5b, 0x41, 0x27, 0x63, 0x11, 0x07, 0x5b, 0xa1, 0x10, 0x44,
+    0x42, 0x87, 0x63, 0x67, 0x63, 0xa7, 0x6b, 0x24, 0x3a, 0x81, 0x10, 0x87, 0x6b, 0xa8, 0x6b, 0xa4,
+    0x31, 0x67, 0x63, 0x44, 0x42, 0x81, 0x21, 0x84, 0x29, 0x66, 0x29, 0x20, 0x00, 0x62, 0x10, 0x5f,
+    0x61, 0x08, 0x56, 0x61, 0x08, 0x14, 0x62, 0x08, 0x41, 0x08, 0x62, 0x10, 0xe4, 0x18, 0x40, 0x08,
+    0x80, 0x08, 0x22, 0x21, 0xa1, 0x10, 0xe4, 0x39, 0xa9, 0x8c, 0xe7, 0x73, 0x45, 0x5b, 0x85, 0x63,
+    0xe4, 0x52, 0x43, 0x3a, 0x63, 0x42, 0xa4, 0x4a, 0xa2, 0x29, 0x40, 0x08, 0x42, 0x21, 0xa3, 0x31,
+    0x41, 0x24, 0x3a, 0x05, 0x44, 0x3a, 0x83, 0x29, 0x41, 0x08, 0x24, 0x42, 0x26, 0x63, 0x27, 0x63,
+    0x41, 0x47, 0x63, 0x12, 0x27, 0x63, 0x81, 0x10, 0x44, 0x42, 0x87, 0x6b, 0x67, 0x63, 0xc8, 0x6b,
+    0x24, 0x3a, 0x81, 0x10, 0xa8, 0x6b, 0xa8, 0x73, 0xc4, 0x31, 0x67, 0x63, 0x44, 0x42, 0x42, 0x3a,
+    0xe2, 0x31, 0xc3, 0x18, 0xe4, 0x20, 0x41, 0x08, 0x62, 0x08, 0x5e, 0x61, 0x08, 0x57, 0x61, 0x08,
+    0x13, 0x62, 0x08, 0x61, 0x08, 0x82, 0x10, 0x04, 0x21, 0x61, 0x08, 0x80, 0x08, 0x60, 0x08, 0x44,
+    0x42, 0x67, 0x84, 0xe4, 0x52, 0xa4, 0x4a, 0x65, 0x63, 0x45, 0x5b, 0x83, 0x42, 0x43, 0x3a, 0xc4,
+    0x4a, 0x42, 0x21, 0x40, 0x08, 0x22, 0x19, 0x42, 0x21, 0x42, 0x83, 0x29, 0x02, 0x22, 0x21, 0x00,
+    0x00, 0x24, 0x42, 0x43, 0x47, 0x63, 0x12, 0x27, 0x63, 0x81, 0x10, 0x44, 0x42, 0x67, 0x63, 0x47,
+    0x63, 0xc8, 0x6b, 0x24, 0x3a, 0x81, 0x10, 0xa8, 0x73, 0xa8, 0x6b, 0xc4, 0x31, 0x87, 0x6b, 0x25,
+    0x42, 0xc2, 0x31, 0x85, 0x5b, 0xc3, 0x31, 0x66, 0x29, 0x82, 0x10, 0x41, 0x08, 0x5e, 0x61, 0x08,
+    0x59, 0x61, 0x08, 0x08, 0x41, 0x08, 0xa2, 0x10, 0x45, 0x29, 0x65, 0x29, 0xa2, 0x10, 0x23, 0x3a,
+    0x67, 0x7c, 0x25, 0x5b, 0x63, 0x42, 0x41, 0x83, 0x42, 0x02, 0x63, 0x42, 0xc4, 0x4a, 0x63, 0x42,
+    0x41, 0x40, 0x08, 0x07, 0x22, 0x19, 0xa3, 0x29, 0x25, 0x3a, 0x65, 0x42, 0x25, 0x3a, 0x23, 0x21,
+    0x00, 0x00, 0x04, 0x42, 0x41, 0x27, 0x63, 0x00, 0x47, 0x63, 0x41, 0x27, 0x63, 0x12, 0x81, 0x10,
+    0x24, 0x42, 0x67, 0x63, 0x47, 0x63, 0xa8, 0x6b, 0x24, 0x3a, 0x81, 0x10, 0xa8, 0x6b, 0xa8, 0x73,
+    0xe4, 0x39, 0x87, 0x6b, 0x24, 0x42, 0x82, 0x29, 0x05, 0x53, 0xe4, 0x4a, 0x23, 0x32, 0x85, 0x31,
+    0xc3, 0x18, 0x41, 0x08, 0x5d, 0x61, 0x08, 0x59, 0x61, 0x08, 0x0d, 0x62, 0x08, 0x41, 0x08, 0x62,
+    0x10, 0xe4, 0x20, 0x25, 0x29, 0x82, 0x29, 0xe5, 0x6b, 0xa6, 0x6b, 0x83, 0x42, 0x64, 0x42, 0xa4,
+    0x4a, 0x04, 0x53, 0xc4, 0x4a, 0x63, 0x42, 0x41, 0x40, 0x08, 0x09, 0x22, 0x21, 0x63, 0x29, 0xe4,
+    0x31, 0x24, 0x3a, 0x05, 0x3a, 0x23, 0x21, 0x00, 0x00, 0x45, 0x4a, 0x67, 0x6b, 0x47, 0x63, 0x41,
+    0x67, 0x6b, 0x14, 0x67, 0x63, 0x81, 0x10, 0x45, 0x42, 0xa8, 0x6b, 0x47, 0x63, 0xe8, 0x73, 0x45,
+    0x42, 0x81, 0x10, 0xe8, 0x7b, 0xe9, 0x7b, 0x05, 0x3a, 0xa8, 0x73, 0x45, 0x42, 0x42, 0x21, 0xa4,
+    0x4a, 0x23, 0x3a, 0x04, 0x53, 0xa3, 0x4a, 0x65, 0x31, 0x04, 0x21, 0x41, 0x08, 0x5c, 0x61, 0x08,
+    0x5a, 0x61, 0x08, 0x17, 0x62, 0x08, 0x41, 0x08, 0xe3, 0x18, 0xa6, 0x31, 0x26, 0x5b, 0x29, 0x9d,
+    0xe6, 0x73, 0x67, 0x7c, 0xa5, 0x63, 0x04, 0x53, 0xa3, 0x4a, 0xa4, 0x4a, 0x43, 0x42, 0x40, 0x08,
+    0x20, 0x00, 0x61, 0x08, 0x41, 0x08, 0x61, 0x08, 0x81, 0x08, 0xa1, 0x10, 0x81, 0x08, 0x00, 0x00,
+    0x22, 0x21, 0xa4, 0x31, 0x43, 0x83, 0x31, 0x15, 0x41, 0x08, 0x43, 0x29, 0xe4, 0x39, 0xc4, 0x39,
+    0x04, 0x3a, 0xe2, 0x18, 0x41, 0x08, 0x45, 0x42, 0x25, 0x42, 0x43, 0x29, 0xe4, 0x39, 0x22, 0x21,
+    0xe1, 0x18, 0xc2, 0x31, 0xc2, 0x29, 0xc4, 0x4a, 0xa5, 0x63, 0x82, 0x29, 0x66, 0x31, 0x04, 0x21,
+    0x41, 0x08, 0x62, 0x08, 0x5a, 0x61, 0x08, 0x5a, 0x61, 0x08, 0x0d, 0x62, 0x08, 0x41, 0x08, 0xe4,
+    0x20, 0x46, 0x42, 0x4a, 0x9d, 0x6b, 0xa5, 0xc8, 0x94, 0xa5, 0x6b, 0xe3, 0x4a, 0xa3, 0x42, 0x63,
+    0x3a, 0x43, 0x3a, 0xe1, 0x18, 0x81, 0x10, 0x41, 0x42, 0x21, 0x01, 0x62, 0x21, 0x83, 0x29, 0x41,
+    0xe4, 0x39, 0x01, 0xc2, 0x18, 0x40, 0x08, 0x45, 0x20, 0x00, 0x00, 0x60, 0x08, 0x42, 0x40, 0x08,
+    0x04, 0x20, 0x00, 0x00, 0x00, 0x20, 0x08, 0x81, 0x10, 0x80, 0x10, 0x41, 0x60, 0x08, 0x09, 0x42,
+    0x21, 0x21, 0x21, 0xc3, 0x31, 0xe5, 0x52, 0x63, 0x42, 0x01, 0x19, 0x40, 0x08, 0x61, 0x08, 0x66,
+    0x29, 0x62, 0x10, 0x5b, 0x61, 0x08, 0x5c, 0x61, 0x08, 0x1a, 0x41, 0x08, 0xc2, 0x10, 0x66, 0x63,
+    0x09, 0x95, 0x08, 0x95, 0x06, 0x74, 0x04, 0x53, 0xc4, 0x4a, 0xe3, 0x4a, 0x02, 0x32, 0x20, 0x08,
+    0xe2, 0x18, 0xc3, 0x31, 0x44, 0x3a, 0x64, 0x42, 0xc5, 0x4a, 0x87, 0x63, 0x47, 0x5b, 0xc4, 0x31,
+    0xa1, 0x10, 0x01, 0x19, 0x42, 0x21, 0x62, 0x21, 0x82, 0x29, 0x83, 0x29, 0xa3, 0x29, 0x82, 0x29,
+    0x41, 0x42, 0x21, 0x41, 0x62, 0x29, 0x11, 0x83, 0x29, 0x02, 0x19, 0x63, 0x42, 0x84, 0x29, 0xc7,
+    0x39, 0xe3, 0x18, 0x01, 0x19, 0x62, 0x21, 0x62, 0x29, 0x42, 0x21, 0x41, 0x08, 0x21, 0x08, 0xe3,
+    0x18, 0x24, 0x21, 0xc3, 0x18, 0xa3, 0x10, 0x41, 0x08, 0x62, 0x08, 0x59, 0x61, 0x08, 0x5b, 0x61,
+    0x08, 0x0e, 0x41, 0x08, 0xa2, 0x10, 0xe3, 0x18, 0x20, 0x00, 0xe2, 0x18, 0xc5, 0x52, 0xa6, 0x6b,
+    0xc6, 0x6b, 0x65, 0x5b, 0xa5, 0x63, 0x63, 0x29, 0x82, 0x10, 0xc1, 0x10, 0x83, 0x29, 0xc3, 0x31,
+    0x41, 0xe3, 0x31, 0x04, 0x04, 0x3a, 0x24, 0x3a, 0x83, 0x29, 0x81, 0x10, 0x60, 0x08, 0x43, 0x81,
+    0x10, 0x03, 0xc1, 0x18, 0x02, 0x19, 0xe2, 0x18, 0x02, 0x21, 0x42, 0x42, 0x21, 0x11, 0x03, 0x21,
+    0xa3, 0x31, 0xc6, 0x39, 0x25, 0x21, 0x66, 0x29, 0x03, 0x21, 0x80, 0x08, 0x60, 0x08, 0x20, 0x00,
+    0x62, 0x10, 0x04, 0x21, 0x65, 0x29, 0xe7, 0x41, 0x24, 0x21, 0x45, 0x29, 0x66, 0x29, 0x41, 0x08,
+    0x62, 0x08, 0x58, 0x61, 0x08, 0x5b, 0x61, 0x08, 0x07, 0x41, 0x08, 0xe3, 0x18, 0x04, 0x21, 0xe4,
+    0x20, 0x62, 0x10, 0x41, 0x08, 0x21, 0x08, 0x61, 0x08, 0x41, 0xa1, 0x10, 0x02, 0xa7, 0x31, 0x66,
+    0x29, 0x40, 0x08, 0x43, 0xa1, 0x10, 0x10, 0xc2, 0x18, 0xc1, 0x10, 0x40, 0x08, 0xc1, 0x18, 0xc2,
+    0x31, 0xa2, 0x29, 0xc2, 0x29, 0x82, 0x29, 0x21, 0x21, 0xc1, 0x10, 0x20, 0x08, 0x20, 0x00, 0x60,
+    0x08, 0x80, 0x08, 0xa1, 0x10, 0x40, 0x08, 0xc4, 0x18, 0x41, 0x04, 0x21, 0x0d, 0x41, 0x08, 0x62,
+    0x08, 0x04, 0x21, 0xa3, 0x18, 0x21, 0x08, 0x62, 0x10, 0xa3, 0x18, 0x25, 0x29, 0x24, 0x29, 0x04,
+    0x21, 0x45, 0x31, 0x82, 0x10, 0xa3, 0x18, 0x41, 0x08, 0x59, 0x61, 0x08, 0x59, 0x61, 0x08, 0x09,
+    0x62, 0x08, 0x41, 0x08, 0x04, 0x21, 0x66, 0x31, 0xe3, 0x18, 0x86, 0x31, 0x66, 0x31, 0x86, 0x31,
+    0x65, 0x29, 0xe4, 0x18, 0x41, 0x82, 0x10, 0x13, 0x86, 0x31, 0xe3, 0x18, 0x61, 0x08, 0x20, 0x08,
+    0x00, 0x00, 0x20, 0x00, 0x40, 0x08, 0x81, 0x08, 0xc1, 0x10, 0x01, 0x19, 0x43, 0x3a, 0x84, 0x42,
+    0xc4, 0x4a, 0x85, 0x63, 0xc6, 0x6b, 0x48, 0x84, 0x25, 0x5b, 0x41, 0x21, 0xa0, 0x10, 0xa1, 0x10,
+    0x41, 0x41, 0x21, 0x03, 0x23, 0x21, 0xe4, 0x18, 0x20, 0x00, 0x41, 0x08, 0x41, 0x61, 0x08, 0x00,
+    0x21, 0x08, 0x41, 0xc3, 0x18, 0x08, 0x61, 0x08, 0xc3, 0x18, 0xe3, 0x20, 0xa3, 0x18, 0x27, 0x62,
+    0x0e, 0xe5, 0x26, 0x62, 0x00, 0x00, 0x82, 0x10, 0x59, 0x61, 0x08, 0x5a, 0x61, 0x08, 0x19, 0x62,
+    0x10, 0x66, 0x29, 0x82, 0x10, 0x65, 0x29, 0xa7, 0x39, 0xc7, 0x39, 0xe7, 0x39, 0xe8, 0x41, 0x86,
+    0x31, 0xe4, 0x20, 0x04, 0x21, 0x65, 0x29, 0x82, 0x10, 0xa3, 0x10, 0x62, 0x10, 0xa2, 0x18, 0x60,
+    0x08, 0x01, 0x19, 0x62, 0x21, 0x82, 0x29, 0x03, 0x32, 0xa4, 0x4a, 0x63, 0x42, 0xa4, 0x4a, 0xc6,
+    0x6b, 0x68, 0x7c, 0x41, 0xe9, 0x94, 0x08, 0x88, 0x84, 0x86, 0x6b, 0x81, 0x10, 0xc2, 0x18, 0x44,
+    0x29, 0x04, 0x21, 0xa3, 0x10, 0x61, 0x08, 0x62, 0x08, 0x41, 0x61, 0x08, 0x0b, 0x62, 0x08, 0x61,
+    0x08, 0x24, 0x21, 0x62, 0x10, 0xa3, 0x18, 0x82, 0x10, 0x61, 0x10, 0x6a, 0x93, 0x8f, 0xf5, 0x69,
+    0xa3, 0xa6, 0x39, 0x62, 0x08, 0x59, 0x61, 0x08, 0x5a, 0x61, 0x08, 0x0b, 0x82, 0x10, 0x86, 0x31,
+    0x82, 0x10, 0x45, 0x29, 0x66, 0x31, 0x08, 0x42, 0x8a, 0x52, 0x69, 0x4a, 0xe4, 0x18, 0xa2, 0x18,
+    0xa6, 0x39, 0x41, 0x08, 0x42, 0x61, 0x08, 0x04, 0xa3, 0x18, 0xa1, 0x10, 0x41, 0x21, 0x42, 0x21,
+    0xa2, 0x29, 0x41, 0xe3, 0x31, 0x0a, 0x23, 0x3a, 0xc4, 0x4a, 0x45, 0x5b, 0x07, 0x74, 0x85, 0x63,
+    0x68, 0x84, 0xe9, 0x94, 0x67, 0x7c, 0x24, 0x53, 0x43, 0x21, 0x04, 0x21, 0x41, 0x41, 0x08, 0x45,
+    0x61, 0x08, 0x08, 0xc3, 0x18, 0x45, 0x29, 0x82, 0x10, 0x23, 0x39, 0x66, 0x82, 0x83, 0x51, 0x89,
+    0xab, 0x06, 0x62, 0x82, 0x10, 0x5a, 0x61, 0x08, 0x5a, 0x61, 0x08, 0x02, 0x82, 0x10, 0x86, 0x31,
+    0x61, 0x08, 0x41, 0xe3, 0x18, 0x07, 0x25, 0x29, 0xe8, 0x41, 0xa7, 0x31, 0xc3, 0x20, 0xc2, 0x28,
+    0x45, 0x31, 0x61, 0x08, 0x62, 0x08, 0x41, 0x61, 0x08, 0x03, 0xa2, 0x10, 0xc1, 0x10, 0x82, 0x29,
+    0x61, 0x21, 0x41, 0x23, 0x3a, 0x0d, 0x82, 0x29, 0x84, 0x42, 0x45, 0x5b, 0xc6, 0x6b, 0xe6, 0x73,
+    0x07, 0x74, 0x65, 0x5b, 0x86, 0x63, 0xa6, 0x63, 0x64, 0x5b, 0xe1, 0x31, 0xe8, 0x39, 0xc3, 0x18,
+    0x41, 0x08, 0x45, 0x61, 0x08, 0x09, 0x41, 0x08, 0x82, 0x10, 0x66, 0x29, 0x47, 0x6a, 0x85, 0x9a,
+    0x87, 0x82, 0xc6, 0x41, 0x82, 0x10, 0x41, 0x08, 0x62, 0x08, 0x59, 0x61, 0x08, 0x5b, 0x61, 0x08,
+    0x02, 0xa3, 0x18, 0xe4, 0x20, 0x82, 0x10, 0x42, 0xc3, 0x18, 0x04, 0x82, 0x10, 0x87, 0x8a, 0xe5,
+    0x79, 0x45, 0x31, 0x62, 0x08, 0x42, 0x61, 0x08, 0x14, 0x82, 0x10, 0xa1, 0x10, 0x02, 0x32, 0x03,
+    0x3a, 0xc4, 0x4a, 0xa4, 0x4a, 0x23, 0x3a, 0xa4, 0x4a, 0xc4, 0x4a, 0xc6, 0x6b, 0xa8, 0x8c, 0x07,
+    0x74, 0xc4, 0x4a, 0xe4, 0x4a, 0xc4, 0x4a, 0xc5, 0x6b, 0xe4, 0x52, 0x46, 0x29, 0xa3, 0x18, 0x41,
+    0x08, 0x62, 0x08, 0x44, 0x61, 0x08, 0x05, 0x62, 0x08, 0x41, 0x08, 0x61, 0x08, 0x45, 0x31, 0xe3,
+    0x28, 0x24, 0x29, 0x41, 0x41, 0x08, 0x00, 0x62, 0x08, 0x5a, 0x61, 0x08, 0x5b, 0x61, 0x08, 0x0b,
+    0x41, 0x08, 0xe4, 0x20, 0x45, 0x29, 0xa2, 0x10, 0xa2, 0x18, 0x82, 0x18, 0x46, 0x7a, 0x47, 0xc3,
+    0xa7, 0x8a, 0xa6, 0x39, 0x41, 0x08, 0x62, 0x08, 0x41, 0x61, 0x08, 0x06, 0x82, 0x10, 0x61, 0x08,
+    0xa2, 0x29, 0x63, 0x42, 0x84, 0x42, 0x64, 0x42, 0x84, 0x4a, 0x41, 0xa4, 0x4a, 0x0c, 0x64, 0x42,
+    0xa6, 0x6b, 0x45, 0x63, 0xc4, 0x4a, 0x83, 0x42, 0x04, 0x53, 0x27, 0x7c, 0x68, 0x7c, 0x24, 0x42,
+    0x45, 0x29, 0xc3, 0x18, 0x41, 0x08, 0x62, 0x08, 0x46, 0x61, 0x08, 0x42, 0x41, 0x08, 0x5d, 0x61,
+    0x08, 0x5b, 0x61, 0x08, 0x09, 0x62, 0x08, 0x21, 0x08, 0x04, 0x21, 0x08, 0x42, 0x43, 0x49, 0x03,
+    0x41, 0x86, 0x8a, 0x66, 0x8a, 0xa5, 0x49, 0x62, 0x08, 0x42, 0x61, 0x08, 0x01, 0x62, 0x10, 0xc3,
+    0x18, 0x41, 0xa1, 0x10, 0x0b, 0x23, 0x3a, 0x64, 0x42, 0x23, 0x3a, 0x63, 0x42, 0x05, 0x53, 0x45,
+    0x5b, 0xc4, 0x4a, 0x84, 0x42, 0x27, 0x7c, 0x0a, 0x9d, 0x07, 0x7c, 0xe7, 0x73, 0x41, 0xc9, 0x8c,
+    0x04, 0x26, 0x74, 0x43, 0x21, 0xc3, 0x18, 0x41, 0x08, 0x62, 0x08, 0x46, 0x61, 0x08, 0x02, 0x62,
+    0x08, 0x62, 0x10, 0x62, 0x08, 0x5d, 0x61, 0x08, 0x5c, 0x61, 0x08, 0x07, 0x62, 0x08, 0x41, 0x08,
+    0x82, 0x10, 0xc3, 0x20, 0xc2, 0x20, 0xe3, 0x20, 0xe4, 0x18, 0x21, 0x00, 0x41, 0x61, 0x08, 0x17,
+    0x62, 0x08, 0x41, 0x08, 0xa6, 0x31, 0xa2, 0x10, 0x41, 0x21, 0xa1, 0x10, 0x22, 0x21, 0x84, 0x42,
+    0xe4, 0x52, 0x63, 0x42, 0x85, 0x63, 0xe6, 0x6b, 0x65, 0x5b, 0xe4, 0x52, 0xc6, 0x6b, 0x89, 0x84,
+    0xa9, 0x8c, 0x27, 0x7c, 0xa6, 0x63, 0xe7, 0x73, 0x47, 0x7c, 0xc3, 0x31, 0x49, 0x4a, 0x41, 0x08,
+    0x68, 0x61, 0x08, 0x5d, 0x61, 0x08, 0x01, 0x62, 0x08, 0x61, 0x08, 0x43, 0x41, 0x08, 0x00, 0x62,
+    0x10, 0x41, 0x61, 0x08, 0x0f, 0x62, 0x08, 0x21, 0x00, 0xe7, 0x39, 0xa1, 0x10, 0x61, 0x21, 0x01,
+    0x19, 0xc1, 0x10, 0xa2, 0x29, 0xc4, 0x4a, 0xe4, 0x52, 0x45, 0x5b, 0x07, 0x74, 0x27, 0x74, 0xe5,
+    0x52, 0xa4, 0x4a, 0xe2, 0x31, 0x41, 0x23, 0x3a, 0x04, 0x82, 0x29, 0xe4, 0x52, 0x06, 0x74, 0xe3,
+    0x31, 0x0c, 0x63, 0x69, 0x61, 0x08, 0x61, 0x61, 0x08, 0x41, 0x62, 0x08, 0x42, 0x61, 0x08, 0x11,
+    0x41, 0x08, 0xe3, 0x18, 0x45, 0x29, 0xe1, 0x18, 0x82, 0x29, 0x62, 0x21, 0x42, 0x21, 0xa1, 0x10,
+    0xc2, 0x31, 0xe4, 0x52, 0x45, 0x5b, 0x86, 0x63, 0x45, 0x5b, 0x84, 0x42, 0x84, 0x4a, 0x63, 0x42,
+    0x43, 0x3a, 0xa3, 0x4a, 0x41, 0xc4, 0x4a, 0x04, 0x24, 0x53, 0xe4, 0x52, 0x48, 0x4a, 0xa3, 0x10,
+    0x41, 0x08, 0x67, 0x61, 0x08, 0x65, 0x61, 0x08, 0x19, 0x62, 0x08, 0x21, 0x08, 0x65, 0x29, 0xc2,
+    0x10, 0x21, 0x19, 0x42, 0x21, 0x82, 0x29, 0x42, 0x21, 0x01, 0x19, 0xc1, 0x18, 0x84, 0x4a, 0x05,
+    0x53, 0xe4, 0x52, 0x63, 0x42, 0x23, 0x3a, 0x83, 0x42, 0x25, 0x53, 0xe4, 0x52, 0xa5, 0x63, 0x65,
+    0x5b, 0x43, 0x42, 0xa4, 0x4a, 0x67, 0x7c, 0x62, 0x29, 0x24, 0x21, 0x82, 0x10, 0x67, 0x61, 0x08,
+    0x66, 0x61, 0x08, 0x18, 0x62, 0x08, 0xa6, 0x31, 0xc2, 0x18, 0x42, 0x21, 0x62, 0x21, 0xa2, 0x29,
+    0x62, 0x21, 0x41, 0x21, 0xa1, 0x10, 0xe1, 0x18, 0xc4, 0x4a, 0xe4, 0x52, 0x04, 0x53, 0xc4, 0x52,
+    0x45, 0x63, 0x64, 0x42, 0xa6, 0x6b, 0x67, 0x7c, 0x06, 0x74, 0xa6, 0x6b, 0x45, 0x5b, 0xe5, 0x52,
+    0x65, 0x5b, 0x63, 0x29, 0x41, 0x08, 0x67, 0x61, 0x08, 0x64, 0x61, 0x08, 0x15, 0x62, 0x08, 0x21,
+    0x08, 0x25, 0x21, 0xe4, 0x20, 0xa0, 0x10, 0x82, 0x29, 0xe3, 0x31, 0x23, 0x3a, 0xc3, 0x31, 0x62,
+    0x21, 0x42, 0x21, 0x80, 0x08, 0x62, 0x29, 0x64, 0x42, 0x84, 0x4a, 0xa6, 0x63, 0xe6, 0x6b, 0xc4,
+    0x4a, 0xe5, 0x52, 0x86, 0x63, 0x25, 0x5b, 0xe4, 0x52, 0x41, 0x83, 0x42, 0x04, 0x06, 0x74, 0xe5,
+    0x39, 0x25, 0x21, 0x41, 0x08, 0x62, 0x08, 0x65, 0x61, 0x08, 0x65, 0x61, 0x08, 0x1c, 0x82, 0x10,
+    0xc3, 0x18, 0xa1, 0x10, 0x41, 0x21, 0xe3, 0x31, 0x44, 0x42, 0x64, 0x42, 0x23, 0x3a, 0xe3, 0x31,
+    0xa2, 0x29, 0x42, 0x21, 0xa1, 0x10, 0x23, 0x3a, 0xc4, 0x4a, 0x25, 0x5b, 0x65, 0x63, 0x05, 0x53,
+    0xe3, 0x31, 0xc2, 0x29, 0x43, 0x3a, 0x65, 0x63, 0x25, 0x5b, 0x27, 0x74, 0x2a, 0x9d, 0x07, 0x74,
+    0xa5, 0x31, 0x82, 0x10, 0x61, 0x08, 0x62, 0x08, 0x64, 0x61, 0x08, 0x63, 0x61, 0x08, 0x1e, 0x62,
+    0x10, 0x21, 0x00, 0xa6, 0x31, 0xa2, 0x10, 0xe1, 0x18, 0x82, 0x29, 0xc3, 0x31, 0x44, 0x42, 0x64,
+    0x42, 0x44, 0x42, 0x23, 0x3a, 0xc2, 0x31, 0x82, 0x29, 0xc1, 0x10, 0xe1, 0x18, 0x25, 0x53, 0x45,
+    0x5b, 0xc4, 0x4a, 0x84, 0x42, 0x44, 0x42, 0x82, 0x29, 0x84, 0x4a, 0x47, 0x7c, 0x88, 0x84, 0xc9,
+    0x8c, 0x4c, 0x9d, 0x09, 0x8d, 0xc4, 0x4a, 0x25, 0x21, 0x61, 0x08, 0x41, 0x08, 0x64, 0x61, 0x08,
+    0x62, 0x61, 0x08, 0x13, 0x62, 0x08, 0x61, 0x08, 0x62, 0x08, 0x86, 0x31, 0x02, 0x19, 0x21, 0x21,
+    0x62, 0x21, 0x21, 0x21, 0x03, 0x3a, 0x23, 0x3a, 0x03, 0x3a, 0xc3, 0x31, 0xa2, 0x29, 0x82, 0x29,
+    0x21, 0x21, 0x60, 0x08, 0x62, 0x29, 0x24, 0x53, 0x84, 0x4a, 0x43, 0x42, 0x41, 0x82, 0x29, 0x01,
+    0x64, 0x42, 0xe7, 0x73, 0x41, 0x0a, 0x95, 0x05, 0x27, 0x7c, 0xc6, 0x6b, 0xe6, 0x6b, 0xa3, 0x29,
+    0x66, 0x29, 0x82, 0x10, 0x64, 0x61, 0x08, 0x61, 0x61, 0x08, 0x0b, 0x62, 0x08, 0x61, 0x08, 0x41,
+    0x08, 0x45, 0x29, 0x02, 0x19, 0xc2, 0x29, 0x82, 0x29, 0x42, 0x21, 0xa2, 0x29, 0x03, 0x32, 0xe2,
+    0x31, 0x62, 0x29, 0x41, 0x42, 0x21, 0x41, 0x01, 0x19, 0x02, 0xc1, 0x10, 0x41, 0x08, 0x83, 0x29,
+    0x41, 0xc2, 0x31, 0x05, 0x23, 0x3a, 0x03, 0x32, 0xc5, 0x4a, 0xa6, 0x6b, 0x68, 0x84, 0x48, 0x7c,
+    0x41, 0x45, 0x5b, 0x03, 0x26, 0x74, 0xc6, 0x6b, 0x85, 0x31, 0x82, 0x10, 0x64, 0x61, 0x08, 0x62,
+    0x61, 0x08, 0x09, 0x62, 0x08, 0xc7, 0x39, 0x23, 0x21, 0x02, 0x32, 0x43, 0x3a, 0x23, 0x3a, 0xe3,
+    0x31, 0x84, 0x42, 0x43, 0x3a, 0xc2, 0x31, 0x41, 0x42, 0x21, 0x13, 0x82, 0x29, 0x42, 0x21, 0x22,
+    0x21, 0x60, 0x08, 0x25, 0x29, 0xe8, 0x41, 0x60, 0x08, 0x21, 0x21, 0x44, 0x42, 0x84, 0x4a, 0xa4,
+    0x4a, 0xe5, 0x52, 0x25, 0x5b, 0xe4, 0x4a, 0xa4, 0x4a, 0x83, 0x42, 0xc6, 0x6b, 0xe6, 0x6b, 0x02,
+    0x21, 0x41, 0x08, 0x64, 0x61, 0x08, 0x60, 0x61, 0x08, 0x06, 0x62, 0x08, 0x41, 0x08, 0xa6, 0x31,
+    0x64, 0x29, 0xe1, 0x10, 0x44, 0x3a, 0xc3, 0x31, 0x41, 0x23, 0x3a, 0x03, 0x64, 0x42, 0x43, 0x42,
+    0xe3, 0x31, 0x62, 0x21, 0x41, 0x62, 0x29, 0x0e, 0x82, 0x29, 0x60, 0x08, 0xc3, 0x18, 0xe4, 0x20,
+    0x24, 0x21, 0xe3, 0x20, 0x00, 0x19, 0xa2, 0x29, 0x84, 0x4a, 0x63, 0x42, 0x64, 0x42, 0x43, 0x42,
+    0x25, 0x5b, 0x85, 0x63, 0x66, 0x63, 0x41, 0x85, 0x63, 0x02, 0x63, 0x29, 0xe4, 0x18, 0x41, 0x08,
+    0x63, 0x61, 0x08, 0x60, 0x61, 0x08, 0x23, 0x41, 0x08, 0xc3, 0x18, 0xe3, 0x18, 0x62, 0x21, 0x44,
+    0x3a, 0x64, 0x42, 0x03, 0x3a, 0x43, 0x3a, 0x84, 0x42, 0xa4, 0x4a, 0xc4, 0x4a, 0x63, 0x42, 0xe3,
+    0x31, 0xa3, 0x29, 0x82, 0x29, 0x41, 0x21, 0xc3, 0x18, 0x86, 0x31, 0x61, 0x08, 0x82, 0x10, 0x66,
+    0x29, 0x02, 0x19, 0x41, 0x21, 0xe4, 0x52, 0xa4, 0x4a, 0xe3, 0x31, 0x43, 0x42, 0x68, 0x84, 0xea,
+    0x94, 0x4b, 0xa5, 0xc6, 0x6b, 0xe6, 0x6b, 0xe4, 0x52, 0x45, 0x29, 0xa3, 0x10, 0x41, 0x08, 0x62,
+    0x61, 0x08, 0x60, 0x61, 0x08, 0x03, 0xa2, 0x10, 0x24, 0x21, 0x42, 0x21, 0xe3, 0x31, 0x41, 0xa4,
+    0x4a, 0x02, 0xc3, 0x31, 0x62, 0x29, 0xa2, 0x29, 0x41, 0x23, 0x3a, 0x06, 0xc3, 0x31, 0xe3, 0x31,
+    0xa3, 0x29, 0xa2, 0x29, 0xa1, 0x10, 0x86, 0x31, 0xa2, 0x10, 0x41, 0x41, 0x08, 0x0e, 0xc3, 0x18,
+    0x04, 0x21, 0x41, 0x19, 0x04, 0x53, 0x65, 0x63, 0xc4, 0x4a, 0x83, 0x42, 0x07, 0x74, 0xc9, 0x8c,
+    0x0a, 0x95, 0xc9, 0x8c, 0x06, 0x74, 0xa5, 0x63, 0x03, 0x21, 0xa3, 0x18, 0x63, 0x61, 0x08, 0x5d,
+    0x61, 0x08, 0x04, 0x62, 0x08, 0x41, 0x08, 0xa2, 0x10, 0xc3, 0x18, 0x80, 0x08, 0x41, 0xa3, 0x29,
+    0x00, 0xa2, 0x29, 0x41, 0x23, 0x3a, 0x42, 0x42, 0x21, 0x1a, 0x62, 0x29, 0xc2, 0x31, 0x62, 0x21,
+    0x82, 0x29, 0x21, 0x19, 0x24, 0x21, 0xa3, 0x10, 0x41, 0x08, 0x62, 0x08, 0x61, 0x08, 0x82, 0x10,
+    0xc3, 0x18, 0x21, 0x19, 0xa3, 0x42, 0x66, 0x63, 0x48, 0x7c, 0x65, 0x63, 0x84, 0x42, 0xc7, 0x6b,
+    0x65, 0x63, 0x27, 0x7c, 0xc6, 0x6b, 0x03, 0x53, 0xc6, 0x31, 0xa3, 0x18, 0x21, 0x08, 0x62, 0x08,
+    0x61, 0x61, 0x08, 0x5e, 0x61, 0x08, 0x07, 0x62, 0x08, 0xc7, 0x39, 0x22, 0x21, 0x62, 0x29, 0x42,
+    0x21, 0x62, 0x29, 0x43, 0x42, 0x64, 0x42, 0x41, 0x84, 0x42, 0x03, 0x64, 0x42, 0xa3, 0x29, 0x21,
+    0x21, 0x01, 0x19, 0x41, 0x21, 0x21, 0x03, 0xe3, 0x18, 0xe4, 0x18, 0x61, 0x08, 0x62, 0x08, 0x41,
+    0x61, 0x08, 0x06, 0x62, 0x10, 0x04, 0x21, 0xe2, 0x18, 0xe2, 0x31, 0x05, 0x53, 0x48, 0x7c, 0xc6,
+    0x6b, 0x41, 0x84, 0x42, 0x08, 0xc4, 0x4a, 0x24, 0x5b, 0xa5, 0x6b, 0xc3, 0x4a, 0xa5, 0x4a, 0xa6,
+    0x31, 0x04, 0x21, 0x41, 0x08, 0x62, 0x08, 0x60, 0x61, 0x08, 0x5d, 0x61, 0x08, 0x03, 0x62, 0x10,
+    0xe4, 0x20, 0x22, 0x19, 0xa1, 0x29, 0x41, 0x42, 0x21, 0x06, 0x22, 0x19, 0x82, 0x29, 0xc3, 0x31,
+    0xa3, 0x29, 0x23, 0x3a, 0x82, 0x29, 0x62, 0x21, 0x41, 0x42, 0x21, 0x03, 0x21, 0x21, 0x65, 0x29,
+    0xe4, 0x20, 0x41, 0x08, 0x43, 0x61, 0x08, 0x05, 0x41, 0x08, 0x82, 0x10, 0xc2, 0x18, 0xa2, 0x29,
+    0x84, 0x42, 0x25, 0x5b, 0x41, 0xe4, 0x52, 0x09, 0xc4, 0x4a, 0x86, 0x63, 0xa6, 0x6b, 0x63, 0x42,
+    0x42, 0x21, 0xe1, 0x29, 0x63, 0x29, 0x86, 0x31, 0x20, 0x00, 0x62, 0x10, 0x60, 0x61, 0x08, 0x5d,
+    0x61, 0x08, 0x07, 0x45, 0x29, 0x22, 0x21, 0x43, 0x3a, 0xe5, 0x52, 0x44, 0x3a, 0xa2, 0x29, 0xc3,
+    0x31, 0x22, 0x21, 0x41, 0x82, 0x29, 0x07, 0xa2, 0x29, 0x62, 0x29, 0x82, 0x29, 0xa2, 0x29, 0x41,
+    0x21, 0xa2, 0x10, 0x04, 0x21, 0x41, 0x08, 0x45, 0x61, 0x08, 0x41, 0x82, 0x10, 0x0f, 0x81, 0x21,
+    0x84, 0x42, 0xc4, 0x4a, 0xe6, 0x73, 0xe4, 0x52, 0xa4, 0x4a, 0x84, 0x42, 0xe2, 0x31, 0x41, 0x21,
+    0x82, 0x29, 0x24, 0x5b, 0xc5, 0x6b, 0xa5, 0x31, 0xe4, 0x18, 0x41, 0x08, 0x62, 0x08, 0x5f, 0x61,
+    0x08, 0x5c, 0x61, 0x08, 0x03, 0x62, 0x08, 0x41, 0x08, 0xc2, 0x31, 0x04, 0x53, 0x41, 0x86, 0x63,
+    0x0b, 0xa4, 0x4a, 0x05, 0x53, 0x23, 0x3a, 0xe3, 0x31, 0x23, 0x3a, 0x43, 0x3a, 0xc2, 0x31, 0xa2,
+    0x29, 0x21, 0x21, 0x81, 0x10, 0x45, 0x29, 0xa2, 0x10, 0x46, 0x61, 0x08, 0x41, 0x82, 0x10, 0x0e,
+    0xe1, 0x18, 0x03, 0x32, 0x64, 0x42, 0xe5, 0x52, 0x65, 0x5b, 0xc4, 0x4a, 0x24, 0x53, 0x07, 0x74,
+    0x09, 0x7c, 0x8a, 0x8c, 0xa8, 0x8c, 0x28, 0x9d, 0x45, 0x5b, 0x25, 0x21, 0x82, 0x10, 0x60, 0x61,
+    0x08, 0x5b, 0x61, 0x08, 0x07, 0x62, 0x08, 0x41, 0x08, 0x82, 0x10, 0xa2, 0x10, 0x82, 0x29, 0xa4,
+    0x4a, 0x25, 0x5b, 0x64, 0x42, 0x41, 0xc5, 0x4a, 0x09, 0x64, 0x42, 0xe3, 0x31, 0x03, 0x32, 0xe3,
+    0x31, 0x62, 0x21, 0x82, 0x10, 0x45, 0x29, 0x62, 0x10, 0x41, 0x08, 0x62, 0x08, 0x44, 0x61, 0x08,
+    0x12, 0x62, 0x08, 0x41, 0x08, 0x25, 0x21, 0xe2, 0x18, 0x42, 0x21, 0xc3, 0x31, 0x64, 0x42, 0x05,
+    0x53, 0x65, 0x63, 0x87, 0x84, 0x4a, 0x9d, 0x8d, 0xad, 0x0b, 0x9d, 0xe7, 0x73, 0x47, 0x7c, 0xe5,
+    0x6b, 0x63, 0x29, 0xa3, 0x18, 0x41, 0x08, 0x5f, 0x61, 0x08, 0x5d, 0x61, 0x08, 0x10, 0x65, 0x29,
+    0x82, 0x10, 0x21, 0x08, 0xe1, 0x18, 0x64, 0x42, 0xc5, 0x4a, 0xa4, 0x4a, 0x64, 0x42, 0x84, 0x42,
+    0x43, 0x3a, 0x84, 0x42, 0x03, 0x32, 0xe2, 0x18, 0xe4, 0x18, 0x62, 0x08, 0x61, 0x08, 0x62, 0x08,
+    0x45, 0x61, 0x08, 0x12, 0x62, 0x08, 0x41, 0x08, 0xc3, 0x18, 0x65, 0x29, 0x01, 0x19, 0xe2, 0x31,
+    0x43, 0x42, 0x05, 0x53, 0x65, 0x63, 0x68, 0x7c, 0xc9, 0x8c, 0xea, 0x94, 0x07, 0x74, 0x04, 0x53,
+    0x85, 0x63, 0x25, 0x74, 0x81, 0x29, 0x21, 0x08, 0x62, 0x10, 0x5f, 0x61, 0x08, 0x5b, 0x61, 0x08,
+    0x0e, 0x41, 0x08, 0x04, 0x21, 0xc3, 0x18, 0x82, 0x10, 0xc3, 0x18, 0x21, 0x08, 0x20, 0x00, 0x02,
+    0x21, 0x24, 0x3a, 0xa4, 0x4a, 0x43, 0x3a, 0xc2, 0x29, 0xc2, 0x31, 0x22, 0x21, 0xc3, 0x18, 0x4a,
+    0x61, 0x08, 0x11, 0x62, 0x08, 0x41, 0x08, 0x25, 0x21, 0xe1, 0x18, 0x43, 0x3a, 0x25, 0x5b, 0x07,
+    0x74, 0x85, 0x63, 0xa6, 0x63, 0xe7, 0x73, 0x27, 0x74, 0x48, 0x7c, 0x07, 0x74, 0x65, 0x63, 0xe2,
+    0x31, 0x85, 0x31, 0xc3, 0x18, 0x41, 0x08, 0x5f, 0x61, 0x08, 0x59, 0x61, 0x08, 0x04, 0x62, 0x08,
+    0x41, 0x08, 0xc3, 0x18, 0xe4, 0x18, 0x82, 0x10, 0x42, 0xc3, 0x18, 0x00, 0x82, 0x10, 0x41, 0x21,
+    0x08, 0x42, 0x81, 0x10, 0x41, 0xc3, 0x18, 0x00, 0x82, 0x10, 0x4a, 0x61, 0x08, 0x10, 0x62, 0x08,
+    0x41, 0x08, 0x04, 0x21, 0x65, 0x29, 0x61, 0x21, 0xa5, 0x63, 0x27, 0x7c, 0x85, 0x63, 0x27, 0x7c,
+    0xa6, 0x6b, 0x85, 0x63, 0xe7, 0x73, 0x64, 0x42, 0xe3, 0x18, 0x62, 0x10, 0xe4, 0x20, 0x82, 0x10,
+    0x60, 0x61, 0x08, 0x5a, 0x61, 0x08, 0x02, 0x62, 0x08, 0x86, 0x31, 0x61, 0x08, 0x41, 0xe3, 0x18,
+    0x00, 0xc3, 0x18, 0x41, 0xe4, 0x20, 0x06, 0xe3, 0x18, 0xa3, 0x18, 0x82, 0x10, 0x20, 0x00, 0x66,
+    0x29, 0x82, 0x10, 0x41, 0x08, 0x4c, 0x61, 0x08, 0x11, 0x62, 0x08, 0x41, 0x08, 0x45, 0x29, 0x24,
+    0x21, 0x21, 0x19, 0x83, 0x42, 0x84, 0x4a, 0x08, 0x7c, 0x05, 0x5b, 0xc2, 0x31, 0x80, 0x10, 0xa3,
+    0x18, 0xc7, 0x39, 0xc6, 0x39, 0x24, 0x21, 0xe4, 0x18, 0x41, 0x08, 0x62, 0x08, 0x5e, 0x61, 0x08,
+    0x58, 0x61, 0x08, 0x04, 0x62, 0x08, 0x41, 0x08, 0xa7, 0x39, 0xe3, 0x18, 0x82, 0x10, 0x41, 0x04,
+    0x21, 0x07, 0xe4, 0x20, 0x24, 0x21, 0x04, 0x21, 0xe3, 0x18, 0xe4, 0x20, 0x62, 0x10, 0xc3, 0x18,
+    0x45, 0x29, 0x50, 0x61, 0x08, 0x02, 0x41, 0x08, 0x04, 0x21, 0x45, 0x29, 0x41, 0xc1, 0x10, 0x0a,
+    0xc1, 0x18, 0x82, 0x10, 0xa2, 0x10, 0xe4, 0x18, 0xa6, 0x31, 0x49, 0x4a, 0x8a, 0x52, 0x24, 0x21,
+    0xe7, 0x39, 0xc3, 0x18, 0x21, 0x08, 0x5e, 0x61, 0x08, 0x57, 0x61, 0x08, 0x06, 0x62, 0x08, 0x20,
+    0x00, 0x65, 0x29, 0x04, 0x21, 0x41, 0x08, 0xe4, 0x20, 0xe3, 0x18, 0x41, 0x04, 0x21, 0x00, 0x45,
+    0x29, 0x41, 0x25, 0x29, 0x41, 0xa3, 0x18, 0x01, 0xe8, 0x39, 0x41, 0x08, 0x50, 0x61, 0x08, 0x12,
+    0x62, 0x08, 0x41, 0x08, 0xe3, 0x18, 0x66, 0x29, 0x62, 0x10, 0xa3, 0x18, 0x04, 0x21, 0x25, 0x29,
+    0xa6, 0x31, 0xa6, 0x39, 0xc7, 0x39, 0xe7, 0x39, 0xc7, 0x39, 0x04, 0x21, 0x66, 0x29, 0x04, 0x21,
+    0x41, 0x08, 0x62, 0x10, 0x82, 0x10, 0x42, 0x62, 0x10, 0x41, 0x61, 0x08, 0x00, 0x62, 0x08, 0x55,
+    0x61, 0x08, 0x56, 0x61, 0x08, 0x07, 0x62, 0x08, 0x41, 0x08, 0x04, 0x21, 0x65, 0x29, 0x82, 0x10,
+    0xc3, 0x18, 0xe3, 0x18, 0xc3, 0x18, 0x41, 0xe3, 0x18, 0x07, 0x04, 0x21, 0x25, 0x29, 0x45, 0x29,
+    0x62, 0x10, 0xe8, 0x39, 0xc3, 0x18, 0x41, 0x08, 0x62, 0x10, 0x50, 0x61, 0x08, 0x02, 0x62, 0x10,
+    0x21, 0x00, 0x24, 0x21, 0x41, 0xc3, 0x18, 0x09, 0x24, 0x21, 0x04, 0x21, 0x45, 0x29, 0x65, 0x29,
+    0x86, 0x31, 0xc7, 0x39, 0x86, 0x31, 0x25, 0x29, 0x86, 0x31, 0xc7, 0x39, 0x41, 0x65, 0x29, 0x42,
+    0x45, 0x29, 0x03, 0x04, 0x21, 0xe3, 0x18, 0x62, 0x10, 0x41, 0x08, 0x55, 0x61, 0x08, 0x56, 0x61,
+    0x08, 0x05, 0x62, 0x10, 0x20, 0x00, 0x49, 0x4a, 0xa3, 0x18, 0xa2, 0x10, 0xe4, 0x20, 0x41, 0xc3,
+    0x18, 0x41, 0xe3, 0x18, 0x03, 0xe3, 0x20, 0x24, 0x21, 0x65, 0x29, 0x04, 0x21, 0x41, 0x45, 0x29,
+    0x42, 0x41, 0x08, 0x51, 0x61, 0x08, 0x02, 0x82, 0x10, 0x86, 0x31, 0xc3, 0x18, 0x41, 0x25, 0x29,
+    0x02, 0x04, 0x21, 0x24, 0x21, 0x45, 0x29, 0x41, 0x86, 0x31, 0x0b, 0xe8, 0x41, 0xc7, 0x39, 0x45,
+    0x29, 0x86, 0x31, 0xe4, 0x20, 0x24, 0x21, 0x08, 0x42, 0xeb, 0x5a, 0x8a, 0x52, 0x45, 0x29, 0xc7,
+    0x39, 0xc3, 0x18, 0x55, 0x61, 0x08, 0x56, 0x61, 0x08, 0x06, 0x62, 0x08, 0x21, 0x08, 0xc7, 0x39,
+    0xe4, 0x20, 0x41, 0x08, 0xc3, 0x18, 0x04, 0x21, 0x41, 0xc3, 0x18, 0x41, 0xe3, 0x18, 0x07, 0x45,
+    0x29, 0xa6, 0x31, 0x66, 0x31, 0xa2, 0x18, 0xe4, 0x20, 0xa7, 0x31, 0x04, 0x21, 0xc3, 0x18, 0x51,
+    0x61, 0x08, 0x04, 0x41, 0x08, 0x24, 0x21, 0xe4, 0x20, 0xa3, 0x18, 0x24, 0x21, 0x41, 0x04, 0x21,
+    0x05, 0x24, 0x21, 0x45, 0x29, 0x86, 0x31, 0x28, 0x42, 0xc7, 0x39, 0xe7, 0x39, 0x41, 0x08, 0x42,
+    0x06, 0x49, 0x4a, 0x69, 0x4a, 0xab, 0x5a, 0xaa, 0x52, 0xe7, 0x39, 0x04, 0x21, 0x86, 0x31, 0x55,
+    0x61, 0x08, 0x59, 0x61, 0x08, 0x10, 0x45, 0x29, 0x24, 0x21, 0x82, 0x10, 0xa2, 0x10, 0x82, 0x10,
+    0xa2, 0x10, 0xa3, 0x18, 0xc3, 0x18, 0x45, 0x29, 0x86, 0x31, 0x66, 0x31, 0x04, 0x21, 0xa3, 0x18,
+    0x25, 0x29, 0xa6, 0x31, 0x24, 0x21, 0x04, 0x21, 0x53, 0x61, 0x08, 0x0d, 0x82, 0x10, 0x04, 0x21,
+    0xe4, 0x20, 0x04, 0x21, 0x24, 0x21, 0x45, 0x29, 0x65, 0x29, 0x86, 0x31, 0xe7, 0x39, 0xe8, 0x41,
+    0xe7, 0x39, 0xc7, 0x39, 0x86, 0x31, 0x65, 0x29, 0x41, 0x45, 0x29, 0x02, 0x24, 0x29, 0x82, 0x10,
+    0x24, 0x21, 0x55, 0x61, 0x08, 0x56, 0x61, 0x08, 0x00, 0x62, 0x08, 0x41, 0x82, 0x10, 0x10, 0x41,
+    0x08, 0x24, 0x21, 0x45, 0x29, 0xa2, 0x10, 0x00, 0x00, 0x21, 0x08, 0xa2, 0x10, 0xa2, 0x18, 0x04,
+    0x21, 0x45, 0x29, 0x24, 0x21, 0x04, 0x21, 0x45, 0x29, 0xa6, 0x31, 0xe8, 0x41, 0x04, 0x21, 0xe3,
+    0x18, 0x53, 0x61, 0x08, 0x02, 0x62, 0x10, 0x25, 0x29, 0x45, 0x29, 0x42, 0x04, 0x21, 0x41, 0x24,
+    0x29, 0x0a, 0x45, 0x29, 0x66, 0x31, 0x65, 0x29, 0x45, 0x29, 0x25, 0x29, 0x24, 0x21, 0xe4, 0x20,
+    0xc3, 0x18, 0x82, 0x10, 0x45, 0x29, 0x04, 0x21, 0x55, 0x61, 0x08,
+};
+
+static const uint8_t MAIN_anim_soldier_frame1[6815] = {
+    0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7,
+    0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7, 0xaf, 0x00, 0x62, 0x08, 0xb6, 0xac,
+    0x00, 0x62, 0x08, 0x41, 0x61, 0x08, 0x00, 0x41, 0x08, 0x00, 0x61, 0x08, 0x86, 0x41, 0x62, 0x08,
+    0x81, 0x00, 0x61, 0x08, 0x80, 0x41, 0x61, 0x08, 0xa6, 0xab, 0x01, 0x62, 0x08, 0x41, 0x08, 0x41,
+    0x61, 0x08, 0x00, 0x04, 0x21, 0x43, 0x62, 0x08, 0x42, 0x41, 0x08, 0x02, 0x62, 0x08, 0x41, 0x08,
+    0x21, 0x08, 0x80, 0x42, 0x61, 0x08, 0x00, 0x62, 0x08, 0x41, 0x61, 0x08, 0xa5, 0xaa, 0x07, 0x62,
+    0x08, 0x41, 0x08, 0x04, 0x21, 0x62, 0x08, 0x25, 0x21, 0x67, 0x42, 0x62, 0x21, 0xe3, 0x31, 0x80,
+    0x08, 0x44, 0x3a, 0x24, 0x3a, 0xe3, 0x31, 0x41, 0x21, 0xe5, 0x39, 0xa5, 0x31, 0x64, 0x29, 0xc3,
+    0x18, 0x62, 0x08, 0x41, 0x82, 0x10, 0x02, 0x41, 0x08, 0x61, 0x08, 0x62, 0x08, 0xa5, 0xaa, 0x0b,
+    0x41, 0x08, 0xe4, 0x18, 0x28, 0x42, 0x21, 0x19, 0x04, 0x3a, 0xc4, 0x4a, 0x25, 0x53, 0x86, 0x5b,
+    0xc7, 0x63, 0x07, 0x6c, 0x48, 0x7c, 0x68, 0x7c, 0x41, 0x88, 0x84, 0x09, 0xc6, 0x6b, 0x04, 0x4b,
+    0x64, 0x29, 0x04, 0x21, 0xe3, 0x20, 0xa2, 0x10, 0x45, 0x29, 0xa2, 0x10, 0x41, 0x08, 0x62, 0x08,
+    0xa4, 0xa8, 0x05, 0x62, 0x08, 0x41, 0x08, 0xe3, 0x18, 0x85, 0x29, 0x03, 0x32, 0xe5, 0x4a, 0x41,
+    0x05, 0x53, 0x05, 0x46, 0x5b, 0x67, 0x5b, 0x87, 0x63, 0xa7, 0x63, 0xe7, 0x6b, 0x07, 0x74, 0x41,
+    0x68, 0x7c, 0x09, 0x25, 0x53, 0xe5, 0x39, 0xa6, 0x39, 0x04, 0x21, 0xa2, 0x10, 0xe3, 0x18, 0xc3,
+    0x18, 0x66, 0x29, 0x61, 0x08, 0x41, 0x08, 0x41, 0x61, 0x08, 0xa2, 0xa7, 0x06, 0x62, 0x08, 0x41,
+    0x08, 0xe3, 0x18, 0x44, 0x21, 0xc3, 0x31, 0x84, 0x42, 0xa5, 0x42, 0x80, 0x02, 0xc5, 0x4a, 0xe5,
+    0x4a, 0x06, 0x53, 0x41, 0x26, 0x53, 0x05, 0x46, 0x5b, 0xc7, 0x63, 0x07, 0x6c, 0x84, 0x42, 0x85,
+    0x31, 0xc8, 0x39, 0x41, 0x45, 0x21, 0x04, 0x44, 0x19, 0x69, 0x22, 0xe7, 0x21, 0xa3, 0x18, 0x86,
+    0x31, 0x42, 0x61, 0x08, 0xa2, 0xa7, 0x06, 0x41, 0x08, 0xa3, 0x18, 0xe4, 0x20, 0x42, 0x21, 0x84,
+    0x42, 0x44, 0x3a, 0x85, 0x42, 0x80, 0x02, 0xc5, 0x4a, 0xe5, 0x4a, 0x26, 0x53, 0x41, 0x06, 0x53,
+    0x0e, 0x26, 0x53, 0xc7, 0x63, 0x66, 0x5b, 0x23, 0x21, 0x29, 0x4a, 0x28, 0x42, 0x49, 0x42, 0x69,
+    0x4a, 0x06, 0x3a, 0x68, 0x2a, 0xcc, 0x3a, 0xe4, 0x20, 0x25, 0x29, 0xa3, 0x18, 0x41, 0x08, 0x00,
+    0x61, 0x08, 0xa2, 0xa6, 0x1a, 0x62, 0x08, 0x41, 0x08, 0x04, 0x21, 0xe3, 0x18, 0xc3, 0x31, 0x44,
+    0x3a, 0x85, 0x42, 0xa5, 0x4a, 0xe4, 0x31, 0xa3, 0x29, 0xe4, 0x31, 0xa3, 0x29, 0x83, 0x29, 0xa3,
+    0x29, 0xe3, 0x31, 0x44, 0x3a, 0x42, 0x21, 0x45, 0x29, 0xcb, 0x52, 0x69, 0x32, 0x89, 0x42, 0x69,
+    0x42, 0x27, 0x42, 0x26, 0x32, 0x8a, 0x2a, 0x86, 0x29, 0x61, 0x08, 0x80, 0x00, 0x61, 0x08, 0xa3,
+    0xa7, 0x18, 0x41, 0x08, 0xa7, 0x31, 0x23, 0x21, 0x62, 0x21, 0xc3, 0x31, 0xe4, 0x31, 0xc4, 0x31,
+    0x02, 0x19, 0xc2, 0x10, 0x81, 0x08, 0x43, 0x29, 0x05, 0x3a, 0xc4, 0x39, 0xc1, 0x18, 0x81, 0x08,
+    0x81, 0x10, 0x85, 0x29, 0x69, 0x4a, 0x49, 0x32, 0x69, 0x3a, 0x69, 0x4a, 0x68, 0x4a, 0x47, 0x3a,
+    0x67, 0x2a, 0x85, 0x29, 0x41, 0x62, 0x10, 0x00, 0x61, 0x08, 0xa3, 0xa5, 0x05, 0x62, 0x08, 0x41,
+    0x08, 0x86, 0x31, 0x65, 0x29, 0x61, 0x08, 0xa2, 0x18, 0x42, 0xe2, 0x18, 0x03, 0x23, 0x21, 0x43,
+    0x21, 0x02, 0x19, 0x87, 0x6b, 0x41, 0x0b, 0x9d, 0x0a, 0x47, 0x63, 0xc3, 0x31, 0xc4, 0x31, 0x03,
+    0x19, 0x65, 0x31, 0xc6, 0x31, 0xc7, 0x31, 0xc7, 0x39, 0xa6, 0x31, 0xe3, 0x18, 0xa2, 0x10, 0x80,
+    0x01, 0x82, 0x10, 0x62, 0x08, 0x00, 0x61, 0x08, 0xa3, 0xa6, 0x05, 0x61, 0x08, 0x29, 0x4a, 0x81,
+    0x10, 0x42, 0x21, 0xe3, 0x31, 0x65, 0x42, 0x80, 0x42, 0x85, 0x42, 0x00, 0xa5, 0x4a, 0x41, 0xc5,
+    0x4a, 0x05, 0x26, 0x53, 0xe5, 0x4a, 0xe3, 0x31, 0x83, 0x29, 0xc1, 0x18, 0xa1, 0x10, 0x42, 0xc2,
+    0x18, 0x05, 0xa1, 0x10, 0x81, 0x10, 0x20, 0x00, 0x00, 0x00, 0xc3, 0x18, 0x62, 0x10, 0x41, 0x61,
+    0x08, 0xa2, 0xa7, 0x03, 0x28, 0x42, 0xc1, 0x10, 0x82, 0x29, 0x04, 0x3a, 0x42, 0x64, 0x42, 0x01,
+    0x44, 0x3a, 0x24, 0x3a, 0x41, 0x44, 0x3a, 0x03, 0x44, 0x42, 0x03, 0x32, 0x81, 0x10, 0x20, 0x00,
+    0x80, 0x41, 0x81, 0x08, 0x02, 0xa1, 0x08, 0xa1, 0x10, 0xa1, 0x08, 0x41, 0xe1, 0x18, 0x03, 0x40,
+    0x08, 0xe4, 0x18, 0x45, 0x29, 0x41, 0x08, 0x42, 0x61, 0x08, 0xa1, 0xa7, 0x11, 0x29, 0x4a, 0x81,
+    0x10, 0x62, 0x21, 0xe4, 0x31, 0x24, 0x3a, 0x44, 0x3a, 0xe4, 0x31, 0xe2, 0x18, 0xa1, 0x10, 0xc2,
+    0x18, 0xe1, 0x18, 0xe2, 0x18, 0x61, 0x10, 0x00, 0x00, 0xa4, 0x51, 0x05, 0x62, 0xc4, 0x59, 0xe4,
+    0x59, 0x41, 0x05, 0x62, 0x05, 0xc4, 0x59, 0x20, 0x08, 0xa3, 0x10, 0x86, 0x31, 0xa3, 0x18, 0x41,
+    0x08, 0x42, 0x61, 0x08, 0xa2, 0xa5, 0x06, 0x62, 0x08, 0x41, 0x08, 0x24, 0x21, 0x04, 0x21, 0x60,
+    0x08, 0xc1, 0x10, 0x02, 0x19, 0x80, 0x13, 0xa1, 0x10, 0x41, 0x08, 0xa2, 0x28, 0xc2, 0x30, 0x02,
+    0x39, 0x03, 0x31, 0x61, 0x08, 0xa4, 0x49, 0x4b, 0xc4, 0x6b, 0xcc, 0x8c, 0xd4, 0x2a, 0xc4, 0x46,
+    0x6a, 0xe5, 0x51, 0xe9, 0xbb, 0xa6, 0x39, 0x25, 0x21, 0x82, 0x10, 0x41, 0x08, 0x62, 0x08, 0x80,
+    0x00, 0x61, 0x08, 0xa3, 0xa7, 0x03, 0x41, 0x08, 0x45, 0x29, 0x66, 0x31, 0x25, 0x29, 0x00, 0x41,
+    0x08, 0x80, 0x09, 0x82, 0x10, 0x03, 0x29, 0x66, 0x72, 0x05, 0x6a, 0xa7, 0x7a, 0x67, 0x6a, 0x00,
+    0x00, 0x66, 0x62, 0x4e, 0xe5, 0xb0, 0xe5, 0x41, 0x32, 0xf6, 0x06, 0x4f, 0xdd, 0x0d, 0xd5, 0x31,
+    0xf6, 0x4e, 0x9c, 0x21, 0x00, 0x61, 0x08, 0x62, 0x08, 0x00, 0x61, 0x08, 0xa5, 0xa7, 0x17, 0x62,
+    0x08, 0x41, 0x08, 0x04, 0x21, 0xa7, 0x39, 0x86, 0x31, 0x61, 0x08, 0xc3, 0x18, 0xc2, 0x18, 0xe8,
+    0x8a, 0x8a, 0xa3, 0xeb, 0xb3, 0x26, 0x62, 0x00, 0x00, 0x46, 0x62, 0x4e, 0xe5, 0xb1, 0xe5, 0x74,
+    0xf6, 0xb6, 0xfe, 0xb5, 0xfe, 0x73, 0xfe, 0x52, 0xf6, 0x0e, 0xcd, 0xa3, 0x10, 0x41, 0x08, 0x41,
+    0x61, 0x08, 0xa5, 0xa8, 0x17, 0x62, 0x08, 0x41, 0x08, 0x00, 0x00, 0x04, 0x21, 0x25, 0x29, 0xa2,
+    0x10, 0x82, 0x10, 0xc3, 0x18, 0xe3, 0x18, 0x03, 0x21, 0xe3, 0x20, 0x20, 0x00, 0x67, 0x62, 0x6e,
+    0xed, 0x4f, 0xdd, 0xf2, 0xed, 0x54, 0xf6, 0xb5, 0xfe, 0x53, 0xfe, 0x0d, 0xd5, 0xce, 0xcc, 0x24,
+    0x29, 0x21, 0x00, 0x62, 0x10, 0x00, 0x61, 0x08, 0xa5, 0xa3, 0x42, 0x61, 0x08, 0x80, 0x00, 0x62,
+    0x08, 0x80, 0x0e, 0x61, 0x08, 0x62, 0x10, 0x21, 0x00, 0xe4, 0x18, 0xa3, 0x18, 0xa1, 0x20, 0x26,
+    0x6a, 0xe5, 0x59, 0xc5, 0x51, 0x23, 0x31, 0x41, 0x00, 0xa5, 0x41, 0x2e, 0xe5, 0x2d, 0xdd, 0x6f,
+    0xe5, 0x41, 0x12, 0xee, 0x02, 0xb1, 0xe5, 0xea, 0xbb, 0xa6, 0x41, 0x41, 0x61, 0x08, 0xa7, 0x9d,
+    0x00, 0x62, 0x08, 0x81, 0x01, 0x61, 0x08, 0x41, 0x08, 0x42, 0x82, 0x10, 0x00, 0x62, 0x10, 0x00,
+    0x61, 0x08, 0x80, 0x16, 0x62, 0x08, 0xc7, 0x39, 0xa6, 0x31, 0xe3, 0x18, 0xa6, 0x31, 0xa2, 0x10,
+    0x82, 0x31, 0xa5, 0x6a, 0x07, 0x83, 0xaa, 0xb3, 0x8a, 0xb3, 0x84, 0x49, 0x41, 0x00, 0x29, 0x83,
+    0x6e, 0xed, 0x6e, 0xe5, 0xd1, 0xed, 0x8d, 0xc4, 0x68, 0xa3, 0xab, 0xa3, 0x62, 0x08, 0x41, 0x08,
+    0x62, 0x08, 0x00, 0x61, 0x08, 0xa6, 0x9c, 0x01, 0x62, 0x08, 0x41, 0x08, 0x41, 0x61, 0x08, 0x06,
+    0x41, 0x08, 0x86, 0x31, 0x48, 0x4a, 0x07, 0x42, 0x48, 0x42, 0x24, 0x21, 0xa3, 0x18, 0x41, 0x04,
+    0x21, 0x02, 0x23, 0x21, 0x22, 0x21, 0x83, 0x29, 0x80, 0x10, 0x02, 0x19, 0x43, 0x3a, 0x05, 0x53,
+    0x84, 0x42, 0x64, 0x52, 0x07, 0x83, 0xa7, 0x82, 0xc2, 0x20, 0xc2, 0x18, 0x67, 0x5a, 0x2b, 0xac,
+    0x6f, 0xdd, 0x31, 0xfe, 0x0d, 0xd5, 0x48, 0x52, 0x41, 0x08, 0x62, 0x10, 0x41, 0x61, 0x08, 0xa6,
+    0x9b, 0x11, 0x62, 0x08, 0x41, 0x08, 0xe3, 0x18, 0xa3, 0x18, 0x82, 0x10, 0xc3, 0x18, 0x05, 0x3a,
+    0xc4, 0x4a, 0xe4, 0x4a, 0x04, 0x53, 0xa3, 0x42, 0x83, 0x29, 0x02, 0x19, 0x42, 0x21, 0xc1, 0x10,
+    0x81, 0x10, 0xe1, 0x18, 0x22, 0x19, 0x41, 0x02, 0x19, 0x0c, 0x62, 0x29, 0x44, 0x42, 0xc7, 0x73,
+    0x86, 0x63, 0x24, 0x4a, 0x63, 0x39, 0xe2, 0x28, 0x81, 0x10, 0xe2, 0x18, 0xe5, 0x41, 0x87, 0x5a,
+    0xa4, 0x39, 0xc3, 0x18, 0x42, 0x61, 0x08, 0xa7, 0x9b, 0x08, 0x41, 0x08, 0xe4, 0x20, 0xa6, 0x31,
+    0xc3, 0x31, 0x64, 0x42, 0xa5, 0x4a, 0xa6, 0x63, 0x27, 0x74, 0xe7, 0x6b, 0x80, 0x06, 0x45, 0x53,
+    0x84, 0x42, 0xa3, 0x29, 0x62, 0x21, 0x02, 0x19, 0xe2, 0x18, 0x63, 0x29, 0x41, 0xe4, 0x31, 0x80,
+    0x0e, 0xe2, 0x18, 0xa1, 0x10, 0x22, 0x21, 0xe5, 0x52, 0x06, 0x74, 0x25, 0x5b, 0xc4, 0x41, 0x43,
+    0x39, 0x81, 0x10, 0xa2, 0x10, 0x82, 0x10, 0x04, 0x21, 0x65, 0x29, 0x41, 0x08, 0x62, 0x08, 0xa8,
+    0x9b, 0x06, 0xe4, 0x18, 0x23, 0x21, 0xc2, 0x29, 0x25, 0x53, 0x66, 0x5b, 0x46, 0x5b, 0x66, 0x5b,
+    0x41, 0x86, 0x5b, 0x15, 0x05, 0x53, 0x83, 0x29, 0x22, 0x21, 0xc2, 0x18, 0x40, 0x08, 0x20, 0x00,
+    0x40, 0x08, 0x61, 0x08, 0xa1, 0x10, 0x43, 0x21, 0xa7, 0x4a, 0x25, 0x42, 0x63, 0x29, 0x43, 0x21,
+    0x61, 0x08, 0x03, 0x3a, 0x65, 0x5b, 0xe4, 0x52, 0xc4, 0x52, 0xa3, 0x31, 0x46, 0x29, 0x45, 0x29,
+    0x41, 0x41, 0x08, 0x00, 0x62, 0x08, 0xa9, 0x9a, 0x05, 0x66, 0x29, 0x03, 0x21, 0x84, 0x42, 0xa5,
+    0x42, 0x24, 0x3a, 0xa5, 0x42, 0x43, 0xc5, 0x4a, 0x16, 0x62, 0x29, 0xc2, 0x18, 0x81, 0x10, 0x20,
+    0x00, 0x43, 0x29, 0x05, 0x53, 0xe5, 0x52, 0x06, 0x5b, 0xc3, 0x31, 0xa1, 0x10, 0xc5, 0x31, 0xc7,
+    0x52, 0x86, 0x4a, 0xe6, 0x4a, 0x04, 0x32, 0x40, 0x00, 0xc1, 0x10, 0xc4, 0x52, 0x85, 0x6b, 0xe1,
+    0x18, 0x43, 0x21, 0xc5, 0x31, 0x45, 0x29, 0x41, 0x41, 0x08, 0xa9, 0x99, 0x05, 0x82, 0x10, 0x04,
+    0x21, 0xc2, 0x31, 0x86, 0x63, 0xc5, 0x4a, 0x84, 0x42, 0x41, 0xa5, 0x42, 0x04, 0xa4, 0x42, 0xa5,
+    0x42, 0x83, 0x29, 0xa1, 0x10, 0x81, 0x10, 0x80, 0x15, 0x46, 0x63, 0x09, 0x95, 0xe6, 0x6b, 0xc4,
+    0x4a, 0x04, 0x53, 0xc6, 0x6b, 0xe4, 0x52, 0xe1, 0x18, 0x63, 0x21, 0x25, 0x3a, 0x45, 0x3a, 0x26,
+    0x53, 0xe6, 0x52, 0x42, 0x21, 0xc1, 0x10, 0x62, 0x29, 0x81, 0x10, 0x22, 0x3a, 0x02, 0x3a, 0x85,
+    0x31, 0xc7, 0x39, 0xa2, 0x10, 0x00, 0x61, 0x08, 0xa8, 0x98, 0x05, 0x41, 0x08, 0xe3, 0x18, 0x65,
+    0x29, 0xc2, 0x31, 0xa4, 0x4a, 0x64, 0x3a, 0x00, 0x84, 0x42, 0x80, 0x1e, 0x84, 0x42, 0x85, 0x42,
+    0xa3, 0x29, 0xc2, 0x10, 0xa1, 0x10, 0x61, 0x08, 0x87, 0x6b, 0x4a, 0x9d, 0x27, 0x74, 0xc8, 0x84,
+    0x27, 0x74, 0x83, 0x42, 0x85, 0x63, 0xa5, 0x63, 0xc6, 0x6b, 0x81, 0x10, 0xa1, 0x10, 0x65, 0x42,
+    0x49, 0x74, 0x48, 0x74, 0xe8, 0x6b, 0x63, 0x21, 0x81, 0x10, 0x42, 0x21, 0x02, 0x19, 0x64, 0x42,
+    0xe2, 0x31, 0x63, 0x29, 0xa6, 0x31, 0x41, 0x08, 0x62, 0x08, 0xa7, 0x98, 0x05, 0x41, 0x08, 0x05,
+    0x21, 0x23, 0x21, 0x84, 0x42, 0x64, 0x3a, 0x84, 0x42, 0x80, 0x00, 0x85, 0x42, 0x80, 0x1e, 0xe4,
+    0x31, 0xc2, 0x18, 0xc1, 0x10, 0x40, 0x08, 0x87, 0x63, 0xc9, 0x8c, 0x68, 0x84, 0xe9, 0x8c, 0x47,
+    0x7c, 0x04, 0x53, 0x63, 0x42, 0xa4, 0x42, 0x48, 0x7c, 0x6b, 0x9d, 0x44, 0x42, 0x81, 0x10, 0xa4,
+    0x29, 0x67, 0x63, 0xc7, 0x63, 0xe8, 0x6b, 0x08, 0x74, 0x63, 0x29, 0xa1, 0x10, 0x62, 0x21, 0x42,
+    0x21, 0x62, 0x21, 0xc2, 0x29, 0x66, 0x31, 0xc3, 0x18, 0x41, 0x08, 0x62, 0x08, 0x00, 0x61, 0x08,
+    0xa5, 0x96, 0x07, 0x62, 0x08, 0x41, 0x08, 0x45, 0x29, 0x03, 0x19, 0xe2, 0x29, 0xe3, 0x31, 0x24,
+    0x32, 0x64, 0x3a, 0x81, 0x20, 0xa5, 0x42, 0x43, 0x21, 0xc1, 0x10, 0x00, 0x00, 0x82, 0x29, 0x65,
+    0x63, 0xe4, 0x52, 0x86, 0x63, 0x07, 0x74, 0xa4, 0x4a, 0xe4, 0x52, 0xc4, 0x4a, 0xe2, 0x31, 0x66,
+    0x63, 0xc9, 0x8c, 0xc7, 0x6b, 0x02, 0x21, 0x23, 0x21, 0x84, 0x29, 0x87, 0x5b, 0x87, 0x63, 0xa7,
+    0x63, 0x46, 0x5b, 0x82, 0x29, 0x22, 0x21, 0x02, 0x19, 0x82, 0x29, 0xc3, 0x29, 0x23, 0x21, 0xa7,
+    0x39, 0xa2, 0x10, 0x41, 0x08, 0x62, 0x08, 0x00, 0x61, 0x08, 0xa4, 0x96, 0x06, 0x62, 0x08, 0x41,
+    0x08, 0x08, 0x42, 0x02, 0x19, 0x43, 0x3a, 0xa3, 0x29, 0x04, 0x32, 0x41, 0x64, 0x3a, 0x1a, 0x64,
+    0x42, 0x83, 0x29, 0xc2, 0x18, 0x40, 0x08, 0x22, 0x21, 0x06, 0x74, 0x05, 0x53, 0x84, 0x42, 0xe4,
+    0x4a, 0xe4, 0x52, 0xe4, 0x4a, 0x68, 0x84, 0xc9, 0x94, 0x05, 0x53, 0x44, 0x42, 0x04, 0x53, 0x65,
+    0x63, 0x83, 0x29, 0x05, 0x3a, 0xe2, 0x18, 0xc4, 0x31, 0xe5, 0x4a, 0xa4, 0x4a, 0xe5, 0x52, 0xa4,
+    0x4a, 0xc3, 0x31, 0x42, 0x21, 0x00, 0x83, 0x29, 0x80, 0x04, 0x82, 0x29, 0x84, 0x29, 0x66, 0x31,
+    0x41, 0x08, 0x62, 0x08, 0x41, 0x61, 0x08, 0xa3, 0x97, 0x10, 0x41, 0x08, 0x24, 0x29, 0xe2, 0x18,
+    0xe1, 0x18, 0x22, 0x21, 0xc3, 0x31, 0x64, 0x3a, 0x44, 0x3a, 0xa3, 0x29, 0xa2, 0x10, 0xa1, 0x10,
+    0x41, 0x08, 0x05, 0x53, 0x09, 0x95, 0x65, 0x5b, 0x05, 0x53, 0xa6, 0x63, 0x41, 0xe7, 0x73, 0x17,
+    0x0a, 0x9d, 0x4a, 0x9d, 0x66, 0x63, 0xe3, 0x31, 0x83, 0x42, 0xe3, 0x31, 0x23, 0x21, 0xc7, 0x52,
+    0x05, 0x3a, 0x62, 0x08, 0x03, 0x3a, 0x07, 0x74, 0xe7, 0x6b, 0xc7, 0x6b, 0xa7, 0x63, 0x26, 0x5b,
+    0x42, 0x21, 0xa1, 0x10, 0x03, 0x32, 0xe3, 0x31, 0x85, 0x29, 0xc3, 0x18, 0x41, 0x08, 0x62, 0x08,
+    0xa4, 0x97, 0x07, 0x82, 0x10, 0x04, 0x21, 0x22, 0x21, 0xe1, 0x18, 0x81, 0x10, 0xe2, 0x18, 0x02,
+    0x19, 0xe2, 0x18, 0x41, 0xa1, 0x10, 0x19, 0x00, 0x00, 0x83, 0x31, 0x88, 0x84, 0xe6, 0x6b, 0x65,
+    0x5b, 0xc6, 0x6b, 0x47, 0x7c, 0xa9, 0x8c, 0x89, 0x84, 0xc9, 0x8c, 0xa9, 0x8c, 0x25, 0x5b, 0x03,
+    0x32, 0xe4, 0x52, 0x60, 0x08, 0xa2, 0x10, 0x27, 0x5b, 0x26, 0x42, 0xe3, 0x18, 0x81, 0x10, 0x85,
+    0x4a, 0x46, 0x5b, 0x67, 0x63, 0x67, 0x5b, 0x87, 0x63, 0x47, 0x5b, 0x41, 0x42, 0x21, 0x02, 0x44,
+    0x3a, 0x83, 0x29, 0x25, 0x21, 0x43, 0x61, 0x08, 0xa2, 0x97, 0x06, 0x62, 0x10, 0x24, 0x21, 0x02,
+    0x19, 0x22, 0x21, 0xe2, 0x18, 0x02, 0x19, 0x22, 0x21, 0x41, 0x43, 0x21, 0x00, 0x61, 0x10, 0x80,
+    0x15, 0x48, 0x84, 0x88, 0x84, 0xa4, 0x4a, 0xc4, 0x4a, 0x45, 0x5b, 0xc6, 0x6b, 0x07, 0x74, 0xe7,
+    0x6b, 0xc7, 0x6b, 0xc6, 0x6b, 0x25, 0x5b, 0x82, 0x29, 0x23, 0x3a, 0x20, 0x00, 0x03, 0x21, 0x28,
+    0x5b, 0x46, 0x42, 0x65, 0x29, 0x21, 0x08, 0xe4, 0x39, 0x26, 0x5b, 0xe6, 0x52, 0x41, 0xc5, 0x4a,
+    0x06, 0x66, 0x5b, 0xc5, 0x4a, 0xa1, 0x10, 0x04, 0x32, 0x83, 0x29, 0x04, 0x21, 0x62, 0x08, 0x00,
+    0x61, 0x08, 0xa4, 0x95, 0x05, 0x62, 0x08, 0x21, 0x08, 0xc7, 0x39, 0xe7, 0x41, 0x42, 0x21, 0xe1,
+    0x18, 0x80, 0x00, 0x02, 0x19, 0x41, 0x63, 0x21, 0x12, 0x22, 0x21, 0x40, 0x08, 0xc2, 0x18, 0x4a,
+    0x9d, 0x47, 0x7c, 0x63, 0x42, 0x43, 0x3a, 0xc4, 0x4a, 0x45, 0x5b, 0xa6, 0x63, 0x46, 0x5b, 0x25,
+    0x53, 0x04, 0x53, 0x63, 0x42, 0x01, 0x19, 0x61, 0x08, 0x41, 0x08, 0xc4, 0x31, 0xa6, 0x4a, 0x80,
+    0x05, 0x85, 0x31, 0x82, 0x10, 0x22, 0x21, 0x26, 0x5b, 0xc5, 0x4a, 0xa5, 0x4a, 0x81, 0x05, 0x85,
+    0x4a, 0xa1, 0x10, 0xc3, 0x29, 0x62, 0x21, 0x04, 0x21, 0x62, 0x08, 0x00, 0x61, 0x08, 0xa4, 0x94,
+    0x13, 0x62, 0x08, 0x41, 0x08, 0x04, 0x21, 0x28, 0x42, 0x62, 0x21, 0x43, 0x3a, 0xe1, 0x18, 0xc1,
+    0x10, 0x03, 0x32, 0xa4, 0x42, 0x64, 0x42, 0xa3, 0x29, 0xa1, 0x10, 0x65, 0x42, 0x88, 0x84, 0x65,
+    0x63, 0x04, 0x53, 0x07, 0x74, 0x27, 0x7c, 0x65, 0x5b, 0x41, 0x45, 0x5b, 0x0c, 0x25, 0x5b, 0xc4,
+    0x4a, 0x43, 0x3a, 0x60, 0x08, 0x20, 0x08, 0xa2, 0x10, 0x05, 0x3a, 0x25, 0x3a, 0xa5, 0x31, 0xa6,
+    0x31, 0x45, 0x29, 0x20, 0x00, 0xa3, 0x29, 0x41, 0x85, 0x42, 0x07, 0xa5, 0x4a, 0x05, 0x53, 0x85,
+    0x42, 0x61, 0x08, 0x42, 0x21, 0x02, 0x19, 0x04, 0x21, 0x62, 0x08, 0x00, 0x61, 0x08, 0xa4, 0x94,
+    0x1e, 0x62, 0x08, 0x21, 0x08, 0x45, 0x29, 0x85, 0x31, 0x23, 0x32, 0x45, 0x53, 0xa1, 0x10, 0x42,
+    0x21, 0x26, 0x5b, 0xe7, 0x6b, 0x26, 0x5b, 0x01, 0x19, 0xa3, 0x29, 0x47, 0x7c, 0xc6, 0x6b, 0x68,
+    0x84, 0xe4, 0x52, 0x86, 0x63, 0xc9, 0x8c, 0xe9, 0x94, 0x27, 0x7c, 0x45, 0x5b, 0xc4, 0x4a, 0xa4,
+    0x4a, 0x01, 0x19, 0x00, 0x00, 0x61, 0x08, 0x63, 0x29, 0xc4, 0x31, 0xa4, 0x29, 0x85, 0x31, 0x41,
+    0xc7, 0x39, 0x03, 0xe3, 0x20, 0x20, 0x08, 0xe1, 0x18, 0x24, 0x3a, 0x80, 0x05, 0x84, 0x42, 0x24,
+    0x3a, 0x61, 0x10, 0x62, 0x21, 0x02, 0x19, 0x87, 0x31, 0x41, 0x61, 0x08, 0xa4, 0x94, 0x1e, 0x62,
+    0x08, 0x21, 0x08, 0x45, 0x29, 0xc6, 0x39, 0x03, 0x32, 0x25, 0x53, 0xc1, 0x18, 0xa4, 0x4a, 0xc5,
+    0x4a, 0x05, 0x53, 0x03, 0x32, 0x80, 0x08, 0xa3, 0x31, 0xa9, 0x8c, 0x47, 0x7c, 0x06, 0x74, 0xa4,
+    0x4a, 0x23, 0x3a, 0xc5, 0x52, 0x89, 0x84, 0x4a, 0x9d, 0x07, 0x74, 0x43, 0x42, 0xa3, 0x29, 0x00,
+    0x00, 0x20, 0x00, 0xe2, 0x18, 0xa3, 0x29, 0x83, 0x29, 0x64, 0x29, 0x65, 0x31, 0x00, 0x86, 0x31,
+    0x80, 0x04, 0x65, 0x29, 0xe3, 0x20, 0x61, 0x08, 0xa1, 0x10, 0xe2, 0x18, 0x41, 0xc2, 0x18, 0x03,
+    0x61, 0x10, 0x01, 0x19, 0x84, 0x29, 0xe4, 0x20, 0x41, 0x61, 0x08, 0xa4, 0x94, 0x19, 0x62, 0x08,
+    0x41, 0x08, 0x25, 0x29, 0x85, 0x29, 0x03, 0x32, 0x84, 0x42, 0xa1, 0x10, 0x44, 0x42, 0x03, 0x32,
+    0xc3, 0x29, 0x42, 0x21, 0x20, 0x00, 0x24, 0x42, 0xcc, 0xad, 0x88, 0x84, 0x47, 0x7c, 0x07, 0x74,
+    0x83, 0x42, 0x84, 0x42, 0x23, 0x3a, 0xe5, 0x4a, 0x65, 0x63, 0x82, 0x29, 0x40, 0x08, 0x00, 0x00,
+    0xa1, 0x10, 0x41, 0x63, 0x29, 0x00, 0x43, 0x21, 0x41, 0xc3, 0x18, 0x80, 0x00, 0xe3, 0x18, 0x41,
+    0xe3, 0x20, 0x03, 0xa2, 0x10, 0x81, 0x10, 0x40, 0x08, 0x81, 0x10, 0x41, 0x20, 0x00, 0x03, 0x80,
+    0x08, 0x64, 0x29, 0xa3, 0x18, 0x41, 0x08, 0x41, 0x61, 0x08, 0xa3, 0x95, 0x2c, 0x82, 0x10, 0xe3,
+    0x18, 0xe1, 0x18, 0x24, 0x32, 0x23, 0x3a, 0x81, 0x10, 0xa3, 0x29, 0x62, 0x21, 0x42, 0x21, 0x62,
+    0x21, 0x40, 0x08, 0x22, 0x21, 0xc6, 0x6b, 0xa9, 0x8c, 0xea, 0x94, 0xe9, 0x8c, 0xc6, 0x6b, 0x04,
+    0x53, 0xe6, 0x73, 0x25, 0x5b, 0x21, 0x21, 0x40, 0x08, 0x00, 0x00, 0x41, 0x08, 0x43, 0x21, 0xe4,
+    0x31, 0x63, 0x29, 0xc2, 0x10, 0xe4, 0x39, 0x24, 0x3a, 0x45, 0x42, 0xe4, 0x39, 0x63, 0x29, 0xa4,
+    0x31, 0xc7, 0x52, 0x07, 0x5b, 0x66, 0x4a, 0x02, 0x19, 0xa6, 0x52, 0xa7, 0x52, 0xe3, 0x31, 0x64,
+    0x4a, 0x89, 0x52, 0x45, 0x29, 0x41, 0x08, 0x41, 0x61, 0x08, 0xa2, 0x95, 0x0d, 0x82, 0x10, 0xc3,
+    0x18, 0x01, 0x19, 0x03, 0x32, 0x23, 0x3a, 0x61, 0x08, 0x62, 0x29, 0x24, 0x3a, 0x03, 0x32, 0xa3,
+    0x29, 0x40, 0x08, 0x22, 0x21, 0x45, 0x5b, 0x48, 0x7c, 0x41, 0x68, 0x7c, 0x12, 0x27, 0x74, 0xe3,
+    0x4a, 0x24, 0x53, 0xa8, 0x84, 0x05, 0x53, 0x00, 0x00, 0x20, 0x00, 0xe2, 0x18, 0x43, 0x21, 0x63,
+    0x29, 0xa1, 0x10, 0xc4, 0x31, 0xe8, 0x7b, 0xc8, 0x73, 0x29, 0x84, 0x67, 0x63, 0x63, 0x29, 0xe6,
+    0x52, 0xab, 0x8c, 0x41, 0x6a, 0x8c, 0x09, 0x42, 0x21, 0x6b, 0x8c, 0xae, 0xad, 0xa6, 0x52, 0x29,
+    0x84, 0x49, 0x84, 0x69, 0x4a, 0xc3, 0x18, 0x41, 0x08, 0x62, 0x08, 0xa2, 0x96, 0x01, 0xc3, 0x18,
+    0x01, 0x19, 0x41, 0xe3, 0x31, 0x27, 0x61, 0x08, 0xc3, 0x29, 0x44, 0x3a, 0x43, 0x3a, 0xe3, 0x31,
+    0x41, 0x08, 0x22, 0x21, 0x45, 0x5b, 0x66, 0x63, 0x05, 0x53, 0x65, 0x63, 0x85, 0x63, 0x65, 0x5b,
+    0x42, 0x3a, 0xe3, 0x4a, 0xe4, 0x4a, 0x00, 0x00, 0x61, 0x08, 0x81, 0x10, 0xc2, 0x18, 0xa1, 0x10,
+    0x61, 0x08, 0xe4, 0x39, 0xa5, 0x52, 0x65, 0x4a, 0xa5, 0x52, 0x04, 0x3a, 0xa1, 0x10, 0xe3, 0x39,
+    0xc5, 0x52, 0x85, 0x4a, 0xa5, 0x4a, 0x81, 0x10, 0xa6, 0x52, 0xa7, 0x6b, 0xe4, 0x39, 0x85, 0x4a,
+    0x69, 0x84, 0x63, 0x29, 0x82, 0x10, 0x00, 0x61, 0x08, 0x80, 0x00, 0x61, 0x08, 0xa1, 0x95, 0x07,
+    0x82, 0x10, 0xc3, 0x18, 0x01, 0x19, 0xa3, 0x29, 0x62, 0x21, 0xc1, 0x10, 0x82, 0x29, 0xc3, 0x29,
+    0x41, 0x03, 0x3a, 0x0f, 0x40, 0x08, 0xc1, 0x18, 0xe4, 0x52, 0xa4, 0x4a, 0x84, 0x42, 0xc4, 0x4a,
+    0xa6, 0x63, 0x2a, 0x9d, 0x47, 0x7c, 0x24, 0x53, 0xe4, 0x52, 0xc1, 0x18, 0x61, 0x08, 0xc2, 0x18,
+    0x02, 0x19, 0xc2, 0x18, 0x41, 0x04, 0x3a, 0x41, 0xe4, 0x39, 0x03, 0x44, 0x42, 0x43, 0x29, 0x61,
+    0x08, 0x45, 0x42, 0x41, 0x65, 0x4a, 0x09, 0x45, 0x42, 0x20, 0x00, 0x65, 0x4a, 0x88, 0x6b, 0xc4,
+    0x31, 0x04, 0x3a, 0x46, 0x63, 0x23, 0x21, 0x62, 0x10, 0x41, 0x08, 0x42, 0x61, 0x08, 0xa0, 0x95,
+    0x2d, 0x82, 0x10, 0x45, 0x29, 0xe1, 0x18, 0x82, 0x21, 0xe1, 0x18, 0x02, 0x19, 0x22, 0x21, 0x42,
+    0x21, 0x62, 0x21, 0x63, 0x29, 0x61, 0x08, 0x20, 0x00, 0xe3, 0x39, 0x63, 0x42, 0x43, 0x3a, 0xc4,
+    0x4a, 0x27, 0x74, 0x2a, 0x9d, 0x4a, 0x9d, 0x06, 0x74, 0x26, 0x74, 0x42, 0x29, 0x00, 0x00, 0x83,
+    0x29, 0x62, 0x21, 0x43, 0x21, 0x07, 0x5b, 0xe6, 0x5a, 0x07, 0x5b, 0xe6, 0x5a, 0x47, 0x63, 0xc4,
+    0x39, 0xc2, 0x18, 0x88, 0x6b, 0x68, 0x63, 0x68, 0x6b, 0x27, 0x63, 0x61, 0x08, 0xa6, 0x52, 0xe9,
+    0x7b, 0x46, 0x42, 0x65, 0x4a, 0xa7, 0x6b, 0x02, 0x21, 0xc3, 0x18, 0x82, 0x10, 0x41, 0x61, 0x08,
+    0xa1, 0x95, 0x20, 0x41, 0x08, 0x86, 0x31, 0x03, 0x21, 0xe1, 0x10, 0xc1, 0x10, 0x42, 0x21, 0x82,
+    0x29, 0xe3, 0x31, 0xc3, 0x31, 0x44, 0x3a, 0x42, 0x21, 0x00, 0x00, 0x42, 0x21, 0xa3, 0x4a, 0x83,
+    0x42, 0xe5, 0x52, 0x27, 0x74, 0x45, 0x5b, 0xe6, 0x73, 0x85, 0x63, 0xa5, 0x63, 0xa4, 0x4a, 0x81,
+    0x10, 0xe2, 0x18, 0xc2, 0x18, 0x02, 0x19, 0x27, 0x5b, 0x07, 0x5b, 0x27, 0x63, 0x27, 0x5b, 0x88,
+    0x6b, 0xe5, 0x39, 0xc2, 0x18, 0x42, 0x68, 0x6b, 0x0b, 0x07, 0x5b, 0x61, 0x08, 0xa6, 0x52, 0xe9,
+    0x7b, 0x46, 0x4a, 0x65, 0x4a, 0xa8, 0x6b, 0x21, 0x19, 0x03, 0x21, 0x45, 0x29, 0x41, 0x08, 0x62,
+    0x08, 0x41, 0x61, 0x08, 0x9f, 0x96, 0x20, 0x41, 0x08, 0xa7, 0x39, 0x82, 0x10, 0x60, 0x08, 0x82,
+    0x29, 0x03, 0x3a, 0x64, 0x42, 0x43, 0x3a, 0x84, 0x42, 0x64, 0x42, 0x40, 0x08, 0x01, 0x19, 0x24,
+    0x5b, 0x06, 0x74, 0xc6, 0x6b, 0x07, 0x74, 0x25, 0x5b, 0x04, 0x53, 0xe4, 0x52, 0xc4, 0x4a, 0x07,
+    0x74, 0xe3, 0x39, 0x20, 0x08, 0x81, 0x10, 0x02, 0x21, 0x68, 0x6b, 0x27, 0x63, 0x47, 0x63, 0x48,
+    0x63, 0xc9, 0x73, 0x05, 0x42, 0xc2, 0x18, 0x88, 0x6b, 0x41, 0x68, 0x6b, 0x0b, 0x07, 0x5b, 0x41,
+    0x08, 0xc7, 0x52, 0x0a, 0x7c, 0x66, 0x4a, 0x86, 0x4a, 0xa9, 0x73, 0x62, 0x21, 0x03, 0x3a, 0x86,
+    0x31, 0x41, 0x08, 0x62, 0x08, 0x42, 0x61, 0x08, 0x9e, 0x95, 0x03, 0x62, 0x08, 0x41, 0x08, 0xc3,
+    0x18, 0xe8, 0x41, 0x80, 0x01, 0x01, 0x19, 0xa2, 0x29, 0x41, 0x23, 0x3a, 0x04, 0x44, 0x3a, 0xa4,
+    0x42, 0x42, 0x21, 0x81, 0x10, 0x83, 0x42, 0x80, 0x0d, 0xe4, 0x52, 0x25, 0x5b, 0x45, 0x5b, 0x65,
+    0x63, 0x04, 0x53, 0x83, 0x42, 0x05, 0x53, 0xe3, 0x39, 0x00, 0x00, 0x61, 0x08, 0x02, 0x21, 0x88,
+    0x6b, 0x47, 0x63, 0x68, 0x6b, 0x80, 0x03, 0xa8, 0x73, 0x05, 0x42, 0xe2, 0x18, 0x88, 0x6b, 0x41,
+    0x68, 0x6b, 0x0c, 0xe7, 0x5a, 0x41, 0x08, 0xc6, 0x52, 0xe9, 0x7b, 0x66, 0x4a, 0x86, 0x4a, 0xa9,
+    0x73, 0x82, 0x29, 0x22, 0x3a, 0x64, 0x29, 0x66, 0x29, 0x21, 0x08, 0x62, 0x10, 0x41, 0x61, 0x08,
+    0x9e, 0x96, 0x0d, 0x62, 0x08, 0x41, 0x08, 0xc3, 0x18, 0x66, 0x31, 0x40, 0x08, 0x42, 0x21, 0xa2,
+    0x29, 0xa3, 0x29, 0x82, 0x29, 0xe3, 0x31, 0x82, 0x29, 0x81, 0x08, 0x02, 0x19, 0xe4, 0x4a, 0x80,
+    0x04, 0x63, 0x42, 0x83, 0x42, 0xc4, 0x4a, 0x27, 0x7c, 0x28, 0x7c, 0x41, 0xe4, 0x52, 0x05, 0x05,
+    0x53, 0x61, 0x08, 0xc2, 0x18, 0x68, 0x6b, 0x47, 0x63, 0x48, 0x6b, 0x80, 0x03, 0x88, 0x6b, 0x05,
+    0x42, 0xe2, 0x18, 0x67, 0x6b, 0x41, 0x48, 0x63, 0x03, 0x07, 0x5b, 0x41, 0x08, 0xc7, 0x52, 0xe9,
+    0x7b, 0x41, 0x86, 0x4a, 0x05, 0x88, 0x6b, 0xa3, 0x29, 0xc4, 0x4a, 0xa3, 0x31, 0x45, 0x29, 0x41,
+    0x08, 0x43, 0x61, 0x08, 0x9d, 0x97, 0x0b, 0x62, 0x08, 0x41, 0x08, 0x62, 0x10, 0x04, 0x21, 0x81,
+    0x10, 0xa0, 0x10, 0xe0, 0x18, 0xe1, 0x18, 0x42, 0x21, 0x62, 0x21, 0x01, 0x19, 0xa1, 0x10, 0x80,
+    0x41, 0x83, 0x42, 0x0a, 0x25, 0x5b, 0x45, 0x5b, 0xa9, 0x8c, 0x07, 0x74, 0x45, 0x5b, 0xa6, 0x63,
+    0xa7, 0x84, 0x86, 0x63, 0xe2, 0x18, 0x68, 0x6b, 0x47, 0x63, 0x41, 0x27, 0x63, 0x12, 0x88, 0x73,
+    0x05, 0x42, 0xe2, 0x18, 0x68, 0x6b, 0x27, 0x63, 0x48, 0x63, 0xe7, 0x5a, 0x40, 0x08, 0xe7, 0x5a,
+    0x0a, 0x84, 0x86, 0x4a, 0x85, 0x4a, 0x68, 0x6b, 0x22, 0x19, 0x43, 0x3a, 0x04, 0x53, 0x43, 0x29,
+    0x24, 0x21, 0x82, 0x10, 0x43, 0x61, 0x08, 0x9c, 0x98, 0x00, 0x62, 0x08, 0x80, 0x0c, 0xc3, 0x18,
+    0x25, 0x29, 0xc7, 0x39, 0x24, 0x21, 0x40, 0x08, 0x60, 0x08, 0x40, 0x08, 0xc2, 0x18, 0x20, 0x00,
+    0x42, 0x21, 0xe4, 0x4a, 0xe4, 0x52, 0x45, 0x5b, 0x41, 0x25, 0x5b, 0x41, 0x45, 0x5b, 0x0a, 0x27,
+    0x7c, 0xa8, 0x84, 0x27, 0x74, 0xc2, 0x18, 0x81, 0x10, 0xa1, 0x10, 0xa2, 0x18, 0xa1, 0x18, 0xe2,
+    0x18, 0x61, 0x08, 0x41, 0x08, 0x41, 0xe2, 0x18, 0x0e, 0x02, 0x19, 0xa1, 0x10, 0x20, 0x00, 0xc2,
+    0x18, 0x23, 0x21, 0xe2, 0x18, 0x42, 0x21, 0x62, 0x29, 0x42, 0x21, 0xa2, 0x29, 0x25, 0x5b, 0x63,
+    0x42, 0x24, 0x21, 0xe3, 0x18, 0x41, 0x08, 0x44, 0x61, 0x08, 0x9a, 0x99, 0x04, 0x62, 0x08, 0x41,
+    0x08, 0x82, 0x10, 0xa3, 0x18, 0x45, 0x29, 0x41, 0xc7, 0x39, 0x0e, 0x45, 0x29, 0x86, 0x31, 0xa3,
+    0x18, 0x01, 0x19, 0x83, 0x42, 0xc4, 0x4a, 0x65, 0x5b, 0x26, 0x74, 0x85, 0x63, 0x25, 0x5b, 0xc6,
+    0x6b, 0x09, 0x95, 0x68, 0x84, 0xe3, 0x31, 0x81, 0x08, 0x80, 0x01, 0x60, 0x08, 0x81, 0x10, 0x41,
+    0xa1, 0x10, 0x03, 0xc1, 0x10, 0xe1, 0x18, 0xa1, 0x10, 0x61, 0x08, 0x80, 0x00, 0x61, 0x08, 0x41,
+    0xa1, 0x10, 0x0b, 0x40, 0x08, 0x80, 0x10, 0xe1, 0x18, 0xa2, 0x29, 0xc2, 0x31, 0xa2, 0x29, 0x62,
+    0x29, 0x81, 0x10, 0xc3, 0x18, 0x25, 0x21, 0x41, 0x08, 0x62, 0x08, 0x80, 0x41, 0x61, 0x08, 0x9b,
+    0x9a, 0x00, 0x62, 0x08, 0x81, 0x00, 0x62, 0x10, 0x41, 0xa2, 0x10, 0x41, 0x82, 0x10, 0x12, 0x25,
+    0x21, 0x40, 0x08, 0xe1, 0x18, 0x62, 0x29, 0x63, 0x42, 0x64, 0x5b, 0x08, 0x95, 0x27, 0x7c, 0xc6,
+    0x6b, 0xe7, 0x73, 0x42, 0x29, 0x41, 0x08, 0xe3, 0x18, 0x81, 0x10, 0xa1, 0x10, 0x22, 0x21, 0x42,
+    0x21, 0x62, 0x29, 0xa3, 0x31, 0x80, 0x00, 0xa3, 0x31, 0x41, 0xa3, 0x29, 0x0e, 0xe3, 0x31, 0xc3,
+    0x31, 0xa3, 0x31, 0xa1, 0x10, 0x81, 0x10, 0xe1, 0x18, 0x82, 0x29, 0x21, 0x21, 0x61, 0x08, 0x41,
+    0x08, 0xc3, 0x18, 0x45, 0x29, 0xe8, 0x39, 0x82, 0x10, 0x41, 0x08, 0x44, 0x61, 0x08, 0x99, 0x9b,
+    0x42, 0x61, 0x08, 0x42, 0x41, 0x08, 0x10, 0x62, 0x08, 0x82, 0x10, 0x87, 0x31, 0x61, 0x08, 0x00,
+    0x00, 0x40, 0x08, 0x43, 0x3a, 0x47, 0x7c, 0xc4, 0x52, 0x42, 0x21, 0x41, 0x08, 0xa3, 0x18, 0x45,
+    0x29, 0xc7, 0x39, 0x66, 0x31, 0x41, 0x08, 0x40, 0x08, 0x41, 0x60, 0x08, 0x03, 0x61, 0x08, 0x60,
+    0x08, 0x40, 0x08, 0x61, 0x08, 0x41, 0x81, 0x10, 0x04, 0xa1, 0x10, 0x81, 0x10, 0xa3, 0x18, 0xa7,
+    0x31, 0x61, 0x08, 0x41, 0x41, 0x08, 0x06, 0x82, 0x10, 0xe4, 0x20, 0x45, 0x29, 0x86, 0x31, 0x04,
+    0x21, 0x86, 0x31, 0x62, 0x08, 0x45, 0x61, 0x08, 0x98, 0x9b, 0x45, 0x61, 0x08, 0x0c, 0x62, 0x08,
+    0x21, 0x08, 0xa7, 0x31, 0x24, 0x21, 0x80, 0x08, 0x61, 0x10, 0x61, 0x08, 0x40, 0x08, 0x00, 0x00,
+    0x62, 0x10, 0x45, 0x29, 0x66, 0x31, 0xa7, 0x31, 0x41, 0x08, 0x42, 0x0b, 0x04, 0x19, 0xa3, 0x31,
+    0xe2, 0x31, 0x81, 0x29, 0x82, 0x29, 0xa2, 0x29, 0x82, 0x29, 0x42, 0x21, 0x21, 0x21, 0xe1, 0x18,
+    0x00, 0x00, 0x61, 0x08, 0x00, 0x04, 0x21, 0x80, 0x00, 0xc3, 0x18, 0x80, 0x41, 0xc3, 0x18, 0x06,
+    0x04, 0x21, 0xe3, 0x20, 0x45, 0x29, 0xc3, 0x18, 0x24, 0x21, 0xa3, 0x18, 0x41, 0x08, 0x43, 0x61,
+    0x08, 0x99, 0x99, 0x4a, 0x61, 0x08, 0x0f, 0xe3, 0x18, 0xa0, 0x10, 0xc1, 0x18, 0x41, 0x08, 0x61,
+    0x08, 0x81, 0x10, 0x65, 0x29, 0xa7, 0x39, 0x86, 0x31, 0xa6, 0x31, 0xe7, 0x41, 0x25, 0x21, 0xe3,
+    0x30, 0xa4, 0x39, 0xa4, 0x4a, 0xc2, 0x29, 0x42, 0xa4, 0x4a, 0x08, 0xe4, 0x4a, 0x63, 0x42, 0x62,
+    0x21, 0xe1, 0x18, 0xa1, 0x10, 0xc3, 0x18, 0x82, 0x10, 0xa6, 0x31, 0x82, 0x10, 0x41, 0xc3, 0x18,
+    0x80, 0x05, 0xa3, 0x18, 0x07, 0x5a, 0x26, 0x62, 0xe4, 0x20, 0xc3, 0x18, 0x41, 0x08, 0x43, 0x61,
+    0x08, 0x99, 0x9a, 0x48, 0x61, 0x08, 0x00, 0xa2, 0x10, 0x80, 0x1a, 0xe1, 0x10, 0x02, 0x19, 0x81,
+    0x10, 0xa1, 0x10, 0xe3, 0x20, 0xa7, 0x39, 0x29, 0x4a, 0x49, 0x4a, 0x86, 0x31, 0x45, 0x29, 0x64,
+    0x39, 0xc8, 0x92, 0xa8, 0x82, 0xc3, 0x39, 0xa2, 0x29, 0x43, 0x3a, 0xe4, 0x4a, 0xc4, 0x4a, 0x44,
+    0x3a, 0xa2, 0x29, 0x62, 0x21, 0x03, 0x3a, 0xe2, 0x31, 0xa6, 0x39, 0x45, 0x29, 0x04, 0x21, 0x24,
+    0x21, 0x80, 0x07, 0xa2, 0x10, 0x82, 0x10, 0xc3, 0x20, 0x6c, 0xd4, 0x2b, 0xc4, 0xa6, 0x39, 0xa3,
+    0x10, 0x41, 0x08, 0x43, 0x61, 0x08, 0x99, 0x9a, 0x48, 0x61, 0x08, 0x03, 0x82, 0x10, 0x24, 0x21,
+    0xe1, 0x18, 0x22, 0x21, 0x41, 0xc2, 0x18, 0x13, 0x04, 0x21, 0x66, 0x31, 0xe7, 0x39, 0xa7, 0x39,
+    0x05, 0x19, 0xe6, 0x59, 0xad, 0xdc, 0x90, 0xe5, 0xae, 0xd4, 0xe6, 0x62, 0x61, 0x21, 0x01, 0x19,
+    0xc2, 0x31, 0xe2, 0x31, 0xe3, 0x31, 0xc3, 0x31, 0xa2, 0x31, 0x42, 0x21, 0x43, 0x42, 0x02, 0x32,
+    0x41, 0x45, 0x29, 0x09, 0x24, 0x21, 0xe3, 0x18, 0x61, 0x18, 0x83, 0x61, 0x25, 0x7a, 0x07, 0x9b,
+    0xc8, 0x82, 0x45, 0x29, 0x41, 0x08, 0x62, 0x08, 0x42, 0x61, 0x08, 0x9a, 0x9a, 0x41, 0x61, 0x08,
+    0x80, 0x44, 0x61, 0x08, 0x24, 0x41, 0x08, 0xa2, 0x10, 0x44, 0x29, 0xe1, 0x18, 0x62, 0x29, 0xe1,
+    0x18, 0xc1, 0x10, 0xc2, 0x18, 0x45, 0x29, 0x86, 0x31, 0x24, 0x21, 0xe3, 0x18, 0x64, 0x49, 0x2e,
+    0xed, 0xf1, 0xfd, 0x0a, 0xa4, 0x23, 0x3a, 0x61, 0x21, 0xc1, 0x10, 0x21, 0x19, 0x23, 0x3a, 0x84,
+    0x4a, 0xc2, 0x31, 0x62, 0x29, 0x62, 0x21, 0x43, 0x42, 0x04, 0x53, 0x62, 0x21, 0xe8, 0x39, 0x82,
+    0x10, 0xe4, 0x18, 0x86, 0x31, 0xc5, 0x69, 0x86, 0x92, 0xe6, 0x51, 0x65, 0x31, 0x41, 0x08, 0x45,
+    0x61, 0x08, 0x99, 0x9b, 0x46, 0x61, 0x08, 0x1d, 0x41, 0x08, 0xa2, 0x10, 0x45, 0x29, 0xe1, 0x18,
+    0x62, 0x29, 0x02, 0x19, 0x42, 0x21, 0xe2, 0x18, 0xa2, 0x18, 0x04, 0x21, 0xa6, 0x41, 0x64, 0x49,
+    0x44, 0x51, 0xeb, 0xbb, 0x0d, 0xd5, 0x65, 0x6b, 0x66, 0x63, 0x84, 0x42, 0x61, 0x08, 0xe1, 0x18,
+    0x82, 0x29, 0x42, 0x21, 0xc2, 0x31, 0xe3, 0x31, 0x23, 0x3a, 0x63, 0x42, 0x05, 0x53, 0x45, 0x5b,
+    0x24, 0x3a, 0xa7, 0x39, 0x80, 0x04, 0xc3, 0x18, 0x65, 0x31, 0x24, 0x31, 0xa3, 0x10, 0x41, 0x08,
+    0x45, 0x61, 0x08, 0x9a, 0x9b, 0x46, 0x61, 0x08, 0x1e, 0x41, 0x08, 0xa2, 0x10, 0x44, 0x21, 0xe1,
+    0x18, 0xa3, 0x29, 0x22, 0x19, 0xa2, 0x29, 0xe3, 0x31, 0xc1, 0x18, 0xc2, 0x18, 0xe2, 0x20, 0xe2,
+    0x18, 0x43, 0x39, 0x25, 0x5a, 0x46, 0x63, 0xa6, 0x63, 0x89, 0x84, 0xe7, 0x73, 0x81, 0x10, 0xa1,
+    0x10, 0xc1, 0x18, 0x82, 0x29, 0x64, 0x42, 0x84, 0x42, 0xc5, 0x4a, 0xc4, 0x4a, 0x05, 0x53, 0x66,
+    0x63, 0x65, 0x5b, 0xa4, 0x31, 0xa7, 0x31, 0x80, 0x00, 0x21, 0x00, 0x41, 0x41, 0x08, 0x00, 0x62,
+    0x08, 0x42, 0x61, 0x08, 0x9d, 0x9b, 0x47, 0x61, 0x08, 0x16, 0x82, 0x10, 0x65, 0x29, 0xc1, 0x10,
+    0xc3, 0x31, 0x03, 0x3a, 0xe3, 0x31, 0x23, 0x3a, 0xc3, 0x31, 0xe3, 0x39, 0x82, 0x29, 0x62, 0x29,
+    0x42, 0x21, 0x23, 0x3a, 0x25, 0x5b, 0x48, 0x7c, 0xe7, 0x73, 0x45, 0x5b, 0x42, 0x21, 0x60, 0x08,
+    0x82, 0x29, 0x23, 0x3a, 0x84, 0x42, 0xa4, 0x4a, 0x41, 0xc5, 0x4a, 0x07, 0x05, 0x53, 0xc4, 0x4a,
+    0x25, 0x53, 0xa4, 0x42, 0x86, 0x31, 0xe4, 0x20, 0x41, 0x08, 0x62, 0x10, 0x81, 0x42, 0x61, 0x08,
+    0x9d, 0x9c, 0x45, 0x61, 0x08, 0x16, 0x62, 0x08, 0x41, 0x08, 0x25, 0x29, 0x24, 0x21, 0x41, 0x21,
+    0xc4, 0x4a, 0x23, 0x3a, 0xe3, 0x31, 0x64, 0x42, 0xa2, 0x31, 0x03, 0x3a, 0x83, 0x42, 0x23, 0x3a,
+    0x05, 0x53, 0x07, 0x74, 0x48, 0x7c, 0xc6, 0x6b, 0x24, 0x53, 0xa1, 0x10, 0x20, 0x08, 0x42, 0x21,
+    0x23, 0x3a, 0x84, 0x42, 0x41, 0x44, 0x3a, 0x01, 0x03, 0x32, 0x44, 0x3a, 0x41, 0x03, 0x32, 0x04,
+    0x43, 0x3a, 0xa6, 0x31, 0x04, 0x21, 0x41, 0x08, 0x62, 0x08, 0xa2, 0x9d, 0x00, 0x61, 0x08, 0x80,
+    0x43, 0x61, 0x08, 0x0a, 0x41, 0x08, 0xc3, 0x18, 0xa7, 0x39, 0x00, 0x19, 0x64, 0x42, 0x23, 0x3a,
+    0x84, 0x42, 0x05, 0x5b, 0xa4, 0x4a, 0x84, 0x42, 0x05, 0x53, 0x81, 0x0c, 0xe7, 0x6b, 0xa6, 0x6b,
+    0x24, 0x53, 0xe4, 0x4a, 0x81, 0x08, 0x60, 0x08, 0xe1, 0x18, 0x62, 0x21, 0x23, 0x3a, 0x63, 0x42,
+    0x03, 0x32, 0xc3, 0x31, 0xc2, 0x29, 0x41, 0xa2, 0x29, 0x02, 0x63, 0x3a, 0xc4, 0x31, 0x87, 0x31,
+    0xa4, 0xa1, 0x41, 0x61, 0x08, 0x08, 0x41, 0x08, 0xe4, 0x20, 0xa7, 0x39, 0x21, 0x21, 0xc4, 0x4a,
+    0x64, 0x42, 0xe5, 0x52, 0x05, 0x53, 0x86, 0x63, 0x41, 0xe7, 0x73, 0x02, 0xc6, 0x6b, 0x83, 0x42,
+    0xe4, 0x52, 0x41, 0xa3, 0x4a, 0x0f, 0x65, 0x5b, 0xe1, 0x18, 0x81, 0x10, 0x22, 0x21, 0x82, 0x29,
+    0xe3, 0x31, 0x63, 0x42, 0x64, 0x42, 0x43, 0x3a, 0x23, 0x3a, 0x03, 0x32, 0x43, 0x3a, 0x63, 0x42,
+    0xe4, 0x4a, 0x63, 0x29, 0x45, 0x29, 0xa3, 0xa3, 0x16, 0x41, 0x08, 0xa2, 0x10, 0x04, 0x21, 0x01,
+    0x19, 0xa4, 0x4a, 0x23, 0x3a, 0xa2, 0x29, 0x25, 0x5b, 0x65, 0x63, 0x25, 0x5b, 0x04, 0x53, 0x86,
+    0x63, 0xa6, 0x6b, 0x25, 0x5b, 0xc4, 0x4a, 0x45, 0x5b, 0x65, 0x5b, 0x02, 0x21, 0x81, 0x10, 0x01,
+    0x19, 0x82, 0x29, 0x03, 0x3a, 0x84, 0x4a, 0x80, 0x0a, 0x84, 0x42, 0x64, 0x42, 0x44, 0x42, 0xc4,
+    0x4a, 0x03, 0x32, 0xe5, 0x52, 0x05, 0x53, 0x65, 0x29, 0x45, 0x29, 0x41, 0x08, 0x62, 0x08, 0xa0,
+    0xa4, 0x16, 0x41, 0x08, 0x62, 0x08, 0xc1, 0x18, 0xa3, 0x4a, 0x03, 0x32, 0xa4, 0x4a, 0x27, 0x7c,
+    0xc6, 0x6b, 0x45, 0x5b, 0x04, 0x53, 0x28, 0x7c, 0x6c, 0xa5, 0xa9, 0x8c, 0x68, 0x84, 0x09, 0x95,
+    0x46, 0x7c, 0x62, 0x29, 0x40, 0x08, 0x42, 0x21, 0x62, 0x21, 0x82, 0x29, 0xe3, 0x31, 0x64, 0x42,
+    0x41, 0x84, 0x42, 0x08, 0xe5, 0x52, 0xa4, 0x4a, 0x03, 0x32, 0xa4, 0x4a, 0xa6, 0x63, 0x64, 0x29,
+    0x46, 0x29, 0x20, 0x00, 0x62, 0x08, 0xa0, 0xa4, 0x0a, 0x41, 0x08, 0xc3, 0x18, 0x04, 0x21, 0xc2,
+    0x31, 0xc4, 0x4a, 0xe4, 0x52, 0x45, 0x5b, 0xe4, 0x52, 0xe4, 0x4a, 0x48, 0x84, 0x4b, 0x9d, 0x41,
+    0x2b, 0x9d, 0x05, 0x88, 0x84, 0x84, 0x42, 0x05, 0x53, 0xc4, 0x31, 0x21, 0x08, 0xc1, 0x10, 0x41,
+    0x42, 0x21, 0x0d, 0x22, 0x21, 0xe3, 0x31, 0x23, 0x3a, 0xe3, 0x31, 0x43, 0x42, 0xa4, 0x4a, 0xe5,
+    0x52, 0x66, 0x63, 0xc7, 0x6b, 0xc5, 0x52, 0x85, 0x31, 0x04, 0x21, 0x41, 0x08, 0x62, 0x08, 0x9f,
+    0xa5, 0x07, 0x61, 0x08, 0xe4, 0x20, 0xa2, 0x10, 0x43, 0x42, 0xa4, 0x4a, 0x03, 0x3a, 0xa2, 0x29,
+    0xe7, 0x73, 0x41, 0x48, 0x7c, 0x17, 0x07, 0x74, 0x66, 0x63, 0x05, 0x53, 0x43, 0x3a, 0xa2, 0x29,
+    0xa5, 0x31, 0x66, 0x29, 0xa2, 0x10, 0x80, 0x08, 0xc1, 0x18, 0x81, 0x10, 0xa1, 0x10, 0x81, 0x10,
+    0x82, 0x29, 0xc2, 0x29, 0x84, 0x42, 0xc5, 0x4a, 0xe5, 0x52, 0x25, 0x5b, 0xc6, 0x6b, 0x04, 0x3a,
+    0x66, 0x31, 0x41, 0x08, 0x62, 0x08, 0x9f, 0xa3, 0x04, 0x61, 0x08, 0x62, 0x08, 0x41, 0x08, 0xe4,
+    0x18, 0xa7, 0x31, 0x80, 0x1d, 0xe3, 0x31, 0x21, 0x19, 0x06, 0x5b, 0x88, 0x84, 0x07, 0x74, 0x27,
+    0x74, 0xc6, 0x6b, 0x86, 0x63, 0xa7, 0x6b, 0x04, 0x53, 0x63, 0x42, 0x65, 0x29, 0x62, 0x08, 0xa6,
+    0x31, 0xa3, 0x10, 0x20, 0x00, 0x40, 0x08, 0x20, 0x08, 0xa1, 0x10, 0xe3, 0x31, 0x42, 0x21, 0x23,
+    0x3a, 0xa4, 0x4a, 0x64, 0x42, 0x03, 0x3a, 0xc4, 0x4a, 0xe3, 0x31, 0x46, 0x29, 0x41, 0x08, 0x62,
+    0x08, 0x9f, 0xa2, 0x00, 0x61, 0x08, 0x80, 0x0a, 0x61, 0x08, 0x62, 0x08, 0x41, 0x08, 0x24, 0x21,
+    0x62, 0x29, 0xc2, 0x31, 0x03, 0x32, 0x08, 0x74, 0x86, 0x63, 0xa6, 0x63, 0xe7, 0x73, 0x43, 0x07,
+    0x74, 0x00, 0x46, 0x5b, 0x41, 0x04, 0x21, 0x01, 0x66, 0x29, 0xa1, 0x10, 0x41, 0xe1, 0x18, 0x01,
+    0x61, 0x08, 0x21, 0x21, 0x41, 0xc3, 0x31, 0x08, 0x84, 0x42, 0x05, 0x53, 0xe5, 0x4a, 0x64, 0x42,
+    0xc4, 0x4a, 0xa3, 0x31, 0x66, 0x29, 0x41, 0x08, 0x62, 0x08, 0x9f, 0xa1, 0x00, 0x61, 0x08, 0x80,
+    0x42, 0x61, 0x08, 0x07, 0x82, 0x10, 0x25, 0x21, 0x61, 0x21, 0xa4, 0x4a, 0x84, 0x4a, 0xe5, 0x52,
+    0x84, 0x42, 0x05, 0x53, 0x41, 0x86, 0x63, 0x0d, 0x46, 0x5b, 0x86, 0x63, 0x07, 0x74, 0x05, 0x53,
+    0x25, 0x29, 0x86, 0x31, 0xa1, 0x10, 0x42, 0x21, 0x22, 0x21, 0x42, 0x21, 0xc1, 0x10, 0xe1, 0x18,
+    0xa2, 0x29, 0x23, 0x3a, 0x41, 0x05, 0x53, 0x06, 0x45, 0x5b, 0x05, 0x53, 0x04, 0x53, 0x03, 0x3a,
+    0x66, 0x31, 0x41, 0x08, 0x62, 0x08, 0x9f, 0xa2, 0x41, 0x61, 0x08, 0x20, 0x62, 0x08, 0x41, 0x08,
+    0xe4, 0x20, 0x63, 0x29, 0xa6, 0x6b, 0xe6, 0x73, 0xa4, 0x4a, 0x64, 0x42, 0x84, 0x42, 0xa4, 0x4a,
+    0x25, 0x5b, 0x66, 0x63, 0x25, 0x5b, 0x05, 0x53, 0xa6, 0x63, 0x08, 0x5b, 0x8a, 0x52, 0xc2, 0x18,
+    0xa2, 0x31, 0x22, 0x21, 0x82, 0x29, 0x23, 0x3a, 0x82, 0x29, 0x42, 0x21, 0xc3, 0x31, 0x43, 0x42,
+    0x25, 0x53, 0xe5, 0x52, 0x25, 0x53, 0x66, 0x5b, 0x63, 0x42, 0xa5, 0x31, 0x82, 0x10, 0xa1, 0xa0,
+    0x43, 0x61, 0x08, 0x02, 0x41, 0x08, 0xc3, 0x18, 0x44, 0x21, 0x41, 0xe6, 0x6b, 0x03, 0x05, 0x53,
+    0x84, 0x42, 0x23, 0x3a, 0xa4, 0x4a, 0x41, 0x05, 0x53, 0x16, 0x25, 0x5b, 0x45, 0x5b, 0x04, 0x53,
+    0x43, 0x3a, 0x85, 0x29, 0x86, 0x31, 0x21, 0x21, 0x62, 0x29, 0x22, 0x21, 0x82, 0x29, 0x03, 0x3a,
+    0x42, 0x21, 0xc1, 0x10, 0x01, 0x19, 0xe1, 0x18, 0x42, 0x21, 0x01, 0x19, 0x22, 0x21, 0x61, 0x21,
+    0x23, 0x21, 0xe4, 0x20, 0x41, 0x08, 0x62, 0x08, 0xa0, 0xa0, 0x42, 0x61, 0x08, 0x06, 0x62, 0x08,
+    0x41, 0x08, 0x46, 0x29, 0x86, 0x4a, 0xc5, 0x6b, 0xa4, 0x4a, 0xe4, 0x4a, 0x80, 0x0d, 0xa4, 0x4a,
+    0x65, 0x5b, 0xa6, 0x6b, 0x86, 0x63, 0x66, 0x63, 0x84, 0x42, 0x63, 0x42, 0x01, 0x19, 0x00, 0x00,
+    0xe1, 0x18, 0x62, 0x29, 0x82, 0x29, 0xc2, 0x31, 0x62, 0x21, 0x80, 0x43, 0x82, 0x29, 0x41, 0xc2,
+    0x31, 0x02, 0x21, 0x21, 0x03, 0x21, 0xe4, 0x18, 0x00, 0x61, 0x08, 0xa2, 0xa0, 0x44, 0x61, 0x08,
+    0x16, 0x86, 0x31, 0x84, 0x4a, 0x67, 0x84, 0x25, 0x5b, 0xa4, 0x4a, 0x67, 0x84, 0xc6, 0x6b, 0x85,
+    0x63, 0xe7, 0x73, 0x88, 0x84, 0x07, 0x74, 0x63, 0x42, 0x07, 0x74, 0x62, 0x29, 0x80, 0x08, 0x01,
+    0x21, 0x62, 0x21, 0xa4, 0x4a, 0x43, 0x3a, 0x22, 0x21, 0x03, 0x32, 0x23, 0x3a, 0xe3, 0x31, 0x41,
+    0xc2, 0x31, 0x05, 0x43, 0x3a, 0xc2, 0x31, 0x65, 0x29, 0x66, 0x31, 0x21, 0x00, 0x62, 0x08, 0xa2,
+    0x9d, 0x44, 0x61, 0x08, 0x1f, 0x62, 0x08, 0x41, 0x08, 0x46, 0x29, 0x06, 0x3a, 0x45, 0x5b, 0x2a,
+    0x95, 0x66, 0x63, 0xe5, 0x52, 0xe7, 0x73, 0x07, 0x74, 0x86, 0x63, 0xe7, 0x6b, 0x07, 0x74, 0xc6,
+    0x6b, 0x04, 0x53, 0x47, 0x7c, 0x42, 0x21, 0x41, 0x21, 0x82, 0x29, 0x62, 0x29, 0xe5, 0x52, 0xa4,
+    0x4a, 0x62, 0x29, 0xa2, 0x31, 0x03, 0x32, 0xa2, 0x29, 0xe3, 0x31, 0x84, 0x42, 0x23, 0x3a, 0xe2,
+    0x18, 0x05, 0x21, 0x41, 0x08, 0x42, 0x61, 0x08, 0xa1, 0x9e, 0x43, 0x61, 0x08, 0x0f, 0x41, 0x08,
+    0xa2, 0x10, 0x25, 0x29, 0x01, 0x19, 0x27, 0x7c, 0x6a, 0x9d, 0x27, 0x7c, 0x05, 0x5b, 0xe5, 0x52,
+    0xc4, 0x4a, 0x45, 0x5b, 0x86, 0x63, 0x25, 0x53, 0x05, 0x53, 0x65, 0x5b, 0xe3, 0x31, 0x80, 0x00,
+    0xe3, 0x31, 0x41, 0x03, 0x3a, 0x05, 0xa4, 0x4a, 0xc4, 0x4a, 0xa2, 0x29, 0x42, 0x21, 0x62, 0x29,
+    0xc2, 0x31, 0x80, 0x03, 0x63, 0x42, 0x43, 0x21, 0x46, 0x29, 0x41, 0x08, 0x44, 0x61, 0x08, 0xa0,
+    0x9d, 0x44, 0x61, 0x08, 0x0a, 0x41, 0x08, 0xa3, 0x18, 0xa6, 0x31, 0x21, 0x21, 0x65, 0x5b, 0xc9,
+    0x8c, 0x45, 0x5b, 0x23, 0x3a, 0x43, 0x42, 0x43, 0x3a, 0x63, 0x42, 0x41, 0x64, 0x42, 0x03, 0xe4,
+    0x52, 0x45, 0x5b, 0x01, 0x19, 0x00, 0x00, 0x80, 0x04, 0x03, 0x3a, 0xa4, 0x4a, 0xc5, 0x52, 0xa4,
+    0x4a, 0x64, 0x42, 0x41, 0xa2, 0x29, 0x04, 0x63, 0x42, 0x02, 0x3a, 0x42, 0x21, 0x04, 0x21, 0x82,
+    0x10, 0x45, 0x61, 0x08, 0xa0, 0x9d, 0x44, 0x61, 0x08, 0x05, 0x41, 0x08, 0x82, 0x10, 0x06, 0x3a,
+    0xa1, 0x29, 0xe2, 0x31, 0x23, 0x3a, 0x41, 0xa4, 0x4a, 0x16, 0x23, 0x3a, 0xa4, 0x4a, 0x84, 0x42,
+    0xe2, 0x31, 0x03, 0x3a, 0xc4, 0x52, 0x45, 0x5b, 0x81, 0x10, 0x20, 0x00, 0x21, 0x00, 0xe1, 0x18,
+    0x44, 0x42, 0xe5, 0x52, 0xc4, 0x4a, 0x64, 0x42, 0x43, 0x3a, 0xe2, 0x31, 0xa2, 0x29, 0x23, 0x21,
+    0x86, 0x31, 0x82, 0x10, 0x41, 0x08, 0x62, 0x08, 0x45, 0x61, 0x08, 0x9f, 0x9c, 0x45, 0x61, 0x08,
+    0x07, 0x41, 0x08, 0x66, 0x31, 0x05, 0x3a, 0xa3, 0x4a, 0xa2, 0x29, 0xc4, 0x52, 0x47, 0x7c, 0x45,
+    0x5b, 0x41, 0x64, 0x42, 0x05, 0x63, 0x42, 0xc6, 0x6b, 0x45, 0x5b, 0x86, 0x63, 0xa2, 0x29, 0x21,
+    0x08, 0x41, 0xc3, 0x18, 0x0b, 0x41, 0x08, 0xc1, 0x18, 0x64, 0x42, 0x05, 0x53, 0x64, 0x42, 0x84,
+    0x42, 0x22, 0x3a, 0xc2, 0x18, 0x66, 0x29, 0xa3, 0x18, 0x41, 0x08, 0x62, 0x08, 0x45, 0x61, 0x08,
+    0xa0, 0x9b, 0x44, 0x61, 0x08, 0x12, 0x62, 0x08, 0x41, 0x08, 0x65, 0x29, 0x85, 0x31, 0xa5, 0x63,
+    0x27, 0x74, 0x64, 0x42, 0xa8, 0x8c, 0x29, 0x95, 0xe6, 0x6b, 0x65, 0x5b, 0x45, 0x5b, 0xa4, 0x4a,
+    0x65, 0x5b, 0x65, 0x63, 0x45, 0x5b, 0xc2, 0x18, 0xa3, 0x18, 0x04, 0x21, 0x41, 0xe3, 0x18, 0x09,
+    0x62, 0x08, 0xa1, 0x10, 0xa2, 0x29, 0x23, 0x3a, 0x03, 0x3a, 0xe2, 0x18, 0x45, 0x29, 0x82, 0x10,
+    0x41, 0x08, 0x62, 0x08, 0x47, 0x61, 0x08, 0x9f, 0x9d, 0x43, 0x61, 0x08, 0x09, 0x62, 0x10, 0x21,
+    0x00, 0x82, 0x29, 0xe7, 0x8c, 0xa8, 0x84, 0x86, 0x63, 0x85, 0x63, 0xc9, 0x8c, 0xe7, 0x73, 0x25,
+    0x5b, 0x41, 0xc4, 0x4a, 0x04, 0xe4, 0x4a, 0xa4, 0x4a, 0xe3, 0x31, 0x61, 0x10, 0xe3, 0x18, 0x41,
+    0x24, 0x21, 0x09, 0x04, 0x21, 0xe3, 0x18, 0x82, 0x10, 0x41, 0x08, 0x65, 0x29, 0x44, 0x29, 0x66,
+    0x29, 0x62, 0x10, 0x61, 0x08, 0x62, 0x08, 0x48, 0x61, 0x08, 0x9f, 0x9b, 0x44, 0x61, 0x08, 0x18,
+    0x62, 0x08, 0x41, 0x08, 0x45, 0x29, 0x43, 0x29, 0xe3, 0x52, 0x26, 0x74, 0x06, 0x74, 0xa5, 0x63,
+    0xc9, 0x8c, 0x45, 0x5b, 0x84, 0x42, 0xa4, 0x4a, 0x04, 0x53, 0xc4, 0x4a, 0x03, 0x3a, 0x41, 0x08,
+    0x82, 0x10, 0xe3, 0x18, 0x25, 0x29, 0x65, 0x29, 0x25, 0x29, 0x04, 0x21, 0x82, 0x10, 0x45, 0x29,
+    0x04, 0x21, 0x41, 0x82, 0x10, 0x01, 0x41, 0x08, 0x62, 0x08, 0x49, 0x61, 0x08, 0x9f, 0x99, 0x48,
+    0x61, 0x08, 0x07, 0xa2, 0x10, 0x04, 0x21, 0x41, 0x08, 0xc1, 0x18, 0xe3, 0x39, 0x86, 0x63, 0x48,
+    0x7c, 0xc7, 0x6b, 0x41, 0xa3, 0x42, 0x0a, 0x83, 0x42, 0xc2, 0x31, 0x81, 0x10, 0x82, 0x10, 0xc3,
+    0x18, 0xe3, 0x18, 0xe4, 0x20, 0x65, 0x29, 0x86, 0x31, 0xe4, 0x20, 0x82, 0x10, 0x80, 0x41, 0x41,
+    0x08, 0x01, 0x61, 0x08, 0x62, 0x08, 0x49, 0x61, 0x08, 0xa0, 0x9a, 0x41, 0x61, 0x08, 0x80, 0x43,
+    0x61, 0x08, 0x09, 0x62, 0x08, 0x41, 0x08, 0x45, 0x29, 0xa2, 0x10, 0x82, 0x10, 0x62, 0x08, 0x41,
+    0x08, 0x21, 0x08, 0xa1, 0x10, 0xe1, 0x18, 0x41, 0xc1, 0x10, 0x03, 0x40, 0x08, 0x41, 0x08, 0xe3,
+    0x18, 0xa2, 0x10, 0x41, 0xe3, 0x18, 0x41, 0x45, 0x29, 0x04, 0xc3, 0x18, 0x24, 0x21, 0xa3, 0x10,
+    0x41, 0x08, 0x62, 0x08, 0x4d, 0x61, 0x08, 0x9e, 0x98, 0x47, 0x61, 0x08, 0x01, 0x62, 0x08, 0x41,
+    0x08, 0x00, 0xe4, 0x20, 0x80, 0x0a, 0xa3, 0x18, 0x04, 0x21, 0x24, 0x21, 0x45, 0x29, 0x24, 0x21,
+    0x45, 0x29, 0x25, 0x21, 0xa3, 0x18, 0x00, 0x00, 0x82, 0x10, 0x00, 0x00, 0x41, 0x82, 0x10, 0x06,
+    0xa3, 0x18, 0xc3, 0x18, 0x25, 0x29, 0x86, 0x31, 0x45, 0x29, 0x04, 0x21, 0x25, 0x29, 0x80, 0x00,
+    0x62, 0x08, 0x4d, 0x61, 0x08, 0x9e, 0x97, 0x4a, 0x61, 0x08, 0x41, 0x82, 0x10, 0x0b, 0x04, 0x21,
+    0x25, 0x29, 0x86, 0x31, 0xa6, 0x31, 0x86, 0x31, 0xe7, 0x39, 0xc7, 0x39, 0xe3, 0x18, 0x04, 0x21,
+    0x45, 0x29, 0x04, 0x21, 0x00, 0x00, 0x80, 0x41, 0xa3, 0x18, 0x00, 0x04, 0x21, 0x41, 0x25, 0x29,
+    0x00, 0xc3, 0x18, 0x41, 0x04, 0x21, 0x80, 0x00, 0x62, 0x08, 0x52, 0x61, 0x08, 0x81, 0x00, 0x61,
+    0x08, 0x95, 0x96, 0x4b, 0x61, 0x08, 0x04, 0x21, 0x08, 0x82, 0x10, 0x04, 0x21, 0x25, 0x29, 0xa6,
+    0x31, 0x41, 0x86, 0x31, 0x08, 0xa7, 0x39, 0x45, 0x29, 0xa3, 0x10, 0x08, 0x42, 0x41, 0x08, 0xa3,
+    0x18, 0x25, 0x21, 0x20, 0x08, 0x62, 0x10, 0x41, 0xc3, 0x18, 0x05, 0x24, 0x21, 0xa6, 0x31, 0x28,
+    0x42, 0x24, 0x21, 0x66, 0x29, 0x82, 0x10, 0x56, 0x61, 0x08, 0x95, 0x96, 0x49, 0x61, 0x08, 0x06,
+    0x41, 0x08, 0xa3, 0x18, 0x45, 0x29, 0x61, 0x08, 0xe4, 0x20, 0x04, 0x21, 0x66, 0x31, 0x41, 0x86,
+    0x31, 0x09, 0xc7, 0x39, 0x66, 0x31, 0xc3, 0x18, 0x86, 0x31, 0x82, 0x10, 0x20, 0x00, 0xe4, 0x20,
+    0xa6, 0x31, 0xc3, 0x18, 0x41, 0x08, 0x41, 0xc3, 0x18, 0x06, 0x24, 0x21, 0xe8, 0x41, 0xc7, 0x39,
+    0xe4, 0x20, 0x25, 0x29, 0x41, 0x08, 0x62, 0x08, 0x54, 0x61, 0x08, 0x95, 0x96, 0x46, 0x61, 0x08,
+    0x03, 0x62, 0x08, 0x62, 0x10, 0x82, 0x10, 0x62, 0x08, 0x80, 0x41, 0x82, 0x10, 0x00, 0x04, 0x21,
+    0x41, 0x25, 0x29, 0x02, 0x65, 0x29, 0x66, 0x31, 0x65, 0x29, 0x41, 0x45, 0x29, 0x02, 0xa3, 0x18,
+    0xa7, 0x39, 0x04, 0x21, 0x41, 0x41, 0x08, 0x00, 0x24, 0x21, 0x81, 0x06, 0x62, 0x10, 0xc3, 0x18,
+    0xe4, 0x20, 0x45, 0x29, 0xc3, 0x18, 0x65, 0x29, 0x62, 0x08, 0x42, 0x82, 0x10, 0x42, 0x62, 0x10,
+    0x4f, 0x61, 0x08, 0x95, 0x97, 0x01, 0x62, 0x08, 0x62, 0x10, 0x41, 0x82, 0x10, 0x07, 0x62, 0x08,
+    0x61, 0x08, 0x41, 0x08, 0x20, 0x00, 0x00, 0x00, 0x82, 0x10, 0x86, 0x31, 0x41, 0x08, 0x41, 0x24,
+    0x21, 0x00, 0x04, 0x21, 0x41, 0x45, 0x29, 0x03, 0x65, 0x29, 0xa7, 0x31, 0x08, 0x42, 0x86, 0x31,
+    0x43, 0x04, 0x21, 0x06, 0xc3, 0x18, 0xa3, 0x18, 0x45, 0x29, 0xc3, 0x18, 0x41, 0x08, 0x00, 0x00,
+    0x20, 0x00, 0x80, 0x01, 0x41, 0x08, 0x04, 0x21, 0x43, 0x00, 0x00, 0x00, 0x20, 0x00, 0x41, 0x21,
+    0x00, 0x01, 0x41, 0x08, 0x61, 0x08, 0x41, 0x82, 0x10, 0x01, 0x62, 0x10, 0x62, 0x08, 0x49, 0x61,
+    0x08, 0x95, 0x95, 0x41, 0x82, 0x10, 0x00, 0x41, 0x08, 0x42, 0x00, 0x00, 0x01, 0x41, 0x08, 0x62,
+    0x10, 0x43, 0x61, 0x08, 0x10, 0xc3, 0x18, 0xa2, 0x10, 0xe4, 0x20, 0x66, 0x31, 0x04, 0x21, 0x24,
+    0x21, 0x25, 0x29, 0x66, 0x31, 0x86, 0x31, 0xe7, 0x39, 0xe8, 0x41, 0x66, 0x31, 0x65, 0x31, 0x86,
+    0x31, 0x08, 0x42, 0x28, 0x42, 0x45, 0x29, 0x84, 0x00, 0x82, 0x10, 0x85, 0x45, 0x61, 0x08, 0x41,
+    0x00, 0x00, 0x03, 0x21, 0x00, 0x61, 0x08, 0x82, 0x10, 0x62, 0x10, 0x46, 0x61, 0x08, 0x95,
+};
+
+static const uint8_t MAIN_anim_soldier_frame2[7003] = {
+    0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7,
+    0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7, 0xbf, 0xa7, 0xac, 0x41, 0x62, 0x10, 0x80, 0x00,
+    0x61, 0x08, 0x88, 0x00, 0x62, 0x08, 0xac, 0xaa, 0x01, 0x62, 0x08, 0x41, 0x08, 0x41, 0x20, 0x00,
+    0x01, 0x41, 0x08, 0x62, 0x10, 0x43, 0x62, 0x08, 0x41, 0x41, 0x08, 0x02, 0x62, 0x08, 0x41, 0x08,
+    0x42, 0x08, 0x44, 0x41, 0x08, 0xa8, 0xa9, 0x08, 0x62, 0x08, 0x41, 0x08, 0xa2, 0x10, 0xa6, 0x31,
+    0x66, 0x31, 0x44, 0x21, 0xe3, 0x31, 0x24, 0x3a, 0x64, 0x42, 0x41, 0x85, 0x42, 0x09, 0x64, 0x42,
+    0x03, 0x3a, 0x62, 0x21, 0xc5, 0x31, 0x87, 0x4a, 0x65, 0x29, 0x82, 0x10, 0xa2, 0x10, 0x82, 0x10,
+    0xc3, 0x18, 0x00, 0x61, 0x08, 0xa7, 0xa8, 0x0d, 0x62, 0x08, 0x41, 0x08, 0x82, 0x10, 0x28, 0x42,
+    0x06, 0x3a, 0x26, 0x3a, 0xc6, 0x4a, 0x66, 0x5b, 0x86, 0x63, 0xc7, 0x6b, 0x07, 0x6c, 0x68, 0x7c,
+    0x88, 0x84, 0xa8, 0x84, 0x41, 0x47, 0x74, 0x07, 0x06, 0x6c, 0x85, 0x42, 0x65, 0x29, 0x44, 0x29,
+    0xe3, 0x18, 0x86, 0x31, 0x25, 0x21, 0x21, 0x08, 0xa6, 0xa7, 0x0a, 0x62, 0x08, 0x41, 0x08, 0xa3,
+    0x18, 0xa6, 0x31, 0x24, 0x3a, 0x84, 0x42, 0xc5, 0x4a, 0x26, 0x53, 0x86, 0x5b, 0xa7, 0x63, 0xc7,
+    0x63, 0x42, 0xe7, 0x6b, 0x00, 0x27, 0x74, 0x80, 0x06, 0xe7, 0x6b, 0x25, 0x42, 0xe6, 0x39, 0x24,
+    0x29, 0x61, 0x10, 0x82, 0x10, 0xc3, 0x18, 0x80, 0x00, 0xe3, 0x18, 0xa6, 0xa6, 0x0a, 0x62, 0x08,
+    0x41, 0x08, 0xc3, 0x18, 0xc7, 0x39, 0x83, 0x29, 0xa5, 0x4a, 0xc5, 0x4a, 0xa5, 0x4a, 0xc5, 0x4a,
+    0xe5, 0x4a, 0x06, 0x53, 0x41, 0x46, 0x53, 0x06, 0x46, 0x5b, 0xa6, 0x63, 0xe7, 0x6b, 0x25, 0x5b,
+    0x23, 0x21, 0xc8, 0x39, 0x86, 0x31, 0x41, 0x44, 0x19, 0x04, 0x64, 0x19, 0x6a, 0x2a, 0xe4, 0x10,
+    0x66, 0x31, 0xa3, 0x10, 0xa5, 0xa8, 0x03, 0xa7, 0x31, 0x43, 0x21, 0x04, 0x3a, 0x65, 0x42, 0x42,
+    0x85, 0x42, 0x80, 0x11, 0x06, 0x53, 0x26, 0x53, 0x06, 0x53, 0x46, 0x53, 0xa6, 0x63, 0xc7, 0x6b,
+    0x84, 0x29, 0xe8, 0x41, 0x8a, 0x52, 0x47, 0x32, 0xc9, 0x3a, 0x68, 0x3a, 0xe6, 0x31, 0x8a, 0x32,
+    0xc8, 0x29, 0x82, 0x10, 0xe4, 0x20, 0x41, 0x08, 0xa4, 0xa6, 0x0a, 0x41, 0x08, 0xc3, 0x18, 0xc7,
+    0x39, 0x21, 0x19, 0xe4, 0x31, 0x25, 0x3a, 0xc5, 0x4a, 0x64, 0x3a, 0x83, 0x29, 0xe4, 0x31, 0xe3,
+    0x31, 0x41, 0xa3, 0x29, 0x03, 0xc3, 0x31, 0x04, 0x3a, 0xc3, 0x31, 0x45, 0x29, 0x41, 0xab, 0x52,
+    0x07, 0xa9, 0x3a, 0xc9, 0x3a, 0x69, 0x42, 0x27, 0x3a, 0x48, 0x32, 0x69, 0x2a, 0x61, 0x10, 0x82,
+    0x10, 0x41, 0x61, 0x08, 0xa3, 0xa6, 0x14, 0x41, 0x08, 0x25, 0x29, 0xa6, 0x31, 0xe1, 0x10, 0x83,
+    0x29, 0xc4, 0x31, 0xe4, 0x31, 0x63, 0x29, 0xe3, 0x18, 0xc2, 0x18, 0x23, 0x21, 0x05, 0x3a, 0x05,
+    0x42, 0x63, 0x29, 0xa1, 0x10, 0x81, 0x08, 0x65, 0x29, 0x49, 0x42, 0x8a, 0x42, 0x69, 0x3a, 0x89,
+    0x3a, 0x80, 0x04, 0x68, 0x42, 0x88, 0x3a, 0xa9, 0x3a, 0xc2, 0x18, 0x82, 0x10, 0x00, 0x61, 0x08,
+    0xa4, 0xa7, 0x00, 0x66, 0x31, 0x41, 0x81, 0x10, 0x00, 0xc2, 0x10, 0x41, 0xe2, 0x18, 0x0b, 0x23,
+    0x21, 0x63, 0x29, 0x02, 0x21, 0x85, 0x4a, 0x2b, 0x9d, 0x4c, 0x9d, 0x29, 0x7c, 0x64, 0x42, 0xa3,
+    0x31, 0x63, 0x21, 0x65, 0x29, 0xc7, 0x39, 0x41, 0xe7, 0x39, 0x05, 0x28, 0x3a, 0xc6, 0x31, 0x44,
+    0x29, 0xa5, 0x31, 0xa2, 0x10, 0x82, 0x10, 0x00, 0x61, 0x08, 0xa4, 0xa5, 0x0c, 0x61, 0x08, 0x62,
+    0x08, 0x61, 0x08, 0x62, 0x29, 0xc3, 0x31, 0x04, 0x32, 0x64, 0x3a, 0x85, 0x42, 0xe5, 0x4a, 0xa5,
+    0x42, 0xc5, 0x4a, 0xe5, 0x4a, 0xe5, 0x52, 0x41, 0x26, 0x53, 0x04, 0x84, 0x42, 0x83, 0x29, 0x22,
+    0x21, 0x81, 0x10, 0xe2, 0x18, 0x41, 0x02, 0x21, 0x06, 0x02, 0x19, 0xc1, 0x18, 0x61, 0x08, 0x00,
+    0x00, 0x82, 0x10, 0xc3, 0x18, 0x41, 0x08, 0xa4, 0xa6, 0x05, 0x62, 0x08, 0xa1, 0x10, 0xa3, 0x29,
+    0xe4, 0x31, 0x44, 0x3a, 0xa5, 0x42, 0x41, 0x84, 0x42, 0x01, 0x44, 0x3a, 0x65, 0x42, 0x41, 0x64,
+    0x42, 0x01, 0x84, 0x42, 0x82, 0x21, 0x41, 0x40, 0x00, 0x42, 0x61, 0x08, 0x41, 0x60, 0x08, 0x05,
+    0xa1, 0x10, 0xe1, 0x18, 0x60, 0x08, 0xe4, 0x18, 0xa7, 0x31, 0x82, 0x10, 0x00, 0x61, 0x08, 0xa4,
+    0xa6, 0x04, 0x62, 0x10, 0x81, 0x10, 0x82, 0x29, 0xe4, 0x31, 0x24, 0x3a, 0x81, 0x0a, 0xa3, 0x29,
+    0xc2, 0x18, 0xe2, 0x18, 0xe2, 0x20, 0x02, 0x21, 0xe2, 0x18, 0x21, 0x00, 0x23, 0x39, 0x25, 0x6a,
+    0xe4, 0x61, 0x05, 0x62, 0x41, 0xe4, 0x61, 0x02, 0x66, 0x72, 0x22, 0x31, 0x41, 0x08, 0x41, 0x25,
+    0x29, 0x41, 0x41, 0x08, 0x00, 0x61, 0x08, 0xa4, 0xa6, 0x0f, 0x62, 0x08, 0xc3, 0x18, 0xa1, 0x10,
+    0x01, 0x19, 0x02, 0x19, 0x42, 0x21, 0x22, 0x21, 0x40, 0x08, 0x81, 0x20, 0x23, 0x39, 0x02, 0x31,
+    0x03, 0x39, 0xc2, 0x18, 0x23, 0x29, 0x0a, 0xbc, 0x8b, 0xcc, 0x41, 0xcc, 0xd4, 0x06, 0x89, 0xa3,
+    0x84, 0x49, 0x4a, 0xc4, 0x6a, 0x8b, 0x66, 0x29, 0xa2, 0x10, 0x41, 0x08, 0x41, 0x61, 0x08, 0xa5,
+    0xa5, 0x41, 0x61, 0x08, 0x00, 0x82, 0x10, 0x41, 0x45, 0x29, 0x14, 0x04, 0x21, 0x21, 0x08, 0x61,
+    0x10, 0x82, 0x10, 0xc5, 0x51, 0x09, 0x8b, 0xa7, 0x7a, 0xa7, 0x82, 0xa2, 0x10, 0x64, 0x31, 0x2e,
+    0xdd, 0xb0, 0xe5, 0x54, 0xee, 0x74, 0xf6, 0x32, 0xf6, 0x4e, 0xd5, 0xaf, 0xe5, 0x30, 0xcd, 0xc3,
+    0x18, 0x21, 0x08, 0x62, 0x10, 0x41, 0x61, 0x08, 0xa5, 0xa6, 0x00, 0x62, 0x08, 0x80, 0x14, 0xa2,
+    0x10, 0x65, 0x29, 0x08, 0x42, 0x04, 0x21, 0x81, 0x10, 0xc2, 0x18, 0xa5, 0x49, 0x6a, 0x93, 0x0c,
+    0xb4, 0x29, 0x93, 0x41, 0x00, 0x44, 0x31, 0x4e, 0xdd, 0xd1, 0xe5, 0x75, 0xf6, 0xb6, 0xfe, 0xd6,
+    0xfe, 0xb4, 0xfe, 0x74, 0xf6, 0xb1, 0xe5, 0x65, 0x31, 0x80, 0x00, 0x62, 0x10, 0x00, 0x61, 0x08,
+    0xa6, 0xa8, 0x0e, 0x61, 0x08, 0x20, 0x00, 0x61, 0x08, 0x65, 0x29, 0x61, 0x10, 0x81, 0x10, 0xa2,
+    0x10, 0xc2, 0x18, 0x03, 0x21, 0x03, 0x29, 0x82, 0x08, 0x64, 0x39, 0x6e, 0xe5, 0x6f, 0xe5, 0xf2,
+    0xed, 0x80, 0x06, 0xb5, 0xfe, 0xd6, 0xfe, 0xb0, 0xe5, 0xed, 0xd4, 0xa5, 0x41, 0x21, 0x00, 0x62,
+    0x10, 0xa7, 0xa0, 0x00, 0x62, 0x08, 0x84, 0x00, 0x62, 0x08, 0x80, 0x14, 0x41, 0x08, 0x82, 0x10,
+    0x61, 0x08, 0x41, 0x08, 0x45, 0x29, 0x62, 0x10, 0xe2, 0x30, 0x84, 0x51, 0xa4, 0x51, 0x84, 0x49,
+    0x81, 0x08, 0x23, 0x29, 0xed, 0xd4, 0x6e, 0xe5, 0x6f, 0xdd, 0x12, 0xee, 0x33, 0xf6, 0xd1, 0xe5,
+    0xac, 0xd4, 0xc4, 0x59, 0x82, 0x10, 0x42, 0x61, 0x08, 0xa6, 0xa0, 0x00, 0x41, 0x08, 0x80, 0x43,
+    0x82, 0x10, 0x02, 0x41, 0x08, 0x61, 0x08, 0x86, 0x31, 0x41, 0xc7, 0x39, 0x12, 0x24, 0x21, 0xa7,
+    0x39, 0x43, 0x21, 0xc3, 0x39, 0x04, 0x5a, 0xa7, 0x8a, 0x89, 0xb3, 0x66, 0x72, 0x61, 0x08, 0x66,
+    0x62, 0x2d, 0xdd, 0x4e, 0xdd, 0xd0, 0xed, 0xd1, 0xe5, 0x2b, 0xbc, 0x0b, 0xbc, 0x24, 0x21, 0x21,
+    0x00, 0x62, 0x10, 0xa8, 0x9b, 0x00, 0x62, 0x08, 0x80, 0x00, 0x41, 0x08, 0x80, 0x18, 0x41, 0x08,
+    0x04, 0x21, 0xc3, 0x18, 0xa5, 0x31, 0x47, 0x42, 0x07, 0x42, 0x65, 0x29, 0x05, 0x21, 0x04, 0x21,
+    0x43, 0x21, 0xe1, 0x18, 0x02, 0x19, 0x83, 0x29, 0x23, 0x21, 0x62, 0x21, 0xc4, 0x4a, 0x24, 0x53,
+    0x84, 0x4a, 0x85, 0x62, 0x49, 0x9b, 0x64, 0x41, 0xa2, 0x10, 0x06, 0x4a, 0xeb, 0xa3, 0x4f, 0xdd,
+    0x41, 0x31, 0xfe, 0x01, 0x4a, 0x83, 0x62, 0x08, 0x42, 0x61, 0x08, 0xa7, 0x9a, 0x00, 0x62, 0x08,
+    0x41, 0x41, 0x08, 0x01, 0x86, 0x31, 0x45, 0x29, 0x80, 0x08, 0xa6, 0x31, 0xc3, 0x29, 0x63, 0x3a,
+    0xc4, 0x4a, 0x25, 0x53, 0xa4, 0x42, 0x05, 0x3a, 0x22, 0x21, 0xe1, 0x10, 0x41, 0xc1, 0x10, 0x01,
+    0x02, 0x19, 0xe2, 0x18, 0x41, 0xe1, 0x18, 0x0c, 0x23, 0x3a, 0x27, 0x7c, 0x48, 0x84, 0x46, 0x63,
+    0x04, 0x52, 0xe2, 0x28, 0x81, 0x10, 0xc3, 0x10, 0xc5, 0x39, 0xc7, 0x6a, 0x25, 0x52, 0x04, 0x29,
+    0x82, 0x10, 0x41, 0x61, 0x08, 0xa8, 0x99, 0x01, 0x62, 0x08, 0x41, 0x08, 0x41, 0xc3, 0x18, 0x0e,
+    0xc3, 0x31, 0xa4, 0x4a, 0x23, 0x3a, 0xc4, 0x4a, 0xc6, 0x63, 0xe7, 0x6b, 0x66, 0x5b, 0xa6, 0x63,
+    0x86, 0x5b, 0x03, 0x32, 0x22, 0x21, 0x63, 0x29, 0x63, 0x21, 0x83, 0x29, 0xa4, 0x29, 0x41, 0xa4,
+    0x31, 0x0c, 0x63, 0x21, 0x81, 0x08, 0xc1, 0x18, 0x44, 0x42, 0x47, 0x84, 0x07, 0x7c, 0x84, 0x5a,
+    0x82, 0x39, 0x01, 0x29, 0x20, 0x00, 0x82, 0x08, 0xc3, 0x10, 0x45, 0x29, 0x00, 0x61, 0x08, 0xaa,
+    0x98, 0x08, 0x62, 0x08, 0x41, 0x08, 0xc3, 0x18, 0x65, 0x29, 0xa3, 0x29, 0xc4, 0x4a, 0x65, 0x5b,
+    0x66, 0x5b, 0x46, 0x5b, 0x42, 0x25, 0x53, 0x02, 0x64, 0x3a, 0x22, 0x19, 0xc1, 0x10, 0x41, 0x81,
+    0x10, 0x00, 0x81, 0x08, 0x41, 0x61, 0x08, 0x0e, 0x02, 0x19, 0x65, 0x42, 0xaa, 0x6b, 0xc7, 0x4a,
+    0x63, 0x29, 0x81, 0x08, 0x83, 0x29, 0xa6, 0x6b, 0x66, 0x63, 0xa4, 0x52, 0xc3, 0x39, 0xa4, 0x18,
+    0x25, 0x29, 0xc3, 0x18, 0x41, 0x08, 0x42, 0x61, 0x08, 0xa8, 0x98, 0x06, 0x41, 0x08, 0xc3, 0x18,
+    0x65, 0x29, 0xc3, 0x31, 0x25, 0x53, 0x04, 0x32, 0x44, 0x3a, 0x42, 0xc5, 0x4a, 0x09, 0xe5, 0x4a,
+    0x03, 0x32, 0xe2, 0x18, 0x40, 0x08, 0x00, 0x00, 0xe2, 0x18, 0xc5, 0x52, 0xe5, 0x52, 0x06, 0x5b,
+    0xa5, 0x4a, 0x80, 0x0c, 0x02, 0x19, 0x04, 0x3a, 0xa7, 0x4a, 0x48, 0x5b, 0xa6, 0x4a, 0xc1, 0x10,
+    0xa1, 0x10, 0x44, 0x42, 0x05, 0x5b, 0x22, 0x21, 0x42, 0x21, 0xc5, 0x31, 0x66, 0x29, 0x80, 0x00,
+    0x61, 0x08, 0xaa, 0x97, 0x06, 0x62, 0x08, 0x41, 0x08, 0xe3, 0x18, 0x22, 0x21, 0xe5, 0x4a, 0xc5,
+    0x4a, 0x85, 0x42, 0x00, 0xa5, 0x42, 0x80, 0x00, 0xa5, 0x42, 0x80, 0x06, 0x04, 0x32, 0x02, 0x19,
+    0xc1, 0x10, 0x81, 0x10, 0x24, 0x42, 0xa6, 0x6b, 0x47, 0x7c, 0x41, 0x65, 0x5b, 0x10, 0xa6, 0x6b,
+    0xe6, 0x6b, 0x42, 0x29, 0xc2, 0x18, 0x25, 0x3a, 0x45, 0x42, 0x85, 0x42, 0xc6, 0x52, 0xc3, 0x31,
+    0xa1, 0x10, 0x22, 0x21, 0xa0, 0x10, 0xa2, 0x42, 0x43, 0x5b, 0xe5, 0x39, 0x66, 0x29, 0x82, 0x10,
+    0x80, 0x00, 0x62, 0x08, 0xa8, 0x98, 0x04, 0x62, 0x08, 0x66, 0x29, 0x83, 0x29, 0x84, 0x42, 0x44,
+    0x3a, 0x41, 0x85, 0x42, 0x00, 0x84, 0x42, 0x80, 0x06, 0x44, 0x3a, 0x02, 0x19, 0xc2, 0x10, 0x40,
+    0x08, 0x86, 0x63, 0xc8, 0x8c, 0x03, 0x53, 0x80, 0x0b, 0x2a, 0x95, 0x65, 0x5b, 0x86, 0x63, 0x85,
+    0x63, 0xe6, 0x6b, 0xc1, 0x18, 0xe2, 0x18, 0x63, 0x29, 0x06, 0x53, 0x49, 0x7c, 0x08, 0x74, 0x84,
+    0x42, 0x80, 0x41, 0xe1, 0x18, 0x02, 0xe3, 0x31, 0x24, 0x53, 0x83, 0x29, 0x80, 0x00, 0xc3, 0x18,
+    0xa9, 0x97, 0x07, 0x41, 0x08, 0xe7, 0x39, 0x85, 0x31, 0x64, 0x42, 0xe5, 0x4a, 0x44, 0x3a, 0x64,
+    0x42, 0x64, 0x3a, 0x81, 0x1d, 0x22, 0x21, 0xe2, 0x18, 0x40, 0x08, 0x86, 0x63, 0x09, 0x95, 0xa8,
+    0x84, 0xe9, 0x94, 0x68, 0x7c, 0x86, 0x63, 0xe4, 0x52, 0x05, 0x53, 0xe6, 0x6b, 0xa8, 0x84, 0xe5,
+    0x52, 0x20, 0x08, 0xe2, 0x18, 0x04, 0x3a, 0x87, 0x63, 0xa7, 0x63, 0x08, 0x6c, 0xc5, 0x52, 0xe2,
+    0x18, 0x22, 0x21, 0xe2, 0x18, 0x23, 0x3a, 0x41, 0x21, 0x03, 0x21, 0xa7, 0x31, 0x20, 0x00, 0x62,
+    0x10, 0xa7, 0x97, 0x04, 0x04, 0x21, 0x08, 0x42, 0xa2, 0x29, 0x25, 0x53, 0x04, 0x32, 0x41, 0x44,
+    0x3a, 0x04, 0x24, 0x3a, 0x64, 0x3a, 0xc3, 0x31, 0x02, 0x19, 0x61, 0x08, 0x80, 0x0b, 0x85, 0x63,
+    0x25, 0x5b, 0x45, 0x5b, 0xc6, 0x6b, 0xc4, 0x4a, 0x83, 0x42, 0xc4, 0x4a, 0x43, 0x3a, 0x45, 0x5b,
+    0xa8, 0x8c, 0xa6, 0x6b, 0xe2, 0x18, 0x41, 0xa2, 0x10, 0x0b, 0x65, 0x42, 0xc7, 0x6b, 0x86, 0x63,
+    0xa6, 0x63, 0x03, 0x3a, 0x02, 0x19, 0x43, 0x21, 0x22, 0x19, 0x21, 0x19, 0xa1, 0x10, 0x65, 0x31,
+    0x24, 0x21, 0xa8, 0x96, 0x01, 0x61, 0x08, 0x65, 0x29, 0x80, 0x02, 0xe2, 0x31, 0x64, 0x42, 0xc4,
+    0x31, 0x41, 0x44, 0x3a, 0x1c, 0x24, 0x3a, 0xa3, 0x29, 0x02, 0x19, 0xa1, 0x10, 0xc1, 0x18, 0x47,
+    0x7c, 0x45, 0x5b, 0x63, 0x42, 0xa3, 0x4a, 0x83, 0x42, 0xa3, 0x4a, 0xe7, 0x73, 0xc9, 0x8c, 0x07,
+    0x74, 0xa4, 0x4a, 0xe5, 0x52, 0x85, 0x63, 0x43, 0x29, 0xc4, 0x31, 0xe2, 0x18, 0xa1, 0x10, 0xe5,
+    0x52, 0x05, 0x53, 0xe5, 0x52, 0x45, 0x5b, 0x44, 0x42, 0x42, 0x21, 0x22, 0x19, 0xa2, 0x29, 0x80,
+    0x02, 0xa3, 0x31, 0x08, 0x42, 0xc3, 0x18, 0x80, 0x00, 0x61, 0x08, 0xa5, 0x96, 0x08, 0x61, 0x08,
+    0x45, 0x29, 0x65, 0x31, 0xc0, 0x10, 0x22, 0x21, 0x43, 0x21, 0x24, 0x3a, 0x04, 0x32, 0xa3, 0x29,
+    0x41, 0xc2, 0x18, 0x1e, 0x20, 0x00, 0xa3, 0x31, 0xa8, 0x84, 0x65, 0x5b, 0x04, 0x53, 0x85, 0x63,
+    0xa6, 0x6b, 0x45, 0x5b, 0xe9, 0x94, 0x6a, 0x9d, 0x07, 0x74, 0x84, 0x42, 0x23, 0x3a, 0x63, 0x42,
+    0xa2, 0x10, 0x05, 0x3a, 0xe5, 0x39, 0x82, 0x10, 0x42, 0x21, 0x67, 0x63, 0xe8, 0x6b, 0xc9, 0x84,
+    0xe9, 0x8c, 0xa6, 0x63, 0xa3, 0x31, 0x22, 0x21, 0x62, 0x21, 0x44, 0x3a, 0x63, 0x29, 0x25, 0x29,
+    0x21, 0x08, 0xa6, 0x97, 0x02, 0x86, 0x31, 0x03, 0x21, 0xa1, 0x10, 0x41, 0x61, 0x08, 0x0c, 0xc1,
+    0x10, 0xe2, 0x18, 0xc1, 0x10, 0xa1, 0x10, 0x20, 0x08, 0x42, 0x21, 0x07, 0x74, 0x25, 0x53, 0x24,
+    0x53, 0x06, 0x74, 0x07, 0x74, 0x68, 0x84, 0x27, 0x7c, 0x41, 0xc9, 0x8c, 0x14, 0x84, 0x42, 0xe2,
+    0x31, 0x43, 0x3a, 0x62, 0x21, 0x41, 0x08, 0x46, 0x42, 0x26, 0x42, 0x44, 0x21, 0x00, 0x00, 0xc4,
+    0x31, 0x46, 0x5b, 0xa7, 0x63, 0xe7, 0x6b, 0x07, 0x6c, 0x28, 0x74, 0x24, 0x3a, 0x61, 0x08, 0xe4,
+    0x31, 0xa2, 0x29, 0x65, 0x29, 0x25, 0x29, 0xa6, 0x97, 0x11, 0x45, 0x29, 0xc1, 0x10, 0x42, 0x21,
+    0xe2, 0x18, 0xe1, 0x18, 0x02, 0x19, 0xe2, 0x18, 0xc2, 0x18, 0x81, 0x10, 0x40, 0x08, 0x67, 0x84,
+    0x48, 0x9d, 0x25, 0x53, 0xc4, 0x4a, 0xa6, 0x6b, 0xe6, 0x6b, 0x07, 0x74, 0xc7, 0x6b, 0x41, 0xa6,
+    0x6b, 0x04, 0x63, 0x42, 0xa2, 0x29, 0x23, 0x3a, 0xa1, 0x10, 0x61, 0x08, 0x41, 0xa7, 0x52, 0x0f,
+    0x85, 0x31, 0x41, 0x08, 0xa1, 0x10, 0x26, 0x5b, 0x05, 0x53, 0x26, 0x53, 0x05, 0x53, 0x26, 0x53,
+    0x46, 0x5b, 0x81, 0x10, 0x22, 0x21, 0xc3, 0x31, 0x84, 0x29, 0x04, 0x21, 0x41, 0x08, 0x62, 0x08,
+    0xa4, 0x97, 0x01, 0x04, 0x21, 0x81, 0x10, 0x41, 0xe1, 0x18, 0x01, 0xc1, 0x10, 0xe1, 0x18, 0x80,
+    0x05, 0x22, 0x21, 0x61, 0x08, 0x62, 0x29, 0x69, 0x9d, 0x47, 0x7c, 0x05, 0x5b, 0x80, 0x14, 0x25,
+    0x53, 0x85, 0x63, 0xa6, 0x6b, 0x45, 0x5b, 0xc4, 0x52, 0xa4, 0x4a, 0x23, 0x3a, 0x01, 0x19, 0x22,
+    0x21, 0x00, 0x00, 0x64, 0x29, 0x47, 0x42, 0x06, 0x42, 0xa6, 0x31, 0xe3, 0x20, 0x61, 0x08, 0x64,
+    0x42, 0x26, 0x53, 0xa4, 0x42, 0xe5, 0x4a, 0x05, 0x53, 0x80, 0x04, 0xa1, 0x10, 0xe2, 0x18, 0xc3,
+    0x31, 0x23, 0x21, 0x41, 0x08, 0x00, 0x61, 0x08, 0xa5, 0x95, 0x41, 0x61, 0x08, 0x18, 0x64, 0x29,
+    0xa3, 0x29, 0x01, 0x19, 0x41, 0x08, 0xc2, 0x18, 0xa5, 0x4a, 0x46, 0x5b, 0x24, 0x3a, 0xe1, 0x18,
+    0xe7, 0x73, 0x0a, 0x95, 0xe5, 0x52, 0xc4, 0x4a, 0x25, 0x5b, 0x65, 0x5b, 0xa6, 0x6b, 0x06, 0x74,
+    0x25, 0x53, 0xe4, 0x4a, 0x83, 0x42, 0x02, 0x32, 0x60, 0x08, 0x20, 0x08, 0x40, 0x08, 0xc4, 0x31,
+    0x41, 0xe5, 0x39, 0x05, 0xa6, 0x31, 0xc7, 0x39, 0xa2, 0x10, 0x61, 0x08, 0x84, 0x42, 0xa4, 0x42,
+    0x80, 0x06, 0x06, 0x53, 0x66, 0x5b, 0xa1, 0x10, 0x81, 0x10, 0x62, 0x21, 0xc2, 0x18, 0x82, 0x10,
+    0x00, 0x61, 0x08, 0xa5, 0x94, 0x42, 0x61, 0x08, 0x10, 0x01, 0x19, 0xa4, 0x42, 0x22, 0x21, 0xc1,
+    0x18, 0xc5, 0x4a, 0xe5, 0x52, 0x66, 0x5b, 0x83, 0x29, 0x82, 0x29, 0x65, 0x5b, 0x68, 0x84, 0x07,
+    0x74, 0x05, 0x53, 0x07, 0x74, 0x45, 0x5b, 0x85, 0x63, 0xc6, 0x6b, 0x41, 0x04, 0x53, 0x05, 0x83,
+    0x42, 0x42, 0x21, 0x00, 0x00, 0x20, 0x00, 0x02, 0x21, 0xa4, 0x31, 0x41, 0x64, 0x29, 0x02, 0x86,
+    0x31, 0x08, 0x42, 0xa6, 0x39, 0x41, 0x61, 0x08, 0x00, 0xa3, 0x29, 0x41, 0x84, 0x42, 0x05, 0xa5,
+    0x4a, 0xe2, 0x18, 0x02, 0x19, 0x22, 0x21, 0xc3, 0x18, 0x82, 0x10, 0x00, 0x61, 0x08, 0xa5, 0x94,
+    0x42, 0x61, 0x08, 0x16, 0x22, 0x19, 0x43, 0x3a, 0x02, 0x19, 0x24, 0x3a, 0x66, 0x5b, 0x64, 0x42,
+    0x82, 0x29, 0x63, 0x29, 0x08, 0x7c, 0xc6, 0x6b, 0x68, 0x84, 0x2a, 0x9d, 0xc9, 0x8c, 0x45, 0x5b,
+    0xe4, 0x4a, 0x25, 0x5b, 0x45, 0x5b, 0x04, 0x53, 0xc4, 0x4a, 0xe2, 0x31, 0x40, 0x08, 0x20, 0x00,
+    0xa1, 0x10, 0x00, 0x63, 0x29, 0x80, 0x02, 0x43, 0x21, 0x44, 0x29, 0x66, 0x31, 0x41, 0x86, 0x31,
+    0x03, 0x44, 0x29, 0xa2, 0x18, 0x41, 0x08, 0xe2, 0x18, 0x41, 0xe1, 0x18, 0x05, 0x81, 0x10, 0x02,
+    0x19, 0x63, 0x29, 0x66, 0x29, 0x41, 0x08, 0x62, 0x08, 0xa5, 0x94, 0x42, 0x61, 0x08, 0x00, 0x42,
+    0x21, 0x80, 0x01, 0xe2, 0x18, 0x62, 0x29, 0x41, 0x03, 0x32, 0x07, 0x60, 0x08, 0xe6, 0x5a, 0xab,
+    0xad, 0x4b, 0x9d, 0xa8, 0x84, 0xe9, 0x94, 0x2a, 0x95, 0x65, 0x5b, 0x42, 0x63, 0x42, 0x08, 0x83,
+    0x4a, 0xc2, 0x31, 0x40, 0x08, 0x00, 0x00, 0x81, 0x10, 0x42, 0x21, 0x43, 0x21, 0x23, 0x21, 0xc2,
+    0x18, 0x41, 0xa3, 0x18, 0x03, 0xc3, 0x18, 0x03, 0x21, 0x23, 0x21, 0xc2, 0x18, 0x80, 0x09, 0x20,
+    0x00, 0x81, 0x08, 0xa1, 0x10, 0x60, 0x08, 0xc1, 0x18, 0x83, 0x29, 0xe7, 0x39, 0xc3, 0x18, 0x41,
+    0x08, 0x62, 0x08, 0xa4, 0x94, 0x42, 0x61, 0x08, 0x00, 0x82, 0x29, 0x80, 0x14, 0xa1, 0x10, 0xe1,
+    0x18, 0xa3, 0x29, 0x01, 0x19, 0x63, 0x29, 0x69, 0x84, 0x4b, 0xa5, 0x48, 0x7c, 0xa5, 0x63, 0xc9,
+    0x8c, 0xa8, 0x8c, 0x06, 0x74, 0x05, 0x53, 0x63, 0x42, 0xe2, 0x31, 0x62, 0x29, 0x20, 0x08, 0x00,
+    0x00, 0x61, 0x08, 0x62, 0x21, 0xa3, 0x29, 0x80, 0x10, 0x02, 0x19, 0x83, 0x29, 0x25, 0x42, 0x45,
+    0x42, 0x65, 0x42, 0x84, 0x29, 0x43, 0x21, 0xa6, 0x52, 0x68, 0x6b, 0x28, 0x63, 0x22, 0x21, 0x25,
+    0x42, 0x48, 0x63, 0x25, 0x42, 0x84, 0x4a, 0x65, 0x4a, 0xe4, 0x18, 0x80, 0x00, 0x62, 0x08, 0xa4,
+    0x95, 0x41, 0x61, 0x08, 0x11, 0xa3, 0x29, 0xe3, 0x31, 0xa1, 0x10, 0xc1, 0x10, 0x42, 0x21, 0x60,
+    0x08, 0xa8, 0x6b, 0xec, 0xb5, 0x89, 0x84, 0x83, 0x42, 0xe4, 0x52, 0xc9, 0x8c, 0x27, 0x7c, 0x25,
+    0x5b, 0xc4, 0x4a, 0x83, 0x42, 0xa2, 0x31, 0x40, 0x08, 0x41, 0x00, 0x00, 0x08, 0xa1, 0x10, 0x42,
+    0x21, 0x63, 0x21, 0x02, 0x19, 0xc4, 0x31, 0xa8, 0x6b, 0xc8, 0x73, 0x4a, 0x84, 0x49, 0x7c, 0x80,
+    0x0d, 0xc4, 0x31, 0x49, 0x84, 0x0c, 0x9d, 0x4c, 0xa5, 0x04, 0x3a, 0xe7, 0x5a, 0x91, 0xce, 0x0a,
+    0x7c, 0xe7, 0x52, 0x6c, 0xa5, 0x87, 0x4a, 0xa3, 0x10, 0x61, 0x08, 0x62, 0x08, 0xa3, 0x95, 0x41,
+    0x61, 0x08, 0x01, 0xa3, 0x29, 0xe3, 0x31, 0x41, 0xa1, 0x10, 0x0d, 0xe1, 0x18, 0x60, 0x08, 0x07,
+    0x74, 0xa8, 0x8c, 0xa6, 0x6b, 0x24, 0x5b, 0xe6, 0x73, 0xa6, 0x6b, 0x86, 0x63, 0xe4, 0x52, 0x83,
+    0x42, 0xa2, 0x29, 0x40, 0x08, 0x61, 0x08, 0x41, 0xc1, 0x10, 0x17, 0xe2, 0x18, 0xc2, 0x18, 0x02,
+    0x19, 0x41, 0x08, 0x83, 0x31, 0xe5, 0x52, 0x85, 0x4a, 0xa5, 0x52, 0x85, 0x4a, 0xe2, 0x18, 0x22,
+    0x21, 0x64, 0x4a, 0x44, 0x42, 0xa5, 0x52, 0x22, 0x21, 0xc3, 0x31, 0x49, 0x84, 0x48, 0x63, 0x25,
+    0x42, 0xaa, 0x8c, 0x66, 0x4a, 0x05, 0x21, 0x41, 0x08, 0x62, 0x08, 0x00, 0x61, 0x08, 0xa2, 0x95,
+    0x41, 0x61, 0x08, 0x02, 0x62, 0x21, 0xa3, 0x29, 0xc1, 0x10, 0x41, 0xa1, 0x10, 0x05, 0x22, 0x21,
+    0xe4, 0x52, 0xc4, 0x4a, 0x24, 0x5b, 0xe4, 0x52, 0x46, 0x5b, 0x41, 0xa4, 0x4a, 0x04, 0x83, 0x4a,
+    0xe2, 0x31, 0x40, 0x08, 0x00, 0x00, 0x60, 0x08, 0x42, 0x81, 0x10, 0x00, 0x02, 0x19, 0x80, 0x02,
+    0x63, 0x29, 0x45, 0x4a, 0x65, 0x4a, 0x41, 0x44, 0x42, 0x0f, 0x04, 0x3a, 0x61, 0x08, 0x04, 0x3a,
+    0x85, 0x4a, 0x44, 0x42, 0x85, 0x52, 0xa1, 0x10, 0x43, 0x29, 0xc8, 0x7b, 0x86, 0x4a, 0x05, 0x42,
+    0xc8, 0x73, 0x25, 0x42, 0x04, 0x21, 0x21, 0x08, 0x62, 0x10, 0xa3, 0x95, 0x41, 0x61, 0x08, 0x41,
+    0x22, 0x21, 0x04, 0xe2, 0x18, 0x81, 0x10, 0x40, 0x08, 0xc6, 0x6b, 0x47, 0x7c, 0x41, 0x65, 0x63,
+    0x0f, 0x45, 0x5b, 0x03, 0x32, 0xc3, 0x31, 0xe3, 0x31, 0xa2, 0x29, 0x61, 0x08, 0x00, 0x00, 0x81,
+    0x10, 0xa1, 0x10, 0xc1, 0x18, 0xe1, 0x18, 0x02, 0x21, 0x02, 0x19, 0x81, 0x10, 0x45, 0x4a, 0x67,
+    0x6b, 0x41, 0x27, 0x5b, 0x0f, 0x07, 0x5b, 0xe6, 0x5a, 0x81, 0x10, 0x86, 0x52, 0x68, 0x6b, 0x47,
+    0x63, 0xa8, 0x73, 0x02, 0x21, 0x43, 0x29, 0x6b, 0x8c, 0xe7, 0x5a, 0x45, 0x42, 0xe8, 0x73, 0xe4,
+    0x39, 0xe4, 0x20, 0xc3, 0x18, 0x80, 0x00, 0x62, 0x08, 0xa2, 0x95, 0x42, 0x61, 0x08, 0x10, 0xc1,
+    0x10, 0xe2, 0x18, 0xe1, 0x18, 0xc5, 0x52, 0x67, 0x84, 0x47, 0x7c, 0xe6, 0x6b, 0x86, 0x63, 0xe4,
+    0x52, 0x63, 0x42, 0x23, 0x3a, 0xe2, 0x31, 0x42, 0x21, 0x00, 0x00, 0xc1, 0x18, 0xe3, 0x31, 0x65,
+    0x42, 0x41, 0xe6, 0x52, 0x00, 0x07, 0x53, 0x80, 0x08, 0x41, 0x08, 0x04, 0x42, 0x87, 0x6b, 0x47,
+    0x63, 0x67, 0x63, 0x47, 0x63, 0x27, 0x63, 0x81, 0x10, 0x45, 0x4a, 0x81, 0x0b, 0xa8, 0x6b, 0xe2,
+    0x18, 0x63, 0x29, 0x6b, 0x8c, 0xc7, 0x5a, 0x65, 0x4a, 0xe8, 0x7b, 0x44, 0x42, 0xe2, 0x18, 0x86,
+    0x31, 0x61, 0x08, 0x62, 0x08, 0xa2, 0x95, 0x41, 0x61, 0x08, 0x19, 0xa7, 0x31, 0x20, 0x08, 0xa1,
+    0x10, 0x22, 0x21, 0xc8, 0x8c, 0x06, 0x74, 0x63, 0x42, 0x05, 0x53, 0x85, 0x63, 0xc4, 0x4a, 0x43,
+    0x3a, 0x83, 0x42, 0x43, 0x42, 0xa1, 0x10, 0x00, 0x00, 0x02, 0x19, 0x43, 0x21, 0xa4, 0x31, 0xe4,
+    0x31, 0x05, 0x3a, 0xe4, 0x31, 0x02, 0x19, 0x00, 0x00, 0x25, 0x42, 0xa8, 0x73, 0x67, 0x6b, 0x41,
+    0x88, 0x6b, 0x10, 0x68, 0x6b, 0x61, 0x10, 0x65, 0x4a, 0xa8, 0x73, 0x67, 0x63, 0xa8, 0x73, 0xe2,
+    0x18, 0x63, 0x29, 0x8b, 0x8c, 0xe7, 0x5a, 0xc6, 0x52, 0x4a, 0x8c, 0x85, 0x4a, 0x22, 0x3a, 0x24,
+    0x21, 0xe4, 0x20, 0x21, 0x08, 0xa2, 0x96, 0x0d, 0x61, 0x08, 0xc3, 0x18, 0x04, 0x21, 0x00, 0x00,
+    0x62, 0x29, 0x07, 0x74, 0xe4, 0x52, 0x64, 0x42, 0xc4, 0x4a, 0xe4, 0x52, 0x83, 0x42, 0x43, 0x3a,
+    0x23, 0x32, 0xc2, 0x31, 0x41, 0x00, 0x00, 0x02, 0xc1, 0x10, 0x63, 0x29, 0xe4, 0x39, 0x41, 0x05,
+    0x3a, 0x04, 0xa4, 0x31, 0xe2, 0x18, 0x00, 0x00, 0x25, 0x42, 0xa8, 0x73, 0x43, 0x88, 0x6b, 0x11,
+    0x61, 0x08, 0x65, 0x4a, 0x88, 0x73, 0x47, 0x63, 0xa8, 0x73, 0x02, 0x21, 0x43, 0x29, 0x6b, 0x8c,
+    0x28, 0x63, 0xc6, 0x52, 0x2a, 0x84, 0xe3, 0x39, 0x43, 0x3a, 0xc3, 0x31, 0xa7, 0x31, 0xa3, 0x18,
+    0x41, 0x08, 0x62, 0x08, 0xa0, 0x95, 0x41, 0x61, 0x08, 0x08, 0x41, 0x08, 0xa2, 0x10, 0xc4, 0x18,
+    0x42, 0x21, 0x07, 0x74, 0xe4, 0x52, 0x05, 0x53, 0xa4, 0x4a, 0x64, 0x42, 0x41, 0xa4, 0x4a, 0x01,
+    0x63, 0x3a, 0x01, 0x19, 0x41, 0x00, 0x00, 0x09, 0xa1, 0x10, 0x63, 0x29, 0x04, 0x3a, 0x25, 0x3a,
+    0x05, 0x3a, 0x84, 0x29, 0xc2, 0x18, 0x00, 0x00, 0x04, 0x42, 0xa8, 0x73, 0x00, 0x68, 0x6b, 0x80,
+    0x41, 0x88, 0x6b, 0x01, 0x61, 0x08, 0x45, 0x4a, 0x80, 0x0f, 0x27, 0x63, 0xa8, 0x6b, 0x02, 0x21,
+    0x43, 0x29, 0x6a, 0x8c, 0x47, 0x63, 0xc6, 0x52, 0xe9, 0x73, 0xc3, 0x31, 0x44, 0x42, 0x64, 0x42,
+    0xa4, 0x31, 0x08, 0x42, 0x62, 0x08, 0x41, 0x08, 0x62, 0x08, 0x9f, 0x96, 0x00, 0x61, 0x08, 0x81,
+    0x0a, 0x64, 0x29, 0x23, 0x42, 0xa8, 0x8c, 0x65, 0x63, 0xc5, 0x6b, 0xc6, 0x6b, 0x64, 0x42, 0x84,
+    0x42, 0xa4, 0x4a, 0x02, 0x32, 0x60, 0x08, 0x41, 0x00, 0x00, 0x02, 0xa1, 0x10, 0x02, 0x19, 0x63,
+    0x29, 0x41, 0xa3, 0x29, 0x04, 0x63, 0x29, 0x81, 0x10, 0x00, 0x00, 0x25, 0x42, 0xc8, 0x73, 0x41,
+    0x67, 0x6b, 0x13, 0x68, 0x6b, 0x67, 0x6b, 0x61, 0x08, 0x45, 0x4a, 0x87, 0x6b, 0x27, 0x63, 0x87,
+    0x6b, 0x02, 0x21, 0x63, 0x29, 0x8b, 0x94, 0x48, 0x6b, 0x07, 0x5b, 0xc8, 0x73, 0x42, 0x21, 0xc3,
+    0x31, 0x84, 0x42, 0xa4, 0x4a, 0x05, 0x3a, 0x08, 0x42, 0x82, 0x10, 0x80, 0x00, 0x62, 0x08, 0x9e,
+    0x97, 0x06, 0x41, 0x08, 0xc3, 0x18, 0x83, 0x29, 0xe8, 0x8c, 0xe9, 0x94, 0x47, 0x7c, 0x84, 0x4a,
+    0x41, 0x64, 0x42, 0x03, 0x83, 0x42, 0x43, 0x3a, 0x21, 0x21, 0x21, 0x08, 0x41, 0x20, 0x00, 0x01,
+    0x20, 0x08, 0x41, 0x08, 0x43, 0x61, 0x08, 0x03, 0x40, 0x08, 0x00, 0x00, 0x61, 0x10, 0xc2, 0x18,
+    0x41, 0xa1, 0x10, 0x04, 0xa1, 0x18, 0xa1, 0x10, 0x00, 0x00, 0xa1, 0x10, 0xe2, 0x18, 0x41, 0xc2,
+    0x18, 0x04, 0x20, 0x08, 0x81, 0x10, 0x63, 0x29, 0x23, 0x21, 0x43, 0x21, 0x41, 0x63, 0x29, 0x07,
+    0x62, 0x29, 0xe3, 0x39, 0x66, 0x63, 0x84, 0x4a, 0x04, 0x21, 0xc7, 0x39, 0x41, 0x08, 0x62, 0x08,
+    0x9e, 0x97, 0x07, 0x41, 0x08, 0xc3, 0x18, 0x04, 0x3a, 0x26, 0x74, 0xe9, 0x94, 0x88, 0x84, 0xc6,
+    0x6b, 0xc4, 0x4a, 0x41, 0x23, 0x3a, 0x0d, 0x81, 0x29, 0x65, 0x29, 0x87, 0x31, 0xa2, 0x10, 0x02,
+    0x19, 0x83, 0x29, 0x24, 0x3a, 0x85, 0x42, 0xe6, 0x52, 0x26, 0x5b, 0xc4, 0x31, 0x02, 0x19, 0x81,
+    0x08, 0xa1, 0x10, 0x81, 0x41, 0xa1, 0x10, 0x43, 0x81, 0x10, 0x41, 0x60, 0x08, 0x00, 0x61, 0x08,
+    0x41, 0x22, 0x21, 0x01, 0xe2, 0x18, 0xc1, 0x18, 0x81, 0x06, 0xa3, 0x31, 0x44, 0x42, 0xe3, 0x31,
+    0xc2, 0x18, 0x41, 0x08, 0x86, 0x31, 0x82, 0x10, 0x9f, 0x97, 0x2c, 0x21, 0x00, 0x66, 0x29, 0x44,
+    0x29, 0x42, 0x21, 0xc5, 0x52, 0x46, 0x63, 0x67, 0x84, 0x87, 0x84, 0xe4, 0x52, 0x43, 0x3a, 0x43,
+    0x21, 0x29, 0x42, 0xe3, 0x18, 0x03, 0x19, 0x22, 0x21, 0xa3, 0x29, 0x24, 0x3a, 0x65, 0x42, 0x06,
+    0x53, 0xe6, 0x52, 0x05, 0x32, 0x43, 0x21, 0xa1, 0x10, 0x22, 0x21, 0x62, 0x29, 0x82, 0x29, 0x83,
+    0x29, 0x63, 0x29, 0xa3, 0x29, 0xa3, 0x31, 0x83, 0x29, 0xa3, 0x31, 0x82, 0x29, 0xa3, 0x31, 0x22,
+    0x21, 0x43, 0x42, 0xa3, 0x31, 0x49, 0x4a, 0x23, 0x21, 0x42, 0x21, 0x82, 0x29, 0x42, 0x21, 0xa1,
+    0x10, 0x41, 0x08, 0xc3, 0x18, 0x41, 0x65, 0x29, 0x01, 0xc3, 0x18, 0x41, 0x08, 0x9e, 0x97, 0x03,
+    0x82, 0x10, 0x86, 0x31, 0x82, 0x10, 0xa3, 0x10, 0x41, 0x21, 0x08, 0x05, 0xc1, 0x18, 0x42, 0x21,
+    0x62, 0x29, 0xc1, 0x18, 0x66, 0x29, 0xa3, 0x18, 0x41, 0xe3, 0x18, 0x01, 0xe1, 0x18, 0x42, 0x21,
+    0x42, 0x83, 0x29, 0x09, 0xa3, 0x29, 0x63, 0x29, 0xa1, 0x10, 0x60, 0x08, 0xc1, 0x10, 0xa1, 0x10,
+    0x80, 0x10, 0x60, 0x08, 0x20, 0x08, 0x20, 0x00, 0x43, 0x81, 0x10, 0x06, 0xa1, 0x10, 0xa2, 0x10,
+    0x64, 0x29, 0x85, 0x31, 0x25, 0x29, 0xc7, 0x39, 0xe3, 0x18, 0x41, 0x61, 0x08, 0x03, 0x62, 0x10,
+    0x04, 0x21, 0x65, 0x29, 0xc7, 0x39, 0x41, 0x45, 0x29, 0x01, 0xc3, 0x18, 0x41, 0x08, 0x9d, 0x97,
+    0x02, 0x66, 0x29, 0xa3, 0x10, 0xc3, 0x18, 0x41, 0x45, 0x29, 0x08, 0x04, 0x21, 0xc3, 0x18, 0x62,
+    0x08, 0x01, 0x00, 0xa3, 0x10, 0xe3, 0x18, 0x20, 0x00, 0x24, 0x21, 0x82, 0x10, 0x81, 0x00, 0x40,
+    0x08, 0x41, 0x41, 0x08, 0x41, 0x40, 0x08, 0x03, 0xa1, 0x10, 0x03, 0x3a, 0x84, 0x42, 0x64, 0x42,
+    0x42, 0x63, 0x42, 0x02, 0x41, 0x21, 0x20, 0x00, 0x00, 0x00, 0x80, 0x0c, 0x80, 0x10, 0x00, 0x00,
+    0x41, 0x08, 0x83, 0x10, 0x82, 0x10, 0x41, 0x08, 0x82, 0x10, 0x86, 0x31, 0x62, 0x10, 0x82, 0x10,
+    0xe3, 0x18, 0xe3, 0x20, 0x04, 0x21, 0x41, 0xe4, 0x18, 0x03, 0xa3, 0x10, 0x25, 0x29, 0x41, 0x08,
+    0x62, 0x08, 0x9c, 0x97, 0x03, 0x62, 0x10, 0xa3, 0x18, 0x45, 0x29, 0x86, 0x31, 0x41, 0xa6, 0x31,
+    0x0a, 0x86, 0x31, 0x04, 0x21, 0x21, 0x08, 0xc7, 0x39, 0xc3, 0x18, 0x21, 0x00, 0x45, 0x29, 0x04,
+    0x21, 0xa2, 0x10, 0x82, 0x10, 0x40, 0x08, 0x41, 0xa1, 0x10, 0x1f, 0xc1, 0x18, 0x82, 0x29, 0x25,
+    0x53, 0xe5, 0x52, 0x64, 0x42, 0xe4, 0x52, 0xa5, 0x63, 0x48, 0x7c, 0x2b, 0x95, 0xc6, 0x6b, 0x03,
+    0x3a, 0x81, 0x10, 0x41, 0x21, 0x82, 0x29, 0xe7, 0x39, 0x04, 0x21, 0x62, 0x08, 0x41, 0x08, 0x62,
+    0x08, 0x41, 0x08, 0xa2, 0x10, 0xc3, 0x18, 0x82, 0x10, 0x04, 0x21, 0xc3, 0x18, 0x82, 0x10, 0x85,
+    0x49, 0x8a, 0x9b, 0x64, 0x39, 0x05, 0x21, 0x61, 0x08, 0x62, 0x08, 0x9c, 0x97, 0x0a, 0x20, 0x00,
+    0xa3, 0x18, 0x45, 0x29, 0x08, 0x42, 0x28, 0x42, 0x29, 0x4a, 0x86, 0x31, 0x83, 0x10, 0x25, 0x21,
+    0x65, 0x29, 0x62, 0x10, 0x80, 0x16, 0x82, 0x10, 0x45, 0x29, 0xc7, 0x39, 0x86, 0x31, 0x81, 0x10,
+    0x21, 0x19, 0x42, 0x21, 0x82, 0x29, 0xc3, 0x31, 0xe3, 0x31, 0x43, 0x3a, 0x03, 0x32, 0xe4, 0x52,
+    0xe6, 0x73, 0x07, 0x74, 0x49, 0x7c, 0x2b, 0x9d, 0xa9, 0x8c, 0xa4, 0x52, 0xc1, 0x18, 0x24, 0x21,
+    0x66, 0x29, 0x82, 0x10, 0x43, 0x61, 0x08, 0x02, 0x82, 0x10, 0x45, 0x29, 0x61, 0x08, 0x80, 0x05,
+    0xc2, 0x20, 0x61, 0x10, 0x87, 0x7a, 0x8e, 0xfd, 0x29, 0x93, 0xa7, 0x31, 0x80, 0x00, 0x62, 0x10,
+    0x9c, 0x97, 0x41, 0x41, 0x08, 0x01, 0xe4, 0x20, 0x65, 0x29, 0x41, 0xc7, 0x39, 0x09, 0x45, 0x29,
+    0xc2, 0x28, 0xa6, 0x41, 0xc3, 0x18, 0x41, 0x08, 0x62, 0x08, 0x61, 0x08, 0x41, 0x08, 0x20, 0x00,
+    0x62, 0x08, 0x80, 0x0a, 0x41, 0x21, 0x42, 0x21, 0xa2, 0x29, 0x23, 0x3a, 0x62, 0x21, 0x82, 0x29,
+    0x84, 0x42, 0x65, 0x63, 0x26, 0x74, 0x86, 0x63, 0xa6, 0x63, 0x41, 0x0a, 0x95, 0x03, 0xe6, 0x73,
+    0xc3, 0x31, 0xc3, 0x18, 0x62, 0x08, 0x45, 0x61, 0x08, 0x08, 0x82, 0x10, 0xc7, 0x39, 0xa3, 0x10,
+    0x43, 0x49, 0xc7, 0x9a, 0xe5, 0x69, 0x87, 0x8a, 0x48, 0x5a, 0xc3, 0x18, 0x80, 0x00, 0x62, 0x08,
+    0x9c, 0x97, 0x00, 0xe7, 0x39, 0x41, 0x82, 0x10, 0x1a, 0x04, 0x21, 0x24, 0x21, 0xe4, 0x18, 0x03,
+    0x29, 0x24, 0x82, 0xe6, 0x59, 0x66, 0x29, 0x21, 0x00, 0x62, 0x10, 0x61, 0x08, 0x62, 0x08, 0x61,
+    0x08, 0xa3, 0x10, 0x81, 0x10, 0x62, 0x21, 0xa2, 0x29, 0x23, 0x3a, 0xc4, 0x4a, 0x43, 0x3a, 0x23,
+    0x3a, 0x86, 0x63, 0xa6, 0x6b, 0x85, 0x63, 0x06, 0x74, 0xe6, 0x73, 0x68, 0x84, 0x27, 0x7c, 0x41,
+    0x66, 0x63, 0x02, 0x22, 0x21, 0x62, 0x08, 0x41, 0x08, 0x44, 0x61, 0x08, 0x07, 0x41, 0x08, 0x82,
+    0x10, 0x86, 0x29, 0xa6, 0x49, 0xe4, 0x71, 0x46, 0x7a, 0xa6, 0x41, 0x61, 0x08, 0x9f, 0x97, 0x01,
+    0xc3, 0x18, 0x66, 0x29, 0x41, 0x82, 0x10, 0x07, 0xa2, 0x10, 0x82, 0x18, 0xa7, 0x8a, 0xc6, 0xa2,
+    0x07, 0x5a, 0x45, 0x29, 0x21, 0x08, 0x62, 0x08, 0x41, 0x61, 0x08, 0x06, 0x41, 0x08, 0xc3, 0x18,
+    0x61, 0x10, 0xc2, 0x31, 0x64, 0x42, 0x44, 0x3a, 0xa4, 0x4a, 0x41, 0xc4, 0x4a, 0x0b, 0x25, 0x53,
+    0xa6, 0x6b, 0xa6, 0x63, 0x27, 0x74, 0x07, 0x74, 0xc4, 0x4a, 0x23, 0x3a, 0x64, 0x42, 0xa6, 0x6b,
+    0x24, 0x42, 0x04, 0x21, 0xc3, 0x18, 0x44, 0x61, 0x08, 0x00, 0x62, 0x08, 0x41, 0x41, 0x08, 0x03,
+    0x24, 0x29, 0xe3, 0x28, 0xe3, 0x20, 0x62, 0x08, 0x80, 0x00, 0x62, 0x08, 0x9e, 0x97, 0x09, 0x41,
+    0x08, 0xa3, 0x10, 0xc7, 0x39, 0x04, 0x21, 0x04, 0x29, 0xc4, 0x69, 0xe7, 0x9a, 0xa8, 0x7a, 0xa6,
+    0x39, 0x62, 0x10, 0x80, 0x41, 0x61, 0x08, 0x09, 0x62, 0x08, 0x41, 0x08, 0xe3, 0x18, 0xa2, 0x18,
+    0xa1, 0x10, 0x23, 0x3a, 0x64, 0x42, 0x23, 0x3a, 0x43, 0x3a, 0x64, 0x42, 0x41, 0x84, 0x42, 0x0b,
+    0x43, 0x42, 0x25, 0x5b, 0xe4, 0x52, 0x43, 0x3a, 0x23, 0x3a, 0xe3, 0x31, 0xc5, 0x52, 0x07, 0x74,
+    0xe4, 0x39, 0xa7, 0x39, 0x41, 0x08, 0x62, 0x08, 0x43, 0x61, 0x08, 0x80, 0x00, 0x62, 0x08, 0x42,
+    0x41, 0x08, 0x01, 0x61, 0x08, 0x62, 0x08, 0x9f, 0x97, 0x08, 0x62, 0x08, 0x41, 0x08, 0x82, 0x10,
+    0xa2, 0x10, 0x04, 0x21, 0x04, 0x29, 0x65, 0x39, 0x04, 0x21, 0x20, 0x00, 0x81, 0x43, 0x61, 0x08,
+    0x06, 0xe8, 0x39, 0x02, 0x19, 0xe1, 0x18, 0x62, 0x21, 0x84, 0x42, 0xa4, 0x4a, 0x84, 0x4a, 0x41,
+    0x64, 0x42, 0x0c, 0xe3, 0x31, 0x82, 0x29, 0x84, 0x4a, 0x47, 0x84, 0xc6, 0x6b, 0x85, 0x6b, 0x25,
+    0x5b, 0xa4, 0x4a, 0x45, 0x5b, 0x23, 0x3a, 0x66, 0x29, 0x41, 0x08, 0x62, 0x08, 0x44, 0x61, 0x08,
+    0x80, 0x42, 0x62, 0x08, 0x00, 0x61, 0x08, 0xa0, 0x98, 0x00, 0x62, 0x08, 0x80, 0x42, 0x41, 0x08,
+    0x02, 0x41, 0x00, 0x41, 0x08, 0x62, 0x10, 0x82, 0x41, 0x61, 0x08, 0x0a, 0x82, 0x10, 0xe8, 0x39,
+    0xe1, 0x18, 0xa2, 0x29, 0xe1, 0x18, 0xa3, 0x29, 0xe5, 0x52, 0x84, 0x4a, 0xa4, 0x4a, 0x25, 0x5b,
+    0x05, 0x53, 0x80, 0x0b, 0xe5, 0x52, 0xa6, 0x6b, 0xe9, 0x94, 0x88, 0x84, 0x68, 0x84, 0x86, 0x63,
+    0x85, 0x63, 0xe6, 0x6b, 0xc5, 0x31, 0x25, 0x21, 0x21, 0x08, 0x62, 0x08, 0x46, 0x61, 0x08, 0xa2,
+    0x9b, 0x41, 0x62, 0x08, 0x01, 0x62, 0x10, 0x62, 0x08, 0x82, 0x41, 0x61, 0x08, 0x06, 0x41, 0x08,
+    0xc3, 0x18, 0xa6, 0x31, 0xe1, 0x18, 0xc2, 0x31, 0x82, 0x29, 0xa1, 0x10, 0x80, 0x0f, 0x23, 0x3a,
+    0x84, 0x4a, 0xa6, 0x6b, 0x06, 0x74, 0x24, 0x53, 0xa5, 0x63, 0x64, 0x42, 0x46, 0x5b, 0x48, 0x7c,
+    0x89, 0x84, 0x48, 0x7c, 0x07, 0x74, 0xc6, 0x6b, 0xa4, 0x31, 0x66, 0x29, 0x62, 0x08, 0x47, 0x61,
+    0x08, 0xa2, 0xa3, 0x41, 0x61, 0x08, 0x18, 0x24, 0x21, 0x81, 0x10, 0x22, 0x21, 0xc3, 0x31, 0xe3,
+    0x31, 0x22, 0x21, 0xa1, 0x10, 0xe3, 0x39, 0xa4, 0x4a, 0x86, 0x63, 0x25, 0x5b, 0xa4, 0x4a, 0x24,
+    0x5b, 0xa4, 0x4a, 0xc3, 0x29, 0x86, 0x6b, 0xe9, 0x8c, 0x0a, 0x95, 0xa9, 0x84, 0x65, 0x63, 0x45,
+    0x5b, 0x44, 0x29, 0xe4, 0x20, 0x41, 0x08, 0x62, 0x08, 0x43, 0x61, 0x08, 0xa4, 0xa3, 0x41, 0x61,
+    0x08, 0x05, 0xa7, 0x31, 0xc1, 0x10, 0x62, 0x21, 0xa3, 0x31, 0xc3, 0x31, 0xa3, 0x29, 0x41, 0xe1,
+    0x18, 0x0e, 0x64, 0x42, 0x46, 0x5b, 0x05, 0x53, 0x25, 0x5b, 0xa6, 0x63, 0xc5, 0x4a, 0x44, 0x3a,
+    0x05, 0x53, 0x25, 0x5b, 0xc7, 0x73, 0x25, 0x5b, 0x63, 0x42, 0xe6, 0x73, 0x06, 0x53, 0xa7, 0x31,
+    0x46, 0x61, 0x08, 0xa3, 0xa5, 0x12, 0xc3, 0x18, 0xa1, 0x10, 0x82, 0x29, 0x03, 0x3a, 0x23, 0x3a,
+    0xc3, 0x31, 0xa3, 0x29, 0xc1, 0x18, 0x42, 0x21, 0x05, 0x5b, 0x85, 0x63, 0xc6, 0x6b, 0x07, 0x74,
+    0x66, 0x63, 0x23, 0x3a, 0xe5, 0x52, 0xa4, 0x4a, 0x23, 0x3a, 0xe2, 0x31, 0x80, 0x04, 0xc4, 0x4a,
+    0x45, 0x5b, 0x65, 0x29, 0x82, 0x10, 0x41, 0x08, 0x47, 0x61, 0x08, 0xa0, 0xa2, 0x1a, 0x62, 0x08,
+    0x41, 0x08, 0x24, 0x21, 0xe2, 0x18, 0x41, 0x21, 0xe3, 0x31, 0x84, 0x42, 0x84, 0x4a, 0x24, 0x3a,
+    0xc3, 0x31, 0xa3, 0x29, 0xa1, 0x10, 0x82, 0x29, 0x83, 0x42, 0x25, 0x5b, 0xe6, 0x6b, 0x48, 0x7c,
+    0xa5, 0x4a, 0x04, 0x53, 0x45, 0x5b, 0x83, 0x42, 0x43, 0x42, 0x03, 0x3a, 0xa4, 0x4a, 0x07, 0x74,
+    0x87, 0x4a, 0x25, 0x29, 0x48, 0x61, 0x08, 0xa0, 0xa1, 0x06, 0x62, 0x08, 0x41, 0x08, 0x25, 0x29,
+    0x25, 0x21, 0xe1, 0x18, 0x82, 0x29, 0x03, 0x3a, 0x42, 0x64, 0x42, 0x14, 0x23, 0x3a, 0x03, 0x3a,
+    0x42, 0x21, 0xc1, 0x10, 0xa4, 0x4a, 0x45, 0x5b, 0x65, 0x63, 0x27, 0x74, 0xe5, 0x52, 0x23, 0x3a,
+    0x04, 0x53, 0x25, 0x5b, 0x86, 0x63, 0x25, 0x5b, 0xca, 0x94, 0xac, 0xad, 0xc9, 0x8c, 0xa4, 0x31,
+    0x45, 0x29, 0x41, 0x08, 0x62, 0x08, 0x46, 0x61, 0x08, 0x9f, 0xa1, 0x15, 0x62, 0x08, 0x20, 0x00,
+    0x45, 0x29, 0xe3, 0x20, 0x21, 0x21, 0x82, 0x29, 0x62, 0x21, 0x44, 0x3a, 0x64, 0x42, 0x44, 0x42,
+    0x03, 0x3a, 0xc2, 0x31, 0x42, 0x21, 0x81, 0x10, 0x22, 0x21, 0x04, 0x53, 0x66, 0x63, 0xa5, 0x4a,
+    0x03, 0x3a, 0xa2, 0x29, 0x43, 0x42, 0x27, 0x7c, 0x41, 0x0a, 0x95, 0x04, 0x4b, 0x9d, 0x0a, 0x95,
+    0x8b, 0xa5, 0x66, 0x63, 0xc7, 0x39, 0x48, 0x61, 0x08, 0x9f, 0xa0, 0x04, 0x62, 0x08, 0x41, 0x08,
+    0xc3, 0x18, 0x86, 0x31, 0x62, 0x21, 0x41, 0x82, 0x29, 0x03, 0xa3, 0x29, 0x44, 0x42, 0x64, 0x42,
+    0xc3, 0x31, 0x41, 0x42, 0x21, 0x0b, 0x62, 0x21, 0x01, 0x19, 0x61, 0x08, 0x82, 0x29, 0x04, 0x53,
+    0x05, 0x53, 0x23, 0x3a, 0xa2, 0x29, 0xe5, 0x52, 0xe7, 0x73, 0xc9, 0x8c, 0x89, 0x84, 0x41, 0xa9,
+    0x84, 0x03, 0xe9, 0x94, 0xc6, 0x6b, 0x44, 0x21, 0xa3, 0x10, 0x47, 0x61, 0x08, 0x9f, 0xa1, 0x06,
+    0x82, 0x10, 0xe7, 0x39, 0x22, 0x21, 0x63, 0x42, 0x23, 0x3a, 0x83, 0x29, 0x03, 0x3a, 0x41, 0x23,
+    0x3a, 0x0f, 0xa2, 0x29, 0x62, 0x21, 0x42, 0x21, 0xc2, 0x31, 0x42, 0x21, 0xa1, 0x10, 0x82, 0x10,
+    0x43, 0x21, 0xa2, 0x29, 0x43, 0x3a, 0x23, 0x3a, 0x63, 0x42, 0xc4, 0x4a, 0x27, 0x7c, 0xa6, 0x6b,
+    0xe7, 0x6b, 0x41, 0x27, 0x74, 0x04, 0xa9, 0x84, 0x27, 0x5b, 0xa6, 0x31, 0x41, 0x08, 0x62, 0x08,
+    0x45, 0x61, 0x08, 0x9f, 0xa0, 0x09, 0x41, 0x08, 0xe3, 0x18, 0x03, 0x21, 0x03, 0x3a, 0xa4, 0x4a,
+    0x43, 0x3a, 0x62, 0x21, 0xa3, 0x29, 0x23, 0x3a, 0xe3, 0x31, 0x41, 0x82, 0x29, 0x08, 0x42, 0x21,
+    0x82, 0x29, 0xe1, 0x18, 0x61, 0x08, 0xe8, 0x41, 0x25, 0x21, 0x40, 0x08, 0xc2, 0x31, 0x83, 0x42,
+    0x41, 0x43, 0x42, 0x08, 0x86, 0x63, 0xc6, 0x6b, 0x04, 0x53, 0xe6, 0x6b, 0xc6, 0x6b, 0x68, 0x7c,
+    0xe6, 0x6b, 0x47, 0x42, 0x42, 0x08, 0x46, 0x61, 0x08, 0x9f, 0x9e, 0x08, 0x62, 0x08, 0x41, 0x08,
+    0x04, 0x21, 0xc3, 0x18, 0x21, 0x19, 0xc3, 0x31, 0x23, 0x3a, 0x84, 0x42, 0x44, 0x42, 0x42, 0x64,
+    0x42, 0x0e, 0x03, 0x32, 0xc3, 0x29, 0x42, 0x21, 0xe1, 0x18, 0x60, 0x08, 0x25, 0x29, 0xe3, 0x18,
+    0x62, 0x08, 0x81, 0x10, 0x61, 0x29, 0x03, 0x3a, 0x23, 0x3a, 0x03, 0x3a, 0x05, 0x53, 0xc7, 0x6b,
+    0x41, 0x66, 0x63, 0x04, 0x43, 0x42, 0x05, 0x53, 0x65, 0x5b, 0x43, 0x29, 0x82, 0x10, 0x44, 0x61,
+    0x08, 0xa1, 0x9f, 0x05, 0x82, 0x10, 0x86, 0x31, 0x01, 0x19, 0x03, 0x3a, 0xe3, 0x31, 0xc3, 0x31,
+    0x41, 0x64, 0x42, 0x13, 0x84, 0x42, 0x64, 0x42, 0x03, 0x3a, 0xc3, 0x31, 0x82, 0x29, 0x62, 0x21,
+    0xe0, 0x18, 0xe3, 0x18, 0x86, 0x31, 0x41, 0x08, 0xc3, 0x18, 0x25, 0x21, 0x01, 0x19, 0xa3, 0x4a,
+    0x25, 0x5b, 0x23, 0x3a, 0xa2, 0x29, 0x45, 0x5b, 0xe5, 0x52, 0x84, 0x4a, 0x41, 0xe2, 0x31, 0x03,
+    0x05, 0x53, 0xe2, 0x18, 0x41, 0x08, 0x62, 0x08, 0x44, 0x61, 0x08, 0xa0, 0x9d, 0x24, 0x62, 0x10,
+    0x41, 0x08, 0x45, 0x29, 0xe2, 0x18, 0x82, 0x29, 0x23, 0x3a, 0x44, 0x42, 0x62, 0x29, 0x83, 0x29,
+    0x44, 0x42, 0x84, 0x42, 0xc3, 0x31, 0x62, 0x29, 0x42, 0x21, 0x62, 0x21, 0x82, 0x29, 0xc1, 0x10,
+    0x04, 0x21, 0x41, 0x08, 0x61, 0x08, 0x41, 0x08, 0x04, 0x21, 0x81, 0x10, 0x02, 0x32, 0x04, 0x53,
+    0x85, 0x63, 0x63, 0x42, 0xe4, 0x52, 0x27, 0x7c, 0x47, 0x7c, 0x65, 0x5b, 0x27, 0x7c, 0x09, 0x95,
+    0xe6, 0x5a, 0xc3, 0x18, 0x21, 0x08, 0x62, 0x08, 0x00, 0x61, 0x08, 0xa3, 0x9c, 0x10, 0x62, 0x10,
+    0x21, 0x08, 0xc3, 0x18, 0x85, 0x31, 0x21, 0x21, 0xa2, 0x29, 0x43, 0x3a, 0x84, 0x42, 0xe3, 0x31,
+    0x44, 0x42, 0x84, 0x42, 0xe3, 0x31, 0xa2, 0x29, 0x42, 0x21, 0x01, 0x19, 0x62, 0x21, 0xc1, 0x10,
+    0x41, 0xc3, 0x18, 0x0c, 0x61, 0x08, 0x62, 0x08, 0x41, 0x08, 0x66, 0x29, 0x24, 0x29, 0x62, 0x21,
+    0xe3, 0x31, 0x24, 0x5b, 0xe6, 0x6b, 0xc7, 0x6b, 0x86, 0x63, 0xa6, 0x6b, 0xa5, 0x63, 0x41, 0x09,
+    0x95, 0x04, 0x06, 0x6c, 0x27, 0x42, 0xe4, 0x20, 0x41, 0x08, 0x62, 0x08, 0x00, 0x61, 0x08, 0xa2,
+    0x9b, 0x0b, 0x62, 0x10, 0x20, 0x00, 0x25, 0x29, 0x08, 0x3a, 0x41, 0x21, 0x42, 0x21, 0x21, 0x21,
+    0x03, 0x3a, 0x64, 0x42, 0x44, 0x42, 0x43, 0x42, 0x62, 0x21, 0x41, 0x21, 0x21, 0x02, 0x22, 0x21,
+    0x21, 0x21, 0x01, 0x19, 0x41, 0xc3, 0x18, 0x01, 0x41, 0x08, 0x62, 0x08, 0x41, 0x61, 0x08, 0x06,
+    0x82, 0x10, 0xc7, 0x39, 0x02, 0x19, 0x02, 0x32, 0x05, 0x53, 0xa9, 0x8c, 0x89, 0x84, 0x41, 0x45,
+    0x5b, 0x01, 0x85, 0x63, 0xc6, 0x6b, 0x80, 0x04, 0x62, 0x3a, 0x63, 0x21, 0x66, 0x29, 0x21, 0x08,
+    0x62, 0x08, 0xa3, 0x9a, 0x06, 0x62, 0x08, 0x41, 0x08, 0x04, 0x21, 0xe7, 0x39, 0x62, 0x29, 0xc2,
+    0x31, 0xa2, 0x29, 0x41, 0x42, 0x21, 0x42, 0x62, 0x29, 0x08, 0x42, 0x21, 0x62, 0x29, 0x82, 0x29,
+    0xc3, 0x31, 0x81, 0x29, 0x02, 0x19, 0x25, 0x29, 0x21, 0x08, 0x62, 0x10, 0x41, 0x61, 0x08, 0x04,
+    0x62, 0x08, 0x41, 0x08, 0xe4, 0x20, 0xa1, 0x10, 0x23, 0x3a, 0x80, 0x02, 0xe7, 0x73, 0x68, 0x84,
+    0xa5, 0x6b, 0x41, 0x04, 0x53, 0x07, 0xc2, 0x29, 0xa0, 0x08, 0xa1, 0x29, 0xc4, 0x52, 0xc6, 0x39,
+    0x04, 0x21, 0x41, 0x08, 0x62, 0x08, 0xa2, 0x9a, 0x12, 0x62, 0x08, 0x41, 0x08, 0x45, 0x29, 0x04,
+    0x3a, 0x06, 0x74, 0x45, 0x5b, 0x25, 0x5b, 0xe5, 0x52, 0x62, 0x29, 0x82, 0x29, 0xe3, 0x31, 0x23,
+    0x3a, 0xe3, 0x31, 0x03, 0x3a, 0xe3, 0x31, 0xa2, 0x29, 0xc1, 0x18, 0x86, 0x31, 0xa2, 0x10, 0x43,
+    0x61, 0x08, 0x11, 0x62, 0x08, 0x41, 0x08, 0x45, 0x29, 0x41, 0x08, 0xc2, 0x31, 0xc4, 0x4a, 0x66,
+    0x63, 0xe7, 0x73, 0x25, 0x5b, 0xc4, 0x4a, 0x43, 0x3a, 0xa5, 0x4a, 0xa5, 0x52, 0x64, 0x63, 0x28,
+    0x95, 0xa6, 0x6b, 0x44, 0x29, 0x21, 0x08, 0xa3, 0x9b, 0x12, 0x62, 0x08, 0x61, 0x10, 0x23, 0x3a,
+    0xa5, 0x63, 0xa6, 0x63, 0xc7, 0x6b, 0x66, 0x63, 0xa5, 0x4a, 0x23, 0x3a, 0x43, 0x42, 0xc3, 0x31,
+    0xa2, 0x29, 0xe3, 0x31, 0x62, 0x21, 0xa1, 0x10, 0x25, 0x21, 0xc3, 0x18, 0x41, 0x08, 0x62, 0x08,
+    0x42, 0x61, 0x08, 0x11, 0x62, 0x08, 0x41, 0x08, 0x45, 0x29, 0x82, 0x10, 0x21, 0x21, 0x43, 0x3a,
+    0xa4, 0x4a, 0x25, 0x5b, 0xa6, 0x63, 0x47, 0x7c, 0x0a, 0x95, 0xad, 0xad, 0xcd, 0xb5, 0x27, 0x7c,
+    0xa6, 0x6b, 0x87, 0x84, 0x04, 0x3a, 0x86, 0x31, 0xa3, 0x9a, 0x12, 0x62, 0x08, 0x41, 0x08, 0xe3,
+    0x18, 0x43, 0x21, 0x43, 0x3a, 0x66, 0x5b, 0xa7, 0x6b, 0xe5, 0x52, 0x05, 0x53, 0xa4, 0x4a, 0xc3,
+    0x31, 0x62, 0x21, 0xc3, 0x31, 0x61, 0x21, 0x23, 0x21, 0x45, 0x29, 0x62, 0x08, 0x41, 0x08, 0x62,
+    0x08, 0x46, 0x61, 0x08, 0x0f, 0xa7, 0x39, 0x02, 0x21, 0xa2, 0x29, 0x63, 0x42, 0xa4, 0x4a, 0x45,
+    0x5b, 0xa8, 0x84, 0xe9, 0x94, 0x2b, 0x9d, 0xea, 0x94, 0xe5, 0x52, 0xe4, 0x52, 0xe6, 0x6b, 0xa3,
+    0x4a, 0xe4, 0x18, 0x82, 0x10, 0xa2, 0x99, 0x03, 0x62, 0x08, 0x41, 0x08, 0xa3, 0x10, 0xe4, 0x18,
+    0x80, 0x0d, 0x41, 0x08, 0x22, 0x21, 0x64, 0x42, 0xc4, 0x52, 0xe5, 0x52, 0xc5, 0x4a, 0x04, 0x3a,
+    0x23, 0x3a, 0x43, 0x3a, 0x21, 0x19, 0x66, 0x29, 0x82, 0x10, 0x41, 0x08, 0x62, 0x08, 0x46, 0x61,
+    0x08, 0x00, 0x41, 0x08, 0x80, 0x02, 0x25, 0x29, 0x61, 0x21, 0x84, 0x42, 0x41, 0xe4, 0x4a, 0x0a,
+    0xc4, 0x4a, 0xa6, 0x6b, 0x48, 0x7c, 0xa9, 0x8c, 0xa6, 0x6b, 0x85, 0x63, 0xa5, 0x63, 0x64, 0x42,
+    0x04, 0x21, 0x41, 0x08, 0x62, 0x08, 0xa1, 0x99, 0x02, 0x41, 0x08, 0xc3, 0x18, 0x65, 0x29, 0x80,
+    0x01, 0xc3, 0x18, 0x82, 0x10, 0x41, 0x00, 0x00, 0x09, 0xe1, 0x18, 0x44, 0x42, 0x23, 0x3a, 0xe2,
+    0x31, 0x02, 0x32, 0x01, 0x19, 0x66, 0x29, 0x04, 0x21, 0x21, 0x08, 0x62, 0x08, 0x48, 0x61, 0x08,
+    0x10, 0x82, 0x10, 0x45, 0x29, 0x42, 0x21, 0x45, 0x5b, 0x27, 0x74, 0xc6, 0x6b, 0x65, 0x5b, 0xa6,
+    0x6b, 0xc6, 0x6b, 0xc9, 0x8c, 0xa8, 0x8c, 0x63, 0x42, 0xe1, 0x18, 0x82, 0x10, 0x25, 0x21, 0x41,
+    0x08, 0x62, 0x08, 0xa1, 0x98, 0x05, 0x62, 0x08, 0x41, 0x08, 0x45, 0x29, 0xa2, 0x10, 0xa3, 0x18,
+    0xe3, 0x18, 0x41, 0xc3, 0x18, 0x09, 0x82, 0x10, 0x21, 0x08, 0x20, 0x00, 0x40, 0x08, 0x61, 0x08,
+    0xe3, 0x18, 0x66, 0x29, 0xc3, 0x18, 0x41, 0x08, 0x62, 0x08, 0x4a, 0x61, 0x08, 0x0d, 0xe3, 0x18,
+    0x04, 0x21, 0x61, 0x21, 0xc3, 0x4a, 0x85, 0x63, 0x0a, 0x95, 0x07, 0x74, 0x24, 0x5b, 0x43, 0x3a,
+    0x42, 0x21, 0x62, 0x10, 0x25, 0x29, 0xe3, 0x20, 0xe4, 0x20, 0x80, 0x00, 0x62, 0x08, 0xa1, 0x97,
+    0x0a, 0x62, 0x08, 0x41, 0x08, 0x04, 0x21, 0xe3, 0x18, 0x82, 0x10, 0x24, 0x21, 0x04, 0x21, 0xe4,
+    0x20, 0xe4, 0x18, 0xe3, 0x18, 0xc3, 0x18, 0x80, 0x41, 0x61, 0x08, 0x03, 0xc3, 0x18, 0x82, 0x10,
+    0x41, 0x08, 0x62, 0x08, 0x4b, 0x61, 0x08, 0x0f, 0x41, 0x08, 0xc3, 0x18, 0x86, 0x31, 0x22, 0x21,
+    0x82, 0x29, 0x03, 0x3a, 0xa3, 0x31, 0x22, 0x21, 0x41, 0x08, 0xa3, 0x18, 0xc7, 0x39, 0xaa, 0x52,
+    0xa6, 0x31, 0x25, 0x29, 0xa3, 0x18, 0x21, 0x08, 0x46, 0x62, 0x08, 0x9a, 0x97, 0x04, 0x41, 0x08,
+    0x04, 0x21, 0x66, 0x31, 0x62, 0x10, 0xe3, 0x18, 0x41, 0x04, 0x21, 0x06, 0xe4, 0x20, 0x04, 0x21,
+    0xe3, 0x18, 0xc3, 0x18, 0xa3, 0x18, 0x20, 0x00, 0xe4, 0x20, 0x80, 0x01, 0x41, 0x08, 0x62, 0x08,
+    0x4c, 0x61, 0x08, 0x0f, 0x62, 0x08, 0x21, 0x08, 0x04, 0x21, 0xe8, 0x39, 0x62, 0x10, 0x41, 0x08,
+    0xa3, 0x10, 0xa3, 0x18, 0x24, 0x21, 0xe7, 0x41, 0x08, 0x42, 0x69, 0x4a, 0xa7, 0x39, 0x45, 0x29,
+    0xc3, 0x18, 0xe4, 0x18, 0x46, 0x41, 0x08, 0x80, 0x00, 0x62, 0x08, 0x98, 0x97, 0x01, 0xc3, 0x18,
+    0x66, 0x29, 0x80, 0x01, 0xc3, 0x18, 0xe3, 0x18, 0x41, 0xe4, 0x20, 0x07, 0x04, 0x21, 0x25, 0x29,
+    0x24, 0x21, 0xe4, 0x20, 0x41, 0x08, 0xc3, 0x18, 0xe4, 0x18, 0x41, 0x08, 0x4f, 0x61, 0x08, 0x04,
+    0x62, 0x10, 0x20, 0x00, 0xc3, 0x18, 0x04, 0x21, 0x82, 0x10, 0x41, 0x45, 0x29, 0x00, 0x25, 0x29,
+    0x41, 0x86, 0x31, 0x03, 0xa6, 0x31, 0x08, 0x42, 0xa6, 0x31, 0xa2, 0x18, 0x41, 0x45, 0x29, 0x02,
+    0xc3, 0x18, 0xe4, 0x20, 0x25, 0x21, 0x41, 0x04, 0x21, 0x03, 0x25, 0x29, 0x82, 0x10, 0x41, 0x08,
+    0x62, 0x08, 0x97, 0x97, 0x00, 0x45, 0x29, 0x42, 0xc3, 0x18, 0x42, 0xe3, 0x18, 0x07, 0xe4, 0x20,
+    0x25, 0x29, 0x24, 0x21, 0xa2, 0x10, 0xa3, 0x18, 0x86, 0x31, 0x61, 0x08, 0x62, 0x08, 0x49, 0x61,
+    0x08, 0x80, 0x46, 0x61, 0x08, 0x09, 0xa2, 0x10, 0x45, 0x29, 0x82, 0x10, 0x04, 0x21, 0x45, 0x29,
+    0x24, 0x29, 0x24, 0x21, 0x65, 0x29, 0xa6, 0x31, 0x29, 0x4a, 0x42, 0x45, 0x29, 0x0a, 0x24, 0x21,
+    0x45, 0x29, 0xc3, 0x18, 0x25, 0x29, 0x08, 0x42, 0xc7, 0x39, 0x45, 0x29, 0xc7, 0x39, 0xa2, 0x10,
+    0x41, 0x08, 0x62, 0x08, 0x96, 0x97, 0x41, 0xa3, 0x18, 0x41, 0x25, 0x29, 0x00, 0xc3, 0x18, 0x42,
+    0xe3, 0x18, 0x41, 0x04, 0x21, 0x02, 0xe4, 0x20, 0xc3, 0x18, 0x04, 0x21, 0x41, 0x41, 0x08, 0x50,
+    0x61, 0x08, 0x0a, 0x62, 0x08, 0x41, 0x08, 0xc3, 0x18, 0xe4, 0x18, 0x82, 0x10, 0x04, 0x21, 0x25,
+    0x29, 0x04, 0x21, 0x25, 0x29, 0x86, 0x31, 0xe7, 0x39, 0x41, 0xc7, 0x39, 0x04, 0xa6, 0x31, 0xa7,
+    0x39, 0x08, 0x42, 0xe7, 0x39, 0x49, 0x4a, 0x41, 0x0c, 0x63, 0x03, 0x08, 0x42, 0x24, 0x21, 0x86,
+    0x31, 0x82, 0x10, 0x97, 0x97, 0x03, 0x20, 0x08, 0x62, 0x10, 0xc3, 0x18, 0x04, 0x21, 0x41, 0xc3,
+    0x18, 0x07, 0xe3, 0x18, 0xc3, 0x18, 0x45, 0x29, 0xa6, 0x31, 0x66, 0x31, 0xe4, 0x18, 0xc3, 0x18,
+    0x65, 0x29, 0x80, 0x02, 0x82, 0x10, 0x61, 0x08, 0x62, 0x08, 0x43, 0x82, 0x10, 0x80, 0x4a, 0x82,
+    0x10, 0x16, 0x62, 0x08, 0x66, 0x29, 0x41, 0x08, 0xc3, 0x18, 0x04, 0x21, 0xe3, 0x18, 0x04, 0x21,
+    0x45, 0x29, 0x86, 0x31, 0xc7, 0x39, 0x08, 0x42, 0x49, 0x4a, 0x6a, 0x52, 0x8a, 0x52, 0x29, 0x4a,
+    0xc7, 0x39, 0xa6, 0x31, 0x66, 0x31, 0x86, 0x31, 0x04, 0x21, 0x45, 0x29, 0xa3, 0x18, 0x41, 0x08,
+    0x96, 0x97, 0x0c, 0xa6, 0x31, 0xc3, 0x18, 0x82, 0x10, 0xa3, 0x18, 0xa2, 0x10, 0xa3, 0x18, 0xc3,
+    0x18, 0xe3, 0x18, 0x25, 0x21, 0xa6, 0x31, 0x65, 0x29, 0xe4, 0x20, 0x62, 0x10, 0x80, 0x03, 0x45,
+    0x29, 0xa6, 0x31, 0xa7, 0x31, 0x20, 0x00, 0x50, 0x00, 0x00, 0x06, 0x24, 0x21, 0x21, 0x08, 0xc3,
+    0x18, 0x66, 0x31, 0x25, 0x29, 0xc3, 0x18, 0x04, 0x21, 0x41, 0x45, 0x29, 0x03, 0x66, 0x31, 0xc7,
+    0x39, 0xe7, 0x39, 0xa7, 0x39, 0x41, 0x86, 0x31, 0x06, 0x25, 0x29, 0x24, 0x21, 0xc3, 0x18, 0x21,
+    0x08, 0x66, 0x31, 0xa2, 0x10, 0x41, 0x08, 0x96, 0x97, 0x01, 0x20, 0x00, 0xe3, 0x18, 0x80, 0x41,
+    0x00, 0x00, 0x09, 0x21, 0x08, 0xa3, 0x18, 0xc3, 0x18, 0xe4, 0x20, 0x25, 0x29, 0x45, 0x29, 0x25,
+    0x29, 0x65, 0x29, 0x86, 0x31, 0xc7, 0x39, 0x80, 0x00, 0xc3, 0x18, 0x4e, 0x61, 0x08, 0x80, 0x42,
+    0x61, 0x08, 0x06, 0x86, 0x31, 0x82, 0x10, 0xa7, 0x39, 0xc7, 0x39, 0x65, 0x29, 0x24, 0x21, 0x25,
+    0x29, 0x41, 0x24, 0x21, 0x05, 0x25, 0x29, 0x45, 0x29, 0x86, 0x31, 0x65, 0x29, 0xe4, 0x20, 0xa2,
+    0x10, 0x41, 0x00, 0x00, 0x03, 0x66, 0x31, 0xa7, 0x39, 0x41, 0x08, 0x62, 0x08, 0x96, 0x95, 0x46,
+    0x61, 0x08, 0x04, 0x04, 0x21, 0x00, 0x00, 0x82, 0x10, 0xa3, 0x18, 0xe3, 0x18, 0x43, 0x04, 0x21,
+    0x02, 0x25, 0x29, 0x66, 0x29, 0x41, 0x08, 0x49, 0x61, 0x08, 0x84, 0x00, 0x61, 0x08, 0x82, 0x0e,
+    0x6a, 0x52, 0x20, 0x00, 0x45, 0x29, 0xa6, 0x31, 0xe7, 0x39, 0xc7, 0x39, 0xa6, 0x31, 0x04, 0x21,
+    0xc3, 0x18, 0xe3, 0x20, 0xe4, 0x20, 0xe3, 0x18, 0x62, 0x08, 0x21, 0x08, 0x21, 0x00, 0x81, 0x04,
+    0x04, 0x21, 0x00, 0x00, 0x21, 0x00, 0x62, 0x10, 0x62, 0x08, 0x95,
+};
+
+static const MAIN_anim_frame_t MAIN_anim_soldier_frames[] = {
+    {MAIN_anim_soldier_frame0, 7307, 0, {22, 13, 60, 91}},
+    {MAIN_anim_soldier_frame1, 6815, 1, {21, 13, 61, 91}},
+    {MAIN_anim_soldier_frame2, 7003, 1, {21, 13, 61, 91}},
+};
+
+static const MAIN_anim_asset_t MAIN_ANIM_ASSETS[] = {
+    {"soldier", 104, 104, 3, MAIN_anim_soldier_frames},
+};
+
+static const size_t MAIN_ANIM_ASSET_COUNT = sizeof(MAIN_ANIM_ASSETS) / sizeof(MAIN_ANIM_ASSETS[0]);
+
+#endif // __MAIN_ANIM_ASSETS_H__
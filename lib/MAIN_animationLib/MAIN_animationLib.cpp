@@ -0,0 +1,473 @@
+/**
+ * @file MAIN_animationLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Compressed animation assets for EARS (startup marching soldier)
+ * @version 1.2.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_animationLib.h"
+#include "MAIN_animAssets.h"
+#include <esp_heap_caps.h>
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static MAIN_anim_player_t anim_startup_player;
+static lv_timer_t *anim_startup_timer = NULL;
+static uint32_t anim_startup_started_ms = 0;
+static uint8_t anim_startup_fps = ANIM_STARTUP_FPS;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Decode one row's opcodes
+ * @param src Read position, advanced past the row
+ * @param end End of the frame data
+ * @param row First pixel of the destination row (2-byte aligned)
+ * @param width Pixels in the row
+ * @param allowSkip Delta frame (skip opcodes allowed)
+ * @return true if the row decoded to exactly width pixels
+ */
+static bool anim_decode_row(const uint8_t **src, const uint8_t *end, uint16_t *row,
+                            uint16_t width, bool allowSkip)
+{
+    const uint8_t *p = *src;
+    uint16_t x = 0;
+
+    while (x < width)
+    {
+        if (p >= end)
+        {
+            return false;
+        }
+
+        uint8_t op = *p++;
+        uint16_t count = ANIM_OP_COUNT(op);
+        if (count > width - x)
+        {
+            return false;
+        }
+
+        switch (op & ANIM_OP_MASK)
+        {
+        case ANIM_OP_LITERAL:
+            if ((uint32_t)(end - p) < (uint32_t)count * ANIM_BYTES_PER_PIXEL)
+            {
+                return false;
+            }
+            memcpy(&row[x], p, count * ANIM_BYTES_PER_PIXEL);
+            p += count * ANIM_BYTES_PER_PIXEL;
+            break;
+
+        case ANIM_OP_RUN:
+        {
+            if (end - p < ANIM_BYTES_PER_PIXEL)
+            {
+                return false;
+            }
+            uint16_t colour = (uint16_t)(p[0] | (p[1] << 8));
+            p += ANIM_BYTES_PER_PIXEL;
+            for (uint16_t i = 0; i < count; i++)
+            {
+                row[x + i] = colour;
+            }
+            break;
+        }
+
+        case ANIM_OP_SKIP:
+            if (!allowSkip)
+            {
+                return false;
+            }
+            break;
+
+        default:
+            return false;
+        }
+
+        x += count;
+    }
+
+    *src = p;
+    return true;
+}
+
+/******************************************************************************
+ * Animation Assets
+ *****************************************************************************/
+
+/**
+ * @brief Find a generated animation by name
+ * @param name Directory name under assets/animation (e.g. "soldier")
+ * @return const MAIN_anim_asset_t* Asset, or NULL if not built in
+ */
+const MAIN_anim_asset_t *MAIN_animation_find_asset(const char *name)
+{
+    if (name == NULL)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < MAIN_ANIM_ASSET_COUNT; i++)
+    {
+        if (strcmp(MAIN_ANIM_ASSETS[i].name, name) == 0)
+        {
+            return &MAIN_ANIM_ASSETS[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Decode a frame into an RGB565 buffer, one row at a time
+ * @param asset Animation asset
+ * @param index Frame index
+ * @param dest First pixel of the destination
+ * @param stride Bytes from one destination row to the next
+ * @return true if the frame decoded cleanly
+ */
+bool MAIN_animation_decode_frame(const MAIN_anim_asset_t *asset, uint16_t index,
+                                 uint8_t *dest, uint32_t stride)
+{
+    if (asset == NULL || dest == NULL || index >= asset->frameCount)
+    {
+        return false;
+    }
+
+    // Runs are stored as 16-bit words
+    if ((((uintptr_t)dest) | stride) & 1)
+    {
+        return false;
+    }
+
+    const MAIN_anim_frame_t *frame = &asset->frames[index];
+    const uint8_t *src = frame->data;
+    const uint8_t *end = frame->data + frame->size;
+
+    for (uint16_t y = 0; y < asset->height; y++)
+    {
+        uint16_t *row = (uint16_t *)(dest + (uint32_t)y * stride);
+        if (!anim_decode_row(&src, end, row, asset->width, frame->isDelta != 0))
+        {
+#if EARS_DEBUG == 1
+            Serial.printf("[ANIM] ERROR: %s frame %u corrupt at row %u\n",
+                          asset->name, index, y);
+#endif
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Bytes needed for one decoded frame with a packed stride
+ * @param asset Animation asset
+ * @return uint32_t width * height * 2
+ */
+uint32_t MAIN_animation_frame_bytes(const MAIN_anim_asset_t *asset)
+{
+    if (asset == NULL)
+    {
+        return 0;
+    }
+
+    return (uint32_t)asset->width * asset->height * ANIM_BYTES_PER_PIXEL;
+}
+
+/******************************************************************************
+ * Dirty-Rect Player
+ *****************************************************************************/
+
+/**
+ * @brief lv_image deleted (e.g. with its screen): forget the object
+ * @param e LV_EVENT_DELETE event, user data is the player
+ */
+static void anim_player_delete_cb(lv_event_t *e)
+{
+    MAIN_anim_player_t *player = (MAIN_anim_player_t *)lv_event_get_user_data(e);
+    player->image = NULL;
+}
+
+/**
+ * @brief Create a player: frame buffer, lv_image, frame 0 shown
+ * @param player Player state to fill in
+ * @param parent Parent LVGL object
+ * @param asset Animation asset
+ * @return true if created
+ */
+bool MAIN_anim_player_create(MAIN_anim_player_t *player, lv_obj_t *parent,
+                             const MAIN_anim_asset_t *asset)
+{
+    if (player == NULL || parent == NULL || asset == NULL || asset->frameCount == 0)
+    {
+        return false;
+    }
+
+    memset(player, 0, sizeof(MAIN_anim_player_t));
+
+    // Internal RAM renders fastest; the sprite is small enough to fit
+    uint32_t bytes = MAIN_animation_frame_bytes(asset);
+    player->pixels = (uint8_t *)heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (player->pixels == NULL)
+    {
+        player->pixels = (uint8_t *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+    if (player->pixels == NULL)
+    {
+        Serial.printf("[ANIM] ERROR: No memory for %lu byte frame buffer\n", (unsigned long)bytes);
+        return false;
+    }
+
+    player->asset = asset;
+    if (!MAIN_animation_decode_frame(asset, 0, player->pixels, asset->width * ANIM_BYTES_PER_PIXEL))
+    {
+        heap_caps_free(player->pixels);
+        player->pixels = NULL;
+        return false;
+    }
+
+    player->dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    player->dsc.header.cf = LV_COLOR_FORMAT_RGB565;
+    player->dsc.header.flags = LV_IMAGE_FLAGS_MODIFIABLE;
+    player->dsc.header.w = asset->width;
+    player->dsc.header.h = asset->height;
+    player->dsc.header.stride = asset->width * ANIM_BYTES_PER_PIXEL;
+    player->dsc.data_size = bytes;
+    player->dsc.data = player->pixels;
+
+    player->image = lv_image_create(parent);
+    lv_image_set_src(player->image, &player->dsc);
+    lv_obj_add_event_cb(player->image, anim_player_delete_cb, LV_EVENT_DELETE, player);
+    player->frame = 0;
+
+    return true;
+}
+
+/**
+ * @brief Show the next frame (loops), invalidating only its dirty box
+ * @param player Player state
+ * @return true if the frame advanced
+ */
+bool MAIN_anim_player_step(MAIN_anim_player_t *player)
+{
+    if (player == NULL || player->image == NULL || player->asset->frameCount < 2)
+    {
+        return false;
+    }
+
+    const MAIN_anim_asset_t *asset = player->asset;
+    uint16_t next = (player->frame + 1) % asset->frameCount;
+
+    // Delta frames patch the buffer in place; frame 0 is a key frame
+    if (!MAIN_animation_decode_frame(asset, next, player->pixels, player->dsc.header.stride))
+    {
+        return false;
+    }
+    player->frame = next;
+
+    const MAIN_anim_rect_t &dirty = asset->frames[next].dirty;
+    if (dirty.w == 0)
+    {
+        return true;
+    }
+
+    lv_image_cache_drop(&player->dsc);
+
+    // Dirty box is in frame pixels; the lv_image is frame sized at its origin
+    lv_area_t coords;
+    lv_obj_get_coords(player->image, &coords);
+
+    lv_area_t area;
+    area.x1 = coords.x1 + dirty.x;
+    area.y1 = coords.y1 + dirty.y;
+    area.x2 = area.x1 + dirty.w - 1;
+    area.y2 = area.y1 + dirty.h - 1;
+    lv_obj_invalidate_area(player->image, &area);
+
+    return true;
+}
+
+/**
+ * @brief Delete the player's lv_image and free its frame buffer
+ * @param player Player state
+ */
+void MAIN_anim_player_destroy(MAIN_anim_player_t *player)
+{
+    if (player == NULL)
+    {
+        return;
+    }
+
+    // The delete event clears player->image
+    if (player->image != NULL)
+    {
+        lv_obj_delete(player->image);
+    }
+
+    if (player->pixels != NULL)
+    {
+        lv_image_cache_drop(&player->dsc);
+        heap_caps_free(player->pixels);
+        player->pixels = NULL;
+    }
+
+    player->asset = NULL;
+}
+
+/******************************************************************************
+ * Startup Animation
+ *****************************************************************************/
+
+/**
+ * @brief Startup animation timer (LVGL task): next frame or finish
+ * @param timer The animation timer
+ */
+static void anim_startup_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+
+    if (ANIM_STARTUP_DURATION_MS > 0 &&
+        lv_tick_elaps(anim_startup_started_ms) >= ANIM_STARTUP_DURATION_MS)
+    {
+        MAIN_destroy_startup_animation();
+        return;
+    }
+
+    MAIN_anim_player_step(&anim_startup_player);
+}
+
+/**
+ * @brief Create the startup animation on the active screen and start it
+ * @return lv_obj_t* The animation image, or NULL if it could not be created
+ */
+lv_obj_t *MAIN_create_startup_animation(void)
+{
+    if (anim_startup_timer != NULL)
+    {
+        return anim_startup_player.image;
+    }
+
+    const MAIN_anim_asset_t *asset = MAIN_animation_find_asset(ANIM_STARTUP_ASSET);
+    if (asset == NULL)
+    {
+        Serial.println("[ANIM] ERROR: Startup asset '" ANIM_STARTUP_ASSET "' not built in");
+        return NULL;
+    }
+
+    if (!MAIN_anim_player_create(&anim_startup_player, lv_screen_active(), asset))
+    {
+        return NULL;
+    }
+    lv_obj_center(anim_startup_player.image);
+
+    anim_startup_timer = lv_timer_create(anim_startup_timer_cb, 1000 / anim_startup_fps, NULL);
+    if (anim_startup_timer == NULL)
+    {
+        MAIN_anim_player_destroy(&anim_startup_player);
+        return NULL;
+    }
+    anim_startup_started_ms = lv_tick_get();
+
+#if EARS_DEBUG == 1
+    Serial.printf("[ANIM] Startup animation '%s': %u frames at %u fps\n",
+                  asset->name, asset->frameCount, anim_startup_fps);
+#endif
+
+    return anim_startup_player.image;
+}
+
+/**
+ * @brief Stop and delete the startup animation early
+ */
+void MAIN_destroy_startup_animation(void)
+{
+    if (anim_startup_timer == NULL)
+    {
+        return;
+    }
+
+    // Safe from inside the timer's own callback
+    lv_timer_delete(anim_startup_timer);
+    anim_startup_timer = NULL;
+
+    MAIN_anim_player_destroy(&anim_startup_player);
+
+#if EARS_DEBUG == 1
+    Serial.println("[ANIM] Startup animation finished");
+#endif
+}
+
+/**
+ * @brief Check if the startup animation is still on screen
+ * @return true between create and destroy
+ */
+bool MAIN_startup_animation_is_running(void)
+{
+    return (anim_startup_timer != NULL);
+}
+
+/**
+ * @brief Change the startup animation frame rate
+ * @param fps Frames per second (clamped to 1..50)
+ */
+void MAIN_animation_set_startup_fps(uint8_t fps)
+{
+    if (fps < 1)
+    {
+        fps = 1;
+    }
+    else if (fps > 50)
+    {
+        fps = 50;
+    }
+
+    anim_startup_fps = fps;
+
+    if (anim_startup_timer != NULL)
+    {
+        lv_timer_set_period(anim_startup_timer, 1000 / fps);
+    }
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Animation_getLibraryName() {
+    return MAIN_Animation::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Animation_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Animation::VERSION_MAJOR,
+                       MAIN_Animation::VERSION_MINOR,
+                       MAIN_Animation::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Animation_getVersionDate() {
+    return MAIN_Animation::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Animation_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Animation_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_animationLib.cpp
+ ******************************************************************************/
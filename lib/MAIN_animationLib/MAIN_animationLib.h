@@ -0,0 +1,228 @@
+/**
+ * @file MAIN_animationLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Compressed animation assets for EARS (startup marching soldier)
+ * @details Frames are compressed at build time by
+ *          scripts/generate_anim_assets.py from the LVGL image converter
+ *          files in assets/animation/<name>/ and decoded row by row into an
+ *          RGB565 buffer (such as an LVGL draw buffer) at run time.
+ *
+ *          Encoded frame format, one opcode stream per row (opcodes never
+ *          cross a row), n = (opcode & 0x3F) + 1:
+ *          - 00nnnnnn: literal, n pixels follow (2 bytes each, RGB565 LE)
+ *          - 01nnnnnn: run, one pixel follows, repeated n times
+ *          - 10nnnnnn: skip n pixels (unchanged from the previous frame)
+ *          - 11nnnnnn: reserved
+ *          Frame 0 is always a key frame. Others are delta frames (skip
+ *          allowed) when that is smaller; they need the previous frame in
+ *          the destination, so play them in order.
+ *
+ *          The player shows the decoded buffer through an lv_image and, on
+ *          each step, invalidates only the frame's dirty box (precomputed
+ *          at build time against the frame before it), so LVGL redraws and
+ *          flushes just the changed part of the sprite.
+ *
+ *          The startup animation is paced by its own lv_timer and removes
+ *          itself once ANIM_STARTUP_DURATION_MS has passed, so no animation
+ *          work is left in the UI task after boot.
+ * @version 1.2.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_ANIMATION_LIB_H__
+#define __MAIN_ANIMATION_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include <lvgl.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Animation
+{
+    constexpr const char* LIB_NAME = "MAIN_Animation";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "2";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-14";
+}
+
+
+// Version information getters
+const char* MAIN_Animation_getLibraryName();
+uint32_t MAIN_Animation_getVersionEncoded();
+const char* MAIN_Animation_getVersionDate();
+void MAIN_Animation_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Encoded Frame Format
+ *****************************************************************************/
+
+#define ANIM_OP_MASK 0xC0
+#define ANIM_OP_LITERAL 0x00
+#define ANIM_OP_RUN 0x40
+#define ANIM_OP_SKIP 0x80
+#define ANIM_OP_COUNT(op) (((op) & 0x3F) + 1)
+
+// Bytes per decoded pixel (RGB565)
+#define ANIM_BYTES_PER_PIXEL 2
+
+/******************************************************************************
+ * Startup Animation Configuration
+ *****************************************************************************/
+
+// Asset played at boot (directory name under assets/animation)
+#define ANIM_STARTUP_ASSET "soldier"
+
+// Frame rate of the startup animation
+#define ANIM_STARTUP_FPS 8
+
+// Time before the startup animation deletes itself (0 = until destroyed)
+#define ANIM_STARTUP_DURATION_MS 4000
+
+/**
+ * @struct MAIN_anim_rect_t
+ * @brief Region of a frame in frame pixels (w = 0: nothing changed)
+ */
+typedef struct
+{
+    uint16_t x;
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+} MAIN_anim_rect_t;
+
+/**
+ * @struct MAIN_anim_frame_t
+ * @brief One encoded frame
+ */
+typedef struct
+{
+    const uint8_t *data;    // Opcode stream, rows in order
+    uint32_t size;          // Encoded bytes
+    uint8_t isDelta;        // 1 = needs the previous frame in the destination
+    MAIN_anim_rect_t dirty; // Pixels that differ from the frame shown before
+} MAIN_anim_frame_t;
+
+/**
+ * @struct MAIN_anim_asset_t
+ * @brief One animation (generated table entry)
+ */
+typedef struct
+{
+    const char *name;                // Directory name under assets/animation
+    uint16_t width;                  // Frame width in pixels
+    uint16_t height;                 // Frame height in pixels
+    uint16_t frameCount;             // Number of frames
+    const MAIN_anim_frame_t *frames; // Encoded frames
+} MAIN_anim_asset_t;
+
+/**
+ * @struct MAIN_anim_player_t
+ * @brief Dirty-rect player state (one per playing animation)
+ */
+typedef struct
+{
+    const MAIN_anim_asset_t *asset; // Animation being played
+    lv_obj_t *image;                // lv_image showing the frame buffer
+    lv_image_dsc_t dsc;             // Descriptor over pixels
+    uint8_t *pixels;                // Decoded frame (RGB565)
+    uint16_t frame;                 // Frame currently shown
+} MAIN_anim_player_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Find a generated animation by name
+ * @param name Directory name under assets/animation (e.g. "soldier")
+ * @return const MAIN_anim_asset_t* Asset, or NULL if not built in
+ */
+const MAIN_anim_asset_t *MAIN_animation_find_asset(const char *name);
+
+/**
+ * @brief Decode a frame into an RGB565 buffer, one row at a time
+ * @param asset Animation asset
+ * @param index Frame index
+ * @param dest First pixel of the destination (e.g. LVGL draw buffer data)
+ * @param stride Bytes from one destination row to the next
+ * @return true if the frame decoded cleanly, false on bad index or data
+ * @note Delta frames only touch changed pixels: dest must hold frame
+ *       index - 1.
+ */
+bool MAIN_animation_decode_frame(const MAIN_anim_asset_t *asset, uint16_t index,
+                                 uint8_t *dest, uint32_t stride);
+
+/**
+ * @brief Bytes needed for one decoded frame with a packed stride
+ * @param asset Animation asset
+ * @return uint32_t width * height * 2
+ */
+uint32_t MAIN_animation_frame_bytes(const MAIN_anim_asset_t *asset);
+
+/**
+ * @brief Create a player: frame buffer, lv_image, frame 0 shown
+ * @param player Player state to fill in
+ * @param parent Parent LVGL object
+ * @param asset Animation asset
+ * @return true if created, false if out of memory or frame 0 is bad
+ * @note Call from the LVGL task.
+ */
+bool MAIN_anim_player_create(MAIN_anim_player_t *player, lv_obj_t *parent,
+                             const MAIN_anim_asset_t *asset);
+
+/**
+ * @brief Show the next frame (loops), invalidating only its dirty box
+ * @param player Player state
+ * @return true if the frame advanced
+ * @note Call from the LVGL task.
+ */
+bool MAIN_anim_player_step(MAIN_anim_player_t *player);
+
+/**
+ * @brief Delete the player's lv_image and free its frame buffer
+ * @param player Player state
+ * @note Call from the LVGL task. If the image was already deleted with
+ *       its parent only the frame buffer is freed.
+ */
+void MAIN_anim_player_destroy(MAIN_anim_player_t *player);
+
+/**
+ * @brief Create the startup animation on the active screen and start it
+ * @return lv_obj_t* The animation image, or NULL if it could not be created
+ * @note Call from setup() before the UI task starts, or from the LVGL task.
+ */
+lv_obj_t *MAIN_create_startup_animation(void);
+
+/**
+ * @brief Stop and delete the startup animation early
+ * @note Call from the LVGL task. Harmless if it has already finished.
+ */
+void MAIN_destroy_startup_animation(void);
+
+/**
+ * @brief Check if the startup animation is still on screen
+ * @return true between create and destroy
+ */
+bool MAIN_startup_animation_is_running(void);
+
+/**
+ * @brief Change the startup animation frame rate
+ * @param fps Frames per second (clamped to 1..50)
+ * @note Takes effect immediately if the animation is running.
+ */
+void MAIN_animation_set_startup_fps(uint8_t fps);
+
+#endif // __MAIN_ANIMATION_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_animationLib.h
+ ******************************************************************************/
@@ -0,0 +1,300 @@
+/**
+ * @file MAIN_assetPackLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Images and fonts from the memory-mapped "assets" flash partition
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_assetPackLib.h"
+#include "EARS_systemDef.h"
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t count;
+    uint32_t totalSize;
+    uint32_t crc32; // Of everything after the header
+    uint8_t reserved[8];
+} asset_pack_header_t;
+
+typedef struct
+{
+    char name[ASSET_PACK_NAME_LEN];
+    uint8_t type;
+    uint8_t pad[3];
+    uint32_t offset;
+    uint32_t size;
+} asset_pack_entry_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static const uint8_t *asset_pack_base = NULL;
+static const asset_pack_entry_t *asset_pack_entries = NULL;
+static uint16_t asset_pack_count = 0;
+static spi_flash_mmap_handle_t asset_pack_handle;
+
+static lv_image_dsc_t asset_pack_images[ASSET_PACK_MAX_IMAGES];
+static const asset_pack_entry_t *asset_pack_image_entries[ASSET_PACK_MAX_IMAGES];
+static uint8_t asset_pack_image_count = 0;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Find an entry by name
+ * @param name Entry name
+ * @return const asset_pack_entry_t* Entry, or NULL
+ */
+static const asset_pack_entry_t *asset_pack_find_entry(const char *name)
+{
+    if (asset_pack_base == NULL || name == NULL)
+    {
+        return NULL;
+    }
+
+    for (uint16_t i = 0; i < asset_pack_count; i++)
+    {
+        if (strncmp(asset_pack_entries[i].name, name, ASSET_PACK_NAME_LEN) == 0)
+        {
+            return &asset_pack_entries[i];
+        }
+    }
+
+    return NULL;
+}
+
+/******************************************************************************
+ * Asset Pack
+ *****************************************************************************/
+
+/**
+ * @brief Map the asset partition and validate the pack
+ * @return uint16_t Entries in the pack
+ */
+uint16_t MAIN_initialise_asset_pack(void)
+{
+    if (asset_pack_base != NULL)
+    {
+        return asset_pack_count;
+    }
+
+    const esp_partition_t *partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)ASSET_PACK_PARTITION_SUBTYPE,
+        ASSET_PACK_PARTITION_LABEL);
+    if (partition == NULL)
+    {
+#if EARS_DEBUG == 1
+        Serial.println("[ASSETPACK] No " ASSET_PACK_PARTITION_LABEL " partition");
+#endif
+        return 0;
+    }
+
+    // Check the header before mapping so an erased partition costs nothing
+    asset_pack_header_t header;
+    if (esp_partition_read(partition, 0, &header, sizeof(header)) != ESP_OK ||
+        memcmp(header.magic, ASSET_PACK_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != ASSET_PACK_VERSION)
+    {
+#if EARS_DEBUG == 1
+        Serial.println("[ASSETPACK] Partition holds no asset pack (run scripts/build_asset_pack.py --flash)");
+#endif
+        return 0;
+    }
+
+    uint32_t tableEnd = sizeof(asset_pack_header_t) + header.count * sizeof(asset_pack_entry_t);
+    if (header.totalSize > partition->size || tableEnd > header.totalSize)
+    {
+        Serial.println("[ASSETPACK] ERROR: Pack larger than partition");
+        return 0;
+    }
+
+    const void *mapped = NULL;
+    if (esp_partition_mmap(partition, 0, header.totalSize, SPI_FLASH_MMAP_DATA,
+                           &mapped, &asset_pack_handle) != ESP_OK)
+    {
+        Serial.println("[ASSETPACK] ERROR: esp_partition_mmap failed");
+        return 0;
+    }
+
+    const uint8_t *base = (const uint8_t *)mapped;
+
+#if ASSET_PACK_VERIFY_CRC == 1
+    uint32_t crc = esp_rom_crc32_le(0, base + sizeof(asset_pack_header_t),
+                                    header.totalSize - sizeof(asset_pack_header_t));
+    if (crc != header.crc32)
+    {
+        Serial.println("[ASSETPACK] ERROR: Pack CRC mismatch");
+        spi_flash_munmap(asset_pack_handle);
+        return 0;
+    }
+#endif
+
+    const asset_pack_entry_t *entries = (const asset_pack_entry_t *)(base + sizeof(asset_pack_header_t));
+    for (uint32_t i = 0; i < header.count; i++)
+    {
+        if (entries[i].offset < tableEnd || entries[i].size > header.totalSize - entries[i].offset)
+        {
+            Serial.printf("[ASSETPACK] ERROR: Entry %lu out of bounds\n", (unsigned long)i);
+            spi_flash_munmap(asset_pack_handle);
+            return 0;
+        }
+    }
+
+    asset_pack_base = base;
+    asset_pack_entries = entries;
+    asset_pack_count = (uint16_t)header.count;
+    asset_pack_image_count = 0;
+
+#if EARS_DEBUG == 1
+    Serial.printf("[ASSETPACK] %u assets, %lu KB mapped from flash at 0x%06lx\n", asset_pack_count,
+                  (unsigned long)(header.totalSize / 1024), (unsigned long)partition->address);
+#endif
+
+    return asset_pack_count;
+}
+
+/**
+ * @brief Raw access to an entry
+ * @param name Entry name
+ * @param size Receives the entry size (may be NULL)
+ * @return const uint8_t* Entry data in mapped flash, or NULL
+ */
+const uint8_t *MAIN_asset_pack_find(const char *name, uint32_t *size)
+{
+    const asset_pack_entry_t *entry = asset_pack_find_entry(name);
+    if (entry == NULL)
+    {
+        return NULL;
+    }
+
+    if (size != NULL)
+    {
+        *size = entry->size;
+    }
+    return asset_pack_base + entry->offset;
+}
+
+/**
+ * @brief Image descriptor over an image entry
+ * @param name Entry name
+ * @return const lv_image_dsc_t* Descriptor, or NULL
+ */
+const lv_image_dsc_t *MAIN_asset_pack_image(const char *name)
+{
+    const asset_pack_entry_t *entry = asset_pack_find_entry(name);
+    if (entry == NULL || entry->type != ASSET_TYPE_IMAGE)
+    {
+        return NULL;
+    }
+
+    // Same descriptor every time, so LVGL's cache sees one source
+    for (uint8_t i = 0; i < asset_pack_image_count; i++)
+    {
+        if (asset_pack_image_entries[i] == entry)
+        {
+            return &asset_pack_images[i];
+        }
+    }
+
+    if (asset_pack_image_count >= ASSET_PACK_MAX_IMAGES)
+    {
+        Serial.println("[ASSETPACK] ERROR: Image descriptor table full");
+        return NULL;
+    }
+
+    const uint8_t *data = asset_pack_base + entry->offset;
+    lv_image_header_t header;
+    memcpy(&header, data, sizeof(header));
+    if (entry->size <= sizeof(lv_image_header_t) || header.magic != LV_IMAGE_HEADER_MAGIC)
+    {
+        Serial.printf("[ASSETPACK] ERROR: %s is not an LVGL image\n", name);
+        return NULL;
+    }
+
+    lv_image_dsc_t *dsc = &asset_pack_images[asset_pack_image_count];
+    memset(dsc, 0, sizeof(lv_image_dsc_t));
+    dsc->header = header;
+    dsc->data_size = entry->size - sizeof(lv_image_header_t);
+    dsc->data = data + sizeof(lv_image_header_t);
+
+    asset_pack_image_entries[asset_pack_image_count++] = entry;
+    return dsc;
+}
+
+/**
+ * @brief Load a font entry
+ * @param name Entry name
+ * @return lv_font_t* Font, or NULL
+ */
+lv_font_t *MAIN_asset_pack_font(const char *name)
+{
+    const asset_pack_entry_t *entry = asset_pack_find_entry(name);
+    if (entry == NULL || entry->type != ASSET_TYPE_FONT)
+    {
+        return NULL;
+    }
+
+    lv_font_t *font = lv_binfont_create_from_buffer((void *)(asset_pack_base + entry->offset), entry->size);
+    if (font == NULL)
+    {
+        Serial.printf("[ASSETPACK] ERROR: Font %s failed to load\n", name);
+    }
+    return font;
+}
+
+/**
+ * @brief Check if a valid pack is mapped
+ * @return true after a successful MAIN_initialise_asset_pack()
+ */
+bool MAIN_asset_pack_is_available(void)
+{
+    return asset_pack_base != NULL;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_AssetPack_getLibraryName() {
+    return MAIN_AssetPack::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_AssetPack_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_AssetPack::VERSION_MAJOR,
+                       MAIN_AssetPack::VERSION_MINOR,
+                       MAIN_AssetPack::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_AssetPack_getVersionDate() {
+    return MAIN_AssetPack::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_AssetPack_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_AssetPack_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_assetPackLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,129 @@
+/**
+ * @file MAIN_assetPackLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Images and fonts from the memory-mapped "assets" flash partition
+ * @details scripts/build_asset_pack.py packs the LVGL .bin images and binary
+ *          fonts into one image written to the "assets" partition
+ *          (partitions_ears.csv). At boot the partition is mapped into the
+ *          data address space with esp_partition_mmap(), so an image's pixels
+ *          are read straight from flash through the cache: no SD access, no
+ *          copy into RAM, and the app binary stays small.
+ *
+ *          Pack layout (little endian, shared with build_asset_pack.py):
+ *            header  32 bytes  magic "EARSPAK1", version, count, totalSize, crc32
+ *            entries 36 bytes  name[24], type, pad[3], offset, size
+ *            data    each entry 16-byte aligned, offset from pack start
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_ASSET_PACK_LIB_H__
+#define __MAIN_ASSET_PACK_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include <lvgl.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_AssetPack
+{
+    constexpr const char* LIB_NAME = "MAIN_AssetPack";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-14";
+}
+
+
+// Version information getters
+const char* MAIN_AssetPack_getLibraryName();
+uint32_t MAIN_AssetPack_getVersionEncoded();
+const char* MAIN_AssetPack_getVersionDate();
+void MAIN_AssetPack_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Asset Pack Configuration
+ *****************************************************************************/
+
+// Partition (partitions_ears.csv: type data, subtype 0x40)
+#define ASSET_PACK_PARTITION_LABEL "assets"
+#define ASSET_PACK_PARTITION_SUBTYPE 0x40
+
+// Pack format
+#define ASSET_PACK_MAGIC "EARSPAK1"
+#define ASSET_PACK_VERSION 1
+#define ASSET_PACK_NAME_LEN 24
+
+// Image descriptors handed out (one per distinct image asked for)
+#define ASSET_PACK_MAX_IMAGES 32
+
+// CRC of the whole pack at boot (~20 ms per MB, off by default)
+#define ASSET_PACK_VERIFY_CRC 0
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef enum
+{
+    ASSET_TYPE_RAW = 0,
+    ASSET_TYPE_IMAGE = 1, // LVGL .bin image (lv_image_header_t + data)
+    ASSET_TYPE_FONT = 2   // lv_binfont file
+} MAIN_asset_type_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Map the asset partition and validate the pack
+ * @return uint16_t Entries in the pack (0 if no partition or no valid pack)
+ * @note Call after MAIN_initialise_lvgl().
+ */
+uint16_t MAIN_initialise_asset_pack(void);
+
+/**
+ * @brief Raw access to an entry
+ * @param name Entry name (file name without .bin)
+ * @param size Receives the entry size (may be NULL)
+ * @return const uint8_t* Entry data in mapped flash, or NULL if unknown
+ */
+const uint8_t *MAIN_asset_pack_find(const char *name, uint32_t *size);
+
+/**
+ * @brief Image descriptor over an image entry, for lv_image_set_src()
+ * @param name Entry name
+ * @return const lv_image_dsc_t* Descriptor with data in mapped flash, or NULL
+ * @note Uncompressed images are drawn from flash with no copy. RLE images are
+ *       expanded once by LVGL's bin decoder into the image cache.
+ */
+const lv_image_dsc_t *MAIN_asset_pack_image(const char *name);
+
+/**
+ * @brief Load a font entry
+ * @param name Entry name
+ * @return lv_font_t* Font, or NULL; free with lv_binfont_destroy()
+ * @note lv_binfont reads through the memory file system, so the glyph data is
+ *       copied into the LVGL heap. Keep packed fonts small.
+ */
+lv_font_t *MAIN_asset_pack_font(const char *name);
+
+/**
+ * @brief Check if a valid pack is mapped
+ * @return true after a successful MAIN_initialise_asset_pack()
+ */
+bool MAIN_asset_pack_is_available(void);
+
+#endif // __MAIN_ASSET_PACK_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_assetPackLib.h
+ ******************************************************************************/
@@ -0,0 +1,776 @@
+/**
+ * @file MAIN_benchmarkLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief On-target micro-benchmarks for the display, SD, NVS and touch paths
+ * @version 1.3.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_benchmarkLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_rgb565ColoursDef.h"
+#include "EARS_nvsEepromLib.h"
+#include "EARS_sdCardLib.h"
+#include "EARS_sdCryptLib.h"
+#include "EARS_touchLib.h"
+#include "MAIN_drawingLib.h"
+#include "MAIN_lvglLib.h"
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <lvgl.h>
+#if LV_USE_DEMO_BENCHMARK
+#include "demos/lv_demos.h"
+#endif
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static MAIN_bench_result_t bench_results[BENCH_MAX_RESULTS];
+static uint8_t bench_result_count = 0;
+
+static const uint16_t bench_shape_colours[] = {
+    EARS_RGB565_RED, EARS_RGB565_GREEN, EARS_RGB565_BLUE, EARS_RGB565_WHITE,
+};
+
+#define BENCH_SHAPE_COLOUR_COUNT (sizeof(bench_shape_colours) / sizeof(bench_shape_colours[0]))
+
+static volatile bool bench_demo_done = false;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Keep a result
+ * @param name Test name (string literal)
+ * @param iterations Operations timed
+ * @param totalUs Time for all of them
+ * @param maxUs Slowest single operation, 0 if not timed per operation
+ * @param rate Throughput
+ * @param unit Throughput unit (string literal)
+ */
+static void bench_record(const char *name, uint32_t iterations, int64_t totalUs, uint32_t maxUs,
+                         float rate, const char *unit)
+{
+    if (bench_result_count >= BENCH_MAX_RESULTS)
+        return;
+
+    MAIN_bench_result_t *result = &bench_results[bench_result_count++];
+    result->name = name;
+    result->iterations = iterations;
+    result->totalUs = (uint32_t)totalUs;
+    result->maxUs = maxUs;
+    result->rate = rate;
+    result->unit = unit;
+}
+
+/**
+ * @brief Bytes over a time as MB/s
+ */
+static float bench_mb_per_s(uint64_t bytes, int64_t us)
+{
+    return (us > 0) ? (float)((double)bytes * 1000000.0 / (double)us / (1024.0 * 1024.0)) : 0.0f;
+}
+
+/**
+ * @brief Operations over a time as a rate per second
+ */
+static float bench_per_s(uint32_t ops, int64_t us)
+{
+    return (us > 0) ? (float)((double)ops * 1000000.0 / (double)us) : 0.0f;
+}
+
+/**
+ * @brief Fixed LCG, so random offsets repeat run to run
+ */
+static uint32_t bench_next_random(uint32_t *state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return *state;
+}
+
+static void bench_track_max(uint32_t *maxUs, int64_t us)
+{
+    if ((uint32_t)us > *maxUs)
+        *maxUs = (uint32_t)us;
+}
+
+/******************************************************************************
+ * Display
+ *****************************************************************************/
+
+/**
+ * @brief Full frames pushed band by band, as the LVGL flush does
+ */
+static void bench_display_flush(Arduino_GFX *gfx)
+{
+    const int16_t w = gfx->width();
+    const int16_t h = gfx->height();
+    const size_t bandPixels = (size_t)w * BENCH_FLUSH_BAND_LINES;
+
+    uint16_t *band = (uint16_t *)heap_caps_malloc(bandPixels * sizeof(uint16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    if (band == NULL)
+    {
+        Serial.println("[BENCH] flush: no DMA buffer, skipped");
+        return;
+    }
+
+    int64_t totalUs = 0;
+    uint32_t maxUs = 0;
+    for (uint16_t frame = 0; frame < BENCH_FLUSH_FRAMES; frame++)
+    {
+        // A new pattern per frame, filled outside the timed push
+        uint16_t colour = (uint16_t)(frame * 0x0841u);
+        for (size_t i = 0; i < bandPixels; i++)
+            band[i] = colour ^ (uint16_t)i;
+
+        int64_t start = esp_timer_get_time();
+        for (int16_t y = 0; y < h; y += BENCH_FLUSH_BAND_LINES)
+        {
+            int16_t lines = (h - y < BENCH_FLUSH_BAND_LINES) ? (h - y) : BENCH_FLUSH_BAND_LINES;
+            gfx->draw16bitRGBBitmap(0, y, band, w, lines);
+        }
+        int64_t us = esp_timer_get_time() - start;
+        totalUs += us;
+        bench_track_max(&maxUs, us);
+    }
+    heap_caps_free(band);
+
+    uint64_t bytes = (uint64_t)w * h * sizeof(uint16_t) * BENCH_FLUSH_FRAMES;
+    bench_record("flush_fps", BENCH_FLUSH_FRAMES, totalUs, maxUs, bench_per_s(BENCH_FLUSH_FRAMES, totalUs), "fps");
+    bench_record("flush_mbps", BENCH_FLUSH_FRAMES, totalUs, maxUs, bench_mb_per_s(bytes, totalUs), "MB/s");
+}
+
+/**
+ * @brief Time a shape drawn BENCH_DRAW_SHAPE_OPS times at rotating positions
+ * @param shape 0 = filled rect, 1 = outline, 2 = rounded rect, 3 = cached button
+ */
+static void bench_drawing_shape(Arduino_GFX *gfx, const char *name, uint8_t shape)
+{
+    const int16_t spanX = gfx->width() - BENCH_DRAW_SHAPE_W;
+    const int16_t spanY = gfx->height() - BENCH_DRAW_SHAPE_H;
+    uint32_t seed = 1;
+
+    int64_t start = esp_timer_get_time();
+    for (uint16_t i = 0; i < BENCH_DRAW_SHAPE_OPS; i++)
+    {
+        int16_t x = (int16_t)(bench_next_random(&seed) % spanX);
+        int16_t y = (int16_t)(bench_next_random(&seed) % spanY);
+        uint16_t colour = bench_shape_colours[i % BENCH_SHAPE_COLOUR_COUNT];
+
+        if (shape == 0)
+            MAIN_draw_filled_rect(gfx, x, y, BENCH_DRAW_SHAPE_W, BENCH_DRAW_SHAPE_H, colour);
+        else if (shape == 1)
+            MAIN_draw_rect_outline(gfx, x, y, BENCH_DRAW_SHAPE_W, BENCH_DRAW_SHAPE_H, colour);
+        else if (shape == 2)
+            MAIN_draw_rounded_rect(gfx, x, y, BENCH_DRAW_SHAPE_W, BENCH_DRAW_SHAPE_H, BENCH_DRAW_SHAPE_RADIUS, colour);
+        else
+            MAIN_draw_button_cached(gfx, x, y, BENCH_DRAW_SHAPE_W, BENCH_DRAW_SHAPE_H, BENCH_DRAW_SHAPE_RADIUS,
+                                    colour, EARS_RGB565_WHITE);
+    }
+    int64_t totalUs = esp_timer_get_time() - start;
+
+    bench_record(name, BENCH_DRAW_SHAPE_OPS, totalUs, 0, bench_per_s(BENCH_DRAW_SHAPE_OPS, totalUs), "ops/s");
+}
+
+/**
+ * @brief Full-screen fills and shapes through MAIN_drawingLib
+ */
+static void bench_drawing(Arduino_GFX *gfx)
+{
+    uint32_t maxUs = 0;
+    int64_t totalUs = 0;
+    for (uint16_t frame = 0; frame < BENCH_DRAW_FILL_FRAMES; frame++)
+    {
+        int64_t start = esp_timer_get_time();
+        MAIN_clear_screen(gfx, bench_shape_colours[frame % BENCH_SHAPE_COLOUR_COUNT]);
+        int64_t us = esp_timer_get_time() - start;
+        totalUs += us;
+        bench_track_max(&maxUs, us);
+    }
+
+    uint64_t pixels = (uint64_t)gfx->width() * gfx->height() * BENCH_DRAW_FILL_FRAMES;
+    bench_record("fill_screen", BENCH_DRAW_FILL_FRAMES, totalUs, maxUs,
+                 (float)((double)pixels / (double)(totalUs > 0 ? totalUs : 1)), "Mpx/s");
+
+    bench_drawing_shape(gfx, "fill_rect", 0);
+    bench_drawing_shape(gfx, "rect_outline", 1);
+    bench_drawing_shape(gfx, "rounded_rect", 2);
+    bench_drawing_shape(gfx, "button_cached", 3);
+    MAIN_draw_sprite_cache_clear();
+
+    MAIN_clear_screen(gfx, EARS_RGB565_BLACK);
+}
+
+/******************************************************************************
+ * SD Card
+ *****************************************************************************/
+
+/**
+ * @brief Sequential write and read of BENCH_SD_BYTES, then random transfers
+ */
+static void bench_sd(void)
+{
+    EARS_sdCard &sd = using_sdcard();
+    if (!sd.isAvailable())
+    {
+        Serial.println("[BENCH] sd: no card, skipped");
+        return;
+    }
+
+    // Internal RAM so the SDMMC driver does not have to bounce the data
+    uint8_t *buffer = (uint8_t *)heap_caps_malloc(BENCH_SD_CHUNK, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    if (buffer == NULL)
+    {
+        Serial.println("[BENCH] sd: no DMA buffer, skipped");
+        return;
+    }
+    for (uint32_t i = 0; i < BENCH_SD_CHUNK; i++)
+        buffer[i] = (uint8_t)(i * 31u + 7u);
+
+    sd.createDirectory(BENCH_CSV_DIR);
+    sd.removeFile(BENCH_SD_PATH);
+
+    const uint32_t chunks = BENCH_SD_BYTES / BENCH_SD_CHUNK;
+    bool ok = true;
+    uint32_t maxUs = 0;
+
+    // Sequential write, flushed so the time includes reaching the card
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < chunks && ok; i++)
+    {
+        int64_t opStart = esp_timer_get_time();
+        ok = sd.appendData(BENCH_SD_PATH, buffer, BENCH_SD_CHUNK);
+        bench_track_max(&maxUs, esp_timer_get_time() - opStart);
+    }
+    sd.flush(BENCH_SD_PATH);
+    int64_t totalUs = esp_timer_get_time() - start;
+    if (ok)
+        bench_record("sd_seq_write", chunks, totalUs, maxUs, bench_mb_per_s(BENCH_SD_BYTES, totalUs), "MB/s");
+
+    // Sequential read
+    maxUs = 0;
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < chunks && ok; i++)
+    {
+        int64_t opStart = esp_timer_get_time();
+        ok = (sd.readDataAt(BENCH_SD_PATH, i * BENCH_SD_CHUNK, buffer, BENCH_SD_CHUNK) == BENCH_SD_CHUNK);
+        bench_track_max(&maxUs, esp_timer_get_time() - opStart);
+    }
+    totalUs = esp_timer_get_time() - start;
+    if (ok)
+        bench_record("sd_seq_read", chunks, totalUs, maxUs, bench_mb_per_s(BENCH_SD_BYTES, totalUs), "MB/s");
+
+    // Random reads at chunk-aligned offsets
+    uint32_t seed = 1;
+    maxUs = 0;
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_SD_RANDOM_OPS && ok; i++)
+    {
+        uint32_t offset = (bench_next_random(&seed) % chunks) * BENCH_SD_CHUNK;
+        int64_t opStart = esp_timer_get_time();
+        ok = (sd.readDataAt(BENCH_SD_PATH, offset, buffer, BENCH_SD_CHUNK) == BENCH_SD_CHUNK);
+        bench_track_max(&maxUs, esp_timer_get_time() - opStart);
+    }
+    totalUs = esp_timer_get_time() - start;
+    if (ok)
+        bench_record("sd_rand_read", BENCH_SD_RANDOM_OPS, totalUs, maxUs,
+                     bench_mb_per_s((uint64_t)BENCH_SD_RANDOM_OPS * BENCH_SD_CHUNK, totalUs), "MB/s");
+
+    // Random writes, flushed at the end
+    maxUs = 0;
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_SD_RANDOM_OPS && ok; i++)
+    {
+        uint32_t offset = (bench_next_random(&seed) % chunks) * BENCH_SD_CHUNK;
+        int64_t opStart = esp_timer_get_time();
+        ok = sd.writeDataAt(BENCH_SD_PATH, offset, buffer, BENCH_SD_CHUNK);
+        bench_track_max(&maxUs, esp_timer_get_time() - opStart);
+    }
+    sd.flush(BENCH_SD_PATH);
+    totalUs = esp_timer_get_time() - start;
+    if (ok)
+        bench_record("sd_rand_write", BENCH_SD_RANDOM_OPS, totalUs, maxUs,
+                     bench_mb_per_s((uint64_t)BENCH_SD_RANDOM_OPS * BENCH_SD_CHUNK, totalUs), "MB/s");
+
+    if (!ok)
+        Serial.println("[BENCH] sd: transfer failed, remaining SD tests skipped");
+
+    sd.removeFile(BENCH_SD_PATH);
+    heap_caps_free(buffer);
+}
+
+/**
+ * @brief AES-256-CTR alone, then sequential write and read through it
+ * @details The device secret is created in NVS if this unit has none yet.
+ */
+static void bench_sd_crypt(void)
+{
+    EARS_sdCard &sd = using_sdcard();
+    EARS_sdCrypt &crypt = using_sdcrypt();
+    if (!sd.isAvailable() || !crypt.begin(&using_nvseeprom()))
+    {
+        Serial.println("[BENCH] sd_crypt: no card or no keys, skipped");
+        return;
+    }
+
+    uint8_t *buffer = (uint8_t *)heap_caps_malloc(BENCH_SD_CHUNK, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    if (buffer == NULL)
+    {
+        Serial.println("[BENCH] sd_crypt: no DMA buffer, skipped");
+        return;
+    }
+    for (uint32_t i = 0; i < BENCH_SD_CHUNK; i++)
+        buffer[i] = (uint8_t)(i * 31u + 7u);
+
+    EARS_sdCryptFile file = {};
+    sd.removeFile(BENCH_SD_CRYPT_PATH);
+    sd.removeFile(BENCH_SD_CRYPT_PATH SDCRYPT_LOG_SUFFIX);
+    if (!crypt.openFile(sd, BENCH_SD_CRYPT_PATH, file))
+    {
+        Serial.println("[BENCH] sd_crypt: no epoch table, skipped");
+        heap_caps_free(buffer);
+        return;
+    }
+
+    const uint32_t chunks = BENCH_SD_BYTES / BENCH_SD_CHUNK;
+    bool ok = true;
+    uint32_t maxUs = 0;
+
+    // Peripheral only: nonce, keystream and XOR in place
+    const uint8_t iv[SDCRYPT_IV_BYTES] = {};
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < chunks && ok; i++)
+    {
+        int64_t opStart = esp_timer_get_time();
+        ok = crypt.unsealImage(BENCH_SD_CRYPT_PATH, iv, i * BENCH_SD_CHUNK, buffer, BENCH_SD_CHUNK);
+        bench_track_max(&maxUs, esp_timer_get_time() - opStart);
+    }
+    int64_t totalUs = esp_timer_get_time() - start;
+    if (ok)
+        bench_record("sd_aes_ctr", chunks, totalUs, maxUs, bench_mb_per_s(BENCH_SD_BYTES, totalUs), "MB/s");
+
+    // Sequential write, compare with sd_seq_write
+    maxUs = 0;
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < chunks && ok; i++)
+    {
+        int64_t opStart = esp_timer_get_time();
+        ok = crypt.appendData(sd, file, i * BENCH_SD_CHUNK, buffer, BENCH_SD_CHUNK);
+        bench_track_max(&maxUs, esp_timer_get_time() - opStart);
+    }
+    sd.flush(BENCH_SD_CRYPT_PATH);
+    totalUs = esp_timer_get_time() - start;
+    if (ok)
+        bench_record("sd_enc_write", chunks, totalUs, maxUs, bench_mb_per_s(BENCH_SD_BYTES, totalUs), "MB/s");
+
+    // Sequential read, compare with sd_seq_read
+    maxUs = 0;
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < chunks && ok; i++)
+    {
+        int64_t opStart = esp_timer_get_time();
+        ok = (crypt.readDataAt(sd, file, i * BENCH_SD_CHUNK, buffer, BENCH_SD_CHUNK) == BENCH_SD_CHUNK);
+        bench_track_max(&maxUs, esp_timer_get_time() - opStart);
+    }
+    totalUs = esp_timer_get_time() - start;
+    if (ok)
+        bench_record("sd_enc_read", chunks, totalUs, maxUs, bench_mb_per_s(BENCH_SD_BYTES, totalUs), "MB/s");
+
+    if (!ok)
+        Serial.println("[BENCH] sd_crypt: transfer failed, remaining tests skipped");
+
+    crypt.closeFile(file);
+    sd.removeFile(BENCH_SD_CRYPT_PATH);
+    sd.removeFile(BENCH_SD_CRYPT_PATH SDCRYPT_LOG_SUFFIX);
+    heap_caps_free(buffer);
+}
+
+/******************************************************************************
+ * NVS
+ *****************************************************************************/
+
+/**
+ * @brief Put and get latency of a scratch key (each opens the namespace)
+ */
+static void bench_nvs(void)
+{
+    EARS_nvsEeprom &nvs = using_nvseeprom();
+    uint32_t maxUs = 0;
+
+    int64_t start = esp_timer_get_time();
+    for (uint16_t i = 0; i < BENCH_NVS_OPS; i++)
+    {
+        int64_t opStart = esp_timer_get_time();
+        if (!nvs.putVersion(BENCH_NVS_KEY, i))
+        {
+            Serial.println("[BENCH] nvs: put failed, skipped");
+            return;
+        }
+        bench_track_max(&maxUs, esp_timer_get_time() - opStart);
+    }
+    int64_t totalUs = esp_timer_get_time() - start;
+    bench_record("nvs_put", BENCH_NVS_OPS, totalUs, maxUs, bench_per_s(BENCH_NVS_OPS, totalUs), "ops/s");
+
+    maxUs = 0;
+    uint32_t sum = 0;
+    start = esp_timer_get_time();
+    for (uint16_t i = 0; i < BENCH_NVS_OPS; i++)
+    {
+        int64_t opStart = esp_timer_get_time();
+        sum += nvs.getVersion(BENCH_NVS_KEY);
+        bench_track_max(&maxUs, esp_timer_get_time() - opStart);
+    }
+    totalUs = esp_timer_get_time() - start;
+    (void)sum;
+    bench_record("nvs_get", BENCH_NVS_OPS, totalUs, maxUs, bench_per_s(BENCH_NVS_OPS, totalUs), "ops/s");
+}
+
+/******************************************************************************
+ * Touch
+ *****************************************************************************/
+
+/**
+ * @brief Back-to-back reads of the first touch point over I2C
+ * @note The ceiling for the sampling task's rate; the I2C bus task serialises
+ *       the reads with the task, which only samples while the panel is pressed.
+ */
+static void bench_touch(void)
+{
+    EARS_touch &touch = using_touch();
+    if (!touch.isAvailable())
+    {
+        Serial.println("[BENCH] touch: no controller, skipped");
+        return;
+    }
+
+    int16_t x[2];
+    int16_t y[2];
+    uint32_t maxUs = 0;
+
+    int64_t start = esp_timer_get_time();
+    for (uint16_t i = 0; i < BENCH_TOUCH_READS; i++)
+    {
+        int64_t opStart = esp_timer_get_time();
+        touch.getPoint(x, y);
+        bench_track_max(&maxUs, esp_timer_get_time() - opStart);
+    }
+    int64_t totalUs = esp_timer_get_time() - start;
+    bench_record("touch_read", BENCH_TOUCH_READS, totalUs, maxUs, bench_per_s(BENCH_TOUCH_READS, totalUs), "Hz");
+}
+
+/******************************************************************************
+ * LVGL
+ *****************************************************************************/
+
+/**
+ * @brief Create, lay out and delete buttons with a label on a scratch screen
+ */
+static void bench_lvgl(void)
+{
+    lv_obj_t *screen = lv_obj_create(NULL);
+    if (screen == NULL)
+    {
+        Serial.println("[BENCH] lvgl: no screen, skipped");
+        return;
+    }
+    lv_obj_set_flex_flow(screen, LV_FLEX_FLOW_ROW_WRAP);
+
+    uint32_t maxUs = 0;
+    int64_t start = esp_timer_get_time();
+    for (uint16_t i = 0; i < BENCH_LVGL_WIDGETS; i++)
+    {
+        int64_t opStart = esp_timer_get_time();
+        lv_obj_t *button = lv_button_create(screen);
+        lv_obj_t *label = lv_label_create(button);
+        lv_label_set_text_fmt(label, "%u", i);
+        bench_track_max(&maxUs, esp_timer_get_time() - opStart);
+    }
+    int64_t totalUs = esp_timer_get_time() - start;
+    bench_record("lvgl_create", BENCH_LVGL_WIDGETS, totalUs, maxUs, bench_per_s(BENCH_LVGL_WIDGETS, totalUs), "widgets/s");
+
+    start = esp_timer_get_time();
+    lv_obj_update_layout(screen);
+    totalUs = esp_timer_get_time() - start;
+    bench_record("lvgl_layout", 1, totalUs, 0, bench_per_s(BENCH_LVGL_WIDGETS, totalUs), "widgets/s");
+
+    start = esp_timer_get_time();
+    lv_obj_delete(screen);
+    totalUs = esp_timer_get_time() - start;
+    bench_record("lvgl_delete", 1, totalUs, 0, bench_per_s(BENCH_LVGL_WIDGETS, totalUs), "widgets/s");
+}
+
+/******************************************************************************
+ * Results
+ *****************************************************************************/
+
+/**
+ * @brief Append this run's results to BENCH_CSV_PATH
+ * @return true if every row was written
+ */
+static bool bench_write_csv(void)
+{
+    EARS_sdCard &sd = using_sdcard();
+    if (!sd.isAvailable())
+        return false;
+
+    sd.createDirectory(BENCH_CSV_DIR);
+    if (!sd.fileExists(BENCH_CSV_PATH) &&
+        !sd.appendFile(BENCH_CSV_PATH, "build,version,test,iterations,total_us,per_op_us,max_us,rate,unit\n"))
+    {
+        return false;
+    }
+
+    char row[160];
+    bool ok = true;
+    for (uint8_t i = 0; i < bench_result_count && ok; i++)
+    {
+        const MAIN_bench_result_t *result = &bench_results[i];
+        snprintf(row, sizeof(row), "%llu,%s.%s.%s,%s,%lu,%lu,%.1f,%lu,%.3f,%s\n",
+                 (unsigned long long)EARS_APP_BUILD_TIMESTAMP,
+                 EARS_APP_VERSION_MAJOR, EARS_APP_VERSION_MINOR, EARS_APP_VERSION_PATCH,
+                 result->name, (unsigned long)result->iterations, (unsigned long)result->totalUs,
+                 result->iterations ? (double)result->totalUs / result->iterations : 0.0,
+                 (unsigned long)result->maxUs, (double)result->rate, result->unit);
+        ok = sd.appendFile(BENCH_CSV_PATH, row);
+    }
+    sd.flush(BENCH_CSV_PATH);
+    return ok;
+}
+
+/******************************************************************************
+ * Benchmarks
+ *****************************************************************************/
+
+/**
+ * @brief Run every benchmark, print the results and append them to the SD card
+ * @param gfx Pointer to Arduino_GFX object
+ * @param displayMutex Mutex guarding the display bus (may be NULL)
+ * @return true if the results were written to BENCH_CSV_PATH
+ */
+bool MAIN_benchmark_run(Arduino_GFX *gfx, SemaphoreHandle_t displayMutex)
+{
+    bench_result_count = 0;
+    Serial.println("\n[BENCH] ===== Micro-benchmarks =====");
+
+    if (gfx != NULL)
+    {
+        if (displayMutex != NULL)
+            xSemaphoreTake(displayMutex, portMAX_DELAY);
+        bench_display_flush(gfx);
+        bench_drawing(gfx);
+        if (displayMutex != NULL)
+            xSemaphoreGive(displayMutex);
+
+        // The panel no longer shows what LVGL last rendered
+        lv_obj_invalidate(lv_screen_active());
+    }
+
+    bench_sd();
+    bench_sd_crypt();
+    bench_nvs();
+    bench_touch();
+    bench_lvgl();
+
+    MAIN_benchmark_print_results();
+
+    bool written = bench_write_csv();
+    Serial.printf("[BENCH] %u results %s\n", bench_result_count,
+                  written ? "appended to " BENCH_CSV_PATH : "not saved (no SD card)");
+    Serial.println("[BENCH] ============================\n");
+    return written;
+}
+
+/**
+ * @brief Results of the last run
+ * @param count Receives the number of results
+ * @return const MAIN_bench_result_t* Results
+ */
+const MAIN_bench_result_t *MAIN_benchmark_get_results(uint8_t *count)
+{
+    if (count != NULL)
+        *count = bench_result_count;
+    return bench_results;
+}
+
+/**
+ * @brief Print the results of the last run to Serial
+ */
+void MAIN_benchmark_print_results(void)
+{
+    Serial.println("[BENCH] test             iterations  per op us   max us        rate");
+    for (uint8_t i = 0; i < bench_result_count; i++)
+    {
+        const MAIN_bench_result_t *result = &bench_results[i];
+        Serial.printf("[BENCH] %-16s %10lu %10.1f %8lu %11.2f %s\n", result->name,
+                      (unsigned long)result->iterations,
+                      result->iterations ? (double)result->totalUs / result->iterations : 0.0,
+                      (unsigned long)result->maxUs, (double)result->rate, result->unit);
+    }
+}
+
+/******************************************************************************
+ * LVGL Demo Benchmark
+ *****************************************************************************/
+
+#if LV_USE_DEMO_BENCHMARK
+static const char *bench_render_mode_name(lv_display_render_mode_t mode)
+{
+    switch (mode)
+    {
+    case LV_DISPLAY_RENDER_MODE_DIRECT:
+        return "direct";
+    case LV_DISPLAY_RENDER_MODE_FULL:
+        return "full";
+    default:
+        return "partial";
+    }
+}
+
+/**
+ * @brief Print one scene (or the total) and append it to the results file
+ * @param prefix Configuration columns
+ * @param saved Cleared when a row could not be written
+ */
+static void bench_demo_row(const char *prefix, const char *scene, uint32_t samples, uint32_t cpu,
+                           uint32_t fps, uint32_t renderMs, uint32_t flushMs, bool *saved)
+{
+    Serial.printf("[BENCH] %-28s %3lu %4lu %% %4lu fps %4lu ms render %4lu ms flush\n", scene,
+                  (unsigned long)samples, (unsigned long)cpu, (unsigned long)fps,
+                  (unsigned long)renderMs, (unsigned long)flushMs);
+
+    if (!*saved)
+        return;
+
+    char row[192];
+    snprintf(row, sizeof(row), "%s,%s,%lu,%lu,%lu,%lu,%lu\n", prefix, scene, (unsigned long)samples,
+             (unsigned long)cpu, (unsigned long)fps, (unsigned long)renderMs, (unsigned long)flushMs);
+    *saved = using_sdcard().appendFile(BENCH_LVGL_DEMO_CSV_PATH, row);
+}
+
+/**
+ * @brief lv_demo_benchmark end callback (LVGL context)
+ * @param summary Per-scene sums; scene fields divide by measurement_cnt
+ */
+static void bench_demo_end_cb(const lv_demo_benchmark_summary_t *summary)
+{
+    lv_display_t *disp = lv_display_get_default();
+    int32_t width = (disp != NULL) ? lv_display_get_horizontal_resolution(disp) : 0;
+    uint32_t bufferLines = (width > 0) ? MAIN_lvgl_get_buffer_size() / ((uint32_t)width * 2) : 0;
+
+    char prefix[96];
+    snprintf(prefix, sizeof(prefix), "%llu,%s.%s.%s,%s,%lu,%s,%s,%d",
+             (unsigned long long)EARS_APP_BUILD_TIMESTAMP,
+             EARS_APP_VERSION_MAJOR, EARS_APP_VERSION_MINOR, EARS_APP_VERSION_PATCH,
+             bench_render_mode_name(MAIN_lvgl_get_render_mode()), (unsigned long)bufferLines,
+             MAIN_lvgl_buffers_in_psram() ? "psram" : "internal",
+             MAIN_lvgl_is_async_flush() ? "async" : "sync", LV_DRAW_SW_DRAW_UNIT_CNT);
+
+    Serial.println("\n[BENCH] ===== lv_demo_benchmark =====");
+    Serial.printf("[BENCH] %s mode, %lu lines (%s), %s flush, %d draw unit(s)\n",
+                  bench_render_mode_name(MAIN_lvgl_get_render_mode()), (unsigned long)bufferLines,
+                  MAIN_lvgl_buffers_in_psram() ? "PSRAM" : "internal",
+                  MAIN_lvgl_is_async_flush() ? "async" : "sync", LV_DRAW_SW_DRAW_UNIT_CNT);
+
+    EARS_sdCard &sd = using_sdcard();
+    bool saved = sd.isAvailable() && sd.createDirectory(BENCH_CSV_DIR);
+    if (saved && !sd.fileExists(BENCH_LVGL_DEMO_CSV_PATH))
+    {
+        saved = sd.appendFile(BENCH_LVGL_DEMO_CSV_PATH,
+                              "build,version,render_mode,buffer_lines,buffer_ram,flush,draw_units,"
+                              "scene,samples,cpu_pct,fps,render_ms,flush_ms\n");
+    }
+
+    for (uint32_t i = 0; summary->scenes[i].create_cb != NULL; i++)
+    {
+        const lv_demo_benchmark_scene_dsc_t *scene = &summary->scenes[i];
+        uint32_t cnt = scene->measurement_cnt;
+        if (cnt == 0)
+            continue;
+        bench_demo_row(prefix, scene->name, cnt, scene->cpu_avg_usage / cnt, scene->fps_avg / cnt,
+                       scene->render_avg_time / cnt, scene->flush_avg_time / cnt, &saved);
+    }
+
+    int32_t valid = summary->valid_scene_cnt;
+    if (valid > 0)
+    {
+        bench_demo_row(prefix, "total", (uint32_t)valid, summary->total_avg_cpu / valid,
+                       summary->total_avg_fps / valid, summary->total_avg_render_time / valid,
+                       summary->total_avg_flush_time / valid, &saved);
+    }
+
+    sd.flush(BENCH_LVGL_DEMO_CSV_PATH);
+    Serial.printf("[BENCH] Scenes %s\n", saved ? "appended to " BENCH_LVGL_DEMO_CSV_PATH : "not saved (no SD card)");
+    MAIN_lvgl_print_stats();
+    Serial.println("[BENCH] ==============================\n");
+
+    // The demo's own table, since setting a callback replaces it
+    lv_demo_benchmark_summary_display(summary);
+    bench_demo_done = true;
+}
+#endif
+
+/**
+ * @brief Start lv_demo_benchmark on the active screen
+ * @return true if the demo is built in and started
+ */
+bool MAIN_benchmark_lvgl_demo_start(void)
+{
+#if LV_USE_DEMO_BENCHMARK
+    bench_demo_done = false;
+    MAIN_lvgl_reset_stats();
+    lv_demo_benchmark_set_end_cb(bench_demo_end_cb);
+    lv_demo_benchmark();
+    Serial.println("[BENCH] lv_demo_benchmark started");
+    return true;
+#else
+    Serial.println("[BENCH] lv_demo_benchmark not built (needs -D EARS_LVGL_BENCHMARK=1)");
+    return false;
+#endif
+}
+
+/**
+ * @brief Check if lv_demo_benchmark has finished and saved its results
+ */
+bool MAIN_benchmark_lvgl_demo_is_done(void)
+{
+    return bench_demo_done;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Benchmark_getLibraryName() {
+    return MAIN_Benchmark::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Benchmark_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Benchmark::VERSION_MAJOR,
+                       MAIN_Benchmark::VERSION_MINOR,
+                       MAIN_Benchmark::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Benchmark_getVersionDate() {
+    return MAIN_Benchmark::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Benchmark_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Benchmark_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_benchmarkLib.cpp
+ ******************************************************************************/
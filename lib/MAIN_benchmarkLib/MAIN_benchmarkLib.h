@@ -0,0 +1,169 @@
+/**
+ * @file MAIN_benchmarkLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief On-target micro-benchmarks for the display, SD, NVS and touch paths
+ * @details Built into the benchmark environment (-D EARS_BENCHMARK=1) and run
+ *          once from setup() after the boot stages, before the FreeRTOS tasks
+ *          start, so display, LVGL and the buses are not shared. Measures:
+ *
+ *          - full-screen flush throughput (draw16bitRGBBitmap in bands)
+ *          - fills, outlines, rounded rects and cached buttons through
+ *            MAIN_drawingLib
+ *          - SD sequential and random read and write (EARS_sdCard)
+ *          - AES-256-CTR on the AES peripheral alone, and sequential write
+ *            and read through it (EARS_sdCrypt)
+ *          - NVS get and put latency (EARS_nvsEeprom)
+ *          - touch controller read rate (EARS_touch)
+ *          - LVGL widget creation, layout and deletion rate
+ *
+ *          Results are printed to Serial and appended to BENCH_CSV_PATH, one
+ *          row per test tagged with the build timestamp, so runs of different
+ *          builds can be compared in a spreadsheet. The screen is drawn over;
+ *          LVGL repaints it on its first frame.
+ *
+ *          The LVGL benchmark environment (-D EARS_LVGL_BENCHMARK=1) runs
+ *          lv_demo_benchmark instead of the UI, through the real flush path
+ *          and draw buffers, and appends one row per scene (FPS, CPU, render
+ *          and flush ms) to BENCH_LVGL_DEMO_CSV_PATH, tagged with the render
+ *          mode, buffer lines, buffer placement, flush path and draw units,
+ *          so those options can be tuned from measurements.
+ * @version 1.3.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_BENCHMARK_LIB_H__
+#define __MAIN_BENCHMARK_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "EARS_versionDef.h"
+#include <Arduino_GFX_Library.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Benchmark
+{
+    constexpr const char* LIB_NAME = "MAIN_Benchmark";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "3";
+    constexpr const char* VERSION_PATCH = "1";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_Benchmark_getLibraryName();
+uint32_t MAIN_Benchmark_getVersionEncoded();
+const char* MAIN_Benchmark_getVersionDate();
+void MAIN_Benchmark_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Benchmark Configuration
+ *****************************************************************************/
+
+// Results file, one row per test per run (header written on creation)
+#define BENCH_CSV_DIR "/bench"
+#define BENCH_CSV_PATH "/bench/results.csv"
+
+// Display: full frames pushed in bands of this many lines (internal DMA RAM)
+#define BENCH_FLUSH_FRAMES 20
+#define BENCH_FLUSH_BAND_LINES 40
+
+// MAIN_drawingLib: full-screen fills, then shapes at rotating positions
+#define BENCH_DRAW_FILL_FRAMES 10
+#define BENCH_DRAW_SHAPE_OPS 200
+#define BENCH_DRAW_SHAPE_W 100
+#define BENCH_DRAW_SHAPE_H 60
+#define BENCH_DRAW_SHAPE_RADIUS 10
+
+// SD: sequential file size, transfer size, random transfers within the file
+#define BENCH_SD_PATH "/bench/.bench.bin"
+#define BENCH_SD_BYTES (1024 * 1024U)
+#define BENCH_SD_CHUNK 4096
+#define BENCH_SD_RANDOM_OPS 128
+#define BENCH_SD_CRYPT_PATH "/bench/.bench.ebin" // Same size and transfers, encrypted
+
+// NVS: scratch key (left in the namespace), puts and gets
+#define BENCH_NVS_KEY "bench"
+#define BENCH_NVS_OPS 50
+
+// Touch: register reads of the first touch point
+#define BENCH_TOUCH_READS 200
+
+// LVGL: buttons with a label, created on an unloaded scratch screen
+#define BENCH_LVGL_WIDGETS 200
+
+// Results kept for MAIN_benchmark_get_results()
+#define BENCH_MAX_RESULTS 24
+
+// lv_demo_benchmark: one row per scene per run, plus a "total" row
+#define BENCH_LVGL_DEMO_CSV_PATH "/bench/lvgl_demo.csv"
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    const char *name;    // Test name (CSV "test" column)
+    uint32_t iterations; // Operations timed
+    uint32_t totalUs;    // Time for all iterations
+    uint32_t maxUs;      // Slowest single operation (0 = not timed per op)
+    float rate;          // Throughput in unit
+    const char *unit;    // "MB/s", "fps", "ops/s", ...
+} MAIN_bench_result_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Run every benchmark, print the results and append them to the SD card
+ * @param gfx Pointer to Arduino_GFX object
+ * @param displayMutex Mutex guarding the display bus (may be NULL)
+ * @return true if the results were written to BENCH_CSV_PATH
+ * @note Call from setup() before the tasks start; LVGL must be idle.
+ *       Tests whose hardware is missing are skipped.
+ */
+bool MAIN_benchmark_run(Arduino_GFX *gfx, SemaphoreHandle_t displayMutex);
+
+/**
+ * @brief Results of the last run
+ * @param count Receives the number of results
+ * @return const MAIN_bench_result_t* Results, in run order
+ */
+const MAIN_bench_result_t *MAIN_benchmark_get_results(uint8_t *count);
+
+/**
+ * @brief Print the results of the last run to Serial
+ */
+void MAIN_benchmark_print_results(void);
+
+/**
+ * @brief Start lv_demo_benchmark on the active screen
+ * @return true if the demo is built in (-D EARS_LVGL_BENCHMARK=1) and started
+ * @note LVGL context. The scenes take about a minute; when they end the
+ *       results are printed, appended to BENCH_LVGL_DEMO_CSV_PATH and shown
+ *       on the summary screen.
+ */
+bool MAIN_benchmark_lvgl_demo_start(void);
+
+/**
+ * @brief Check if lv_demo_benchmark has finished and saved its results
+ * @return true once the summary has been written
+ */
+bool MAIN_benchmark_lvgl_demo_is_done(void);
+
+#endif // __MAIN_BENCHMARK_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_benchmarkLib.h
+ ******************************************************************************/
@@ -0,0 +1,310 @@
+/**
+ * @file MAIN_bootProfilerLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Boot timeline in RTC memory, appended to the SD card after boot
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_bootProfilerLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_sdCardLib.h"
+#include "MAIN_jobSchedulerLib.h"
+#include "MAIN_lvglLib.h"
+#include <esp_attr.h>
+#include <esp_rom_crc.h>
+#include <esp_system.h>
+#include <esp_timer.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+#define BOOT_PROFILE_MAGIC 0x544F4F42UL // "BOOT"
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t bootCount;  // Boots since power-on
+    uint64_t build;      // EARS_APP_BUILD_TIMESTAMP
+    uint32_t version;    // VERS_ENCODE of the app version
+    uint8_t count;       // Entries used
+    uint8_t complete;    // First frame reached
+    uint8_t reserved[2];
+    MAIN_boot_profile_entry_t entries[BOOT_PROFILE_MAX_ENTRIES];
+    uint32_t crc;        // Over everything above
+} boot_profile_record_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+// Left alone by the bootloader and by panic/watchdog resets, garbage after power-on
+RTC_NOINIT_ATTR static boot_profile_record_t boot_profile_rtc;
+
+static boot_profile_record_t boot_profile_previous; // Unfinished timeline of the last boot
+static bool boot_profile_has_previous = false;
+static MAIN_job_id_t boot_profile_job_id = JOB_INVALID;
+static int64_t boot_profile_complete_us = 0;
+static portMUX_TYPE boot_profile_mux = portMUX_INITIALIZER_UNLOCKED;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Checksum of a record
+ * @param record Record
+ * @return uint32_t CRC32 of everything before the crc field
+ */
+static uint32_t boot_profile_crc(const boot_profile_record_t *record)
+{
+    return esp_rom_crc32_le(0, (const uint8_t *)record, offsetof(boot_profile_record_t, crc));
+}
+
+/**
+ * @brief Append one record to BOOT_PROFILE_FILE
+ * @param record Timeline
+ * @param resetReason esp_reset_reason() that ended or started it
+ * @return true if written
+ */
+static bool boot_profile_write(const boot_profile_record_t *record, int resetReason)
+{
+    char version[16];
+    VERS_FORMAT(record->version, version);
+
+    char line[128];
+    if (!using_sdcard().fileExists(BOOT_PROFILE_FILE))
+    {
+        static const char header[] = "build,version,boot,reset,complete,entry,core,start_us,duration_us\n";
+        if (!using_sdcard().appendData(BOOT_PROFILE_FILE, (const uint8_t *)header, sizeof(header) - 1))
+        {
+            return false;
+        }
+    }
+
+    for (uint8_t i = 0; i < record->count; i++)
+    {
+        const MAIN_boot_profile_entry_t *entry = &record->entries[i];
+        int length = snprintf(line, sizeof(line), "%llu,%s,%lu,%d,%u,%s,%d,%lu,%lu\n",
+                              (unsigned long long)record->build, version, (unsigned long)record->bootCount,
+                              resetReason, record->complete, entry->name, entry->core,
+                              (unsigned long)entry->startUs, (unsigned long)(entry->endUs - entry->startUs));
+        if (!using_sdcard().appendData(BOOT_PROFILE_FILE, (const uint8_t *)line, length))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Core 1 job: once the first frame is out, close and persist the timeline
+ * @param ctx Unused
+ */
+static void boot_profile_job(void *ctx)
+{
+    int64_t firstFrameUs = MAIN_lvgl_get_first_frame_us();
+    bool timedOut = (esp_timer_get_time() - boot_profile_complete_us) > BOOT_PROFILE_FIRST_FRAME_TIMEOUT_MS * 1000LL;
+
+    if (firstFrameUs == 0 && !timedOut)
+    {
+        return;
+    }
+
+    if (firstFrameUs != 0)
+    {
+        MAIN_boot_profile_stage("first frame", firstFrameUs, firstFrameUs, -1);
+    }
+    else
+    {
+        Serial.println("[BOOTPROF] Warning: No frame flushed, timeline saved without it");
+    }
+
+    taskENTER_CRITICAL(&boot_profile_mux);
+    boot_profile_rtc.complete = 1;
+    boot_profile_rtc.crc = boot_profile_crc(&boot_profile_rtc);
+    taskEXIT_CRITICAL(&boot_profile_mux);
+
+    int resetReason = (int)esp_reset_reason();
+    if (using_sdcard().isAvailable())
+    {
+        bool ok = true;
+        if (boot_profile_has_previous)
+        {
+            ok = boot_profile_write(&boot_profile_previous, resetReason);
+            boot_profile_has_previous = false;
+        }
+        ok = boot_profile_write(&boot_profile_rtc, resetReason) && ok;
+        if (!ok)
+        {
+            Serial.println("[BOOTPROF] Warning: Could not append " BOOT_PROFILE_FILE);
+        }
+    }
+
+#if EARS_DEBUG == 1
+    MAIN_boot_profile_print();
+#endif
+
+    MAIN_job_cancel(boot_profile_job_id);
+    boot_profile_job_id = JOB_INVALID;
+}
+
+/******************************************************************************
+ * Boot Profiler
+ *****************************************************************************/
+
+/**
+ * @brief Start this boot's timeline
+ */
+void MAIN_boot_profile_begin(void)
+{
+    bool valid = boot_profile_rtc.magic == BOOT_PROFILE_MAGIC &&
+                 boot_profile_rtc.count <= BOOT_PROFILE_MAX_ENTRIES &&
+                 boot_profile_rtc.crc == boot_profile_crc(&boot_profile_rtc);
+
+    if (valid && !boot_profile_rtc.complete)
+    {
+        boot_profile_previous = boot_profile_rtc;
+        boot_profile_has_previous = true;
+
+        const char *last = (boot_profile_rtc.count > 0) ? boot_profile_rtc.entries[boot_profile_rtc.count - 1].name : "start";
+        Serial.printf("[BOOTPROF] Warning: Boot #%lu reset after '%s' (reset reason %d)\n",
+                      (unsigned long)boot_profile_rtc.bootCount, last, (int)esp_reset_reason());
+    }
+
+    uint32_t bootCount = valid ? boot_profile_rtc.bootCount + 1 : 1;
+
+    memset(&boot_profile_rtc, 0, sizeof(boot_profile_rtc));
+    boot_profile_rtc.magic = BOOT_PROFILE_MAGIC;
+    boot_profile_rtc.bootCount = bootCount;
+    boot_profile_rtc.build = EARS_APP_BUILD_TIMESTAMP;
+    boot_profile_rtc.version = VERS_ENCODE(EARS_APP_VERSION_MAJOR, EARS_APP_VERSION_MINOR, EARS_APP_VERSION_PATCH);
+    boot_profile_rtc.crc = boot_profile_crc(&boot_profile_rtc);
+
+    MAIN_boot_profile_mark("setup");
+}
+
+/**
+ * @brief Record a stage
+ * @param name Stage name
+ * @param startUs Start time
+ * @param endUs End time
+ * @param core Core it ran on
+ */
+void MAIN_boot_profile_stage(const char *name, int64_t startUs, int64_t endUs, int8_t core)
+{
+    taskENTER_CRITICAL(&boot_profile_mux);
+    if (boot_profile_rtc.count < BOOT_PROFILE_MAX_ENTRIES)
+    {
+        MAIN_boot_profile_entry_t *entry = &boot_profile_rtc.entries[boot_profile_rtc.count++];
+        strncpy(entry->name, (name != NULL) ? name : "?", BOOT_PROFILE_NAME_SIZE - 1);
+        entry->name[BOOT_PROFILE_NAME_SIZE - 1] = '\0';
+        entry->core = core;
+        entry->startUs = (uint32_t)startUs;
+        entry->endUs = (uint32_t)endUs;
+        boot_profile_rtc.crc = boot_profile_crc(&boot_profile_rtc);
+    }
+    taskEXIT_CRITICAL(&boot_profile_mux);
+}
+
+/**
+ * @brief Record a milestone at the current time
+ * @param name Milestone name
+ */
+void MAIN_boot_profile_mark(const char *name)
+{
+    int64_t now = esp_timer_get_time();
+    MAIN_boot_profile_stage(name, now, now, -1);
+}
+
+/**
+ * @brief Boot is done: wait for the first frame, then persist and summarise
+ */
+void MAIN_boot_profile_complete(void)
+{
+    if (boot_profile_job_id != JOB_INVALID)
+    {
+        return;
+    }
+
+    boot_profile_complete_us = esp_timer_get_time();
+    boot_profile_job_id = MAIN_job_add("bootprof", boot_profile_job, NULL, BOOT_PROFILE_POLL_MS,
+                                       BOOT_PROFILE_POLL_MS, JOB_PRIORITY_LOW, 0);
+}
+
+/**
+ * @brief This boot's entries
+ * @param count Receives the number of entries
+ * @return const MAIN_boot_profile_entry_t* Entries
+ */
+const MAIN_boot_profile_entry_t *MAIN_boot_profile_entries(uint8_t *count)
+{
+    if (count != NULL)
+    {
+        *count = boot_profile_rtc.count;
+    }
+    return boot_profile_rtc.entries;
+}
+
+/**
+ * @brief Print this boot's timeline to Serial
+ */
+void MAIN_boot_profile_print(void)
+{
+    char version[16];
+    VERS_FORMAT(boot_profile_rtc.version, version);
+
+    Serial.printf("[BOOTPROF] Boot #%lu, v%s build %llu\n", (unsigned long)boot_profile_rtc.bootCount, version,
+                  (unsigned long long)boot_profile_rtc.build);
+    for (uint8_t i = 0; i < boot_profile_rtc.count; i++)
+    {
+        const MAIN_boot_profile_entry_t *entry = &boot_profile_rtc.entries[i];
+        if (entry->core < 0)
+        {
+            Serial.printf("[BOOTPROF]   %-12s at %8.1f ms\n", entry->name, entry->startUs / 1000.0);
+        }
+        else
+        {
+            Serial.printf("[BOOTPROF]   %-12s at %8.1f ms, %7.1f ms on core %d\n", entry->name,
+                          entry->startUs / 1000.0, (entry->endUs - entry->startUs) / 1000.0, entry->core);
+        }
+    }
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_BootProfiler_getLibraryName() {
+    return MAIN_BootProfiler::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_BootProfiler_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_BootProfiler::VERSION_MAJOR,
+                       MAIN_BootProfiler::VERSION_MINOR,
+                       MAIN_BootProfiler::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_BootProfiler_getVersionDate() {
+    return MAIN_BootProfiler::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_BootProfiler_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_BootProfiler_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_bootProfilerLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,130 @@
+/**
+ * @file MAIN_bootProfilerLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Boot timeline in RTC memory, appended to the SD card after boot
+ * @details Each boot stage (the MAIN_boot_run() stages: display, LVGL, touch,
+ *          NVS, SD, assets) and milestone (setup entry, tasks started, first
+ *          frame flushed) is stamped with esp_timer_get_time() into a record
+ *          in RTC memory, which costs a few microseconds and no Serial output.
+ *
+ *          Once the first frame has reached the panel, a Core 1 job appends
+ *          the timeline to BOOT_PROFILE_FILE, one CSV row per entry keyed by
+ *          EARS_APP_BUILD_TIMESTAMP and version (bumped by
+ *          scripts/increment_build.py), so boot regressions show across
+ *          builds, and prints a short Serial summary in debug builds.
+ *
+ *          The record survives a panic or watchdog reset: a boot that never
+ *          completed is reported at the next boot with the stage it reached,
+ *          and persisted with complete = 0.
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_BOOT_PROFILER_LIB_H__
+#define __MAIN_BOOT_PROFILER_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_BootProfiler
+{
+    constexpr const char* LIB_NAME = "MAIN_BootProfiler";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-14";
+}
+
+
+// Version information getters
+const char* MAIN_BootProfiler_getLibraryName();
+uint32_t MAIN_BootProfiler_getVersionEncoded();
+const char* MAIN_BootProfiler_getVersionDate();
+void MAIN_BootProfiler_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Boot Profiler Configuration
+ *****************************************************************************/
+
+// Entries per boot and stored name length (including terminator)
+#define BOOT_PROFILE_MAX_ENTRIES 24
+#define BOOT_PROFILE_NAME_SIZE 12
+
+// Timeline history on the SD card (CSV, header written with the file)
+#define BOOT_PROFILE_FILE "/logs/boot_profile.csv"
+
+// How often the persist job checks for the first frame, and when it gives up
+#define BOOT_PROFILE_POLL_MS 250
+#define BOOT_PROFILE_FIRST_FRAME_TIMEOUT_MS 15000
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    char name[BOOT_PROFILE_NAME_SIZE]; // Stage or milestone
+    int8_t core;                       // Core it ran on (-1 = milestone)
+    uint32_t startUs;                  // esp_timer_get_time() at start
+    uint32_t endUs;                    // At end (== startUs for milestones)
+} MAIN_boot_profile_entry_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Start this boot's timeline
+ * @note First thing in setup(). Reports and keeps an unfinished timeline
+ *       left in RTC memory by a reset during the previous boot.
+ */
+void MAIN_boot_profile_begin(void);
+
+/**
+ * @brief Record a stage
+ * @param name Stage name (cut to BOOT_PROFILE_NAME_SIZE - 1)
+ * @param startUs esp_timer_get_time() at start
+ * @param endUs esp_timer_get_time() at end
+ * @param core Core it ran on
+ * @note Any task.
+ */
+void MAIN_boot_profile_stage(const char *name, int64_t startUs, int64_t endUs, int8_t core);
+
+/**
+ * @brief Record a milestone at the current time
+ * @param name Milestone name
+ */
+void MAIN_boot_profile_mark(const char *name);
+
+/**
+ * @brief Boot is done: wait for the first frame, then persist and summarise
+ * @note Call at the end of setup(). The work runs as a Core 1 job.
+ */
+void MAIN_boot_profile_complete(void);
+
+/**
+ * @brief This boot's entries
+ * @param count Receives the number of entries
+ * @return const MAIN_boot_profile_entry_t* Entries in recording order
+ */
+const MAIN_boot_profile_entry_t *MAIN_boot_profile_entries(uint8_t *count);
+
+/**
+ * @brief Print this boot's timeline to Serial
+ */
+void MAIN_boot_profile_print(void);
+
+#endif // __MAIN_BOOT_PROFILER_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_bootProfilerLib.h
+ ******************************************************************************/
@@ -0,0 +1,500 @@
+/**
+ * @file MAIN_chartDataLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Chart data engine: ring-buffered series drawn min/max per pixel
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_chartDataLib.h"
+#include "EARS_systemDef.h"
+#include "MAIN_memPlanLib.h"
+#include <esp_heap_caps.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+struct MAIN_chart_data_s
+{
+    bool used;
+    int32_t *ring;
+    uint32_t capacity;
+    uint32_t appended;          // Samples ever added; sample n is ring[n % capacity]
+
+    lv_obj_t *chart;            // NULL when not bound
+    lv_chart_series_t *series;
+    MAIN_chart_data_mode_t mode;
+    uint16_t columns;
+    uint32_t bucket;            // Samples per column
+
+    // Newest column, updated sample by sample
+    uint32_t lastBucket;
+    bool lastOpen;
+    int32_t min;
+    int32_t max;
+    bool minFirst;
+
+    MAIN_chart_data_stats_t stats;
+};
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static MAIN_chart_data_t chart_datas[CHART_DATA_MAX];
+
+/******************************************************************************
+ * Private Functions
+ *****************************************************************************/
+
+/**
+ * @brief Samples still in the ring
+ */
+static uint32_t chart_data_held(const MAIN_chart_data_t *data)
+{
+    return data->appended < data->capacity ? data->appended : data->capacity;
+}
+
+/**
+ * @brief Min and max of one column's samples still in the ring
+ * @param bucket Column number (bucket x samples per column = first sample)
+ * @return true if any of its samples is held
+ */
+static bool chart_data_reduce(const MAIN_chart_data_t *data, uint32_t bucket, int32_t *min, int32_t *max,
+                              bool *minFirst)
+{
+    uint32_t oldest = data->appended - chart_data_held(data);
+    uint32_t first = bucket * data->bucket;
+    uint32_t end = first + data->bucket;
+    if (first < oldest)
+    {
+        first = oldest;
+    }
+    if (end > data->appended)
+    {
+        end = data->appended;
+    }
+    if (first >= end)
+    {
+        return false;
+    }
+
+    uint32_t minAt = first;
+    uint32_t maxAt = first;
+    *min = *max = data->ring[first % data->capacity];
+    for (uint32_t n = first + 1; n < end; n++)
+    {
+        int32_t value = data->ring[n % data->capacity];
+        if (value < *min)
+        {
+            *min = value;
+            minAt = n;
+        }
+        if (value > *max)
+        {
+            *max = value;
+            maxAt = n;
+        }
+    }
+    *minFirst = minAt <= maxAt;
+    return true;
+}
+
+/**
+ * @brief Drawn position of a column's first point
+ */
+static uint32_t chart_data_position(const MAIN_chart_data_t *data, uint32_t bucket)
+{
+    if (data->mode == CHART_DATA_SCROLL)
+    {
+        return 2 * (data->columns - 1 - (data->lastBucket - bucket));
+    }
+    return 2 * (bucket % data->columns);
+}
+
+/**
+ * @brief Write a column's two points (LV_CHART_POINT_NONE when empty)
+ * @param position Drawn position of its first point
+ */
+static void chart_data_put(MAIN_chart_data_t *data, uint32_t position, bool any, int32_t min, int32_t max,
+                           bool minFirst)
+{
+    int32_t *y = lv_chart_get_series_y_array(data->chart, data->series);
+    uint32_t count = lv_chart_get_point_count(data->chart);
+
+    // Scroll mode draws from the series start, sweep mode from index 0
+    uint32_t start = data->mode == CHART_DATA_SCROLL ? lv_chart_get_x_start_point(data->chart, data->series) : 0;
+    uint32_t index = (start + position) % count;
+
+    y[index] = any ? (minFirst ? min : max) : LV_CHART_POINT_NONE;
+    y[(index + 1) % count] = any ? (minFirst ? max : min) : LV_CHART_POINT_NONE;
+}
+
+/**
+ * @brief Invalidate the strip drawn by some points (and the segments into them)
+ * @param position Drawn position of the first point
+ * @param points Points
+ */
+static void chart_data_invalidate(MAIN_chart_data_t *data, uint32_t position, uint32_t points)
+{
+    lv_obj_t *chart = data->chart;
+    uint32_t count = lv_chart_get_point_count(chart);
+    if (count < 2)
+    {
+        return;
+    }
+
+    int32_t width = lv_obj_get_content_width(chart);
+    int32_t margin = lv_obj_get_style_line_width(chart, LV_PART_ITEMS) +
+                     lv_obj_get_style_width(chart, LV_PART_INDICATOR);
+
+    lv_area_t area;
+    lv_obj_get_coords(chart, &area);
+    int32_t xOfs = area.x1 + lv_obj_get_style_pad_left(chart, LV_PART_MAIN) +
+                   lv_obj_get_style_border_width(chart, LV_PART_MAIN) - lv_obj_get_scroll_left(chart);
+
+    uint32_t from = position > 0 ? position - 1 : 0;
+    uint32_t to = position + points < count ? position + points : count - 1;
+    area.x1 = (int32_t)((width * (int32_t)from) / (int32_t)(count - 1)) + xOfs - margin;
+    area.x2 = (int32_t)((width * (int32_t)to) / (int32_t)(count - 1)) + xOfs + margin;
+    area.y1 -= margin;
+    area.y2 += margin;
+    lv_obj_invalidate_area(chart, &area);
+    data->stats.strips++;
+}
+
+/**
+ * @brief Decimate the whole window into the chart and redraw it
+ */
+static void chart_data_rebuild(MAIN_chart_data_t *data)
+{
+    if (data->chart == NULL)
+    {
+        return;
+    }
+
+    lv_chart_set_x_start_point(data->chart, data->series, 0);
+    data->lastOpen = data->appended > 0;
+    data->lastBucket = data->appended > 0 ? (data->appended - 1) / data->bucket : 0;
+
+    for (uint32_t column = 0; column < data->columns; column++)
+    {
+        // Columns back from the newest: scroll mode has the newest on the
+        // right, sweep mode at lastBucket % columns with the gap after it
+        uint32_t back = data->columns - 1 - column;
+        if (data->mode == CHART_DATA_SWEEP)
+        {
+            back = (data->lastBucket % data->columns + data->columns - column) % data->columns;
+        }
+
+        int32_t min = 0;
+        int32_t max = 0;
+        bool minFirst = true;
+        bool any = false;
+        bool gap = data->mode == CHART_DATA_SWEEP && back == (uint32_t)data->columns - 1;
+        if (data->lastOpen && !gap && back <= data->lastBucket)
+        {
+            any = chart_data_reduce(data, data->lastBucket - back, &min, &max, &minFirst);
+        }
+        chart_data_put(data, 2 * column, any, min, max, minFirst);
+    }
+
+    if (data->lastOpen)
+    {
+        chart_data_reduce(data, data->lastBucket, &data->min, &data->max, &data->minFirst);
+    }
+    lv_chart_refresh(data->chart);
+    data->stats.rebuilds++;
+}
+
+/**
+ * @brief Chart deleted: stop drawing into it
+ */
+static void chart_data_delete_cb(lv_event_t *e)
+{
+    MAIN_chart_data_t *data = (MAIN_chart_data_t *)lv_event_get_user_data(e);
+    data->chart = NULL;
+    data->series = NULL;
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Create a series with a ring of its own
+ */
+MAIN_chart_data_t *MAIN_chart_data_create(uint32_t capacity)
+{
+    if (capacity == 0 || capacity > CHART_DATA_MAX_SAMPLES)
+    {
+        return NULL;
+    }
+
+    for (uint8_t i = 0; i < CHART_DATA_MAX; i++)
+    {
+        MAIN_chart_data_t *data = &chart_datas[i];
+        if (data->used)
+        {
+            continue;
+        }
+
+        data->ring = (int32_t *)MAIN_mem_alloc(MEM_POOL_CHARTS, capacity * sizeof(int32_t),
+                                               MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (data->ring == NULL)
+        {
+            return NULL;
+        }
+
+        memset(&data->stats, 0, sizeof(data->stats));
+        data->used = true;
+        data->capacity = capacity;
+        data->appended = 0;
+        data->chart = NULL;
+        data->series = NULL;
+        data->lastOpen = false;
+        return data;
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[CHART] ERROR: All %u series in use\n", CHART_DATA_MAX);
+#endif
+    return NULL;
+}
+
+/**
+ * @brief Free a series and its ring
+ */
+void MAIN_chart_data_delete(MAIN_chart_data_t *data)
+{
+    if (data == NULL || !data->used)
+    {
+        return;
+    }
+
+    MAIN_chart_data_unbind(data);
+    MAIN_mem_free(data->ring);
+    data->ring = NULL;
+    data->used = false;
+}
+
+/**
+ * @brief Show a series on a line chart
+ */
+void MAIN_chart_data_bind(MAIN_chart_data_t *data, lv_obj_t *chart, lv_chart_series_t *series, uint32_t window,
+                          MAIN_chart_data_mode_t mode)
+{
+    if (data == NULL || chart == NULL || series == NULL)
+    {
+        return;
+    }
+    MAIN_chart_data_unbind(data);
+
+    // One column per pixel of the plot area
+    lv_obj_update_layout(chart);
+    int32_t width = lv_obj_get_content_width(chart);
+    uint16_t columns = (uint16_t)(width < 2 ? 2 : (width > CHART_DATA_MAX_COLUMNS ? CHART_DATA_MAX_COLUMNS : width));
+    if (window == 0)
+    {
+        window = data->capacity;
+    }
+
+    data->chart = chart;
+    data->series = series;
+    data->mode = mode;
+    data->columns = columns;
+    data->bucket = (window + columns - 1) / columns;
+
+    lv_chart_set_update_mode(chart, mode == CHART_DATA_SCROLL ? LV_CHART_UPDATE_MODE_SHIFT : LV_CHART_UPDATE_MODE_CIRCULAR);
+    lv_chart_set_point_count(chart, 2U * columns);
+    lv_obj_add_event_cb(chart, chart_data_delete_cb, LV_EVENT_DELETE, data);
+
+    data->stats.columns = columns;
+    data->stats.bucket = data->bucket;
+    chart_data_rebuild(data);
+
+#if EARS_DEBUG == 1
+    Serial.printf("[CHART] %u columns of %lu samples, %s\n", columns, (unsigned long)data->bucket,
+                  mode == CHART_DATA_SCROLL ? "scroll" : "sweep");
+#endif
+}
+
+/**
+ * @brief Stop drawing a series
+ */
+void MAIN_chart_data_unbind(MAIN_chart_data_t *data)
+{
+    if (data == NULL || data->chart == NULL)
+    {
+        return;
+    }
+
+    lv_obj_remove_event_cb_with_user_data(data->chart, chart_data_delete_cb, data);
+    data->chart = NULL;
+    data->series = NULL;
+}
+
+/**
+ * @brief Add a sample, drawing just the newest column
+ */
+void MAIN_chart_data_append(MAIN_chart_data_t *data, int32_t value)
+{
+    if (data == NULL || !data->used)
+    {
+        return;
+    }
+
+    uint32_t n = data->appended++;
+    data->ring[n % data->capacity] = value;
+    data->stats.appends++;
+    if (data->chart == NULL)
+    {
+        return;
+    }
+
+    uint32_t bucket = n / data->bucket;
+    if (data->lastOpen && bucket == data->lastBucket)
+    {
+        // Same column: redraw it only if its extremes moved
+        bool changed = false;
+        if (value < data->min)
+        {
+            data->min = value;
+            data->minFirst = false;
+            changed = true;
+        }
+        if (value > data->max)
+        {
+            data->max = value;
+            data->minFirst = true;
+            changed = true;
+        }
+        if (changed)
+        {
+            uint32_t position = chart_data_position(data, bucket);
+            chart_data_put(data, position, true, data->min, data->max, data->minFirst);
+            chart_data_invalidate(data, position, 2);
+        }
+        return;
+    }
+
+    // New column
+    data->lastOpen = true;
+    data->lastBucket = bucket;
+    data->min = data->max = value;
+    data->minFirst = true;
+
+    if (data->mode == CHART_DATA_SCROLL)
+    {
+        // Everything moves one column left: the one full redraw per column
+        uint32_t count = lv_chart_get_point_count(data->chart);
+        uint32_t start = lv_chart_get_x_start_point(data->chart, data->series);
+        lv_chart_set_x_start_point(data->chart, data->series, (start + 2) % count);
+        chart_data_put(data, chart_data_position(data, bucket), true, value, value, true);
+        lv_obj_invalidate(data->chart);
+        data->stats.scrolls++;
+        return;
+    }
+
+    // Sweep: write over the oldest column and clear the one after as the gap
+    uint32_t position = chart_data_position(data, bucket);
+    uint32_t gap = 2 * ((bucket + 1) % data->columns);
+    chart_data_put(data, position, true, value, value, true);
+    chart_data_put(data, gap, false, 0, 0, true);
+    chart_data_invalidate(data, position, gap > position ? 4 : 2);
+    if (gap < position)
+    {
+        chart_data_invalidate(data, gap, 2);
+    }
+}
+
+/**
+ * @brief Add many samples, then decimate and draw once
+ */
+void MAIN_chart_data_append_many(MAIN_chart_data_t *data, const int32_t *values, size_t count)
+{
+    if (data == NULL || !data->used || values == NULL)
+    {
+        return;
+    }
+
+    // Only the last `capacity` survive
+    if (count > data->capacity)
+    {
+        data->appended += (uint32_t)(count - data->capacity);
+        data->stats.appends += (uint32_t)(count - data->capacity);
+        values += count - data->capacity;
+        count = data->capacity;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        data->ring[data->appended++ % data->capacity] = values[i];
+    }
+    data->stats.appends += (uint32_t)count;
+    chart_data_rebuild(data);
+}
+
+/**
+ * @brief Drop every sample
+ */
+void MAIN_chart_data_clear(MAIN_chart_data_t *data)
+{
+    if (data == NULL || !data->used)
+    {
+        return;
+    }
+
+    data->appended = 0;
+    chart_data_rebuild(data);
+}
+
+/**
+ * @brief Series counters
+ */
+void MAIN_chart_data_get_stats(const MAIN_chart_data_t *data, MAIN_chart_data_stats_t *stats)
+{
+    if (data == NULL || stats == NULL)
+    {
+        return;
+    }
+
+    *stats = data->stats;
+    stats->held = chart_data_held(data);
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_ChartData_getLibraryName() {
+    return MAIN_ChartData::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_ChartData_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_ChartData::VERSION_MAJOR,
+                       MAIN_ChartData::VERSION_MINOR,
+                       MAIN_ChartData::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_ChartData_getVersionDate() {
+    return MAIN_ChartData::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_ChartData_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_ChartData_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/******************************************************************************
+ * End of MAIN_chartDataLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,166 @@
+/**
+ * @file MAIN_chartDataLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Chart data engine: ring-buffered series drawn min/max per pixel
+ * @details An lv_chart draws every point it holds, and lv_chart_refresh()
+ *          or a shift-mode lv_chart_set_next_value() redraws the whole
+ *          chart. Hours of samples on a chart 480 pixels wide means
+ *          thousands of line segments stacked in each column, all redrawn
+ *          for every new value.
+ *
+ *          A chart data series keeps its samples in a ring of fixed
+ *          capacity (PSRAM, MEM_POOL_CHARTS), allocated once. Bound to a
+ *          chart series, it shows the last `window` samples as one column
+ *          per pixel of the chart's content width. Each column holds two
+ *          points, the minimum and the maximum of its samples, in the order
+ *          they occurred, so spikes survive the decimation and the chart
+ *          never holds more than twice its width in points.
+ *
+ *          Columns are aligned to the sample count, so an append only
+ *          touches the newest column. While it fills, only that column's
+ *          strip is invalidated, and only when its minimum or maximum
+ *          changes. When a new column starts, CHART_DATA_SWEEP writes it
+ *          over the oldest one and invalidates two strips.
+ *          CHART_DATA_SCROLL moves the series start one column and redraws
+ *          the chart once per column, not once per sample.
+ *
+ *          UI task only.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_CHART_DATA_LIB_H__
+#define __MAIN_CHART_DATA_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include <lvgl.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_ChartData
+{
+    constexpr const char* LIB_NAME = "MAIN_ChartData";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_ChartData_getLibraryName();
+uint32_t MAIN_ChartData_getVersionEncoded();
+const char* MAIN_ChartData_getVersionDate();
+void MAIN_ChartData_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Chart Data Configuration
+ *****************************************************************************/
+
+// Series that can exist at once, and the largest ring each may have
+#define CHART_DATA_MAX 4
+#define CHART_DATA_MAX_SAMPLES 8640
+
+// Columns a bound chart gets at most (two points each)
+#define CHART_DATA_MAX_COLUMNS 480
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct MAIN_chart_data_s MAIN_chart_data_t;
+
+typedef enum
+{
+    CHART_DATA_SWEEP = 0,       // New columns overwrite the oldest, a gap after the newest
+    CHART_DATA_SCROLL           // Newest column on the right, the rest moves left
+} MAIN_chart_data_mode_t;
+
+typedef struct
+{
+    uint32_t appends;           // Samples added
+    uint32_t held;              // In the ring now
+    uint16_t columns;           // Columns on the bound chart
+    uint32_t bucket;            // Samples per column
+    uint32_t rebuilds;          // Full decimations of the ring
+    uint32_t strips;            // Strip invalidations
+    uint32_t scrolls;           // Whole-chart invalidations (scroll mode)
+} MAIN_chart_data_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Create a series with a ring of its own
+ * @param capacity Samples held (up to CHART_DATA_MAX_SAMPLES)
+ * @return MAIN_chart_data_t* Series, NULL if none free or out of memory
+ */
+MAIN_chart_data_t *MAIN_chart_data_create(uint32_t capacity);
+
+/**
+ * @brief Free a series and its ring (unbinds it first)
+ * @param data Series
+ */
+void MAIN_chart_data_delete(MAIN_chart_data_t *data);
+
+/**
+ * @brief Show a series on a line chart
+ * @details Sets the chart's point count to two per column of its content
+ *          width, so every series on that chart must be bound the same way.
+ * @param data Series
+ * @param chart Line chart (laid out, or sized)
+ * @param series Series of that chart
+ * @param window Most recent samples spanned by the width (0 = capacity)
+ * @param mode CHART_DATA_SWEEP or CHART_DATA_SCROLL
+ */
+void MAIN_chart_data_bind(MAIN_chart_data_t *data, lv_obj_t *chart, lv_chart_series_t *series, uint32_t window,
+                          MAIN_chart_data_mode_t mode);
+
+/**
+ * @brief Stop drawing a series (the ring keeps filling)
+ * @param data Series
+ */
+void MAIN_chart_data_unbind(MAIN_chart_data_t *data);
+
+/**
+ * @brief Add a sample, drawing just the newest column
+ * @param data Series
+ * @param value Sample
+ */
+void MAIN_chart_data_append(MAIN_chart_data_t *data, int32_t value);
+
+/**
+ * @brief Add many samples, then decimate and draw once
+ * @param data Series
+ * @param values Samples, oldest first (e.g. from MAIN_telemetry_get_series)
+ * @param count Samples
+ */
+void MAIN_chart_data_append_many(MAIN_chart_data_t *data, const int32_t *values, size_t count);
+
+/**
+ * @brief Drop every sample
+ * @param data Series
+ */
+void MAIN_chart_data_clear(MAIN_chart_data_t *data);
+
+/**
+ * @brief Series counters
+ * @param data Series
+ * @param stats Receives the counters
+ */
+void MAIN_chart_data_get_stats(const MAIN_chart_data_t *data, MAIN_chart_data_stats_t *stats);
+
+#endif // __MAIN_CHART_DATA_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_chartDataLib.h
+ ******************************************************************************/
@@ -0,0 +1,504 @@
+/**
+ * @file MAIN_consoleLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Serial diagnostics console with a static command registry
+ * @version 1.2.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_consoleLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_loggerLib.h"
+#include "EARS_sdCardLib.h"
+#include "MAIN_lvglLib.h"
+#include "MAIN_lvglLogLib.h"
+#include "MAIN_rtosStaticLib.h"
+#include "MAIN_screenshotLib.h"
+#include "MAIN_sysinfoLib.h"
+#include <esp_heap_caps.h>
+#include <stdarg.h>
+
+extern "C" size_t eez_flow_profile_write(void (*write)(const char *text, size_t length, void *ctx), void *ctx);
+extern "C" void eez_flow_profile_reset();
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+MAIN_STATIC_TASK(console_task, CONSOLE_TASK_STACK_SIZE);
+
+static char console_line[CONSOLE_LINE_SIZE];
+static uint8_t console_line_length = 0;
+static bool console_line_overflow = false;
+
+static const MAIN_console_cmd_t *console_commands[CONSOLE_MAX_COMMANDS];
+static uint8_t console_command_count = 0;
+
+static MAIN_console_stats_t console_stats = {};
+
+// Too big for the console stack
+static MAIN_cpu_stats_t console_cpu;
+
+// Screenshot requested, reported when MAIN_screenshotLib finishes
+static bool console_shot_waiting = false;
+static uint32_t console_shot_captures = 0;
+
+/******************************************************************************
+ * Static Functions
+ *****************************************************************************/
+
+/**
+ * @brief Write text whole, or drop it if the CDC buffer cannot take it
+ */
+static bool console_write(const char *text, size_t length)
+{
+    if (length == 0)
+    {
+        return true;
+    }
+    if ((size_t)Serial.availableForWrite() < length)
+    {
+        console_stats.dropped += length;
+        return false;
+    }
+    Serial.write((const uint8_t *)text, length);
+    return true;
+}
+
+static void console_cmd_help(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    for (uint8_t i = 0; i < console_command_count; i++)
+    {
+        const MAIN_console_cmd_t *cmd = console_commands[i];
+        MAIN_console_printf("  %-10s %-16s %s\n", cmd->name, cmd->args, cmd->help);
+    }
+}
+
+static void console_cmd_stats(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    char line[512];
+    size_t length = MAIN_lvgl_format_stats(line, sizeof(line));
+    for (size_t at = 0; at < length; at += CONSOLE_OUT_SIZE - 1)
+    {
+        size_t part = length - at < CONSOLE_OUT_SIZE - 1 ? length - at : CONSOLE_OUT_SIZE - 1;
+        console_write(line + at, part);
+    }
+    console_write("\n", 1);
+
+    MAIN_latency_stats_t latency;
+    MAIN_sysinfo_latency_get_stats(&latency);
+    MAIN_console_printf("Touch latency: p50=%lu p95=%lu p99=%lu max=%lu us over %u (dispatch p50=%lu us)\n",
+                        (unsigned long)latency.p50Us, (unsigned long)latency.p95Us,
+                        (unsigned long)latency.p99Us, (unsigned long)latency.maxUs, latency.count,
+                        (unsigned long)latency.dispatchP50Us);
+}
+
+static void console_cmd_heap(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    static const struct
+    {
+        const char *name;
+        uint32_t caps;
+    } pools[] = {{"Internal", MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT}, {"PSRAM", MALLOC_CAP_SPIRAM}};
+
+    for (uint8_t i = 0; i < sizeof(pools) / sizeof(pools[0]); i++)
+    {
+        MAIN_console_printf("%-8s free=%u low=%u largest=%u total=%u\n", pools[i].name,
+                            heap_caps_get_free_size(pools[i].caps), heap_caps_get_minimum_free_size(pools[i].caps),
+                            heap_caps_get_largest_free_block(pools[i].caps), heap_caps_get_total_size(pools[i].caps));
+    }
+}
+
+static void console_cmd_tasks(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    MAIN_sysinfo_profiler_sample(&console_cpu);
+    for (uint8_t core = 0; core < 2; core++)
+    {
+        if (console_cpu.cpuPercent[core] == SYSINFO_CPU_UNKNOWN)
+        {
+            MAIN_console_printf("Core %u CPU: n/a\n", core);
+        }
+        else
+        {
+            MAIN_console_printf("Core %u CPU: %.1f%% over %lu ms\n", core, console_cpu.cpuPercent[core],
+                                (unsigned long)console_cpu.windowMs);
+        }
+    }
+
+    MAIN_console_printf("Task             Core Prio   CPU  Stack free\n");
+    for (uint8_t i = 0; i < console_cpu.taskCount; i++)
+    {
+        const MAIN_task_stats_t &t = console_cpu.tasks[i];
+        if (t.cpuPercent == SYSINFO_CPU_UNKNOWN)
+        {
+            MAIN_console_printf("%-16s %4d %4u     -  %lu\n", t.name, t.core, t.priority,
+                                (unsigned long)t.stackFree);
+        }
+        else
+        {
+            MAIN_console_printf("%-16s %4d %4u %5.1f  %lu\n", t.name, t.core, t.priority, t.cpuPercent,
+                                (unsigned long)t.stackFree);
+        }
+    }
+}
+
+static void console_cmd_perf(int argc, char **argv)
+{
+    if (argc < 2 || strcmp(argv[1], "reset") != 0)
+    {
+        MAIN_console_printf("usage: perf reset\n");
+        return;
+    }
+    MAIN_lvgl_reset_stats();
+    MAIN_sysinfo_latency_reset();
+    MAIN_console_printf("Render, flush and latency counters reset\n");
+}
+
+static void console_cmd_log(int argc, char **argv)
+{
+    if (argc == 3 && strcmp(argv[1], "lvgl") == 0)
+    {
+        MAIN_console_printf(MAIN_lvgl_log_set_level_name(argv[2]) ? "LVGL log level %s\n"
+                                                                   : "Unknown level %s\n",
+                            argv[2]);
+        return;
+    }
+    if (argc == 2)
+    {
+        bool ok = EARS_logger::getInstance().setLogLevelFromString(String(argv[1]));
+        MAIN_console_printf(ok ? "Log level %s\n" : "Unknown level %s\n", argv[1]);
+        return;
+    }
+    MAIN_console_printf("Log level %s\n", EARS_logger::getInstance().getLogLevelString().c_str());
+}
+
+static void console_cmd_sdbench(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    if (!using_sdcard().isAvailable())
+    {
+        MAIN_console_printf("No card mounted\n");
+        return;
+    }
+
+    uint32_t writeKBps = 0;
+    uint32_t readKBps = 0;
+    bool ok = using_sdcard().runSelfTest(writeKBps, readKBps);
+    MAIN_console_printf("SD %s %d kHz: write %lu KB/s, read %lu KB/s%s\n",
+                        using_sdcard().isBus4bit() ? "4-bit" : "1-bit", using_sdcard().getBusFrequencyKhz(),
+                        (unsigned long)writeKBps, (unsigned long)readKBps, ok ? "" : " (verify FAILED)");
+}
+
+/**
+ * @brief Console task: report a screenshot once MAIN_screenshotLib is done
+ */
+static void console_screenshot_report(void)
+{
+    if (!console_shot_waiting || MAIN_screenshot_is_busy())
+    {
+        return;
+    }
+    console_shot_waiting = false;
+
+    MAIN_screenshot_stats_t stats;
+    MAIN_screenshot_get_stats(&stats);
+    if (stats.captures != console_shot_captures)
+    {
+        MAIN_console_printf("Screenshot %s (%lu bytes, %lu ms, %lu us in the frame)\n", stats.path,
+                            (unsigned long)stats.bytes, (unsigned long)stats.totalMs, (unsigned long)stats.frameUs);
+    }
+    else
+    {
+        MAIN_console_printf("Screenshot not saved\n");
+    }
+}
+
+static void console_cmd_screenshot(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    if (!using_sdcard().isAvailable())
+    {
+        MAIN_console_printf("No card mounted\n");
+        return;
+    }
+
+    MAIN_screenshot_stats_t stats;
+    MAIN_screenshot_get_stats(&stats);
+    console_shot_captures = stats.captures;
+    if (!MAIN_screenshot_capture())
+    {
+        MAIN_console_printf("Screenshot already in progress\n");
+        return;
+    }
+    console_shot_waiting = true;
+}
+
+/**
+ * @brief eez_flow_profile_write() writer: append to the profile file
+ */
+static void console_profile_append(const char *text, size_t length, void *ctx)
+{
+    bool *ok = (bool *)ctx;
+    *ok = using_sdcard().appendData(CONSOLE_FLOW_PROFILE_PATH, (const uint8_t *)text, length) && *ok;
+}
+
+static void console_cmd_flowprof(int argc, char **argv)
+{
+    if (argc == 2 && strcmp(argv[1], "reset") == 0)
+    {
+        eez_flow_profile_reset();
+        MAIN_console_printf("Flow profile reset\n");
+        return;
+    }
+    if (!using_sdcard().isAvailable())
+    {
+        MAIN_console_printf("No card mounted\n");
+        return;
+    }
+
+    using_sdcard().createDirectory("/bench");
+    using_sdcard().removeFile(CONSOLE_FLOW_PROFILE_PATH);
+    bool ok = true;
+    size_t length = eez_flow_profile_write(console_profile_append, &ok);
+    using_sdcard().flush(CONSOLE_FLOW_PROFILE_PATH);
+    if (length == 0)
+    {
+        MAIN_console_printf("No flow profile (build with -D EEZ_FLOW_PROFILER=1)\n");
+        return;
+    }
+    MAIN_console_printf(ok ? "Flow profile %s (%u bytes)\n" : "Flow profile %s not written\n",
+                        CONSOLE_FLOW_PROFILE_PATH, (unsigned)length);
+}
+
+static const MAIN_console_cmd_t console_builtin[] = {
+    {"help", "", "This list", console_cmd_help},
+    {"stats", "", "Render, flush and touch latency counters", console_cmd_stats},
+    {"heap", "", "Internal RAM and PSRAM", console_cmd_heap},
+    {"tasks", "", "CPU per core and task, stack headroom", console_cmd_tasks},
+    {"perf", "reset", "Zero the render, flush and latency counters", console_cmd_perf},
+    {"log", "[lvgl] <level>", "Logger (or LVGL) log level", console_cmd_log},
+    {"sdbench", "", "SD card write and read throughput", console_cmd_sdbench},
+    {"screenshot", "", "Next frame to " SCREENSHOT_DIR, console_cmd_screenshot},
+    {"flowprof", "[reset]", "Flow component profile to " CONSOLE_FLOW_PROFILE_PATH, console_cmd_flowprof},
+};
+
+/**
+ * @brief Find a command by name, built-in or registered
+ */
+static const MAIN_console_cmd_t *console_find(const char *name)
+{
+    for (uint8_t i = 0; i < console_command_count; i++)
+    {
+        if (strcmp(console_commands[i]->name, name) == 0)
+        {
+            return console_commands[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Split the line into words and run its command
+ */
+static void console_run_line(void)
+{
+    char *argv[CONSOLE_MAX_ARGS];
+    int argc = 0;
+    char *save = NULL;
+    for (char *word = strtok_r(console_line, " \t", &save); word != NULL && argc < CONSOLE_MAX_ARGS;
+         word = strtok_r(NULL, " \t", &save))
+    {
+        argv[argc++] = word;
+    }
+    if (argc == 0)
+    {
+        return;
+    }
+
+    console_stats.lines++;
+    const MAIN_console_cmd_t *cmd = console_find(argv[0]);
+    if (cmd == NULL)
+    {
+        console_stats.unknown++;
+        MAIN_console_printf("Unknown command '%s', try help\n", argv[0]);
+        return;
+    }
+    console_stats.commands++;
+    cmd->fn(argc, argv);
+}
+
+/**
+ * @brief Take what Serial has without waiting; run each complete line
+ */
+static void console_poll(void)
+{
+    int available = Serial.available();
+    while (available-- > 0)
+    {
+        int c = Serial.read();
+        if (c < 0)
+        {
+            break;
+        }
+
+        if (c == '\r' || c == '\n')
+        {
+            if (console_line_overflow)
+            {
+                console_stats.overflows++;
+                MAIN_console_printf("Line longer than %u characters ignored\n", CONSOLE_LINE_SIZE - 1);
+            }
+            else if (console_line_length > 0)
+            {
+                console_line[console_line_length] = '\0';
+                console_run_line();
+            }
+            console_line_length = 0;
+            console_line_overflow = false;
+        }
+        else if (c == '\b' || c == 0x7F)
+        {
+            if (console_line_length > 0)
+            {
+                console_line_length--;
+            }
+        }
+        else if (console_line_length < CONSOLE_LINE_SIZE - 1)
+        {
+            console_line[console_line_length++] = (char)c;
+        }
+        else
+        {
+            console_line_overflow = true;
+        }
+    }
+}
+
+static void console_task_fn(void *param)
+{
+    (void)param;
+    for (;;)
+    {
+        console_poll();
+        console_screenshot_report();
+        vTaskDelay(pdMS_TO_TICKS(CONSOLE_POLL_MS));
+    }
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Register the built-in commands and start the task
+ */
+bool MAIN_initialise_console(void)
+{
+#if EARS_CONSOLE == 1
+    for (uint8_t i = 0; i < sizeof(console_builtin) / sizeof(console_builtin[0]); i++)
+    {
+        console_commands[console_command_count++] = &console_builtin[i];
+    }
+
+#if EARS_DEBUG != 1
+    // Debug builds opened it in setup()
+    Serial.begin(EARS_DEBUG_BAUD_RATE);
+#endif
+
+    if (MAIN_STATIC_TASK_CREATE(console_task, console_task_fn, "Console", NULL, CONSOLE_TASK_PRIORITY,
+                                CONSOLE_TASK_CORE) == NULL)
+    {
+        return false;
+    }
+    DEBUG_PRINTLN("[OK] Console ready, type help");
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Add a command to the table after the built-in ones
+ */
+bool MAIN_console_register(const MAIN_console_cmd_t *cmd)
+{
+    if (console_command_count >= sizeof(console_commands) / sizeof(console_commands[0]) ||
+        console_find(cmd->name) != NULL)
+    {
+        return false;
+    }
+    console_commands[console_command_count++] = cmd;
+    return true;
+}
+
+/**
+ * @brief Format into the output buffer and write it whole or not at all
+ */
+bool MAIN_console_printf(const char *format, ...)
+{
+    static char out[CONSOLE_OUT_SIZE];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(out, sizeof(out), format, args);
+    va_end(args);
+    if (length < 0)
+    {
+        return false;
+    }
+    return console_write(out, (size_t)length < sizeof(out) ? (size_t)length : sizeof(out) - 1);
+}
+
+/**
+ * @brief Copy the counters
+ */
+void MAIN_console_get_stats(MAIN_console_stats_t *stats)
+{
+    *stats = console_stats;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Console_getLibraryName() {
+    return MAIN_Console::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Console_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Console::VERSION_MAJOR,
+                       MAIN_Console::VERSION_MINOR,
+                       MAIN_Console::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Console_getVersionDate() {
+    return MAIN_Console::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Console_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Console_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_consoleLib.cpp
+ ******************************************************************************/
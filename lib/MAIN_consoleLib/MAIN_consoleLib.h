@@ -0,0 +1,161 @@
+/**
+ * @file MAIN_consoleLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Serial diagnostics console with a static command registry
+ * @details Diagnostics were compile-time only (EARS_DEBUG, DEV_print_*) and
+ *          Serial was write-only, so a production unit could not be asked
+ *          for anything. With -D EARS_CONSOLE=1 (on in every build) a
+ *          console task reads the USB CDC port a line at a time and runs
+ *          the command the line names:
+ *
+ *          - help               commands and their arguments
+ *          - stats              LVGL render and flush counters, touch latency
+ *          - heap               internal RAM and PSRAM free, low water, largest block
+ *          - tasks              CPU per core, and per task with stack headroom
+ *          - perf reset         zero the render, flush and latency counters
+ *          - log <level>        logger level (NONE, ERROR, WARN, INFO, DEBUG)
+ *          - log lvgl <level>   LVGL log level
+ *          - sdbench            SD card write and read throughput
+ *          - screenshot         next frame to SCREENSHOT_DIR (MAIN_screenshotLib)
+ *          - flowprof [reset]   flow component profile to CONSOLE_FLOW_PROFILE_PATH
+ *                               (JSON, built with -D EEZ_FLOW_PROFILER=1)
+ *
+ *          Other libraries add theirs with MAIN_console_register(), from a
+ *          static table, and answer with MAIN_console_printf().
+ *
+ *          The task has the lowest priority (TASK_ROLE_CONSOLE) and polls
+ *          Serial every CONSOLE_POLL_MS without blocking. Each printf is
+ *          formatted into one CONSOLE_OUT_SIZE buffer and written only if
+ *          the CDC transmit buffer can take it whole; with no host reading,
+ *          output is dropped and counted rather than stalling the task.
+ *          screenshot only starts the capture; the result is printed when
+ *          MAIN_screenshotLib has written the file.
+ * @version 1.2.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_CONSOLE_LIB_H__
+#define __MAIN_CONSOLE_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include "EARS_taskPlanLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Console
+{
+    constexpr const char* LIB_NAME = "MAIN_Console";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "2";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_Console_getLibraryName();
+uint32_t MAIN_Console_getVersionEncoded();
+const char* MAIN_Console_getVersionDate();
+void MAIN_Console_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Console Configuration
+ *****************************************************************************/
+
+// 1 = console task reading commands from Serial
+#ifndef EARS_CONSOLE
+#define EARS_CONSOLE 1
+#endif
+
+#define CONSOLE_TASK_STACK_SIZE 4096
+#define CONSOLE_TASK_PRIORITY using_taskplan().priority(TASK_ROLE_CONSOLE)
+#define CONSOLE_TASK_CORE using_taskplan().core(TASK_ROLE_CONSOLE)
+
+// Serial polled this often (ms)
+#define CONSOLE_POLL_MS 50
+
+// Longest command line, and words taken from it
+#define CONSOLE_LINE_SIZE 96
+#define CONSOLE_MAX_ARGS 6
+
+// One MAIN_console_printf(), formatted
+#define CONSOLE_OUT_SIZE 192
+
+// flowprof writes the flow profile here
+#define CONSOLE_FLOW_PROFILE_PATH "/bench/flow_profile.json"
+
+// Commands MAIN_console_register() can add to the built-in ones
+#define CONSOLE_MAX_COMMANDS 16
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+/**
+ * @brief Command handler, on the console task
+ * @param argc Words on the line, the command name included
+ * @param argv The words (argv[0] is the command name)
+ */
+typedef void (*MAIN_console_fn_t)(int argc, char **argv);
+
+typedef struct
+{
+    const char *name; // First word of the line
+    const char *args; // Argument synopsis for help ("" = none)
+    const char *help; // One line for help
+    MAIN_console_fn_t fn;
+} MAIN_console_cmd_t;
+
+typedef struct
+{
+    uint32_t lines;     // Lines read
+    uint32_t commands;  // Lines that ran a command
+    uint32_t unknown;   // Lines naming no command
+    uint32_t overflows; // Lines longer than CONSOLE_LINE_SIZE, discarded
+    uint32_t dropped;   // Output bytes dropped with the CDC buffer full
+} MAIN_console_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Start the console task
+ * @return true if running (false with EARS_CONSOLE 0)
+ * @note After the UI task exists (screenshot arms the flush tap on it).
+ */
+bool MAIN_initialise_console(void);
+
+/**
+ * @brief Add a command
+ * @param cmd Command, kept by pointer (static storage)
+ * @return true if added (false: table full or the name is taken)
+ */
+bool MAIN_console_register(const MAIN_console_cmd_t *cmd);
+
+/**
+ * @brief Print to the console, dropping the text if the host is not reading
+ * @param format printf format
+ * @return true if written
+ * @note Console task (command handlers) only.
+ */
+bool MAIN_console_printf(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief Console counters
+ * @param stats Receives the counters
+ */
+void MAIN_console_get_stats(MAIN_console_stats_t *stats);
+
+#endif // __MAIN_CONSOLE_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_consoleLib.h
+ ******************************************************************************/
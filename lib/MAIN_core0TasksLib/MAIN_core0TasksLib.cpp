@@ -1,10 +1,16 @@
 /**
  * @file MAIN_core0TasksLib.cpp
  * @author Julian (51fiftyone51fiftyone@gmail.com)
- * @brief Core 0 UI Task implementation with animation support
- * @details Manages Core 0 UI task - LVGL processing at 200Hz + Animation updates
- * @version 1.1.0
- * @date 20260210
+ * @brief Core 0 UI Task implementation
+ * @details Manages Core 0 UI task - event driven LVGL processing. The startup
+ *          animation runs from its own LVGL timer (MAIN_animationLib). With the
+ *          flow worker task (MAIN_flowTaskLib) the UI commands it posts are
+ *          applied here, before each LVGL pass, as are the widget updates
+ *          queued by Core 1 through MAIN_uiCommandLib. The task beats to
+ *          MAIN_healthLib every pass, and checks the auto-lock after the
+ *          screensaver (MAIN_lockLib).
+ * @version 1.17.0
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -14,20 +20,202 @@
  *****************************************************************************/
 #include "MAIN_core0TasksLib.h"
 #include "EARS_systemDef.h"
-// #include "MAIN_animationLib.h"  // NEW! Animation support
 #include <lvgl.h>
+#include "MAIN_lvglLib.h"
+#include "MAIN_displayLib.h"
+#include "MAIN_flowTaskLib.h"
+#include "MAIN_uiCommandLib.h"
+#include "MAIN_uiTxnLib.h"
+#include "EARS_screenSaverLib.h"
+#include "EARS_touchLib.h"
+#include "MAIN_resumeLib.h"
+#include "MAIN_lockLib.h"
+#include "MAIN_healthLib.h"
+#include "MAIN_powerMonitorLib.h"
+#include "MAIN_rtosStaticLib.h"
 
-// Development tools (compile out in production)
-#if EARS_DEBUG == 1
-#include "MAIN_developmentFeaturesLib.h"
-#endif
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+// UI task handle (target of wake notifications)
+static TaskHandle_t core0_task_handle = NULL;
+
+// UI task stack and TCB
+MAIN_STATIC_TASK(core0_task, CORE0_STACK_SIZE);
+
+// Refresh governor state (UI task only)
+typedef struct
+{
+    lv_obj_t *screen;
+    MAIN_refresh_level_t level;
+} core0_screen_refresh_t;
+
+static core0_screen_refresh_t screen_refresh[CORE0_REFRESH_SCREENS];
+static MAIN_refresh_level_t refresh_level = MAIN_REFRESH_ACTIVE;
+static uint32_t refresh_applied_ms = 0; // Period on the refresh timer, 0 = still LV_DEF_REFR_PERIOD
+
+// Display refresh period and task period floor per level
+static const uint32_t refresh_period_ms[3] = {CORE0_REFR_ACTIVE_MS, CORE0_REFR_STATIC_MS, CORE0_REFR_SAVER_MS};
+static const uint32_t refresh_min_ms[3] = {CORE0_MIN_PERIOD_MS, CORE0_MIN_STATIC_MS, CORE0_MIN_SAVER_MS};
+
+// Panel power state per level (frame rate, idle mode, backlight scale)
+static const MAIN_display_power_t refresh_power[3] = {MAIN_DISPLAY_POWER_NORMAL, MAIN_DISPLAY_POWER_STATIC,
+                                                      MAIN_DISPLAY_POWER_SAVER};
 
 /******************************************************************************
- * External Global Variables
+ * Refresh Governor
  *****************************************************************************/
 
-// Animation object created in main.cpp
-// extern lv_obj_t* g_animation_img;
+/**
+ * @brief Check for motion that needs the full frame rate
+ * @return true if an animation runs or an input device is pressed or scrolling
+ */
+static bool core0_ui_in_motion(void)
+{
+    if (lv_anim_count_running() > 0)
+    {
+        return true;
+    }
+
+    for (lv_indev_t *indev = lv_indev_get_next(NULL); indev != NULL; indev = lv_indev_get_next(indev))
+    {
+        if (lv_indev_get_state(indev) == LV_INDEV_STATE_PRESSED || lv_indev_get_scroll_obj(indev) != NULL)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Set the touch controller's scan rate for what the UI is doing
+ * @param level Refresh level just applied
+ * @details A press that moves or scrolls is a drag; the screensaver, or
+ *          CORE0_TOUCH_IDLE_MS without input, is idle.
+ */
+static void core0_touch_scan_update(MAIN_refresh_level_t level)
+{
+    lv_indev_t *indev = using_touch().getInputDevice();
+    if (indev == NULL)
+    {
+        return;
+    }
+
+    bool dragging = false;
+    if (lv_indev_get_state(indev) == LV_INDEV_STATE_PRESSED)
+    {
+        lv_point_t vect;
+        lv_indev_get_vect(indev, &vect);
+        dragging = lv_indev_get_scroll_obj(indev) != NULL || vect.x != 0 || vect.y != 0;
+    }
+    bool idle = level == MAIN_REFRESH_SAVER || lv_display_get_inactive_time(NULL) >= CORE0_TOUCH_IDLE_MS;
+    using_touch().updateScanRate(dragging, idle);
+}
+
+/**
+ * @brief Pick the refresh level and apply it to the display refresh timer
+ * @return uint32_t Minimum task period for the level in ms
+ */
+static uint32_t core0_refresh_governor_update(void)
+{
+    MAIN_refresh_level_t level = MAIN_REFRESH_ACTIVE;
+
+    if (using_screensaver().isActive())
+    {
+        level = MAIN_REFRESH_SAVER;
+    }
+    else if (!core0_ui_in_motion())
+    {
+        // On a low battery even untargeted screens idle at STATIC
+        if (MAIN_power_monitor_is_low())
+        {
+            level = MAIN_REFRESH_STATIC;
+        }
+
+        lv_obj_t *screen = lv_screen_active();
+        for (uint8_t i = 0; i < CORE0_REFRESH_SCREENS; i++)
+        {
+            if (screen_refresh[i].screen == screen && screen != NULL)
+            {
+                level = screen_refresh[i].level;
+                break;
+            }
+        }
+    }
+
+    // The refresh timer is only touched when the level changes, or when TE
+    // pacing starts or stops and the period moves to or from whole panel refreshes
+    uint32_t period = MAIN_lvgl_align_refresh_period(refresh_period_ms[level]);
+    lv_display_t *disp = lv_display_get_default();
+    if ((level != refresh_level || period != refresh_applied_ms) && disp != NULL)
+    {
+        lv_timer_t *refr = lv_display_get_refr_timer(disp);
+        if (refr != NULL)
+        {
+            refresh_applied_ms = period;
+            lv_timer_set_period(refr, period);
+            if (level < refresh_level)
+            {
+                // Speeding up: redraw now rather than at the end of the slow period
+                lv_timer_ready(refr);
+            }
+        }
+        refresh_level = level;
+    }
+
+    // Back to full power before the first moving frame is flushed
+    MAIN_display_set_power_state(refresh_power[refresh_level]);
+
+#if CORE0_TOUCH_SCAN == 1
+    // Report rate up for a drag before its next sample, down when idle
+    core0_touch_scan_update(refresh_level);
+#endif
+
+    return refresh_min_ms[refresh_level];
+}
+
+/**
+ * @brief Set the refresh level a screen settles to when nothing moves
+ */
+bool MAIN_core0_set_screen_refresh(lv_obj_t *screen, MAIN_refresh_level_t level)
+{
+    if (screen == NULL)
+    {
+        return false;
+    }
+
+    core0_screen_refresh_t *slot = NULL;
+    for (uint8_t i = 0; i < CORE0_REFRESH_SCREENS; i++)
+    {
+        if (screen_refresh[i].screen == screen)
+        {
+            slot = &screen_refresh[i];
+            break;
+        }
+        if (slot == NULL && screen_refresh[i].screen == NULL)
+        {
+            slot = &screen_refresh[i];
+        }
+    }
+    if (slot == NULL)
+    {
+        return false;
+    }
+
+    // ACTIVE is the default, so it frees the slot
+    slot->screen = (level == MAIN_REFRESH_ACTIVE) ? NULL : screen;
+    slot->level = level;
+    return true;
+}
+
+/**
+ * @brief Get the level the governor applied on the last pass
+ */
+MAIN_refresh_level_t MAIN_core0_get_refresh_level(void)
+{
+    return refresh_level;
+}
 
 /******************************************************************************
  * Core 0 UI Task Function
@@ -36,48 +224,120 @@
 /**
  * @brief Core 0 UI Task (runs on Core 0)
  * @param parameter Task parameter (unused)
- * @details Handles LVGL UI processing at 200Hz + Animation frame updates
+ * @details Handles LVGL UI processing at up to 200Hz, less when the refresh
+ *          governor settles on a slower level
  *
  * This task is responsible for:
- * - Running LVGL timer handler (updates widgets, animations)
+ * - Running LVGL timer handler (updates widgets, animations, the startup
+ *   animation's frame timer)
  * - Processing UI events
- * - Updating animation frames (marching soldier)
  * - Maintaining smooth display updates
+ * - Heartbeats to the health monitor, with the phase it is in
  * - Future: Touch input processing, transitions
  */
 void MAIN_core0_ui_task(void *parameter)
 {
-    /* #if EARS_DEBUG == 1
-        Serial.println("[CORE0] UI Task started");
-        if (g_animation_img != NULL)
-        {
-            Serial.println("[CORE0] Animation enabled - soldier will march!");
-        }
-    #endif
-     */
     TickType_t xLastWakeTime = xTaskGetTickCount();
-    const TickType_t xFrequency = pdMS_TO_TICKS(1000 / CORE0_FREQUENCY_HZ); // 5ms for 200Hz
+    uint32_t minPeriodMs = CORE0_MIN_PERIOD_MS; // 5ms for 200Hz, raised by the governor
+    MAIN_health_id_t health = MAIN_health_register(CORE0_HEALTH_DEADLINE_MS, NULL);
 
     while (1)
     {
-#if EARS_DEBUG == 1
-        DEV_increment_core0_heartbeat();
+        MAIN_health_beat(health);
+
+        // LVGL work queued by the flow worker task (none without it)
+        MAIN_health_phase(health, "flow commands");
+        MAIN_flow_apply_ui_commands(FLOW_UI_BATCH);
+
+        // Widget updates posted by Core 1 and other background tasks
+        MAIN_health_phase(health, "ui commands");
+        MAIN_ui_cmd_apply(UI_CMD_BATCH);
+
+#if CORE0_REFRESH_GOVERNOR == 1
+        // Refresh period and task cadence for what is on screen now
+        minPeriodMs = core0_refresh_governor_update();
 #endif
 
+        // A UI transaction left open would keep this frame's changes off screen
+        MAIN_ui_txn_close_all();
+
         // Run LVGL task handler (processes timers, animations, redraws)
-        lv_timer_handler();
-
-        // Update animation frame if animation object exists
-        /*         if (g_animation_img != NULL)
-                {
-                    MAIN_update_animation_frame(g_animation_img);
-                }
-         */
-        // Wait for next cycle
-        vTaskDelayUntil(&xLastWakeTime, xFrequency);
+        MAIN_health_phase(health, "lv_timer_handler");
+        uint32_t nextMs = MAIN_lvgl_timer_handler();
+
+        // Screensaver timeout, touch wake and deep idle (needs LVGL context)
+        MAIN_health_phase(health, "screensaver");
+        using_screensaver().update();
+
+        // Auto-lock on inactivity; the lock panel steps aside for the screensaver
+        MAIN_health_phase(health, "lock");
+        MAIN_lock_update();
+
+        // Long deep idle ends in deep sleep (-D EARS_DEEP_SLEEP=1)
+        MAIN_resume_update();
+        MAIN_health_phase(health, "sleep");
+
+        // Rate limit: never service LVGL more often than the level allows
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(minPeriodMs));
+
+        // Sleep until the next LVGL timer is due, or until woken early
+        if (using_screensaver().isDeepIdle())
+        {
+            // LVGL timers are suspended, only the touch check is due
+            nextMs = CORE0_DEEP_IDLE_PERIOD_MS;
+        }
+        else if (nextMs > CORE0_MAX_PERIOD_MS)
+        {
+            nextMs = CORE0_MAX_PERIOD_MS;
+        }
+        if (nextMs > minPeriodMs)
+        {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(nextMs - minPeriodMs));
+        }
+        else
+        {
+            // Clear any wake that arrived while LVGL was already running
+            ulTaskNotifyTake(pdTRUE, 0);
+        }
+        xLastWakeTime = xTaskGetTickCount();
+    }
+}
+
+/**
+ * @brief Wake the UI task early (task context)
+ */
+void MAIN_core0_request_update(void)
+{
+    if (core0_task_handle != NULL)
+    {
+        xTaskNotifyGive(core0_task_handle);
     }
 }
 
+/**
+ * @brief Wake the UI task early (ISR context)
+ */
+void IRAM_ATTR MAIN_core0_request_update_from_isr(void)
+{
+    if (core0_task_handle != NULL)
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        vTaskNotifyGiveFromISR(core0_task_handle, &xHigherPriorityTaskWoken);
+        if (xHigherPriorityTaskWoken == pdTRUE)
+        {
+            portYIELD_FROM_ISR();
+        }
+    }
+}
+
+/**
+ * @brief Get the Core 0 UI task handle
+ */
+TaskHandle_t MAIN_core0_get_task_handle(void)
+{
+    return core0_task_handle;
+}
+
 /******************************************************************************
  * Task Creation Function
  *****************************************************************************/
@@ -100,18 +360,11 @@ bool MAIN_create_core0_task(TaskHandle_t *taskHandle)
     Serial.println("[INIT] Creating Core 0 UI task...");
 #endif
 
-    // Create Core 0 UI Task
-    BaseType_t result = xTaskCreatePinnedToCore(
-        MAIN_core0_ui_task,
-        "Core0_UI",
-        CORE0_STACK_SIZE,
-        NULL,
-        CORE0_PRIORITY,
-        taskHandle,
-        0 // Pin to Core 0
-    );
-
-    if (result != pdPASS || *taskHandle == NULL)
+    // Create Core 0 UI Task (stack and TCB outside the heap)
+    *taskHandle = MAIN_STATIC_TASK_CREATE(core0_task, MAIN_core0_ui_task, "Core0_UI", NULL, CORE0_PRIORITY,
+                                          CORE0_CORE);
+
+    if (*taskHandle == NULL)
     {
 #if EARS_DEBUG == 1
         Serial.println("[ERROR] Failed to create Core 0 UI task!");
@@ -119,6 +372,17 @@ bool MAIN_create_core0_task(TaskHandle_t *taskHandle)
         return false;
     }
 
+    core0_task_handle = *taskHandle;
+
+    // Let the flush task wake the UI task when a frame reaches the panel
+    MAIN_lvgl_set_wake_task(core0_task_handle);
+
+    // And the flow worker task when it queues UI commands
+    MAIN_flow_task_set_ui_task(core0_task_handle);
+
+    // And background tasks when they post widget updates
+    MAIN_ui_cmd_set_ui_task(core0_task_handle);
+
 #if EARS_DEBUG == 1
     Serial.println("[OK] Core 0 UI task created");
 #endif
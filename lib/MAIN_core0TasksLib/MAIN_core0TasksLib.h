@@ -2,9 +2,27 @@
  * @file MAIN_core0TasksLib.h
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief Core 0 UI Task management for EARS (extracted from main.cpp)
- * @details Manages Core 0 UI task - LVGL processing at 200Hz
- * @version 0.1.0
- * @date 20260204
+ * @details Manages Core 0 UI task - LVGL processing, event driven.
+ *          The task sleeps for the delay returned by lv_timer_handler and is
+ *          woken early by task notifications (touch, flush complete, Core 1
+ *          UI update requests). In screensaver deep idle LVGL timers are
+ *          suspended and the task only wakes to check for a touch.
+ *          A refresh governor picks the display refresh period and the
+ *          task's minimum service period together: full rate while
+ *          animations run or the panel is touched or scrolling, a per-screen
+ *          target otherwise, and a slow tick under the screensaver.
+ *          Each level also sets the panel power state (MAIN_displayLib),
+ *          and the governor sets the touch scan rate with it: fastest
+ *          during drags and scrolls, monitor mode under the screensaver or
+ *          after CORE0_TOUCH_IDLE_MS without input.
+ *          While the battery is low and not charging, screens without a
+ *          target settle to MAIN_REFRESH_STATIC as well.
+ *          Periods are rounded to whole panel refreshes while flushes are
+ *          paced by the panel's TE output (MAIN_lvgl_align_refresh_period).
+ *          The task runs on Core 1 under EARS_taskPlanLib's radio plan,
+ *          away from the Wi-Fi/BT stacks; the name is kept.
+ * @version 1.17.0
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -20,6 +38,8 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include "EARS_versionDef.h"
+#include "EARS_taskPlanLib.h"
+#include <lvgl.h>
 
 /******************************************************************************
  * Library Version Information
@@ -28,23 +48,60 @@ namespace MAIN_Core0Tasks
 {
     constexpr const char* LIB_NAME = "MAIN_Core0Tasks";
     constexpr const char* VERSION_MAJOR = "1";
-    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_MINOR = "17";
     constexpr const char* VERSION_PATCH = "0";
-    constexpr const char* VERSION_DATE = "2026-02-04";
+    constexpr const char* VERSION_DATE = "2026-10-15";
 }
 
 /******************************************************************************
  * Core 0 Configuration
  *****************************************************************************/
 
-// Stack size (in words, not bytes)
+// Stack size (bytes, static: MAIN_rtosStaticLib)
 #define CORE0_STACK_SIZE 8192
 
-// Task priority
-#define CORE0_PRIORITY 2
+// Task priority and placement (EARS_taskPlanLib: Core 1 while the radios are in use)
+#define CORE0_PRIORITY using_taskplan().priority(TASK_ROLE_UI)
+#define CORE0_CORE using_taskplan().core(TASK_ROLE_UI)
 
 // Task update frequency
-#define CORE0_FREQUENCY_HZ 200 // 200Hz for smooth LVGL
+#define CORE0_FREQUENCY_HZ 200 // Upper bound on LVGL service rate (200Hz)
+
+// Sleep bounds between lv_timer_handler calls
+#define CORE0_MIN_PERIOD_MS (1000 / CORE0_FREQUENCY_HZ) // Never service faster than this
+#define CORE0_MAX_PERIOD_MS 500                         // Cap when LVGL has no timers pending
+#define CORE0_DEEP_IDLE_PERIOD_MS 100                   // Touch check period in deep idle
+
+// Health monitor: longest time between passes before it counts as a stall
+#define CORE0_HEALTH_DEADLINE_MS 2000
+
+// Refresh governor: display refresh period / minimum task period per level
+#define CORE0_REFRESH_GOVERNOR 1      // 0 = fixed LV_DEF_REFR_PERIOD and CORE0_MIN_PERIOD_MS
+#define CORE0_REFR_ACTIVE_MS 16       // 60 fps: animations, touch, scrolling
+#define CORE0_REFR_STATIC_MS 100      // 10 fps: data screens with nothing moving
+#define CORE0_REFR_SAVER_MS 500       // 2 fps: screensaver
+#define CORE0_MIN_STATIC_MS 20        // Task period floor at STATIC (touch still wakes it)
+#define CORE0_MIN_SAVER_MS 100        // Task period floor under the screensaver
+#define CORE0_REFRESH_SCREENS 8       // Screens with their own target
+
+// Touch scan rate from the governor (EARS_touch::updateScanRate)
+#define CORE0_TOUCH_SCAN 1            // 0 = controller keeps its default rate
+#define CORE0_TOUCH_IDLE_MS 30000     // No input this long: monitor mode
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+/**
+ * @enum MAIN_refresh_level_t
+ * @brief Refresh governor levels, fastest first
+ */
+enum MAIN_refresh_level_t
+{
+    MAIN_REFRESH_ACTIVE = 0, // CORE0_REFR_ACTIVE_MS
+    MAIN_REFRESH_STATIC,     // CORE0_REFR_STATIC_MS
+    MAIN_REFRESH_SAVER       // CORE0_REFR_SAVER_MS
+};
 
 /******************************************************************************
  * Function Prototypes
@@ -61,7 +118,8 @@ bool MAIN_create_core0_task(TaskHandle_t *taskHandle);
 /**
  * @brief Core 0 UI Task function (runs on Core 0)
  * @param parameter Task parameter (unused)
- * @details Handles LVGL UI processing at 200Hz
+ * @details Runs lv_timer_handler, then sleeps until the next LVGL timer is
+ *          due or a wake notification arrives, whichever is first
  *
  * Responsibilities:
  * - LVGL timer handler (lv_timer_handler)
@@ -71,6 +129,42 @@ bool MAIN_create_core0_task(TaskHandle_t *taskHandle);
  */
 void MAIN_core0_ui_task(void *parameter);
 
+/**
+ * @brief Wake the UI task early (task context)
+ * @details Call from Core 1 after queuing UI work, or from any task that
+ *          changed state LVGL should render promptly
+ */
+void MAIN_core0_request_update(void);
+
+/**
+ * @brief Wake the UI task early (ISR context)
+ * @details For use from GPIO interrupts such as the touch INT line
+ */
+void IRAM_ATTR MAIN_core0_request_update_from_isr(void);
+
+/**
+ * @brief Set the refresh level a screen settles to when nothing moves
+ * @details Screens without a target run at MAIN_REFRESH_ACTIVE. Animations,
+ *          a pressed or scrolling input device and the screensaver override
+ *          the target. LVGL task only.
+ * @param screen Screen object (lv_screen_active() while it is shown)
+ * @param level MAIN_REFRESH_STATIC for data screens, MAIN_REFRESH_ACTIVE to clear
+ * @return true if stored, false if all CORE0_REFRESH_SCREENS slots are used
+ */
+bool MAIN_core0_set_screen_refresh(lv_obj_t *screen, MAIN_refresh_level_t level);
+
+/**
+ * @brief Get the level the governor applied on the last pass
+ * @return MAIN_refresh_level_t Current level
+ */
+MAIN_refresh_level_t MAIN_core0_get_refresh_level(void);
+
+/**
+ * @brief Get the Core 0 UI task handle
+ * @return TaskHandle_t UI task handle (NULL if not created)
+ */
+TaskHandle_t MAIN_core0_get_task_handle(void);
+
 /******************************************************************************
  * Version Information Getters
  *****************************************************************************/
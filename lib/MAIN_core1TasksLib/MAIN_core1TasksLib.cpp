@@ -2,9 +2,11 @@
  * @file MAIN_core1TasksLib.cpp
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief Core 1 Background Task implementation (extracted from main.cpp)
- * @details Manages Core 1 background task - System initialization and monitoring
- * @version 0.1.0
- * @date 20260204
+ * @details Manages Core 1 background task - the background services run as
+ *          MAIN_jobSchedulerLib jobs (NVS and SD are brought up by the boot
+ *          orchestrator in setup)
+ * @version 1.21.0
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -14,14 +16,216 @@
  *****************************************************************************/
 #include "MAIN_core1TasksLib.h"
 #include "EARS_systemDef.h"
-#include "MAIN_initializationLib.h"  // For MAIN_initialise_nvs() and MAIN_initialise_sd()
+#include "EARS_loggerLib.h"         // Buffered log flushing
+#include "EARS_sdCardLib.h"         // Coalesced config commits
+#include "EARS_configLib.h"         // Debounced ears.config write-back
+#include "EARS_recordStoreLib.h"    // Record index checkpoints
+#include "EARS_searchIndexLib.h"    // Search segment checkpoints
+#include "EARS_auditLib.h"          // Audit trail checkpoints
+#include "EARS_peerSyncLib.h"       // Peer-to-peer record deltas
+#include "EARS_recordTransferLib.h" // Bulk import/export slices
+#include "EARS_reportLib.h"         // Report generation slices
+#include "EARS_bleTransferLib.h"    // Report transfer slices
+#include "EARS_errorsLib.h"         // Queued error resolution
+#include "EARS_nvsEepromLib.h"      // Deferred NVS write-back
+#include "EARS_backLightManagerLib.h" // Backlight policy controller
+#include "EARS_screenSaverLib.h"     // Deep idle state
+#include "EARS_eventBusLib.h"        // System event dispatch
+#include "EARS_timeLib.h"            // RTC drift correction and write-back
+#include "MAIN_jobSchedulerLib.h"    // Background jobs
+#include "MAIN_healthLib.h"          // Heartbeat deadline
+#include "EARS_profileLib.h"         // Profiler zone reports
+#include "EARS_rtosTraceLib.h"       // Scheduling trace save
+#include "MAIN_rtosStaticLib.h"      // Task stack outside the heap
+#include "MAIN_usbMscLib.h"          // SD card handover to USB
 
 // Development tools (compile out in production)
 #if EARS_DEBUG == 1
 #include "MAIN_ledLib.h"
-#include "MAIN_developmentFeaturesLib.h"
+#include "EARS_touchLib.h"
 #endif
 
+// Background task stack and TCB
+MAIN_STATIC_TASK(core1_task, CORE1_STACK_SIZE);
+
+/******************************************************************************
+ * Core 1 Jobs
+ *****************************************************************************/
+
+// Deliver posted system events to their subscribers
+static void core1_job_events(void *ctx)
+{
+    using_eventbus().dispatch();
+}
+
+// Resolve errors raised from ISRs and Core 0
+static void core1_job_errors(void *ctx)
+{
+    errorsLib.processPending();
+}
+
+// Apply idle/battery/screen backlight policies
+static void core1_job_backlight(void *ctx)
+{
+    using_backlightmanager().service();
+}
+
+// Write out buffered log lines once they are old enough
+static void core1_job_logger(void *ctx)
+{
+    EARS_logger::getInstance().tick();
+}
+
+// Compress rotated logs a step at a time
+static void core1_job_log_compress(void *ctx)
+{
+    EARS_logger::getInstance().serviceCompression();
+}
+
+#if EARS_PEER_SYNC == 1
+// Exchange record deltas with nearby units
+static void core1_job_peer_sync(void *ctx)
+{
+    using_peersync().service();
+}
+#endif
+
+// Commit coalesced config writes once they have settled, then lend the
+// card to USB or take it back between passes
+static void core1_job_sdcard(void *ctx)
+{
+    using_sdcard().service();
+    MAIN_usb_msc_service();
+}
+
+// Write back settled ears.config section changes
+static void core1_job_config(void *ctx)
+{
+    using_config().service();
+}
+
+// Checkpoint record store indexes once writes have settled
+static void core1_job_records(void *ctx)
+{
+    using_equipment().service();
+    using_ammunition().service();
+    using_equipment_search().service();
+}
+
+#if EARS_AUDIT == 1
+// Sign an audit checkpoint once appends have settled
+static void core1_job_audit(void *ctx)
+{
+    using_audit().service();
+}
+#endif
+
+// Run the next slice of a bulk import or export
+static void core1_job_transfer(void *ctx)
+{
+    using_transfer().service();
+}
+
+// Run the next slice of a report
+static void core1_job_report(void *ctx)
+{
+    using_report().service();
+}
+
+#if EARS_BLE_TRANSFER == 1
+// Queue the next slice of a file to the phone
+static void core1_job_ble_transfer(void *ctx)
+{
+    using_bletransfer().service();
+}
+#endif
+
+// Write back settled NVS shadow changes (backlight)
+static void core1_job_nvs(void *ctx)
+{
+    using_nvseeprom().service();
+}
+
+// Re-read the RTC, write it back after an NTP or GPS sync
+static void core1_job_clock(void *ctx)
+{
+    using_time().service();
+}
+
+#if EARS_PROFILE == 1
+// Print and save the profiler zones of the last period, then start a new one
+static void core1_job_profile(void *ctx)
+{
+    EARS_PROFILE_PRINT();
+    EARS_PROFILE_SAVE();
+    EARS_PROFILE_RESET();
+}
+#endif
+
+#if EARS_RTOS_TRACE == 1
+// Save the scheduling trace once its capture has ended
+static void core1_job_rtos_trace(void *ctx)
+{
+    using_rtostrace().service();
+}
+#endif
+
+#if EARS_DEBUG == 1
+// Heartbeat, green LED toggled every 500ms (1Hz), buffered touch samples
+static void core1_job_heartbeat(void *ctx)
+{
+    static uint32_t ticks = 0;
+
+    if (++ticks % 5 == 0)
+    {
+        MAIN_led_green_toggle();
+    }
+
+    // Print buffered touch samples away from the UI task
+    using_touch().flushTrace();
+}
+#endif
+
+/**
+ * @brief Register the background services as scheduler jobs
+ */
+static void core1_register_jobs(void)
+{
+    const uint32_t period = 1000 / CORE1_FREQUENCY_HZ;
+
+    MAIN_job_add("events", core1_job_events, NULL, 0, CORE1_EVENT_PERIOD_MS, JOB_PRIORITY_HIGH, CORE1_EVENT_PERIOD_MS);
+    MAIN_job_add("errors", core1_job_errors, NULL, 0, period, JOB_PRIORITY_HIGH, period);
+    MAIN_job_add("backlight", core1_job_backlight, NULL, 0, period, JOB_PRIORITY_NORMAL, period);
+    MAIN_job_add("logger", core1_job_logger, NULL, 0, period, JOB_PRIORITY_LOW, period);
+    MAIN_job_add("log compress", core1_job_log_compress, NULL, 0, LOGGER_COMPRESS_PERIOD_MS, JOB_PRIORITY_LOW, 0);
+    MAIN_job_add("sdcard", core1_job_sdcard, NULL, 0, period, JOB_PRIORITY_LOW, period);
+    MAIN_job_add("config", core1_job_config, NULL, 0, period, JOB_PRIORITY_LOW, period);
+    MAIN_job_add("records", core1_job_records, NULL, 0, period, JOB_PRIORITY_LOW, period);
+#if EARS_AUDIT == 1
+    MAIN_job_add("audit", core1_job_audit, NULL, AUDIT_SERVICE_PERIOD_MS, AUDIT_SERVICE_PERIOD_MS, JOB_PRIORITY_LOW, 0);
+#endif
+#if EARS_PEER_SYNC == 1
+    MAIN_job_add("peer sync", core1_job_peer_sync, NULL, 0, PEERSYNC_SERVICE_MS, JOB_PRIORITY_LOW, 0);
+#endif
+    MAIN_job_add("transfer", core1_job_transfer, NULL, 0, TRANSFER_SERVICE_PERIOD_MS, JOB_PRIORITY_LOW, 0);
+    MAIN_job_add("report", core1_job_report, NULL, 0, REPORT_SERVICE_PERIOD_MS, JOB_PRIORITY_LOW, 0);
+#if EARS_BLE_TRANSFER == 1
+    MAIN_job_add("ble transfer", core1_job_ble_transfer, NULL, 0, BLEXFER_SERVICE_PERIOD_MS, JOB_PRIORITY_LOW, 0);
+#endif
+    MAIN_job_add("nvs", core1_job_nvs, NULL, 0, period, JOB_PRIORITY_LOW, period);
+    MAIN_job_add("clock", core1_job_clock, NULL, TIME_SERVICE_PERIOD_MS, TIME_SERVICE_PERIOD_MS, JOB_PRIORITY_LOW, 0);
+#if EARS_PROFILE == 1
+    MAIN_job_add("profile", core1_job_profile, NULL, PROFILE_REPORT_MS, PROFILE_REPORT_MS, JOB_PRIORITY_LOW, 0);
+#endif
+#if EARS_RTOS_TRACE == 1
+    MAIN_job_add("rtos trace", core1_job_rtos_trace, NULL, RTOS_TRACE_SERVICE_MS, RTOS_TRACE_SERVICE_MS,
+                 JOB_PRIORITY_LOW, 0);
+#endif
+#if EARS_DEBUG == 1
+    MAIN_job_add("heartbeat", core1_job_heartbeat, NULL, 0, period, JOB_PRIORITY_LOW, 0);
+#endif
+}
+
 /******************************************************************************
  * Core 1 Background Task Function
  *****************************************************************************/
@@ -29,13 +233,13 @@
 /**
  * @brief Core 1 Background Task (runs on Core 1)
  * @param parameter Task parameter (unused)
- * @details Handles system initialization and background monitoring at 10Hz
+ * @details Runs the background job scheduler (MAIN_jobSchedulerLib)
  *
  * This task is responsible for:
- * - One-time initialization (NVS, SD card)
- * - System monitoring and maintenance
+ * - Running every registered job when it is due, sleeping in between
+ * - Heartbeats to the health monitor between scheduler passes
  * - LED heartbeat indication
- * - Future: WiFi, BLE, sensor polling, data logging
+ * - Future: WiFi, BLE, sensor polling, data logging (register as jobs)
  */
 void MAIN_core1_background_task(void *parameter)
 {
@@ -43,34 +247,27 @@ void MAIN_core1_background_task(void *parameter)
     Serial.println("[CORE1] Background Task started");
 #endif
 
-    // One-time initialization tasks
-    MAIN_initialise_nvs();
-    MAIN_initialise_sd();
+    MAIN_job_scheduler_set_task(xTaskGetCurrentTaskHandle());
+    core1_register_jobs();
+
+    // A stall is pinned on the job that was running
+    MAIN_health_id_t health = MAIN_health_register(CORE1_HEALTH_DEADLINE_MS, MAIN_job_get_running);
 
-    // Continuous background loop
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    const TickType_t xFrequency = pdMS_TO_TICKS(1000 / CORE1_FREQUENCY_HZ); // 100ms for 10Hz
+    const uint32_t idlePeriodMs = 1000 / CORE1_DEEP_IDLE_FREQUENCY_HZ;
 
     while (1)
     {
-#if EARS_DEBUG == 1
-        DEV_increment_core1_heartbeat();
+        MAIN_health_beat(health);
+
+        bool deepIdle = using_screensaver().isDeepIdle();
+        uint32_t nextMs = MAIN_job_scheduler_run(deepIdle);
 
-        // Toggle green LED every 500ms (heartbeat at 1Hz)
-        if (DEV_get_core1_heartbeat() % 5 == 0)
+        // Longer sleeps in deep idle so the CPU can sleep; new jobs still wake the task
+        if (deepIdle && nextMs < idlePeriodMs)
         {
-            MAIN_led_green_toggle();
+            nextMs = idlePeriodMs;
         }
-#endif
-
-        // Future: Add background monitoring tasks here
-        // - Check system health
-        // - Monitor temperatures
-        // - Handle WiFi/BLE
-        // - Log data to SD card
-
-        // Wait for next cycle
-        vTaskDelayUntil(&xLastWakeTime, xFrequency);
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(nextMs));
     }
 }
 
@@ -96,18 +293,11 @@ bool MAIN_create_core1_task(TaskHandle_t *taskHandle)
     Serial.println("[INIT] Creating Core 1 background task...");
 #endif
 
-    // Create Core 1 Background Task
-    BaseType_t result = xTaskCreatePinnedToCore(
-        MAIN_core1_background_task,
-        "Core1_Background",
-        CORE1_STACK_SIZE,
-        NULL,
-        CORE1_PRIORITY,
-        taskHandle,
-        1 // Pin to Core 1
-    );
+    // Create Core 1 Background Task (stack and TCB outside the heap)
+    *taskHandle = MAIN_STATIC_TASK_CREATE(core1_task, MAIN_core1_background_task, "Core1_Background", NULL,
+                                          CORE1_PRIORITY, CORE1_CORE);
 
-    if (result != pdPASS || *taskHandle == NULL)
+    if (*taskHandle == NULL)
     {
 #if EARS_DEBUG == 1
         Serial.println("[ERROR] Failed to create Core 1 background task!");
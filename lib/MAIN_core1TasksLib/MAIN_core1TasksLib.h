@@ -3,8 +3,8 @@
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief Core 1 Background Task management for EARS (extracted from main.cpp)
  * @details Manages Core 1 background task - System initialization and monitoring
- * @version 0.1.0
- * @date 20260204
+ * @version 1.21.0
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -20,6 +20,7 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include "EARS_versionDef.h"
+#include "EARS_taskPlanLib.h"
 
 /******************************************************************************
  * Library Version Information
@@ -28,23 +29,29 @@ namespace MAIN_Core1Tasks
 {
     constexpr const char* LIB_NAME = "MAIN_Core1Tasks";
     constexpr const char* VERSION_MAJOR = "1";
-    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_MINOR = "21";
     constexpr const char* VERSION_PATCH = "0";
-    constexpr const char* VERSION_DATE = "2026-02-04";
+    constexpr const char* VERSION_DATE = "2026-10-15";
 }
 
 /******************************************************************************
  * Core 1 Configuration
  *****************************************************************************/
 
-// Stack size (in words, not bytes)
+// Stack size (bytes, static: MAIN_rtosStaticLib)
 #define CORE1_STACK_SIZE 4096
 
-// Task priority
-#define CORE1_PRIORITY 1
+// Task priority and placement (EARS_taskPlanLib: Core 0 while the radios are in use)
+#define CORE1_PRIORITY using_taskplan().priority(TASK_ROLE_BACKGROUND)
+#define CORE1_CORE using_taskplan().core(TASK_ROLE_BACKGROUND)
 
-// Task update frequency
-#define CORE1_FREQUENCY_HZ 10 // 10Hz for background tasks
+// Service job rate, and the faster event dispatch job period
+#define CORE1_FREQUENCY_HZ 10 // 10Hz for background services
+#define CORE1_EVENT_PERIOD_MS 20
+#define CORE1_DEEP_IDLE_FREQUENCY_HZ 1 // Slowed while the screensaver is in deep idle
+
+// Health monitor: longest scheduler pass plus sleep before it counts as a stall
+#define CORE1_HEALTH_DEADLINE_MS 8000
 
 /******************************************************************************
  * Function Prototypes
@@ -61,14 +68,13 @@ bool MAIN_create_core1_task(TaskHandle_t *taskHandle);
 /**
  * @brief Core 1 Background Task function (runs on Core 1)
  * @param parameter Task parameter (unused)
- * @details Handles system initialization and background monitoring at 10Hz
+ * @details Runs the background jobs
  *
  * Responsibilities:
- * - NVS initialization (once at startup)
- * - SD card initialization (once at startup)
- * - System monitoring (continuous)
- * - LED heartbeat (continuous)
- * - Future: WiFi, BLE, sensors, logging
+ * - Background services as scheduler jobs (events, errors, backlight,
+ *   logger, SD and NVS write-back)
+ * - LED heartbeat (debug job)
+ * - Future: WiFi, BLE, sensors - register with MAIN_job_add()
  */
 void MAIN_core1_background_task(void *parameter);
 
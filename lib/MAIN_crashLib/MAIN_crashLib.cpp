@@ -0,0 +1,572 @@
+/**
+ * @file MAIN_crashLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Crash capture: core dump to the SD card and a post-mortem timeline
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_crashLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_sdCardLib.h"
+#include "EARS_eventBusLib.h"
+#include "MAIN_healthLib.h"
+#include "MAIN_jobSchedulerLib.h"
+#include "MAIN_lvglLib.h"
+#include "MAIN_uiCommandLib.h"
+#include <esp_attr.h>
+#include <esp_heap_caps.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+#include <esp_system.h>
+#include <esp_timer.h>
+#include <sdkconfig.h>
+
+#if defined(CONFIG_ESP_COREDUMP_ENABLE_TO_FLASH)
+#include <esp_core_dump.h>
+#endif
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+#define CRASH_MAGIC 0x48535243UL        // "CRSH"
+#define CRASH_REPORT_BUFFER 8192        // One timeline, built before it is written
+#define CRASH_ERASE_SIZE 4096           // Flash sector holding the core dump header
+
+// Kept in RTC memory across panic and watchdog resets
+typedef struct
+{
+    uint32_t magic;
+    uint16_t head;      // Next sample slot
+    uint16_t count;     // Samples held
+    MAIN_crash_sample_t samples[CRASH_SAMPLES];
+    uint32_t crc;       // Over everything above
+} crash_rtc_t;
+
+typedef enum
+{
+    CRASH_STEP_REPORT = 0,  // Append the timeline
+    CRASH_STEP_OPEN,        // Rotate the old dump, start the copy
+    CRASH_STEP_COPY,        // A chunk per run
+    CRASH_STEP_DONE
+} crash_step_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+// Left alone by the bootloader and by panic/watchdog resets, garbage after power-on
+RTC_NOINIT_ATTR static crash_rtc_t crash_rtc;
+
+static MAIN_crash_report_t crash_previous;
+static portMUX_TYPE crash_lock = portMUX_INITIALIZER_UNLOCKED;
+static esp_timer_handle_t crash_timer = NULL;
+static uint32_t crash_last_frames = 0; // Sampler only
+
+// Copy job (Core 1 only)
+static MAIN_job_id_t crash_job_id = JOB_INVALID;
+static crash_step_t crash_step = CRASH_STEP_DONE;
+static const esp_partition_t *crash_partition = NULL;
+static uint32_t crash_copy_offset = 0;
+static uint8_t *crash_chunk = NULL;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Checksum of the RTC record
+ * @return uint32_t CRC32 of everything before the crc field
+ */
+static uint32_t crash_rtc_crc(void)
+{
+    return esp_rom_crc32_le(0, (const uint8_t *)&crash_rtc, offsetof(crash_rtc_t, crc));
+}
+
+/**
+ * @brief Clamp a count to a byte
+ */
+static inline uint8_t crash_clamp8(uint32_t value)
+{
+    return (value > 0xFF) ? 0xFF : (uint8_t)value;
+}
+
+/**
+ * @brief Readable reset reason
+ * @param reason esp_reset_reason()
+ * @return const char* Name
+ */
+static const char *crash_reason_name(int reason)
+{
+    switch (reason)
+    {
+    case ESP_RST_POWERON:
+        return "power on";
+    case ESP_RST_SW:
+        return "software";
+    case ESP_RST_PANIC:
+        return "panic";
+    case ESP_RST_INT_WDT:
+        return "interrupt watchdog";
+    case ESP_RST_TASK_WDT:
+        return "task watchdog";
+    case ESP_RST_WDT:
+        return "watchdog";
+    case ESP_RST_BROWNOUT:
+        return "brownout";
+    default:
+        return "other";
+    }
+}
+
+/**
+ * @brief Flight recorder sample (esp_timer task)
+ * @param arg Unused
+ */
+static void crash_sample(void *arg)
+{
+    MAIN_crash_sample_t sample;
+    memset(&sample, 0, sizeof(sample));
+
+    const uint32_t internal = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+    sample.uptimeMs = millis();
+    sample.heapFree = heap_caps_get_free_size(internal);
+    sample.heapLargest = heap_caps_get_largest_free_block(internal);
+    sample.psramFree = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+
+    MAIN_lvgl_stats_t lvgl;
+    MAIN_lvgl_get_stats(&lvgl);
+    uint32_t frames = lvgl.frames - crash_last_frames;
+    crash_last_frames = lvgl.frames;
+    sample.frames = (frames > 0xFFFF) ? 0xFFFF : (uint16_t)frames;
+    sample.frameUs = lvgl.lastFrameUs;
+    sample.handlerUs = lvgl.lastHandlerUs;
+
+    MAIN_ui_cmd_stats_t ui;
+    MAIN_ui_cmd_get_stats(&ui);
+    sample.uiQueue = crash_clamp8(ui.posted - ui.applied);
+    sample.eventQueue = crash_clamp8(using_eventbus().getPending());
+    sample.sdPending = using_sdcard().getPendingWrites();
+
+    portENTER_CRITICAL(&crash_lock);
+    crash_rtc.samples[crash_rtc.head] = sample;
+    crash_rtc.head = (crash_rtc.head + 1) % CRASH_SAMPLES;
+    if (crash_rtc.count < CRASH_SAMPLES)
+    {
+        crash_rtc.count++;
+    }
+    crash_rtc.crc = crash_rtc_crc();
+    portEXIT_CRITICAL(&crash_lock);
+}
+
+/**
+ * @brief Copy the RTC samples into crash_previous and start this boot's
+ * @param resetReason esp_reset_reason()
+ */
+static void crash_take_previous(int resetReason)
+{
+    memset(&crash_previous, 0, sizeof(crash_previous));
+    crash_previous.resetReason = resetReason;
+    crash_previous.crashed = resetReason == ESP_RST_PANIC || resetReason == ESP_RST_INT_WDT ||
+                             resetReason == ESP_RST_TASK_WDT || resetReason == ESP_RST_WDT;
+
+    bool valid = resetReason != ESP_RST_POWERON && crash_rtc.magic == CRASH_MAGIC &&
+                 crash_rtc.count <= CRASH_SAMPLES && crash_rtc.head < CRASH_SAMPLES &&
+                 crash_rtc.crc == crash_rtc_crc();
+    if (valid)
+    {
+        uint16_t first = (crash_rtc.head + CRASH_SAMPLES - crash_rtc.count) % CRASH_SAMPLES;
+        for (uint16_t i = 0; i < crash_rtc.count; i++)
+        {
+            crash_previous.samples[i] = crash_rtc.samples[(first + i) % CRASH_SAMPLES];
+        }
+        crash_previous.sampleCount = (uint8_t)crash_rtc.count;
+    }
+
+    memset(&crash_rtc, 0, sizeof(crash_rtc));
+    crash_rtc.magic = CRASH_MAGIC;
+    crash_rtc.crc = crash_rtc_crc();
+}
+
+/**
+ * @brief Append formatted text to the timeline buffer
+ * @return size_t New length (clamped to the buffer)
+ */
+static size_t crash_printf(char *buffer, size_t length, const char *format, ...)
+{
+    if (length >= CRASH_REPORT_BUFFER - 1)
+    {
+        return length;
+    }
+
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(buffer + length, CRASH_REPORT_BUFFER - length, format, args);
+    va_end(args);
+
+    length += (written > 0) ? (size_t)written : 0;
+    return (length < CRASH_REPORT_BUFFER) ? length : CRASH_REPORT_BUFFER - 1;
+}
+
+/**
+ * @brief Build the timeline of the last samples and breadcrumbs
+ * @param buffer CRASH_REPORT_BUFFER bytes
+ * @return size_t Text length
+ */
+static size_t crash_build_report(char *buffer)
+{
+    const MAIN_crash_report_t *report = &crash_previous;
+
+    size_t length = crash_printf(buffer, 0, "=== Reset reason %d (%s), build %llu, version %s.%s.%s ===\n",
+                                 report->resetReason, crash_reason_name(report->resetReason),
+                                 (unsigned long long)EARS_APP_BUILD_TIMESTAMP, EARS_APP_VERSION_MAJOR,
+                                 EARS_APP_VERSION_MINOR, EARS_APP_VERSION_PATCH);
+    if (report->coreDumpSize != 0)
+    {
+        length = crash_printf(buffer, length, "Core dump: %s (%lu bytes)\n", CRASH_CORE_FILE,
+                              (unsigned long)report->coreDumpSize);
+    }
+
+    // Breadcrumbs of the boot that crashed (after its "boot" note)
+    MAIN_health_report_t *health = (MAIN_health_report_t *)heap_caps_malloc(sizeof(MAIN_health_report_t),
+                                                                            MALLOC_CAP_8BIT);
+    uint8_t eventFirst = 0;
+    uint8_t eventCount = 0;
+    if (health != NULL && MAIN_health_get_previous(health))
+    {
+        eventCount = health->eventCount;
+        for (uint8_t i = 0; i < health->eventCount; i++)
+        {
+            if (strcmp(health->events[i].tag, "boot") == 0)
+            {
+                eventFirst = i + 1;
+            }
+        }
+    }
+
+    if (report->sampleCount == 0)
+    {
+        length = crash_printf(buffer, length, "No flight recorder samples\n");
+    }
+    uint32_t endMs = (report->sampleCount > 0) ? report->samples[report->sampleCount - 1].uptimeMs : 0;
+
+    length = crash_printf(buffer, length,
+                          "   t (ms)  heap free   largest  psram free  frames  frame us   lvgl us  ui  ev  sd\n");
+
+    // Samples and breadcrumbs in time order, relative to the last sample
+    uint8_t s = 0;
+    uint8_t e = eventFirst;
+    while (s < report->sampleCount || e < eventCount)
+    {
+        bool takeEvent = e < eventCount &&
+                         (s >= report->sampleCount ||
+                          (int32_t)(health->events[e].uptimeMs - report->samples[s].uptimeMs) < 0);
+        if (takeEvent)
+        {
+            const MAIN_health_event_t *event = &health->events[e++];
+            length = crash_printf(buffer, length, "%9ld  * %s (%lu)\n", (long)(int32_t)(event->uptimeMs - endMs), event->tag,
+                                  (unsigned long)event->value);
+        }
+        else
+        {
+            const MAIN_crash_sample_t *sample = &report->samples[s++];
+            length = crash_printf(buffer, length, "%9ld %10lu %9lu %11lu %7u %9lu %9lu %3u %3u %3u\n",
+                                  (long)(int32_t)(sample->uptimeMs - endMs), (unsigned long)sample->heapFree,
+                                  (unsigned long)sample->heapLargest, (unsigned long)sample->psramFree,
+                                  sample->frames, (unsigned long)sample->frameUs, (unsigned long)sample->handlerUs,
+                                  sample->uiQueue, sample->eventQueue, sample->sdPending);
+        }
+    }
+
+    heap_caps_free(health);
+    return crash_printf(buffer, length, "\n");
+}
+
+/**
+ * @brief Append the timeline to CRASH_REPORT_FILE
+ * @return true if written
+ */
+static bool crash_write_report(void)
+{
+    char *buffer = (char *)heap_caps_malloc(CRASH_REPORT_BUFFER, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (buffer == NULL)
+    {
+        buffer = (char *)heap_caps_malloc(CRASH_REPORT_BUFFER, MALLOC_CAP_8BIT);
+    }
+    if (buffer == NULL)
+    {
+        return false;
+    }
+
+    size_t length = crash_build_report(buffer);
+
+    EARS_sdCard &sd = using_sdcard();
+    if (sd.getFileSize(CRASH_REPORT_FILE) + length > CRASH_REPORT_MAX)
+    {
+        if (sd.fileExists(CRASH_REPORT_FILE ".1"))
+        {
+            sd.removeFile(CRASH_REPORT_FILE ".1");
+        }
+        sd.renameFile(CRASH_REPORT_FILE, CRASH_REPORT_FILE ".1");
+    }
+    bool ok = sd.appendData(CRASH_REPORT_FILE, (const uint8_t *)buffer, length);
+
+    heap_caps_free(buffer);
+    return ok;
+}
+
+/**
+ * @brief Size of the core dump waiting in flash
+ * @return uint32_t Bytes, 0 if there is none
+ */
+static uint32_t crash_core_dump_size(void)
+{
+#if defined(CONFIG_ESP_COREDUMP_ENABLE_TO_FLASH)
+    size_t address = 0;
+    size_t size = 0;
+    crash_partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_COREDUMP, NULL);
+    if (crash_partition != NULL && esp_core_dump_image_get(&address, &size) == ESP_OK &&
+        address == crash_partition->address && size <= crash_partition->size)
+    {
+        return (uint32_t)size;
+    }
+#endif
+    return 0;
+}
+
+/**
+ * @brief Stop the copy job and release its buffer
+ */
+static void crash_job_finish(void)
+{
+    heap_caps_free(crash_chunk);
+    crash_chunk = NULL;
+    crash_step = CRASH_STEP_DONE;
+    MAIN_job_cancel(crash_job_id);
+    crash_job_id = JOB_INVALID;
+}
+
+/**
+ * @brief Core 1 job: write the timeline, then copy the core dump a chunk at
+ *        a time
+ * @param ctx Unused
+ */
+static void crash_job(void *ctx)
+{
+    EARS_sdCard &sd = using_sdcard();
+    if (!sd.isAvailable())
+    {
+        return; // Waits for a card
+    }
+
+    switch (crash_step)
+    {
+    case CRASH_STEP_REPORT:
+    {
+        if (!sd.directoryExists("/logs"))
+        {
+            sd.createDirectory("/logs");
+        }
+        bool ok = crash_write_report();
+        portENTER_CRITICAL(&crash_lock);
+        crash_previous.reportWritten = ok;
+        portEXIT_CRITICAL(&crash_lock);
+        Serial.printf("[CRASH] %s (reset reason %d)\n", ok ? "Timeline saved to " CRASH_REPORT_FILE : "Warning: Timeline not saved",
+                      crash_previous.resetReason);
+        crash_step = CRASH_STEP_OPEN;
+        break;
+    }
+
+    case CRASH_STEP_OPEN:
+        crash_chunk = (uint8_t *)heap_caps_malloc(CRASH_COPY_CHUNK, MALLOC_CAP_8BIT);
+        if (crash_previous.coreDumpSize == 0 || crash_partition == NULL || crash_chunk == NULL)
+        {
+            crash_job_finish();
+            break;
+        }
+        if (sd.fileExists(CRASH_CORE_FILE ".part"))
+        {
+            sd.removeFile(CRASH_CORE_FILE ".part");
+        }
+        crash_copy_offset = 0;
+        crash_step = CRASH_STEP_COPY;
+        break;
+
+    case CRASH_STEP_COPY:
+    {
+        uint32_t size = crash_previous.coreDumpSize;
+        uint32_t chunk = size - crash_copy_offset;
+        if (chunk > CRASH_COPY_CHUNK)
+        {
+            chunk = CRASH_COPY_CHUNK;
+        }
+
+        bool ok = esp_partition_read(crash_partition, crash_copy_offset, crash_chunk, chunk) == ESP_OK &&
+                  sd.appendData(CRASH_CORE_FILE ".part", crash_chunk, chunk);
+        if (!ok)
+        {
+            // The dump stays in flash and is tried again next boot
+            sd.removeFile(CRASH_CORE_FILE ".part");
+            Serial.println("[CRASH] Warning: Core dump copy failed");
+            crash_job_finish();
+            break;
+        }
+
+        crash_copy_offset += chunk;
+        if (crash_copy_offset < size)
+        {
+            break;
+        }
+
+        if (sd.fileExists(CRASH_CORE_FILE))
+        {
+            if (sd.fileExists(CRASH_CORE_FILE ".1"))
+            {
+                sd.removeFile(CRASH_CORE_FILE ".1");
+            }
+            sd.renameFile(CRASH_CORE_FILE, CRASH_CORE_FILE ".1");
+        }
+        ok = sd.renameFile(CRASH_CORE_FILE ".part", CRASH_CORE_FILE);
+
+        // Erasing the header sector is enough to invalidate the image
+        if (ok)
+        {
+            esp_partition_erase_range(crash_partition, 0, CRASH_ERASE_SIZE);
+        }
+
+        portENTER_CRITICAL(&crash_lock);
+        crash_previous.coreDumpCopied = ok;
+        portEXIT_CRITICAL(&crash_lock);
+        Serial.printf("[CRASH] Core dump %s %s (%lu bytes)\n", ok ? "saved to" : "not renamed to", CRASH_CORE_FILE,
+                      (unsigned long)size);
+        crash_job_finish();
+        break;
+    }
+
+    default:
+        crash_job_finish();
+        break;
+    }
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Take over the previous boot's samples, queue the copy to the SD card
+ *        after a crash and start the flight recorder
+ */
+bool MAIN_initialise_crash(void)
+{
+    if (crash_timer != NULL)
+    {
+        return true;
+    }
+
+    crash_take_previous((int)esp_reset_reason());
+    crash_previous.coreDumpSize = crash_core_dump_size();
+
+    // A dump left by any earlier crash is copied even if this reset was clean
+    if (crash_previous.crashed || crash_previous.coreDumpSize != 0)
+    {
+        crash_step = crash_previous.crashed ? CRASH_STEP_REPORT : CRASH_STEP_OPEN;
+        crash_job_id = MAIN_job_add("crash", crash_job, NULL, 0, CRASH_JOB_PERIOD_MS, JOB_PRIORITY_LOW, 0);
+        if (crash_job_id == JOB_INVALID)
+        {
+            Serial.println("[CRASH] Warning: No job slot, crash data left in place");
+        }
+    }
+
+    crash_last_frames = 0;
+    const esp_timer_create_args_t args = {
+        .callback = crash_sample,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "crash",
+        .skip_unhandled_events = true,
+    };
+    if (esp_timer_create(&args, &crash_timer) != ESP_OK ||
+        esp_timer_start_periodic(crash_timer, CRASH_SAMPLE_PERIOD_MS * 1000ULL) != ESP_OK)
+    {
+        Serial.println("[CRASH] Error: Flight recorder not started");
+        return false;
+    }
+
+    DEBUG_PRINTF("[CRASH] Flight recorder: %u samples every %u ms\n", CRASH_SAMPLES, CRASH_SAMPLE_PERIOD_MS);
+    return true;
+}
+
+/**
+ * @brief What the previous boot left behind
+ */
+bool MAIN_crash_get_previous(MAIN_crash_report_t *report)
+{
+    if (report == NULL)
+    {
+        return false;
+    }
+
+    portENTER_CRITICAL(&crash_lock);
+    *report = crash_previous;
+    portEXIT_CRITICAL(&crash_lock);
+    return report->crashed;
+}
+
+/**
+ * @brief Recent flight recorder samples, oldest first
+ */
+uint8_t MAIN_crash_get_samples(MAIN_crash_sample_t *out, uint8_t max)
+{
+    if (out == NULL)
+    {
+        return 0;
+    }
+
+    portENTER_CRITICAL(&crash_lock);
+    uint8_t count = (crash_rtc.count < max) ? (uint8_t)crash_rtc.count : max;
+    uint16_t first = (crash_rtc.head + CRASH_SAMPLES - count) % CRASH_SAMPLES;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        out[i] = crash_rtc.samples[(first + i) % CRASH_SAMPLES];
+    }
+    portEXIT_CRITICAL(&crash_lock);
+    return count;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Crash_getLibraryName() {
+    return MAIN_Crash::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Crash_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Crash::VERSION_MAJOR,
+                       MAIN_Crash::VERSION_MINOR,
+                       MAIN_Crash::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Crash_getVersionDate() {
+    return MAIN_Crash::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Crash_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Crash_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/******************************************************************************
+ * End of MAIN_crashLib.cpp
+ *****************************************************************************/
@@ -0,0 +1,136 @@
+/**
+ * @file MAIN_crashLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Crash capture: core dump to the SD card and a post-mortem timeline
+ * @details A panic or watchdog reset leaves two things behind:
+ *
+ *          - The ESP-IDF core dump, written by the panic handler to the
+ *            coredump flash partition (partitions_ears.csv) in ELF format.
+ *          - A flight recorder of CRASH_SAMPLES performance samples, one
+ *            every CRASH_SAMPLE_PERIOD_MS, kept in RTC memory: internal heap
+ *            free and largest block, PSRAM free, frames rendered and the
+ *            latest frame and lv_timer_handler times, and the UI command,
+ *            event bus and SD write queue depths. Samples are taken from an
+ *            esp_timer callback, so they carry on while either core's task
+ *            is stuck.
+ *
+ *          On the next boot after an abnormal reset, MAIN_initialise_crash()
+ *          hands a Core 1 job the work: it appends a timeline of the last
+ *          seconds to CRASH_REPORT_FILE (the samples merged with the
+ *          MAIN_healthLib breadcrumbs, times relative to the last sample),
+ *          then copies the core dump to CRASH_CORE_FILE a chunk at a time
+ *          and invalidates it in flash so it is copied once. The previous
+ *          dump is kept as "<file>.1". On the host:
+ *
+ *            espcoredump.py info_corefile -t elf -c coredump.elf firmware.elf
+ *
+ *          Without CONFIG_ESP_COREDUMP_ENABLE_TO_FLASH in the framework
+ *          sdkconfig only the timeline is written.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_CRASH_LIB_H__
+#define __MAIN_CRASH_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Crash
+{
+    constexpr const char* LIB_NAME = "MAIN_Crash";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_Crash_getLibraryName();
+uint32_t MAIN_Crash_getVersionEncoded();
+const char* MAIN_Crash_getVersionDate();
+void MAIN_Crash_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Crash Configuration
+ *****************************************************************************/
+#define CRASH_SAMPLE_PERIOD_MS 250        // Flight recorder period
+#define CRASH_SAMPLES 40                  // Held in RTC memory (the last 10 s)
+#define CRASH_REPORT_FILE "/logs/crash.txt"
+#define CRASH_REPORT_MAX (256 * 1024UL)   // Rotate to "<file>.1" beyond this
+#define CRASH_CORE_FILE "/logs/coredump.elf"
+#define CRASH_COPY_CHUNK 4096             // Core dump bytes copied per job run
+#define CRASH_JOB_PERIOD_MS 20
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t uptimeMs;          // millis() when taken
+    uint32_t heapFree;          // Internal RAM free (bytes)
+    uint32_t heapLargest;       // Internal RAM largest free block (bytes)
+    uint32_t psramFree;         // PSRAM free (bytes)
+    uint32_t frameUs;           // Latest frame render time
+    uint32_t handlerUs;         // Latest lv_timer_handler time
+    uint16_t frames;            // Frames rendered since the previous sample
+    uint8_t uiQueue;            // UI commands waiting
+    uint8_t eventQueue;         // Event bus events waiting
+    uint8_t sdPending;          // Coalesced SD writes waiting
+    uint8_t reserved[3];
+} MAIN_crash_sample_t;
+
+typedef struct
+{
+    int resetReason;            // esp_reset_reason() of this boot
+    bool crashed;               // Panic or watchdog reset
+    uint8_t sampleCount;
+    MAIN_crash_sample_t samples[CRASH_SAMPLES]; // Oldest first
+    uint32_t coreDumpSize;      // Bytes in the flash partition (0 = none)
+    bool coreDumpCopied;        // CRASH_CORE_FILE written
+    bool reportWritten;         // CRASH_REPORT_FILE appended
+} MAIN_crash_report_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Take over the previous boot's samples, queue the copy to the SD
+ *        card after a crash and start the flight recorder
+ * @return true if recording
+ * @note Call from setup after MAIN_initialise_health() (the timeline uses
+ *       its breadcrumbs) and with the job scheduler available.
+ */
+bool MAIN_initialise_crash(void);
+
+/**
+ * @brief What the previous boot left behind
+ * @param report Receives a copy
+ * @return true if the previous boot crashed
+ */
+bool MAIN_crash_get_previous(MAIN_crash_report_t *report);
+
+/**
+ * @brief Recent flight recorder samples, oldest first
+ * @param out Samples returned
+ * @param max Capacity of out
+ * @return uint8_t Samples returned
+ */
+uint8_t MAIN_crash_get_samples(MAIN_crash_sample_t *out, uint8_t max);
+
+#endif // __MAIN_CRASH_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_crashLib.h
+ ******************************************************************************/
@@ -2,9 +2,8 @@
  * @file MAIN_developmentFeaturesLib.cpp
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief Development features library implementation
- * @details Contains all development/debugging features that compile out in production
- * @version 1.0.0
- * @date 20260210
+ * @version 2.3.0
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -13,19 +12,20 @@
  * Includes
  *****************************************************************************/
 #include "MAIN_developmentFeaturesLib.h"
-#include "MAIN_drawingLib.h"
+#include <esp_timer.h>
+#include "MAIN_fontLib.h"
+#include "MAIN_lvglLib.h"
 #include "MAIN_sysinfoLib.h"
+#include "EARS_sdCardLib.h"
+#include "EARS_touchLib.h"
 #include "EARS_versionDef.h"
+#include "EARS_libVersionsDef.h"
 #include "EARS_systemDef.h"
 #include "EARS_toolsVersionDef.h"
-#include "EARS_rgb565ColoursDef.h"
-#include "EARS_ws35tlcdPins.h"
 
 /******************************************************************************
  * Development Mode Variables
  *****************************************************************************/
-volatile uint32_t dev_core0_heartbeat = 0;
-volatile uint32_t dev_core1_heartbeat = 0;
 volatile uint32_t dev_display_updates = 0;
 
 /******************************************************************************
@@ -42,9 +42,7 @@ void DEV_print_boot_banner(void)
     Serial.println("================================================================");
     Serial.println("  EARS - Equipment & Ammunition Reporting System");
     Serial.println("================================================================");
-    Serial.printf("  Version:    %s.%s.%s %s\n",
-                  EARS_APP_VERSION_MAJOR, EARS_APP_VERSION_MINOR,
-                  EARS_APP_VERSION_PATCH, EARS_STATUS);
+    Serial.printf("  Version:    %s %s\n", EARS_APP_VERSION_STRING, EARS_STATUS);
     Serial.printf("  Compiler:   %s\n", EARS_XTENSA_COMPILER_VERSION);
     Serial.printf("  Platform:   %s\n", EARS_ESPRESSIF_PLATFORM_VERSION);
     Serial.println("================================================================");
@@ -58,167 +56,260 @@ void DEV_print_boot_banner(void)
 void DEV_print_system_info(void)
 {
     MAIN_sysinfo_print_all();
+
+    // Preformatted by scripts/increment_build.py
+    Serial.println("========================================");
+    Serial.println("LIBRARIES:");
+    Serial.println("========================================");
+    for (size_t i = 0; i < EARS_LIB_VERSIONS_COUNT; i++)
+    {
+        Serial.printf("  %-26s %-8s %s\n", EARS_LIB_VERSIONS[i].name,
+                      EARS_LIB_VERSIONS[i].version, EARS_LIB_VERSIONS[i].date);
+    }
+    Serial.println();
 }
 
 /******************************************************************************
- * Development Screen Functions
+ * Performance HUD Functions
  *****************************************************************************/
 
+#if DEV_HUD_ENABLED == 1
+
+// UI objects and refresh timer (LVGL task only)
+static lv_obj_t *hud_panel = NULL;
+static lv_obj_t *hud_label = NULL;
+static lv_timer_t *hud_timer = NULL;
+static uint32_t hud_period_ms = DEV_HUD_PERIOD_MS;
+
+// Previous sample, to turn the running totals into per-window figures
+static MAIN_lvgl_stats_t hud_last_lvgl;
+static int64_t hud_last_us = 0;
+static MAIN_cpu_load_mark_t hud_cpu_mark;
+
+// The HUD started the idle-hook profiler / latency probe and stops them on hide
+static bool hud_owns_profiler = false;
+static bool hud_owns_latency = false;
+
 /**
- * @brief Draw the initial development screen layout
- * @param gfx Pointer to Arduino_GFX display object
- * @return void
+ * @brief Refresh the HUD text
+ * @param timer LVGL timer (unused)
  */
-void DEV_draw_screen(Arduino_GFX *gfx)
+static void hud_refresh(lv_timer_t *timer)
 {
-    if (gfx == nullptr)
-        return;
-
-    MAIN_clear_screen(gfx, EARS_RGB565_BLACK);
-
-    // Title bar
-    MAIN_draw_filled_rect(gfx, 0, 0, TFT_WIDTH, 40, EARS_RGB565_RS_PRIMARY);
-    gfx->setTextColor(EARS_RGB565_WHITE);
-    gfx->setTextSize(2);
-    gfx->setCursor(10, 12);
-    gfx->print("EARS - DEVELOPMENT MODE");
-
-    // Version box
-    MAIN_draw_rounded_rect(gfx, 10, 50, 220, 80, 5, EARS_RGB565_CS_PRIMARY);
-    gfx->setTextColor(EARS_RGB565_WHITE);
-    gfx->setTextSize(1);
-    gfx->setCursor(20, 60);
-    gfx->print("Version:");
-    gfx->setTextSize(2);
-    gfx->setCursor(20, 75);
-    gfx->printf("%s.%s.%s", EARS_APP_VERSION_MAJOR,
-                EARS_APP_VERSION_MINOR, EARS_APP_VERSION_PATCH);
-    gfx->setTextSize(1);
-    gfx->setCursor(20, 105);
-    gfx->print(EARS_STATUS);
-
-    // System Info box
-    MAIN_draw_rounded_rect(gfx, 240, 50, 230, 80, 5, EARS_RGB565_CS_SECONDARY);
-    gfx->setTextColor(EARS_RGB565_WHITE);
-    gfx->setTextSize(1);
-    gfx->setCursor(250, 60);
-    gfx->print("Platform:");
-    gfx->setCursor(250, 75);
-    gfx->printf("%s @ %dMHz", MAIN_sysinfo_get_chip_model().c_str(),
-                MAIN_sysinfo_get_cpu_freq_mhz());
-    gfx->setCursor(250, 90);
-    gfx->printf("Heap: %s free", MAIN_sysinfo_format_bytes(MAIN_sysinfo_get_free_heap()).c_str());
-    gfx->setCursor(250, 105);
-    gfx->printf("PSRAM: %s free", MAIN_sysinfo_format_bytes(MAIN_sysinfo_get_free_psram()).c_str());
-
-    // Status labels
-    gfx->setTextColor(EARS_RGB565_CS_TEXT);
-    gfx->setTextSize(1);
-    gfx->setCursor(10, 150);
-    gfx->print("Core 0 (UI):");
-    gfx->setCursor(10, 180);
-    gfx->print("Core 1 (BG):");
-    gfx->setCursor(10, 210);
-    gfx->print("Uptime:");
-    gfx->setCursor(10, 240);
-    gfx->print("Display:");
-
-    // Footer
-    gfx->setTextColor(EARS_RGB565_GRAY);
-    gfx->setCursor(10, 300);
-    gfx->print("LED Heartbeat: GPIO42 (Green)");
+    (void)timer;
+
+    MAIN_lvgl_stats_t lvgl;
+    MAIN_lvgl_get_stats(&lvgl);
+    int64_t now = esp_timer_get_time();
+
+    uint32_t elapsedUs = (uint32_t)(now - hud_last_us);
+    uint32_t frames = lvgl.frames - hud_last_lvgl.frames;
+    uint32_t flushes = lvgl.flushCalls - hud_last_lvgl.flushCalls;
+    uint32_t fpsTenths = elapsedUs ? (uint32_t)((uint64_t)frames * 10000000ULL / elapsedUs) : 0;
+    uint32_t renderUs = frames ? (uint32_t)((lvgl.totalFrameUs - hud_last_lvgl.totalFrameUs) / frames) : 0;
+    uint32_t flushUs = flushes ? (uint32_t)((lvgl.totalFlushUs - hud_last_lvgl.totalFlushUs) / flushes) : 0;
+    hud_last_lvgl = lvgl;
+    hud_last_us = now;
+
+    float cpu[2];
+    MAIN_sysinfo_cpu_load(&hud_cpu_mark, cpu, NULL);
+
+    MAIN_latency_stats_t latency;
+    MAIN_sysinfo_latency_get_stats(&latency);
+
+    char text[256];
+    snprintf(text, sizeof(text),
+             "FPS %lu.%lu  render %lu.%lu ms\n"
+             "flush %lu.%lu ms\n"
+             "CPU0 %d%%  CPU1 %d%%\n"
+             "heap %lu K  psram %lu K\n"
+             "SD pending %u\n"
+             "touch p50 %lu p95 %lu ms, drop %lu",
+             (unsigned long)(fpsTenths / 10), (unsigned long)(fpsTenths % 10),
+             (unsigned long)(renderUs / 1000), (unsigned long)((renderUs % 1000) / 100),
+             (unsigned long)(flushUs / 1000), (unsigned long)((flushUs % 1000) / 100),
+             (int)(cpu[0] + 0.5f), (int)(cpu[1] + 0.5f),
+             (unsigned long)(MAIN_sysinfo_get_free_heap() / 1024),
+             (unsigned long)(MAIN_sysinfo_get_free_psram() / 1024),
+             (unsigned)using_sdcard().getPendingWrites(),
+             (unsigned long)(latency.p50Us / 1000), (unsigned long)(latency.p95Us / 1000),
+             (unsigned long)using_touch().getDroppedEvents());
+
+    // The label redraws only when the text changes
+    if (strcmp(lv_label_get_text(hud_label), text) != 0)
+    {
+        lv_label_set_text(hud_label, text);
+    }
 }
 
 /**
- * @brief Update live statistics on development screen
- * @param gfx Pointer to Arduino_GFX display object
- * @return void
+ * @brief Long press on a pointer device: toggle when it is in the corner
+ * @param e LVGL event (user data = the input device)
  */
-void DEV_update_screen(Arduino_GFX *gfx)
+static void hud_long_press_cb(lv_event_t *e)
 {
-    if (gfx == nullptr)
-        return;
-
-    dev_display_updates++;
-    uint32_t uptime_sec = millis() / 1000;
-
-    // Clear update area
-    MAIN_draw_filled_rect(gfx, 120, 145, 350, 100, EARS_RGB565_BLACK);
-
-    gfx->setTextColor(EARS_RGB565_WHITE);
-    gfx->setTextSize(1);
+    lv_indev_t *indev = (lv_indev_t *)lv_event_get_user_data(e);
+    lv_point_t point;
+    lv_indev_get_point(indev, &point);
 
-    // Core 0 heartbeat
-    gfx->setCursor(120, 150);
-    gfx->printf("Running (%lu beats)", dev_core0_heartbeat);
+    if (point.x < DEV_HUD_TOGGLE_CORNER_PX && point.y < DEV_HUD_TOGGLE_CORNER_PX)
+    {
+        DEV_hud_toggle();
 
-    // Core 1 heartbeat
-    gfx->setCursor(120, 180);
-    gfx->printf("Running (%lu beats)", dev_core1_heartbeat);
-
-    // Uptime
-    gfx->setCursor(120, 210);
-    uint32_t hours = uptime_sec / 3600;
-    uint32_t minutes = (uptime_sec % 3600) / 60;
-    uint32_t seconds = uptime_sec % 60;
-    gfx->printf("%02lu:%02lu:%02lu", hours, minutes, seconds);
-
-    // Display updates
-    gfx->setCursor(120, 240);
-    gfx->printf("%lu updates", dev_display_updates);
-
-    // Heartbeat indicator (flashing dot)
-    uint16_t color = (dev_core0_heartbeat % 2) ? EARS_RGB565_GREEN : EARS_RGB565_DARKGRAY;
-    gfx->fillCircle(450, 155, 8, color);
+        // The press is spent on the HUD; the widget under it gets no click
+        lv_indev_wait_release(indev);
+    }
 }
 
-/******************************************************************************
- * Heartbeat Management Functions
- *****************************************************************************/
+/**
+ * @brief Create the hidden HUD and the corner long-press toggle
+ * @return bool True if the overlay was created
+ */
+bool DEV_hud_init(void)
+{
+    if (hud_panel != NULL)
+    {
+        return true;
+    }
+
+    hud_panel = lv_obj_create(lv_layer_top());
+    if (hud_panel == NULL)
+    {
+        return false;
+    }
+
+    lv_obj_remove_style_all(hud_panel);
+    lv_obj_set_pos(hud_panel, DEV_HUD_X, DEV_HUD_Y);
+    lv_obj_set_size(hud_panel, DEV_HUD_WIDTH, DEV_HUD_HEIGHT);
+    lv_obj_set_style_bg_color(hud_panel, lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(hud_panel, LV_OPA_COVER, 0);
+    lv_obj_set_style_pad_all(hud_panel, 4, 0);
+    lv_obj_remove_flag(hud_panel, (lv_obj_flag_t)(LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE));
+    lv_obj_add_flag(hud_panel, LV_OBJ_FLAG_HIDDEN);
+
+    hud_label = lv_label_create(hud_panel);
+    lv_obj_set_width(hud_label, LV_PCT(100));
+    lv_label_set_long_mode(hud_label, LV_LABEL_LONG_MODE_CLIP);
+    lv_obj_set_style_text_color(hud_label, lv_color_white(), 0);
+    lv_obj_set_style_text_font(hud_label, MAIN_font_get(12), 0);
+    lv_label_set_text(hud_label, "");
+
+    // Each pointer device reports its long presses, whatever they land on
+    for (lv_indev_t *indev = lv_indev_get_next(NULL); indev != NULL; indev = lv_indev_get_next(indev))
+    {
+        if (lv_indev_get_type(indev) == LV_INDEV_TYPE_POINTER)
+        {
+            lv_indev_add_event_cb(indev, hud_long_press_cb, LV_EVENT_LONG_PRESSED, indev);
+        }
+    }
+
+    DEBUG_PRINTLN("[HUD] Ready (long press top-left corner)");
+    return true;
+}
 
 /**
- * @brief Increment Core 0 heartbeat counter
+ * @brief Show or hide the HUD
+ * @param visible True to show
  * @return void
  */
-void DEV_increment_core0_heartbeat(void)
+void DEV_hud_show(bool visible)
 {
-    dev_core0_heartbeat++;
+    if (hud_panel == NULL || visible == DEV_hud_is_visible())
+    {
+        return;
+    }
+
+    if (visible)
+    {
+        if (!MAIN_sysinfo_profiler_is_running())
+        {
+            hud_owns_profiler = MAIN_sysinfo_profiler_begin(0);
+        }
+        if (!MAIN_sysinfo_latency_is_enabled())
+        {
+            MAIN_sysinfo_latency_enable(true);
+            hud_owns_latency = true;
+        }
+        hud_cpu_mark.us = 0;
+        MAIN_lvgl_get_stats(&hud_last_lvgl);
+        hud_last_us = esp_timer_get_time();
+
+        lv_label_set_text(hud_label, "...");
+        lv_obj_remove_flag(hud_panel, LV_OBJ_FLAG_HIDDEN);
+        hud_timer = lv_timer_create(hud_refresh, hud_period_ms, NULL);
+    }
+    else
+    {
+        lv_timer_delete(hud_timer);
+        hud_timer = NULL;
+        lv_obj_add_flag(hud_panel, LV_OBJ_FLAG_HIDDEN);
+
+        if (hud_owns_profiler)
+        {
+            MAIN_sysinfo_profiler_end();
+            hud_owns_profiler = false;
+        }
+        if (hud_owns_latency)
+        {
+            MAIN_sysinfo_latency_enable(false);
+            hud_owns_latency = false;
+        }
+    }
 }
 
 /**
- * @brief Increment Core 1 heartbeat counter
+ * @brief Show the HUD if hidden, hide it if shown
  * @return void
  */
-void DEV_increment_core1_heartbeat(void)
+void DEV_hud_toggle(void)
 {
-    dev_core1_heartbeat++;
+    DEV_hud_show(!DEV_hud_is_visible());
 }
 
 /**
- * @brief Increment display update counter
- * @return void
+ * @brief Check if the HUD is shown
+ * @return bool True if shown
  */
-void DEV_increment_display_updates(void)
+bool DEV_hud_is_visible(void)
 {
-    dev_display_updates++;
+    return hud_timer != NULL;
 }
 
 /**
- * @brief Get Core 0 heartbeat count
- * @return uint32_t Current heartbeat count
+ * @brief Change the refresh period
+ * @param periodMs Milliseconds between refreshes (0 = DEV_HUD_PERIOD_MS)
+ * @return void
  */
-uint32_t DEV_get_core0_heartbeat(void)
+void DEV_hud_set_period(uint32_t periodMs)
 {
-    return dev_core0_heartbeat;
+    hud_period_ms = (periodMs > 0) ? periodMs : DEV_HUD_PERIOD_MS;
+    if (hud_timer != NULL)
+    {
+        lv_timer_set_period(hud_timer, hud_period_ms);
+    }
 }
 
+#else
+
+bool DEV_hud_init(void) { return false; }
+void DEV_hud_show(bool visible) { (void)visible; }
+void DEV_hud_toggle(void) {}
+bool DEV_hud_is_visible(void) { return false; }
+void DEV_hud_set_period(uint32_t periodMs) { (void)periodMs; }
+
+#endif // DEV_HUD_ENABLED
+
+/******************************************************************************
+ * Display Counter Functions
+ *****************************************************************************/
+
 /**
- * @brief Get Core 1 heartbeat count
- * @return uint32_t Current heartbeat count
+ * @brief Increment display update counter
+ * @return void
  */
-uint32_t DEV_get_core1_heartbeat(void)
+void DEV_increment_display_updates(void)
 {
-    return dev_core1_heartbeat;
+    dev_display_updates++;
 }
 
 /**
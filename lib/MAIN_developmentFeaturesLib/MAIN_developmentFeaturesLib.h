@@ -2,14 +2,21 @@
  * @file MAIN_developmentFeaturesLib.h
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief Development features library for EARS
- * @details Contains all development/debugging features that compile out in production
- * @version 1.0.0
- * @date 20260210
+ * @details Boot banner, display counter and a live performance HUD.
+ *          Task heartbeats moved to MAIN_healthLib, which watches them in
+ *          every build.
+ *          The HUD is an LVGL overlay on lv_layer_top(), so it sits above
+ *          every screen without touching the UI. A long press in the top-left
+ *          corner shows or hides it; while shown, one LVGL timer refreshes
+ *          FPS, render and flush times, CPU per core, free heap and PSRAM,
+ *          SD writes pending, touch-to-photon latency and touch events
+ *          dropped. While hidden no timer
+ *          runs and nothing is sampled, so it may stay in deployed builds.
+ * @version 2.3.0
+ * @date 20261015
  *
  * PURPOSE:
- * - Development screen display
- * - System heartbeat tracking
- * - Live statistics display
+ * - Live performance HUD
  * - Boot information
  *
  * PRODUCTION BUILD:
@@ -27,7 +34,7 @@
  *****************************************************************************/
 #include <Arduino.h>
 #include "EARS_versionDef.h"
-#include <Arduino_GFX_Library.h>
+#include <lvgl.h>
 
 /******************************************************************************
  * Library Version Information
@@ -35,10 +42,10 @@
 namespace MAIN_DevFeatures
 {
     constexpr const char *LIB_NAME = "MAIN_DevelopmentFeatures";
-    constexpr const char *VERSION_MAJOR = "1";
-    constexpr const char *VERSION_MINOR = "0";
+    constexpr const char *VERSION_MAJOR = "2";
+    constexpr const char *VERSION_MINOR = "3";
     constexpr const char *VERSION_PATCH = "0";
-    constexpr const char *VERSION_DATE = "2026-02-10";
+    constexpr const char *VERSION_DATE = "2026-10-15";
 }
 
 // Version information getters
@@ -47,13 +54,32 @@ uint32_t MAIN_DevelopmentFeatures_getVersionEncoded();
 const char *MAIN_DevelopmentFeatures_getVersionDate();
 void MAIN_DevelopmentFeatures_getVersionString(char *buffer);
 
+/******************************************************************************
+ * Performance HUD Configuration
+ *****************************************************************************/
+
+// 0 removes the HUD (DEV_hud_* become no-ops)
+#ifndef DEV_HUD_ENABLED
+#define DEV_HUD_ENABLED 1
+#endif
+
+// Refresh period while shown
+#define DEV_HUD_PERIOD_MS 500
+
+// Long press inside this square at the top-left corner toggles the HUD
+#define DEV_HUD_TOGGLE_CORNER_PX 40
+
+// Overlay geometry (opaque, so LVGL skips redrawing what lies beneath)
+#define DEV_HUD_X 4
+#define DEV_HUD_Y 4
+#define DEV_HUD_WIDTH 200
+#define DEV_HUD_HEIGHT 100
+
 /******************************************************************************
  * Development Mode Variables
  *****************************************************************************/
 
-// Core heartbeat counters (volatile for cross-core access)
-extern volatile uint32_t dev_core0_heartbeat;
-extern volatile uint32_t dev_core1_heartbeat;
+// Display update counter (volatile for cross-core access)
 extern volatile uint32_t dev_display_updates;
 
 /******************************************************************************
@@ -69,62 +95,60 @@ void DEV_print_boot_banner(void);
 
 /**
  * @brief Print complete system information report
- * @details Calls MAIN_sysinfo_print_all() if available
+ * @details Calls MAIN_sysinfo_print_all(), then lists every library version
+ *          from the build-time table in EARS_libVersionsDef.h
  * @return void
  */
 void DEV_print_system_info(void);
 
 /******************************************************************************
- * Development Screen Functions
+ * Performance HUD Functions
  *****************************************************************************/
 
 /**
- * @brief Draw the initial development screen layout
- * @param gfx Pointer to Arduino_GFX display object
- * @return void
+ * @brief Create the hidden HUD and the corner long-press toggle
+ * @return bool True if the overlay was created
+ * @note LVGL task (or setup() before the tasks start), after the touch
+ *       input device is registered.
  */
-void DEV_draw_screen(Arduino_GFX *gfx);
+bool DEV_hud_init(void);
 
 /**
- * @brief Update live statistics on development screen
- * @param gfx Pointer to Arduino_GFX display object
+ * @brief Show or hide the HUD
+ * @param visible True to show
  * @return void
+ * @note LVGL task only; other tasks post it through MAIN_ui_cmd_call.
  */
-void DEV_update_screen(Arduino_GFX *gfx);
-
-/******************************************************************************
- * Heartbeat Management Functions
- *****************************************************************************/
+void DEV_hud_show(bool visible);
 
 /**
- * @brief Increment Core 0 heartbeat counter
+ * @brief Show the HUD if hidden, hide it if shown
  * @return void
  */
-void DEV_increment_core0_heartbeat(void);
+void DEV_hud_toggle(void);
 
 /**
- * @brief Increment Core 1 heartbeat counter
- * @return void
+ * @brief Check if the HUD is shown
+ * @return bool True if shown
  */
-void DEV_increment_core1_heartbeat(void);
+bool DEV_hud_is_visible(void);
 
 /**
- * @brief Increment display update counter
+ * @brief Change the refresh period
+ * @param periodMs Milliseconds between refreshes (0 = DEV_HUD_PERIOD_MS)
  * @return void
  */
-void DEV_increment_display_updates(void);
+void DEV_hud_set_period(uint32_t periodMs);
 
-/**
- * @brief Get Core 0 heartbeat count
- * @return uint32_t Current heartbeat count
- */
-uint32_t DEV_get_core0_heartbeat(void);
+/******************************************************************************
+ * Display Counter Functions
+ *****************************************************************************/
 
 /**
- * @brief Get Core 1 heartbeat count
- * @return uint32_t Current heartbeat count
+ * @brief Increment display update counter
+ * @return void
  */
-uint32_t DEV_get_core1_heartbeat(void);
+void DEV_increment_display_updates(void);
 
 /**
  * @brief Get display update count
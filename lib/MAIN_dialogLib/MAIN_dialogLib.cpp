@@ -0,0 +1,445 @@
+/**
+ * @file MAIN_dialogLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Pooled dialogs: message, confirm, keypad and keyboard built once
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_dialogLib.h"
+#include "EARS_systemDef.h"
+#include "MAIN_themeLib.h"
+#include "MAIN_keypadLib.h"
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    lv_obj_t *backdrop;         // Modal layer, parent of everything below
+    lv_obj_t *panel;
+    lv_obj_t *title;
+    lv_obj_t *body;             // Notice: label, entry: text area
+    lv_obj_t *ok;               // Notice only
+    lv_obj_t *cancel;           // Notice only
+    lv_obj_t *keyboard;         // Entry only, text
+    lv_obj_t *keypad;           // Entry only, numbers (NULL: keyboard in number mode)
+    MAIN_dialog_cb_t cb;
+    void *ctx;
+    bool open;
+} dialog_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static dialog_t dialogs[DIALOG_TEMPLATE_COUNT];
+
+static MAIN_dialog_stats_t dialog_stats;
+
+/******************************************************************************
+ * Private Functions
+ *****************************************************************************/
+
+/**
+ * @brief Hide a dialog and report how it closed
+ * @param dialog Dialog
+ * @param ok Result for the callback
+ */
+static void dialog_finish(dialog_t *dialog, bool ok)
+{
+    if (!dialog->open)
+    {
+        return;
+    }
+
+    // The text area's buffer changes with the next show; the callback may show one
+    char text[DIALOG_ENTRY_SIZE];
+    const char *result = NULL;
+    if (dialog->keyboard != NULL)
+    {
+        strlcpy(text, lv_textarea_get_text(dialog->body), sizeof(text));
+        result = text;
+    }
+
+    lv_obj_add_flag(dialog->backdrop, LV_OBJ_FLAG_HIDDEN);
+    dialog->open = false;
+
+    MAIN_dialog_cb_t cb = dialog->cb;
+    void *ctx = dialog->ctx;
+    dialog->cb = NULL;
+    dialog->ctx = NULL;
+    if (cb != NULL)
+    {
+        cb(ok, result, ctx);
+    }
+}
+
+/**
+ * @brief OK or Cancel clicked on a notice
+ */
+static void dialog_button_cb(lv_event_t *e)
+{
+    dialog_t *dialog = &dialogs[DIALOG_TEMPLATE_NOTICE];
+    dialog_finish(dialog, lv_event_get_current_target(e) == dialog->ok);
+}
+
+/**
+ * @brief Enter or close pressed on the entry keyboard
+ */
+static void dialog_entry_cb(lv_event_t *e)
+{
+    dialog_finish(&dialogs[DIALOG_TEMPLATE_ENTRY], lv_event_get_code(e) == LV_EVENT_READY);
+}
+
+/**
+ * @brief Themed button with a static label
+ */
+static lv_obj_t *dialog_button(lv_obj_t *parent, const char *text)
+{
+    lv_obj_t *button = lv_button_create(parent);
+    lv_style_t *style = MAIN_theme_get_style(THEME_STYLE_BUTTON);
+    if (style != NULL)
+    {
+        lv_obj_add_style(button, style, 0);
+    }
+    style = MAIN_theme_get_style(THEME_STYLE_PRESSED);
+    if (style != NULL)
+    {
+        lv_obj_add_style(button, style, LV_STATE_PRESSED);
+    }
+    lv_obj_add_event_cb(button, dialog_button_cb, LV_EVENT_CLICKED, NULL);
+
+    lv_obj_t *label = lv_label_create(button);
+    lv_label_set_text_static(label, text);
+    lv_obj_center(label);
+    return button;
+}
+
+/**
+ * @brief Hidden full-screen backdrop and a themed panel on it
+ * @param dialog Dialog to fill in
+ */
+static void dialog_build_frame(dialog_t *dialog)
+{
+    dialog->backdrop = lv_obj_create(lv_layer_top());
+    lv_obj_remove_style_all(dialog->backdrop);
+    lv_obj_set_size(dialog->backdrop, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_style_bg_color(dialog->backdrop, lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(dialog->backdrop, DIALOG_BACKDROP_OPA, 0);
+    lv_obj_remove_flag(dialog->backdrop, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(dialog->backdrop, (lv_obj_flag_t)(LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_CLICKABLE));
+
+    dialog->panel = lv_obj_create(dialog->backdrop);
+    lv_style_t *panel = MAIN_theme_get_style(THEME_STYLE_PANEL);
+    if (panel != NULL)
+    {
+        lv_obj_add_style(dialog->panel, panel, 0);
+    }
+    lv_obj_set_style_pad_all(dialog->panel, DIALOG_PAD, 0);
+    lv_obj_set_style_pad_row(dialog->panel, DIALOG_PAD, 0);
+    lv_obj_set_flex_flow(dialog->panel, LV_FLEX_FLOW_COLUMN);
+    lv_obj_remove_flag(dialog->panel, LV_OBJ_FLAG_SCROLLABLE);
+
+    dialog->title = lv_label_create(dialog->panel);
+    lv_style_t *accent = MAIN_theme_get_style(THEME_STYLE_ACCENT);
+    if (accent != NULL)
+    {
+        lv_obj_add_style(dialog->title, accent, 0);
+    }
+    lv_obj_set_width(dialog->title, LV_PCT(100));
+}
+
+/**
+ * @brief Build the notice: title, wrapped text, OK and Cancel
+ */
+static void dialog_build_notice(dialog_t *dialog)
+{
+    dialog_build_frame(dialog);
+    lv_obj_set_size(dialog->panel, LV_PCT(DIALOG_WIDTH_PCT), LV_SIZE_CONTENT);
+    lv_obj_center(dialog->panel);
+
+    dialog->body = lv_label_create(dialog->panel);
+    lv_obj_set_width(dialog->body, LV_PCT(100));
+    lv_label_set_long_mode(dialog->body, LV_LABEL_LONG_MODE_WRAP);
+
+    lv_obj_t *row = lv_obj_create(dialog->panel);
+    lv_obj_remove_style_all(row);
+    lv_obj_set_size(row, LV_PCT(100), LV_SIZE_CONTENT);
+    lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(row, LV_FLEX_ALIGN_END, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_column(row, DIALOG_PAD, 0);
+
+    dialog->cancel = dialog_button(row, "Cancel");
+    dialog->ok = dialog_button(row, "OK");
+}
+
+/**
+ * @brief Build the entry: title, one-line text area, keyboard and keypad on the lower half
+ */
+static void dialog_build_entry(dialog_t *dialog)
+{
+    dialog_build_frame(dialog);
+    lv_obj_set_size(dialog->panel, LV_PCT(100), LV_SIZE_CONTENT);
+    lv_obj_align(dialog->panel, LV_ALIGN_TOP_MID, 0, 0);
+
+    dialog->body = lv_textarea_create(dialog->panel);
+    lv_obj_set_width(dialog->body, LV_PCT(100));
+    lv_textarea_set_one_line(dialog->body, true);
+    lv_textarea_set_max_length(dialog->body, DIALOG_ENTRY_SIZE - 1);
+
+    // READY and CANCEL reach the text area from the keyboard and from Enter
+    lv_obj_add_event_cb(dialog->body, dialog_entry_cb, LV_EVENT_READY, NULL);
+    lv_obj_add_event_cb(dialog->body, dialog_entry_cb, LV_EVENT_CANCEL, NULL);
+
+    dialog->keyboard = lv_keyboard_create(dialog->backdrop);
+    lv_obj_set_size(dialog->keyboard, LV_PCT(100), LV_PCT(50));
+    lv_obj_align(dialog->keyboard, LV_ALIGN_BOTTOM_MID, 0, 0);
+    lv_keyboard_set_textarea(dialog->keyboard, dialog->body);
+
+    // Numbers on a pre-rendered keypad in the same place, faces rendered now
+    // rather than on the first show
+    dialog->keypad = MAIN_keypad_create(dialog->backdrop, &MAIN_keypad_layout_number);
+    if (dialog->keypad != NULL)
+    {
+        lv_obj_set_size(dialog->keypad, LV_PCT(100), LV_PCT(50));
+        lv_obj_align(dialog->keypad, LV_ALIGN_BOTTOM_MID, 0, 0);
+        lv_obj_add_flag(dialog->keypad, LV_OBJ_FLAG_HIDDEN);
+        MAIN_keypad_set_textarea(dialog->keypad, dialog->body);
+        MAIN_keypad_prerender(dialog->keypad);
+    }
+}
+
+/**
+ * @brief Build a template if it is not built yet
+ * @param tmpl Template
+ * @return dialog_t* Its dialog (NULL if it could not be built)
+ */
+static dialog_t *dialog_get(MAIN_dialog_template_t tmpl)
+{
+    dialog_t *dialog = &dialogs[tmpl];
+    if (dialog->backdrop != NULL)
+    {
+        return dialog;
+    }
+
+    uint32_t startUs = micros();
+    if (tmpl == DIALOG_TEMPLATE_NOTICE)
+    {
+        dialog_build_notice(dialog);
+    }
+    else
+    {
+        dialog_build_entry(dialog);
+    }
+    uint32_t buildUs = micros() - startUs;
+    dialog_stats.buildUs += buildUs;
+    dialog_stats.builds++;
+
+#if EARS_DEBUG == 1
+    Serial.printf("[DIALOG] Template %u built in %lu us\n", (unsigned)tmpl, (unsigned long)buildUs);
+#endif
+    return dialog;
+}
+
+/**
+ * @brief Take a template for a new show, replacing an open dialog
+ * @return dialog_t* Dialog to fill in (NULL if it could not be built)
+ */
+static dialog_t *dialog_begin(MAIN_dialog_template_t tmpl, MAIN_dialog_cb_t cb, void *ctx)
+{
+    bool built = dialogs[tmpl].backdrop != NULL;
+    dialog_t *dialog = dialog_get(tmpl);
+    if (dialog == NULL)
+    {
+        return NULL;
+    }
+
+    if (dialog->open)
+    {
+        dialog_stats.replaced++;
+        dialog_finish(dialog, false);
+    }
+
+    dialog_stats.shows++;
+    if (built)
+    {
+        dialog_stats.hits++;
+    }
+
+    dialog->cb = cb;
+    dialog->ctx = ctx;
+    return dialog;
+}
+
+/**
+ * @brief Bring a filled-in dialog up, above anything else on the top layer
+ */
+static void dialog_show(dialog_t *dialog)
+{
+    lv_obj_move_foreground(dialog->backdrop);
+    lv_obj_remove_flag(dialog->backdrop, LV_OBJ_FLAG_HIDDEN);
+    dialog->open = true;
+}
+
+/**
+ * @brief Fill in and show the notice
+ */
+static bool dialog_notice(const char *title, const char *text, bool withCancel, MAIN_dialog_cb_t cb, void *ctx)
+{
+    dialog_t *dialog = dialog_begin(DIALOG_TEMPLATE_NOTICE, cb, ctx);
+    if (dialog == NULL)
+    {
+        return false;
+    }
+
+    lv_label_set_text(dialog->title, title != NULL ? title : "");
+    lv_label_set_text(dialog->body, text != NULL ? text : "");
+    lv_obj_set_flag(dialog->cancel, LV_OBJ_FLAG_HIDDEN, !withCancel);
+    dialog_show(dialog);
+    return true;
+}
+
+/**
+ * @brief Fill in and show the entry
+ */
+static bool dialog_entry(const char *title, const char *initial, bool number, MAIN_dialog_cb_t cb, void *ctx)
+{
+    dialog_t *dialog = dialog_begin(DIALOG_TEMPLATE_ENTRY, cb, ctx);
+    if (dialog == NULL)
+    {
+        return false;
+    }
+
+    lv_label_set_text(dialog->title, title != NULL ? title : "");
+    lv_textarea_set_accepted_chars(dialog->body, number ? "0123456789.-" : NULL);
+    lv_textarea_set_text(dialog->body, initial != NULL ? initial : "");
+    bool keypad = number && dialog->keypad != NULL;
+    if (dialog->keypad != NULL)
+    {
+        lv_obj_set_flag(dialog->keypad, LV_OBJ_FLAG_HIDDEN, !keypad);
+    }
+    lv_obj_set_flag(dialog->keyboard, LV_OBJ_FLAG_HIDDEN, keypad);
+    if (!keypad)
+    {
+        lv_keyboard_set_mode(dialog->keyboard, number ? LV_KEYBOARD_MODE_NUMBER : LV_KEYBOARD_MODE_TEXT_LOWER);
+    }
+    dialog_show(dialog);
+    return true;
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Build templates ahead of their first show
+ */
+bool MAIN_initialise_dialogs(uint8_t buildMask)
+{
+    bool built = true;
+    for (uint8_t tmpl = 0; tmpl < DIALOG_TEMPLATE_COUNT; tmpl++)
+    {
+        if ((buildMask & (1U << tmpl)) != 0 && dialog_get((MAIN_dialog_template_t)tmpl) == NULL)
+        {
+            built = false;
+        }
+    }
+    return built;
+}
+
+/**
+ * @brief Show a message with an OK button
+ */
+bool MAIN_dialog_message(const char *title, const char *text, MAIN_dialog_cb_t cb, void *ctx)
+{
+    return dialog_notice(title, text, false, cb, ctx);
+}
+
+/**
+ * @brief Ask for OK or Cancel
+ */
+bool MAIN_dialog_confirm(const char *title, const char *text, MAIN_dialog_cb_t cb, void *ctx)
+{
+    return dialog_notice(title, text, true, cb, ctx);
+}
+
+/**
+ * @brief Ask for a number
+ */
+bool MAIN_dialog_keypad(const char *title, const char *initial, MAIN_dialog_cb_t cb, void *ctx)
+{
+    return dialog_entry(title, initial, true, cb, ctx);
+}
+
+/**
+ * @brief Ask for text
+ */
+bool MAIN_dialog_keyboard(const char *title, const char *initial, MAIN_dialog_cb_t cb, void *ctx)
+{
+    return dialog_entry(title, initial, false, cb, ctx);
+}
+
+/**
+ * @brief Close a template's open dialog as cancelled
+ */
+void MAIN_dialog_close(MAIN_dialog_template_t tmpl)
+{
+    if (tmpl < DIALOG_TEMPLATE_COUNT)
+    {
+        dialog_finish(&dialogs[tmpl], false);
+    }
+}
+
+/**
+ * @brief Check for an open dialog
+ */
+bool MAIN_dialog_is_open(MAIN_dialog_template_t tmpl)
+{
+    return tmpl < DIALOG_TEMPLATE_COUNT && dialogs[tmpl].open;
+}
+
+/**
+ * @brief Dialog counters
+ */
+void MAIN_dialog_get_stats(MAIN_dialog_stats_t *stats)
+{
+    *stats = dialog_stats;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Dialog_getLibraryName() {
+    return MAIN_Dialog::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Dialog_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Dialog::VERSION_MAJOR,
+                       MAIN_Dialog::VERSION_MINOR,
+                       MAIN_Dialog::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Dialog_getVersionDate() {
+    return MAIN_Dialog::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Dialog_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Dialog_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/******************************************************************************
+ * End of MAIN_dialogLib.cpp
+ ******************************************************************************/
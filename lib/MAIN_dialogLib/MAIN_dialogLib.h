@@ -0,0 +1,197 @@
+/**
+ * @file MAIN_dialogLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Pooled dialogs: message, confirm, keypad and keyboard built once
+ * @details Creating a message box or a keyboard each time it is shown and
+ *          deleting it again costs its construction (a keyboard is a button
+ *          matrix of some forty buttons plus a text area) on the frame it
+ *          appears, and leaves holes of every size in the LVGL heap.
+ *
+ *          Two templates are built once on lv_layer_top, hidden, and reused:
+ *          a notice (title, text, OK and an optional Cancel) for messages
+ *          and confirmations, and an entry (title, one-line text area, an
+ *          lv_keyboard for text and a MAIN_keypadLib keypad for numbers,
+ *          its faces rendered when the entry is built). Showing one sets its
+ *          texts, shows the keyboard or the keypad and clears
+ *          LV_OBJ_FLAG_HIDDEN: a few label writes, no objects created, so it
+ *          is on screen the next frame.
+ *
+ *          MAIN_initialise_dialogs() builds the templates asked for up
+ *          front; any other is built on first use and kept. The stats count
+ *          shows served by a built template (hits) against builds.
+ *
+ *          One dialog of each template is open at a time. Showing one over
+ *          an open one replaces it, and the replaced one's callback runs
+ *          with ok false. A modal backdrop takes the touches meant for the
+ *          screen below while a dialog is open.
+ *
+ *          C callable for EEZ actions in src/ui. UI task only.
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_DIALOG_LIB_H__
+#define __MAIN_DIALOG_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <lvgl.h>
+
+#ifdef __cplusplus
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Dialog
+{
+    constexpr const char* LIB_NAME = "MAIN_Dialog";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "1";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_Dialog_getLibraryName();
+uint32_t MAIN_Dialog_getVersionEncoded();
+const char* MAIN_Dialog_getVersionDate();
+void MAIN_Dialog_getVersionString(char* buffer);
+
+extern "C" {
+#endif
+
+/******************************************************************************
+ * Dialog Configuration
+ *****************************************************************************/
+
+// Notice panel width (percent of the screen) and padding
+#define DIALOG_WIDTH_PCT 80
+#define DIALOG_PAD 12
+
+// Entry text length, including the terminator
+#define DIALOG_ENTRY_SIZE 64
+
+// Backdrop over the screen below an open dialog
+#define DIALOG_BACKDROP_OPA LV_OPA_50
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef enum
+{
+    DIALOG_TEMPLATE_NOTICE = 0, // Message and confirm
+    DIALOG_TEMPLATE_ENTRY,      // Keypad and keyboard
+    DIALOG_TEMPLATE_COUNT
+} MAIN_dialog_template_t;
+
+// MAIN_initialise_dialogs() masks
+#define DIALOG_BUILD_NOTICE (1U << DIALOG_TEMPLATE_NOTICE)
+#define DIALOG_BUILD_ENTRY (1U << DIALOG_TEMPLATE_ENTRY)
+#define DIALOG_BUILD_ALL (DIALOG_BUILD_NOTICE | DIALOG_BUILD_ENTRY)
+
+/**
+ * @brief Dialog closed
+ * @param ok true for OK (or Enter), false for Cancel or replaced
+ * @param text Entered text (keypad and keyboard), NULL otherwise; valid
+ *        during the call only
+ * @param ctx Context given to the show call
+ */
+typedef void (*MAIN_dialog_cb_t)(bool ok, const char *text, void *ctx);
+
+typedef struct
+{
+    uint32_t shows;             // Dialogs shown
+    uint32_t hits;              // Of those, from a template already built
+    uint32_t builds;            // Templates built
+    uint32_t replaced;          // Open dialogs replaced by a new show
+    uint32_t buildUs;           // Time spent building templates
+} MAIN_dialog_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Build templates ahead of their first show
+ * @param buildMask DIALOG_BUILD_* bits (0 = build each on first use)
+ * @return true if every template asked for was built
+ * @note UI task (or setup() before the tasks start), after the theme.
+ */
+bool MAIN_initialise_dialogs(uint8_t buildMask);
+
+/**
+ * @brief Show a message with an OK button
+ * @param title Title (copied)
+ * @param text Text (copied)
+ * @param cb Called on close (may be NULL)
+ * @param ctx Passed to cb
+ * @return true if shown
+ */
+bool MAIN_dialog_message(const char *title, const char *text, MAIN_dialog_cb_t cb, void *ctx);
+
+/**
+ * @brief Ask for OK or Cancel
+ * @param title Title (copied)
+ * @param text Question (copied)
+ * @param cb Called on close (may be NULL)
+ * @param ctx Passed to cb
+ * @return true if shown
+ */
+bool MAIN_dialog_confirm(const char *title, const char *text, MAIN_dialog_cb_t cb, void *ctx);
+
+/**
+ * @brief Ask for a number
+ * @param title Title (copied)
+ * @param initial Starting text (NULL = empty)
+ * @param cb Called on close with the text entered
+ * @param ctx Passed to cb
+ * @return true if shown
+ */
+bool MAIN_dialog_keypad(const char *title, const char *initial, MAIN_dialog_cb_t cb, void *ctx);
+
+/**
+ * @brief Ask for text
+ * @param title Title (copied)
+ * @param initial Starting text (NULL = empty)
+ * @param cb Called on close with the text entered
+ * @param ctx Passed to cb
+ * @return true if shown
+ */
+bool MAIN_dialog_keyboard(const char *title, const char *initial, MAIN_dialog_cb_t cb, void *ctx);
+
+/**
+ * @brief Close a template's open dialog as cancelled
+ * @param tmpl Template
+ */
+void MAIN_dialog_close(MAIN_dialog_template_t tmpl);
+
+/**
+ * @brief Check for an open dialog
+ * @param tmpl Template
+ * @return true if its dialog is showing
+ */
+bool MAIN_dialog_is_open(MAIN_dialog_template_t tmpl);
+
+/**
+ * @brief Dialog counters
+ * @param stats Receives the counters
+ */
+void MAIN_dialog_get_stats(MAIN_dialog_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MAIN_DIALOG_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_dialogLib.h
+ ******************************************************************************/
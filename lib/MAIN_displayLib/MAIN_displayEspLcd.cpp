@@ -0,0 +1,401 @@
+/**
+ * @file MAIN_displayEspLcd.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief ESP-IDF esp_lcd display backend for the ST7796
+ * @details Compiled only with EARS_DISPLAY_BACKEND=EARS_DISPLAY_BACKEND_ESP_LCD.
+ * @version 1.4.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_displayEspLcd.h"
+
+#if EARS_DISPLAY_BACKEND == EARS_DISPLAY_BACKEND_ESP_LCD
+
+#include "EARS_systemDef.h"
+#include <driver/spi_master.h>
+#include <esp_heap_caps.h>
+#if ESP_IDF_VERSION_MAJOR >= 5
+#include <esp_memory_utils.h>
+#else
+#include <soc/soc_memory_layout.h>
+#endif
+
+/******************************************************************************
+ * ST7796 Commands
+ *****************************************************************************/
+#define ST7796_SWRESET 0x01
+#define ST7796_SLPOUT 0x11
+#define ST7796_INVOFF 0x20
+#define ST7796_INVON 0x21
+#define ST7796_DISPON 0x29
+#define ST7796_CASET 0x2A
+#define ST7796_RASET 0x2B
+#define ST7796_RAMWR 0x2C
+#define ST7796_MADCTL 0x36
+#define ST7796_COLMOD 0x3A
+#define ST7796_RAMWRC 0x3C // Write memory continue
+#define ST7796_CSCON 0xF0  // Command set control
+
+#define ST7796_MADCTL_MY 0x80
+#define ST7796_MADCTL_MX 0x40
+#define ST7796_MADCTL_MV 0x20
+#define ST7796_MADCTL_BGR 0x08
+
+// Same MADCTL per rotation as Arduino_ST7796, so touch transforms carry over
+static const uint8_t esplcd_madctl[4] = {
+    ST7796_MADCTL_MX | ST7796_MADCTL_BGR,
+    ST7796_MADCTL_MX | ST7796_MADCTL_MY | ST7796_MADCTL_MV | ST7796_MADCTL_BGR,
+    ST7796_MADCTL_MY | ST7796_MADCTL_BGR,
+    ST7796_MADCTL_MV | ST7796_MADCTL_BGR};
+
+/******************************************************************************
+ * Construction and Start-up
+ *****************************************************************************/
+
+MAIN_EspLcdGFX::MAIN_EspLcdGFX(int8_t dc, int8_t cs, int8_t sclk, int8_t mosi, int8_t miso,
+                               int16_t w, int16_t h, uint8_t rotation, bool ips)
+    : Arduino_GFX(w, h),
+      _dc(dc),
+      _cs(cs),
+      _sclk(sclk),
+      _mosi(mosi),
+      _miso(miso),
+      _ips(ips),
+      _io(NULL),
+      _queued(0),
+      _done(0),
+      _doneSem(NULL),
+      _doneCallback(NULL),
+      _doneCtx(NULL),
+      _bounceNext(0)
+{
+    for (uint8_t i = 0; i < MAIN_ESPLCD_BOUNCE_COUNT; i++)
+    {
+        _bounce[i] = NULL;
+        _bounceTicket[i] = 0;
+    }
+    _rotation = rotation & 0x03;
+}
+
+bool MAIN_EspLcdGFX::begin(int32_t speed)
+{
+    if (_io != NULL)
+    {
+        return true;
+    }
+
+    // One transfer can carry a whole screen, so drawBitmapAsync never splits
+    spi_bus_config_t buscfg = {};
+    buscfg.sclk_io_num = _sclk;
+    buscfg.mosi_io_num = _mosi;
+    buscfg.miso_io_num = _miso;
+    buscfg.quadwp_io_num = -1;
+    buscfg.quadhd_io_num = -1;
+    buscfg.max_transfer_sz = (int)WIDTH * HEIGHT * 2;
+    if (spi_bus_initialize(MAIN_ESPLCD_SPI_HOST, &buscfg, SPI_DMA_CH_AUTO) != ESP_OK)
+    {
+        DEBUG_PRINTLN("[ERROR] esp_lcd: SPI bus init failed");
+        return false;
+    }
+
+    _doneSem = xSemaphoreCreateBinary();
+    for (uint8_t i = 0; i < MAIN_ESPLCD_BOUNCE_COUNT; i++)
+    {
+        _bounce[i] = (uint16_t *)heap_caps_malloc(MAIN_ESPLCD_BOUNCE_PIXELS * 2, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+        if (_bounce[i] == NULL)
+        {
+            DEBUG_PRINTLN("[ERROR] esp_lcd: no DMA RAM for bounce buffers");
+            return false;
+        }
+    }
+    if (_doneSem == NULL)
+    {
+        return false;
+    }
+
+    esp_lcd_panel_io_spi_config_t iocfg = {};
+    iocfg.cs_gpio_num = _cs;
+    iocfg.dc_gpio_num = _dc;
+    iocfg.spi_mode = 0;
+    iocfg.pclk_hz = (speed > 0) ? (uint32_t)speed : MAIN_ESPLCD_DEFAULT_HZ;
+    iocfg.trans_queue_depth = MAIN_ESPLCD_QUEUE_DEPTH;
+    iocfg.on_color_trans_done = onColorDone;
+    iocfg.user_ctx = this;
+    iocfg.lcd_cmd_bits = 8;
+    iocfg.lcd_param_bits = 8;
+    if (esp_lcd_new_panel_io_spi((esp_lcd_spi_bus_handle_t)MAIN_ESPLCD_SPI_HOST, &iocfg, &_io) != ESP_OK)
+    {
+        DEBUG_PRINTLN("[ERROR] esp_lcd: panel IO init failed");
+        _io = NULL;
+        return false;
+    }
+
+    // ST7796 start-up: reset, wake, unlock, RGB565, inversion, lock, on
+    static const uint8_t unlock1[] = {0xC3};
+    static const uint8_t unlock2[] = {0x96};
+    static const uint8_t lock1[] = {0x3C};
+    static const uint8_t lock2[] = {0x69};
+    static const uint8_t colmod[] = {0x55};
+
+    sendCommand(ST7796_SWRESET);
+    delay(120);
+    sendCommand(ST7796_SLPOUT);
+    delay(120);
+    sendCommand(ST7796_CSCON, unlock1, 1);
+    sendCommand(ST7796_CSCON, unlock2, 1);
+    sendCommand(ST7796_COLMOD, colmod, 1);
+    sendCommand(_ips ? ST7796_INVON : ST7796_INVOFF);
+    sendCommand(ST7796_CSCON, lock1, 1);
+    sendCommand(ST7796_CSCON, lock2, 1);
+    setRotation(_rotation);
+    sendCommand(ST7796_DISPON);
+    delay(20);
+
+    DEBUG_PRINTF("[OK] esp_lcd backend: %lu Hz, queue depth %u\n", (unsigned long)iocfg.pclk_hz,
+                 MAIN_ESPLCD_QUEUE_DEPTH);
+    return true;
+}
+
+/******************************************************************************
+ * Arduino_GFX Adapter
+ *****************************************************************************/
+
+void MAIN_EspLcdGFX::setRotation(uint8_t r)
+{
+    Arduino_GFX::setRotation(r);
+    if (_io != NULL)
+    {
+        uint8_t madctl = esplcd_madctl[_rotation & 0x03];
+        sendCommand(ST7796_MADCTL, &madctl, 1);
+    }
+}
+
+void MAIN_EspLcdGFX::writePixelPreclipped(int16_t x, int16_t y, uint16_t color)
+{
+    writeFillRectPreclipped(x, y, 1, 1, color);
+}
+
+void MAIN_EspLcdGFX::writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    if (_io == NULL || w <= 0 || h <= 0)
+    {
+        return;
+    }
+
+    setWindow(x, y, w, h);
+
+    // One bounce buffer of the colour, queued as often as the area needs
+    uint32_t remaining = (uint32_t)w * h;
+    uint32_t chunk = (remaining < MAIN_ESPLCD_BOUNCE_PIXELS) ? remaining : MAIN_ESPLCD_BOUNCE_PIXELS;
+    uint8_t b = nextBounce();
+    uint16_t swapped = (color >> 8) | (color << 8);
+    for (uint32_t i = 0; i < chunk; i++)
+    {
+        _bounce[b][i] = swapped;
+    }
+
+    bool first = true;
+    while (remaining > 0)
+    {
+        uint32_t n = (remaining < chunk) ? remaining : chunk;
+        _bounceTicket[b] = queueColor(first, _bounce[b], n * 2);
+        first = false;
+        remaining -= n;
+    }
+    waitIdle();
+}
+
+void MAIN_EspLcdGFX::draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h)
+{
+    if (_io == NULL || w <= 0 || h <= 0)
+    {
+        return;
+    }
+    if (x < 0 || y < 0 || x + w > _width || y + h > _height || w > MAIN_ESPLCD_BOUNCE_PIXELS)
+    {
+        // Partly off screen: Arduino_GFX clips and draws pixel by pixel
+        Arduino_GFX::draw16bitRGBBitmap(x, y, bitmap, w, h);
+        return;
+    }
+
+    setWindow(x, y, w, h);
+
+    // Swap whole rows into a bounce buffer while the other one is on the bus
+    int16_t rowsPerChunk = MAIN_ESPLCD_BOUNCE_PIXELS / w;
+    bool first = true;
+    for (int16_t row = 0; row < h; row += rowsPerChunk)
+    {
+        int16_t rows = (h - row < rowsPerChunk) ? (h - row) : rowsPerChunk;
+        uint32_t pixels = (uint32_t)rows * w;
+        const uint16_t *src = bitmap + (uint32_t)row * w;
+
+        uint8_t b = nextBounce();
+        uint16_t *dst = _bounce[b];
+        for (uint32_t i = 0; i < pixels; i++)
+        {
+            uint16_t v = src[i];
+            dst[i] = (v >> 8) | (v << 8);
+        }
+        _bounceTicket[b] = queueColor(first, dst, pixels * 2);
+        first = false;
+    }
+    waitIdle();
+}
+
+void MAIN_EspLcdGFX::draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h)
+{
+    if (_io == NULL || w <= 0 || h <= 0)
+    {
+        return;
+    }
+    if (x < 0 || y < 0 || x + w > _width || y + h > _height || w > MAIN_ESPLCD_BOUNCE_PIXELS)
+    {
+        Arduino_GFX::draw16bitBeRGBBitmap(x, y, bitmap, w, h);
+        return;
+    }
+
+    if (esp_ptr_dma_capable(bitmap))
+    {
+        drawBitmapAsync(x, y, bitmap, w, h);
+        waitIdle();
+        return;
+    }
+
+    setWindow(x, y, w, h);
+
+    int16_t rowsPerChunk = MAIN_ESPLCD_BOUNCE_PIXELS / w;
+    bool first = true;
+    for (int16_t row = 0; row < h; row += rowsPerChunk)
+    {
+        int16_t rows = (h - row < rowsPerChunk) ? (h - row) : rowsPerChunk;
+        uint32_t pixels = (uint32_t)rows * w;
+
+        uint8_t b = nextBounce();
+        memcpy(_bounce[b], bitmap + (uint32_t)row * w, pixels * 2);
+        _bounceTicket[b] = queueColor(first, _bounce[b], pixels * 2);
+        first = false;
+    }
+    waitIdle();
+}
+
+/******************************************************************************
+ * Asynchronous Path
+ *****************************************************************************/
+
+bool MAIN_EspLcdGFX::drawBitmapAsync(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h)
+{
+    if (_io == NULL || w <= 0 || h <= 0 || x < 0 || y < 0 || x + w > _width || y + h > _height)
+    {
+        return false;
+    }
+
+    setWindow(x, y, w, h);
+    return queueColor(true, bitmap, (size_t)w * h * 2) != 0;
+}
+
+void MAIN_EspLcdGFX::setTransferDoneCallback(MAIN_esplcd_done_cb_t callback, void *ctx)
+{
+    _doneCtx = ctx;
+    _doneCallback = callback;
+}
+
+bool MAIN_EspLcdGFX::waitIdle()
+{
+    return waitFor(_queued.load());
+}
+
+/******************************************************************************
+ * Internals
+ *****************************************************************************/
+
+void MAIN_EspLcdGFX::sendCommand(uint8_t cmd, const uint8_t *params, size_t len)
+{
+    // tx_param waits for queued colour transfers, so commands never overtake pixels
+    esp_lcd_panel_io_tx_param(_io, cmd, params, len);
+}
+
+void MAIN_EspLcdGFX::setWindow(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    uint16_t x2 = x + w - 1;
+    uint16_t y2 = y + h - 1;
+    uint8_t caset[4] = {(uint8_t)(x >> 8), (uint8_t)x, (uint8_t)(x2 >> 8), (uint8_t)x2};
+    uint8_t raset[4] = {(uint8_t)(y >> 8), (uint8_t)y, (uint8_t)(y2 >> 8), (uint8_t)y2};
+    sendCommand(ST7796_CASET, caset, 4);
+    sendCommand(ST7796_RASET, raset, 4);
+}
+
+/**
+ * @brief Queue one colour transfer
+ * @param first RAMWR (start of window) rather than RAMWRC (continue)
+ * @return uint32_t Transfer number to wait for, 0 if not queued
+ */
+uint32_t MAIN_EspLcdGFX::queueColor(bool first, const void *data, size_t bytes)
+{
+    uint32_t ticket = _queued.fetch_add(1) + 1;
+    if (esp_lcd_panel_io_tx_color(_io, first ? ST7796_RAMWR : ST7796_RAMWRC, data, bytes) != ESP_OK)
+    {
+        _queued.fetch_sub(1);
+        return 0;
+    }
+    return ticket;
+}
+
+/**
+ * @brief Sleep until colour transfer number ticket has finished
+ */
+bool MAIN_EspLcdGFX::waitFor(uint32_t ticket)
+{
+    while ((int32_t)(_done.load() - ticket) < 0)
+    {
+        if (xSemaphoreTake(_doneSem, pdMS_TO_TICKS(MAIN_ESPLCD_WAIT_MS)) != pdTRUE &&
+            (int32_t)(_done.load() - ticket) < 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Pick the next bounce buffer, waiting until its last transfer is done
+ * @return uint8_t Index into _bounce
+ */
+uint8_t MAIN_EspLcdGFX::nextBounce()
+{
+    uint8_t b = _bounceNext;
+    _bounceNext = (b + 1) % MAIN_ESPLCD_BOUNCE_COUNT;
+    waitFor(_bounceTicket[b]);
+    return b;
+}
+
+#if ESP_IDF_VERSION_MAJOR >= 5
+bool IRAM_ATTR MAIN_EspLcdGFX::onColorDone(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t *edata, void *ctx)
+#else
+bool IRAM_ATTR MAIN_EspLcdGFX::onColorDone(esp_lcd_panel_io_handle_t io, void *ctx, void *edata)
+#endif
+{
+    (void)io;
+    (void)edata;
+    MAIN_EspLcdGFX *self = static_cast<MAIN_EspLcdGFX *>(ctx);
+
+    self->_done.fetch_add(1);
+    if (self->_doneCallback != NULL)
+    {
+        self->_doneCallback(self->_doneCtx);
+    }
+
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(self->_doneSem, &woken);
+    return woken == pdTRUE;
+}
+
+#endif // EARS_DISPLAY_BACKEND == EARS_DISPLAY_BACKEND_ESP_LCD
+
+/******************************************************************************
+ * End of MAIN_displayEspLcd.cpp
+ ******************************************************************************/
@@ -0,0 +1,185 @@
+/**
+ * @file MAIN_displayEspLcd.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief ESP-IDF esp_lcd display backend for the ST7796
+ * @details Optional replacement for Arduino_ESP32SPI + Arduino_ST7796,
+ *          selected with EARS_DISPLAY_BACKEND=EARS_DISPLAY_BACKEND_ESP_LCD.
+ *          Pixels go out through esp_lcd_panel_io_spi as queued DMA
+ *          transactions (MAIN_ESPLCD_QUEUE_DEPTH deep) and every finished
+ *          colour transfer raises a callback from the SPI ISR.
+ *          MAIN_EspLcdGFX derives from Arduino_GFX, so MAIN_drawingLib,
+ *          MAIN_lvglLib and the test pattern keep calling the usual
+ *          Arduino_GFX methods; those stay synchronous (they return once
+ *          the pixels are on the panel). drawBitmapAsync() is the zero-copy
+ *          path for callers that track completion themselves.
+ *
+ *          The panel is driven by a short ST7796 init sequence sent with
+ *          esp_lcd_panel_io_tx_param (IDF 4.4 ships no ST7796 driver).
+ *          Pixels are sent MSB first, so Arduino_GFX-order RGB565 (little
+ *          endian in RAM) is byte swapped into DMA bounce buffers while the
+ *          previous chunk is still on the bus.
+ * @version 1.4.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_DISPLAY_ESP_LCD_H__
+#define __MAIN_DISPLAY_ESP_LCD_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <Arduino_GFX_Library.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <esp_idf_version.h>
+#include <esp_lcd_panel_io.h>
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+#define EARS_DISPLAY_BACKEND_ARDUINO_GFX 0 // Arduino_ESP32SPI + Arduino_ST7796
+#define EARS_DISPLAY_BACKEND_ESP_LCD 1     // MAIN_EspLcdGFX
+
+#ifndef EARS_DISPLAY_BACKEND
+#define EARS_DISPLAY_BACKEND EARS_DISPLAY_BACKEND_ARDUINO_GFX
+#endif
+
+#ifndef MAIN_ESPLCD_QUEUE_DEPTH
+#define MAIN_ESPLCD_QUEUE_DEPTH 4 // Colour transactions queued in the SPI driver
+#endif
+#define MAIN_ESPLCD_SPI_HOST SPI2_HOST     // FSPI, the host Arduino_ESP32SPI uses
+#define MAIN_ESPLCD_DEFAULT_HZ 40000000    // Pixel clock when begin() gets no speed
+#define MAIN_ESPLCD_BOUNCE_PIXELS 4800     // Pixels per DMA bounce buffer (10 lines at 480)
+#define MAIN_ESPLCD_BOUNCE_COUNT 2         // Bounce buffers in rotation (<= queue depth)
+#define MAIN_ESPLCD_WAIT_MS 100            // Longest wait for one transfer before giving up
+
+/**
+ * @brief Colour transfer done callback, called from the SPI ISR
+ * @param ctx Context given to setTransferDoneCallback
+ */
+typedef void (*MAIN_esplcd_done_cb_t)(void *ctx);
+
+/******************************************************************************
+ * MAIN_EspLcdGFX Class
+ *****************************************************************************/
+class MAIN_EspLcdGFX : public Arduino_GFX
+{
+public:
+    /**
+     * @brief Describe the panel; nothing is touched until begin()
+     * @param dc Data/command pin
+     * @param cs Chip select pin (-1 = tied low)
+     * @param sclk SPI clock pin
+     * @param mosi SPI MOSI pin
+     * @param miso SPI MISO pin (-1 = none)
+     * @param w Native (rotation 0) width
+     * @param h Native (rotation 0) height
+     * @param rotation Initial rotation 0-3, as Arduino_GFX setRotation
+     * @param ips Panel needs display inversion (INVON)
+     */
+    MAIN_EspLcdGFX(int8_t dc, int8_t cs, int8_t sclk, int8_t mosi, int8_t miso,
+                   int16_t w, int16_t h, uint8_t rotation = 0, bool ips = false);
+
+    /**
+     * @brief Start the SPI bus, panel IO and ST7796
+     * @param speed Pixel clock in Hz (GFX_NOT_DEFINED = MAIN_ESPLCD_DEFAULT_HZ)
+     * @return true if the panel is ready
+     */
+    bool begin(int32_t speed = GFX_NOT_DEFINED) override;
+
+    /**
+     * @brief Rotate in hardware (MADCTL) and update width/height
+     */
+    void setRotation(uint8_t r) override;
+
+    void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override;
+    void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
+
+    /**
+     * @brief Draw a bitmap already in panel (big-endian) byte order
+     * @details DMA-capable buffers go out as one transfer with no copy, so
+     *          LVGL's RGB565_SWAPPED strips reach the bus untouched; PSRAM
+     *          buffers are copied (not swapped) through the bounce buffers.
+     */
+    void draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
+
+    /**
+     * @brief Queue a bitmap without copying or waiting
+     * @details bitmap must be DMA capable (internal RAM), already big endian
+     *          (panel byte order) and untouched until its transfer-done
+     *          callback, which fires once per call. Waits only if the SPI
+     *          queue is full or a command must wait for earlier transfers.
+     * @return true if queued
+     */
+    bool drawBitmapAsync(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h);
+
+    /**
+     * @brief Register the colour transfer done callback (ISR context)
+     * @param callback Function to call, NULL to clear
+     * @param ctx Passed back to callback
+     */
+    void setTransferDoneCallback(MAIN_esplcd_done_cb_t callback, void *ctx);
+
+    /**
+     * @brief Block until every queued colour transfer has finished
+     * @return true if the queue drained within MAIN_ESPLCD_WAIT_MS per transfer
+     */
+    bool waitIdle();
+
+    /**
+     * @brief Get the SPI transaction queue depth
+     * @return uint8_t MAIN_ESPLCD_QUEUE_DEPTH
+     */
+    uint8_t getQueueDepth() const { return MAIN_ESPLCD_QUEUE_DEPTH; }
+
+    /**
+     * @brief Get the panel IO handle for direct esp_lcd calls
+     * @return esp_lcd_panel_io_handle_t NULL before begin()
+     */
+    esp_lcd_panel_io_handle_t getPanelIo() const { return _io; }
+
+private:
+    int8_t _dc;
+    int8_t _cs;
+    int8_t _sclk;
+    int8_t _mosi;
+    int8_t _miso;
+    bool _ips;
+    esp_lcd_panel_io_handle_t _io; // NULL until begin()
+
+    // Colour transfers: _queued written by the drawing task, _done by the ISR
+    std::atomic<uint32_t> _queued;
+    std::atomic<uint32_t> _done;
+    SemaphoreHandle_t _doneSem;    // Given by the ISR after each transfer
+    MAIN_esplcd_done_cb_t _doneCallback;
+    void *_doneCtx;
+
+    // DMA bounce buffers and the transfer number that last used each
+    uint16_t *_bounce[MAIN_ESPLCD_BOUNCE_COUNT];
+    uint32_t _bounceTicket[MAIN_ESPLCD_BOUNCE_COUNT];
+    uint8_t _bounceNext;
+
+    void sendCommand(uint8_t cmd, const uint8_t *params = NULL, size_t len = 0);
+    void setWindow(int16_t x, int16_t y, int16_t w, int16_t h);
+    uint32_t queueColor(bool first, const void *data, size_t bytes);
+    bool waitFor(uint32_t ticket);
+    uint8_t nextBounce();
+
+#if ESP_IDF_VERSION_MAJOR >= 5
+    static bool IRAM_ATTR onColorDone(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t *edata, void *ctx);
+#else
+    static bool IRAM_ATTR onColorDone(esp_lcd_panel_io_handle_t io, void *ctx, void *edata);
+#endif
+};
+
+#endif // __MAIN_DISPLAY_ESP_LCD_H__
+
+/******************************************************************************
+ * End of MAIN_displayEspLcd.h
+ ******************************************************************************/
@@ -3,8 +3,8 @@
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief Display initialisation and management for EARS
  * @details Handles Arduino GFX library initialisation for Waveshare 3.5" LCD
- * @version 1.0.0
- * @date 20260210
+ * @version 1.7.0
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -15,22 +15,100 @@
 #include "MAIN_displayLib.h"
 #include "MAIN_drawingLib.h" // â† Need this for MAIN_clear_screen()
 #include "EARS_systemDef.h"
+#include "EARS_touchLib.h"
+#include "MAIN_splashLib.h"
+#include "MAIN_displayEspLcd.h"
+#include "EARS_rtosTraceLib.h"
+#include <Preferences.h>
 
 // Only include LED lib if debug mode enabled
 #if EARS_DEBUG == 1
 #include "MAIN_ledLib.h"
 #endif
 
+/******************************************************************************
+ * Module State
+ *****************************************************************************/
+
+// Rotation last written to the panel (0-3)
+static uint8_t display_rotation = MAIN_DISPLAY_ROTATION;
+
+// Power state manager: panel, bus and the state last applied
+static Arduino_GFX *display_power_gfx = NULL;
+static Arduino_DataBus *display_power_bus = NULL;
+static SemaphoreHandle_t display_power_mutex = NULL;
+static MAIN_display_power_t display_power_state = MAIN_DISPLAY_POWER_NORMAL;
+
+// Colour bars drawn by MAIN_display_test_pattern, left to right
+static const uint16_t test_pattern_bars[8] = {
+    EARS_RGB565_RED, EARS_RGB565_GREEN, EARS_RGB565_BLUE, EARS_RGB565_YELLOW,
+    EARS_RGB565_CYAN, EARS_RGB565_MAGENTA, EARS_RGB565_WHITE, EARS_RGB565_GRAY};
+
+// Calibration steps: the S3 SPI clock is 80 MHz APB / n, so nothing lies
+// between the 40 MHz base and 80 MHz
+static const uint32_t spi_steps_hz[] = {MAIN_DISPLAY_SPI_BASE_HZ, 80000000};
+
+// ST7796 commands used for readback, the tearing-effect output and the
+// power states
+#define ST7796_CASET 0x2A
+#define ST7796_RASET 0x2B
+#define ST7796_RAMRD 0x2E
+#define ST7796_TEON 0x35
+#define ST7796_IDMOFF 0x38
+#define ST7796_IDMON 0x39
+#define ST7796_FRMCTR1 0xB1
+
 /******************************************************************************
  * Display Initialisation
  *****************************************************************************/
 
+/**
+ * @brief Send one panel command and its parameters
+ * @param gfx Display (the esp_lcd backend sends through its panel IO)
+ * @param bus Display bus (Arduino_GFX backend)
+ * @param cmd Command
+ * @param data Parameters (NULL when len is 0)
+ * @param len Number of parameters
+ */
+static void display_send_command(Arduino_GFX *gfx, Arduino_DataBus *bus, uint8_t cmd, const uint8_t *data, uint8_t len)
+{
+#if EARS_DISPLAY_BACKEND == EARS_DISPLAY_BACKEND_ESP_LCD
+    (void)bus;
+    esp_lcd_panel_io_tx_param(((MAIN_EspLcdGFX *)gfx)->getPanelIo(), cmd, data, len);
+#else
+    (void)gfx;
+    if (bus != NULL)
+    {
+        bus->beginWrite();
+        bus->writeCommand(cmd);
+        for (uint8_t i = 0; i < len; i++)
+        {
+            bus->write(data[i]);
+        }
+        bus->endWrite();
+    }
+#endif
+}
+
+#if LCD_TE >= 0
+/**
+ * @brief Turn on the panel's TE output, pulsing once per V-blank
+ * @param gfx Display (the esp_lcd backend sends through its panel IO)
+ * @param bus Display bus (Arduino_GFX backend)
+ */
+static void display_enable_te(Arduino_GFX *gfx, Arduino_DataBus *bus)
+{
+    uint8_t mode = 0x00; // TEM = 0: V-blank only
+    display_send_command(gfx, bus, ST7796_TEON, &mode, 1);
+}
+#endif
+
 /**
  * @brief Initialise the display hardware
  * @param gfx Pointer to Arduino_GFX object
  * @return true if successful, false if failed
  */
-bool MAIN_initialise_display(Arduino_GFX *gfx)
+bool MAIN_initialise_display(Arduino_GFX *gfx, Arduino_DataBus *bus)
 {
     DEBUG_PRINTLN("[INIT] Initialising display...");
 
@@ -42,8 +120,9 @@ bool MAIN_initialise_display(Arduino_GFX *gfx)
     // Step 2: Small delay to ensure display power stable
     delay(100);
 
-    // Step 3: Initialise the display hardware
-    if (!gfx->begin())
+    // Step 3: Initialise the display hardware at the calibrated clock
+    uint32_t spiHz = MAIN_display_get_stored_spi_hz();
+    if (!gfx->begin(spiHz ? (int32_t)spiHz : GFX_NOT_DEFINED))
     {
         DEBUG_PRINTLN("[ERROR] Display initialisation failed!");
 #if EARS_DEBUG == 1
@@ -55,9 +134,30 @@ bool MAIN_initialise_display(Arduino_GFX *gfx)
 
     DEBUG_PRINTLN("[OK] Display hardware initialised");
 
-    // Step 4: Set display rotation (1 = landscape, USB port on left)
-    gfx->setRotation(1);
-    DEBUG_PRINTLN("[OK] Display rotation set to landscape");
+    // Step 4: Set display rotation in hardware (MADCTL), touch to match
+    gfx->setRotation(MAIN_DISPLAY_ROTATION);
+    display_rotation = MAIN_DISPLAY_ROTATION;
+    if (EARS_touch::getInstance() != nullptr)
+    {
+        EARS_touch::getInstance()->setRotation(display_rotation);
+    }
+    DEBUG_PRINTF("[OK] Display rotation %u (%dx%d)\n", display_rotation, gfx->width(), gfx->height());
+
+#if EARS_DISPLAY_SPI_CALIBRATE == 1
+    // Step 4b: First boot only, while the backlight hides the test pattern
+    if (spiHz == 0 && bus != NULL)
+    {
+        MAIN_display_calibrate_spi(gfx, bus);
+    }
+#else
+    (void)bus;
+#endif
+
+#if LCD_TE >= 0
+    // Step 4c: Tearing-effect output for MAIN_lvglLib's flush pacing
+    display_enable_te(gfx, bus);
+    DEBUG_PRINTF("[OK] Display TE output on GPIO%d\n", LCD_TE);
+#endif
 
     // Step 5: CRITICAL - Fill screen BLACK multiple times to clear ST7796 framebuffer
     DEBUG_PRINTLN("[INFO] Clearing display framebuffer...");
@@ -68,6 +168,9 @@ bool MAIN_initialise_display(Arduino_GFX *gfx)
     }
     DEBUG_PRINTLN("[OK] Display framebuffer cleared");
 
+    // Step 5b: Boot splash, so the backlight comes on to it
+    MAIN_splash_show(gfx);
+
     // Step 6: Turn backlight ON
     digitalWrite(GFX_BL, HIGH);
     DEBUG_PRINTLN("[OK] Backlight ON");
@@ -89,36 +192,330 @@ void MAIN_display_test_pattern(Arduino_GFX *gfx)
 {
     DEBUG_PRINTLN("[TEST] Drawing test pattern...");
 
-    // Clear screen
-    MAIN_clear_screen(gfx, EARS_RGB565_BLACK);
+    // One command list: a window per band instead of one per primitive
+    MAIN_draw_list_begin(gfx);
+    MAIN_draw_list_clear(EARS_RGB565_BLACK);
 
     // Draw colour bars (vertical stripes)
-    uint16_t barWidth = TFT_WIDTH / 8;
+    int16_t width = gfx->width();
+    int16_t height = gfx->height();
+    uint16_t barWidth = width / 8;
 
-    gfx->fillRect(0 * barWidth, 0, barWidth, TFT_HEIGHT, EARS_RGB565_RED);
-    gfx->fillRect(1 * barWidth, 0, barWidth, TFT_HEIGHT, EARS_RGB565_GREEN);
-    gfx->fillRect(2 * barWidth, 0, barWidth, TFT_HEIGHT, EARS_RGB565_BLUE);
-    gfx->fillRect(3 * barWidth, 0, barWidth, TFT_HEIGHT, EARS_RGB565_YELLOW);
-    gfx->fillRect(4 * barWidth, 0, barWidth, TFT_HEIGHT, EARS_RGB565_CYAN);
-    gfx->fillRect(5 * barWidth, 0, barWidth, TFT_HEIGHT, EARS_RGB565_MAGENTA);
-    gfx->fillRect(6 * barWidth, 0, barWidth, TFT_HEIGHT, EARS_RGB565_WHITE);
-    gfx->fillRect(7 * barWidth, 0, barWidth, TFT_HEIGHT, EARS_RGB565_GRAY);
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        MAIN_draw_list_filled_rect(i * barWidth, 0, barWidth, height, test_pattern_bars[i]);
+    }
 
     // Draw text overlay
-    gfx->setTextColor(EARS_RGB565_WHITE);
-    gfx->setTextSize(2);
-    gfx->setCursor(10, 10);
-    gfx->println("EARS Display Test");
+    char resolution[DRAW_LIST_TEXT_SIZE];
+    snprintf(resolution, sizeof(resolution), "Resolution: %dx%d", width, height);
+    MAIN_draw_list_text(10, 10, "EARS Display Test", EARS_RGB565_WHITE, 2);
+    MAIN_draw_list_text(10, 40, resolution, EARS_RGB565_WHITE, 2);
 
-    gfx->setCursor(10, 40);
-    gfx->print("Resolution: ");
-    gfx->print(TFT_WIDTH);
-    gfx->print("x");
-    gfx->println(TFT_HEIGHT);
+    MAIN_draw_list_submit();
 
     DEBUG_PRINTLN("[OK] Test pattern drawn");
 }
 
+/******************************************************************************
+ * SPI Clock Calibration
+ *****************************************************************************/
+
+/**
+ * @brief Clock one byte out on MOSI (bit-banged, SPI mode 0)
+ */
+static void display_bb_write(uint8_t value)
+{
+    for (uint8_t bit = 0; bit < 8; bit++)
+    {
+        digitalWrite(SPI_MOSI, (value & 0x80) ? HIGH : LOW);
+        digitalWrite(SPI_SCLK, HIGH);
+        digitalWrite(SPI_SCLK, LOW);
+        value <<= 1;
+    }
+}
+
+/**
+ * @brief Clock one byte in from MISO (bit-banged, SPI mode 0)
+ */
+static uint8_t display_bb_read(void)
+{
+    uint8_t value = 0;
+    for (uint8_t bit = 0; bit < 8; bit++)
+    {
+        digitalWrite(SPI_SCLK, HIGH);
+        value = (value << 1) | (digitalRead(SPI_MISO) ? 1 : 0);
+        digitalWrite(SPI_SCLK, LOW);
+    }
+    return value;
+}
+
+/**
+ * @brief Send a command and 16-bit start/end pair (CASET or RASET)
+ */
+static void display_bb_window(uint8_t command, uint16_t start, uint16_t end)
+{
+    digitalWrite(LCD_DC, LOW);
+    display_bb_write(command);
+    digitalWrite(LCD_DC, HIGH);
+    display_bb_write(start >> 8);
+    display_bb_write(start & 0xFF);
+    display_bb_write(end >> 8);
+    display_bb_write(end & 0xFF);
+}
+
+/**
+ * @brief Read one panel row with RAMRD
+ * @details Takes the SPI pins off the peripheral and bit-bangs well under
+ *          the ST7796 read clock limit; the caller restores the bus with
+ *          begin(). Each pixel reads back as 3 bytes (RGB666).
+ * @param y Row in the current rotation
+ * @param width Pixels in the row
+ * @param out width * 3 bytes
+ */
+static void display_read_row(int16_t y, int16_t width, uint8_t *out)
+{
+    pinMode(SPI_SCLK, OUTPUT);
+    pinMode(SPI_MOSI, OUTPUT);
+    pinMode(SPI_MISO, INPUT);
+    pinMode(LCD_DC, OUTPUT);
+    digitalWrite(SPI_SCLK, LOW);
+#if LCD_CS >= 0
+    pinMode(LCD_CS, OUTPUT);
+    digitalWrite(LCD_CS, LOW);
+#endif
+
+    display_bb_window(ST7796_CASET, 0, width - 1);
+    display_bb_window(ST7796_RASET, y, y);
+
+    digitalWrite(LCD_DC, LOW);
+    display_bb_write(ST7796_RAMRD);
+    digitalWrite(LCD_DC, HIGH);
+    display_bb_read(); // Dummy byte
+    for (int32_t i = 0; i < (int32_t)width * 3; i++)
+    {
+        out[i] = display_bb_read();
+    }
+
+#if LCD_CS >= 0
+    digitalWrite(LCD_CS, HIGH);
+#endif
+}
+
+/**
+ * @brief Draw the test pattern at a clock and read back its bottom row
+ */
+static void display_sample_row(Arduino_GFX *gfx, Arduino_DataBus *bus, uint32_t hz, uint8_t *out)
+{
+    bus->begin((int32_t)hz);
+    MAIN_display_test_pattern(gfx);
+    display_read_row(gfx->height() - 1, gfx->width(), out);
+}
+
+/**
+ * @brief Find and store the fastest SPI clock the panel accepts
+ */
+uint32_t MAIN_display_calibrate_spi(Arduino_GFX *gfx, Arduino_DataBus *bus)
+{
+    if (gfx == NULL || bus == NULL)
+    {
+        return 0;
+    }
+
+    DEBUG_PRINTLN("[INIT] Calibrating display SPI clock...");
+
+    // Bottom row: below the test pattern text, crosses every colour bar
+    size_t rowBytes = (size_t)gfx->width() * 3;
+    uint8_t *reference = (uint8_t *)malloc(rowBytes);
+    uint8_t *sample = (uint8_t *)malloc(rowBytes);
+    uint32_t bestHz = MAIN_DISPLAY_SPI_BASE_HZ;
+
+    if (reference != NULL && sample != NULL)
+    {
+        display_sample_row(gfx, bus, MAIN_DISPLAY_SPI_BASE_HZ, reference);
+
+        // Readback only proves anything if the bars differ (MISO wired up)
+        uint16_t barBytes = (gfx->width() / 8) * 3;
+        if (memcmp(reference, reference + barBytes, 3) == 0)
+        {
+            DEBUG_PRINTLN("[WARN] Display readback unavailable, keeping base SPI clock");
+        }
+        else
+        {
+            for (size_t step = 1; step < sizeof(spi_steps_hz) / sizeof(spi_steps_hz[0]); step++)
+            {
+                bool stable = true;
+                for (uint8_t pass = 0; pass < MAIN_DISPLAY_SPI_VERIFY_PASSES && stable; pass++)
+                {
+                    display_sample_row(gfx, bus, spi_steps_hz[step], sample);
+                    stable = (memcmp(reference, sample, rowBytes) == 0);
+                }
+                DEBUG_PRINTF("[INFO] SPI %lu Hz: %s\n", (unsigned long)spi_steps_hz[step], stable ? "stable" : "FAILED");
+                if (!stable)
+                {
+                    break;
+                }
+                bestHz = spi_steps_hz[step];
+            }
+        }
+    }
+    else
+    {
+        DEBUG_PRINTLN("[WARN] No RAM for SPI calibration, keeping base SPI clock");
+    }
+    free(reference);
+    free(sample);
+
+    bus->begin((int32_t)bestHz);
+
+    // Stored even when readback is unavailable, so boot does not retry
+    Preferences prefs;
+    if (prefs.begin(MAIN_DISPLAY_NVS_NAMESPACE, false))
+    {
+        prefs.putULong(MAIN_DISPLAY_NVS_SPI_KEY, bestHz);
+        prefs.end();
+    }
+
+    DEBUG_PRINTF("[OK] Display SPI clock %lu Hz\n", (unsigned long)bestHz);
+    return bestHz;
+}
+
+/**
+ * @brief Get the SPI clock stored by MAIN_display_calibrate_spi
+ */
+uint32_t MAIN_display_get_stored_spi_hz(void)
+{
+    Preferences prefs;
+    if (!prefs.begin(MAIN_DISPLAY_NVS_NAMESPACE, true))
+    {
+        return 0;
+    }
+    uint32_t hz = prefs.getULong(MAIN_DISPLAY_NVS_SPI_KEY, 0);
+    prefs.end();
+    return hz;
+}
+
+/******************************************************************************
+ * Orientation
+ *****************************************************************************/
+
+/**
+ * @brief Rotate the panel, LVGL and touch together
+ */
+bool MAIN_display_set_orientation(Arduino_GFX *gfx, SemaphoreHandle_t displayMutex, uint8_t rotation)
+{
+    if (gfx == NULL)
+    {
+        return false;
+    }
+    rotation &= 0x03;
+
+    // MADCTL write: areas still queued for the flush task land in the new
+    // orientation, but the resize below invalidates the whole screen anyway
+    if (displayMutex != NULL && xSemaphoreTake(displayMutex, portMAX_DELAY) != pdTRUE)
+    {
+        return false;
+    }
+    gfx->setRotation(rotation);
+    if (displayMutex != NULL)
+    {
+        xSemaphoreGive(displayMutex);
+    }
+    display_rotation = rotation;
+
+    lv_display_t *disp = lv_display_get_default();
+    if (disp != NULL)
+    {
+        lv_display_set_resolution(disp, gfx->width(), gfx->height());
+    }
+
+    if (EARS_touch::getInstance() != nullptr)
+    {
+        EARS_touch::getInstance()->setRotation(rotation);
+    }
+
+    DEBUG_PRINTF("[OK] Display rotation %u (%dx%d)\n", rotation, gfx->width(), gfx->height());
+    return true;
+}
+
+/**
+ * @brief Get the current panel rotation
+ */
+uint8_t MAIN_display_get_orientation(void)
+{
+    return display_rotation;
+}
+
+/******************************************************************************
+ * Power State
+ *****************************************************************************/
+
+/**
+ * @brief Give the power state manager the panel and its bus
+ */
+void MAIN_initialise_display_power(Arduino_GFX *gfx, Arduino_DataBus *bus, SemaphoreHandle_t displayMutex)
+{
+    display_power_gfx = gfx;
+    display_power_bus = bus;
+    display_power_mutex = displayMutex;
+    display_power_state = MAIN_DISPLAY_POWER_NORMAL;
+}
+
+/**
+ * @brief Move the panel to a power state
+ */
+void MAIN_display_set_power_state(MAIN_display_power_t state)
+{
+    if (state == display_power_state || display_power_gfx == NULL || display_power_mutex == NULL)
+    {
+        return;
+    }
+
+    bool slowWas = display_power_state != MAIN_DISPLAY_POWER_NORMAL;
+    bool slow = state != MAIN_DISPLAY_POWER_NORMAL;
+    bool idleWas = (MAIN_DISPLAY_SAVER_IDLE_MODE == 1) && display_power_state == MAIN_DISPLAY_POWER_SAVER;
+    bool idle = (MAIN_DISPLAY_SAVER_IDLE_MODE == 1) && state == MAIN_DISPLAY_POWER_SAVER;
+
+    // Waits for any flush still using the bus
+    EARS_RTOS_TRACE_BEGIN(RTOS_TRACE_MUTEX_WAIT);
+    if (xSemaphoreTake(display_power_mutex, portMAX_DELAY) != pdTRUE)
+    {
+        return;
+    }
+    EARS_RTOS_TRACE_END(RTOS_TRACE_MUTEX_WAIT);
+    EARS_RTOS_TRACE_BEGIN(RTOS_TRACE_MUTEX_HOLD);
+
+    // Static content looks the same at half the panel refresh; the TE
+    // period MAIN_lvglLib measures follows the change
+    if (slow != slowWas)
+    {
+        uint8_t frmctr[2] = {slow ? (uint8_t)MAIN_DISPLAY_FRMCTR_STATIC : (uint8_t)MAIN_DISPLAY_FRMCTR_NORMAL,
+                             MAIN_DISPLAY_FRMCTR_RTNA};
+        display_send_command(display_power_gfx, display_power_bus, ST7796_FRMCTR1, frmctr, 2);
+    }
+    if (idle != idleWas)
+    {
+        display_send_command(display_power_gfx, display_power_bus, idle ? ST7796_IDMON : ST7796_IDMOFF, NULL, 0);
+    }
+
+    xSemaphoreGive(display_power_mutex);
+    EARS_RTOS_TRACE_END(RTOS_TRACE_MUTEX_HOLD);
+
+    // The screensaver owns the backlight under SAVER; the policy controller
+    // fades to the scaled level on its next service()
+    using_backlightmanager().setStaticScale(state == MAIN_DISPLAY_POWER_STATIC ? MAIN_DISPLAY_STATIC_BACKLIGHT : 100);
+
+    display_power_state = state;
+}
+
+/**
+ * @brief Get the panel power state
+ */
+MAIN_display_power_t MAIN_display_get_power_state(void)
+{
+    return display_power_state;
+}
+
 /******************************************************************************
  * Library Version Information Getters
  *****************************************************************************/
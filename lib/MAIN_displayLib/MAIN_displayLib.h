@@ -3,8 +3,21 @@
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief Display initialisation and management for EARS
  * @details Handles Arduino GFX library initialisation for Waveshare 3.5" LCD
- * @version 1.0.0
- * @date 20260210
+ *          and owns the panel orientation: MAIN_display_set_orientation
+ *          rotates in hardware (ST7796 MADCTL via setRotation), resizes the
+ *          LVGL display and switches the touch transform in one call.
+ *          MAIN_display_calibrate_spi finds the fastest SPI clock whose
+ *          writes read back intact (RAMRD over SPI_MISO) and keeps it in NVS.
+ *          With LCD_TE routed, the panel's tearing-effect output is turned
+ *          on at init for MAIN_lvglLib's flush pacing.
+ *          The panel power state follows the refresh governor
+ *          (MAIN_core0TasksLib): on static screens the ST7796 frame rate
+ *          is halved (FRMCTR1) and the backlight scaled down slightly;
+ *          under the screensaver the panel runs in idle mode (IDMON, 8
+ *          colours). Motion or a touch restores normal mode.
+ *          MAIN_displayEspLcd.h holds the optional esp_lcd backend.
+ * @version 1.7.0
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -22,6 +35,30 @@
 #include "EARS_ws35tlcdPins.h"
 #include "EARS_rgb565ColoursDef.h"
 #include "EARS_backLightManagerLib.h"
+#include <lvgl.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+#define MAIN_DISPLAY_ROTATION 1 // Boot rotation: 0/2 portrait, 1/3 landscape (1 = USB port on left)
+
+// SPI clock calibration (EARS_DISPLAY_SPI_CALIBRATE=1 runs it on first boot)
+#ifndef EARS_DISPLAY_SPI_CALIBRATE
+#define EARS_DISPLAY_SPI_CALIBRATE 0
+#endif
+#define MAIN_DISPLAY_SPI_BASE_HZ 40000000     // Arduino_ESP32SPI default, known good
+#define MAIN_DISPLAY_SPI_VERIFY_PASSES 3      // Clean readbacks needed per step
+#define MAIN_DISPLAY_NVS_NAMESPACE "display"  // Preferences namespace
+#define MAIN_DISPLAY_NVS_SPI_KEY "spi_hz"     // Calibrated clock, absent = not calibrated
+
+// Panel power states (MAIN_display_set_power_state)
+#define MAIN_DISPLAY_FRMCTR_NORMAL 0xA0       // FRMCTR1 FRS/DIVA: about 60 Hz (reset default)
+#define MAIN_DISPLAY_FRMCTR_STATIC 0xA1       // DIVA = fosc/2: about 30 Hz
+#define MAIN_DISPLAY_FRMCTR_RTNA 0x10         // FRMCTR1 line period (reset default)
+#define MAIN_DISPLAY_STATIC_BACKLIGHT 90      // Backlight scale on static screens (percent)
+#define MAIN_DISPLAY_SAVER_IDLE_MODE 1        // 1 = IDMON under the screensaver
 
 /******************************************************************************
  * Library Version Information
@@ -30,9 +67,9 @@ namespace MAIN_Display
 {
     constexpr const char* LIB_NAME = "MAIN_Display";
     constexpr const char* VERSION_MAJOR = "1";
-    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_MINOR = "7";
     constexpr const char* VERSION_PATCH = "0";
-    constexpr const char* VERSION_DATE = "2026-02-10";
+    constexpr const char* VERSION_DATE = "2026-10-15";
 }
 
 
@@ -42,16 +79,35 @@ uint32_t MAIN_Display_getVersionEncoded();
 const char* MAIN_Display_getVersionDate();
 void MAIN_Display_getVersionString(char* buffer);
 
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+/**
+ * @enum MAIN_display_power_t
+ * @brief Panel power states, full power first
+ */
+enum MAIN_display_power_t
+{
+    MAIN_DISPLAY_POWER_NORMAL = 0, // Full frame rate, full colour, user backlight
+    MAIN_DISPLAY_POWER_STATIC,     // Half frame rate, backlight scaled down
+    MAIN_DISPLAY_POWER_SAVER       // Half frame rate and idle mode (8 colours)
+};
+
 /******************************************************************************
  * Function Prototypes
  *****************************************************************************/
 
 /**
  * @brief Initialise the display hardware and backlight
+ * @details Starts the bus at the clock stored by MAIN_display_calibrate_spi,
+ *          or the library default. With EARS_DISPLAY_SPI_CALIBRATE and no
+ *          stored clock, calibrates while the backlight is still off.
  * @param gfx Pointer to Arduino_GFX object
+ * @param bus Display bus, needed only for calibration (NULL = skip)
  * @return true if successful, false if failed
  */
-bool MAIN_initialise_display(Arduino_GFX *gfx);
+bool MAIN_initialise_display(Arduino_GFX *gfx, Arduino_DataBus *bus = NULL);
 
 /**
  * @brief Test display with colour bars
@@ -59,6 +115,73 @@ bool MAIN_initialise_display(Arduino_GFX *gfx);
  */
 void MAIN_display_test_pattern(Arduino_GFX *gfx);
 
+/**
+ * @brief Find and store the fastest SPI clock the panel accepts
+ * @details Steps the write clock upwards from MAIN_DISPLAY_SPI_BASE_HZ. At
+ *          each step MAIN_display_test_pattern is drawn and its bottom row
+ *          read back with RAMRD, bit-banged slowly over SPI_MISO so only
+ *          the write path is under test, and compared with a reference row
+ *          read after drawing at the base clock. The highest step that
+ *          passes MAIN_DISPLAY_SPI_VERIFY_PASSES times is applied and
+ *          stored in NVS. Boot only: nothing else may use the bus.
+ * @param gfx Pointer to Arduino_GFX object
+ * @param bus Display bus the clock is applied to
+ * @return uint32_t Chosen clock in Hz (MAIN_DISPLAY_SPI_BASE_HZ if readback
+ *         does not work on this panel)
+ */
+uint32_t MAIN_display_calibrate_spi(Arduino_GFX *gfx, Arduino_DataBus *bus);
+
+/**
+ * @brief Get the SPI clock stored by MAIN_display_calibrate_spi
+ * @return uint32_t Clock in Hz, 0 if never calibrated
+ */
+uint32_t MAIN_display_get_stored_spi_hz(void);
+
+/**
+ * @brief Rotate the panel, LVGL and touch together
+ * @details The ST7796 rotates in hardware (MADCTL set by setRotation, under
+ *          the display mutex), so no pixel is rotated in software. The LVGL
+ *          display is resized to the new width and height, which redraws
+ *          the whole screen, and EARS_touch switches to the matching entry
+ *          of its transform table. Call from the LVGL task (Core 0).
+ *          Quarter turns need PARTIAL render mode (the default); DIRECT and
+ *          FULL buffers keep the stride of the boot orientation.
+ * @param gfx Pointer to Arduino_GFX object
+ * @param displayMutex Mutex guarding the SPI bus (NULL = no locking)
+ * @param rotation 0-3, as Arduino_GFX setRotation
+ * @return true if the rotation was applied
+ */
+bool MAIN_display_set_orientation(Arduino_GFX *gfx, SemaphoreHandle_t displayMutex, uint8_t rotation);
+
+/**
+ * @brief Get the current panel rotation
+ * @return uint8_t 0-3, as Arduino_GFX setRotation
+ */
+uint8_t MAIN_display_get_orientation(void);
+
+/**
+ * @brief Give the power state manager the panel and its bus
+ * @param gfx Pointer to Arduino_GFX object (esp_lcd backend: its panel IO)
+ * @param bus Display bus (Arduino_GFX backend)
+ * @param displayMutex Mutex guarding the display bus
+ */
+void MAIN_initialise_display_power(Arduino_GFX *gfx, Arduino_DataBus *bus, SemaphoreHandle_t displayMutex);
+
+/**
+ * @brief Move the panel to a power state
+ * @details Sends FRMCTR1 and IDMON/IDMOFF only for what changed, under the
+ *          display mutex, and sets the backlight manager's static scale.
+ *          Called by the refresh governor from the LVGL task.
+ * @param state New state
+ */
+void MAIN_display_set_power_state(MAIN_display_power_t state);
+
+/**
+ * @brief Get the panel power state
+ * @return MAIN_display_power_t Last state applied
+ */
+MAIN_display_power_t MAIN_display_get_power_state(void);
+
 #endif // __MAIN_DISPLAY_LIB_H__
 
 /******************************************************************************
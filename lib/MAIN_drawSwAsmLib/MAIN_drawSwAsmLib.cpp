@@ -0,0 +1,347 @@
+/**
+ * @file MAIN_drawSwAsmLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Custom LVGL draw-SW blend kernels for RGB565 on the ESP32-S3
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_drawSwAsmLib.h"
+#include "lvgl_private.h"
+#include <string.h>
+#ifdef ESP_PLATFORM
+#include <sdkconfig.h>
+#endif
+
+/******************************************************************************
+ * Internal Definitions
+ *****************************************************************************/
+
+#if DRAW_SW_PIE_ENABLED == 1 && defined(CONFIG_IDF_TARGET_ESP32S3)
+#define DRAW_SW_USE_PIE 1
+#else
+#define DRAW_SW_USE_PIE 0
+#endif
+
+// RGB565 with green moved to the upper half: 0b00000111111000001111100000011111
+#define DRAW_SW_SPREAD_MASK 0x07E0F81Fu
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+static inline uint32_t draw_sw_spread(uint16_t c)
+{
+    return ((uint32_t)c | ((uint32_t)c << 16)) & DRAW_SW_SPREAD_MASK;
+}
+
+/**
+ * @brief Mix a spread foreground into a pixel, as lv_color_16_16_mix
+ * @param fg Foreground from draw_sw_spread()
+ * @param bg Destination pixel
+ * @param mix LVGL opacity reduced to 0..32 ((opa + 4) >> 3)
+ * @return uint16_t Mixed pixel
+ */
+static inline uint16_t draw_sw_mix(uint32_t fg, uint16_t bg, uint32_t mix)
+{
+    uint32_t b = draw_sw_spread(bg);
+    uint32_t r = ((((fg - b) * mix) >> 5) + b) & DRAW_SW_SPREAD_MASK;
+    return (uint16_t)((r >> 16) | r);
+}
+
+static inline void *draw_sw_next_row(const void *buf, int32_t stride)
+{
+    return (uint8_t *)buf + stride;
+}
+
+#if DRAW_SW_USE_PIE
+/**
+ * @brief Store blocks of 8 pixels with 128-bit PIE stores
+ * @param dest 16-byte aligned destination
+ * @param blocks Number of 8-pixel blocks (at least 1)
+ * @param colour Pixel broadcast to all eight lanes of q0
+ * @return uint16_t* First pixel after the last block
+ * @note q0 is coprocessor state, saved on task switches as for esp-dsp.
+ */
+static inline uint16_t *draw_sw_pie_fill(uint16_t *dest, uint32_t blocks, const uint16_t *colour)
+{
+    __asm__ volatile(
+        "ee.vldbc.16      q0, %[colour]           \n"
+        "1:                                       \n"
+        "ee.vst.128.ip    q0, %[dest], 16         \n"
+        "addi             %[blocks], %[blocks], -1\n"
+        "bnez             %[blocks], 1b           \n"
+        : [dest] "+r"(dest), [blocks] "+r"(blocks)
+        : [colour] "r"(colour)
+        : "memory");
+    return dest;
+}
+#endif
+
+/**
+ * @brief Fill one row
+ */
+static inline void draw_sw_fill_row(uint16_t *dest, int32_t w, uint16_t colour)
+{
+#if DRAW_SW_USE_PIE
+    if (w >= DRAW_SW_PIE_MIN_PIXELS)
+    {
+        // Scalar up to a 16-byte boundary (EE.VST.128 ignores the low bits)
+        while (((uintptr_t)dest & 0xF) != 0)
+        {
+            *dest++ = colour;
+            w--;
+        }
+        dest = draw_sw_pie_fill(dest, (uint32_t)w >> 3, &colour);
+        w &= 7;
+    }
+#endif
+
+    if (w > 0 && ((uintptr_t)dest & 0x3) != 0)
+    {
+        *dest++ = colour;
+        w--;
+    }
+
+    uint32_t c32 = (uint32_t)colour | ((uint32_t)colour << 16);
+    uint32_t *dest32 = (uint32_t *)dest;
+    int32_t pairs = w >> 1;
+    while (pairs >= 4)
+    {
+        dest32[0] = c32;
+        dest32[1] = c32;
+        dest32[2] = c32;
+        dest32[3] = c32;
+        dest32 += 4;
+        pairs -= 4;
+    }
+    while (pairs-- > 0)
+    {
+        *dest32++ = c32;
+    }
+    if (w & 1)
+    {
+        *(uint16_t *)dest32 = colour;
+    }
+}
+
+/******************************************************************************
+ * Fills
+ *****************************************************************************/
+
+/**
+ * @brief Solid RGB565 fill
+ */
+lv_result_t LV_ATTRIBUTE_FAST_MEM MAIN_draw_sw_fill_rgb565(lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    const uint16_t colour = lv_color_to_u16(dsc->color);
+    uint16_t *dest = (uint16_t *)dsc->dest_buf;
+
+    for (int32_t y = 0; y < dsc->dest_h; y++)
+    {
+        draw_sw_fill_row(dest, dsc->dest_w, colour);
+        dest = (uint16_t *)draw_sw_next_row(dest, dsc->dest_stride);
+    }
+    return LV_RESULT_OK;
+}
+
+/**
+ * @brief RGB565 fill with opacity
+ */
+lv_result_t LV_ATTRIBUTE_FAST_MEM MAIN_draw_sw_fill_rgb565_opa(lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    const int32_t w = dsc->dest_w;
+    const uint32_t fg = draw_sw_spread(lv_color_to_u16(dsc->color));
+    const uint32_t mix = ((uint32_t)dsc->opa + 4) >> 3;
+    uint16_t *dest = (uint16_t *)dsc->dest_buf;
+
+    if (w <= 0)
+    {
+        return LV_RESULT_OK;
+    }
+
+    for (int32_t y = 0; y < dsc->dest_h; y++)
+    {
+        // Runs of one colour (backgrounds) are mixed once
+        uint16_t last = dest[0];
+        uint16_t lastMixed = draw_sw_mix(fg, last, mix);
+        for (int32_t x = 0; x < w; x++)
+        {
+            if (dest[x] != last)
+            {
+                last = dest[x];
+                lastMixed = draw_sw_mix(fg, last, mix);
+            }
+            dest[x] = lastMixed;
+        }
+        dest = (uint16_t *)draw_sw_next_row(dest, dsc->dest_stride);
+    }
+    return LV_RESULT_OK;
+}
+
+/**
+ * @brief RGB565 fill through an alpha mask
+ */
+lv_result_t LV_ATTRIBUTE_FAST_MEM MAIN_draw_sw_fill_rgb565_mask(lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    const int32_t w = dsc->dest_w;
+    const uint16_t colour = lv_color_to_u16(dsc->color);
+    const uint32_t fg = draw_sw_spread(colour);
+    const lv_opa_t *mask = dsc->mask_buf;
+    uint16_t *dest = (uint16_t *)dsc->dest_buf;
+
+    for (int32_t y = 0; y < dsc->dest_h; y++)
+    {
+        int32_t x = 0;
+        while (x < w)
+        {
+            // Glyph and corner masks are mostly runs of 0x00 or 0xFF
+            if (x + 4 <= w && ((uintptr_t)&mask[x] & 0x3) == 0)
+            {
+                uint32_t m4 = *(const uint32_t *)&mask[x];
+                if (m4 == 0)
+                {
+                    x += 4;
+                    continue;
+                }
+                if (m4 == 0xFFFFFFFFu)
+                {
+                    dest[x] = colour;
+                    dest[x + 1] = colour;
+                    dest[x + 2] = colour;
+                    dest[x + 3] = colour;
+                    x += 4;
+                    continue;
+                }
+            }
+
+            lv_opa_t m = mask[x];
+            if (m == LV_OPA_COVER)
+            {
+                dest[x] = colour;
+            }
+            else if (m != LV_OPA_TRANSP)
+            {
+                dest[x] = draw_sw_mix(fg, dest[x], ((uint32_t)m + 4) >> 3);
+            }
+            x++;
+        }
+        dest = (uint16_t *)draw_sw_next_row(dest, dsc->dest_stride);
+        mask += dsc->mask_stride;
+    }
+    return LV_RESULT_OK;
+}
+
+/******************************************************************************
+ * Images
+ *****************************************************************************/
+
+/**
+ * @brief Copy an RGB565 image
+ */
+lv_result_t LV_ATTRIBUTE_FAST_MEM MAIN_draw_sw_copy_rgb565(lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    uint16_t *dest = (uint16_t *)dsc->dest_buf;
+    const uint16_t *src = (const uint16_t *)dsc->src_buf;
+
+    for (int32_t y = 0; y < dsc->dest_h; y++)
+    {
+        int32_t w = dsc->dest_w;
+        if ((((uintptr_t)dest ^ (uintptr_t)src) & 0x3) == 0)
+        {
+            // Same word alignment: the framework's word-wide memcpy
+            memcpy(dest, src, (size_t)w * 2);
+        }
+        else
+        {
+            // 2 bytes out of step: align the destination, pair the source
+            uint16_t *d = dest;
+            const uint16_t *s = src;
+            if (w > 0 && ((uintptr_t)d & 0x3) != 0)
+            {
+                *d++ = *s++;
+                w--;
+            }
+            uint32_t *d32 = (uint32_t *)d;
+            for (int32_t pairs = w >> 1; pairs > 0; pairs--)
+            {
+                *d32++ = (uint32_t)s[0] | ((uint32_t)s[1] << 16);
+                s += 2;
+            }
+            if (w & 1)
+            {
+                *(uint16_t *)d32 = *s;
+            }
+        }
+        dest = (uint16_t *)draw_sw_next_row(dest, dsc->dest_stride);
+        src = (const uint16_t *)draw_sw_next_row(src, dsc->src_stride);
+    }
+    return LV_RESULT_OK;
+}
+
+/**
+ * @brief Blend an RGB565 image with opacity
+ */
+lv_result_t LV_ATTRIBUTE_FAST_MEM MAIN_draw_sw_copy_rgb565_opa(lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    const int32_t w = dsc->dest_w;
+    const uint32_t mix = ((uint32_t)dsc->opa + 4) >> 3;
+    uint16_t *dest = (uint16_t *)dsc->dest_buf;
+    const uint16_t *src = (const uint16_t *)dsc->src_buf;
+
+    for (int32_t y = 0; y < dsc->dest_h; y++)
+    {
+        for (int32_t x = 0; x < w; x++)
+        {
+            dest[x] = draw_sw_mix(draw_sw_spread(src[x]), dest[x], mix);
+        }
+        dest = (uint16_t *)draw_sw_next_row(dest, dsc->dest_stride);
+        src = (const uint16_t *)draw_sw_next_row(src, dsc->src_stride);
+    }
+    return LV_RESULT_OK;
+}
+
+/**
+ * @brief Name of the fill path compiled in
+ */
+const char *MAIN_draw_sw_asm_backend(void)
+{
+    return DRAW_SW_USE_PIE ? "S3 PIE" : "32-bit";
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_DrawSwAsm_getLibraryName() {
+    return MAIN_DrawSwAsm::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_DrawSwAsm_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_DrawSwAsm::VERSION_MAJOR,
+                       MAIN_DrawSwAsm::VERSION_MINOR,
+                       MAIN_DrawSwAsm::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_DrawSwAsm_getVersionDate() {
+    return MAIN_DrawSwAsm::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_DrawSwAsm_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_DrawSwAsm_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_drawSwAsmLib.cpp
+ ******************************************************************************/
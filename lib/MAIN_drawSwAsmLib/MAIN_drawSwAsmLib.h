@@ -0,0 +1,134 @@
+/**
+ * @file MAIN_drawSwAsmLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Custom LVGL draw-SW blend kernels for RGB565 on the ESP32-S3
+ * @details LVGL's LV_DRAW_SW_ASM_CUSTOM hooks. With -D EARS_DRAW_SW_ASM=1
+ *          lv_conf.h names this header as LV_DRAW_SW_ASM_CUSTOM_INCLUDE, and
+ *          LVGL's RGB565 blend tries these kernels before its own C loops:
+ *
+ *          - solid fill: 128-bit PIE stores (EE.VST.128.IP) on the S3,
+ *            unrolled 32-bit stores elsewhere
+ *          - fill with opacity and fill through a mask (text, rounded
+ *            corners): the colour is spread once per call and mixed inline,
+ *            with four-pixel skips over fully clear or covered mask runs
+ *          - RGB565 image copy: word copies when source and destination are
+ *            2 bytes out of step, where lv_memcpy falls back to bytes
+ *          - RGB565 image with opacity: inline mix
+ *
+ *          Results match LVGL's own loops bit for bit (same mix formula).
+ *          Included from LVGL's C sources, so this header stays C.
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_DRAW_SW_ASM_LIB_H__
+#define __MAIN_DRAW_SW_ASM_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <lvgl.h>
+
+#ifdef __cplusplus
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_DrawSwAsm
+{
+    constexpr const char* LIB_NAME = "MAIN_DrawSwAsm";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-14";
+}
+
+
+// Version information getters
+const char* MAIN_DrawSwAsm_getLibraryName();
+uint32_t MAIN_DrawSwAsm_getVersionEncoded();
+const char* MAIN_DrawSwAsm_getVersionDate();
+void MAIN_DrawSwAsm_getVersionString(char* buffer);
+
+extern "C" {
+#endif
+
+/******************************************************************************
+ * Draw SW Kernel Configuration
+ *****************************************************************************/
+
+// 1 = 128-bit PIE stores for solid fills when built for the ESP32-S3
+#define DRAW_SW_PIE_ENABLED 1
+
+// Rows narrower than this are filled by the scalar loop (PIE setup cost)
+#define DRAW_SW_PIE_MIN_PIXELS 32
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Solid RGB565 fill
+ * @param dsc Fill descriptor (no mask, opacity LV_OPA_MAX or more)
+ * @return lv_result_t LV_RESULT_OK when filled
+ */
+lv_result_t MAIN_draw_sw_fill_rgb565(lv_draw_sw_blend_fill_dsc_t *dsc);
+
+/**
+ * @brief RGB565 fill with opacity
+ * @param dsc Fill descriptor (no mask)
+ * @return lv_result_t LV_RESULT_OK when filled
+ */
+lv_result_t MAIN_draw_sw_fill_rgb565_opa(lv_draw_sw_blend_fill_dsc_t *dsc);
+
+/**
+ * @brief RGB565 fill through an alpha mask
+ * @param dsc Fill descriptor (mask, full opacity)
+ * @return lv_result_t LV_RESULT_OK when filled
+ */
+lv_result_t MAIN_draw_sw_fill_rgb565_mask(lv_draw_sw_blend_fill_dsc_t *dsc);
+
+/**
+ * @brief Copy an RGB565 image
+ * @param dsc Image descriptor (no mask, full opacity, normal blend)
+ * @return lv_result_t LV_RESULT_OK when copied
+ */
+lv_result_t MAIN_draw_sw_copy_rgb565(lv_draw_sw_blend_image_dsc_t *dsc);
+
+/**
+ * @brief Blend an RGB565 image with opacity
+ * @param dsc Image descriptor (no mask, normal blend)
+ * @return lv_result_t LV_RESULT_OK when blended
+ */
+lv_result_t MAIN_draw_sw_copy_rgb565_opa(lv_draw_sw_blend_image_dsc_t *dsc);
+
+/**
+ * @brief Name of the fill path compiled in
+ * @return const char* "S3 PIE" or "32-bit"
+ */
+const char *MAIN_draw_sw_asm_backend(void);
+
+/******************************************************************************
+ * LVGL Hooks (LV_DRAW_SW_ASM_CUSTOM)
+ *****************************************************************************/
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc) MAIN_draw_sw_fill_rgb565(dsc)
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc) MAIN_draw_sw_fill_rgb565_opa(dsc)
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc) MAIN_draw_sw_fill_rgb565_mask(dsc)
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565(dsc) MAIN_draw_sw_copy_rgb565(dsc)
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc) MAIN_draw_sw_copy_rgb565_opa(dsc)
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // __MAIN_DRAW_SW_ASM_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_drawSwAsmLib.h
+ ******************************************************************************/
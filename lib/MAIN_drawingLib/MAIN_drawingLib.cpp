@@ -2,9 +2,12 @@
  * @file MAIN_drawingLib.cpp
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief Drawing functions for EARS - rectangles, shapes, etc.
- * @details Functions callable from main code and EEZ Studio Flow
- * @version 1.0.0
- * @date 20260210
+ * @details Functions callable from main code and EEZ Studio Flow. The direct
+ *          functions, the command list and the sprite cache draw through
+ *          Arduino_GFX; the draw layer keeps its shapes and lets LVGL render
+ *          them in its own refresh.
+ * @version 1.3.0
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -14,6 +17,7 @@
  *****************************************************************************/
 #include "MAIN_drawingLib.h"
 #include "EARS_systemDef.h"
+#include <esp_heap_caps.h>
 
 /******************************************************************************
  * Rectangle Drawing Functions
@@ -37,8 +41,6 @@ void MAIN_draw_filled_rect(Arduino_GFX *gfx, int16_t x, int16_t y, int16_t w, in
     }
 
     gfx->fillRect(x, y, w, h, colour);
-
-    DEBUG_PRINTF("[DRAW] Filled rect at (%d,%d) size %dx%d colour 0x%04X\n", x, y, w, h, colour);
 }
 
 /**
@@ -59,8 +61,6 @@ void MAIN_draw_rect_outline(Arduino_GFX *gfx, int16_t x, int16_t y, int16_t w, i
     }
 
     gfx->drawRect(x, y, w, h, colour);
-
-    DEBUG_PRINTF("[DRAW] Rect outline at (%d,%d) size %dx%d colour 0x%04X\n", x, y, w, h, colour);
 }
 
 /**
@@ -82,9 +82,6 @@ void MAIN_draw_rounded_rect(Arduino_GFX *gfx, int16_t x, int16_t y, int16_t w, i
     }
 
     gfx->fillRoundRect(x, y, w, h, r, colour);
-
-    DEBUG_PRINTF("[DRAW] Rounded rect at (%d,%d) size %dx%d radius %d colour 0x%04X\n",
-                 x, y, w, h, r, colour);
 }
 
 /**
@@ -106,9 +103,6 @@ void MAIN_draw_rounded_rect_outline(Arduino_GFX *gfx, int16_t x, int16_t y, int1
     }
 
     gfx->drawRoundRect(x, y, w, h, r, colour);
-
-    DEBUG_PRINTF("[DRAW] Rounded rect outline at (%d,%d) size %dx%d radius %d colour 0x%04X\n",
-                 x, y, w, h, r, colour);
 }
 
 /**
@@ -135,9 +129,6 @@ void MAIN_draw_button_rect(Arduino_GFX *gfx, int16_t x, int16_t y, int16_t w, in
 
     // Draw border
     gfx->drawRect(x, y, w, h, borderColour);
-
-    DEBUG_PRINTF("[DRAW] Button rect at (%d,%d) size %dx%d fill 0x%04X border 0x%04X\n",
-                 x, y, w, h, fillColour, borderColour);
 }
 
 /**
@@ -154,8 +145,1199 @@ void MAIN_clear_screen(Arduino_GFX *gfx, uint16_t colour)
     }
 
     gfx->fillScreen(colour);
+}
+
+/******************************************************************************
+ * Command List (Arduino_GFX)
+ *****************************************************************************/
+
+typedef enum
+{
+    LIST_FILL,
+    LIST_OUTLINE,
+    LIST_ROUNDED,
+    LIST_ROUNDED_OUTLINE,
+    LIST_BUTTON,
+    LIST_TEXT
+} list_type_t;
+
+typedef struct
+{
+    uint8_t type;                   // list_type_t
+    uint8_t textSize;
+    int16_t x, y, w, h, r;          // As given
+    int16_t x1, y1, x2, y2;         // Bounds clipped to the screen (inclusive)
+    uint16_t fill;                  // Fill or line colour
+    uint16_t border;
+    char text[DRAW_LIST_TEXT_SIZE];
+} list_command_t;
+
+static Arduino_GFX *list_gfx = NULL;
+static list_command_t list_commands[DRAW_LIST_MAX_COMMANDS];
+static uint8_t list_count = 0;
+static MAIN_draw_list_stats_t list_stats;
+
+// Band buffer: the raster half holds a band as drawn, the staging half
+// packs a window that does not span the whole band
+static uint16_t *list_buffer = NULL;
+
+// Pixels written in the current band, one bit each
+static uint8_t list_cover[DRAW_LIST_BAND_ROWS][DRAW_LIST_MAX_WIDTH / 8];
+
+// Band being rasterised, into band_pixels (list_buffer or a sprite);
+// list_cover is kept only for the list
+static uint16_t *band_pixels = NULL;
+static bool band_track = false;
+static int16_t band_x = 0;
+static int16_t band_y = 0;
+static int16_t band_w = 0;
+static int16_t band_rows = 0;
+
+static int16_t list_width(void)
+{
+    int16_t w = list_gfx->width();
+    return (w > DRAW_LIST_MAX_WIDTH) ? DRAW_LIST_MAX_WIDTH : w;
+}
+
+static void list_flush(void);
+
+// Queue a command, NULL if it is off screen or there is no list
+static list_command_t *list_add(uint8_t type, int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                                uint16_t fill, uint16_t border)
+{
+    if (list_gfx == NULL || w <= 0 || h <= 0)
+    {
+        return NULL;
+    }
+
+    int16_t x1 = (x < 0) ? 0 : x;
+    int16_t y1 = (y < 0) ? 0 : y;
+    int16_t x2 = (x + w - 1 >= list_width()) ? list_width() - 1 : x + w - 1;
+    int16_t y2 = (y + h - 1 >= list_gfx->height()) ? list_gfx->height() - 1 : y + h - 1;
+    if (x1 > x2 || y1 > y2)
+    {
+        return NULL;
+    }
+
+    // A full list is drawn now; the order on screen is unchanged
+    if (list_count >= DRAW_LIST_MAX_COMMANDS)
+    {
+        list_flush();
+    }
+
+    int16_t maxR = ((w < h) ? w : h) / 2;
+
+    list_command_t *c = &list_commands[list_count++];
+    c->type = type;
+    c->textSize = 1;
+    c->x = x;
+    c->y = y;
+    c->w = w;
+    c->h = h;
+    c->r = (r < 0) ? 0 : ((r > maxR) ? maxR : r);
+    c->x1 = x1;
+    c->y1 = y1;
+    c->x2 = x2;
+    c->y2 = y2;
+    c->fill = fill;
+    c->border = border;
+    c->text[0] = '\0';
+    return c;
+}
+
+// Part of a command that hides whatever is under it
+static bool list_opaque_area(const list_command_t *c, int16_t *y1, int16_t *y2)
+{
+    switch (c->type)
+    {
+    case LIST_FILL:
+    case LIST_BUTTON:
+        *y1 = c->y1;
+        *y2 = c->y2;
+        return true;
+    case LIST_ROUNDED:
+        // Full width between the corners
+        *y1 = (c->y + c->r > c->y1) ? c->y + c->r : c->y1;
+        *y2 = (c->y + c->h - 1 - c->r < c->y2) ? c->y + c->h - 1 - c->r : c->y2;
+        return *y1 <= *y2;
+    default:
+        return false;
+    }
+}
+
+static bool list_is_hidden(uint8_t index)
+{
+    const list_command_t *c = &list_commands[index];
+
+    for (uint8_t j = index + 1; j < list_count; j++)
+    {
+        const list_command_t *over = &list_commands[j];
+        int16_t y1, y2;
+        if (list_opaque_area(over, &y1, &y2) &&
+            over->x1 <= c->x1 && over->x2 >= c->x2 && y1 <= c->y1 && y2 >= c->y2)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool list_is_isolated(uint8_t index, const bool *hidden)
+{
+    const list_command_t *c = &list_commands[index];
+
+    if (c->type != LIST_FILL && c->type != LIST_OUTLINE)
+    {
+        return false;
+    }
+
+    for (uint8_t j = 0; j < list_count; j++)
+    {
+        const list_command_t *other = &list_commands[j];
+        if (j == index || hidden[j] || other->type == LIST_TEXT)
+        {
+            continue;
+        }
+        if (other->x1 <= c->x2 && other->x2 >= c->x1 && other->y1 <= c->y2 && other->y2 >= c->y1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// One row of pixels into the band, clipped to it
+static void list_span(int16_t y, int16_t xa, int16_t xb, uint16_t colour)
+{
+    int16_t row = y - band_y;
+    if (row < 0 || row >= band_rows)
+    {
+        return;
+    }
+
+    if (xa < band_x)
+    {
+        xa = band_x;
+    }
+    if (xb > band_x + band_w - 1)
+    {
+        xb = band_x + band_w - 1;
+    }
+
+    uint16_t *px = &band_pixels[row * band_w];
+    for (int16_t x = xa - band_x; x <= xb - band_x; x++)
+    {
+        px[x] = colour;
+    }
+
+    if (band_track)
+    {
+        uint8_t *cover = list_cover[row];
+        for (int16_t x = xa - band_x; x <= xb - band_x; x++)
+        {
+            cover[x >> 3] |= (uint8_t)(1u << (x & 7));
+        }
+    }
+}
+
+// Columns a rounded corner leaves out of a row dy rows from the top or bottom
+static int16_t list_corner_inset(int16_t r, int16_t dy)
+{
+    if (dy >= r)
+    {
+        return 0;
+    }
+    int32_t t = r - dy;
+    return r - (int16_t)(sqrtf((float)(r * r - t * t)) + 0.5f);
+}
+
+static void list_rasterise(const list_command_t *c)
+{
+    int16_t first = (c->y1 > band_y) ? c->y1 : band_y;
+    int16_t last = (c->y2 < band_y + band_rows - 1) ? c->y2 : band_y + band_rows - 1;
+    int16_t right = c->x + c->w - 1;
+    int16_t bottom = c->y + c->h - 1;
+
+    for (int16_t y = first; y <= last; y++)
+    {
+        int16_t dy = (y - c->y < bottom - y) ? y - c->y : bottom - y;
+
+        switch (c->type)
+        {
+        case LIST_FILL:
+            list_span(y, c->x, right, c->fill);
+            break;
+
+        case LIST_OUTLINE:
+        case LIST_BUTTON:
+        {
+            uint16_t line = (c->type == LIST_BUTTON) ? c->border : c->fill;
+            if (dy == 0)
+            {
+                list_span(y, c->x, right, line);
+                break;
+            }
+            if (c->type == LIST_BUTTON)
+            {
+                list_span(y, c->x + 1, right - 1, c->fill);
+            }
+            list_span(y, c->x, c->x, line);
+            list_span(y, right, right, line);
+            break;
+        }
+
+        case LIST_ROUNDED:
+        {
+            int16_t inset = list_corner_inset(c->r, dy);
+            list_span(y, c->x + inset, right - inset, c->fill);
+            break;
+        }
+
+        case LIST_ROUNDED_OUTLINE:
+        {
+            int16_t inset = list_corner_inset(c->r, dy);
+            if (dy == 0)
+            {
+                list_span(y, c->x + inset, right - inset, c->fill);
+                break;
+            }
+            // Reach out to the row nearer the edge so the curve is unbroken
+            int16_t outer = list_corner_inset(c->r, dy - 1) - 1;
+            int16_t reach = (outer > inset) ? outer : inset;
+            list_span(y, c->x + inset, c->x + reach, c->fill);
+            list_span(y, right - reach, right - inset, c->fill);
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+}
+
+static void list_window(int16_t x, int16_t y, uint16_t *pixels, int16_t w, int16_t h)
+{
+    list_gfx->draw16bitRGBBitmap(x, y, pixels, w, h);
+    list_stats.windows++;
+    list_stats.pixels += (uint32_t)w * h;
+}
+
+static inline bool list_covered(const uint8_t *bits, int16_t x)
+{
+    return (bits[x >> 3] >> (x & 7)) & 1;
+}
+
+// Written on this row but not on every row of the band
+static inline bool list_partial(const uint8_t *full, int16_t row, int16_t x)
+{
+    return list_covered(list_cover[row], x) && !list_covered(full, x);
+}
+
+// Row holds exactly the run [start, end)
+static bool list_same_run(const uint8_t *full, int16_t row, int16_t start, int16_t end)
+{
+    if ((start > 0 && list_partial(full, row, start - 1)) || (end < band_w && list_partial(full, row, end)))
+    {
+        return false;
+    }
+    for (int16_t x = start; x < end; x++)
+    {
+        if (!list_partial(full, row, x))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Send the band: columns written on every row as whole-band windows, the
+// rest as runs
+static void list_send_band(void)
+{
+    uint8_t full[DRAW_LIST_MAX_WIDTH / 8];
+    const int16_t bytes = (band_w + 7) / 8;
+
+    memcpy(full, list_cover[0], bytes);
+    for (int16_t row = 1; row < band_rows; row++)
+    {
+        for (int16_t i = 0; i < bytes; i++)
+        {
+            full[i] &= list_cover[row][i];
+        }
+    }
+
+    uint16_t *staging = list_buffer + DRAW_LIST_BAND_ROWS * DRAW_LIST_MAX_WIDTH;
+    int16_t x = 0;
+    while (x < band_w)
+    {
+        if (!list_covered(full, x))
+        {
+            x++;
+            continue;
+        }
+
+        int16_t start = x;
+        while (x < band_w && list_covered(full, x))
+        {
+            x++;
+        }
+        int16_t runW = x - start;
+
+        if (runW == band_w)
+        {
+            list_window(band_x, band_y, list_buffer, band_w, band_rows);
+            return;
+        }
+
+        for (int16_t row = 0; row < band_rows; row++)
+        {
+            memcpy(&staging[row * runW], &list_buffer[row * band_w + start], runW * sizeof(uint16_t));
+        }
+        list_window(band_x + start, band_y, staging, runW, band_rows);
+    }
+
+    // Runs written on some rows only; a run repeated on the rows below it
+    // goes out as one window
+    for (int16_t row = 0; row < band_rows; row++)
+    {
+        x = 0;
+        while (x < band_w)
+        {
+            if (!list_partial(full, row, x))
+            {
+                x++;
+                continue;
+            }
+
+            int16_t start = x;
+            while (x < band_w && list_partial(full, row, x))
+            {
+                x++;
+            }
+
+            int16_t last = row;
+            while (last + 1 < band_rows && list_same_run(full, last + 1, start, x))
+            {
+                last++;
+            }
+
+            int16_t runW = x - start;
+            int16_t runRows = last - row + 1;
+            if (runRows == 1)
+            {
+                list_window(band_x + start, band_y + row, &list_buffer[row * band_w + start], runW, 1);
+                continue;
+            }
+
+            for (int16_t r = 0; r < runRows; r++)
+            {
+                memcpy(&staging[r * runW], &list_buffer[(row + r) * band_w + start], runW * sizeof(uint16_t));
+                if (r > 0)
+                {
+                    // Sent; not to be found again on its own row
+                    for (int16_t i = start; i < x; i++)
+                    {
+                        list_cover[row + r][i >> 3] &= (uint8_t)~(1u << (i & 7));
+                    }
+                }
+            }
+            list_window(band_x + start, band_y + row, staging, runW, runRows);
+        }
+    }
+}
+
+// Without a band buffer every command goes straight to the panel
+static void list_draw_direct(const list_command_t *c)
+{
+    switch (c->type)
+    {
+    case LIST_FILL:
+        MAIN_draw_filled_rect(list_gfx, c->x, c->y, c->w, c->h, c->fill);
+        break;
+    case LIST_OUTLINE:
+        MAIN_draw_rect_outline(list_gfx, c->x, c->y, c->w, c->h, c->fill);
+        break;
+    case LIST_ROUNDED:
+        MAIN_draw_rounded_rect(list_gfx, c->x, c->y, c->w, c->h, c->r, c->fill);
+        break;
+    case LIST_ROUNDED_OUTLINE:
+        MAIN_draw_rounded_rect_outline(list_gfx, c->x, c->y, c->w, c->h, c->r, c->fill);
+        break;
+    case LIST_BUTTON:
+        MAIN_draw_button_rect(list_gfx, c->x, c->y, c->w, c->h, c->fill, c->border);
+        break;
+    default:
+        break;
+    }
+}
+
+// Draw the queued commands; the counters carry on until the submit
+static void list_flush(void)
+{
+    if (list_gfx == NULL)
+    {
+        return;
+    }
+
+    // Drop what a later opaque rectangle hides
+    bool hidden[DRAW_LIST_MAX_COMMANDS];
+    for (uint8_t i = 0; i < list_count; i++)
+    {
+        hidden[i] = list_is_hidden(i);
+        if (hidden[i])
+        {
+            list_stats.culled++;
+        }
+    }
+    list_stats.commands += list_count;
+
+    // A plain rectangle or outline touching nothing else is cheaper as its
+    // own windows than spread over bands; order the rest by their top
+    uint8_t order[DRAW_LIST_MAX_COMMANDS];
+    uint8_t live = 0;
+    for (uint8_t i = 0; i < list_count; i++)
+    {
+        if (hidden[i] || list_commands[i].type == LIST_TEXT)
+        {
+            continue;
+        }
+        if (list_buffer != NULL && list_is_isolated(i, hidden))
+        {
+            const list_command_t *c = &list_commands[i];
+            uint32_t w = c->x2 - c->x1 + 1;
+            uint32_t h = c->y2 - c->y1 + 1;
+            list_draw_direct(c);
+            list_stats.windows += (c->type == LIST_FILL) ? 1 : 4;
+            list_stats.pixels += (c->type == LIST_FILL) ? w * h : 2 * (w + h);
+            continue;
+        }
+
+        uint8_t at = live++;
+        while (at > 0 && list_commands[order[at - 1]].y1 > list_commands[i].y1)
+        {
+            order[at] = order[at - 1];
+            at--;
+        }
+        order[at] = i;
+    }
+
+    if (list_buffer == NULL)
+    {
+        for (uint8_t i = 0; i < list_count; i++)
+        {
+            if (!hidden[i])
+            {
+                list_draw_direct(&list_commands[i]);
+            }
+        }
+    }
+    else
+    {
+        // Sweep down the screen a band at a time; the commands crossing a
+        // band are drawn in list order so later ones stay on top
+        band_pixels = list_buffer;
+        band_track = true;
+        uint64_t active = 0;
+        uint8_t next = 0;
+        int16_t y = (live > 0) ? list_commands[order[0]].y1 : list_gfx->height();
+
+        while (y < list_gfx->height() && (next < live || active != 0))
+        {
+            if (active == 0 && list_commands[order[next]].y1 > y)
+            {
+                y = list_commands[order[next]].y1;
+            }
+
+            band_y = y;
+            band_rows = (list_gfx->height() - y < DRAW_LIST_BAND_ROWS) ? list_gfx->height() - y : DRAW_LIST_BAND_ROWS;
+
+            while (next < live && list_commands[order[next]].y1 < band_y + band_rows)
+            {
+                active |= 1ULL << order[next++];
+            }
+
+            int16_t x1 = DRAW_LIST_MAX_WIDTH;
+            int16_t x2 = -1;
+            for (uint8_t i = 0; i < list_count; i++)
+            {
+                if (!(active & (1ULL << i)))
+                {
+                    continue;
+                }
+                if (list_commands[i].y2 < band_y)
+                {
+                    active &= ~(1ULL << i);
+                    continue;
+                }
+                x1 = (list_commands[i].x1 < x1) ? list_commands[i].x1 : x1;
+                x2 = (list_commands[i].x2 > x2) ? list_commands[i].x2 : x2;
+            }
+
+            if (x1 <= x2)
+            {
+                band_x = x1;
+                band_w = x2 - x1 + 1;
+                for (int16_t row = 0; row < band_rows; row++)
+                {
+                    memset(list_cover[row], 0, (band_w + 7) / 8);
+                }
+
+                for (uint8_t i = 0; i < list_count; i++)
+                {
+                    if (active & (1ULL << i))
+                    {
+                        list_rasterise(&list_commands[i]);
+                    }
+                }
+                list_send_band();
+            }
+
+            y += band_rows;
+        }
+    }
+
+    for (uint8_t i = 0; i < list_count; i++)
+    {
+        const list_command_t *c = &list_commands[i];
+        if (hidden[i] || c->type != LIST_TEXT)
+        {
+            continue;
+        }
+        list_gfx->setTextColor(c->fill);
+        list_gfx->setTextSize(c->textSize);
+        list_gfx->setCursor(c->x, c->y);
+        list_gfx->print(c->text);
+    }
+
+    list_count = 0;
+}
+
+
+/**
+ * @brief Start a command list, discarding anything not submitted
+ * @param gfx Pointer to Arduino_GFX object the list is drawn to
+ * @return true if ready
+ */
+bool MAIN_draw_list_begin(Arduino_GFX *gfx)
+{
+    if (gfx == nullptr)
+    {
+        DEBUG_PRINTLN("[ERROR] GFX object is null");
+        return false;
+    }
+
+    if (list_buffer == NULL)
+    {
+        list_buffer = (uint16_t *)heap_caps_malloc(2 * DRAW_LIST_BAND_ROWS * DRAW_LIST_MAX_WIDTH * sizeof(uint16_t),
+                                                   MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+        if (list_buffer == NULL)
+        {
+            DEBUG_PRINTLN("[WARN] Draw list: no band buffer, drawing directly");
+        }
+    }
+
+    list_gfx = gfx;
+    list_count = 0;
+    memset(&list_stats, 0, sizeof(list_stats));
+    return true;
+}
+
+/**
+ * @brief Queue a fill of the whole screen
+ */
+void MAIN_draw_list_clear(uint16_t colour)
+{
+    if (list_gfx == NULL)
+    {
+        return;
+    }
+
+    // Nothing queued before a clear can show
+    list_stats.culled += list_count;
+    list_stats.commands += list_count;
+    list_count = 0;
+
+    list_add(LIST_FILL, 0, 0, list_gfx->width(), list_gfx->height(), 0, colour, colour);
+}
+
+/**
+ * @brief Queue a filled rectangle
+ */
+void MAIN_draw_list_filled_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t colour)
+{
+    list_add(LIST_FILL, x, y, w, h, 0, colour, colour);
+}
+
+/**
+ * @brief Queue a rectangle outline
+ */
+void MAIN_draw_list_rect_outline(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t colour)
+{
+    list_add(LIST_OUTLINE, x, y, w, h, 0, colour, colour);
+}
+
+/**
+ * @brief Queue a rounded rectangle
+ */
+void MAIN_draw_list_rounded_rect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t colour)
+{
+    list_add(LIST_ROUNDED, x, y, w, h, r, colour, colour);
+}
+
+/**
+ * @brief Queue a rounded rectangle outline
+ */
+void MAIN_draw_list_rounded_rect_outline(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t colour)
+{
+    list_add(LIST_ROUNDED_OUTLINE, x, y, w, h, r, colour, colour);
+}
+
+/**
+ * @brief Queue a button-style rectangle
+ */
+void MAIN_draw_list_button_rect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                uint16_t fillColour, uint16_t borderColour)
+{
+    list_add(LIST_BUTTON, x, y, w, h, 0, fillColour, borderColour);
+}
+
+/**
+ * @brief Queue a line of text in the built-in font
+ */
+void MAIN_draw_list_text(int16_t x, int16_t y, const char *text, uint16_t colour, uint8_t size)
+{
+    if (text == NULL || text[0] == '\0')
+    {
+        return;
+    }
+    if (size == 0)
+    {
+        size = 1;
+    }
+
+    // The built-in font is 6 x 8 per character at size 1
+    size_t len = strnlen(text, DRAW_LIST_TEXT_SIZE - 1);
+    list_command_t *c = list_add(LIST_TEXT, x, y, (int16_t)(len * 6 * size), (int16_t)(8 * size), 0, colour, colour);
+    if (c != NULL)
+    {
+        c->textSize = size;
+        memcpy(c->text, text, len);
+        c->text[len] = '\0';
+    }
+}
+
+/**
+ * @brief Draw the queued commands and empty the list
+ * @param stats Receives the counters of this list (NULL = not needed)
+ * @return uint16_t Address windows written
+ */
+uint16_t MAIN_draw_list_submit(MAIN_draw_list_stats_t *stats)
+{
+    list_flush();
+
+    if (stats != NULL)
+    {
+        *stats = list_stats;
+    }
+    uint16_t windows = list_stats.windows;
+
+    memset(&list_stats, 0, sizeof(list_stats));
+    return windows;
+}
+
+/******************************************************************************
+ * Sprite Cache (Arduino_GFX)
+ *****************************************************************************/
+
+typedef struct
+{
+    uint16_t *pixels;               // NULL = free slot
+    int16_t w, h, r;
+    uint16_t fill;
+    uint16_t border;
+    uint16_t background;
+    uint32_t lastUse;               // sprite_clock when last drawn
+} sprite_slot_t;
+
+static sprite_slot_t sprite_slots[DRAW_SPRITE_SLOTS];
+static uint32_t sprite_clock = 0;
+static MAIN_draw_sprite_stats_t sprite_stats;
+
+static void sprite_free(sprite_slot_t *slot)
+{
+    sprite_stats.bytes -= (uint32_t)slot->w * slot->h * sizeof(uint16_t);
+    sprite_stats.sprites--;
+    heap_caps_free(slot->pixels);
+    slot->pixels = NULL;
+}
+
+// Least recently drawn sprite, NULL if none is held
+static sprite_slot_t *sprite_oldest(void)
+{
+    sprite_slot_t *oldest = NULL;
+    for (uint8_t i = 0; i < DRAW_SPRITE_SLOTS; i++)
+    {
+        sprite_slot_t *slot = &sprite_slots[i];
+        if (slot->pixels != NULL && (oldest == NULL || (int32_t)(slot->lastUse - oldest->lastUse) < 0))
+        {
+            oldest = slot;
+        }
+    }
+    return oldest;
+}
+
+// A rounded rectangle in sprite coordinates, through the list rasteriser
+static void sprite_shape(uint8_t type, int16_t w, int16_t h, int16_t r, uint16_t colour)
+{
+    list_command_t c;
+    c.type = type;
+    c.x = c.x1 = 0;
+    c.y = c.y1 = 0;
+    c.w = w;
+    c.h = h;
+    c.x2 = w - 1;
+    c.y2 = h - 1;
+    c.r = r;
+    c.fill = colour;
+    list_rasterise(&c);
+}
+
+static void sprite_render(sprite_slot_t *slot)
+{
+    band_pixels = slot->pixels;
+    band_track = false;
+    band_x = 0;
+    band_y = 0;
+    band_w = slot->w;
+    band_rows = slot->h;
+
+    for (int32_t i = 0; i < (int32_t)slot->w * slot->h; i++)
+    {
+        slot->pixels[i] = slot->background;
+    }
+
+    sprite_shape(LIST_ROUNDED, slot->w, slot->h, slot->r, slot->fill);
+    sprite_shape(LIST_ROUNDED_OUTLINE, slot->w, slot->h, slot->r, slot->border);
+}
+
+// Cached sprite for a button, rendered if new; NULL if it cannot be held
+static sprite_slot_t *sprite_get(int16_t w, int16_t h, int16_t r, uint16_t fill, uint16_t border, uint16_t background)
+{
+    sprite_slot_t *room = NULL;
+    for (uint8_t i = 0; i < DRAW_SPRITE_SLOTS; i++)
+    {
+        sprite_slot_t *slot = &sprite_slots[i];
+        if (slot->pixels == NULL)
+        {
+            room = (room == NULL) ? slot : room;
+            continue;
+        }
+        if (slot->w == w && slot->h == h && slot->r == r && slot->fill == fill && slot->border == border &&
+            slot->background == background)
+        {
+            sprite_stats.hits++;
+            return slot;
+        }
+    }
+
+    sprite_stats.misses++;
+
+    uint32_t bytes = (uint32_t)w * h * sizeof(uint16_t);
+    if ((uint32_t)w * h > DRAW_SPRITE_MAX_PIXELS)
+    {
+        return NULL;
+    }
+
+    // Make room: a slot and the bytes
+    while (room == NULL || sprite_stats.bytes + bytes > DRAW_SPRITE_CACHE_BYTES)
+    {
+        sprite_slot_t *oldest = sprite_oldest();
+        if (oldest == NULL)
+        {
+            break;
+        }
+        sprite_free(oldest);
+        sprite_stats.evictions++;
+        room = (room == NULL) ? oldest : room;
+    }
+    if (room == NULL)
+    {
+        return NULL;
+    }
+
+    room->pixels = (uint16_t *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (room->pixels == NULL)
+    {
+        room->pixels = (uint16_t *)heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+    if (room->pixels == NULL)
+    {
+        return NULL;
+    }
+
+    room->w = w;
+    room->h = h;
+    room->r = r;
+    room->fill = fill;
+    room->border = border;
+    room->background = background;
+    sprite_stats.bytes += bytes;
+    sprite_stats.sprites++;
+
+    sprite_render(room);
+    return room;
+}
+
+/**
+ * @brief Draw a rounded button from a cached RGB565 sprite
+ * @param gfx Pointer to Arduino_GFX object
+ * @param x X coordinate (top-left corner)
+ * @param y Y coordinate (top-left corner)
+ * @param w Width in pixels
+ * @param h Height in pixels
+ * @param r Corner radius in pixels
+ * @param fillColour RGB565 fill colour
+ * @param borderColour RGB565 border colour (1 pixel)
+ * @param backgroundColour RGB565 colour behind the corners
+ */
+void MAIN_draw_button_cached(Arduino_GFX *gfx, int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                             uint16_t fillColour, uint16_t borderColour, uint16_t backgroundColour)
+{
+    if (gfx == nullptr)
+    {
+        DEBUG_PRINTLN("[ERROR] GFX object is null");
+        return;
+    }
+    if (w <= 0 || h <= 0)
+    {
+        return;
+    }
+
+    int16_t maxR = ((w < h) ? w : h) / 2;
+    r = (r < 0) ? 0 : ((r > maxR) ? maxR : r);
+
+    sprite_slot_t *slot = sprite_get(w, h, r, fillColour, borderColour, backgroundColour);
+    if (slot == NULL)
+    {
+        gfx->fillRoundRect(x, y, w, h, r, fillColour);
+        gfx->drawRoundRect(x, y, w, h, r, borderColour);
+        return;
+    }
+
+    slot->lastUse = ++sprite_clock;
+    gfx->draw16bitRGBBitmap(x, y, slot->pixels, w, h);
+}
+
+/**
+ * @brief Free every cached sprite
+ */
+void MAIN_draw_sprite_cache_clear(void)
+{
+    for (uint8_t i = 0; i < DRAW_SPRITE_SLOTS; i++)
+    {
+        if (sprite_slots[i].pixels != NULL)
+        {
+            sprite_free(&sprite_slots[i]);
+        }
+    }
+}
+
+/**
+ * @brief Sprite cache counters
+ * @param stats Receives a copy
+ */
+void MAIN_draw_sprite_cache_get_stats(MAIN_draw_sprite_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = sprite_stats;
+    }
+}
+
+/******************************************************************************
+ * Draw Layer (LVGL)
+ *****************************************************************************/
+
+typedef struct
+{
+    lv_area_t area;                 // Relative to the layer
+    lv_color_t fill;
+    lv_color_t border;
+    int16_t radius;
+    bool used;
+    bool filled;
+    bool bordered;
+} draw_shape_t;
+
+// RGB565 as LVGL colour
+static lv_color_t draw_colour(uint16_t colour)
+{
+    return lv_color_make((uint8_t)((colour >> 8) & 0xF8),
+                         (uint8_t)((colour >> 3) & 0xFC),
+                         (uint8_t)((colour << 3) & 0xF8));
+}
+
+// Shape table of a layer, NULL if it is not a draw layer
+static draw_shape_t *draw_layer_shapes(lv_obj_t *layer)
+{
+    if (layer == NULL)
+    {
+        return NULL;
+    }
+    return (draw_shape_t *)lv_obj_get_user_data(layer);
+}
+
+static draw_shape_t *draw_layer_shape(lv_obj_t *layer, MAIN_draw_shape_t shape)
+{
+    draw_shape_t *shapes = draw_layer_shapes(layer);
+
+    if (shapes == NULL || shape < 0 || shape >= DRAW_LAYER_MAX_SHAPES || !shapes[shape].used)
+    {
+        return NULL;
+    }
+    return &shapes[shape];
+}
+
+// Mark just the shape's pixels for the next refresh
+static void draw_layer_invalidate(lv_obj_t *layer, const draw_shape_t *s)
+{
+    lv_area_t coords;
+    lv_area_t area = s->area;
+
+    lv_obj_get_coords(layer, &coords);
+    lv_area_move(&area, coords.x1, coords.y1);
+    lv_obj_invalidate_area(layer, &area);
+}
+
+static void draw_layer_draw_cb(lv_event_t *e)
+{
+    lv_obj_t *layer = (lv_obj_t *)lv_event_get_target(e);
+    draw_shape_t *shapes = draw_layer_shapes(layer);
+    lv_layer_t *drawLayer = lv_event_get_layer(e);
+    lv_area_t coords;
+
+    if (shapes == NULL)
+    {
+        return;
+    }
+
+    lv_obj_get_coords(layer, &coords);
+
+    for (uint8_t i = 0; i < DRAW_LAYER_MAX_SHAPES; i++)
+    {
+        const draw_shape_t *s = &shapes[i];
+        if (!s->used)
+        {
+            continue;
+        }
+
+        lv_draw_rect_dsc_t dsc;
+        lv_draw_rect_dsc_init(&dsc);
+        dsc.radius = s->radius;
+        dsc.bg_opa = s->filled ? LV_OPA_COVER : LV_OPA_TRANSP;
+        dsc.bg_color = s->fill;
+        dsc.border_width = s->bordered ? 1 : 0;
+        dsc.border_opa = LV_OPA_COVER;
+        dsc.border_color = s->border;
+
+        lv_area_t area = s->area;
+        lv_area_move(&area, coords.x1, coords.y1);
+        lv_draw_rect(drawLayer, &dsc, &area);
+    }
+}
+
+static void draw_layer_delete_cb(lv_event_t *e)
+{
+    lv_obj_t *layer = (lv_obj_t *)lv_event_get_target(e);
+    draw_shape_t *shapes = draw_layer_shapes(layer);
+
+    if (shapes != NULL)
+    {
+        lv_obj_set_user_data(layer, NULL);
+        lv_free(shapes);
+    }
+}
+
+static MAIN_draw_shape_t draw_layer_add(lv_obj_t *layer, int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                                        bool filled, uint16_t fillColour, bool bordered, uint16_t borderColour)
+{
+    draw_shape_t *shapes = draw_layer_shapes(layer);
+
+    if (shapes == NULL || w <= 0 || h <= 0)
+    {
+        return DRAW_SHAPE_INVALID;
+    }
+
+    for (uint8_t i = 0; i < DRAW_LAYER_MAX_SHAPES; i++)
+    {
+        draw_shape_t *s = &shapes[i];
+        if (s->used)
+        {
+            continue;
+        }
+
+        lv_area_set(&s->area, x, y, x + w - 1, y + h - 1);
+        s->fill = draw_colour(fillColour);
+        s->border = draw_colour(borderColour);
+        s->radius = r;
+        s->filled = filled;
+        s->bordered = bordered;
+        s->used = true;
+
+        draw_layer_invalidate(layer, s);
+        return (MAIN_draw_shape_t)i;
+    }
+
+    return DRAW_SHAPE_INVALID;
+}
+
+/**
+ * @brief Create a draw layer covering its parent
+ * @param parent Screen or container to draw on
+ * @return lv_obj_t* Layer (transparent, not clickable), NULL if out of memory
+ */
+lv_obj_t *MAIN_draw_layer_create(lv_obj_t *parent)
+{
+    draw_shape_t *shapes = (draw_shape_t *)lv_malloc_zeroed(sizeof(draw_shape_t) * DRAW_LAYER_MAX_SHAPES);
+    if (shapes == NULL)
+    {
+        DEBUG_PRINTLN("[ERROR] Draw layer shape table allocation failed");
+        return NULL;
+    }
+
+    lv_obj_t *layer = lv_obj_create(parent);
+    lv_obj_remove_style_all(layer);
+    lv_obj_set_size(layer, lv_pct(100), lv_pct(100));
+    lv_obj_remove_flag(layer, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_remove_flag(layer, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_user_data(layer, shapes);
+
+    lv_obj_add_event_cb(layer, draw_layer_draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+    lv_obj_add_event_cb(layer, draw_layer_delete_cb, LV_EVENT_DELETE, NULL);
+
+    return layer;
+}
+
+/**
+ * @brief Add a filled rectangle
+ */
+MAIN_draw_shape_t MAIN_draw_layer_filled_rect(lv_obj_t *layer, int16_t x, int16_t y, int16_t w, int16_t h,
+                                              uint16_t colour)
+{
+    return draw_layer_add(layer, x, y, w, h, 0, true, colour, false, colour);
+}
+
+/**
+ * @brief Add a rectangle outline (1 pixel)
+ */
+MAIN_draw_shape_t MAIN_draw_layer_rect_outline(lv_obj_t *layer, int16_t x, int16_t y, int16_t w, int16_t h,
+                                               uint16_t colour)
+{
+    return draw_layer_add(layer, x, y, w, h, 0, false, colour, true, colour);
+}
+
+/**
+ * @brief Add a rounded rectangle (filled)
+ */
+MAIN_draw_shape_t MAIN_draw_layer_rounded_rect(lv_obj_t *layer, int16_t x, int16_t y, int16_t w, int16_t h,
+                                               int16_t r, uint16_t colour)
+{
+    return draw_layer_add(layer, x, y, w, h, r, true, colour, false, colour);
+}
+
+/**
+ * @brief Add a rounded rectangle outline (1 pixel)
+ */
+MAIN_draw_shape_t MAIN_draw_layer_rounded_rect_outline(lv_obj_t *layer, int16_t x, int16_t y, int16_t w,
+                                                       int16_t h, int16_t r, uint16_t colour)
+{
+    return draw_layer_add(layer, x, y, w, h, r, false, colour, true, colour);
+}
+
+/**
+ * @brief Add a button-style rectangle (filled with border)
+ */
+MAIN_draw_shape_t MAIN_draw_layer_button_rect(lv_obj_t *layer, int16_t x, int16_t y, int16_t w, int16_t h,
+                                              uint16_t fillColour, uint16_t borderColour)
+{
+    return draw_layer_add(layer, x, y, w, h, 0, true, fillColour, true, borderColour);
+}
+
+/**
+ * @brief Move a shape
+ * @return true if the shape exists
+ */
+bool MAIN_draw_layer_move(lv_obj_t *layer, MAIN_draw_shape_t shape, int16_t x, int16_t y)
+{
+    draw_shape_t *s = draw_layer_shape(layer, shape);
+    if (s == NULL)
+    {
+        return false;
+    }
+
+    // Old and new position both need redrawing
+    draw_layer_invalidate(layer, s);
+    lv_area_set(&s->area, x, y, x + lv_area_get_width(&s->area) - 1, y + lv_area_get_height(&s->area) - 1);
+    draw_layer_invalidate(layer, s);
+    return true;
+}
+
+/**
+ * @brief Recolour a shape
+ * @return true if the shape exists
+ */
+bool MAIN_draw_layer_set_colour(lv_obj_t *layer, MAIN_draw_shape_t shape, uint16_t colour)
+{
+    draw_shape_t *s = draw_layer_shape(layer, shape);
+    if (s == NULL)
+    {
+        return false;
+    }
+
+    if (s->filled)
+    {
+        s->fill = draw_colour(colour);
+    }
+    else
+    {
+        s->border = draw_colour(colour);
+    }
+    draw_layer_invalidate(layer, s);
+    return true;
+}
+
+/**
+ * @brief Remove a shape
+ * @return true if the shape existed
+ */
+bool MAIN_draw_layer_remove(lv_obj_t *layer, MAIN_draw_shape_t shape)
+{
+    draw_shape_t *s = draw_layer_shape(layer, shape);
+    if (s == NULL)
+    {
+        return false;
+    }
+
+    s->used = false;
+    draw_layer_invalidate(layer, s);
+    return true;
+}
+
+/**
+ * @brief Remove every shape and fill the layer with a colour
+ */
+void MAIN_draw_layer_clear(lv_obj_t *layer, uint16_t colour)
+{
+    draw_shape_t *shapes = draw_layer_shapes(layer);
+    if (shapes == NULL)
+    {
+        return;
+    }
 
-    DEBUG_PRINTF("[DRAW] Screen cleared to colour 0x%04X\n", colour);
+    lv_memzero(shapes, sizeof(draw_shape_t) * DRAW_LAYER_MAX_SHAPES);
+    lv_obj_set_style_bg_color(layer, draw_colour(colour), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(layer, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_invalidate(layer);
 }
 
 /******************************************************************************
@@ -2,9 +2,31 @@
  * @file MAIN_drawingLib.h
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief Drawing functions for EARS - rectangles, shapes, etc.
- * @details Functions callable from main code and EEZ Studio Flow
- * @version 1.0.0
- * @date 20260210
+ * @details Functions callable from main code and EEZ Studio Flow, with two
+ *          backends:
+ *
+ *          - Direct (Arduino_GFX): draws to the panel at once. For use before
+ *            LVGL owns the display (boot splash, display tests, benchmarks);
+ *            anything LVGL later redraws over it is lost.
+ *          - Command list (Arduino_GFX): MAIN_draw_list_begin(), shape and
+ *            text commands, then MAIN_draw_list_submit(). Commands hidden
+ *            under a later opaque rectangle are dropped, the rest are
+ *            rasterised DRAW_LIST_BAND_ROWS rows at a time into one buffer
+ *            and sent as a few merged address windows per band instead of
+ *            a bus transaction per primitive. For boot and diagnostic
+ *            screens drawn before LVGL starts.
+ *          - Sprite cache (Arduino_GFX): MAIN_draw_button_cached() renders
+ *            a rounded button once per size, radius and colours and pushes
+ *            it as one bitmap afterwards, so menus of repeated buttons are
+ *            not rasterised again on every redraw.
+ *          - Draw layer (LVGL): MAIN_draw_layer_create() makes a transparent
+ *            object that keeps up to DRAW_LAYER_MAX_SHAPES shapes and draws
+ *            them with lv_draw_rect() in its LV_EVENT_DRAW_MAIN. Adding,
+ *            moving or removing a shape only invalidates its area, so the
+ *            shapes go through the normal dirty-area refresh with everything
+ *            else on screen, in the right order and without flicker.
+ * @version 1.3.0
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -19,6 +41,7 @@
 #include <Arduino.h>
 #include "EARS_versionDef.h"
 #include <Arduino_GFX_Library.h>
+#include <lvgl.h>
 #include "EARS_rgb565ColoursDef.h"
 
 /******************************************************************************
@@ -28,9 +51,9 @@ namespace MAIN_Drawing
 {
     constexpr const char* LIB_NAME = "MAIN_Drawing";
     constexpr const char* VERSION_MAJOR = "1";
-    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_MINOR = "3";
     constexpr const char* VERSION_PATCH = "0";
-    constexpr const char* VERSION_DATE = "2026-02-10";
+    constexpr const char* VERSION_DATE = "2026-10-15";
 }
 
 
@@ -41,7 +64,53 @@ const char* MAIN_Drawing_getVersionDate();
 void MAIN_Drawing_getVersionString(char* buffer);
 
 /******************************************************************************
- * Function Prototypes
+ * Draw Layer Configuration
+ *****************************************************************************/
+#define DRAW_LAYER_MAX_SHAPES 32   // Shapes one draw layer keeps
+
+// Returned when a layer is full or the shape does not exist
+#define DRAW_SHAPE_INVALID (-1)
+
+/******************************************************************************
+ * Command List Configuration
+ *****************************************************************************/
+#define DRAW_LIST_MAX_COMMANDS 64  // Commands held; a full list is submitted early
+#define DRAW_LIST_TEXT_SIZE 32     // Text command characters + NUL
+#define DRAW_LIST_BAND_ROWS 16     // Rows rasterised per pass
+#define DRAW_LIST_MAX_WIDTH 480    // Longest panel side (any rotation)
+
+/******************************************************************************
+ * Sprite Cache Configuration
+ *****************************************************************************/
+#define DRAW_SPRITE_SLOTS 12                        // Distinct button looks kept
+#define DRAW_SPRITE_CACHE_BYTES (128 * 1024UL)      // Pixel memory of all sprites (PSRAM first)
+#define DRAW_SPRITE_MAX_PIXELS (16 * 1024UL)        // Bigger buttons are drawn directly
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef int8_t MAIN_draw_shape_t;
+
+typedef struct
+{
+    uint16_t commands;              // Submitted
+    uint16_t culled;                // Hidden under a later opaque rectangle
+    uint16_t windows;               // Address windows written (not counted without the band buffer)
+    uint32_t pixels;                // Pixels sent in those windows
+} MAIN_draw_list_stats_t;
+
+typedef struct
+{
+    uint32_t hits;                  // Drawn from a cached sprite
+    uint32_t misses;                // Rendered (or drawn directly)
+    uint32_t evictions;             // Sprites dropped for room
+    uint32_t bytes;                 // Pixel memory held now
+    uint8_t sprites;                // Sprites held now
+} MAIN_draw_sprite_stats_t;
+
+/******************************************************************************
+ * Function Prototypes - Direct (Arduino_GFX)
  *****************************************************************************/
 
 /**
@@ -110,6 +179,201 @@ void MAIN_draw_button_rect(Arduino_GFX *gfx, int16_t x, int16_t y, int16_t w, in
  */
 void MAIN_clear_screen(Arduino_GFX *gfx, uint16_t colour = EARS_RGB565_BLACK);
 
+/******************************************************************************
+ * Function Prototypes - Command List (Arduino_GFX)
+ *****************************************************************************/
+
+/**
+ * @brief Start a command list, discarding anything not submitted
+ * @param gfx Pointer to Arduino_GFX object the list is drawn to
+ * @return true if ready (the band buffer is allocated on the first call;
+ *         without it submit falls back to the direct functions)
+ * @note One list, used by the task that owns the display
+ */
+bool MAIN_draw_list_begin(Arduino_GFX *gfx);
+
+/**
+ * @brief Queue a fill of the whole screen
+ * @param colour RGB565 colour value
+ */
+void MAIN_draw_list_clear(uint16_t colour = EARS_RGB565_BLACK);
+
+/**
+ * @brief Queue a filled rectangle (arguments as MAIN_draw_filled_rect())
+ */
+void MAIN_draw_list_filled_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t colour);
+
+/**
+ * @brief Queue a rectangle outline (arguments as MAIN_draw_rect_outline())
+ */
+void MAIN_draw_list_rect_outline(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t colour);
+
+/**
+ * @brief Queue a rounded rectangle (arguments as MAIN_draw_rounded_rect())
+ */
+void MAIN_draw_list_rounded_rect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t colour);
+
+/**
+ * @brief Queue a rounded rectangle outline (arguments as
+ *        MAIN_draw_rounded_rect_outline())
+ */
+void MAIN_draw_list_rounded_rect_outline(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t colour);
+
+/**
+ * @brief Queue a button-style rectangle (arguments as MAIN_draw_button_rect())
+ */
+void MAIN_draw_list_button_rect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                uint16_t fillColour, uint16_t borderColour);
+
+/**
+ * @brief Queue a line of text in the built-in font
+ * @param x X coordinate (top-left corner)
+ * @param y Y coordinate (top-left corner)
+ * @param text Text (copied, DRAW_LIST_TEXT_SIZE - 1 characters kept)
+ * @param colour RGB565 colour value (transparent background)
+ * @param size Text size multiplier (1 = 6x8 pixels per character)
+ * @note Text is drawn after the rectangles of the same submit, through
+ *       Arduino_GFX, so it always lands on top of them
+ */
+void MAIN_draw_list_text(int16_t x, int16_t y, const char *text, uint16_t colour, uint8_t size = 1);
+
+/**
+ * @brief Draw the queued commands and empty the list
+ * @param stats Receives the counters of this list (NULL = not needed)
+ * @return uint16_t Address windows written
+ */
+uint16_t MAIN_draw_list_submit(MAIN_draw_list_stats_t *stats = NULL);
+
+/******************************************************************************
+ * Function Prototypes - Sprite Cache (Arduino_GFX)
+ *****************************************************************************/
+
+/**
+ * @brief Draw a rounded button from a cached RGB565 sprite
+ * @details The first draw of a size, radius and colour combination renders
+ *          the sprite; later ones are a single draw16bitRGBBitmap(). The
+ *          least recently drawn sprite makes room for a new one.
+ * @param gfx Pointer to Arduino_GFX object
+ * @param x X coordinate (top-left corner)
+ * @param y Y coordinate (top-left corner)
+ * @param w Width in pixels
+ * @param h Height in pixels
+ * @param r Corner radius in pixels
+ * @param fillColour RGB565 fill colour
+ * @param borderColour RGB565 border colour (1 pixel)
+ * @param backgroundColour RGB565 colour behind the corners (the sprite is
+ *        a full rectangle)
+ * @note Buttons over DRAW_SPRITE_MAX_PIXELS, or with no memory for the
+ *       sprite, are drawn directly with transparent corners. One cache,
+ *       used by the task that owns the display.
+ */
+void MAIN_draw_button_cached(Arduino_GFX *gfx, int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                             uint16_t fillColour, uint16_t borderColour,
+                             uint16_t backgroundColour = EARS_RGB565_BLACK);
+
+/**
+ * @brief Free every cached sprite
+ */
+void MAIN_draw_sprite_cache_clear(void);
+
+/**
+ * @brief Sprite cache counters
+ * @param stats Receives a copy
+ */
+void MAIN_draw_sprite_cache_get_stats(MAIN_draw_sprite_stats_t *stats);
+
+/******************************************************************************
+ * Function Prototypes - Draw Layer (LVGL task only)
+ *****************************************************************************/
+
+/**
+ * @brief Create a draw layer covering its parent
+ * @param parent Screen or container to draw on
+ * @return lv_obj_t* Layer (transparent, not clickable), NULL if out of memory
+ */
+lv_obj_t *MAIN_draw_layer_create(lv_obj_t *parent);
+
+/**
+ * @brief Add a filled rectangle
+ * @param layer Draw layer
+ * @param x X coordinate relative to the layer (top-left corner)
+ * @param y Y coordinate relative to the layer (top-left corner)
+ * @param w Width in pixels
+ * @param h Height in pixels
+ * @param colour RGB565 colour value
+ * @return MAIN_draw_shape_t Shape id, DRAW_SHAPE_INVALID if the layer is full
+ */
+MAIN_draw_shape_t MAIN_draw_layer_filled_rect(lv_obj_t *layer, int16_t x, int16_t y, int16_t w, int16_t h,
+                                              uint16_t colour);
+
+/**
+ * @brief Add a rectangle outline (1 pixel)
+ * @return MAIN_draw_shape_t Shape id, DRAW_SHAPE_INVALID if the layer is full
+ */
+MAIN_draw_shape_t MAIN_draw_layer_rect_outline(lv_obj_t *layer, int16_t x, int16_t y, int16_t w, int16_t h,
+                                               uint16_t colour);
+
+/**
+ * @brief Add a rounded rectangle (filled)
+ * @param r Corner radius in pixels
+ * @return MAIN_draw_shape_t Shape id, DRAW_SHAPE_INVALID if the layer is full
+ */
+MAIN_draw_shape_t MAIN_draw_layer_rounded_rect(lv_obj_t *layer, int16_t x, int16_t y, int16_t w, int16_t h,
+                                               int16_t r, uint16_t colour);
+
+/**
+ * @brief Add a rounded rectangle outline (1 pixel)
+ * @param r Corner radius in pixels
+ * @return MAIN_draw_shape_t Shape id, DRAW_SHAPE_INVALID if the layer is full
+ */
+MAIN_draw_shape_t MAIN_draw_layer_rounded_rect_outline(lv_obj_t *layer, int16_t x, int16_t y, int16_t w,
+                                                       int16_t h, int16_t r, uint16_t colour);
+
+/**
+ * @brief Add a button-style rectangle (filled with border)
+ * @param fillColour RGB565 fill colour
+ * @param borderColour RGB565 border colour
+ * @return MAIN_draw_shape_t Shape id, DRAW_SHAPE_INVALID if the layer is full
+ */
+MAIN_draw_shape_t MAIN_draw_layer_button_rect(lv_obj_t *layer, int16_t x, int16_t y, int16_t w, int16_t h,
+                                              uint16_t fillColour, uint16_t borderColour);
+
+/**
+ * @brief Move a shape
+ * @param layer Draw layer
+ * @param shape Shape id
+ * @param x New X coordinate relative to the layer
+ * @param y New Y coordinate relative to the layer
+ * @return true if the shape exists
+ */
+bool MAIN_draw_layer_move(lv_obj_t *layer, MAIN_draw_shape_t shape, int16_t x, int16_t y);
+
+/**
+ * @brief Recolour a shape
+ * @param layer Draw layer
+ * @param shape Shape id
+ * @param colour RGB565 fill colour (the outline colour for outlines)
+ * @return true if the shape exists
+ */
+bool MAIN_draw_layer_set_colour(lv_obj_t *layer, MAIN_draw_shape_t shape, uint16_t colour);
+
+/**
+ * @brief Remove a shape
+ * @param layer Draw layer
+ * @param shape Shape id
+ * @return true if the shape existed
+ */
+bool MAIN_draw_layer_remove(lv_obj_t *layer, MAIN_draw_shape_t shape);
+
+/**
+ * @brief Remove every shape and fill the layer with a colour
+ * @details The LVGL counterpart of MAIN_clear_screen(): the fill is the
+ *          layer's own background, drawn by LVGL in the same refresh
+ * @param layer Draw layer
+ * @param colour RGB565 colour value
+ */
+void MAIN_draw_layer_clear(lv_obj_t *layer, uint16_t colour = EARS_RGB565_BLACK);
+
 #endif // __MAIN_DRAWING_LIB_H__
 
 /******************************************************************************
@@ -0,0 +1,502 @@
+/**
+ * @file MAIN_flowHeapLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Size-class pool allocator behind eez::alloc / eez::free
+ * @version 1.2.2
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_flowHeapLib.h"
+#include "EARS_systemDef.h"
+#include "MAIN_sysinfoLib.h"
+#include "MAIN_memPlanLib.h"
+#include <lvgl.h>
+#include <esp_heap_caps.h>
+#include <multi_heap.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+// Large blocks use this class index
+#define FLOW_HEAP_CLASS_LARGE 0xFF
+#define FLOW_HEAP_MAGIC 0xF10E
+
+typedef struct
+{
+    uint8_t cls;    // Size class, or FLOW_HEAP_CLASS_LARGE
+    uint8_t pad;    // Bytes skipped to align the block (large blocks)
+    uint16_t magic; // FLOW_HEAP_MAGIC while handed out
+    uint32_t size;  // Payload bytes (large blocks)
+} flow_heap_header_t;
+
+typedef struct flow_heap_free_s
+{
+    struct flow_heap_free_s *next;
+} flow_heap_free_t;
+
+static_assert(sizeof(flow_heap_header_t) % FLOW_HEAP_ALIGN == 0, "header must keep blocks aligned");
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static const uint16_t flow_heap_class_sizes[FLOW_HEAP_CLASS_COUNT] = FLOW_HEAP_CLASS_SIZES;
+static flow_heap_free_t *flow_heap_free_lists[FLOW_HEAP_CLASS_COUNT];
+static MAIN_flow_heap_stats_t flow_heap_stats;
+static multi_heap_handle_t flow_heap_region = NULL;
+static bool flow_heap_initialised = false;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Backing heap allocation
+ * @param size Bytes
+ * @return void* Block, or NULL
+ */
+static void *flow_heap_backing_alloc(size_t size)
+{
+    if (!flow_heap_initialised)
+    {
+        MAIN_initialise_flow_heap();
+    }
+
+    if (flow_heap_region == NULL)
+    {
+        return lv_malloc(size);
+    }
+
+    void *ptr = multi_heap_malloc(flow_heap_region, size);
+    if (ptr != NULL)
+    {
+        flow_heap_stats.heapUsed += multi_heap_get_allocated_size(flow_heap_region, ptr);
+        if (flow_heap_stats.heapUsed > flow_heap_stats.heapPeak)
+        {
+            flow_heap_stats.heapPeak = flow_heap_stats.heapUsed;
+        }
+    }
+    return ptr;
+}
+
+/**
+ * @brief Backing heap release
+ * @param ptr Block
+ */
+static void flow_heap_backing_free(void *ptr)
+{
+    if (flow_heap_region == NULL)
+    {
+        lv_free(ptr);
+        return;
+    }
+
+    flow_heap_stats.heapUsed -= multi_heap_get_allocated_size(flow_heap_region, ptr);
+    multi_heap_free(flow_heap_region, ptr);
+}
+
+/**
+ * @brief Align a raw backing block so the payload after a header is aligned
+ * @param raw Block from the backing heap
+ * @return flow_heap_header_t* Header position
+ */
+static flow_heap_header_t *flow_heap_align(uint8_t *raw)
+{
+    uintptr_t payload = ((uintptr_t)raw + sizeof(flow_heap_header_t) + FLOW_HEAP_ALIGN - 1) &
+                        ~(uintptr_t)(FLOW_HEAP_ALIGN - 1);
+    flow_heap_header_t *header = (flow_heap_header_t *)payload - 1;
+    header->pad = (uint8_t)((uint8_t *)header - raw);
+    return header;
+}
+
+/**
+ * @brief Size class for a request (binary search would not pay for 9 classes)
+ * @param size Payload bytes, at most FLOW_HEAP_MAX_POOLED
+ * @return uint8_t Class index
+ */
+static uint8_t flow_heap_class_of(size_t size)
+{
+    uint8_t cls = 0;
+    while (flow_heap_class_sizes[cls] < size)
+    {
+        cls++;
+    }
+    return cls;
+}
+
+/**
+ * @brief Carve a new slab into a class's free list
+ * @param cls Class index
+ * @return true if the free list is no longer empty
+ */
+static bool flow_heap_refill(uint8_t cls)
+{
+    size_t stride = sizeof(flow_heap_header_t) + flow_heap_class_sizes[cls];
+    size_t count = FLOW_HEAP_SLAB_BYTES / stride;
+    if (count == 0)
+    {
+        count = 1;
+    }
+
+    // The backing heap only guarantees 4-byte alignment
+    uint8_t *raw = (uint8_t *)flow_heap_backing_alloc(count * stride + FLOW_HEAP_ALIGN - 1);
+    if (raw == NULL)
+    {
+        return false;
+    }
+    uint8_t *slab = (uint8_t *)flow_heap_align(raw);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        flow_heap_header_t *header = (flow_heap_header_t *)(slab + i * stride);
+        header->cls = cls;
+        header->magic = 0;
+        flow_heap_free_t *block = (flow_heap_free_t *)(header + 1);
+        block->next = flow_heap_free_lists[cls];
+        flow_heap_free_lists[cls] = block;
+    }
+
+    flow_heap_stats.classes[cls].blocks += count;
+    flow_heap_stats.slabBytes += count * stride + FLOW_HEAP_ALIGN - 1;
+    return true;
+}
+
+/******************************************************************************
+ * Flow Heap
+ *****************************************************************************/
+
+/**
+ * @brief Create the dedicated flow heap
+ * @return true if the flow has its own heap
+ */
+bool MAIN_initialise_flow_heap(void)
+{
+    if (flow_heap_initialised)
+    {
+        return flow_heap_region != NULL;
+    }
+    flow_heap_initialised = true;
+
+    uint8_t *region = NULL;
+    bool inPsram = false;
+
+#if FLOW_HEAP_USE_PSRAM == 1
+    if (MAIN_sysinfo_has_psram())
+    {
+        region = (uint8_t *)MAIN_mem_alloc(MEM_POOL_FLOW_HEAP, FLOW_HEAP_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        inPsram = (region != NULL);
+    }
+#endif
+    if (region == NULL)
+    {
+        region = (uint8_t *)MAIN_mem_alloc(MEM_POOL_FLOW_HEAP, FLOW_HEAP_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+
+    // The IDF region heap, not lv_tlsf: LVGL only builds its TLSF with the
+    // builtin allocator, and lv_malloc is on heap_caps (EARS_LVGL_HEAP_CAPS)
+    if (region != NULL)
+    {
+        flow_heap_region = multi_heap_register(region, FLOW_HEAP_SIZE);
+    }
+
+    if (flow_heap_region == NULL)
+    {
+        MAIN_mem_free(region);
+        Serial.println("[FLOWHEAP] Warning: No dedicated heap, sharing the LVGL heap");
+        return false;
+    }
+
+    flow_heap_stats.heapSize = FLOW_HEAP_SIZE;
+    flow_heap_stats.heapInPsram = inPsram;
+
+#if EARS_DEBUG == 1
+    Serial.printf("[FLOWHEAP] %lu KB flow heap in %s\n", (unsigned long)(FLOW_HEAP_SIZE / 1024),
+                  inPsram ? "PSRAM" : "internal RAM");
+#endif
+
+    return true;
+}
+
+/**
+ * @brief Allocate for the flow runtime
+ * @param size Bytes
+ * @return void* Block, or NULL
+ */
+void *MAIN_flow_heap_alloc(size_t size)
+{
+    if (size == 0)
+    {
+        return NULL;
+    }
+
+    if (size > FLOW_HEAP_MAX_POOLED)
+    {
+        uint8_t *raw = (uint8_t *)flow_heap_backing_alloc(sizeof(flow_heap_header_t) + size + FLOW_HEAP_ALIGN - 1);
+        if (raw == NULL)
+        {
+            flow_heap_stats.failures++;
+            return NULL;
+        }
+        flow_heap_header_t *header = flow_heap_align(raw);
+        header->cls = FLOW_HEAP_CLASS_LARGE;
+        header->magic = FLOW_HEAP_MAGIC;
+        header->size = size;
+        flow_heap_stats.largeAllocs++;
+        flow_heap_stats.largeBytes += size;
+        if (flow_heap_stats.largeBytes > flow_heap_stats.largePeak)
+        {
+            flow_heap_stats.largePeak = flow_heap_stats.largeBytes;
+        }
+        return header + 1;
+    }
+
+    uint8_t cls = flow_heap_class_of(size);
+    if (flow_heap_free_lists[cls] == NULL && !flow_heap_refill(cls))
+    {
+        flow_heap_stats.failures++;
+        return NULL;
+    }
+
+    flow_heap_free_t *block = flow_heap_free_lists[cls];
+    flow_heap_free_lists[cls] = block->next;
+
+    flow_heap_header_t *header = (flow_heap_header_t *)block - 1;
+    header->magic = FLOW_HEAP_MAGIC;
+
+    MAIN_flow_heap_class_stats_t *stats = &flow_heap_stats.classes[cls];
+    stats->allocs++;
+    stats->inUse++;
+    if (stats->inUse > stats->peak)
+    {
+        stats->peak = stats->inUse;
+    }
+    flow_heap_stats.pooledBytes += flow_heap_class_sizes[cls];
+    if (flow_heap_stats.pooledBytes > flow_heap_stats.pooledPeak)
+    {
+        flow_heap_stats.pooledPeak = flow_heap_stats.pooledBytes;
+    }
+
+    return block;
+}
+
+/**
+ * @brief Release a block from MAIN_flow_heap_alloc()
+ * @param ptr Block
+ */
+void MAIN_flow_heap_free(void *ptr)
+{
+    if (ptr == NULL)
+    {
+        return;
+    }
+
+    flow_heap_header_t *header = (flow_heap_header_t *)ptr - 1;
+    if (header->magic != FLOW_HEAP_MAGIC)
+    {
+        // Double free or a pointer the pool never handed out
+        Serial.printf("[FLOWHEAP] ERROR: Bad free %p\n", ptr);
+        return;
+    }
+    header->magic = 0;
+
+    if (header->cls == FLOW_HEAP_CLASS_LARGE)
+    {
+        flow_heap_stats.largeBytes -= header->size;
+        flow_heap_backing_free((uint8_t *)header - header->pad);
+        return;
+    }
+
+    uint8_t cls = header->cls;
+#if EARS_DEBUG == 1
+    memset(ptr, FLOW_HEAP_SCRUB_BYTE, flow_heap_class_sizes[cls]);
+#endif
+
+    flow_heap_free_t *block = (flow_heap_free_t *)ptr;
+    block->next = flow_heap_free_lists[cls];
+    flow_heap_free_lists[cls] = block;
+
+    flow_heap_stats.classes[cls].inUse--;
+    flow_heap_stats.pooledBytes -= flow_heap_class_sizes[cls];
+}
+
+/**
+ * @brief Long-lived buffer outside the flow heap
+ * @param size Bytes
+ * @param inPsram Receives true if the buffer is in PSRAM (may be NULL)
+ * @return void* Buffer, or NULL
+ */
+void *MAIN_flow_heap_alloc_bulk(size_t size, bool *inPsram)
+{
+    void *ptr = NULL;
+    bool psram = false;
+
+    if (FLOW_HEAP_USE_PSRAM == 1 && MAIN_sysinfo_has_psram())
+    {
+        ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        psram = (ptr != NULL);
+    }
+    if (ptr == NULL)
+    {
+        ptr = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+
+    if (inPsram != NULL)
+    {
+        *inPsram = psram;
+    }
+    return ptr;
+}
+
+/**
+ * @brief Release a buffer from MAIN_flow_heap_alloc_bulk()
+ * @param ptr Buffer (NULL is ignored)
+ */
+void MAIN_flow_heap_free_bulk(void *ptr)
+{
+    heap_caps_free(ptr);
+}
+
+/**
+ * @brief Totals for eez::getAllocInfo()
+ * @param freeBytes Pooled free blocks plus backing heap free
+ * @param allocBytes Bytes handed out to the flow
+ */
+void MAIN_flow_heap_get_info(uint32_t *freeBytes, uint32_t *allocBytes)
+{
+    uint32_t pooledFree = 0;
+    for (uint8_t i = 0; i < FLOW_HEAP_CLASS_COUNT; i++)
+    {
+        const MAIN_flow_heap_class_stats_t *stats = &flow_heap_stats.classes[i];
+        pooledFree += (uint32_t)(stats->blocks - stats->inUse) * flow_heap_class_sizes[i];
+    }
+
+    uint32_t backingFree;
+    if (flow_heap_region != NULL)
+    {
+        backingFree = multi_heap_free_size(flow_heap_region);
+    }
+    else
+    {
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        backingFree = mon.free_size;
+    }
+
+    if (freeBytes != NULL)
+    {
+        *freeBytes = pooledFree + backingFree;
+    }
+    if (allocBytes != NULL)
+    {
+        *allocBytes = flow_heap_stats.pooledBytes + flow_heap_stats.largeBytes;
+    }
+}
+
+/**
+ * @brief Per-class counters
+ * @param stats Receives the counters
+ */
+void MAIN_flow_heap_get_stats(MAIN_flow_heap_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    *stats = flow_heap_stats;
+    for (uint8_t i = 0; i < FLOW_HEAP_CLASS_COUNT; i++)
+    {
+        stats->classes[i].blockSize = flow_heap_class_sizes[i];
+    }
+}
+
+/**
+ * @brief Print the counters to Serial
+ */
+void MAIN_flow_heap_print_stats(void)
+{
+    MAIN_flow_heap_stats_t stats;
+    MAIN_flow_heap_get_stats(&stats);
+
+    Serial.printf("[FLOWHEAP] Pooled %lu B in use, %lu B in slabs, large %lu B, %lu failures\n",
+                  (unsigned long)stats.pooledBytes, (unsigned long)stats.slabBytes,
+                  (unsigned long)stats.largeBytes, (unsigned long)stats.failures);
+    for (uint8_t i = 0; i < FLOW_HEAP_CLASS_COUNT; i++)
+    {
+        const MAIN_flow_heap_class_stats_t *c = &stats.classes[i];
+        if (c->blocks == 0)
+        {
+            continue;
+        }
+        Serial.printf("[FLOWHEAP]   %3u B: %u in use, peak %u, %u carved, %lu allocs\n",
+                      c->blockSize, c->inUse, c->peak, c->blocks, (unsigned long)c->allocs);
+    }
+}
+
+/**
+ * @brief Print high-water marks of the flow heap, its pools and LVGL's heap
+ */
+void MAIN_flow_heap_print_report(void)
+{
+    MAIN_flow_heap_stats_t stats;
+    MAIN_flow_heap_get_stats(&stats);
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+
+    if (stats.heapSize != 0)
+    {
+        Serial.printf("[FLOWHEAP] Flow heap (%s): %lu / %lu B used, peak %lu B\n",
+                      stats.heapInPsram ? "PSRAM" : "internal", (unsigned long)stats.heapUsed,
+                      (unsigned long)stats.heapSize, (unsigned long)stats.heapPeak);
+    }
+    else
+    {
+        Serial.println("[FLOWHEAP] Flow heap: sharing the LVGL heap");
+    }
+    Serial.printf("[FLOWHEAP]   Pooled values: %lu B, peak %lu B\n",
+                  (unsigned long)stats.pooledBytes, (unsigned long)stats.pooledPeak);
+    Serial.printf("[FLOWHEAP]   Large blocks:  %lu B, peak %lu B\n",
+                  (unsigned long)stats.largeBytes, (unsigned long)stats.largePeak);
+    Serial.printf("[FLOWHEAP] LVGL heap: %lu / %lu B used, peak %lu B, %u%% fragmented\n",
+                  (unsigned long)(mon.total_size - mon.free_size), (unsigned long)mon.total_size,
+                  (unsigned long)mon.max_used, mon.frag_pct);
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_FlowHeap_getLibraryName() {
+    return MAIN_FlowHeap::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_FlowHeap_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_FlowHeap::VERSION_MAJOR,
+                       MAIN_FlowHeap::VERSION_MINOR,
+                       MAIN_FlowHeap::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_FlowHeap_getVersionDate() {
+    return MAIN_FlowHeap::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_FlowHeap_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_FlowHeap_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_flowHeapLib.cpp
+ ******************************************************************************/
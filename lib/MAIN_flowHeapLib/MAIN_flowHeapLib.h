@@ -0,0 +1,176 @@
+/**
+ * @file MAIN_flowHeapLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Size-class pool allocator behind eez::alloc / eez::free
+ * @details The EEZ Flow runtime allocates and frees many small objects
+ *          (Value string and array refs, flow states, component execution
+ *          states). Requests up to FLOW_HEAP_MAX_POOLED bytes are rounded up
+ *          to a size class and served from that class's free list, carved
+ *          from slabs on demand, so alloc and free are O(1) and churn does
+ *          not fragment the backing heap. Larger requests go straight to the
+ *          backing heap.
+ *
+ *          The backing heap is the flow's own region of FLOW_HEAP_SIZE bytes
+ *          under the IDF region allocator (multi_heap), in PSRAM when
+ *          available, so flow values and LVGL objects no longer share (and
+ *          fragment) LVGL's heap, whichever allocator lv_malloc is on. If the region
+ *          cannot be allocated the flow falls back to lv_malloc.
+ *
+ *          Every block carries an 8-byte header with its class. Slabs are
+ *          kept once carved, so pooled memory stays at its high-water mark.
+ *          Not thread safe: the flow runs in the LVGL task, as lv_malloc
+ *          already assumes.
+ * @version 1.2.2
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_FLOW_HEAP_LIB_H__
+#define __MAIN_FLOW_HEAP_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_FlowHeap
+{
+    constexpr const char* LIB_NAME = "MAIN_FlowHeap";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "2";
+    constexpr const char* VERSION_PATCH = "2";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_FlowHeap_getLibraryName();
+uint32_t MAIN_FlowHeap_getVersionEncoded();
+const char* MAIN_FlowHeap_getVersionDate();
+void MAIN_FlowHeap_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Flow Heap Configuration
+ *****************************************************************************/
+
+// Block alignment: 8 bytes covers double and int64_t on the Xtensa LX7
+#define FLOW_HEAP_ALIGN 8
+
+// Size classes (bytes of payload, multiples of FLOW_HEAP_ALIGN, ascending)
+#define FLOW_HEAP_CLASS_SIZES {16, 24, 32, 48, 64, 96, 128, 192, 256}
+#define FLOW_HEAP_CLASS_COUNT 9
+#define FLOW_HEAP_MAX_POOLED 256
+
+// Bytes carved per slab when a class runs dry
+#define FLOW_HEAP_SLAB_BYTES 1024
+
+// Dedicated flow heap, placed in PSRAM when FLOW_HEAP_USE_PSRAM and present
+#define FLOW_HEAP_SIZE (64 * 1024U)
+#define FLOW_HEAP_USE_PSRAM 1
+
+// Freed blocks are filled with this in debug builds to expose use-after-free
+#define FLOW_HEAP_SCRUB_BYTE 0xCC
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint16_t blockSize; // Payload bytes
+    uint16_t inUse;     // Blocks handed out
+    uint16_t peak;      // Most blocks handed out at once
+    uint16_t blocks;    // Blocks carved (in use + free list)
+    uint32_t allocs;    // Allocations served
+} MAIN_flow_heap_class_stats_t;
+
+typedef struct
+{
+    MAIN_flow_heap_class_stats_t classes[FLOW_HEAP_CLASS_COUNT];
+    uint32_t largeAllocs;    // Requests above FLOW_HEAP_MAX_POOLED
+    uint32_t largeBytes;     // Large bytes in use
+    uint32_t pooledBytes;    // Pooled bytes in use (payload)
+    uint32_t slabBytes;      // Bytes held by slabs
+    uint32_t failures;       // Requests the backing heap refused
+    uint32_t pooledPeak;     // Most pooled bytes in use at once
+    uint32_t largePeak;      // Most large bytes in use at once
+    uint32_t heapSize;       // Dedicated heap size (0 = sharing lv_malloc)
+    uint32_t heapUsed;       // Dedicated heap bytes allocated
+    uint32_t heapPeak;       // Dedicated heap high-water mark
+    bool heapInPsram;        // Dedicated heap placed in PSRAM
+} MAIN_flow_heap_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Create the dedicated flow heap
+ * @return true if the flow has its own heap (false = sharing lv_malloc)
+ * @note Called by eez::initAllocHeap() and on the first allocation.
+ */
+bool MAIN_initialise_flow_heap(void);
+
+/**
+ * @brief Allocate for the flow runtime
+ * @param size Bytes (0 returns NULL)
+ * @return void* FLOW_HEAP_ALIGN aligned block, or NULL
+ */
+void *MAIN_flow_heap_alloc(size_t size);
+
+/**
+ * @brief Release a block from MAIN_flow_heap_alloc()
+ * @param ptr Block (NULL is ignored)
+ */
+void MAIN_flow_heap_free(void *ptr);
+
+/**
+ * @brief Long-lived buffer outside the flow heap
+ * @param size Bytes
+ * @param inPsram Receives true if the buffer is in PSRAM (may be NULL)
+ * @return void* Buffer in PSRAM when available, else internal RAM, or NULL
+ * @note For blocks that live as long as the flow (decompressed assets), so
+ *       they take neither the flow heap nor LVGL's pool.
+ */
+void *MAIN_flow_heap_alloc_bulk(size_t size, bool *inPsram);
+
+/**
+ * @brief Release a buffer from MAIN_flow_heap_alloc_bulk()
+ * @param ptr Buffer (NULL is ignored)
+ */
+void MAIN_flow_heap_free_bulk(void *ptr);
+
+/**
+ * @brief Totals for eez::getAllocInfo()
+ * @param freeBytes Pooled free blocks plus backing heap free
+ * @param allocBytes Bytes handed out to the flow
+ */
+void MAIN_flow_heap_get_info(uint32_t *freeBytes, uint32_t *allocBytes);
+
+/**
+ * @brief Per-class counters
+ * @param stats Receives the counters
+ */
+void MAIN_flow_heap_get_stats(MAIN_flow_heap_stats_t *stats);
+
+/**
+ * @brief Print the counters to Serial
+ */
+void MAIN_flow_heap_print_stats(void);
+
+/**
+ * @brief Print high-water marks of the flow heap, its pools and LVGL's heap
+ */
+void MAIN_flow_heap_print_report(void);
+
+#endif // __MAIN_FLOW_HEAP_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_flowHeapLib.h
+ ******************************************************************************/
@@ -0,0 +1,325 @@
+/**
+ * @file MAIN_flowTaskLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Optional EEZ Flow worker task with a UI command queue
+ * @version 1.1.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_flowTaskLib.h"
+#include "EARS_systemDef.h"
+#include "MAIN_flowHeapLib.h"
+#include "EARS_mpscRingDef.h"
+#include <freertos/semphr.h>
+#include <atomic>
+
+// The generated UI (src/ui) provides the flow tick
+extern "C" void eez_flow_tick();
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    MAIN_flow_ui_command_fn_t fn;
+    void *ctx;
+    uint32_t param;
+} flow_ui_slot_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static TaskHandle_t flow_task_handle = NULL;
+static TaskHandle_t flow_ui_task_handle = NULL;
+static SemaphoreHandle_t flow_lock = NULL;
+static EARS_mpscRing<flow_ui_slot_t, FLOW_UI_QUEUE_SIZE> flow_ui_ring; // UI task consumes
+static MAIN_flow_task_stats_t flow_task_stats;
+static std::atomic<uint32_t> flow_ui_dropped(0); // Any task may post
+static std::atomic<bool> flow_paused(false);
+
+/******************************************************************************
+ * Flow Task Function
+ *****************************************************************************/
+
+#if EARS_FLOW_TASK == 1
+/**
+ * @brief Flow worker task (runs on FLOW_TASK_CORE)
+ * @param parameter Task parameter (unused)
+ */
+static void flow_task(void *parameter)
+{
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+    const TickType_t xPeriod = pdMS_TO_TICKS(FLOW_TASK_PERIOD_MS);
+
+    while (1)
+    {
+        if (!flow_paused.load(std::memory_order_relaxed) && MAIN_flow_lock(FLOW_LOCK_FOREVER))
+        {
+            eez_flow_tick();
+            MAIN_flow_unlock();
+            flow_task_stats.ticks++;
+        }
+
+        vTaskDelayUntil(&xLastWakeTime, xPeriod);
+    }
+}
+#endif
+
+/******************************************************************************
+ * Flow Task
+ *****************************************************************************/
+
+/**
+ * @brief Start the flow worker task
+ * @return true if the flow now ticks on its own task
+ */
+bool MAIN_initialise_flow_task(void)
+{
+#if EARS_FLOW_TASK == 1
+    if (flow_task_handle != NULL)
+    {
+        return true;
+    }
+
+    if (!MAIN_initialise_flow_heap())
+    {
+        Serial.println("[FLOWTASK] Warning: Flow shares lv_malloc, staying on the UI task");
+        return false;
+    }
+
+    flow_lock = xSemaphoreCreateRecursiveMutex();
+    if (flow_lock == NULL)
+    {
+        return false;
+    }
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        flow_task,
+        "Flow",
+        FLOW_TASK_STACK_SIZE,
+        NULL,
+        FLOW_TASK_PRIORITY,
+        &flow_task_handle,
+        FLOW_TASK_CORE);
+
+    if (result != pdPASS || flow_task_handle == NULL)
+    {
+        vSemaphoreDelete(flow_lock);
+        flow_lock = NULL;
+        flow_task_handle = NULL;
+#if EARS_DEBUG == 1
+        Serial.println("[ERROR] Failed to create flow task!");
+#endif
+        return false;
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[OK] Flow task on core %d, UI queue %d\n", FLOW_TASK_CORE, FLOW_UI_QUEUE_SIZE);
+#endif
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Check if the flow ticks on the worker task
+ * @return true if the worker is running
+ */
+bool MAIN_flow_task_is_running(void)
+{
+    return flow_task_handle != NULL;
+}
+
+/**
+ * @brief Check if the caller is the worker task
+ * @return true on the flow task
+ */
+bool MAIN_flow_task_is_current(void)
+{
+    return flow_task_handle != NULL && xTaskGetCurrentTaskHandle() == flow_task_handle;
+}
+
+/**
+ * @brief Take the flow lock (recursive)
+ * @param timeoutMs 0 = try only, FLOW_LOCK_FOREVER = wait
+ * @return true if held
+ */
+bool MAIN_flow_lock(uint32_t timeoutMs)
+{
+    if (flow_lock == NULL)
+    {
+        return true;
+    }
+
+    TickType_t ticks = (timeoutMs == FLOW_LOCK_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
+    return xSemaphoreTakeRecursive(flow_lock, ticks) == pdTRUE;
+}
+
+/**
+ * @brief Release the flow lock
+ */
+void MAIN_flow_unlock(void)
+{
+    if (flow_lock != NULL)
+    {
+        xSemaphoreGiveRecursive(flow_lock);
+    }
+}
+
+/**
+ * @brief Stop or restart flow ticks
+ * @param paused true: eez_flow_tick returns at once until cleared
+ */
+void MAIN_flow_set_paused(bool paused)
+{
+    flow_paused.store(paused, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Check if flow ticks are paused
+ * @return true while paused
+ */
+bool MAIN_flow_is_paused(void)
+{
+    return flow_paused.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************
+ * UI Command Queue
+ *****************************************************************************/
+
+/**
+ * @brief Queue a call for the UI task
+ * @param fn Function run on Core 0
+ * @param ctx Passed to fn
+ * @param param Passed to fn
+ * @return true if queued
+ */
+bool MAIN_flow_post_ui(MAIN_flow_ui_command_fn_t fn, void *ctx, uint32_t param)
+{
+    if (fn == NULL)
+    {
+        return false;
+    }
+
+    flow_ui_slot_t *slot = flow_ui_ring.claim();
+    if (slot == NULL)
+    {
+        flow_ui_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    slot->fn = fn;
+    slot->ctx = ctx;
+    slot->param = param;
+
+    // Hand the slot to the UI task
+    flow_ui_ring.publish(slot);
+
+    if (flow_ui_task_handle != NULL)
+    {
+        xTaskNotifyGive(flow_ui_task_handle);
+    }
+    return true;
+}
+
+/**
+ * @brief Run queued UI commands (UI task only)
+ * @param maxCommands Upper bound for this call
+ * @return uint16_t Commands run
+ */
+uint16_t MAIN_flow_apply_ui_commands(uint16_t maxCommands)
+{
+    uint16_t count = 0;
+
+    while (count < maxCommands)
+    {
+        // Empty, or the producer is still writing the next command
+        flow_ui_slot_t *slot = flow_ui_ring.peek();
+        if (slot == NULL)
+        {
+            break;
+        }
+
+        // Copy out and free the slot before running the command
+        flow_ui_slot_t command = *slot;
+        flow_ui_ring.pop();
+        count++;
+
+        command.fn(command.ctx, command.param);
+    }
+
+    flow_task_stats.uiCommands += count;
+    return count;
+}
+
+/**
+ * @brief Task woken when a command is posted
+ * @param task UI task handle
+ */
+void MAIN_flow_task_set_ui_task(TaskHandle_t task)
+{
+    flow_ui_task_handle = task;
+}
+
+/**
+ * @brief Worker counters
+ * @param stats Receives the counters
+ */
+void MAIN_flow_task_get_stats(MAIN_flow_task_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = flow_task_stats;
+        stats->dropped = flow_ui_dropped.load(std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Note a UI try-lock that found the flow busy
+ */
+void MAIN_flow_task_note_lock_miss(void)
+{
+    flow_task_stats.lockMisses++;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_FlowTask_getLibraryName() {
+    return MAIN_FlowTask::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_FlowTask_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_FlowTask::VERSION_MAJOR,
+                       MAIN_FlowTask::VERSION_MINOR,
+                       MAIN_FlowTask::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_FlowTask_getVersionDate() {
+    return MAIN_FlowTask::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_FlowTask_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_FlowTask_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_flowTaskLib.cpp
+ ******************************************************************************/
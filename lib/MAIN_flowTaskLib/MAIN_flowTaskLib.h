@@ -0,0 +1,186 @@
+/**
+ * @file MAIN_flowTaskLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Optional EEZ Flow worker task with a UI command queue
+ * @details With -D EARS_FLOW_TASK=1 the flow engine ticks on its own task on
+ *          FLOW_TASK_CORE instead of inside MAIN_core0_ui_task, so heavy flow
+ *          actions (JSON, array sorting, long loops) run while LVGL renders.
+ *
+ *          Flow state is guarded by a recursive lock, held by the worker for
+ *          each eez_flow_tick and by the UI task around bindings and LVGL event
+ *          callbacks into the flow. Components that touch LVGL (LVGL actions,
+ *          page changes, themes, native actions) are not run on the worker: the
+ *          flow posts them to a lock-free MPSC command queue, and Core 0 applies
+ *          the queue before each lv_timer_handler.
+ *
+ *          Without EARS_FLOW_TASK nothing is created, the lock functions return
+ *          at once and the flow keeps ticking from ui_tick.
+ *
+ *          MAIN_flow_set_paused() stops the flow ticking on either path, with
+ *          its state kept, while nothing it drives is on screen (the lock).
+ * @version 1.1.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_FLOW_TASK_LIB_H__
+#define __MAIN_FLOW_TASK_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "EARS_versionDef.h"
+#include "EARS_taskPlanLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_FlowTask
+{
+    constexpr const char* LIB_NAME = "MAIN_FlowTask";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "1";
+    constexpr const char* VERSION_PATCH = "1";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_FlowTask_getLibraryName();
+uint32_t MAIN_FlowTask_getVersionEncoded();
+const char* MAIN_FlowTask_getVersionDate();
+void MAIN_FlowTask_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Flow Task Configuration
+ *****************************************************************************/
+
+#ifndef EARS_FLOW_TASK
+#define EARS_FLOW_TASK 0
+#endif
+
+// Stack size (in words, not bytes)
+#define FLOW_TASK_STACK_SIZE 8192
+
+// Task priority and placement (EARS_taskPlanLib)
+#define FLOW_TASK_PRIORITY using_taskplan().priority(TASK_ROLE_FLOW)
+#define FLOW_TASK_CORE using_taskplan().core(TASK_ROLE_FLOW)
+
+// Flow tick period (each tick is bounded by EEZ_FLOW_TICK_MAX_DURATION_US)
+#define FLOW_TASK_PERIOD_MS 5
+
+// UI commands (power of 2) and how many Core 0 applies per frame
+#define FLOW_UI_QUEUE_SIZE 64
+#define FLOW_UI_BATCH 16
+
+// Pass as timeoutMs to wait for the lock indefinitely
+#define FLOW_LOCK_FOREVER 0xFFFFFFFFUL
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef void (*MAIN_flow_ui_command_fn_t)(void *ctx, uint32_t param);
+
+typedef struct
+{
+    uint32_t ticks;       // Flow ticks run on the worker
+    uint32_t uiCommands;  // Commands applied by Core 0
+    uint32_t dropped;     // Posts refused because the queue was full
+    uint32_t lockMisses;  // UI try-locks that found the flow busy
+} MAIN_flow_task_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Start the flow worker task
+ * @return true if the flow now ticks on its own task
+ * @note Call after ui_init(). Needs the flow's own heap (MAIN_flowHeapLib):
+ *       with only lv_malloc behind it the flow would race LVGL's allocator,
+ *       so the worker is not started.
+ */
+bool MAIN_initialise_flow_task(void);
+
+/**
+ * @brief Check if the flow ticks on the worker task
+ * @return true if the worker is running
+ */
+bool MAIN_flow_task_is_running(void);
+
+/**
+ * @brief Check if the caller is the worker task
+ * @return true on the flow task
+ */
+bool MAIN_flow_task_is_current(void);
+
+/**
+ * @brief Take the flow lock (recursive)
+ * @param timeoutMs 0 = try only, FLOW_LOCK_FOREVER = wait
+ * @return true if held (always true without the worker)
+ */
+bool MAIN_flow_lock(uint32_t timeoutMs);
+
+/**
+ * @brief Release the flow lock
+ */
+void MAIN_flow_unlock(void);
+
+/**
+ * @brief Stop or restart flow ticks
+ * @param paused true: eez_flow_tick returns at once until cleared
+ * @note Any task. A tick already running finishes.
+ */
+void MAIN_flow_set_paused(bool paused);
+
+/**
+ * @brief Check if flow ticks are paused
+ * @return true while paused
+ */
+bool MAIN_flow_is_paused(void);
+
+/**
+ * @brief Queue a call for the UI task
+ * @param fn Function run on Core 0 before lv_timer_handler
+ * @param ctx Passed to fn
+ * @param param Passed to fn
+ * @return true if queued, false if the queue is full
+ * @note Lock free, any task.
+ */
+bool MAIN_flow_post_ui(MAIN_flow_ui_command_fn_t fn, void *ctx, uint32_t param);
+
+/**
+ * @brief Run queued UI commands (UI task only)
+ * @param maxCommands Upper bound for this call
+ * @return uint16_t Commands run
+ */
+uint16_t MAIN_flow_apply_ui_commands(uint16_t maxCommands);
+
+/**
+ * @brief Task woken when a command is posted
+ * @param task UI task handle
+ */
+void MAIN_flow_task_set_ui_task(TaskHandle_t task);
+
+/**
+ * @brief Worker counters
+ * @param stats Receives the counters
+ */
+void MAIN_flow_task_get_stats(MAIN_flow_task_stats_t *stats);
+
+/**
+ * @brief Note a UI try-lock that found the flow busy
+ */
+void MAIN_flow_task_note_lock_miss(void);
+
+#endif // __MAIN_FLOW_TASK_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_flowTaskLib.h
+ ******************************************************************************/
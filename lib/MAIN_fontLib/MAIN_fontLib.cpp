@@ -0,0 +1,234 @@
+/**
+ * @file MAIN_fontLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Montserrat font lookup with on-demand loading of the large sizes
+ * @version 1.1.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_fontLib.h"
+#include "EARS_systemDef.h"
+#include "MAIN_assetPackLib.h"
+#include "MAIN_glyphCacheLib.h"
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint8_t size;              // Pixel size
+    const lv_font_t *compiled; // Compiled font, NULL = on demand
+} font_size_t;
+
+typedef struct
+{
+    uint8_t size;     // Pixel size (0 = free)
+    lv_font_t *font;  // Loaded font, NULL after a failed load
+} font_loaded_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+#if EARS_FONT_SUBSETS == 1
+static const font_size_t font_sizes[] = {
+    {8, &ears_font_montserrat_8},
+    {10, &ears_font_montserrat_10},
+    {12, &ears_font_montserrat_12},
+    {14, &ears_font_montserrat_14},
+    {16, &ears_font_montserrat_16},
+    {20, &ears_font_montserrat_20},
+    {24, &ears_font_montserrat_24},
+    {34, NULL},
+    {38, NULL},
+};
+#else
+static const font_size_t font_sizes[] = {
+    {8, &lv_font_montserrat_8},
+    {10, &lv_font_montserrat_10},
+    {12, &lv_font_montserrat_12},
+    {14, &lv_font_montserrat_14},
+    {16, &lv_font_montserrat_16},
+    {20, &lv_font_montserrat_20},
+    {24, &lv_font_montserrat_24},
+    {34, &lv_font_montserrat_34},
+    {38, &lv_font_montserrat_38},
+};
+#endif
+
+#define FONT_SIZE_COUNT (sizeof(font_sizes) / sizeof(font_sizes[0]))
+
+static font_loaded_t font_loaded[FONT_ON_DEMAND_MAX];
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Load an on-demand size, asset pack first, then SD card
+ * @param size Pixel size
+ * @return lv_font_t* Font, or NULL
+ */
+static lv_font_t *font_load(uint8_t size)
+{
+    char name[24];
+    snprintf(name, sizeof(name), "montserrat_%u", size);
+
+    lv_font_t *font = MAIN_asset_pack_font(name);
+    if (font == NULL)
+    {
+        char path[40];
+        snprintf(path, sizeof(path), FONT_SD_DIR "/%s.bin", name);
+        font = lv_binfont_create(path);
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[FONT] %s %s\n", name, (font != NULL) ? "loaded" : "not found, using a smaller size");
+#endif
+
+    return font;
+}
+
+/**
+ * @brief Nearest smaller compiled font
+ * @param size Pixel size
+ * @return const lv_font_t* Font
+ */
+static const lv_font_t *font_fallback(uint8_t size)
+{
+    const lv_font_t *best = LV_FONT_DEFAULT;
+    for (uint8_t i = 0; i < FONT_SIZE_COUNT; i++)
+    {
+        if (font_sizes[i].compiled != NULL && font_sizes[i].size <= size)
+        {
+            best = font_sizes[i].compiled;
+        }
+    }
+    return best;
+}
+
+/******************************************************************************
+ * Fonts
+ *****************************************************************************/
+
+/**
+ * @brief Montserrat font of a pixel size
+ * @param size Pixel size
+ * @return const lv_font_t* Font
+ */
+const lv_font_t *MAIN_font_get(uint8_t size)
+{
+    for (uint8_t i = 0; i < FONT_SIZE_COUNT; i++)
+    {
+        if (font_sizes[i].size == size && font_sizes[i].compiled != NULL)
+        {
+            return (size >= FONT_GLYPH_CACHE_MIN_SIZE) ? MAIN_glyph_cache_font(font_sizes[i].compiled)
+                                                       : font_sizes[i].compiled;
+        }
+    }
+
+    if (!MAIN_font_is_on_demand(size))
+    {
+        return font_fallback(size);
+    }
+
+    // A failed load is remembered too, so a missing file is not retried per label
+    font_loaded_t *slot = NULL;
+    for (uint8_t i = 0; i < FONT_ON_DEMAND_MAX; i++)
+    {
+        if (font_loaded[i].size == size)
+        {
+            return (font_loaded[i].font != NULL) ? MAIN_glyph_cache_font(font_loaded[i].font) : font_fallback(size);
+        }
+        if (slot == NULL && font_loaded[i].size == 0)
+        {
+            slot = &font_loaded[i];
+        }
+    }
+
+    lv_font_t *font = font_load(size);
+    if (slot != NULL)
+    {
+        slot->size = size;
+        slot->font = font;
+    }
+    else if (font != NULL)
+    {
+        lv_binfont_destroy(font);
+        font = NULL;
+    }
+
+    return (font != NULL) ? MAIN_glyph_cache_font(font) : font_fallback(size);
+}
+
+/**
+ * @brief Check if a size is served on demand
+ * @param size Pixel size
+ * @return true if the size is loaded from the asset pack or SD card
+ */
+bool MAIN_font_is_on_demand(uint8_t size)
+{
+    for (uint8_t i = 0; i < FONT_SIZE_COUNT; i++)
+    {
+        if (font_sizes[i].size == size)
+        {
+            return font_sizes[i].compiled == NULL;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Free every on-demand font
+ */
+void MAIN_font_release_on_demand(void)
+{
+    for (uint8_t i = 0; i < FONT_ON_DEMAND_MAX; i++)
+    {
+        if (font_loaded[i].font != NULL)
+        {
+            MAIN_glyph_cache_drop(font_loaded[i].font);
+            lv_binfont_destroy(font_loaded[i].font);
+        }
+        font_loaded[i].size = 0;
+        font_loaded[i].font = NULL;
+    }
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Font_getLibraryName() {
+    return MAIN_Font::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Font_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Font::VERSION_MAJOR,
+                       MAIN_Font::VERSION_MINOR,
+                       MAIN_Font::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Font_getVersionDate() {
+    return MAIN_Font::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Font_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Font_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_fontLib.cpp
+ ******************************************************************************/
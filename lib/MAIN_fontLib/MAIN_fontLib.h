@@ -0,0 +1,93 @@
+/**
+ * @file MAIN_fontLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Montserrat font lookup with on-demand loading of the large sizes
+ * @details With -D EARS_FONT_SUBSETS=1 the fonts compiled in are the glyph
+ *          subsets from scripts/generate_font_subsets.py, and the rarely used
+ *          34 and 38 px sizes are not compiled in at all. They are loaded as
+ *          lv_binfont files the first time they are asked for, from the asset
+ *          partition (MAIN_assetPackLib) or else the SD card /fonts, and kept
+ *          until released. Without subsets the built-in fonts are returned.
+ *
+ *          Loaded fonts live in the LVGL heap, so the on-demand subsets must
+ *          stay small (digits and the few characters actually drawn).
+ *          Sizes from FONT_GLYPH_CACHE_MIN_SIZE up are returned wrapped by
+ *          MAIN_glyphCacheLib, so their glyphs are expanded only once.
+ * @version 1.1.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_FONT_LIB_H__
+#define __MAIN_FONT_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include <lvgl.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Font
+{
+    constexpr const char* LIB_NAME = "MAIN_Font";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "1";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-14";
+}
+
+
+// Version information getters
+const char* MAIN_Font_getLibraryName();
+uint32_t MAIN_Font_getVersionEncoded();
+const char* MAIN_Font_getVersionDate();
+void MAIN_Font_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Font Configuration
+ *****************************************************************************/
+
+// On-demand files: asset pack entry "montserrat_NN", or this SD directory
+#define FONT_SD_DIR "S:/fonts"
+#define FONT_ON_DEMAND_MAX 4
+
+// Sizes drawn through MAIN_glyphCacheLib (big readouts that change often)
+#define FONT_GLYPH_CACHE_MIN_SIZE 34
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Montserrat font of a pixel size
+ * @param size 8, 10, 12, 14, 16, 20, 24, 34 or 38
+ * @return const lv_font_t* Font, the nearest smaller compiled size if an
+ *         on-demand size cannot be loaded, or LV_FONT_DEFAULT
+ * @note On-demand sizes are loaded on the first call; LVGL task only.
+ */
+const lv_font_t *MAIN_font_get(uint8_t size);
+
+/**
+ * @brief Check if a size is served on demand
+ * @param size Pixel size
+ * @return true if the size is loaded from the asset pack or SD card
+ */
+bool MAIN_font_is_on_demand(uint8_t size);
+
+/**
+ * @brief Free every on-demand font
+ * @note No widget may still use one.
+ */
+void MAIN_font_release_on_demand(void);
+
+#endif // __MAIN_FONT_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_fontLib.h
+ ******************************************************************************/
@@ -0,0 +1,364 @@
+/**
+ * @file MAIN_glyphCacheLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Rendered glyph cache in PSRAM for the large fonts
+ * @version 1.1.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_glyphCacheLib.h"
+#include "EARS_systemDef.h"
+#include "MAIN_sysinfoLib.h"
+#include "MAIN_memPlanLib.h"
+#include <esp_heap_caps.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef const void *(*glyph_bitmap_cb_t)(lv_font_glyph_dsc_t *, lv_draw_buf_t *);
+
+typedef struct
+{
+    lv_font_t font;                     // Wrapper handed to LVGL, must be first
+    const lv_font_t *base;              // Original font (NULL = free)
+    glyph_bitmap_cb_t baseBitmap;       // Original get_glyph_bitmap
+} glyph_cache_font_t;
+
+typedef struct
+{
+    const lv_font_t *font; // Wrapper the mask belongs to (NULL = free)
+    uint32_t glyph;        // Glyph index in the font
+    uint32_t lastUse;      // Draw counter at last hit, for eviction
+    lv_draw_buf_t buf;     // A8 mask, data in PSRAM
+} glyph_cache_entry_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static glyph_cache_entry_t *glyph_cache_entries = NULL;
+static glyph_cache_font_t glyph_cache_fonts[GLYPH_CACHE_MAX_FONTS];
+static MAIN_glyph_cache_stats_t glyph_cache_stats;
+static uint32_t glyph_cache_clock = 0;
+
+#if LV_USE_OS != LV_OS_NONE
+// Draw units on both cores look glyphs up at the same time
+static lv_mutex_t glyph_cache_mutex;
+#define GLYPH_CACHE_LOCK() lv_mutex_lock(&glyph_cache_mutex)
+#define GLYPH_CACHE_UNLOCK() lv_mutex_unlock(&glyph_cache_mutex)
+#else
+#define GLYPH_CACHE_LOCK()
+#define GLYPH_CACHE_UNLOCK()
+#endif
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Free one entry's mask
+ * @param entry Cache slot
+ */
+static void glyph_cache_free_entry(glyph_cache_entry_t *entry)
+{
+    if (entry->font == NULL)
+    {
+        return;
+    }
+
+    glyph_cache_stats.bytes -= entry->buf.data_size;
+    glyph_cache_stats.entries--;
+    MAIN_mem_free(entry->buf.data);
+    memset(entry, 0, sizeof(glyph_cache_entry_t));
+}
+
+/**
+ * @brief Copy a freshly expanded mask into a slot
+ * @param entry Free slot
+ * @param font Wrapper font
+ * @param glyph Glyph index
+ * @param src Mask LVGL just expanded
+ * @return true if stored
+ */
+static bool glyph_cache_store(glyph_cache_entry_t *entry, const lv_font_t *font, uint32_t glyph,
+                              const lv_draw_buf_t *src)
+{
+    uint32_t w = src->header.w;
+    uint32_t h = src->header.h;
+    uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_A8);
+    uint32_t size = stride * h;
+
+    if (glyph_cache_stats.bytes + size > GLYPH_CACHE_BYTES)
+    {
+        return false;
+    }
+
+    uint8_t *data = (uint8_t *)MAIN_mem_alloc(MEM_POOL_GLYPH_CACHE, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (data == NULL)
+    {
+        return false;
+    }
+
+    for (uint32_t y = 0; y < h; y++)
+    {
+        memcpy(data + y * stride, src->data + y * src->header.stride, w);
+    }
+
+    lv_draw_buf_init(&entry->buf, w, h, LV_COLOR_FORMAT_A8, stride, data, size);
+    entry->font = font;
+    entry->glyph = glyph;
+    entry->lastUse = glyph_cache_clock;
+
+    glyph_cache_stats.bytes += size;
+    glyph_cache_stats.entries++;
+    return true;
+}
+
+#if LV_USE_OS != LV_OS_NONE
+/**
+ * @brief Copy a cached mask into the draw unit's own buffer
+ * @details Another draw unit may evict the entry while this one blends it.
+ * @param src Cached mask
+ * @param draw_buf LVGL's scratch buffer, already shaped for the glyph
+ * @return const void* draw_buf
+ */
+static const void *glyph_cache_copy_out(const lv_draw_buf_t *src, lv_draw_buf_t *draw_buf)
+{
+    for (uint32_t y = 0; y < src->header.h; y++)
+    {
+        memcpy(draw_buf->data + y * draw_buf->header.stride, src->data + y * src->header.stride, src->header.w);
+    }
+    return draw_buf;
+}
+#endif
+
+/**
+ * @brief get_glyph_bitmap hook of every wrapped font
+ * @param g_dsc Glyph being drawn (resolved_font is the wrapper)
+ * @param draw_buf LVGL's scratch buffer for the expanded mask
+ * @return const void* Cached mask, or whatever the original returned
+ */
+static const void *glyph_cache_get_bitmap(lv_font_glyph_dsc_t *g_dsc, lv_draw_buf_t *draw_buf)
+{
+    const glyph_cache_font_t *wrapper = (const glyph_cache_font_t *)g_dsc->resolved_font;
+    uint32_t glyph = g_dsc->gid.index;
+
+    // Raw and non-A8 requests are not ours to cache
+    if (g_dsc->req_raw_bitmap || draw_buf == NULL || g_dsc->format >= LV_FONT_GLYPH_FORMAT_IMAGE)
+    {
+        return wrapper->baseBitmap(g_dsc, draw_buf);
+    }
+
+    GLYPH_CACHE_LOCK();
+    glyph_cache_clock++;
+    uint32_t hash = (((uint32_t)(uintptr_t)wrapper >> 4) ^ (glyph * 2654435761u)) & (GLYPH_CACHE_ENTRIES - 1);
+    glyph_cache_entry_t *slot = NULL;
+
+    for (uint8_t i = 0; i < GLYPH_CACHE_PROBE; i++)
+    {
+        glyph_cache_entry_t *entry = &glyph_cache_entries[(hash + i) & (GLYPH_CACHE_ENTRIES - 1)];
+        if (entry->font == &wrapper->font && entry->glyph == glyph)
+        {
+            entry->lastUse = glyph_cache_clock;
+            glyph_cache_stats.hits++;
+#if LV_USE_OS != LV_OS_NONE
+            const void *bitmap = glyph_cache_copy_out(&entry->buf, draw_buf);
+#else
+            const void *bitmap = &entry->buf;
+#endif
+            GLYPH_CACHE_UNLOCK();
+            return bitmap;
+        }
+        if (slot == NULL || (slot->font != NULL && (entry->font == NULL || entry->lastUse < slot->lastUse)))
+        {
+            slot = entry;
+        }
+    }
+
+    glyph_cache_stats.misses++;
+    const lv_draw_buf_t *expanded = (const lv_draw_buf_t *)wrapper->baseBitmap(g_dsc, draw_buf);
+    if (expanded == NULL)
+    {
+        GLYPH_CACHE_UNLOCK();
+        return NULL;
+    }
+
+    if (slot->font != NULL)
+    {
+        glyph_cache_free_entry(slot);
+        glyph_cache_stats.evictions++;
+    }
+    glyph_cache_store(slot, &wrapper->font, glyph, expanded);
+    GLYPH_CACHE_UNLOCK();
+    return expanded;
+}
+
+/******************************************************************************
+ * Glyph Cache
+ *****************************************************************************/
+
+/**
+ * @brief Allocate the cache in PSRAM
+ * @return true if enabled
+ */
+bool MAIN_initialise_glyph_cache(void)
+{
+    if (glyph_cache_entries != NULL)
+    {
+        return true;
+    }
+
+    if (!MAIN_sysinfo_has_psram())
+    {
+#if EARS_DEBUG == 1
+        Serial.println("[GLYPHCACHE] No PSRAM, glyph cache disabled");
+#endif
+        return false;
+    }
+
+    glyph_cache_entries = (glyph_cache_entry_t *)heap_caps_calloc(
+        GLYPH_CACHE_ENTRIES, sizeof(glyph_cache_entry_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (glyph_cache_entries == NULL)
+    {
+        return false;
+    }
+
+    memset(glyph_cache_fonts, 0, sizeof(glyph_cache_fonts));
+    memset(&glyph_cache_stats, 0, sizeof(glyph_cache_stats));
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_init(&glyph_cache_mutex);
+#endif
+
+#if EARS_DEBUG == 1
+    Serial.printf("[GLYPHCACHE] %d glyphs, %lu KB mask budget in PSRAM\n", GLYPH_CACHE_ENTRIES,
+                  (unsigned long)(GLYPH_CACHE_BYTES / 1024));
+#endif
+
+    return true;
+}
+
+/**
+ * @brief Cached version of a font
+ * @param font Bitmap font
+ * @return const lv_font_t* Wrapper, or font itself
+ */
+const lv_font_t *MAIN_glyph_cache_font(const lv_font_t *font)
+{
+    if (glyph_cache_entries == NULL || font == NULL || font->get_glyph_bitmap == glyph_cache_get_bitmap)
+    {
+        return font;
+    }
+
+    glyph_cache_font_t *unused = NULL;
+    for (uint8_t i = 0; i < GLYPH_CACHE_MAX_FONTS; i++)
+    {
+        if (glyph_cache_fonts[i].base == font)
+        {
+            return &glyph_cache_fonts[i].font;
+        }
+        if (unused == NULL && glyph_cache_fonts[i].base == NULL)
+        {
+            unused = &glyph_cache_fonts[i];
+        }
+    }
+
+    if (unused == NULL)
+    {
+        Serial.println("[GLYPHCACHE] Warning: Font table full, font not cached");
+        return font;
+    }
+
+    // fmt_txt callbacks reach their data through resolved_font->dsc, which the copy shares
+    unused->font = *font;
+    unused->font.get_glyph_bitmap = glyph_cache_get_bitmap;
+    unused->base = font;
+    unused->baseBitmap = font->get_glyph_bitmap;
+    return &unused->font;
+}
+
+/**
+ * @brief Drop every cached glyph of a font
+ * @param font Original or wrapped font (NULL = all)
+ */
+void MAIN_glyph_cache_drop(const lv_font_t *font)
+{
+    if (glyph_cache_entries == NULL)
+    {
+        return;
+    }
+
+    const lv_font_t *wrapper = NULL;
+    for (uint8_t i = 0; font != NULL && i < GLYPH_CACHE_MAX_FONTS; i++)
+    {
+        if (glyph_cache_fonts[i].base == font || &glyph_cache_fonts[i].font == font)
+        {
+            wrapper = &glyph_cache_fonts[i].font;
+            glyph_cache_fonts[i].base = NULL;
+        }
+    }
+
+    if (font != NULL && wrapper == NULL)
+    {
+        return;
+    }
+
+    GLYPH_CACHE_LOCK();
+    for (uint16_t i = 0; i < GLYPH_CACHE_ENTRIES; i++)
+    {
+        if (font == NULL || glyph_cache_entries[i].font == wrapper)
+        {
+            glyph_cache_free_entry(&glyph_cache_entries[i]);
+        }
+    }
+    GLYPH_CACHE_UNLOCK();
+}
+
+/**
+ * @brief Cache counters
+ * @param stats Receives the counters
+ */
+void MAIN_glyph_cache_get_stats(MAIN_glyph_cache_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = glyph_cache_stats;
+    }
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_GlyphCache_getLibraryName() {
+    return MAIN_GlyphCache::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_GlyphCache_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_GlyphCache::VERSION_MAJOR,
+                       MAIN_GlyphCache::VERSION_MINOR,
+                       MAIN_GlyphCache::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_GlyphCache_getVersionDate() {
+    return MAIN_GlyphCache::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_GlyphCache_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_GlyphCache_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_glyphCacheLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,117 @@
+/**
+ * @file MAIN_glyphCacheLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Rendered glyph cache in PSRAM for the large fonts
+ * @details LVGL expands a 4 bpp glyph into an A8 mask every time it is drawn,
+ *          which for the 34/38 px readouts is most of the cost of a label
+ *          update. A cached font is a RAM copy of the original whose
+ *          get_glyph_bitmap hook returns a ready-made A8 draw buffer from
+ *          PSRAM, expanded once on the first draw of each glyph.
+ *
+ *          The cache holds masks, not coloured pixels: the text colour is
+ *          applied when the mask is blended, so one raster serves every
+ *          colour and the key is just font and glyph.
+ *
+ *          With LVGL's OS layer on (EARS_LVGL_OS=1) the table is locked and
+ *          hits are copied into the draw unit's buffer, as two draw units
+ *          can render glyphs at once.
+ * @version 1.1.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_GLYPH_CACHE_LIB_H__
+#define __MAIN_GLYPH_CACHE_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include <lvgl.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_GlyphCache
+{
+    constexpr const char* LIB_NAME = "MAIN_GlyphCache";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "1";
+    constexpr const char* VERSION_PATCH = "1";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_GlyphCache_getLibraryName();
+uint32_t MAIN_GlyphCache_getVersionEncoded();
+const char* MAIN_GlyphCache_getVersionDate();
+void MAIN_GlyphCache_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Glyph Cache Configuration
+ *****************************************************************************/
+
+// Glyph slots (power of two) and the PSRAM budget for their masks
+#define GLYPH_CACHE_ENTRIES 256
+#define GLYPH_CACHE_BYTES (256 * 1024U)
+
+// Slots searched per lookup before the oldest is evicted
+#define GLYPH_CACHE_PROBE 8
+
+// Fonts that can be wrapped
+#define GLYPH_CACHE_MAX_FONTS 4
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t hits;      // Draws served from the cache
+    uint32_t misses;    // Glyphs expanded by the font
+    uint32_t evictions; // Masks dropped to make room
+    uint32_t bytes;     // PSRAM held by masks
+    uint16_t entries;   // Glyphs cached
+} MAIN_glyph_cache_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Allocate the cache in PSRAM
+ * @return true if enabled (false without PSRAM)
+ */
+bool MAIN_initialise_glyph_cache(void);
+
+/**
+ * @brief Cached version of a font
+ * @param font Bitmap font (built-in, subset or lv_binfont)
+ * @return const lv_font_t* Font to use for drawing, or font itself if the
+ *         cache is disabled or full
+ * @note The same font always returns the same wrapper.
+ */
+const lv_font_t *MAIN_glyph_cache_font(const lv_font_t *font);
+
+/**
+ * @brief Drop every cached glyph of a font (NULL drops all)
+ * @param font Original or wrapped font
+ * @note Call before freeing an lv_binfont that was wrapped.
+ */
+void MAIN_glyph_cache_drop(const lv_font_t *font);
+
+/**
+ * @brief Cache counters
+ * @param stats Receives the counters
+ */
+void MAIN_glyph_cache_get_stats(MAIN_glyph_cache_stats_t *stats);
+
+#endif // __MAIN_GLYPH_CACHE_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_glyphCacheLib.h
+ ******************************************************************************/
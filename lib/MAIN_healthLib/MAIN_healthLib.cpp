@@ -0,0 +1,639 @@
+/**
+ * @file MAIN_healthLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Task health monitor on the task watchdog, with stall diagnostics
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_healthLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_sdCardLib.h"
+#include <esp_attr.h>
+#include <esp_ipc.h>
+#include <esp_rom_crc.h>
+#include <esp_system.h>
+#include <esp_task_wdt.h>
+
+// Backtrace of a task that is not running (Xtensa windowed ABI only)
+#if defined(__XTENSA__)
+#define HEALTH_BACKTRACE 1
+#include <esp_cpu.h>
+#include <esp_debug_helpers.h>
+#if __has_include(<esp_memory_utils.h>)
+#include <esp_memory_utils.h>
+#else
+#include <soc/soc_memory_layout.h>
+#endif
+#if __has_include(<freertos/xtensa_context.h>)
+#include <freertos/xtensa_context.h>
+#else
+#include <xtensa_context.h>
+#endif
+#else
+#define HEALTH_BACKTRACE 0
+#endif
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+#define HEALTH_MAGIC 0x48544C48UL       // "HLTH"
+#define HEALTH_STALL_MAGIC 0x4C415453UL // "STAL"
+
+// Kept in RTC memory across panic and watchdog resets
+typedef struct
+{
+    uint32_t magic;
+    uint16_t head;       // Next event slot
+    uint16_t count;      // Events held
+    MAIN_health_event_t events[HEALTH_EVENT_COUNT];
+    uint32_t stallMagic; // HEALTH_STALL_MAGIC while stall holds a record
+    MAIN_health_stall_t stall;
+    uint32_t crc;        // Over everything above
+} health_rtc_t;
+
+typedef struct
+{
+    TaskHandle_t handle;
+    MAIN_health_phase_fn_t phaseFn;
+    const char *volatile phase;
+    volatile uint32_t lastBeatMs;
+    MAIN_health_task_stats_t stats;
+} health_task_t;
+
+typedef struct
+{
+    TaskHandle_t handle;
+    MAIN_health_stall_t *stall;
+} health_capture_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+// Left alone by the bootloader and by panic/watchdog resets, garbage after power-on
+RTC_NOINIT_ATTR static health_rtc_t health_rtc;
+
+static health_task_t health_tasks[HEALTH_TASK_MAX];
+static uint8_t health_task_count = 0;
+static MAIN_health_report_t health_previous; // Left by the last boot
+static TaskHandle_t health_monitor_handle = NULL;
+static portMUX_TYPE health_mux = portMUX_INITIALIZER_UNLOCKED;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Checksum of the RTC record
+ * @return uint32_t CRC32 of everything before the crc field
+ */
+static uint32_t health_rtc_crc(void)
+{
+    return esp_rom_crc32_le(0, (const uint8_t *)&health_rtc, offsetof(health_rtc_t, crc));
+}
+
+/**
+ * @brief Copy text into a fixed field, always terminated
+ * @param out Field
+ * @param size Field size
+ * @param text Text (NULL = empty)
+ */
+static void health_copy(char *out, size_t size, const char *text)
+{
+    strncpy(out, (text != NULL) ? text : "", size - 1);
+    out[size - 1] = '\0';
+}
+
+/**
+ * @brief Add a breadcrumb "<kind> <task>"
+ * @param kind What happened
+ * @param task Task it happened to
+ * @param value Milliseconds involved
+ */
+static void health_note_task(const char *kind, const health_task_t *task, uint32_t value)
+{
+    char tag[HEALTH_TAG_SIZE];
+    snprintf(tag, sizeof(tag), "%s %s", kind, task->stats.name);
+    MAIN_health_note(tag, value);
+}
+
+/**
+ * @brief Store a stall record in RTC memory
+ * @param stall Record (replaces any earlier one)
+ */
+static void health_store_stall(const MAIN_health_stall_t *stall)
+{
+    taskENTER_CRITICAL(&health_mux);
+    health_rtc.stall = *stall;
+    health_rtc.stallMagic = HEALTH_STALL_MAGIC;
+    health_rtc.crc = health_rtc_crc();
+    taskEXIT_CRITICAL(&health_mux);
+}
+
+#if HEALTH_BACKTRACE
+/**
+ * @brief Walk the saved stack of a task that is not running (IPC call)
+ * @details Runs on the stalled task's core at IPC priority, so the task is
+ *          switched out and its registers are in the frame at the top of its
+ *          stack: a solicited frame if it yielded, an exception frame if it
+ *          was interrupted.
+ * @param arg health_capture_t
+ */
+static void health_capture_backtrace(void *arg)
+{
+    health_capture_t *capture = (health_capture_t *)arg;
+    MAIN_health_stall_t *stall = capture->stall;
+
+    // pxTopOfStack is the first member of the task control block
+    const void *top = *(void *const *)capture->handle;
+    if (!esp_stack_ptr_is_sane((uint32_t)top))
+    {
+        return;
+    }
+
+    esp_backtrace_frame_t frame;
+    const XtExcFrame *exc = (const XtExcFrame *)top;
+    if (exc->exit == 0)
+    {
+        const XtSolFrame *sol = (const XtSolFrame *)top;
+        frame.pc = sol->pc;
+        frame.sp = sol->a1;
+        frame.next_pc = sol->a0;
+    }
+    else
+    {
+        frame.pc = exc->pc;
+        frame.sp = exc->a1;
+        frame.next_pc = exc->a0;
+    }
+    frame.exc_frame = NULL;
+
+    bool sane = esp_stack_ptr_is_sane(frame.sp) &&
+                esp_ptr_executable((void *)esp_cpu_process_stack_pc(frame.pc));
+    while (sane && stall->depth < HEALTH_BACKTRACE_DEPTH)
+    {
+        stall->pc[stall->depth] = esp_cpu_process_stack_pc(frame.pc);
+        stall->sp[stall->depth] = frame.sp;
+        stall->depth++;
+        if (frame.next_pc == 0)
+        {
+            break;
+        }
+        sane = esp_backtrace_get_next_frame(&frame);
+    }
+}
+#endif
+
+/**
+ * @brief Record a task that missed its deadline
+ * @details The record is stored before the backtrace is taken, so a task
+ *          stuck with interrupts off (the IPC call never returns, and the
+ *          watchdog fires on the monitor) still leaves its name and phase.
+ * @param task Stalled task
+ * @param silentMs Time since its last beat
+ */
+static void health_capture(health_task_t *task, uint32_t silentMs)
+{
+    MAIN_health_stall_t stall;
+    memset(&stall, 0, sizeof(stall));
+    health_copy(stall.task, sizeof(stall.task), task->stats.name);
+    health_copy(stall.phase, sizeof(stall.phase), (task->phaseFn != NULL) ? task->phaseFn() : task->phase);
+    stall.uptimeMs = millis();
+    stall.silentMs = silentMs;
+
+    // A pinned task is sampled from its own core; an unpinned one cannot be
+    // running on this core, so the other core is the only place it can be
+    BaseType_t core = xTaskGetAffinity(task->handle);
+    if (core == tskNO_AFFINITY)
+    {
+        core = !xPortGetCoreID();
+    }
+    stall.core = (uint8_t)core;
+
+    health_note_task("stall", task, silentMs);
+    health_store_stall(&stall);
+
+#if HEALTH_BACKTRACE
+    health_capture_t capture = {task->handle, &stall};
+    if (esp_ipc_call_blocking(core, health_capture_backtrace, &capture) == ESP_OK)
+    {
+        health_store_stall(&stall);
+    }
+#endif
+
+    Serial.printf("[HEALTH] Warning: %s silent for %lu ms in '%s'\n", stall.task, (unsigned long)silentMs,
+                  stall.phase);
+}
+
+/**
+ * @brief Monitor task: check every deadline, capture stalls
+ * @param parameter Unused
+ */
+static void health_monitor_task(void *parameter)
+{
+    // The monitor is watched too: if it is starved, nothing else is checked
+    esp_task_wdt_add(NULL);
+    TickType_t lastWake = xTaskGetTickCount();
+
+    while (1)
+    {
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(HEALTH_CHECK_PERIOD_MS));
+        esp_task_wdt_reset();
+
+        uint32_t now = millis();
+        for (uint8_t i = 0; i < health_task_count; i++)
+        {
+            health_task_t *task = &health_tasks[i];
+            uint32_t silentMs = now - task->lastBeatMs;
+            if (silentMs <= task->stats.deadlineMs)
+            {
+                continue;
+            }
+
+            // Once per stall; the next beat clears it
+            taskENTER_CRITICAL(&health_mux);
+            bool first = !task->stats.stalled;
+            if (first)
+            {
+                task->stats.stalled = true;
+                task->stats.stalls++;
+            }
+            taskEXIT_CRITICAL(&health_mux);
+
+            if (first)
+            {
+                health_capture(task, silentMs);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Copy the RTC record into health_previous and start this boot's
+ * @param resetReason esp_reset_reason()
+ */
+static void health_take_previous(int resetReason)
+{
+    memset(&health_previous, 0, sizeof(health_previous));
+    health_previous.resetReason = resetReason;
+
+    bool valid = resetReason != ESP_RST_POWERON && health_rtc.magic == HEALTH_MAGIC &&
+                 health_rtc.count <= HEALTH_EVENT_COUNT && health_rtc.head < HEALTH_EVENT_COUNT &&
+                 health_rtc.crc == health_rtc_crc();
+    if (!valid)
+    {
+        memset(&health_rtc, 0, sizeof(health_rtc));
+        health_rtc.magic = HEALTH_MAGIC;
+        health_rtc.crc = health_rtc_crc();
+        return;
+    }
+
+    if (health_rtc.stallMagic == HEALTH_STALL_MAGIC)
+    {
+        health_previous.stalled = true;
+        health_previous.stall = health_rtc.stall;
+        health_previous.stall.task[sizeof(health_previous.stall.task) - 1] = '\0';
+        health_previous.stall.phase[sizeof(health_previous.stall.phase) - 1] = '\0';
+        if (health_previous.stall.depth > HEALTH_BACKTRACE_DEPTH)
+        {
+            health_previous.stall.depth = HEALTH_BACKTRACE_DEPTH;
+        }
+    }
+
+    uint16_t first = (health_rtc.head + HEALTH_EVENT_COUNT - health_rtc.count) % HEALTH_EVENT_COUNT;
+    for (uint16_t i = 0; i < health_rtc.count; i++)
+    {
+        MAIN_health_event_t *event = &health_previous.events[i];
+        *event = health_rtc.events[(first + i) % HEALTH_EVENT_COUNT];
+        event->tag[HEALTH_TAG_SIZE - 1] = '\0';
+    }
+    health_previous.eventCount = (uint8_t)health_rtc.count;
+
+    // Breadcrumbs carry on across the boot; the stall is reported once
+    health_rtc.stallMagic = 0;
+    health_rtc.crc = health_rtc_crc();
+}
+
+/**
+ * @brief Print the previous boot's stall and breadcrumbs, and append them to
+ *        HEALTH_LOG_FILE
+ */
+static void health_report_previous(void)
+{
+    const MAIN_health_report_t *report = &health_previous;
+    char line[160];
+    int length;
+    bool toCard = using_sdcard().isAvailable();
+
+    if (toCard && !using_sdcard().directoryExists("/logs"))
+    {
+        using_sdcard().createDirectory("/logs");
+    }
+
+    length = snprintf(line, sizeof(line), "--- boot after reset reason %d ---\n", report->resetReason);
+    Serial.printf("[HEALTH] Warning: Previous boot ended in reset reason %d\n", report->resetReason);
+    if (toCard)
+    {
+        toCard = using_sdcard().appendData(HEALTH_LOG_FILE, (const uint8_t *)line, length);
+    }
+
+    if (report->stalled)
+    {
+        const MAIN_health_stall_t *stall = &report->stall;
+        length = snprintf(line, sizeof(line), "stall %s phase '%s' silent %lu ms at %lu ms (core %u)\n", stall->task,
+                          stall->phase, (unsigned long)stall->silentMs, (unsigned long)stall->uptimeMs, stall->core);
+        Serial.printf("[HEALTH] %s", line);
+        if (toCard)
+        {
+            toCard = using_sdcard().appendData(HEALTH_LOG_FILE, (const uint8_t *)line, length);
+        }
+
+        // Same form as a panic backtrace, so the monitor filter decodes it
+        length = (stall->depth > 0) ? snprintf(line, sizeof(line), "Backtrace:") : 0;
+        for (uint8_t i = 0; i < stall->depth; i++)
+        {
+            if (length > (int)sizeof(line) - 24)
+            {
+                Serial.print(line);
+                if (toCard)
+                {
+                    toCard = using_sdcard().appendData(HEALTH_LOG_FILE, (const uint8_t *)line, length);
+                }
+                length = 0;
+            }
+            length += snprintf(line + length, sizeof(line) - length, " 0x%08lx:0x%08lx", (unsigned long)stall->pc[i],
+                               (unsigned long)stall->sp[i]);
+        }
+        if (length > 0)
+        {
+            length += snprintf(line + length, sizeof(line) - length, "\n");
+            Serial.print(line);
+            if (toCard)
+            {
+                toCard = using_sdcard().appendData(HEALTH_LOG_FILE, (const uint8_t *)line, length);
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < report->eventCount; i++)
+    {
+        const MAIN_health_event_t *event = &report->events[i];
+        length = snprintf(line, sizeof(line), "%10lu ms  %-23s %lu\n", (unsigned long)event->uptimeMs, event->tag,
+                          (unsigned long)event->value);
+        Serial.printf("[HEALTH] %s", line);
+        if (toCard)
+        {
+            toCard = using_sdcard().appendData(HEALTH_LOG_FILE, (const uint8_t *)line, length);
+        }
+    }
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Read the previous boot's record, set the watchdog timeout and start
+ *        the monitor
+ */
+bool MAIN_initialise_health(void)
+{
+    int resetReason = (int)esp_reset_reason();
+    health_take_previous(resetReason);
+
+    bool abnormal = resetReason == ESP_RST_TASK_WDT || resetReason == ESP_RST_INT_WDT ||
+                    resetReason == ESP_RST_WDT || resetReason == ESP_RST_PANIC;
+    if (health_previous.stalled || abnormal)
+    {
+        health_report_previous();
+    }
+    MAIN_health_note("boot", (uint32_t)resetReason);
+
+    // Already running from startup (idle task watch); this only sets timeout and panic
+    if (esp_task_wdt_init(HEALTH_TWDT_TIMEOUT_S, true) != ESP_OK)
+    {
+        Serial.println("[HEALTH] Warning: Task watchdog not configured");
+    }
+
+    if (health_monitor_handle == NULL)
+    {
+        BaseType_t result = xTaskCreatePinnedToCore(health_monitor_task, "Health", HEALTH_TASK_STACK_SIZE, NULL,
+                                                    HEALTH_TASK_PRIORITY, &health_monitor_handle, tskNO_AFFINITY);
+        if (result != pdPASS)
+        {
+            health_monitor_handle = NULL;
+            Serial.println("[HEALTH] Error: Monitor task not created");
+            return false;
+        }
+    }
+
+    DEBUG_PRINTF("[HEALTH] Monitor running, watchdog %d s\n", HEALTH_TWDT_TIMEOUT_S);
+    return true;
+}
+
+/**
+ * @brief Watch the calling task
+ */
+MAIN_health_id_t MAIN_health_register(uint32_t deadlineMs, MAIN_health_phase_fn_t phaseFn)
+{
+    MAIN_health_id_t id = HEALTH_INVALID;
+
+    taskENTER_CRITICAL(&health_mux);
+    if (health_task_count < HEALTH_TASK_MAX)
+    {
+        id = (MAIN_health_id_t)health_task_count;
+        health_task_t *task = &health_tasks[id];
+        memset(task, 0, sizeof(*task));
+        task->handle = xTaskGetCurrentTaskHandle();
+        task->phaseFn = phaseFn;
+        task->lastBeatMs = millis();
+        health_copy(task->stats.name, sizeof(task->stats.name), pcTaskGetName(NULL));
+        task->stats.deadlineMs = deadlineMs;
+        health_task_count++; // Published last, the monitor reads without the lock
+    }
+    taskEXIT_CRITICAL(&health_mux);
+
+    if (id == HEALTH_INVALID)
+    {
+        Serial.printf("[HEALTH] Error: No slot for %s\n", pcTaskGetName(NULL));
+        return HEALTH_INVALID;
+    }
+
+    if (esp_task_wdt_add(NULL) != ESP_OK)
+    {
+        Serial.printf("[HEALTH] Warning: %s not on the task watchdog\n", pcTaskGetName(NULL));
+    }
+    return id;
+}
+
+/**
+ * @brief Heartbeat: the task is making progress
+ */
+void MAIN_health_beat(MAIN_health_id_t id)
+{
+    if (id < 0 || id >= (MAIN_health_id_t)health_task_count)
+    {
+        return;
+    }
+
+    health_task_t *task = &health_tasks[id];
+    uint32_t now = millis();
+    uint32_t gapMs = now - task->lastBeatMs;
+
+    taskENTER_CRITICAL(&health_mux);
+    task->lastBeatMs = now;
+    task->stats.beats++;
+    if (gapMs > task->stats.maxGapMs)
+    {
+        task->stats.maxGapMs = gapMs;
+    }
+    bool recovered = task->stats.stalled;
+    bool late = !recovered && gapMs * 100 > task->stats.deadlineMs * HEALTH_LATE_PERCENT;
+    if (late)
+    {
+        task->stats.late++;
+    }
+    task->stats.stalled = false;
+    taskEXIT_CRITICAL(&health_mux);
+
+    if (recovered)
+    {
+        health_note_task("recovered", task, gapMs);
+    }
+    else if (late)
+    {
+        health_note_task("late", task, gapMs);
+    }
+
+    esp_task_wdt_reset();
+}
+
+/**
+ * @brief Name what the task is about to do
+ */
+void MAIN_health_phase(MAIN_health_id_t id, const char *phase)
+{
+    if (id >= 0 && id < (MAIN_health_id_t)health_task_count)
+    {
+        health_tasks[id].phase = phase;
+    }
+}
+
+/**
+ * @brief Add a breadcrumb
+ */
+void MAIN_health_note(const char *tag, uint32_t value)
+{
+    uint32_t now = millis();
+
+    taskENTER_CRITICAL(&health_mux);
+    MAIN_health_event_t *event = &health_rtc.events[health_rtc.head];
+    event->uptimeMs = now;
+    event->value = value;
+    health_copy(event->tag, sizeof(event->tag), tag);
+    health_rtc.head = (health_rtc.head + 1) % HEALTH_EVENT_COUNT;
+    if (health_rtc.count < HEALTH_EVENT_COUNT)
+    {
+        health_rtc.count++;
+    }
+    health_rtc.crc = health_rtc_crc();
+    taskEXIT_CRITICAL(&health_mux);
+}
+
+/**
+ * @brief What the previous boot left behind
+ */
+bool MAIN_health_get_previous(MAIN_health_report_t *report)
+{
+    if (report == NULL)
+    {
+        return false;
+    }
+    *report = health_previous;
+    return health_previous.stalled || health_previous.eventCount > 0;
+}
+
+/**
+ * @brief Counters of one watched task
+ */
+bool MAIN_health_get_task_stats(MAIN_health_id_t id, MAIN_health_task_stats_t *stats)
+{
+    if (stats == NULL || id < 0 || id >= (MAIN_health_id_t)health_task_count)
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL(&health_mux);
+    *stats = health_tasks[id].stats;
+    taskEXIT_CRITICAL(&health_mux);
+    return true;
+}
+
+/**
+ * @brief Beats of one watched task
+ */
+uint32_t MAIN_health_get_beats(MAIN_health_id_t id)
+{
+    if (id < 0 || id >= (MAIN_health_id_t)health_task_count)
+    {
+        return 0;
+    }
+    return health_tasks[id].stats.beats;
+}
+
+/**
+ * @brief Print every watched task's counters to Serial
+ */
+void MAIN_health_print_report(void)
+{
+    Serial.println("[HEALTH] Task             Deadline     Beats  Max gap  Late  Stalls");
+    for (MAIN_health_id_t i = 0; i < (MAIN_health_id_t)health_task_count; i++)
+    {
+        MAIN_health_task_stats_t stats;
+        if (!MAIN_health_get_task_stats(i, &stats))
+        {
+            continue;
+        }
+        Serial.printf("[HEALTH] %-16s %8lu %9lu %8lu %5lu %7lu%s\n", stats.name, (unsigned long)stats.deadlineMs,
+                      (unsigned long)stats.beats, (unsigned long)stats.maxGapMs, (unsigned long)stats.late,
+                      (unsigned long)stats.stalls, stats.stalled ? "  STALLED" : "");
+    }
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Health_getLibraryName() {
+    return MAIN_Health::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Health_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Health::VERSION_MAJOR,
+                       MAIN_Health::VERSION_MINOR,
+                       MAIN_Health::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Health_getVersionDate() {
+    return MAIN_Health::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Health_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Health_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/******************************************************************************
+ * End of MAIN_healthLib.cpp
+ *****************************************************************************/
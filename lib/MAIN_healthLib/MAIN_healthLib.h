@@ -0,0 +1,210 @@
+/**
+ * @file MAIN_healthLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Task health monitor on the task watchdog, with stall diagnostics
+ * @details Long-running tasks (Core0_UI, Core1_Background) register from
+ *          their own context with a heartbeat deadline and call
+ *          MAIN_health_beat() once per loop. Registering also subscribes the
+ *          task to the ESP task watchdog, reconfigured to
+ *          HEALTH_TWDT_TIMEOUT_S, and each beat feeds it.
+ *
+ *          A monitor task checks the deadlines every HEALTH_CHECK_PERIOD_MS.
+ *          The deadlines are well inside the watchdog timeout, so a task
+ *          that stops beating is caught while it is still stuck: the monitor
+ *          takes a backtrace of its saved context (from that task's core,
+ *          through an IPC call, so it is not running while it is read) and
+ *          writes a stall record to RTC memory, with the task's phase (what
+ *          it said it was doing, or the scheduler job it is in). If the task
+ *          recovers, the stall is only counted; if not, the watchdog restarts
+ *          the chip and the record survives the reset.
+ *
+ *          Breadcrumbs (MAIN_health_note(), late beats, stalls and boots)
+ *          go into a ring of HEALTH_EVENT_COUNT events, also in RTC memory.
+ *          MAIN_initialise_health() picks up the previous boot's stall and
+ *          breadcrumbs, prints them (the backtrace in the form the
+ *          esp32_exception_decoder monitor filter decodes) and appends them
+ *          to HEALTH_LOG_FILE.
+ *
+ *          Beats cost a store and a watchdog feed, so the monitor runs in
+ *          every build. A task stuck inside a critical section cannot be
+ *          sampled (the IPC call never runs); the watchdog panic and core
+ *          dump cover that case.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_HEALTH_LIB_H__
+#define __MAIN_HEALTH_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Health
+{
+    constexpr const char* LIB_NAME = "MAIN_Health";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_Health_getLibraryName();
+uint32_t MAIN_Health_getVersionEncoded();
+const char* MAIN_Health_getVersionDate();
+void MAIN_Health_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Health Configuration
+ *****************************************************************************/
+#define HEALTH_TASK_MAX 6                 // Registered tasks
+#define HEALTH_CHECK_PERIOD_MS 250        // Monitor deadline check period
+#define HEALTH_TWDT_TIMEOUT_S 15          // Task watchdog: restart after this long
+#define HEALTH_LATE_PERCENT 50            // A beat this far into the deadline is noted as late
+#define HEALTH_BACKTRACE_DEPTH 16         // Frames kept of a stalled task
+#define HEALTH_EVENT_COUNT 32             // Breadcrumbs kept across a reset
+#define HEALTH_TAG_SIZE 24                // Breadcrumb and phase text + NUL
+#define HEALTH_LOG_FILE "/logs/health.log"
+
+#define HEALTH_TASK_STACK_SIZE 3072
+#define HEALTH_TASK_PRIORITY (configMAX_PRIORITIES - 2) // Above everything but IPC
+
+// Returned by MAIN_health_register() when the table is full
+#define HEALTH_INVALID (-1)
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef int8_t MAIN_health_id_t;
+
+// Names what a task is doing, read by the monitor when it stalls
+typedef const char *(*MAIN_health_phase_fn_t)(void);
+
+typedef struct
+{
+    uint32_t uptimeMs;                  // millis() when noted
+    uint32_t value;
+    char tag[HEALTH_TAG_SIZE];
+} MAIN_health_event_t;
+
+typedef struct
+{
+    char task[configMAX_TASK_NAME_LEN];
+    char phase[HEALTH_TAG_SIZE];        // Empty if the task gave none
+    uint32_t uptimeMs;                  // When the stall was caught
+    uint32_t silentMs;                  // Since the task's last beat
+    uint8_t core;                       // Core it was sampled from
+    uint8_t depth;                      // Backtrace frames held
+    uint32_t pc[HEALTH_BACKTRACE_DEPTH];
+    uint32_t sp[HEALTH_BACKTRACE_DEPTH];
+} MAIN_health_stall_t;
+
+typedef struct
+{
+    int resetReason;                    // esp_reset_reason() of this boot
+    bool stalled;                       // stall holds the last stall before the reset
+    MAIN_health_stall_t stall;
+    uint8_t eventCount;
+    MAIN_health_event_t events[HEALTH_EVENT_COUNT]; // Oldest first
+} MAIN_health_report_t;
+
+typedef struct
+{
+    char name[configMAX_TASK_NAME_LEN];
+    uint32_t deadlineMs;
+    uint32_t beats;
+    uint32_t maxGapMs;                  // Longest time between beats
+    uint32_t late;                      // Beats past HEALTH_LATE_PERCENT of the deadline
+    uint32_t stalls;                    // Deadlines missed
+    bool stalled;                       // Missing its deadline now
+} MAIN_health_task_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Read the previous boot's record, set the watchdog timeout and start
+ *        the monitor
+ * @return true if the monitor is running
+ * @note Call from setup after the SD card is mounted and before the tasks
+ *       that register are created.
+ */
+bool MAIN_initialise_health(void);
+
+/**
+ * @brief Watch the calling task
+ * @param deadlineMs Longest time allowed between beats
+ * @param phaseFn Names the current phase at a stall (NULL = the text from
+ *        MAIN_health_phase())
+ * @return MAIN_health_id_t Id for beats, HEALTH_INVALID if the table is full
+ * @note Call from the task itself, before its loop.
+ */
+MAIN_health_id_t MAIN_health_register(uint32_t deadlineMs, MAIN_health_phase_fn_t phaseFn);
+
+/**
+ * @brief Heartbeat: the task is making progress
+ * @param id Id from MAIN_health_register()
+ * @note The registered task only
+ */
+void MAIN_health_beat(MAIN_health_id_t id);
+
+/**
+ * @brief Name what the task is about to do
+ * @param id Id from MAIN_health_register()
+ * @param phase String literal (kept by pointer)
+ */
+void MAIN_health_phase(MAIN_health_id_t id, const char *phase);
+
+/**
+ * @brief Add a breadcrumb
+ * @param tag Short text (HEALTH_TAG_SIZE - 1 characters kept)
+ * @param value Any number worth keeping with it
+ * @note Any task; not from an ISR
+ */
+void MAIN_health_note(const char *tag, uint32_t value);
+
+/**
+ * @brief What the previous boot left behind
+ * @param report Receives the reset reason, the last stall and the breadcrumbs
+ * @return true if there was a stall or a breadcrumb to report
+ */
+bool MAIN_health_get_previous(MAIN_health_report_t *report);
+
+/**
+ * @brief Counters of one watched task
+ * @param id Id from MAIN_health_register()
+ * @param stats Receives a copy
+ * @return true if the task is registered
+ */
+bool MAIN_health_get_task_stats(MAIN_health_id_t id, MAIN_health_task_stats_t *stats);
+
+/**
+ * @brief Beats of one watched task
+ * @param id Id from MAIN_health_register()
+ * @return uint32_t Beats since it registered (0 if not registered)
+ */
+uint32_t MAIN_health_get_beats(MAIN_health_id_t id);
+
+/**
+ * @brief Print every watched task's counters to Serial
+ */
+void MAIN_health_print_report(void);
+
+#endif // __MAIN_HEALTH_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_healthLib.h
+ ******************************************************************************/
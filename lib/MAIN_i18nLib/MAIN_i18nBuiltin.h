@@ -0,0 +1,32 @@
+/**
+ * @file MAIN_i18nBuiltin.h
+ * @brief Builtin language pack generated from assets/lang/en.json
+ * @details Written by scripts/generate_lang_packs.py before every build.
+ *          Included by MAIN_i18nLib.cpp only. Data lives in flash (.rodata).
+ */
+
+#pragma once
+#ifndef __MAIN_I18N_BUILTIN_H__
+#define __MAIN_I18N_BUILTIN_H__
+
+#include <stdint.h>
+
+alignas(4) static const uint8_t MAIN_I18N_BUILTIN_PACK[235] = {
+    0x45, 0x41, 0x52, 0x53, 0x4c, 0x4e, 0x47, 0x31, 0x01, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0x65, 0x6e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xcd, 0x6c, 0x6b, 0xb4, 0x8b, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x00,
+    0x14, 0x00, 0x00, 0x00, 0x1d, 0x00, 0x00, 0x00, 0x26, 0x00, 0x00, 0x00, 0x31, 0x00, 0x00, 0x00,
+    0x39, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00, 0x4c, 0x00, 0x00, 0x00, 0x57, 0x00, 0x00, 0x00,
+    0x5e, 0x00, 0x00, 0x00, 0x69, 0x00, 0x00, 0x00, 0x79, 0x00, 0x00, 0x00, 0x85, 0x00, 0x00, 0x00,
+    0x4f, 0x4b, 0x00, 0x43, 0x61, 0x6e, 0x63, 0x65, 0x6c, 0x00, 0x42, 0x61, 0x63, 0x6b, 0x00, 0x53,
+    0x61, 0x76, 0x65, 0x00, 0x53, 0x65, 0x74, 0x74, 0x69, 0x6e, 0x67, 0x73, 0x00, 0x4c, 0x61, 0x6e,
+    0x67, 0x75, 0x61, 0x67, 0x65, 0x00, 0x42, 0x72, 0x69, 0x67, 0x68, 0x74, 0x6e, 0x65, 0x73, 0x73,
+    0x00, 0x42, 0x61, 0x74, 0x74, 0x65, 0x72, 0x79, 0x00, 0x43, 0x68, 0x61, 0x72, 0x67, 0x69, 0x6e,
+    0x67, 0x00, 0x45, 0x71, 0x75, 0x69, 0x70, 0x6d, 0x65, 0x6e, 0x74, 0x00, 0x41, 0x6d, 0x6d, 0x75,
+    0x6e, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x00, 0x53, 0x65, 0x61, 0x72, 0x63, 0x68, 0x00, 0x4e, 0x6f,
+    0x20, 0x72, 0x65, 0x63, 0x6f, 0x72, 0x64, 0x73, 0x00, 0x53, 0x44, 0x20, 0x63, 0x61, 0x72, 0x64,
+    0x20, 0x72, 0x65, 0x6d, 0x6f, 0x76, 0x65, 0x64, 0x00, 0x55, 0x70, 0x64, 0x61, 0x74, 0x69, 0x6e,
+    0x67, 0x2e, 0x2e, 0x2e, 0x00, 0x45, 0x72, 0x72, 0x6f, 0x72, 0x00,
+};
+
+#endif // __MAIN_I18N_BUILTIN_H__
@@ -0,0 +1,310 @@
+/**
+ * @file MAIN_i18nLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Localised UI strings looked up by ID from precompiled language packs
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_i18nLib.h"
+#include "MAIN_i18nBuiltin.h"
+#include "MAIN_assetPackLib.h"
+#include "EARS_errorsLib.h"
+#include "EARS_systemDef.h"
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint16_t count;
+    uint16_t errorCount;
+    char language[8];
+    uint32_t keysHash;
+    uint32_t dataSize;
+} i18n_header_t;
+
+typedef struct
+{
+    uint16_t code;
+    uint16_t pad;
+    uint32_t offset;
+} i18n_error_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+// Current pack: the builtin one or a pack in the mapped asset partition.
+// Packs are never freed, so a reader holding the old pointer stays safe.
+static const uint8_t *volatile i18n_pack = MAIN_I18N_BUILTIN_PACK;
+
+/******************************************************************************
+ * Static Functions (internal to library)
+ *****************************************************************************/
+
+static inline const i18n_header_t *i18n_header(const uint8_t *pack)
+{
+    return (const i18n_header_t *)pack;
+}
+
+static inline const uint32_t *i18n_offsets(const uint8_t *pack)
+{
+    return (const uint32_t *)(pack + sizeof(i18n_header_t));
+}
+
+static inline const i18n_error_t *i18n_errors(const uint8_t *pack)
+{
+    return (const i18n_error_t *)(i18n_offsets(pack) + i18n_header(pack)->count);
+}
+
+static inline const char *i18n_data(const uint8_t *pack)
+{
+    return (const char *)(i18n_errors(pack) + i18n_header(pack)->errorCount);
+}
+
+/**
+ * @brief Check a pack against this build's string IDs
+ * @param pack Pack start
+ * @param size Pack size in bytes
+ * @return true if every offset lands inside the string data
+ */
+static bool i18n_validate(const uint8_t *pack, uint32_t size)
+{
+    if (pack == NULL || size < sizeof(i18n_header_t) || ((uintptr_t)pack & 3) != 0)
+    {
+        return false;
+    }
+
+    const i18n_header_t *header = i18n_header(pack);
+    if (memcmp(header->magic, I18N_PACK_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != I18N_PACK_VERSION ||
+        header->keysHash != I18N_KEYS_HASH || header->count != STR_COUNT)
+    {
+        return false;
+    }
+
+    uint32_t dataStart = sizeof(i18n_header_t) + header->count * sizeof(uint32_t) +
+                         header->errorCount * sizeof(i18n_error_t);
+    if (header->dataSize == 0 || dataStart + header->dataSize > size ||
+        pack[dataStart + header->dataSize - 1] != '\0')
+    {
+        return false;
+    }
+
+    const uint32_t *offsets = i18n_offsets(pack);
+    for (uint16_t i = 0; i < header->count; i++)
+    {
+        if (offsets[i] != I18N_UNTRANSLATED && offsets[i] >= header->dataSize)
+        {
+            return false;
+        }
+    }
+
+    const i18n_error_t *errors = i18n_errors(pack);
+    for (uint16_t i = 0; i < header->errorCount; i++)
+    {
+        if (errors[i].offset >= header->dataSize || (i > 0 && errors[i].code <= errors[i - 1].code))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Find a pack by language code
+ * @param language Language code
+ * @return const uint8_t* Validated pack, or NULL
+ */
+static const uint8_t *i18n_find_pack(const char *language)
+{
+    if (strcmp(language, I18N_BUILTIN_LANGUAGE) == 0)
+    {
+        return MAIN_I18N_BUILTIN_PACK;
+    }
+
+    char name[ASSET_PACK_NAME_LEN];
+    snprintf(name, sizeof(name), I18N_ASSET_PREFIX "%s", language);
+
+    uint32_t size = 0;
+    const uint8_t *pack = MAIN_asset_pack_find(name, &size);
+    if (pack == NULL)
+    {
+        return NULL;
+    }
+
+    if (!i18n_validate(pack, size))
+    {
+        Serial.printf("[I18N] ERROR: %s does not match this build's strings (rebuild the asset pack)\n", name);
+        return NULL;
+    }
+    return pack;
+}
+
+/**
+ * @brief String by ID from one pack
+ * @param pack Pack to look in
+ * @param id String ID
+ * @return const char* String, or NULL if untranslated
+ */
+static const char *i18n_lookup(const uint8_t *pack, uint16_t id)
+{
+    uint32_t offset = i18n_offsets(pack)[id];
+    return offset == I18N_UNTRANSLATED ? NULL : i18n_data(pack) + offset;
+}
+
+/******************************************************************************
+ * Localisation
+ *****************************************************************************/
+
+/**
+ * @brief Select the boot language
+ * @param language Language code, NULL for the builtin
+ * @return true if that language is in use
+ */
+bool MAIN_initialise_i18n(const char *language)
+{
+    if (language == NULL || language[0] == '\0')
+    {
+        language = I18N_BUILTIN_LANGUAGE;
+    }
+
+    bool ok = MAIN_i18n_set_language(language);
+    if (!ok)
+    {
+        Serial.printf("[I18N] No \"%s\" language pack, using \"" I18N_BUILTIN_LANGUAGE "\"\n", language);
+        i18n_pack = MAIN_I18N_BUILTIN_PACK;
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[I18N] Language \"%s\", %u strings\n", MAIN_i18n_get_language(), (unsigned)STR_COUNT);
+#endif
+    return ok;
+}
+
+/**
+ * @brief Switch language
+ * @param language Language code
+ * @return true if switched
+ */
+bool MAIN_i18n_set_language(const char *language)
+{
+    if (language == NULL)
+    {
+        return false;
+    }
+
+    const uint8_t *pack = i18n_find_pack(language);
+    if (pack == NULL)
+    {
+        return false;
+    }
+
+    i18n_pack = pack;
+    return true;
+}
+
+/**
+ * @brief Language in use
+ * @return const char* Language code
+ */
+const char *MAIN_i18n_get_language(void)
+{
+    // language[8] is NUL-padded by the generator (codes are at most 7 bytes)
+    return i18n_header(i18n_pack)->language;
+}
+
+/**
+ * @brief Localised string
+ * @param id String ID
+ * @return const char* String, never NULL
+ */
+const char *MAIN_tr(MAIN_string_id_t id)
+{
+    if ((unsigned)id >= STR_COUNT)
+    {
+        return "";
+    }
+
+    const char *text = i18n_lookup(i18n_pack, (uint16_t)id);
+    if (text == NULL)
+    {
+        text = i18n_lookup(MAIN_I18N_BUILTIN_PACK, (uint16_t)id);
+    }
+    return text != NULL ? text : "";
+}
+
+/**
+ * @brief Localised error message
+ * @param code Error code
+ * @return const char* Message, or NULL if unknown
+ */
+const char *MAIN_tr_error(uint16_t code)
+{
+    const uint8_t *pack = i18n_pack;
+    const i18n_error_t *errors = i18n_errors(pack);
+
+    // Binary search of the sorted error index
+    int lo = 0;
+    int hi = (int)i18n_header(pack)->errorCount - 1;
+    while (lo <= hi)
+    {
+        int mid = (lo + hi) / 2;
+        if (errors[mid].code == code)
+        {
+            return i18n_data(pack) + errors[mid].offset;
+        }
+        if (errors[mid].code < code)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid - 1;
+        }
+    }
+
+    return EARS_errors::getBuiltinMessage(code);
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_I18n_getLibraryName() {
+    return MAIN_I18n::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_I18n_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_I18n::VERSION_MAJOR,
+                       MAIN_I18n::VERSION_MINOR,
+                       MAIN_I18n::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_I18n_getVersionDate() {
+    return MAIN_I18n::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_I18n_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_I18n_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_i18nLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,120 @@
+/**
+ * @file MAIN_i18nLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Localised UI strings looked up by ID from precompiled language packs
+ * @details scripts/generate_lang_packs.py turns assets/lang/<code>.json into
+ *          binary packs before every build. The master language (en) sets
+ *          the string IDs (MAIN_i18nStrings.h) and is compiled into flash as
+ *          the builtin pack; every other language becomes the asset pack
+ *          entry "lang_<code>" (scripts/build_asset_pack.py), read in place
+ *          from the mapped partition.
+ *
+ *          A lookup is an index into the offset table of the current pack:
+ *          no parsing, hashing or copying at run time. Switching language
+ *          swaps one pointer, so MAIN_tr() is safe from any task and the
+ *          strings it returns stay valid for the life of the firmware.
+ *          Strings missing from a pack fall back to the builtin pack.
+ *
+ *          Error messages are translated the same way, by error code, and
+ *          fall back to EARS_errors' builtin table.
+ *
+ *          Pack layout (little endian, shared with generate_lang_packs.py):
+ *            header  32 bytes  magic "EARSLNG1", version, count, errorCount,
+ *                              language[8], keysHash, dataSize
+ *            offsets count x uint32 into data (I18N_UNTRANSLATED if absent)
+ *            errors  errorCount x {uint16 code, pad, uint32 offset}, sorted
+ *            data    NUL-terminated UTF-8 strings
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_I18N_LIB_H__
+#define __MAIN_I18N_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include "MAIN_i18nStrings.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_I18n
+{
+    constexpr const char* LIB_NAME = "MAIN_I18n";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_I18n_getLibraryName();
+uint32_t MAIN_I18n_getVersionEncoded();
+const char* MAIN_I18n_getVersionDate();
+void MAIN_I18n_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Localisation Configuration
+ *****************************************************************************/
+
+// Pack format
+#define I18N_PACK_MAGIC "EARSLNG1"
+#define I18N_PACK_VERSION 1
+#define I18N_UNTRANSLATED 0xFFFFFFFFUL
+
+// Builtin language and the asset pack entry prefix for the others
+#define I18N_BUILTIN_LANGUAGE "en"
+#define I18N_ASSET_PREFIX "lang_"
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Select the boot language
+ * @param language Language code (ears.config application.language), NULL for the builtin
+ * @return true if that language is in use, false if the builtin is used instead
+ * @note Call after MAIN_initialise_asset_pack().
+ */
+bool MAIN_initialise_i18n(const char *language);
+
+/**
+ * @brief Switch language
+ * @param language Language code ("en", "de", ...)
+ * @return true if switched; false leaves the current language in place
+ * @note Any task. Screens re-read their labels with MAIN_tr() to pick it up.
+ */
+bool MAIN_i18n_set_language(const char *language);
+
+/**
+ * @brief Language in use
+ * @return const char* Language code
+ */
+const char *MAIN_i18n_get_language(void);
+
+/**
+ * @brief Localised string
+ * @param id String ID (MAIN_i18nStrings.h)
+ * @return const char* UTF-8 string in flash, never NULL ("" for an unknown ID)
+ */
+const char *MAIN_tr(MAIN_string_id_t id);
+
+/**
+ * @brief Localised error message
+ * @param code Error code (data/config/errors.json)
+ * @return const char* Message, or NULL if the code is unknown
+ */
+const char *MAIN_tr_error(uint16_t code);
+
+#endif // __MAIN_I18N_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_i18nLib.h
+ ******************************************************************************/
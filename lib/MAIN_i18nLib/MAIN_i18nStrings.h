@@ -0,0 +1,37 @@
+/**
+ * @file MAIN_i18nStrings.h
+ * @brief String IDs generated from assets/lang/en.json
+ * @details Written by scripts/generate_lang_packs.py before every build; add
+ *          strings to the master language file, not here. Packs built with
+ *          a different key list carry a different I18N_KEYS_HASH and are
+ *          refused at load.
+ */
+
+#pragma once
+#ifndef __MAIN_I18N_STRINGS_H__
+#define __MAIN_I18N_STRINGS_H__
+
+#define I18N_KEYS_HASH 0xB46B6CCDUL
+
+typedef enum
+{
+    STR_OK,
+    STR_CANCEL,
+    STR_BACK,
+    STR_SAVE,
+    STR_SETTINGS,
+    STR_LANGUAGE,
+    STR_BRIGHTNESS,
+    STR_BATTERY,
+    STR_CHARGING,
+    STR_EQUIPMENT,
+    STR_AMMUNITION,
+    STR_SEARCH,
+    STR_NO_RECORDS,
+    STR_SD_REMOVED,
+    STR_UPDATING,
+    STR_ERROR,
+    STR_COUNT
+} MAIN_string_id_t;
+
+#endif // __MAIN_I18N_STRINGS_H__
@@ -0,0 +1,257 @@
+/**
+ * @file MAIN_imageAssetsLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Native LVGL binary image assets loaded from the SD card
+ * @version 1.0.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_imageAssetsLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_sdCardLib.h"
+#include "MAIN_sdFsLib.h"
+#include "MAIN_sysinfoLib.h"
+#include <ArduinoJson.h>
+#include <esp_heap_caps.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    char name[IMAGE_ASSETS_NAME_LEN]; // Manifest name
+    char path[IMAGE_ASSETS_PATH_LEN]; // "S:" path for LVGL's file decoder
+    lv_image_dsc_t dsc;               // Descriptor over buffer
+    uint8_t *buffer;                  // Whole .bin file in PSRAM (NULL = use path)
+} image_asset_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static image_asset_t image_assets[IMAGE_ASSETS_MAX];
+static uint8_t image_asset_count = 0;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Load one .bin file into PSRAM and describe it
+ * @param asset Table entry (path set)
+ * @param sdPath Path on the SD card
+ * @param expectedSize Size from the manifest
+ * @return true if the buffer holds a valid LVGL image
+ */
+static bool image_assets_load_file(image_asset_t *asset, const char *sdPath, uint32_t expectedSize)
+{
+    uint32_t size = using_sdcard().getFileSize(sdPath);
+    if (size <= sizeof(lv_image_header_t) || (expectedSize != 0 && size != expectedSize))
+    {
+        Serial.printf("[IMGASSETS] ERROR: %s size %lu, manifest says %lu\n",
+                      sdPath, (unsigned long)size, (unsigned long)expectedSize);
+        return false;
+    }
+
+    uint8_t *buffer = (uint8_t *)heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (buffer == NULL)
+    {
+        return false;
+    }
+
+    if (using_sdcard().readInto(sdPath, buffer, size) != size)
+    {
+        heap_caps_free(buffer);
+        return false;
+    }
+
+    lv_image_header_t header;
+    memcpy(&header, buffer, sizeof(header));
+    if (header.magic != LV_IMAGE_HEADER_MAGIC ||
+        (header.cf != LV_COLOR_FORMAT_RGB565 && header.cf != LV_COLOR_FORMAT_RGB565A8))
+    {
+        Serial.printf("[IMGASSETS] ERROR: %s is not an RGB565/RGB565A8 LVGL image\n", sdPath);
+        heap_caps_free(buffer);
+        return false;
+    }
+
+    // Compressed files keep their compression header in data, as LVGL expects
+    asset->buffer = buffer;
+    asset->dsc.header = header;
+    asset->dsc.data_size = size - sizeof(lv_image_header_t);
+    asset->dsc.data = buffer + sizeof(lv_image_header_t);
+    return true;
+}
+
+/******************************************************************************
+ * Image Assets
+ *****************************************************************************/
+
+/**
+ * @brief Read the manifest and load every listed image
+ * @return uint8_t Assets available
+ */
+uint8_t MAIN_initialise_image_assets(void)
+{
+    MAIN_image_assets_release();
+
+    if (!using_sdcard().isAvailable() || !using_sdcard().fileExists(IMAGE_ASSETS_MANIFEST))
+    {
+#if EARS_DEBUG == 1
+        Serial.println("[IMGASSETS] No " IMAGE_ASSETS_MANIFEST ", no image assets");
+#endif
+        return 0;
+    }
+
+    File file = using_sdcard().openRead(IMAGE_ASSETS_MANIFEST);
+    if (!file)
+    {
+        return 0;
+    }
+
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(doc, file);
+    file.close();
+
+    if (error)
+    {
+        Serial.printf("[IMGASSETS] ERROR: manifest.json: %s\n", error.c_str());
+        return 0;
+    }
+
+    bool preload = MAIN_sysinfo_has_psram();
+    uint32_t loadedBytes = 0;
+
+    for (JsonObject entry : doc["images"].as<JsonArray>())
+    {
+        const char *name = entry["name"];
+        const char *fileName = entry["file"];
+        if (name == NULL || fileName == NULL)
+        {
+            continue;
+        }
+
+        if (image_asset_count >= IMAGE_ASSETS_MAX)
+        {
+            Serial.println("[IMGASSETS] Warning: Too many images, some ignored");
+            break;
+        }
+
+        image_asset_t *asset = &image_assets[image_asset_count];
+        memset(asset, 0, sizeof(image_asset_t));
+        strlcpy(asset->name, name, sizeof(asset->name));
+        snprintf(asset->path, sizeof(asset->path), "%c:" IMAGE_ASSETS_DIR "/%s", SDFS_LETTER, fileName);
+
+        if (preload)
+        {
+            char sdPath[IMAGE_ASSETS_PATH_LEN];
+            snprintf(sdPath, sizeof(sdPath), IMAGE_ASSETS_DIR "/%s", fileName);
+            if (image_assets_load_file(asset, sdPath, entry["size"] | 0))
+            {
+                loadedBytes += asset->dsc.data_size;
+            }
+        }
+
+        image_asset_count++;
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[IMGASSETS] %u images, %lu bytes preloaded to PSRAM\n",
+                  image_asset_count, (unsigned long)loadedBytes);
+#endif
+
+    return image_asset_count;
+}
+
+/**
+ * @brief Image source for an asset, for lv_image_set_src()
+ * @param name Manifest name
+ * @return const void* Descriptor, path or NULL
+ */
+const void *MAIN_image_asset_src(const char *name)
+{
+    if (name == NULL)
+    {
+        return NULL;
+    }
+
+    for (uint8_t i = 0; i < image_asset_count; i++)
+    {
+        if (strcmp(image_assets[i].name, name) == 0)
+        {
+            if (image_assets[i].buffer != NULL)
+            {
+                return &image_assets[i].dsc;
+            }
+            return image_assets[i].path;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Number of assets in the table
+ * @return uint8_t Assets loaded from the manifest
+ */
+uint8_t MAIN_image_asset_count(void)
+{
+    return image_asset_count;
+}
+
+/**
+ * @brief Free every loaded asset
+ */
+void MAIN_image_assets_release(void)
+{
+    for (uint8_t i = 0; i < image_asset_count; i++)
+    {
+        if (image_assets[i].buffer != NULL)
+        {
+            // Compressed assets leave a decompressed copy in the image cache
+            lv_image_cache_drop(&image_assets[i].dsc);
+            heap_caps_free(image_assets[i].buffer);
+            image_assets[i].buffer = NULL;
+        }
+    }
+
+    image_asset_count = 0;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_ImageAssets_getLibraryName() {
+    return MAIN_ImageAssets::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_ImageAssets_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_ImageAssets::VERSION_MAJOR,
+                       MAIN_ImageAssets::VERSION_MINOR,
+                       MAIN_ImageAssets::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_ImageAssets_getVersionDate() {
+    return MAIN_ImageAssets::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_ImageAssets_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_ImageAssets_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_imageAssetsLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,97 @@
+/**
+ * @file MAIN_imageAssetsLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Native LVGL binary image assets loaded from the SD card
+ * @details scripts/convert_images.py turns the source images into LVGL 9
+ *          .bin files (RGB565 / RGB565A8, optionally RLE compressed) with a
+ *          manifest.json, copied to the SD card under /images. At boot the
+ *          manifest is read and each file is loaded whole into PSRAM and
+ *          wrapped in an lv_image_dsc_t, so drawing needs no PNG/JPG decode
+ *          and no SD access. Compressed files are expanded once by LVGL's
+ *          bin decoder into the image cache.
+ *
+ *          Without PSRAM the assets are served as "S:" file paths instead.
+ * @version 1.0.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_IMAGE_ASSETS_LIB_H__
+#define __MAIN_IMAGE_ASSETS_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include <lvgl.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_ImageAssets
+{
+    constexpr const char* LIB_NAME = "MAIN_ImageAssets";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "1";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_ImageAssets_getLibraryName();
+uint32_t MAIN_ImageAssets_getVersionEncoded();
+const char* MAIN_ImageAssets_getVersionDate();
+void MAIN_ImageAssets_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Image Assets Configuration
+ *****************************************************************************/
+
+// Asset directory and manifest on the SD card
+#define IMAGE_ASSETS_DIR "/images"
+#define IMAGE_ASSETS_MANIFEST IMAGE_ASSETS_DIR "/manifest.json"
+
+// Table size
+#define IMAGE_ASSETS_MAX 32
+#define IMAGE_ASSETS_NAME_LEN 32
+#define IMAGE_ASSETS_PATH_LEN 64
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Read the manifest and load every listed image
+ * @return uint8_t Assets available (0 if no card or no manifest)
+ * @note Call after MAIN_initialise_sd() and MAIN_initialise_lvgl().
+ */
+uint8_t MAIN_initialise_image_assets(void);
+
+/**
+ * @brief Image source for an asset, for lv_image_set_src()
+ * @param name Manifest name (file name without .bin)
+ * @return const void* lv_image_dsc_t in PSRAM, "S:" path, or NULL if unknown
+ */
+const void *MAIN_image_asset_src(const char *name);
+
+/**
+ * @brief Number of assets in the table
+ * @return uint8_t Assets loaded from the manifest
+ */
+uint8_t MAIN_image_asset_count(void);
+
+/**
+ * @brief Free every loaded asset
+ * @note No widget may still show an asset.
+ */
+void MAIN_image_assets_release(void);
+
+#endif // __MAIN_IMAGE_ASSETS_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_imageAssetsLib.h
+ ******************************************************************************/
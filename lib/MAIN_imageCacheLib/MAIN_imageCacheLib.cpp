@@ -0,0 +1,287 @@
+/**
+ * @file MAIN_imageCacheLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Decoded image cache for SD-hosted images (PNG/JPG/BMP) in PSRAM
+ * @version 1.0.2
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_imageCacheLib.h"
+#include "EARS_systemDef.h"
+#include "MAIN_sysinfoLib.h"
+#include "MAIN_memPlanLib.h"
+#include <lvgl_private.h>
+#include <esp_heap_caps.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    lv_obj_t *screen;        // Screen the hints belong to (NULL = free)
+    const char *const *srcs; // Image sources shown by the screen
+    uint8_t count;           // Entries in srcs
+} image_cache_hint_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static bool image_cache_enabled = false;
+static image_cache_hint_t image_cache_hints[IMAGE_CACHE_MAX_HINT_SCREENS];
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Decoded image buffer allocator (PSRAM)
+ * @param size Bytes LVGL needs
+ * @param colorFormat Unused
+ * @return void* Unaligned buffer, LVGL aligns it to LV_DRAW_BUF_ALIGN
+ */
+static void *image_cache_buf_malloc(size_t size, lv_color_format_t colorFormat)
+{
+    (void)colorFormat;
+    return MAIN_mem_alloc(MEM_POOL_IMAGE_CACHE, size + LV_DRAW_BUF_ALIGN - 1, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+}
+
+/**
+ * @brief Decoded image buffer release
+ * @param buf Buffer from image_cache_buf_malloc
+ */
+static void image_cache_buf_free(void *buf)
+{
+    MAIN_mem_free(buf);
+}
+
+/**
+ * @brief Find the hint slot of a screen
+ * @param screen Screen object (NULL finds a free slot)
+ * @return image_cache_hint_t* Slot, or NULL
+ */
+static image_cache_hint_t *image_cache_find_hint(lv_obj_t *screen)
+{
+    for (uint8_t i = 0; i < IMAGE_CACHE_MAX_HINT_SCREENS; i++)
+    {
+        if (image_cache_hints[i].screen == screen)
+        {
+            return &image_cache_hints[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Screen events: prefetch on load start, forget hints on delete
+ * @param e LVGL event
+ */
+static void image_cache_screen_event_cb(lv_event_t *e)
+{
+    lv_obj_t *screen = (lv_obj_t *)lv_event_get_target(e);
+
+    if (lv_event_get_code(e) == LV_EVENT_SCREEN_LOAD_START)
+    {
+        MAIN_image_cache_prefetch_screen(screen);
+    }
+    else
+    {
+        image_cache_hint_t *hint = image_cache_find_hint(screen);
+        if (hint != NULL)
+        {
+            memset(hint, 0, sizeof(image_cache_hint_t));
+        }
+    }
+}
+
+/******************************************************************************
+ * Image Cache
+ *****************************************************************************/
+
+/**
+ * @brief Enable the image and header caches
+ * @return true if the decoded image cache is enabled
+ * @note File reads are cached by the 'S' drive itself (MAIN_sdFsLib).
+ */
+bool MAIN_initialise_image_cache(void)
+{
+    memset(image_cache_hints, 0, sizeof(image_cache_hints));
+
+    // Header cache is small, keep it on the LVGL heap
+    lv_image_header_cache_resize(IMAGE_CACHE_HEADER_COUNT, false);
+
+    if (!MAIN_sysinfo_has_psram())
+    {
+#if EARS_DEBUG == 1
+        Serial.println("[IMGCACHE] No PSRAM, decoded image cache disabled");
+#endif
+        return false;
+    }
+
+    // Only the image cache handlers change; widget and font buffers stay put
+    lv_draw_buf_handlers_t *handlers = lv_draw_buf_get_image_handlers();
+    handlers->buf_malloc_cb = image_cache_buf_malloc;
+    handlers->buf_free_cb = image_cache_buf_free;
+
+    lv_image_cache_resize(IMAGE_CACHE_SIZE_BYTES, false);
+    image_cache_enabled = lv_image_cache_is_enabled();
+
+#if EARS_DEBUG == 1
+    Serial.printf("[IMGCACHE] %lu KB decoded image cache in PSRAM, %d headers\n",
+                  (unsigned long)(IMAGE_CACHE_SIZE_BYTES / 1024), IMAGE_CACHE_HEADER_COUNT);
+#endif
+
+    return image_cache_enabled;
+}
+
+/**
+ * @brief Decode an image into the cache now
+ * @param src Image source (e.g. "S:/images/logo.png")
+ * @return true if the image is cached
+ */
+bool MAIN_image_cache_prefetch(const char *src)
+{
+    if (!image_cache_enabled || src == NULL)
+    {
+        return false;
+    }
+
+    // Opening decodes and inserts; closing only drops our reference
+    lv_image_decoder_dsc_t dsc;
+    if (lv_image_decoder_open(&dsc, src, NULL) != LV_RESULT_OK)
+    {
+#if EARS_DEBUG == 1
+        Serial.printf("[IMGCACHE] Prefetch failed: %s\n", src);
+#endif
+        return false;
+    }
+
+    bool cached = (dsc.cache_entry != NULL);
+    lv_image_decoder_close(&dsc);
+    return cached;
+}
+
+/**
+ * @brief Register images a screen shows, prefetched when it starts loading
+ * @param screen Screen object
+ * @param srcs Image sources
+ * @param count Entries in srcs (0 removes the hints)
+ * @return true if registered
+ */
+bool MAIN_image_cache_set_screen_hints(lv_obj_t *screen, const char *const *srcs, uint8_t count)
+{
+    if (screen == NULL)
+    {
+        return false;
+    }
+
+    image_cache_hint_t *hint = image_cache_find_hint(screen);
+
+    if (count == 0 || srcs == NULL)
+    {
+        if (hint != NULL)
+        {
+            lv_obj_remove_event_cb(screen, image_cache_screen_event_cb);
+            memset(hint, 0, sizeof(image_cache_hint_t));
+        }
+        return true;
+    }
+
+    if (hint == NULL)
+    {
+        hint = image_cache_find_hint(NULL);
+        if (hint == NULL)
+        {
+            Serial.println("[IMGCACHE] ERROR: Screen hint table full");
+            return false;
+        }
+        lv_obj_add_event_cb(screen, image_cache_screen_event_cb, LV_EVENT_SCREEN_LOAD_START, NULL);
+        lv_obj_add_event_cb(screen, image_cache_screen_event_cb, LV_EVENT_DELETE, NULL);
+    }
+
+    hint->screen = screen;
+    hint->srcs = srcs;
+    hint->count = count;
+    return true;
+}
+
+/**
+ * @brief Prefetch a screen's hinted images ahead of loading it
+ * @param screen Screen object
+ * @return uint8_t Images now cached
+ */
+uint8_t MAIN_image_cache_prefetch_screen(lv_obj_t *screen)
+{
+    image_cache_hint_t *hint = (screen != NULL) ? image_cache_find_hint(screen) : NULL;
+    if (hint == NULL)
+    {
+        return 0;
+    }
+
+    uint8_t cached = 0;
+    for (uint8_t i = 0; i < hint->count; i++)
+    {
+        if (MAIN_image_cache_prefetch(hint->srcs[i]))
+        {
+            cached++;
+        }
+    }
+
+    return cached;
+}
+
+/**
+ * @brief Drop every decoded image
+ */
+void MAIN_image_cache_clear(void)
+{
+    lv_image_cache_drop(NULL);
+    lv_image_header_cache_drop(NULL);
+}
+
+/**
+ * @brief Check if the decoded image cache is enabled
+ * @return true after a successful MAIN_initialise_image_cache()
+ */
+bool MAIN_image_cache_is_enabled(void)
+{
+    return image_cache_enabled;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_ImageCache_getLibraryName() {
+    return MAIN_ImageCache::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_ImageCache_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_ImageCache::VERSION_MAJOR,
+                       MAIN_ImageCache::VERSION_MINOR,
+                       MAIN_ImageCache::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_ImageCache_getVersionDate() {
+    return MAIN_ImageCache::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_ImageCache_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_ImageCache_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_imageCacheLib.cpp
+ ******************************************************************************/
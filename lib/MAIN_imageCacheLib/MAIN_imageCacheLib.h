@@ -0,0 +1,117 @@
+/**
+ * @file MAIN_imageCacheLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Decoded image cache for SD-hosted images (PNG/JPG/BMP) in PSRAM
+ * @details Enables LVGL's image cache (LRU, bounded by decoded bytes) and
+ *          moves its decoded buffers out of the small LVGL heap into PSRAM,
+ *          so an SD image is decoded once and redrawn from memory after
+ *          that. Also enables the image header cache; file reads are
+ *          cached by the 'S' drive (MAIN_sdFsLib).
+ *
+ *          Screens can register prefetch hints: the listed images are
+ *          decoded into the cache when the screen starts loading, or ahead
+ *          of time with MAIN_image_cache_prefetch_screen().
+ *
+ *          Without PSRAM the cache stays disabled (LV_CACHE_DEF_SIZE 0)
+ *          rather than competing with widgets for the LVGL heap.
+ * @version 1.0.2
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_IMAGE_CACHE_LIB_H__
+#define __MAIN_IMAGE_CACHE_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include <lvgl.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_ImageCache
+{
+    constexpr const char* LIB_NAME = "MAIN_ImageCache";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "2";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_ImageCache_getLibraryName();
+uint32_t MAIN_ImageCache_getVersionEncoded();
+const char* MAIN_ImageCache_getVersionDate();
+void MAIN_ImageCache_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Image Cache Configuration
+ *****************************************************************************/
+
+// Decoded image budget in PSRAM (bytes, least recently used evicted first)
+#define IMAGE_CACHE_SIZE_BYTES (2 * 1024 * 1024)
+
+// Image headers kept (saves reopening files just to size a widget)
+#define IMAGE_CACHE_HEADER_COUNT 32
+
+// Screens that can hold prefetch hints
+#define IMAGE_CACHE_MAX_HINT_SCREENS 8
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Enable the image and header caches
+ * @return true if the decoded image cache is enabled (PSRAM present)
+ * @note Call after MAIN_initialise_lvgl() and before any image is shown.
+ */
+bool MAIN_initialise_image_cache(void);
+
+/**
+ * @brief Decode an image into the cache now
+ * @param src Image source (e.g. "S:/images/logo.png")
+ * @return true if the image is cached
+ * @note Call from the LVGL task.
+ */
+bool MAIN_image_cache_prefetch(const char *src);
+
+/**
+ * @brief Register images a screen shows, prefetched when it starts loading
+ * @param screen Screen object
+ * @param srcs Image sources (array and strings must outlive the screen)
+ * @param count Entries in srcs (0 removes the hints)
+ * @return true if registered, false if the hint table is full
+ */
+bool MAIN_image_cache_set_screen_hints(lv_obj_t *screen, const char *const *srcs, uint8_t count);
+
+/**
+ * @brief Prefetch a screen's hinted images ahead of loading it
+ * @param screen Screen object
+ * @return uint8_t Images now cached
+ * @note Call from the LVGL task.
+ */
+uint8_t MAIN_image_cache_prefetch_screen(lv_obj_t *screen);
+
+/**
+ * @brief Drop every decoded image (e.g. after replacing files on the SD)
+ */
+void MAIN_image_cache_clear(void);
+
+/**
+ * @brief Check if the decoded image cache is enabled
+ * @return true after a successful MAIN_initialise_image_cache()
+ */
+bool MAIN_image_cache_is_enabled(void);
+
+#endif // __MAIN_IMAGE_CACHE_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_imageCacheLib.h
+ ******************************************************************************/
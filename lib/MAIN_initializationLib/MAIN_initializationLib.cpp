@@ -2,13 +2,46 @@
  * @file MAIN_initializationLib.cpp
  * @author JTB & Claude Sonnet 4.5
  * @brief Centralized initialization functions for EARS subsystems
- * @version 0.1.0
- * @date 20260210
+ * @version 1.12.1
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
 
 #include "MAIN_initializationLib.h"
+#include "EARS_auditLib.h"
+#include "EARS_configLib.h"
+#include "EARS_errorsLib.h"
+#include "EARS_gestureLib.h"
+#include "EARS_peerSyncLib.h"
+#include "EARS_recordStoreLib.h"
+#include "EARS_searchIndexLib.h"
+#include "EARS_sdCryptLib.h"
+#include "EARS_syncLib.h"
+#include "EARS_taskPlanLib.h"
+#include "MAIN_bootProfilerLib.h"
+#include <esp_timer.h>
+
+/******************************************************************************
+ * Boot Orchestrator Types
+ *****************************************************************************/
+
+enum BootStageState
+{
+    BOOT_PENDING,
+    BOOT_RUNNING,
+    BOOT_DONE,
+    BOOT_FAILED,
+    BOOT_SKIPPED
+};
+
+typedef struct
+{
+    volatile uint8_t state; // BootStageState
+    int8_t core;            // Core it ran on (-1 = not run)
+    int64_t startUs;        // Relative to MAIN_boot_run()
+    int64_t durationUs;
+} boot_stage_record_t;
 
 /******************************************************************************
  * Global State Variables
@@ -18,26 +51,34 @@ volatile bool touch_initialized = false;
 volatile NVSInitState nvs_state = NVS_NOT_INITIALIZED;
 volatile SDCardState sd_card_state = SD_NOT_INITIALIZED;
 
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static const MAIN_boot_stage_t *boot_stages = NULL;
+static uint8_t boot_stage_count = 0;
+static boot_stage_record_t boot_records[BOOT_MAX_STAGES];
+static int64_t boot_start_us = 0;
+static int64_t boot_total_us = 0;
+static TaskHandle_t boot_main_task = NULL;
+static TaskHandle_t boot_worker_task = NULL;
+static volatile bool boot_worker_done = false;
+static portMUX_TYPE boot_mux = portMUX_INITIALIZER_UNLOCKED;
+
 /******************************************************************************
  * Touch Controller Initialization
  *****************************************************************************/
 
 /**
- * @brief Initialize Touch Controller
- * @details Uses EARS_touchLib::performFullInitialization()
+ * @brief Bring up the touch controller
+ * @param registerIndev Also register the LVGL input device (LVGL task only)
  */
-void MAIN_initialise_touch()
+static void touch_start(bool registerIndev)
 {
-    // Guard against duplicate initialization
-    if (touch_state != TOUCH_NOT_INITIALIZED)
-    {
-#if EARS_DEBUG == 1
-        Serial.println("[TOUCH] Already initialized, skipping");
-#endif
-        return;
-    }
+    // Touch INT wakes the UI task so samples are handled without polling
+    using_touch().setInterruptCallback(MAIN_core0_request_update_from_isr);
 
-    TouchInitResult result = using_touch().performFullInitialization(TOUCH_SDA, TOUCH_SCL);
+    TouchInitResult result = using_touch().performFullInitialization(TOUCH_SDA, TOUCH_SCL, TOUCH_INT, registerIndev);
     touch_state = result.state;
 
     switch (result.state)
@@ -52,11 +93,18 @@ void MAIN_initialise_touch()
         break;
 
     case TOUCH_READY:
+#if TOUCH_SAMPLING_TASK_ENABLED == 1
+        // Sample on a dedicated task; each new event wakes the UI task
+        using_touch().setEventCallback(MAIN_core0_request_update);
+        using_touch().startSamplingTask();
+#endif
 #if EARS_DEBUG == 1
         Serial.printf("[OK] Touch ready: %s\n", result.modelName.c_str());
         Serial.printf("     I2C: 0x%02X @ SDA=%d, SCL=%d\n",
                       result.i2cAddress, result.sdaPin, result.sclPin);
         Serial.printf("     Max Touch Points: %d\n", result.maxTouchPoints);
+        Serial.printf("     Interrupt: %s\n", result.interruptEnabled ? "TOUCH_INT" : "polled");
+        Serial.printf("     Sampling: %s\n", using_touch().isSamplingTaskRunning() ? "dedicated task" : "LVGL indev");
         MAIN_led_success_pattern();
 #endif
         touch_initialized = true;
@@ -67,6 +115,56 @@ void MAIN_initialise_touch()
     }
 }
 
+/**
+ * @brief Initialize Touch Controller
+ * @details Uses EARS_touchLib::performFullInitialization()
+ */
+void MAIN_initialise_touch()
+{
+    // After MAIN_probe_touch() only the LVGL input device is left
+    if (touch_state == TOUCH_READY)
+    {
+        using_touch().registerInputDevice();
+    }
+    else if (touch_state != TOUCH_NOT_INITIALIZED)
+    {
+        // Guard against duplicate initialization
+#if EARS_DEBUG == 1
+        Serial.println("[TOUCH] Already initialized, skipping");
+#endif
+        return;
+    }
+    else
+    {
+        touch_start(true);
+    }
+
+#if TOUCH_SAMPLING_TASK_ENABLED == 1
+    // Gestures are recognised on the sampling task and sent as LVGL events
+    if (touch_state == TOUCH_READY)
+    {
+        using_gesture().begin(using_touch());
+    }
+#endif
+}
+
+/**
+ * @brief Probe the touch controller without touching LVGL
+ */
+void MAIN_probe_touch()
+{
+    // Guard against duplicate initialization
+    if (touch_state != TOUCH_NOT_INITIALIZED)
+    {
+#if EARS_DEBUG == 1
+        Serial.println("[TOUCH] Already initialized, skipping");
+#endif
+        return;
+    }
+
+    touch_start(false);
+}
+
 /******************************************************************************
  * NVS (Non-Volatile Storage) Initialization
  *****************************************************************************/
@@ -215,6 +313,358 @@ void MAIN_initialise_sd()
     }
 }
 
+/******************************************************************************
+ * Flash Filesystem Initialization
+ *****************************************************************************/
+
+/**
+ * @brief Mount LittleFS and load ears.config from it
+ * @return true if the config file was read
+ */
+bool MAIN_initialise_flashfs()
+{
+    FlashFsInitResult result = using_flashfs().performFullInitialization();
+    if (result.state != SD_CARD_READY)
+    {
+        return false;
+    }
+
+    // Defaults (and a write-back) if the file is missing
+    bool loaded = using_config().begin(&using_flashfs());
+
+#if EARS_DEBUG == 1
+    Serial.printf("[OK] ears.config %s from flash (%lu us)\n", loaded ? "loaded" : "defaults",
+                  (unsigned long)using_config().getLoadReport().parseUs);
+#endif
+
+    // Tasks are placed at boot, so a Wi-Fi change moves them at the next one
+    if (using_taskplan().setRadioActive(using_config().network().wifiEnabled))
+    {
+        DEBUG_PRINTLN("[TASKS] network.wifi_enabled changed, task plan follows at the next boot");
+    }
+    return loaded;
+}
+
+/******************************************************************************
+ * Error Messages Initialization
+ *****************************************************************************/
+
+/**
+ * @brief Load the error messages (errors.json in flash, else on the card)
+ * @return true if loaded
+ */
+bool MAIN_initialise_errors()
+{
+    EARS_sdCard *jsonStore = &using_sdcard();
+    if (using_flashfs().isAvailable() && using_flashfs().fileExists("/config/errors.json"))
+    {
+        jsonStore = &using_flashfs();
+    }
+    return errorsLib.begin("/config/errors.json", "/logs/error_log.txt", &using_sdcard(), jsonStore);
+}
+
+/******************************************************************************
+ * Record Store Initialization
+ *****************************************************************************/
+
+/**
+ * @brief Open the equipment and ammunition record stores
+ * @details The equipment search index follows the store from here on, so
+ *          it is opened before anything can write to it. With
+ *          EARS_SD_ENCRYPT the stores stay closed if the keys cannot be set
+ *          up, rather than starting new plaintext files beside encrypted ones.
+ *          With EARS_PEER_SYNC the stores are also shared with nearby units
+ *          that hold the same security.peer_key.
+ *          The audit trail follows the ammunition store before anything
+ *          else can write to it.
+ * @return true if both stores and the search index are ready
+ */
+bool MAIN_initialise_records()
+{
+#if EARS_SD_ENCRYPT == 1
+    EARS_sdCrypt *crypt = &using_sdcrypt();
+    crypt->begin(&using_nvseeprom());
+#else
+    EARS_sdCrypt *crypt = nullptr;
+#endif
+
+    bool equipment = using_equipment().begin(&using_sdcard(), "equipment", RECORD_EQUIPMENT, crypt);
+    bool ammunition = using_ammunition().begin(&using_sdcard(), "ammunition", RECORD_AMMUNITION, crypt);
+    bool search = equipment && using_equipment_search().begin(&using_sdcard(), &using_equipment(), "equipment");
+
+#if EARS_AUDIT == 1
+    // Every ammunition change is chained into the audit trail from here on
+    if (ammunition && using_audit().begin(&using_sdcard(), &using_nvseeprom()))
+    {
+        using_audit().attach(&using_ammunition());
+    }
+#endif
+
+    // Delta sync follows the stores; it stays idle until ears.config enables it
+    if (equipment && ammunition)
+    {
+        using_sync().addStore(&using_equipment(), "equipment");
+        using_sync().addStore(&using_ammunition(), "ammunition");
+        using_sync().begin(&using_sdcard());
+#if EARS_PEER_SYNC == 1
+        using_peersync().addStore(&using_equipment(), "equipment");
+        using_peersync().addStore(&using_ammunition(), "ammunition");
+        using_peersync().begin(&using_sdcard(), using_config().security().peerKey);
+#endif
+    }
+    return equipment && ammunition && search;
+}
+
+/******************************************************************************
+ * Boot Orchestrator
+ *****************************************************************************/
+
+/**
+ * @brief Claim the next stage this worker may run (boot_mux held)
+ * @param onMain true for the calling task, which may also run BOOT_MAIN_TASK stages
+ * @param finished Receives true once no stage is pending or running
+ * @return int8_t Stage index, or -1 if none is ready for this worker
+ */
+static int8_t boot_claim_locked(bool onMain, bool *finished)
+{
+    bool changed = true;
+
+    // Skipping a stage can unblock (skip) the ones after it, so repeat until stable
+    while (changed)
+    {
+        changed = false;
+        bool busy = false;
+        bool anyReady = false;
+        int8_t claim = -1;
+
+        for (uint8_t i = 0; i < boot_stage_count; i++)
+        {
+            if (boot_records[i].state == BOOT_RUNNING)
+            {
+                busy = true;
+                continue;
+            }
+            if (boot_records[i].state != BOOT_PENDING)
+            {
+                continue;
+            }
+            busy = true;
+
+            bool waiting = false;
+            bool blocked = false;
+            for (uint8_t d = 0; d < boot_stage_count; d++)
+            {
+                if ((boot_stages[i].after & BOOT_AFTER(d)) == 0)
+                {
+                    continue;
+                }
+                uint8_t depState = boot_records[d].state;
+                if (depState == BOOT_FAILED || depState == BOOT_SKIPPED)
+                {
+                    blocked = true;
+                }
+                else if (depState != BOOT_DONE)
+                {
+                    waiting = true;
+                }
+            }
+
+            if (blocked)
+            {
+                boot_records[i].state = BOOT_SKIPPED;
+                changed = true;
+                continue;
+            }
+            if (waiting)
+            {
+                continue;
+            }
+
+            anyReady = true;
+            if (claim < 0 && (onMain || (boot_stages[i].flags & BOOT_MAIN_TASK) == 0))
+            {
+                claim = i;
+            }
+        }
+
+        if (changed)
+        {
+            continue;
+        }
+
+        if (claim >= 0)
+        {
+            boot_records[claim].state = BOOT_RUNNING;
+            *finished = false;
+            return claim;
+        }
+
+        // Pending stages that nothing running can ever release form a cycle
+        bool running = false;
+        for (uint8_t i = 0; i < boot_stage_count; i++)
+        {
+            running |= (boot_records[i].state == BOOT_RUNNING);
+        }
+        if (busy && !anyReady && !running)
+        {
+            for (uint8_t i = 0; i < boot_stage_count; i++)
+            {
+                if (boot_records[i].state == BOOT_PENDING)
+                {
+                    boot_records[i].state = BOOT_SKIPPED;
+                }
+            }
+            Serial.println("[BOOT] Warning: Stage dependency cycle, remaining stages skipped");
+            busy = false;
+        }
+
+        *finished = !busy;
+    }
+    return -1;
+}
+
+/**
+ * @brief Run stages until every stage has finished
+ * @param onMain true for the calling task
+ */
+static void boot_work(bool onMain)
+{
+    TaskHandle_t other = onMain ? boot_worker_task : boot_main_task;
+
+    while (true)
+    {
+        bool finished = false;
+
+        taskENTER_CRITICAL(&boot_mux);
+        int8_t index = boot_claim_locked(onMain, &finished);
+        taskEXIT_CRITICAL(&boot_mux);
+
+        if (index < 0)
+        {
+            if (finished)
+            {
+                break;
+            }
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(BOOT_POLL_MS));
+            continue;
+        }
+
+        boot_stage_record_t *record = &boot_records[index];
+        record->core = (int8_t)xPortGetCoreID();
+        record->startUs = esp_timer_get_time() - boot_start_us;
+        bool ok = boot_stages[index].fn();
+        record->durationUs = esp_timer_get_time() - boot_start_us - record->startUs;
+        MAIN_boot_profile_stage(boot_stages[index].name, boot_start_us + record->startUs,
+                                boot_start_us + record->startUs + record->durationUs, record->core);
+
+        taskENTER_CRITICAL(&boot_mux);
+        record->state = ok ? BOOT_DONE : BOOT_FAILED;
+        taskEXIT_CRITICAL(&boot_mux);
+
+        // A finished stage may release one the other worker is waiting for
+        if (other != NULL)
+        {
+            xTaskNotifyGive(other);
+        }
+    }
+}
+
+/**
+ * @brief Temporary worker task on BOOT_WORKER_CORE
+ * @param parameter Task parameter (unused)
+ */
+static void boot_worker(void *parameter)
+{
+    boot_work(false);
+    boot_worker_done = true;
+    xTaskNotifyGive(boot_main_task);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Run boot stages in dependency order on both cores
+ * @param stages Stage table
+ * @param count Stages
+ * @return true unless a BOOT_CRITICAL stage failed or was skipped
+ */
+bool MAIN_boot_run(const MAIN_boot_stage_t *stages, uint8_t count)
+{
+    if (stages == NULL || count == 0 || count > BOOT_MAX_STAGES)
+    {
+        return false;
+    }
+
+    boot_stages = stages;
+    boot_stage_count = count;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        boot_records[i].state = BOOT_PENDING;
+        boot_records[i].core = -1;
+        boot_records[i].startUs = 0;
+        boot_records[i].durationUs = 0;
+    }
+
+    boot_start_us = esp_timer_get_time();
+    boot_main_task = xTaskGetCurrentTaskHandle();
+    boot_worker_done = false;
+    boot_worker_task = NULL;
+
+    // Without the worker every stage simply runs here, in table order
+    if (xTaskCreatePinnedToCore(boot_worker, "Boot", BOOT_WORKER_STACK_SIZE, NULL, BOOT_WORKER_PRIORITY,
+                                &boot_worker_task, BOOT_WORKER_CORE) != pdPASS)
+    {
+        boot_worker_task = NULL;
+        boot_worker_done = true;
+        Serial.println("[BOOT] Warning: No boot worker, stages run in sequence");
+    }
+
+    boot_work(true);
+
+    // The worker's last stage may still be finishing its bookkeeping
+    while (!boot_worker_done)
+    {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(BOOT_POLL_MS));
+    }
+    boot_worker_task = NULL;
+    boot_total_us = esp_timer_get_time() - boot_start_us;
+
+    bool ok = true;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if ((stages[i].flags & BOOT_CRITICAL) && boot_records[i].state != BOOT_DONE)
+        {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief Print each stage's core, start, duration and result
+ */
+void MAIN_boot_print_report()
+{
+    static const char *const results[] = {"pending", "running", "ok", "FAILED", "skipped"};
+    int64_t sequentialUs = 0;
+
+    Serial.println("[BOOT] Stage            Core  Start ms   Time ms  Result");
+    for (uint8_t i = 0; i < boot_stage_count; i++)
+    {
+        const boot_stage_record_t *record = &boot_records[i];
+        sequentialUs += record->durationUs;
+
+        if (record->core < 0)
+        {
+            Serial.printf("[BOOT] %-16s    -         -         -  %s\n", boot_stages[i].name, results[record->state]);
+            continue;
+        }
+        Serial.printf("[BOOT] %-16s %4d %9.1f %9.1f  %s\n", boot_stages[i].name, record->core,
+                      record->startUs / 1000.0, record->durationUs / 1000.0, results[record->state]);
+    }
+    Serial.printf("[BOOT] Total %.1f ms (%.1f ms if run in sequence)\n", boot_total_us / 1000.0,
+                  sequentialUs / 1000.0);
+}
+
 /******************************************************************************
  * Library Version Information Getters
  *****************************************************************************/
@@ -2,14 +2,25 @@
  * @file MAIN_initializationLib.h
  * @author JTB & Claude Sonnet 4.5
  * @brief Centralized initialization functions for EARS subsystems
- * @version 0.1.0
- * @date 20260210
+ * @version 1.12.1
+ * @date 20261015
  *
  * @details
  * This library consolidates initialization functions for Touch, NVS, and SD Card
  * subsystems, reducing clutter in main.cpp and providing a clean interface for
  * system startup sequencing.
  *
+ * The boot orchestrator (MAIN_boot_run) runs a table of stages with
+ * dependencies on two workers: the calling task (setup, Core 1) and a
+ * temporary worker on BOOT_WORKER_CORE. A stage starts once every stage it
+ * depends on has finished; stages flagged BOOT_MAIN_TASK (anything touching
+ * LVGL or the display) only run on the calling task, the rest on whichever
+ * worker is free. So SD mount, NVS validation, touch probing and errors.json
+ * run while the display and LVGL come up. ears.config is read from internal
+ * flash (EARS_flashFs), so nothing that configures the system waits for
+ * the card. A failed stage skips the stages
+ * that depend on it, and MAIN_boot_print_report() shows when each ran.
+ *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
 
@@ -21,12 +32,16 @@
  * Includes
  *****************************************************************************/
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include "EARS_versionDef.h"
 #include "EARS_systemDef.h"
 #include "EARS_ws35tlcdPins.h" // Hardware pin definitions (TOUCH_SDA, TOUCH_SCL)
 #include "EARS_touchLib.h"
 #include "EARS_nvsEepromLib.h"
 #include "EARS_sdCardLib.h"
+#include "EARS_flashFsLib.h"
+#include "MAIN_core0TasksLib.h" // UI task wake-up from touch INT
 
 // LED library for status indication (debug builds only)
 #if EARS_DEBUG == 1
@@ -40,11 +55,47 @@ namespace MAIN_Initialization
 {
     constexpr const char *LIB_NAME = "MAIN_Initialization";
     constexpr const char *VERSION_MAJOR = "1";
-    constexpr const char *VERSION_MINOR = "0";
-    constexpr const char *VERSION_PATCH = "0";
-    constexpr const char *VERSION_DATE = "2026-02-10";
+    constexpr const char *VERSION_MINOR = "12";
+    constexpr const char *VERSION_PATCH = "1";
+    constexpr const char *VERSION_DATE = "2026-10-15";
 }
 
+/******************************************************************************
+ * Boot Orchestrator Configuration
+ *****************************************************************************/
+
+// Stages in one MAIN_boot_run() table
+#define BOOT_MAX_STAGES 16
+
+// Temporary worker for stages that may leave the calling task
+#define BOOT_WORKER_CORE 0
+#define BOOT_WORKER_PRIORITY 1
+#define BOOT_WORKER_STACK_SIZE 6144 // Words (SD mount and JSON parsing)
+
+// Wait between checks for a stage whose dependencies are still running
+#define BOOT_POLL_MS 2
+
+// Stage flags
+#define BOOT_MAIN_TASK 0x01 // Run on the calling task (LVGL, display)
+#define BOOT_CRITICAL 0x02  // MAIN_boot_run() fails if this stage fails
+
+// Dependency mask bit of the stage at a table index
+#define BOOT_AFTER(index) (1UL << (index))
+
+/******************************************************************************
+ * Boot Orchestrator Types
+ *****************************************************************************/
+
+typedef bool (*MAIN_boot_fn_t)(void);
+
+typedef struct
+{
+    const char *name;  // Shown in the report
+    MAIN_boot_fn_t fn; // Returns false on failure
+    uint32_t after;    // BOOT_AFTER() bits of the stages to wait for
+    uint8_t flags;     // BOOT_MAIN_TASK, BOOT_CRITICAL
+} MAIN_boot_stage_t;
+
 /******************************************************************************
  * NVS State Machine
  *****************************************************************************/
@@ -81,6 +132,14 @@ extern volatile SDCardState sd_card_state;
  */
 void MAIN_initialise_touch();
 
+/**
+ * @brief Probe the touch controller without touching LVGL
+ * @details Same as MAIN_initialise_touch() except for the LVGL input device,
+ *          which the next MAIN_initialise_touch() call registers. Safe on a
+ *          task other than LVGL's while LVGL starts.
+ */
+void MAIN_probe_touch();
+
 /**
  * @brief Initialize NVS (Non-Volatile Storage)
  * @details Uses EARS_nvsEepromLib::performFullInitialization()
@@ -98,6 +157,51 @@ void MAIN_initialise_nvs();
  */
 void MAIN_initialise_sd();
 
+/**
+ * @brief Mount the internal flash filesystem and load ears.config from it
+ * @details Uses EARS_flashFsLib::performFullInitialization(), then
+ *          EARS_config::begin() on the flash filesystem: no SD card needed
+ * @return true if the config file was read
+ */
+bool MAIN_initialise_flashfs();
+
+/**
+ * @brief Load the error messages (errors.json in flash, else on the card)
+ * @details Uses EARS_errors::begin(); the built-in table is used without a
+ *          file. The error log stays on the SD card.
+ * @return true if loaded
+ */
+bool MAIN_initialise_errors();
+
+/**
+ * @brief Open the equipment and ammunition record stores
+ * @details Uses EARS_recordStore::begin() on the SD card (encrypted with
+ *          EARS_SD_ENCRYPT 1); each store replays records newer than its
+ *          index checkpoint, then the equipment search index is loaded or
+ *          rebuilt and the delta sync task started
+ * @return true if both stores and the search index are ready
+ */
+bool MAIN_initialise_records();
+
+/******************************************************************************
+ * Boot Orchestrator Functions
+ *****************************************************************************/
+
+/**
+ * @brief Run boot stages in dependency order on both cores
+ * @param stages Stage table (BOOT_AFTER() refers to indices in it)
+ * @param count Stages (up to BOOT_MAX_STAGES)
+ * @return true unless a BOOT_CRITICAL stage failed or was skipped
+ * @note Returns once every stage has finished. Dependency cycles are
+ *       reported and their stages skipped.
+ */
+bool MAIN_boot_run(const MAIN_boot_stage_t *stages, uint8_t count);
+
+/**
+ * @brief Print each stage's core, start, duration and result
+ */
+void MAIN_boot_print_report();
+
 /******************************************************************************
  * Version Information Getters
  *****************************************************************************/
@@ -0,0 +1,477 @@
+/**
+ * @file MAIN_inputReplayLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Input record and replay, for frame-time comparisons between builds
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_inputReplayLib.h"
+#include "EARS_sdCardLib.h"
+#include "MAIN_jobSchedulerLib.h"
+#include "MAIN_lvglLib.h"
+
+// Flow screen shown (src/ui/eez-flow.cpp)
+extern "C" int16_t eez_flow_get_current_screen();
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+// No screen check pending
+#define INPUT_REPLAY_NO_SCREEN INT16_MIN
+
+// Header and records in one PSRAM block, written and read as one file
+static uint8_t *replay_buffer = NULL;
+static MAIN_input_script_header_t *replay_header = NULL;
+static MAIN_input_record_t *replay_records = NULL;
+static bool replay_loaded = false;
+
+// Wrapped device and its own read callback
+static lv_indev_t *replay_indev = NULL;
+static lv_indev_read_cb_t replay_read_cb = NULL;
+
+// Recording and replay position (UI task)
+static volatile MAIN_input_replay_state_t replay_state = INPUT_REPLAY_IDLE;
+static uint32_t replay_start_ms = 0;
+static uint32_t replay_cursor = 0;
+static uint32_t replay_settle_ms = 0;
+static uint8_t replay_kind = INPUT_RECORD_RELEASED;
+static int16_t replay_x = 0;
+static int16_t replay_y = 0;
+static int16_t replay_screen = INPUT_REPLAY_NO_SCREEN;
+
+// Set while a Core 1 job writes the buffer or the results
+static volatile bool replay_writing = false;
+
+// Counters taken at the end of a replay, written by the results job
+static MAIN_lvgl_stats_t replay_lvgl;
+
+static MAIN_input_replay_stats_t replay_stats;
+
+/******************************************************************************
+ * Core 1 Jobs
+ *****************************************************************************/
+
+/**
+ * @brief Write the recorded script
+ */
+static void input_replay_save(void *ctx)
+{
+    (void)ctx;
+    EARS_sdCard &sd = using_sdcard();
+    size_t length = sizeof(MAIN_input_script_header_t) + replay_header->count * sizeof(MAIN_input_record_t);
+    replay_stats.saved = sd.isAvailable() && sd.createDirectory(INPUT_REPLAY_DIR) &&
+                         sd.writeFileAtomic(INPUT_REPLAY_PATH, replay_buffer, length);
+    replay_writing = false;
+
+    Serial.printf("[REPLAY] %lu samples over %lu ms %s\n", (unsigned long)replay_header->count,
+                  (unsigned long)replay_header->durationMs,
+                  replay_stats.saved ? "saved to " INPUT_REPLAY_PATH : "not saved (no SD card)");
+}
+
+/**
+ * @brief Append the replay's row to the results file
+ */
+static void input_replay_write_results(void *ctx)
+{
+    (void)ctx;
+    const MAIN_lvgl_stats_t *lvgl = &replay_lvgl;
+    uint32_t frames = lvgl->frames;
+    uint32_t flushes = lvgl->flushCalls;
+
+    char row[320];
+    int length = snprintf(row, sizeof(row), "%llu,%s.%s.%s,%llu,%lu,%lu,%lu,%lu,%lu,%lu,%lu",
+                          (unsigned long long)EARS_APP_BUILD_TIMESTAMP,
+                          EARS_APP_VERSION_MAJOR, EARS_APP_VERSION_MINOR, EARS_APP_VERSION_PATCH,
+                          (unsigned long long)replay_header->build, (unsigned long)replay_header->durationMs,
+                          (unsigned long)replay_stats.replayed, (unsigned long)replay_stats.divergences,
+                          (unsigned long)replay_stats.maxLateMs, (unsigned long)frames,
+                          (unsigned long)(frames ? lvgl->totalFrameUs / frames : 0),
+                          (unsigned long)lvgl->maxFrameUs);
+    for (uint8_t i = 0; i < LVGL_STATS_HIST_BUCKETS; i++)
+    {
+        length += snprintf(row + length, sizeof(row) - length, ",%lu", (unsigned long)lvgl->frameHistogram[i]);
+    }
+    snprintf(row + length, sizeof(row) - length, ",%lu,%lu,%lu\n",
+             (unsigned long)(flushes ? lvgl->totalFlushUs / flushes : 0), (unsigned long)lvgl->maxFlushUs,
+             (unsigned long)lvgl->maxHandlerUs);
+
+    Serial.printf("[REPLAY] Run %lu: %s", (unsigned long)replay_stats.runs, row);
+
+    EARS_sdCard &sd = using_sdcard();
+    bool saved = sd.isAvailable() && sd.createDirectory(INPUT_REPLAY_DIR);
+    if (saved && !sd.fileExists(INPUT_REPLAY_CSV_PATH))
+    {
+        saved = sd.appendFile(INPUT_REPLAY_CSV_PATH,
+                              "build,version,script_build,script_ms,samples,divergences,max_late_ms,"
+                              "frames,avg_frame_us,max_frame_us,f_lt2,f_lt4,f_lt8,f_lt16,f_lt33,f_lt66,"
+                              "f_ge66,avg_flush_us,max_flush_us,max_handler_us\n");
+    }
+    if (saved)
+    {
+        saved = sd.appendFile(INPUT_REPLAY_CSV_PATH, row);
+        sd.flush(INPUT_REPLAY_CSV_PATH);
+    }
+    replay_stats.saved = saved;
+    replay_writing = false;
+
+    if (replay_stats.divergences > 0)
+    {
+        Serial.printf("[REPLAY] WARNING: %lu touches on another screen, run did not follow the script\n",
+                      (unsigned long)replay_stats.divergences);
+    }
+}
+
+/**
+ * @brief Hand a write to Core 1
+ */
+static void input_replay_post(MAIN_job_fn_t fn)
+{
+    replay_writing = true;
+    if (MAIN_job_add("replay", fn, NULL, 0, 0, JOB_PRIORITY_LOW, 0) == JOB_INVALID)
+    {
+        Serial.println("[REPLAY] ERROR: No job slot, nothing written");
+        replay_writing = false;
+    }
+}
+
+/******************************************************************************
+ * UI Task
+ *****************************************************************************/
+
+/**
+ * @brief Append one record, ending the recording when the buffer is full
+ */
+static void input_replay_append(uint32_t ms, MAIN_input_record_kind_t kind, int16_t x, int16_t y)
+{
+    if (replay_header->count == INPUT_REPLAY_MAX_RECORDS)
+    {
+        replay_stats.overflows++;
+        MAIN_input_replay_stop();
+        return;
+    }
+
+    MAIN_input_record_t *record = &replay_records[replay_header->count++];
+    memset(record, 0, sizeof(*record));
+    record->ms = ms;
+    record->kind = (uint8_t)kind;
+    record->x = x;
+    record->y = y;
+}
+
+/**
+ * @brief Log the device's report if it changed, and the flow screen if it did
+ */
+static void input_replay_record(const lv_indev_data_t *data)
+{
+    uint32_t now = millis() - replay_start_ms;
+    if (now >= INPUT_REPLAY_RECORD_MS)
+    {
+        MAIN_input_replay_stop();
+        return;
+    }
+
+    int16_t screen = eez_flow_get_current_screen();
+    if (screen != replay_screen)
+    {
+        replay_screen = screen;
+        input_replay_append(now, INPUT_RECORD_SCREEN, screen, 0);
+    }
+
+    uint8_t kind = (data->state == LV_INDEV_STATE_PRESSED) ? INPUT_RECORD_PRESSED : INPUT_RECORD_RELEASED;
+    int16_t x = (int16_t)data->point.x;
+    int16_t y = (int16_t)data->point.y;
+
+    // Edges always; moves while pressed
+    if (kind != replay_kind || (kind == INPUT_RECORD_PRESSED && (x != replay_x || y != replay_y)))
+    {
+        replay_kind = kind;
+        replay_x = x;
+        replay_y = y;
+        input_replay_append(now, (MAIN_input_record_kind_t)kind, x, y);
+    }
+}
+
+/**
+ * @brief Report the script's state for now: one due sample per read
+ */
+static void input_replay_play(lv_indev_data_t *data)
+{
+    uint32_t now = millis() - replay_start_ms;
+    uint32_t count = replay_header->count;
+
+    // Screen markers set the screen the next touch must land on
+    while (replay_cursor < count && replay_records[replay_cursor].kind == INPUT_RECORD_SCREEN &&
+           replay_records[replay_cursor].ms <= now)
+    {
+        replay_screen = replay_records[replay_cursor++].x;
+    }
+
+    if (replay_state == INPUT_REPLAY_PLAYING && replay_cursor < count && replay_records[replay_cursor].ms <= now)
+    {
+        const MAIN_input_record_t *record = &replay_records[replay_cursor++];
+        if (replay_screen != INPUT_REPLAY_NO_SCREEN)
+        {
+            if (replay_screen != eez_flow_get_current_screen())
+            {
+                replay_stats.divergences++;
+            }
+            replay_screen = INPUT_REPLAY_NO_SCREEN;
+        }
+
+        replay_kind = record->kind;
+        replay_x = record->x;
+        replay_y = record->y;
+        replay_stats.replayed++;
+        if (now - record->ms > replay_stats.maxLateMs)
+        {
+            replay_stats.maxLateMs = now - record->ms;
+        }
+
+        // Several due (a late read): LVGL reads again at once, so none is skipped
+        data->continue_reading = replay_cursor < count && replay_records[replay_cursor].kind != INPUT_RECORD_SCREEN &&
+                                 replay_records[replay_cursor].ms <= now;
+    }
+
+    data->state = (replay_kind == INPUT_RECORD_PRESSED) ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    data->point.x = replay_x;
+    data->point.y = replay_y;
+
+    if (replay_state == INPUT_REPLAY_PLAYING && replay_cursor >= count)
+    {
+        replay_state = INPUT_REPLAY_SETTLING;
+        replay_settle_ms = now;
+    }
+    else if (replay_state == INPUT_REPLAY_SETTLING && now - replay_settle_ms >= INPUT_REPLAY_SETTLE_MS)
+    {
+        // Counters cover the script and the frames it set off
+        MAIN_lvgl_get_stats(&replay_lvgl);
+        replay_state = INPUT_REPLAY_IDLE;
+        replay_stats.runs++;
+        input_replay_post(input_replay_write_results);
+    }
+}
+
+/**
+ * @brief Read callback in place of the device's own
+ */
+static void input_replay_read(lv_indev_t *indev, lv_indev_data_t *data)
+{
+    if (replay_state == INPUT_REPLAY_PLAYING || replay_state == INPUT_REPLAY_SETTLING)
+    {
+        // The panel is still read, so its event ring drains, but not reported
+        lv_indev_data_t panel = *data;
+        replay_read_cb(indev, &panel);
+        input_replay_play(data);
+        return;
+    }
+
+    replay_read_cb(indev, data);
+    if (replay_state == INPUT_REPLAY_RECORDING)
+    {
+        input_replay_record(data);
+    }
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Wrap an input device's read callback and start the boot mode
+ */
+bool MAIN_initialise_input_replay(lv_indev_t *indev, uint8_t mode)
+{
+    if (replay_indev != NULL)
+    {
+        return true;
+    }
+    if (indev == NULL || lv_indev_get_read_cb(indev) == NULL)
+    {
+        return false;
+    }
+
+    // Past 4 KB malloc takes it from PSRAM
+    replay_buffer = (uint8_t *)malloc(sizeof(MAIN_input_script_header_t) +
+                                      INPUT_REPLAY_MAX_RECORDS * sizeof(MAIN_input_record_t));
+    if (replay_buffer == NULL)
+    {
+        Serial.println("[REPLAY] ERROR: No memory for the script");
+        return false;
+    }
+    replay_header = (MAIN_input_script_header_t *)replay_buffer;
+    replay_records = (MAIN_input_record_t *)(replay_buffer + sizeof(MAIN_input_script_header_t));
+    memset(replay_header, 0, sizeof(*replay_header));
+
+    replay_indev = indev;
+    replay_read_cb = lv_indev_get_read_cb(indev);
+    lv_indev_set_read_cb(indev, input_replay_read);
+
+    if (mode == INPUT_REPLAY_RECORD)
+    {
+        return MAIN_input_replay_record_start();
+    }
+    if (mode == INPUT_REPLAY_PLAY)
+    {
+        return MAIN_input_replay_load(INPUT_REPLAY_PATH) && MAIN_input_replay_play_start();
+    }
+    return true;
+}
+
+/**
+ * @brief Start recording
+ */
+bool MAIN_input_replay_record_start(void)
+{
+    if (replay_indev == NULL || replay_state != INPUT_REPLAY_IDLE || replay_writing)
+    {
+        return false;
+    }
+
+    lv_display_t *disp = lv_indev_get_display(replay_indev);
+    memset(replay_header, 0, sizeof(*replay_header));
+    replay_header->magic = INPUT_REPLAY_MAGIC;
+    replay_header->format = INPUT_REPLAY_FORMAT;
+    replay_header->recordSize = sizeof(MAIN_input_record_t);
+    replay_header->width = (uint16_t)lv_display_get_horizontal_resolution(disp);
+    replay_header->height = (uint16_t)lv_display_get_vertical_resolution(disp);
+    replay_header->build = EARS_APP_BUILD_TIMESTAMP;
+    replay_loaded = false;
+
+    replay_kind = INPUT_RECORD_RELEASED;
+    replay_screen = INPUT_REPLAY_NO_SCREEN;
+    replay_stats.recorded = 0;
+    replay_start_ms = millis();
+    replay_state = INPUT_REPLAY_RECORDING;
+
+#if EARS_DEBUG == 1
+    Serial.printf("[REPLAY] Recording input for %u ms\n", INPUT_REPLAY_RECORD_MS);
+#endif
+    return true;
+}
+
+/**
+ * @brief Load a script into the replay buffer
+ */
+bool MAIN_input_replay_load(const char *path)
+{
+    if (replay_indev == NULL || replay_state != INPUT_REPLAY_IDLE || replay_writing)
+    {
+        return false;
+    }
+
+    replay_loaded = false;
+    size_t capacity = sizeof(MAIN_input_script_header_t) + INPUT_REPLAY_MAX_RECORDS * sizeof(MAIN_input_record_t);
+    size_t length = using_sdcard().readInto(path, replay_buffer, capacity);
+
+    lv_display_t *disp = lv_indev_get_display(replay_indev);
+    if (length < sizeof(MAIN_input_script_header_t) || replay_header->magic != INPUT_REPLAY_MAGIC ||
+        replay_header->format != INPUT_REPLAY_FORMAT || replay_header->recordSize != sizeof(MAIN_input_record_t) ||
+        replay_header->count > INPUT_REPLAY_MAX_RECORDS ||
+        length < sizeof(MAIN_input_script_header_t) + replay_header->count * sizeof(MAIN_input_record_t))
+    {
+        Serial.printf("[REPLAY] ERROR: %s is not an input script\n", path);
+        return false;
+    }
+    if (replay_header->width != lv_display_get_horizontal_resolution(disp) ||
+        replay_header->height != lv_display_get_vertical_resolution(disp))
+    {
+        Serial.printf("[REPLAY] ERROR: Script recorded at %ux%u\n", replay_header->width, replay_header->height);
+        return false;
+    }
+
+    replay_loaded = true;
+    return true;
+}
+
+/**
+ * @brief Replay the loaded script from its start
+ */
+bool MAIN_input_replay_play_start(void)
+{
+    if (!replay_loaded || replay_state != INPUT_REPLAY_IDLE || replay_writing)
+    {
+        return false;
+    }
+
+    replay_cursor = 0;
+    replay_kind = INPUT_RECORD_RELEASED;
+    replay_screen = INPUT_REPLAY_NO_SCREEN;
+    replay_stats.replayed = 0;
+    replay_stats.divergences = 0;
+    replay_stats.maxLateMs = 0;
+
+    MAIN_lvgl_reset_stats();
+    replay_start_ms = millis();
+    replay_state = INPUT_REPLAY_PLAYING;
+
+#if EARS_DEBUG == 1
+    Serial.printf("[REPLAY] Replaying %lu samples over %lu ms\n", (unsigned long)replay_header->count,
+                  (unsigned long)replay_header->durationMs);
+#endif
+    return true;
+}
+
+/**
+ * @brief End a recording (saved) or a replay (no results row)
+ */
+void MAIN_input_replay_stop(void)
+{
+    if (replay_state == INPUT_REPLAY_RECORDING)
+    {
+        replay_header->durationMs = millis() - replay_start_ms;
+        replay_stats.recorded = replay_header->count;
+        replay_state = INPUT_REPLAY_IDLE;
+        input_replay_post(input_replay_save);
+    }
+    else
+    {
+        replay_state = INPUT_REPLAY_IDLE;
+    }
+}
+
+/**
+ * @brief Record and replay counters
+ */
+void MAIN_input_replay_get_stats(MAIN_input_replay_stats_t *stats)
+{
+    *stats = replay_stats;
+    stats->state = replay_state;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_InputReplay_getLibraryName() {
+    return MAIN_InputReplay::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_InputReplay_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_InputReplay::VERSION_MAJOR,
+                       MAIN_InputReplay::VERSION_MINOR,
+                       MAIN_InputReplay::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_InputReplay_getVersionDate() {
+    return MAIN_InputReplay::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_InputReplay_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_InputReplay_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/******************************************************************************
+ * End of MAIN_inputReplayLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,196 @@
+/**
+ * @file MAIN_inputReplayLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Input record and replay, for frame-time comparisons between builds
+ * @details Frame-time figures from hand-driven sessions cannot be compared:
+ *          no two sessions press the same places at the same moments. This
+ *          library wraps the touch input device's read callback (EARS_touch)
+ *          and either records what it reports or replays a recorded script
+ *          in its place.
+ *
+ *          Recording logs each press, release and move as a timestamped
+ *          sample. It also logs each flow screen change as a marker, and
+ *          saves the script to INPUT_REPLAY_PATH when it ends. Replay
+ *          injects the samples at their original times (to within one
+ *          indev read period; each late sample is still delivered, one per
+ *          read). It resets the MAIN_lvglLib counters at the start, takes
+ *          them INPUT_REPLAY_SETTLE_MS after the last sample, and appends
+ *          one row to INPUT_REPLAY_CSV_PATH. The row has the build, the
+ *          frame-time histogram, the frame and flush times, and the number
+ *          of touches that landed on a different screen than when they were
+ *          recorded. A run with such divergences did not follow the script.
+ *
+ *          Both start in setup() at the same point of the boot, so a script
+ *          recorded on one build replays on another from the same state:
+ *          build with -D EARS_INPUT_REPLAY=1 to record for
+ *          INPUT_REPLAY_RECORD_MS, then with -D EARS_INPUT_REPLAY=2 to
+ *          replay (pio envs input_record and input_replay). The panel is
+ *          read but ignored while a script plays.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_INPUT_REPLAY_LIB_H__
+#define __MAIN_INPUT_REPLAY_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include <lvgl.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_InputReplay
+{
+    constexpr const char* LIB_NAME = "MAIN_InputReplay";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_InputReplay_getLibraryName();
+uint32_t MAIN_InputReplay_getVersionEncoded();
+const char* MAIN_InputReplay_getVersionDate();
+void MAIN_InputReplay_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Input Replay Configuration
+ *****************************************************************************/
+
+// Boot mode: 0 off, 1 record, 2 replay
+#ifndef EARS_INPUT_REPLAY
+#define EARS_INPUT_REPLAY 0
+#endif
+
+#define INPUT_REPLAY_OFF 0
+#define INPUT_REPLAY_RECORD 1
+#define INPUT_REPLAY_PLAY 2
+
+// Script and results files
+#define INPUT_REPLAY_DIR "/bench"
+#define INPUT_REPLAY_PATH "/bench/input.rec"
+#define INPUT_REPLAY_CSV_PATH "/bench/replay.csv"
+
+// Samples one script holds (12 bytes each, PSRAM)
+#define INPUT_REPLAY_MAX_RECORDS 4096
+
+// Recording length, and the wait after the last sample before the stats are taken
+#define INPUT_REPLAY_RECORD_MS 60000
+#define INPUT_REPLAY_SETTLE_MS 2000
+
+#define INPUT_REPLAY_MAGIC 0x50524945U      // "EIRP"
+#define INPUT_REPLAY_FORMAT 1
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef enum
+{
+    INPUT_REPLAY_IDLE = 0,
+    INPUT_REPLAY_RECORDING,
+    INPUT_REPLAY_PLAYING,
+    INPUT_REPLAY_SETTLING           // Script done, frames still counted
+} MAIN_input_replay_state_t;
+
+typedef enum
+{
+    INPUT_RECORD_RELEASED = 0,
+    INPUT_RECORD_PRESSED,
+    INPUT_RECORD_SCREEN             // x = flow screen id
+} MAIN_input_record_kind_t;
+
+typedef struct
+{
+    uint32_t ms;                    // Since the recording started
+    int16_t x;
+    int16_t y;
+    uint8_t kind;                   // MAIN_input_record_kind_t
+    uint8_t reserved[3];
+} MAIN_input_record_t;
+
+typedef struct
+{
+    uint32_t magic;                 // INPUT_REPLAY_MAGIC
+    uint16_t format;                // INPUT_REPLAY_FORMAT
+    uint16_t recordSize;            // sizeof(MAIN_input_record_t)
+    uint32_t count;                 // Records after the header
+    uint16_t width;                 // Display resolution it was recorded at
+    uint16_t height;
+    uint32_t durationMs;
+    uint64_t build;                 // EARS_APP_BUILD_TIMESTAMP of the recording
+} MAIN_input_script_header_t;
+
+typedef struct
+{
+    MAIN_input_replay_state_t state;
+    uint32_t recorded;              // Records in the last recording
+    uint32_t overflows;             // Recordings cut short by INPUT_REPLAY_MAX_RECORDS
+    uint32_t runs;                  // Replays completed
+    uint32_t replayed;              // Samples injected by the last replay
+    uint32_t divergences;           // Of those, landing on another screen than recorded
+    uint32_t maxLateMs;             // Most a sample was injected after its time
+    bool saved;                     // Last script or result reached the SD card
+} MAIN_input_replay_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Wrap an input device's read callback and start the boot mode
+ * @param indev Pointer input device (EARS_touch's)
+ * @param mode INPUT_REPLAY_OFF, _RECORD or _PLAY
+ * @return true if wrapped (and, for _PLAY, the script loaded)
+ * @note setup() or the UI task. _PLAY reads INPUT_REPLAY_PATH from the SD card.
+ */
+bool MAIN_initialise_input_replay(lv_indev_t *indev, uint8_t mode);
+
+/**
+ * @brief Start recording (ends after INPUT_REPLAY_RECORD_MS, then saved)
+ * @return true if started
+ * @note UI task.
+ */
+bool MAIN_input_replay_record_start(void);
+
+/**
+ * @brief Load a script into the replay buffer
+ * @param path Script file
+ * @return true if it is a valid script for this display resolution
+ * @note Not while recording or playing.
+ */
+bool MAIN_input_replay_load(const char *path);
+
+/**
+ * @brief Replay the loaded script from its start
+ * @return true if started
+ * @note UI task.
+ */
+bool MAIN_input_replay_play_start(void);
+
+/**
+ * @brief End a recording (saved) or a replay (no results row)
+ * @note UI task.
+ */
+void MAIN_input_replay_stop(void);
+
+/**
+ * @brief Record and replay counters
+ * @param stats Receives the counters
+ */
+void MAIN_input_replay_get_stats(MAIN_input_replay_stats_t *stats);
+
+#endif // __MAIN_INPUT_REPLAY_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_inputReplayLib.h
+ ******************************************************************************/
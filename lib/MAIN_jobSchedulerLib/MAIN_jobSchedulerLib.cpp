@@ -0,0 +1,498 @@
+/**
+ * @file MAIN_jobSchedulerLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Periodic and one-shot background jobs for the Core 1 task
+ * @version 1.2.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_jobSchedulerLib.h"
+#include "EARS_systemDef.h"
+#include <esp_timer.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    MAIN_job_fn_t fn;
+    void *ctx;
+    MAIN_job_stats_t stats;
+    uint32_t dueTick;  // Wheel tick the job is due at
+    int8_t next;       // Wheel slot list links (JOB_INVALID = end)
+    int8_t prev;
+    uint8_t slot;      // Slot the job is linked into
+    bool active;       // Registered and not cancelled
+    bool onWheel;      // Linked into a slot (false while running)
+} job_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static job_t jobs[JOB_MAX];
+static int8_t job_wheel[JOB_WHEEL_SLOTS];
+static uint32_t job_wheel_tick = 0; // Next tick to process
+static bool job_started = false;
+static TaskHandle_t job_task_handle = NULL;
+static const char *volatile job_running = NULL; // Name of the job inside MAIN_job_scheduler_run()
+static portMUX_TYPE job_mux = portMUX_INITIALIZER_UNLOCKED;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Current wheel tick
+ * @return uint32_t Ticks of JOB_TICK_MS since boot
+ */
+static inline uint32_t job_now_tick(void)
+{
+    return (uint32_t)(esp_timer_get_time() / (JOB_TICK_MS * 1000LL));
+}
+
+/**
+ * @brief Ticks for a delay, rounded up so a job never runs early
+ * @param ms Milliseconds
+ * @return uint32_t Ticks
+ */
+static inline uint32_t job_ms_to_ticks(uint32_t ms)
+{
+    return (ms + JOB_TICK_MS - 1) / JOB_TICK_MS;
+}
+
+/**
+ * @brief Empty the wheel once (job_mux held)
+ */
+static void job_start_locked(void)
+{
+    for (uint8_t i = 0; i < JOB_WHEEL_SLOTS; i++)
+    {
+        job_wheel[i] = JOB_INVALID;
+    }
+    job_wheel_tick = job_now_tick();
+    job_started = true;
+}
+
+/**
+ * @brief Link a job into the slot of its due tick (job_mux held)
+ * @param id Job id
+ */
+static void job_link_locked(MAIN_job_id_t id)
+{
+    job_t *job = &jobs[id];
+
+    // A due tick the wheel has already passed goes in the next slot processed
+    uint32_t tick = ((int32_t)(job->dueTick - job_wheel_tick) < 0) ? job_wheel_tick : job->dueTick;
+    uint8_t slot = tick & (JOB_WHEEL_SLOTS - 1);
+
+    job->prev = JOB_INVALID;
+    job->next = job_wheel[slot];
+    if (job->next != JOB_INVALID)
+    {
+        jobs[job->next].prev = id;
+    }
+    job_wheel[slot] = id;
+    job->slot = slot;
+    job->onWheel = true;
+}
+
+/**
+ * @brief Unlink a job from its slot (job_mux held)
+ * @param id Job id
+ */
+static void job_unlink_locked(MAIN_job_id_t id)
+{
+    job_t *job = &jobs[id];
+
+    if (job->prev != JOB_INVALID)
+    {
+        jobs[job->prev].next = job->next;
+    }
+    else
+    {
+        job_wheel[job->slot] = job->next;
+    }
+    if (job->next != JOB_INVALID)
+    {
+        jobs[job->next].prev = job->prev;
+    }
+    job->next = JOB_INVALID;
+    job->prev = JOB_INVALID;
+    job->onWheel = false;
+}
+
+/**
+ * @brief Wake the scheduler task, unless it is the caller
+ */
+static void job_wake(void)
+{
+    if (job_task_handle != NULL && xTaskGetCurrentTaskHandle() != job_task_handle)
+    {
+        xTaskNotifyGive(job_task_handle);
+    }
+}
+
+/******************************************************************************
+ * Jobs
+ *****************************************************************************/
+
+/**
+ * @brief Register a job
+ * @param name Job name
+ * @param fn Job function
+ * @param ctx Passed to fn
+ * @param delayMs First run delay
+ * @param periodMs Interval, 0 = once
+ * @param priority JOB_PRIORITY_...
+ * @param deadlineMs Allowed start delay (0 = none)
+ * @return MAIN_job_id_t Job id, or JOB_INVALID
+ */
+MAIN_job_id_t MAIN_job_add(const char *name, MAIN_job_fn_t fn, void *ctx, uint32_t delayMs, uint32_t periodMs,
+                           uint8_t priority, uint32_t deadlineMs)
+{
+    if (fn == NULL)
+    {
+        return JOB_INVALID;
+    }
+
+    MAIN_job_id_t id = JOB_INVALID;
+
+    taskENTER_CRITICAL(&job_mux);
+    if (!job_started)
+    {
+        job_start_locked();
+    }
+
+    for (MAIN_job_id_t i = 0; i < JOB_MAX; i++)
+    {
+        if (!jobs[i].active && !jobs[i].onWheel && jobs[i].fn == NULL)
+        {
+            id = i;
+            break;
+        }
+    }
+
+    if (id != JOB_INVALID)
+    {
+        job_t *job = &jobs[id];
+        memset(job, 0, sizeof(job_t));
+        job->fn = fn;
+        job->ctx = ctx;
+        job->stats.name = (name != NULL) ? name : "job";
+        job->stats.periodMs = periodMs;
+        job->stats.deadlineMs = deadlineMs;
+        job->stats.priority = priority;
+        job->dueTick = job_now_tick() + job_ms_to_ticks(delayMs);
+        job->active = true;
+        job_link_locked(id);
+    }
+    taskEXIT_CRITICAL(&job_mux);
+
+    if (id == JOB_INVALID)
+    {
+        Serial.printf("[JOBS] Warning: No free job slot for %s\n", (name != NULL) ? name : "job");
+        return JOB_INVALID;
+    }
+
+    job_wake();
+    return id;
+}
+
+/**
+ * @brief Remove a job
+ * @param id Job id
+ * @return true if the job existed
+ */
+bool MAIN_job_cancel(MAIN_job_id_t id)
+{
+    if (id < 0 || id >= JOB_MAX)
+    {
+        return false;
+    }
+
+    bool existed = false;
+
+    taskENTER_CRITICAL(&job_mux);
+    job_t *job = &jobs[id];
+    if (job->active)
+    {
+        existed = true;
+        job->active = false;
+        if (job->onWheel)
+        {
+            job_unlink_locked(id);
+            job->fn = NULL;
+        }
+        // A running job's slot is freed by the scheduler once it returns
+    }
+    taskEXIT_CRITICAL(&job_mux);
+
+    return existed;
+}
+
+/**
+ * @brief Run a job at the next pass
+ * @param id Job id
+ * @return true if the job exists
+ */
+bool MAIN_job_trigger(MAIN_job_id_t id)
+{
+    if (id < 0 || id >= JOB_MAX)
+    {
+        return false;
+    }
+
+    bool exists = false;
+
+    taskENTER_CRITICAL(&job_mux);
+    job_t *job = &jobs[id];
+    if (job->active && job->onWheel)
+    {
+        exists = true;
+        job_unlink_locked(id);
+        job->dueTick = job_now_tick();
+        job_link_locked(id);
+    }
+    taskEXIT_CRITICAL(&job_mux);
+
+    if (exists)
+    {
+        job_wake();
+    }
+    return exists;
+}
+
+/**
+ * @brief Run every job that is due
+ * @param throttled true while sleeping longer on purpose (deep idle)
+ * @return uint32_t Milliseconds until the next job is due
+ */
+uint32_t MAIN_job_scheduler_run(bool throttled)
+{
+    MAIN_job_id_t ready[JOB_MAX];
+    uint8_t readyCount = 0;
+    uint32_t now = job_now_tick();
+
+    // Collect due jobs from the slots passed since the last run (each slot once)
+    taskENTER_CRITICAL(&job_mux);
+    if (!job_started)
+    {
+        job_start_locked();
+    }
+
+    uint32_t passed = now - job_wheel_tick + 1;
+    if ((int32_t)passed > 0)
+    {
+        if (passed > JOB_WHEEL_SLOTS)
+        {
+            passed = JOB_WHEEL_SLOTS;
+        }
+        for (uint32_t i = 0; i < passed; i++)
+        {
+            uint8_t slot = (job_wheel_tick + i) & (JOB_WHEEL_SLOTS - 1);
+            MAIN_job_id_t id = job_wheel[slot];
+            while (id != JOB_INVALID)
+            {
+                MAIN_job_id_t next = jobs[id].next;
+                if ((int32_t)(jobs[id].dueTick - now) <= 0)
+                {
+                    job_unlink_locked(id);
+                    ready[readyCount++] = id;
+                }
+                id = next;
+            }
+        }
+        job_wheel_tick = now + 1;
+    }
+    taskEXIT_CRITICAL(&job_mux);
+
+    // Highest priority first, then the longest overdue
+    for (uint8_t i = 1; i < readyCount; i++)
+    {
+        MAIN_job_id_t id = ready[i];
+        int8_t j = i - 1;
+        while (j >= 0 && (jobs[ready[j]].stats.priority < jobs[id].stats.priority ||
+                          (jobs[ready[j]].stats.priority == jobs[id].stats.priority &&
+                           (int32_t)(jobs[ready[j]].dueTick - jobs[id].dueTick) > 0)))
+        {
+            ready[j + 1] = ready[j];
+            j--;
+        }
+        ready[j + 1] = id;
+    }
+
+    for (uint8_t i = 0; i < readyCount; i++)
+    {
+        job_t *job = &jobs[ready[i]];
+
+        if (job->active)
+        {
+            uint32_t lateMs = (uint32_t)(job_now_tick() - job->dueTick) * JOB_TICK_MS;
+            if (!throttled)
+            {
+                if (lateMs > job->stats.maxLateMs)
+                {
+                    job->stats.maxLateMs = lateMs;
+                }
+                if (job->stats.deadlineMs != 0 && lateMs > job->stats.deadlineMs)
+                {
+                    job->stats.late++;
+                }
+            }
+
+            int64_t start = esp_timer_get_time();
+            job_running = job->stats.name;
+            job->fn(job->ctx);
+            job_running = NULL;
+            uint32_t elapsed = (uint32_t)(esp_timer_get_time() - start);
+
+            job->stats.runs++;
+            job->stats.totalUs += elapsed;
+            if (elapsed > job->stats.maxUs)
+            {
+                job->stats.maxUs = elapsed;
+            }
+        }
+
+        // Reschedule on the period grid; runs missed while busy are skipped, not bunched
+        taskENTER_CRITICAL(&job_mux);
+        if (job->active && job->stats.periodMs != 0)
+        {
+            uint32_t period = job_ms_to_ticks(job->stats.periodMs);
+            uint32_t current = job_now_tick();
+            job->dueTick += period;
+            if ((int32_t)(job->dueTick - current) <= 0)
+            {
+                job->dueTick = current + period;
+            }
+            job_link_locked(ready[i]);
+        }
+        else
+        {
+            job->active = false;
+            job->fn = NULL;
+        }
+        taskEXIT_CRITICAL(&job_mux);
+    }
+
+    // Sleep until the earliest due job
+    uint32_t sleepTicks = job_ms_to_ticks(JOB_MAX_SLEEP_MS);
+    now = job_now_tick();
+
+    taskENTER_CRITICAL(&job_mux);
+    for (uint8_t i = 0; i < JOB_MAX; i++)
+    {
+        if (jobs[i].onWheel)
+        {
+            int32_t until = (int32_t)(jobs[i].dueTick - now);
+            if (until <= 0)
+            {
+                sleepTicks = 0;
+                break;
+            }
+            if ((uint32_t)until < sleepTicks)
+            {
+                sleepTicks = (uint32_t)until;
+            }
+        }
+    }
+    taskEXIT_CRITICAL(&job_mux);
+
+    return sleepTicks * JOB_TICK_MS;
+}
+
+/**
+ * @brief Task woken when a job is added or triggered
+ * @param task Scheduler task
+ */
+void MAIN_job_scheduler_set_task(TaskHandle_t task)
+{
+    job_task_handle = task;
+}
+
+/**
+ * @brief Job being run right now
+ * @return const char* Its name, NULL between jobs
+ */
+const char *MAIN_job_get_running(void)
+{
+    return job_running;
+}
+
+/**
+ * @brief Counters of one job
+ * @param id Job id
+ * @param stats Receives the counters
+ * @return true if the job exists
+ */
+bool MAIN_job_get_stats(MAIN_job_id_t id, MAIN_job_stats_t *stats)
+{
+    if (id < 0 || id >= JOB_MAX || stats == NULL || !jobs[id].active)
+    {
+        return false;
+    }
+
+    *stats = jobs[id].stats;
+    return true;
+}
+
+/**
+ * @brief Print every job's counters to Serial
+ */
+void MAIN_job_scheduler_print_report(void)
+{
+    Serial.println("[JOBS] Job              Period  Pri      Runs   Avg us   Max us  Late  Worst ms");
+    for (MAIN_job_id_t i = 0; i < JOB_MAX; i++)
+    {
+        MAIN_job_stats_t stats;
+        if (!MAIN_job_get_stats(i, &stats))
+        {
+            continue;
+        }
+
+        uint32_t avg = (stats.runs != 0) ? (uint32_t)(stats.totalUs / stats.runs) : 0;
+        Serial.printf("[JOBS] %-16s %6lu  %3u  %8lu %8lu %8lu %5lu %9lu\n", stats.name,
+                      (unsigned long)stats.periodMs, stats.priority, (unsigned long)stats.runs,
+                      (unsigned long)avg, (unsigned long)stats.maxUs, (unsigned long)stats.late,
+                      (unsigned long)stats.maxLateMs);
+    }
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_JobScheduler_getLibraryName() {
+    return MAIN_JobScheduler::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_JobScheduler_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_JobScheduler::VERSION_MAJOR,
+                       MAIN_JobScheduler::VERSION_MINOR,
+                       MAIN_JobScheduler::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_JobScheduler_getVersionDate() {
+    return MAIN_JobScheduler::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_JobScheduler_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_JobScheduler_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_jobSchedulerLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,176 @@
+/**
+ * @file MAIN_jobSchedulerLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Periodic and one-shot background jobs for the Core 1 task
+ * @details Background services (event dispatch, log and SD flushing, NVS
+ *          write-back, backlight policy, sensor polling) register as jobs with
+ *          a period, a priority and a deadline, instead of all running at the
+ *          fixed Core 1 rate. MAIN_core1_background_task calls
+ *          MAIN_job_scheduler_run() and sleeps until the next job is due, or
+ *          until a job is added from another task.
+ *
+ *          Jobs are kept on a hashed timer wheel of JOB_WHEEL_SLOTS slots of
+ *          JOB_TICK_MS each, so adding, rescheduling and cancelling are O(1);
+ *          a due time beyond one turn of the wheel just stays in its slot
+ *          until its turn comes. Jobs due in the same pass run highest
+ *          priority first. A job that starts later than its deadline after
+ *          its due time counts as late. Each job keeps its run count, total
+ *          and worst run time.
+ *
+ *          Adding and cancelling are safe from any task; jobs run on the task
+ *          that calls MAIN_job_scheduler_run(). MAIN_job_get_running() names
+ *          the job in progress, so a stall can be pinned on it.
+ * @version 1.2.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_JOB_SCHEDULER_LIB_H__
+#define __MAIN_JOB_SCHEDULER_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_JobScheduler
+{
+    constexpr const char* LIB_NAME = "MAIN_JobScheduler";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "2";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_JobScheduler_getLibraryName();
+uint32_t MAIN_JobScheduler_getVersionEncoded();
+const char* MAIN_JobScheduler_getVersionDate();
+void MAIN_JobScheduler_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Job Scheduler Configuration
+ *****************************************************************************/
+
+// Jobs registered at once
+#define JOB_MAX 24
+
+// Wheel resolution and size (power of 2): one turn is 640 ms
+#define JOB_TICK_MS 10
+#define JOB_WHEEL_SLOTS 64
+
+// Longest sleep when no job is due soon
+#define JOB_MAX_SLEEP_MS 1000
+
+// Priorities (higher runs first)
+#define JOB_PRIORITY_LOW 0
+#define JOB_PRIORITY_NORMAL 1
+#define JOB_PRIORITY_HIGH 2
+
+// Returned by MAIN_job_add() when no job slot is free
+#define JOB_INVALID (-1)
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef void (*MAIN_job_fn_t)(void *ctx);
+
+typedef int8_t MAIN_job_id_t;
+
+typedef struct
+{
+    const char *name;    // Job name (NULL = free slot)
+    uint32_t periodMs;   // 0 = one shot
+    uint32_t deadlineMs; // Allowed start delay (0 = none)
+    uint8_t priority;    // JOB_PRIORITY_...
+    uint32_t runs;       // Times run
+    uint32_t late;       // Runs started after the deadline
+    uint32_t maxLateMs;  // Worst start delay
+    uint64_t totalUs;    // Time spent running
+    uint32_t maxUs;      // Longest run
+} MAIN_job_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Register a job
+ * @param name Job name (static string)
+ * @param fn Job function
+ * @param ctx Passed to fn
+ * @param delayMs First run after this many milliseconds
+ * @param periodMs Interval between runs, 0 = run once
+ * @param priority JOB_PRIORITY_... (higher first when several are due)
+ * @param deadlineMs Start delay after which a run counts as late (0 = none)
+ * @return MAIN_job_id_t Job id, or JOB_INVALID if JOB_MAX jobs exist
+ * @note Any task. One-shot jobs free their slot after running.
+ */
+MAIN_job_id_t MAIN_job_add(const char *name, MAIN_job_fn_t fn, void *ctx, uint32_t delayMs, uint32_t periodMs,
+                           uint8_t priority, uint32_t deadlineMs);
+
+/**
+ * @brief Remove a job
+ * @param id Job id from MAIN_job_add()
+ * @return true if the job existed
+ * @note A job may cancel itself while running.
+ */
+bool MAIN_job_cancel(MAIN_job_id_t id);
+
+/**
+ * @brief Run a job at the next pass, then keep its period
+ * @param id Job id
+ * @return true if the job exists
+ */
+bool MAIN_job_trigger(MAIN_job_id_t id);
+
+/**
+ * @brief Run every job that is due
+ * @param throttled true while the caller is deliberately sleeping longer
+ *        (deep idle), so late starts are not counted
+ * @return uint32_t Milliseconds until the next job is due (up to
+ *         JOB_MAX_SLEEP_MS)
+ */
+uint32_t MAIN_job_scheduler_run(bool throttled);
+
+/**
+ * @brief Task woken when a job is added or triggered
+ * @param task Task that calls MAIN_job_scheduler_run()
+ */
+void MAIN_job_scheduler_set_task(TaskHandle_t task);
+
+/**
+ * @brief Job being run right now
+ * @return const char* Its name, NULL between jobs
+ * @note Safe from any task (the health monitor reads it as Core 1's phase)
+ */
+const char *MAIN_job_get_running(void);
+
+/**
+ * @brief Counters of one job
+ * @param id Job id
+ * @param stats Receives the counters
+ * @return true if the job exists
+ */
+bool MAIN_job_get_stats(MAIN_job_id_t id, MAIN_job_stats_t *stats);
+
+/**
+ * @brief Print every job's counters to Serial
+ */
+void MAIN_job_scheduler_print_report(void);
+
+#endif // __MAIN_JOB_SCHEDULER_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_jobSchedulerLib.h
+ ******************************************************************************/
@@ -0,0 +1,444 @@
+/**
+ * @file MAIN_jpegDecoderLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief LVGL JPEG decoder on the ESP32-S3 ROM TJpgDec
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_jpegDecoderLib.h"
+#include "EARS_systemDef.h"
+#include <lvgl_private.h>
+#include <esp_heap_caps.h>
+#include <rom/tjpgd.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+// TJpgDec device: where the JPEG comes from and where the pixels go
+typedef struct
+{
+    lv_fs_file_t *file;  // File source, or NULL for data
+    const uint8_t *data; // Data source
+    uint32_t size;
+    uint32_t pos;
+    lv_draw_buf_t *buf;  // RGB565 output
+} jpeg_io_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static MAIN_jpeg_stats_t jpeg_stats;
+static portMUX_TYPE jpeg_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/******************************************************************************
+ * Static Functions
+ *****************************************************************************/
+
+/**
+ * @brief File source with a JPEG extension (any case: cameras write .JPG)
+ */
+static bool jpeg_is_file(const char *path)
+{
+    const char *ext = lv_fs_get_ext(path);
+    return strcasecmp(ext, "jpg") == 0 || strcasecmp(ext, "jpeg") == 0;
+}
+
+/**
+ * @brief Variable source holding a JPEG file (SOI marker then a segment)
+ */
+static bool jpeg_is_data(const lv_image_dsc_t *image)
+{
+    return image->data != NULL && image->data_size >= 3 && image->data[0] == 0xFF && image->data[1] == 0xD8 &&
+           image->data[2] == 0xFF;
+}
+
+/**
+ * @brief Side length at a TJpgDec scale (partial MCUs round up)
+ */
+static uint32_t jpeg_scaled(uint32_t length, uint8_t scale)
+{
+    return (length + (1U << scale) - 1) >> scale;
+}
+
+/**
+ * @brief Smallest scale from the requested one that fits the size limit
+ */
+static uint8_t jpeg_fit_scale(uint32_t width, uint32_t height, uint8_t scale)
+{
+    while (scale < JPEG_SCALE_1_8 &&
+           (jpeg_scaled(width, scale) > JPEG_DECODER_MAX_WIDTH || jpeg_scaled(height, scale) > JPEG_DECODER_MAX_HEIGHT))
+    {
+        scale++;
+    }
+    return scale;
+}
+
+/**
+ * @brief TJpgDec input: read (or skip, with buf NULL) up to len bytes
+ * @return UINT Bytes read or skipped, 0 at the end or on an error
+ */
+static UINT jpeg_input(JDEC *jd, BYTE *buf, UINT len)
+{
+    jpeg_io_t *io = (jpeg_io_t *)jd->device;
+
+    if (io->file != NULL)
+    {
+        if (buf == NULL)
+        {
+            uint32_t pos;
+            if (lv_fs_tell(io->file, &pos) != LV_FS_RES_OK ||
+                lv_fs_seek(io->file, pos + len, LV_FS_SEEK_SET) != LV_FS_RES_OK)
+            {
+                return 0;
+            }
+            return len;
+        }
+
+        uint32_t got = 0;
+        if (lv_fs_read(io->file, buf, len, &got) != LV_FS_RES_OK)
+        {
+            return 0;
+        }
+        return got;
+    }
+
+    uint32_t left = io->size - io->pos;
+    if (len > left)
+    {
+        len = left;
+    }
+    if (buf != NULL)
+    {
+        memcpy(buf, io->data + io->pos, len);
+    }
+    io->pos += len;
+    return len;
+}
+
+/**
+ * @brief TJpgDec output: one MCU block of RGB888, written as RGB565
+ * @return UINT 1 to carry on
+ */
+static UINT jpeg_output(JDEC *jd, void *bitmap, JRECT *rect)
+{
+    jpeg_io_t *io = (jpeg_io_t *)jd->device;
+    lv_draw_buf_t *buf = io->buf;
+    const uint8_t *rgb = (const uint8_t *)bitmap;
+    uint32_t width = rect->right - rect->left + 1;
+
+    if (rect->left >= buf->header.w)
+    {
+        return 1;
+    }
+    uint32_t columns = LV_MIN(width, buf->header.w - rect->left);
+
+    for (uint32_t y = rect->top; y <= rect->bottom && y < buf->header.h; y++)
+    {
+        uint16_t *dst = (uint16_t *)(buf->data + y * buf->header.stride) + rect->left;
+        const uint8_t *src = rgb;
+        for (uint32_t x = 0; x < columns; x++, src += 3)
+        {
+            dst[x] = ((src[0] & 0xF8) << 8) | ((src[1] & 0xFC) << 3) | (src[2] >> 3);
+        }
+        rgb += width * 3;
+    }
+    return 1;
+}
+
+/**
+ * @brief Read the JPEG header
+ * @param pool JPEG_DECODER_POOL_SIZE bytes of work memory
+ * @return true if TJpgDec can decode it
+ */
+static bool jpeg_prepare(JDEC *jd, jpeg_io_t *io, void *pool)
+{
+    return jd_prepare(jd, jpeg_input, pool, JPEG_DECODER_POOL_SIZE, io) == JDR_OK;
+}
+
+/**
+ * @brief Decode into a new RGB565 buffer from the image cache's allocator
+ * @param io Source, positioned at its start
+ * @param scale Requested scale (raised to fit the size limit)
+ * @return lv_draw_buf_t* The picture, or NULL
+ */
+static lv_draw_buf_t *jpeg_decode(jpeg_io_t *io, uint8_t scale)
+{
+    uint32_t start = micros();
+    lv_draw_buf_t *buf = NULL;
+    uint8_t used = scale;
+
+    void *pool = heap_caps_malloc(JPEG_DECODER_POOL_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    JDEC jd;
+    if (pool != NULL && jpeg_prepare(&jd, io, pool))
+    {
+        used = jpeg_fit_scale(jd.width, jd.height, scale);
+        buf = lv_draw_buf_create_ex(lv_draw_buf_get_image_handlers(), jpeg_scaled(jd.width, used),
+                                    jpeg_scaled(jd.height, used), LV_COLOR_FORMAT_RGB565, LV_STRIDE_AUTO);
+        if (buf != NULL)
+        {
+            io->buf = buf;
+            if (jd_decomp(&jd, jpeg_output, used) != JDR_OK)
+            {
+                lv_draw_buf_destroy(buf);
+                buf = NULL;
+            }
+        }
+    }
+    heap_caps_free(pool);
+
+    portENTER_CRITICAL(&jpeg_lock);
+    if (buf != NULL)
+    {
+        jpeg_stats.decoded++;
+        if (used != JPEG_SCALE_1_1)
+        {
+            jpeg_stats.scaled++;
+        }
+        jpeg_stats.lastUs = micros() - start;
+    }
+    else
+    {
+        jpeg_stats.failed++;
+    }
+    portEXIT_CRITICAL(&jpeg_lock);
+
+    return buf;
+}
+
+/**
+ * @brief Decoder info: size of a JPEG source as it will be decoded
+ */
+static lv_result_t jpeg_decoder_info(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc,
+                                     lv_image_header_t *header)
+{
+    (void)decoder;
+    jpeg_io_t io = {};
+
+    if (dsc->src_type == LV_IMAGE_SRC_FILE)
+    {
+        if (!jpeg_is_file((const char *)dsc->src))
+        {
+            return LV_RESULT_INVALID;
+        }
+        // Opened and rewound by LVGL
+        io.file = &dsc->file;
+    }
+    else if (dsc->src_type == LV_IMAGE_SRC_VARIABLE)
+    {
+        const lv_image_dsc_t *image = (const lv_image_dsc_t *)dsc->src;
+        if (!jpeg_is_data(image))
+        {
+            return LV_RESULT_INVALID;
+        }
+        io.data = image->data;
+        io.size = image->data_size;
+    }
+    else
+    {
+        return LV_RESULT_INVALID;
+    }
+
+    void *pool = heap_caps_malloc(JPEG_DECODER_POOL_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    JDEC jd;
+    bool ok = pool != NULL && jpeg_prepare(&jd, &io, pool);
+    heap_caps_free(pool);
+    if (!ok)
+    {
+        return LV_RESULT_INVALID;
+    }
+
+    uint8_t scale = jpeg_fit_scale(jd.width, jd.height, JPEG_SCALE_1_1);
+    header->cf = LV_COLOR_FORMAT_RGB565;
+    header->w = jpeg_scaled(jd.width, scale);
+    header->h = jpeg_scaled(jd.height, scale);
+    header->stride = lv_draw_buf_width_to_stride(header->w, LV_COLOR_FORMAT_RGB565);
+    return LV_RESULT_OK;
+}
+
+/**
+ * @brief Decoder open: decode the whole picture and add it to the image cache
+ */
+static lv_result_t jpeg_decoder_open(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc)
+{
+    jpeg_io_t io = {};
+    lv_fs_file_t file;
+
+    if (dsc->src_type == LV_IMAGE_SRC_FILE)
+    {
+        if (!jpeg_is_file((const char *)dsc->src) ||
+            lv_fs_open(&file, (const char *)dsc->src, LV_FS_MODE_RD) != LV_FS_RES_OK)
+        {
+            return LV_RESULT_INVALID;
+        }
+        io.file = &file;
+    }
+    else if (dsc->src_type == LV_IMAGE_SRC_VARIABLE)
+    {
+        const lv_image_dsc_t *image = (const lv_image_dsc_t *)dsc->src;
+        if (!jpeg_is_data(image))
+        {
+            return LV_RESULT_INVALID;
+        }
+        io.data = image->data;
+        io.size = image->data_size;
+    }
+    else
+    {
+        return LV_RESULT_INVALID;
+    }
+
+    lv_draw_buf_t *decoded = jpeg_decode(&io, JPEG_SCALE_1_1);
+    if (io.file != NULL)
+    {
+        lv_fs_close(io.file);
+    }
+    if (decoded == NULL)
+    {
+        return LV_RESULT_INVALID;
+    }
+
+    lv_draw_buf_t *adjusted = lv_image_decoder_post_process(dsc, decoded);
+    if (adjusted == NULL)
+    {
+        lv_draw_buf_destroy(decoded);
+        return LV_RESULT_INVALID;
+    }
+    if (adjusted != decoded)
+    {
+        lv_draw_buf_destroy(decoded);
+        decoded = adjusted;
+    }
+    dsc->decoded = decoded;
+
+    if (dsc->args.no_cache || !lv_image_cache_is_enabled())
+    {
+        return LV_RESULT_OK;
+    }
+
+    // The cache owns the pixels from here and frees them on eviction
+    lv_image_cache_data_t search_key;
+    search_key.src_type = dsc->src_type;
+    search_key.src = dsc->src;
+    search_key.slot.size = decoded->data_size;
+
+    lv_cache_entry_t *entry = lv_image_decoder_add_to_cache(decoder, &search_key, decoded, NULL);
+    if (entry == NULL)
+    {
+        return LV_RESULT_INVALID;
+    }
+    dsc->cache_entry = entry;
+    return LV_RESULT_OK;
+}
+
+/**
+ * @brief Decoder close: free pixels the image cache did not take
+ */
+static void jpeg_decoder_close(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc)
+{
+    (void)decoder;
+    if (dsc->args.no_cache || !lv_image_cache_is_enabled())
+    {
+        lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
+    }
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Register the decoder with LVGL
+ */
+void MAIN_initialise_jpeg_decoder(void)
+{
+    lv_image_decoder_t *decoder = lv_image_decoder_create();
+    if (decoder == NULL)
+    {
+        return;
+    }
+    lv_image_decoder_set_info_cb(decoder, jpeg_decoder_info);
+    lv_image_decoder_set_open_cb(decoder, jpeg_decoder_open);
+    lv_image_decoder_set_close_cb(decoder, jpeg_decoder_close);
+    decoder->name = "ROM TJpgDec";
+
+#if EARS_DEBUG == 1
+    Serial.printf("[OK] JPEG decoder (ROM TJpgDec, fits %dx%d)\n", JPEG_DECODER_MAX_WIDTH, JPEG_DECODER_MAX_HEIGHT);
+#endif
+}
+
+/**
+ * @brief Decode a JPEG file at a given scale (thumbnails)
+ */
+lv_draw_buf_t *MAIN_jpeg_decode(const char *path, MAIN_jpeg_scale_t scale)
+{
+    if (path == NULL || scale > JPEG_SCALE_1_8)
+    {
+        return NULL;
+    }
+
+    lv_fs_file_t file;
+    if (lv_fs_open(&file, path, LV_FS_MODE_RD) != LV_FS_RES_OK)
+    {
+        return NULL;
+    }
+
+    jpeg_io_t io = {};
+    io.file = &file;
+    lv_draw_buf_t *buf = jpeg_decode(&io, scale);
+    lv_fs_close(&file);
+    return buf;
+}
+
+/**
+ * @brief Decoder counters
+ */
+void MAIN_jpeg_get_stats(MAIN_jpeg_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+    portENTER_CRITICAL(&jpeg_lock);
+    *stats = jpeg_stats;
+    portEXIT_CRITICAL(&jpeg_lock);
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_JpegDecoder_getLibraryName() {
+    return MAIN_JpegDecoder::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_JpegDecoder_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_JpegDecoder::VERSION_MAJOR,
+                       MAIN_JpegDecoder::VERSION_MINOR,
+                       MAIN_JpegDecoder::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_JpegDecoder_getVersionDate() {
+    return MAIN_JpegDecoder::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_JpegDecoder_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_JpegDecoder_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_jpegDecoderLib.cpp
+ ******************************************************************************/
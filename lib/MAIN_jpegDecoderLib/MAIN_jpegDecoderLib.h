@@ -0,0 +1,120 @@
+/**
+ * @file MAIN_jpegDecoderLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief LVGL JPEG decoder on the ESP32-S3 ROM TJpgDec
+ * @details The ESP32-S3 ROM holds a TJpgDec (the decoder Espressif's esp_jpeg
+ *          component wraps), so JPEG support costs no flash for a decoder
+ *          and about 3 KB of work memory while a picture decodes. This
+ *          library registers it as an LVGL image decoder, ahead of LVGL's
+ *          own, for:
+ *
+ *          - "S:/...jpg" / ".jpeg" file sources, read through lv_fs (and so
+ *            through the 'S' drive's read cache)
+ *          - lv_image_dsc_t variables whose data is a JPEG file
+ *
+ *          TJpgDec hands over one MCU block at a time as RGB888, which is
+ *          converted straight into an RGB565 draw buffer in the image cache
+ *          (PSRAM, see MAIN_imageCacheLib): no RGB888 frame is ever held.
+ *          A picture larger than the display is decoded at 1/2, 1/4 or 1/8
+ *          in TJpgDec's IDCT, which is also faster than a full decode.
+ *
+ *          Thumbnails come from MAIN_jpeg_decode() at a chosen scale; the
+ *          buffer it returns is an image source for lv_image_set_src().
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_JPEG_DECODER_LIB_H__
+#define __MAIN_JPEG_DECODER_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <lvgl.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_JpegDecoder
+{
+    constexpr const char* LIB_NAME = "MAIN_JpegDecoder";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_JpegDecoder_getLibraryName();
+uint32_t MAIN_JpegDecoder_getVersionEncoded();
+const char* MAIN_JpegDecoder_getVersionDate();
+void MAIN_JpegDecoder_getVersionString(char* buffer);
+
+/******************************************************************************
+ * JPEG Decoder Configuration
+ *****************************************************************************/
+
+// TJpgDec work memory (the ROM build needs 3100 bytes), internal RAM
+#define JPEG_DECODER_POOL_SIZE 3100
+
+// Image sources are scaled down until they fit in this
+#define JPEG_DECODER_MAX_WIDTH 480
+#define JPEG_DECODER_MAX_HEIGHT 480
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+// TJpgDec output scales
+typedef enum
+{
+    JPEG_SCALE_1_1 = 0,
+    JPEG_SCALE_1_2 = 1,
+    JPEG_SCALE_1_4 = 2,
+    JPEG_SCALE_1_8 = 3
+} MAIN_jpeg_scale_t;
+
+typedef struct
+{
+    uint32_t decoded; // Pictures decoded
+    uint32_t scaled;  // Of those, decoded below full size
+    uint32_t failed;  // Not a JPEG TJpgDec takes (progressive, CMYK) or out of memory
+    uint32_t lastUs;  // Time of the last decode
+} MAIN_jpeg_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Register the decoder with LVGL
+ * @note Call after the other image decoders: the last registered is tried first.
+ */
+void MAIN_initialise_jpeg_decoder(void);
+
+/**
+ * @brief Decode a JPEG file at a given scale (thumbnails)
+ * @param path LVGL path ("S:/photos/a.jpg")
+ * @param scale Output scale; raised further if the result would not fit
+ *              JPEG_DECODER_MAX_WIDTH x JPEG_DECODER_MAX_HEIGHT
+ * @return lv_draw_buf_t* RGB565 image for lv_image_set_src(), or NULL.
+ *         Free with lv_draw_buf_destroy() once no image shows it.
+ */
+lv_draw_buf_t *MAIN_jpeg_decode(const char *path, MAIN_jpeg_scale_t scale);
+
+/**
+ * @brief Decoder counters
+ * @param stats Receives the counters
+ */
+void MAIN_jpeg_get_stats(MAIN_jpeg_stats_t *stats);
+
+#endif // __MAIN_JPEG_DECODER_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_jpegDecoderLib.h
+ ******************************************************************************/
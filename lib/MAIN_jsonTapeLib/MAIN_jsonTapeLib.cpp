@@ -0,0 +1,752 @@
+/**
+ * @file MAIN_jsonTapeLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Read-only JSON index (tape) over the text it was parsed from
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_jsonTapeLib.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+// Entry type and offset packing
+#define JSON_TAPE_TYPE_SHIFT 28
+#define JSON_TAPE_OFFSET_MASK 0x0FFFFFFFU
+
+// Escaped keys are unescaped into this much stack to compare
+#define JSON_TAPE_KEY_MAX 64
+
+// Longest number text converted
+#define JSON_TAPE_NUMBER_MAX 32
+
+typedef struct
+{
+    const char *text;
+    uint32_t length;
+    uint32_t pos;
+    uint32_t count;
+    MAIN_json_tape_entry_t *entries;    // NULL while counting
+} json_tape_scan_t;
+
+static MAIN_json_tape_stats_t json_tape_stats;
+
+/******************************************************************************
+ * Scanner
+ *****************************************************************************/
+
+static inline void json_tape_skip_space(json_tape_scan_t *scan)
+{
+    while (scan->pos < scan->length)
+    {
+        char c = scan->text[scan->pos];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+        {
+            break;
+        }
+        scan->pos++;
+    }
+}
+
+/**
+ * @brief Append an entry (only counted on the first pass)
+ * @return uint32_t Its index
+ */
+static inline uint32_t json_tape_emit(json_tape_scan_t *scan, MAIN_json_tape_type_t type, uint32_t offset)
+{
+    uint32_t index = scan->count++;
+    if (scan->entries != NULL)
+    {
+        scan->entries[index].at = ((uint32_t)type << JSON_TAPE_TYPE_SHIFT) | offset;
+        scan->entries[index].next = index + 1;
+    }
+    return index;
+}
+
+/**
+ * @brief A string, from its opening quote
+ */
+static bool json_tape_scan_string(json_tape_scan_t *scan)
+{
+    if (scan->pos >= scan->length || scan->text[scan->pos] != '"')
+    {
+        return false;
+    }
+    scan->pos++;
+    json_tape_emit(scan, JSON_TAPE_STRING, scan->pos);
+
+    while (scan->pos < scan->length)
+    {
+        char c = scan->text[scan->pos++];
+        if (c == '"')
+        {
+            return true;
+        }
+        if ((uint8_t)c < 0x20)
+        {
+            return false;
+        }
+        if (c == '\\')
+        {
+            if (scan->pos >= scan->length)
+            {
+                return false;
+            }
+            c = scan->text[scan->pos++];
+            if (c == 'u')
+            {
+                for (uint8_t i = 0; i < 4; i++)
+                {
+                    if (scan->pos >= scan->length || !isxdigit((uint8_t)scan->text[scan->pos++]))
+                    {
+                        return false;
+                    }
+                }
+            }
+            else if (strchr("\"\\/bfnrt", c) == NULL)
+            {
+                return false;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Digits, at least one
+ */
+static inline bool json_tape_scan_digits(json_tape_scan_t *scan)
+{
+    uint32_t start = scan->pos;
+    while (scan->pos < scan->length && isdigit((uint8_t)scan->text[scan->pos]))
+    {
+        scan->pos++;
+    }
+    return scan->pos > start;
+}
+
+/**
+ * @brief A number, literal or string
+ */
+static bool json_tape_scan_scalar(json_tape_scan_t *scan)
+{
+    const char *text = scan->text + scan->pos;
+    uint32_t left = scan->length - scan->pos;
+    char c = text[0];
+
+    if (c == '"')
+    {
+        return json_tape_scan_string(scan);
+    }
+    if (left >= 4 && memcmp(text, "null", 4) == 0)
+    {
+        json_tape_emit(scan, JSON_TAPE_NULL, scan->pos);
+        scan->pos += 4;
+        return true;
+    }
+    if (left >= 4 && memcmp(text, "true", 4) == 0)
+    {
+        json_tape_emit(scan, JSON_TAPE_TRUE, scan->pos);
+        scan->pos += 4;
+        return true;
+    }
+    if (left >= 5 && memcmp(text, "false", 5) == 0)
+    {
+        json_tape_emit(scan, JSON_TAPE_FALSE, scan->pos);
+        scan->pos += 5;
+        return true;
+    }
+    if (c != '-' && !isdigit((uint8_t)c))
+    {
+        return false;
+    }
+
+    json_tape_emit(scan, JSON_TAPE_NUMBER, scan->pos);
+    if (c == '-')
+    {
+        scan->pos++;
+    }
+    // No leading zeros
+    if (scan->pos < scan->length && scan->text[scan->pos] == '0')
+    {
+        scan->pos++;
+    }
+    else if (!json_tape_scan_digits(scan))
+    {
+        return false;
+    }
+    if (scan->pos < scan->length && scan->text[scan->pos] == '.')
+    {
+        scan->pos++;
+        if (!json_tape_scan_digits(scan))
+        {
+            return false;
+        }
+    }
+    if (scan->pos < scan->length && (scan->text[scan->pos] == 'e' || scan->text[scan->pos] == 'E'))
+    {
+        scan->pos++;
+        if (scan->pos < scan->length && (scan->text[scan->pos] == '+' || scan->text[scan->pos] == '-'))
+        {
+            scan->pos++;
+        }
+        if (!json_tape_scan_digits(scan))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief An object key and its colon
+ */
+static inline bool json_tape_scan_key(json_tape_scan_t *scan)
+{
+    json_tape_skip_space(scan);
+    if (!json_tape_scan_string(scan))
+    {
+        return false;
+    }
+    json_tape_skip_space(scan);
+    if (scan->pos >= scan->length || scan->text[scan->pos] != ':')
+    {
+        return false;
+    }
+    scan->pos++;
+    return true;
+}
+
+/**
+ * @brief One pass over the whole text, without recursion
+ * @return true if it is exactly one JSON value (surrounding space allowed)
+ */
+static bool json_tape_scan(json_tape_scan_t *scan)
+{
+    uint32_t open[JSON_TAPE_MAX_DEPTH];   // Entries of the open containers
+    char closer[JSON_TAPE_MAX_DEPTH];
+    uint8_t depth = 0;
+
+    scan->pos = 0;
+    scan->count = 0;
+
+    for (;;)
+    {
+        // A value
+        json_tape_skip_space(scan);
+        if (scan->pos >= scan->length)
+        {
+            return false;
+        }
+        char c = scan->text[scan->pos];
+        if (c == '{' || c == '[')
+        {
+            if (depth == JSON_TAPE_MAX_DEPTH)
+            {
+                return false;
+            }
+            closer[depth] = (c == '{') ? '}' : ']';
+            open[depth++] = json_tape_emit(scan, (c == '{') ? JSON_TAPE_OBJECT : JSON_TAPE_ARRAY, scan->pos);
+            scan->pos++;
+
+            json_tape_skip_space(scan);
+            if (scan->pos < scan->length && scan->text[scan->pos] == closer[depth - 1])
+            {
+                // Empty: closed at once, next already points past it
+                scan->pos++;
+                depth--;
+            }
+            else
+            {
+                if (c == '{' && !json_tape_scan_key(scan))
+                {
+                    return false;
+                }
+                continue;
+            }
+        }
+        else if (!json_tape_scan_scalar(scan))
+        {
+            return false;
+        }
+
+        // After a value: closers, then a comma or the end
+        for (;;)
+        {
+            json_tape_skip_space(scan);
+            if (depth == 0)
+            {
+                return scan->pos == scan->length;
+            }
+            if (scan->pos >= scan->length)
+            {
+                return false;
+            }
+            c = scan->text[scan->pos++];
+            if (c == ',')
+            {
+                if (closer[depth - 1] == '}' && !json_tape_scan_key(scan))
+                {
+                    return false;
+                }
+                break;
+            }
+            if (c != closer[depth - 1])
+            {
+                return false;
+            }
+            depth--;
+            if (scan->entries != NULL)
+            {
+                scan->entries[open[depth]].next = scan->count;
+            }
+        }
+    }
+}
+
+/******************************************************************************
+ * Entries
+ *****************************************************************************/
+
+static inline MAIN_json_tape_type_t json_tape_entry_type(const MAIN_json_tape_t *tape, uint32_t node)
+{
+    return (MAIN_json_tape_type_t)(tape->entries[node].at >> JSON_TAPE_TYPE_SHIFT);
+}
+
+static inline uint32_t json_tape_entry_offset(const MAIN_json_tape_t *tape, uint32_t node)
+{
+    return tape->entries[node].at & JSON_TAPE_OFFSET_MASK;
+}
+
+/**
+ * @brief Bytes of a string's raw text (up to its closing quote)
+ */
+static uint32_t json_tape_string_length(const MAIN_json_tape_t *tape, uint32_t offset)
+{
+    uint32_t pos = offset;
+    while (pos < tape->length && tape->text[pos] != '"')
+    {
+        pos += (tape->text[pos] == '\\') ? 2 : 1;
+    }
+    return pos - offset;
+}
+
+/**
+ * @brief Four hex digits
+ */
+static uint32_t json_tape_hex4(const char *hex)
+{
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        char c = hex[i];
+        value = (value << 4) | (uint32_t)(isdigit((uint8_t)c) ? c - '0' : (tolower((uint8_t)c) - 'a' + 10));
+    }
+    return value;
+}
+
+/**
+ * @brief Unescape raw string text
+ * @return int32_t Bytes written, -1 if dst is too small
+ */
+static int32_t json_tape_unescape(const char *raw, uint32_t rawLength, char *dst, uint32_t size)
+{
+    uint32_t out = 0;
+    uint32_t pos = 0;
+    while (pos < rawLength)
+    {
+        char utf8[4];
+        uint8_t n = 1;
+        char c = raw[pos++];
+        if (c != '\\')
+        {
+            utf8[0] = c;
+        }
+        else
+        {
+            c = raw[pos++];
+            switch (c)
+            {
+            case 'b': utf8[0] = '\b'; break;
+            case 'f': utf8[0] = '\f'; break;
+            case 'n': utf8[0] = '\n'; break;
+            case 'r': utf8[0] = '\r'; break;
+            case 't': utf8[0] = '\t'; break;
+            case 'u':
+            {
+                uint32_t code = json_tape_hex4(raw + pos);
+                pos += 4;
+                // Surrogate pair
+                if (code >= 0xD800 && code < 0xDC00 && pos + 6 <= rawLength && raw[pos] == '\\' && raw[pos + 1] == 'u')
+                {
+                    uint32_t low = json_tape_hex4(raw + pos + 2);
+                    if (low >= 0xDC00 && low < 0xE000)
+                    {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        pos += 6;
+                    }
+                }
+                if (code < 0x80)
+                {
+                    utf8[0] = (char)code;
+                }
+                else if (code < 0x800)
+                {
+                    utf8[0] = (char)(0xC0 | (code >> 6));
+                    utf8[1] = (char)(0x80 | (code & 0x3F));
+                    n = 2;
+                }
+                else if (code < 0x10000)
+                {
+                    utf8[0] = (char)(0xE0 | (code >> 12));
+                    utf8[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+                    utf8[2] = (char)(0x80 | (code & 0x3F));
+                    n = 3;
+                }
+                else
+                {
+                    utf8[0] = (char)(0xF0 | (code >> 18));
+                    utf8[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+                    utf8[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+                    utf8[3] = (char)(0x80 | (code & 0x3F));
+                    n = 4;
+                }
+                break;
+            }
+            default:
+                // \" \\ \/
+                utf8[0] = c;
+                break;
+            }
+        }
+
+        if (out + n >= size)
+        {
+            return -1;
+        }
+        memcpy(dst + out, utf8, n);
+        out += n;
+    }
+    dst[out] = '\0';
+    return (int32_t)out;
+}
+
+/**
+ * @brief Compare a key entry with a name, in place when it has no escapes
+ */
+static bool json_tape_key_equals(const MAIN_json_tape_t *tape, uint32_t node, const char *key, size_t keyLength)
+{
+    uint32_t offset = json_tape_entry_offset(tape, node);
+    uint32_t rawLength = json_tape_string_length(tape, offset);
+    const char *raw = tape->text + offset;
+
+    if (memchr(raw, '\\', rawLength) == NULL)
+    {
+        return rawLength == keyLength && memcmp(raw, key, keyLength) == 0;
+    }
+
+    // Escapes only shorten, so a raw key shorter than the name cannot match;
+    // escaped keys longer than JSON_TAPE_KEY_MAX never match
+    char unescaped[JSON_TAPE_KEY_MAX];
+    if (rawLength < keyLength)
+    {
+        return false;
+    }
+    int32_t length = json_tape_unescape(raw, rawLength, unescaped, sizeof(unescaped));
+    return length == (int32_t)keyLength && memcmp(unescaped, key, keyLength) == 0;
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Index a JSON text: count and check, allocate once, fill
+ */
+bool MAIN_json_tape_index(MAIN_json_tape_t *tape, const char *text, uint32_t length)
+{
+    MAIN_json_tape_free(tape);
+    tape->text = text;
+    tape->length = length;
+    if (text == NULL || length > JSON_TAPE_MAX_TEXT)
+    {
+        json_tape_stats.rejected++;
+        return false;
+    }
+
+    uint32_t start = micros();
+    json_tape_scan_t scan = {text, length, 0, 0, NULL};
+    if (!json_tape_scan(&scan) || scan.count > JSON_TAPE_MAX_TOKENS)
+    {
+        json_tape_stats.rejected++;
+        return false;
+    }
+
+    // Past 4 KB (512 tokens) malloc takes it from PSRAM
+    scan.entries = (MAIN_json_tape_entry_t *)malloc(scan.count * sizeof(MAIN_json_tape_entry_t));
+    if (scan.entries == NULL)
+    {
+#if EARS_DEBUG == 1
+        Serial.printf("[JSON] ERROR: No memory for %lu tokens\n", (unsigned long)scan.count);
+#endif
+        return false;
+    }
+    json_tape_scan(&scan);
+
+    tape->entries = scan.entries;
+    tape->count = scan.count;
+    json_tape_stats.indexed++;
+    json_tape_stats.tokens += scan.count;
+    json_tape_stats.indexUs += micros() - start;
+    return true;
+}
+
+/**
+ * @brief Free a tape's entries
+ */
+void MAIN_json_tape_free(MAIN_json_tape_t *tape)
+{
+    free(tape->entries);
+    tape->entries = NULL;
+    tape->count = 0;
+}
+
+/**
+ * @brief Type of a node
+ */
+MAIN_json_tape_type_t MAIN_json_tape_type(const MAIN_json_tape_t *tape, uint32_t node)
+{
+    if (node >= tape->count)
+    {
+        return JSON_TAPE_NULL;
+    }
+    return json_tape_entry_type(tape, node);
+}
+
+/**
+ * @brief Value of an object member: keys compared, values jumped over
+ */
+uint32_t MAIN_json_tape_member(const MAIN_json_tape_t *tape, uint32_t node, const char *key)
+{
+    if (node >= tape->count || json_tape_entry_type(tape, node) != JSON_TAPE_OBJECT || key == NULL)
+    {
+        return JSON_TAPE_NONE;
+    }
+
+    json_tape_stats.lookups++;
+    size_t keyLength = strlen(key);
+    uint32_t end = tape->entries[node].next;
+    uint32_t child = node + 1;
+    while (child < end)
+    {
+        if (json_tape_key_equals(tape, child, key, keyLength))
+        {
+            return child + 1;
+        }
+        child = tape->entries[child + 1].next;
+    }
+    return JSON_TAPE_NONE;
+}
+
+/**
+ * @brief Array element: earlier elements jumped over
+ */
+uint32_t MAIN_json_tape_element(const MAIN_json_tape_t *tape, uint32_t node, uint32_t index)
+{
+    if (node >= tape->count || json_tape_entry_type(tape, node) != JSON_TAPE_ARRAY)
+    {
+        return JSON_TAPE_NONE;
+    }
+
+    json_tape_stats.lookups++;
+    uint32_t end = tape->entries[node].next;
+    uint32_t child = node + 1;
+    while (child < end && index > 0)
+    {
+        child = tape->entries[child].next;
+        index--;
+    }
+    return (child < end) ? child : JSON_TAPE_NONE;
+}
+
+/**
+ * @brief Elements or members
+ */
+int32_t MAIN_json_tape_size(const MAIN_json_tape_t *tape, uint32_t node)
+{
+    if (node >= tape->count)
+    {
+        return -1;
+    }
+    MAIN_json_tape_type_t type = json_tape_entry_type(tape, node);
+    if (type != JSON_TAPE_ARRAY && type != JSON_TAPE_OBJECT)
+    {
+        return -1;
+    }
+
+    int32_t size = 0;
+    uint32_t end = tape->entries[node].next;
+    uint32_t child = node + 1;
+    while (child < end)
+    {
+        // A member is a key entry and a value subtree
+        child = tape->entries[(type == JSON_TAPE_OBJECT) ? child + 1 : child].next;
+        size++;
+    }
+    return size;
+}
+
+/**
+ * @brief Number value, converted now
+ */
+bool MAIN_json_tape_number(const MAIN_json_tape_t *tape, uint32_t node, double *value, bool *isInteger)
+{
+    if (node >= tape->count || json_tape_entry_type(tape, node) != JSON_TAPE_NUMBER)
+    {
+        return false;
+    }
+
+    uint32_t length;
+    const char *raw = MAIN_json_tape_raw(tape, node, &length);
+    char number[JSON_TAPE_NUMBER_MAX + 1];
+    if (length > JSON_TAPE_NUMBER_MAX)
+    {
+        length = JSON_TAPE_NUMBER_MAX;
+    }
+    memcpy(number, raw, length);
+    number[length] = '\0';
+
+    *value = strtod(number, NULL);
+    if (isInteger != NULL)
+    {
+        *isInteger = strpbrk(number, ".eE") == NULL && *value >= INT32_MIN && *value <= INT32_MAX;
+    }
+    return true;
+}
+
+/**
+ * @brief Raw text of a node
+ */
+const char *MAIN_json_tape_raw(const MAIN_json_tape_t *tape, uint32_t node, uint32_t *length)
+{
+    if (node >= tape->count)
+    {
+        *length = 0;
+        return NULL;
+    }
+
+    uint32_t offset = json_tape_entry_offset(tape, node);
+    const char *text = tape->text;
+    uint32_t pos = offset;
+    switch (json_tape_entry_type(tape, node))
+    {
+    case JSON_TAPE_NULL:
+    case JSON_TAPE_TRUE:
+        pos += 4;
+        break;
+
+    case JSON_TAPE_FALSE:
+        pos += 5;
+        break;
+
+    case JSON_TAPE_NUMBER:
+        while (pos < tape->length && strchr("+-.0123456789eE", text[pos]) != NULL && text[pos] != '\0')
+        {
+            pos++;
+        }
+        break;
+
+    case JSON_TAPE_STRING:
+        pos += json_tape_string_length(tape, offset);
+        break;
+
+    default:
+    {
+        // To the matching bracket, stepping over strings
+        uint32_t depth = 0;
+        while (pos < tape->length)
+        {
+            char c = text[pos++];
+            if (c == '"')
+            {
+                pos += json_tape_string_length(tape, pos) + 1;
+            }
+            else if (c == '{' || c == '[')
+            {
+                depth++;
+            }
+            else if ((c == '}' || c == ']') && --depth == 0)
+            {
+                break;
+            }
+        }
+        break;
+    }
+    }
+
+    *length = pos - offset;
+    return text + offset;
+}
+
+/**
+ * @brief Unescaped string value
+ */
+int32_t MAIN_json_tape_string(const MAIN_json_tape_t *tape, uint32_t node, char *dst, uint32_t size)
+{
+    if (node >= tape->count || json_tape_entry_type(tape, node) != JSON_TAPE_STRING || size == 0)
+    {
+        return -1;
+    }
+    uint32_t length;
+    const char *raw = MAIN_json_tape_raw(tape, node, &length);
+    return json_tape_unescape(raw, length, dst, size);
+}
+
+/**
+ * @brief Tape counters
+ */
+void MAIN_json_tape_get_stats(MAIN_json_tape_stats_t *stats)
+{
+    *stats = json_tape_stats;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_JsonTape_getLibraryName() {
+    return MAIN_JsonTape::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_JsonTape_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_JsonTape::VERSION_MAJOR,
+                       MAIN_JsonTape::VERSION_MINOR,
+                       MAIN_JsonTape::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_JsonTape_getVersionDate() {
+    return MAIN_JsonTape::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_JsonTape_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_JsonTape_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/******************************************************************************
+ * End of MAIN_jsonTapeLib.cpp
+ ******************************************************************************/
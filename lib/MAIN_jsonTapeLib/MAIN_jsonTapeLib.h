@@ -0,0 +1,191 @@
+/**
+ * @file MAIN_jsonTapeLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Read-only JSON index (tape) over the text it was parsed from
+ * @details Parsing a JSON payload into a tree copies every key and string,
+ *          allocates a node per value and converts every number, when a
+ *          screen usually reads three fields of it. A tape is one array of
+ *          8-byte entries, one per token, pointing into the original text:
+ *          the token's type and byte offset, and the index of the entry
+ *          after its subtree. Object children alternate key, value.
+ *
+ *          Member lookup walks an object's keys, stepping over each value's
+ *          subtree in one jump, and compares the key bytes in place (keys
+ *          with escapes are unescaped only to compare). Numbers and strings
+ *          are converted only when read. Nothing is copied out of the text,
+ *          which has to outlive the tape.
+ *
+ *          MAIN_json_tape_index() checks the syntax and counts the tokens
+ *          in a first pass, then allocates the tape once and fills it in a
+ *          second. Used by the flow's JSON values (src/ui/eez-flow.cpp),
+ *          which index a payload on its first member access.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_JSON_TAPE_LIB_H__
+#define __MAIN_JSON_TAPE_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_JsonTape
+{
+    constexpr const char* LIB_NAME = "MAIN_JsonTape";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_JsonTape_getLibraryName();
+uint32_t MAIN_JsonTape_getVersionEncoded();
+const char* MAIN_JsonTape_getVersionDate();
+void MAIN_JsonTape_getVersionString(char* buffer);
+
+/******************************************************************************
+ * JSON Tape Configuration
+ *****************************************************************************/
+
+// Deepest nesting of objects and arrays
+#define JSON_TAPE_MAX_DEPTH 32
+
+// Most tokens one tape may hold (and the largest text, in bytes)
+#define JSON_TAPE_MAX_TOKENS 0x00FFFFFFU
+#define JSON_TAPE_MAX_TEXT 0x0FFFFFFFU
+
+// Node index meaning "not found"
+#define JSON_TAPE_NONE 0xFFFFFFFFU
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef enum
+{
+    JSON_TAPE_NULL = 0,
+    JSON_TAPE_FALSE,
+    JSON_TAPE_TRUE,
+    JSON_TAPE_NUMBER,
+    JSON_TAPE_STRING,
+    JSON_TAPE_ARRAY,
+    JSON_TAPE_OBJECT
+} MAIN_json_tape_type_t;
+
+// One token: type in the top 4 bits of `at`, byte offset in the low 28
+typedef struct
+{
+    uint32_t at;
+    uint32_t next;              // Entry after this token's subtree
+} MAIN_json_tape_entry_t;
+
+typedef struct
+{
+    const char *text;           // Not owned
+    uint32_t length;
+    uint32_t count;             // Entries (0 = not indexed)
+    MAIN_json_tape_entry_t *entries;
+} MAIN_json_tape_t;
+
+typedef struct
+{
+    uint32_t indexed;           // Tapes built
+    uint32_t rejected;          // Texts that were not valid JSON (or too deep)
+    uint32_t tokens;            // Entries written
+    uint32_t lookups;           // Member and element lookups
+    uint32_t indexUs;           // Time spent indexing
+} MAIN_json_tape_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Index a JSON text
+ * @param tape Tape to fill (anything it held is freed first)
+ * @param text Text; must outlive the tape and stay unchanged
+ * @param length Bytes of text
+ * @return true if the text is one valid JSON value and the tape was allocated
+ */
+bool MAIN_json_tape_index(MAIN_json_tape_t *tape, const char *text, uint32_t length);
+
+/**
+ * @brief Free a tape's entries (not the text)
+ */
+void MAIN_json_tape_free(MAIN_json_tape_t *tape);
+
+/**
+ * @brief Type of a node
+ * @param node Entry index (0 = the root)
+ */
+MAIN_json_tape_type_t MAIN_json_tape_type(const MAIN_json_tape_t *tape, uint32_t node);
+
+/**
+ * @brief Value of an object member
+ * @param node Object node
+ * @param key Member name (NUL-terminated, unescaped)
+ * @return uint32_t Value node, or JSON_TAPE_NONE
+ */
+uint32_t MAIN_json_tape_member(const MAIN_json_tape_t *tape, uint32_t node, const char *key);
+
+/**
+ * @brief Array element
+ * @param node Array node
+ * @param index Element index
+ * @return uint32_t Element node, or JSON_TAPE_NONE
+ */
+uint32_t MAIN_json_tape_element(const MAIN_json_tape_t *tape, uint32_t node, uint32_t index);
+
+/**
+ * @brief Elements of an array or members of an object
+ * @return int32_t Count, -1 for a scalar
+ */
+int32_t MAIN_json_tape_size(const MAIN_json_tape_t *tape, uint32_t node);
+
+/**
+ * @brief Number value
+ * @param value Receives the number
+ * @param isInteger Receives true for an integer that fits int32_t (may be NULL)
+ * @return true if the node is a number
+ */
+bool MAIN_json_tape_number(const MAIN_json_tape_t *tape, uint32_t node, double *value, bool *isInteger);
+
+/**
+ * @brief Raw text of a node
+ * @param length Receives the byte length
+ * @return const char* Start of the token in the text (a string without its
+ *         quotes, escapes as written), NULL if node is out of range
+ */
+const char *MAIN_json_tape_raw(const MAIN_json_tape_t *tape, uint32_t node, uint32_t *length);
+
+/**
+ * @brief Unescaped string value
+ * @param dst Receives the string; never longer than its raw text, so a
+ *            buffer of raw length + 1 always fits
+ * @param size Bytes at dst
+ * @return int32_t Bytes written (without the terminator), -1 if not a string
+ */
+int32_t MAIN_json_tape_string(const MAIN_json_tape_t *tape, uint32_t node, char *dst, uint32_t size);
+
+/**
+ * @brief Tape counters
+ * @param stats Receives the counters
+ */
+void MAIN_json_tape_get_stats(MAIN_json_tape_stats_t *stats);
+
+#endif // __MAIN_JSON_TAPE_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_jsonTapeLib.h
+ ******************************************************************************/
@@ -0,0 +1,700 @@
+/**
+ * @file MAIN_keypadLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief On-screen keypad drawn from key faces rendered once
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_keypadLib.h"
+#include "EARS_systemDef.h"
+#include "MAIN_themeLib.h"
+#include <lvgl_private.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+#define KEYPAD_NO_INDEX 0xFF
+
+typedef struct
+{
+    lv_obj_t *obj;              // NULL = free slot
+    const MAIN_keypad_layout_t *layout;
+    lv_obj_t *textarea;
+    lv_draw_buf_t *up;          // Every key up, RGB565, content size
+    lv_draw_buf_t *down;        // Every key pressed
+    uint8_t *hit;               // Key index per KEYPAD_HIT_CELL square
+    uint16_t hitCols;
+    uint16_t hitRows;
+    lv_area_t rects[KEYPAD_MAX_KEYS]; // Key rectangles, content relative
+    int32_t width;              // Content size the rectangles were made for
+    int32_t height;
+    uint8_t pressed;            // Key index under the finger, KEYPAD_NO_INDEX
+    uint32_t lastKey;
+    bool scheduled;             // Render queued with lv_async_call
+} keypad_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static const MAIN_keypad_key_t keypad_number_keys[] = {
+    {"1", '1', 0, 0, 1, 1}, {"2", '2', 0, 1, 1, 1}, {"3", '3', 0, 2, 1, 1}, {LV_SYMBOL_BACKSPACE, LV_KEY_BACKSPACE, 0, 3, 1, 1},
+    {"4", '4', 1, 0, 1, 1}, {"5", '5', 1, 1, 1, 1}, {"6", '6', 1, 2, 1, 1}, {"-", '-', 1, 3, 1, 1},
+    {"7", '7', 2, 0, 1, 1}, {"8", '8', 2, 1, 1, 1}, {"9", '9', 2, 2, 1, 1}, {LV_SYMBOL_CLOSE, LV_KEY_ESC, 2, 3, 1, 1},
+    {".", '.', 3, 0, 1, 1}, {"0", '0', 3, 1, 1, 2}, {LV_SYMBOL_OK, LV_KEY_ENTER, 3, 3, 1, 1},
+};
+
+const MAIN_keypad_layout_t MAIN_keypad_layout_number = {
+    keypad_number_keys, sizeof(keypad_number_keys) / sizeof(keypad_number_keys[0]), 4, 4};
+
+static keypad_t keypad_slots[KEYPAD_MAX];
+static MAIN_keypad_stats_t keypad_stats;
+
+/******************************************************************************
+ * Static Functions (internal to library)
+ *****************************************************************************/
+
+/**
+ * @brief Slot of a keypad
+ * @param obj Keypad (NULL finds a free slot)
+ * @return keypad_t* Slot, or NULL
+ */
+static keypad_t *keypad_find(const lv_obj_t *obj)
+{
+    for (uint8_t i = 0; i < KEYPAD_MAX; i++)
+    {
+        if (keypad_slots[i].obj == obj)
+        {
+            return &keypad_slots[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Free the faces and the hit table
+ * @param k Keypad
+ */
+static void keypad_release(keypad_t *k)
+{
+    if (k->up != NULL)
+    {
+        keypad_stats.bytes -= k->up->data_size;
+        lv_draw_buf_destroy(k->up);
+        k->up = NULL;
+    }
+    if (k->down != NULL)
+    {
+        keypad_stats.bytes -= k->down->data_size;
+        lv_draw_buf_destroy(k->down);
+        k->down = NULL;
+    }
+    if (k->hit != NULL)
+    {
+        keypad_stats.bytes -= (uint32_t)k->hitCols * k->hitRows;
+        lv_free(k->hit);
+        k->hit = NULL;
+    }
+}
+
+/**
+ * @brief Lay the keys out over the content area
+ * @param k Keypad
+ * @param w Content width
+ * @param h Content height
+ * @details Grid lines at (index * (size + gap)) / count, so the remainder
+ *          is spread over the keys instead of left at one edge.
+ */
+static void keypad_layout(keypad_t *k, int32_t w, int32_t h)
+{
+    const MAIN_keypad_layout_t *layout = k->layout;
+    for (uint8_t i = 0; i < layout->count; i++)
+    {
+        const MAIN_keypad_key_t *key = &layout->keys[i];
+        lv_area_t *r = &k->rects[i];
+        r->x1 = key->col * (w + KEYPAD_GAP) / layout->cols;
+        r->x2 = (key->col + key->colSpan) * (w + KEYPAD_GAP) / layout->cols - KEYPAD_GAP - 1;
+        r->y1 = key->row * (h + KEYPAD_GAP) / layout->rows;
+        r->y2 = (key->row + key->rowSpan) * (h + KEYPAD_GAP) / layout->rows - KEYPAD_GAP - 1;
+    }
+    k->width = w;
+    k->height = h;
+}
+
+/**
+ * @brief Draw every key face into a layer
+ * @param k Keypad, laid out
+ * @param layer Layer to draw into
+ * @param x Content origin in the layer
+ * @param y Content origin in the layer
+ * @param pressed true for the pressed faces
+ */
+static void keypad_draw_keys(keypad_t *k, lv_layer_t *layer, int32_t x, int32_t y, bool pressed)
+{
+    lv_draw_rect_dsc_t rect;
+    lv_draw_rect_dsc_init(&rect);
+    lv_obj_init_draw_rect_dsc(k->obj, LV_PART_ITEMS, &rect);
+    lv_draw_label_dsc_t label;
+    lv_draw_label_dsc_init(&label);
+    lv_obj_init_draw_label_dsc(k->obj, LV_PART_ITEMS, &label);
+
+    // The pressed colours come from the style directly: as a state style on
+    // the object they would invalidate all of it on every press
+    lv_style_t *style = pressed ? MAIN_theme_get_style(THEME_STYLE_PRESSED) : NULL;
+    lv_style_value_t v;
+    if (style != NULL && lv_style_get_prop(style, LV_STYLE_BG_COLOR, &v) == LV_STYLE_RES_FOUND)
+    {
+        rect.bg_color = v.color;
+        rect.bg_opa = LV_OPA_COVER;
+    }
+    if (style != NULL && lv_style_get_prop(style, LV_STYLE_TEXT_COLOR, &v) == LV_STYLE_RES_FOUND)
+    {
+        label.color = v.color;
+    }
+
+    for (uint8_t i = 0; i < k->layout->count; i++)
+    {
+        lv_area_t area = k->rects[i];
+        lv_area_move(&area, x, y);
+        lv_draw_rect(layer, &rect, &area);
+
+        lv_point_t size;
+        label.text = k->layout->keys[i].label;
+        lv_text_get_size(&size, label.text, label.font, label.letter_space, label.line_space, LV_COORD_MAX,
+                         LV_TEXT_FLAG_NONE);
+        lv_area_t text;
+        text.x1 = area.x1 + (lv_area_get_width(&area) - size.x) / 2;
+        text.y1 = area.y1 + (lv_area_get_height(&area) - size.y) / 2;
+        text.x2 = text.x1 + size.x - 1;
+        text.y2 = text.y1 + size.y - 1;
+        lv_draw_label(layer, &label, &text);
+    }
+}
+
+/**
+ * @brief Render one set of faces into a draw buffer
+ * @param k Keypad, laid out
+ * @param buf RGB565 buffer of the content size
+ * @param pressed true for the pressed faces
+ * @note UI task, outside rendering (the draw units are dispatched here).
+ */
+static void keypad_render_faces(keypad_t *k, lv_draw_buf_t *buf, bool pressed)
+{
+    lv_area_t area = {0, 0, k->width - 1, k->height - 1};
+    lv_layer_t layer;
+    lv_layer_init(&layer);
+    layer.draw_buf = buf;
+    layer.color_format = LV_COLOR_FORMAT_RGB565;
+    layer.buf_area = area;
+    layer._clip_area = area;
+    layer.phy_clip_area = area;
+
+    // Under the keys: the body colour, so the gaps match what is around them
+    lv_draw_rect_dsc_t body;
+    lv_draw_rect_dsc_init(&body);
+    body.bg_color = lv_obj_get_style_bg_color(k->obj, LV_PART_MAIN);
+    body.bg_opa = LV_OPA_COVER;
+    lv_draw_rect(&layer, &body, &area);
+
+    keypad_draw_keys(k, &layer, 0, 0, pressed);
+
+    // As lv_canvas_finish_layer()
+    lv_display_t *display = lv_obj_get_display(k->obj);
+    while (layer.draw_task_head)
+    {
+        lv_draw_dispatch_wait_for_request();
+        if (!lv_draw_dispatch_layer(display, &layer))
+        {
+            lv_draw_wait_for_finish();
+            lv_draw_dispatch_request();
+        }
+    }
+}
+
+/**
+ * @brief Build the hit table: the key under each KEYPAD_HIT_CELL square
+ * @param k Keypad, laid out
+ * @return true if built
+ * @details A square belongs to the key whose rectangle, grown by half the
+ *          gap, holds its centre, so a press between keys still finds one.
+ */
+static bool keypad_build_hit(keypad_t *k)
+{
+    k->hitCols = (uint16_t)((k->width + KEYPAD_HIT_CELL - 1) >> KEYPAD_HIT_SHIFT);
+    k->hitRows = (uint16_t)((k->height + KEYPAD_HIT_CELL - 1) >> KEYPAD_HIT_SHIFT);
+    uint32_t size = (uint32_t)k->hitCols * k->hitRows;
+    k->hit = (uint8_t *)lv_malloc(size);
+    if (k->hit == NULL)
+    {
+        return false;
+    }
+    memset(k->hit, KEYPAD_NO_INDEX, size);
+    keypad_stats.bytes += size;
+
+    const int32_t half = KEYPAD_GAP / 2;
+    for (uint8_t i = 0; i < k->layout->count; i++)
+    {
+        const lv_area_t *r = &k->rects[i];
+        int32_t cx1 = LV_MAX(0, r->x1 - half) >> KEYPAD_HIT_SHIFT;
+        int32_t cx2 = LV_MIN(k->hitCols - 1, (r->x2 + half) >> KEYPAD_HIT_SHIFT);
+        int32_t cy1 = LV_MAX(0, r->y1 - half) >> KEYPAD_HIT_SHIFT;
+        int32_t cy2 = LV_MIN(k->hitRows - 1, (r->y2 + half) >> KEYPAD_HIT_SHIFT);
+        for (int32_t cy = cy1; cy <= cy2; cy++)
+        {
+            int32_t py = (cy << KEYPAD_HIT_SHIFT) + KEYPAD_HIT_CELL / 2;
+            if (py < r->y1 - half || py > r->y2 + half)
+            {
+                continue;
+            }
+            for (int32_t cx = cx1; cx <= cx2; cx++)
+            {
+                int32_t px = (cx << KEYPAD_HIT_SHIFT) + KEYPAD_HIT_CELL / 2;
+                if (px >= r->x1 - half && px <= r->x2 + half)
+                {
+                    k->hit[cy * k->hitCols + cx] = i;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Render both sets of faces and the hit table for the current size
+ * @param k Keypad
+ * @return true if the faces exist
+ */
+static bool keypad_render(keypad_t *k)
+{
+    uint32_t startUs = micros();
+    keypad_release(k);
+
+    int32_t w = lv_obj_get_content_width(k->obj);
+    int32_t h = lv_obj_get_content_height(k->obj);
+    if (w <= 0 || h <= 0)
+    {
+        return false;
+    }
+    keypad_layout(k, w, h);
+
+    lv_draw_buf_handlers_t *handlers = lv_draw_buf_get_image_handlers();
+    k->up = lv_draw_buf_create_ex(handlers, w, h, LV_COLOR_FORMAT_RGB565, LV_STRIDE_AUTO);
+    k->down = lv_draw_buf_create_ex(handlers, w, h, LV_COLOR_FORMAT_RGB565, LV_STRIDE_AUTO);
+    if (k->up != NULL)
+    {
+        keypad_stats.bytes += k->up->data_size;
+    }
+    if (k->down != NULL)
+    {
+        keypad_stats.bytes += k->down->data_size;
+    }
+    if (k->up == NULL || k->down == NULL || !keypad_build_hit(k))
+    {
+        // Drawn key by key instead, which still works
+        keypad_release(k);
+        Serial.println("[KEYPAD] ERROR: No memory for the key faces");
+        return false;
+    }
+
+    keypad_render_faces(k, k->up, false);
+    keypad_render_faces(k, k->down, true);
+
+    keypad_stats.renders++;
+    keypad_stats.renderUs += micros() - startUs;
+    lv_obj_invalidate(k->obj);
+    return true;
+}
+
+/**
+ * @brief lv_async_call: render faces made stale by a size or style change
+ * @param data Keypad slot
+ */
+static void keypad_render_async(void *data)
+{
+    keypad_t *k = (keypad_t *)data;
+    k->scheduled = false;
+    if (k->obj != NULL)
+    {
+        keypad_render(k);
+    }
+}
+
+/**
+ * @brief Drop the faces and render them on the next timer run
+ * @param k Keypad
+ */
+static void keypad_invalidate_faces(keypad_t *k)
+{
+    keypad_release(k);
+    if (!k->scheduled && lv_async_call(keypad_render_async, k) == LV_RESULT_OK)
+    {
+        k->scheduled = true;
+    }
+}
+
+/**
+ * @brief Key under a point
+ * @param k Keypad
+ * @param point Screen coordinates
+ * @return uint8_t Key index, KEYPAD_NO_INDEX for none
+ */
+static uint8_t keypad_hit(keypad_t *k, const lv_point_t *point)
+{
+    lv_area_t content;
+    lv_obj_get_content_coords(k->obj, &content);
+    int32_t x = point->x - content.x1;
+    int32_t y = point->y - content.y1;
+    if (x < 0 || y < 0 || x >= k->width || y >= k->height)
+    {
+        return KEYPAD_NO_INDEX;
+    }
+
+    if (k->hit != NULL)
+    {
+        return k->hit[(y >> KEYPAD_HIT_SHIFT) * k->hitCols + (x >> KEYPAD_HIT_SHIFT)];
+    }
+
+    // No table yet (faces not rendered): test the rectangles
+    for (uint8_t i = 0; i < k->layout->count; i++)
+    {
+        lv_point_t local = {x, y};
+        if (lv_area_is_point_on(&k->rects[i], &local, 0))
+        {
+            return i;
+        }
+    }
+    return KEYPAD_NO_INDEX;
+}
+
+/**
+ * @brief Invalidate one key's rectangle
+ * @param k Keypad
+ * @param index Key index (KEYPAD_NO_INDEX does nothing)
+ */
+static void keypad_invalidate_key(keypad_t *k, uint8_t index)
+{
+    if (index == KEYPAD_NO_INDEX)
+    {
+        return;
+    }
+    lv_area_t content;
+    lv_obj_get_content_coords(k->obj, &content);
+    lv_area_t area = k->rects[index];
+    lv_area_move(&area, content.x1, content.y1);
+    lv_obj_invalidate_area(k->obj, &area);
+}
+
+/**
+ * @brief Send a key: VALUE_CHANGED, then the text area
+ * @param k Keypad
+ * @param index Key index
+ */
+static void keypad_send(keypad_t *k, uint8_t index)
+{
+    uint32_t key = k->layout->keys[index].key;
+    k->lastKey = key;
+    keypad_stats.keys++;
+
+    lv_obj_t *obj = k->obj;
+    if (lv_obj_send_event(obj, LV_EVENT_VALUE_CHANGED, NULL) != LV_RESULT_OK || k->textarea == NULL)
+    {
+        return;
+    }
+
+    lv_obj_t *textarea = k->textarea;
+    switch (key)
+    {
+    case LV_KEY_ENTER:
+        lv_obj_send_event(textarea, LV_EVENT_READY, NULL);
+        break;
+    case LV_KEY_ESC:
+        lv_obj_send_event(textarea, LV_EVENT_CANCEL, NULL);
+        break;
+    case LV_KEY_BACKSPACE:
+        lv_textarea_delete_char(textarea);
+        break;
+    default:
+        lv_textarea_add_char(textarea, key);
+        break;
+    }
+}
+
+/**
+ * @brief Keypad events: draw, press, size, restyle and delete
+ * @param e Event
+ */
+static void keypad_event_cb(lv_event_t *e)
+{
+    lv_obj_t *obj = lv_event_get_current_target_obj(e);
+    keypad_t *k = keypad_find(obj);
+    if (k == NULL)
+    {
+        return;
+    }
+
+    switch (lv_event_get_code(e))
+    {
+    case LV_EVENT_DRAW_MAIN:
+    {
+        lv_layer_t *layer = lv_event_get_layer(e);
+        lv_area_t content;
+        lv_area_t clip;
+        lv_obj_get_content_coords(obj, &content);
+        if (!lv_area_intersect(&clip, &layer->_clip_area, &content))
+        {
+            return;
+        }
+
+        if (k->up == NULL)
+        {
+            // Faces not rendered yet: draw the keys as they are now
+            if (k->width != lv_area_get_width(&content) || k->height != lv_area_get_height(&content))
+            {
+                keypad_layout(k, lv_area_get_width(&content), lv_area_get_height(&content));
+            }
+            keypad_draw_keys(k, layer, content.x1, content.y1, false);
+            keypad_stats.direct++;
+            return;
+        }
+
+        lv_draw_image_dsc_t dsc;
+        lv_draw_image_dsc_init(&dsc);
+        dsc.base.layer = layer;
+        dsc.src = k->up;
+        dsc.image_area = content;
+        lv_area_t clipOri = layer->_clip_area;
+        layer->_clip_area = clip;
+        lv_draw_image(layer, &dsc, &content);
+
+        // The pressed key from the other bitmap, clipped to its rectangle
+        lv_area_t key;
+        if (k->pressed != KEYPAD_NO_INDEX)
+        {
+            key = k->rects[k->pressed];
+            lv_area_move(&key, content.x1, content.y1);
+            if (lv_area_intersect(&layer->_clip_area, &clip, &key))
+            {
+                dsc.src = k->down;
+                lv_draw_image(layer, &dsc, &content);
+            }
+        }
+        layer->_clip_area = clipOri;
+        break;
+    }
+    case LV_EVENT_PRESSED:
+    case LV_EVENT_PRESSING:
+    {
+        lv_indev_t *indev = lv_indev_active();
+        if (indev == NULL)
+        {
+            return;
+        }
+        lv_point_t point;
+        lv_indev_get_point(indev, &point);
+        uint8_t index = keypad_hit(k, &point);
+        if (index != k->pressed)
+        {
+            // Only the two keys change: two small rectangles, or one
+            keypad_invalidate_key(k, k->pressed);
+            keypad_invalidate_key(k, index);
+            k->pressed = index;
+            if (index != KEYPAD_NO_INDEX)
+            {
+                keypad_stats.presses++;
+            }
+        }
+        break;
+    }
+    case LV_EVENT_RELEASED:
+    case LV_EVENT_PRESS_LOST:
+    {
+        uint8_t index = k->pressed;
+        if (index == KEYPAD_NO_INDEX)
+        {
+            return;
+        }
+        keypad_invalidate_key(k, index);
+        k->pressed = KEYPAD_NO_INDEX;
+        if (lv_event_get_code(e) == LV_EVENT_RELEASED)
+        {
+            keypad_send(k, index);
+        }
+        break;
+    }
+    case LV_EVENT_SIZE_CHANGED:
+    case LV_EVENT_STYLE_CHANGED:
+        keypad_invalidate_faces(k);
+        break;
+    case LV_EVENT_DELETE:
+        if (k->scheduled)
+        {
+            lv_async_call_cancel(keypad_render_async, k);
+        }
+        keypad_release(k);
+        memset(k, 0, sizeof(*k));
+        keypad_stats.active--;
+        break;
+    default:
+        break;
+    }
+}
+
+/******************************************************************************
+ * Keypad
+ *****************************************************************************/
+
+/**
+ * @brief Create a keypad
+ * @param parent Parent object
+ * @param layout Keys, NULL for the number layout
+ * @return lv_obj_t* Keypad, NULL once KEYPAD_MAX exist
+ */
+lv_obj_t *MAIN_keypad_create(lv_obj_t *parent, const MAIN_keypad_layout_t *layout)
+{
+    if (layout == NULL)
+    {
+        layout = &MAIN_keypad_layout_number;
+    }
+    keypad_t *k = keypad_find(NULL);
+    if (k == NULL || layout->count > KEYPAD_MAX_KEYS)
+    {
+        Serial.printf("[KEYPAD] ERROR: More than %d keypads or %d keys\n", KEYPAD_MAX, KEYPAD_MAX_KEYS);
+        return NULL;
+    }
+
+    // A bare object with the theme's role styles: no state styles of its
+    // own, so a press changes nothing LVGL would redraw on its own
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_style_t *style = MAIN_theme_get_style(THEME_STYLE_PANEL);
+    if (style != NULL)
+    {
+        lv_obj_add_style(obj, style, LV_PART_MAIN);
+    }
+    style = MAIN_theme_get_style(THEME_STYLE_BUTTON);
+    if (style != NULL)
+    {
+        lv_obj_add_style(obj, style, LV_PART_ITEMS);
+    }
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(obj, KEYPAD_GAP, LV_PART_MAIN);
+    lv_obj_remove_flag(obj, (lv_obj_flag_t)(LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_SCROLL_ON_FOCUS));
+
+    memset(k, 0, sizeof(*k));
+    k->obj = obj;
+    k->layout = layout;
+    k->pressed = KEYPAD_NO_INDEX;
+    keypad_stats.active++;
+
+    lv_obj_add_event_cb(obj, keypad_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+    lv_obj_add_event_cb(obj, keypad_event_cb, LV_EVENT_PRESSED, NULL);
+    lv_obj_add_event_cb(obj, keypad_event_cb, LV_EVENT_PRESSING, NULL);
+    lv_obj_add_event_cb(obj, keypad_event_cb, LV_EVENT_RELEASED, NULL);
+    lv_obj_add_event_cb(obj, keypad_event_cb, LV_EVENT_PRESS_LOST, NULL);
+    lv_obj_add_event_cb(obj, keypad_event_cb, LV_EVENT_SIZE_CHANGED, NULL);
+    lv_obj_add_event_cb(obj, keypad_event_cb, LV_EVENT_STYLE_CHANGED, NULL);
+    lv_obj_add_event_cb(obj, keypad_event_cb, LV_EVENT_DELETE, NULL);
+    return obj;
+}
+
+/**
+ * @brief Type keys into a text area
+ * @param keypad Keypad
+ * @param textarea Text area, NULL for none
+ */
+void MAIN_keypad_set_textarea(lv_obj_t *keypad, lv_obj_t *textarea)
+{
+    keypad_t *k = keypad ? keypad_find(keypad) : NULL;
+    if (k != NULL)
+    {
+        k->textarea = textarea;
+    }
+}
+
+/**
+ * @brief Render the key faces now
+ * @param keypad Keypad
+ * @return true if the faces exist
+ */
+bool MAIN_keypad_prerender(lv_obj_t *keypad)
+{
+    keypad_t *k = keypad ? keypad_find(keypad) : NULL;
+    if (k == NULL)
+    {
+        return false;
+    }
+    lv_obj_update_layout(keypad);
+    if (k->up != NULL && k->width == lv_obj_get_content_width(keypad) &&
+        k->height == lv_obj_get_content_height(keypad))
+    {
+        return true;
+    }
+    if (k->scheduled)
+    {
+        lv_async_call_cancel(keypad_render_async, k);
+        k->scheduled = false;
+    }
+    return keypad_render(k);
+}
+
+/**
+ * @brief Key sent by the latest release
+ * @param keypad Keypad
+ * @return uint32_t Key, KEYPAD_KEY_NONE if none yet
+ */
+uint32_t MAIN_keypad_get_key(lv_obj_t *keypad)
+{
+    keypad_t *k = keypad ? keypad_find(keypad) : NULL;
+    return k != NULL ? k->lastKey : KEYPAD_KEY_NONE;
+}
+
+/**
+ * @brief Keypad counters
+ * @param stats Receives the counters
+ */
+void MAIN_keypad_get_stats(MAIN_keypad_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = keypad_stats;
+    }
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Keypad_getLibraryName() {
+    return MAIN_Keypad::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Keypad_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Keypad::VERSION_MAJOR,
+                       MAIN_Keypad::VERSION_MINOR,
+                       MAIN_Keypad::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Keypad_getVersionDate() {
+    return MAIN_Keypad::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Keypad_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Keypad_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_keypadLib.cpp
+ ******************************************************************************/
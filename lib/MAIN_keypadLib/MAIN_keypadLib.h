@@ -0,0 +1,179 @@
+/**
+ * @file MAIN_keypadLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief On-screen keypad drawn from key faces rendered once
+ * @details Quantities and serials are typed more than anything else is
+ *          done on EARS. An lv_keyboard is a button matrix: every show
+ *          lays out and draws some forty buttons, and every press restyles
+ *          the matrix and draws its buttons again.
+ *
+ *          A keypad renders its key faces once, into two RGB565 bitmaps of
+ *          its content area (PSRAM, through the image draw-buffer
+ *          handlers): every key up, and every key pressed. Drawing it is
+ *          one blit. A press looks up a grid table built with the faces
+ *          (one byte per KEYPAD_HIT_CELL square, the key under it) and
+ *          invalidates only that key's rectangle, which is drawn from the
+ *          pressed bitmap, so a keystroke's feedback is one flush of one
+ *          key. The object itself has no pressed style, so LVGL does not
+ *          invalidate all of it on a press.
+ *
+ *          Keys come from a static MAIN_keypad_layout_t: a grid of rows
+ *          and columns, each key with its span, label and the key it
+ *          sends. Key faces use the THEME_STYLE_BUTTON and
+ *          THEME_STYLE_PRESSED colours, the body THEME_STYLE_PANEL. The
+ *          faces are rendered again, on the next timer run, when the size
+ *          or a style changes (a theme switch); until they exist the keys
+ *          are drawn directly. MAIN_keypad_prerender() renders them up
+ *          front, for a keypad that is built hidden.
+ *
+ *          A released key is sent as LV_EVENT_VALUE_CHANGED
+ *          (MAIN_keypad_get_key()) and, like an lv_keyboard, typed into
+ *          the text area set with MAIN_keypad_set_textarea(): LV_KEY_ENTER
+ *          sends it LV_EVENT_READY, LV_KEY_ESC LV_EVENT_CANCEL.
+ *
+ *          C callable for EEZ screens in src/ui. UI task only.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_KEYPAD_LIB_H__
+#define __MAIN_KEYPAD_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <lvgl.h>
+
+#ifdef __cplusplus
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Keypad
+{
+    constexpr const char* LIB_NAME = "MAIN_Keypad";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_Keypad_getLibraryName();
+uint32_t MAIN_Keypad_getVersionEncoded();
+const char* MAIN_Keypad_getVersionDate();
+void MAIN_Keypad_getVersionString(char* buffer);
+
+extern "C" {
+#endif
+
+/******************************************************************************
+ * Keypad Configuration
+ *****************************************************************************/
+
+// Keypads that can exist at once, and keys in one layout
+#define KEYPAD_MAX 2
+#define KEYPAD_MAX_KEYS 24
+
+// Hit-test grid square, as a shift (3 = 8 px)
+#define KEYPAD_HIT_SHIFT 3
+#define KEYPAD_HIT_CELL (1 << KEYPAD_HIT_SHIFT)
+
+// Space between keys and around them
+#define KEYPAD_GAP 6
+
+// MAIN_keypad_get_key() with no key
+#define KEYPAD_KEY_NONE 0
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    const char *label;          // Face text (static), LV_SYMBOL_* allowed
+    uint32_t key;               // Character, or LV_KEY_BACKSPACE / LV_KEY_ENTER / LV_KEY_ESC
+    uint8_t row;
+    uint8_t col;
+    uint8_t rowSpan;
+    uint8_t colSpan;
+} MAIN_keypad_key_t;
+
+typedef struct
+{
+    const MAIN_keypad_key_t *keys;
+    uint8_t count;              // Up to KEYPAD_MAX_KEYS
+    uint8_t rows;
+    uint8_t cols;
+} MAIN_keypad_layout_t;
+
+typedef struct
+{
+    uint16_t active;            // Keypads that exist
+    uint32_t renders;           // Face pairs rendered
+    uint32_t renderUs;          // Time spent rendering them
+    uint32_t direct;            // Frames drawn key by key (faces not rendered yet)
+    uint32_t presses;           // Keys pressed (one key rectangle invalidated each)
+    uint32_t keys;              // Keys sent
+    uint32_t bytes;             // Face and hit table memory now
+} MAIN_keypad_stats_t;
+
+// Digits, point, minus, backspace, Cancel and OK in a 4 x 4 grid
+extern const MAIN_keypad_layout_t MAIN_keypad_layout_number;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Create a keypad
+ * @param parent Parent object
+ * @param layout Keys (static; NULL = MAIN_keypad_layout_number)
+ * @return lv_obj_t* Keypad (size it), NULL once KEYPAD_MAX exist
+ * @note Text styles (font) of LV_PART_ITEMS apply to the key labels.
+ */
+lv_obj_t *MAIN_keypad_create(lv_obj_t *parent, const MAIN_keypad_layout_t *layout);
+
+/**
+ * @brief Type keys into a text area
+ * @param keypad Keypad
+ * @param textarea Text area, NULL for none
+ */
+void MAIN_keypad_set_textarea(lv_obj_t *keypad, lv_obj_t *textarea);
+
+/**
+ * @brief Render the key faces now
+ * @param keypad Keypad, sized (hidden is fine)
+ * @return true if the faces exist
+ * @note Not from a draw event: this dispatches the draw units.
+ */
+bool MAIN_keypad_prerender(lv_obj_t *keypad);
+
+/**
+ * @brief Key sent by the latest release
+ * @param keypad Keypad
+ * @return uint32_t Key, KEYPAD_KEY_NONE if none yet
+ */
+uint32_t MAIN_keypad_get_key(lv_obj_t *keypad);
+
+/**
+ * @brief Keypad counters
+ * @param stats Receives the counters
+ */
+void MAIN_keypad_get_stats(MAIN_keypad_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MAIN_KEYPAD_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_keypadLib.h
+ ******************************************************************************/
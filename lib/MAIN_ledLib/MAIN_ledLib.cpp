@@ -2,9 +2,10 @@
  * @file MAIN_ledLib.cpp
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief LED indicator management library implementation
- * @details Provides hardware debugging LEDs for visual system status
- * @version 1.0.0
- * @date 20260210
+ * @details Provides hardware debugging LEDs for visual system status, with
+ *          patterns sequenced from an esp_timer
+ * @version 1.1.0
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -15,6 +16,134 @@
 #include "MAIN_ledLib.h"
 #include "EARS_systemDef.h"
 
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+typedef struct
+{
+    MAIN_led_step_t steps[LED_MAX_STEPS];
+    uint8_t count;
+    uint8_t cycles;
+    uint8_t mask;                       // LEDs the pattern drives
+    MAIN_led_priority_t priority;
+} led_pattern_t;
+
+static const uint8_t led_pins[3] = {LED_RED_PIN, LED_YELLOW_PIN, LED_GREEN_PIN};
+
+static portMUX_TYPE led_lock = portMUX_INITIALIZER_UNLOCKED;
+static esp_timer_handle_t led_timer = NULL;
+
+// Steady state set by the on/off calls, and what the pattern shows now
+static uint8_t led_steady = 0;
+static uint8_t led_pattern_lit = 0;
+
+// Sequencer (under led_lock)
+static bool led_playing = false;
+static led_pattern_t led_current;
+static uint8_t led_step = 0;
+static uint8_t led_cycle = 0;
+static led_pattern_t led_queue[LED_QUEUE_SIZE];
+static uint8_t led_queue_head = 0;
+static uint8_t led_queue_count = 0;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Drive the pins: the pattern's LEDs from the pattern, the rest steady
+ * @note Call with led_lock held
+ */
+static void led_output(void)
+{
+    uint8_t owned = led_playing ? led_current.mask : 0;
+    uint8_t lit = (led_steady & ~owned) | (led_pattern_lit & owned);
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        digitalWrite(led_pins[i], (lit & (1u << i)) ? LED_ON : LED_OFF);
+    }
+}
+
+/**
+ * @brief Change the steady state of some LEDs
+ * @param mask LEDs to change
+ * @param on Lit or not
+ */
+static void led_set_steady(uint8_t mask, bool on)
+{
+    portENTER_CRITICAL(&led_lock);
+    led_steady = on ? (led_steady | mask) : (led_steady & ~mask);
+    led_output();
+    portEXIT_CRITICAL(&led_lock);
+}
+
+static void led_toggle_steady(uint8_t mask)
+{
+    portENTER_CRITICAL(&led_lock);
+    led_steady ^= mask;
+    led_output();
+    portEXIT_CRITICAL(&led_lock);
+}
+
+/**
+ * @brief Show the next step, or start the next queued pattern (esp_timer task)
+ * @param arg Unused
+ */
+static void led_advance(void *arg)
+{
+    uint32_t waitUs = 0;
+
+    portENTER_CRITICAL(&led_lock);
+    if (led_playing && led_step >= led_current.count)
+    {
+        led_step = 0;
+        if (++led_cycle >= led_current.cycles)
+        {
+            // Pattern finished - take the next queued one
+            led_cycle = 0;
+            if (led_queue_count > 0)
+            {
+                led_current = led_queue[led_queue_head];
+                led_queue_head = (led_queue_head + 1) % LED_QUEUE_SIZE;
+                led_queue_count--;
+            }
+            else
+            {
+                led_playing = false;
+            }
+        }
+    }
+
+    if (led_playing)
+    {
+        const MAIN_led_step_t *step = &led_current.steps[led_step++];
+        led_pattern_lit = step->mask;
+        waitUs = (uint32_t)step->durationMs * 1000;
+    }
+    else
+    {
+        led_pattern_lit = 0;
+    }
+    led_output();
+    portEXIT_CRITICAL(&led_lock);
+
+    if (waitUs > 0)
+    {
+        esp_timer_start_once(led_timer, waitUs);
+    }
+}
+
+/**
+ * @brief Play a pattern of the same steps repeated
+ */
+static bool led_play_blink(uint8_t mask, uint16_t onMs, uint16_t offMs, uint8_t cycles, MAIN_led_priority_t priority)
+{
+    const MAIN_led_step_t steps[2] = {{mask, onMs}, {0, offMs}};
+    return MAIN_led_play(steps, 2, cycles, priority);
+}
+
 /******************************************************************************
  * Initialisation Functions
  *****************************************************************************/
@@ -34,6 +163,22 @@ void MAIN_led_init(void)
     // Turn all LEDs off initially
     MAIN_led_all_off();
 
+    // Patterns run in the esp_timer task, not the caller's
+    if (led_timer == NULL)
+    {
+        esp_timer_create_args_t timerArgs = {};
+        timerArgs.callback = led_advance;
+        timerArgs.arg = NULL;
+        timerArgs.dispatch_method = ESP_TIMER_TASK;
+        timerArgs.name = "led";
+
+        if (esp_timer_create(&timerArgs, &led_timer) != ESP_OK)
+        {
+            led_timer = NULL;
+            DEBUG_PRINTLN("[LED] WARNING: Pattern timer unavailable - patterns will block");
+        }
+    }
+
     DEBUG_PRINTLN("[LED] Initialisation complete");
     DEBUG_PRINTF("[LED] Red LED on GPIO%d\n", LED_RED_PIN);
     DEBUG_PRINTF("[LED] Yellow LED on GPIO%d\n", LED_YELLOW_PIN);
@@ -50,7 +195,7 @@ void MAIN_led_init(void)
  */
 void MAIN_led_red_on(void)
 {
-    digitalWrite(LED_RED_PIN, LED_ON);
+    led_set_steady(LED_MASK_RED, true);
     DEBUG_PRINTLN("[LED] Red ON");
 }
 
@@ -60,7 +205,7 @@ void MAIN_led_red_on(void)
  */
 void MAIN_led_red_off(void)
 {
-    digitalWrite(LED_RED_PIN, LED_OFF);
+    led_set_steady(LED_MASK_RED, false);
     DEBUG_PRINTLN("[LED] Red OFF");
 }
 
@@ -70,7 +215,7 @@ void MAIN_led_red_off(void)
  */
 void MAIN_led_red_toggle(void)
 {
-    digitalWrite(LED_RED_PIN, !digitalRead(LED_RED_PIN));
+    led_toggle_steady(LED_MASK_RED);
 }
 
 /**
@@ -80,7 +225,7 @@ void MAIN_led_red_toggle(void)
  */
 void MAIN_led_red_set(uint8_t state)
 {
-    digitalWrite(LED_RED_PIN, state);
+    led_set_steady(LED_MASK_RED, state == LED_ON);
 }
 
 /******************************************************************************
@@ -93,7 +238,7 @@ void MAIN_led_red_set(uint8_t state)
  */
 void MAIN_led_yellow_on(void)
 {
-    digitalWrite(LED_YELLOW_PIN, LED_ON);
+    led_set_steady(LED_MASK_YELLOW, true);
     DEBUG_PRINTLN("[LED] Yellow ON");
 }
 
@@ -103,7 +248,7 @@ void MAIN_led_yellow_on(void)
  */
 void MAIN_led_yellow_off(void)
 {
-    digitalWrite(LED_YELLOW_PIN, LED_OFF);
+    led_set_steady(LED_MASK_YELLOW, false);
     DEBUG_PRINTLN("[LED] Yellow OFF");
 }
 
@@ -113,7 +258,7 @@ void MAIN_led_yellow_off(void)
  */
 void MAIN_led_yellow_toggle(void)
 {
-    digitalWrite(LED_YELLOW_PIN, !digitalRead(LED_YELLOW_PIN));
+    led_toggle_steady(LED_MASK_YELLOW);
 }
 
 /**
@@ -123,7 +268,7 @@ void MAIN_led_yellow_toggle(void)
  */
 void MAIN_led_yellow_set(uint8_t state)
 {
-    digitalWrite(LED_YELLOW_PIN, state);
+    led_set_steady(LED_MASK_YELLOW, state == LED_ON);
 }
 
 /******************************************************************************
@@ -136,7 +281,7 @@ void MAIN_led_yellow_set(uint8_t state)
  */
 void MAIN_led_green_on(void)
 {
-    digitalWrite(LED_GREEN_PIN, LED_ON);
+    led_set_steady(LED_MASK_GREEN, true);
     DEBUG_PRINTLN("[LED] Green ON");
 }
 
@@ -146,7 +291,7 @@ void MAIN_led_green_on(void)
  */
 void MAIN_led_green_off(void)
 {
-    digitalWrite(LED_GREEN_PIN, LED_OFF);
+    led_set_steady(LED_MASK_GREEN, false);
     DEBUG_PRINTLN("[LED] Green OFF");
 }
 
@@ -156,7 +301,7 @@ void MAIN_led_green_off(void)
  */
 void MAIN_led_green_toggle(void)
 {
-    digitalWrite(LED_GREEN_PIN, !digitalRead(LED_GREEN_PIN));
+    led_toggle_steady(LED_MASK_GREEN);
 }
 
 /**
@@ -166,7 +311,7 @@ void MAIN_led_green_toggle(void)
  */
 void MAIN_led_green_set(uint8_t state)
 {
-    digitalWrite(LED_GREEN_PIN, state);
+    led_set_steady(LED_MASK_GREEN, state == LED_ON);
 }
 
 /******************************************************************************
@@ -179,9 +324,7 @@ void MAIN_led_green_set(uint8_t state)
  */
 void MAIN_led_all_on(void)
 {
-    digitalWrite(LED_RED_PIN, LED_ON);
-    digitalWrite(LED_YELLOW_PIN, LED_ON);
-    digitalWrite(LED_GREEN_PIN, LED_ON);
+    led_set_steady(LED_MASK_ALL, true);
     DEBUG_PRINTLN("[LED] All LEDs ON");
 }
 
@@ -191,9 +334,7 @@ void MAIN_led_all_on(void)
  */
 void MAIN_led_all_off(void)
 {
-    digitalWrite(LED_RED_PIN, LED_OFF);
-    digitalWrite(LED_YELLOW_PIN, LED_OFF);
-    digitalWrite(LED_GREEN_PIN, LED_OFF);
+    led_set_steady(LED_MASK_ALL, false);
     DEBUG_PRINTLN("[LED] All LEDs OFF");
 }
 
@@ -202,46 +343,134 @@ void MAIN_led_all_off(void)
  *****************************************************************************/
 
 /**
- * @brief Flash all LEDs in sequence
- * @param delay_ms Delay between each LED in milliseconds
+ * @brief Play a pattern without blocking
+ * @param steps Steps (copied, LED_MAX_STEPS kept)
+ * @param count Number of steps
+ * @param cycles Times the steps are played (1 = once)
+ * @param priority Queuing and preemption class
+ * @return true if playing or queued, false if dropped
+ */
+bool MAIN_led_play(const MAIN_led_step_t *steps, uint8_t count, uint8_t cycles, MAIN_led_priority_t priority)
+{
+    if (steps == NULL || count == 0 || cycles == 0)
+    {
+        return false;
+    }
+
+    led_pattern_t pattern;
+    pattern.count = min(count, (uint8_t)LED_MAX_STEPS);
+    pattern.cycles = cycles;
+    pattern.priority = priority;
+    pattern.mask = 0;
+    for (uint8_t i = 0; i < pattern.count; i++)
+    {
+        pattern.steps[i].mask = steps[i].mask & LED_MASK_ALL;
+        pattern.steps[i].durationMs = max(steps[i].durationMs, (uint16_t)1);
+        pattern.mask |= pattern.steps[i].mask;
+    }
+
+    // No timer - fall back to playing inline
+    if (led_timer == NULL)
+    {
+        for (uint8_t c = 0; c < pattern.cycles; c++)
+        {
+            for (uint8_t i = 0; i < pattern.count; i++)
+            {
+                for (uint8_t led = 0; led < 3; led++)
+                {
+                    if (pattern.mask & (1u << led))
+                    {
+                        digitalWrite(led_pins[led], (pattern.steps[i].mask & (1u << led)) ? LED_ON : LED_OFF);
+                    }
+                }
+                delay(pattern.steps[i].durationMs);
+            }
+        }
+        portENTER_CRITICAL(&led_lock);
+        led_output();
+        portEXIT_CRITICAL(&led_lock);
+        return true;
+    }
+
+    bool startNow = false;
+    bool accepted = true;
+
+    portENTER_CRITICAL(&led_lock);
+    if (!led_playing || priority > led_current.priority)
+    {
+        // Idle, or preempt a lower priority pattern
+        led_current = pattern;
+        led_step = 0;
+        led_cycle = 0;
+        led_playing = true;
+        startNow = true;
+    }
+    else if (led_queue_count >= LED_QUEUE_SIZE)
+    {
+        accepted = false;
+    }
+    else
+    {
+        led_queue[(led_queue_head + led_queue_count) % LED_QUEUE_SIZE] = pattern;
+        led_queue_count++;
+    }
+    portEXIT_CRITICAL(&led_lock);
+
+    if (startNow)
+    {
+        // Show the first step from the timer task straight away
+        esp_timer_stop(led_timer);
+        esp_timer_start_once(led_timer, 1);
+    }
+
+    return accepted;
+}
+
+/**
+ * @brief Stop the playing pattern and clear the queue
+ */
+void MAIN_led_stop(void)
+{
+    if (led_timer != NULL)
+    {
+        esp_timer_stop(led_timer);
+    }
+
+    portENTER_CRITICAL(&led_lock);
+    led_playing = false;
+    led_queue_count = 0;
+    led_pattern_lit = 0;
+    led_output();
+    portEXIT_CRITICAL(&led_lock);
+}
+
+/**
+ * @brief Check if a pattern is playing
+ * @return true while a pattern is playing or queued
+ */
+bool MAIN_led_is_playing(void)
+{
+    return led_playing;
+}
+
+/**
+ * @brief Flash all LEDs in sequence (non-blocking)
+ * @param delay_ms Time each step is shown in milliseconds
  * @return void
  */
 void MAIN_led_test_sequence(uint16_t delay_ms)
 {
     DEBUG_PRINTLN("[LED] Running test sequence");
 
-    // Turn all off first
-    MAIN_led_all_off();
-    delay(delay_ms);
-
-    // Red
-    MAIN_led_red_on();
-    delay(delay_ms);
-    MAIN_led_red_off();
-    delay(delay_ms);
-
-    // Yellow
-    MAIN_led_yellow_on();
-    delay(delay_ms);
-    MAIN_led_yellow_off();
-    delay(delay_ms);
-
-    // Green
-    MAIN_led_green_on();
-    delay(delay_ms);
-    MAIN_led_green_off();
-    delay(delay_ms);
-
-    // All together
-    MAIN_led_all_on();
-    delay(delay_ms);
-    MAIN_led_all_off();
-
-    DEBUG_PRINTLN("[LED] Test sequence complete");
+    // Off, red, off, yellow, off, green, off, all together
+    const MAIN_led_step_t steps[LED_MAX_STEPS] = {
+        {0, delay_ms}, {LED_MASK_RED, delay_ms}, {0, delay_ms}, {LED_MASK_YELLOW, delay_ms},
+        {0, delay_ms}, {LED_MASK_GREEN, delay_ms}, {0, delay_ms}, {LED_MASK_ALL, delay_ms}};
+    MAIN_led_play(steps, LED_MAX_STEPS, 1, LED_PRIORITY_NORMAL);
 }
 
 /**
- * @brief Display error pattern on red LED
+ * @brief Display error pattern on red LED (non-blocking, high priority)
  * @details Fast blinking pattern to indicate critical error
  * @param count Number of blink cycles
  * @return void
@@ -250,17 +479,11 @@ void MAIN_led_error_pattern(uint8_t count)
 {
     DEBUG_PRINTF("[LED] Error pattern (%d cycles)\n", count);
 
-    for (uint8_t i = 0; i < count; i++)
-    {
-        MAIN_led_red_on();
-        delay(100); // Fast blink
-        MAIN_led_red_off();
-        delay(100);
-    }
+    led_play_blink(LED_MASK_RED, 100, 100, count, LED_PRIORITY_HIGH); // Fast blink
 }
 
 /**
- * @brief Display warning pattern on yellow LED
+ * @brief Display warning pattern on yellow LED (non-blocking)
  * @details Slow blinking pattern to indicate warning
  * @param count Number of blink cycles
  * @return void
@@ -269,17 +492,11 @@ void MAIN_led_warning_pattern(uint8_t count)
 {
     DEBUG_PRINTF("[LED] Warning pattern (%d cycles)\n", count);
 
-    for (uint8_t i = 0; i < count; i++)
-    {
-        MAIN_led_yellow_on();
-        delay(500); // Slow blink
-        MAIN_led_yellow_off();
-        delay(500);
-    }
+    led_play_blink(LED_MASK_YELLOW, 500, 500, count, LED_PRIORITY_NORMAL); // Slow blink
 }
 
 /**
- * @brief Display success pattern on green LED
+ * @brief Display success pattern on green LED (non-blocking, low priority)
  * @details Quick double-blink to indicate successful operation
  * @return void
  */
@@ -288,13 +505,7 @@ void MAIN_led_success_pattern(void)
     DEBUG_PRINTLN("[LED] Success pattern");
 
     // Double blink
-    MAIN_led_green_on();
-    delay(100);
-    MAIN_led_green_off();
-    delay(100);
-    MAIN_led_green_on();
-    delay(100);
-    MAIN_led_green_off();
+    led_play_blink(LED_MASK_GREEN, 100, 100, 2, LED_PRIORITY_LOW);
 }
 
 /******************************************************************************
@@ -2,9 +2,15 @@
  * @file MAIN_ledLib.h
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief LED indicator management library for EARS development breadboard
- * @details Provides hardware debugging LEDs for visual system status
- * @version 1.0.0
- * @date 20260210
+ * @details Provides hardware debugging LEDs for visual system status.
+ *          Patterns (error, warning, success, test sequence or any
+ *          MAIN_led_play() steps) run from an esp_timer, so they never
+ *          block the caller: a pattern of higher priority preempts the one
+ *          playing, others queue behind it. While a pattern drives an LED,
+ *          on/off/toggle calls for it set the steady state it returns to
+ *          when the pattern ends.
+ * @version 1.1.0
+ * @date 20261015
  *
  * Hardware Configuration:
  * - Red LED (GPIO40):    Critical errors
@@ -25,6 +31,7 @@
  * Includes
  *****************************************************************************/
 #include <Arduino.h>
+#include <esp_timer.h>
 #include "EARS_versionDef.h"
 
 /******************************************************************************
@@ -34,9 +41,9 @@ namespace MAIN_LED
 {
     constexpr const char* LIB_NAME = "MAIN_LED";
     constexpr const char* VERSION_MAJOR = "1";
-    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_MINOR = "1";
     constexpr const char* VERSION_PATCH = "0";
-    constexpr const char* VERSION_DATE = "2026-02-10";
+    constexpr const char* VERSION_DATE = "2026-10-15";
 }
 
 
@@ -59,6 +66,39 @@ void MAIN_LED_getVersionString(char* buffer);
 #define LED_ON HIGH
 #define LED_OFF LOW
 
+// LED selection for pattern steps
+#define LED_MASK_RED 0x01
+#define LED_MASK_YELLOW 0x02
+#define LED_MASK_GREEN 0x04
+#define LED_MASK_ALL (LED_MASK_RED | LED_MASK_YELLOW | LED_MASK_GREEN)
+
+/******************************************************************************
+ * Pattern Configuration
+ *****************************************************************************/
+#define LED_MAX_STEPS 8       // Longest pattern (steps, including gaps)
+#define LED_QUEUE_SIZE 4      // Patterns waiting behind the one playing
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+// One pattern step: the LEDs lit (0 = a gap) and for how long
+typedef struct
+{
+    uint8_t mask;             // LED_MASK_* lit during the step
+    uint16_t durationMs;
+} MAIN_led_step_t;
+
+// Queuing and preemption class of a pattern: a higher priority pattern
+// preempts the one playing (which is dropped), equal or lower ones queue
+// behind it, or are dropped when the queue is full
+typedef enum
+{
+    LED_PRIORITY_LOW = 0,     // Confirmations (success)
+    LED_PRIORITY_NORMAL = 1,  // Warnings, test sequence
+    LED_PRIORITY_HIGH = 2     // Errors
+} MAIN_led_priority_t;
+
 /******************************************************************************
  * Function Prototypes
  *****************************************************************************/
@@ -70,6 +110,29 @@ void MAIN_LED_getVersionString(char* buffer);
  */
 void MAIN_led_init(void);
 
+/**
+ * @brief Play a pattern without blocking
+ * @param steps Steps (copied, LED_MAX_STEPS kept)
+ * @param count Number of steps
+ * @param cycles Times the steps are played (1 = once)
+ * @param priority Queuing and preemption class
+ * @return true if playing or queued, false if dropped
+ * @note The LEDs in any step are the pattern's until it ends, then go back
+ *       to their steady state
+ */
+bool MAIN_led_play(const MAIN_led_step_t *steps, uint8_t count, uint8_t cycles, MAIN_led_priority_t priority);
+
+/**
+ * @brief Stop the playing pattern and clear the queue
+ */
+void MAIN_led_stop(void);
+
+/**
+ * @brief Check if a pattern is playing
+ * @return true while a pattern is playing or queued
+ */
+bool MAIN_led_is_playing(void);
+
 /**
  * @brief Turn red LED on
  * @details Indicates critical error condition
@@ -142,14 +205,14 @@ void MAIN_led_all_on(void);
 void MAIN_led_all_off(void);
 
 /**
- * @brief Flash all LEDs in sequence
- * @param delay_ms Delay between each LED in milliseconds
+ * @brief Flash all LEDs in sequence (non-blocking)
+ * @param delay_ms Time each step is shown in milliseconds
  * @return void
  */
 void MAIN_led_test_sequence(uint16_t delay_ms);
 
 /**
- * @brief Display error pattern on red LED
+ * @brief Display error pattern on red LED (non-blocking, high priority)
  * @details Fast blinking pattern to indicate critical error
  * @param count Number of blink cycles
  * @return void
@@ -157,7 +220,7 @@ void MAIN_led_test_sequence(uint16_t delay_ms);
 void MAIN_led_error_pattern(uint8_t count);
 
 /**
- * @brief Display warning pattern on yellow LED
+ * @brief Display warning pattern on yellow LED (non-blocking)
  * @details Slow blinking pattern to indicate warning
  * @param count Number of blink cycles
  * @return void
@@ -165,7 +228,7 @@ void MAIN_led_error_pattern(uint8_t count);
 void MAIN_led_warning_pattern(uint8_t count);
 
 /**
- * @brief Display success pattern on green LED
+ * @brief Display success pattern on green LED (non-blocking, low priority)
  * @details Quick double-blink to indicate successful operation
  * @return void
  */
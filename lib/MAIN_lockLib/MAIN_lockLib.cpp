@@ -0,0 +1,591 @@
+/**
+ * @file MAIN_lockLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Auto-lock: a PIN overlay that freezes the screen under it
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_lockLib.h"
+#include "EARS_systemDef.h"
+#include "MAIN_themeLib.h"
+#include "MAIN_keypadLib.h"
+#include "MAIN_flowTaskLib.h"
+#include "EARS_configLib.h"
+#include "EARS_nvsEepromLib.h"
+#include "EARS_screenSaverLib.h"
+#include "MAIN_jobSchedulerLib.h"
+#include <Preferences.h>
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static const MAIN_keypad_key_t lock_pin_keys[] = {
+    {"1", '1', 0, 0, 1, 1}, {"2", '2', 0, 1, 1, 1}, {"3", '3', 0, 2, 1, 1},
+    {"4", '4', 1, 0, 1, 1}, {"5", '5', 1, 1, 1, 1}, {"6", '6', 1, 2, 1, 1},
+    {"7", '7', 2, 0, 1, 1}, {"8", '8', 2, 1, 1, 1}, {"9", '9', 2, 2, 1, 1},
+    {LV_SYMBOL_BACKSPACE, LV_KEY_BACKSPACE, 3, 0, 1, 1}, {"0", '0', 3, 1, 1, 1}, {LV_SYMBOL_OK, LV_KEY_ENTER, 3, 2, 1, 1},
+};
+
+static const MAIN_keypad_layout_t lock_pin_layout = {
+    lock_pin_keys, sizeof(lock_pin_keys) / sizeof(lock_pin_keys[0]), 4, 3};
+
+static lv_obj_t *lock_panel = NULL;
+static lv_obj_t *lock_message = NULL;
+static lv_obj_t *lock_pin = NULL;
+static bool lock_locked = false;
+
+// What the lock paused and hid, and so gives back
+static lv_timer_t *lock_timers[LOCK_MAX_TIMERS];
+static uint16_t lock_timer_count = 0;
+static lv_obj_t *lock_hidden[LOCK_MAX_HIDDEN + 1];
+static uint16_t lock_hidden_count = 0;
+
+// Wrong PINs in a row, and the end of a hold-off (0 = none)
+static uint8_t lock_attempts = 0;
+static uint32_t lock_holdoff_until = 0;
+
+// PIN hash, and the check handed to Core 1 (lock_mux guards both)
+static portMUX_TYPE lock_mux = portMUX_INITIALIZER_UNLOCKED;
+static char lock_pin_hash[NVS_PASSWORD_HASH_MAX + 1];
+static char lock_check_pin[LOCK_PIN_MAX + 1];
+static bool lock_check_done = false;
+static bool lock_check_ok = false;
+static bool lock_checking = false; // UI task only
+
+static MAIN_lock_stats_t lock_stats;
+
+/******************************************************************************
+ * Private Functions
+ *****************************************************************************/
+
+/**
+ * @brief Check if a timer drives the display or an input device
+ * @param timer Timer
+ * @return true for a refresh or input read timer (left running)
+ */
+static bool lock_timer_is_needed(lv_timer_t *timer)
+{
+    for (lv_display_t *disp = lv_display_get_next(NULL); disp != NULL; disp = lv_display_get_next(disp))
+    {
+        if (lv_display_get_refr_timer(disp) == timer)
+        {
+            return true;
+        }
+    }
+    for (lv_indev_t *indev = lv_indev_get_next(NULL); indev != NULL; indev = lv_indev_get_next(indev))
+    {
+        if (lv_indev_get_read_timer(indev) == timer)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Pause every running timer that is not needed to show the lock
+ * @details Animations, widget refreshes and flow timers stop where they
+ *          are; timers already paused are left for their owners.
+ */
+static void lock_pause_timers(void)
+{
+    lock_timer_count = 0;
+    for (lv_timer_t *timer = lv_timer_get_next(NULL); timer != NULL; timer = lv_timer_get_next(timer))
+    {
+        if (lock_timer_count >= LOCK_MAX_TIMERS)
+        {
+            break;
+        }
+        if (lv_timer_get_paused(timer) || lock_timer_is_needed(timer))
+        {
+            continue;
+        }
+        lv_timer_pause(timer);
+        lock_timers[lock_timer_count++] = timer;
+    }
+}
+
+/**
+ * @brief Resume the timers lock_pause_timers() paused
+ * @details Only timers still in LVGL's list: one deleted while locked
+ *          (the screensaver's, a one-shot) is not touched.
+ */
+static void lock_resume_timers(void)
+{
+    for (lv_timer_t *timer = lv_timer_get_next(NULL); timer != NULL; timer = lv_timer_get_next(timer))
+    {
+        for (uint16_t i = 0; i < lock_timer_count; i++)
+        {
+            if (lock_timers[i] == timer)
+            {
+                lv_timer_resume(timer);
+                break;
+            }
+        }
+    }
+    lock_timer_count = 0;
+}
+
+/**
+ * @brief Hide an object and remember it, if it is shown
+ * @param obj Object (NULL does nothing)
+ */
+static void lock_hide(lv_obj_t *obj)
+{
+    if (obj == NULL || obj == lock_panel || lock_hidden_count > LOCK_MAX_HIDDEN ||
+        lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN))
+    {
+        return;
+    }
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    lock_hidden[lock_hidden_count++] = obj;
+}
+
+/**
+ * @brief Set the message above the PIN
+ * @param text Static text
+ */
+static void lock_set_message(const char *text)
+{
+    lv_label_set_text_static(lock_message, text);
+}
+
+/**
+ * @brief Take the lock down and give the screen back
+ */
+static void lock_release(void)
+{
+    uint32_t startUs = micros();
+
+    lv_obj_add_flag(lock_panel, LV_OBJ_FLAG_HIDDEN);
+    for (uint16_t i = 0; i < lock_hidden_count; i++)
+    {
+        if (lv_obj_is_valid(lock_hidden[i]))
+        {
+            lv_obj_remove_flag(lock_hidden[i], LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+    lock_hidden_count = 0;
+    lock_resume_timers();
+    MAIN_flow_set_paused(false);
+
+    lock_locked = false;
+    lock_attempts = 0;
+    lock_stats.unlocks++;
+    lock_stats.unlockUs = micros() - startUs;
+    DEBUG_PRINTLN("[LOCK] Unlocked");
+}
+
+/**
+ * @brief Check the PIN handed over by lock_pin_cb() (Core 1 job)
+ * @param ctx Unused
+ */
+static void lock_check_job(void *ctx)
+{
+    (void)ctx;
+    char pin[LOCK_PIN_MAX + 1];
+    char hash[NVS_PASSWORD_HASH_MAX + 1];
+
+    portENTER_CRITICAL(&lock_mux);
+    memcpy(pin, lock_check_pin, sizeof(pin));
+    memcpy(hash, lock_pin_hash, sizeof(hash));
+    memset(lock_check_pin, 0, sizeof(lock_check_pin));
+    portEXIT_CRITICAL(&lock_mux);
+
+    uint32_t startUs = micros();
+    bool ok = EARS_nvsEeprom::verifyPasswordHash(String(pin), hash);
+    uint32_t verifyUs = micros() - startUs;
+    memset(pin, 0, sizeof(pin));
+
+    portENTER_CRITICAL(&lock_mux);
+    lock_check_ok = ok;
+    lock_check_done = true;
+    lock_stats.verifyUs = verifyUs;
+    portEXIT_CRITICAL(&lock_mux);
+}
+
+/**
+ * @brief Act on a finished PIN check
+ * @param ok true if the PIN matched
+ */
+static void lock_check_result(bool ok)
+{
+    if (ok)
+    {
+        lock_release();
+        return;
+    }
+
+    lock_stats.failures++;
+    if (++lock_attempts >= LOCK_ATTEMPTS)
+    {
+        lock_attempts = 0;
+        lock_holdoff_until = millis() + LOCK_HOLDOFF_MS;
+        if (lock_holdoff_until == 0)
+        {
+            lock_holdoff_until = 1;
+        }
+        lv_label_set_text_fmt(lock_message, "Too many attempts, wait %lu s", (unsigned long)(LOCK_HOLDOFF_MS / 1000));
+        return;
+    }
+    lock_set_message("Wrong PIN");
+}
+
+/**
+ * @brief OK on the PIN pad: hand the PIN to Core 1 for checking
+ * @param e Event (LV_EVENT_READY of the text area)
+ */
+static void lock_pin_cb(lv_event_t *e)
+{
+    (void)e;
+    if (!lock_locked || lock_checking)
+    {
+        return;
+    }
+
+    if (lock_holdoff_until != 0)
+    {
+        if ((int32_t)(millis() - lock_holdoff_until) < 0)
+        {
+            lock_stats.refused++;
+            lv_textarea_set_text(lock_pin, "");
+            lv_label_set_text_fmt(lock_message, "Too many attempts, wait %lu s",
+                                  (unsigned long)((lock_holdoff_until - millis() + 999) / 1000));
+            return;
+        }
+        lock_holdoff_until = 0;
+    }
+
+    const char *pin = lv_textarea_get_text(lock_pin);
+    size_t length = strlen(pin);
+    if (length == 0)
+    {
+        return;
+    }
+    if (length < LOCK_PIN_MIN)
+    {
+        lv_textarea_set_text(lock_pin, "");
+        lock_check_result(false);
+        return;
+    }
+
+    portENTER_CRITICAL(&lock_mux);
+    strlcpy(lock_check_pin, pin, sizeof(lock_check_pin));
+    lock_check_done = false;
+    portEXIT_CRITICAL(&lock_mux);
+    lv_textarea_set_text(lock_pin, "");
+
+    // Without a free job slot the check runs here, on the UI task
+    lock_checking = true;
+    if (MAIN_job_add("lock", lock_check_job, NULL, 0, 0, JOB_PRIORITY_HIGH, 0) == JOB_INVALID)
+    {
+        lock_check_job(NULL);
+    }
+    lock_set_message("Checking...");
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Build the lock panel, hidden
+ */
+bool MAIN_initialise_lock(void)
+{
+    if (lock_panel != NULL)
+    {
+        return true;
+    }
+
+    Preferences prefs;
+    if (prefs.begin(LOCK_NVS_NAMESPACE, true))
+    {
+        char hash[sizeof(lock_pin_hash)];
+        if (prefs.getString(LOCK_NVS_KEY, hash, sizeof(hash)) > 0)
+        {
+            portENTER_CRITICAL(&lock_mux);
+            memcpy(lock_pin_hash, hash, sizeof(hash));
+            portEXIT_CRITICAL(&lock_mux);
+        }
+        prefs.end();
+    }
+
+    lock_panel = lv_obj_create(lv_layer_top());
+    lv_style_t *style = MAIN_theme_get_style(THEME_STYLE_SCREEN);
+    if (style != NULL)
+    {
+        lv_obj_add_style(lock_panel, style, 0);
+    }
+    lv_obj_set_size(lock_panel, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_style_bg_opa(lock_panel, LV_OPA_COVER, 0);
+    lv_obj_set_flex_flow(lock_panel, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(lock_panel, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_remove_flag(lock_panel, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(lock_panel, (lv_obj_flag_t)(LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_HIDDEN));
+
+    lv_obj_t *title = lv_label_create(lock_panel);
+    style = MAIN_theme_get_style(THEME_STYLE_ACCENT);
+    if (style != NULL)
+    {
+        lv_obj_add_style(title, style, 0);
+    }
+    lv_label_set_text_static(title, LV_SYMBOL_EYE_CLOSE " Locked");
+
+    lock_message = lv_label_create(lock_panel);
+    lock_set_message("Enter PIN");
+
+    // Timers are paused while locked: no cursor blink, and no delayed
+    // masking of the last digit, which would then stay readable
+    lock_pin = lv_textarea_create(lock_panel);
+    lv_obj_set_width(lock_pin, LV_PCT(60));
+    lv_textarea_set_one_line(lock_pin, true);
+    lv_textarea_set_password_mode(lock_pin, true);
+    lv_textarea_set_password_show_time(lock_pin, 0);
+    lv_textarea_set_max_length(lock_pin, LOCK_PIN_MAX);
+    lv_textarea_set_accepted_chars(lock_pin, "0123456789");
+    lv_obj_set_style_opa(lock_pin, LV_OPA_TRANSP, LV_PART_CURSOR);
+    lv_obj_add_event_cb(lock_pin, lock_pin_cb, LV_EVENT_READY, NULL);
+
+    lv_obj_t *pad = MAIN_keypad_create(lock_panel, &lock_pin_layout);
+    if (pad == NULL)
+    {
+        lv_obj_delete(lock_panel);
+        lock_panel = NULL;
+        Serial.println("[LOCK] ERROR: No keypad for the PIN pad");
+        return false;
+    }
+    lv_obj_set_width(pad, LV_PCT(100));
+    lv_obj_set_flex_grow(pad, 1);
+    MAIN_keypad_set_textarea(pad, lock_pin);
+    MAIN_keypad_prerender(pad);
+
+    DEBUG_PRINTLN("[OK] Lock ready");
+    return true;
+}
+
+/**
+ * @brief Lock now
+ */
+bool MAIN_lock_now(void)
+{
+    if (lock_locked)
+    {
+        return true;
+    }
+    if (lock_panel == NULL || !MAIN_lock_has_pin())
+    {
+        return false;
+    }
+
+    uint32_t startUs = micros();
+
+    // The panel first, so nothing below is shown for a frame
+    lv_textarea_set_text(lock_pin, "");
+    lock_set_message("Enter PIN");
+    lv_obj_move_foreground(lock_panel);
+    lv_obj_set_flag(lock_panel, LV_OBJ_FLAG_HIDDEN, using_screensaver().isActive());
+
+    // Under the screensaver the working screen is the covered one
+    lock_hidden_count = 0;
+    lv_obj_t *screen = using_screensaver().isActive() ? using_screensaver().getCoveredScreen() : lv_screen_active();
+    lock_hide(screen);
+    lv_obj_t *top = lv_layer_top();
+    uint32_t children = lv_obj_get_child_count(top);
+    for (uint32_t i = 0; i < children; i++)
+    {
+        lock_hide(lv_obj_get_child(top, i));
+    }
+
+    MAIN_flow_set_paused(true);
+    lock_pause_timers();
+
+    lock_locked = true;
+    lock_stats.locks++;
+    lock_stats.timersPaused = lock_timer_count;
+    lock_stats.objectsHidden = lock_hidden_count;
+    lock_stats.lockUs = micros() - startUs;
+    DEBUG_PRINTF("[LOCK] Locked: %u timers paused, %u objects hidden\n", lock_timer_count, lock_hidden_count);
+    return true;
+}
+
+/**
+ * @brief Set or clear the lock PIN
+ */
+bool MAIN_lock_set_pin(const char *pin)
+{
+    if (lock_locked)
+    {
+        return false;
+    }
+
+    size_t length = pin != NULL ? strlen(pin) : 0;
+    if (length != 0 && (length < LOCK_PIN_MIN || length > LOCK_PIN_MAX))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++)
+    {
+        if (pin[i] < '0' || pin[i] > '9')
+        {
+            return false;
+        }
+    }
+
+    String hash;
+    if (length != 0)
+    {
+        hash = EARS_nvsEeprom::makePasswordHash(String(pin));
+        if (hash.length() == 0)
+        {
+            return false;
+        }
+    }
+
+    Preferences prefs;
+    if (!prefs.begin(LOCK_NVS_NAMESPACE, false))
+    {
+        return false;
+    }
+    bool stored;
+    if (length != 0)
+    {
+        stored = prefs.putString(LOCK_NVS_KEY, hash) > 0;
+    }
+    else
+    {
+        prefs.remove(LOCK_NVS_KEY);
+        stored = !prefs.isKey(LOCK_NVS_KEY);
+    }
+    prefs.end();
+    if (!stored)
+    {
+        return false;
+    }
+
+    portENTER_CRITICAL(&lock_mux);
+    strlcpy(lock_pin_hash, hash.c_str(), sizeof(lock_pin_hash));
+    portEXIT_CRITICAL(&lock_mux);
+    DEBUG_PRINTLN(length != 0 ? "[LOCK] PIN set" : "[LOCK] PIN cleared");
+    return true;
+}
+
+/**
+ * @brief Check if a lock PIN is set
+ */
+bool MAIN_lock_has_pin(void)
+{
+    portENTER_CRITICAL(&lock_mux);
+    bool has = lock_pin_hash[0] != '\0';
+    portEXIT_CRITICAL(&lock_mux);
+    return has;
+}
+
+/**
+ * @brief Check if locked
+ */
+bool MAIN_lock_is_locked(void)
+{
+    return lock_locked;
+}
+
+/**
+ * @brief Auto-lock on inactivity, and the screensaver handover
+ */
+void MAIN_lock_update(void)
+{
+    if (lock_panel == NULL)
+    {
+        return;
+    }
+
+    if (lock_locked)
+    {
+        if (lock_checking)
+        {
+            portENTER_CRITICAL(&lock_mux);
+            bool done = lock_check_done;
+            bool ok = lock_check_ok;
+            portEXIT_CRITICAL(&lock_mux);
+            if (done)
+            {
+                lock_checking = false;
+                lock_check_result(ok);
+                if (!lock_locked)
+                {
+                    return;
+                }
+            }
+        }
+
+        // The screensaver's screen shows while it runs, the panel after
+        bool saver = using_screensaver().isActive();
+        if (lv_obj_has_flag(lock_panel, LV_OBJ_FLAG_HIDDEN) != saver)
+        {
+            lv_obj_set_flag(lock_panel, LV_OBJ_FLAG_HIDDEN, saver);
+        }
+        return;
+    }
+
+    const EARS_configSecurity &security = using_config().security();
+    if (!security.requirePassword || security.autoLockMinutes == 0)
+    {
+        return;
+    }
+    if (lv_display_get_inactive_time(NULL) >= (uint32_t)security.autoLockMinutes * 60000UL)
+    {
+        MAIN_lock_now();
+    }
+}
+
+/**
+ * @brief Lock counters
+ */
+void MAIN_lock_get_stats(MAIN_lock_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        portENTER_CRITICAL(&lock_mux);
+        *stats = lock_stats;
+        portEXIT_CRITICAL(&lock_mux);
+    }
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Lock_getLibraryName() {
+    return MAIN_Lock::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Lock_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Lock::VERSION_MAJOR,
+                       MAIN_Lock::VERSION_MINOR,
+                       MAIN_Lock::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Lock_getVersionDate() {
+    return MAIN_Lock::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Lock_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Lock_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_lockLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,180 @@
+/**
+ * @file MAIN_lockLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Auto-lock: a PIN overlay that freezes the screen under it
+ * @details ears.config's security.require_password and auto_lock_minutes
+ *          ask for the unit to lock when left alone. Locking by loading a
+ *          lock screen would throw away what was on screen, and unlocking
+ *          would mean building it and running its flows again.
+ *
+ *          The lock is a full-screen panel on lv_layer_top, built hidden by
+ *          MAIN_initialise_lock() with a one-line password text area and a
+ *          MAIN_keypadLib PIN pad (faces rendered then). Locking:
+ *
+ *          - hides the screen (the one under the screensaver if that is
+ *            up) and the other lv_layer_top children: hidden objects are
+ *            neither drawn nor invalidated, so what Core 1 still posts to
+ *            them costs nothing, and their state is untouched
+ *          - pauses every LVGL timer except the display refresh and input
+ *            reads, and the EEZ flow (MAIN_flow_set_paused)
+ *          - shows the panel
+ *
+ *          A few flag writes and one full-screen redraw: the lock is on
+ *          screen the next frame. Unlocking undoes exactly that, so the
+ *          screen comes back as it was, one frame again.
+ *
+ *          The lock has its own PIN, LOCK_PIN_MIN to LOCK_PIN_MAX digits,
+ *          set with MAIN_lock_set_pin(). It is not the NVS password: that
+ *          takes any text, and the pad types only digits. Its PBKDF2 hash
+ *          (EARS_nvsEeprom::makePasswordHash()) is kept in the "ears_lock"
+ *          NVS namespace and read into RAM by MAIN_initialise_lock().
+ *
+ *          OK hands the PIN to a one-shot Core 1 job. PBKDF2 takes
+ *          milliseconds (NVS_PASSWORD_ITERATIONS of HMAC-SHA256), too long
+ *          to block the UI task for. The panel shows "Checking" until
+ *          MAIN_lock_update() picks up the result. After LOCK_ATTEMPTS
+ *          wrong PINs in a row entries are refused for LOCK_HOLDOFF_MS.
+ *
+ *          MAIN_lock_update() (UI task, every pass) locks once LVGL has
+ *          seen no input for auto_lock_minutes, when require_password is
+ *          set and a PIN exists, and keeps the panel out of the way while
+ *          the screensaver runs.
+ *
+ *          C callable for EEZ actions in src/ui. UI task only.
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_LOCK_LIB_H__
+#define __MAIN_LOCK_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <lvgl.h>
+
+#ifdef __cplusplus
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Lock
+{
+    constexpr const char* LIB_NAME = "MAIN_Lock";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "1";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_Lock_getLibraryName();
+uint32_t MAIN_Lock_getVersionEncoded();
+const char* MAIN_Lock_getVersionDate();
+void MAIN_Lock_getVersionString(char* buffer);
+
+extern "C" {
+#endif
+
+/******************************************************************************
+ * Lock Configuration
+ *****************************************************************************/
+
+// Shortest and longest PIN
+#define LOCK_PIN_MIN 4
+#define LOCK_PIN_MAX 16
+
+// Where the PIN hash is kept
+#define LOCK_NVS_NAMESPACE "ears_lock"
+#define LOCK_NVS_KEY "pin"
+
+// Wrong PINs in a row before entries are refused, and for how long
+#define LOCK_ATTEMPTS 5
+#define LOCK_HOLDOFF_MS 30000
+
+// LVGL timers and lv_layer_top children one lock can pause and hide
+#define LOCK_MAX_TIMERS 48
+#define LOCK_MAX_HIDDEN 8
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t locks;
+    uint32_t unlocks;
+    uint32_t failures;          // Wrong PINs
+    uint32_t refused;           // Entries refused during a hold-off
+    uint32_t lockUs;            // Latest lock, panel shown to timers paused
+    uint32_t unlockUs;          // Latest unlock, excluding the PIN check
+    uint32_t verifyUs;          // Latest PIN check (Core 1 job)
+    uint16_t timersPaused;      // By the latest lock
+    uint16_t objectsHidden;     // By the latest lock, the screen included
+} MAIN_lock_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Build the lock panel, hidden
+ * @return true if built
+ * @note After MAIN_initialise_dialogs(): the PIN pad takes a keypad slot.
+ */
+bool MAIN_initialise_lock(void);
+
+/**
+ * @brief Lock now
+ * @return true if locked (or already locked); false without a PIN
+ */
+bool MAIN_lock_now(void);
+
+/**
+ * @brief Set or clear the lock PIN
+ * @param pin LOCK_PIN_MIN to LOCK_PIN_MAX digits; NULL or "" clears it
+ * @return true if stored; false for other text, while locked, or on an
+ *         NVS failure
+ * @note Hashes on the calling task (PBKDF2, a few milliseconds).
+ */
+bool MAIN_lock_set_pin(const char *pin);
+
+/**
+ * @brief Check if a lock PIN is set
+ * @return true if the lock can be used
+ */
+bool MAIN_lock_has_pin(void);
+
+/**
+ * @brief Check if locked
+ * @return true while the lock is up
+ */
+bool MAIN_lock_is_locked(void);
+
+/**
+ * @brief Auto-lock on inactivity, and the screensaver handover
+ * @note UI task, every pass, after the screensaver's update.
+ */
+void MAIN_lock_update(void);
+
+/**
+ * @brief Lock counters
+ * @param stats Receives the counters
+ */
+void MAIN_lock_get_stats(MAIN_lock_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MAIN_LOCK_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_lockLib.h
+ ******************************************************************************/
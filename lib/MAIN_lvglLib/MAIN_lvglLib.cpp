@@ -3,8 +3,8 @@
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief LVGL 9.3.0 initialization and management (extracted from main.cpp)
  * @details Handles LVGL display setup, buffers, and callbacks
- * @version 1.0.0
- * @date 20260210
+ * @version 1.17.1
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -14,6 +14,21 @@
  *****************************************************************************/
 #include "MAIN_lvglLib.h"
 #include "EARS_systemDef.h"
+#include "MAIN_sysinfoLib.h"
+#include "MAIN_memPlanLib.h"
+#include "EARS_loggerLib.h"
+#include "MAIN_drawSwAsmLib.h"
+#include "MAIN_lvglMemLib.h"
+#include "EARS_placementDef.h"
+#include "EARS_profileLib.h"
+#include "EARS_rtosTraceLib.h"
+#include "MAIN_rtosStaticLib.h"
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <atomic>
+
+// Display internals needed to pre-join invalidated areas
+#include <lvgl_private.h>
 
 // Only include LED lib if debug mode enabled
 #if EARS_DEBUG == 1
@@ -28,8 +43,17 @@
 static lv_display_t *lvgl_disp = NULL;
 
 // Display buffers
-static lv_color_t *disp_draw_buf1 = NULL;
-static lv_color_t *disp_draw_buf2 = NULL;
+static lv_color_t *disp_draw_bufs[LVGL_PIPELINE_MAX_STRIPS];
+static uint8_t draw_buf_count = 0;
+
+// Pipelined strips: LVGL sees two of them, the flush callback rotates the rest
+static lv_draw_buf_t strip_bufs[LVGL_PIPELINE_MAX_STRIPS];
+static uint8_t strip_count = 0; // 0 = not pipelined
+
+// Display buffer layout (stored during init)
+static uint32_t draw_buf_bytes = 0;
+static bool draw_buf_in_psram = false;
+static lv_display_render_mode_t display_render_mode = LV_DISPLAY_RENDER_MODE_PARTIAL;
 
 // Display dimensions (stored during init)
 static uint32_t display_width = 0;
@@ -41,29 +65,657 @@ static Arduino_GFX *display_gfx = NULL;
 // FreeRTOS mutex for display access
 static SemaphoreHandle_t display_mutex = NULL;
 
+// Asynchronous flush state
+typedef struct
+{
+    lv_display_t *disp;
+    lv_area_t area;
+    uint8_t *px_map;
+    bool last;              // Final area of the frame
+    uint32_t renderStartUs; // Frame's LV_EVENT_REFR_START (latency probe)
+} lvgl_flush_job_t;
+
+static QueueHandle_t flush_queue = NULL;
+static SemaphoreHandle_t flush_done_sem = NULL;
+static TaskHandle_t flush_task_handle = NULL;
+static TaskHandle_t wake_task_handle = NULL;
+
+// Flush taps (MAIN_lvgl_add_flush_tap), LVGL task only
+static MAIN_lvgl_flush_tap_t flush_taps[LVGL_FLUSH_TAPS] = {};
+static uint8_t flush_tap_count = 0;
+
+// Flush task, queue and semaphore memory (internal RAM, never from the heap)
+#define LVGL_FLUSH_QUEUE_MAX_DEPTH \
+    (LVGL_PIPELINE_MAX_STRIPS > LVGL_FLUSH_QUEUE_DEPTH ? LVGL_PIPELINE_MAX_STRIPS : LVGL_FLUSH_QUEUE_DEPTH)
+MAIN_STATIC_TASK(flush_task, LVGL_FLUSH_TASK_STACK_SIZE);
+static uint8_t flush_queue_storage[LVGL_FLUSH_QUEUE_MAX_DEPTH * sizeof(lvgl_flush_job_t)];
+static StaticQueue_t flush_queue_buffer;
+static StaticSemaphore_t flush_done_sem_buffer;
+static std::atomic<uint32_t> flush_in_flight(0); // Written from both cores
+static volatile int64_t first_frame_us = 0;       // Boot profiler milestone
+
+// Dirty-area coalescing counters
+static MAIN_lvgl_coalesce_stats_t coalesce_stats = {0, 0, 0, 0};
+
+// Performance counters
+static MAIN_lvgl_stats_t perf_stats;
+static int64_t frame_start_us = 0;
+static bool frame_started = false;
+
+// Latency probe input source (LVGL task)
+static MAIN_lvgl_input_time_fn_t latency_input_time = NULL;
+
+// Bus idle within the frame being flushed (flushing task only)
+static int64_t bus_last_end_us = 0; // End of the previous transfer, 0 = frame not started
+static uint32_t bus_idle_us = 0;
+
+// Upper bound (exclusive) of each frame-time histogram bucket in ms
+static const uint32_t EARS_HOT_DATA frame_hist_limits_ms[LVGL_STATS_HIST_BUCKETS - 1] = {2, 4, 8, 16, 33, 66};
+
+#if LV_USE_OS == LV_OS_FREERTOS
+// Software draw threads pinned so far (created inside lv_init)
+static uint8_t draw_threads_pinned = 0;
+#endif
+
+#if LVGL_TE_SYNC == 1 && LCD_TE >= 0
+#define LVGL_TE_ACTIVE 1
+#else
+#define LVGL_TE_ACTIVE 0
+#endif
+
+#if LVGL_TE_ACTIVE == 1
+// TE pacing: pulse time, smoothed period and count written by the TE ISR
+static SemaphoreHandle_t te_sem = NULL;
+static StaticSemaphore_t te_sem_buffer;
+static volatile int64_t te_last_us = 0;
+static volatile uint32_t te_period_us = 0;
+static volatile uint32_t te_edges = 0;
+
+// Measured bus rate for transfer time estimates (flushing task only)
+static uint32_t te_px_per_ms = 0;
+#endif
+
 /******************************************************************************
  * LVGL Callback Functions
  *****************************************************************************/
 
+#if LVGL_TE_ACTIVE == 1
 /**
- * @brief LVGL display flush callback
- * @details Called by LVGL when a region needs to be drawn to the display
+ * @brief TE pulse (start of V-blank): time it and wake a held flush
+ */
+static void IRAM_ATTR lvgl_te_isr(void)
+{
+    EARS_RTOS_TRACE_MARK(RTOS_TRACE_TE_IRQ, 0);
+    int64_t now = esp_timer_get_time();
+    if (te_last_us != 0)
+    {
+        // 5-50 ms (200-20 Hz): anything else is a glitch or a panel waking up
+        uint32_t gap = (uint32_t)(now - te_last_us);
+        if (gap > 5000 && gap < 50000)
+        {
+            te_period_us = te_period_us ? (te_period_us * 7 + gap) / 8 : gap;
+        }
+    }
+    te_last_us = now;
+    te_edges = te_edges + 1;
+
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(te_sem, &woken);
+    if (woken == pdTRUE)
+    {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+ * @brief Check that TE pulses have been timed and are still arriving
+ * @details A sleeping panel, or a TE pin with nothing on it, stops the
+ *          pulses; flushes then go out unpaced until they return.
  */
-void MAIN_lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+static bool EARS_HOT lvgl_te_running(void)
 {
+    uint32_t period = te_period_us;
+    return te_edges >= LVGL_TE_SETTLE_EDGES && period != 0 &&
+           esp_timer_get_time() - te_last_us <= (int64_t)period * 2;
+}
+
+/**
+ * @brief Panel gate lines an area covers
+ * @details The ST7796 scans its native portrait rows whatever MADCTL
+ *          says, so the landscape rotations map x onto gate lines.
+ */
+static void EARS_HOT lvgl_te_scan_span(const lv_area_t *area, int32_t *first, int32_t *last)
+{
+    switch (display_gfx->getRotation())
+    {
+    case 1:
+        *first = area->x1;
+        *last = area->x2;
+        break;
+    case 2:
+        *first = LVGL_TE_SCAN_LINES - 1 - area->y2;
+        *last = LVGL_TE_SCAN_LINES - 1 - area->y1;
+        break;
+    case 3:
+        *first = LVGL_TE_SCAN_LINES - 1 - area->x2;
+        *last = LVGL_TE_SCAN_LINES - 1 - area->x1;
+        break;
+    default:
+        *first = area->y1;
+        *last = area->y2;
+        break;
+    }
+}
+
+/**
+ * @brief Hold an area until V-blank if the scan would cross it mid-transfer
+ * @details The scan line is placed from the time since the last pulse and
+ *          the transfer time from the measured bus rate. If the lines the
+ *          scan passes while the area is sent include any of the area's,
+ *          the panel would show half old and half new pixels, so the
+ *          transfer waits for the next pulse (at most two periods).
+ */
+static void EARS_HOT lvgl_te_pace(const lv_area_t *area)
+{
+    if (te_sem == NULL || display_gfx == NULL || !lvgl_te_running())
+    {
+        return;
+    }
+
+    uint32_t period = te_period_us;
+    int32_t first, last;
+    lvgl_te_scan_span(area, &first, &last);
+
+    int64_t start_us = esp_timer_get_time();
+    uint32_t since = (uint32_t)(start_us - te_last_us) % period;
+    int32_t scan = (int32_t)((uint64_t)since * LVGL_TE_SCAN_LINES / period);
+    uint32_t xfer_us = te_px_per_ms ? (uint32_t)((uint64_t)lv_area_get_size(area) * 1000 / te_px_per_ms) : period;
+    int32_t end = scan + (int32_t)((uint64_t)xfer_us * LVGL_TE_SCAN_LINES / period);
+
+    // Lines scanned during the transfer, wrapping into the next refresh
+    bool crosses = (scan <= last && end >= first) || (end - LVGL_TE_SCAN_LINES >= first);
+    if (!crosses)
+    {
+        return;
+    }
+
+    xSemaphoreTake(te_sem, 0); // A pulse already passed does not count
+    if (xSemaphoreTake(te_sem, pdMS_TO_TICKS(period / 500 + 1)) == pdTRUE)
+    {
+        perf_stats.teWaits++;
+        perf_stats.totalTeWaitUs += (uint64_t)(esp_timer_get_time() - start_us);
+    }
+    else
+    {
+        perf_stats.teMisses++;
+    }
+}
+#endif
+
+/**
+ * @brief Send pixels in the byte order LVGL rendered them
+ * @details RGB565_SWAPPED is already big endian, so draw16bitBeRGBBitmap
+ *          writes it as is; plain RGB565 is swapped by the driver.
+ */
+static inline void lvgl_draw_bitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h)
+{
+#if LVGL_NATIVE_BYTE_ORDER == 1
+    display_gfx->draw16bitBeRGBBitmap(x, y, bitmap, w, h);
+#else
+    display_gfx->draw16bitRGBBitmap(x, y, bitmap, w, h);
+#endif
+}
+
+/**
+ * @brief Push one area to the panel under the display mutex
+ * @param last Final area of the frame (closes the SPI idle count)
+ */
+static void EARS_HOT lvgl_push_area(const lv_area_t *area, uint8_t *px_map, bool last)
+{
+    EARS_RTOS_TRACE_SCOPE(RTOS_TRACE_FLUSH);
+
     uint32_t w = lv_area_get_width(area);
     uint32_t h = lv_area_get_height(area);
 
     if (display_mutex != NULL && display_gfx != NULL)
     {
+#if LVGL_TE_ACTIVE == 1
+        lvgl_te_pace(area);
+#endif
+        EARS_RTOS_TRACE_BEGIN(RTOS_TRACE_MUTEX_WAIT);
         if (xSemaphoreTake(display_mutex, portMAX_DELAY) == pdTRUE)
         {
-            display_gfx->draw16bitRGBBitmap(area->x1, area->y1, (uint16_t *)px_map, w, h);
+            EARS_RTOS_TRACE_END(RTOS_TRACE_MUTEX_WAIT);
+            EARS_RTOS_TRACE_BEGIN(RTOS_TRACE_MUTEX_HOLD);
+            int64_t start_us = esp_timer_get_time();
+
+            if (display_render_mode == LV_DISPLAY_RENDER_MODE_DIRECT && w != display_width)
+            {
+                // DIRECT mode: px_map is the whole frame, send the area row by row
+                uint16_t *row = (uint16_t *)px_map + (area->y1 * display_width) + area->x1;
+                for (int32_t y = area->y1; y <= area->y2; y++)
+                {
+                    lvgl_draw_bitmap(area->x1, y, row, w, 1);
+                    row += display_width;
+                }
+            }
+            else if (display_render_mode == LV_DISPLAY_RENDER_MODE_DIRECT)
+            {
+                // Full-width rows are contiguous in the frame buffer
+                uint16_t *start = (uint16_t *)px_map + (area->y1 * display_width);
+                lvgl_draw_bitmap(area->x1, area->y1, start, w, h);
+            }
+            else
+            {
+                lvgl_draw_bitmap(area->x1, area->y1, (uint16_t *)px_map, w, h);
+            }
             xSemaphoreGive(display_mutex);
+            EARS_RTOS_TRACE_END(RTOS_TRACE_MUTEX_HOLD);
+
+            int64_t end_us = esp_timer_get_time();
+            uint32_t elapsed_us = (uint32_t)(end_us - start_us);
+            perf_stats.lastFlushUs = elapsed_us;
+            perf_stats.totalFlushUs += elapsed_us;
+            if (elapsed_us > perf_stats.maxFlushUs)
+            {
+                perf_stats.maxFlushUs = elapsed_us;
+            }
+            perf_stats.bytesFlushed += (uint64_t)w * h * 2;
+#if LVGL_TE_ACTIVE == 1
+            if (elapsed_us > 0)
+            {
+                uint32_t rate = (uint32_t)((uint64_t)w * h * 1000 / elapsed_us);
+                te_px_per_ms = te_px_per_ms ? (te_px_per_ms * 3 + rate) / 4 : rate;
+            }
+#endif
+
+            // Bus idle: gap since the frame's previous transfer ended
+            if (bus_last_end_us != 0)
+            {
+                bus_idle_us += (uint32_t)(start_us - bus_last_end_us);
+            }
+            if (last)
+            {
+                perf_stats.lastSpiIdleUs = bus_idle_us;
+                perf_stats.totalSpiIdleUs += bus_idle_us;
+                if (bus_idle_us > perf_stats.maxSpiIdleUs)
+                {
+                    perf_stats.maxSpiIdleUs = bus_idle_us;
+                }
+                bus_last_end_us = 0;
+                bus_idle_us = 0;
+            }
+            else
+            {
+                bus_last_end_us = end_us;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Mark the start of a refresh cycle
+ */
+static void EARS_HOT lvgl_frame_start_cb(lv_event_t *e)
+{
+    (void)e;
+    frame_start_us = esp_timer_get_time();
+    frame_started = true;
+}
+
+/**
+ * @brief Close a refresh cycle and update frame statistics
+ * @details Cycles with nothing to draw are not counted as frames
+ */
+static void EARS_HOT lvgl_frame_ready_cb(lv_event_t *e)
+{
+    (void)e;
+    if (!frame_started)
+    {
+        return;
+    }
+    frame_started = false;
+
+    static uint32_t last_flush_calls = 0;
+    if (perf_stats.flushCalls == last_flush_calls)
+    {
+        return;
+    }
+    last_flush_calls = perf_stats.flushCalls;
+
+    // Layer slices since the last frame (each slice allocates one buffer)
+    static uint32_t last_layer_slices = 0;
+    MAIN_lvgl_mem_layer_stats_t layers;
+    MAIN_lvgl_mem_get_layer_stats(&layers);
+    uint32_t slices = layers.slices - last_layer_slices;
+    last_layer_slices = layers.slices;
+    if (slices > 0)
+    {
+        perf_stats.layerSlices += slices;
+        perf_stats.layerFrames++;
+        if (slices > perf_stats.maxLayerSlices)
+        {
+            perf_stats.maxLayerSlices = slices;
+        }
+    }
+
+    uint32_t elapsed_us = (uint32_t)(esp_timer_get_time() - frame_start_us);
+    perf_stats.frames++;
+    perf_stats.lastFrameUs = elapsed_us;
+    perf_stats.totalFrameUs += elapsed_us;
+    if (elapsed_us > perf_stats.maxFrameUs)
+    {
+        perf_stats.maxFrameUs = elapsed_us;
+    }
+
+    uint32_t elapsed_ms = elapsed_us / 1000;
+    uint8_t bucket = LVGL_STATS_HIST_BUCKETS - 1;
+    for (uint8_t i = 0; i < LVGL_STATS_HIST_BUCKETS - 1; i++)
+    {
+        if (elapsed_ms < frame_hist_limits_ms[i])
+        {
+            bucket = i;
+            break;
+        }
+    }
+    perf_stats.frameHistogram[bucket]++;
+}
+
+/**
+ * @brief Merge nearby invalidated areas before LVGL renders them
+ * @details Runs on LV_EVENT_REFR_START, ahead of LVGL's own join pass which
+ *          only merges overlapping areas. Two areas are merged when their
+ *          bounding box costs no more than LVGL_COALESCE_SLACK_PX extra
+ *          pixels, trading a little re-rendering for one less address
+ *          window, mutex take and bitmap transaction.
+ */
+static void lvgl_coalesce_areas_cb(lv_event_t *e)
+{
+    lv_display_t *disp = (lv_display_t *)lv_event_get_target(e);
+    if (disp == NULL || disp->inv_p == 0)
+    {
+        return;
+    }
+
+    coalesce_stats.refreshCycles++;
+    coalesce_stats.areasInvalidated += disp->inv_p;
+
+    // Keep merging until a full pass finds nothing more to join
+    bool merged = true;
+    while (merged)
+    {
+        merged = false;
+        for (uint32_t i = 0; i < disp->inv_p; i++)
+        {
+            if (disp->inv_area_joined[i])
+            {
+                continue;
+            }
+
+            for (uint32_t j = i + 1; j < disp->inv_p; j++)
+            {
+                if (disp->inv_area_joined[j])
+                {
+                    continue;
+                }
+
+                lv_area_t joined;
+                lv_area_join(&joined, &disp->inv_areas[i], &disp->inv_areas[j]);
+
+                uint32_t separate = lv_area_get_size(&disp->inv_areas[i]) + lv_area_get_size(&disp->inv_areas[j]);
+                uint32_t combined = lv_area_get_size(&joined);
+
+                if (combined <= separate + LVGL_COALESCE_SLACK_PX)
+                {
+                    if (combined > separate)
+                    {
+                        coalesce_stats.extraPixels += combined - separate;
+                    }
+                    lv_area_copy(&disp->inv_areas[i], &joined);
+                    disp->inv_area_joined[j] = 1;
+                    coalesce_stats.areasMerged++;
+                    merged = true;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Allocate one draw buffer according to the placement policy
+ * @param bytes Buffer size in bytes
+ * @param policy Placement policy
+ * @param inPsram Set to true if the buffer landed in PSRAM
+ * @return void* Buffer pointer (NULL on failure)
+ */
+static void *lvgl_alloc_draw_buf(uint32_t bytes, MAIN_lvgl_buf_policy_t policy, bool *inPsram)
+{
+    void *buf = NULL;
+    *inPsram = false;
+
+    if (policy != MAIN_LVGL_BUF_PSRAM)
+    {
+        buf = MAIN_mem_alloc(MEM_POOL_FRAME_BUFFERS, bytes, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    }
+
+    if (buf == NULL && policy != MAIN_LVGL_BUF_INTERNAL_DMA && MAIN_sysinfo_has_psram())
+    {
+        buf = MAIN_mem_alloc(MEM_POOL_FRAME_BUFFERS, bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        *inPsram = (buf != NULL);
+    }
+
+    return buf;
+}
+
+/**
+ * @brief Sleep until at most limit areas are still queued or on the bus
+ * @param limit Transfers allowed to remain in flight
+ */
+static void lvgl_wait_in_flight(uint32_t limit)
+{
+    while (flush_in_flight > limit)
+    {
+        xSemaphoreTake(flush_done_sem, pdMS_TO_TICKS(10));
+    }
+}
+
+/**
+ * @brief Hand LVGL the next pipelined strip
+ * @details Strips are flushed in order, so the strip after the one just
+ *          queued is the oldest in flight; once at most strip_count - 1
+ *          transfers remain it is free. It becomes LVGL's buf_2 and the
+ *          strip just queued its buf_1, which LVGL swaps away from on return.
+ * @param disp LVGL display
+ * @param px_map Strip just handed to the flush path
+ */
+static void EARS_HOT lvgl_rotate_strip(lv_display_t *disp, uint8_t *px_map)
+{
+    uint8_t current = 0;
+    while (current < strip_count - 1 && strip_bufs[current].data != px_map)
+    {
+        current++;
+    }
+    uint8_t next = (current + 1) % strip_count;
+
+    if (flush_queue != NULL)
+    {
+        lvgl_wait_in_flight(strip_count - 1);
+    }
+
+    disp->buf_1 = &strip_bufs[current];
+    disp->buf_2 = &strip_bufs[next];
+    disp->buf_act = disp->buf_1;
+}
+
+/**
+ * @brief Show an area to the flush taps, rows located as lvgl_push_area sends them
+ */
+static void lvgl_tap_area(const lv_area_t *area, const uint8_t *px_map, bool last)
+{
+    const uint8_t *start = px_map;
+    uint32_t stridePx = lv_area_get_width(area);
+    if (display_render_mode == LV_DISPLAY_RENDER_MODE_DIRECT)
+    {
+        start = px_map + (area->y1 * display_width + area->x1) * 2;
+        stridePx = display_width;
+    }
+
+    // Taps may remove themselves: snapshot the set first
+    MAIN_lvgl_flush_tap_t taps[LVGL_FLUSH_TAPS];
+    memcpy(taps, flush_taps, sizeof(taps));
+    for (uint8_t i = 0; i < LVGL_FLUSH_TAPS; i++)
+    {
+        if (taps[i] != NULL)
+        {
+            taps[i](area, start, stridePx, last);
         }
     }
+}
+
+/**
+ * @brief LVGL display flush callback
+ * @details Called by LVGL when a region needs to be drawn to the display.
+ *          In async mode the area is queued for the flush task and LVGL
+ *          continues rendering into the other draw buffer, or the next free
+ *          strip when pipelined.
+ */
+void EARS_HOT MAIN_lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    EARS_PROFILE_ZONE("lvgl flush");
 
+    perf_stats.flushCalls++;
+
+    if (flush_tap_count > 0)
+    {
+        lvgl_tap_area(area, px_map, lv_display_flush_is_last(disp));
+    }
+
+    if (flush_queue != NULL)
+    {
+        lvgl_flush_job_t job;
+        job.disp = disp;
+        job.area = *area;
+        job.px_map = px_map;
+        job.last = lv_display_flush_is_last(disp);
+        job.renderStartUs = (uint32_t)frame_start_us;
+
+        flush_in_flight++;
+        if (xQueueSend(flush_queue, &job, portMAX_DELAY) == pdTRUE)
+        {
+            if (strip_count > 0)
+            {
+                lvgl_rotate_strip(disp, px_map);
+            }
+            return;
+        }
+        flush_in_flight--;
+    }
+
+    lvgl_push_area(area, px_map, lv_display_flush_is_last(disp));
     lv_display_flush_ready(disp);
+    if (strip_count > 0)
+    {
+        lvgl_rotate_strip(disp, px_map);
+    }
+
+    if (lv_display_flush_is_last(disp))
+    {
+        int64_t now = esp_timer_get_time();
+        if (first_frame_us == 0)
+        {
+            first_frame_us = now;
+        }
+        MAIN_sysinfo_latency_frame((uint32_t)frame_start_us, (uint32_t)now);
+    }
+}
+
+/**
+ * @brief LVGL flush wait callback
+ * @details Sleeps on the completion semaphore until every queued area has
+ *          been transferred, so Core 0 yields instead of busy-waiting.
+ *          Pipelined strips do not drain here: the flush callback already
+ *          waited for the strip LVGL renders next.
+ */
+void MAIN_lvgl_flush_wait_cb(lv_display_t *disp)
+{
+    (void)disp;
+
+    if (strip_count > 0)
+    {
+        return;
+    }
+    lvgl_wait_in_flight(0);
+}
+
+/**
+ * @brief Flush task (runs on LVGL_FLUSH_TASK_CORE)
+ * @details Performs the SPI transfer for each queued area and releases the
+ *          draw buffer back to LVGL once the transfer has completed
+ */
+void EARS_HOT MAIN_lvgl_flush_task(void *parameter)
+{
+    (void)parameter;
+    lvgl_flush_job_t job;
+
+    while (1)
+    {
+        if (xQueueReceive(flush_queue, &job, portMAX_DELAY) == pdTRUE)
+        {
+            lvgl_push_area(&job.area, job.px_map, job.last);
+            lv_display_flush_ready(job.disp);
+
+            flush_in_flight--;
+            xSemaphoreGive(flush_done_sem);
+
+            if (job.last)
+            {
+                int64_t now = esp_timer_get_time();
+                if (first_frame_us == 0)
+                {
+                    first_frame_us = now;
+                }
+                MAIN_sysinfo_latency_frame(job.renderStartUs, (uint32_t)now);
+            }
+
+            if (job.last && wake_task_handle != NULL)
+            {
+                xTaskNotifyGive(wake_task_handle);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Start the asynchronous flush task
+ * @return true if the flush task is running
+ */
+static bool lvgl_start_flush_task(void)
+{
+    if (flush_task_handle != NULL)
+    {
+        return true; // Static memory: one flush task per boot
+    }
+
+    // Every strip but the one being rendered can be waiting for the bus
+    UBaseType_t depth = (strip_count > LVGL_FLUSH_QUEUE_DEPTH) ? strip_count : LVGL_FLUSH_QUEUE_DEPTH;
+    if (depth > LVGL_FLUSH_QUEUE_MAX_DEPTH)
+    {
+        depth = LVGL_FLUSH_QUEUE_MAX_DEPTH;
+    }
+    flush_queue = xQueueCreateStatic(depth, sizeof(lvgl_flush_job_t), flush_queue_storage, &flush_queue_buffer);
+    flush_done_sem = xSemaphoreCreateBinaryStatic(&flush_done_sem_buffer);
+
+    flush_task_handle = MAIN_STATIC_TASK_CREATE(flush_task, MAIN_lvgl_flush_task, "LVGL_Flush", NULL,
+                                                LVGL_FLUSH_TASK_PRIORITY, LVGL_FLUSH_TASK_CORE);
+    if (flush_task_handle == NULL)
+    {
+        // Nothing would drain the queue: flush blocking
+        flush_queue = NULL;
+        flush_done_sem = NULL;
+        return false;
+    }
+
+    return true;
 }
 
 /**
@@ -75,6 +727,38 @@ uint32_t MAIN_lvgl_tick_cb(void)
     return millis();
 }
 
+#if LV_USE_OS == LV_OS_FREERTOS
+/******************************************************************************
+ * Draw Thread Placement
+ *****************************************************************************/
+
+extern "C" BaseType_t __real_xTaskCreatePinnedToCore(TaskFunction_t code, const char *const name,
+                                                     const uint32_t stackDepth, void *const parameter,
+                                                     UBaseType_t priority, TaskHandle_t *const handle,
+                                                     const BaseType_t coreId);
+
+/**
+ * @brief Task creation with LVGL's draw threads given a core
+ * @details LVGL's FreeRTOS OSAL creates its draw threads with xTaskCreate,
+ *          which leaves them free to run on either core. The linker routes
+ *          every task creation here (-Wl,--wrap=xTaskCreatePinnedToCore);
+ *          draw threads alternate between LVGL_DRAW_THREAD0_CORE and
+ *          LVGL_DRAW_THREAD1_CORE, anything else passes straight through.
+ */
+extern "C" BaseType_t __wrap_xTaskCreatePinnedToCore(TaskFunction_t code, const char *const name,
+                                                     const uint32_t stackDepth, void *const parameter,
+                                                     UBaseType_t priority, TaskHandle_t *const handle,
+                                                     const BaseType_t coreId)
+{
+    BaseType_t core = coreId;
+    if (core == tskNO_AFFINITY && name != NULL && strcmp(name, LVGL_DRAW_THREAD_NAME) == 0)
+    {
+        core = (draw_threads_pinned++ & 1) ? LVGL_DRAW_THREAD1_CORE : LVGL_DRAW_THREAD0_CORE;
+    }
+    return __real_xTaskCreatePinnedToCore(code, name, stackDepth, parameter, priority, handle, core);
+}
+#endif
+
 /******************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -84,19 +768,321 @@ uint32_t MAIN_lvgl_tick_cb(void)
  */
 void MAIN_clear_lvgl_buffers(void)
 {
-    uint32_t bufSize = display_width * LVGL_BUFFER_LINES * 2; // *2 for RGB565
+    for (uint8_t i = 0; i < draw_buf_count; i++)
+    {
+        if (disp_draw_bufs[i] != NULL)
+        {
+            memset(disp_draw_bufs[i], 0x00, draw_buf_bytes);
+        }
+    }
 
-    if (disp_draw_buf1 != NULL)
+    DEBUG_PRINTLN("[OK] LVGL buffers cleared");
+}
+
+/**
+ * @brief Set the task notified when the last area of a frame is flushed
+ */
+void MAIN_lvgl_set_wake_task(TaskHandle_t task)
+{
+    wake_task_handle = task;
+}
+
+/**
+ * @brief Report a press or release dispatch to the latency probe
+ * @param e LVGL event on the input device
+ */
+static void lvgl_latency_input_cb(lv_event_t *e)
+{
+    (void)e;
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    MAIN_sysinfo_latency_input((latency_input_time != NULL) ? latency_input_time() : now, now);
+}
+
+/**
+ * @brief Time an input device's presses and releases to the panel
+ */
+bool MAIN_lvgl_latency_attach(lv_indev_t *indev, MAIN_lvgl_input_time_fn_t inputTime)
+{
+    if (indev == NULL)
     {
-        memset(disp_draw_buf1, 0x00, bufSize);
+        return false;
     }
 
-    if (disp_draw_buf2 != NULL)
+    latency_input_time = inputTime;
+    lv_indev_add_event_cb(indev, lvgl_latency_input_cb, LV_EVENT_PRESSED, NULL);
+    lv_indev_add_event_cb(indev, lvgl_latency_input_cb, LV_EVENT_RELEASED, NULL);
+    return true;
+}
+
+/**
+ * @brief Time the first complete frame reached the panel
+ */
+int64_t MAIN_lvgl_get_first_frame_us(void)
+{
+    return first_frame_us;
+}
+
+/**
+ * @brief Get the size of one draw buffer
+ */
+uint32_t MAIN_lvgl_get_buffer_size(void)
+{
+    return draw_buf_bytes;
+}
+
+/**
+ * @brief Get the number of draw buffers
+ */
+uint8_t MAIN_lvgl_get_buffer_count(void)
+{
+    return draw_buf_count;
+}
+
+/**
+ * @brief Check whether the draw buffers were allocated in PSRAM
+ */
+bool MAIN_lvgl_buffers_in_psram(void)
+{
+    return draw_buf_in_psram;
+}
+
+/**
+ * @brief Get the render mode the display was created with
+ */
+lv_display_render_mode_t MAIN_lvgl_get_render_mode(void)
+{
+    return display_render_mode;
+}
+
+/**
+ * @brief Run lv_timer_handler and record how long it took
+ */
+uint32_t MAIN_lvgl_timer_handler(void)
+{
+    int64_t start_us = esp_timer_get_time();
+    uint32_t next_ms = lv_timer_handler();
+    uint32_t elapsed_us = (uint32_t)(esp_timer_get_time() - start_us);
+
+    perf_stats.handlerCalls++;
+    perf_stats.lastHandlerUs = elapsed_us;
+    if (elapsed_us > perf_stats.maxHandlerUs)
     {
-        memset(disp_draw_buf2, 0x00, bufSize);
+        perf_stats.maxHandlerUs = elapsed_us;
     }
 
-    DEBUG_PRINTLN("[OK] LVGL buffers cleared");
+    return next_ms;
+}
+
+/**
+ * @brief Get rendering and flush performance counters
+ */
+void MAIN_lvgl_get_stats(MAIN_lvgl_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = perf_stats;
+#if LVGL_TE_ACTIVE == 1
+        stats->tePeriodUs = lvgl_te_running() ? te_period_us : 0;
+#endif
+    }
+}
+
+/**
+ * @brief Reset rendering and flush performance counters to zero
+ */
+void MAIN_lvgl_reset_stats(void)
+{
+    memset(&perf_stats, 0, sizeof(perf_stats));
+}
+
+/**
+ * @brief Format a one-line stats summary
+ */
+size_t MAIN_lvgl_format_stats(char *buffer, size_t bufferSize)
+{
+    if (buffer == NULL || bufferSize == 0)
+    {
+        return 0;
+    }
+
+    MAIN_lvgl_stats_t s;
+    MAIN_lvgl_get_stats(&s);
+
+    uint32_t avgFrameUs = s.frames ? (uint32_t)(s.totalFrameUs / s.frames) : 0;
+    uint32_t avgFlushUs = s.flushCalls ? (uint32_t)(s.totalFlushUs / s.flushCalls) : 0;
+    uint32_t avgSpiIdleUs = s.frames ? (uint32_t)(s.totalSpiIdleUs / s.frames) : 0;
+
+    int written = snprintf(buffer, bufferSize,
+                           "LVGL frames=%lu frame_us avg=%lu max=%lu flush=%lu flush_us avg=%lu max=%lu "
+                           "bytes=%llu spi_idle_us avg=%lu max=%lu handler_us max=%lu hist=%lu/%lu/%lu/%lu/%lu/%lu/%lu "
+                           "layer_slices=%lu layer_frames=%lu layer_max=%lu te_period_us=%lu te_waits=%lu "
+                           "te_wait_us=%llu te_misses=%lu",
+                           (unsigned long)s.frames, (unsigned long)avgFrameUs, (unsigned long)s.maxFrameUs,
+                           (unsigned long)s.flushCalls, (unsigned long)avgFlushUs, (unsigned long)s.maxFlushUs,
+                           (unsigned long long)s.bytesFlushed, (unsigned long)avgSpiIdleUs,
+                           (unsigned long)s.maxSpiIdleUs, (unsigned long)s.maxHandlerUs,
+                           (unsigned long)s.frameHistogram[0], (unsigned long)s.frameHistogram[1],
+                           (unsigned long)s.frameHistogram[2], (unsigned long)s.frameHistogram[3],
+                           (unsigned long)s.frameHistogram[4], (unsigned long)s.frameHistogram[5],
+                           (unsigned long)s.frameHistogram[6], (unsigned long)s.layerSlices,
+                           (unsigned long)s.layerFrames, (unsigned long)s.maxLayerSlices,
+                           (unsigned long)s.tePeriodUs, (unsigned long)s.teWaits,
+                           (unsigned long long)s.totalTeWaitUs, (unsigned long)s.teMisses);
+
+    if (written < 0)
+    {
+        buffer[0] = '\0';
+        return 0;
+    }
+
+    return ((size_t)written < bufferSize) ? (size_t)written : bufferSize - 1;
+}
+
+/**
+ * @brief Print rendering and flush statistics to Serial (debug builds only)
+ */
+void MAIN_lvgl_print_stats(void)
+{
+#if EARS_DEBUG == 1
+    MAIN_lvgl_stats_t s;
+    MAIN_lvgl_get_stats(&s);
+
+    uint32_t avgFrameUs = s.frames ? (uint32_t)(s.totalFrameUs / s.frames) : 0;
+    uint32_t avgFlushUs = s.flushCalls ? (uint32_t)(s.totalFlushUs / s.flushCalls) : 0;
+    uint32_t avgSpiIdleUs = s.frames ? (uint32_t)(s.totalSpiIdleUs / s.frames) : 0;
+
+    DEBUG_PRINTLN("========================================");
+    DEBUG_PRINTLN("LVGL PERFORMANCE:");
+    DEBUG_PRINTLN("========================================");
+    DEBUG_PRINTF("Frames:        %lu\n", (unsigned long)s.frames);
+    DEBUG_PRINTF("Frame Avg:     %lu us\n", (unsigned long)avgFrameUs);
+    DEBUG_PRINTF("Frame Max:     %lu us\n", (unsigned long)s.maxFrameUs);
+    DEBUG_PRINTF("Flush Calls:   %lu\n", (unsigned long)s.flushCalls);
+    DEBUG_PRINTF("Flush Avg:     %lu us\n", (unsigned long)avgFlushUs);
+    DEBUG_PRINTF("Flush Max:     %lu us\n", (unsigned long)s.maxFlushUs);
+    DEBUG_PRINTF("SPI Bytes:     %s\n", MAIN_sysinfo_format_bytes((uint32_t)s.bytesFlushed).c_str());
+    DEBUG_PRINTF("SPI Idle Avg:  %lu us/frame\n", (unsigned long)avgSpiIdleUs);
+    DEBUG_PRINTF("SPI Idle Max:  %lu us/frame\n", (unsigned long)s.maxSpiIdleUs);
+    DEBUG_PRINTF("Handler Max:   %lu us\n", (unsigned long)s.maxHandlerUs);
+    DEBUG_PRINTF("Histogram:     <2:%lu <4:%lu <8:%lu <16:%lu <33:%lu <66:%lu >=66:%lu\n",
+                 (unsigned long)s.frameHistogram[0], (unsigned long)s.frameHistogram[1],
+                 (unsigned long)s.frameHistogram[2], (unsigned long)s.frameHistogram[3],
+                 (unsigned long)s.frameHistogram[4], (unsigned long)s.frameHistogram[5],
+                 (unsigned long)s.frameHistogram[6]);
+    DEBUG_PRINTF("Layer Slices:  %lu in %lu frames, max %lu/frame\n", (unsigned long)s.layerSlices,
+                 (unsigned long)s.layerFrames, (unsigned long)s.maxLayerSlices);
+    DEBUG_PRINTF("TE Pacing:     period %lu us, %lu held (%llu us), %lu missed\n", (unsigned long)s.tePeriodUs,
+                 (unsigned long)s.teWaits, (unsigned long long)s.totalTeWaitUs, (unsigned long)s.teMisses);
+    DEBUG_PRINTLN();
+#endif
+}
+
+/**
+ * @brief Write a stats summary line to the SD logger
+ */
+bool MAIN_lvgl_log_stats(void)
+{
+    EARS_logger &logger = EARS_logger::getInstance();
+    if (!logger.wouldLog(LogLevel::INFO))
+    {
+        return false;
+    }
+
+    char line[256];
+    MAIN_lvgl_format_stats(line, sizeof(line));
+    logger.info(line);
+    return true;
+}
+
+/**
+ * @brief Get dirty-area coalescing counters
+ */
+void MAIN_lvgl_get_coalesce_stats(MAIN_lvgl_coalesce_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = coalesce_stats;
+    }
+}
+
+/**
+ * @brief Reset dirty-area coalescing counters to zero
+ */
+void MAIN_lvgl_reset_coalesce_stats(void)
+{
+    memset(&coalesce_stats, 0, sizeof(coalesce_stats));
+}
+
+/**
+ * @brief Install a flush tap in the first free slot
+ */
+bool MAIN_lvgl_add_flush_tap(MAIN_lvgl_flush_tap_t tap)
+{
+    for (uint8_t i = 0; i < LVGL_FLUSH_TAPS; i++)
+    {
+        if (flush_taps[i] == NULL)
+        {
+            flush_taps[i] = tap;
+            flush_tap_count++;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Remove a flush tap
+ */
+void MAIN_lvgl_remove_flush_tap(MAIN_lvgl_flush_tap_t tap)
+{
+    for (uint8_t i = 0; i < LVGL_FLUSH_TAPS; i++)
+    {
+        if (flush_taps[i] == tap)
+        {
+            flush_taps[i] = NULL;
+            flush_tap_count--;
+        }
+    }
+}
+
+/**
+ * @brief Check whether flushes are paced by the panel's TE pulses
+ */
+bool MAIN_lvgl_is_te_synced(void)
+{
+#if LVGL_TE_ACTIVE == 1
+    return lvgl_te_running();
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Round a display refresh period to whole panel refreshes
+ */
+uint32_t MAIN_lvgl_align_refresh_period(uint32_t periodMs)
+{
+#if LVGL_TE_ACTIVE == 1
+    if (lvgl_te_running())
+    {
+        uint32_t period = te_period_us;
+        uint32_t refreshes = (periodMs * 1000 + period / 2) / period;
+        if (refreshes == 0)
+        {
+            refreshes = 1;
+        }
+        return (refreshes * period + 500) / 1000;
+    }
+#endif
+    return periodMs;
+}
+
+/**
+ * @brief Check whether the asynchronous flush path is active
+ */
+bool MAIN_lvgl_is_async_flush(void)
+{
+    return flush_queue != NULL;
 }
 
 /**
@@ -108,10 +1094,41 @@ lv_display_t *MAIN_get_lvgl_display(void)
 }
 
 /**
- * @brief Initialize LVGL 9.3.0 display system
+ * @brief Fill a config with the defaults for this board
+ */
+void MAIN_lvgl_get_default_config(MAIN_lvgl_config_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    config->buf_policy = MAIN_sysinfo_has_psram() ? MAIN_LVGL_BUF_AUTO : MAIN_LVGL_BUF_INTERNAL_DMA;
+    config->buffer_lines = LVGL_BUFFER_LINES;
+    config->render_mode = LV_DISPLAY_RENDER_MODE_PARTIAL;
+    config->double_buffer = true;
+    config->strips = 0;
+#if LVGL_PIPELINE_STRIPS > 2
+    config->buffer_lines = LVGL_PIPELINE_STRIP_LINES;
+    config->strips = LVGL_PIPELINE_STRIPS;
+#endif
+}
+
+/**
+ * @brief Initialize LVGL 9.3.0 display system with default options
  */
 bool MAIN_initialise_lvgl(Arduino_GFX *gfx, SemaphoreHandle_t displayMutex,
                           uint32_t screenWidth, uint32_t screenHeight)
+{
+    return MAIN_initialise_lvgl_with_config(gfx, displayMutex, screenWidth, screenHeight, NULL);
+}
+
+/**
+ * @brief Initialize LVGL 9.3.0 display system with explicit options
+ */
+bool MAIN_initialise_lvgl_with_config(Arduino_GFX *gfx, SemaphoreHandle_t displayMutex,
+                                      uint32_t screenWidth, uint32_t screenHeight,
+                                      const MAIN_lvgl_config_t *config)
 {
     // Validate parameters
     if (gfx == NULL || displayMutex == NULL)
@@ -120,11 +1137,22 @@ bool MAIN_initialise_lvgl(Arduino_GFX *gfx, SemaphoreHandle_t displayMutex,
         return false;
     }
 
+    MAIN_lvgl_config_t cfg;
+    if (config != NULL)
+    {
+        cfg = *config;
+    }
+    else
+    {
+        MAIN_lvgl_get_default_config(&cfg);
+    }
+
     // Store parameters for callbacks
     display_gfx = gfx;
     display_mutex = displayMutex;
     display_width = screenWidth;
     display_height = screenHeight;
+    display_render_mode = cfg.render_mode;
 
 #if EARS_DEBUG == 1
     Serial.println("[INIT] Initialising LVGL 9.3.0...");
@@ -142,46 +1170,94 @@ bool MAIN_initialise_lvgl(Arduino_GFX *gfx, SemaphoreHandle_t displayMutex,
     // Initialize LVGL core
     lv_init();
 
-    // Calculate buffer size (LVGL_BUFFER_LINES lines)
-    uint32_t bufSize = screenWidth * LVGL_BUFFER_LINES;
+    // Layer buffers from PSRAM, before anything is drawn
+    MAIN_lvgl_mem_attach_layers();
 
+#if LV_USE_OS == LV_OS_FREERTOS
+    // Draw threads still unpinned means the --wrap link flag is missing
+    if (draw_threads_pinned < LV_DRAW_SW_DRAW_UNIT_CNT)
+    {
+        DEBUG_PRINTLN("[WARN] LVGL draw threads not pinned - link with -Wl,--wrap=xTaskCreatePinnedToCore");
+    }
 #if EARS_DEBUG == 1
+    Serial.printf("[OK] LVGL draw units: %d (Core %d + Core %d)\n", LV_DRAW_SW_DRAW_UNIT_CNT,
+                  LVGL_DRAW_THREAD0_CORE, LVGL_DRAW_THREAD1_CORE);
+#endif
+#endif
+
+    // Calculate buffer size (whole screen for DIRECT/FULL, line count for PARTIAL)
+    uint32_t bufLines = cfg.buffer_lines;
+    if (cfg.render_mode != LV_DISPLAY_RENDER_MODE_PARTIAL || bufLines == 0 || bufLines > screenHeight)
+    {
+        bufLines = screenHeight;
+    }
+    uint32_t bufSize = screenWidth * bufLines;
+    draw_buf_bytes = bufSize * 2; // *2 for RGB565
+
+    // Buffer count: pipelined strips (PARTIAL only), else one or two
+    strip_count = 0;
+    draw_buf_count = cfg.double_buffer ? 2 : 1;
+    if (cfg.render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL && cfg.strips > 2)
+    {
+        strip_count = (cfg.strips > LVGL_PIPELINE_MAX_STRIPS) ? LVGL_PIPELINE_MAX_STRIPS : cfg.strips;
+        draw_buf_count = strip_count;
+    }
+
+#if EARS_DEBUG == 1
+    Serial.print("[INFO] Render mode: ");
+    Serial.println(cfg.render_mode == LV_DISPLAY_RENDER_MODE_FULL     ? "FULL"
+                   : cfg.render_mode == LV_DISPLAY_RENDER_MODE_DIRECT ? "DIRECT"
+                                                                      : "PARTIAL");
     Serial.print("[INFO] Buffer size: ");
     Serial.print(bufSize);
     Serial.println(" pixels");
     Serial.print("[INFO] Bytes per buffer: ");
-    Serial.print(bufSize * 2);
+    Serial.print(draw_buf_bytes);
     Serial.println(" bytes");
     Serial.print("[INFO] Total allocation: ");
-    Serial.print(bufSize * 2 * 2);
+    Serial.print(draw_buf_bytes * draw_buf_count);
     Serial.println(" bytes");
-#endif
-
-    // Allocate display buffers (bufSize * 2 for RGB565)
-    disp_draw_buf1 = (lv_color_t *)malloc(bufSize * 2);
-    disp_draw_buf2 = (lv_color_t *)malloc(bufSize * 2);
-
-#if EARS_DEBUG == 1
-    if (disp_draw_buf1)
+    if (strip_count > 0)
     {
-        Serial.println("[OK] Buffer 1 allocated");
+        Serial.printf("[INFO] Pipelined: %u strips of %lu lines\n", strip_count, (unsigned long)bufLines);
     }
-    if (disp_draw_buf2)
+#endif
+
+    // Allocate display buffers according to the placement policy
+    bool allocated = true;
+    draw_buf_in_psram = false;
+    for (uint8_t i = 0; i < draw_buf_count; i++)
     {
-        Serial.println("[OK] Buffer 2 allocated");
-    }
+        bool inPsram = false;
+        disp_draw_bufs[i] = (lv_color_t *)lvgl_alloc_draw_buf(draw_buf_bytes, cfg.buf_policy, &inPsram);
+        if (disp_draw_bufs[i] == NULL)
+        {
+            allocated = false;
+#if EARS_DEBUG == 1
+            Serial.printf("  buf%u is NULL\n", i + 1);
 #endif
+            continue;
+        }
+        draw_buf_in_psram = draw_buf_in_psram || inPsram;
+#if EARS_DEBUG == 1
+        Serial.printf("[OK] Buffer %u allocated (%s)\n", i + 1, inPsram ? "PSRAM" : "internal DMA");
+#endif
+    }
 
-    if (!disp_draw_buf1 || !disp_draw_buf2)
+    if (!allocated)
     {
 #if EARS_DEBUG == 1
         Serial.println("[ERROR] Buffer allocation failed!");
-        if (!disp_draw_buf1)
-            Serial.println("  buf1 is NULL");
-        if (!disp_draw_buf2)
-            Serial.println("  buf2 is NULL");
         MAIN_led_red_on();
 #endif
+        for (uint8_t i = 0; i < draw_buf_count; i++)
+        {
+            MAIN_mem_free(disp_draw_bufs[i]);
+            disp_draw_bufs[i] = NULL;
+        }
+        draw_buf_count = 0;
+        strip_count = 0;
+        draw_buf_bytes = 0;
         return false;
     }
 
@@ -203,17 +1279,80 @@ bool MAIN_initialise_lvgl(Arduino_GFX *gfx, SemaphoreHandle_t displayMutex,
         return false;
     }
 
+#if LVGL_NATIVE_BYTE_ORDER == 1
+    // Render in the panel's byte order; must precede the buffers (stride)
+    lv_display_set_color_format(lvgl_disp, LV_COLOR_FORMAT_RGB565_SWAPPED);
+#endif
+
 #if EARS_DEBUG == 1
     Serial.println("[OK] LVGL display created");
+#if EARS_DRAW_SW_ASM == 1 && LVGL_NATIVE_BYTE_ORDER == 1
+    Serial.println("[WARN] Draw SW kernels: LVGL C (MAIN_drawSwAsm is RGB565 only)");
+#elif EARS_DRAW_SW_ASM == 1
+    Serial.printf("[OK] Draw SW kernels: MAIN_drawSwAsm (%s)\n", MAIN_draw_sw_asm_backend());
+#else
+    Serial.println("[OK] Draw SW kernels: LVGL C");
+#endif
+    Serial.printf("[OK] LVGL heap: %s\n", MAIN_lvgl_mem_backend());
 #endif
 
-    // Set display buffers (size in BYTES = bufSize * 2)
-    lv_display_set_buffers(lvgl_disp, disp_draw_buf1, disp_draw_buf2,
-                           bufSize * 2, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    // Set display buffers (size in BYTES)
+    if (strip_count > 0)
+    {
+        // LVGL starts on strips 1 and 2; MAIN_lvgl_flush_cb rotates in the rest
+        lv_color_format_t cf = lv_display_get_color_format(lvgl_disp);
+        uint32_t stride = lv_draw_buf_width_to_stride(screenWidth, cf);
+        for (uint8_t i = 0; i < strip_count; i++)
+        {
+            lv_draw_buf_init(&strip_bufs[i], screenWidth, bufLines, cf, stride,
+                             disp_draw_bufs[i], draw_buf_bytes);
+        }
+        lv_display_set_draw_buffers(lvgl_disp, &strip_bufs[0], &strip_bufs[1]);
+        lv_display_set_render_mode(lvgl_disp, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    }
+    else
+    {
+        lv_display_set_buffers(lvgl_disp, disp_draw_bufs[0], (draw_buf_count > 1) ? disp_draw_bufs[1] : NULL,
+                               draw_buf_bytes, cfg.render_mode);
+    }
 
     // Set flush callback
     lv_display_set_flush_cb(lvgl_disp, MAIN_lvgl_flush_cb);
 
+    // Frame timing for MAIN_lvgl_get_stats
+    MAIN_lvgl_reset_stats();
+    lv_display_add_event_cb(lvgl_disp, lvgl_frame_start_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(lvgl_disp, lvgl_frame_ready_cb, LV_EVENT_REFR_READY, NULL);
+
+#if LVGL_COALESCE_AREAS == 1
+    // Merge nearby dirty areas before each refresh
+    lv_display_add_event_cb(lvgl_disp, lvgl_coalesce_areas_cb, LV_EVENT_REFR_START, NULL);
+#endif
+
+#if LVGL_FLUSH_ASYNC == 1
+    // Hand SPI transfers to the flush task (falls back to blocking flush)
+    if (lvgl_start_flush_task())
+    {
+        lv_display_set_flush_wait_cb(lvgl_disp, MAIN_lvgl_flush_wait_cb);
+        DEBUG_PRINTLN("[OK] LVGL async flush task started");
+    }
+    else
+    {
+        DEBUG_PRINTLN("[WARN] LVGL async flush unavailable - using blocking flush");
+    }
+#endif
+
+#if LVGL_TE_ACTIVE == 1
+    // Pace flushes on the panel's TE pulses (unpaced until they arrive)
+    te_sem = xSemaphoreCreateBinaryStatic(&te_sem_buffer);
+    if (te_sem != NULL)
+    {
+        pinMode(LCD_TE, INPUT);
+        attachInterrupt(digitalPinToInterrupt(LCD_TE), lvgl_te_isr, RISING);
+        DEBUG_PRINTF("[OK] LVGL TE pacing on GPIO%d\n", LCD_TE);
+    }
+#endif
+
     // Set tick callback
     lv_tick_set_cb(MAIN_lvgl_tick_cb);
 
@@ -2,9 +2,37 @@
  * @file MAIN_lvglLib.h
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief LVGL 9.3.0 initialization and management for EARS (extracted from main.cpp)
- * @details Handles LVGL display setup, buffers, and callbacks
- * @version 1.0.0
- * @date 20260210
+ * @details Handles LVGL display setup, buffers, and callbacks.
+ *          Optional asynchronous flush path hands SPI transfers to a
+ *          dedicated flush task so LVGL can render into the second draw
+ *          buffer while the previous one is still on the bus.
+ *          Draw buffer placement (internal DMA SRAM or PSRAM), line count
+ *          and render mode are selectable at init via MAIN_lvgl_config_t.
+ *          Pipelined render (PARTIAL mode, more than two strips) rotates
+ *          smaller strip buffers through render, transfer and free, so the
+ *          flush task has the next strip queued before the bus goes idle.
+ *          With LVGL_NATIVE_BYTE_ORDER LVGL renders RGB565_SWAPPED, the
+ *          ST7796's big-endian byte order, and the flush hands buffers to
+ *          draw16bitBeRGBBitmap with no per-pixel pass before the transfer.
+ *          Invalidated areas of each refresh cycle are coalesced before
+ *          rendering so nearby widgets share one SPI window and transfer.
+ *          Frame render time, flush time, SPI byte counts and a frame-time
+ *          histogram are collected for MAIN_lvgl_get_stats().
+ *          An attached input device feeds the sysinfo touch-to-photon probe:
+ *          press and release dispatches are timed against the end of the
+ *          flush of the next frame rendered after them.
+ *          The flush callback and task run from IRAM (EARS_HOT), so a
+ *          cache refill after a flash write does not stretch a frame.
+ *          With the panel's TE output routed (LCD_TE), an area the scan
+ *          line would cross during its transfer is held for the next
+ *          V-blank pulse, and refresh periods can be rounded to whole
+ *          panel refreshes. Without pulses flushes go out unpaced.
+ *          Flush taps (MAIN_lvgl_add_flush_tap, up to LVGL_FLUSH_TAPS) see
+ *          every area on the UI task before it is queued, for captures and
+ *          mirrors that stream the frame out strip by strip instead of
+ *          copying it whole.
+ * @version 1.17.1
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -18,9 +46,11 @@
  *****************************************************************************/
 #include <Arduino.h>
 #include "EARS_versionDef.h"
+#include "EARS_taskPlanLib.h"
 #include <Arduino_GFX_Library.h>
 #include <lvgl.h>
 #include <freertos/semphr.h>
+#include <freertos/queue.h>
 #include "EARS_ws35tlcdPins.h"
 
 /******************************************************************************
@@ -30,9 +60,9 @@ namespace MAIN_LVGL
 {
     constexpr const char* LIB_NAME = "MAIN_LVGL";
     constexpr const char* VERSION_MAJOR = "1";
-    constexpr const char* VERSION_MINOR = "0";
-    constexpr const char* VERSION_PATCH = "0";
-    constexpr const char* VERSION_DATE = "2026-02-10";
+    constexpr const char* VERSION_MINOR = "17";
+    constexpr const char* VERSION_PATCH = "1";
+    constexpr const char* VERSION_DATE = "2026-10-15";
 }
 
 
@@ -49,12 +79,175 @@ void MAIN_LVGL_getVersionString(char* buffer);
 // Buffer configuration
 #define LVGL_BUFFER_LINES 60 // Number of lines per buffer (60 lines = ~57KB per buffer)
 
+// Flush configuration
+#define LVGL_FLUSH_ASYNC 1              // 1 = SPI transfer runs in flush task, 0 = blocking flush
+#define LVGL_FLUSH_TASK_STACK_SIZE 4096 // Stack size (bytes, static: MAIN_rtosStaticLib)
+#define LVGL_FLUSH_TASK_PRIORITY using_taskplan().priority(TASK_ROLE_FLUSH) // Above the background task
+#define LVGL_FLUSH_TASK_CORE using_taskplan().core(TASK_ROLE_FLUSH)
+#define LVGL_FLUSH_QUEUE_DEPTH 2        // One pending job per draw buffer (raised to the strip count)
+
+// Pipelined render (PARTIAL mode, async flush)
+#define LVGL_PIPELINE_STRIPS 4        // Default strips in rotation, 0 = two LVGL_BUFFER_LINES buffers
+#define LVGL_PIPELINE_STRIP_LINES 30  // Lines per strip (4 x 30 lines = the RAM of 2 x 60)
+#define LVGL_PIPELINE_MAX_STRIPS 6    // Upper bound on MAIN_lvgl_config_t.strips
+
+// Pixel byte order handed to the display driver
+#ifndef LVGL_NATIVE_BYTE_ORDER
+#define LVGL_NATIVE_BYTE_ORDER 1 // 1 = render RGB565_SWAPPED (panel order), 0 = RGB565, swapped at flush
+#endif
+
+// Flush taps installed at once (screenshot, mirror)
+#define LVGL_FLUSH_TAPS 2
+
+// Multi-threaded rendering (EARS_LVGL_OS=1, linked with --wrap=xTaskCreatePinnedToCore)
+#define LVGL_DRAW_THREAD_NAME "swdraw" // Name LVGL gives its software draw threads
+#define LVGL_DRAW_THREAD0_CORE using_taskplan().core(TASK_ROLE_DRAW0) // First draw unit, with the UI task
+#define LVGL_DRAW_THREAD1_CORE using_taskplan().core(TASK_ROLE_DRAW1) // Second draw unit, on the other core
+
+// Dirty-area coalescing
+#define LVGL_COALESCE_AREAS 1          // 1 = merge nearby invalidated areas per refresh
+#define LVGL_COALESCE_SLACK_PX 2048    // Extra pixels accepted to save one transfer
+
+// Tear-free flush pacing on the panel's TE output (LCD_TE >= 0)
+#ifndef LVGL_TE_SYNC
+#define LVGL_TE_SYNC 1                 // 1 = hold areas the scan line would cross until V-blank
+#endif
+#define LVGL_TE_SCAN_LINES 480         // Panel gate lines (native portrait height)
+#define LVGL_TE_SETTLE_EDGES 8         // Pulses timed before pacing starts
+
+// Performance statistics
+#define LVGL_STATS_HIST_BUCKETS 7 // Frame-time buckets: <2, <4, <8, <16, <33, <66, >=66 ms
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+/**
+ * @enum MAIN_lvgl_buf_policy_t
+ * @brief Draw buffer memory placement policy
+ */
+enum MAIN_lvgl_buf_policy_t
+{
+    MAIN_LVGL_BUF_AUTO = 0,     ///< Internal DMA SRAM, PSRAM if it does not fit
+    MAIN_LVGL_BUF_INTERNAL_DMA, ///< MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL only
+    MAIN_LVGL_BUF_PSRAM         ///< MALLOC_CAP_SPIRAM only
+};
+
+/**
+ * @struct MAIN_lvgl_config_t
+ * @brief LVGL display initialisation options
+ * @details buffer_lines is ignored for DIRECT and FULL render modes, which
+ *          always allocate whole-screen buffers. strips above 2 (PARTIAL
+ *          only) allocates that many buffers of buffer_lines each and
+ *          overrides double_buffer.
+ */
+struct MAIN_lvgl_config_t
+{
+    MAIN_lvgl_buf_policy_t buf_policy;    // Where the draw buffers are allocated
+    uint32_t buffer_lines;                // Lines per buffer in PARTIAL mode
+    lv_display_render_mode_t render_mode; // PARTIAL, DIRECT or FULL
+    bool double_buffer;                   // Allocate a second draw buffer
+    uint8_t strips;                       // PARTIAL buffers in rotation, >2 = pipelined
+};
+
+/**
+ * @struct MAIN_lvgl_coalesce_stats_t
+ * @brief Counters for the dirty-area coalescing stage
+ */
+struct MAIN_lvgl_coalesce_stats_t
+{
+    uint32_t refreshCycles;    // Refresh cycles that had invalidated areas
+    uint32_t areasInvalidated; // Areas handed in by LVGL
+    uint32_t areasMerged;      // Areas folded into a neighbour (transfers saved)
+    uint32_t extraPixels;      // Pixels re-rendered only because of merging
+};
+
+/**
+ * @struct MAIN_lvgl_stats_t
+ * @brief Rendering and flush performance counters
+ * @details Frame time runs from LV_EVENT_REFR_START to LV_EVENT_REFR_READY.
+ *          Flush time covers only the SPI transfer of each area, which in
+ *          async mode runs on the flush task in parallel with rendering.
+ *          SPI idle time is the gap between transfers of one frame, from
+ *          the end of its first transfer to the start of its last; near
+ *          zero means rendering keeps the bus saturated.
+ *          All times are microseconds from esp_timer_get_time().
+ */
+struct MAIN_lvgl_stats_t
+{
+    uint32_t frames;          // Refresh cycles that rendered something
+    uint32_t lastFrameUs;     // Duration of the most recent frame
+    uint32_t maxFrameUs;      // Longest frame since reset
+    uint64_t totalFrameUs;    // Sum of all frame durations
+    uint32_t flushCalls;      // MAIN_lvgl_flush_cb invocations
+    uint32_t lastFlushUs;     // Duration of the most recent area transfer
+    uint32_t maxFlushUs;      // Longest area transfer since reset
+    uint64_t totalFlushUs;    // Sum of all area transfer durations
+    uint64_t bytesFlushed;    // Pixel bytes pushed over SPI
+    uint32_t lastSpiIdleUs;   // Bus idle between transfers of the most recent frame
+    uint32_t maxSpiIdleUs;    // Most bus idle in one frame since reset
+    uint64_t totalSpiIdleUs;  // Sum of per-frame bus idle (average = total / frames)
+    uint32_t handlerCalls;    // MAIN_lvgl_timer_handler invocations
+    uint32_t lastHandlerUs;   // Duration of the most recent lv_timer_handler
+    uint32_t maxHandlerUs;    // Longest lv_timer_handler since reset
+    uint32_t frameHistogram[LVGL_STATS_HIST_BUCKETS]; // Frame-time distribution
+    uint32_t layerSlices;     // Layer slices rendered (opacity, transforms, blend modes)
+    uint32_t layerFrames;     // Frames that rendered at least one layer slice
+    uint32_t maxLayerSlices;  // Most layer slices in one frame since reset
+    uint32_t teWaits;         // Areas held for a V-blank pulse
+    uint32_t teMisses;        // Holds that timed out (pulses stopped)
+    uint64_t totalTeWaitUs;   // Time spent holding areas
+    uint32_t tePeriodUs;      // Panel refresh period from TE, 0 = unpaced
+};
+
+/**
+ * @brief Input time of the sample an input device last reported
+ * @return uint32_t esp_timer time (low 32 bits)
+ */
+typedef uint32_t (*MAIN_lvgl_input_time_fn_t)(void);
+
+/**
+ * @brief Flush tap: one area of a frame on its way to the panel
+ * @param area Area on the display
+ * @param pixels Its first pixel, in render byte order (RGB565_SWAPPED
+ *        with LVGL_NATIVE_BYTE_ORDER)
+ * @param stridePx Pixels from one row of the area to the next
+ * @param last Final area of the frame
+ */
+typedef void (*MAIN_lvgl_flush_tap_t)(const lv_area_t *area, const uint8_t *pixels, uint32_t stridePx, bool last);
+
 /******************************************************************************
  * Function Prototypes
  *****************************************************************************/
 
 /**
- * @brief Initialize LVGL 9.3.0 display system
+ * @brief Fill a config with the defaults for this board
+ * @details Uses MAIN_sysinfo_has_psram to pick the buffer placement: with
+ *          PSRAM present the policy is AUTO (internal DMA SRAM first, PSRAM
+ *          if internal RAM is short), otherwise internal DMA SRAM only.
+ *          LVGL_BUFFER_LINES lines, PARTIAL render mode, double buffered;
+ *          with LVGL_PIPELINE_STRIPS set, that many LVGL_PIPELINE_STRIP_LINES
+ *          strips instead.
+ * @param config Config structure to fill
+ */
+void MAIN_lvgl_get_default_config(MAIN_lvgl_config_t *config);
+
+/**
+ * @brief Initialize LVGL 9.3.0 display system with explicit options
+ * @param gfx Pointer to Arduino_GFX display object
+ * @param displayMutex FreeRTOS mutex for display access synchronization
+ * @param screenWidth Display width in pixels
+ * @param screenHeight Display height in pixels
+ * @param config Buffer and render mode options (NULL for defaults)
+ * @return true if initialization successful
+ * @return false if initialization failed
+ */
+bool MAIN_initialise_lvgl_with_config(Arduino_GFX *gfx, SemaphoreHandle_t displayMutex,
+                                      uint32_t screenWidth, uint32_t screenHeight,
+                                      const MAIN_lvgl_config_t *config);
+
+/**
+ * @brief Initialize LVGL 9.3.0 display system with default options
  * @param gfx Pointer to Arduino_GFX display object
  * @param displayMutex FreeRTOS mutex for display access synchronization
  * @param screenWidth Display width in pixels
@@ -77,6 +270,148 @@ lv_display_t *MAIN_get_lvgl_display(void);
  */
 void MAIN_clear_lvgl_buffers(void);
 
+/**
+ * @brief Set the task notified when the last area of a frame is flushed
+ * @details Lets an event-driven UI task sleep through the transfer and wake
+ *          as soon as the panel has the complete frame
+ * @param task Task to notify (NULL to disable)
+ */
+void MAIN_lvgl_set_wake_task(TaskHandle_t task);
+
+/**
+ * @brief Time the first complete frame reached the panel
+ * @return int64_t esp_timer_get_time() after its last area was sent, 0 = not yet
+ */
+int64_t MAIN_lvgl_get_first_frame_us(void);
+
+/**
+ * @brief Get the size of one draw buffer
+ * @return uint32_t Buffer size in bytes (0 if not initialized)
+ */
+uint32_t MAIN_lvgl_get_buffer_size(void);
+
+/**
+ * @brief Get the number of draw buffers
+ * @return uint8_t 1, 2, or the strips in rotation when pipelined
+ */
+uint8_t MAIN_lvgl_get_buffer_count(void);
+
+/**
+ * @brief Check whether the draw buffers were allocated in PSRAM
+ * @return true if buffers are in PSRAM
+ * @return false if buffers are in internal SRAM
+ */
+bool MAIN_lvgl_buffers_in_psram(void);
+
+/**
+ * @brief Get the render mode the display was created with
+ * @return lv_display_render_mode_t PARTIAL, DIRECT or FULL
+ */
+lv_display_render_mode_t MAIN_lvgl_get_render_mode(void);
+
+/**
+ * @brief Run lv_timer_handler and record how long it took
+ * @details Drop-in replacement for lv_timer_handler in the UI task
+ * @return uint32_t Milliseconds until LVGL next needs servicing
+ */
+uint32_t MAIN_lvgl_timer_handler(void);
+
+/**
+ * @brief Get rendering and flush performance counters
+ * @param stats Structure to fill with a snapshot of the counters
+ * @note Counters updated by the flush task may be one transfer ahead of
+ *       the frame counters in the snapshot
+ */
+void MAIN_lvgl_get_stats(MAIN_lvgl_stats_t *stats);
+
+/**
+ * @brief Reset rendering and flush performance counters to zero
+ */
+void MAIN_lvgl_reset_stats(void);
+
+/**
+ * @brief Format a one-line stats summary
+ * @details Suitable for the SD logger or any text sink
+ * @param buffer Destination buffer
+ * @param bufferSize Size of destination buffer in bytes
+ * @return size_t Number of characters written (excluding terminator)
+ */
+size_t MAIN_lvgl_format_stats(char *buffer, size_t bufferSize);
+
+/**
+ * @brief Print rendering and flush statistics to Serial (debug builds only)
+ */
+void MAIN_lvgl_print_stats(void);
+
+/**
+ * @brief Write a stats summary line to the SD logger
+ * @return true if the logger accepted the entry
+ * @return false if the logger is not initialized
+ */
+bool MAIN_lvgl_log_stats(void);
+
+/**
+ * @brief Get dirty-area coalescing counters
+ * @param stats Structure to fill with a snapshot of the counters
+ */
+void MAIN_lvgl_get_coalesce_stats(MAIN_lvgl_coalesce_stats_t *stats);
+
+/**
+ * @brief Reset dirty-area coalescing counters to zero
+ */
+void MAIN_lvgl_reset_coalesce_stats(void);
+
+/**
+ * @brief Time an input device's presses and releases to the panel
+ * @details Each LV_EVENT_PRESSED / LV_EVENT_RELEASED dispatch is reported to
+ *          MAIN_sysinfo_latency_input() with the device's input time, and
+ *          each completed frame to MAIN_sysinfo_latency_frame(). Nothing is
+ *          recorded until MAIN_sysinfo_latency_enable(true).
+ * @param indev Pointer input device
+ * @param inputTime Input time of its last sample (NULL = the dispatch time)
+ * @return true if attached
+ * @note LVGL task only.
+ */
+bool MAIN_lvgl_latency_attach(lv_indev_t *indev, MAIN_lvgl_input_time_fn_t inputTime);
+
+/**
+ * @brief Show every flushed area to a tap before it goes to the panel
+ * @param tap Called from the flush callback
+ * @return true if installed (false: LVGL_FLUSH_TAPS already in use)
+ * @note LVGL task only. The tap runs inside the frame, so its time is
+ *       frame time.
+ */
+bool MAIN_lvgl_add_flush_tap(MAIN_lvgl_flush_tap_t tap);
+
+/**
+ * @brief Remove a flush tap
+ * @param tap Tap given to MAIN_lvgl_add_flush_tap()
+ * @note LVGL task only; a tap may remove itself.
+ */
+void MAIN_lvgl_remove_flush_tap(MAIN_lvgl_flush_tap_t tap);
+
+/**
+ * @brief Check whether flushes are paced by the panel's TE pulses
+ * @return true if LCD_TE is routed and its pulses are arriving
+ */
+bool MAIN_lvgl_is_te_synced(void);
+
+/**
+ * @brief Round a display refresh period to whole panel refreshes
+ * @details Lets the refresh timer run in step with the panel rather than
+ *          beating against it. Unchanged while flushes are unpaced.
+ * @param periodMs Wanted refresh period in ms
+ * @return uint32_t Nearest whole number of panel refreshes (at least one), in ms
+ */
+uint32_t MAIN_lvgl_align_refresh_period(uint32_t periodMs);
+
+/**
+ * @brief Check whether the asynchronous flush path is active
+ * @return true if flushes are handed to the flush task
+ * @return false if flushes complete inside MAIN_lvgl_flush_cb
+ */
+bool MAIN_lvgl_is_async_flush(void);
+
 /**
  * @brief Create a simple test UI panel
  * @param message Text to display on the test panel
@@ -93,6 +428,21 @@ void MAIN_create_test_ui(const char *message);
  */
 void MAIN_lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
 
+/**
+ * @brief LVGL flush wait callback
+ * @note Blocks the rendering task until the flush task has released the
+ *       draw buffer, instead of spinning on the flushing flag
+ */
+void MAIN_lvgl_flush_wait_cb(lv_display_t *disp);
+
+/**
+ * @brief Flush task function (runs on LVGL_FLUSH_TASK_CORE)
+ * @param parameter Task parameter (unused)
+ * @details Pushes queued areas to the panel and signals
+ *          lv_display_flush_ready once each transfer has completed
+ */
+void MAIN_lvgl_flush_task(void *parameter);
+
 /**
  * @brief LVGL tick callback
  * @note Provides millisecond timing to LVGL
@@ -0,0 +1,313 @@
+/**
+ * @file MAIN_lvglLogLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief LVGL log bridge into EARS_logger, with a runtime level and rate limits
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_lvglLogLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_configLib.h"
+#include "EARS_loggerLib.h"
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t hash;        // Module name hash, 0 = free
+    uint32_t windowStart; // millis() the current window opened
+    uint16_t count;       // Messages let through in the window
+    uint16_t suppressed;  // Dropped since the last report
+} lvgl_log_module_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static volatile lv_log_level_t lvgl_log_level = LVGL_LOG_DEFAULT_LEVEL;
+static lvgl_log_module_t lvgl_log_modules[LVGL_LOG_MODULES];
+static MAIN_lvgl_log_stats_t lvgl_log_stats;
+static portMUX_TYPE lvgl_log_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Config names, indexed by lv_log_level_t (USER is never a threshold)
+static const char *const lvgl_log_level_names[] = {"TRACE", "INFO", "WARN", "ERROR", "USER", "NONE"};
+
+/******************************************************************************
+ * Static Functions
+ *****************************************************************************/
+
+/**
+ * @brief Pass one line to EARS_logger (and the trace in debug builds)
+ */
+static void lvgl_log_emit(lv_log_level_t level, const char *line)
+{
+    EARS_logger &logger = EARS_logger::getInstance();
+    switch (level)
+    {
+    case LV_LOG_LEVEL_TRACE:
+        logger.debug(line);
+        break;
+    case LV_LOG_LEVEL_WARN:
+        logger.warn(line);
+        break;
+    case LV_LOG_LEVEL_ERROR:
+        logger.error(line);
+        break;
+    default:
+        logger.info(line);
+        break;
+    }
+
+    DEBUG_PRINTF("%s\n", line);
+}
+
+/**
+ * @brief Module name of a formatted LVGL line: the source file before ":line"
+ * @param body Line without the level prefix or trailing newline
+ * @param length Length of body
+ * @param module Receives the start of the name
+ * @return size_t Length of the name (0 for lv_log() user lines)
+ */
+static size_t lvgl_log_module(const char *body, size_t length, const char **module)
+{
+    size_t end = length;
+    while (end > 0 && body[end - 1] != ':' && body[end - 1] != ' ')
+    {
+        end--;
+    }
+    if (end == 0 || body[end - 1] != ':')
+    {
+        *module = body;
+        return 0;
+    }
+
+    size_t start = end - 1;
+    while (start > 0 && body[start - 1] != ' ')
+    {
+        start--;
+    }
+    *module = body + start;
+    return end - 1 - start;
+}
+
+/**
+ * @brief LVGL print callback
+ * @param level Message level
+ * @param buf "[Level] func: message file.c:line\n", formatted by LVGL
+ */
+static void lvgl_log_print_cb(lv_log_level_t level, const char *buf)
+{
+    if (level < lvgl_log_level)
+    {
+        lvgl_log_stats.filtered++;
+        return;
+    }
+
+    // Drop LVGL's "[Warn] " prefix and newline: EARS_logger stamps its own
+    const char *body = buf;
+    if (body[0] == '[')
+    {
+        const char *close = strchr(body, ']');
+        if (close != NULL)
+        {
+            body = close + 1;
+            while (*body == ' ')
+            {
+                body++;
+            }
+        }
+    }
+    size_t length = strlen(body);
+    while (length > 0 && (body[length - 1] == '\n' || body[length - 1] == '\r'))
+    {
+        length--;
+    }
+
+    const char *module;
+    size_t moduleLength = lvgl_log_module(body, length, &module);
+
+    // FNV-1a of the module name picks its slot
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < moduleLength; i++)
+    {
+        hash = (hash ^ (uint8_t)module[i]) * 16777619UL;
+    }
+    hash |= 1; // 0 marks a free slot
+
+    uint32_t now = millis();
+    uint16_t reported = 0;
+    bool pass;
+
+    portENTER_CRITICAL(&lvgl_log_lock);
+    lvgl_log_module_t *slot = &lvgl_log_modules[(hash >> 8) % LVGL_LOG_MODULES];
+    if (slot->hash != hash)
+    {
+        slot->hash = hash;
+        slot->windowStart = now;
+        slot->count = 0;
+        slot->suppressed = 0;
+    }
+    else if (now - slot->windowStart >= LVGL_LOG_WINDOW_MS)
+    {
+        reported = slot->suppressed;
+        slot->windowStart = now;
+        slot->count = 0;
+        slot->suppressed = 0;
+    }
+
+    pass = slot->count < LVGL_LOG_BURST;
+    if (pass)
+    {
+        slot->count++;
+        lvgl_log_stats.logged++;
+    }
+    else
+    {
+        if (slot->suppressed < UINT16_MAX)
+        {
+            slot->suppressed++;
+        }
+        lvgl_log_stats.suppressed++;
+    }
+    portEXIT_CRITICAL(&lvgl_log_lock);
+
+    if (!pass)
+    {
+        return;
+    }
+
+    char line[LVGL_LOG_LINE_MAX];
+    if (reported > 0)
+    {
+        snprintf(line, sizeof(line), "LVGL %.*s: %u messages suppressed", (int)moduleLength, module, reported);
+        lvgl_log_emit(level, line);
+    }
+
+    snprintf(line, sizeof(line), "LVGL %.*s", (int)length, body);
+    lvgl_log_emit(level, line);
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Register the bridge with LVGL
+ */
+void MAIN_initialise_lvgl_log(void)
+{
+    lv_log_register_print_cb(lvgl_log_print_cb);
+
+#if EARS_DEBUG == 1
+    Serial.printf("[OK] LVGL log bridge (level %s, compiled from %s)\n",
+                  lvgl_log_level_names[lvgl_log_level], lvgl_log_level_names[LV_LOG_LEVEL]);
+#endif
+}
+
+/**
+ * @brief Set the runtime level
+ */
+void MAIN_lvgl_log_set_level(lv_log_level_t level, bool save)
+{
+    if (level < LV_LOG_LEVEL_TRACE || level > LV_LOG_LEVEL_NONE)
+    {
+        return;
+    }
+    lvgl_log_level = level;
+
+    if (save)
+    {
+        EARS_configLogger cfg = using_config().logger();
+        strlcpy(cfg.lvglLogLevel, lvgl_log_level_names[level], sizeof(cfg.lvglLogLevel));
+        using_config().setLogger(cfg);
+    }
+}
+
+/**
+ * @brief Set the runtime level from its config name
+ */
+bool MAIN_lvgl_log_set_level_name(const char *name)
+{
+    if (name == NULL)
+    {
+        return false;
+    }
+
+    if (strcasecmp(name, "DEBUG") == 0)
+    {
+        MAIN_lvgl_log_set_level(LV_LOG_LEVEL_TRACE, false);
+        return true;
+    }
+
+    for (uint8_t level = LV_LOG_LEVEL_TRACE; level <= LV_LOG_LEVEL_NONE; level++)
+    {
+        if (level != LV_LOG_LEVEL_USER && strcasecmp(name, lvgl_log_level_names[level]) == 0)
+        {
+            MAIN_lvgl_log_set_level((lv_log_level_t)level, false);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Runtime level
+ */
+lv_log_level_t MAIN_lvgl_log_get_level(void)
+{
+    return lvgl_log_level;
+}
+
+/**
+ * @brief Bridge counters
+ */
+void MAIN_lvgl_log_get_stats(MAIN_lvgl_log_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+    portENTER_CRITICAL(&lvgl_log_lock);
+    *stats = lvgl_log_stats;
+    portEXIT_CRITICAL(&lvgl_log_lock);
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_LvglLog_getLibraryName() {
+    return MAIN_LvglLog::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_LvglLog_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_LvglLog::VERSION_MAJOR,
+                       MAIN_LvglLog::VERSION_MINOR,
+                       MAIN_LvglLog::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_LvglLog_getVersionDate() {
+    return MAIN_LvglLog::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_LvglLog_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_LvglLog_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_lvglLogLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,129 @@
+/**
+ * @file MAIN_lvglLogLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief LVGL log bridge into EARS_logger, with a runtime level and rate limits
+ * @details LVGL's log output is registered with lv_log_register_print_cb
+ *          instead of printf (LV_LOG_PRINTF 0), so no LVGL message writes to
+ *          the console from inside rendering. Each message that passes the
+ *          runtime level goes to EARS_logger, whose async mode only copies it
+ *          into the Core 1 writer's ring, and in debug builds to the deferred
+ *          trace (DEBUG_PRINTF).
+ *
+ *          The level comes from ears.config logger.lvgl_log_level ("NONE",
+ *          "ERROR", "WARN", "INFO", "TRACE") and can be changed at run time.
+ *          LV_LOG_LEVEL in lv_conf.h is the floor: messages below it are not
+ *          compiled in.
+ *
+ *          Each LVGL source file is a module with its own rate limit:
+ *          LVGL_LOG_BURST messages per LVGL_LOG_WINDOW_MS, the rest counted
+ *          and reported as one line when the module next logs. A widget
+ *          warning repeated every frame costs a counter increment after the
+ *          first few.
+ *
+ *          LVGL formats every message at or above LV_LOG_LEVEL before the
+ *          bridge sees it (768 bytes of the caller's stack), so the runtime
+ *          level saves the logging, not the formatting.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_LVGL_LOG_LIB_H__
+#define __MAIN_LVGL_LOG_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <lvgl.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_LvglLog
+{
+    constexpr const char* LIB_NAME = "MAIN_LvglLog";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_LvglLog_getLibraryName();
+uint32_t MAIN_LvglLog_getVersionEncoded();
+const char* MAIN_LvglLog_getVersionDate();
+void MAIN_LvglLog_getVersionString(char* buffer);
+
+/******************************************************************************
+ * LVGL Log Configuration
+ *****************************************************************************/
+
+// Level until ears.config is read
+#define LVGL_LOG_DEFAULT_LEVEL LV_LOG_LEVEL_WARN
+
+// Per-module rate limit: messages let through per window
+#define LVGL_LOG_BURST 4
+#define LVGL_LOG_WINDOW_MS 1000
+
+// Modules tracked at once (a new module takes over the slot of its hash)
+#define LVGL_LOG_MODULES 16
+
+// Longest message passed on, longer ones are cut
+#define LVGL_LOG_LINE_MAX 192
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t logged;     // Passed to EARS_logger
+    uint32_t filtered;   // Below the runtime level
+    uint32_t suppressed; // Over a module's rate limit
+} MAIN_lvgl_log_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Register the bridge with LVGL
+ * @note Call after lv_init(): LVGL keeps the callback in its globals.
+ */
+void MAIN_initialise_lvgl_log(void);
+
+/**
+ * @brief Set the runtime level
+ * @param level LV_LOG_LEVEL_TRACE to LV_LOG_LEVEL_NONE
+ * @param save true to write it to ears.config logger.lvgl_log_level
+ */
+void MAIN_lvgl_log_set_level(lv_log_level_t level, bool save);
+
+/**
+ * @brief Set the runtime level from its config name
+ * @param name "NONE", "ERROR", "WARN", "INFO" or "TRACE" ("DEBUG" = "TRACE")
+ * @return true if the name was recognised
+ */
+bool MAIN_lvgl_log_set_level_name(const char *name);
+
+/**
+ * @brief Runtime level
+ * @return lv_log_level_t Current level
+ */
+lv_log_level_t MAIN_lvgl_log_get_level(void);
+
+/**
+ * @brief Bridge counters
+ * @param stats Receives the counters
+ */
+void MAIN_lvgl_log_get_stats(MAIN_lvgl_log_stats_t *stats);
+
+#endif // __MAIN_LVGL_LOG_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_lvglLogLib.h
+ ******************************************************************************/
@@ -0,0 +1,461 @@
+/**
+ * @file MAIN_lvglMemLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief LVGL memory backend on the capability heaps, with PSRAM spill
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_lvglMemLib.h"
+#include "lvgl_private.h"
+#include <esp_heap_caps.h>
+#include <string.h>
+#if __has_include(<esp_memory_utils.h>)
+#include <esp_memory_utils.h>
+#else
+#include <soc/soc_memory_layout.h>
+#endif
+
+// Counters of both the allocator and the layer buffers
+static portMUX_TYPE lvgl_mem_lock = portMUX_INITIALIZER_UNLOCKED;
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t size;              // Requested bytes
+    uint16_t magic;
+    uint8_t cls;
+    uint8_t inPsram;
+} lvgl_mem_header_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+#define LVGL_MEM_MAGIC 0x4C56 // "LV"
+
+#define LVGL_MEM_CAPS_INTERNAL (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#define LVGL_MEM_CAPS_PSRAM (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+
+static MAIN_lvgl_mem_stats_t lvgl_mem_stats;
+
+/******************************************************************************
+ * Static Functions (internal to library)
+ *****************************************************************************/
+
+static inline MAIN_lvgl_mem_class_t lvgl_mem_class(size_t size)
+{
+    return size >= LVGL_MEM_LARGE_MIN ? LVGL_MEM_CLASS_LARGE : LVGL_MEM_CLASS_SMALL;
+}
+
+/**
+ * @brief Allocate or resize a block in the class's heap, spilling if full
+ * @param old Block header to resize, or NULL
+ * @param size Requested bytes
+ * @param spilled Set if the other heap served it
+ * @return lvgl_mem_header_t* Header, or NULL (old is untouched)
+ */
+static lvgl_mem_header_t *lvgl_mem_heap_alloc(lvgl_mem_header_t *old, size_t size, bool *spilled)
+{
+    size_t total = size + LVGL_MEM_HEADER;
+    bool large = lvgl_mem_class(size) == LVGL_MEM_CLASS_LARGE;
+    uint32_t first = large ? LVGL_MEM_CAPS_PSRAM : LVGL_MEM_CAPS_INTERNAL;
+
+    *spilled = false;
+    void *block = old != NULL ? heap_caps_realloc(old, total, first) : heap_caps_malloc(total, first);
+#if LVGL_MEM_SPILL == 1
+    if (block == NULL)
+    {
+        uint32_t second = large ? LVGL_MEM_CAPS_INTERNAL : LVGL_MEM_CAPS_PSRAM;
+        block = old != NULL ? heap_caps_realloc(old, total, second) : heap_caps_malloc(total, second);
+        *spilled = block != NULL;
+    }
+#endif
+    return (lvgl_mem_header_t *)block;
+}
+
+/**
+ * @brief Count a block in (sign 1) or out (sign -1) of its class
+ */
+static void lvgl_mem_count(const lvgl_mem_header_t *header, int sign)
+{
+    MAIN_lvgl_mem_class_stats_t *c = &lvgl_mem_stats.classes[header->cls];
+    if (sign > 0)
+    {
+        c->bytes += header->size;
+        c->blocks++;
+        if (header->inPsram)
+        {
+            c->bytesPsram += header->size;
+        }
+        if (c->bytes > c->peak)
+        {
+            c->peak = c->bytes;
+        }
+        lvgl_mem_stats.bytes += header->size;
+        if (lvgl_mem_stats.bytes > lvgl_mem_stats.peak)
+        {
+            lvgl_mem_stats.peak = lvgl_mem_stats.bytes;
+        }
+    }
+    else
+    {
+        c->bytes -= header->size;
+        c->blocks--;
+        if (header->inPsram)
+        {
+            c->bytesPsram -= header->size;
+        }
+        lvgl_mem_stats.bytes -= header->size;
+    }
+}
+
+/**
+ * @brief Fill in a new or moved block's header and count it
+ * @param header Block header
+ * @param size Requested bytes
+ * @param spilled Served by the other heap
+ * @return void* Block for LVGL
+ */
+static void *lvgl_mem_take(lvgl_mem_header_t *header, size_t size, bool spilled)
+{
+    header->size = (uint32_t)size;
+    header->magic = LVGL_MEM_MAGIC;
+    header->cls = (uint8_t)lvgl_mem_class(size);
+    header->inPsram = esp_ptr_external_ram(header) ? 1 : 0;
+
+    portENTER_CRITICAL(&lvgl_mem_lock);
+    lvgl_mem_count(header, 1);
+    lvgl_mem_stats.classes[header->cls].allocs++;
+    if (spilled)
+    {
+        lvgl_mem_stats.classes[header->cls].spills++;
+    }
+    portEXIT_CRITICAL(&lvgl_mem_lock);
+
+    return (uint8_t *)header + LVGL_MEM_HEADER;
+}
+
+static void lvgl_mem_fail(size_t size)
+{
+    portENTER_CRITICAL(&lvgl_mem_lock);
+    lvgl_mem_stats.classes[lvgl_mem_class(size)].failures++;
+    portEXIT_CRITICAL(&lvgl_mem_lock);
+}
+
+static lvgl_mem_header_t *lvgl_mem_header(void *p)
+{
+    lvgl_mem_header_t *header = (lvgl_mem_header_t *)((uint8_t *)p - LVGL_MEM_HEADER);
+    LV_ASSERT_MSG(header->magic == LVGL_MEM_MAGIC, "lv_free of a block not from lv_malloc");
+    return header;
+}
+
+/******************************************************************************
+ * LVGL Hooks (LV_STDLIB_CUSTOM)
+ *****************************************************************************/
+
+void lv_mem_init(void)
+{
+    memset(&lvgl_mem_stats, 0, sizeof(lvgl_mem_stats));
+}
+
+void lv_mem_deinit(void)
+{
+    // Blocks are freed by their owners
+}
+
+lv_mem_pool_t lv_mem_add_pool(void *mem, size_t bytes)
+{
+    // The capability heaps take no extra pools
+    LV_UNUSED(mem);
+    LV_UNUSED(bytes);
+    return NULL;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool)
+{
+    LV_UNUSED(pool);
+}
+
+void *lv_malloc_core(size_t size)
+{
+    bool spilled;
+    lvgl_mem_header_t *header = lvgl_mem_heap_alloc(NULL, size, &spilled);
+    if (header == NULL)
+    {
+        lvgl_mem_fail(size);
+        return NULL;
+    }
+    return lvgl_mem_take(header, size, spilled);
+}
+
+void *lv_realloc_core(void *p, size_t new_size)
+{
+    if (p == NULL)
+    {
+        return lv_malloc_core(new_size);
+    }
+
+    lvgl_mem_header_t *old = lvgl_mem_header(p);
+    lvgl_mem_header_t before = *old;
+
+    // heap_caps_realloc() moves the block if it is not in the wanted heap
+    bool spilled;
+    lvgl_mem_header_t *header = lvgl_mem_heap_alloc(old, new_size, &spilled);
+    if (header == NULL)
+    {
+        lvgl_mem_fail(new_size);
+        return NULL;
+    }
+
+    portENTER_CRITICAL(&lvgl_mem_lock);
+    lvgl_mem_count(&before, -1);
+    portEXIT_CRITICAL(&lvgl_mem_lock);
+    return lvgl_mem_take(header, new_size, spilled);
+}
+
+void lv_free_core(void *p)
+{
+    lvgl_mem_header_t *header = lvgl_mem_header(p);
+
+    portENTER_CRITICAL(&lvgl_mem_lock);
+    lvgl_mem_count(header, -1);
+    portEXIT_CRITICAL(&lvgl_mem_lock);
+
+    header->magic = 0;
+    heap_caps_free(header);
+}
+
+void lv_mem_monitor_core(lv_mem_monitor_t *mon_p)
+{
+    // Both heaps, as one pool; "used" is LVGL's share of it
+    size_t freeInternal = heap_caps_get_free_size(LVGL_MEM_CAPS_INTERNAL);
+    size_t freePsram = heap_caps_get_free_size(LVGL_MEM_CAPS_PSRAM);
+    size_t bigInternal = heap_caps_get_largest_free_block(LVGL_MEM_CAPS_INTERNAL);
+    size_t bigPsram = heap_caps_get_largest_free_block(LVGL_MEM_CAPS_PSRAM);
+
+    portENTER_CRITICAL(&lvgl_mem_lock);
+    uint32_t used = lvgl_mem_stats.bytes;
+    uint32_t peak = lvgl_mem_stats.peak;
+    uint32_t blocks = lvgl_mem_stats.classes[LVGL_MEM_CLASS_SMALL].blocks +
+                      lvgl_mem_stats.classes[LVGL_MEM_CLASS_LARGE].blocks;
+    portEXIT_CRITICAL(&lvgl_mem_lock);
+
+    mon_p->free_size = freeInternal + freePsram;
+    mon_p->total_size = mon_p->free_size + used;
+    mon_p->free_biggest_size = bigInternal > bigPsram ? bigInternal : bigPsram;
+    mon_p->free_cnt = 0;
+    mon_p->used_cnt = blocks;
+    mon_p->max_used = peak;
+    mon_p->used_pct = mon_p->total_size ? (uint8_t)((uint64_t)used * 100 / mon_p->total_size) : 0;
+    mon_p->frag_pct = freeInternal ? (uint8_t)(100 - (uint64_t)bigInternal * 100 / freeInternal) : 0;
+}
+
+lv_result_t lv_mem_test_core(void)
+{
+    return heap_caps_check_integrity_all(true) ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+#endif // LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+
+/******************************************************************************
+ * Layer Buffers
+ *****************************************************************************/
+
+static volatile uint32_t lvgl_mem_layer_slices = 0;
+static volatile uint32_t lvgl_mem_layer_failures = 0;
+
+#if EARS_LVGL_LAYER_PSRAM == 1
+
+/**
+ * @brief Layer buffer for LVGL (default draw-buffer handlers)
+ * @param size Bytes LVGL needs
+ * @param cf Colour format (unused)
+ * @return void* Buffer, aligned by LVGL afterwards
+ */
+static void *lvgl_mem_layer_malloc(size_t size, lv_color_format_t cf)
+{
+    LV_UNUSED(cf);
+
+    // Room for LVGL to align the start
+    size += LV_DRAW_BUF_ALIGN - 1;
+    void *buf = MAIN_mem_alloc(MEM_POOL_LAYERS, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (buf == NULL)
+    {
+        buf = MAIN_mem_alloc(MEM_POOL_LAYERS, size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+
+    portENTER_CRITICAL(&lvgl_mem_lock);
+    if (buf != NULL)
+    {
+        lvgl_mem_layer_slices++;
+    }
+    else
+    {
+        lvgl_mem_layer_failures++;
+    }
+    portEXIT_CRITICAL(&lvgl_mem_lock);
+    return buf;
+}
+
+static void lvgl_mem_layer_free(void *buf)
+{
+    MAIN_mem_free(buf);
+}
+
+#endif // EARS_LVGL_LAYER_PSRAM == 1
+
+/**
+ * @brief Serve LVGL's layer buffers from the layers pool
+ * @return true if attached
+ */
+bool MAIN_lvgl_mem_attach_layers(void)
+{
+#if EARS_LVGL_LAYER_PSRAM == 1
+    lv_draw_buf_handlers_t *handlers = lv_draw_buf_get_handlers();
+    handlers->buf_malloc_cb = lvgl_mem_layer_malloc;
+    handlers->buf_free_cb = lvgl_mem_layer_free;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Layer slice counters
+ * @param stats Receives the counters
+ */
+void MAIN_lvgl_mem_get_layer_stats(MAIN_lvgl_mem_layer_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    MAIN_mem_pool_stats_t pool;
+    MAIN_mem_plan_get_pool(MEM_POOL_LAYERS, &pool);
+
+    portENTER_CRITICAL(&lvgl_mem_lock);
+    stats->slices = lvgl_mem_layer_slices;
+    stats->failures = lvgl_mem_layer_failures;
+    portEXIT_CRITICAL(&lvgl_mem_lock);
+    stats->bytes = pool.used;
+    stats->peak = pool.peak;
+    stats->bytesPsram = pool.usedPsram;
+}
+
+/******************************************************************************
+ * LVGL Memory
+ *****************************************************************************/
+
+/**
+ * @brief Name of the allocator compiled in
+ * @return const char* "heap_caps" or "builtin"
+ */
+const char *MAIN_lvgl_mem_backend(void)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+    return "heap_caps";
+#else
+    return "builtin";
+#endif
+}
+
+/**
+ * @brief Counters per size class
+ * @param stats Receives the counters
+ */
+void MAIN_lvgl_mem_get_stats(MAIN_lvgl_mem_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+    portENTER_CRITICAL(&lvgl_mem_lock);
+    *stats = lvgl_mem_stats;
+    portEXIT_CRITICAL(&lvgl_mem_lock);
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+/**
+ * @brief Print the counters to Serial
+ */
+void MAIN_lvgl_mem_print_report(void)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+    static const char *const names[LVGL_MEM_CLASS_COUNT] = {"small", "large"};
+
+    MAIN_lvgl_mem_stats_t s;
+    MAIN_lvgl_mem_get_stats(&s);
+
+    Serial.printf("[LVGLMEM] heap_caps: %lu B in use, peak %lu B (large from %u B)\n", (unsigned long)s.bytes,
+                  (unsigned long)s.peak, (unsigned)LVGL_MEM_LARGE_MIN);
+    for (uint8_t i = 0; i < LVGL_MEM_CLASS_COUNT; i++)
+    {
+        const MAIN_lvgl_mem_class_stats_t *c = &s.classes[i];
+        Serial.printf("[LVGLMEM] %-5s %lu B in %lu blocks, peak %lu B, %lu B PSRAM, %lu spills, %lu failures\n",
+                      names[i], (unsigned long)c->bytes, (unsigned long)c->blocks, (unsigned long)c->peak,
+                      (unsigned long)c->bytesPsram, (unsigned long)c->spills, (unsigned long)c->failures);
+    }
+#else
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    Serial.printf("[LVGLMEM] builtin: %lu / %lu B used, peak %lu B, %u%% fragmented\n",
+                  (unsigned long)(mon.total_size - mon.free_size), (unsigned long)mon.total_size,
+                  (unsigned long)mon.max_used, (unsigned)mon.frag_pct);
+#endif
+
+#if EARS_LVGL_LAYER_PSRAM == 1
+    MAIN_lvgl_mem_layer_stats_t l;
+    MAIN_lvgl_mem_get_layer_stats(&l);
+    Serial.printf("[LVGLMEM] layers %lu slices of up to %lu B, peak %lu B, %lu B PSRAM now, %lu failures\n",
+                  (unsigned long)l.slices, (unsigned long)LV_DRAW_LAYER_SIMPLE_BUF_SIZE, (unsigned long)l.peak,
+                  (unsigned long)l.bytesPsram, (unsigned long)l.failures);
+#endif
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_LvglMem_getLibraryName() {
+    return MAIN_LvglMem::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_LvglMem_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_LvglMem::VERSION_MAJOR,
+                       MAIN_LvglMem::VERSION_MINOR,
+                       MAIN_LvglMem::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_LvglMem_getVersionDate() {
+    return MAIN_LvglMem::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_LvglMem_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_LvglMem_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_lvglMemLib.cpp
+ ******************************************************************************/
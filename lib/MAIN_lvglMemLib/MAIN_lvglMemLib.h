@@ -0,0 +1,156 @@
+/**
+ * @file MAIN_lvglMemLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief LVGL memory backend on the capability heaps, with PSRAM spill
+ * @details LVGL's LV_STDLIB_CUSTOM allocator. With EARS_LVGL_HEAP_CAPS=1
+ *          (the default in lv_conf.h) lv_malloc() no longer carves a fixed
+ *          LV_MEM_SIZE arena; it goes to heap_caps_malloc() by size class:
+ *
+ *          - small (objects, styles, text, timers): internal RAM, where the
+ *            widget tree is walked every frame
+ *          - large (image decode, layers, snapshots, caches): PSRAM
+ *
+ *          A class whose heap is full spills to the other one, so the UI
+ *          grows until both heaps are exhausted rather than at a pool
+ *          ceiling. Each block carries a LVGL_MEM_HEADER byte header (its
+ *          size and where it landed), so the counters per class stay exact.
+ *
+ *          The capability heaps are thread safe; the counters are guarded,
+ *          so LVGL's draw threads (EARS_LVGL_OS=1) may allocate too.
+ *          lv_mem_monitor() reports both heaps together.
+ *
+ *          Layer buffers (opacity, transforms and blend modes render the
+ *          widget into an intermediate layer) come from LVGL's default
+ *          draw-buffer handlers. With EARS_LVGL_LAYER_PSRAM=1 those are
+ *          pointed at the memory plan's layers pool in PSRAM, and lv_conf.h
+ *          sizes a simple layer slice from the screen, so a faded or
+ *          rotated screen renders in one or two slices rather than a dozen.
+ *          Each slice allocates one buffer, which is what is counted.
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_LVGL_MEM_LIB_H__
+#define __MAIN_LVGL_MEM_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <lvgl.h>
+#include "EARS_versionDef.h"
+#include "MAIN_memPlanLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_LvglMem
+{
+    constexpr const char* LIB_NAME = "MAIN_LvglMem";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "1";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_LvglMem_getLibraryName();
+uint32_t MAIN_LvglMem_getVersionEncoded();
+const char* MAIN_LvglMem_getVersionDate();
+void MAIN_LvglMem_getVersionString(char* buffer);
+
+/******************************************************************************
+ * LVGL Memory Configuration
+ *****************************************************************************/
+
+// Requests of this many bytes or more are large (PSRAM first)
+#define LVGL_MEM_LARGE_MIN 2048
+
+// 1 = a full heap spills to the other one, 0 = fail as the builtin pool did
+#define LVGL_MEM_SPILL 1
+
+// Bytes in front of each block (keeps the heap's alignment)
+#define LVGL_MEM_HEADER 8
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef enum
+{
+    LVGL_MEM_CLASS_SMALL = 0,   // Internal first
+    LVGL_MEM_CLASS_LARGE,       // PSRAM first
+    LVGL_MEM_CLASS_COUNT
+} MAIN_lvgl_mem_class_t;
+
+typedef struct
+{
+    uint32_t bytes;             // Requested bytes now (headers excluded)
+    uint32_t peak;
+    uint32_t bytesPsram;        // Of bytes, those in PSRAM
+    uint32_t blocks;            // Blocks now
+    uint32_t allocs;            // Allocations and reallocations
+    uint32_t spills;            // Served by the other heap
+    uint32_t failures;          // Refused by both heaps
+} MAIN_lvgl_mem_class_stats_t;
+
+typedef struct
+{
+    MAIN_lvgl_mem_class_stats_t classes[LVGL_MEM_CLASS_COUNT];
+    uint32_t bytes;             // Both classes now
+    uint32_t peak;              // Both classes together
+} MAIN_lvgl_mem_stats_t;
+
+typedef struct
+{
+    uint32_t slices;            // Layer buffers allocated (one per slice)
+    uint32_t failures;          // Refused by both heaps (LVGL retries later)
+    uint32_t bytes;             // Layer memory now
+    uint32_t peak;
+    uint32_t bytesPsram;        // Of bytes, those in PSRAM
+} MAIN_lvgl_mem_layer_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Name of the allocator compiled in
+ * @return const char* "heap_caps" or "builtin"
+ */
+const char *MAIN_lvgl_mem_backend(void);
+
+/**
+ * @brief Counters per size class
+ * @param stats Receives the counters (zero with the builtin allocator)
+ */
+void MAIN_lvgl_mem_get_stats(MAIN_lvgl_mem_stats_t *stats);
+
+/**
+ * @brief Serve LVGL's layer buffers from the layers pool
+ * @return true if attached (EARS_LVGL_LAYER_PSRAM=1)
+ * @note Right after lv_init(), before any layer is drawn.
+ */
+bool MAIN_lvgl_mem_attach_layers(void);
+
+/**
+ * @brief Layer slice counters
+ * @param stats Receives the counters
+ * @note Any task; slices rise monotonically, difference them per frame.
+ */
+void MAIN_lvgl_mem_get_layer_stats(MAIN_lvgl_mem_layer_stats_t *stats);
+
+/**
+ * @brief Print use, peak, PSRAM share and spills per size class
+ */
+void MAIN_lvgl_mem_print_report(void);
+
+#endif // __MAIN_LVGL_MEM_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_lvglMemLib.h
+ ******************************************************************************/
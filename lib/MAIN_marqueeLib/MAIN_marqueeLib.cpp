@@ -0,0 +1,439 @@
+/**
+ * @file MAIN_marqueeLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Scrolling text drawn from a strip rendered once
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_marqueeLib.h"
+#include "EARS_systemDef.h"
+#include <lvgl_private.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    lv_obj_t *obj;              // NULL = free slot
+    char *text;                 // lv_strdup() copy
+    lv_draw_buf_t *strip;       // A8 coverage of the whole text
+    uint32_t posMilli;          // Scroll position, 1/1000 pixel
+    uint32_t lastTick;
+    uint16_t speed;             // Pixels per second
+    bool dirty;                 // Strip to render again
+} marquee_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static marquee_t marquee_slots[MARQUEE_MAX];
+static lv_timer_t *marquee_timer = NULL;
+static MAIN_marquee_stats_t marquee_stats;
+
+/******************************************************************************
+ * Static Functions (internal to library)
+ *****************************************************************************/
+
+/**
+ * @brief Slot of a marquee
+ * @param obj Marquee (NULL finds a free slot)
+ * @return marquee_t* Slot, or NULL
+ */
+static marquee_t *marquee_find(const lv_obj_t *obj)
+{
+    for (uint8_t i = 0; i < MARQUEE_MAX; i++)
+    {
+        if (marquee_slots[i].obj == obj)
+        {
+            return &marquee_slots[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Length of one scroll cycle (text and gap)
+ * @param m Marquee with a strip
+ * @return int32_t Pixels
+ */
+static int32_t marquee_period(const marquee_t *m)
+{
+    return (int32_t)m->strip->header.w + MARQUEE_GAP;
+}
+
+/**
+ * @brief Whether the text is wider than the marquee
+ * @param m Marquee
+ * @return true if it scrolls
+ */
+static bool marquee_overflows(const marquee_t *m)
+{
+    return m->strip != NULL && (int32_t)m->strip->header.w > lv_obj_get_content_width(m->obj);
+}
+
+/**
+ * @brief Render the text into the A8 strip
+ * @param m Marquee
+ * @note UI task, outside rendering (the draw units are dispatched here).
+ */
+static void marquee_render(marquee_t *m)
+{
+    m->dirty = false;
+    if (m->strip != NULL)
+    {
+        marquee_stats.bytes -= m->strip->data_size;
+        lv_draw_buf_destroy(m->strip);
+        m->strip = NULL;
+    }
+    if (m->text == NULL || m->text[0] == '\0')
+    {
+        lv_obj_refresh_self_size(m->obj);
+        return;
+    }
+
+    const lv_font_t *font = lv_obj_get_style_text_font(m->obj, LV_PART_MAIN);
+    int32_t letterSpace = lv_obj_get_style_text_letter_space(m->obj, LV_PART_MAIN);
+    lv_point_t size;
+    lv_text_get_size(&size, m->text, font, letterSpace, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    int32_t w = LV_MAX(1, size.x);
+    int32_t h = LV_MAX(1, size.y);
+
+    // The glyphs are drawn white into ARGB8888, then only their alpha is kept
+    lv_draw_buf_handlers_t *handlers = lv_draw_buf_get_image_handlers();
+    lv_draw_buf_t *argb = lv_draw_buf_create_ex(handlers, w, h, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    lv_draw_buf_t *strip = lv_draw_buf_create_ex(handlers, w, h, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    if (argb == NULL || strip == NULL)
+    {
+        if (argb != NULL)
+        {
+            lv_draw_buf_destroy(argb);
+        }
+        if (strip != NULL)
+        {
+            lv_draw_buf_destroy(strip);
+        }
+        Serial.println("[MARQUEE] ERROR: No memory for the text strip");
+        return;
+    }
+    lv_draw_buf_clear(argb, NULL);
+
+    lv_area_t area = {0, 0, w - 1, h - 1};
+    lv_layer_t layer;
+    lv_layer_init(&layer);
+    layer.draw_buf = argb;
+    layer.color_format = LV_COLOR_FORMAT_ARGB8888;
+    layer.buf_area = area;
+    layer._clip_area = area;
+    layer.phy_clip_area = area;
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.font = font;
+    dsc.letter_space = letterSpace;
+    dsc.color = lv_color_white();
+    dsc.text = m->text;
+    lv_draw_label(&layer, &dsc, &area);
+
+    // As lv_canvas_finish_layer()
+    lv_display_t *display = lv_obj_get_display(m->obj);
+    while (layer.draw_task_head)
+    {
+        lv_draw_dispatch_wait_for_request();
+        if (!lv_draw_dispatch_layer(display, &layer))
+        {
+            lv_draw_wait_for_finish();
+            lv_draw_dispatch_request();
+        }
+    }
+
+    for (int32_t y = 0; y < h; y++)
+    {
+        const lv_color32_t *src = (const lv_color32_t *)(argb->data + (uint32_t)y * argb->header.stride);
+        uint8_t *dst = strip->data + (uint32_t)y * strip->header.stride;
+        for (int32_t x = 0; x < w; x++)
+        {
+            dst[x] = src[x].alpha;
+        }
+    }
+    lv_draw_buf_destroy(argb);
+
+    m->strip = strip;
+    m->posMilli = 0;
+    marquee_stats.renders++;
+    marquee_stats.bytes += strip->data_size;
+    lv_obj_refresh_self_size(m->obj);
+    lv_obj_invalidate(m->obj);
+}
+
+/**
+ * @brief Whether a marquee can be seen now
+ * @param obj Marquee
+ * @return true on the active screen, not hidden and not scrolled away
+ */
+static bool marquee_visible(lv_obj_t *obj)
+{
+    return lv_obj_get_screen(obj) == lv_screen_active() && lv_obj_is_visible(obj);
+}
+
+/**
+ * @brief LVGL timer: render dirty strips and step visible marquees
+ * @param timer Unused
+ */
+static void marquee_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    uint32_t now = lv_tick_get();
+    marquee_stats.scrolling = 0;
+
+    for (uint8_t i = 0; i < MARQUEE_MAX; i++)
+    {
+        marquee_t *m = &marquee_slots[i];
+        if (m->obj == NULL)
+        {
+            continue;
+        }
+        if (m->dirty)
+        {
+            marquee_render(m);
+        }
+
+        uint32_t elapsed = now - m->lastTick;
+        m->lastTick = now;
+
+        // Paused: no step and no invalidation while it cannot be seen
+        if (m->speed == 0 || !marquee_overflows(m) || !marquee_visible(m->obj))
+        {
+            continue;
+        }
+
+        uint32_t period = (uint32_t)marquee_period(m) * 1000;
+        uint32_t before = m->posMilli / 1000;
+        m->posMilli = (m->posMilli + m->speed * elapsed) % period;
+        marquee_stats.scrolling++;
+        if (m->posMilli / 1000 != before)
+        {
+            lv_obj_invalidate(m->obj);
+            marquee_stats.steps++;
+        }
+    }
+}
+
+/**
+ * @brief Marquee events: draw, size, restyle and delete
+ * @param e Event
+ */
+static void marquee_event_cb(lv_event_t *e)
+{
+    lv_obj_t *obj = lv_event_get_current_target_obj(e);
+    marquee_t *m = marquee_find(obj);
+    if (m == NULL)
+    {
+        return;
+    }
+
+    switch (lv_event_get_code(e))
+    {
+    case LV_EVENT_DRAW_MAIN:
+    {
+        if (m->strip == NULL)
+        {
+            return;
+        }
+
+        lv_layer_t *layer = lv_event_get_layer(e);
+        lv_area_t content;
+        lv_area_t clip;
+        lv_obj_get_content_coords(obj, &content);
+        if (!lv_area_intersect(&clip, &layer->_clip_area, &content))
+        {
+            return;
+        }
+
+        lv_draw_image_dsc_t dsc;
+        lv_draw_image_dsc_init(&dsc);
+        dsc.base.layer = layer;
+        dsc.src = m->strip;
+        dsc.recolor = lv_obj_get_style_text_color_filtered(obj, LV_PART_MAIN);
+        dsc.opa = lv_obj_get_style_text_opa(obj, LV_PART_MAIN);
+
+        // One window of the strip, then its repeat after the gap
+        bool scrolls = marquee_overflows(m);
+        int32_t x = content.x1 - (scrolls ? (int32_t)(m->posMilli / 1000) : 0);
+        lv_area_t clipOri = layer->_clip_area;
+        layer->_clip_area = clip;
+        for (uint8_t copy = 0; copy < (scrolls ? 2 : 1); copy++)
+        {
+            lv_area_t coords = {x, content.y1, x + (int32_t)m->strip->header.w - 1,
+                                content.y1 + (int32_t)m->strip->header.h - 1};
+            dsc.image_area = coords;
+            lv_draw_image(layer, &dsc, &coords);
+            x += marquee_period(m);
+        }
+        layer->_clip_area = clipOri;
+        break;
+    }
+    case LV_EVENT_GET_SELF_SIZE:
+    {
+        // LV_SIZE_CONTENT takes the text's size, as on a label
+        lv_point_t *p = (lv_point_t *)lv_event_get_param(e);
+        if (m->strip != NULL)
+        {
+            p->x = LV_MAX(p->x, (int32_t)m->strip->header.w);
+            p->y = LV_MAX(p->y, (int32_t)m->strip->header.h);
+        }
+        break;
+    }
+    case LV_EVENT_STYLE_CHANGED:
+        m->dirty = true;
+        break;
+    case LV_EVENT_DELETE:
+        if (m->strip != NULL)
+        {
+            marquee_stats.bytes -= m->strip->data_size;
+            lv_draw_buf_destroy(m->strip);
+        }
+        lv_free(m->text);
+        memset(m, 0, sizeof(*m));
+        marquee_stats.active--;
+        break;
+    default:
+        break;
+    }
+}
+
+/******************************************************************************
+ * Marquee
+ *****************************************************************************/
+
+/**
+ * @brief Create a marquee
+ * @param parent Parent object
+ * @return lv_obj_t* Marquee
+ */
+lv_obj_t *MAIN_marquee_create(lv_obj_t *parent)
+{
+    marquee_t *m = marquee_find(NULL);
+    if (m == NULL)
+    {
+        // Out of slots: the label mode this replaces still works
+        Serial.printf("[MARQUEE] WARNING: More than %d marquees, using a scrolling label\n", MARQUEE_MAX);
+        lv_obj_t *label = lv_label_create(parent);
+        lv_label_set_long_mode(label, LV_LABEL_LONG_MODE_SCROLL_CIRCULAR);
+        return label;
+    }
+
+    if (marquee_timer == NULL)
+    {
+        marquee_timer = lv_timer_create(marquee_timer_cb, 1000 / MARQUEE_FPS, NULL);
+    }
+
+    // A bare object: no theme card, only the text styles matter
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_remove_flag(obj, (lv_obj_flag_t)(LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE));
+    lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+
+    memset(m, 0, sizeof(*m));
+    m->obj = obj;
+    m->speed = MARQUEE_SPEED;
+    m->lastTick = lv_tick_get();
+    marquee_stats.active++;
+
+    lv_obj_add_event_cb(obj, marquee_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+    lv_obj_add_event_cb(obj, marquee_event_cb, LV_EVENT_GET_SELF_SIZE, NULL);
+    lv_obj_add_event_cb(obj, marquee_event_cb, LV_EVENT_STYLE_CHANGED, NULL);
+    lv_obj_add_event_cb(obj, marquee_event_cb, LV_EVENT_DELETE, NULL);
+    return obj;
+}
+
+/**
+ * @brief Set the text and render its strip
+ * @param marquee Marquee
+ * @param text Text
+ */
+void MAIN_marquee_set_text(lv_obj_t *marquee, const char *text)
+{
+    marquee_t *m = marquee ? marquee_find(marquee) : NULL;
+    if (m == NULL)
+    {
+        if (marquee != NULL && lv_obj_check_type(marquee, &lv_label_class))
+        {
+            lv_label_set_text(marquee, text);
+        }
+        return;
+    }
+    if (m->text != NULL && text != NULL && strcmp(m->text, text) == 0 && m->strip != NULL)
+    {
+        return;
+    }
+
+    lv_free(m->text);
+    m->text = text ? lv_strdup(text) : NULL;
+    marquee_render(m);
+}
+
+/**
+ * @brief Set the scroll speed
+ * @param marquee Marquee
+ * @param pxPerSec Pixels per second
+ */
+void MAIN_marquee_set_speed(lv_obj_t *marquee, uint16_t pxPerSec)
+{
+    marquee_t *m = marquee ? marquee_find(marquee) : NULL;
+    if (m != NULL)
+    {
+        m->speed = pxPerSec;
+    }
+}
+
+/**
+ * @brief Marquee counters
+ * @param stats Receives the counters
+ */
+void MAIN_marquee_get_stats(MAIN_marquee_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = marquee_stats;
+    }
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Marquee_getLibraryName() {
+    return MAIN_Marquee::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Marquee_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Marquee::VERSION_MAJOR,
+                       MAIN_Marquee::VERSION_MINOR,
+                       MAIN_Marquee::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Marquee_getVersionDate() {
+    return MAIN_Marquee::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Marquee_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Marquee_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_marqueeLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,129 @@
+/**
+ * @file MAIN_marqueeLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Scrolling text drawn from a strip rendered once
+ * @details An lv_label in LV_LABEL_LONG_SCROLL_CIRCULAR mode lays out and
+ *          draws its glyphs again on every animation step, for as long as
+ *          the screen exists, visible or not. A marquee renders its text
+ *          once into an A8 strip (PSRAM, through the image draw-buffer
+ *          handlers) and each step only blits two windows of that strip,
+ *          recoloured with the text colour, at no more than MARQUEE_FPS.
+ *
+ *          One LVGL timer steps every marquee. A marquee whose screen is
+ *          not the active one, or that is hidden or scrolled out of view,
+ *          is not stepped and invalidates nothing. Text that fits is drawn
+ *          still. The strip is rendered again when the text or a text
+ *          style (font, letter spacing) changes.
+ *
+ *          Created in place of a label from the EEZ screens in src/ui, so
+ *          this header stays C. UI task only.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_MARQUEE_LIB_H__
+#define __MAIN_MARQUEE_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <lvgl.h>
+
+#ifdef __cplusplus
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Marquee
+{
+    constexpr const char* LIB_NAME = "MAIN_Marquee";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_Marquee_getLibraryName();
+uint32_t MAIN_Marquee_getVersionEncoded();
+const char* MAIN_Marquee_getVersionDate();
+void MAIN_Marquee_getVersionString(char* buffer);
+
+extern "C" {
+#endif
+
+/******************************************************************************
+ * Marquee Configuration
+ *****************************************************************************/
+
+// Marquees that can exist at once
+#define MARQUEE_MAX 8
+
+// Step rate cap, and the default speed (pixels per second)
+#define MARQUEE_FPS 25
+#define MARQUEE_SPEED 40
+
+// Space between the end of the text and its next repeat
+#define MARQUEE_GAP 40
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint16_t active;            // Marquees that exist
+    uint16_t scrolling;         // Of those, stepped by the last timer run
+    uint32_t steps;             // Steps that invalidated a marquee
+    uint32_t renders;           // Strips rendered
+    uint32_t bytes;             // Strip memory now
+} MAIN_marquee_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Create a marquee
+ * @param parent Parent object
+ * @return lv_obj_t* Marquee (size it like a label); a scrolling lv_label
+ *         once MARQUEE_MAX exist
+ * @note Text styles (font, colour, letter spacing, opacity) apply as on a label.
+ */
+lv_obj_t *MAIN_marquee_create(lv_obj_t *parent);
+
+/**
+ * @brief Set the text (copied) and render its strip
+ * @param marquee Marquee
+ * @param text Text
+ */
+void MAIN_marquee_set_text(lv_obj_t *marquee, const char *text);
+
+/**
+ * @brief Set the scroll speed
+ * @param marquee Marquee
+ * @param pxPerSec Pixels per second (0 stops at the current position)
+ */
+void MAIN_marquee_set_speed(lv_obj_t *marquee, uint16_t pxPerSec);
+
+/**
+ * @brief Marquee counters
+ * @param stats Receives the counters
+ */
+void MAIN_marquee_get_stats(MAIN_marquee_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MAIN_MARQUEE_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_marqueeLib.h
+ ******************************************************************************/
@@ -0,0 +1,339 @@
+/**
+ * @file MAIN_memPlanLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief RAM layout plan: named pools with budgets, checked at boot
+ * @version 1.4.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_memPlanLib.h"
+#include "EARS_systemDef.h"
+#if __has_include(<esp_memory_utils.h>)
+#include <esp_memory_utils.h>
+#else
+#include <soc/soc_memory_layout.h>
+#endif
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t magic;
+    uint8_t pool;
+    uint8_t inPsram;
+    uint16_t pad;
+    uint32_t size;              // Block size, header included
+    uint32_t reserved;
+} mem_plan_header_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+#define MEM_PLAN_MAGIC 0x4D504C4EUL // "MPLN"
+
+static MAIN_mem_pool_stats_t mem_plan_pools[MEM_POOL_COUNT] = {
+    {"frame buffers", MEM_HOME_INTERNAL, MEM_PLAN_FRAME_BUFFERS},
+    {"image cache", MEM_HOME_PSRAM, MEM_PLAN_IMAGE_CACHE},
+    {"glyph cache", MEM_HOME_PSRAM, MEM_PLAN_GLYPH_CACHE},
+    {"snapshots", MEM_HOME_PSRAM, MEM_PLAN_SNAPSHOTS},
+    {"flow heap", MEM_HOME_PSRAM, MEM_PLAN_FLOW_HEAP},
+    {"telemetry", MEM_HOME_PSRAM, MEM_PLAN_TELEMETRY},
+    {"sd cache", MEM_HOME_PSRAM, MEM_PLAN_SD_CACHE},
+    {"layers", MEM_HOME_PSRAM, MEM_PLAN_LAYERS},
+    {"svg cache", MEM_HOME_PSRAM, MEM_PLAN_SVG_CACHE},
+    {"transforms", MEM_HOME_PSRAM, MEM_PLAN_TRANSFORMS},
+    {"chart data", MEM_HOME_PSRAM, MEM_PLAN_CHARTS},
+};
+
+// Free heap when the plan was checked, per MAIN_mem_home_t
+static uint32_t mem_plan_free_at_boot[2] = {0, 0};
+static portMUX_TYPE mem_plan_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/******************************************************************************
+ * Static Functions (internal to library)
+ *****************************************************************************/
+
+/**
+ * @brief Sum of the budgets planned in a heap
+ * @param home Heap
+ * @return uint32_t Bytes
+ */
+static uint32_t mem_plan_budget_total(MAIN_mem_home_t home)
+{
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < MEM_POOL_COUNT; i++)
+    {
+        if (mem_plan_pools[i].home == home)
+        {
+            total += mem_plan_pools[i].budget;
+        }
+    }
+    return total;
+}
+
+/******************************************************************************
+ * Memory Plan
+ *****************************************************************************/
+
+/**
+ * @brief Set the malloc() threshold and check the plan against the heaps
+ * @return true if the plan fits
+ */
+bool MAIN_initialise_mem_plan(void)
+{
+    uint32_t psramFree = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    mem_plan_free_at_boot[MEM_HOME_INTERNAL] = heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    mem_plan_free_at_boot[MEM_HOME_PSRAM] = psramFree;
+
+    if (psramFree > 0)
+    {
+        // Small blocks stay internal, large ones go to PSRAM
+        heap_caps_malloc_extmem_enable(MEM_PLAN_MALLOC_INTERNAL_MAX);
+    }
+    else
+    {
+        Serial.println("[MEMPLAN] WARNING: No PSRAM; PSRAM pools fall back to internal RAM");
+    }
+
+    bool fits = true;
+    for (uint8_t home = MEM_HOME_INTERNAL; home <= MEM_HOME_PSRAM; home++)
+    {
+        if (home == MEM_HOME_PSRAM && psramFree == 0)
+        {
+            continue;
+        }
+        if (MAIN_mem_plan_get_headroom((MAIN_mem_home_t)home) < 0)
+        {
+            Serial.printf("[MEMPLAN] ERROR: %s budgets of %lu KB do not fit in %lu KB free (reserve included)\n",
+                          home == MEM_HOME_PSRAM ? "PSRAM" : "Internal",
+                          (unsigned long)(mem_plan_budget_total((MAIN_mem_home_t)home) / 1024),
+                          (unsigned long)(mem_plan_free_at_boot[home] / 1024));
+            fits = false;
+        }
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[MEMPLAN] Internal %lu KB free, %ld KB headroom; PSRAM %lu KB free, %ld KB headroom\n",
+                  (unsigned long)(mem_plan_free_at_boot[MEM_HOME_INTERNAL] / 1024),
+                  (long)(MAIN_mem_plan_get_headroom(MEM_HOME_INTERNAL) / 1024),
+                  (unsigned long)(psramFree / 1024),
+                  (long)(MAIN_mem_plan_get_headroom(MEM_HOME_PSRAM) / 1024));
+#endif
+    return fits;
+}
+
+/**
+ * @brief Allocate a block for a pool
+ * @param pool Pool
+ * @param size Bytes wanted
+ * @param caps heap_caps capabilities
+ * @return void* Block, or NULL
+ */
+void *MAIN_mem_alloc(MAIN_mem_pool_t pool, size_t size, uint32_t caps)
+{
+    if ((unsigned)pool >= MEM_POOL_COUNT || size == 0)
+    {
+        return NULL;
+    }
+
+    MAIN_mem_pool_stats_t *p = &mem_plan_pools[pool];
+    uint32_t total = (uint32_t)size + MEM_PLAN_HEADER;
+    bool over = false;
+
+    portENTER_CRITICAL(&mem_plan_lock);
+    over = p->used + total > p->budget;
+    if (over)
+    {
+        p->overBudget++;
+    }
+    bool warn = over && p->overBudget == 1;
+    portEXIT_CRITICAL(&mem_plan_lock);
+
+    if (warn)
+    {
+        Serial.printf("[MEMPLAN] WARNING: %s past its %lu KB budget\n", p->name, (unsigned long)(p->budget / 1024));
+    }
+#if MEM_PLAN_ENFORCE == 1
+    if (over)
+    {
+        return NULL;
+    }
+#endif
+
+    mem_plan_header_t *header = (mem_plan_header_t *)heap_caps_malloc(total, caps);
+    if (header == NULL)
+    {
+        portENTER_CRITICAL(&mem_plan_lock);
+        p->failures++;
+        portEXIT_CRITICAL(&mem_plan_lock);
+        return NULL;
+    }
+
+    header->magic = MEM_PLAN_MAGIC;
+    header->pool = (uint8_t)pool;
+    header->inPsram = esp_ptr_external_ram(header) ? 1 : 0;
+    header->size = total;
+
+    portENTER_CRITICAL(&mem_plan_lock);
+    p->used += total;
+    p->blocks++;
+    if (header->inPsram)
+    {
+        p->usedPsram += total;
+    }
+    if (p->used > p->peak)
+    {
+        p->peak = p->used;
+    }
+    portEXIT_CRITICAL(&mem_plan_lock);
+
+    return (uint8_t *)header + MEM_PLAN_HEADER;
+}
+
+/**
+ * @brief Allocate a zeroed array for a pool
+ * @param pool Pool
+ * @param count Elements
+ * @param size Element size
+ * @param caps heap_caps capabilities
+ * @return void* Block, or NULL
+ */
+void *MAIN_mem_calloc(MAIN_mem_pool_t pool, size_t count, size_t size, uint32_t caps)
+{
+    if (size != 0 && count > SIZE_MAX / size)
+    {
+        return NULL;
+    }
+
+    void *ptr = MAIN_mem_alloc(pool, count * size, caps);
+    if (ptr != NULL)
+    {
+        memset(ptr, 0, count * size);
+    }
+    return ptr;
+}
+
+/**
+ * @brief Free a block
+ * @param ptr Block, or NULL
+ */
+void MAIN_mem_free(void *ptr)
+{
+    if (ptr == NULL)
+    {
+        return;
+    }
+
+    mem_plan_header_t *header = (mem_plan_header_t *)((uint8_t *)ptr - MEM_PLAN_HEADER);
+    if (header->magic != MEM_PLAN_MAGIC || header->pool >= MEM_POOL_COUNT)
+    {
+        Serial.println("[MEMPLAN] ERROR: Free of a block not from MAIN_mem_alloc()");
+        return;
+    }
+
+    MAIN_mem_pool_stats_t *p = &mem_plan_pools[header->pool];
+    portENTER_CRITICAL(&mem_plan_lock);
+    p->used -= header->size;
+    p->blocks--;
+    if (header->inPsram)
+    {
+        p->usedPsram -= header->size;
+    }
+    portEXIT_CRITICAL(&mem_plan_lock);
+
+    header->magic = 0;
+    heap_caps_free(header);
+}
+
+/**
+ * @brief Figures of one pool
+ * @param pool Pool
+ * @param stats Receives the figures
+ */
+void MAIN_mem_plan_get_pool(MAIN_mem_pool_t pool, MAIN_mem_pool_stats_t *stats)
+{
+    if ((unsigned)pool >= MEM_POOL_COUNT || stats == NULL)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&mem_plan_lock);
+    *stats = mem_plan_pools[pool];
+    portEXIT_CRITICAL(&mem_plan_lock);
+}
+
+/**
+ * @brief Heap left once every pool has its full budget
+ * @param home Heap
+ * @return int32_t Bytes, negative when the plan does not fit
+ */
+int32_t MAIN_mem_plan_get_headroom(MAIN_mem_home_t home)
+{
+    uint32_t reserve = home == MEM_HOME_PSRAM ? MEM_PLAN_PSRAM_RESERVE : MEM_PLAN_INTERNAL_RESERVE;
+    return (int32_t)mem_plan_free_at_boot[home] - (int32_t)reserve - (int32_t)mem_plan_budget_total(home);
+}
+
+/**
+ * @brief Print the plan
+ */
+void MAIN_mem_plan_print_report(void)
+{
+    Serial.println("[MEMPLAN] Pool            Heap      Budget KB  Used KB  Peak KB  In PSRAM  Over");
+    for (uint8_t i = 0; i < MEM_POOL_COUNT; i++)
+    {
+        MAIN_mem_pool_stats_t p;
+        MAIN_mem_plan_get_pool((MAIN_mem_pool_t)i, &p);
+        Serial.printf("[MEMPLAN] %-15s %-8s %10lu %8lu %8lu %8lu%% %5lu\n", p.name,
+                      p.home == MEM_HOME_PSRAM ? "PSRAM" : "internal", (unsigned long)(p.budget / 1024),
+                      (unsigned long)(p.used / 1024), (unsigned long)(p.peak / 1024),
+                      (unsigned long)(p.used ? (uint64_t)p.usedPsram * 100 / p.used : 0),
+                      (unsigned long)p.overBudget);
+    }
+
+    Serial.printf("[MEMPLAN] Internal: %lu KB free now, %ld KB planned headroom\n",
+                  (unsigned long)(heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT) / 1024),
+                  (long)(MAIN_mem_plan_get_headroom(MEM_HOME_INTERNAL) / 1024));
+    Serial.printf("[MEMPLAN] PSRAM:    %lu KB free now, %ld KB planned headroom\n",
+                  (unsigned long)(heap_caps_get_free_size(MALLOC_CAP_SPIRAM) / 1024),
+                  (long)(MAIN_mem_plan_get_headroom(MEM_HOME_PSRAM) / 1024));
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_MemPlan_getLibraryName() {
+    return MAIN_MemPlan::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_MemPlan_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_MemPlan::VERSION_MAJOR,
+                       MAIN_MemPlan::VERSION_MINOR,
+                       MAIN_MemPlan::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_MemPlan_getVersionDate() {
+    return MAIN_MemPlan::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_MemPlan_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_MemPlan_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_memPlanLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,194 @@
+/**
+ * @file MAIN_memPlanLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief RAM layout plan: named pools with budgets, checked at boot
+ * @details The large buffers (draw buffers, image and glyph caches,
+ *          transition snapshots, the flow heap, the telemetry ring, SD read
+ *          caches, LVGL's layer buffers, SVG bitmaps, transformed
+ *          image variants, chart series rings) are allocated through
+ *          MAIN_mem_alloc() against a named pool. Each pool has a home heap
+ *          and a budget; the budgets are summed per heap at boot and
+ *          compared with what the heap holds, so a plan that cannot fit
+ *          shows before anything is allocated, and
+ *          MAIN_mem_plan_print_report() shows use and headroom per pool.
+ *
+ *          Callers keep their own placement (PSRAM first, internal as a
+ *          fallback, or the reverse); the pool records where each block
+ *          landed. A block carries a MEM_PLAN_HEADER byte header so it can
+ *          be freed without its size; free it with MAIN_mem_free() only.
+ *
+ *          PSRAM itself is enabled by the board settings (platformio.ini
+ *          board_build.arduino.memory_type and BOARD_HAS_PSRAM). The
+ *          framework's CONFIG_SPIRAM_MALLOC_ALWAYSINTERNAL is fixed in its
+ *          prebuilt libraries, so MAIN_initialise_mem_plan() sets the same
+ *          malloc() threshold at run time (heap_caps_malloc_extmem_enable).
+ *
+ *          Allocations made inside the EARS_ libraries and LVGL's heap
+ *          are not pools here; they show in the heap totals.
+ * @version 1.4.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_MEM_PLAN_LIB_H__
+#define __MAIN_MEM_PLAN_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include <esp_heap_caps.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_MemPlan
+{
+    constexpr const char* LIB_NAME = "MAIN_MemPlan";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "4";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_MemPlan_getLibraryName();
+uint32_t MAIN_MemPlan_getVersionEncoded();
+const char* MAIN_MemPlan_getVersionDate();
+void MAIN_MemPlan_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Memory Plan Configuration
+ *****************************************************************************/
+
+// malloc()/new of this many bytes or more go to PSRAM
+#define MEM_PLAN_MALLOC_INTERNAL_MAX 4096
+
+// Heap kept out of every plan: internal for Wi-Fi, tasks and LVGL's objects,
+// PSRAM for the EARS_ libraries' buffers and LVGL's large blocks
+#define MEM_PLAN_INTERNAL_RESERVE (96 * 1024U)
+#define MEM_PLAN_PSRAM_RESERVE (512 * 1024U)
+
+// Pool budgets (bytes). Each covers the named library setting.
+#define MEM_PLAN_FRAME_BUFFERS (120 * 1024U)     // MAIN_lvglLib: 2 x LVGL_BUFFER_LINES lines
+#define MEM_PLAN_IMAGE_CACHE (2112 * 1024U)      // MAIN_imageCacheLib: IMAGE_CACHE_SIZE_BYTES + alignment
+#define MEM_PLAN_GLYPH_CACHE (288 * 1024U)       // MAIN_glyphCacheLib: GLYPH_CACHE_BYTES + slots
+#define MEM_PLAN_SNAPSHOTS (640 * 1024U)         // MAIN_transitionLib: two full-screen RGB565
+#define MEM_PLAN_FLOW_HEAP (68 * 1024U)          // MAIN_flowHeapLib: FLOW_HEAP_SIZE
+#define MEM_PLAN_TELEMETRY (328 * 1024U)         // MAIN_telemetryLib: ring + SD block
+#define MEM_PLAN_SD_CACHE (4 * 32 * 1024U)       // MAIN_sdFsLib: four open files
+#define MEM_PLAN_LAYERS (1200 * 1024U)           // MAIN_lvglMemLib: LV_DRAW_LAYER_MAX_MEMORY
+#define MEM_PLAN_SVG_CACHE (264 * 1024U)         // MAIN_svgCacheLib: SVG_CACHE_BYTES + headers
+#define MEM_PLAN_TRANSFORMS (770 * 1024U)        // MAIN_transformCacheLib: TRANSFORM_CACHE_BYTES + headers
+#define MEM_PLAN_CHARTS (136 * 1024U)            // MAIN_chartDataLib: CHART_DATA_MAX rings of CHART_DATA_MAX_SAMPLES
+
+// 1 = refuse an allocation past its pool budget, 0 = count and warn once
+#define MEM_PLAN_ENFORCE 0
+
+// Bytes in front of each block (keeps 16-byte alignment)
+#define MEM_PLAN_HEADER 16
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef enum
+{
+    MEM_POOL_FRAME_BUFFERS = 0,
+    MEM_POOL_IMAGE_CACHE,
+    MEM_POOL_GLYPH_CACHE,
+    MEM_POOL_SNAPSHOTS,
+    MEM_POOL_FLOW_HEAP,
+    MEM_POOL_TELEMETRY,
+    MEM_POOL_SD_CACHE,
+    MEM_POOL_LAYERS,
+    MEM_POOL_SVG_CACHE,
+    MEM_POOL_TRANSFORMS,
+    MEM_POOL_CHARTS,
+    MEM_POOL_COUNT
+} MAIN_mem_pool_t;
+
+typedef enum
+{
+    MEM_HOME_INTERNAL = 0,  // Internal SRAM (DMA capable where asked)
+    MEM_HOME_PSRAM
+} MAIN_mem_home_t;
+
+typedef struct
+{
+    const char *name;
+    MAIN_mem_home_t home;       // Heap the budget is planned in
+    uint32_t budget;            // Bytes
+    uint32_t used;              // Bytes now, headers included
+    uint32_t peak;
+    uint32_t usedPsram;         // Of used, the bytes that landed in PSRAM
+    uint32_t blocks;            // Blocks now
+    uint32_t failures;          // Allocations the heap refused
+    uint32_t overBudget;        // Allocations that went past the budget
+} MAIN_mem_pool_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Set the malloc() threshold and check the plan against the heaps
+ * @return true if every heap's budgets fit with its reserve
+ * @note First thing in setup(), before any pool allocation.
+ */
+bool MAIN_initialise_mem_plan(void);
+
+/**
+ * @brief Allocate a block for a pool
+ * @param pool Pool the block counts against
+ * @param size Bytes wanted
+ * @param caps heap_caps capabilities (the caller's placement)
+ * @return void* Block, or NULL
+ * @note Any task.
+ */
+void *MAIN_mem_alloc(MAIN_mem_pool_t pool, size_t size, uint32_t caps);
+
+/**
+ * @brief Allocate a zeroed array for a pool
+ * @param pool Pool the block counts against
+ * @param count Elements
+ * @param size Element size
+ * @param caps heap_caps capabilities
+ * @return void* Block, or NULL
+ */
+void *MAIN_mem_calloc(MAIN_mem_pool_t pool, size_t count, size_t size, uint32_t caps);
+
+/**
+ * @brief Free a block from MAIN_mem_alloc() or MAIN_mem_calloc()
+ * @param ptr Block (NULL is ignored)
+ */
+void MAIN_mem_free(void *ptr);
+
+/**
+ * @brief Figures of one pool
+ * @param pool Pool
+ * @param stats Receives the figures
+ */
+void MAIN_mem_plan_get_pool(MAIN_mem_pool_t pool, MAIN_mem_pool_stats_t *stats);
+
+/**
+ * @brief Heap left over once every pool has its full budget
+ * @param home Heap
+ * @return int32_t Bytes (negative when the plan does not fit)
+ */
+int32_t MAIN_mem_plan_get_headroom(MAIN_mem_home_t home);
+
+/**
+ * @brief Print the plan: budget, use, peak and headroom per pool and heap
+ */
+void MAIN_mem_plan_print_report(void);
+
+#endif // __MAIN_MEM_PLAN_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_memPlanLib.h
+ ******************************************************************************/
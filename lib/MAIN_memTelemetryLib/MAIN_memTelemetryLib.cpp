@@ -0,0 +1,334 @@
+/**
+ * @file MAIN_memTelemetryLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Heap fragmentation and allocation-rate monitor
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_memTelemetryLib.h"
+#include "EARS_systemDef.h"
+#include "MAIN_flowHeapLib.h"
+#include "MAIN_jobSchedulerLib.h"
+#include "MAIN_uiCommandLib.h"
+#include <esp_heap_caps.h>
+#include <sdkconfig.h>
+#include <lvgl.h>
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static const uint32_t mem_region_caps[MEM_REGION_COUNT] = {
+    MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT,
+    MALLOC_CAP_DMA,
+    MALLOC_CAP_SPIRAM,
+};
+
+static const uint32_t mem_region_warn[MEM_REGION_COUNT] = {
+    MEM_TELEMETRY_WARN_INTERNAL_BLOCK,
+    MEM_TELEMETRY_WARN_DMA_BLOCK,
+    MEM_TELEMETRY_WARN_PSRAM_BLOCK,
+};
+
+static const char *const mem_region_names[MEM_REGION_COUNT] = {"Internal", "DMA", "PSRAM"};
+
+static portMUX_TYPE mem_telemetry_lock = portMUX_INITIALIZER_UNLOCKED;
+static MAIN_mem_stats_t mem_stats;
+static bool mem_ui_capture_queued = false;
+
+// Rate baselines (sampler only)
+static uint32_t mem_rate_ms = 0;
+static uint32_t mem_rate_allocs = 0;
+static uint32_t mem_rate_frees = 0;
+static uint32_t mem_rate_bytes = 0;
+static uint32_t mem_flow_rate_ms = 0; // UI task only
+static uint32_t mem_flow_rate_allocs = 0;
+static uint32_t mem_report_ms = 0;
+
+/******************************************************************************
+ * Heap Hooks (CONFIG_HEAP_USE_HOOKS builds)
+ *****************************************************************************/
+
+#if defined(CONFIG_HEAP_USE_HOOKS)
+static uint32_t mem_hook_allocs = 0;
+static uint32_t mem_hook_frees = 0;
+static uint32_t mem_hook_bytes = 0;
+
+// Called by heap_caps for every allocation, from any task or ISR
+extern "C" void IRAM_ATTR esp_heap_trace_alloc_hook(void *ptr, size_t size, uint32_t caps)
+{
+    __atomic_fetch_add(&mem_hook_allocs, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&mem_hook_bytes, (uint32_t)size, __ATOMIC_RELAXED);
+}
+
+extern "C" void IRAM_ATTR esp_heap_trace_free_hook(void *ptr)
+{
+    __atomic_fetch_add(&mem_hook_frees, 1, __ATOMIC_RELAXED);
+}
+#endif
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Capture the LVGL pool and flow heap (runs in the UI task)
+ * @param ctx Unused
+ * @param param Unused
+ */
+static void mem_telemetry_capture_ui(void *ctx, uint32_t param)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+
+    uint32_t flowFree = 0;
+    uint32_t flowAllocated = 0;
+    MAIN_flow_heap_get_info(&flowFree, &flowAllocated);
+
+    MAIN_flow_heap_stats_t flow;
+    MAIN_flow_heap_get_stats(&flow);
+    uint32_t flowAllocs = flow.largeAllocs;
+    for (uint8_t i = 0; i < FLOW_HEAP_CLASS_COUNT; i++)
+    {
+        flowAllocs += flow.classes[i].allocs;
+    }
+
+    uint32_t now = millis();
+    float flowRate = 0.0f;
+    if (mem_flow_rate_ms != 0 && now != mem_flow_rate_ms)
+    {
+        flowRate = (float)(flowAllocs - mem_flow_rate_allocs) * 1000.0f / (now - mem_flow_rate_ms);
+    }
+    mem_flow_rate_ms = now;
+    mem_flow_rate_allocs = flowAllocs;
+
+    portENTER_CRITICAL(&mem_telemetry_lock);
+    mem_stats.lvglTotal = mon.total_size;
+    mem_stats.lvglFree = mon.free_size;
+    mem_stats.lvglLargest = mon.free_biggest_size;
+    mem_stats.lvglMaxUsed = mon.max_used;
+    mem_stats.lvglFragPercent = mon.frag_pct;
+    mem_stats.flowFree = flowFree;
+    mem_stats.flowAllocated = flowAllocated;
+    mem_stats.flowAllocsPerSec = flowRate;
+    mem_stats.uiCaptureMs = (now != 0) ? now : 1;
+    mem_ui_capture_queued = false;
+    portEXIT_CRITICAL(&mem_telemetry_lock);
+}
+
+/**
+ * @brief Sampling job for the Core 1 scheduler
+ * @param ctx Unused
+ */
+static void mem_telemetry_job(void *ctx)
+{
+    MAIN_mem_telemetry_sample();
+
+#if EARS_DEBUG == 1
+    if (millis() - mem_report_ms >= MEM_TELEMETRY_REPORT_MS)
+    {
+        mem_report_ms = millis();
+        MAIN_mem_telemetry_print_report();
+    }
+#endif
+}
+
+/******************************************************************************
+ * Memory Telemetry
+ *****************************************************************************/
+
+/**
+ * @brief Take a first sample and register the sampling job
+ * @return true if the job was registered
+ */
+bool MAIN_initialise_mem_telemetry(void)
+{
+    MAIN_mem_telemetry_sample();
+    mem_report_ms = millis();
+
+    return MAIN_job_add("memtelemetry", mem_telemetry_job, NULL, MEM_TELEMETRY_PERIOD_MS, MEM_TELEMETRY_PERIOD_MS,
+                        JOB_PRIORITY_LOW, 0) != JOB_INVALID;
+}
+
+/**
+ * @brief Sample the heaps now and queue a UI capture
+ */
+void MAIN_mem_telemetry_sample(void)
+{
+    MAIN_mem_region_stats_t regions[MEM_REGION_COUNT];
+
+    for (uint8_t i = 0; i < MEM_REGION_COUNT; i++)
+    {
+        MAIN_mem_region_stats_t *r = &regions[i];
+        r->totalBytes = heap_caps_get_total_size(mem_region_caps[i]);
+        r->freeBytes = heap_caps_get_free_size(mem_region_caps[i]);
+        r->largestBlock = heap_caps_get_largest_free_block(mem_region_caps[i]);
+        r->minFreeBytes = heap_caps_get_minimum_free_size(mem_region_caps[i]);
+        r->fragPercent = (r->freeBytes > 0) ? (uint8_t)(100 - (uint64_t)r->largestBlock * 100 / r->freeBytes) : 0;
+        r->lowBlock = (r->totalBytes > 0 && mem_region_warn[i] > 0 && r->largestBlock < mem_region_warn[i]);
+    }
+
+    uint32_t now = millis();
+    bool queueCapture = false;
+
+    portENTER_CRITICAL(&mem_telemetry_lock);
+    for (uint8_t i = 0; i < MEM_REGION_COUNT; i++)
+    {
+        uint32_t minLargest = mem_stats.regions[i].minLargestBlock;
+        bool wasLow = mem_stats.regions[i].lowBlock;
+        mem_stats.regions[i] = regions[i];
+        mem_stats.regions[i].minLargestBlock =
+            (mem_stats.samples == 0 || regions[i].largestBlock < minLargest) ? regions[i].largestBlock : minLargest;
+
+        // Remember the edge for the warning below
+        regions[i].lowBlock = regions[i].lowBlock && !wasLow;
+    }
+
+#if defined(CONFIG_HEAP_USE_HOOKS)
+    uint32_t allocs = __atomic_load_n(&mem_hook_allocs, __ATOMIC_RELAXED);
+    uint32_t frees = __atomic_load_n(&mem_hook_frees, __ATOMIC_RELAXED);
+    uint32_t bytes = __atomic_load_n(&mem_hook_bytes, __ATOMIC_RELAXED);
+    mem_stats.heapHooks = true;
+    if (mem_rate_ms != 0 && now != mem_rate_ms)
+    {
+        float seconds = (now - mem_rate_ms) / 1000.0f;
+        mem_stats.allocsPerSec = (allocs - mem_rate_allocs) / seconds;
+        mem_stats.freesPerSec = (frees - mem_rate_frees) / seconds;
+        mem_stats.allocBytesPerSec = (bytes - mem_rate_bytes) / seconds;
+    }
+    mem_rate_allocs = allocs;
+    mem_rate_frees = frees;
+    mem_rate_bytes = bytes;
+#endif
+    mem_rate_ms = now;
+
+    mem_stats.samples++;
+    mem_stats.sampleMs = now;
+
+    // One capture in flight at a time
+    if (!mem_ui_capture_queued)
+    {
+        mem_ui_capture_queued = true;
+        queueCapture = true;
+    }
+    portEXIT_CRITICAL(&mem_telemetry_lock);
+
+    if (queueCapture && !MAIN_ui_cmd_call(mem_telemetry_capture_ui, NULL, 0))
+    {
+        portENTER_CRITICAL(&mem_telemetry_lock);
+        mem_ui_capture_queued = false;
+        portEXIT_CRITICAL(&mem_telemetry_lock);
+    }
+
+#if EARS_DEBUG == 1
+    for (uint8_t i = 0; i < MEM_REGION_COUNT; i++)
+    {
+        if (regions[i].lowBlock)
+        {
+            DEBUG_PRINTF("[MEMTEL] WARNING: %s largest free block %lu B (%u%% fragmented)\n", mem_region_names[i],
+                         (unsigned long)regions[i].largestBlock, regions[i].fragPercent);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Latest figures
+ * @param stats Receives a copy
+ */
+void MAIN_mem_telemetry_get_stats(MAIN_mem_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&mem_telemetry_lock);
+    *stats = mem_stats;
+    portEXIT_CRITICAL(&mem_telemetry_lock);
+}
+
+/**
+ * @brief Check whether a block would fit right now
+ * @param size Bytes
+ * @param caps MALLOC_CAP_* flags
+ * @return true if the largest free block with those caps is big enough
+ */
+bool MAIN_mem_can_allocate(size_t size, uint32_t caps)
+{
+    return heap_caps_get_largest_free_block(caps) >= size;
+}
+
+/**
+ * @brief Print the latest figures to Serial
+ */
+void MAIN_mem_telemetry_print_report(void)
+{
+    MAIN_mem_stats_t stats;
+    MAIN_mem_telemetry_get_stats(&stats);
+
+    for (uint8_t i = 0; i < MEM_REGION_COUNT; i++)
+    {
+        const MAIN_mem_region_stats_t *r = &stats.regions[i];
+        if (r->totalBytes == 0)
+        {
+            continue;
+        }
+        DEBUG_PRINTF("[MEMTEL] %-8s free %lu B (min %lu), largest %lu B (min %lu), %u%% fragmented\n",
+                     mem_region_names[i], (unsigned long)r->freeBytes, (unsigned long)r->minFreeBytes,
+                     (unsigned long)r->largestBlock, (unsigned long)r->minLargestBlock, r->fragPercent);
+    }
+
+    if (stats.uiCaptureMs != 0)
+    {
+        DEBUG_PRINTF("[MEMTEL] LVGL     free %lu / %lu B, largest %lu B, peak used %lu B, %u%% fragmented\n",
+                     (unsigned long)stats.lvglFree, (unsigned long)stats.lvglTotal, (unsigned long)stats.lvglLargest,
+                     (unsigned long)stats.lvglMaxUsed, stats.lvglFragPercent);
+        DEBUG_PRINTF("[MEMTEL] Flow     free %lu B, allocated %lu B, %.1f allocs/s\n", (unsigned long)stats.flowFree,
+                     (unsigned long)stats.flowAllocated, stats.flowAllocsPerSec);
+    }
+
+    if (stats.heapHooks)
+    {
+        DEBUG_PRINTF("[MEMTEL] Heap     %.1f allocs/s, %.1f frees/s, %.0f B/s\n", stats.allocsPerSec, stats.freesPerSec,
+                     stats.allocBytesPerSec);
+    }
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_MemTelemetry_getLibraryName() {
+    return MAIN_MemTelemetry::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_MemTelemetry_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_MemTelemetry::VERSION_MAJOR,
+                       MAIN_MemTelemetry::VERSION_MINOR,
+                       MAIN_MemTelemetry::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_MemTelemetry_getVersionDate() {
+    return MAIN_MemTelemetry::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_MemTelemetry_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_MemTelemetry_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_memTelemetryLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,157 @@
+/**
+ * @file MAIN_memTelemetryLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Heap fragmentation and allocation-rate monitor
+ * @details A Core 1 job samples free size, largest free block and low-water
+ *          mark of internal RAM, DMA-capable RAM and PSRAM every
+ *          MEM_TELEMETRY_PERIOD_MS, and keeps the smallest largest block seen,
+ *          so slow fragmentation on long-running units shows before a draw
+ *          buffer or image allocation fails.
+ *
+ *          The LVGL pool (lv_mem_monitor) and the EEZ Flow heap (the figures
+ *          behind eez::getAllocInfo) are not thread safe, so each sample asks
+ *          the UI task to capture them through MAIN_uiCommandLib; they lag the
+ *          heap figures by up to one UI frame.
+ *
+ *          When the framework is built with CONFIG_HEAP_USE_HOOKS the heap
+ *          allocation hooks count allocations and frees, giving system-wide
+ *          allocation rates; the flow heap's own counters give its rate in
+ *          every build.
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_MEM_TELEMETRY_LIB_H__
+#define __MAIN_MEM_TELEMETRY_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_MemTelemetry
+{
+    constexpr const char* LIB_NAME = "MAIN_MemTelemetry";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-14";
+}
+
+
+// Version information getters
+const char* MAIN_MemTelemetry_getLibraryName();
+uint32_t MAIN_MemTelemetry_getVersionEncoded();
+const char* MAIN_MemTelemetry_getVersionDate();
+void MAIN_MemTelemetry_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Memory Telemetry Configuration
+ *****************************************************************************/
+
+// Sampling job period, and the Serial report interval in debug builds
+#define MEM_TELEMETRY_PERIOD_MS 5000
+#define MEM_TELEMETRY_REPORT_MS 60000
+
+// Warn once a region's largest free block falls below these (0 = never)
+#define MEM_TELEMETRY_WARN_INTERNAL_BLOCK (16 * 1024U)
+#define MEM_TELEMETRY_WARN_DMA_BLOCK (16 * 1024U)
+#define MEM_TELEMETRY_WARN_PSRAM_BLOCK (320 * 1024U) // One full-screen RGB565 image
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef enum
+{
+    MEM_REGION_INTERNAL = 0, // MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT
+    MEM_REGION_DMA,          // MALLOC_CAP_DMA
+    MEM_REGION_PSRAM,        // MALLOC_CAP_SPIRAM
+    MEM_REGION_COUNT
+} MAIN_mem_region_t;
+
+typedef struct
+{
+    uint32_t totalBytes;      // Region size
+    uint32_t freeBytes;       // Free now
+    uint32_t largestBlock;    // Largest free block now
+    uint32_t minFreeBytes;    // Lowest free since boot (heap_caps)
+    uint32_t minLargestBlock; // Smallest largest block seen by the sampler
+    uint8_t fragPercent;      // 100 - largest block * 100 / free
+    bool lowBlock;            // Largest block under its warning threshold
+} MAIN_mem_region_stats_t;
+
+typedef struct
+{
+    MAIN_mem_region_stats_t regions[MEM_REGION_COUNT];
+
+    // LVGL pool, captured in the UI task
+    uint32_t lvglTotal;
+    uint32_t lvglFree;
+    uint32_t lvglLargest;
+    uint32_t lvglMaxUsed;
+    uint8_t lvglFragPercent;
+
+    // EEZ Flow heap, captured in the UI task
+    uint32_t flowFree;
+    uint32_t flowAllocated;
+    float flowAllocsPerSec;
+
+    // System-wide rates (heap hooks builds only)
+    bool heapHooks;
+    float allocsPerSec;
+    float freesPerSec;
+    float allocBytesPerSec;
+
+    uint32_t samples;     // Samples taken
+    uint32_t sampleMs;    // millis() of the latest sample
+    uint32_t uiCaptureMs; // millis() of the latest UI capture (0 = none yet)
+} MAIN_mem_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Take a first sample and register the sampling job
+ * @return true if the job was registered
+ */
+bool MAIN_initialise_mem_telemetry(void);
+
+/**
+ * @brief Sample the heaps now and queue a UI capture
+ * @note Any task; the job calls it every MEM_TELEMETRY_PERIOD_MS.
+ */
+void MAIN_mem_telemetry_sample(void);
+
+/**
+ * @brief Latest figures
+ * @param stats Receives a copy
+ */
+void MAIN_mem_telemetry_get_stats(MAIN_mem_stats_t *stats);
+
+/**
+ * @brief Check whether a block would fit right now
+ * @param size Bytes
+ * @param caps MALLOC_CAP_* flags
+ * @return true if the largest free block with those caps is big enough
+ */
+bool MAIN_mem_can_allocate(size_t size, uint32_t caps);
+
+/**
+ * @brief Print the latest figures to Serial
+ */
+void MAIN_mem_telemetry_print_report(void);
+
+#endif // __MAIN_MEM_TELEMETRY_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_memTelemetryLib.h
+ ******************************************************************************/
@@ -0,0 +1,795 @@
+/**
+ * @file MAIN_mirrorLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Live screen mirror over Wi-Fi, streamed from the flush path
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_mirrorLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_configLib.h"
+#include "MAIN_consoleLib.h"
+#include "MAIN_lvglLib.h"
+#include "MAIN_rtosStaticLib.h"
+#include "MAIN_uiCommandLib.h"
+#include <WiFi.h>
+#include <freertos/ringbuf.h>
+#include <mbedtls/md.h>
+#include <mbedtls/base64.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+static_assert(sizeof(MAIN_mirror_rect_t) == 12, "MAIN_mirror_rect_t is a wire format");
+static_assert(sizeof(MAIN_mirror_touch_t) == 6, "MAIN_mirror_touch_t is a wire format");
+
+// WebSocket opcodes (RFC 6455)
+#define WS_OP_TEXT 0x1
+#define WS_OP_BINARY 0x2
+#define WS_OP_CLOSE 0x8
+#define WS_OP_PING 0x9
+#define WS_OP_PONG 0xA
+#define WS_GUID "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+// Remote touch, packed in one word so the indev read sees it whole
+#define MIRROR_TOUCH_VALID (1U << 31)
+#define MIRROR_TOUCH_PRESSED (1U << 30)
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+MAIN_STATIC_TASK(mirror_task, MIRROR_TASK_STACK_SIZE);
+static TaskHandle_t mirror_task_handle = NULL;
+
+static WiFiServer mirror_server(MIRROR_PORT);
+static bool mirror_listening = false; // Mirror task
+
+static volatile bool mirror_enabled = false;
+static volatile bool mirror_connected = false;
+static volatile bool mirror_resync = false;
+
+// Encoded areas: flush tap (LVGL task) to the mirror task
+static RingbufHandle_t mirror_ring = NULL;
+static StaticRingbuffer_t mirror_ring_buffer;
+static uint8_t *mirror_message = NULL; // LVGL task
+static bool mirror_tapped = false;     // LVGL task
+
+// Remote touch: written by the mirror task, read by the indev
+static lv_indev_t *mirror_indev = NULL;
+static lv_indev_read_cb_t mirror_read_cb = NULL;
+static volatile uint32_t mirror_touch_word = 0;
+static volatile uint32_t mirror_touch_ms = 0;
+
+static MAIN_mirror_stats_t mirror_stats = {};
+
+/******************************************************************************
+ * Static Functions - Flush Tap (LVGL task)
+ *****************************************************************************/
+
+/**
+ * @brief Run-length encode one row
+ * @return Bytes written, at most width * 2 + 2
+ */
+static uint32_t mirror_encode_row(uint8_t *out, const uint16_t *src, uint32_t width)
+{
+    uint16_t *dst = (uint16_t *)out;
+    uint32_t n = 0;
+    uint32_t i = 0;
+
+    while (i < width)
+    {
+        uint32_t run = 1;
+        while (i + run < width && src[i + run] == src[i] && run < 0x8000)
+        {
+            run++;
+        }
+        if (run >= 3)
+        {
+            dst[n++] = (uint16_t)(0x8000 | (run - 1));
+            dst[n++] = src[i];
+            i += run;
+            continue;
+        }
+
+        // Literals up to the next run of three
+        uint32_t start = i;
+        while (i < width && i - start < 0x8000 &&
+               !(i + 2 < width && src[i] == src[i + 1] && src[i] == src[i + 2]))
+        {
+            i++;
+        }
+        dst[n++] = (uint16_t)(i - start - 1);
+        memcpy(&dst[n], &src[start], (i - start) * 2);
+        n += i - start;
+    }
+    return n * 2;
+}
+
+/**
+ * @brief Queue one message without waiting; a full ring drops it
+ */
+static void mirror_queue(uint32_t length)
+{
+    if (xRingbufferSend(mirror_ring, mirror_message, length, 0) == pdTRUE)
+    {
+        mirror_stats.rects++;
+    }
+    else
+    {
+        mirror_stats.dropped++;
+        mirror_resync = true;
+    }
+}
+
+/**
+ * @brief Flush tap: encode the area, split into messages of whole rows
+ */
+static void mirror_tap(const lv_area_t *area, const uint8_t *pixels, uint32_t stridePx, bool last)
+{
+    int64_t start = esp_timer_get_time();
+    uint32_t width = lv_area_get_width(area);
+    uint32_t rowWorst = width * 2 + 2;
+    if (sizeof(MAIN_mirror_rect_t) + rowWorst > MIRROR_MESSAGE_BYTES)
+    {
+        return;
+    }
+
+    int32_t y = area->y1;
+    while (y <= area->y2)
+    {
+        int32_t top = y;
+        uint32_t length = sizeof(MAIN_mirror_rect_t);
+        while (y <= area->y2 && length + rowWorst <= MIRROR_MESSAGE_BYTES)
+        {
+            const uint16_t *row = (const uint16_t *)pixels + (y - area->y1) * stridePx;
+            length += mirror_encode_row(mirror_message + length, row, width);
+            y++;
+        }
+
+        MAIN_mirror_rect_t *rect = (MAIN_mirror_rect_t *)mirror_message;
+        rect->x = (uint16_t)area->x1;
+        rect->y = (uint16_t)top;
+        rect->w = (uint16_t)width;
+        rect->h = (uint16_t)(y - top);
+        rect->flags = (last && y > area->y2) ? MIRROR_RECT_FRAME_END : 0;
+        memset(rect->reserved, 0, sizeof(rect->reserved));
+        mirror_queue(length);
+    }
+
+    mirror_stats.rawBytes += width * lv_area_get_height(area) * 2;
+    mirror_stats.encodeUs += (uint32_t)(esp_timer_get_time() - start);
+}
+
+/**
+ * @brief UI task: install the tap if needed and redraw the whole screen
+ */
+static void mirror_keyframe(void *ctx, uint32_t param)
+{
+    (void)ctx;
+    (void)param;
+    if (!mirror_connected)
+    {
+        return;
+    }
+    if (!mirror_tapped)
+    {
+        mirror_tapped = MAIN_lvgl_add_flush_tap(mirror_tap);
+    }
+    if (mirror_tapped)
+    {
+        lv_obj_invalidate(lv_screen_active());
+    }
+    else
+    {
+        mirror_resync = true; // Both taps taken (a screenshot): try again
+    }
+}
+
+/**
+ * @brief UI task: remove the tap
+ */
+static void mirror_detach(void *ctx, uint32_t param)
+{
+    (void)ctx;
+    (void)param;
+    if (mirror_tapped)
+    {
+        MAIN_lvgl_remove_flush_tap(mirror_tap);
+        mirror_tapped = false;
+    }
+}
+
+/**
+ * @brief Indev read: the panel, or a remote touch while the panel is released
+ */
+static void mirror_read(lv_indev_t *indev, lv_indev_data_t *data)
+{
+    mirror_read_cb(indev, data);
+
+    uint32_t word = mirror_touch_word;
+    if (data->state == LV_INDEV_STATE_PRESSED || (word & MIRROR_TOUCH_VALID) == 0)
+    {
+        return;
+    }
+
+    bool pressed = (word & MIRROR_TOUCH_PRESSED) != 0 && millis() - mirror_touch_ms < MIRROR_TOUCH_TIMEOUT_MS;
+    data->point.x = (int32_t)(word & 0x7FFF);
+    data->point.y = (int32_t)((word >> 15) & 0x7FFF);
+    data->state = pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    if (!pressed)
+    {
+        mirror_touch_word = 0; // Release reported once
+    }
+}
+
+/**
+ * @brief UI task: wrap the touch input device's read callback
+ */
+static void mirror_hook_indev(void *ctx, uint32_t param)
+{
+    (void)param;
+    lv_indev_t *indev = (lv_indev_t *)ctx;
+    if (lv_indev_get_read_cb(indev) == NULL)
+    {
+        return;
+    }
+    mirror_read_cb = lv_indev_get_read_cb(indev);
+    lv_indev_set_read_cb(indev, mirror_read);
+    mirror_indev = indev;
+}
+
+/******************************************************************************
+ * Static Functions - Mirror Task
+ *****************************************************************************/
+
+/**
+ * @brief Join the ears.config network if Wi-Fi is not up yet
+ * @return true once connected
+ */
+static bool mirror_join_wifi(void)
+{
+    if (WiFi.status() == WL_CONNECTED)
+    {
+        return true;
+    }
+
+    // Copied: Core 1 may replace the section meanwhile
+    EARS_configNetwork network = using_config().network();
+    if (!network.wifiEnabled || network.ssid[0] == '\0')
+    {
+        return false;
+    }
+
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(network.ssid, network.password[0] != '\0' ? network.password : nullptr);
+
+    uint32_t startMs = millis();
+    while (WiFi.status() != WL_CONNECTED)
+    {
+        if (millis() - startMs > MIRROR_WIFI_TIMEOUT_MS)
+        {
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(100));
+    }
+    return true;
+}
+
+/**
+ * @brief Ring and message buffer, in PSRAM, on the first start
+ */
+static bool mirror_allocate(void)
+{
+    if (mirror_ring != NULL)
+    {
+        return true;
+    }
+
+    uint8_t *storage = (uint8_t *)heap_caps_malloc(MIRROR_RING_BYTES, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    mirror_message = (uint8_t *)heap_caps_malloc(MIRROR_MESSAGE_BYTES, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (storage != NULL && mirror_message != NULL)
+    {
+        mirror_ring = xRingbufferCreateStatic(MIRROR_RING_BYTES, RINGBUF_TYPE_NOSPLIT, storage, &mirror_ring_buffer);
+    }
+    if (mirror_ring == NULL)
+    {
+        heap_caps_free(storage);
+        heap_caps_free(mirror_message);
+        mirror_message = NULL;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Read exactly length bytes, or fail after a short wait
+ */
+static bool mirror_read_exact(WiFiClient &client, uint8_t *data, size_t length)
+{
+    uint32_t startMs = millis();
+    size_t got = 0;
+    while (got < length)
+    {
+        int n = client.read(data + got, length - got);
+        if (n > 0)
+        {
+            got += n;
+        }
+        else if (!client.connected() || millis() - startMs > MIRROR_HANDSHAKE_TIMEOUT_MS)
+        {
+            return false;
+        }
+        else
+        {
+            vTaskDelay(1);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Check the token query parameter of the request line
+ * @param request "GET /?token=... HTTP/1.1"
+ * @return true if it matches security.mirror_token
+ */
+static bool mirror_token_ok(const char *request)
+{
+    const char *expected = using_config().security().mirrorToken;
+    size_t expectedLength = strlen(expected);
+    const char *value = strstr(request, "?token=");
+    if (value == NULL)
+    {
+        value = strstr(request, "&token=");
+    }
+    if (expectedLength < MIRROR_TOKEN_MIN || value == NULL)
+    {
+        return false;
+    }
+
+    value += 7;
+    if (strcspn(value, "& ") != expectedLength)
+    {
+        return false;
+    }
+
+    // No early exit, so timing does not show how much matched
+    uint8_t diff = 0;
+    for (size_t i = 0; i < expectedLength; i++)
+    {
+        diff |= (uint8_t)(value[i] ^ expected[i]);
+    }
+    return diff == 0;
+}
+
+/**
+ * @brief Answer the viewer's HTTP upgrade request
+ * @return true if the connection is now a WebSocket
+ */
+static bool mirror_handshake(WiFiClient &client)
+{
+    char line[128];
+    char key[40] = "";
+    uint8_t length = 0;
+    bool first = true;
+    bool authorised = false;
+    uint32_t startMs = millis();
+
+    // Request line with the token, then header lines up to the empty one;
+    // only the key matters
+    while (true)
+    {
+        if (millis() - startMs > MIRROR_HANDSHAKE_TIMEOUT_MS || !client.connected())
+        {
+            return false;
+        }
+        int c = client.read();
+        if (c < 0)
+        {
+            vTaskDelay(1);
+            continue;
+        }
+        if (c == '\r')
+        {
+            continue;
+        }
+        if (c != '\n')
+        {
+            if (length < sizeof(line) - 1)
+            {
+                line[length++] = (char)c;
+            }
+            continue;
+        }
+        line[length] = '\0';
+        if (first)
+        {
+            authorised = mirror_token_ok(line);
+            first = false;
+            length = 0;
+            continue;
+        }
+        if (length == 0)
+        {
+            break;
+        }
+        if (strncasecmp(line, "Sec-WebSocket-Key:", 18) == 0)
+        {
+            const char *value = line + 18;
+            while (*value == ' ')
+            {
+                value++;
+            }
+            strlcpy(key, value, sizeof(key));
+        }
+        length = 0;
+    }
+    if (!authorised)
+    {
+        static const char refusal[] = "HTTP/1.1 401 Unauthorized\r\nContent-Length: 0\r\n\r\n";
+        client.write((const uint8_t *)refusal, sizeof(refusal) - 1);
+        mirror_stats.refused++;
+        DEBUG_PRINTF("[WARN] Mirror refused %s: no token\n", client.remoteIP().toString().c_str());
+        return false;
+    }
+    if (key[0] == '\0')
+    {
+        return false;
+    }
+
+    // Sec-WebSocket-Accept: base64(SHA-1(key + GUID))
+    char text[96];
+    uint8_t digest[20];
+    unsigned char accept[32];
+    size_t acceptLength = 0;
+    int textLength = snprintf(text, sizeof(text), "%s" WS_GUID, key);
+    if (mbedtls_md(mbedtls_md_info_from_type(MBEDTLS_MD_SHA1), (const unsigned char *)text, textLength, digest) != 0 ||
+        mbedtls_base64_encode(accept, sizeof(accept) - 1, &acceptLength, digest, sizeof(digest)) != 0)
+    {
+        return false;
+    }
+    accept[acceptLength] = '\0';
+
+    char response[160];
+    int responseLength = snprintf(response, sizeof(response),
+                                  "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\n"
+                                  "Connection: Upgrade\r\nSec-WebSocket-Accept: %s\r\n\r\n",
+                                  (const char *)accept);
+    return client.write((const uint8_t *)response, responseLength) == (size_t)responseLength;
+}
+
+/**
+ * @brief Send one unmasked frame (server to viewer)
+ */
+static bool mirror_send(WiFiClient &client, uint8_t opcode, const uint8_t *data, size_t length)
+{
+    uint8_t header[4] = {(uint8_t)(0x80 | opcode), (uint8_t)length};
+    size_t headerLength = 2;
+    if (length >= 126)
+    {
+        header[1] = 126;
+        header[2] = (uint8_t)(length >> 8);
+        header[3] = (uint8_t)length;
+        headerLength = 4;
+    }
+
+    bool ok = client.write(header, headerLength) == headerLength && client.write(data, length) == length;
+    if (ok)
+    {
+        mirror_stats.sentBytes += headerLength + length;
+    }
+    return ok;
+}
+
+/**
+ * @brief Handle frames from the viewer: touches, ping, close
+ * @return false once the viewer has closed
+ */
+static bool mirror_poll_input(WiFiClient &client)
+{
+    while (client.available() >= 2)
+    {
+        uint8_t header[2];
+        uint8_t mask[4] = {};
+        uint8_t payload[16];
+        if (!mirror_read_exact(client, header, 2))
+        {
+            return false;
+        }
+
+        uint8_t opcode = header[0] & 0x0F;
+        size_t length = header[1] & 0x7F;
+        if (length >= 126)
+        {
+            return false; // Nothing the viewer sends is this long
+        }
+        if ((header[1] & 0x80) != 0 && !mirror_read_exact(client, mask, 4))
+        {
+            return false;
+        }
+        if (length > sizeof(payload) || !mirror_read_exact(client, payload, length))
+        {
+            return false;
+        }
+        for (size_t i = 0; i < length; i++)
+        {
+            payload[i] ^= mask[i & 3];
+        }
+
+        if (opcode == WS_OP_CLOSE)
+        {
+            mirror_send(client, WS_OP_CLOSE, payload, length < 2 ? length : 2);
+            return false;
+        }
+        if (opcode == WS_OP_PING)
+        {
+            mirror_send(client, WS_OP_PONG, payload, length);
+        }
+        else if (opcode == WS_OP_BINARY && length == sizeof(MAIN_mirror_touch_t) && mirror_indev != NULL)
+        {
+            MAIN_mirror_touch_t touch;
+            memcpy(&touch, payload, sizeof(touch));
+            mirror_touch_ms = millis();
+            mirror_touch_word = MIRROR_TOUCH_VALID | (touch.pressed ? MIRROR_TOUCH_PRESSED : 0) |
+                                (touch.x & 0x7FFFU) | ((touch.y & 0x7FFFU) << 15);
+            mirror_stats.touches++;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Post to the UI task, waiting for room in its queue
+ */
+static void mirror_ui_call(MAIN_ui_cmd_fn_t fn)
+{
+    while (!MAIN_ui_cmd_call(fn, NULL, 0))
+    {
+        vTaskDelay(pdMS_TO_TICKS(MIRROR_POLL_MS));
+    }
+}
+
+/**
+ * @brief Stream to one viewer until it leaves or the mirror is stopped
+ */
+static void mirror_session(WiFiClient &client)
+{
+    client.setNoDelay(true);
+
+    char hello[80];
+    int helloLength = snprintf(hello, sizeof(hello), "{\"w\":%d,\"h\":%d,\"format\":\"RGB565\",\"swapped\":%s}",
+                               (int)lv_display_get_horizontal_resolution(NULL),
+                               (int)lv_display_get_vertical_resolution(NULL),
+                               LVGL_NATIVE_BYTE_ORDER == 1 ? "true" : "false");
+    if (!mirror_send(client, WS_OP_TEXT, (const uint8_t *)hello, helloLength))
+    {
+        return;
+    }
+    mirror_stats.sessions++;
+    DEBUG_PRINTF("[OK] Mirror viewer %s\n", client.remoteIP().toString().c_str());
+
+    // Left over from the last viewer's detach
+    size_t size;
+    void *item;
+    while ((item = xRingbufferReceive(mirror_ring, &size, 0)) != NULL)
+    {
+        vRingbufferReturnItem(mirror_ring, item);
+    }
+
+    mirror_connected = true;
+    mirror_resync = true;
+    uint32_t keyframeMs = millis() - MIRROR_KEYFRAME_MIN_MS;
+    bool open = true;
+    while (open && mirror_enabled && client.connected())
+    {
+        item = xRingbufferReceive(mirror_ring, &size, pdMS_TO_TICKS(MIRROR_POLL_MS));
+        if (item != NULL)
+        {
+            open = mirror_send(client, WS_OP_BINARY, (const uint8_t *)item, size);
+            vRingbufferReturnItem(mirror_ring, item);
+        }
+        else if (mirror_resync && millis() - keyframeMs >= MIRROR_KEYFRAME_MIN_MS)
+        {
+            // Drained: one full redraw replaces whatever was dropped
+            mirror_resync = false;
+            keyframeMs = millis();
+            mirror_stats.keyframes++;
+            mirror_ui_call(mirror_keyframe);
+        }
+        open = open && mirror_poll_input(client);
+    }
+
+    mirror_connected = false;
+    mirror_ui_call(mirror_detach);
+    if ((mirror_touch_word & MIRROR_TOUCH_VALID) != 0)
+    {
+        mirror_touch_word = MIRROR_TOUCH_VALID | (mirror_touch_word & 0x3FFFFFFFU); // Release a held press
+    }
+    DEBUG_PRINTLN("[INFO] Mirror viewer left");
+}
+
+static void mirror_task_fn(void *param)
+{
+    (void)param;
+    for (;;)
+    {
+        if (!mirror_enabled)
+        {
+            if (mirror_listening)
+            {
+                mirror_server.end();
+                mirror_listening = false;
+            }
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        if (!mirror_listening)
+        {
+            if (!mirror_allocate() || !mirror_join_wifi())
+            {
+                DEBUG_PRINTLN("[WARN] Mirror not started (memory or Wi-Fi)");
+                mirror_enabled = false;
+                continue;
+            }
+            mirror_server.begin();
+            mirror_listening = true;
+            DEBUG_PRINTF("[OK] Mirror on ws://%s:%d/\n", WiFi.localIP().toString().c_str(), MIRROR_PORT);
+        }
+
+        WiFiClient client = mirror_server.available();
+        if (client)
+        {
+            if (mirror_handshake(client))
+            {
+                mirror_session(client);
+            }
+            client.stop();
+        }
+        else
+        {
+            vTaskDelay(pdMS_TO_TICKS(100));
+        }
+    }
+}
+
+/******************************************************************************
+ * Static Functions - Console
+ *****************************************************************************/
+
+static void mirror_cmd(int argc, char **argv)
+{
+    if (argc == 2 && strcmp(argv[1], "on") == 0)
+    {
+        MAIN_console_printf(MAIN_mirror_start() ? "Mirror starting on port %d\n"
+                                                : "Mirror not available (needs security.mirror_token)\n",
+                            MIRROR_PORT);
+        return;
+    }
+    if (argc == 2 && strcmp(argv[1], "off") == 0)
+    {
+        MAIN_mirror_stop();
+        MAIN_console_printf("Mirror stopped\n");
+        return;
+    }
+
+    MAIN_mirror_stats_t s;
+    MAIN_mirror_get_stats(&s);
+    MAIN_console_printf("Mirror %s%s: %lu sessions (%lu refused), %lu rects (%lu dropped), %lu keyframes\n",
+                        mirror_enabled ? "on" : "off", mirror_connected ? ", viewer connected" : "",
+                        (unsigned long)s.sessions, (unsigned long)s.refused, (unsigned long)s.rects,
+                        (unsigned long)s.dropped, (unsigned long)s.keyframes);
+    MAIN_console_printf("  %lu KB flushed, %lu KB sent, %lu ms encoding, %lu touches\n",
+                        (unsigned long)(s.rawBytes / 1024), (unsigned long)(s.sentBytes / 1024),
+                        (unsigned long)(s.encodeUs / 1000), (unsigned long)s.touches);
+}
+
+static const MAIN_console_cmd_t mirror_console_cmd = {"mirror", "[on|off]", "Screen mirror over Wi-Fi",
+                                                      mirror_cmd};
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Create the task, hook the touch input device, register the command
+ */
+bool MAIN_initialise_mirror(lv_indev_t *touch)
+{
+    if (mirror_task_handle != NULL)
+    {
+        return true;
+    }
+
+    mirror_task_handle = MAIN_STATIC_TASK_CREATE(mirror_task, mirror_task_fn, "Mirror", NULL, MIRROR_TASK_PRIORITY,
+                                                 MIRROR_TASK_CORE);
+    if (mirror_task_handle == NULL)
+    {
+        return false;
+    }
+    if (touch != NULL)
+    {
+        MAIN_ui_cmd_call(mirror_hook_indev, touch, 0);
+    }
+    MAIN_console_register(&mirror_console_cmd);
+
+#if EARS_MIRROR == 1
+    MAIN_mirror_start();
+#endif
+    return true;
+}
+
+/**
+ * @brief Wake the task to join Wi-Fi and listen
+ */
+bool MAIN_mirror_start(void)
+{
+    if (mirror_task_handle == NULL || strlen(using_config().security().mirrorToken) < MIRROR_TOKEN_MIN)
+    {
+        return false;
+    }
+    mirror_enabled = true;
+    xTaskNotifyGive(mirror_task_handle);
+    return true;
+}
+
+/**
+ * @brief Ask the task to close the viewer and stop listening
+ */
+void MAIN_mirror_stop(void)
+{
+    mirror_enabled = false;
+}
+
+/**
+ * @brief Check for a connected viewer
+ */
+bool MAIN_mirror_is_connected(void)
+{
+    return mirror_connected;
+}
+
+/**
+ * @brief Copy the counters
+ */
+void MAIN_mirror_get_stats(MAIN_mirror_stats_t *stats)
+{
+    *stats = mirror_stats;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Mirror_getLibraryName() {
+    return MAIN_Mirror::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Mirror_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Mirror::VERSION_MAJOR,
+                       MAIN_Mirror::VERSION_MINOR,
+                       MAIN_Mirror::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Mirror_getVersionDate() {
+    return MAIN_Mirror::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Mirror_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Mirror_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_mirrorLib.cpp
+ ******************************************************************************/
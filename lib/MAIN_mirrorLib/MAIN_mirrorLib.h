@@ -0,0 +1,190 @@
+/**
+ * @file MAIN_mirrorLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Live screen mirror over Wi-Fi, streamed from the flush path
+ * @details For remote support and training a host viewer sees the screen
+ *          live and can touch it. With a viewer connected, a flush tap
+ *          (MAIN_lvgl_add_flush_tap) run-length encodes each dirty area
+ *          LVGL flushes and queues it on a MIRROR_RING_BYTES ring in PSRAM;
+ *          only the changed rectangles ever leave the unit. The "Mirror"
+ *          task (TASK_ROLE_NETWORK) sends them as binary WebSocket frames
+ *          to the one viewer on MIRROR_PORT.
+ *
+ *          The tap never waits: an area the ring cannot take is dropped
+ *          and counted, and once the ring has drained the task asks the
+ *          UI task for a full redraw (at most every MIRROR_KEYFRAME_MIN_MS),
+ *          so the viewer catches up with one keyframe instead of the local
+ *          frame rate paying for a slow link.
+ *          The tap's cost is one encoding pass over the flushed pixels.
+ *
+ *          Protocol (ws://<ip>:MIRROR_PORT/?token=<token>, little-endian):
+ *          - the upgrade request must carry ears.config
+ *            security.mirror_token (at least MIRROR_TOKEN_MIN characters)
+ *            as the token query parameter, or it is answered 401 and
+ *            closed before anything is streamed or a touch is read. With
+ *            no such token configured the mirror does not start.
+ *          - on connect, one text frame:
+ *            {"w":480,"h":320,"format":"RGB565","swapped":true}
+ *            (swapped: pixels in panel byte order, high byte first)
+ *          - then binary frames, each one MAIN_mirror_rect_t and its rows:
+ *            a 16-bit code c, then (c & 0x8000) ? one pixel repeated
+ *            (c & 0x7FFF) + 1 times : c + 1 literal pixels; runs never
+ *            cross a row. MIRROR_RECT_FRAME_END marks a frame's last area.
+ *          - viewer to unit, binary frames of MAIN_mirror_touch_t. A press
+ *            is reported through the touch input device in place of the
+ *            panel while the panel is not pressed, and released by itself
+ *            MIRROR_TOUCH_TIMEOUT_MS after the last update.
+ *
+ *          USB CDC is the diagnostics console (MAIN_consoleLib), so the
+ *          mirror is Wi-Fi only; "mirror on|off" there starts and stops it.
+ *          Build with -D EARS_MIRROR=1 to listen from boot.
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_MIRROR_LIB_H__
+#define __MAIN_MIRROR_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include "EARS_taskPlanLib.h"
+#include <lvgl.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Mirror
+{
+    constexpr const char* LIB_NAME = "MAIN_Mirror";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "1";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_Mirror_getLibraryName();
+uint32_t MAIN_Mirror_getVersionEncoded();
+const char* MAIN_Mirror_getVersionDate();
+void MAIN_Mirror_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Mirror Configuration
+ *****************************************************************************/
+
+// 1 = listen for a viewer from boot (0: "mirror on" at the console)
+#ifndef EARS_MIRROR
+#define EARS_MIRROR 0
+#endif
+
+#define MIRROR_PORT 8081
+
+// Shortest security.mirror_token accepted
+#define MIRROR_TOKEN_MIN 16
+
+// Encoded areas waiting for the socket (PSRAM)
+#define MIRROR_RING_BYTES 65536
+
+// Largest message: rows of one area are split across several past this
+#define MIRROR_MESSAGE_BYTES 8192
+
+// Task poll period with a viewer connected, and the wait for its upgrade request
+#define MIRROR_POLL_MS 10
+#define MIRROR_HANDSHAKE_TIMEOUT_MS 2000
+#define MIRROR_WIFI_TIMEOUT_MS 15000   // Joining the ears.config network
+
+// Full redraws for a viewer that fell behind, at most this often
+#define MIRROR_KEYFRAME_MIN_MS 1000
+
+// A remote press with no update for this long is released
+#define MIRROR_TOUCH_TIMEOUT_MS 500
+
+// Mirror task
+#define MIRROR_TASK_CORE using_taskplan().core(TASK_ROLE_NETWORK)
+#define MIRROR_TASK_PRIORITY using_taskplan().priority(TASK_ROLE_NETWORK)
+#define MIRROR_TASK_STACK_SIZE 4096
+
+// MAIN_mirror_rect_t.flags
+#define MIRROR_RECT_FRAME_END 0x01
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint16_t x;     // Area on the display
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+    uint8_t flags;  // MIRROR_RECT_*
+    uint8_t reserved[3];
+} MAIN_mirror_rect_t;
+
+typedef struct
+{
+    uint8_t pressed; // 1 pressed, 0 released
+    uint8_t reserved;
+    uint16_t x;
+    uint16_t y;
+} MAIN_mirror_touch_t;
+
+typedef struct
+{
+    uint32_t sessions;  // Viewers accepted
+    uint32_t refused;   // Upgrade requests without the token
+    uint32_t rects;     // Areas queued
+    uint32_t dropped;   // Areas lost to a full ring
+    uint32_t keyframes; // Full redraws after drops or a new viewer
+    uint32_t rawBytes;  // Pixel bytes flushed while mirroring
+    uint32_t sentBytes; // Bytes written to the socket
+    uint32_t touches;   // Touch messages from viewers
+    uint32_t encodeUs;  // Time in the flush tap
+} MAIN_mirror_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Create the mirror task and hook the touch input device
+ * @param touch Input device remote touches are reported through (NULL: none)
+ * @return true if ready (listening too with EARS_MIRROR 1)
+ * @note After the UI task exists (the hook is installed on it).
+ */
+bool MAIN_initialise_mirror(lv_indev_t *touch);
+
+/**
+ * @brief Join Wi-Fi and listen for a viewer
+ * @return true if started; false without a security.mirror_token
+ * @note Any task; the task does the joining.
+ */
+bool MAIN_mirror_start(void);
+
+/**
+ * @brief Close the viewer's connection and stop listening
+ */
+void MAIN_mirror_stop(void);
+
+/**
+ * @brief Check for a connected viewer
+ */
+bool MAIN_mirror_is_connected(void);
+
+/**
+ * @brief Mirror counters
+ * @param stats Receives the counters
+ */
+void MAIN_mirror_get_stats(MAIN_mirror_stats_t *stats);
+
+#endif // __MAIN_MIRROR_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_mirrorLib.h
+ ******************************************************************************/
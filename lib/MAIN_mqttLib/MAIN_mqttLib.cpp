@@ -0,0 +1,714 @@
+/**
+ * @file MAIN_mqttLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief esp-mqtt backend for the EEZ Flow MQTT components
+ * @version 1.0.2
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_mqttLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_configLib.h"
+#include "EARS_mpscRingDef.h"
+#include <WiFi.h>
+#include <mqtt_client.h>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include <new>
+
+// Results, as MQTT_ERROR_OK / MQTT_ERROR_OTHER in eez-flow.h
+#define MQTT_RESULT_OK 0
+#define MQTT_RESULT_ERROR 1
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef enum
+{
+    MQTT_CONN_FREE = 0,
+    MQTT_CONN_IDLE,       // Initialised, not started
+    MQTT_CONN_STARTED     // esp-mqtt task running (connected or reconnecting)
+} mqtt_conn_state_t;
+
+typedef struct
+{
+    esp_mqtt_client_handle_t client;
+    uint8_t state;                // mqtt_conn_state_t, MQTT task once in use
+    volatile bool connected;      // esp-mqtt task
+    volatile bool everConnected;
+    uint32_t generation;          // Bumped at deinit; older events are dropped
+    char topics[MQTT_MAX_SUBSCRIPTIONS][MQTT_TOPIC_SIZE]; // Under mqtt_mux
+} mqtt_connection_t;
+
+typedef enum
+{
+    MQTT_CMD_CONNECT = 0,
+    MQTT_CMD_DISCONNECT,
+    MQTT_CMD_DEINIT,
+    MQTT_CMD_SUBSCRIBE,
+    MQTT_CMD_UNSUBSCRIBE,
+    MQTT_CMD_PUBLISH
+} mqtt_command_op_t;
+
+typedef struct
+{
+    uint8_t op;
+    mqtt_connection_t *conn;
+    char *topic;                  // One allocation: topic, then payload
+    char *payload;
+} mqtt_command_t;
+
+typedef struct
+{
+    mqtt_connection_t *conn;
+    uint32_t generation;
+    uint8_t event;                // MAIN_mqtt_event_t
+    bool hasTopic;
+    bool hasText;
+    char topic[MQTT_TOPIC_SIZE];
+    char text[MQTT_PAYLOAD_SIZE];
+} mqtt_event_slot_t;
+
+typedef EARS_mpscRing<mqtt_event_slot_t, MQTT_EVENT_QUEUE_SIZE> mqtt_event_ring_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static portMUX_TYPE mqtt_mux = portMUX_INITIALIZER_UNLOCKED;
+static mqtt_connection_t mqtt_connections[MQTT_MAX_CONNECTIONS];
+static TaskHandle_t mqtt_task_handle = NULL;
+static QueueHandle_t mqtt_commands = NULL;
+
+// Event ring: esp-mqtt and MQTT tasks produce, the flow consumes
+static mqtt_event_ring_t *mqtt_ring = NULL; // Flow task consumes
+
+static MAIN_mqtt_stats_t mqtt_stats;
+
+/******************************************************************************
+ * Internal Functions - Event Ring
+ *****************************************************************************/
+
+/**
+ * @brief Queue an event for the flow (any task, never blocks)
+ * @param topic Topic, not terminated, or NULL
+ * @param text Payload or error text, not terminated, or NULL
+ * @return true if queued
+ */
+static bool mqtt_post_event(mqtt_connection_t *conn, MAIN_mqtt_event_t event, const char *topic, size_t topicLength,
+                            const char *text, size_t textLength)
+{
+    mqtt_event_slot_t *slot = mqtt_ring->claim();
+    if (slot == NULL)
+    {
+        portENTER_CRITICAL(&mqtt_mux);
+        mqtt_stats.dropped++;
+        portEXIT_CRITICAL(&mqtt_mux);
+        return false;
+    }
+
+    slot->conn = conn;
+    slot->generation = conn->generation;
+    slot->event = event;
+    slot->hasTopic = topic != NULL;
+    slot->hasText = text != NULL;
+    if (topic != NULL)
+    {
+        memcpy(slot->topic, topic, topicLength);
+        slot->topic[topicLength] = '\0';
+    }
+    if (text != NULL)
+    {
+        memcpy(slot->text, text, textLength);
+        slot->text[textLength] = '\0';
+    }
+
+    // Hand the slot to the flow
+    mqtt_ring->publish(slot);
+    return true;
+}
+
+static void mqtt_post_status(mqtt_connection_t *conn, MAIN_mqtt_event_t event, const char *text)
+{
+    mqtt_post_event(conn, event, NULL, 0, text, text ? strlen(text) : 0);
+}
+
+/******************************************************************************
+ * Internal Functions - esp-mqtt Task
+ *****************************************************************************/
+
+/**
+ * @brief Subscribe again to the topics the flow asked for
+ * @note The session may be clean, so nothing survives a reconnect
+ */
+static void mqtt_resubscribe(mqtt_connection_t *conn)
+{
+    char topics[MQTT_MAX_SUBSCRIPTIONS][MQTT_TOPIC_SIZE];
+
+    portENTER_CRITICAL(&mqtt_mux);
+    memcpy(topics, conn->topics, sizeof(topics));
+    portEXIT_CRITICAL(&mqtt_mux);
+
+    for (uint8_t i = 0; i < MQTT_MAX_SUBSCRIPTIONS; i++)
+    {
+        if (topics[i][0] != '\0')
+        {
+            esp_mqtt_client_subscribe(conn->client, topics[i], MQTT_SUBSCRIBE_QOS);
+        }
+    }
+}
+
+/**
+ * @brief esp-mqtt events, turned into flow events
+ * @note Runs on the esp-mqtt task of the connection
+ */
+static void mqtt_event_handler(void *args, esp_event_base_t base, int32_t id, void *data)
+{
+    (void)base;
+    mqtt_connection_t *conn = (mqtt_connection_t *)args;
+    esp_mqtt_event_handle_t event = (esp_mqtt_event_handle_t)data;
+
+    switch ((esp_mqtt_event_id_t)id)
+    {
+    case MQTT_EVENT_BEFORE_CONNECT:
+        if (conn->everConnected)
+        {
+            mqtt_post_status(conn, MAIN_MQTT_EVENT_RECONNECT, NULL);
+        }
+        break;
+
+    case MQTT_EVENT_CONNECTED:
+        conn->connected = true;
+        conn->everConnected = true;
+        mqtt_resubscribe(conn);
+        mqtt_post_status(conn, MAIN_MQTT_EVENT_CONNECT, NULL);
+        break;
+
+    case MQTT_EVENT_DISCONNECTED:
+        conn->connected = false;
+        mqtt_post_status(conn, MAIN_MQTT_EVENT_CLOSE, NULL);
+        mqtt_post_status(conn, MAIN_MQTT_EVENT_OFFLINE, NULL);
+        break;
+
+    case MQTT_EVENT_ERROR:
+        mqtt_post_status(conn, MAIN_MQTT_EVENT_ERROR,
+                         event->error_handle->error_type == MQTT_ERROR_TYPE_CONNECTION_REFUSED
+                             ? "Connection refused"
+                             : "Transport error");
+        break;
+
+    case MQTT_EVENT_DATA:
+        // Only whole messages that fit a slot; fragments of larger ones are dropped
+        if (event->current_data_offset != 0 || event->data_len != event->total_data_len ||
+            event->topic_len >= MQTT_TOPIC_SIZE || event->data_len >= MQTT_PAYLOAD_SIZE)
+        {
+            if (event->current_data_offset == 0)
+            {
+                portENTER_CRITICAL(&mqtt_mux);
+                mqtt_stats.oversize++;
+                portEXIT_CRITICAL(&mqtt_mux);
+            }
+            break;
+        }
+        if (mqtt_post_event(conn, MAIN_MQTT_EVENT_MESSAGE, event->topic, event->topic_len, event->data,
+                            event->data_len))
+        {
+            portENTER_CRITICAL(&mqtt_mux);
+            mqtt_stats.received++;
+            portEXIT_CRITICAL(&mqtt_mux);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/******************************************************************************
+ * Internal Functions - MQTT Task
+ *****************************************************************************/
+
+/**
+ * @brief Join the ears.config network if Wi-Fi is not up yet
+ * @return true once connected
+ */
+static bool mqtt_join_wifi(void)
+{
+    if (WiFi.status() == WL_CONNECTED)
+    {
+        return true;
+    }
+
+    // Copied: Core 1 may replace the section meanwhile
+    EARS_configNetwork network = using_config().network();
+    if (!network.wifiEnabled || network.ssid[0] == '\0')
+    {
+        return false;
+    }
+
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(network.ssid, network.password[0] != '\0' ? network.password : nullptr);
+
+    uint32_t startMs = millis();
+    while (WiFi.status() != WL_CONNECTED)
+    {
+        if (millis() - startMs > MQTT_WIFI_TIMEOUT_MS)
+        {
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(100));
+    }
+    return true;
+}
+
+/**
+ * @brief Add or remove a topic in the renewal list
+ * @return true if the list changed (adding: or the topic was already there)
+ */
+static bool mqtt_update_topics(mqtt_connection_t *conn, const char *topic, bool add)
+{
+    bool done = false;
+    int8_t freeSlot = -1;
+
+    portENTER_CRITICAL(&mqtt_mux);
+    for (uint8_t i = 0; i < MQTT_MAX_SUBSCRIPTIONS && !done; i++)
+    {
+        if (strcmp(conn->topics[i], topic) == 0 && topic[0] != '\0')
+        {
+            if (!add)
+            {
+                conn->topics[i][0] = '\0';
+            }
+            done = true;
+        }
+        else if (conn->topics[i][0] == '\0' && freeSlot < 0)
+        {
+            freeSlot = i;
+        }
+    }
+    if (!done && add && freeSlot >= 0)
+    {
+        strlcpy(conn->topics[freeSlot], topic, MQTT_TOPIC_SIZE);
+        done = true;
+    }
+    portEXIT_CRITICAL(&mqtt_mux);
+    return done;
+}
+
+/**
+ * @brief Carry out one flow request (MQTT task)
+ */
+static void mqtt_run_command(const mqtt_command_t *command)
+{
+    mqtt_connection_t *conn = command->conn;
+    bool ok = true;
+
+    switch (command->op)
+    {
+    case MQTT_CMD_CONNECT:
+        if (conn->state == MQTT_CONN_STARTED)
+        {
+            break;
+        }
+        if (!mqtt_join_wifi())
+        {
+            mqtt_post_status(conn, MAIN_MQTT_EVENT_ERROR, "Wi-Fi not connected");
+            mqtt_post_status(conn, MAIN_MQTT_EVENT_OFFLINE, NULL);
+            ok = false;
+            break;
+        }
+        ok = esp_mqtt_client_start(conn->client) == ESP_OK;
+        if (ok)
+        {
+            conn->state = MQTT_CONN_STARTED;
+        }
+        break;
+
+    case MQTT_CMD_DISCONNECT:
+    case MQTT_CMD_DEINIT:
+        if (conn->state == MQTT_CONN_STARTED)
+        {
+            esp_mqtt_client_stop(conn->client);
+            conn->state = MQTT_CONN_IDLE;
+            conn->connected = false;
+            if (command->op == MQTT_CMD_DISCONNECT)
+            {
+                mqtt_post_status(conn, MAIN_MQTT_EVENT_CLOSE, NULL);
+                mqtt_post_status(conn, MAIN_MQTT_EVENT_END, NULL);
+            }
+        }
+        if (command->op == MQTT_CMD_DEINIT)
+        {
+            esp_mqtt_client_destroy(conn->client);
+            portENTER_CRITICAL(&mqtt_mux);
+            conn->client = NULL;
+            conn->generation++;
+            conn->state = MQTT_CONN_FREE;
+            portEXIT_CRITICAL(&mqtt_mux);
+        }
+        break;
+
+    case MQTT_CMD_SUBSCRIBE:
+        ok = mqtt_update_topics(conn, command->topic, true);
+        if (ok && conn->connected)
+        {
+            ok = esp_mqtt_client_subscribe(conn->client, command->topic, MQTT_SUBSCRIBE_QOS) >= 0;
+        }
+        break;
+
+    case MQTT_CMD_UNSUBSCRIBE:
+        mqtt_update_topics(conn, command->topic, false);
+        if (conn->connected)
+        {
+            ok = esp_mqtt_client_unsubscribe(conn->client, command->topic) >= 0;
+        }
+        break;
+
+    case MQTT_CMD_PUBLISH:
+        // Into the outbox; the esp-mqtt task sends it on its next pass
+        ok = esp_mqtt_client_enqueue(conn->client, command->topic, command->payload, 0, MQTT_PUBLISH_QOS, 0,
+                                     true) >= 0;
+        if (ok)
+        {
+            portENTER_CRITICAL(&mqtt_mux);
+            mqtt_stats.published++;
+            portEXIT_CRITICAL(&mqtt_mux);
+        }
+        break;
+    }
+
+    if (!ok)
+    {
+        portENTER_CRITICAL(&mqtt_mux);
+        mqtt_stats.refused++;
+        portEXIT_CRITICAL(&mqtt_mux);
+    }
+}
+
+/**
+ * @brief MQTT task: runs queued commands, a whole backlog per wake
+ * @param parameter Task parameter (unused)
+ */
+static void mqtt_task(void *parameter)
+{
+    (void)parameter;
+    mqtt_command_t command;
+
+    while (1)
+    {
+        if (xQueueReceive(mqtt_commands, &command, portMAX_DELAY) != pdTRUE)
+        {
+            continue;
+        }
+
+        uint16_t batch = 0;
+        do
+        {
+            mqtt_run_command(&command);
+            free(command.topic);
+            batch++;
+        } while (xQueueReceive(mqtt_commands, &command, 0) == pdTRUE);
+
+        portENTER_CRITICAL(&mqtt_mux);
+        if (batch > mqtt_stats.peakBatch)
+        {
+            mqtt_stats.peakBatch = batch;
+        }
+        portEXIT_CRITICAL(&mqtt_mux);
+    }
+}
+
+/******************************************************************************
+ * Internal Functions - Flow Side
+ *****************************************************************************/
+
+/**
+ * @brief Create the event ring, command queue and MQTT task on first use
+ * @return true if running
+ */
+static bool mqtt_start(void)
+{
+    if (mqtt_task_handle != NULL)
+    {
+        return true;
+    }
+
+    if (mqtt_ring == NULL)
+    {
+        void *memory = heap_caps_malloc(sizeof(mqtt_event_ring_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (memory == NULL)
+        {
+            memory = heap_caps_malloc(sizeof(mqtt_event_ring_t), MALLOC_CAP_8BIT);
+        }
+        if (memory == NULL)
+        {
+            return false;
+        }
+        mqtt_ring = new (memory) mqtt_event_ring_t();
+    }
+
+    if (mqtt_commands == NULL)
+    {
+        mqtt_commands = xQueueCreate(MQTT_COMMAND_QUEUE_SIZE, sizeof(mqtt_command_t));
+        if (mqtt_commands == NULL)
+        {
+            return false;
+        }
+    }
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        mqtt_task,
+        "MQTT",
+        MQTT_TASK_STACK_SIZE,
+        NULL,
+        MQTT_TASK_PRIORITY,
+        &mqtt_task_handle,
+        MQTT_TASK_CORE);
+
+    if (result != pdPASS || mqtt_task_handle == NULL)
+    {
+        mqtt_task_handle = NULL;
+#if EARS_DEBUG == 1
+        Serial.println("[ERROR] Failed to create MQTT task!");
+#endif
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Queue a command for the MQTT task (never blocks)
+ * @return MQTT_RESULT_OK if queued
+ */
+static int mqtt_post_command(uint8_t op, void *handle, const char *topic, const char *payload)
+{
+    mqtt_connection_t *conn = (mqtt_connection_t *)handle;
+    if (conn == NULL || conn->state == MQTT_CONN_FREE || mqtt_commands == NULL)
+    {
+        return MQTT_RESULT_ERROR;
+    }
+
+    mqtt_command_t command = {op, conn, NULL, NULL};
+    if (topic != NULL)
+    {
+        size_t topicSize = strlen(topic) + 1;
+        size_t payloadSize = payload != NULL ? strlen(payload) + 1 : 0;
+        if (topicSize > MQTT_TOPIC_SIZE)
+        {
+            return MQTT_RESULT_ERROR;
+        }
+        command.topic = (char *)malloc(topicSize + payloadSize);
+        if (command.topic == NULL)
+        {
+            return MQTT_RESULT_ERROR;
+        }
+        memcpy(command.topic, topic, topicSize);
+        if (payload != NULL)
+        {
+            command.payload = command.topic + topicSize;
+            memcpy(command.payload, payload, payloadSize);
+        }
+    }
+
+    if (xQueueSend(mqtt_commands, &command, 0) != pdTRUE)
+    {
+        free(command.topic);
+        portENTER_CRITICAL(&mqtt_mux);
+        mqtt_stats.refused++;
+        portEXIT_CRITICAL(&mqtt_mux);
+        return MQTT_RESULT_ERROR;
+    }
+    return MQTT_RESULT_OK;
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+uint16_t MAIN_mqtt_dispatch(MAIN_mqtt_event_cb_t callback)
+{
+    if (mqtt_ring == NULL || callback == NULL)
+    {
+        return 0;
+    }
+
+    uint16_t count = 0;
+    while (count < MQTT_DISPATCH_BATCH)
+    {
+        // Empty, or the producer is still writing the next event
+        mqtt_event_slot_t *slot = mqtt_ring->peek();
+        if (slot == NULL)
+        {
+            break;
+        }
+
+        // Events of a connection the flow has since closed are dropped
+        if (slot->generation == slot->conn->generation)
+        {
+            callback(slot->conn, (MAIN_mqtt_event_t)slot->event, slot->hasTopic ? slot->topic : NULL,
+                     slot->hasText ? slot->text : NULL);
+        }
+
+        // Free the slot for the producers
+        mqtt_ring->pop();
+        count++;
+    }
+
+    if (count > 0)
+    {
+        portENTER_CRITICAL(&mqtt_mux);
+        mqtt_stats.dispatched += count;
+        portEXIT_CRITICAL(&mqtt_mux);
+    }
+    return count;
+}
+
+void MAIN_mqtt_get_stats(MAIN_mqtt_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&mqtt_mux);
+    *stats = mqtt_stats;
+    portEXIT_CRITICAL(&mqtt_mux);
+}
+
+/******************************************************************************
+ * EEZ Flow Adapter
+ *****************************************************************************/
+
+extern "C" int eez_mqtt_init(const char *protocol, const char *host, int port, const char *username,
+                             const char *password, void **handle)
+{
+    if (protocol == NULL || host == NULL || handle == NULL || !mqtt_start())
+    {
+        return MQTT_RESULT_ERROR;
+    }
+
+    // Claim a free connection
+    mqtt_connection_t *conn = NULL;
+    portENTER_CRITICAL(&mqtt_mux);
+    for (uint8_t i = 0; i < MQTT_MAX_CONNECTIONS; i++)
+    {
+        if (mqtt_connections[i].state == MQTT_CONN_FREE)
+        {
+            conn = &mqtt_connections[i];
+            conn->state = MQTT_CONN_IDLE;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&mqtt_mux);
+    if (conn == NULL)
+    {
+        return MQTT_RESULT_ERROR;
+    }
+
+    // "mqtt", "mqtts", "ws" or "wss", as the flow's MQTT Init component offers
+    char uri[128];
+    snprintf(uri, sizeof(uri), "%s://%s:%d", protocol, host, port);
+
+    esp_mqtt_client_config_t config = {};
+    config.uri = uri;
+    config.username = (username != NULL && username[0] != '\0') ? username : NULL;
+    config.password = (password != NULL && password[0] != '\0') ? password : NULL;
+    config.keepalive = MQTT_KEEPALIVE_S;
+    config.reconnect_timeout_ms = MQTT_RECONNECT_MS;
+
+    // esp-mqtt copies the strings
+    conn->client = esp_mqtt_client_init(&config);
+    if (conn->client == NULL ||
+        esp_mqtt_client_register_event(conn->client, MQTT_EVENT_ANY, mqtt_event_handler, conn) != ESP_OK)
+    {
+        if (conn->client != NULL)
+        {
+            esp_mqtt_client_destroy(conn->client);
+        }
+        portENTER_CRITICAL(&mqtt_mux);
+        conn->client = NULL;
+        conn->state = MQTT_CONN_FREE;
+        portEXIT_CRITICAL(&mqtt_mux);
+        return MQTT_RESULT_ERROR;
+    }
+
+    conn->connected = false;
+    conn->everConnected = false;
+    memset(conn->topics, 0, sizeof(conn->topics));
+    *handle = conn;
+    return MQTT_RESULT_OK;
+}
+
+extern "C" int eez_mqtt_deinit(void *handle)
+{
+    return mqtt_post_command(MQTT_CMD_DEINIT, handle, NULL, NULL);
+}
+
+extern "C" int eez_mqtt_connect(void *handle)
+{
+    return mqtt_post_command(MQTT_CMD_CONNECT, handle, NULL, NULL);
+}
+
+extern "C" int eez_mqtt_disconnect(void *handle)
+{
+    return mqtt_post_command(MQTT_CMD_DISCONNECT, handle, NULL, NULL);
+}
+
+extern "C" int eez_mqtt_subscribe(void *handle, const char *topic)
+{
+    return topic != NULL ? mqtt_post_command(MQTT_CMD_SUBSCRIBE, handle, topic, NULL) : MQTT_RESULT_ERROR;
+}
+
+extern "C" int eez_mqtt_unsubscribe(void *handle, const char *topic)
+{
+    return topic != NULL ? mqtt_post_command(MQTT_CMD_UNSUBSCRIBE, handle, topic, NULL) : MQTT_RESULT_ERROR;
+}
+
+extern "C" int eez_mqtt_publish(void *handle, const char *topic, const char *payload)
+{
+    if (topic == NULL || payload == NULL)
+    {
+        return MQTT_RESULT_ERROR;
+    }
+    return mqtt_post_command(MQTT_CMD_PUBLISH, handle, topic, payload);
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Mqtt_getLibraryName() {
+    return MAIN_Mqtt::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Mqtt_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Mqtt::VERSION_MAJOR,
+                       MAIN_Mqtt::VERSION_MINOR,
+                       MAIN_Mqtt::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Mqtt_getVersionDate() {
+    return MAIN_Mqtt::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Mqtt_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Mqtt_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_mqttLib.cpp
+ ******************************************************************************/
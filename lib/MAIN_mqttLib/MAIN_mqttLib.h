@@ -0,0 +1,153 @@
+/**
+ * @file MAIN_mqttLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief esp-mqtt backend for the EEZ Flow MQTT components
+ * @details Implements the eez_mqtt_* adapter functions the flow's MQTT Init,
+ *          Connect, Subscribe, Publish... components call (built with
+ *          -D EEZ_MQTT_ADAPTER). None of them waits on the network: each
+ *          queues a command for the "MQTT" task, which joins Wi-Fi, starts
+ *          and stops the esp-mqtt clients, subscribes, and hands publishes
+ *          to the client's outbox (esp_mqtt_client_enqueue) in batches,
+ *          all drained in one pass so the esp-mqtt task writes them
+ *          together.
+ *
+ *          Connection events and incoming messages, raised on the esp-mqtt
+ *          task, are copied into a lock-free MPSC ring. The flow drains it
+ *          at the start of every eez_flow_tick (MAIN_mqtt_dispatch()), on
+ *          whichever task runs the flow, so the MQTT Event component sees
+ *          them in order and the flow is never entered from another task.
+ *
+ *          esp-mqtt reconnects by itself after MQTT_RECONNECT_MS; the
+ *          topics subscribed through the flow are subscribed again on every
+ *          reconnect. Publishes use MQTT_PUBLISH_QOS, subscriptions
+ *          MQTT_SUBSCRIBE_QOS.
+ * @version 1.0.2
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_MQTT_LIB_H__
+#define __MAIN_MQTT_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include "EARS_taskPlanLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Mqtt
+{
+    constexpr const char* LIB_NAME = "MAIN_Mqtt";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "2";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_Mqtt_getLibraryName();
+uint32_t MAIN_Mqtt_getVersionEncoded();
+const char* MAIN_Mqtt_getVersionDate();
+void MAIN_Mqtt_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+#define MQTT_MAX_CONNECTIONS 2
+#define MQTT_MAX_SUBSCRIPTIONS 8        // Topics per connection, renewed on reconnect
+#define MQTT_TOPIC_SIZE 64              // Including the terminator
+#define MQTT_PAYLOAD_SIZE 256           // Including the terminator; longer messages are dropped
+#define MQTT_EVENT_QUEUE_SIZE 32        // Events waiting for the flow (power of 2)
+#define MQTT_COMMAND_QUEUE_SIZE 32      // Commands waiting for the MQTT task
+#define MQTT_DISPATCH_BATCH 8           // Events handed to the flow per tick
+#define MQTT_PUBLISH_QOS 0
+#define MQTT_SUBSCRIBE_QOS 0
+#define MQTT_KEEPALIVE_S 30
+#define MQTT_RECONNECT_MS 5000
+#define MQTT_WIFI_TIMEOUT_MS 15000      // Joining the ears.config network
+
+// MQTT task
+#define MQTT_TASK_CORE using_taskplan().core(TASK_ROLE_NETWORK)
+#define MQTT_TASK_PRIORITY using_taskplan().priority(TASK_ROLE_NETWORK)
+#define MQTT_TASK_STACK_SIZE 4096
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+/**
+ * @brief Connection events, numbered as EEZ_MQTT_Event
+ */
+typedef enum
+{
+    MAIN_MQTT_EVENT_CONNECT = 0,
+    MAIN_MQTT_EVENT_RECONNECT,
+    MAIN_MQTT_EVENT_CLOSE,
+    MAIN_MQTT_EVENT_DISCONNECT,
+    MAIN_MQTT_EVENT_OFFLINE,
+    MAIN_MQTT_EVENT_END,
+    MAIN_MQTT_EVENT_ERROR,
+    MAIN_MQTT_EVENT_MESSAGE
+} MAIN_mqtt_event_t;
+
+/**
+ * @brief Receives one queued event (flow task)
+ * @param handle Connection handle from eez_mqtt_init()
+ * @param event What happened
+ * @param topic Message topic (MESSAGE), else NULL
+ * @param text Message payload (MESSAGE) or error text (ERROR), else NULL
+ */
+typedef void (*MAIN_mqtt_event_cb_t)(void *handle, MAIN_mqtt_event_t event, const char *topic, const char *text);
+
+typedef struct
+{
+    uint32_t received;    // Messages queued for the flow
+    uint32_t dispatched;  // Events handed to the flow
+    uint32_t dropped;     // Events lost to a full ring
+    uint32_t oversize;    // Messages longer than MQTT_PAYLOAD_SIZE or MQTT_TOPIC_SIZE
+    uint32_t published;   // Publishes handed to esp-mqtt
+    uint32_t refused;     // Commands refused (queue full, no memory, or esp-mqtt error)
+    uint16_t peakBatch;   // Most commands drained in one pass
+} MAIN_mqtt_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Hand queued events to the flow
+ * @param callback Receives each event
+ * @return uint16_t Events dispatched (at most MQTT_DISPATCH_BATCH)
+ * @note The task running the flow only; called from eez_flow_tick.
+ */
+uint16_t MAIN_mqtt_dispatch(MAIN_mqtt_event_cb_t callback);
+
+/**
+ * @brief MQTT counters
+ * @param stats Receives the counters
+ */
+void MAIN_mqtt_get_stats(MAIN_mqtt_stats_t *stats);
+
+// EEZ Flow adapter (declared by eez-flow.h); every call returns at once
+extern "C"
+{
+    int eez_mqtt_init(const char *protocol, const char *host, int port, const char *username, const char *password, void **handle);
+    int eez_mqtt_deinit(void *handle);
+    int eez_mqtt_connect(void *handle);
+    int eez_mqtt_disconnect(void *handle);
+    int eez_mqtt_subscribe(void *handle, const char *topic);
+    int eez_mqtt_unsubscribe(void *handle, const char *topic);
+    int eez_mqtt_publish(void *handle, const char *topic, const char *payload);
+}
+
+#endif // __MAIN_MQTT_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_mqttLib.h
+ ******************************************************************************/
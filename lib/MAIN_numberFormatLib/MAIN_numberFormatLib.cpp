@@ -0,0 +1,433 @@
+/**
+ * @file MAIN_numberFormatLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Number to text without printf for the EEZ Flow display paths
+ * @version 1.0.1
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_numberFormatLib.h"
+#include <math.h>
+#include <string.h>
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static const char number_format_digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Exact in a double up to 1e22
+static const double number_format_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// 2^53: integers up to here are exact in a double
+#define NUMBER_FORMAT_EXACT_LIMIT 9007199254740992.0
+
+static const uint64_t number_format_pow10_u64[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL};
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Copy formatted text with snprintf truncation
+ * @param buf Destination
+ * @param size Buffer size
+ * @param text Source
+ * @param length Source length
+ * @return size_t Characters written
+ */
+static size_t number_format_copy(char *buf, size_t size, const char *text, size_t length)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+    if (length > size - 1)
+    {
+        length = size - 1;
+    }
+    memcpy(buf, text, length);
+    buf[length] = 0;
+    return length;
+}
+
+/**
+ * @brief Digits of an unsigned value, written backwards from end
+ * @param end One past the last digit
+ * @param value Value
+ * @return char* First digit
+ */
+static char *number_format_digits(char *end, uint64_t value)
+{
+    // 32-bit divisions are much cheaper on the LX7, so drop to them early
+    while (value > 0xFFFFFFFFULL)
+    {
+        uint32_t pair = (uint32_t)(value % 100);
+        value /= 100;
+        end -= 2;
+        memcpy(end, &number_format_digit_pairs[pair * 2], 2);
+    }
+
+    uint32_t v = (uint32_t)value;
+    while (v >= 100)
+    {
+        uint32_t pair = v % 100;
+        v /= 100;
+        end -= 2;
+        memcpy(end, &number_format_digit_pairs[pair * 2], 2);
+    }
+    if (v >= 10)
+    {
+        end -= 2;
+        memcpy(end, &number_format_digit_pairs[v * 2], 2);
+    }
+    else
+    {
+        *--end = (char)('0' + v);
+    }
+    return end;
+}
+
+/**
+ * @brief Exactly padded digits of value (for fractions)
+ * @param out Destination of width characters
+ * @param value Value below 10^width
+ * @param width Digits
+ */
+static void number_format_padded(char *out, uint64_t value, int width)
+{
+    for (int i = width - 1; i >= 0; i--)
+    {
+        out[i] = (char)('0' + (uint32_t)(value % 10));
+        value /= 10;
+    }
+}
+
+/**
+ * @brief Round magnitude * 10^shift to an integer the way printf does
+ * @param magnitude Non-negative value
+ * @param shift Power of ten, -22 to 22; magnitude * 10^shift below 2^53
+ * @return uint64_t Nearest integer, ties to even
+ * @details The product is rounded once by the FPU, which can turn an
+ *          x.4999... or x.5000...1 into an exact half, and the remainder
+ *          near a half needs more bits than a double has. So the product is
+ *          kept as product + error, both exact (fma() gives the error), and
+ *          the fraction is compared with a half as (fraction - 0.5) + error:
+ *          the difference is exact whenever error can matter, and a rounded
+ *          sum keeps the sign of the true one.
+ *
+ *          Dividing (negative shift) leaves a remainder that is a double,
+ *          so fma() gives it exactly.
+ */
+static uint64_t number_format_round(double magnitude, int shift)
+{
+    double quotient;
+    double above; // Sign of (true remainder - half)
+
+    if (shift >= 0)
+    {
+        double scale = number_format_pow10[shift];
+        double product = magnitude * scale;
+        double error = fma(magnitude, scale, -product);
+        quotient = floor(product);
+        above = (product - quotient - 0.5) + error;
+    }
+    else
+    {
+        double scale = number_format_pow10[-shift];
+        quotient = floor(magnitude / scale);
+        double remainder = fma(-quotient, scale, magnitude);
+        if (remainder < 0)
+        {
+            quotient -= 1;
+            remainder += scale;
+        }
+        above = remainder - scale / 2;
+    }
+
+    uint64_t result = (uint64_t)quotient;
+    if (above > 0 || (above == 0 && (result & 1)))
+    {
+        result++;
+    }
+    return result;
+}
+
+/**
+ * @brief snprintf for the magnitudes the fast paths do not cover
+ */
+static size_t number_format_fallback(char *buf, size_t size, const char *format, int decimals, double value)
+{
+    char text[64];
+    int n = (decimals < 0) ? snprintf(text, sizeof(text), format, value)
+                           : snprintf(text, sizeof(text), format, decimals, value);
+    if (n < 0)
+    {
+        n = 0;
+    }
+    return number_format_copy(buf, size, text, strlen(text));
+}
+
+/**
+ * @brief nan / inf as printf spells them
+ * @return size_t Characters written, 0 if the value is finite
+ */
+static size_t number_format_special(char *buf, size_t size, double value)
+{
+    if (isnan(value))
+    {
+        return number_format_copy(buf, size, signbit(value) ? "-nan" : "nan", signbit(value) ? 4 : 3);
+    }
+    if (isinf(value))
+    {
+        return number_format_copy(buf, size, (value < 0) ? "-inf" : "inf", (value < 0) ? 4 : 3);
+    }
+    return 0;
+}
+
+/******************************************************************************
+ * Integers
+ *****************************************************************************/
+
+size_t MAIN_format_int32(char *buf, size_t size, int32_t value)
+{
+    return MAIN_format_int64(buf, size, value);
+}
+
+size_t MAIN_format_uint32(char *buf, size_t size, uint32_t value)
+{
+    return MAIN_format_uint64(buf, size, value);
+}
+
+size_t MAIN_format_int64(char *buf, size_t size, int64_t value)
+{
+    char text[24];
+    char *end = text + sizeof(text);
+    // Negate in unsigned so INT64_MIN is fine
+    uint64_t magnitude = (value < 0) ? (0 - (uint64_t)value) : (uint64_t)value;
+    char *start = number_format_digits(end, magnitude);
+    if (value < 0)
+    {
+        *--start = '-';
+    }
+    return number_format_copy(buf, size, start, end - start);
+}
+
+size_t MAIN_format_uint64(char *buf, size_t size, uint64_t value)
+{
+    char text[24];
+    char *end = text + sizeof(text);
+    char *start = number_format_digits(end, value);
+    return number_format_copy(buf, size, start, end - start);
+}
+
+/******************************************************************************
+ * Floating Point
+ *****************************************************************************/
+
+size_t MAIN_format_fixed(char *buf, size_t size, double value, int decimals)
+{
+    size_t special = number_format_special(buf, size, value);
+    if (special > 0)
+    {
+        return special;
+    }
+
+    if (decimals < 0)
+    {
+        decimals = 0;
+    }
+
+    double magnitude = fabs(value);
+    if (decimals > NUMBER_FORMAT_MAX_DECIMALS || magnitude * number_format_pow10[decimals] >= NUMBER_FORMAT_EXACT_LIMIT)
+    {
+        return number_format_fallback(buf, size, "%.*f", decimals, value);
+    }
+
+    uint64_t scaled = number_format_round(magnitude, decimals);
+    uint64_t unit = number_format_pow10_u64[decimals];
+
+    char text[48];
+    char *end = text + sizeof(text);
+    char *start = end;
+    if (decimals > 0)
+    {
+        start -= decimals;
+        number_format_padded(start, scaled % unit, decimals);
+        *--start = '.';
+    }
+    start = number_format_digits(start, scaled / unit);
+    if (signbit(value))
+    {
+        *--start = '-';
+    }
+    return number_format_copy(buf, size, start, end - start);
+}
+
+size_t MAIN_format_general(char *buf, size_t size, double value)
+{
+    size_t special = number_format_special(buf, size, value);
+    if (special > 0)
+    {
+        return special;
+    }
+
+    const int digits = NUMBER_FORMAT_GENERAL_DIGITS;
+    double magnitude = fabs(value);
+    char text[32];
+    size_t n = 0;
+
+    if (signbit(value))
+    {
+        text[n++] = '-';
+    }
+
+    if (magnitude == 0)
+    {
+        text[n++] = '0';
+        return number_format_copy(buf, size, text, n);
+    }
+
+    if (magnitude < 1e-16 || magnitude >= 1e16)
+    {
+        return number_format_fallback(buf, size, "%g", -1, value);
+    }
+
+    // Decimal exponent: largest e with 10^e <= magnitude
+    int exponent = 0;
+    if (magnitude >= 1)
+    {
+        while (exponent < 16 && magnitude >= number_format_pow10[exponent + 1])
+        {
+            exponent++;
+        }
+    }
+    else
+    {
+        exponent = -1;
+        while (magnitude * number_format_pow10[-exponent] < 1)
+        {
+            exponent--;
+        }
+    }
+
+    // Round to the significant digits, which may carry into one more digit
+    int shift = digits - 1 - exponent;
+    uint32_t mantissa = (uint32_t)number_format_round(magnitude, shift);
+    if (mantissa >= (uint32_t)number_format_pow10_u64[digits])
+    {
+        mantissa /= 10;
+        exponent++;
+    }
+
+    char mantissaDigits[NUMBER_FORMAT_GENERAL_DIGITS];
+    number_format_padded(mantissaDigits, mantissa, digits);
+    int significant = digits;
+    while (significant > 1 && mantissaDigits[significant - 1] == '0')
+    {
+        significant--;
+    }
+
+    if (exponent < -4 || exponent >= digits)
+    {
+        text[n++] = mantissaDigits[0];
+        if (significant > 1)
+        {
+            text[n++] = '.';
+            memcpy(text + n, mantissaDigits + 1, significant - 1);
+            n += significant - 1;
+        }
+        text[n++] = 'e';
+        text[n++] = (exponent < 0) ? '-' : '+';
+        int e = (exponent < 0) ? -exponent : exponent;
+        memcpy(text + n, &number_format_digit_pairs[e * 2], 2);
+        n += 2;
+    }
+    else if (exponent >= 0)
+    {
+        // Integer digits are always all written, the fraction only up to the last non-zero
+        memcpy(text + n, mantissaDigits, exponent + 1);
+        n += exponent + 1;
+        if (significant > exponent + 1)
+        {
+            text[n++] = '.';
+            memcpy(text + n, mantissaDigits + exponent + 1, significant - exponent - 1);
+            n += significant - exponent - 1;
+        }
+    }
+    else
+    {
+        text[n++] = '0';
+        text[n++] = '.';
+        for (int i = -1; i > exponent; i--)
+        {
+            text[n++] = '0';
+        }
+        memcpy(text + n, mantissaDigits, significant);
+        n += significant;
+    }
+
+    return number_format_copy(buf, size, text, n);
+}
+
+size_t MAIN_format_with_unit(char *buf, size_t size, double value, const char *unit)
+{
+    size_t n = MAIN_format_general(buf, size, value);
+    if (unit != NULL && *unit && n + 1 < size)
+    {
+        buf[n++] = ' ';
+        n += number_format_copy(buf + n, size - n, unit, strlen(unit));
+    }
+    return n;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_NumberFormat_getLibraryName() {
+    return MAIN_NumberFormat::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_NumberFormat_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_NumberFormat::VERSION_MAJOR,
+                       MAIN_NumberFormat::VERSION_MINOR,
+                       MAIN_NumberFormat::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_NumberFormat_getVersionDate() {
+    return MAIN_NumberFormat::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_NumberFormat_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_NumberFormat_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_numberFormatLib.cpp
+ ******************************************************************************/
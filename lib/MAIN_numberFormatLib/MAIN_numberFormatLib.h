@@ -0,0 +1,124 @@
+/**
+ * @file MAIN_numberFormatLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Number to text without printf for the EEZ Flow display paths
+ * @details Every value rendered to a label goes through the eez Value
+ *          to_text functions, which used snprintf (varargs, locale lookup and
+ *          newlib's dtoa) for each number. These formatters write the same
+ *          text directly: integers two digits at a time from a table, fixed
+ *          decimals by scaling to a 64-bit integer, and %g style output from
+ *          six rounded significant digits.
+ *
+ *          Halves are decided on the exact value, as printf does, not on
+ *          the once-rounded scaled product. %g magnitudes below 1e-16 or
+ *          from 1e16 up, fixed values that scale to 2^53 or more, and fixed
+ *          formats with more than 9 decimals are handed to snprintf so their
+ *          text stays exact. Output is truncated like snprintf to the buffer
+ *          size. native_bench checks both formats against snprintf.
+ * @version 1.0.1
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_NUMBER_FORMAT_LIB_H__
+#define __MAIN_NUMBER_FORMAT_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_NumberFormat
+{
+    constexpr const char* LIB_NAME = "MAIN_NumberFormat";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "1";
+    constexpr const char* VERSION_DATE = "2026-10-14";
+}
+
+
+// Version information getters
+const char* MAIN_NumberFormat_getLibraryName();
+uint32_t MAIN_NumberFormat_getVersionEncoded();
+const char* MAIN_NumberFormat_getVersionDate();
+void MAIN_NumberFormat_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Number Format Configuration
+ *****************************************************************************/
+
+// Significant digits of the general format (as printf %g)
+#define NUMBER_FORMAT_GENERAL_DIGITS 6
+
+// Largest decimal count formatted without snprintf
+#define NUMBER_FORMAT_MAX_DECIMALS 9
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Signed 32-bit integer, as "%d"
+ * @param buf Destination (always terminated when size > 0)
+ * @param size Buffer size in bytes
+ * @param value Value
+ * @return size_t Characters written, excluding the terminator
+ */
+size_t MAIN_format_int32(char *buf, size_t size, int32_t value);
+
+/**
+ * @brief Unsigned 32-bit integer, as "%lu"
+ */
+size_t MAIN_format_uint32(char *buf, size_t size, uint32_t value);
+
+/**
+ * @brief Signed 64-bit integer, as "%lld"
+ */
+size_t MAIN_format_int64(char *buf, size_t size, int64_t value);
+
+/**
+ * @brief Unsigned 64-bit integer, as "%llu"
+ */
+size_t MAIN_format_uint64(char *buf, size_t size, uint64_t value);
+
+/**
+ * @brief Fixed decimals, as "%.*f"
+ * @param buf Destination
+ * @param size Buffer size in bytes
+ * @param value Value
+ * @param decimals Digits after the point
+ * @return size_t Characters written
+ */
+size_t MAIN_format_fixed(char *buf, size_t size, double value, int decimals);
+
+/**
+ * @brief Shortest of fixed and exponent form, as "%g"
+ * @param buf Destination
+ * @param size Buffer size in bytes
+ * @param value Value
+ * @return size_t Characters written
+ */
+size_t MAIN_format_general(char *buf, size_t size, double value);
+
+/**
+ * @brief General format followed by a space and a unit, as "%g V"
+ * @param buf Destination
+ * @param size Buffer size in bytes
+ * @param value Value
+ * @param unit Unit name (NULL or "" = none)
+ * @return size_t Characters written
+ */
+size_t MAIN_format_with_unit(char *buf, size_t size, double value, const char *unit);
+
+#endif // __MAIN_NUMBER_FORMAT_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_numberFormatLib.h
+ ******************************************************************************/
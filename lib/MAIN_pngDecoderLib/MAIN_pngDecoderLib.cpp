@@ -0,0 +1,838 @@
+/**
+ * @file MAIN_pngDecoderLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Streaming PNG decoder for LVGL, row by row into RGB565 / RGB565A8
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_pngDecoderLib.h"
+#include "EARS_systemDef.h"
+#include <lvgl_private.h>
+#include <esp_heap_caps.h>
+#include <rom/miniz.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+// PNG colour types
+#define PNG_COLOUR_GREY 0
+#define PNG_COLOUR_RGB 2
+#define PNG_COLOUR_PALETTE 3
+#define PNG_COLOUR_GREY_ALPHA 4
+#define PNG_COLOUR_RGBA 6
+
+// One decode: source, IHDR/PLTE/tRNS, and the scanline being filled
+typedef struct
+{
+    lv_fs_file_t *file;  // File source, or NULL for data
+    const uint8_t *data; // Data source
+    uint32_t size;
+    uint32_t pos;
+    uint32_t chunkLeft;  // Bytes left in the current IDAT chunk
+    bool idatDone;       // No IDAT data after this
+
+    uint32_t width;
+    uint32_t height;
+    uint8_t depth;
+    uint8_t colour;
+    uint8_t channels;
+    uint8_t pixelBytes; // Filter distance (at least one byte)
+    uint32_t rowBytes;  // Without the filter byte
+
+    uint8_t (*palette)[4]; // RGBA, NULL when only the header is wanted
+    uint16_t key[3];       // tRNS colour for grey and RGB
+    bool hasKey;
+    bool alpha;            // Output RGB565A8
+
+    lv_draw_buf_t *buf;
+    uint8_t *row;  // Filter byte + rowBytes
+    uint8_t *prev; // Previous row, unfiltered
+    uint32_t fill; // Bytes of row filled
+    uint32_t y;    // Next output row
+} png_t;
+
+// Working memory of one decode
+typedef struct
+{
+    tinfl_decompressor inflater;
+    uint8_t window[TINFL_LZ_DICT_SIZE];
+    uint8_t input[PNG_DECODER_INPUT_SIZE];
+    uint8_t palette[256][4];
+} png_work_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static const uint8_t png_signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+static MAIN_png_stats_t png_stats;
+static portMUX_TYPE png_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/******************************************************************************
+ * Static Functions
+ *****************************************************************************/
+
+/**
+ * @brief File source with a PNG extension
+ */
+static bool png_is_file(const char *path)
+{
+    return strcasecmp(lv_fs_get_ext(path), "png") == 0;
+}
+
+/**
+ * @brief Variable source holding a PNG file
+ */
+static bool png_is_data(const lv_image_dsc_t *image)
+{
+    return image->data != NULL && image->data_size >= sizeof(png_signature) &&
+           memcmp(image->data, png_signature, sizeof(png_signature)) == 0;
+}
+
+/**
+ * @brief Big-endian 32-bit value
+ */
+static uint32_t png_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/**
+ * @brief Working memory: PSRAM, else internal RAM
+ */
+static void *png_alloc(size_t size)
+{
+    void *p = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    return p != NULL ? p : heap_caps_malloc(size, MALLOC_CAP_8BIT);
+}
+
+/**
+ * @brief Read exactly len bytes from the source
+ */
+static bool png_read(png_t *png, void *buf, uint32_t len)
+{
+    if (png->file != NULL)
+    {
+        uint32_t got = 0;
+        return lv_fs_read(png->file, buf, len, &got) == LV_FS_RES_OK && got == len;
+    }
+
+    if (png->size - png->pos < len)
+    {
+        return false;
+    }
+    memcpy(buf, png->data + png->pos, len);
+    png->pos += len;
+    return true;
+}
+
+/**
+ * @brief Skip len bytes of the source
+ */
+static bool png_skip(png_t *png, uint32_t len)
+{
+    if (png->file != NULL)
+    {
+        uint32_t pos;
+        return lv_fs_tell(png->file, &pos) == LV_FS_RES_OK &&
+               lv_fs_seek(png->file, pos + len, LV_FS_SEEK_SET) == LV_FS_RES_OK;
+    }
+
+    if (png->size - png->pos < len)
+    {
+        return false;
+    }
+    png->pos += len;
+    return true;
+}
+
+/**
+ * @brief Check the IHDR fields this decoder takes, and derive the row layout
+ */
+static bool png_parse_ihdr(png_t *png, const uint8_t *ihdr)
+{
+    png->width = png_be32(ihdr);
+    png->height = png_be32(ihdr + 4);
+    png->depth = ihdr[8];
+    png->colour = ihdr[9];
+
+    // Compression and filter method 0; no Adam7
+    if (ihdr[10] != 0 || ihdr[11] != 0 || ihdr[12] != 0)
+    {
+        return false;
+    }
+    if (png->width == 0 || png->height == 0 || png->width > PNG_DECODER_MAX_SIDE ||
+        png->height > PNG_DECODER_MAX_SIDE)
+    {
+        return false;
+    }
+
+    uint8_t depth = png->depth;
+    bool lowDepth = depth == 1 || depth == 2 || depth == 4;
+    switch (png->colour)
+    {
+    case PNG_COLOUR_GREY:
+        png->channels = 1;
+        if (!lowDepth && depth != 8 && depth != 16)
+        {
+            return false;
+        }
+        break;
+    case PNG_COLOUR_PALETTE:
+        png->channels = 1;
+        if (!lowDepth && depth != 8)
+        {
+            return false;
+        }
+        break;
+    case PNG_COLOUR_RGB:
+    case PNG_COLOUR_GREY_ALPHA:
+    case PNG_COLOUR_RGBA:
+        png->channels = png->colour == PNG_COLOUR_RGB ? 3 : png->colour == PNG_COLOUR_RGBA ? 4 : 2;
+        if (depth != 8 && depth != 16)
+        {
+            return false;
+        }
+        png->alpha = png->colour != PNG_COLOUR_RGB;
+        break;
+    default:
+        return false;
+    }
+
+    uint32_t bits = png->channels * depth;
+    png->pixelBytes = bits < 8 ? 1 : bits / 8;
+    png->rowBytes = (png->width * bits + 7) / 8;
+    return true;
+}
+
+/**
+ * @brief Read the chunks up to the first IDAT
+ * @return true with the source at the first IDAT's data
+ */
+static bool png_read_header(png_t *png)
+{
+    uint8_t head[8];
+    if (!png_read(png, head, sizeof(head)) || memcmp(head, png_signature, sizeof(png_signature)) != 0)
+    {
+        return false;
+    }
+
+    bool ihdr = false;
+    while (png_read(png, head, sizeof(head)))
+    {
+        uint32_t length = png_be32(head);
+        const uint8_t *type = head + 4;
+
+        if (memcmp(type, "IDAT", 4) == 0)
+        {
+            png->chunkLeft = length;
+            return ihdr;
+        }
+        if (memcmp(type, "IEND", 4) == 0)
+        {
+            return false;
+        }
+
+        if (memcmp(type, "IHDR", 4) == 0)
+        {
+            uint8_t data[13];
+            if (length != sizeof(data) || !png_read(png, data, sizeof(data)) || !png_parse_ihdr(png, data))
+            {
+                return false;
+            }
+            ihdr = true;
+            length = 0;
+        }
+        else if (memcmp(type, "PLTE", 4) == 0 && png->palette != NULL && length <= 256 * 3)
+        {
+            for (uint32_t i = 0; i < length / 3; i++)
+            {
+                if (!png_read(png, png->palette[i], 3))
+                {
+                    return false;
+                }
+            }
+            length -= length / 3 * 3;
+        }
+        else if (memcmp(type, "tRNS", 4) == 0 && ihdr)
+        {
+            png->alpha = true;
+            if (png->palette != NULL && png->colour == PNG_COLOUR_PALETTE && length <= 256)
+            {
+                for (uint32_t i = 0; i < length; i++)
+                {
+                    if (!png_read(png, &png->palette[i][3], 1))
+                    {
+                        return false;
+                    }
+                }
+                length = 0;
+            }
+            else if ((png->colour == PNG_COLOUR_GREY && length == 2) || (png->colour == PNG_COLOUR_RGB && length == 6))
+            {
+                uint8_t key[6];
+                if (!png_read(png, key, length))
+                {
+                    return false;
+                }
+                for (uint32_t i = 0; i < length / 2; i++)
+                {
+                    png->key[i] = (key[i * 2] << 8) | key[i * 2 + 1];
+                }
+                png->hasKey = true;
+                length = 0;
+            }
+        }
+
+        // The rest of the chunk, then its CRC
+        if (!png_skip(png, length + 4))
+        {
+            return false;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Read compressed data, across IDAT chunks
+ * @return uint32_t Bytes read, 0 once the IDAT chunks are done
+ */
+static uint32_t png_read_idat(png_t *png, uint8_t *buf, uint32_t max)
+{
+    uint32_t total = 0;
+    while (total < max && !png->idatDone)
+    {
+        if (png->chunkLeft == 0)
+        {
+            // CRC of this chunk, then the next chunk's length and type
+            uint8_t head[12];
+            if (!png_read(png, head, sizeof(head)) || memcmp(head + 8, "IDAT", 4) != 0)
+            {
+                png->idatDone = true;
+                break;
+            }
+            png->chunkLeft = png_be32(head + 4);
+            continue;
+        }
+
+        uint32_t n = LV_MIN(max - total, png->chunkLeft);
+        if (!png_read(png, buf + total, n))
+        {
+            png->idatDone = true;
+            break;
+        }
+        total += n;
+        png->chunkLeft -= n;
+    }
+    return total;
+}
+
+/**
+ * @brief Undo a scanline's filter, against the previous unfiltered row
+ */
+static bool png_unfilter(png_t *png)
+{
+    uint8_t *cur = png->row + 1;
+    const uint8_t *prev = png->prev + 1;
+    uint32_t bpp = png->pixelBytes;
+    uint32_t n = png->rowBytes;
+
+    switch (png->row[0])
+    {
+    case 0: // None
+        break;
+    case 1: // Sub
+        for (uint32_t i = bpp; i < n; i++)
+        {
+            cur[i] += cur[i - bpp];
+        }
+        break;
+    case 2: // Up
+        for (uint32_t i = 0; i < n; i++)
+        {
+            cur[i] += prev[i];
+        }
+        break;
+    case 3: // Average
+        for (uint32_t i = 0; i < n; i++)
+        {
+            uint32_t a = i >= bpp ? cur[i - bpp] : 0;
+            cur[i] += (a + prev[i]) >> 1;
+        }
+        break;
+    case 4: // Paeth
+        for (uint32_t i = 0; i < n; i++)
+        {
+            int a = i >= bpp ? cur[i - bpp] : 0;
+            int b = prev[i];
+            int c = i >= bpp ? prev[i - bpp] : 0;
+            int pa = abs(b - c);
+            int pb = abs(a - c);
+            int pc = abs(a + b - 2 * c);
+            cur[i] += (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+        }
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Sample index of an unfiltered row, raw (up to 16 bits)
+ */
+static uint32_t png_sample(const uint8_t *row, uint32_t index, uint8_t depth)
+{
+    switch (depth)
+    {
+    case 16:
+        return (row[index * 2] << 8) | row[index * 2 + 1];
+    case 8:
+        return row[index];
+    default:
+    {
+        uint32_t bit = index * depth;
+        return (row[bit >> 3] >> (8 - depth - (bit & 7))) & ((1U << depth) - 1);
+    }
+    }
+}
+
+/**
+ * @brief A raw sample as 8 bits
+ */
+static uint8_t png_to8(uint32_t raw, uint8_t depth)
+{
+    if (depth == 16)
+    {
+        return raw >> 8;
+    }
+    return depth == 8 ? raw : raw * 255 / ((1U << depth) - 1);
+}
+
+/**
+ * @brief RGB565 of 8-bit channels
+ */
+static inline uint16_t png_rgb565(uint8_t r, uint8_t g, uint8_t b)
+{
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+/**
+ * @brief Convert the unfiltered row into output row y
+ */
+static void png_output_row(png_t *png)
+{
+    lv_draw_buf_t *buf = png->buf;
+    const uint8_t *src = png->row + 1;
+    uint16_t *rgb = (uint16_t *)(buf->data + png->y * buf->header.stride);
+    uint8_t *mask = png->alpha ? buf->data + buf->header.stride * buf->header.h + png->y * (buf->header.stride / 2)
+                               : NULL;
+    uint8_t depth = png->depth;
+
+    // The common 8-bit layouts first
+    if (depth == 8 && png->colour == PNG_COLOUR_RGBA)
+    {
+        for (uint32_t x = 0; x < png->width; x++, src += 4)
+        {
+            rgb[x] = png_rgb565(src[0], src[1], src[2]);
+            mask[x] = src[3];
+        }
+        return;
+    }
+    if (depth == 8 && png->colour == PNG_COLOUR_RGB && !png->hasKey)
+    {
+        for (uint32_t x = 0; x < png->width; x++, src += 3)
+        {
+            rgb[x] = png_rgb565(src[0], src[1], src[2]);
+        }
+        return;
+    }
+
+    for (uint32_t x = 0; x < png->width; x++)
+    {
+        uint8_t r, g, b, a = 255;
+        uint32_t s = x * png->channels;
+
+        switch (png->colour)
+        {
+        case PNG_COLOUR_GREY:
+        {
+            uint32_t raw = png_sample(src, s, depth);
+            r = g = b = png_to8(raw, depth);
+            if (png->hasKey && raw == png->key[0])
+            {
+                a = 0;
+            }
+            break;
+        }
+        case PNG_COLOUR_PALETTE:
+        {
+            const uint8_t *entry = png->palette[png_sample(src, s, depth)];
+            r = entry[0];
+            g = entry[1];
+            b = entry[2];
+            a = entry[3];
+            break;
+        }
+        case PNG_COLOUR_GREY_ALPHA:
+            r = g = b = png_to8(png_sample(src, s, depth), depth);
+            a = png_to8(png_sample(src, s + 1, depth), depth);
+            break;
+        case PNG_COLOUR_RGB:
+        {
+            uint32_t rr = png_sample(src, s, depth);
+            uint32_t gg = png_sample(src, s + 1, depth);
+            uint32_t bb = png_sample(src, s + 2, depth);
+            r = png_to8(rr, depth);
+            g = png_to8(gg, depth);
+            b = png_to8(bb, depth);
+            if (png->hasKey && rr == png->key[0] && gg == png->key[1] && bb == png->key[2])
+            {
+                a = 0;
+            }
+            break;
+        }
+        default: // RGBA
+            r = png_to8(png_sample(src, s, depth), depth);
+            g = png_to8(png_sample(src, s + 1, depth), depth);
+            b = png_to8(png_sample(src, s + 2, depth), depth);
+            a = png_to8(png_sample(src, s + 3, depth), depth);
+            break;
+        }
+
+        rgb[x] = png_rgb565(r, g, b);
+        if (mask != NULL)
+        {
+            mask[x] = a;
+        }
+    }
+}
+
+/**
+ * @brief Take inflated bytes: fill scanlines and output each one complete
+ * @return false on a bad filter type
+ */
+static bool png_take(png_t *png, const uint8_t *data, size_t len)
+{
+    uint32_t full = png->rowBytes + 1;
+    while (len > 0 && png->y < png->height)
+    {
+        uint32_t n = LV_MIN((uint32_t)len, full - png->fill);
+        memcpy(png->row + png->fill, data, n);
+        png->fill += n;
+        data += n;
+        len -= n;
+
+        if (png->fill == full)
+        {
+            if (!png_unfilter(png))
+            {
+                return false;
+            }
+            png_output_row(png);
+            png->y++;
+            png->fill = 0;
+
+            uint8_t *swap = png->prev;
+            png->prev = png->row;
+            png->row = swap;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Inflate the IDAT stream into a new draw buffer from the image cache's allocator
+ * @param png Header read, source at the first IDAT's data
+ * @param work Working memory, palette already filled
+ * @return lv_draw_buf_t* The picture, or NULL
+ */
+static lv_draw_buf_t *png_inflate(png_t *png, png_work_t *work)
+{
+    uint8_t *rows = (uint8_t *)png_alloc(2 * (png->rowBytes + 1));
+    png->buf = lv_draw_buf_create_ex(lv_draw_buf_get_image_handlers(), png->width, png->height,
+                                     png->alpha ? LV_COLOR_FORMAT_RGB565A8 : LV_COLOR_FORMAT_RGB565, LV_STRIDE_AUTO);
+    if (rows == NULL || png->buf == NULL)
+    {
+        heap_caps_free(rows);
+        if (png->buf != NULL)
+        {
+            lv_draw_buf_destroy(png->buf);
+        }
+        return NULL;
+    }
+
+    png->row = rows;
+    png->prev = rows + png->rowBytes + 1;
+    memset(png->prev, 0, png->rowBytes + 1);
+
+    tinfl_init(&work->inflater);
+    const uint8_t *in = work->input;
+    size_t inAvail = 0;
+    size_t windowPos = 0;
+    bool ok = true;
+
+    while (ok && png->y < png->height)
+    {
+        if (inAvail == 0)
+        {
+            inAvail = png_read_idat(png, work->input, sizeof(work->input));
+            in = work->input;
+        }
+
+        // The window wraps: tinfl keeps its history in it
+        size_t inBytes = inAvail;
+        size_t outBytes = TINFL_LZ_DICT_SIZE - windowPos;
+        mz_uint32 flags = TINFL_FLAG_PARSE_ZLIB_HEADER | (inAvail > 0 ? TINFL_FLAG_HAS_MORE_INPUT : 0);
+        tinfl_status status = tinfl_decompress(&work->inflater, in, &inBytes, work->window,
+                                               work->window + windowPos, &outBytes, flags);
+        in += inBytes;
+        inAvail -= inBytes;
+
+        ok = png_take(png, work->window + windowPos, outBytes);
+        windowPos = (windowPos + outBytes) & (TINFL_LZ_DICT_SIZE - 1);
+
+        // Done, or failed (including IDAT data running out)
+        if (status <= TINFL_STATUS_DONE)
+        {
+            break;
+        }
+    }
+
+    heap_caps_free(rows);
+    if (!ok || png->y < png->height)
+    {
+        lv_draw_buf_destroy(png->buf);
+        return NULL;
+    }
+    return png->buf;
+}
+
+/**
+ * @brief Point a png_t at an image source
+ * @param file Open file for file sources
+ */
+static bool png_source(png_t *png, lv_image_src_t type, const void *src, lv_fs_file_t *file)
+{
+    if (type == LV_IMAGE_SRC_FILE && png_is_file((const char *)src))
+    {
+        png->file = file;
+        return true;
+    }
+    if (type == LV_IMAGE_SRC_VARIABLE && png_is_data((const lv_image_dsc_t *)src))
+    {
+        const lv_image_dsc_t *image = (const lv_image_dsc_t *)src;
+        png->data = image->data;
+        png->size = image->data_size;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Decoder info: size and format from the chunks before the pixels
+ */
+static lv_result_t png_decoder_info(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc,
+                                    lv_image_header_t *header)
+{
+    (void)decoder;
+    png_t png = {};
+
+    // Files are opened and rewound by LVGL
+    if (!png_source(&png, dsc->src_type, dsc->src, &dsc->file) || !png_read_header(&png))
+    {
+        return LV_RESULT_INVALID;
+    }
+
+    lv_color_format_t cf = png.alpha ? LV_COLOR_FORMAT_RGB565A8 : LV_COLOR_FORMAT_RGB565;
+    header->cf = cf;
+    header->w = png.width;
+    header->h = png.height;
+    header->stride = lv_draw_buf_width_to_stride(png.width, cf);
+    return LV_RESULT_OK;
+}
+
+/**
+ * @brief Decoder open: stream the whole picture and add it to the image cache
+ */
+static lv_result_t png_decoder_open(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc)
+{
+    png_t png = {};
+    lv_fs_file_t file;
+
+    if (!png_source(&png, dsc->src_type, dsc->src, &file))
+    {
+        return LV_RESULT_INVALID;
+    }
+    if (png.file != NULL && lv_fs_open(&file, (const char *)dsc->src, LV_FS_MODE_RD) != LV_FS_RES_OK)
+    {
+        return LV_RESULT_INVALID;
+    }
+
+    uint32_t start = micros();
+    lv_draw_buf_t *decoded = NULL;
+    uint32_t work = 0;
+
+    png_work_t *mem = (png_work_t *)png_alloc(sizeof(png_work_t));
+    if (mem != NULL)
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            mem->palette[i][3] = 255;
+        }
+        png.palette = mem->palette;
+        if (png_read_header(&png))
+        {
+            work = sizeof(png_work_t) + 2 * (png.rowBytes + 1);
+            decoded = png_inflate(&png, mem);
+        }
+        heap_caps_free(mem);
+    }
+    if (png.file != NULL)
+    {
+        lv_fs_close(&file);
+    }
+
+    portENTER_CRITICAL(&png_lock);
+    if (decoded != NULL)
+    {
+        png_stats.decoded++;
+        png_stats.lastUs = micros() - start;
+        if (work > png_stats.peakWork)
+        {
+            png_stats.peakWork = work;
+        }
+    }
+    else
+    {
+        png_stats.failed++;
+    }
+    portEXIT_CRITICAL(&png_lock);
+
+    if (decoded == NULL)
+    {
+        return LV_RESULT_INVALID;
+    }
+
+    lv_draw_buf_t *adjusted = lv_image_decoder_post_process(dsc, decoded);
+    if (adjusted == NULL)
+    {
+        lv_draw_buf_destroy(decoded);
+        return LV_RESULT_INVALID;
+    }
+    if (adjusted != decoded)
+    {
+        lv_draw_buf_destroy(decoded);
+        decoded = adjusted;
+    }
+    dsc->decoded = decoded;
+
+    if (dsc->args.no_cache || !lv_image_cache_is_enabled())
+    {
+        return LV_RESULT_OK;
+    }
+
+    // The cache owns the pixels from here and frees them on eviction
+    lv_image_cache_data_t search_key;
+    search_key.src_type = dsc->src_type;
+    search_key.src = dsc->src;
+    search_key.slot.size = decoded->data_size;
+
+    lv_cache_entry_t *entry = lv_image_decoder_add_to_cache(decoder, &search_key, decoded, NULL);
+    if (entry == NULL)
+    {
+        return LV_RESULT_INVALID;
+    }
+    dsc->cache_entry = entry;
+    return LV_RESULT_OK;
+}
+
+/**
+ * @brief Decoder close: free pixels the image cache did not take
+ */
+static void png_decoder_close(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc)
+{
+    (void)decoder;
+    if (dsc->args.no_cache || !lv_image_cache_is_enabled())
+    {
+        lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
+    }
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Register the decoder with LVGL
+ */
+void MAIN_initialise_png_decoder(void)
+{
+    lv_image_decoder_t *decoder = lv_image_decoder_create();
+    if (decoder == NULL)
+    {
+        return;
+    }
+    lv_image_decoder_set_info_cb(decoder, png_decoder_info);
+    lv_image_decoder_set_open_cb(decoder, png_decoder_open);
+    lv_image_decoder_set_close_cb(decoder, png_decoder_close);
+    decoder->name = "PNG stream";
+
+#if EARS_DEBUG == 1
+    Serial.printf("[OK] PNG decoder (streaming, %u bytes working memory)\n", (unsigned)sizeof(png_work_t));
+#endif
+}
+
+/**
+ * @brief Decoder counters
+ */
+void MAIN_png_get_stats(MAIN_png_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+    portENTER_CRITICAL(&png_lock);
+    *stats = png_stats;
+    portEXIT_CRITICAL(&png_lock);
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_PngDecoder_getLibraryName() {
+    return MAIN_PngDecoder::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_PngDecoder_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_PngDecoder::VERSION_MAJOR,
+                       MAIN_PngDecoder::VERSION_MINOR,
+                       MAIN_PngDecoder::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_PngDecoder_getVersionDate() {
+    return MAIN_PngDecoder::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_PngDecoder_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_PngDecoder_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_pngDecoderLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,103 @@
+/**
+ * @file MAIN_pngDecoderLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Streaming PNG decoder for LVGL, row by row into RGB565 / RGB565A8
+ * @details lodepng (LV_USE_LODEPNG) holds the whole PNG file and a full
+ *          ARGB8888 copy of the picture (600 KB at 480x320) before
+ *          converting it. This decoder streams instead:
+ *
+ *          - the file is read PNG_DECODER_INPUT_SIZE bytes at a time
+ *            through lv_fs (the 'S' drive's read cache)
+ *          - IDAT data is inflated by the ROM miniz (tinfl) into its 32 KB
+ *            window
+ *          - each scanline is unfiltered against the previous one and
+ *            written straight into the output draw buffer
+ *
+ *          Working memory is the inflater and its window (about 43 KB,
+ *          PSRAM) plus two scanlines, freed when the picture is done. The
+ *          output goes into the image cache (PSRAM, see MAIN_imageCacheLib)
+ *          as RGB565, or RGB565A8 when the PNG has alpha or a tRNS chunk,
+ *          so nothing comes out of LVGL's pool.
+ *
+ *          All colour types and bit depths are taken (16-bit samples keep
+ *          their high byte). Interlaced (Adam7) PNGs are not: convert them
+ *          on the host. CRCs are not checked; a broken stream fails in the
+ *          inflater.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_PNG_DECODER_LIB_H__
+#define __MAIN_PNG_DECODER_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <lvgl.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_PngDecoder
+{
+    constexpr const char* LIB_NAME = "MAIN_PngDecoder";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_PngDecoder_getLibraryName();
+uint32_t MAIN_PngDecoder_getVersionEncoded();
+const char* MAIN_PngDecoder_getVersionDate();
+void MAIN_PngDecoder_getVersionString(char* buffer);
+
+/******************************************************************************
+ * PNG Decoder Configuration
+ *****************************************************************************/
+
+// Compressed bytes read from the source at a time
+#define PNG_DECODER_INPUT_SIZE 1024
+
+// Largest side decoded (a bigger PNG is left to fail, not to fill PSRAM)
+#define PNG_DECODER_MAX_SIDE 1024
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t decoded;  // Pictures decoded
+    uint32_t failed;   // Corrupt, interlaced, too large or out of memory
+    uint32_t lastUs;   // Time of the last decode
+    uint32_t peakWork; // Largest working memory used by one decode, bytes
+} MAIN_png_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Register the decoder with LVGL
+ * @note Call after the other image decoders: the last registered is tried first.
+ */
+void MAIN_initialise_png_decoder(void);
+
+/**
+ * @brief Decoder counters
+ * @param stats Receives the counters
+ */
+void MAIN_png_get_stats(MAIN_png_stats_t *stats);
+
+#endif // __MAIN_PNG_DECODER_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_pngDecoderLib.h
+ ******************************************************************************/
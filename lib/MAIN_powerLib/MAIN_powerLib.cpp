@@ -0,0 +1,204 @@
+/**
+ * @file MAIN_powerLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Board power states for EARS (panel sleep, CPU scaling, light sleep)
+ * @version 1.0.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_powerLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_screenSaverLib.h"
+#include "EARS_rtosTraceLib.h"
+#include <esp_pm.h>
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static Arduino_GFX *power_gfx = NULL;
+static SemaphoreHandle_t power_display_mutex = NULL;
+static volatile bool power_deep_idle = false;
+static bool power_pm_available = false;
+static uint32_t power_active_freq_mhz = 240;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Apply a CPU frequency range through esp_pm
+ * @param maxMhz Maximum CPU frequency
+ * @param minMhz Minimum CPU frequency
+ * @param lightSleep Allow automatic light sleep when idle
+ * @return esp_err_t Result of esp_pm_configure
+ */
+static esp_err_t power_configure_pm(uint32_t maxMhz, uint32_t minMhz, bool lightSleep)
+{
+    esp_pm_config_esp32s3_t config;
+    config.max_freq_mhz = maxMhz;
+    config.min_freq_mhz = minMhz;
+    config.light_sleep_enable = lightSleep;
+    return esp_pm_configure(&config);
+}
+
+/**
+ * @brief Send the panel sleep/wake command under the display mutex
+ * @param sleep true for SLPIN, false for SLPOUT
+ */
+static void power_panel_sleep(bool sleep)
+{
+    if (power_gfx == NULL || power_display_mutex == NULL)
+    {
+        return;
+    }
+
+    // Waits for any flush still using the bus
+    EARS_RTOS_TRACE_BEGIN(RTOS_TRACE_MUTEX_WAIT);
+    if (xSemaphoreTake(power_display_mutex, portMAX_DELAY) == pdTRUE)
+    {
+        EARS_RTOS_TRACE_END(RTOS_TRACE_MUTEX_WAIT);
+        EARS_RTOS_TRACE_BEGIN(RTOS_TRACE_MUTEX_HOLD);
+        // Arduino_ST7796: displayOff = SLPIN, displayOn = SLPOUT (+120ms)
+        if (sleep)
+        {
+            power_gfx->displayOff();
+        }
+        else
+        {
+            power_gfx->displayOn();
+        }
+        xSemaphoreGive(power_display_mutex);
+        EARS_RTOS_TRACE_END(RTOS_TRACE_MUTEX_HOLD);
+    }
+}
+
+/******************************************************************************
+ * Power Management
+ *****************************************************************************/
+
+/**
+ * @brief Initialise power management and register the deep idle hooks
+ * @param gfx Pointer to Arduino_GFX object (panel sleep commands)
+ * @param displayMutex Mutex guarding the display bus
+ * @return true if esp_pm is available
+ */
+bool MAIN_initialise_power(Arduino_GFX *gfx, SemaphoreHandle_t displayMutex)
+{
+    power_gfx = gfx;
+    power_display_mutex = displayMutex;
+    power_active_freq_mhz = getCpuFrequencyMhz();
+
+    // Full speed while awake; probing here tells us if esp_pm is built in
+    power_pm_available = (power_configure_pm(power_active_freq_mhz, power_active_freq_mhz, false) == ESP_OK);
+
+    using_screensaver().setDeepIdleHooks(MAIN_power_enter_deep_idle, MAIN_power_exit_deep_idle);
+
+#if EARS_DEBUG == 1
+    Serial.printf("[POWER] esp_pm %s, active CPU %lu MHz\n",
+                  power_pm_available ? "available" : "not built in",
+                  (unsigned long)power_active_freq_mhz);
+#endif
+
+    return power_pm_available;
+}
+
+/**
+ * @brief Enter the board deep idle state (screensaver hook)
+ */
+void MAIN_power_enter_deep_idle(void)
+{
+    if (power_deep_idle)
+    {
+        return;
+    }
+
+    power_panel_sleep(true);
+
+    if (power_pm_available)
+    {
+        // Light sleep needs tickless idle; fall back to scaling alone
+        bool lightSleep = (POWER_LIGHT_SLEEP_ENABLED == 1);
+        if (power_configure_pm(POWER_IDLE_MAX_FREQ_MHZ, POWER_IDLE_MIN_FREQ_MHZ, lightSleep) != ESP_OK && lightSleep)
+        {
+            power_configure_pm(POWER_IDLE_MAX_FREQ_MHZ, POWER_IDLE_MIN_FREQ_MHZ, false);
+        }
+    }
+    else
+    {
+        setCpuFrequencyMhz(POWER_IDLE_MAX_FREQ_MHZ);
+    }
+
+    power_deep_idle = true;
+}
+
+/**
+ * @brief Leave the board deep idle state (screensaver hook)
+ */
+void MAIN_power_exit_deep_idle(void)
+{
+    if (!power_deep_idle)
+    {
+        return;
+    }
+
+    // Clock back up first so the panel wake and redraw run at full speed
+    if (power_pm_available)
+    {
+        power_configure_pm(power_active_freq_mhz, power_active_freq_mhz, false);
+    }
+    else
+    {
+        setCpuFrequencyMhz(power_active_freq_mhz);
+    }
+
+    power_panel_sleep(false);
+
+    power_deep_idle = false;
+}
+
+/**
+ * @brief Check if the board is in deep idle
+ * @return true between enter and exit
+ */
+bool MAIN_power_is_deep_idle(void)
+{
+    return power_deep_idle;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Power_getLibraryName() {
+    return MAIN_Power::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Power_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Power::VERSION_MAJOR,
+                       MAIN_Power::VERSION_MINOR,
+                       MAIN_Power::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Power_getVersionDate() {
+    return MAIN_Power::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Power_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Power_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_powerLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,94 @@
+/**
+ * @file MAIN_powerLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Board power states for EARS (panel sleep, CPU scaling, light sleep)
+ * @details Supplies the screensaver's deep idle hooks. On entry the ST7796
+ *          is put into sleep (SLPIN), the CPU is scaled down through esp_pm
+ *          with automatic light sleep, and the touch INT line is armed as a
+ *          GPIO wake source. Exit restores full speed and wakes the panel.
+ *          Light sleep needs CONFIG_PM_ENABLE and tickless idle in the
+ *          framework sdkconfig; without them only the CPU clock is lowered.
+ * @version 1.0.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_POWER_LIB_H__
+#define __MAIN_POWER_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "EARS_versionDef.h"
+#include <Arduino_GFX_Library.h>
+#include "EARS_ws35tlcdPins.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Power
+{
+    constexpr const char* LIB_NAME = "MAIN_Power";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "1";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_Power_getLibraryName();
+uint32_t MAIN_Power_getVersionEncoded();
+const char* MAIN_Power_getVersionDate();
+void MAIN_Power_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Power Configuration
+ *****************************************************************************/
+
+// CPU frequency range while in deep idle (MHz)
+#define POWER_IDLE_MAX_FREQ_MHZ 80
+#define POWER_IDLE_MIN_FREQ_MHZ 40
+
+// Allow automatic light sleep in deep idle (1 = yes)
+#define POWER_LIGHT_SLEEP_ENABLED 1
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Initialise power management and register the deep idle hooks
+ * @param gfx Pointer to Arduino_GFX object (panel sleep commands)
+ * @param displayMutex Mutex guarding the display bus
+ * @return true if esp_pm is available, false if only the CPU clock can be
+ *         lowered
+ */
+bool MAIN_initialise_power(Arduino_GFX *gfx, SemaphoreHandle_t displayMutex);
+
+/**
+ * @brief Enter the board deep idle state (screensaver hook)
+ */
+void MAIN_power_enter_deep_idle(void);
+
+/**
+ * @brief Leave the board deep idle state (screensaver hook)
+ */
+void MAIN_power_exit_deep_idle(void);
+
+/**
+ * @brief Check if the board is in deep idle
+ * @return true between enter and exit
+ */
+bool MAIN_power_is_deep_idle(void);
+
+#endif // __MAIN_POWER_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_powerLib.h
+ ******************************************************************************/
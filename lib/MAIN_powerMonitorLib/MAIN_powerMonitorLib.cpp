@@ -0,0 +1,404 @@
+/**
+ * @file MAIN_powerMonitorLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Battery monitor for EARS (ADC continuous DMA, charge estimate)
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_powerMonitorLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_eventBusLib.h"
+#include "MAIN_jobSchedulerLib.h"
+#include "MAIN_powerLib.h"
+#include <esp_adc_cal.h>
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+#define POWER_MON_FRAME_BYTES (POWER_MON_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES)
+#define POWER_MON_PERCENT_UNKNOWN 255
+
+// Li-ion open-circuit voltage (mV) against charge (percent), ascending
+typedef struct
+{
+    uint16_t mv;
+    uint8_t percent;
+} power_mon_curve_t;
+
+static const power_mon_curve_t power_mon_curve[] = {
+    {3300, 0}, {3610, 5}, {3690, 10}, {3730, 20}, {3770, 30}, {3790, 40},
+    {3820, 50}, {3870, 60}, {3920, 70}, {3980, 80}, {4060, 90}, {4180, 100},
+};
+
+static esp_adc_cal_characteristics_t power_mon_cal;
+static bool power_mon_ready = false;
+static bool power_mon_converting = false;
+static uint32_t power_mon_last_frame_ms = 0;
+static uint8_t power_mon_frame[POWER_MON_FRAME_BYTES];
+
+// Moving average of the pin voltage (Core 1 job only)
+static uint16_t power_mon_window[POWER_MON_AVERAGE];
+static uint32_t power_mon_window_sum = 0;
+static uint8_t power_mon_window_head = 0;
+static uint8_t power_mon_window_count = 0;
+
+// Trend reference for the charge state
+static uint16_t power_mon_trend_mv = 0;
+static uint32_t power_mon_trend_ms = 0;
+
+// Published state; single writer (the job), read from any task
+static volatile uint8_t power_mon_percent = POWER_MON_PERCENT_UNKNOWN;
+static volatile MAIN_battery_state_t power_mon_state = POWER_BATTERY_UNKNOWN;
+static volatile bool power_mon_low = false;
+static MAIN_power_monitor_stats_t power_mon_stats;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Charge from the open-circuit voltage, linear between curve points
+ * @param mv Battery voltage
+ * @return uint8_t 0-100
+ */
+static uint8_t power_mon_percent_from_mv(uint16_t mv)
+{
+    const size_t points = sizeof(power_mon_curve) / sizeof(power_mon_curve[0]);
+    if (mv <= power_mon_curve[0].mv)
+    {
+        return 0;
+    }
+    for (size_t i = 1; i < points; i++)
+    {
+        const power_mon_curve_t *hi = &power_mon_curve[i];
+        if (mv < hi->mv)
+        {
+            const power_mon_curve_t *lo = &power_mon_curve[i - 1];
+            return lo->percent + (uint8_t)((uint32_t)(mv - lo->mv) * (hi->percent - lo->percent) / (hi->mv - lo->mv));
+        }
+    }
+    return 100;
+}
+
+/**
+ * @brief Start or stop the DMA conversions
+ * @param run true to convert
+ */
+static void power_mon_convert(bool run)
+{
+    if (run == power_mon_converting)
+    {
+        return;
+    }
+    if ((run ? adc_digi_start() : adc_digi_stop()) == ESP_OK)
+    {
+        power_mon_converting = run;
+    }
+}
+
+/**
+ * @brief Mean of the frames the DMA pool holds
+ * @param raw Receives the mean raw reading
+ * @return true if any conversion was read
+ */
+static bool power_mon_read_frames(uint32_t *raw)
+{
+    uint32_t sum = 0;
+    uint32_t count = 0;
+
+    // A full pool reports ESP_ERR_INVALID_STATE with valid data; the bound
+    // stops a fast ADC from keeping the job here
+    for (uint8_t frame = 0; frame < POWER_MON_POOL_FRAMES + 1; frame++)
+    {
+        uint32_t got = 0;
+        esp_err_t err = adc_digi_read_bytes(power_mon_frame, sizeof(power_mon_frame), &got, 0);
+        if (err == ESP_ERR_INVALID_STATE)
+        {
+            power_mon_stats.overruns++;
+        }
+        else if (err != ESP_OK)
+        {
+            break;
+        }
+
+        for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= got; i += SOC_ADC_DIGI_RESULT_BYTES)
+        {
+            const adc_digi_output_data_t *result = (const adc_digi_output_data_t *)&power_mon_frame[i];
+            if (result->type2.unit == 0 && result->type2.channel == POWER_MON_ADC_CHANNEL)
+            {
+                sum += result->type2.data;
+                count++;
+            }
+        }
+        power_mon_stats.frames++;
+    }
+
+    if (count == 0)
+    {
+        return false;
+    }
+    power_mon_stats.conversions += count;
+    *raw = sum / count;
+    return true;
+}
+
+/**
+ * @brief Estimate the charge state from the averaged voltage and its trend
+ * @param mv Battery voltage (moving average)
+ * @return MAIN_battery_state_t New state
+ */
+static MAIN_battery_state_t power_mon_estimate_state(uint16_t mv)
+{
+    if (mv < POWER_MON_ABSENT_LOW_MV || mv > POWER_MON_ABSENT_HIGH_MV)
+    {
+        return POWER_BATTERY_ABSENT;
+    }
+
+    uint32_t now = millis();
+    if (power_mon_trend_ms == 0)
+    {
+        power_mon_trend_mv = mv;
+        power_mon_trend_ms = now;
+        return POWER_BATTERY_DISCHARGING;
+    }
+    if (now - power_mon_trend_ms < POWER_MON_TREND_MS && power_mon_state != POWER_BATTERY_UNKNOWN &&
+        power_mon_state != POWER_BATTERY_ABSENT)
+    {
+        return power_mon_state;
+    }
+
+    int32_t rise = (int32_t)mv - (int32_t)power_mon_trend_mv;
+    power_mon_trend_mv = mv;
+    power_mon_trend_ms = now;
+
+    if (rise >= POWER_MON_CHARGE_RISE_MV)
+    {
+        return POWER_BATTERY_CHARGING;
+    }
+    if (mv >= POWER_MON_FULL_MV && rise >= 0 &&
+        (power_mon_state == POWER_BATTERY_CHARGING || power_mon_state == POWER_BATTERY_FULL))
+    {
+        return POWER_BATTERY_FULL;
+    }
+    return POWER_BATTERY_DISCHARGING;
+}
+
+/**
+ * @brief Fold one reading into the average and publish any change
+ * @param raw Mean raw reading of the period
+ */
+static void power_mon_update(uint32_t raw)
+{
+    uint16_t pinMv = (uint16_t)esp_adc_cal_raw_to_voltage(raw, &power_mon_cal);
+
+    if (power_mon_window_count == POWER_MON_AVERAGE)
+    {
+        power_mon_window_sum -= power_mon_window[power_mon_window_head];
+    }
+    else
+    {
+        power_mon_window_count++;
+    }
+    power_mon_window[power_mon_window_head] = pinMv;
+    power_mon_window_sum += pinMv;
+    power_mon_window_head = (power_mon_window_head + 1) % POWER_MON_AVERAGE;
+
+    uint16_t mv = (uint16_t)(power_mon_window_sum / power_mon_window_count * POWER_MON_DIVIDER_NUM / POWER_MON_DIVIDER_DEN);
+    MAIN_battery_state_t state = power_mon_estimate_state(mv);
+    uint8_t percent = (state == POWER_BATTERY_ABSENT) ? POWER_MON_PERCENT_UNKNOWN : power_mon_percent_from_mv(mv);
+    bool charging = (state == POWER_BATTERY_CHARGING || state == POWER_BATTERY_FULL);
+
+    power_mon_stats.pinMv = pinMv;
+    power_mon_stats.batteryMv = mv;
+
+    // Small swings in the charge are noise, not news
+    uint8_t last = power_mon_percent;
+    bool moved = (last == POWER_MON_PERCENT_UNKNOWN || percent == POWER_MON_PERCENT_UNKNOWN)
+                     ? last != percent
+                     : abs((int)percent - (int)last) >= POWER_MON_EVENT_STEP || (percent != last && (percent == 0 || percent == 100));
+    if (!moved && state == power_mon_state)
+    {
+        return;
+    }
+
+    if (moved)
+    {
+        power_mon_percent = percent;
+        last = percent;
+    }
+    power_mon_state = state;
+    power_mon_low = !charging && last <= POWER_MON_LOW_PERCENT;
+    power_mon_stats.critical = !charging && last <= POWER_MON_CRITICAL_PERCENT;
+
+    using_eventbus().post(EVENT_BATTERY, ((uint32_t)state << 8) | last);
+    power_mon_stats.events++;
+
+    DEBUG_PRINTF("[POWER] Battery %u mV, %u%%, state %d\n", mv, last, (int)state);
+}
+
+/**
+ * @brief Core 1 job: read the frames the DMA collected since the last run
+ * @param ctx Unused
+ */
+static void power_mon_job(void *ctx)
+{
+    (void)ctx;
+
+    // The ADC keeps the APB clock up while converting: in deep idle take
+    // one frame per POWER_MON_IDLE_PERIOD_MS and stop again
+    bool idle = MAIN_power_is_deep_idle();
+    if (idle && !power_mon_converting)
+    {
+        if (millis() - power_mon_last_frame_ms >= POWER_MON_IDLE_PERIOD_MS)
+        {
+            power_mon_convert(true);
+        }
+        return;
+    }
+
+    uint32_t raw;
+    if (power_mon_read_frames(&raw))
+    {
+        power_mon_last_frame_ms = millis();
+        power_mon_update(raw);
+    }
+
+    power_mon_convert(!idle);
+}
+
+/******************************************************************************
+ * Power Monitor
+ *****************************************************************************/
+
+/**
+ * @brief Start the ADC conversions and register the Core 1 job
+ * @return true if monitoring
+ */
+bool MAIN_initialise_power_monitor(void)
+{
+#if POWER_MON_ENABLED == 1
+    if (power_mon_ready)
+    {
+        return true;
+    }
+
+    adc_digi_init_config_t init = {};
+    init.max_store_buf_size = POWER_MON_FRAME_BYTES * POWER_MON_POOL_FRAMES;
+    init.conv_num_each_intr = POWER_MON_FRAME_BYTES;
+    init.adc1_chan_mask = BIT(POWER_MON_ADC_CHANNEL);
+    init.adc2_chan_mask = 0;
+    if (adc_digi_initialize(&init) != ESP_OK)
+    {
+        DEBUG_PRINTLN("[POWER] ERROR: ADC DMA driver did not start");
+        return false;
+    }
+
+    adc_digi_pattern_config_t pattern = {};
+    pattern.atten = POWER_MON_ATTEN;
+    pattern.channel = POWER_MON_ADC_CHANNEL;
+    pattern.unit = 0; // ADC1
+    pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+    adc_digi_configuration_t config = {};
+    config.conv_limit_en = false;
+    config.conv_limit_num = 250;
+    config.pattern_num = 1;
+    config.adc_pattern = &pattern;
+    config.sample_freq_hz = POWER_MON_SAMPLE_HZ;
+    config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+    if (adc_digi_controller_configure(&config) != ESP_OK)
+    {
+        adc_digi_deinitialize();
+        DEBUG_PRINTLN("[POWER] ERROR: ADC DMA configuration rejected");
+        return false;
+    }
+
+    // eFuse two-point or Vref calibration, whichever the chip carries
+    esp_adc_cal_characterize(ADC_UNIT_1, POWER_MON_ATTEN, ADC_WIDTH_BIT_12, 1100, &power_mon_cal);
+
+    power_mon_convert(true);
+    power_mon_ready = true;
+
+    DEBUG_PRINTF("[POWER] Battery monitor on ADC1 channel %d, %d Hz DMA, read every %d ms\n",
+                 (int)POWER_MON_ADC_CHANNEL, POWER_MON_SAMPLE_HZ, POWER_MON_PERIOD_MS);
+
+    return MAIN_job_add("power", power_mon_job, NULL, POWER_MON_PERIOD_MS, POWER_MON_PERIOD_MS,
+                        JOB_PRIORITY_LOW, 0) != JOB_INVALID;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Battery charge
+ */
+uint8_t MAIN_power_monitor_get_percent(void)
+{
+    return power_mon_percent;
+}
+
+/**
+ * @brief Estimated charge state
+ */
+MAIN_battery_state_t MAIN_power_monitor_get_state(void)
+{
+    return power_mon_state;
+}
+
+/**
+ * @brief Check for a low battery that is not charging
+ */
+bool MAIN_power_monitor_is_low(void)
+{
+    return power_mon_low;
+}
+
+/**
+ * @brief Readings and counters
+ */
+void MAIN_power_monitor_get_stats(MAIN_power_monitor_stats_t *stats)
+{
+    *stats = power_mon_stats;
+    stats->percent = power_mon_percent;
+    stats->state = power_mon_state;
+    stats->low = power_mon_low;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_PowerMonitor_getLibraryName() {
+    return MAIN_PowerMonitor::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_PowerMonitor_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_PowerMonitor::VERSION_MAJOR,
+                       MAIN_PowerMonitor::VERSION_MINOR,
+                       MAIN_PowerMonitor::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_PowerMonitor_getVersionDate() {
+    return MAIN_PowerMonitor::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_PowerMonitor_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_PowerMonitor_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/******************************************************************************
+ * End of MAIN_powerMonitorLib.cpp
+ ******************************************************************************/
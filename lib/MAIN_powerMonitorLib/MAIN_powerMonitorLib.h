@@ -0,0 +1,164 @@
+/**
+ * @file MAIN_powerMonitorLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Battery monitor for EARS (ADC continuous DMA, charge estimate)
+ * @details The ADC converts the battery divider (POWER_MON_ADC_CHANNEL) in
+ *          continuous mode at POWER_MON_SAMPLE_HZ, and DMA fills frames of
+ *          POWER_MON_FRAME_SAMPLES conversions with no CPU involvement. A
+ *          Core 1 job drains the frames every POWER_MON_PERIOD_MS, converts
+ *          their mean with the eFuse calibration (esp_adc_cal) and keeps a
+ *          moving average over POWER_MON_AVERAGE periods.
+ *
+ *          Charge comes from a Li-ion open-circuit voltage curve. The state
+ *          (discharging, charging, full, no battery) is estimated from the
+ *          voltage trend over POWER_MON_TREND_MS, since the board has no
+ *          charger status line.
+ *
+ *          Changes of state, or of charge by POWER_MON_EVENT_STEP, are
+ *          posted as EVENT_BATTERY (value = state << 8 | percent).
+ *          EARS_backLightManager takes the charge from the event for its
+ *          battery step-down, and the Core 0 refresh governor settles
+ *          untargeted screens to MAIN_REFRESH_STATIC while the battery is
+ *          low and not charging.
+ *
+ *          In deep idle the conversions stop (the ADC driver holds the APB
+ *          frequency while running, which blocks light sleep) and one frame
+ *          is taken every POWER_MON_IDLE_PERIOD_MS instead.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_POWER_MONITOR_LIB_H__
+#define __MAIN_POWER_MONITOR_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include <driver/adc.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_PowerMonitor
+{
+    constexpr const char* LIB_NAME = "MAIN_PowerMonitor";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_PowerMonitor_getLibraryName();
+uint32_t MAIN_PowerMonitor_getVersionEncoded();
+const char* MAIN_PowerMonitor_getVersionDate();
+void MAIN_PowerMonitor_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Power Monitor Configuration
+ *****************************************************************************/
+
+// Battery sense input (BAT_ADC, GPIO4) and its divider:
+// battery mV = pin mV * POWER_MON_DIVIDER_NUM / POWER_MON_DIVIDER_DEN
+#define POWER_MON_ENABLED 1
+#define POWER_MON_ADC_CHANNEL ADC1_CHANNEL_3
+#define POWER_MON_ATTEN ADC_ATTEN_DB_11
+#define POWER_MON_DIVIDER_NUM 3
+#define POWER_MON_DIVIDER_DEN 1
+
+// Conversion rate (611 Hz minimum on the S3) and DMA frame size
+#define POWER_MON_SAMPLE_HZ 1000
+#define POWER_MON_FRAME_SAMPLES 64
+#define POWER_MON_POOL_FRAMES 4           // Frames the driver holds until read
+
+// Core 1 job period, moving average window (job periods) and deep idle period
+#define POWER_MON_PERIOD_MS 1000
+#define POWER_MON_AVERAGE 16
+#define POWER_MON_IDLE_PERIOD_MS 30000
+
+// Charge state estimate
+#define POWER_MON_TREND_MS 60000          // Window the voltage trend is taken over
+#define POWER_MON_CHARGE_RISE_MV 15       // Rise over the window that means charging
+#define POWER_MON_FULL_MV 4150            // At or above and not rising: full on the charger
+#define POWER_MON_ABSENT_LOW_MV 2500      // Outside these: no battery (USB only)
+#define POWER_MON_ABSENT_HIGH_MV 4350
+
+// Thresholds and event hysteresis (percent)
+#define POWER_MON_LOW_PERCENT 20
+#define POWER_MON_CRITICAL_PERCENT 5
+#define POWER_MON_EVENT_STEP 2
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef enum
+{
+    POWER_BATTERY_UNKNOWN = 0,  // No reading yet
+    POWER_BATTERY_DISCHARGING,
+    POWER_BATTERY_CHARGING,
+    POWER_BATTERY_FULL,         // On the charger, charge complete
+    POWER_BATTERY_ABSENT        // Reading outside a cell's range
+} MAIN_battery_state_t;
+
+typedef struct
+{
+    uint16_t batteryMv;         // Moving average, divider applied
+    uint16_t pinMv;             // Last period, at the ADC pin
+    uint8_t percent;            // 0-100, 255 before the first reading
+    MAIN_battery_state_t state;
+    bool low;                   // At or below POWER_MON_LOW_PERCENT, not charging
+    bool critical;              // At or below POWER_MON_CRITICAL_PERCENT, not charging
+    uint32_t frames;            // DMA frames read
+    uint32_t conversions;       // Conversions averaged
+    uint32_t overruns;          // Periods the DMA pool had filled
+    uint32_t events;            // EVENT_BATTERY posted
+} MAIN_power_monitor_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Start the ADC conversions and register the Core 1 job
+ * @return true if monitoring
+ * @note Call after the job scheduler and event bus are running.
+ */
+bool MAIN_initialise_power_monitor(void);
+
+/**
+ * @brief Battery charge
+ * @return uint8_t 0-100, or 255 before the first reading
+ */
+uint8_t MAIN_power_monitor_get_percent(void);
+
+/**
+ * @brief Estimated charge state
+ * @return MAIN_battery_state_t Current state
+ */
+MAIN_battery_state_t MAIN_power_monitor_get_state(void);
+
+/**
+ * @brief Check for a low battery that is not charging
+ * @return true at or below POWER_MON_LOW_PERCENT on battery
+ * @note Any task; a flag read, cheap enough for the refresh governor.
+ */
+bool MAIN_power_monitor_is_low(void);
+
+/**
+ * @brief Readings and counters
+ * @param stats Receives the figures
+ */
+void MAIN_power_monitor_get_stats(MAIN_power_monitor_stats_t *stats);
+
+#endif // __MAIN_POWER_MONITOR_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_powerMonitorLib.h
+ ******************************************************************************/
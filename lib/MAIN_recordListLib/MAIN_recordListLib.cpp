@@ -0,0 +1,707 @@
+/**
+ * @file MAIN_recordListLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Virtualised LVGL list over an EARS_recordStore
+ * @version 1.2.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_recordListLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_rgb888ColoursDef.h"
+#include "MAIN_uiCommandLib.h"
+#include "MAIN_jobSchedulerLib.h"
+#include "MAIN_uiTxnLib.h"
+#include "MAIN_widgetTemplateLib.h"
+#include <esp_heap_caps.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+// Page life: the UI moves EMPTY/READY -> LOADING, the job LOADING -> FETCHING
+// -> READY. The UI never reuses a FETCHING page, the job is writing into it.
+typedef enum
+{
+    LIST_PAGE_EMPTY = 0,
+    LIST_PAGE_LOADING,
+    LIST_PAGE_FETCHING,
+    LIST_PAGE_READY
+} list_page_state_t;
+
+typedef struct
+{
+    volatile uint8_t state;  // list_page_state_t
+    uint8_t count;           // Records held (READY)
+    uint32_t page;           // Page number (position / RECORD_LIST_PAGE_RECORDS)
+    uint32_t lastUse;        // UI task LRU stamp
+    EARS_record *records;    // RECORD_LIST_PAGE_RECORDS, allocated once
+} list_page_t;
+
+typedef struct
+{
+    lv_obj_t *obj;
+    lv_obj_t *title;
+    lv_obj_t *detail;
+    int32_t index;           // Row bound, -1 = none
+    uint32_t id;             // Item ID shown
+    bool placeholder;        // Waiting for its page
+} list_row_t;
+
+typedef struct
+{
+    bool used;
+    volatile uint32_t generation; // Bumped on refresh and delete
+    EARS_recordStore *store;
+    MAIN_record_list_bind_cb_t bind;
+    MAIN_record_list_select_cb_t select;
+    void *ctx;
+
+    lv_obj_t *container;
+    lv_obj_t *spacer;
+    list_row_t rows[RECORD_LIST_MAX_ROWS];
+    uint8_t rowCount;
+    uint32_t count;          // Records in the store at the last refresh
+    uint32_t useClock;
+
+    list_page_t pages[RECORD_LIST_CACHE_PAGES];
+    MAIN_record_list_stats_t stats;
+} record_list_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+// Slots are never freed: the job may still be reading into a deleted list's page
+static record_list_t record_lists[RECORD_LIST_MAX];
+static portMUX_TYPE record_list_mux = portMUX_INITIALIZER_UNLOCKED;
+static MAIN_job_id_t record_list_job = JOB_INVALID;
+
+// Row look, recorded from the first row ever built; every list stamps its rows
+// from it, so it is kept for good
+static MAIN_widget_template_t *record_list_row_template = NULL;
+
+/******************************************************************************
+ * Internal Functions - Core 1
+ *****************************************************************************/
+
+/**
+ * @brief Pages arrived for a list: rebind rows still showing placeholders
+ * @param ctx List slot
+ * @param param Generation the pages were read for
+ * @note Runs on the UI task through MAIN_ui_cmd_call().
+ */
+static void record_list_loaded(void *ctx, uint32_t param);
+
+/**
+ * @brief Read every queued page (Core 1 job)
+ * @param ctx Unused
+ */
+static void record_list_job_fn(void *ctx)
+{
+    (void)ctx;
+
+    for (uint8_t l = 0; l < RECORD_LIST_MAX; l++)
+    {
+        record_list_t *list = &record_lists[l];
+        bool loaded = false;
+        uint32_t generation = 0;
+
+        for (uint8_t p = 0; p < RECORD_LIST_CACHE_PAGES; p++)
+        {
+            list_page_t *page = &list->pages[p];
+            EARS_recordStore *store;
+            uint32_t pageNo;
+
+            portENTER_CRITICAL(&record_list_mux);
+            bool claim = list->used && page->state == LIST_PAGE_LOADING;
+            if (claim)
+            {
+                page->state = LIST_PAGE_FETCHING;
+                generation = list->generation;
+            }
+            store = list->store;
+            pageNo = page->page;
+            portEXIT_CRITICAL(&record_list_mux);
+
+            if (!claim)
+            {
+                continue;
+            }
+
+            uint32_t startUs = micros();
+            size_t got = store->readPage(pageNo * RECORD_LIST_PAGE_RECORDS, page->records,
+                                         RECORD_LIST_PAGE_RECORDS);
+            uint32_t elapsedUs = micros() - startUs;
+
+            portENTER_CRITICAL(&record_list_mux);
+            if (list->generation == generation)
+            {
+                page->count = (uint8_t)got;
+                page->state = LIST_PAGE_READY;
+                loaded = true;
+            }
+            else
+            {
+                // Refreshed or deleted while reading: the records may be stale
+                page->state = LIST_PAGE_EMPTY;
+            }
+            list->stats.pageLoads++;
+            if (elapsedUs > list->stats.maxLoadUs)
+            {
+                list->stats.maxLoadUs = elapsedUs;
+            }
+            portEXIT_CRITICAL(&record_list_mux);
+        }
+
+        if (loaded)
+        {
+            MAIN_ui_cmd_call(record_list_loaded, list, generation);
+        }
+    }
+}
+
+/******************************************************************************
+ * Internal Functions - UI Task
+ *****************************************************************************/
+
+/**
+ * @brief Find the slot of a list container
+ * @param obj Container from MAIN_record_list_create
+ * @return record_list_t* Slot, or NULL if obj is not a record list
+ */
+static record_list_t *record_list_find(lv_obj_t *obj)
+{
+    if (obj == NULL)
+    {
+        return NULL;
+    }
+
+    for (uint8_t l = 0; l < RECORD_LIST_MAX; l++)
+    {
+        if (record_lists[l].used && record_lists[l].container == obj)
+        {
+            return &record_lists[l];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Queue a page unless it is cached or already queued
+ * @param list List slot
+ * @param pageNo Page number
+ */
+static void record_list_request(record_list_t *list, uint32_t pageNo)
+{
+    if ((uint64_t)pageNo * RECORD_LIST_PAGE_RECORDS >= list->count)
+    {
+        return;
+    }
+
+    list_page_t *victim = NULL;
+
+    portENTER_CRITICAL(&record_list_mux);
+    for (uint8_t p = 0; p < RECORD_LIST_CACHE_PAGES; p++)
+    {
+        list_page_t *page = &list->pages[p];
+        if (page->state != LIST_PAGE_EMPTY && page->page == pageNo)
+        {
+            portEXIT_CRITICAL(&record_list_mux);
+            return;
+        }
+    }
+
+    // Empty page first, then the least recently used ready one
+    for (uint8_t p = 0; p < RECORD_LIST_CACHE_PAGES; p++)
+    {
+        list_page_t *page = &list->pages[p];
+        if (page->state == LIST_PAGE_EMPTY)
+        {
+            victim = page;
+            break;
+        }
+        if (page->state == LIST_PAGE_READY && (victim == NULL || page->lastUse < victim->lastUse))
+        {
+            victim = page;
+        }
+    }
+
+    if (victim != NULL)
+    {
+        victim->page = pageNo;
+        victim->count = 0;
+        victim->lastUse = ++list->useClock;
+        victim->state = LIST_PAGE_LOADING;
+    }
+    portEXIT_CRITICAL(&record_list_mux);
+
+    if (victim != NULL && record_list_job != JOB_INVALID)
+    {
+        MAIN_job_trigger(record_list_job);
+    }
+}
+
+/**
+ * @brief Cached record at a row index
+ * @param list List slot
+ * @param index Row index
+ * @return const EARS_record* Record, or NULL if its page is not ready
+ */
+static const EARS_record *record_list_lookup(record_list_t *list, uint32_t index)
+{
+    uint32_t pageNo = index / RECORD_LIST_PAGE_RECORDS;
+    uint32_t offset = index % RECORD_LIST_PAGE_RECORDS;
+
+    for (uint8_t p = 0; p < RECORD_LIST_CACHE_PAGES; p++)
+    {
+        list_page_t *page = &list->pages[p];
+        if (page->state == LIST_PAGE_READY && page->page == pageNo)
+        {
+            page->lastUse = ++list->useClock;
+            return offset < page->count ? &page->records[offset] : NULL;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Default text for equipment and ammunition records
+ */
+static void record_list_default_bind(const EARS_record *record, char *title, char *detail,
+                                     size_t size, void *ctx)
+{
+    (void)ctx;
+
+    if (record->header.type == RECORD_AMMUNITION)
+    {
+        const EARS_ammunitionData *ammo = (const EARS_ammunitionData *)record->payload;
+        snprintf(title, size, "%.16s %.32s", ammo->calibre, ammo->description);
+        snprintf(detail, size, "Lot %.24s  Qty %lu", ammo->lot, (unsigned long)ammo->quantity);
+    }
+    else
+    {
+        const EARS_equipmentData *item = (const EARS_equipmentData *)record->payload;
+        snprintf(title, size, "%.32s", item->name);
+        snprintf(detail, size, "%lu  %.24s  Qty %u", (unsigned long)record->header.id,
+                 item->serial, (unsigned)item->quantity);
+    }
+}
+
+/**
+ * @brief Build one row call by call (the first one, recorded as the template)
+ * @param row Row to fill in
+ * @param parent List container
+ */
+static void record_list_build_row(list_row_t *row, lv_obj_t *parent)
+{
+    row->obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(row->obj);
+    lv_obj_set_size(row->obj, lv_pct(100), RECORD_LIST_ROW_HEIGHT);
+    lv_obj_set_style_pad_hor(row->obj, 6, LV_PART_MAIN);
+    lv_obj_set_style_border_side(row->obj, LV_BORDER_SIDE_BOTTOM, LV_PART_MAIN);
+    lv_obj_set_style_border_width(row->obj, 1, LV_PART_MAIN);
+    lv_obj_set_style_border_color(row->obj, lv_color_hex(EARS_RGB888_CS_BROWN2), LV_PART_MAIN);
+    lv_obj_set_style_bg_color(row->obj, lv_color_hex(EARS_RGB888_CS_PRESSED), LV_STATE_PRESSED);
+    lv_obj_set_style_bg_opa(row->obj, LV_OPA_COVER, LV_STATE_PRESSED);
+    lv_obj_remove_flag(row->obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(row->obj, LV_OBJ_FLAG_HIDDEN);
+
+    row->title = lv_label_create(row->obj);
+    lv_label_set_long_mode(row->title, LV_LABEL_LONG_MODE_CLIP);
+    lv_obj_set_width(row->title, lv_pct(100));
+    lv_obj_set_style_text_color(row->title, lv_color_hex(EARS_RGB888_CS_TEXT), LV_PART_MAIN);
+    lv_obj_align(row->title, LV_ALIGN_TOP_LEFT, 0, 2);
+
+    row->detail = lv_label_create(row->obj);
+    lv_label_set_long_mode(row->detail, LV_LABEL_LONG_MODE_CLIP);
+    lv_obj_set_width(row->detail, lv_pct(100));
+    lv_obj_set_style_text_color(row->detail, lv_color_hex(EARS_RGB888_GRAY), LV_PART_MAIN);
+    lv_obj_align(row->detail, LV_ALIGN_BOTTOM_LEFT, 0, -2);
+}
+
+/**
+ * @brief Place the row pool over the visible indexes and bind their text
+ * @param list List slot
+ * @param force Rebind rows even if their index did not change
+ */
+static void record_list_bind_rows(record_list_t *list, bool force)
+{
+    int32_t scrollY = lv_obj_get_scroll_y(list->container);
+    uint32_t first = scrollY > RECORD_LIST_ROW_HEIGHT ? (uint32_t)scrollY / RECORD_LIST_ROW_HEIGHT - 1 : 0;
+    char title[RECORD_LIST_TEXT_SIZE];
+    char detail[RECORD_LIST_TEXT_SIZE];
+
+    // Up to two labels, a move and a flag per row: one invalidation of the
+    // container at the end instead of one per change
+    MAIN_ui_txn_begin();
+
+    // Each index has a fixed row (index % rowCount), so a scroll only moves
+    // the rows that wrapped around
+    for (uint32_t index = first; index < first + list->rowCount; index++)
+    {
+        list_row_t *row = &list->rows[index % list->rowCount];
+
+        if (index >= list->count)
+        {
+            if (row->index != -1)
+            {
+                lv_obj_add_flag(row->obj, LV_OBJ_FLAG_HIDDEN);
+                row->index = -1;
+            }
+            continue;
+        }
+
+        if (!force && row->index == (int32_t)index && !row->placeholder)
+        {
+            continue;
+        }
+
+        if (row->index != (int32_t)index)
+        {
+            lv_obj_set_y(row->obj, (int32_t)index * RECORD_LIST_ROW_HEIGHT);
+            lv_obj_remove_flag(row->obj, LV_OBJ_FLAG_HIDDEN);
+            row->index = (int32_t)index;
+        }
+
+        const EARS_record *record = record_list_lookup(list, index);
+        if (record == NULL)
+        {
+            if (!row->placeholder || force)
+            {
+                lv_label_set_text(row->title, "...");
+                lv_label_set_text(row->detail, "");
+                row->placeholder = true;
+                list->stats.placeholders++;
+            }
+            record_list_request(list, index / RECORD_LIST_PAGE_RECORDS);
+            continue;
+        }
+
+        title[0] = '\0';
+        detail[0] = '\0';
+        list->bind(record, title, detail, sizeof(title), list->ctx);
+        lv_label_set_text(row->title, title);
+        lv_label_set_text(row->detail, detail);
+        row->id = record->header.id;
+        row->placeholder = false;
+        list->stats.binds++;
+    }
+    MAIN_ui_txn_commit(list->container);
+
+    // Prefetch the pages either side of the window
+    uint32_t firstPage = first / RECORD_LIST_PAGE_RECORDS;
+    uint32_t lastPage = (first + list->rowCount - 1) / RECORD_LIST_PAGE_RECORDS;
+    record_list_request(list, lastPage + 1);
+    if (firstPage > 0)
+    {
+        record_list_request(list, firstPage - 1);
+    }
+}
+
+static void record_list_loaded(void *ctx, uint32_t param)
+{
+    record_list_t *list = (record_list_t *)ctx;
+    if (!list->used || list->generation != param)
+    {
+        return;
+    }
+    record_list_bind_rows(list, false);
+}
+
+/**
+ * @brief Drop every page the job is not reading; mark those it is as stale
+ * @param list List slot
+ */
+static void record_list_invalidate(record_list_t *list)
+{
+    portENTER_CRITICAL(&record_list_mux);
+    list->generation++;
+    for (uint8_t p = 0; p < RECORD_LIST_CACHE_PAGES; p++)
+    {
+        if (list->pages[p].state != LIST_PAGE_FETCHING)
+        {
+            list->pages[p].state = LIST_PAGE_EMPTY;
+        }
+    }
+    portEXIT_CRITICAL(&record_list_mux);
+}
+
+/**
+ * @brief Size the scroll range to the record count
+ * @param list List slot
+ */
+static void record_list_update_spacer(record_list_t *list)
+{
+    int32_t height = (int32_t)list->count * RECORD_LIST_ROW_HEIGHT;
+    lv_obj_set_y(list->spacer, height > 0 ? height - 1 : 0);
+}
+
+/**
+ * @brief Rebind on scroll
+ */
+static void record_list_scroll_cb(lv_event_t *e)
+{
+    record_list_t *list = (record_list_t *)lv_event_get_user_data(e);
+    record_list_bind_rows(list, false);
+}
+
+/**
+ * @brief Row tapped: report its item ID
+ */
+static void record_list_click_cb(lv_event_t *e)
+{
+    record_list_t *list = (record_list_t *)lv_event_get_user_data(e);
+    lv_obj_t *target = (lv_obj_t *)lv_event_get_current_target(e);
+
+    for (uint8_t r = 0; r < list->rowCount; r++)
+    {
+        list_row_t *row = &list->rows[r];
+        if (row->obj == target && row->index >= 0 && !row->placeholder)
+        {
+            list->select(row->id, list->ctx);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Container deleted (e.g. with its screen): free the slot
+ */
+static void record_list_delete_cb(lv_event_t *e)
+{
+    record_list_t *list = (record_list_t *)lv_event_get_user_data(e);
+
+    record_list_invalidate(list);
+    portENTER_CRITICAL(&record_list_mux);
+    list->used = false;
+    portEXIT_CRITICAL(&record_list_mux);
+    list->container = NULL;
+}
+
+/**
+ * @brief Allocate a slot's page buffers once, PSRAM first
+ * @param list List slot
+ * @return true if every page has a buffer
+ */
+static bool record_list_alloc_pages(record_list_t *list)
+{
+    const size_t bytes = sizeof(EARS_record) * RECORD_LIST_PAGE_RECORDS;
+
+    for (uint8_t p = 0; p < RECORD_LIST_CACHE_PAGES; p++)
+    {
+        list_page_t *page = &list->pages[p];
+        if (page->records != NULL)
+        {
+            continue;
+        }
+        page->records = (EARS_record *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (page->records == NULL)
+        {
+            page->records = (EARS_record *)heap_caps_malloc(bytes, MALLOC_CAP_8BIT);
+        }
+        if (page->records == NULL)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+lv_obj_t *MAIN_record_list_create(lv_obj_t *parent, EARS_recordStore *store,
+                                  MAIN_record_list_bind_cb_t bind,
+                                  MAIN_record_list_select_cb_t select, void *ctx)
+{
+    if (parent == NULL || store == NULL || !store->isReady())
+    {
+        return NULL;
+    }
+
+    record_list_t *list = NULL;
+    for (uint8_t l = 0; l < RECORD_LIST_MAX; l++)
+    {
+        if (!record_lists[l].used)
+        {
+            list = &record_lists[l];
+            break;
+        }
+    }
+    if (list == NULL)
+    {
+        Serial.println("[RLIST] ERROR: No free list slot");
+        return NULL;
+    }
+    if (!record_list_alloc_pages(list))
+    {
+        Serial.println("[RLIST] ERROR: No memory for the page cache");
+        return NULL;
+    }
+
+    if (record_list_job == JOB_INVALID)
+    {
+        record_list_job = MAIN_job_add("recordlist", record_list_job_fn, NULL, 0,
+                                       RECORD_LIST_JOB_PERIOD_MS, JOB_PRIORITY_NORMAL, 0);
+    }
+
+    // A page still FETCHING for the slot's previous list is left to the job
+    record_list_invalidate(list);
+    list->store = store;
+    list->bind = bind != NULL ? bind : record_list_default_bind;
+    list->select = select;
+    list->ctx = ctx;
+    list->count = store->count();
+    list->useClock = 0;
+    memset(&list->stats, 0, sizeof(list->stats));
+
+    lv_obj_t *container = lv_obj_create(parent);
+    lv_obj_set_size(container, lv_pct(100), lv_pct(100));
+    lv_obj_set_style_pad_all(container, 0, LV_PART_MAIN);
+    lv_obj_set_style_border_width(container, 0, LV_PART_MAIN);
+    lv_obj_set_style_radius(container, 0, LV_PART_MAIN);
+    lv_obj_set_style_bg_color(container, lv_color_hex(EARS_RGB888_TRUE_BLACK), LV_PART_MAIN);
+    lv_obj_set_scroll_dir(container, LV_DIR_VER);
+    lv_obj_update_layout(container);
+    list->container = container;
+
+    list->spacer = lv_obj_create(container);
+    lv_obj_remove_style_all(list->spacer);
+    lv_obj_set_size(list->spacer, 1, 1);
+    lv_obj_remove_flag(list->spacer, LV_OBJ_FLAG_CLICKABLE);
+    record_list_update_spacer(list);
+
+    int32_t visible = lv_obj_get_content_height(container) / RECORD_LIST_ROW_HEIGHT + 1;
+    int32_t rows = visible + RECORD_LIST_OVERSCAN;
+    list->rowCount = (uint8_t)(rows > RECORD_LIST_MAX_ROWS ? RECORD_LIST_MAX_ROWS : rows);
+
+    for (uint8_t r = 0; r < list->rowCount; r++)
+    {
+        list_row_t *row = &list->rows[r];
+
+        if (record_list_row_template != NULL)
+        {
+            row->obj = MAIN_widget_template_stamp(record_list_row_template, container);
+            row->title = lv_obj_get_child(row->obj, 0);
+            row->detail = lv_obj_get_child(row->obj, 1);
+        }
+        else
+        {
+            record_list_build_row(row, container);
+            record_list_row_template = MAIN_widget_template_record(row->obj);
+        }
+
+        if (select != NULL)
+        {
+            lv_obj_add_event_cb(row->obj, record_list_click_cb, LV_EVENT_CLICKED, list);
+        }
+        else
+        {
+            lv_obj_remove_flag(row->obj, LV_OBJ_FLAG_CLICKABLE);
+        }
+
+        row->index = -1;
+        row->id = 0;
+        row->placeholder = false;
+    }
+
+    lv_obj_add_event_cb(container, record_list_scroll_cb, LV_EVENT_SCROLL, list);
+    lv_obj_add_event_cb(container, record_list_delete_cb, LV_EVENT_DELETE, list);
+
+    portENTER_CRITICAL(&record_list_mux);
+    list->used = true;
+    portEXIT_CRITICAL(&record_list_mux);
+
+    record_list_bind_rows(list, true);
+
+#if EARS_DEBUG == 1
+    Serial.printf("[RLIST] List of %lu records, %u rows\n", (unsigned long)list->count,
+                  (unsigned)list->rowCount);
+#endif
+
+    return container;
+}
+
+void MAIN_record_list_refresh(lv_obj_t *obj)
+{
+    record_list_t *list = record_list_find(obj);
+    if (list == NULL)
+    {
+        return;
+    }
+
+    record_list_invalidate(list);
+    list->count = list->store->count();
+    record_list_update_spacer(list);
+
+    // Scroll position may now be past the end; LVGL clamps it on the next layout
+    lv_obj_update_layout(list->container);
+    record_list_bind_rows(list, true);
+}
+
+void MAIN_record_list_scroll_to(lv_obj_t *obj, uint32_t index)
+{
+    record_list_t *list = record_list_find(obj);
+    if (list == NULL)
+    {
+        return;
+    }
+
+    // Queue the target page before the scroll event asks for it
+    record_list_request(list, index / RECORD_LIST_PAGE_RECORDS);
+    lv_obj_scroll_to_y(list->container, (int32_t)index * RECORD_LIST_ROW_HEIGHT, LV_ANIM_OFF);
+    record_list_bind_rows(list, false);
+}
+
+bool MAIN_record_list_get_stats(lv_obj_t *obj, MAIN_record_list_stats_t *stats)
+{
+    record_list_t *list = record_list_find(obj);
+    if (list == NULL || stats == NULL)
+    {
+        return false;
+    }
+
+    portENTER_CRITICAL(&record_list_mux);
+    *stats = list->stats;
+    portEXIT_CRITICAL(&record_list_mux);
+    return true;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_RecordList_getLibraryName() {
+    return MAIN_RecordList::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_RecordList_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_RecordList::VERSION_MAJOR,
+                       MAIN_RecordList::VERSION_MINOR,
+                       MAIN_RecordList::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_RecordList_getVersionDate() {
+    return MAIN_RecordList::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_RecordList_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_RecordList_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_recordListLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,146 @@
+/**
+ * @file MAIN_recordListLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Virtualised LVGL list over an EARS_recordStore
+ * @details The list never creates one object per record. It keeps a fixed
+ *          pool of row objects (enough to cover the visible height plus
+ *          RECORD_LIST_OVERSCAN), positions them absolutely inside a
+ *          scrollable container and, on every scroll, moves the rows that
+ *          left the viewport to the indexes that entered it and rebinds
+ *          their text. A 1 px spacer at the bottom gives the container the
+ *          full scroll height (count x RECORD_LIST_ROW_HEIGHT).
+ *
+ *          Records come from a small page cache (RECORD_LIST_CACHE_PAGES
+ *          pages of RECORD_LIST_PAGE_RECORDS, in PSRAM). The UI task never
+ *          reads the SD card: a row whose page is missing shows a
+ *          placeholder and queues the page, the "recordlist" job on Core 1
+ *          reads it with EARS_recordStore::readPage() and posts a rebind
+ *          through MAIN_uiCommandLib. The page after (or before) the
+ *          visible window is queued at the same time, so steady scrolling
+ *          finds it ready. Each rebind is one UI transaction
+ *          (MAIN_uiTxnLib): one invalidation of the list, not one per label.
+ *          The first row is built call by call and recorded as a widget
+ *          template (MAIN_widgetTemplateLib); every other row is stamped.
+ *
+ *          Create, refresh and delete lists from the UI task only.
+ * @version 1.2.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_RECORD_LIST_LIB_H__
+#define __MAIN_RECORD_LIST_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include <lvgl.h>
+#include "EARS_recordStoreLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_RecordList
+{
+    constexpr const char* LIB_NAME = "MAIN_RecordList";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "2";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_RecordList_getLibraryName();
+uint32_t MAIN_RecordList_getVersionEncoded();
+const char* MAIN_RecordList_getVersionDate();
+void MAIN_RecordList_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+#define RECORD_LIST_MAX 2               // Lists alive at once
+#define RECORD_LIST_ROW_HEIGHT 36       // Pixels per row
+#define RECORD_LIST_OVERSCAN 2          // Rows kept beyond the visible height
+#define RECORD_LIST_MAX_ROWS 16         // Row pool limit (480 px / 36 + overscan)
+#define RECORD_LIST_PAGE_RECORDS 16     // Records per cached page
+#define RECORD_LIST_CACHE_PAGES 4       // Pages cached per list
+#define RECORD_LIST_JOB_PERIOD_MS 1000  // Core 1 fetch job poll; page requests trigger it at once
+#define RECORD_LIST_TEXT_SIZE 48        // Title/detail buffer per row
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+/**
+ * @brief Fill a row's two lines from a record (UI task)
+ * @param record Record for the row
+ * @param title Main line
+ * @param detail Second line (smaller, may be left empty)
+ * @param size Size of each buffer (RECORD_LIST_TEXT_SIZE)
+ * @param ctx Context given to MAIN_record_list_create
+ */
+typedef void (*MAIN_record_list_bind_cb_t)(const EARS_record *record, char *title, char *detail,
+                                           size_t size, void *ctx);
+
+/**
+ * @brief A row was tapped (UI task)
+ * @param id Item ID of the row's record
+ * @param ctx Context given to MAIN_record_list_create
+ */
+typedef void (*MAIN_record_list_select_cb_t)(uint32_t id, void *ctx);
+
+typedef struct
+{
+    uint32_t binds;       // Rows bound from the cache
+    uint32_t placeholders; // Rows bound before their page arrived
+    uint32_t pageLoads;   // Pages read on Core 1
+    uint32_t maxLoadUs;   // Slowest page read
+} MAIN_record_list_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Create a virtualised list filling its parent
+ * @param parent Parent object
+ * @param store Record store to show (must be ready)
+ * @param bind Row formatter, NULL for the default equipment/ammunition text
+ * @param select Tap handler, NULL for none
+ * @param ctx Passed to bind and select
+ * @return lv_obj_t* The list container, NULL if RECORD_LIST_MAX lists exist
+ */
+lv_obj_t *MAIN_record_list_create(lv_obj_t *parent, EARS_recordStore *store,
+                                  MAIN_record_list_bind_cb_t bind,
+                                  MAIN_record_list_select_cb_t select, void *ctx);
+
+/**
+ * @brief Drop cached pages and re-read the count after the store changed
+ * @param list List from MAIN_record_list_create
+ */
+void MAIN_record_list_refresh(lv_obj_t *list);
+
+/**
+ * @brief Scroll so a row index is at the top
+ * @param list List from MAIN_record_list_create
+ * @param index Row index (position in ID order)
+ */
+void MAIN_record_list_scroll_to(lv_obj_t *list, uint32_t index);
+
+/**
+ * @brief Counters of one list
+ * @param list List from MAIN_record_list_create
+ * @param stats Receives the counters
+ * @return true if list is a record list
+ */
+bool MAIN_record_list_get_stats(lv_obj_t *list, MAIN_record_list_stats_t *stats);
+
+#endif // __MAIN_RECORD_LIST_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_recordListLib.h
+ ******************************************************************************/
@@ -0,0 +1,509 @@
+/**
+ * @file MAIN_resumeLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Deep sleep with a fast resume of the screen that was showing
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_resumeLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_flashFsLib.h"
+#include "EARS_sdCardLib.h"
+#include "EARS_screenSaverLib.h"
+#include "MAIN_animationLib.h"
+#include <esp_attr.h>
+#include <esp_sleep.h>
+#include <esp_timer.h>
+#include <esp_heap_caps.h>
+#include <esp_rom_crc.h>
+#include <driver/rtc_io.h>
+
+// Flow screens (src/ui/eez-flow.cpp)
+extern "C" int16_t eez_flow_get_current_screen();
+extern "C" void eez_flow_set_screen(int16_t screenId, lv_scr_load_anim_t animType, uint32_t speed, uint32_t delay);
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+// "RSM1": the RTC record below is complete
+#define RESUME_MAGIC 0x314D5352UL
+
+typedef struct
+{
+    uint32_t magic;
+    int16_t screen;         // Flow screen ID, 0 = none
+    uint16_t width;         // Snapshot size, 0 = no snapshot
+    uint16_t height;
+    uint32_t snapshotBytes;
+    uint32_t snapshotCrc;
+    uint32_t varMask;       // Bit per slot holding a value
+    int32_t vars[RESUME_VARS];
+} resume_rtc_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+// Kept through deep sleep, zero after power-on
+RTC_DATA_ATTR static resume_rtc_t resume_rtc;
+RTC_DATA_ATTR static uint32_t resume_sleeps = 0;
+
+// This boot's copy, taken once (the RTC record is cleared as it is read)
+static resume_rtc_t resume_saved;
+static int8_t resume_wake = -1;
+
+static int32_t *resume_vars[RESUME_VARS];
+static MAIN_resume_stats_t resume_stats;
+static uint32_t resume_idle_start = 0;
+
+// Wake frame: drawn by the splash, then an image on the boot screen
+static uint16_t *resume_frame = NULL;
+static lv_image_dsc_t resume_frame_dsc;
+static lv_obj_t *resume_image = NULL;
+
+/******************************************************************************
+ * Static Functions
+ *****************************************************************************/
+
+/**
+ * @brief Compress one RGB565 row (literal and run opcodes only)
+ * @return uint8_t* End of the row's opcodes, or NULL if out would overflow
+ */
+static uint8_t *resume_encode_row(const uint16_t *row, uint16_t width, uint8_t *out, const uint8_t *end)
+{
+    uint16_t x = 0;
+    while (x < width)
+    {
+        // Room for the longest opcode
+        if (end - out < 1 + 64 * ANIM_BYTES_PER_PIXEL)
+        {
+            return NULL;
+        }
+
+        uint16_t run = 1;
+        while (x + run < width && run < 64 && row[x + run] == row[x])
+        {
+            run++;
+        }
+        if (run >= 2)
+        {
+            *out++ = ANIM_OP_RUN | (run - 1);
+            *out++ = row[x] & 0xFF;
+            *out++ = row[x] >> 8;
+            x += run;
+            continue;
+        }
+
+        // Literal up to where the next run starts
+        uint16_t start = x;
+        uint16_t count = 0;
+        while (x < width && count < 64)
+        {
+            if (x + 1 < width && row[x + 1] == row[x])
+            {
+                break;
+            }
+            x++;
+            count++;
+        }
+        *out++ = ANIM_OP_LITERAL | (count - 1);
+        memcpy(out, &row[start], count * ANIM_BYTES_PER_PIXEL);
+        out += count * ANIM_BYTES_PER_PIXEL;
+    }
+    return out;
+}
+
+/**
+ * @brief Expand one row written by resume_encode_row
+ * @return true if the row was complete and in bounds
+ */
+static bool resume_decode_row(const uint8_t **src, const uint8_t *end, uint16_t *row, uint16_t width)
+{
+    const uint8_t *p = *src;
+    uint16_t x = 0;
+
+    while (x < width)
+    {
+        if (p >= end)
+        {
+            return false;
+        }
+
+        uint8_t op = *p++;
+        uint16_t count = ANIM_OP_COUNT(op);
+        if (count > width - x)
+        {
+            return false;
+        }
+
+        if ((op & ANIM_OP_MASK) == ANIM_OP_LITERAL)
+        {
+            if ((uint32_t)(end - p) < (uint32_t)count * ANIM_BYTES_PER_PIXEL)
+            {
+                return false;
+            }
+            memcpy(&row[x], p, count * ANIM_BYTES_PER_PIXEL);
+            p += count * ANIM_BYTES_PER_PIXEL;
+        }
+        else if ((op & ANIM_OP_MASK) == ANIM_OP_RUN)
+        {
+            if (end - p < ANIM_BYTES_PER_PIXEL)
+            {
+                return false;
+            }
+            uint16_t colour = (uint16_t)(p[0] | (p[1] << 8));
+            p += ANIM_BYTES_PER_PIXEL;
+            for (uint16_t i = 0; i < count; i++)
+            {
+                row[x + i] = colour;
+            }
+        }
+        else
+        {
+            return false;
+        }
+        x += count;
+    }
+
+    *src = p;
+    return true;
+}
+
+/**
+ * @brief Snapshot a screen and write it compressed to LittleFS
+ * @return true if the file and the RTC size and CRC are written
+ */
+static bool resume_save_snapshot(lv_obj_t *screen)
+{
+    int32_t w = lv_display_get_horizontal_resolution(NULL);
+    int32_t h = lv_display_get_vertical_resolution(NULL);
+    uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+    uint32_t size = stride * h + LV_DRAW_BUF_ALIGN;
+
+    uint8_t *memory = (uint8_t *)heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    uint8_t *packed = (uint8_t *)heap_caps_malloc(RESUME_SNAPSHOT_MAX_BYTES, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    lv_draw_buf_t buf;
+    bool ok = memory != NULL && packed != NULL &&
+              lv_draw_buf_init(&buf, w, h, LV_COLOR_FORMAT_RGB565, stride, memory, size) == LV_RESULT_OK &&
+              lv_snapshot_take_to_draw_buf(screen, LV_COLOR_FORMAT_RGB565, &buf) == LV_RESULT_OK;
+
+    uint8_t *out = packed;
+    for (int32_t y = 0; ok && y < h; y++)
+    {
+        out = resume_encode_row((const uint16_t *)(buf.data + y * buf.header.stride), w,
+                                out, packed + RESUME_SNAPSHOT_MAX_BYTES);
+        ok = out != NULL;
+    }
+
+    if (ok)
+    {
+        // The old copy goes first, so the partition never holds two
+        uint32_t length = out - packed;
+        using_flashfs().removeFile(RESUME_SNAPSHOT_PATH);
+        ok = using_flashfs().writeFileAtomic(RESUME_SNAPSHOT_PATH, packed, length);
+        if (ok)
+        {
+            resume_rtc.width = w;
+            resume_rtc.height = h;
+            resume_rtc.snapshotBytes = length;
+            resume_rtc.snapshotCrc = esp_rom_crc32_le(0, packed, length);
+            resume_stats.snapshotBytes = length;
+        }
+    }
+
+    heap_caps_free(packed);
+    heap_caps_free(memory);
+    return ok;
+}
+
+/**
+ * @brief Remove the snapshot image from the boot screen and free the frame
+ */
+static void resume_detach_snapshot(void)
+{
+    if (resume_image != NULL)
+    {
+        lv_obj_delete(resume_image);
+    }
+    if (resume_frame != NULL)
+    {
+        lv_image_cache_drop(&resume_frame_dsc);
+        heap_caps_free(resume_frame);
+        resume_frame = NULL;
+    }
+}
+
+/**
+ * @brief The image went with its screen (or by resume_detach_snapshot)
+ */
+static void resume_image_delete_cb(lv_event_t *e)
+{
+    (void)e;
+    resume_image = NULL;
+}
+
+static void resume_hold_timer_cb(lv_timer_t *timer)
+{
+    lv_timer_delete(timer);
+    resume_detach_snapshot();
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Check whether this boot is a touch wake with saved state
+ */
+bool MAIN_resume_is_wake(void)
+{
+    if (resume_wake < 0)
+    {
+        resume_wake = (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_EXT0 && resume_rtc.magic == RESUME_MAGIC);
+        if (resume_wake)
+        {
+            resume_saved = resume_rtc;
+            resume_stats.resumed = true;
+            resume_stats.screen = resume_saved.screen;
+        }
+
+        // One resume per sleep: a later reset boots normally
+        resume_rtc.magic = 0;
+    }
+    return resume_wake == 1;
+}
+
+/**
+ * @brief Draw the saved snapshot on the panel
+ */
+bool MAIN_resume_show_snapshot(Arduino_GFX *gfx)
+{
+    if (!MAIN_resume_is_wake() || resume_saved.width == 0 || resume_frame != NULL)
+    {
+        return false;
+    }
+    if (resume_saved.width != gfx->width() || resume_saved.height != gfx->height())
+    {
+        return false;
+    }
+
+    uint32_t start = (uint32_t)esp_timer_get_time();
+    if (!using_flashfs().begin())
+    {
+        return false;
+    }
+
+    uint32_t length = resume_saved.snapshotBytes;
+    uint8_t *packed = (uint8_t *)heap_caps_malloc(length, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    resume_frame = (uint16_t *)heap_caps_malloc((uint32_t)resume_saved.width * resume_saved.height * 2,
+                                                MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    bool ok = packed != NULL && resume_frame != NULL &&
+              using_flashfs().readInto(RESUME_SNAPSHOT_PATH, packed, length) == length &&
+              esp_rom_crc32_le(0, packed, length) == resume_saved.snapshotCrc;
+
+    const uint8_t *src = packed;
+    for (uint16_t y = 0; ok && y < resume_saved.height; y++)
+    {
+        ok = resume_decode_row(&src, packed + length, resume_frame + y * resume_saved.width, resume_saved.width);
+    }
+    heap_caps_free(packed);
+
+    if (!ok)
+    {
+        DEBUG_PRINTF("[WARN] Resume snapshot unreadable, using the splash\n");
+        heap_caps_free(resume_frame);
+        resume_frame = NULL;
+        return false;
+    }
+
+    gfx->draw16bitRGBBitmap(0, 0, resume_frame, resume_saved.width, resume_saved.height);
+    resume_stats.snapshotBytes = length;
+    resume_stats.showUs = (uint32_t)esp_timer_get_time() - start;
+
+    DEBUG_PRINTF("[OK] Resume snapshot (%lu bytes, %lu us)\n", (unsigned long)length,
+                 (unsigned long)resume_stats.showUs);
+    return true;
+}
+
+/**
+ * @brief Show the drawn snapshot on an LVGL screen
+ */
+bool MAIN_resume_attach_snapshot(lv_obj_t *screen)
+{
+    if (resume_frame == NULL || resume_image != NULL)
+    {
+        return false;
+    }
+
+    memset(&resume_frame_dsc, 0, sizeof(resume_frame_dsc));
+    resume_frame_dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    resume_frame_dsc.header.cf = LV_COLOR_FORMAT_RGB565;
+    resume_frame_dsc.header.w = resume_saved.width;
+    resume_frame_dsc.header.h = resume_saved.height;
+    resume_frame_dsc.header.stride = resume_saved.width * 2;
+    resume_frame_dsc.data = (const uint8_t *)resume_frame;
+    resume_frame_dsc.data_size = (uint32_t)resume_saved.width * resume_saved.height * 2;
+
+    resume_image = lv_image_create(screen);
+    lv_image_set_src(resume_image, &resume_frame_dsc);
+    lv_obj_set_pos(resume_image, 0, 0);
+    lv_obj_add_event_cb(resume_image, resume_image_delete_cb, LV_EVENT_DELETE, NULL);
+
+    lv_timer_create(resume_hold_timer_cb, RESUME_SNAPSHOT_HOLD_MS, NULL);
+    return true;
+}
+
+/**
+ * @brief Keep a variable across deep sleep
+ */
+void MAIN_resume_keep(uint8_t slot, int32_t *value)
+{
+    if (slot >= RESUME_VARS)
+    {
+        return;
+    }
+    resume_vars[slot] = value;
+
+    if (value != NULL && MAIN_resume_is_wake() && (resume_saved.varMask & (1UL << slot)))
+    {
+        *value = resume_saved.vars[slot];
+    }
+}
+
+/**
+ * @brief Load the flow screen that was showing when the board slept
+ */
+bool MAIN_resume_restore_screen(void)
+{
+    if (!MAIN_resume_is_wake() || resume_saved.screen <= 0)
+    {
+        return false;
+    }
+
+    // Created now if it is not yet: the others wait for their first load
+    eez_flow_set_screen(resume_saved.screen, LV_SCR_LOAD_ANIM_NONE, 0, 0);
+    resume_detach_snapshot();
+    return true;
+}
+
+/**
+ * @brief Count deep idle time and sleep once it reaches RESUME_SLEEP_AFTER_S
+ */
+void MAIN_resume_update(void)
+{
+#if EARS_DEEP_SLEEP == 1
+    if (!using_screensaver().isDeepIdle())
+    {
+        resume_idle_start = 0;
+        return;
+    }
+
+    uint32_t now = millis();
+    if (resume_idle_start == 0)
+    {
+        resume_idle_start = now | 1;
+    }
+    else if (now - resume_idle_start >= (uint32_t)RESUME_SLEEP_AFTER_S * 1000)
+    {
+        MAIN_resume_sleep();
+    }
+#endif
+}
+
+/**
+ * @brief Save the UI state and deep sleep until the screen is touched
+ */
+void MAIN_resume_sleep(void)
+{
+    memset(&resume_rtc, 0, sizeof(resume_rtc));
+    resume_rtc.screen = eez_flow_get_current_screen();
+
+    for (uint8_t slot = 0; slot < RESUME_VARS; slot++)
+    {
+        if (resume_vars[slot] != NULL)
+        {
+            resume_rtc.vars[slot] = *resume_vars[slot];
+            resume_rtc.varMask |= 1UL << slot;
+        }
+    }
+
+    // The UI under the screensaver, not the screensaver
+    lv_obj_t *screen = using_screensaver().getCoveredScreen();
+    if (screen == NULL)
+    {
+        screen = lv_screen_active();
+    }
+    if (!resume_save_snapshot(screen))
+    {
+        // Wakes to the saved screen without a picture first
+        resume_rtc.width = 0;
+        DEBUG_PRINTF("[WARN] Resume snapshot not saved\n");
+    }
+
+    resume_rtc.magic = RESUME_MAGIC;
+    resume_sleeps++;
+
+    // Buffered writes would be lost with the power
+    using_sdcard().flush();
+    using_flashfs().flush();
+
+    DEBUG_PRINTF("[POWER] Deep sleep (screen %d, snapshot %lu bytes)\n", resume_rtc.screen,
+                 (unsigned long)resume_rtc.snapshotBytes);
+
+    rtc_gpio_pullup_en((gpio_num_t)RESUME_WAKE_PIN);
+    rtc_gpio_pulldown_dis((gpio_num_t)RESUME_WAKE_PIN);
+    esp_sleep_enable_ext0_wakeup((gpio_num_t)RESUME_WAKE_PIN, 0);
+    esp_deep_sleep_start();
+}
+
+/**
+ * @brief Resume counters
+ */
+void MAIN_resume_get_stats(MAIN_resume_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+    *stats = resume_stats;
+    stats->sleeps = resume_sleeps;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Resume_getLibraryName() {
+    return MAIN_Resume::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Resume_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Resume::VERSION_MAJOR,
+                       MAIN_Resume::VERSION_MINOR,
+                       MAIN_Resume::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Resume_getVersionDate() {
+    return MAIN_Resume::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Resume_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Resume_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_resumeLib.cpp
+ ******************************************************************************/
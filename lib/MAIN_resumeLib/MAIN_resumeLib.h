@@ -0,0 +1,170 @@
+/**
+ * @file MAIN_resumeLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Deep sleep with a fast resume of the screen that was showing
+ * @details With -D EARS_DEEP_SLEEP=1 the board goes from deep idle (see
+ *          EARS_screenSaverLib) into deep sleep after RESUME_SLEEP_AFTER_S,
+ *          and a touch wakes it through the TOUCH_INT line (ext0). A wake
+ *          is a reset, so before sleeping this library keeps:
+ *
+ *          - in RTC slow memory: the flow screen ID, the variables
+ *            registered with MAIN_resume_keep() and the snapshot's size
+ *            and CRC (RTC slow memory is 8 KB and PSRAM loses power, so
+ *            neither holds the picture)
+ *          - in LittleFS (RESUME_SNAPSHOT_PATH): the screen under the
+ *            screensaver, taken with lv_snapshot and compressed row by row
+ *            in the animation opcode format (MAIN_animationLib), typically
+ *            20-60 KB for a UI screen against 300 KB raw
+ *
+ *          On the wake, MAIN_splash_show() draws the snapshot in place of
+ *          the splash, a few hundred ms after reset, and the boot screen
+ *          shows it (MAIN_resume_attach_snapshot) in place of the startup
+ *          animation. Registered variables get their values back as they
+ *          are registered, and MAIN_resume_restore_screen() loads the saved
+ *          flow screen directly: EEZ creates screens when first loaded, so
+ *          only that one is built.
+ *
+ *          A power-on, a reset or a wake by anything but the touch line is
+ *          a normal boot.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_RESUME_LIB_H__
+#define __MAIN_RESUME_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <Arduino_GFX_Library.h>
+#include <lvgl.h>
+#include "EARS_versionDef.h"
+#include "EARS_ws35tlcdPins.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Resume
+{
+    constexpr const char* LIB_NAME = "MAIN_Resume";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_Resume_getLibraryName();
+uint32_t MAIN_Resume_getVersionEncoded();
+const char* MAIN_Resume_getVersionDate();
+void MAIN_Resume_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Resume Configuration
+ *****************************************************************************/
+
+// 1 = deep sleep after RESUME_SLEEP_AFTER_S of deep idle
+#ifndef EARS_DEEP_SLEEP
+#define EARS_DEEP_SLEEP 0
+#endif
+
+// Seconds of deep idle before deep sleep
+#define RESUME_SLEEP_AFTER_S 300
+
+// Touch controller INT, held low while touched in POWER_MONITOR (RTC GPIO)
+#define RESUME_WAKE_PIN TOUCH_INT
+
+// Compressed snapshot on LittleFS, and the most it may take there
+#define RESUME_SNAPSHOT_PATH "/resume.rle"
+#define RESUME_SNAPSHOT_MAX_BYTES (64 * 1024)
+
+// Snapshot left on the boot screen if MAIN_resume_restore_screen() is not called
+#define RESUME_SNAPSHOT_HOLD_MS 3000
+
+// Variable slots kept in RTC slow memory
+#define RESUME_VARS 16
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    bool resumed;           // This boot is a wake from deep sleep
+    int16_t screen;         // Flow screen ID being restored (0 = none)
+    uint32_t snapshotBytes; // Compressed snapshot, written or read
+    uint32_t showUs;        // Read, decode and draw of the snapshot on wake
+    uint32_t sleeps;        // Deep sleeps since power-on
+} MAIN_resume_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Check whether this boot is a touch wake with saved state
+ * @return true on a wake from MAIN_resume_sleep()
+ */
+bool MAIN_resume_is_wake(void);
+
+/**
+ * @brief Draw the saved snapshot on the panel
+ * @param gfx Display, initialised and rotated
+ * @return true if drawn (false: not a wake, or the snapshot is missing,
+ *         corrupt or for another screen size)
+ * @note Boot only, before LVGL owns the display (MAIN_splash_show calls it).
+ *       Mounts LittleFS if the flashfs boot stage has not yet.
+ */
+bool MAIN_resume_show_snapshot(Arduino_GFX *gfx);
+
+/**
+ * @brief Show the drawn snapshot on an LVGL screen, so the first frame matches
+ * @param screen Usually lv_screen_active() during boot
+ * @return true if the snapshot was drawn earlier and is now on the screen
+ * @note Removed by MAIN_resume_restore_screen(), or after RESUME_SNAPSHOT_HOLD_MS.
+ */
+bool MAIN_resume_attach_snapshot(lv_obj_t *screen);
+
+/**
+ * @brief Keep a variable across deep sleep
+ * @param slot 0 .. RESUME_VARS-1, the same for the variable in every build
+ * @param value Variable (such as a native flow variable's storage); on a wake
+ *              it is given its saved value now
+ */
+void MAIN_resume_keep(uint8_t slot, int32_t *value);
+
+/**
+ * @brief Load the flow screen that was showing when the board slept
+ * @return true if a screen was loaded (false on a normal boot)
+ * @note Call from the LVGL task after ui_init().
+ */
+bool MAIN_resume_restore_screen(void);
+
+/**
+ * @brief Count deep idle time and sleep once it reaches RESUME_SLEEP_AFTER_S
+ * @note Call from the LVGL task after the screensaver update. Does nothing
+ *       unless EARS_DEEP_SLEEP is 1.
+ */
+void MAIN_resume_update(void);
+
+/**
+ * @brief Save the UI state and deep sleep until the screen is touched
+ * @note Call from the LVGL task. Does not return.
+ */
+void MAIN_resume_sleep(void);
+
+/**
+ * @brief Resume counters
+ * @param stats Receives the counters
+ */
+void MAIN_resume_get_stats(MAIN_resume_stats_t *stats);
+
+#endif // __MAIN_RESUME_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_resumeLib.h
+ ******************************************************************************/
@@ -0,0 +1,139 @@
+/**
+ * @file MAIN_rtosStaticLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Statically allocated tasks, and the Arduino loop task reclaimed
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_rtosStaticLib.h"
+#include "EARS_systemDef.h"
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    const char *name;
+    TaskHandle_t handle;
+    uint32_t stackDepth;
+} rtos_static_task_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static rtos_static_task_t rtos_static_tasks[RTOS_STATIC_MAX_TASKS];
+static uint8_t rtos_static_task_count = 0;
+static portMUX_TYPE rtos_static_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Create a pinned task in caller-provided memory, and register it
+ */
+TaskHandle_t MAIN_rtos_create_static_task(TaskFunction_t fn, const char *name, uint32_t stackDepth, void *param,
+                                          UBaseType_t priority, StackType_t *stack, StaticTask_t *tcb,
+                                          BaseType_t core)
+{
+    TaskHandle_t handle = xTaskCreateStaticPinnedToCore(fn, name, stackDepth, param, priority, stack, tcb, core);
+    if (handle == NULL)
+    {
+        return NULL;
+    }
+
+    portENTER_CRITICAL(&rtos_static_lock);
+    if (rtos_static_task_count < RTOS_STATIC_MAX_TASKS)
+    {
+        rtos_static_task_t *task = &rtos_static_tasks[rtos_static_task_count++];
+        task->name = name;
+        task->handle = handle;
+        task->stackDepth = stackDepth;
+    }
+    portEXIT_CRITICAL(&rtos_static_lock);
+
+    return handle;
+}
+
+/**
+ * @brief Print each static task's stack use and a suggested size to Serial
+ */
+void MAIN_rtos_static_report(void)
+{
+    uint32_t total = 0;
+    Serial.println("[RTOS] Static task       stack   free   used  suggested");
+
+    for (uint8_t i = 0; i < rtos_static_task_count; i++)
+    {
+        const rtos_static_task_t *task = &rtos_static_tasks[i];
+        uint32_t free = uxTaskGetStackHighWaterMark(task->handle) * sizeof(StackType_t);
+        uint32_t size = task->stackDepth * sizeof(StackType_t);
+        uint32_t used = size - free;
+        uint32_t suggested = (used + RTOS_STATIC_STACK_MARGIN + RTOS_STATIC_STACK_ROUND - 1) /
+                             RTOS_STATIC_STACK_ROUND * RTOS_STATIC_STACK_ROUND;
+        total += size;
+
+        Serial.printf("[RTOS] %-16s %6lu %6lu %6lu %10lu\n", task->name, (unsigned long)size,
+                      (unsigned long)free, (unsigned long)used, (unsigned long)suggested);
+    }
+
+    Serial.printf("[RTOS] %u static tasks, %lu bytes of stack outside the heap\n", rtos_static_task_count,
+                  (unsigned long)total);
+}
+
+/**
+ * @brief End the Arduino loop task (call from loop())
+ */
+void MAIN_rtos_end_loop_task(void)
+{
+#if EARS_DEBUG == 1
+    // Only setup() ran on this stack: size ARDUINO_LOOP_STACK_SIZE from it
+    uint32_t free = uxTaskGetStackHighWaterMark(NULL) * sizeof(StackType_t);
+    Serial.printf("[RTOS] Loop task ended: setup() used %lu of %lu bytes of stack\n",
+                  (unsigned long)(getArduinoLoopTaskStackSize() - free),
+                  (unsigned long)getArduinoLoopTaskStackSize());
+    MAIN_rtos_static_report();
+#endif
+
+    vTaskDelete(NULL);
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_RtosStatic_getLibraryName() {
+    return MAIN_RtosStatic::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_RtosStatic_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_RtosStatic::VERSION_MAJOR,
+                       MAIN_RtosStatic::VERSION_MINOR,
+                       MAIN_RtosStatic::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_RtosStatic_getVersionDate() {
+    return MAIN_RtosStatic::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_RtosStatic_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_RtosStatic_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_rtosStaticLib.cpp
+ ******************************************************************************/
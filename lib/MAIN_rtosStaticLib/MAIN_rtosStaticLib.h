@@ -0,0 +1,125 @@
+/**
+ * @file MAIN_rtosStaticLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Statically allocated tasks, and the Arduino loop task reclaimed
+ * @details Long-lived tasks declare their stack and TCB at file scope with
+ *          MAIN_STATIC_TASK and start with MAIN_STATIC_TASK_CREATE
+ *          (xTaskCreateStaticPinnedToCore). Their memory is placed in
+ *          internal RAM by the linker, so it never comes out of the heap,
+ *          creation cannot fail for want of memory and the boot sequence
+ *          leaves no holes between them. Queues and semaphores created
+ *          once at boot use the matching *CreateStatic calls next to their
+ *          handles.
+ *
+ *          Each static task is registered, and MAIN_rtos_static_report()
+ *          prints its stack size, high-water mark and a size with
+ *          RTOS_STATIC_STACK_MARGIN spare, to retune the *_STACK_SIZE
+ *          defines from a long run.
+ *
+ *          The Arduino loop task only runs setup(); loop() ends it with
+ *          MAIN_rtos_end_loop_task(), which returns its ARDUINO_LOOP_STACK_SIZE
+ *          stack to the heap and prints how much of it setup() used.
+ *
+ *          On ESP-IDF StackType_t is one byte and stack depths are in bytes.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_RTOS_STATIC_LIB_H__
+#define __MAIN_RTOS_STATIC_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_RtosStatic
+{
+    constexpr const char* LIB_NAME = "MAIN_RtosStatic";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_RtosStatic_getLibraryName();
+uint32_t MAIN_RtosStatic_getVersionEncoded();
+const char* MAIN_RtosStatic_getVersionDate();
+void MAIN_RtosStatic_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Static RTOS Configuration
+ *****************************************************************************/
+
+// Static tasks registered for the report
+#define RTOS_STATIC_MAX_TASKS 8
+
+// Spare stack kept above the high-water mark in the suggested size
+#define RTOS_STATIC_STACK_MARGIN 1024
+
+// Suggested sizes are rounded up to this
+#define RTOS_STATIC_STACK_ROUND 512
+
+/**
+ * Stack and TCB for one task, at file scope
+ * @param var Name prefix (var_stack, var_tcb)
+ * @param stackSize Stack depth (bytes on ESP-IDF)
+ */
+#define MAIN_STATIC_TASK(var, stackSize)            \
+    static StackType_t var##_stack[(stackSize)];   \
+    static StaticTask_t var##_tcb
+
+/**
+ * Create a task declared with MAIN_STATIC_TASK
+ * @return TaskHandle_t The task (NULL only for bad arguments)
+ */
+#define MAIN_STATIC_TASK_CREATE(var, fn, name, param, priority, core)                                  \
+    MAIN_rtos_create_static_task((fn), (name), sizeof(var##_stack) / sizeof(var##_stack[0]), (param), \
+                                 (priority), var##_stack, &var##_tcb, (core))
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Create a pinned task in caller-provided memory, and register it
+ * @param fn Task function
+ * @param name Task name
+ * @param stackDepth Entries in stack
+ * @param param Passed to fn
+ * @param priority FreeRTOS priority
+ * @param stack Stack buffer
+ * @param tcb Task control block
+ * @param core Core to pin to
+ * @return TaskHandle_t The task, or NULL
+ */
+TaskHandle_t MAIN_rtos_create_static_task(TaskFunction_t fn, const char *name, uint32_t stackDepth, void *param,
+                                          UBaseType_t priority, StackType_t *stack, StaticTask_t *tcb,
+                                          BaseType_t core);
+
+/**
+ * @brief Print each static task's stack use and a suggested size to Serial
+ */
+void MAIN_rtos_static_report(void);
+
+/**
+ * @brief End the Arduino loop task (call from loop())
+ * @note Does not return. Prints the loop task's high-water mark first.
+ */
+void MAIN_rtos_end_loop_task(void);
+
+#endif // __MAIN_RTOS_STATIC_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_rtosStaticLib.h
+ ******************************************************************************/
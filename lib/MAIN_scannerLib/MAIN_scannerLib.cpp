@@ -0,0 +1,518 @@
+/**
+ * @file MAIN_scannerLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Barcode and QR scanner input with record lookup
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_scannerLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_ws35tlcdPins.h"
+#include "EARS_searchIndexLib.h"
+#include "MAIN_uiCommandLib.h"
+#include <driver/uart.h>
+#include <driver/gpio.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include <atomic>
+
+static_assert((SCANNER_RESULT_SLOTS & (SCANNER_RESULT_SLOTS - 1)) == 0,
+              "SCANNER_RESULT_SLOTS must be a power of two");
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+// Sequence 0 while the scanner task writes the slot
+typedef struct
+{
+    std::atomic<uint32_t> sequence;
+    MAIN_scan_result_t result;
+} scanner_slot_t;
+
+typedef struct
+{
+    const char *wanted;         // Normalised code
+    uint16_t matches;
+    MAIN_scan_result_t *result;
+    EARS_record candidate;
+} scanner_match_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static portMUX_TYPE scanner_mux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t scanner_task_handle = NULL;
+static QueueHandle_t scanner_uart_events = NULL;
+static volatile MAIN_scan_handler_t scanner_handler = NULL;
+
+static scanner_slot_t scanner_slots[SCANNER_RESULT_SLOTS];
+static uint32_t scanner_next = 1;           // Scanner task only
+
+static char scanner_last_code[SCANNER_CODE_SIZE];
+static uint32_t scanner_last_ms = 0;
+
+static MAIN_scanner_stats_t scanner_stats;
+
+/******************************************************************************
+ * Internal Functions - Lookup
+ *****************************************************************************/
+
+/**
+ * @brief Parse an item ID: decimal digits only
+ * @return true if text is a number that fits 32 bits
+ */
+static bool scanner_parse_id(const char *text, uint32_t *id)
+{
+    if (*text == '\0')
+    {
+        return false;
+    }
+
+    uint64_t value = 0;
+    for (; *text != '\0'; text++)
+    {
+        if (*text < '0' || *text > '9')
+        {
+            return false;
+        }
+        value = value * 10 + (*text - '0');
+        if (value > 0xFFFFFFFFULL)
+        {
+            return false;
+        }
+    }
+    *id = (uint32_t)value;
+    return true;
+}
+
+/**
+ * @brief Letters and digits only, lower case, as the search index keeps them
+ */
+static void scanner_normalise(const char *text, size_t length, char *out, size_t size)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < length && text[i] != '\0' && n < size - 1; i++)
+    {
+        char c = text[i];
+        if (c >= 'A' && c <= 'Z')
+        {
+            out[n++] = c - 'A' + 'a';
+        }
+        else if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9'))
+        {
+            out[n++] = c;
+        }
+    }
+    out[n] = '\0';
+}
+
+/**
+ * @brief Search callback: keep the candidates whose serial or NSN is the code
+ */
+static bool scanner_match(const uint32_t *ids, uint16_t count, void *ctx)
+{
+    scanner_match_t *match = (scanner_match_t *)ctx;
+    char field[SCANNER_CODE_SIZE];
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        if (!using_equipment().get(ids[i], match->candidate))
+        {
+            continue;
+        }
+
+        const EARS_equipmentData *data = (const EARS_equipmentData *)match->candidate.payload;
+        scanner_normalise(data->serial, sizeof(data->serial), field, sizeof(field));
+        bool same = strcmp(field, match->wanted) == 0;
+        if (!same)
+        {
+            scanner_normalise(data->nsn, sizeof(data->nsn), field, sizeof(field));
+            same = strcmp(field, match->wanted) == 0;
+        }
+
+        if (same)
+        {
+            if (match->matches == 0)
+            {
+                match->result->record = match->candidate;
+            }
+            match->matches++;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Find the item a code names
+ * @param result code in, everything else out
+ */
+static void scanner_lookup(MAIN_scan_result_t *result)
+{
+    const char *code = result->code;
+    EARS_recordStore &equipment = using_equipment();
+    EARS_recordStore &ammunition = using_ammunition();
+    uint32_t id;
+
+    int64_t startUs = esp_timer_get_time();
+    result->matches = 0;
+
+    // "E123" / "A123": that store; "123": equipment, then ammunition
+    char prefix = code[0] & ~0x20;
+    if ((prefix == 'E' || prefix == 'A') && scanner_parse_id(code + 1, &id))
+    {
+        EARS_recordStore &store = prefix == 'E' ? equipment : ammunition;
+        if (store.isReady() && store.get(id, result->record))
+        {
+            result->matches = 1;
+        }
+    }
+    else if (scanner_parse_id(code, &id))
+    {
+        if ((equipment.isReady() && equipment.get(id, result->record)) ||
+            (ammunition.isReady() && ammunition.get(id, result->record)))
+        {
+            result->matches = 1;
+        }
+    }
+
+    // Otherwise a serial number or NSN
+    if (result->matches == 0 && using_equipment_search().isReady())
+    {
+        char wanted[SCANNER_CODE_SIZE];
+        scanner_normalise(code, SCANNER_CODE_SIZE, wanted, sizeof(wanted));
+        // Most codes at a stock check are new: the filter says so from RAM
+        if (wanted[0] != '\0' && using_equipment_search().mayContain(wanted))
+        {
+            static scanner_match_t match; // Scanner task only; keeps the stack small
+            match.wanted = wanted;
+            match.matches = 0;
+            match.result = result;
+            using_equipment_search().search(code, scanner_match, &match, SCANNER_SEARCH_MAX);
+            result->matches = match.matches;
+        }
+    }
+
+    if (result->matches == 0)
+    {
+        result->status = SCAN_NOT_FOUND;
+        memset(&result->record, 0, sizeof(result->record));
+    }
+    else
+    {
+        result->status = result->matches == 1 ? SCAN_FOUND : SCAN_AMBIGUOUS;
+    }
+    result->lookupUs = (uint32_t)(esp_timer_get_time() - startUs);
+}
+
+/******************************************************************************
+ * Internal Functions - UI Task
+ *****************************************************************************/
+
+/**
+ * @brief Hand one result to the handler (UI task, through MAIN_ui_cmd_call)
+ * @param param Sequence number of the result
+ */
+static void scanner_deliver(void *ctx, uint32_t param)
+{
+    (void)ctx;
+    scanner_slot_t *slot = &scanner_slots[param & (SCANNER_RESULT_SLOTS - 1)];
+
+    // Copy, then check the scanner task did not reuse the slot meanwhile
+    MAIN_scan_result_t result;
+    bool current = slot->sequence.load(std::memory_order_acquire) == param;
+    if (current)
+    {
+        result = slot->result;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        current = slot->sequence.load(std::memory_order_relaxed) == param;
+    }
+
+    uint32_t latencyUs = current ? (uint32_t)esp_timer_get_time() - result.receivedUs : 0;
+    portENTER_CRITICAL(&scanner_mux);
+    if (current)
+    {
+        scanner_stats.scans++;
+        scanner_stats.lastLatencyUs = latencyUs;
+        if (latencyUs > scanner_stats.peakLatencyUs)
+        {
+            scanner_stats.peakLatencyUs = latencyUs;
+        }
+    }
+    else
+    {
+        scanner_stats.overruns++;
+    }
+    portEXIT_CRITICAL(&scanner_mux);
+
+    MAIN_scan_handler_t handler = scanner_handler;
+    if (current && handler != NULL)
+    {
+        handler(&result);
+    }
+}
+
+/******************************************************************************
+ * Internal Functions - Scanner Task
+ *****************************************************************************/
+
+/**
+ * @brief One complete code: dedupe, look up, post to the UI
+ */
+static void scanner_handle_code(const char *code)
+{
+    uint32_t receivedUs = (uint32_t)esp_timer_get_time();
+    uint32_t nowMs = millis();
+
+    // A repeat keeps the window open, so a held trigger counts once
+    if (strcmp(code, scanner_last_code) == 0 && nowMs - scanner_last_ms < SCANNER_DEDUPE_MS)
+    {
+        scanner_last_ms = nowMs;
+        portENTER_CRITICAL(&scanner_mux);
+        scanner_stats.duplicates++;
+        portEXIT_CRITICAL(&scanner_mux);
+        return;
+    }
+    strncpy(scanner_last_code, code, sizeof(scanner_last_code));
+    scanner_last_ms = nowMs;
+
+    uint32_t sequence = scanner_next++;
+    if (scanner_next == 0)
+    {
+        scanner_next = 1;
+    }
+
+    scanner_slot_t *slot = &scanner_slots[sequence & (SCANNER_RESULT_SLOTS - 1)];
+    slot->sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    MAIN_scan_result_t *result = &slot->result;
+    strncpy(result->code, code, sizeof(result->code));
+    result->receivedUs = receivedUs;
+    scanner_lookup(result);
+
+    slot->sequence.store(sequence, std::memory_order_release);
+
+    if (!MAIN_ui_cmd_call(scanner_deliver, NULL, sequence))
+    {
+        portENTER_CRITICAL(&scanner_mux);
+        scanner_stats.dropped++;
+        portEXIT_CRITICAL(&scanner_mux);
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[SCANNER] \"%s\": %u match(es) in %lu us\n", code, result->matches,
+                  (unsigned long)result->lookupUs);
+#endif
+}
+
+/**
+ * @brief Scanner task: cut UART bursts into codes
+ * @param parameter Task parameter (unused)
+ */
+static void scanner_task(void *parameter)
+{
+    (void)parameter;
+    uart_event_t event;
+    uint8_t chunk[64];
+    char code[SCANNER_CODE_SIZE];
+    size_t length = 0;
+    bool overlong = false;
+
+    while (1)
+    {
+        if (xQueueReceive(scanner_uart_events, &event, portMAX_DELAY) != pdTRUE)
+        {
+            continue;
+        }
+
+        if (event.type == UART_FIFO_OVF || event.type == UART_BUFFER_FULL)
+        {
+            // Whatever was partly received is lost; start clean
+            uart_flush_input(SCANNER_UART_NUM);
+            xQueueReset(scanner_uart_events);
+            length = 0;
+            overlong = false;
+            portENTER_CRITICAL(&scanner_mux);
+            scanner_stats.overruns++;
+            portEXIT_CRITICAL(&scanner_mux);
+            continue;
+        }
+        if (event.type != UART_DATA)
+        {
+            continue;
+        }
+
+        size_t pending = event.size;
+        while (pending > 0)
+        {
+            int got = uart_read_bytes(SCANNER_UART_NUM, chunk, pending < sizeof(chunk) ? pending : sizeof(chunk), 0);
+            if (got <= 0)
+            {
+                break;
+            }
+            pending -= got;
+
+            for (int i = 0; i < got; i++)
+            {
+                char c = (char)chunk[i];
+                if (c == '\r' || c == '\n')
+                {
+                    // CR, LF or both end a code; empty lines are skipped
+                    if (overlong)
+                    {
+                        portENTER_CRITICAL(&scanner_mux);
+                        scanner_stats.oversize++;
+                        portEXIT_CRITICAL(&scanner_mux);
+                    }
+                    else if (length > 0)
+                    {
+                        code[length] = '\0';
+                        scanner_handle_code(code);
+                    }
+                    length = 0;
+                    overlong = false;
+                }
+                else if ((uint8_t)c < 0x20)
+                {
+                    // AIM identifiers' controls, GS1 separators: not part of the lookup
+                }
+                else if (length < SCANNER_CODE_SIZE - 1)
+                {
+                    code[length++] = c;
+                }
+                else
+                {
+                    overlong = true;
+                }
+            }
+        }
+    }
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+bool MAIN_initialise_scanner(void)
+{
+    if (scanner_task_handle != NULL)
+    {
+        return true;
+    }
+
+    for (uint8_t i = 0; i < SCANNER_RESULT_SLOTS; i++)
+    {
+        scanner_slots[i].sequence.store(0, std::memory_order_relaxed);
+    }
+
+    uart_config_t config = {};
+    config.baud_rate = SCANNER_BAUD_RATE;
+    config.data_bits = UART_DATA_8_BITS;
+    config.parity = UART_PARITY_DISABLE;
+    config.stop_bits = UART_STOP_BITS_1;
+    config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+    config.source_clk = UART_SCLK_APB;
+
+    if (uart_driver_install(SCANNER_UART_NUM, SCANNER_RX_BUFFER_SIZE, 0, SCANNER_EVENT_QUEUE_SIZE,
+                            &scanner_uart_events, 0) != ESP_OK)
+    {
+        Serial.println("[SCANNER] ERROR: UART driver install failed");
+        return false;
+    }
+    if (uart_param_config(SCANNER_UART_NUM, &config) != ESP_OK ||
+        uart_set_pin(SCANNER_UART_NUM, SCANNER_UART_TX, SCANNER_UART_RX, UART_PIN_NO_CHANGE,
+                     UART_PIN_NO_CHANGE) != ESP_OK ||
+        uart_set_rx_timeout(SCANNER_UART_NUM, SCANNER_RX_TIMEOUT_SYMBOLS) != ESP_OK)
+    {
+        Serial.println("[SCANNER] ERROR: UART configuration failed");
+        uart_driver_delete(SCANNER_UART_NUM);
+        return false;
+    }
+
+    // No scanner plugged in: keep the line idle instead of reading noise
+    gpio_set_pull_mode((gpio_num_t)SCANNER_UART_RX, GPIO_PULLUP_ONLY);
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        scanner_task,
+        "Scanner",
+        SCANNER_TASK_STACK_SIZE,
+        NULL,
+        SCANNER_TASK_PRIORITY,
+        &scanner_task_handle,
+        SCANNER_TASK_CORE);
+
+    if (result != pdPASS || scanner_task_handle == NULL)
+    {
+        scanner_task_handle = NULL;
+        uart_driver_delete(SCANNER_UART_NUM);
+#if EARS_DEBUG == 1
+        Serial.println("[ERROR] Failed to create scanner task!");
+#endif
+        return false;
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[SCANNER] UART%d at %d baud, RX GPIO%d\n", SCANNER_UART_NUM, SCANNER_BAUD_RATE,
+                  SCANNER_UART_RX);
+#endif
+    return true;
+}
+
+void MAIN_scanner_set_handler(MAIN_scan_handler_t handler)
+{
+    scanner_handler = handler;
+}
+
+void MAIN_scanner_get_stats(MAIN_scanner_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&scanner_mux);
+    *stats = scanner_stats;
+    portEXIT_CRITICAL(&scanner_mux);
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Scanner_getLibraryName() {
+    return MAIN_Scanner::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Scanner_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Scanner::VERSION_MAJOR,
+                       MAIN_Scanner::VERSION_MINOR,
+                       MAIN_Scanner::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Scanner_getVersionDate() {
+    return MAIN_Scanner::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Scanner_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Scanner_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_scannerLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,150 @@
+/**
+ * @file MAIN_scannerLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Barcode and QR scanner input with record lookup
+ * @details A serial barcode scanner on SCANNER_UART_NUM sends each code as
+ *          one burst ending in CR and/or LF. The UART driver moves the bytes
+ *          from the RX FIFO into its ring buffer from the interrupt, and an
+ *          RX timeout of SCANNER_RX_TIMEOUT_SYMBOLS character times raises
+ *          the data event as soon as a burst ends, so a code reaches the
+ *          "Scanner" task on Core 1 within a few milliseconds of its last
+ *          character rather than after the default ten.
+ *
+ *          The task cuts the stream into codes, drops a repeat of the last
+ *          code within SCANNER_DEDUPE_MS (scanners in continuous mode, a
+ *          double trigger), and looks the code up in the record stores:
+ *
+ *            "E123" / "A123"   equipment / ammunition item ID
+ *            "123"             item ID, equipment first
+ *            anything else     equipment serial number or NSN, through the
+ *                              search index, compared exactly (case and
+ *                              punctuation ignored); a code the index's
+ *                              presence filter rules out is not found
+ *                              without a search or a record read
+ *
+ *          An ID is one binary search in the RAM index and one 128-byte
+ *          read. The result goes into a small ring and its number to the
+ *          UI task through MAIN_ui_cmd_call(), which wakes it; the handler
+ *          set with MAIN_scanner_set_handler() then runs on the UI task
+ *          before the next frame, so it may update LVGL directly.
+ *
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_SCANNER_LIB_H__
+#define __MAIN_SCANNER_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include "EARS_taskPlanLib.h"
+#include "EARS_recordStoreLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Scanner
+{
+    constexpr const char* LIB_NAME = "MAIN_Scanner";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "1";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_Scanner_getLibraryName();
+uint32_t MAIN_Scanner_getVersionEncoded();
+const char* MAIN_Scanner_getVersionDate();
+void MAIN_Scanner_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+#define SCANNER_UART_NUM 1
+#define SCANNER_BAUD_RATE 9600          // Factory default of most scanners
+#define SCANNER_RX_BUFFER_SIZE 512      // UART driver ring
+#define SCANNER_RX_TIMEOUT_SYMBOLS 2    // Idle character times that end a burst
+#define SCANNER_EVENT_QUEUE_SIZE 16     // UART driver events
+#define SCANNER_CODE_SIZE 48            // Longest code + NUL; longer ones are dropped
+#define SCANNER_DEDUPE_MS 1500          // Same code again within this is ignored
+#define SCANNER_RESULT_SLOTS 4          // Results waiting for the UI (power of 2)
+#define SCANNER_SEARCH_MAX 16           // Serial/NSN candidates compared exactly
+
+// Scanner task
+#define SCANNER_TASK_CORE using_taskplan().core(TASK_ROLE_SCANNER)
+#define SCANNER_TASK_PRIORITY using_taskplan().priority(TASK_ROLE_SCANNER) // A scan waits on nothing
+#define SCANNER_TASK_STACK_SIZE 4096
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef enum
+{
+    SCAN_FOUND = 0,             // record holds the item
+    SCAN_NOT_FOUND,
+    SCAN_AMBIGUOUS              // Several items share the serial; record is the first
+} MAIN_scan_status_t;
+
+typedef struct
+{
+    char code[SCANNER_CODE_SIZE];
+    uint8_t status;             // MAIN_scan_status_t
+    uint16_t matches;           // Items matching the code
+    uint32_t receivedUs;        // esp_timer time the code was complete
+    uint32_t lookupUs;          // Time spent in the stores
+    EARS_record record;         // header.type tells the store
+} MAIN_scan_result_t;
+
+/**
+ * @brief Receives each scan (UI task)
+ * @param result Valid for the call only
+ */
+typedef void (*MAIN_scan_handler_t)(const MAIN_scan_result_t *result);
+
+typedef struct
+{
+    uint32_t scans;             // Codes handed to the UI
+    uint32_t duplicates;        // Repeats inside SCANNER_DEDUPE_MS
+    uint32_t oversize;          // Codes longer than SCANNER_CODE_SIZE - 1
+    uint32_t overruns;          // UART buffer overflows, or results overwritten before the UI ran
+    uint32_t dropped;           // UI command queue full
+    uint32_t lastLatencyUs;     // Code complete to handler, last scan
+    uint32_t peakLatencyUs;
+} MAIN_scanner_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Install the UART driver and start the scanner task
+ * @return true if running
+ * @note Call after MAIN_initialise_records().
+ */
+bool MAIN_initialise_scanner(void);
+
+/**
+ * @brief Set the function receiving scans on the UI task
+ * @param handler Handler, or NULL to discard scans
+ */
+void MAIN_scanner_set_handler(MAIN_scan_handler_t handler);
+
+/**
+ * @brief Scanner counters
+ * @param stats Receives the counters
+ */
+void MAIN_scanner_get_stats(MAIN_scanner_stats_t *stats);
+
+#endif // __MAIN_SCANNER_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_scannerLib.h
+ ******************************************************************************/
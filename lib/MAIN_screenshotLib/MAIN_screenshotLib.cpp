@@ -0,0 +1,343 @@
+/**
+ * @file MAIN_screenshotLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Screenshots to the SD card, streamed from the flush path
+ * @version 1.0.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_screenshotLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_sdCardLib.h"
+#include "MAIN_jobSchedulerLib.h"
+#include "MAIN_lvglLib.h"
+#include "MAIN_uiCommandLib.h"
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+typedef enum
+{
+    SHOT_IDLE = 0,
+    SHOT_PREPARING, // Job: name and header
+    SHOT_ARMING,    // UI task: invalidate and tap
+    SHOT_CAPTURING, // Tap filling slots, job writing them
+    SHOT_WRITING    // Frame done, job writing the last slots
+} screenshot_state_t;
+
+// One contiguous run of file bytes staged in a slot
+typedef struct
+{
+    uint32_t offset;
+    uint32_t length;
+} screenshot_run_t;
+
+static volatile screenshot_state_t shot_state = SHOT_IDLE;
+static MAIN_job_id_t shot_job = JOB_INVALID;
+static char shot_path[32];
+static uint16_t shot_next = 1;
+static bool shot_ok = false;
+static uint32_t shot_start_ms = 0;
+
+// Frame geometry, from the display at the request
+static uint32_t shot_width = 0;
+static uint32_t shot_height = 0;
+static uint32_t shot_row_bytes = 0;
+
+// Slot ring: the tap publishes (head), the job writes and frees (tail)
+static uint8_t *shot_stage = NULL;
+static screenshot_run_t shot_runs[SCREENSHOT_SLOTS];
+static volatile uint8_t shot_head = 0;
+static volatile uint8_t shot_tail = 0;
+
+static MAIN_screenshot_stats_t shot_stats = {};
+
+/******************************************************************************
+ * Static Functions
+ *****************************************************************************/
+
+/**
+ * @brief Hand the slot being filled to the job and wait for the next to free
+ * @details The wait is where the captured frame pays for the SD writes.
+ */
+static void screenshot_publish(void)
+{
+    if (shot_runs[shot_head % SCREENSHOT_SLOTS].length == 0)
+    {
+        return;
+    }
+    shot_head++;
+    MAIN_job_trigger(shot_job);
+
+    while ((uint8_t)(shot_head - shot_tail) >= SCREENSHOT_SLOTS)
+    {
+        vTaskDelay(1);
+    }
+    shot_runs[shot_head % SCREENSHOT_SLOTS].length = 0;
+}
+
+/**
+ * @brief Stage one row of an area at its place in the file
+ */
+static void screenshot_put_row(uint32_t offset, const uint16_t *src, uint32_t width, bool rowEnd)
+{
+    uint32_t bytes = width * 2;
+    uint32_t padding = rowEnd ? shot_row_bytes - shot_width * 2 : 0;
+
+    screenshot_run_t *run = &shot_runs[shot_head % SCREENSHOT_SLOTS];
+    if (run->length > 0 &&
+        (run->offset + run->length != offset || run->length + bytes + padding > SCREENSHOT_SLOT_BYTES))
+    {
+        screenshot_publish();
+        run = &shot_runs[shot_head % SCREENSHOT_SLOTS];
+    }
+    if (run->length == 0)
+    {
+        run->offset = offset;
+    }
+
+    uint16_t *dst = (uint16_t *)(shot_stage + (shot_head % SCREENSHOT_SLOTS) * SCREENSHOT_SLOT_BYTES + run->length);
+#if LVGL_NATIVE_BYTE_ORDER == 1
+    // RGB565_SWAPPED (panel order) to the little-endian RGB565 of BMP
+    for (uint32_t x = 0; x < width; x++)
+    {
+        dst[x] = (uint16_t)((src[x] << 8) | (src[x] >> 8));
+    }
+#else
+    memcpy(dst, src, bytes);
+#endif
+    memset((uint8_t *)dst + bytes, 0, padding);
+    run->length += bytes + padding;
+}
+
+/**
+ * @brief Flush tap: stage each row of the area, finish on the frame's last
+ */
+static void screenshot_tap(const lv_area_t *area, const uint8_t *pixels, uint32_t stridePx, bool last)
+{
+    int64_t start = esp_timer_get_time();
+    uint32_t width = lv_area_get_width(area);
+    bool rowEnd = (uint32_t)area->x2 == shot_width - 1;
+
+    for (int32_t y = area->y1; y <= area->y2 && (uint32_t)y < shot_height; y++)
+    {
+        const uint16_t *src = (const uint16_t *)pixels + (y - area->y1) * stridePx;
+        screenshot_put_row(SCREENSHOT_HEADER_BYTES + y * shot_row_bytes + area->x1 * 2, src, width, rowEnd);
+    }
+
+    if (last)
+    {
+        screenshot_publish();
+        MAIN_lvgl_remove_flush_tap(screenshot_tap);
+        shot_state = SHOT_WRITING;
+        MAIN_job_trigger(shot_job);
+    }
+    shot_stats.frameUs += (uint32_t)(esp_timer_get_time() - start);
+}
+
+/**
+ * @brief UI task: render the next frame whole, through the tap
+ */
+static void screenshot_arm(void *ctx, uint32_t param)
+{
+    (void)ctx;
+    (void)param;
+    shot_runs[shot_head % SCREENSHOT_SLOTS].length = 0;
+    shot_stats.frameUs = 0;
+    if (!MAIN_lvgl_add_flush_tap(screenshot_tap))
+    {
+        shot_ok = false;
+        shot_state = SHOT_WRITING;
+        return;
+    }
+    shot_state = SHOT_CAPTURING;
+    lv_obj_invalidate(lv_screen_active());
+}
+
+/**
+ * @brief Job: pick the name, write the header, then ask the UI task to arm
+ * @return true if the capture can go ahead
+ */
+static bool screenshot_prepare(void)
+{
+    bool ok = using_sdcard().directoryExists(SCREENSHOT_DIR) || using_sdcard().createDirectory(SCREENSHOT_DIR);
+    shot_path[0] = '\0';
+    for (; ok && shot_path[0] == '\0' && shot_next < 10000; shot_next++)
+    {
+        snprintf(shot_path, sizeof(shot_path), SCREENSHOT_DIR "/shot_%04u.bmp", shot_next);
+        if (using_sdcard().fileExists(shot_path))
+        {
+            shot_path[0] = '\0';
+        }
+    }
+    if (!ok || shot_path[0] == '\0')
+    {
+        return false;
+    }
+
+    shot_stage = (uint8_t *)heap_caps_malloc(SCREENSHOT_SLOTS * SCREENSHOT_SLOT_BYTES,
+                                             MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (shot_stage == NULL)
+    {
+        return false;
+    }
+
+    // BITMAPFILEHEADER, then BITMAPINFOHEADER with BI_BITFIELDS and the
+    // RGB565 masks; a negative height stores the rows top-down
+    uint8_t header[SCREENSHOT_HEADER_BYTES] = {'B', 'M'};
+    uint32_t fileBytes = SCREENSHOT_HEADER_BYTES + shot_row_bytes * shot_height;
+    uint32_t fields[14] = {SCREENSHOT_HEADER_BYTES, 40, shot_width, (uint32_t)-(int32_t)shot_height, 1 | (16 << 16),
+                           3, shot_row_bytes * shot_height, 2835, 2835, 0, 0, 0xF800, 0x07E0, 0x001F};
+    memcpy(header + 2, &fileBytes, 4);
+    memcpy(header + 10, fields, sizeof(fields));
+    if (!using_sdcard().writeFileAtomic(shot_path, header, sizeof(header)))
+    {
+        return false;
+    }
+
+    return MAIN_ui_cmd_call(screenshot_arm, NULL, 0);
+}
+
+/**
+ * @brief Job: write published slots; close the capture once the frame is in
+ */
+static void screenshot_job(void *ctx)
+{
+    (void)ctx;
+
+    if (shot_state == SHOT_PREPARING)
+    {
+        shot_state = SHOT_ARMING;
+        shot_ok = screenshot_prepare();
+        if (!shot_ok)
+        {
+            shot_state = SHOT_WRITING;
+        }
+    }
+
+    while (shot_tail != shot_head)
+    {
+        const screenshot_run_t &run = shot_runs[shot_tail % SCREENSHOT_SLOTS];
+        const uint8_t *data = shot_stage + (shot_tail % SCREENSHOT_SLOTS) * SCREENSHOT_SLOT_BYTES;
+        shot_ok = using_sdcard().writeDataAt(shot_path, run.offset, data, run.length) && shot_ok;
+        shot_tail++;
+    }
+
+    if (shot_state != SHOT_WRITING)
+    {
+        return;
+    }
+
+    heap_caps_free(shot_stage);
+    shot_stage = NULL;
+    if (shot_ok)
+    {
+        using_sdcard().flush(shot_path);
+        shot_stats.captures++;
+        shot_stats.bytes = SCREENSHOT_HEADER_BYTES + shot_row_bytes * shot_height;
+        strlcpy(shot_stats.path, shot_path, sizeof(shot_stats.path));
+        DEBUG_PRINTF("[OK] Screenshot %s (%lu us in the frame)\n", shot_path, (unsigned long)shot_stats.frameUs);
+    }
+    else
+    {
+        if (shot_path[0] != '\0')
+        {
+            using_sdcard().removeFile(shot_path);
+        }
+        shot_stats.failed++;
+        DEBUG_PRINTLN("[WARN] Screenshot not saved");
+    }
+    shot_stats.totalMs = millis() - shot_start_ms;
+
+    MAIN_job_cancel(shot_job);
+    shot_job = JOB_INVALID;
+    shot_state = SHOT_IDLE;
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Start a capture; the job and the UI task take it from here
+ */
+bool MAIN_screenshot_capture(void)
+{
+    lv_display_t *disp = lv_display_get_default();
+    if (shot_state != SHOT_IDLE || disp == NULL || !using_sdcard().isAvailable())
+    {
+        return false;
+    }
+
+    shot_width = lv_display_get_horizontal_resolution(disp);
+    shot_height = lv_display_get_vertical_resolution(disp);
+    shot_row_bytes = (shot_width * 2 + 3) & ~3U;
+    shot_head = 0;
+    shot_tail = 0;
+    shot_start_ms = millis();
+    shot_state = SHOT_PREPARING;
+
+    shot_job = MAIN_job_add("screenshot", screenshot_job, NULL, 0, SCREENSHOT_WRITE_PERIOD_MS, JOB_PRIORITY_LOW, 0);
+    if (shot_job == JOB_INVALID)
+    {
+        shot_state = SHOT_IDLE;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Check for a capture in progress
+ */
+bool MAIN_screenshot_is_busy(void)
+{
+    return shot_state != SHOT_IDLE;
+}
+
+/**
+ * @brief Copy the counters
+ */
+void MAIN_screenshot_get_stats(MAIN_screenshot_stats_t *stats)
+{
+    *stats = shot_stats;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Screenshot_getLibraryName() {
+    return MAIN_Screenshot::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Screenshot_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Screenshot::VERSION_MAJOR,
+                       MAIN_Screenshot::VERSION_MINOR,
+                       MAIN_Screenshot::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Screenshot_getVersionDate() {
+    return MAIN_Screenshot::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Screenshot_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Screenshot_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_screenshotLib.cpp
+ ******************************************************************************/
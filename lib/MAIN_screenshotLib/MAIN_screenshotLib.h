@@ -0,0 +1,118 @@
+/**
+ * @file MAIN_screenshotLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Screenshots to the SD card, streamed from the flush path
+ * @details A 480x320 RGB565 frame is 300 KB, more than the partial-render
+ *          strips ever hold at once, and copying it whole would need a
+ *          second frame's worth of PSRAM. A capture instead:
+ *
+ *          - picks a free name, SCREENSHOT_DIR/shot_NNNN.bmp, and writes
+ *            the BMP header (Core 1, a job of MAIN_jobSchedulerLib)
+ *          - invalidates the active screen on the UI task and installs a
+ *            flush tap (MAIN_lvgl_add_flush_tap), so the next frame is
+ *            rendered whole
+ *          - in the tap, copies each strip's rows into SCREENSHOT_SLOTS
+ *            staging slots of SCREENSHOT_SLOT_BYTES (byte-swapped to
+ *            little-endian RGB565 on the way), handing each full slot to
+ *            the job, which writes it with EARS_sdCard::writeDataAt()
+ *          - removes the tap after the frame's last area
+ *
+ *          The file is a top-down BMP (negative height, BI_BITFIELDS
+ *          RGB565), so rows are written in the order LVGL renders them.
+ *          Extra memory is the staging slots only, allocated for the
+ *          capture. The captured frame takes longer by whatever time the
+ *          tap waits for a free slot, about one frame's worth of SD writes;
+ *          no other frame is touched.
+ * @version 1.0.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_SCREENSHOT_LIB_H__
+#define __MAIN_SCREENSHOT_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Screenshot
+{
+    constexpr const char* LIB_NAME = "MAIN_Screenshot";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "1";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_Screenshot_getLibraryName();
+uint32_t MAIN_Screenshot_getVersionEncoded();
+const char* MAIN_Screenshot_getVersionDate();
+void MAIN_Screenshot_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Screenshot Configuration
+ *****************************************************************************/
+
+// Where shot_NNNN.bmp files go
+#define SCREENSHOT_DIR "/screenshots"
+
+// Staging between the flush tap and the SD writes (SD_WRITE_ALIGN sized)
+#define SCREENSHOT_SLOTS 3
+#define SCREENSHOT_SLOT_BYTES 16384
+
+// Writer job period while a capture runs (each full slot also triggers it)
+#define SCREENSHOT_WRITE_PERIOD_MS 20
+
+// BITMAPFILEHEADER, BITMAPINFOHEADER and three colour masks
+#define SCREENSHOT_HEADER_BYTES 66
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t captures; // Screenshots saved
+    uint32_t failed;   // Captures that could not be saved
+    uint32_t bytes;    // Size of the last file
+    uint32_t frameUs;  // Time the last capture spent in the flush tap
+    uint32_t totalMs;  // Last capture, request to file flushed
+    char path[32];     // Last file saved
+} MAIN_screenshot_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Capture the next frame to the SD card
+ * @return true if started (false: one already running, or no card)
+ * @note Any task. Done when MAIN_screenshot_is_busy() turns false.
+ */
+bool MAIN_screenshot_capture(void);
+
+/**
+ * @brief Check for a capture in progress
+ * @return true from MAIN_screenshot_capture() until the file is written
+ */
+bool MAIN_screenshot_is_busy(void);
+
+/**
+ * @brief Screenshot counters
+ * @param stats Receives the counters
+ */
+void MAIN_screenshot_get_stats(MAIN_screenshot_stats_t *stats);
+
+#endif // __MAIN_SCREENSHOT_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_screenshotLib.h
+ ******************************************************************************/
@@ -0,0 +1,562 @@
+/**
+ * @file MAIN_sdFsLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief LVGL filesystem driver for the SD card with a PSRAM block cache
+ * @version 1.0.2
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_sdFsLib.h"
+#include "EARS_systemDef.h"
+#include "MAIN_memPlanLib.h"
+#include <esp_heap_caps.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+#define SDFS_NO_BLOCK 0xFFFFFFFFU
+
+#if (SDFS_BLOCK_SIZE % 512) != 0
+#error "SDFS_BLOCK_SIZE must be a multiple of the 512 byte sector"
+#endif
+
+#if (SDFS_CACHE_BLOCKS & (SDFS_CACHE_BLOCKS - 1)) != 0 || SDFS_CACHE_BLOCKS == 0
+#error "SDFS_CACHE_BLOCKS must be a power of two"
+#endif
+
+typedef struct
+{
+    int fd;                             // VFS file descriptor
+    uint32_t pos;                       // Position LVGL sees
+    uint32_t size;                      // File size
+    uint32_t cardPos;                   // Offset of fd (saves an lseek per read)
+    uint8_t *cache;                     // SDFS_CACHE_BLOCKS blocks, NULL = uncached
+    uint32_t tag[SDFS_CACHE_BLOCKS];    // Block held by each slot
+    uint32_t valid[SDFS_CACHE_BLOCKS];  // Bytes held (short at the end of the file)
+} sd_fs_file_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static lv_fs_drv_t sd_fs_drv;
+static bool sd_fs_registered = false;
+static uint8_t sd_fs_read_ahead = SDFS_READ_AHEAD_BLOCKS;
+static MAIN_sd_fs_stats_t sd_fs_stats;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Full VFS path of a drive path
+ * @param out Receives SDMMC_MOUNT_POINT + path
+ * @param size Size of out
+ * @param path Path after the drive letter ("/images/logo.bin")
+ * @return true if it fits
+ */
+static bool sd_fs_full_path(char *out, size_t size, const char *path)
+{
+    int len = snprintf(out, size, "%s%s%s", SDMMC_MOUNT_POINT, path[0] == '/' ? "" : "/", path);
+    return len > 0 && (size_t)len < size;
+}
+
+/**
+ * @brief Forget every cached block of a file
+ * @param file Open file
+ */
+static void sd_fs_invalidate(sd_fs_file_t *file)
+{
+    for (uint8_t i = 0; i < SDFS_CACHE_BLOCKS; i++)
+    {
+        file->tag[i] = SDFS_NO_BLOCK;
+        file->valid[i] = 0;
+    }
+}
+
+/**
+ * @brief Read from the card at an offset
+ * @param file Open file
+ * @param offset File offset
+ * @param buf Destination
+ * @param len Bytes wanted
+ * @return int Bytes read, -1 on error
+ */
+static int sd_fs_card_read(sd_fs_file_t *file, uint32_t offset, uint8_t *buf, uint32_t len)
+{
+    if (file->cardPos != offset)
+    {
+        if (lseek(file->fd, offset, SEEK_SET) < 0)
+        {
+            return -1;
+        }
+        file->cardPos = offset;
+    }
+
+    // Holds off EARS_sdCard's background writes while the UI waits
+    uint32_t start = using_sdcard().beginInteractiveRead();
+    int n = read(file->fd, buf, len);
+    using_sdcard().endInteractiveRead(start);
+    sd_fs_stats.cardReads++;
+    if (n > 0)
+    {
+        file->cardPos += n;
+        sd_fs_stats.cardBytes += n;
+    }
+    return n;
+}
+
+/**
+ * @brief Load a block and the read-ahead after it into the cache
+ * @param file Open file with a cache
+ * @param block Block that missed (still uncached after a card error)
+ * @note Slots are direct-mapped, so consecutive blocks sit in consecutive
+ *       slots and a read-ahead is one card read (two where it wraps).
+ */
+static void sd_fs_fill(sd_fs_file_t *file, uint32_t block)
+{
+    uint32_t lastBlock = file->size ? (file->size - 1) / SDFS_BLOCK_SIZE : 0;
+    uint32_t count = sd_fs_read_ahead;
+    if (count > lastBlock - block + 1)
+    {
+        count = lastBlock - block + 1;
+    }
+
+    while (count > 0)
+    {
+        uint32_t slot = block & (SDFS_CACHE_BLOCKS - 1);
+        uint32_t run = SDFS_CACHE_BLOCKS - slot;
+        if (run > count)
+        {
+            run = count;
+        }
+
+        int n = sd_fs_card_read(file, block * SDFS_BLOCK_SIZE, file->cache + slot * SDFS_BLOCK_SIZE,
+                                run * SDFS_BLOCK_SIZE);
+        if (n <= 0)
+        {
+            break;
+        }
+
+        for (uint32_t i = 0; i < run && n > 0; i++)
+        {
+            file->tag[slot + i] = block + i;
+            file->valid[slot + i] = (uint32_t)n < SDFS_BLOCK_SIZE ? (uint32_t)n : SDFS_BLOCK_SIZE;
+            n -= SDFS_BLOCK_SIZE;
+        }
+        if (n < 0)
+        {
+            break; // Short read: the file ended sooner than its size said
+        }
+
+        block += run;
+        count -= run;
+    }
+}
+
+/******************************************************************************
+ * LVGL Driver Callbacks
+ *****************************************************************************/
+
+static bool sd_fs_ready(lv_fs_drv_t *drv)
+{
+    LV_UNUSED(drv);
+    return using_sdcard().isAvailable();
+}
+
+static void *sd_fs_open(lv_fs_drv_t *drv, const char *path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+
+    char fullPath[sizeof(SDMMC_MOUNT_POINT) + SDFS_PATH_MAX];
+    if (!sd_fs_full_path(fullPath, sizeof(fullPath), path))
+    {
+        return NULL;
+    }
+
+    // Same modes as LVGL's stdio driver ("rb", "wb", "rb+")
+    int flags = O_RDONLY;
+    if (mode == LV_FS_MODE_WR)
+    {
+        flags = O_WRONLY | O_CREAT | O_TRUNC;
+    }
+    else if (mode == (LV_FS_MODE_WR | LV_FS_MODE_RD))
+    {
+        flags = O_RDWR;
+    }
+
+    int fd = open(fullPath, flags, 0666);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    struct stat st;
+    sd_fs_file_t *file = (sd_fs_file_t *)lv_malloc(sizeof(sd_fs_file_t));
+    if (file == NULL || fstat(fd, &st) != 0)
+    {
+        lv_free(file);
+        close(fd);
+        return NULL;
+    }
+
+    file->fd = fd;
+    file->pos = 0;
+    file->size = (uint32_t)st.st_size;
+    file->cardPos = 0;
+    file->cache = NULL;
+    sd_fs_invalidate(file);
+
+    // Write-only files never read back through the cache
+    if (mode & LV_FS_MODE_RD)
+    {
+        file->cache = (uint8_t *)MAIN_mem_alloc(MEM_POOL_SD_CACHE, SDFS_CACHE_BLOCKS * SDFS_BLOCK_SIZE,
+                                                MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (file->cache == NULL)
+        {
+            sd_fs_stats.uncached++;
+        }
+    }
+
+    sd_fs_stats.openFiles++;
+    return file;
+}
+
+static lv_fs_res_t sd_fs_close(lv_fs_drv_t *drv, void *file_p)
+{
+    LV_UNUSED(drv);
+    sd_fs_file_t *file = (sd_fs_file_t *)file_p;
+
+    int err = close(file->fd);
+    MAIN_mem_free(file->cache);
+    lv_free(file);
+    sd_fs_stats.openFiles--;
+    return err == 0 ? LV_FS_RES_OK : LV_FS_RES_HW_ERR;
+}
+
+static lv_fs_res_t sd_fs_read(lv_fs_drv_t *drv, void *file_p, void *buf, uint32_t btr, uint32_t *br)
+{
+    LV_UNUSED(drv);
+    sd_fs_file_t *file = (sd_fs_file_t *)file_p;
+    uint8_t *out = (uint8_t *)buf;
+    bool missed = false;
+
+    *br = 0;
+    sd_fs_stats.reads++;
+
+    if (file->pos >= file->size)
+    {
+        return LV_FS_RES_OK;
+    }
+    if (btr > file->size - file->pos)
+    {
+        btr = file->size - file->pos;
+    }
+
+    while (btr > 0)
+    {
+        uint32_t block = file->pos / SDFS_BLOCK_SIZE;
+        uint32_t offset = file->pos % SDFS_BLOCK_SIZE;
+
+        // Whole aligned blocks (or no cache): straight into the caller's buffer
+        if (file->cache == NULL || (offset == 0 && btr >= SDFS_BLOCK_SIZE))
+        {
+            uint32_t len = file->cache ? btr - btr % SDFS_BLOCK_SIZE : btr;
+            int n = sd_fs_card_read(file, file->pos, out, len);
+            missed = true;
+            if (n <= 0)
+            {
+                if (n < 0 && *br == 0)
+                {
+                    sd_fs_stats.misses++;
+                    return LV_FS_RES_HW_ERR;
+                }
+                break;
+            }
+
+            sd_fs_stats.directBytes += n;
+            out += n;
+            file->pos += n;
+            *br += n;
+            btr -= n;
+            if ((uint32_t)n < len)
+            {
+                break;
+            }
+            continue;
+        }
+
+        uint32_t slot = block & (SDFS_CACHE_BLOCKS - 1);
+        if (file->tag[slot] != block)
+        {
+            missed = true;
+            sd_fs_fill(file, block);
+            if (file->tag[slot] != block)
+            {
+                if (*br == 0)
+                {
+                    sd_fs_stats.misses++;
+                    return LV_FS_RES_HW_ERR;
+                }
+                break;
+            }
+        }
+
+        if (file->valid[slot] <= offset)
+        {
+            break;
+        }
+        uint32_t chunk = file->valid[slot] - offset;
+        if (chunk > btr)
+        {
+            chunk = btr;
+        }
+
+        memcpy(out, file->cache + slot * SDFS_BLOCK_SIZE + offset, chunk);
+        out += chunk;
+        file->pos += chunk;
+        *br += chunk;
+        btr -= chunk;
+    }
+
+    if (missed)
+    {
+        sd_fs_stats.misses++;
+    }
+    else
+    {
+        sd_fs_stats.hits++;
+    }
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t sd_fs_write(lv_fs_drv_t *drv, void *file_p, const void *buf, uint32_t btw, uint32_t *bw)
+{
+    LV_UNUSED(drv);
+    sd_fs_file_t *file = (sd_fs_file_t *)file_p;
+
+    *bw = 0;
+    if (file->cardPos != file->pos)
+    {
+        if (lseek(file->fd, file->pos, SEEK_SET) < 0)
+        {
+            return LV_FS_RES_HW_ERR;
+        }
+        file->cardPos = file->pos;
+    }
+
+    int n = write(file->fd, buf, btw);
+    if (n < 0)
+    {
+        return LV_FS_RES_HW_ERR;
+    }
+
+    file->pos += n;
+    file->cardPos += n;
+    if (file->pos > file->size)
+    {
+        file->size = file->pos;
+    }
+    sd_fs_invalidate(file);
+
+    *bw = n;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t sd_fs_seek(lv_fs_drv_t *drv, void *file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    LV_UNUSED(drv);
+    sd_fs_file_t *file = (sd_fs_file_t *)file_p;
+
+    // Only the position moves; the card is seeked by the next read or write
+    switch (whence)
+    {
+    case LV_FS_SEEK_SET:
+        file->pos = pos;
+        break;
+    case LV_FS_SEEK_CUR:
+        file->pos += pos;
+        break;
+    case LV_FS_SEEK_END:
+        file->pos = file->size + pos;
+        break;
+    default:
+        return LV_FS_RES_INV_PARAM;
+    }
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t sd_fs_tell(lv_fs_drv_t *drv, void *file_p, uint32_t *pos_p)
+{
+    LV_UNUSED(drv);
+    *pos_p = ((sd_fs_file_t *)file_p)->pos;
+    return LV_FS_RES_OK;
+}
+
+static void *sd_fs_dir_open(lv_fs_drv_t *drv, const char *path)
+{
+    LV_UNUSED(drv);
+
+    char fullPath[sizeof(SDMMC_MOUNT_POINT) + SDFS_PATH_MAX];
+    if (!sd_fs_full_path(fullPath, sizeof(fullPath), path))
+    {
+        return NULL;
+    }
+    return opendir(fullPath);
+}
+
+static lv_fs_res_t sd_fs_dir_read(lv_fs_drv_t *drv, void *dir_p, char *fn, uint32_t fn_len)
+{
+    LV_UNUSED(drv);
+    if (fn_len == 0)
+    {
+        return LV_FS_RES_INV_PARAM;
+    }
+
+    struct dirent *entry;
+    do
+    {
+        entry = readdir((DIR *)dir_p);
+        if (entry == NULL)
+        {
+            fn[0] = '\0'; // End of the directory
+            return LV_FS_RES_OK;
+        }
+    } while (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0);
+
+    // Directories start with '/', as with LVGL's stdio driver
+    lv_snprintf(fn, fn_len, "%s%s", entry->d_type == DT_DIR ? "/" : "", entry->d_name);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t sd_fs_dir_close(lv_fs_drv_t *drv, void *dir_p)
+{
+    LV_UNUSED(drv);
+    return closedir((DIR *)dir_p) == 0 ? LV_FS_RES_OK : LV_FS_RES_HW_ERR;
+}
+
+/******************************************************************************
+ * SD Filesystem
+ *****************************************************************************/
+
+/**
+ * @brief Register the 'S' drive with LVGL
+ * @return true if registered
+ */
+bool MAIN_initialise_sd_fs(void)
+{
+    if (sd_fs_registered)
+    {
+        return true;
+    }
+
+    if (lv_fs_get_drv(SDFS_LETTER) != NULL)
+    {
+        Serial.printf("[SDFS] ERROR: Drive %c is already registered (LV_USE_FS_STDIO?)\n", SDFS_LETTER);
+        return false;
+    }
+
+    memset(&sd_fs_stats, 0, sizeof(sd_fs_stats));
+
+    lv_fs_drv_init(&sd_fs_drv);
+    sd_fs_drv.letter = SDFS_LETTER;
+    sd_fs_drv.cache_size = 0; // Blocks are cached here, per file
+    sd_fs_drv.ready_cb = sd_fs_ready;
+    sd_fs_drv.open_cb = sd_fs_open;
+    sd_fs_drv.close_cb = sd_fs_close;
+    sd_fs_drv.read_cb = sd_fs_read;
+    sd_fs_drv.write_cb = sd_fs_write;
+    sd_fs_drv.seek_cb = sd_fs_seek;
+    sd_fs_drv.tell_cb = sd_fs_tell;
+    sd_fs_drv.dir_open_cb = sd_fs_dir_open;
+    sd_fs_drv.dir_read_cb = sd_fs_dir_read;
+    sd_fs_drv.dir_close_cb = sd_fs_dir_close;
+    lv_fs_drv_register(&sd_fs_drv);
+    sd_fs_registered = true;
+
+#if EARS_DEBUG == 1
+    Serial.printf("[SDFS] Drive %c: on " SDMMC_MOUNT_POINT ", %d x %d byte blocks per file, read-ahead %d\n",
+                  SDFS_LETTER, SDFS_CACHE_BLOCKS, SDFS_BLOCK_SIZE, sd_fs_read_ahead);
+#endif
+    return true;
+}
+
+/**
+ * @brief Change the blocks read on a miss
+ * @param blocks 1 to SDFS_CACHE_BLOCKS
+ */
+void MAIN_sd_fs_set_read_ahead(uint8_t blocks)
+{
+    if (blocks < 1)
+    {
+        blocks = 1;
+    }
+    if (blocks > SDFS_CACHE_BLOCKS)
+    {
+        blocks = SDFS_CACHE_BLOCKS;
+    }
+    sd_fs_read_ahead = blocks;
+}
+
+/**
+ * @brief Blocks read on a miss
+ * @return uint8_t Current read-ahead
+ */
+uint8_t MAIN_sd_fs_get_read_ahead(void)
+{
+    return sd_fs_read_ahead;
+}
+
+/**
+ * @brief Driver counters
+ * @param stats Receives the counters
+ */
+void MAIN_sd_fs_get_stats(MAIN_sd_fs_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = sd_fs_stats;
+    }
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_SdFs_getLibraryName() {
+    return MAIN_SdFs::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_SdFs_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_SdFs::VERSION_MAJOR,
+                       MAIN_SdFs::VERSION_MINOR,
+                       MAIN_SdFs::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_SdFs_getVersionDate() {
+    return MAIN_SdFs::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_SdFs_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_SdFs_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_sdFsLib.cpp
+ ******************************************************************************/
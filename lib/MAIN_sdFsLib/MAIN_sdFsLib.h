@@ -0,0 +1,125 @@
+/**
+ * @file MAIN_sdFsLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief LVGL filesystem driver for the SD card with a PSRAM block cache
+ * @details Registers the 'S' drive (replacing LVGL's stdio driver) on the
+ *          SD_MMC VFS mount of EARS_sdCard. Each open file reads the card
+ *          in aligned blocks (a multiple of the 512 byte sector) into a
+ *          small direct-mapped block cache in PSRAM, with read-ahead on
+ *          a miss, so image decoders and binfont loaders that read a few
+ *          bytes at a time and seek back to headers hit memory instead of
+ *          the card. Reads of whole aligned blocks go straight into the
+ *          caller's buffer.
+ *
+ *          The drive prefixes paths with SDMMC_MOUNT_POINT, the one mount
+ *          point EARS_sdCard mounts on, so "S:/images/logo.bin" is always
+ *          the file the card library sees as "/images/logo.bin".
+ *
+ *          LVGL's own per-file cache (drv->cache_size) stays 0.
+ * @version 1.0.2
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_SD_FS_LIB_H__
+#define __MAIN_SD_FS_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include "EARS_sdCardLib.h"
+#include <lvgl.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_SdFs
+{
+    constexpr const char* LIB_NAME = "MAIN_SdFs";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "2";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_SdFs_getLibraryName();
+uint32_t MAIN_SdFs_getVersionEncoded();
+const char* MAIN_SdFs_getVersionDate();
+void MAIN_SdFs_getVersionString(char* buffer);
+
+/******************************************************************************
+ * SD Filesystem Configuration
+ *****************************************************************************/
+
+// LVGL drive letter ("S:/images/...")
+#define SDFS_LETTER 'S'
+
+// Card read unit (bytes, a multiple of the 512 byte sector)
+#define SDFS_BLOCK_SIZE 4096
+
+// Blocks cached per open file (power of two)
+#define SDFS_CACHE_BLOCKS 8
+
+// Blocks read on a miss, the missing one included (1 to SDFS_CACHE_BLOCKS)
+#define SDFS_READ_AHEAD_BLOCKS 2
+
+// Longest path after the mount point
+#define SDFS_PATH_MAX 128
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t reads;       // lv_fs_read() calls
+    uint32_t hits;        // Reads served from the cache alone
+    uint32_t misses;      // Reads that went to the card
+    uint32_t cardReads;   // read() calls on the card
+    uint32_t cardBytes;   // Bytes read from the card
+    uint32_t directBytes; // Of those, read straight into the caller's buffer
+    uint16_t openFiles;   // Files open now
+    uint16_t uncached;    // Opens with no memory for a cache
+} MAIN_sd_fs_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Register the 'S' drive with LVGL
+ * @return true if registered
+ * @note Call after MAIN_initialise_lvgl(). The card may mount later;
+ *       opens fail until it does.
+ */
+bool MAIN_initialise_sd_fs(void);
+
+/**
+ * @brief Change the blocks read on a miss
+ * @param blocks 1 to SDFS_CACHE_BLOCKS (clamped); applies to later misses
+ */
+void MAIN_sd_fs_set_read_ahead(uint8_t blocks);
+
+/**
+ * @brief Blocks read on a miss
+ * @return uint8_t Current read-ahead
+ */
+uint8_t MAIN_sd_fs_get_read_ahead(void);
+
+/**
+ * @brief Driver counters
+ * @param stats Receives the counters
+ */
+void MAIN_sd_fs_get_stats(MAIN_sd_fs_stats_t *stats);
+
+#endif // __MAIN_SD_FS_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_sdFsLib.h
+ ******************************************************************************/
@@ -0,0 +1,254 @@
+/**
+ * @file MAIN_searchLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Search-as-you-type over the equipment search index
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_searchLib.h"
+#include "EARS_systemDef.h"
+#include "MAIN_uiCommandLib.h"
+#include "MAIN_jobSchedulerLib.h"
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static portMUX_TYPE search_mux = portMUX_INITIALIZER_UNLOCKED;
+static MAIN_job_id_t search_job = JOB_INVALID;
+
+// Pending query (UI writes, job takes)
+static char search_query[SEARCH_QUERY_SIZE];
+static uint32_t search_seq = 0;         // Bumped by every submit and cancel
+static bool search_pending = false;
+
+// Results of the query the job last ran
+static uint32_t search_results[SEARCH_MAX_RESULTS];
+static uint16_t search_result_count = 0;
+static uint32_t search_result_seq = 0;
+static bool search_result_done = false;
+
+// UI task only
+static MAIN_search_result_cb_t search_cb = NULL;
+static void *search_ctx = NULL;
+static uint16_t search_delivered = 0;
+static bool search_done_reported = false;
+
+static MAIN_search_stats_t search_stats;
+
+/******************************************************************************
+ * Internal Functions - UI Task
+ *****************************************************************************/
+
+/**
+ * @brief Hand the results not yet delivered to the callback
+ * @param ctx Unused
+ * @param param Query sequence the post was made for
+ * @note Runs on the UI task through MAIN_ui_cmd_call().
+ */
+static void search_deliver(void *ctx, uint32_t param)
+{
+    (void)ctx;
+    uint32_t ids[SEARCH_MAX_RESULTS];
+    uint16_t count = 0;
+    bool done = false;
+
+    portENTER_CRITICAL(&search_mux);
+    bool current = param == search_seq && search_result_seq == param && !search_done_reported;
+    if (current)
+    {
+        count = search_result_count - search_delivered;
+        memcpy(ids, &search_results[search_delivered], count * sizeof(uint32_t));
+        search_delivered = search_result_count;
+        done = search_result_done;
+        search_done_reported = done;
+    }
+    portEXIT_CRITICAL(&search_mux);
+
+    // Earlier posts for a query may find nothing new; the last reports done
+    if (current && search_cb != NULL && (count > 0 || done))
+    {
+        search_cb(ids, count, done, search_ctx);
+    }
+}
+
+/******************************************************************************
+ * Internal Functions - Core 1
+ *****************************************************************************/
+
+/**
+ * @brief Append a batch from the index, stop if a newer query came in
+ * @param ctx Sequence of the query being run
+ */
+static bool search_collect(const uint32_t *ids, uint16_t count, void *ctx)
+{
+    uint32_t seq = *(const uint32_t *)ctx;
+
+    portENTER_CRITICAL(&search_mux);
+    bool current = search_seq == seq;
+    bool room = false;
+    if (current)
+    {
+        uint16_t roomLeft = SEARCH_MAX_RESULTS - search_result_count;
+        uint16_t take = count < roomLeft ? count : roomLeft;
+        memcpy(&search_results[search_result_count], ids, take * sizeof(uint32_t));
+        search_result_count += take;
+        room = search_result_count < SEARCH_MAX_RESULTS;
+    }
+    else
+    {
+        search_stats.superseded++;
+    }
+    portEXIT_CRITICAL(&search_mux);
+
+    if (current)
+    {
+        MAIN_ui_cmd_call(search_deliver, NULL, seq);
+    }
+    return current && room;
+}
+
+/**
+ * @brief Run the pending query (Core 1 job)
+ * @param ctx Unused
+ */
+static void search_job_fn(void *ctx)
+{
+    (void)ctx;
+    char query[SEARCH_QUERY_SIZE];
+    uint32_t seq;
+
+    portENTER_CRITICAL(&search_mux);
+    if (!search_pending)
+    {
+        portEXIT_CRITICAL(&search_mux);
+        return;
+    }
+    memcpy(query, search_query, sizeof(query));
+    seq = search_seq;
+    search_pending = false;
+    search_result_seq = seq;
+    search_result_count = 0;
+    search_result_done = false;
+    search_stats.run++;
+    portEXIT_CRITICAL(&search_mux);
+
+    EARS_searchIndex &index = using_equipment_search();
+    if (query[0] != '\0' && index.isReady())
+    {
+        index.search(query, search_collect, &seq, SEARCH_MAX_RESULTS);
+    }
+
+    portENTER_CRITICAL(&search_mux);
+    bool current = search_seq == seq;
+    if (current)
+    {
+        search_result_done = true;
+        search_stats.lastQueryUs = index.getLastQueryUs();
+    }
+    portEXIT_CRITICAL(&search_mux);
+
+    if (current)
+    {
+        MAIN_ui_cmd_call(search_deliver, NULL, seq);
+    }
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+bool MAIN_search_submit(const char *query, MAIN_search_result_cb_t callback, void *ctx)
+{
+    if (query == NULL || callback == NULL)
+    {
+        return false;
+    }
+
+    if (search_job == JOB_INVALID)
+    {
+        search_job = MAIN_job_add("search", search_job_fn, NULL, 0, SEARCH_JOB_PERIOD_MS,
+                                  JOB_PRIORITY_NORMAL, 0);
+        if (search_job == JOB_INVALID)
+        {
+            return false;
+        }
+    }
+
+    search_cb = callback;
+    search_ctx = ctx;
+
+    portENTER_CRITICAL(&search_mux);
+    if (search_pending)
+    {
+        search_stats.superseded++;
+    }
+    strlcpy(search_query, query, sizeof(search_query));
+    search_seq++;
+    search_pending = true;
+    search_delivered = 0;
+    search_done_reported = false;
+    search_stats.submitted++;
+    portEXIT_CRITICAL(&search_mux);
+
+    MAIN_job_trigger(search_job);
+    return true;
+}
+
+void MAIN_search_cancel(void)
+{
+    portENTER_CRITICAL(&search_mux);
+    search_seq++;
+    search_pending = false;
+    portEXIT_CRITICAL(&search_mux);
+}
+
+void MAIN_search_get_stats(MAIN_search_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&search_mux);
+    *stats = search_stats;
+    portEXIT_CRITICAL(&search_mux);
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Search_getLibraryName() {
+    return MAIN_Search::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Search_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Search::VERSION_MAJOR,
+                       MAIN_Search::VERSION_MINOR,
+                       MAIN_Search::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Search_getVersionDate() {
+    return MAIN_Search::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Search_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Search_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_searchLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,109 @@
+/**
+ * @file MAIN_searchLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Search-as-you-type over the equipment search index
+ * @details The UI task calls MAIN_search_submit() on every keystroke. The
+ *          query is copied into a single pending slot (a newer keystroke
+ *          simply replaces it) and the "search" job on Core 1 is triggered,
+ *          so the UI never waits on the index. The job runs
+ *          EARS_searchIndex::search() and posts each batch of IDs back
+ *          through MAIN_uiCommandLib; a search overtaken by a newer
+ *          submission stops at its next batch and its results are dropped.
+ *
+ *          Results arrive on the UI task through the callback given to
+ *          MAIN_search_submit(), in ascending ID order, the last batch
+ *          flagged done.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_SEARCH_LIB_H__
+#define __MAIN_SEARCH_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include "EARS_searchIndexLib.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Search
+{
+    constexpr const char* LIB_NAME = "MAIN_Search";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_Search_getLibraryName();
+uint32_t MAIN_Search_getVersionEncoded();
+const char* MAIN_Search_getVersionDate();
+void MAIN_Search_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Configuration
+ *****************************************************************************/
+#define SEARCH_QUERY_SIZE 48            // Query text kept, including the terminator
+#define SEARCH_MAX_RESULTS 64           // IDs returned per query
+#define SEARCH_JOB_PERIOD_MS 1000       // Job poll; submissions trigger it at once
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+/**
+ * @brief Results of the latest query (UI task)
+ * @param ids New IDs since the previous call for this query
+ * @param count IDs in ids (0 with done for no matches)
+ * @param done true on the last call for this query
+ * @param ctx Context given to MAIN_search_submit
+ */
+typedef void (*MAIN_search_result_cb_t)(const uint32_t *ids, uint16_t count, bool done, void *ctx);
+
+typedef struct
+{
+    uint32_t submitted;   // Queries submitted
+    uint32_t run;         // Queries the job ran
+    uint32_t superseded;  // Queries replaced before or while running
+    uint32_t lastQueryUs; // Index time of the last query
+} MAIN_search_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Search for a query, replacing any query still pending
+ * @param query Text as typed (empty clears: callback gets done with no IDs)
+ * @param callback Receives the results on the UI task
+ * @param ctx Passed to callback
+ * @return true if queued
+ * @note UI task.
+ */
+bool MAIN_search_submit(const char *query, MAIN_search_result_cb_t callback, void *ctx);
+
+/**
+ * @brief Drop the pending query and any results still on their way
+ * @note UI task.
+ */
+void MAIN_search_cancel(void);
+
+/**
+ * @brief Search counters
+ * @param stats Receives the counters
+ */
+void MAIN_search_get_stats(MAIN_search_stats_t *stats);
+
+#endif // __MAIN_SEARCH_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_searchLib.h
+ ******************************************************************************/
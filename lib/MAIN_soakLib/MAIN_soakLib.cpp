@@ -0,0 +1,376 @@
+/**
+ * @file MAIN_soakLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Soak-test mode: hours of sustained load with periodic snapshots
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_soakLib.h"
+#include "EARS_loggerLib.h"
+#include "EARS_nvsEepromLib.h"
+#include "EARS_recordStoreLib.h"
+#include "EARS_sdCardLib.h"
+#include "MAIN_inputReplayLib.h"
+#include "MAIN_jobSchedulerLib.h"
+#include "MAIN_memTelemetryLib.h"
+#include "MAIN_telemetryLib.h"
+#include "MAIN_uiCommandLib.h"
+#include <esp_timer.h>
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static const char *const soak_load_names[SOAK_LOAD_COUNT] = {"log", "record", "nvs", "sd"};
+
+// Since start, and since the last snapshot (Core 1 jobs only)
+static MAIN_soak_stats_t soak_stats;
+static MAIN_soak_load_stats_t soak_period[SOAK_LOAD_COUNT];
+
+// Record store of its own, so the soak never touches real items
+static EARS_recordStore soak_store;
+static uint32_t soak_record_id = 0;
+
+static uint32_t soak_nvs_writes = 0;
+
+// SD churn file contents (PSRAM) and the next file to replace
+static uint8_t *soak_sd_data = NULL;
+static uint8_t soak_sd_next = 0;
+
+// Replay runs seen ended
+static uint32_t soak_replay_runs = 0;
+
+/******************************************************************************
+ * Load Timing
+ *****************************************************************************/
+
+/**
+ * @brief Count one timed operation
+ * @param startUs esp_timer time it started
+ */
+static void soak_count(MAIN_soak_load_t load, int64_t startUs, bool ok)
+{
+    uint32_t us = (uint32_t)(esp_timer_get_time() - startUs);
+    MAIN_soak_load_stats_t *counters[2] = {&soak_stats.loads[load], &soak_period[load]};
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        counters[i]->count++;
+        counters[i]->totalUs += us;
+        if (us > counters[i]->maxUs)
+        {
+            counters[i]->maxUs = us;
+        }
+        if (!ok)
+        {
+            counters[i]->failures++;
+        }
+    }
+}
+
+/******************************************************************************
+ * Core 1 Jobs
+ *****************************************************************************/
+
+/**
+ * @brief A burst of log lines
+ */
+static void soak_log(void *ctx)
+{
+    (void)ctx;
+    EARS_logger &logger = EARS_logger::getInstance();
+    for (uint8_t i = 0; i < SOAK_LOG_BURST; i++)
+    {
+        int64_t start = esp_timer_get_time();
+        logger.infof("[SOAK] line %lu uptime %lu ms", (unsigned long)soak_stats.loads[SOAK_LOAD_LOG].count,
+                     (unsigned long)millis());
+        soak_count(SOAK_LOAD_LOG, start, true);
+    }
+}
+
+/**
+ * @brief A burst of record puts, cycling over SOAK_RECORD_IDS items
+ */
+static void soak_record(void *ctx)
+{
+    (void)ctx;
+    if (!soak_store.begin(&using_sdcard(), SOAK_RECORD_STORE, RECORD_EQUIPMENT))
+    {
+        soak_count(SOAK_LOAD_RECORD, esp_timer_get_time(), false);
+        return;
+    }
+
+    for (uint8_t i = 0; i < SOAK_RECORD_BURST; i++)
+    {
+        EARS_record record;
+        memset(&record, 0, sizeof(record));
+        record.header.id = 1 + soak_record_id;
+        record.header.type = RECORD_EQUIPMENT;
+        soak_record_id = (soak_record_id + 1) % SOAK_RECORD_IDS;
+
+        EARS_equipmentData *data = (EARS_equipmentData *)record.payload;
+        snprintf(data->name, sizeof(data->name), "Soak item %lu", (unsigned long)record.header.id);
+        snprintf(data->serial, sizeof(data->serial), "SK%08lu", (unsigned long)millis());
+        snprintf(data->category, sizeof(data->category), "Soak %lu", (unsigned long)(record.header.id % 8));
+        data->quantity = (uint16_t)(millis() & 0xFF);
+
+        int64_t start = esp_timer_get_time();
+        bool ok = soak_store.put(record);
+        soak_count(SOAK_LOAD_RECORD, start, ok);
+    }
+}
+
+/**
+ * @brief One NVS write
+ */
+static void soak_nvs(void *ctx)
+{
+    (void)ctx;
+    int64_t start = esp_timer_get_time();
+    bool ok = using_nvseeprom().putVersion(SOAK_NVS_KEY, (uint16_t)++soak_nvs_writes);
+    soak_count(SOAK_LOAD_NVS, start, ok);
+}
+
+/**
+ * @brief Replace one churn file (removed, then written whole)
+ */
+static void soak_sd(void *ctx)
+{
+    (void)ctx;
+    EARS_sdCard &sd = using_sdcard();
+    if (soak_sd_data == NULL || !sd.isAvailable())
+    {
+        soak_count(SOAK_LOAD_SD, esp_timer_get_time(), false);
+        return;
+    }
+
+    char path[32];
+    snprintf(path, sizeof(path), SOAK_SD_DIR "/churn%u.bin", soak_sd_next);
+    soak_sd_next = (soak_sd_next + 1) % SOAK_SD_FILES;
+
+    // Different contents each time, so nothing is skipped as unchanged
+    memset(soak_sd_data, (int)(soak_stats.loads[SOAK_LOAD_SD].count & 0xFF), 64);
+
+    int64_t start = esp_timer_get_time();
+    sd.removeFile(path);
+    bool ok = sd.writeFileAtomic(path, soak_sd_data, SOAK_SD_FILE_BYTES);
+    soak_count(SOAK_LOAD_SD, start, ok);
+}
+
+/**
+ * @brief Start the input script again once a run has ended (UI task)
+ */
+static void soak_replay_start(void *ctx, uint32_t param)
+{
+    (void)ctx;
+    (void)param;
+    if (MAIN_input_replay_play_start())
+    {
+        soak_stats.replays++;
+    }
+}
+
+/**
+ * @brief Watch for an ended replay run
+ */
+static void soak_replay(void *ctx)
+{
+    (void)ctx;
+    MAIN_input_replay_stats_t replay;
+    MAIN_input_replay_get_stats(&replay);
+    if (replay.state == INPUT_REPLAY_IDLE && replay.runs != soak_replay_runs)
+    {
+        soak_replay_runs = replay.runs;
+        MAIN_ui_cmd_call(soak_replay_start, NULL, 0);
+    }
+}
+
+/**
+ * @brief Snapshot job
+ */
+static void soak_snapshot_job(void *ctx)
+{
+    (void)ctx;
+    MAIN_soak_snapshot();
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Register the load and snapshot jobs
+ */
+bool MAIN_initialise_soak(void)
+{
+    soak_stats.startMs = millis();
+
+    // Past 4 KB malloc takes it from PSRAM
+    soak_sd_data = (uint8_t *)malloc(SOAK_SD_FILE_BYTES);
+    if (soak_sd_data != NULL)
+    {
+        for (uint32_t i = 0; i < SOAK_SD_FILE_BYTES; i++)
+        {
+            soak_sd_data[i] = (uint8_t)(i * 31);
+        }
+        using_sdcard().createDirectory(SOAK_SD_DIR);
+    }
+
+    MAIN_input_replay_stats_t replay;
+    MAIN_input_replay_get_stats(&replay);
+    soak_replay_runs = replay.runs;
+
+    struct
+    {
+        const char *name;
+        MAIN_job_fn_t fn;
+        uint32_t periodMs;
+    } const jobs[] = {
+        {"soak log", soak_log, SOAK_LOG_PERIOD_MS},
+        {"soak record", soak_record, SOAK_RECORD_PERIOD_MS},
+        {"soak nvs", soak_nvs, SOAK_NVS_PERIOD_MS},
+        {"soak sd", soak_sd, SOAK_SD_PERIOD_MS},
+        {"soak replay", soak_replay, SOAK_REPLAY_CHECK_MS},
+        {"soak snapshot", soak_snapshot_job, SOAK_SNAPSHOT_MS},
+    };
+
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(jobs) / sizeof(jobs[0]); i++)
+    {
+        if (jobs[i].periodMs == 0)
+        {
+            continue;
+        }
+        if (MAIN_job_add(jobs[i].name, jobs[i].fn, NULL, jobs[i].periodMs, jobs[i].periodMs, JOB_PRIORITY_LOW, 0) ==
+            JOB_INVALID)
+        {
+            Serial.printf("[SOAK] ERROR: No job slot for %s\n", jobs[i].name);
+            ok = false;
+        }
+    }
+
+    Serial.printf("[SOAK] Soak load running, snapshots every %lu s to " SOAK_CSV_PATH "\n",
+                  (unsigned long)(SOAK_SNAPSHOT_MS / 1000));
+    return ok;
+}
+
+/**
+ * @brief Write a snapshot row and start a new period
+ */
+void MAIN_soak_snapshot(void)
+{
+    MAIN_mem_stats_t mem;
+    MAIN_mem_telemetry_get_stats(&mem);
+    MAIN_telemetry_sample_t sample;
+    bool haveSample = MAIN_telemetry_get_latest(&sample);
+    EARS_logger &logger = EARS_logger::getInstance();
+
+    char row[512];
+    int length = snprintf(row, sizeof(row), "%llu,%s.%s.%s,%lu,%lu,%lu,%u,%lu,%lu,%lu,%lu,%u,%lu,%lu,%lu,%lu,%lu,%lu,%lu",
+                          (unsigned long long)EARS_APP_BUILD_TIMESTAMP,
+                          EARS_APP_VERSION_MAJOR, EARS_APP_VERSION_MINOR, EARS_APP_VERSION_PATCH,
+                          (unsigned long)((millis() - soak_stats.startMs) / 1000),
+                          (unsigned long)mem.regions[MEM_REGION_INTERNAL].freeBytes,
+                          (unsigned long)mem.regions[MEM_REGION_INTERNAL].largestBlock,
+                          mem.regions[MEM_REGION_INTERNAL].fragPercent,
+                          (unsigned long)mem.regions[MEM_REGION_DMA].largestBlock,
+                          (unsigned long)mem.regions[MEM_REGION_PSRAM].freeBytes,
+                          (unsigned long)mem.regions[MEM_REGION_PSRAM].largestBlock,
+                          (unsigned long)mem.lvglFree, mem.lvglFragPercent, (unsigned long)mem.flowFree,
+                          (unsigned long)logger.getLogFileSize(), (unsigned long)logger.getDroppedRecords(),
+                          (unsigned long)(haveSample ? sample.value[TELEMETRY_CPU0] : TELEMETRY_UNKNOWN),
+                          (unsigned long)(haveSample ? sample.value[TELEMETRY_CPU1] : TELEMETRY_UNKNOWN),
+                          (unsigned long)(haveSample ? sample.value[TELEMETRY_FPS] : 0),
+                          (unsigned long)soak_stats.replays);
+
+    for (uint8_t load = 0; load < SOAK_LOAD_COUNT; load++)
+    {
+        const MAIN_soak_load_stats_t *period = &soak_period[load];
+        length += snprintf(row + length, sizeof(row) - length, ",%lu,%lu,%lu,%lu", (unsigned long)period->count,
+                           (unsigned long)period->failures,
+                           (unsigned long)(period->count ? period->totalUs / period->count : 0),
+                           (unsigned long)period->maxUs);
+    }
+    snprintf(row + length, sizeof(row) - length, ",%lu\n", (unsigned long)soak_store.count());
+    memset(soak_period, 0, sizeof(soak_period));
+
+    EARS_sdCard &sd = using_sdcard();
+    bool saved = sd.isAvailable() && sd.createDirectory(INPUT_REPLAY_DIR);
+    if (saved && !sd.fileExists(SOAK_CSV_PATH))
+    {
+        char header[512];
+        length = snprintf(header, sizeof(header),
+                          "build,version,uptime_s,heap_free,heap_largest,heap_frag,dma_largest,psram_free,psram_largest,"
+                          "lvgl_free,lvgl_frag,flow_free,log_bytes,log_dropped,cpu0,cpu1,fps_x10,replays");
+        for (uint8_t load = 0; load < SOAK_LOAD_COUNT; load++)
+        {
+            const char *name = soak_load_names[load];
+            length += snprintf(header + length, sizeof(header) - length, ",%s_ops,%s_fail,%s_avg_us,%s_max_us",
+                               name, name, name, name);
+        }
+        snprintf(header + length, sizeof(header) - length, ",records\n");
+        saved = sd.appendFile(SOAK_CSV_PATH, header);
+    }
+    if (saved)
+    {
+        saved = sd.appendFile(SOAK_CSV_PATH, row);
+        sd.flush(SOAK_CSV_PATH);
+    }
+
+    if (saved)
+    {
+        soak_stats.snapshots++;
+    }
+    else
+    {
+        soak_stats.snapshotFailures++;
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[SOAK] %s", row);
+#endif
+}
+
+/**
+ * @brief Soak counters
+ */
+void MAIN_soak_get_stats(MAIN_soak_stats_t *stats)
+{
+    *stats = soak_stats;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Soak_getLibraryName() {
+    return MAIN_Soak::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Soak_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Soak::VERSION_MAJOR,
+                       MAIN_Soak::VERSION_MINOR,
+                       MAIN_Soak::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Soak_getVersionDate() {
+    return MAIN_Soak::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Soak_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Soak_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/******************************************************************************
+ * End of MAIN_soakLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,166 @@
+/**
+ * @file MAIN_soakLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Soak-test mode: hours of sustained load with periodic snapshots
+ * @details Slow degradation (heap fragmentation, a growing log, an SD card
+ *          that gets slower as it fills) never shows up in a few minutes of
+ *          testing. Built with -D EARS_SOAK=1 (pio env soak), the firmware
+ *          keeps every subsystem busy for as long as it runs:
+ *
+ *          - the input script replayed in a loop (MAIN_inputReplayLib),
+ *            each run appending its frame-time row to the replay results
+ *          - SOAK_LOG_BURST lines through EARS_logger every SOAK_LOG_PERIOD_MS
+ *          - SOAK_RECORD_BURST puts into a separate "soak" record store
+ *            every SOAK_RECORD_PERIOD_MS, over SOAK_RECORD_IDS items, so
+ *            the store grows by updates as well as inserts
+ *          - one NVS write every SOAK_NVS_PERIOD_MS
+ *          - one SOAK_SD_FILE_BYTES file replaced every SOAK_SD_PERIOD_MS,
+ *            cycling over SOAK_SD_FILES files
+ *
+ *          Every load is a Core 1 job, timed per operation. Every
+ *          SOAK_SNAPSHOT_MS a row goes to SOAK_CSV_PATH. It holds the
+ *          memory regions, the LVGL and flow heaps, the log size and drops,
+ *          telemetry CPU and FPS, and each load's count, failures, and
+ *          average and worst time over the period. A trend in any column
+ *          over hours is the degradation to look for.
+ *
+ *          Any rate is set with -D; a period of 0 turns that load off. The
+ *          NVS load wears flash: one write every 10 s is about 8600 a day.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_SOAK_LIB_H__
+#define __MAIN_SOAK_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Soak
+{
+    constexpr const char* LIB_NAME = "MAIN_Soak";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_Soak_getLibraryName();
+uint32_t MAIN_Soak_getVersionEncoded();
+const char* MAIN_Soak_getVersionDate();
+void MAIN_Soak_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Soak Configuration
+ *****************************************************************************/
+
+#ifndef EARS_SOAK
+#define EARS_SOAK 0
+#endif
+
+// Snapshot period and file
+#ifndef SOAK_SNAPSHOT_MS
+#define SOAK_SNAPSHOT_MS (5 * 60 * 1000UL)
+#endif
+#define SOAK_CSV_PATH "/bench/soak.csv"
+
+// Logging: lines per run, run period
+#ifndef SOAK_LOG_PERIOD_MS
+#define SOAK_LOG_PERIOD_MS 100
+#endif
+#define SOAK_LOG_BURST 10
+
+// Record store: puts per run, run period, distinct item IDs
+#ifndef SOAK_RECORD_PERIOD_MS
+#define SOAK_RECORD_PERIOD_MS 1000
+#endif
+#define SOAK_RECORD_BURST 4
+#define SOAK_RECORD_IDS 5000
+#define SOAK_RECORD_STORE "soak"
+
+// NVS: one write per period
+#ifndef SOAK_NVS_PERIOD_MS
+#define SOAK_NVS_PERIOD_MS 10000
+#endif
+#define SOAK_NVS_KEY "soak_writes"
+
+// SD churn: one file replaced per period, cycling over SOAK_SD_FILES
+#ifndef SOAK_SD_PERIOD_MS
+#define SOAK_SD_PERIOD_MS 2000
+#endif
+#define SOAK_SD_DIR "/soak"
+#define SOAK_SD_FILES 8
+#define SOAK_SD_FILE_BYTES (16 * 1024U)
+
+// How often an ended replay is started again
+#define SOAK_REPLAY_CHECK_MS 1000
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef enum
+{
+    SOAK_LOAD_LOG = 0,
+    SOAK_LOAD_RECORD,
+    SOAK_LOAD_NVS,
+    SOAK_LOAD_SD,
+    SOAK_LOAD_COUNT
+} MAIN_soak_load_t;
+
+typedef struct
+{
+    uint32_t count;             // Operations
+    uint32_t failures;          // Of those, failed
+    uint64_t totalUs;           // Time in them
+    uint32_t maxUs;             // Slowest one
+} MAIN_soak_load_stats_t;
+
+typedef struct
+{
+    MAIN_soak_load_stats_t loads[SOAK_LOAD_COUNT];  // Since start
+    uint32_t snapshots;         // Rows written
+    uint32_t snapshotFailures;  // Rows that could not be written
+    uint32_t replays;           // Replay runs started
+    uint32_t startMs;           // millis() at MAIN_initialise_soak()
+} MAIN_soak_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Register the load and snapshot jobs
+ * @return true if every enabled job was registered
+ * @note After MAIN_initialise_input_replay(); the loads start with the job
+ *       scheduler.
+ */
+bool MAIN_initialise_soak(void);
+
+/**
+ * @brief Write a snapshot row now (Core 1 job context)
+ */
+void MAIN_soak_snapshot(void);
+
+/**
+ * @brief Soak counters
+ * @param stats Receives the counters
+ */
+void MAIN_soak_get_stats(MAIN_soak_stats_t *stats);
+
+#endif // __MAIN_SOAK_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_soakLib.h
+ ******************************************************************************/
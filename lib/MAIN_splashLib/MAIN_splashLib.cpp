@@ -0,0 +1,117 @@
+/**
+ * @file MAIN_splashLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Boot splash pushed straight to the panel before LVGL starts
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_splashLib.h"
+#include "EARS_systemDef.h"
+#include "MAIN_animationLib.h"
+#include "MAIN_bootProfilerLib.h"
+#include "MAIN_resumeLib.h"
+#include <esp_heap_caps.h>
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static bool splash_shown = false;
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Fill the screen and draw the splash, centred
+ */
+bool MAIN_splash_show(Arduino_GFX *gfx)
+{
+    // Woken from deep sleep: the screen it slept on, in place of the splash
+    if (MAIN_resume_show_snapshot(gfx))
+    {
+        splash_shown = true;
+        MAIN_boot_profile_mark("splash");
+        return true;
+    }
+
+#if EARS_SPLASH == 1
+    gfx->fillScreen(SPLASH_BACKGROUND);
+
+    const MAIN_anim_asset_t *asset = MAIN_animation_find_asset(ANIM_STARTUP_ASSET);
+    if (asset == NULL)
+    {
+        return false;
+    }
+
+    // Frame 0 is a key frame; both backends copy it out before returning
+    uint8_t *pixels = (uint8_t *)heap_caps_malloc(MAIN_animation_frame_bytes(asset), MALLOC_CAP_8BIT);
+    if (pixels == NULL)
+    {
+        return false;
+    }
+
+    if (MAIN_animation_decode_frame(asset, 0, pixels, asset->width * ANIM_BYTES_PER_PIXEL))
+    {
+        // Where lv_obj_center() puts the startup animation
+        gfx->draw16bitRGBBitmap((gfx->width() - asset->width) / 2, (gfx->height() - asset->height) / 2,
+                                (uint16_t *)pixels, asset->width, asset->height);
+        splash_shown = true;
+        MAIN_boot_profile_mark("splash");
+    }
+    heap_caps_free(pixels);
+
+    DEBUG_PRINTF("[%s] Splash '%s' (%ux%u)\n", splash_shown ? "OK" : "WARN", asset->name, asset->width,
+                 asset->height);
+    return splash_shown;
+#else
+    (void)gfx;
+    return false;
+#endif
+}
+
+/**
+ * @brief Check whether the splash is on the panel
+ */
+bool MAIN_splash_is_shown(void)
+{
+    return splash_shown;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Splash_getLibraryName() {
+    return MAIN_Splash::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Splash_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Splash::VERSION_MAJOR,
+                       MAIN_Splash::VERSION_MINOR,
+                       MAIN_Splash::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Splash_getVersionDate() {
+    return MAIN_Splash::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Splash_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Splash_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_splashLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,92 @@
+/**
+ * @file MAIN_splashLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Boot splash pushed straight to the panel before LVGL starts
+ * @details setup() brings the display up before anything else, ahead of
+ *          the Serial wait and the boot stages, and MAIN_initialise_display
+ *          draws the splash while the backlight is still off. The first
+ *          light is the splash, a few hundred ms after reset, while LVGL,
+ *          touch, NVS and the SD card are still initialising.
+ *
+ *          The splash is frame 0 of the startup animation (ANIM_STARTUP_ASSET),
+ *          decoded from its compressed flash data and written with
+ *          draw16bitRGBBitmap (DMA on both display backends), centred on the
+ *          theme's TRUE_BLACK background. LVGL's first frame draws the same
+ *          background with the startup animation centred on the same frame,
+ *          so the hand-over does not show.
+ *
+ *          On a wake from deep sleep the saved screen (MAIN_resumeLib) is
+ *          drawn instead, with or without EARS_SPLASH.
+ *
+ *          -D EARS_SPLASH=0 leaves the panel black until LVGL's first frame.
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_SPLASH_LIB_H__
+#define __MAIN_SPLASH_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <Arduino_GFX_Library.h>
+#include "EARS_versionDef.h"
+#include "EARS_rgb565ColoursDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Splash
+{
+    constexpr const char* LIB_NAME = "MAIN_Splash";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "1";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_Splash_getLibraryName();
+uint32_t MAIN_Splash_getVersionEncoded();
+const char* MAIN_Splash_getVersionDate();
+void MAIN_Splash_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Splash Configuration
+ *****************************************************************************/
+
+// 1 = draw the splash during display initialisation
+#ifndef EARS_SPLASH
+#define EARS_SPLASH 1
+#endif
+
+// Screen behind the splash: the theme's screen background
+#define SPLASH_BACKGROUND EARS_RGB565_TRUE_BLACK
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Fill the screen and draw the splash, centred
+ * @param gfx Display, initialised and rotated
+ * @return true if the splash was drawn (false: disabled, or no asset or memory)
+ * @note Boot only, before LVGL owns the display.
+ */
+bool MAIN_splash_show(Arduino_GFX *gfx);
+
+/**
+ * @brief Check whether the splash is on the panel
+ * @return true once MAIN_splash_show() has drawn it
+ */
+bool MAIN_splash_is_shown(void);
+
+#endif // __MAIN_SPLASH_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_splashLib.h
+ ******************************************************************************/
@@ -0,0 +1,307 @@
+/**
+ * @file MAIN_statusBarLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Status bar on the top layer, updated on its own cadence
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_statusBarLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_timeLib.h"
+#include "EARS_sdCardLib.h"
+#include "EARS_syncLib.h"
+#include "MAIN_powerMonitorLib.h"
+#include "MAIN_jobSchedulerLib.h"
+#include "MAIN_uiCommandLib.h"
+#include "MAIN_themeLib.h"
+#include "MAIN_fontLib.h"
+#include <time.h>
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+// Sampled value not known yet (never equal to a real one)
+#define STATUS_VALUE_NONE 0xFFFFFFU
+
+// Bar and one label per field (UI task only)
+static lv_obj_t *status_bar = NULL;
+static lv_obj_t *status_labels[STATUS_FIELD_COUNT];
+
+// Values last posted to the UI task (Core 1 job only)
+static uint32_t status_posted[STATUS_FIELD_COUNT];
+
+static MAIN_status_bar_stats_t status_stats;
+
+/******************************************************************************
+ * UI Task
+ *****************************************************************************/
+
+/**
+ * @brief Text for a sampled value
+ * @param field Field
+ * @param value Value as packed by status_bar_sample
+ */
+static void status_bar_format(MAIN_status_field_t field, uint32_t value, char *text, size_t size)
+{
+    switch (field)
+    {
+    case STATUS_FIELD_CLOCK:
+        if (value == STATUS_VALUE_NONE)
+        {
+            snprintf(text, size, "--:--");
+        }
+        else
+        {
+            snprintf(text, size, "%02lu:%02lu", (unsigned long)(value / 60), (unsigned long)(value % 60));
+        }
+        break;
+
+    case STATUS_FIELD_SYNC:
+    {
+        static const char *const names[] = {"", "CONNECT", "SYNC", "SYNC ERR"};
+        uint8_t state = value & 0xFF;
+        bool pending = (value >> 8) != 0;
+        snprintf(text, size, "%s", (state == SYNC_IDLE) ? (pending ? "PENDING" : "") : names[state & 0x03]);
+        break;
+    }
+
+    case STATUS_FIELD_SD:
+        snprintf(text, size, "%s", value ? "SD" : "NO SD");
+        break;
+
+    case STATUS_FIELD_BATTERY:
+    {
+        uint8_t percent = value & 0xFF;
+        MAIN_battery_state_t state = (MAIN_battery_state_t)(value >> 8);
+        if (state == POWER_BATTERY_ABSENT)
+        {
+            snprintf(text, size, "USB");
+        }
+        else if (percent > 100)
+        {
+            snprintf(text, size, "--%%");
+        }
+        else
+        {
+            snprintf(text, size, "%s%u%%", (state == POWER_BATTERY_CHARGING) ? "+" : "", percent);
+        }
+        break;
+    }
+
+    default:
+        text[0] = '\0';
+        break;
+    }
+}
+
+/**
+ * @brief Show one changed value (UI task, through MAIN_ui_cmd_call)
+ * @param param Field in the top 8 bits, value in the low 24
+ */
+static void status_bar_apply(void *ctx, uint32_t param)
+{
+    (void)ctx;
+    MAIN_status_field_t field = (MAIN_status_field_t)(param >> 24);
+    if (field >= STATUS_FIELD_COUNT || status_labels[field] == NULL)
+    {
+        return;
+    }
+
+    char text[16];
+    status_bar_format(field, param & STATUS_VALUE_NONE, text, sizeof(text));
+
+    // Same text (e.g. battery discharging to full, both shown as 100%): no invalidation
+    if (strcmp(lv_label_get_text(status_labels[field]), text) != 0)
+    {
+        lv_label_set_text(status_labels[field], text);
+        status_stats.redraws++;
+    }
+}
+
+/**
+ * @brief One fixed-size, clipped label
+ * @param align LV_ALIGN_LEFT_MID or LV_ALIGN_RIGHT_MID
+ * @param x Offset from that edge
+ */
+static lv_obj_t *status_bar_label(int32_t width, lv_align_t align, int32_t x, lv_text_align_t textAlign)
+{
+    lv_obj_t *label = lv_label_create(status_bar);
+    lv_obj_set_size(label, width, lv_font_get_line_height(MAIN_font_get(STATUS_BAR_FONT_SIZE)));
+    lv_obj_align(label, align, x, 0);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_MODE_CLIP);
+    lv_obj_set_style_text_align(label, textAlign, 0);
+    lv_label_set_text_static(label, "");
+    return label;
+}
+
+/******************************************************************************
+ * Core 1 Job
+ *****************************************************************************/
+
+/**
+ * @brief Sample the four values and post those that changed
+ */
+static void status_bar_sample(void *ctx)
+{
+    (void)ctx;
+    uint32_t values[STATUS_FIELD_COUNT];
+
+    // Minute of the day, local time
+    values[STATUS_FIELD_CLOCK] = STATUS_VALUE_NONE;
+    if (using_time().isValid())
+    {
+        time_t now = using_time().now();
+        struct tm local;
+        localtime_r(&now, &local);
+        values[STATUS_FIELD_CLOCK] = (uint32_t)(local.tm_hour * 60 + local.tm_min);
+    }
+
+    EARS_syncStats sync = using_sync().getStats();
+    values[STATUS_FIELD_SYNC] = (uint32_t)sync.state | ((using_sync().getPending() > 0) ? 0x100U : 0U);
+    values[STATUS_FIELD_SD] = using_sdcard().isAvailable() ? 1U : 0U;
+    values[STATUS_FIELD_BATTERY] = (uint32_t)MAIN_power_monitor_get_percent() |
+                                   ((uint32_t)MAIN_power_monitor_get_state() << 8);
+
+    status_stats.samples++;
+    for (uint8_t field = 0; field < STATUS_FIELD_COUNT; field++)
+    {
+        if (values[field] == status_posted[field])
+        {
+            continue;
+        }
+
+        // A refused post leaves the old value, so the next run sends it again
+        if (MAIN_ui_cmd_call(status_bar_apply, NULL, ((uint32_t)field << 24) | (values[field] & STATUS_VALUE_NONE)))
+        {
+            status_posted[field] = values[field];
+            status_stats.posted++;
+        }
+        else
+        {
+            status_stats.dropped++;
+        }
+    }
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Create the bar on the top layer and register the sampling job
+ */
+bool MAIN_initialise_status_bar(void)
+{
+    if (status_bar != NULL)
+    {
+        return true;
+    }
+
+    status_bar = lv_obj_create(lv_layer_top());
+    if (status_bar == NULL)
+    {
+        return false;
+    }
+
+    // Opaque theme panel, bottom border only; nothing in it lays out
+    lv_obj_remove_style_all(status_bar);
+    lv_style_t *panel = MAIN_theme_get_style(THEME_STYLE_PANEL);
+    if (panel != NULL)
+    {
+        lv_obj_add_style(status_bar, panel, 0);
+    }
+    lv_obj_set_style_bg_opa(status_bar, LV_OPA_COVER, 0);
+    lv_obj_set_style_border_side(status_bar, LV_BORDER_SIDE_BOTTOM, 0);
+    lv_obj_set_style_radius(status_bar, 0, 0);
+    lv_obj_set_style_pad_all(status_bar, 0, 0);
+    lv_obj_set_style_text_font(status_bar, MAIN_font_get(STATUS_BAR_FONT_SIZE), 0);
+    lv_obj_set_size(status_bar, LV_PCT(100), STATUS_BAR_HEIGHT);
+    lv_obj_set_pos(status_bar, 0, 0);
+    lv_obj_remove_flag(status_bar, (lv_obj_flag_t)(LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE));
+
+    int32_t right = STATUS_BAR_PAD;
+    status_labels[STATUS_FIELD_CLOCK] =
+        status_bar_label(STATUS_BAR_CLOCK_W, LV_ALIGN_LEFT_MID, STATUS_BAR_PAD, LV_TEXT_ALIGN_LEFT);
+    status_labels[STATUS_FIELD_BATTERY] =
+        status_bar_label(STATUS_BAR_BATTERY_W, LV_ALIGN_RIGHT_MID, -right, LV_TEXT_ALIGN_RIGHT);
+    right += STATUS_BAR_BATTERY_W;
+    status_labels[STATUS_FIELD_SD] = status_bar_label(STATUS_BAR_SD_W, LV_ALIGN_RIGHT_MID, -right, LV_TEXT_ALIGN_RIGHT);
+    right += STATUS_BAR_SD_W;
+    status_labels[STATUS_FIELD_SYNC] =
+        status_bar_label(STATUS_BAR_SYNC_W, LV_ALIGN_RIGHT_MID, -right, LV_TEXT_ALIGN_RIGHT);
+
+    // First run posts every field
+    for (uint8_t field = 0; field < STATUS_FIELD_COUNT; field++)
+    {
+        status_posted[field] = STATUS_VALUE_NONE + 1;
+    }
+
+    if (MAIN_job_add("status", status_bar_sample, NULL, 0, STATUS_BAR_PERIOD_MS, JOB_PRIORITY_LOW, 0) == JOB_INVALID)
+    {
+        Serial.println("[STATUS] ERROR: No job slot, bar stays empty");
+        return false;
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[STATUS] Bar on the top layer, %u lines, sampled every %u ms\n", STATUS_BAR_HEIGHT,
+                  STATUS_BAR_PERIOD_MS);
+#endif
+    return true;
+}
+
+/**
+ * @brief Show or hide the bar
+ */
+void MAIN_status_bar_set_visible(bool visible)
+{
+    if (status_bar != NULL)
+    {
+        lv_obj_set_flag(status_bar, LV_OBJ_FLAG_HIDDEN, !visible);
+    }
+}
+
+/**
+ * @brief Bar counters
+ */
+void MAIN_status_bar_get_stats(MAIN_status_bar_stats_t *stats)
+{
+    *stats = status_stats;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_StatusBar_getLibraryName() {
+    return MAIN_StatusBar::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_StatusBar_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_StatusBar::VERSION_MAJOR,
+                       MAIN_StatusBar::VERSION_MINOR,
+                       MAIN_StatusBar::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_StatusBar_getVersionDate() {
+    return MAIN_StatusBar::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_StatusBar_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_StatusBar_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/******************************************************************************
+ * End of MAIN_statusBarLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,121 @@
+/**
+ * @file MAIN_statusBarLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Status bar on the top layer, updated on its own cadence
+ * @details Clock, sync state, SD card and battery in a bar on lv_layer_top,
+ *          above every screen. A Core 1 job samples the four values every
+ *          STATUS_BAR_PERIOD_MS and posts only the ones that changed to
+ *          the UI task through MAIN_uiCommandLib, so the bar costs nothing
+ *          between changes and the screens' refresh levels are not held up.
+ *
+ *          Each value has its own label of fixed size (clipped, no layout
+ *          container), so a new value invalidates just that label's
+ *          rectangle: no re-layout of the bar or the screen, and a flush of
+ *          a few hundred pixels. The clock shows hours and minutes and so
+ *          changes once a minute.
+ *
+ *          The bar covers the top STATUS_BAR_HEIGHT lines of the screen.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_STATUS_BAR_LIB_H__
+#define __MAIN_STATUS_BAR_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include <lvgl.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_StatusBar
+{
+    constexpr const char* LIB_NAME = "MAIN_StatusBar";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_StatusBar_getLibraryName();
+uint32_t MAIN_StatusBar_getVersionEncoded();
+const char* MAIN_StatusBar_getVersionDate();
+void MAIN_StatusBar_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Status Bar Configuration
+ *****************************************************************************/
+
+// Core 1 sampling period
+#define STATUS_BAR_PERIOD_MS 1000
+
+// Bar height, text size and side padding
+#define STATUS_BAR_HEIGHT 18
+#define STATUS_BAR_FONT_SIZE 12
+#define STATUS_BAR_PAD 4
+
+// Field widths: clock on the left, sync, SD and battery from the right
+#define STATUS_BAR_CLOCK_W 40
+#define STATUS_BAR_SYNC_W 64
+#define STATUS_BAR_SD_W 40
+#define STATUS_BAR_BATTERY_W 56
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef enum
+{
+    STATUS_FIELD_CLOCK = 0,
+    STATUS_FIELD_SYNC,
+    STATUS_FIELD_SD,
+    STATUS_FIELD_BATTERY,
+    STATUS_FIELD_COUNT
+} MAIN_status_field_t;
+
+typedef struct
+{
+    uint32_t samples;           // Core 1 sampling runs
+    uint32_t posted;            // Changed values sent to the UI task
+    uint32_t dropped;           // Posts refused by a full command queue (resent next run)
+    uint32_t redraws;           // Labels whose text changed
+} MAIN_status_bar_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Create the bar on the top layer and register the sampling job
+ * @return true if created
+ * @note UI task (or setup() before the tasks start), after the theme.
+ */
+bool MAIN_initialise_status_bar(void);
+
+/**
+ * @brief Show or hide the bar
+ * @param visible true to show
+ * @note UI task.
+ */
+void MAIN_status_bar_set_visible(bool visible);
+
+/**
+ * @brief Bar counters
+ * @param stats Receives the counters
+ */
+void MAIN_status_bar_get_stats(MAIN_status_bar_stats_t *stats);
+
+#endif // __MAIN_STATUS_BAR_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_statusBarLib.h
+ ******************************************************************************/
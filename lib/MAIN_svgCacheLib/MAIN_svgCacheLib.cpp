@@ -0,0 +1,906 @@
+/**
+ * @file MAIN_svgCacheLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief SVG icons rasterised once per size and drawn as plain bitmaps
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_svgCacheLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_sdCardLib.h"
+#include "MAIN_jobSchedulerLib.h"
+#include "MAIN_memPlanLib.h"
+#include <lvgl_private.h>
+#include <esp_heap_caps.h>
+
+#if LV_USE_SVG && LV_USE_VECTOR_GRAPHIC && (LV_USE_THORVG_INTERNAL || LV_USE_THORVG_EXTERNAL)
+#define SVG_CACHE_ENABLED 1
+#else
+#define SVG_CACHE_ENABLED 0
+#endif
+
+#if SVG_CACHE_ENABLED == 1
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint8_t *data;              // RGB565 plane, then the A8 plane (NULL = free slot)
+    uint32_t pathHash;
+    uint32_t contentHash;       // Of the SVG file, keys the SD copy
+    uint32_t lastUse;
+    uint16_t pins;
+    bool ownSize;               // Made for a file source at the SVG's own size
+    lv_image_dsc_t image;
+    char path[SVG_CACHE_PATH_MAX];
+} svg_cache_entry_t;
+
+typedef struct
+{
+    uint32_t magic;
+    uint16_t width;
+    uint16_t height;
+    uint32_t contentHash;
+    uint32_t reserved;
+} svg_cache_file_header_t;
+
+typedef struct
+{
+    char path[48];              // SD path of the bitmap
+    uint32_t length;            // File header and pixels that follow
+} svg_cache_save_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+#define SVG_CACHE_MAGIC 0x43475653UL // "SVGC"
+
+static svg_cache_entry_t svg_cache_entries[SVG_CACHE_ENTRIES];
+static char svg_cache_pending[SVG_CACHE_PENDING][SVG_CACHE_PATH_MAX];
+static MAIN_svg_cache_stats_t svg_cache_stats;
+static uint32_t svg_cache_bytes = 0;
+static uint32_t svg_cache_clock = 0;
+static bool svg_cache_ready = false;
+static portMUX_TYPE svg_cache_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Draw buffers handed to LVGL point at the entry's pixels; freeing them
+// frees only the lv_draw_buf_t
+static void svg_cache_buf_free(void *buf)
+{
+    (void)buf;
+}
+
+static lv_draw_buf_handlers_t svg_cache_handlers;
+
+/******************************************************************************
+ * Static Functions (internal to library)
+ *****************************************************************************/
+
+/**
+ * @brief FNV-1a hash
+ * @param data Bytes
+ * @param length Byte count
+ * @return uint32_t Hash
+ */
+static uint32_t svg_cache_hash(const uint8_t *data, size_t length)
+{
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= data[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Find a bitmap of a file
+ * @param path LVGL path
+ * @param width Width wanted (0 = the own-size bitmap)
+ * @param height Height wanted
+ * @return svg_cache_entry_t* Entry, or NULL
+ */
+static svg_cache_entry_t *svg_cache_find(const char *path, int32_t width, int32_t height)
+{
+    uint32_t pathHash = svg_cache_hash((const uint8_t *)path, strlen(path));
+    for (uint8_t i = 0; i < SVG_CACHE_ENTRIES; i++)
+    {
+        svg_cache_entry_t *e = &svg_cache_entries[i];
+        if (e->data == NULL || e->pathHash != pathHash || strcmp(e->path, path) != 0)
+        {
+            continue;
+        }
+        if (width == 0 ? e->ownSize : (e->image.header.w == width && e->image.header.h == height))
+        {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Free a bitmap
+ * @param e Entry (unpinned)
+ * @note LVGL task.
+ */
+static void svg_cache_drop(svg_cache_entry_t *e)
+{
+    if (e->ownSize)
+    {
+        // The header cache holds this decoder for the path
+        lv_image_header_cache_drop(e->path);
+    }
+
+    portENTER_CRITICAL(&svg_cache_lock);
+    svg_cache_bytes -= e->image.data_size;
+    portEXIT_CRITICAL(&svg_cache_lock);
+
+    MAIN_mem_free(e->data);
+    e->data = NULL;
+}
+
+/**
+ * @brief Evict unpinned bitmaps, least recently used first, until one fits
+ * @param bytes Bitmap size
+ * @return svg_cache_entry_t* Free slot, or NULL if pinned bitmaps fill the cache
+ */
+static svg_cache_entry_t *svg_cache_make_room(uint32_t bytes)
+{
+    while (true)
+    {
+        svg_cache_entry_t *free = NULL;
+        svg_cache_entry_t *oldest = NULL;
+        for (uint8_t i = 0; i < SVG_CACHE_ENTRIES; i++)
+        {
+            svg_cache_entry_t *e = &svg_cache_entries[i];
+            if (e->data == NULL)
+            {
+                free = free ? free : e;
+            }
+            else if (e->pins == 0 && (oldest == NULL || e->lastUse < oldest->lastUse))
+            {
+                oldest = e;
+            }
+        }
+
+        if (free != NULL && svg_cache_bytes + bytes <= SVG_CACHE_BYTES)
+        {
+            return free;
+        }
+        if (oldest == NULL)
+        {
+            return NULL;
+        }
+
+        svg_cache_drop(oldest);
+        svg_cache_stats.evictions++;
+    }
+}
+
+/**
+ * @brief Read a whole file through LVGL's file system
+ * @param path LVGL path
+ * @param size Receives the byte count
+ * @return uint8_t* Contents (lv_free), or NULL
+ */
+static uint8_t *svg_cache_read_file(const char *path, uint32_t *size)
+{
+    lv_fs_file_t file;
+    if (lv_fs_open(&file, path, LV_FS_MODE_RD) != LV_FS_RES_OK)
+    {
+        return NULL;
+    }
+
+    uint8_t *data = NULL;
+    uint32_t length = 0;
+    uint32_t got = 0;
+    if (lv_fs_seek(&file, 0, LV_FS_SEEK_END) == LV_FS_RES_OK && lv_fs_tell(&file, &length) == LV_FS_RES_OK &&
+        length > 0 && lv_fs_seek(&file, 0, LV_FS_SEEK_SET) == LV_FS_RES_OK)
+    {
+        data = (uint8_t *)lv_malloc(length);
+        if (data != NULL && (lv_fs_read(&file, data, length, &got) != LV_FS_RES_OK || got != length))
+        {
+            lv_free(data);
+            data = NULL;
+        }
+    }
+    lv_fs_close(&file);
+
+    *size = length;
+    return data;
+}
+
+/**
+ * @brief SD path of a bitmap
+ * @param buffer Receives the path (svg_cache_save_t::path)
+ * @param e Entry with its hash and size set
+ */
+static void svg_cache_disk_path(char *buffer, const svg_cache_entry_t *e)
+{
+    snprintf(buffer, sizeof(((svg_cache_save_t *)0)->path), SVG_CACHE_DIR "/%08lx_%ux%u.bin",
+             (unsigned long)e->contentHash, (unsigned)e->image.header.w, (unsigned)e->image.header.h);
+}
+
+/**
+ * @brief Load a bitmap written by an earlier boot
+ * @param e Entry with its hash, size and pixels allocated
+ * @return true if loaded
+ */
+static bool svg_cache_disk_load(svg_cache_entry_t *e)
+{
+#if SVG_CACHE_DISK == 1
+    EARS_sdCard &sd = using_sdcard();
+    if (!sd.isAvailable())
+    {
+        return false;
+    }
+
+    char path[sizeof(((svg_cache_save_t *)0)->path)];
+    svg_cache_disk_path(path, e);
+
+    svg_cache_file_header_t header;
+    if (sd.readDataAt(path, 0, (uint8_t *)&header, sizeof(header)) != sizeof(header) ||
+        header.magic != SVG_CACHE_MAGIC || header.width != e->image.header.w ||
+        header.height != e->image.header.h || header.contentHash != e->contentHash)
+    {
+        return false;
+    }
+    return sd.readDataAt(path, sizeof(header), e->data, e->image.data_size) == e->image.data_size;
+#else
+    (void)e;
+    return false;
+#endif
+}
+
+/**
+ * @brief Core 1 job: write a bitmap to the SD card
+ * @param ctx svg_cache_save_t followed by the file contents (freed here)
+ */
+static void svg_cache_save_job(void *ctx)
+{
+    static bool dirReady = false;
+    svg_cache_save_t *save = (svg_cache_save_t *)ctx;
+    EARS_sdCard &sd = using_sdcard();
+
+    // The graphics stage may run before the SD card is mounted
+    if (!dirReady && sd.isAvailable())
+    {
+        sd.createDirectory("/cache");
+        dirReady = sd.createDirectory(SVG_CACHE_DIR);
+    }
+
+    if (dirReady && sd.writeFileAtomic(save->path, (const uint8_t *)(save + 1), save->length))
+    {
+        portENTER_CRITICAL(&svg_cache_lock);
+        svg_cache_stats.diskSaves++;
+        portEXIT_CRITICAL(&svg_cache_lock);
+    }
+    heap_caps_free(save);
+}
+
+/**
+ * @brief Queue a copy of a bitmap for the SD card
+ * @param e Entry just rasterised
+ */
+static void svg_cache_disk_save(const svg_cache_entry_t *e)
+{
+#if SVG_CACHE_DISK == 1
+    if (!using_sdcard().isAvailable())
+    {
+        return;
+    }
+
+    uint32_t length = sizeof(svg_cache_file_header_t) + e->image.data_size;
+    svg_cache_save_t *save = (svg_cache_save_t *)heap_caps_malloc(sizeof(svg_cache_save_t) + length,
+                                                                  MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (save == NULL)
+    {
+        return;
+    }
+
+    svg_cache_disk_path(save->path, e);
+    save->length = length;
+
+    svg_cache_file_header_t *header = (svg_cache_file_header_t *)(save + 1);
+    header->magic = SVG_CACHE_MAGIC;
+    header->width = e->image.header.w;
+    header->height = e->image.header.h;
+    header->contentHash = e->contentHash;
+    header->reserved = 0;
+    memcpy(header + 1, e->data, e->image.data_size);
+
+    if (MAIN_job_add("svgsave", svg_cache_save_job, save, 0, 0, JOB_PRIORITY_LOW, 0) == JOB_INVALID)
+    {
+        heap_caps_free(save);
+    }
+#else
+    (void)e;
+#endif
+}
+
+/**
+ * @brief Run the vector renderer once into the entry's pixels
+ * @param list Parsed SVG
+ * @param iw SVG's own width
+ * @param ih SVG's own height
+ * @param e Entry with its size and pixels allocated
+ * @return true if rendered
+ * @note LVGL task, outside rendering (the draw units are dispatched here).
+ */
+static bool svg_cache_render(const lv_svg_render_obj_t *list, int32_t iw, int32_t ih, svg_cache_entry_t *e)
+{
+    int32_t w = e->image.header.w;
+    int32_t h = e->image.header.h;
+
+    // ThorVG draws into ARGB8888; it is converted to RGB565A8 below
+    lv_draw_buf_t *argb = lv_draw_buf_create_ex(lv_draw_buf_get_image_handlers(), w, h, LV_COLOR_FORMAT_ARGB8888,
+                                                LV_STRIDE_AUTO);
+    if (argb == NULL)
+    {
+        return false;
+    }
+    lv_draw_buf_clear(argb, NULL);
+
+    lv_area_t area = {0, 0, w - 1, h - 1};
+    lv_layer_t layer;
+    lv_layer_init(&layer);
+    layer.draw_buf = argb;
+    layer.color_format = LV_COLOR_FORMAT_ARGB8888;
+    layer.buf_area = area;
+    layer._clip_area = area;
+    layer.phy_clip_area = area;
+
+    lv_vector_dsc_t *ctx = lv_vector_dsc_create(&layer);
+    lv_matrix_t matrix;
+    lv_matrix_identity(&matrix);
+    lv_matrix_scale(&matrix, (float)w / iw, (float)h / ih);
+    ctx->current_dsc.scissor_area = area;
+    lv_vector_dsc_set_transform(ctx, &matrix);
+    lv_draw_svg_render(ctx, list);
+    lv_draw_vector(ctx);
+    lv_vector_dsc_delete(ctx);
+
+    // As lv_canvas_finish_layer()
+    lv_display_t *display = lv_display_get_default();
+    while (layer.draw_task_head)
+    {
+        lv_draw_dispatch_wait_for_request();
+        if (!lv_draw_dispatch_layer(display, &layer))
+        {
+            lv_draw_wait_for_finish();
+            lv_draw_dispatch_request();
+        }
+    }
+
+    // ThorVG's output is premultiplied; RGB565A8 is not
+    uint16_t *rgb = (uint16_t *)e->data;
+    uint8_t *alpha = e->data + (uint32_t)w * h * 2;
+    for (int32_t y = 0; y < h; y++)
+    {
+        const lv_color32_t *src = (const lv_color32_t *)(argb->data + (uint32_t)y * argb->header.stride);
+        for (int32_t x = 0; x < w; x++, src++)
+        {
+            uint8_t a = src->alpha;
+            lv_color_t c = lv_color_make(src->red, src->green, src->blue);
+            if (a != 0 && a != 255)
+            {
+                c.red = (uint8_t)LV_MIN(255, src->red * 255 / a);
+                c.green = (uint8_t)LV_MIN(255, src->green * 255 / a);
+                c.blue = (uint8_t)LV_MIN(255, src->blue * 255 / a);
+            }
+            *rgb++ = lv_color_to_u16(c);
+            *alpha++ = a;
+        }
+    }
+
+    lv_draw_buf_destroy(argb);
+    return true;
+}
+
+/**
+ * @brief Make a bitmap: from the SD card if an earlier boot wrote it, else
+ *        by running the vector renderer
+ * @param path LVGL path
+ * @param width Width (0 = from height and aspect)
+ * @param height Height (0 = from width; both 0 = own size)
+ * @param ownSize Mark the entry as the file source's own-size bitmap
+ * @return svg_cache_entry_t* Entry, or NULL
+ * @note LVGL task, outside rendering.
+ */
+static svg_cache_entry_t *svg_cache_make(const char *path, int32_t width, int32_t height, bool ownSize)
+{
+    if (strlen(path) >= SVG_CACHE_PATH_MAX)
+    {
+        svg_cache_stats.failures++;
+        return NULL;
+    }
+
+    uint32_t fileSize = 0;
+    uint8_t *file = svg_cache_read_file(path, &fileSize);
+    if (file == NULL)
+    {
+        svg_cache_stats.failures++;
+        return NULL;
+    }
+    uint32_t contentHash = svg_cache_hash(file, fileSize);
+
+    lv_svg_node_t *doc = lv_svg_load_data((const char *)file, fileSize);
+    lv_free(file);
+    if (doc == NULL)
+    {
+        svg_cache_stats.failures++;
+        return NULL;
+    }
+    lv_svg_render_obj_t *list = lv_svg_render_create(doc);
+    lv_svg_node_delete(doc);
+    if (list == NULL)
+    {
+        svg_cache_stats.failures++;
+        return NULL;
+    }
+
+    // Own size from the <svg> viewport, as LVGL's decoder reports it
+    int32_t iw = LV_DPI_DEF;
+    int32_t ih = LV_DPI_DEF;
+    if (list->tag == LV_SVG_TAG_SVG)
+    {
+        lv_area_t bounds;
+        list->clz->get_bounds(list, &bounds);
+        iw = LV_MAX(1, lv_area_get_width(&bounds) - 1);
+        ih = LV_MAX(1, lv_area_get_height(&bounds) - 1);
+    }
+
+    if (width == 0 && height == 0)
+    {
+        width = iw;
+        height = ih;
+    }
+    else if (width == 0)
+    {
+        width = LV_MAX(1, height * iw / ih);
+    }
+    else if (height == 0)
+    {
+        height = LV_MAX(1, width * ih / iw);
+    }
+
+    svg_cache_entry_t *e = NULL;
+    uint32_t bytes = (uint32_t)width * height * 3;
+    if (width <= SVG_CACHE_MAX_SIDE && height <= SVG_CACHE_MAX_SIDE)
+    {
+        e = svg_cache_make_room(bytes);
+    }
+    if (e != NULL)
+    {
+        e->data = (uint8_t *)MAIN_mem_alloc(MEM_POOL_SVG_CACHE, bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (e->data == NULL)
+        {
+            e->data = (uint8_t *)MAIN_mem_alloc(MEM_POOL_SVG_CACHE, bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        }
+    }
+    if (e == NULL || e->data == NULL)
+    {
+        lv_svg_render_delete(list);
+        svg_cache_stats.failures++;
+        return NULL;
+    }
+
+    e->pathHash = svg_cache_hash((const uint8_t *)path, strlen(path));
+    e->contentHash = contentHash;
+    e->lastUse = ++svg_cache_clock;
+    e->pins = 0;
+    e->ownSize = ownSize;
+    strcpy(e->path, path);
+
+    memset(&e->image, 0, sizeof(e->image));
+    e->image.header.magic = LV_IMAGE_HEADER_MAGIC;
+    e->image.header.cf = LV_COLOR_FORMAT_RGB565A8;
+    e->image.header.w = width;
+    e->image.header.h = height;
+    e->image.header.stride = width * 2;
+    e->image.data_size = bytes;
+    e->image.data = e->data;
+
+    bool ok = true;
+    if (svg_cache_disk_load(e))
+    {
+        svg_cache_stats.diskLoads++;
+    }
+    else if (svg_cache_render(list, iw, ih, e))
+    {
+        svg_cache_stats.rasterised++;
+        svg_cache_disk_save(e);
+    }
+    else
+    {
+        ok = false;
+    }
+    lv_svg_render_delete(list);
+
+    if (!ok)
+    {
+        MAIN_mem_free(e->data);
+        e->data = NULL;
+        svg_cache_stats.failures++;
+        return NULL;
+    }
+
+    portENTER_CRITICAL(&svg_cache_lock);
+    svg_cache_bytes += bytes;
+    portEXIT_CRITICAL(&svg_cache_lock);
+
+#if EARS_DEBUG == 1
+    Serial.printf("[SVGCACHE] %s at %ldx%ld (%lu bytes)\n", path, (long)width, (long)height, (unsigned long)bytes);
+#endif
+    return e;
+}
+
+/**
+ * @brief Decoder info: own-size bitmaps of "*.svg" file sources
+ * @note A source with no bitmap yet is queued and left to LVGL's decoder.
+ */
+static lv_result_t svg_cache_decoder_info(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *src,
+                                          lv_image_header_t *header)
+{
+    (void)decoder;
+    if (src->src_type != LV_IMAGE_SRC_FILE || lv_strcmp(lv_fs_get_ext((const char *)src->src), "svg") != 0)
+    {
+        return LV_RESULT_INVALID;
+    }
+
+    const char *path = (const char *)src->src;
+    bool found = false;
+    bool queued = false;
+
+    portENTER_CRITICAL(&svg_cache_lock);
+    svg_cache_entry_t *e = svg_cache_find(path, 0, 0);
+    if (e != NULL)
+    {
+        *header = e->image.header;
+        found = true;
+    }
+    else if (strlen(path) < SVG_CACHE_PATH_MAX)
+    {
+        int8_t slot = -1;
+        for (uint8_t i = 0; i < SVG_CACHE_PENDING && !queued; i++)
+        {
+            queued = strcmp(svg_cache_pending[i], path) == 0;
+            if (slot < 0 && svg_cache_pending[i][0] == '\0')
+            {
+                slot = i;
+            }
+        }
+        if (!queued && slot >= 0)
+        {
+            strcpy(svg_cache_pending[slot], path);
+        }
+        svg_cache_stats.vectorFallbacks++;
+    }
+    portEXIT_CRITICAL(&svg_cache_lock);
+
+    return found ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+/**
+ * @brief Decoder open: hand LVGL the cached pixels, pinned until close
+ */
+static lv_result_t svg_cache_decoder_open(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc)
+{
+    (void)decoder;
+    lv_draw_buf_t *buf = (lv_draw_buf_t *)lv_zalloc(sizeof(lv_draw_buf_t));
+    if (buf == NULL)
+    {
+        return LV_RESULT_INVALID;
+    }
+
+    portENTER_CRITICAL(&svg_cache_lock);
+    svg_cache_entry_t *e = svg_cache_find((const char *)dsc->src, 0, 0);
+    if (e != NULL)
+    {
+        e->pins++;
+        e->lastUse = ++svg_cache_clock;
+        svg_cache_stats.hits++;
+    }
+    portEXIT_CRITICAL(&svg_cache_lock);
+
+    if (e == NULL)
+    {
+        lv_free(buf);
+        return LV_RESULT_INVALID;
+    }
+
+    buf->header = e->image.header;
+    buf->header.flags = LV_IMAGE_FLAGS_ALLOCATED;
+    buf->data = e->data;
+    buf->unaligned_data = e->data;
+    buf->data_size = e->image.data_size;
+    buf->handlers = &svg_cache_handlers;
+
+    dsc->decoded = buf;
+    dsc->user_data = e;
+    return LV_RESULT_OK;
+}
+
+/**
+ * @brief Decoder close: unpin the bitmap
+ */
+static void svg_cache_decoder_close(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc)
+{
+    (void)decoder;
+    if (dsc->decoded != NULL)
+    {
+        lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
+        dsc->decoded = NULL;
+    }
+
+    svg_cache_entry_t *e = (svg_cache_entry_t *)dsc->user_data;
+    if (e != NULL)
+    {
+        portENTER_CRITICAL(&svg_cache_lock);
+        e->pins--;
+        portEXIT_CRITICAL(&svg_cache_lock);
+    }
+}
+
+/**
+ * @brief LVGL timer: make the bitmaps of queued file sources, then redraw
+ * @param timer Unused
+ */
+static void svg_cache_prefetch_timer(lv_timer_t *timer)
+{
+    (void)timer;
+    bool made = false;
+
+    for (uint8_t i = 0; i < SVG_CACHE_PENDING; i++)
+    {
+        char path[SVG_CACHE_PATH_MAX];
+        portENTER_CRITICAL(&svg_cache_lock);
+        strcpy(path, svg_cache_pending[i]);
+        svg_cache_pending[i][0] = '\0';
+        portEXIT_CRITICAL(&svg_cache_lock);
+
+        if (path[0] != '\0' && MAIN_svg_cache_prefetch(path))
+        {
+            // Forget LVGL's vector decode so the next draw finds the bitmap
+            lv_image_header_cache_drop(path);
+            lv_image_cache_drop(path);
+            made = true;
+        }
+    }
+
+    if (made)
+    {
+        lv_obj_invalidate(lv_screen_active());
+    }
+}
+
+#endif // SVG_CACHE_ENABLED
+
+/******************************************************************************
+ * SVG Cache
+ *****************************************************************************/
+
+/**
+ * @brief Register the decoder and the prefetch timer
+ * @return true if SVG files are cached
+ */
+bool MAIN_initialise_svg_cache(void)
+{
+#if SVG_CACHE_ENABLED == 1
+    if (svg_cache_ready)
+    {
+        return true;
+    }
+
+    memset(svg_cache_entries, 0, sizeof(svg_cache_entries));
+    memset(svg_cache_pending, 0, sizeof(svg_cache_pending));
+    memset(&svg_cache_stats, 0, sizeof(svg_cache_stats));
+    memset(&svg_cache_handlers, 0, sizeof(svg_cache_handlers));
+    svg_cache_handlers.buf_free_cb = svg_cache_buf_free;
+
+    // Created last, so it sits at the head of the list ahead of the SVG decoder
+    lv_image_decoder_t *decoder = lv_image_decoder_create();
+    if (decoder == NULL)
+    {
+        return false;
+    }
+    lv_image_decoder_set_info_cb(decoder, svg_cache_decoder_info);
+    lv_image_decoder_set_open_cb(decoder, svg_cache_decoder_open);
+    lv_image_decoder_set_close_cb(decoder, svg_cache_decoder_close);
+    decoder->name = "SVG cache";
+
+    lv_timer_create(svg_cache_prefetch_timer, SVG_CACHE_PREFETCH_MS, NULL);
+
+    svg_cache_ready = true;
+#if EARS_DEBUG == 1
+    Serial.printf("[SVGCACHE] %u bitmaps, %lu KB in PSRAM\n", SVG_CACHE_ENTRIES,
+                  (unsigned long)(SVG_CACHE_BYTES / 1024));
+#endif
+    return true;
+#else
+#if EARS_DEBUG == 1
+    Serial.println("[SVGCACHE] SVG support not built, cache disabled");
+#endif
+    return false;
+#endif
+}
+
+/**
+ * @brief Bitmap of an SVG file at a size, pinned
+ * @param path LVGL path
+ * @param width Width (0 = from height)
+ * @param height Height (0 = from width)
+ * @return const lv_image_dsc_t* Image, or NULL
+ */
+const lv_image_dsc_t *MAIN_svg_cache_get(const char *path, int32_t width, int32_t height)
+{
+#if SVG_CACHE_ENABLED == 1
+    if (!svg_cache_ready || path == NULL || width < 0 || height < 0)
+    {
+        return NULL;
+    }
+
+    svg_cache_entry_t *e = NULL;
+    if (width != 0 && height != 0)
+    {
+        e = svg_cache_find(path, width, height);
+    }
+    else if (width == 0 && height == 0)
+    {
+        e = svg_cache_find(path, 0, 0);
+    }
+    if (e == NULL)
+    {
+        e = svg_cache_make(path, width, height, width == 0 && height == 0);
+    }
+    if (e == NULL)
+    {
+        return NULL;
+    }
+
+    portENTER_CRITICAL(&svg_cache_lock);
+    e->pins++;
+    e->lastUse = ++svg_cache_clock;
+    svg_cache_stats.hits++;
+    portEXIT_CRITICAL(&svg_cache_lock);
+    return &e->image;
+#else
+    (void)path;
+    (void)width;
+    (void)height;
+    return NULL;
+#endif
+}
+
+/**
+ * @brief Unpin a bitmap
+ * @param image Image from MAIN_svg_cache_get(), or NULL
+ */
+void MAIN_svg_cache_release(const lv_image_dsc_t *image)
+{
+#if SVG_CACHE_ENABLED == 1
+    for (uint8_t i = 0; image != NULL && i < SVG_CACHE_ENTRIES; i++)
+    {
+        svg_cache_entry_t *e = &svg_cache_entries[i];
+        if (&e->image == image && e->data != NULL)
+        {
+            portENTER_CRITICAL(&svg_cache_lock);
+            if (e->pins > 0)
+            {
+                e->pins--;
+            }
+            portEXIT_CRITICAL(&svg_cache_lock);
+            return;
+        }
+    }
+#else
+    (void)image;
+#endif
+}
+
+/**
+ * @brief Make the own-size bitmap of a file source
+ * @param path LVGL path
+ * @return true if cached
+ */
+bool MAIN_svg_cache_prefetch(const char *path)
+{
+#if SVG_CACHE_ENABLED == 1
+    if (!svg_cache_ready || path == NULL)
+    {
+        return false;
+    }
+    return svg_cache_find(path, 0, 0) != NULL || svg_cache_make(path, 0, 0, true) != NULL;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+/**
+ * @brief Drop every unpinned bitmap
+ */
+void MAIN_svg_cache_clear(void)
+{
+#if SVG_CACHE_ENABLED == 1
+    for (uint8_t i = 0; i < SVG_CACHE_ENTRIES; i++)
+    {
+        if (svg_cache_entries[i].data != NULL && svg_cache_entries[i].pins == 0)
+        {
+            svg_cache_drop(&svg_cache_entries[i]);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Cache counters
+ * @param stats Receives the counters
+ */
+void MAIN_svg_cache_get_stats(MAIN_svg_cache_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+#if SVG_CACHE_ENABLED == 1
+    portENTER_CRITICAL(&svg_cache_lock);
+    *stats = svg_cache_stats;
+    stats->entries = 0;
+    stats->pinned = 0;
+    for (uint8_t i = 0; i < SVG_CACHE_ENTRIES; i++)
+    {
+        if (svg_cache_entries[i].data != NULL)
+        {
+            stats->entries++;
+            stats->pinned += svg_cache_entries[i].pins > 0 ? 1 : 0;
+        }
+    }
+    stats->bytes = svg_cache_bytes;
+    portEXIT_CRITICAL(&svg_cache_lock);
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_SvgCache_getLibraryName() {
+    return MAIN_SvgCache::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_SvgCache_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_SvgCache::VERSION_MAJOR,
+                       MAIN_SvgCache::VERSION_MINOR,
+                       MAIN_SvgCache::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_SvgCache_getVersionDate() {
+    return MAIN_SvgCache::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_SvgCache_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_SvgCache_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_svgCacheLib.cpp
+ ******************************************************************************/
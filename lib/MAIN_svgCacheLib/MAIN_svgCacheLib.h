@@ -0,0 +1,154 @@
+/**
+ * @file MAIN_svgCacheLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief SVG icons rasterised once per size and drawn as plain bitmaps
+ * @details LVGL draws an SVG by running the vector renderer (ThorVG) on
+ *          every redraw. This library rasterises each SVG once per target
+ *          size into an RGB565A8 bitmap in PSRAM (the memory plan's SVG
+ *          pool), so later draws are image blits:
+ *
+ *          - MAIN_svg_cache_get() returns an lv_image_dsc_t of a file at a
+ *            given size, for lv_image_set_src(); it stays valid until
+ *            MAIN_svg_cache_release()
+ *          - "S:/...svg" file sources set directly on an image are served
+ *            at their own size by a decoder ahead of LVGL's SVG decoder;
+ *            a source with no bitmap yet is drawn as vectors once, its
+ *            bitmap is made by an LVGL timer after the frame, and the
+ *            screen is redrawn from the bitmap
+ *
+ *          Bitmaps are also written to the SD card (SVG_CACHE_DIR), keyed
+ *          by a hash of the SVG file's contents and the size, so a later
+ *          boot loads them instead of rasterising; an edited SVG gets a new
+ *          key. Unpinned bitmaps are evicted least recently used first.
+ *
+ *          Needs LV_USE_SVG and the ThorVG renderer (off in the trimmed
+ *          production build, where every call fails and SVG files are not
+ *          drawn).
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_SVG_CACHE_LIB_H__
+#define __MAIN_SVG_CACHE_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include <lvgl.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_SvgCache
+{
+    constexpr const char* LIB_NAME = "MAIN_SvgCache";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_SvgCache_getLibraryName();
+uint32_t MAIN_SvgCache_getVersionEncoded();
+const char* MAIN_SvgCache_getVersionDate();
+void MAIN_SvgCache_getVersionString(char* buffer);
+
+/******************************************************************************
+ * SVG Cache Configuration
+ *****************************************************************************/
+
+// Bitmaps kept, and their total size in PSRAM (MEM_PLAN_SVG_CACHE)
+#define SVG_CACHE_ENTRIES 24
+#define SVG_CACHE_BYTES (256 * 1024U)
+
+// Largest side rasterised (a full-screen bitmap is 450 KB)
+#define SVG_CACHE_MAX_SIDE 320
+
+// Longest source path, drive letter included
+#define SVG_CACHE_PATH_MAX 64
+
+// 1 = keep bitmaps on the SD card across boots
+#define SVG_CACHE_DISK 1
+#define SVG_CACHE_DIR "/cache/svg"
+
+// File sources waiting for a bitmap, and how often the LVGL timer makes them
+#define SVG_CACHE_PENDING 4
+#define SVG_CACHE_PREFETCH_MS 50
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint16_t entries;           // Bitmaps in PSRAM now
+    uint16_t pinned;            // Of those, held by MAIN_svg_cache_get() or a draw
+    uint32_t bytes;             // Bitmap bytes now
+    uint32_t hits;              // Draws and gets served from a bitmap
+    uint32_t rasterised;        // SVGs run through the vector renderer
+    uint32_t diskLoads;         // Bitmaps read back from the SD card
+    uint32_t diskSaves;         // Bitmaps written to the SD card
+    uint32_t vectorFallbacks;   // Sources left to LVGL's SVG decoder (no bitmap yet)
+    uint32_t evictions;
+    uint32_t failures;          // Unreadable, unparsable or too large
+} MAIN_svg_cache_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Register the decoder and the prefetch timer
+ * @return true if SVG files are cached (LV_USE_SVG)
+ * @note Call after MAIN_initialise_image_cache(), from the LVGL task.
+ */
+bool MAIN_initialise_svg_cache(void);
+
+/**
+ * @brief Bitmap of an SVG file at a size, made now if needed
+ * @param path LVGL path (e.g. "S:/icons/wifi.svg")
+ * @param width Width in pixels (0 = from height and the SVG's aspect)
+ * @param height Height in pixels (0 = from width; both 0 = the SVG's size)
+ * @return const lv_image_dsc_t* Image for lv_image_set_src(), or NULL
+ * @note LVGL task, outside rendering. Pinned until MAIN_svg_cache_release().
+ */
+const lv_image_dsc_t *MAIN_svg_cache_get(const char *path, int32_t width, int32_t height);
+
+/**
+ * @brief Unpin a bitmap from MAIN_svg_cache_get()
+ * @param image Image (NULL is ignored)
+ * @note Set another source on the widgets showing it first.
+ */
+void MAIN_svg_cache_release(const lv_image_dsc_t *image);
+
+/**
+ * @brief Make the own-size bitmap of an SVG file source ahead of its draw
+ * @param path LVGL path
+ * @return true if the bitmap is cached
+ * @note LVGL task, outside rendering.
+ */
+bool MAIN_svg_cache_prefetch(const char *path);
+
+/**
+ * @brief Drop every unpinned bitmap (the SD copies stay)
+ */
+void MAIN_svg_cache_clear(void);
+
+/**
+ * @brief Cache counters
+ * @param stats Receives the counters
+ */
+void MAIN_svg_cache_get_stats(MAIN_svg_cache_stats_t *stats);
+
+#endif // __MAIN_SVG_CACHE_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_svgCacheLib.h
+ ******************************************************************************/
@@ -3,8 +3,8 @@
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief ESP32-S3 system information library implementation
  * @details Provides functions to query chip info, memory, flash, and runtime stats
- * @version 1.0.0
- * @date 20260210
+ * @version 1.4.0
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -18,6 +18,84 @@
 #include <esp_flash.h>
 #include <esp_system.h>
 #include <esp_mac.h>
+#include <esp_timer.h>
+#include <esp_freertos_hooks.h>
+#include <atomic>
+#include "MAIN_jobSchedulerLib.h"
+
+/******************************************************************************
+ * Task Profiler State
+ *****************************************************************************/
+
+// Per-task CPU needs the framework built with trace facility and run-time stats
+#if configUSE_TRACE_FACILITY == 1 && configGENERATE_RUN_TIME_STATS == 1
+#define SYSINFO_RUN_TIME_STATS 1
+#else
+#define SYSINFO_RUN_TIME_STATS 0
+#endif
+
+typedef struct
+{
+    TaskHandle_t handle; // Registered task (NULL = free)
+    uint32_t stackSize;  // Bytes
+} sysinfo_watch_t;
+
+// Written only by each core's own idle hook
+static volatile uint32_t profiler_idle_cycles[2];
+static volatile uint32_t profiler_idle_exits[2];
+static uint32_t profiler_idle_last[2];
+
+static bool profiler_running = false;
+static int64_t profiler_start_us = 0;
+static MAIN_cpu_load_mark_t profiler_sample_mark;
+static sysinfo_watch_t profiler_watch[SYSINFO_WATCH_MAX];
+static MAIN_cpu_stats_t profiler_report;
+
+#if SYSINFO_RUN_TIME_STATS == 1
+typedef struct
+{
+    TaskHandle_t handle;
+    uint32_t runTime; // ulRunTimeCounter at the previous sample
+} sysinfo_run_time_t;
+
+static TaskStatus_t profiler_status[SYSINFO_TASK_MAX];
+static sysinfo_run_time_t profiler_run_time[SYSINFO_TASK_MAX];
+static uint8_t profiler_run_time_count = 0;
+#endif
+
+/******************************************************************************
+ * Latency Probe State
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t total;    // Input to flush complete
+    uint32_t dispatch; // Input to LVGL event dispatch
+} sysinfo_latency_sample_t;
+
+// Written by the LVGL task (inputs) and the flush task (frames)
+static portMUX_TYPE latency_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool latency_enabled = false;
+static bool latency_pending = false;
+static uint32_t latency_input_us = 0;
+static uint32_t latency_dispatch_us = 0;
+static sysinfo_latency_sample_t latency_samples[SYSINFO_LATENCY_SAMPLES];
+static uint16_t latency_head = 0;
+static uint16_t latency_count = 0;
+static uint32_t latency_measured = 0;
+static uint32_t latency_discarded = 0;
+
+/******************************************************************************
+ * Snapshot State
+ *****************************************************************************/
+
+static MAIN_sysinfo_static_t snapshot_static;
+
+// One writer (the telemetry job) fills the buffer readers are not on, then
+// bumps the count; snapshot_dynamic[snapshot_seq & 1] is the latest
+static MAIN_sysinfo_dynamic_t snapshot_dynamic[2];
+static std::atomic<uint32_t> snapshot_seq(0);
+static MAIN_cpu_load_mark_t snapshot_cpu_mark;
 
 /******************************************************************************
  * Core Identification Functions
@@ -337,6 +415,633 @@ String MAIN_sysinfo_get_sdk_version(void)
     return String(ESP.getSdkVersion());
 }
 
+/******************************************************************************
+ * Snapshot Functions
+ *****************************************************************************/
+
+/**
+ * @brief Fill the static snapshot and take the first dynamic sample
+ * @return void
+ */
+void MAIN_initialise_sysinfo(void)
+{
+    MAIN_sysinfo_static_t *info = &snapshot_static;
+
+    strlcpy(info->chipModel, MAIN_sysinfo_get_chip_model().c_str(), sizeof(info->chipModel));
+    strlcpy(info->chipRevision, MAIN_sysinfo_get_chip_revision().c_str(), sizeof(info->chipRevision));
+    strlcpy(info->macAddress, MAIN_sysinfo_get_mac_address().c_str(), sizeof(info->macAddress));
+    strlcpy(info->flashMode, MAIN_sysinfo_get_flash_mode().c_str(), sizeof(info->flashMode));
+    strlcpy(info->sdkVersion, ESP.getSdkVersion(), sizeof(info->sdkVersion));
+    info->chipId = MAIN_sysinfo_get_chip_id();
+    info->cpuFreqMhz = MAIN_sysinfo_get_cpu_freq_mhz();
+    info->cpuCores = MAIN_sysinfo_get_cpu_cores();
+    info->heapSize = MAIN_sysinfo_get_heap_size();
+    info->psramSize = MAIN_sysinfo_get_psram_size();
+    info->hasPsram = info->psramSize > 0;
+    info->flashSize = MAIN_sysinfo_get_flash_size();
+    info->flashSpeedMhz = MAIN_sysinfo_get_flash_speed_mhz();
+
+    MAIN_sysinfo_snapshot_update();
+}
+
+/**
+ * @brief Properties that do not change after boot
+ * @return const MAIN_sysinfo_static_t* The static snapshot
+ */
+const MAIN_sysinfo_static_t *MAIN_sysinfo_get_static(void)
+{
+    return &snapshot_static;
+}
+
+/**
+ * @brief Sample memory and CPU load into the dynamic snapshot
+ * @return void
+ */
+void MAIN_sysinfo_snapshot_update(void)
+{
+    uint32_t seq = snapshot_seq.load(std::memory_order_relaxed);
+    MAIN_sysinfo_dynamic_t *next = &snapshot_dynamic[(seq + 1) & 1];
+
+    next->sampledMs = millis();
+    next->freeHeap = MAIN_sysinfo_get_free_heap();
+    next->minFreeHeap = MAIN_sysinfo_get_min_free_heap();
+    next->freePsram = snapshot_static.hasPsram ? MAIN_sysinfo_get_free_psram() : 0;
+    next->heapUsage = snapshot_static.heapSize
+                          ? (float)(snapshot_static.heapSize - next->freeHeap) * 100.0f / (float)snapshot_static.heapSize
+                          : 0.0f;
+    next->psramUsage = snapshot_static.psramSize
+                           ? (float)(snapshot_static.psramSize - next->freePsram) * 100.0f / (float)snapshot_static.psramSize
+                           : 0.0f;
+    MAIN_sysinfo_cpu_load(&snapshot_cpu_mark, next->cpuPercent, NULL);
+
+    snapshot_seq.store(seq + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Copy the latest dynamic snapshot
+ * @param snapshot Receives the figures
+ */
+void MAIN_sysinfo_get_dynamic(MAIN_sysinfo_dynamic_t *snapshot)
+{
+    // A retry needs the writer to publish mid-copy: once per tick at most
+    uint32_t seq;
+    do
+    {
+        seq = snapshot_seq.load(std::memory_order_acquire);
+        *snapshot = snapshot_dynamic[seq & 1];
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while (snapshot_seq.load(std::memory_order_relaxed) != seq);
+}
+
+/******************************************************************************
+ * Task Profiler Functions
+ *****************************************************************************/
+
+/**
+ * @brief Idle hook body: time between back-to-back calls is idle time
+ * @param core Core the hook runs on
+ * @return bool false, so the idle task calls it again straight away
+ */
+static bool profiler_idle_hook(uint8_t core)
+{
+    uint32_t now = ESP.getCycleCount();
+    uint32_t delta = now - profiler_idle_last[core];
+    profiler_idle_last[core] = now;
+
+    if (delta < SYSINFO_IDLE_GAP_CYCLES)
+    {
+        profiler_idle_cycles[core] += delta;
+    }
+    else
+    {
+        profiler_idle_exits[core]++;
+    }
+    return false;
+}
+
+static bool profiler_idle_hook_core0(void)
+{
+    return profiler_idle_hook(0);
+}
+
+static bool profiler_idle_hook_core1(void)
+{
+    return profiler_idle_hook(1);
+}
+
+/**
+ * @brief Stack size of a registered task
+ * @param handle Task handle
+ * @return uint32_t Bytes, 0 if not registered
+ */
+static uint32_t profiler_stack_size(TaskHandle_t handle)
+{
+    for (uint8_t i = 0; i < SYSINFO_WATCH_MAX; i++)
+    {
+        if (profiler_watch[i].handle == handle)
+        {
+            return profiler_watch[i].stackSize;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Report job for the Core 1 scheduler
+ * @param ctx Unused
+ */
+static void profiler_job(void *ctx)
+{
+    MAIN_sysinfo_print_tasks();
+    if (MAIN_sysinfo_latency_is_enabled())
+    {
+        MAIN_sysinfo_print_latency();
+    }
+}
+
+/**
+ * @brief Start measuring CPU load
+ * @param periodMs Report interval (0 = none)
+ * @return bool True if the idle hooks were registered on both cores
+ */
+bool MAIN_sysinfo_profiler_begin(uint32_t periodMs)
+{
+    if (profiler_running)
+    {
+        return true;
+    }
+
+    if (esp_register_freertos_idle_hook_for_cpu(profiler_idle_hook_core0, 0) != ESP_OK ||
+        esp_register_freertos_idle_hook_for_cpu(profiler_idle_hook_core1, 1) != ESP_OK)
+    {
+        esp_deregister_freertos_idle_hook_for_cpu(profiler_idle_hook_core0, 0);
+        DEBUG_PRINTLN("[PROFILER] ERROR: Idle hooks unavailable");
+        return false;
+    }
+
+    profiler_running = true;
+    profiler_start_us = esp_timer_get_time();
+    profiler_sample_mark.us = 0;
+
+    if (periodMs > 0)
+    {
+        MAIN_job_add("profiler", profiler_job, NULL, periodMs, periodMs, JOB_PRIORITY_LOW, 0);
+    }
+
+    DEBUG_PRINTF("[PROFILER] Started (per-task CPU %s)\n", SYSINFO_RUN_TIME_STATS ? "on" : "not in this build");
+    return true;
+}
+
+/**
+ * @brief Stop measuring CPU load
+ * @return void
+ */
+void MAIN_sysinfo_profiler_end(void)
+{
+    if (!profiler_running)
+    {
+        return;
+    }
+
+    esp_deregister_freertos_idle_hook_for_cpu(profiler_idle_hook_core0, 0);
+    esp_deregister_freertos_idle_hook_for_cpu(profiler_idle_hook_core1, 1);
+    profiler_running = false;
+}
+
+/**
+ * @brief Check if the idle hooks are measuring
+ * @return bool True between begin and end
+ */
+bool MAIN_sysinfo_profiler_is_running(void)
+{
+    return profiler_running;
+}
+
+/**
+ * @brief CPU load per core since a mark, then move the mark to now
+ * @param mark Caller's baseline
+ * @param cpuPercent Receives load per core
+ * @param idleExitsPerSec Receives idle preemptions per core (may be NULL)
+ */
+void MAIN_sysinfo_cpu_load(MAIN_cpu_load_mark_t *mark, float cpuPercent[2], float idleExitsPerSec[2])
+{
+    int64_t now = esp_timer_get_time();
+
+    // A mark from before the profiler (re)started would span idle time it never saw
+    if (mark->us < profiler_start_us)
+    {
+        mark->us = profiler_start_us;
+        for (uint8_t core = 0; core < 2; core++)
+        {
+            mark->idleCycles[core] = 0;
+            mark->idleExits[core] = 0;
+        }
+    }
+
+    uint32_t elapsedUs = (uint32_t)(now - mark->us);
+    if (elapsedUs == 0)
+    {
+        elapsedUs = 1;
+    }
+
+    // Idle cycles over the cycles the window held; the u32 counters cover
+    // about 17 s of idle at 240 MHz between calls
+    float windowCycles = (float)elapsedUs * getCpuFrequencyMhz();
+    for (uint8_t core = 0; core < 2; core++)
+    {
+        uint32_t cycles = profiler_idle_cycles[core];
+        uint32_t exits = profiler_idle_exits[core];
+
+        if (profiler_running)
+        {
+            float idle = 100.0f * (float)(cycles - mark->idleCycles[core]) / windowCycles;
+            cpuPercent[core] = (idle > 100.0f) ? 0.0f : 100.0f - idle;
+        }
+        else
+        {
+            cpuPercent[core] = SYSINFO_CPU_UNKNOWN;
+        }
+
+        if (idleExitsPerSec != NULL)
+        {
+            idleExitsPerSec[core] =
+                profiler_running ? (float)(exits - mark->idleExits[core]) * 1000000.0f / elapsedUs : 0.0f;
+        }
+
+        mark->idleCycles[core] = cycles;
+        mark->idleExits[core] = exits;
+    }
+    mark->us = now;
+}
+
+/**
+ * @brief Register a task whose stack size is known
+ * @param handle Task handle
+ * @param stackSize Stack size in bytes
+ */
+void MAIN_sysinfo_profiler_watch_task(TaskHandle_t handle, uint32_t stackSize)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; i < SYSINFO_WATCH_MAX; i++)
+    {
+        if (profiler_watch[i].handle == NULL || profiler_watch[i].handle == handle)
+        {
+            profiler_watch[i].handle = handle;
+            profiler_watch[i].stackSize = stackSize;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Measure CPU and stack use since the previous sample
+ * @param stats Receives the sample
+ */
+void MAIN_sysinfo_profiler_sample(MAIN_cpu_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    memset(stats, 0, sizeof(MAIN_cpu_stats_t));
+
+    int64_t previousUs = (profiler_sample_mark.us > profiler_start_us) ? profiler_sample_mark.us : profiler_start_us;
+    MAIN_sysinfo_cpu_load(&profiler_sample_mark, stats->cpuPercent, stats->idleExitsPerSec);
+    uint32_t elapsedUs = (uint32_t)(profiler_sample_mark.us - previousUs);
+    if (elapsedUs == 0)
+    {
+        elapsedUs = 1;
+    }
+    stats->windowMs = elapsedUs / 1000;
+
+#if SYSINFO_RUN_TIME_STATS == 1
+    uint32_t totalRunTime = 0;
+    UBaseType_t count = uxTaskGetSystemState(profiler_status, SYSINFO_TASK_MAX, &totalRunTime);
+    if (count > 0)
+    {
+        stats->perTaskCpu = true;
+        sysinfo_run_time_t previous[SYSINFO_TASK_MAX];
+        uint8_t previousCount = profiler_run_time_count;
+        memcpy(previous, profiler_run_time, sizeof(previous));
+
+        for (UBaseType_t i = 0; i < count; i++)
+        {
+            const TaskStatus_t &status = profiler_status[i];
+            MAIN_task_stats_t *task = &stats->tasks[i];
+
+            strncpy(task->name, status.pcTaskName, sizeof(task->name) - 1);
+#if configTASKLIST_INCLUDE_COREID == 1
+            task->core = (status.xCoreID == tskNO_AFFINITY) ? -1 : (int8_t)status.xCoreID;
+#else
+            task->core = -1;
+#endif
+            task->priority = status.uxCurrentPriority;
+            task->stackFree = status.usStackHighWaterMark;
+            task->stackSize = profiler_stack_size(status.xHandle);
+
+            // Tasks new since the last sample have no baseline yet
+            task->cpuPercent = SYSINFO_CPU_UNKNOWN;
+            for (uint8_t p = 0; p < previousCount; p++)
+            {
+                if (previous[p].handle == status.xHandle)
+                {
+                    task->cpuPercent = 100.0f * (float)(status.ulRunTimeCounter - previous[p].runTime) / elapsedUs;
+                    break;
+                }
+            }
+
+            profiler_run_time[i].handle = status.xHandle;
+            profiler_run_time[i].runTime = status.ulRunTimeCounter;
+        }
+
+        profiler_run_time_count = count;
+        stats->taskCount = count;
+        return;
+    }
+#endif
+
+    // Registered tasks only: stacks, but no per-task CPU
+    for (uint8_t i = 0; i < SYSINFO_WATCH_MAX; i++)
+    {
+        TaskHandle_t handle = profiler_watch[i].handle;
+        if (handle == NULL)
+        {
+            continue;
+        }
+
+        MAIN_task_stats_t *task = &stats->tasks[stats->taskCount++];
+        strncpy(task->name, pcTaskGetName(handle), sizeof(task->name) - 1);
+        BaseType_t affinity = xTaskGetAffinity(handle);
+        task->core = (affinity == tskNO_AFFINITY) ? -1 : (int8_t)affinity;
+        task->priority = uxTaskPriorityGet(handle);
+        task->cpuPercent = SYSINFO_CPU_UNKNOWN;
+        task->stackFree = uxTaskGetStackHighWaterMark(handle);
+        task->stackSize = profiler_watch[i].stackSize;
+    }
+}
+
+/**
+ * @brief Sample and print CPU load per core and per task to Serial
+ * @return void
+ */
+void MAIN_sysinfo_print_tasks(void)
+{
+    // Static: the report is too big for the Core 1 task stack
+    MAIN_sysinfo_profiler_sample(&profiler_report);
+    const MAIN_cpu_stats_t &r = profiler_report;
+
+    DEBUG_PRINTLN("========================================");
+    DEBUG_PRINTF("TASKS (%lu ms window):\n", (unsigned long)r.windowMs);
+    DEBUG_PRINTLN("========================================");
+    for (uint8_t core = 0; core < 2; core++)
+    {
+        if (r.cpuPercent[core] == SYSINFO_CPU_UNKNOWN)
+        {
+            DEBUG_PRINTF("Core %d CPU:    n/a (profiler not started)\n", core);
+        }
+        else
+        {
+            DEBUG_PRINTF("Core %d CPU:    %5.1f%%  (%.0f idle exits/s)\n", core, r.cpuPercent[core],
+                         r.idleExitsPerSec[core]);
+        }
+    }
+
+    DEBUG_PRINTLN("Task             Core Prio   CPU   Stack free");
+    for (uint8_t i = 0; i < r.taskCount; i++)
+    {
+        const MAIN_task_stats_t &t = r.tasks[i];
+        char cpu[12];
+        char stack[24];
+
+        if (t.cpuPercent == SYSINFO_CPU_UNKNOWN)
+        {
+            snprintf(cpu, sizeof(cpu), "   -");
+        }
+        else
+        {
+            snprintf(cpu, sizeof(cpu), "%5.1f%%", t.cpuPercent);
+        }
+
+        if (t.stackSize > 0)
+        {
+            snprintf(stack, sizeof(stack), "%lu / %lu B", (unsigned long)t.stackFree, (unsigned long)t.stackSize);
+        }
+        else
+        {
+            snprintf(stack, sizeof(stack), "%lu B", (unsigned long)t.stackFree);
+        }
+
+        DEBUG_PRINTF("%-16s %4s %4d %6s  %s\n", t.name, (t.core < 0) ? "-" : (t.core == 0 ? "0" : "1"), t.priority, cpu,
+                     stack);
+    }
+    DEBUG_PRINTLN();
+}
+
+/******************************************************************************
+ * Latency Probe Functions
+ *****************************************************************************/
+
+/**
+ * @brief Start or stop collecting touch-to-photon samples
+ * @param enable True to collect
+ * @return void
+ */
+void MAIN_sysinfo_latency_enable(bool enable)
+{
+    portENTER_CRITICAL(&latency_lock);
+    latency_enabled = enable;
+    latency_pending = false;
+    portEXIT_CRITICAL(&latency_lock);
+}
+
+/**
+ * @brief Check if the latency probe is collecting
+ * @return bool True if enabled
+ */
+bool MAIN_sysinfo_latency_is_enabled(void)
+{
+    return latency_enabled;
+}
+
+/**
+ * @brief An input was dispatched to LVGL
+ * @param inputUs Touch INT edge or I2C sample time
+ * @param dispatchUs LVGL event dispatch time
+ */
+void MAIN_sysinfo_latency_input(uint32_t inputUs, uint32_t dispatchUs)
+{
+    if (!latency_enabled)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&latency_lock);
+    if (latency_pending && (dispatchUs - latency_dispatch_us) > SYSINFO_LATENCY_TIMEOUT_US)
+    {
+        latency_pending = false;
+        latency_discarded++;
+    }
+
+    // A timestamp later than the dispatch means the sample was not the one
+    // LVGL read; count from the dispatch instead
+    if (!latency_pending)
+    {
+        latency_input_us = ((int32_t)(dispatchUs - inputUs) >= 0) ? inputUs : dispatchUs;
+        latency_dispatch_us = dispatchUs;
+        latency_pending = true;
+    }
+    portEXIT_CRITICAL(&latency_lock);
+}
+
+/**
+ * @brief A frame finished reaching the panel
+ * @param renderStartUs When LVGL began rendering it
+ * @param doneUs When its last area was flushed
+ */
+void MAIN_sysinfo_latency_frame(uint32_t renderStartUs, uint32_t doneUs)
+{
+    if (!latency_enabled || !latency_pending)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&latency_lock);
+    if (latency_pending)
+    {
+        if ((doneUs - latency_dispatch_us) > SYSINFO_LATENCY_TIMEOUT_US)
+        {
+            latency_pending = false;
+            latency_discarded++;
+        }
+        else if ((int32_t)(renderStartUs - latency_dispatch_us) >= 0)
+        {
+            // Rendered after the dispatch, so it holds the redraw
+            sysinfo_latency_sample_t &sample = latency_samples[latency_head];
+            sample.total = doneUs - latency_input_us;
+            sample.dispatch = latency_dispatch_us - latency_input_us;
+            latency_head = (latency_head + 1) % SYSINFO_LATENCY_SAMPLES;
+            if (latency_count < SYSINFO_LATENCY_SAMPLES)
+            {
+                latency_count++;
+            }
+            latency_measured++;
+            latency_pending = false;
+        }
+    }
+    portEXIT_CRITICAL(&latency_lock);
+}
+
+/**
+ * @brief Sort a small array in place
+ * @param values Array
+ * @param count Entries
+ */
+static void latency_sort(uint32_t *values, uint16_t count)
+{
+    for (uint16_t i = 1; i < count; i++)
+    {
+        uint32_t v = values[i];
+        uint16_t j = i;
+        while (j > 0 && values[j - 1] > v)
+        {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = v;
+    }
+}
+
+/**
+ * @brief Nearest-rank percentile of a sorted array
+ * @param sorted Sorted values
+ * @param count Entries (> 0)
+ * @param percent 1-100
+ * @return uint32_t Value
+ */
+static uint32_t latency_percentile(const uint32_t *sorted, uint16_t count, uint8_t percent)
+{
+    uint32_t rank = ((uint32_t)count * percent + 99) / 100;
+    return sorted[(rank > 0) ? rank - 1 : 0];
+}
+
+/**
+ * @brief Percentiles over the samples held
+ * @param stats Receives the figures
+ */
+void MAIN_sysinfo_latency_get_stats(MAIN_latency_stats_t *stats)
+{
+    static uint32_t totals[SYSINFO_LATENCY_SAMPLES];
+    static uint32_t dispatches[SYSINFO_LATENCY_SAMPLES];
+
+    // Copy under the lock, sort outside it
+    portENTER_CRITICAL(&latency_lock);
+    uint16_t count = latency_count;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        totals[i] = latency_samples[i].total;
+        dispatches[i] = latency_samples[i].dispatch;
+    }
+    stats->measured = latency_measured;
+    stats->discarded = latency_discarded;
+    portEXIT_CRITICAL(&latency_lock);
+
+    stats->count = count;
+    if (count == 0)
+    {
+        stats->p50Us = stats->p95Us = stats->p99Us = stats->maxUs = stats->dispatchP50Us = 0;
+        return;
+    }
+
+    latency_sort(totals, count);
+    latency_sort(dispatches, count);
+    stats->p50Us = latency_percentile(totals, count, 50);
+    stats->p95Us = latency_percentile(totals, count, 95);
+    stats->p99Us = latency_percentile(totals, count, 99);
+    stats->maxUs = totals[count - 1];
+    stats->dispatchP50Us = latency_percentile(dispatches, count, 50);
+}
+
+/**
+ * @brief Drop every sample and counter
+ * @return void
+ */
+void MAIN_sysinfo_latency_reset(void)
+{
+    portENTER_CRITICAL(&latency_lock);
+    latency_pending = false;
+    latency_head = 0;
+    latency_count = 0;
+    latency_measured = 0;
+    latency_discarded = 0;
+    portEXIT_CRITICAL(&latency_lock);
+}
+
+/**
+ * @brief Print the touch-to-photon percentiles to Serial
+ * @return void
+ */
+void MAIN_sysinfo_print_latency(void)
+{
+    MAIN_latency_stats_t s;
+    MAIN_sysinfo_latency_get_stats(&s);
+
+    DEBUG_PRINTLN("========================================");
+    DEBUG_PRINTLN("TOUCH-TO-PHOTON LATENCY:");
+    DEBUG_PRINTLN("========================================");
+    DEBUG_PRINTF("Probe:         %s\n", latency_enabled ? "enabled" : "disabled");
+    DEBUG_PRINTF("Measured:      %lu (%lu no redraw)\n", (unsigned long)s.measured, (unsigned long)s.discarded);
+    DEBUG_PRINTF("p50/p95/p99:   %lu / %lu / %lu us\n", (unsigned long)s.p50Us, (unsigned long)s.p95Us,
+                 (unsigned long)s.p99Us);
+    DEBUG_PRINTF("Max:           %lu us (last %u)\n", (unsigned long)s.maxUs, (unsigned)s.count);
+    DEBUG_PRINTF("To dispatch:   %lu us (p50)\n", (unsigned long)s.dispatchP50Us);
+    DEBUG_PRINTLN();
+}
+
 /******************************************************************************
  * Formatted Output Functions
  *****************************************************************************/
@@ -350,13 +1055,14 @@ void MAIN_sysinfo_print_chip(void)
     DEBUG_PRINTLN("========================================");
     DEBUG_PRINTLN("CHIP INFORMATION:");
     DEBUG_PRINTLN("========================================");
-    DEBUG_PRINTF("Model:         %s\n", MAIN_sysinfo_get_chip_model().c_str());
-    DEBUG_PRINTF("Revision:      %s\n", MAIN_sysinfo_get_chip_revision().c_str());
-    DEBUG_PRINTF("Cores:         %d\n", MAIN_sysinfo_get_cpu_cores());
-    DEBUG_PRINTF("CPU Freq:      %d MHz\n", MAIN_sysinfo_get_cpu_freq_mhz());
-    DEBUG_PRINTF("MAC Address:   %s\n", MAIN_sysinfo_get_mac_address().c_str());
-    DEBUG_PRINTF("Chip ID:       %llu\n", MAIN_sysinfo_get_chip_id());
-    DEBUG_PRINTF("SDK Version:   %s\n", MAIN_sysinfo_get_sdk_version().c_str());
+    const MAIN_sysinfo_static_t *info = &snapshot_static;
+    DEBUG_PRINTF("Model:         %s\n", info->chipModel);
+    DEBUG_PRINTF("Revision:      %s\n", info->chipRevision);
+    DEBUG_PRINTF("Cores:         %d\n", info->cpuCores);
+    DEBUG_PRINTF("CPU Freq:      %lu MHz\n", (unsigned long)info->cpuFreqMhz);
+    DEBUG_PRINTF("MAC Address:   %s\n", info->macAddress);
+    DEBUG_PRINTF("Chip ID:       %llu\n", info->chipId);
+    DEBUG_PRINTF("SDK Version:   %s\n", info->sdkVersion);
     DEBUG_PRINTLN();
 }
 
@@ -371,10 +1077,12 @@ void MAIN_sysinfo_print_memory(void)
     DEBUG_PRINTLN("========================================");
 
     // Heap
-    uint32_t heap_total = MAIN_sysinfo_get_heap_size();
-    uint32_t heap_free = MAIN_sysinfo_get_free_heap();
-    uint32_t heap_min = MAIN_sysinfo_get_min_free_heap();
-    float heap_usage = MAIN_sysinfo_get_heap_usage_percent();
+    MAIN_sysinfo_dynamic_t dynamic;
+    MAIN_sysinfo_get_dynamic(&dynamic);
+    uint32_t heap_total = snapshot_static.heapSize;
+    uint32_t heap_free = dynamic.freeHeap;
+    uint32_t heap_min = dynamic.minFreeHeap;
+    float heap_usage = dynamic.heapUsage;
 
     DEBUG_PRINTF("Heap Total:    %s\n", MAIN_sysinfo_format_bytes(heap_total).c_str());
     DEBUG_PRINTF("Heap Free:     %s\n", MAIN_sysinfo_format_bytes(heap_free).c_str());
@@ -382,11 +1090,11 @@ void MAIN_sysinfo_print_memory(void)
     DEBUG_PRINTF("Heap Usage:    %s\n", MAIN_sysinfo_format_percent(heap_usage).c_str());
 
     // PSRAM
-    if (MAIN_sysinfo_has_psram())
+    if (snapshot_static.hasPsram)
     {
-        uint32_t psram_total = MAIN_sysinfo_get_psram_size();
-        uint32_t psram_free = MAIN_sysinfo_get_free_psram();
-        float psram_usage = MAIN_sysinfo_get_psram_usage_percent();
+        uint32_t psram_total = snapshot_static.psramSize;
+        uint32_t psram_free = dynamic.freePsram;
+        float psram_usage = dynamic.psramUsage;
 
         DEBUG_PRINTF("PSRAM Total:   %s\n", MAIN_sysinfo_format_bytes(psram_total).c_str());
         DEBUG_PRINTF("PSRAM Free:    %s\n", MAIN_sysinfo_format_bytes(psram_free).c_str());
@@ -409,9 +1117,9 @@ void MAIN_sysinfo_print_flash(void)
     DEBUG_PRINTLN("========================================");
     DEBUG_PRINTLN("FLASH INFORMATION:");
     DEBUG_PRINTLN("========================================");
-    DEBUG_PRINTF("Flash Size:    %d MB\n", MAIN_sysinfo_get_flash_size_mb());
-    DEBUG_PRINTF("Flash Speed:   %d MHz\n", MAIN_sysinfo_get_flash_speed_mhz());
-    DEBUG_PRINTF("Flash Mode:    %s\n", MAIN_sysinfo_get_flash_mode().c_str());
+    DEBUG_PRINTF("Flash Size:    %lu MB\n", (unsigned long)(snapshot_static.flashSize / (1024 * 1024)));
+    DEBUG_PRINTF("Flash Speed:   %lu MHz\n", (unsigned long)snapshot_static.flashSpeedMhz);
+    DEBUG_PRINTF("Flash Mode:    %s\n", snapshot_static.flashMode);
     DEBUG_PRINTLN();
 }
 
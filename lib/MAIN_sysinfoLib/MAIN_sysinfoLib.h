@@ -2,9 +2,22 @@
  * @file MAIN_sysinfoLib.h
  * @author Julian (51fiftyone51fiftyone@gmail.com)
  * @brief ESP32-S3 system information library for EARS
- * @details Provides functions to query chip info, memory, flash, and runtime stats
- * @version 1.0.0
- * @date 20260210
+ * @details Provides functions to query chip info, memory, flash, and runtime stats.
+ *          The task profiler measures CPU load per core from idle-hook
+ *          timing (the idle hook spins while profiling, so the CPU does not
+ *          sleep), per-task CPU from FreeRTOS run-time stats where the
+ *          framework is built with them, and stack high-water marks.
+ *          The latency probe keeps the last SYSINFO_LATENCY_SAMPLES
+ *          touch-to-photon times: from the touch input (INT edge or I2C
+ *          sample) through the LVGL event dispatch to the end of the flush
+ *          of the first frame rendered after it.
+ *          The snapshot holds what an about or settings screen shows:
+ *          static properties (chip, MAC, flash, SDK) formatted once at
+ *          boot into fixed char arrays, and memory and CPU figures sampled
+ *          on the telemetry tick into a double buffer that any task on
+ *          either core reads without a lock.
+ * @version 1.4.0
+ * @date 20261015
  *
  * @copyright Copyright (c) 2026 JTB. All rights reserved.
  */
@@ -17,6 +30,8 @@
  * Includes
  *****************************************************************************/
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include "EARS_versionDef.h"
 
 /******************************************************************************
@@ -26,9 +41,9 @@ namespace MAIN_SysInfo
 {
     constexpr const char* LIB_NAME = "MAIN_SysInfo";
     constexpr const char* VERSION_MAJOR = "1";
-    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_MINOR = "4";
     constexpr const char* VERSION_PATCH = "0";
-    constexpr const char* VERSION_DATE = "2026-02-10";
+    constexpr const char* VERSION_DATE = "2026-10-15";
 }
 
 
@@ -38,6 +53,109 @@ uint32_t MAIN_SysInfo_getVersionEncoded();
 const char* MAIN_SysInfo_getVersionDate();
 void MAIN_SysInfo_getVersionString(char* buffer);
 
+/******************************************************************************
+ * Task Profiler Configuration
+ *****************************************************************************/
+
+// Tasks reported per sample, and tasks registered with a known stack size
+#define SYSINFO_TASK_MAX 24
+#define SYSINFO_WATCH_MAX 4
+
+// Idle-hook calls further apart than this (CPU cycles) mean the core ran
+// something else in between (a pass of the idle loop takes a few hundred)
+#define SYSINFO_IDLE_GAP_CYCLES 4000
+
+// Periodic report from the Core 1 scheduler (0 = API only)
+#define SYSINFO_PROFILE_PERIOD_MS 10000
+
+// Marks a per-task CPU figure the build cannot measure
+#define SYSINFO_CPU_UNKNOWN (-1.0f)
+
+/******************************************************************************
+ * Latency Probe Configuration
+ *****************************************************************************/
+
+// Touch-to-photon samples kept for the percentiles
+#define SYSINFO_LATENCY_SAMPLES 128
+
+// An input with no frame rendered after it within this time caused no
+// redraw and is discarded
+#define SYSINFO_LATENCY_TIMEOUT_US 250000
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    char name[configMAX_TASK_NAME_LEN]; // Task name
+    int8_t core;                         // Pinned core, -1 = either
+    uint8_t priority;                    // Current priority
+    float cpuPercent;                    // Share of one core, or SYSINFO_CPU_UNKNOWN
+    uint32_t stackFree;                  // Stack high-water mark (bytes never used)
+    uint32_t stackSize;                  // Stack size if registered, else 0
+} MAIN_task_stats_t;
+
+typedef struct
+{
+    int64_t us;              // esp_timer_get_time() at the mark
+    uint32_t idleCycles[2];  // Idle-hook counters at the mark
+    uint32_t idleExits[2];
+} MAIN_cpu_load_mark_t;
+
+typedef struct
+{
+    uint32_t windowMs;          // Time covered by this sample
+    float cpuPercent[2];        // Load per core (100 - idle)
+    float idleExitsPerSec[2];   // Idle task preemptions per core, a lower
+                                // bound on context switches
+    bool perTaskCpu;            // Run-time stats available
+    uint8_t taskCount;          // Valid entries in tasks[]
+    MAIN_task_stats_t tasks[SYSINFO_TASK_MAX];
+} MAIN_cpu_stats_t;
+
+typedef struct
+{
+    uint16_t count;       // Samples the percentiles are taken over
+    uint32_t measured;    // Inputs that reached the panel
+    uint32_t discarded;   // Inputs that caused no redraw
+    uint32_t p50Us;       // Input to flush complete
+    uint32_t p95Us;
+    uint32_t p99Us;
+    uint32_t maxUs;
+    uint32_t dispatchP50Us; // Input to LVGL event dispatch (median)
+} MAIN_latency_stats_t;
+
+// Properties that do not change after boot
+typedef struct
+{
+    char chipModel[16];      // "ESP32-S3"
+    char chipRevision[8];    // "v0.1"
+    char macAddress[18];     // "XX:XX:XX:XX:XX:XX"
+    char flashMode[12];      // "QIO", "DIO", ...
+    char sdkVersion[32];     // ESP-IDF version
+    uint64_t chipId;         // From the MAC address
+    uint32_t cpuFreqMhz;
+    uint8_t cpuCores;
+    bool hasPsram;
+    uint32_t heapSize;       // Bytes
+    uint32_t psramSize;      // Bytes (0 without PSRAM)
+    uint32_t flashSize;      // Bytes
+    uint32_t flashSpeedMhz;
+} MAIN_sysinfo_static_t;
+
+// Figures sampled on the telemetry tick
+typedef struct
+{
+    uint32_t sampledMs;      // millis() when sampled (0 = never)
+    uint32_t freeHeap;       // Bytes
+    uint32_t minFreeHeap;    // Low water mark (bytes)
+    uint32_t freePsram;      // Bytes
+    float heapUsage;         // Percent
+    float psramUsage;        // Percent
+    float cpuPercent[2];     // Load per core, SYSINFO_CPU_UNKNOWN if not profiling
+} MAIN_sysinfo_dynamic_t;
+
 /******************************************************************************
  * Core Identification Functions
  *****************************************************************************/
@@ -186,6 +304,147 @@ String MAIN_sysinfo_get_uptime_string(void);
  */
 String MAIN_sysinfo_get_sdk_version(void);
 
+/******************************************************************************
+ * Task Profiler Functions
+ *****************************************************************************/
+
+/**
+ * @brief Start measuring CPU load
+ * @param periodMs Report interval for the Core 1 scheduler job (0 = none)
+ * @return bool True if the idle hooks were registered on both cores
+ */
+bool MAIN_sysinfo_profiler_begin(uint32_t periodMs);
+
+/**
+ * @brief Stop measuring CPU load and let the idle task sleep again
+ * @return void
+ */
+void MAIN_sysinfo_profiler_end(void);
+
+/**
+ * @brief Check if the idle hooks are measuring
+ * @return bool True between begin and end
+ */
+bool MAIN_sysinfo_profiler_is_running(void);
+
+/**
+ * @brief CPU load per core since a mark, then move the mark to now
+ * @param mark Caller's baseline (zeroed = since the profiler started)
+ * @param cpuPercent Receives load per core, SYSINFO_CPU_UNKNOWN if stopped
+ * @param idleExitsPerSec Receives idle preemptions per core (may be NULL)
+ * @note Any task: each caller keeps its own mark, so samplers do not
+ *       disturb each other's windows.
+ */
+void MAIN_sysinfo_cpu_load(MAIN_cpu_load_mark_t *mark, float cpuPercent[2], float idleExitsPerSec[2]);
+
+/**
+ * @brief Register a task whose stack size is known
+ * @param handle Task handle
+ * @param stackSize Stack size given to xTaskCreate (bytes)
+ * @note Without run-time stats only registered tasks are reported.
+ */
+void MAIN_sysinfo_profiler_watch_task(TaskHandle_t handle, uint32_t stackSize);
+
+/**
+ * @brief Measure CPU and stack use since the previous sample
+ * @param stats Receives the sample
+ * @note Not thread safe: sample from one task (the report job or a shell).
+ */
+void MAIN_sysinfo_profiler_sample(MAIN_cpu_stats_t *stats);
+
+/**
+ * @brief Sample and print CPU load per core and per task to Serial
+ * @return void
+ */
+void MAIN_sysinfo_print_tasks(void);
+
+/******************************************************************************
+ * Latency Probe Functions
+ *****************************************************************************/
+
+/**
+ * @brief Start or stop collecting touch-to-photon samples
+ * @param enable True to collect
+ * @return void
+ */
+void MAIN_sysinfo_latency_enable(bool enable);
+
+/**
+ * @brief Check if the latency probe is collecting
+ * @return bool True if enabled
+ */
+bool MAIN_sysinfo_latency_is_enabled(void);
+
+/**
+ * @brief An input was dispatched to LVGL
+ * @param inputUs Touch INT edge or I2C sample time (esp_timer, low 32 bits)
+ * @param dispatchUs LVGL event dispatch time (same clock)
+ * @note LVGL task. While one input waits for its frame, later ones are
+ *       ignored, so a drag measures its first move.
+ */
+void MAIN_sysinfo_latency_input(uint32_t inputUs, uint32_t dispatchUs);
+
+/**
+ * @brief A frame finished reaching the panel
+ * @param renderStartUs When LVGL began rendering it (same clock)
+ * @param doneUs When its last area was flushed (same clock)
+ * @note Flush task or LVGL task. Completes the waiting input if the frame
+ *       was rendered after it was dispatched.
+ */
+void MAIN_sysinfo_latency_frame(uint32_t renderStartUs, uint32_t doneUs);
+
+/**
+ * @brief Percentiles over the samples held
+ * @param stats Receives the figures (zero until the first sample)
+ * @note Safe against the probe, but sorts in a static buffer: one caller
+ *       at a time (the HUD or a shell).
+ */
+void MAIN_sysinfo_latency_get_stats(MAIN_latency_stats_t *stats);
+
+/**
+ * @brief Drop every sample and counter
+ * @return void
+ */
+void MAIN_sysinfo_latency_reset(void);
+
+/**
+ * @brief Print the touch-to-photon percentiles to Serial
+ * @return void
+ */
+void MAIN_sysinfo_print_latency(void);
+
+/******************************************************************************
+ * Snapshot Functions
+ *****************************************************************************/
+
+/**
+ * @brief Fill the static snapshot and take the first dynamic sample
+ * @return void
+ * @note Call once early in setup(), before anything reads the snapshot.
+ */
+void MAIN_initialise_sysinfo(void);
+
+/**
+ * @brief Properties that do not change after boot
+ * @return const MAIN_sysinfo_static_t* Snapshot filled by MAIN_initialise_sysinfo()
+ * @note Any task, no copy and no lock.
+ */
+const MAIN_sysinfo_static_t *MAIN_sysinfo_get_static(void);
+
+/**
+ * @brief Sample memory and CPU load into the dynamic snapshot
+ * @return void
+ * @note One writer: the telemetry job calls this on its tick.
+ */
+void MAIN_sysinfo_snapshot_update(void);
+
+/**
+ * @brief Copy the latest dynamic snapshot
+ * @param snapshot Receives the figures
+ * @note Any task on either core, lock-free.
+ */
+void MAIN_sysinfo_get_dynamic(MAIN_sysinfo_dynamic_t *snapshot);
+
 /******************************************************************************
  * Formatted Output Functions
  *****************************************************************************/
@@ -198,6 +457,7 @@ void MAIN_sysinfo_print_all(void);
 
 /**
  * @brief Print memory information to Serial
+ * @details Figures from the latest snapshot sample
  * @return void
  */
 void MAIN_sysinfo_print_memory(void);
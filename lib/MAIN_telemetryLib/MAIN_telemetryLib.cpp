@@ -0,0 +1,476 @@
+/**
+ * @file MAIN_telemetryLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Time-series telemetry recorder for long-run trends
+ * @version 1.0.2
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_telemetryLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_sdCardLib.h"
+#include "EARS_backLightManagerLib.h"
+#include "MAIN_jobSchedulerLib.h"
+#include "MAIN_lvglLib.h"
+#include "MAIN_memPlanLib.h"
+#include "MAIN_sysinfoLib.h"
+#include <esp_heap_caps.h>
+#include <esp_rom_crc.h>
+#include <esp_timer.h>
+
+/******************************************************************************
+ * Block Format
+ *****************************************************************************/
+#define TELEMETRY_BLOCK_MAGIC 0x4D4C5445 // "ETLM"
+
+// Worst case: every field a five-byte varint
+#define TELEMETRY_VARINT_MAX 5
+#define TELEMETRY_BLOCK_BYTES (sizeof(TelemetryBlockHeader) + \
+                               TELEMETRY_BLOCK_SAMPLES * TELEMETRY_FIELD_COUNT * TELEMETRY_VARINT_MAX)
+
+// TELEMETRY_FILE: blocks back to back, each standing alone. Field values of
+// each sample follow in field order as zigzag varints of the change from
+// the previous sample; the first sample of a block is relative to zero.
+struct TelemetryBlockHeader
+{
+    uint32_t magic;
+    uint8_t fields;        // TELEMETRY_FIELD_COUNT of the writer
+    uint8_t reserved;
+    uint16_t count;        // Samples
+    uint32_t periodMs;
+    uint32_t length;       // Encoded bytes after the header
+    uint32_t crc;          // CRC-32 of the encoded bytes
+};
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static portMUX_TYPE telemetry_lock = portMUX_INITIALIZER_UNLOCKED;
+static MAIN_telemetry_sample_t *telemetry_ring = NULL;
+static uint32_t telemetry_capacity = 0;
+static uint32_t telemetry_count = 0;    // Samples taken; the next goes to count % capacity
+static MAIN_telemetry_stats_t telemetry_stats;
+
+// Spill (Core 1 only)
+static uint8_t *telemetry_block = NULL; // TELEMETRY_BLOCK_BYTES
+static uint32_t telemetry_spilled_to = 0; // Sample number the card has reached
+
+// Rate baselines (sampler only)
+static MAIN_cpu_load_mark_t telemetry_cpu_mark;
+static uint32_t telemetry_last_frames = 0;
+static int64_t telemetry_last_us = 0;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Append a zigzag varint
+ * @param out Write position
+ * @param delta Signed change
+ * @return uint8_t* Position after it
+ */
+static uint8_t *telemetry_put_varint(uint8_t *out, int32_t delta)
+{
+    uint32_t value = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+    while (value >= 0x80)
+    {
+        *out++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = (uint8_t)value;
+    return out;
+}
+
+/**
+ * @brief Copy a sample out of the ring
+ * @param sampleNo Sample number (still held)
+ * @param sample Receives it
+ */
+static void telemetry_read(uint32_t sampleNo, MAIN_telemetry_sample_t *sample)
+{
+    portENTER_CRITICAL(&telemetry_lock);
+    *sample = telemetry_ring[sampleNo % telemetry_capacity];
+    portEXIT_CRITICAL(&telemetry_lock);
+}
+
+/**
+ * @brief Move TELEMETRY_FILE to "<file>.1" once it is full
+ * @param adding Bytes about to be appended
+ */
+static void telemetry_rotate(uint32_t adding)
+{
+    EARS_sdCard &sd = using_sdcard();
+    if (sd.getFileSize(TELEMETRY_FILE) + adding <= TELEMETRY_FILE_MAX)
+    {
+        return;
+    }
+
+    if (sd.fileExists(TELEMETRY_FILE ".1"))
+    {
+        sd.removeFile(TELEMETRY_FILE ".1");
+    }
+    sd.renameFile(TELEMETRY_FILE, TELEMETRY_FILE ".1");
+}
+
+/**
+ * @brief Encode and append blocks of samples not yet on the card
+ * @param partial Also write a block of fewer than TELEMETRY_BLOCK_SAMPLES
+ * @return true unless a write failed
+ */
+static bool telemetry_spill(bool partial)
+{
+    if (telemetry_block == NULL || !using_sdcard().isAvailable())
+    {
+        return false;
+    }
+
+    portENTER_CRITICAL(&telemetry_lock);
+    uint32_t count = telemetry_count;
+    portEXIT_CRITICAL(&telemetry_lock);
+
+    // Samples the ring has already overwritten are gone
+    if (count - telemetry_spilled_to > telemetry_capacity)
+    {
+        uint32_t lost = count - telemetry_capacity - telemetry_spilled_to;
+        telemetry_spilled_to += lost;
+        portENTER_CRITICAL(&telemetry_lock);
+        telemetry_stats.skipped += lost;
+        portEXIT_CRITICAL(&telemetry_lock);
+    }
+
+    while (count - telemetry_spilled_to >= TELEMETRY_BLOCK_SAMPLES ||
+           (partial && count != telemetry_spilled_to))
+    {
+        uint32_t samples = count - telemetry_spilled_to;
+        if (samples > TELEMETRY_BLOCK_SAMPLES)
+        {
+            samples = TELEMETRY_BLOCK_SAMPLES;
+        }
+
+        uint8_t *data = telemetry_block + sizeof(TelemetryBlockHeader);
+        uint8_t *out = data;
+        uint32_t previous[TELEMETRY_FIELD_COUNT] = {0};
+        for (uint32_t i = 0; i < samples; i++)
+        {
+            MAIN_telemetry_sample_t sample;
+            telemetry_read(telemetry_spilled_to + i, &sample);
+            for (uint8_t f = 0; f < TELEMETRY_FIELD_COUNT; f++)
+            {
+                out = telemetry_put_varint(out, (int32_t)(sample.value[f] - previous[f]));
+                previous[f] = sample.value[f];
+            }
+        }
+
+        TelemetryBlockHeader *header = (TelemetryBlockHeader *)telemetry_block;
+        header->magic = TELEMETRY_BLOCK_MAGIC;
+        header->fields = TELEMETRY_FIELD_COUNT;
+        header->reserved = 0;
+        header->count = (uint16_t)samples;
+        header->periodMs = TELEMETRY_PERIOD_MS;
+        header->length = (uint32_t)(out - data);
+        header->crc = esp_rom_crc32_le(0, data, header->length);
+
+        uint32_t bytes = sizeof(TelemetryBlockHeader) + header->length;
+        telemetry_rotate(bytes);
+        bool ok = using_sdcard().appendData(TELEMETRY_FILE, telemetry_block, bytes);
+
+        portENTER_CRITICAL(&telemetry_lock);
+        if (ok)
+        {
+            telemetry_stats.spilled += samples;
+            telemetry_stats.blocks++;
+            telemetry_stats.rawBytes += samples * sizeof(MAIN_telemetry_sample_t);
+            telemetry_stats.encodedBytes += bytes;
+        }
+        else
+        {
+            telemetry_stats.failures++;
+        }
+        portEXIT_CRITICAL(&telemetry_lock);
+
+        if (!ok)
+        {
+            return false;
+        }
+        telemetry_spilled_to += samples;
+    }
+    return true;
+}
+
+/**
+ * @brief Sampling job for the Core 1 scheduler
+ * @param ctx Unused
+ */
+static void telemetry_job(void *ctx)
+{
+    MAIN_telemetry_sample();
+    telemetry_spill(false);
+}
+
+/******************************************************************************
+ * Telemetry
+ *****************************************************************************/
+
+/**
+ * @brief Allocate the ring, take a first sample and register the job
+ * @return true if recording
+ */
+bool MAIN_initialise_telemetry(void)
+{
+    if (telemetry_ring != NULL)
+    {
+        return true;
+    }
+
+    uint32_t capacity = TELEMETRY_RING_SAMPLES;
+    MAIN_telemetry_sample_t *ring = (MAIN_telemetry_sample_t *)MAIN_mem_calloc(
+        MEM_POOL_TELEMETRY, capacity, sizeof(MAIN_telemetry_sample_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (ring == NULL)
+    {
+        capacity = TELEMETRY_RING_FALLBACK;
+        ring = (MAIN_telemetry_sample_t *)MAIN_mem_calloc(MEM_POOL_TELEMETRY, capacity, sizeof(MAIN_telemetry_sample_t),
+                                                          MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+    telemetry_block = (uint8_t *)MAIN_mem_alloc(MEM_POOL_TELEMETRY, TELEMETRY_BLOCK_BYTES, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (ring == NULL || telemetry_block == NULL)
+    {
+        MAIN_mem_free(ring);
+        MAIN_mem_free(telemetry_block);
+        telemetry_block = NULL;
+        DEBUG_PRINTLN("[TELEMETRY] ERROR: No memory for the sample ring");
+        return false;
+    }
+
+    if (using_sdcard().isAvailable() && !using_sdcard().directoryExists("/logs"))
+    {
+        using_sdcard().createDirectory("/logs");
+    }
+
+    telemetry_capacity = capacity;
+    telemetry_stats.capacity = capacity;
+    telemetry_last_us = esp_timer_get_time();
+    telemetry_ring = ring;
+    MAIN_telemetry_sample();
+
+    DEBUG_PRINTF("[TELEMETRY] %lu samples every %lu ms held in %s\n", (unsigned long)capacity,
+                 (unsigned long)TELEMETRY_PERIOD_MS, capacity == TELEMETRY_RING_SAMPLES ? "PSRAM" : "internal RAM");
+
+    return MAIN_job_add("telemetry", telemetry_job, NULL, TELEMETRY_PERIOD_MS, TELEMETRY_PERIOD_MS,
+                        JOB_PRIORITY_LOW, 0) != JOB_INVALID;
+}
+
+/**
+ * @brief Take a sample now
+ */
+void MAIN_telemetry_sample(void)
+{
+    if (telemetry_ring == NULL)
+    {
+        return;
+    }
+
+    // The about screen reads the same tick from the sysinfo snapshot
+    MAIN_sysinfo_snapshot_update();
+
+    MAIN_telemetry_sample_t sample;
+    const uint32_t internal = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+    sample.value[TELEMETRY_UPTIME] = millis() / 1000;
+    sample.value[TELEMETRY_HEAP_FREE] = heap_caps_get_free_size(internal);
+    sample.value[TELEMETRY_HEAP_LARGEST] = heap_caps_get_largest_free_block(internal);
+    sample.value[TELEMETRY_PSRAM_FREE] = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+
+    if (MAIN_sysinfo_profiler_is_running())
+    {
+        float cpu[2];
+        MAIN_sysinfo_cpu_load(&telemetry_cpu_mark, cpu, NULL);
+        sample.value[TELEMETRY_CPU0] = cpu[0] < 0.0f ? TELEMETRY_UNKNOWN : (uint32_t)(cpu[0] + 0.5f);
+        sample.value[TELEMETRY_CPU1] = cpu[1] < 0.0f ? TELEMETRY_UNKNOWN : (uint32_t)(cpu[1] + 0.5f);
+    }
+    else
+    {
+        // Measure from the profiler's start when it next runs
+        memset(&telemetry_cpu_mark, 0, sizeof(telemetry_cpu_mark));
+        sample.value[TELEMETRY_CPU0] = TELEMETRY_UNKNOWN;
+        sample.value[TELEMETRY_CPU1] = TELEMETRY_UNKNOWN;
+    }
+
+    MAIN_lvgl_stats_t lvgl;
+    MAIN_lvgl_get_stats(&lvgl);
+    int64_t now = esp_timer_get_time();
+    uint32_t elapsedUs = (uint32_t)(now - telemetry_last_us);
+    uint32_t frames = lvgl.frames - telemetry_last_frames;
+    sample.value[TELEMETRY_FPS] = elapsedUs ? (uint32_t)((uint64_t)frames * 10000000ULL / elapsedUs) : 0;
+    telemetry_last_frames = lvgl.frames;
+    telemetry_last_us = now;
+
+    sample.value[TELEMETRY_SD_PENDING] = using_sdcard().getPendingWrites();
+
+    uint8_t battery = using_backlightmanager().getBatteryLevel();
+    sample.value[TELEMETRY_BATTERY] = battery > 100 ? TELEMETRY_UNKNOWN : battery;
+
+    portENTER_CRITICAL(&telemetry_lock);
+    telemetry_ring[telemetry_count % telemetry_capacity] = sample;
+    telemetry_count++;
+    portEXIT_CRITICAL(&telemetry_lock);
+}
+
+/**
+ * @brief Spill the samples not yet on the SD card, a part block included
+ * @return true if nothing was waiting or the write succeeded
+ */
+bool MAIN_telemetry_flush(void)
+{
+    return telemetry_ring != NULL && telemetry_spill(true);
+}
+
+/**
+ * @brief Latest sample
+ * @param sample Receives a copy
+ * @return true if there is one
+ */
+bool MAIN_telemetry_get_latest(MAIN_telemetry_sample_t *sample)
+{
+    if (sample == NULL || telemetry_ring == NULL)
+    {
+        return false;
+    }
+
+    portENTER_CRITICAL(&telemetry_lock);
+    bool found = telemetry_count > 0;
+    if (found)
+    {
+        *sample = telemetry_ring[(telemetry_count - 1) % telemetry_capacity];
+    }
+    portEXIT_CRITICAL(&telemetry_lock);
+    return found;
+}
+
+/**
+ * @brief Read one field of the recent samples, oldest first
+ */
+size_t MAIN_telemetry_get_series(MAIN_telemetry_field_t field, int32_t *out, size_t max, uint16_t step)
+{
+    if (out == NULL || max == 0 || field >= TELEMETRY_FIELD_COUNT || telemetry_ring == NULL)
+    {
+        return 0;
+    }
+    if (step == 0)
+    {
+        step = 1;
+    }
+
+    portENTER_CRITICAL(&telemetry_lock);
+    uint32_t count = telemetry_count;
+    portEXIT_CRITICAL(&telemetry_lock);
+
+    uint32_t held = count < telemetry_capacity ? count : telemetry_capacity;
+    size_t points = (held + step - 1) / step;
+    if (points > max)
+    {
+        points = max;
+    }
+
+    // Newest last, stepping back from it
+    for (size_t i = 0; i < points; i++)
+    {
+        uint32_t sampleNo = count - 1 - (uint32_t)(points - 1 - i) * step;
+        portENTER_CRITICAL(&telemetry_lock);
+        out[i] = (int32_t)telemetry_ring[sampleNo % telemetry_capacity].value[field];
+        portEXIT_CRITICAL(&telemetry_lock);
+    }
+    return points;
+}
+
+#if LV_USE_CHART
+/**
+ * @brief Fill a chart series with the recent values of a field
+ */
+void MAIN_telemetry_chart_series(lv_obj_t *chart, lv_chart_series_t *series, MAIN_telemetry_field_t field,
+                                 uint16_t step)
+{
+    if (chart == NULL || series == NULL)
+    {
+        return;
+    }
+
+    uint32_t points = lv_chart_get_point_count(chart);
+    int32_t *y = lv_chart_get_series_y_array(chart, series);
+    if (y == NULL || points == 0)
+    {
+        return;
+    }
+
+    // Right-align what there is, the newest value on the right edge
+    size_t got = MAIN_telemetry_get_series(field, y, points, step);
+    memmove(&y[points - got], y, got * sizeof(int32_t));
+
+    bool mayBeUnknown = field == TELEMETRY_CPU0 || field == TELEMETRY_CPU1 || field == TELEMETRY_BATTERY;
+    for (uint32_t i = 0; i < points; i++)
+    {
+        if (i < points - got || (mayBeUnknown && y[i] == TELEMETRY_UNKNOWN))
+        {
+            y[i] = LV_CHART_POINT_NONE;
+        }
+    }
+
+    lv_chart_set_x_start_point(chart, series, 0);
+    lv_chart_refresh(chart);
+}
+#endif
+
+/**
+ * @brief Recorder counters
+ * @param stats Receives a copy
+ */
+void MAIN_telemetry_get_stats(MAIN_telemetry_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&telemetry_lock);
+    *stats = telemetry_stats;
+    stats->samples = telemetry_count;
+    stats->held = telemetry_count < telemetry_capacity ? telemetry_count : telemetry_capacity;
+    portEXIT_CRITICAL(&telemetry_lock);
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Telemetry_getLibraryName() {
+    return MAIN_Telemetry::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Telemetry_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Telemetry::VERSION_MAJOR,
+                       MAIN_Telemetry::VERSION_MINOR,
+                       MAIN_Telemetry::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Telemetry_getVersionDate() {
+    return MAIN_Telemetry::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Telemetry_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Telemetry_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_telemetryLib.cpp
+ ******************************************************************************/
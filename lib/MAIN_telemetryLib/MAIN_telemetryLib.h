@@ -0,0 +1,180 @@
+/**
+ * @file MAIN_telemetryLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Time-series telemetry recorder for long-run trends
+ * @details A Core 1 job takes a sample every TELEMETRY_PERIOD_MS: uptime,
+ *          internal heap free and largest block, PSRAM free, CPU load per
+ *          core, frames rendered per second, SD writes pending and battery
+ *          charge. Samples go into a ring of TELEMETRY_RING_SAMPLES
+ *          (24 hours at the default period) allocated once in PSRAM, and
+ *          each is written in place over the oldest, so recording never
+ *          allocates.
+ *
+ *          Every TELEMETRY_BLOCK_SAMPLES samples the job spills a block to
+ *          TELEMETRY_FILE on the SD card. Successive samples differ little,
+ *          so a block stores each field as the zigzag varint of its change
+ *          from the previous sample, typically a third of the raw size.
+ *          The file rotates to "<file>.1" at TELEMETRY_FILE_MAX bytes;
+ *          scripts/decode_telemetry.py turns both into CSV.
+ *
+ *          MAIN_telemetry_get_series() reads one field back out of the ring
+ *          for a chart, and MAIN_telemetry_chart_series() fills an LVGL
+ *          chart series with it directly.
+ *
+ *          CPU load comes from the idle-hook profiler, so it reads
+ *          TELEMETRY_UNKNOWN unless the profiler is running (debug builds,
+ *          or while the HUD is shown); battery reads TELEMETRY_UNKNOWN
+ *          until the power monitor's first EVENT_BATTERY reaches
+ *          EARS_backLightManager::setBatteryLevel().
+ * @version 1.0.2
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_TELEMETRY_LIB_H__
+#define __MAIN_TELEMETRY_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <lvgl.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Telemetry
+{
+    constexpr const char* LIB_NAME = "MAIN_Telemetry";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "2";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_Telemetry_getLibraryName();
+uint32_t MAIN_Telemetry_getVersionEncoded();
+const char* MAIN_Telemetry_getVersionDate();
+void MAIN_Telemetry_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Telemetry Configuration
+ *****************************************************************************/
+#define TELEMETRY_PERIOD_MS 10000         // Sampling job period
+#define TELEMETRY_RING_SAMPLES 8640       // Samples held in PSRAM (24 h)
+#define TELEMETRY_RING_FALLBACK 360       // Held in internal RAM without PSRAM (1 h)
+#define TELEMETRY_BLOCK_SAMPLES 64        // Samples per SD block (about 11 min)
+#define TELEMETRY_FILE "/logs/telemetry.bin"
+#define TELEMETRY_FILE_MAX (1024 * 1024UL) // Rotate to "<file>.1" beyond this
+
+// CPU or battery figure not available
+#define TELEMETRY_UNKNOWN 255
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+// Sample fields; the order is the SD block format, append only
+typedef enum
+{
+    TELEMETRY_UPTIME = 0,       // Seconds since boot
+    TELEMETRY_HEAP_FREE,        // Internal RAM free (bytes)
+    TELEMETRY_HEAP_LARGEST,     // Internal RAM largest free block (bytes)
+    TELEMETRY_PSRAM_FREE,       // PSRAM free (bytes)
+    TELEMETRY_CPU0,             // Core 0 load (percent)
+    TELEMETRY_CPU1,             // Core 1 load (percent)
+    TELEMETRY_FPS,              // Frames rendered per second, in tenths
+    TELEMETRY_SD_PENDING,       // Coalesced SD writes waiting
+    TELEMETRY_BATTERY,          // Battery charge (percent)
+    TELEMETRY_FIELD_COUNT
+} MAIN_telemetry_field_t;
+
+typedef struct
+{
+    uint32_t value[TELEMETRY_FIELD_COUNT];
+} MAIN_telemetry_sample_t;
+
+typedef struct
+{
+    uint32_t samples;           // Taken since boot
+    uint32_t held;              // In the ring now
+    uint32_t capacity;          // Ring size
+    uint32_t spilled;           // Written to the SD card
+    uint32_t skipped;           // Overwritten before they could be spilled
+    uint32_t blocks;            // Blocks written
+    uint32_t rawBytes;          // Size of the spilled samples unencoded
+    uint32_t encodedBytes;      // Size on the card, block headers included
+    uint32_t failures;          // Block writes that failed
+} MAIN_telemetry_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Allocate the ring, take a first sample and register the job
+ * @return true if recording
+ * @note Call after the SD card is mounted and the job scheduler is running.
+ */
+bool MAIN_initialise_telemetry(void);
+
+/**
+ * @brief Take a sample now
+ * @note The job calls it every TELEMETRY_PERIOD_MS; one sampler at a time.
+ */
+void MAIN_telemetry_sample(void);
+
+/**
+ * @brief Spill the samples not yet on the SD card, a part block included
+ * @return true if nothing was waiting or the write succeeded
+ * @note Core 1 (before a planned restart or power off)
+ */
+bool MAIN_telemetry_flush(void);
+
+/**
+ * @brief Latest sample
+ * @param sample Receives a copy
+ * @return true if there is one
+ */
+bool MAIN_telemetry_get_latest(MAIN_telemetry_sample_t *sample);
+
+/**
+ * @brief Read one field of the recent samples, oldest first
+ * @param field Field to read
+ * @param out Values returned
+ * @param max Capacity of out
+ * @param step Take every step-th sample, ending with the newest (1 = all)
+ * @return size_t Values returned (fewer than max early in a run)
+ */
+size_t MAIN_telemetry_get_series(MAIN_telemetry_field_t field, int32_t *out, size_t max, uint16_t step);
+
+#if LV_USE_CHART
+/**
+ * @brief Fill a chart series with the recent values of a field
+ * @details The newest value lands on the right; points with no sample yet
+ *          are LV_CHART_POINT_NONE
+ * @param chart Chart (its point count sets how many values)
+ * @param series Series of that chart
+ * @param field Field to show
+ * @param step Samples per point (1 = one point per TELEMETRY_PERIOD_MS)
+ * @note LVGL task only
+ */
+void MAIN_telemetry_chart_series(lv_obj_t *chart, lv_chart_series_t *series, MAIN_telemetry_field_t field,
+                                 uint16_t step);
+#endif
+
+/**
+ * @brief Recorder counters
+ * @param stats Receives a copy
+ */
+void MAIN_telemetry_get_stats(MAIN_telemetry_stats_t *stats);
+
+#endif // __MAIN_TELEMETRY_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_telemetryLib.h
+ ******************************************************************************/
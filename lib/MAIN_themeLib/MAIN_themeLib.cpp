@@ -0,0 +1,257 @@
+/**
+ * @file MAIN_themeLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Colour themes as constant palette tables
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_themeLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_rgb565ColoursDef.h"
+#include "EARS_rgb888ColoursDef.h"
+
+/******************************************************************************
+ * Palette Tables (flash)
+ *****************************************************************************/
+
+// EARS_RGB888 value as a constant lv_color_t
+#define THEME_LV_COLOUR(hex) LV_COLOR_MAKE(((hex) >> 16) & 0xFF, ((hex) >> 8) & 0xFF, (hex) & 0xFF)
+
+// One property list per style role, every theme filling the same roles
+#define THEME_STYLE_PROPS(prefix, background, text, primary, secondary, pressed) \
+    static const lv_style_const_prop_t prefix##_screen[] = {                     \
+        LV_STYLE_CONST_BG_COLOR(THEME_LV_COLOUR(background)),                    \
+        LV_STYLE_CONST_BG_OPA(LV_OPA_COVER),                                     \
+        LV_STYLE_CONST_TEXT_COLOR(THEME_LV_COLOUR(text)),                        \
+        LV_STYLE_CONST_PROPS_END};                                               \
+    static const lv_style_const_prop_t prefix##_panel[] = {                      \
+        LV_STYLE_CONST_BG_COLOR(THEME_LV_COLOUR(background)),                    \
+        LV_STYLE_CONST_BORDER_COLOR(THEME_LV_COLOUR(secondary)),                 \
+        LV_STYLE_CONST_TEXT_COLOR(THEME_LV_COLOUR(text)),                        \
+        LV_STYLE_CONST_PROPS_END};                                               \
+    static const lv_style_const_prop_t prefix##_button[] = {                     \
+        LV_STYLE_CONST_BG_COLOR(THEME_LV_COLOUR(primary)),                       \
+        LV_STYLE_CONST_BORDER_COLOR(THEME_LV_COLOUR(secondary)),                 \
+        LV_STYLE_CONST_TEXT_COLOR(THEME_LV_COLOUR(text)),                        \
+        LV_STYLE_CONST_PROPS_END};                                               \
+    static const lv_style_const_prop_t prefix##_pressed[] = {                    \
+        LV_STYLE_CONST_BG_COLOR(THEME_LV_COLOUR(pressed)),                       \
+        LV_STYLE_CONST_PROPS_END};                                               \
+    static const lv_style_const_prop_t prefix##_accent[] = {                     \
+        LV_STYLE_CONST_TEXT_COLOR(THEME_LV_COLOUR(primary)),                     \
+        LV_STYLE_CONST_PROPS_END}
+
+THEME_STYLE_PROPS(theme_light, EARS_RGB888_CS_BLACK, EARS_RGB888_CS_TEXT, EARS_RGB888_CS_PRIMARY,
+                  EARS_RGB888_CS_SECONDARY, EARS_RGB888_CS_PRESSED);
+
+THEME_STYLE_PROPS(theme_dark, EARS_RGB888_RS_BLACK, EARS_RGB888_RS_TEXT, EARS_RGB888_RS_PRIMARY,
+                  EARS_RGB888_RS_SECONDARY, EARS_RGB888_RS_PRESSED);
+
+static const MAIN_theme_t theme_table[THEME_COUNT] = {
+    {"light",
+     {EARS_RGB888_CS_BLACK, EARS_RGB888_CS_TEXT, EARS_RGB888_CS_PRIMARY, EARS_RGB888_CS_SECONDARY, EARS_RGB888_CS_PRESSED},
+     {EARS_RGB565_CS_BLACK, EARS_RGB565_CS_TEXT, EARS_RGB565_CS_PRIMARY, EARS_RGB565_CS_SECONDARY, EARS_RGB565_CS_PRESSED},
+     {theme_light_screen, theme_light_panel, theme_light_button, theme_light_pressed, theme_light_accent}},
+    {"dark",
+     {EARS_RGB888_RS_BLACK, EARS_RGB888_RS_TEXT, EARS_RGB888_RS_PRIMARY, EARS_RGB888_RS_SECONDARY, EARS_RGB888_RS_PRESSED},
+     {EARS_RGB565_RS_BLACK, EARS_RGB565_RS_TEXT, EARS_RGB565_RS_PRIMARY, EARS_RGB565_RS_SECONDARY, EARS_RGB565_RS_PRESSED},
+     {theme_dark_screen, theme_dark_panel, theme_dark_button, theme_dark_pressed, theme_dark_accent}},
+};
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static const MAIN_theme_t *theme_active = &theme_table[THEME_LIGHT];
+static lv_style_t theme_styles[THEME_STYLE_COUNT]; // Constant styles, lists repointed on a switch
+static bool theme_ready = false;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Point every shared style at the active theme's property lists
+ */
+static void theme_point_styles(void)
+{
+    for (uint8_t i = 0; i < THEME_STYLE_COUNT; i++)
+    {
+        theme_styles[i].values_and_props = (void *)theme_active->props[i];
+    }
+}
+
+/**
+ * @brief Make the shared styles constant styles (as LV_STYLE_CONST_INIT)
+ */
+static void theme_init_styles(void)
+{
+    for (uint8_t i = 0; i < THEME_STYLE_COUNT; i++)
+    {
+#if LV_USE_ASSERT_STYLE
+        theme_styles[i].sentinel = LV_STYLE_SENTINEL_VALUE;
+#endif
+        theme_styles[i].has_group = 0xFFFFFFFF;
+        theme_styles[i].prop_cnt = 255;
+    }
+    theme_point_styles();
+    theme_ready = true;
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+void MAIN_initialise_theme()
+{
+    if (!theme_ready)
+    {
+        theme_init_styles();
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[THEME] %s theme, %u shared styles\n", theme_active->name, (unsigned)THEME_STYLE_COUNT);
+#endif
+}
+
+bool MAIN_theme_set(MAIN_theme_id_t id)
+{
+    if (id >= THEME_COUNT)
+    {
+        return false;
+    }
+    if (!theme_ready)
+    {
+        theme_init_styles();
+    }
+    if (theme_active == &theme_table[id])
+    {
+        return true;
+    }
+
+    theme_active = &theme_table[id];
+    theme_point_styles();
+
+    // One walk of the object tree for every style at once
+    if (lv_is_initialized())
+    {
+        lv_obj_report_style_change(NULL);
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[THEME] Switched to %s\n", theme_active->name);
+#endif
+    return true;
+}
+
+bool MAIN_theme_set_by_name(const char *name)
+{
+    if (name == NULL)
+    {
+        return false;
+    }
+    if (strcasecmp(name, "default") == 0)
+    {
+        return MAIN_theme_set(THEME_LIGHT);
+    }
+    for (uint8_t i = 0; i < THEME_COUNT; i++)
+    {
+        if (strcasecmp(name, theme_table[i].name) == 0)
+        {
+            return MAIN_theme_set((MAIN_theme_id_t)i);
+        }
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[THEME] Warning: Unknown theme \"%s\", keeping %s\n", name, theme_active->name);
+#endif
+    return false;
+}
+
+MAIN_theme_id_t MAIN_theme_get()
+{
+    return (MAIN_theme_id_t)(theme_active - theme_table);
+}
+
+const MAIN_theme_t *MAIN_theme_get_palette()
+{
+    return theme_active;
+}
+
+lv_color_t MAIN_theme_colour(MAIN_theme_colour_t colour)
+{
+    if (colour >= THEME_COLOUR_COUNT)
+    {
+        return lv_color_black();
+    }
+    return lv_color_hex(theme_active->rgb888[colour]);
+}
+
+uint16_t MAIN_theme_colour565(MAIN_theme_colour_t colour)
+{
+    if (colour >= THEME_COLOUR_COUNT)
+    {
+        return EARS_RGB565_BLACK;
+    }
+    return theme_active->rgb565[colour];
+}
+
+lv_style_t *MAIN_theme_get_style(MAIN_theme_style_t style)
+{
+    if (style >= THEME_STYLE_COUNT)
+    {
+        return NULL;
+    }
+    if (!theme_ready)
+    {
+        theme_init_styles();
+    }
+    return &theme_styles[style];
+}
+
+void MAIN_theme_apply_screen(lv_obj_t *screen)
+{
+    if (screen == NULL)
+    {
+        return;
+    }
+    lv_obj_add_style(screen, MAIN_theme_get_style(THEME_STYLE_SCREEN), LV_PART_MAIN);
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Theme_getLibraryName() {
+    return MAIN_Theme::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Theme_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Theme::VERSION_MAJOR,
+                       MAIN_Theme::VERSION_MINOR,
+                       MAIN_Theme::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Theme_getVersionDate() {
+    return MAIN_Theme::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Theme_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Theme_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_themeLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,165 @@
+/**
+ * @file MAIN_themeLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Colour themes as constant palette tables
+ * @details Each theme is a const table in flash: its palette (background,
+ *          text, primary, secondary, pressed) in RGB888 for LVGL and RGB565
+ *          for direct drawing, taken from EARS_rgb888ColoursDef.h and
+ *          EARS_rgb565ColoursDef.h, and one constant LVGL property list per
+ *          style role built from that palette.
+ *
+ *          Widgets add the shared role styles (MAIN_theme_get_style) once.
+ *          The styles are constant styles whose property list pointer
+ *          follows the active theme, so a switch rewrites THEME_STYLE_COUNT
+ *          pointers and makes one lv_obj_report_style_change(NULL) call:
+ *          no theme re-initialisation, no style rebuilt per widget and no
+ *          LVGL heap, however many widgets there are.
+ *
+ *          The role styles must not be changed with lv_style_set_...; add a
+ *          local style on top instead. LVGL calls are UI task only; other
+ *          tasks switch theme through MAIN_ui_cmd_call.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_THEME_LIB_H__
+#define __MAIN_THEME_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include <lvgl.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Theme
+{
+    constexpr const char* LIB_NAME = "MAIN_Theme";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_Theme_getLibraryName();
+uint32_t MAIN_Theme_getVersionEncoded();
+const char* MAIN_Theme_getVersionDate();
+void MAIN_Theme_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+// Themes, in the order of the EEZ Studio themes (Light, Dark)
+typedef enum
+{
+    THEME_LIGHT = 0, // Camouflage swatch
+    THEME_DARK,      // Red swatch
+    THEME_COUNT
+} MAIN_theme_id_t;
+
+// Palette entries
+typedef enum
+{
+    THEME_COLOUR_BACKGROUND = 0,
+    THEME_COLOUR_TEXT,
+    THEME_COLOUR_PRIMARY,
+    THEME_COLOUR_SECONDARY,
+    THEME_COLOUR_PRESSED,
+    THEME_COLOUR_COUNT
+} MAIN_theme_colour_t;
+
+// Shared styles, each built from the palette
+typedef enum
+{
+    THEME_STYLE_SCREEN = 0, // Background, text
+    THEME_STYLE_PANEL,      // Background, secondary border, text
+    THEME_STYLE_BUTTON,     // Primary fill, secondary border, text
+    THEME_STYLE_PRESSED,    // Pressed fill (add with LV_STATE_PRESSED)
+    THEME_STYLE_ACCENT,     // Primary text, for values and headings
+    THEME_STYLE_COUNT
+} MAIN_theme_style_t;
+
+typedef struct
+{
+    const char *name;                                      // As in ears.config display.theme
+    uint32_t rgb888[THEME_COLOUR_COUNT];                   // lv_color_hex() values
+    uint16_t rgb565[THEME_COLOUR_COUNT];                   // MAIN_drawingLib and Arduino_GFX
+    const lv_style_const_prop_t *props[THEME_STYLE_COUNT]; // Property list of each style
+} MAIN_theme_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Point the shared styles at the first theme (UI task, after LVGL)
+ */
+void MAIN_initialise_theme();
+
+/**
+ * @brief Switch theme (UI task only)
+ * @param id Theme
+ * @return true if switched or already active, false if id is not a theme
+ */
+bool MAIN_theme_set(MAIN_theme_id_t id);
+
+/**
+ * @brief Switch theme by its config name (UI task only)
+ * @param name "light", "dark" or "default" (light), any case
+ * @return true if the name is a theme
+ */
+bool MAIN_theme_set_by_name(const char *name);
+
+/**
+ * @brief The active theme
+ * @return MAIN_theme_id_t Theme
+ */
+MAIN_theme_id_t MAIN_theme_get();
+
+/**
+ * @brief The active theme's table
+ * @return const MAIN_theme_t* Palette and property lists (never NULL)
+ */
+const MAIN_theme_t *MAIN_theme_get_palette();
+
+/**
+ * @brief One colour of the active theme for LVGL
+ * @param colour Palette entry
+ * @return lv_color_t Colour (black for an unknown entry)
+ */
+lv_color_t MAIN_theme_colour(MAIN_theme_colour_t colour);
+
+/**
+ * @brief One colour of the active theme for direct RGB565 drawing
+ * @param colour Palette entry
+ * @return uint16_t Colour (black for an unknown entry)
+ */
+uint16_t MAIN_theme_colour565(MAIN_theme_colour_t colour);
+
+/**
+ * @brief A shared style, to add once with lv_obj_add_style
+ * @param style Role
+ * @return lv_style_t* Style that follows the active theme, NULL if unknown
+ */
+lv_style_t *MAIN_theme_get_style(MAIN_theme_style_t style);
+
+/**
+ * @brief Add the screen style to a screen (UI task only)
+ * @param screen Screen object
+ */
+void MAIN_theme_apply_screen(lv_obj_t *screen);
+
+#endif // __MAIN_THEME_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_themeLib.h
+ ******************************************************************************/
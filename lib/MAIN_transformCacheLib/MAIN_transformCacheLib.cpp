@@ -0,0 +1,766 @@
+/**
+ * @file MAIN_transformCacheLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Rotated and zoomed image variants, made once and drawn as blits
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_transformCacheLib.h"
+#include "EARS_systemDef.h"
+#include "MAIN_jobSchedulerLib.h"
+#include "MAIN_memPlanLib.h"
+#include <lvgl_private.h>
+#include <math.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    const lv_image_dsc_t *src;
+    int16_t angle;              // Quantised, 0..3599
+    uint16_t scale;             // Quantised
+    int16_t pivotX;
+    int16_t pivotY;
+} transform_cache_key_t;
+
+typedef enum
+{
+    TRANSFORM_SLOT_FREE = 0,
+    TRANSFORM_SLOT_MAKING,      // Reserved by the Core 1 job
+    TRANSFORM_SLOT_READY
+} transform_cache_slot_t;
+
+typedef struct
+{
+    transform_cache_key_t key;
+    uint8_t state;              // transform_cache_slot_t
+    int16_t offsetX;            // Variant's top left, relative to the image's
+    int16_t offsetY;
+    uint32_t lastUse;
+    uint8_t *data;              // RGB565 plane, then the A8 plane
+    lv_image_dsc_t image;
+} transform_cache_entry_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static transform_cache_entry_t transform_cache_entries[TRANSFORM_CACHE_ENTRIES];
+static transform_cache_key_t transform_cache_queue[TRANSFORM_CACHE_QUEUE];
+static uint16_t transform_cache_queue_head = 0;
+static uint16_t transform_cache_queue_count = 0;
+static MAIN_transform_cache_stats_t transform_cache_stats;
+static uint32_t transform_cache_bytes = 0;      // Ready and reserved
+static uint32_t transform_cache_need = 0;       // Bytes the job is waiting for
+static uint32_t transform_cache_clock = 0;
+static bool transform_cache_ready = false;
+static portMUX_TYPE transform_cache_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/******************************************************************************
+ * Static Functions (internal to library)
+ *****************************************************************************/
+
+/**
+ * @brief Whether two keys name the same variant
+ */
+static bool transform_cache_key_equal(const transform_cache_key_t *a, const transform_cache_key_t *b)
+{
+    return a->src == b->src && a->angle == b->angle && a->scale == b->scale && a->pivotX == b->pivotX &&
+           a->pivotY == b->pivotY;
+}
+
+/**
+ * @brief Round a transform to the configured steps
+ * @param angle Rotation (0.1 degree, any sign)
+ * @param scale Scale (256 = none)
+ * @param key Receives the angle and scale
+ */
+static void transform_cache_quantise(int32_t angle, int32_t scale, transform_cache_key_t *key)
+{
+    angle %= 3600;
+    if (angle < 0)
+    {
+        angle += 3600;
+    }
+    angle = (angle + TRANSFORM_CACHE_ANGLE_STEP / 2) / TRANSFORM_CACHE_ANGLE_STEP * TRANSFORM_CACHE_ANGLE_STEP;
+    scale = (scale + TRANSFORM_CACHE_SCALE_STEP / 2) / TRANSFORM_CACHE_SCALE_STEP * TRANSFORM_CACHE_SCALE_STEP;
+
+    key->angle = (int16_t)(angle % 3600);
+    key->scale = (uint16_t)LV_CLAMP(TRANSFORM_CACHE_SCALE_STEP, scale, 0xFFFF);
+}
+
+/**
+ * @brief Whether a source can be resampled here
+ * @param src Image source
+ * @return true for uncompressed RGB565, RGB565A8, ARGB8888 and XRGB8888
+ */
+static bool transform_cache_source_ok(const lv_image_dsc_t *src)
+{
+    if (src == NULL || src->data == NULL || src->header.w == 0 || src->header.h == 0 ||
+        (src->header.flags & LV_IMAGE_FLAGS_COMPRESSED))
+    {
+        return false;
+    }
+    switch (src->header.cf)
+    {
+    case LV_COLOR_FORMAT_RGB565:
+    case LV_COLOR_FORMAT_RGB565A8:
+    case LV_COLOR_FORMAT_ARGB8888:
+    case LV_COLOR_FORMAT_XRGB8888:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Key of the transform an image widget would draw now
+ * @param obj lv_image object
+ * @param key Receives the key
+ * @return true if the image can be served from a variant
+ */
+static bool transform_cache_key_of(lv_obj_t *obj, transform_cache_key_t *key)
+{
+    lv_image_t *img = (lv_image_t *)obj;
+    if (img->src_type != LV_IMAGE_SRC_VARIABLE || img->scale_x != img->scale_y || img->bitmap_mask_src != NULL ||
+        img->align >= LV_IMAGE_ALIGN_AUTO_TRANSFORM || !transform_cache_source_ok((const lv_image_dsc_t *)img->src))
+    {
+        return false;
+    }
+
+    // The variant replaces the whole draw, the widget's own background included
+    if (lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) > LV_OPA_MIN ||
+        lv_obj_get_style_border_width(obj, LV_PART_MAIN) != 0 ||
+        lv_obj_get_style_shadow_width(obj, LV_PART_MAIN) != 0)
+    {
+        return false;
+    }
+
+    lv_point_t pivot;
+    lv_image_get_pivot(obj, &pivot);
+    key->src = (const lv_image_dsc_t *)img->src;
+    key->pivotX = (int16_t)pivot.x;
+    key->pivotY = (int16_t)pivot.y;
+    transform_cache_quantise((int32_t)img->rotation, (int32_t)img->scale_x, key);
+    return true;
+}
+
+/**
+ * @brief Find a variant
+ * @param key Key
+ * @return transform_cache_entry_t* Entry in any state but free, or NULL
+ * @note Call with the lock held.
+ */
+static transform_cache_entry_t *transform_cache_find(const transform_cache_key_t *key)
+{
+    for (uint16_t i = 0; i < TRANSFORM_CACHE_ENTRIES; i++)
+    {
+        transform_cache_entry_t *e = &transform_cache_entries[i];
+        if (e->state != TRANSFORM_SLOT_FREE && transform_cache_key_equal(&e->key, key))
+        {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Queue a variant for Core 1 unless it exists or is queued
+ * @param key Key
+ * @return true if newly queued
+ */
+static bool transform_cache_enqueue(const transform_cache_key_t *key)
+{
+    bool queued = false;
+
+    portENTER_CRITICAL(&transform_cache_lock);
+    bool known = transform_cache_find(key) != NULL;
+    for (uint16_t i = 0; i < transform_cache_queue_count && !known; i++)
+    {
+        known = transform_cache_key_equal(
+            &transform_cache_queue[(transform_cache_queue_head + i) % TRANSFORM_CACHE_QUEUE], key);
+    }
+    if (!known)
+    {
+        if (transform_cache_queue_count < TRANSFORM_CACHE_QUEUE)
+        {
+            transform_cache_queue[(transform_cache_queue_head + transform_cache_queue_count) % TRANSFORM_CACHE_QUEUE] =
+                *key;
+            transform_cache_queue_count++;
+            queued = true;
+        }
+        else
+        {
+            transform_cache_stats.dropped++;
+        }
+    }
+    portEXIT_CRITICAL(&transform_cache_lock);
+
+    return queued;
+}
+
+/**
+ * @brief Read one source pixel
+ * @param src Image source (a transform_cache_source_ok() format)
+ * @param x Column
+ * @param y Row
+ * @param rgba Receives red, green, blue and alpha (alpha 0 outside the image)
+ */
+static void transform_cache_read_pixel(const lv_image_dsc_t *src, int32_t x, int32_t y, uint8_t *rgba)
+{
+    int32_t w = src->header.w;
+    int32_t h = src->header.h;
+    if (x < 0 || y < 0 || x >= w || y >= h)
+    {
+        rgba[3] = 0;
+        return;
+    }
+
+    uint32_t stride = src->header.stride;
+    const uint8_t *data = src->data;
+    if (src->header.cf == LV_COLOR_FORMAT_ARGB8888 || src->header.cf == LV_COLOR_FORMAT_XRGB8888)
+    {
+        const uint8_t *p = data + (uint32_t)y * (stride ? stride : (uint32_t)w * 4) + (uint32_t)x * 4;
+        rgba[0] = p[2];
+        rgba[1] = p[1];
+        rgba[2] = p[0];
+        rgba[3] = src->header.cf == LV_COLOR_FORMAT_ARGB8888 ? p[3] : 0xFF;
+        return;
+    }
+
+    stride = stride ? stride : (uint32_t)w * 2;
+    uint16_t c = *(const uint16_t *)(data + (uint32_t)y * stride + (uint32_t)x * 2);
+    rgba[0] = (uint8_t)(((c >> 11) & 0x1F) * 255 / 31);
+    rgba[1] = (uint8_t)(((c >> 5) & 0x3F) * 255 / 63);
+    rgba[2] = (uint8_t)((c & 0x1F) * 255 / 31);
+    // RGB565A8: the A8 plane follows, with half the RGB565 stride
+    rgba[3] = src->header.cf == LV_COLOR_FORMAT_RGB565A8 ? data[stride * h + (uint32_t)y * (stride / 2) + x] : 0xFF;
+}
+
+/**
+ * @brief Resample a source into a variant (bilinear)
+ * @param e Entry with its key, offset, size and pixels set
+ * @note Core 1; touches only the source and the entry's pixels.
+ */
+static void transform_cache_render(transform_cache_entry_t *e)
+{
+    const lv_image_dsc_t *src = e->key.src;
+    int32_t w = e->image.header.w;
+    int32_t h = e->image.header.h;
+
+    // Inverse of lv_point_transform(): destination back to source, in 16.16
+    float radians = e->key.angle * (float)M_PI / 1800.0f;
+    float inv = 256.0f / e->key.scale;
+    int32_t cosA = (int32_t)lrintf(cosf(radians) * inv * 65536.0f);
+    int32_t sinA = (int32_t)lrintf(sinf(radians) * inv * 65536.0f);
+
+    uint16_t *rgb = (uint16_t *)e->data;
+    uint8_t *alpha = e->data + (uint32_t)w * h * 2;
+
+    for (int32_t y = 0; y < h; y++)
+    {
+        int32_t dx = e->offsetX - e->key.pivotX;
+        int32_t dy = e->offsetY + y - e->key.pivotY;
+        int32_t sx = cosA * dx + sinA * dy + (e->key.pivotX << 16);
+        int32_t sy = -sinA * dx + cosA * dy + (e->key.pivotY << 16);
+
+        for (int32_t x = 0; x < w; x++, sx += cosA, sy -= sinA)
+        {
+            int32_t x0 = sx >> 16;
+            int32_t y0 = sy >> 16;
+            uint32_t fx = (uint32_t)(sx >> 9) & 0x7F;
+            uint32_t fy = (uint32_t)(sy >> 9) & 0x7F;
+
+            uint8_t p[4][4];
+            transform_cache_read_pixel(src, x0, y0, p[0]);
+            transform_cache_read_pixel(src, x0 + 1, y0, p[1]);
+            transform_cache_read_pixel(src, x0, y0 + 1, p[2]);
+            transform_cache_read_pixel(src, x0 + 1, y0 + 1, p[3]);
+
+            // Colours weighted by alpha, so transparent texels do not darken edges
+            uint32_t weight[4] = {(128 - fx) * (128 - fy), fx * (128 - fy), (128 - fx) * fy, fx * fy};
+            uint32_t sumA = 0;
+            uint32_t sumR = 0;
+            uint32_t sumG = 0;
+            uint32_t sumB = 0;
+            for (uint8_t i = 0; i < 4; i++)
+            {
+                uint32_t wa = weight[i] * p[i][3];
+                sumA += wa;
+                sumR += wa * p[i][0];
+                sumG += wa * p[i][1];
+                sumB += wa * p[i][2];
+            }
+
+            if (sumA == 0)
+            {
+                *rgb++ = 0;
+                *alpha++ = 0;
+                continue;
+            }
+            *rgb++ = lv_color_to_u16(lv_color_make(sumR / sumA, sumG / sumA, sumB / sumA));
+            *alpha++ = (uint8_t)(sumA >> 14);
+        }
+    }
+}
+
+/**
+ * @brief Make one queued variant
+ * @return true if the queue should be worked on further this run
+ * @note Core 1 job.
+ */
+static bool transform_cache_make_next(void)
+{
+    transform_cache_key_t key;
+    portENTER_CRITICAL(&transform_cache_lock);
+    bool any = transform_cache_queue_count > 0 && transform_cache_need == 0;
+    if (any)
+    {
+        key = transform_cache_queue[transform_cache_queue_head];
+    }
+    portEXIT_CRITICAL(&transform_cache_lock);
+    if (!any)
+    {
+        return false;
+    }
+
+    lv_area_t area;
+    lv_point_t pivot = {key.pivotX, key.pivotY};
+    lv_image_buf_get_transformed_area(&area, key.src->header.w, key.src->header.h, key.angle, key.scale, key.scale,
+                                      &pivot);
+    int32_t w = lv_area_get_width(&area);
+    int32_t h = lv_area_get_height(&area);
+    uint32_t bytes = (uint32_t)w * h * 3;
+    bool fits = w > 0 && h > 0 && w <= TRANSFORM_CACHE_MAX_SIDE && h <= TRANSFORM_CACHE_MAX_SIDE;
+
+    // Reserve a slot and the bytes, or ask the LVGL timer for room and wait
+    transform_cache_entry_t *e = NULL;
+    portENTER_CRITICAL(&transform_cache_lock);
+    bool done = !fits || transform_cache_find(&key) != NULL;
+    if (!done)
+    {
+        for (uint16_t i = 0; i < TRANSFORM_CACHE_ENTRIES && e == NULL; i++)
+        {
+            if (transform_cache_entries[i].state == TRANSFORM_SLOT_FREE)
+            {
+                e = &transform_cache_entries[i];
+            }
+        }
+        if (e == NULL || transform_cache_bytes + bytes > TRANSFORM_CACHE_BYTES)
+        {
+            e = NULL;
+            transform_cache_need = bytes;
+        }
+        else
+        {
+            e->key = key;
+            e->state = TRANSFORM_SLOT_MAKING;
+            transform_cache_bytes += bytes;
+        }
+    }
+    if (done || e != NULL)
+    {
+        transform_cache_queue_head = (transform_cache_queue_head + 1) % TRANSFORM_CACHE_QUEUE;
+        transform_cache_queue_count--;
+    }
+    portEXIT_CRITICAL(&transform_cache_lock);
+
+    if (done)
+    {
+        return true;
+    }
+    if (e == NULL)
+    {
+        return false;
+    }
+
+    uint8_t *data = (uint8_t *)MAIN_mem_alloc(MEM_POOL_TRANSFORMS, bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (data == NULL)
+    {
+        portENTER_CRITICAL(&transform_cache_lock);
+        e->state = TRANSFORM_SLOT_FREE;
+        transform_cache_bytes -= bytes;
+        portEXIT_CRITICAL(&transform_cache_lock);
+        return false;
+    }
+
+    e->data = data;
+    e->offsetX = (int16_t)area.x1;
+    e->offsetY = (int16_t)area.y1;
+    memset(&e->image, 0, sizeof(e->image));
+    e->image.header.magic = LV_IMAGE_HEADER_MAGIC;
+    e->image.header.cf = LV_COLOR_FORMAT_RGB565A8;
+    e->image.header.w = w;
+    e->image.header.h = h;
+    e->image.header.stride = w * 2;
+    e->image.data_size = bytes;
+    e->image.data = data;
+    transform_cache_render(e);
+
+    portENTER_CRITICAL(&transform_cache_lock);
+    e->lastUse = transform_cache_clock;
+    e->state = TRANSFORM_SLOT_READY;
+    transform_cache_stats.generated++;
+    portEXIT_CRITICAL(&transform_cache_lock);
+    return true;
+}
+
+/**
+ * @brief Core 1 job: make up to TRANSFORM_CACHE_JOB_BATCH queued variants
+ * @param ctx Unused
+ */
+static void transform_cache_job(void *ctx)
+{
+    (void)ctx;
+    for (uint8_t i = 0; i < TRANSFORM_CACHE_JOB_BATCH; i++)
+    {
+        if (!transform_cache_make_next())
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Free a ready variant
+ * @param e Entry
+ * @note LVGL task, outside rendering.
+ */
+static void transform_cache_drop(transform_cache_entry_t *e)
+{
+    lv_image_cache_drop(&e->image);
+
+    portENTER_CRITICAL(&transform_cache_lock);
+    uint8_t *data = e->data;
+    transform_cache_bytes -= e->image.data_size;
+    e->data = NULL;
+    e->state = TRANSFORM_SLOT_FREE;
+    portEXIT_CRITICAL(&transform_cache_lock);
+
+    MAIN_mem_free(data);
+}
+
+/**
+ * @brief LVGL timer: evict least recently drawn variants when the job waits
+ * @param timer Unused
+ * @note Runs between frames, so no draw task holds a variant.
+ */
+static void transform_cache_trim_timer(lv_timer_t *timer)
+{
+    (void)timer;
+    if (transform_cache_need == 0)
+    {
+        return;
+    }
+
+    while (true)
+    {
+        transform_cache_entry_t *oldest = NULL;
+        bool freeSlot = false;
+
+        portENTER_CRITICAL(&transform_cache_lock);
+        for (uint16_t i = 0; i < TRANSFORM_CACHE_ENTRIES; i++)
+        {
+            transform_cache_entry_t *e = &transform_cache_entries[i];
+            freeSlot |= e->state == TRANSFORM_SLOT_FREE;
+            if (e->state == TRANSFORM_SLOT_READY && (oldest == NULL || e->lastUse < oldest->lastUse))
+            {
+                oldest = e;
+            }
+        }
+        bool room = freeSlot && transform_cache_bytes + transform_cache_need <= TRANSFORM_CACHE_BYTES;
+        if (room || oldest == NULL)
+        {
+            // Room made, or nothing left to evict: drop the request so the queue moves on
+            if (!room && transform_cache_queue_count > 0)
+            {
+                transform_cache_queue_head = (transform_cache_queue_head + 1) % TRANSFORM_CACHE_QUEUE;
+                transform_cache_queue_count--;
+                transform_cache_stats.dropped++;
+            }
+            transform_cache_need = 0;
+        }
+        portEXIT_CRITICAL(&transform_cache_lock);
+
+        if (room || oldest == NULL)
+        {
+            return;
+        }
+        transform_cache_drop(oldest);
+        transform_cache_stats.evictions++;
+    }
+}
+
+/**
+ * @brief Image event: draw from a variant, or queue one
+ * @param e LV_EVENT_DRAW_MAIN (preprocessed, ahead of the image's own draw)
+ *        or LV_EVENT_REFR_EXT_DRAW_SIZE
+ */
+static void transform_cache_event_cb(lv_event_t *e)
+{
+    lv_obj_t *obj = lv_event_get_current_target_obj(e);
+    lv_image_t *img = (lv_image_t *)obj;
+
+    if (lv_event_get_code(e) == LV_EVENT_REFR_EXT_DRAW_SIZE)
+    {
+        // A quantised variant may reach a little past the exact transform
+        int32_t side = LV_MAX(img->w, img->h);
+        int32_t *size = (int32_t *)lv_event_get_param(e);
+        *size += side * TRANSFORM_CACHE_ANGLE_STEP / 1000 + side * TRANSFORM_CACHE_SCALE_STEP / 512 + 1;
+        return;
+    }
+
+    if (img->rotation == 0 && img->scale_x == LV_SCALE_NONE && img->scale_y == LV_SCALE_NONE)
+    {
+        return;
+    }
+    if (img->w == 0 || img->h == 0 || img->scale_x == 0 || img->scale_y == 0)
+    {
+        return;
+    }
+
+    transform_cache_key_t key;
+    if (!transform_cache_key_of(obj, &key))
+    {
+        transform_cache_stats.unsupported++;
+        return;
+    }
+
+    const lv_image_dsc_t *variant = key.src;
+    int32_t offsetX = 0;
+    int32_t offsetY = 0;
+    if (key.angle != 0 || key.scale != LV_SCALE_NONE)
+    {
+        portENTER_CRITICAL(&transform_cache_lock);
+        transform_cache_entry_t *entry = transform_cache_find(&key);
+        if (entry != NULL && entry->state == TRANSFORM_SLOT_READY)
+        {
+            entry->lastUse = ++transform_cache_clock;
+            variant = &entry->image;
+            offsetX = entry->offsetX;
+            offsetY = entry->offsetY;
+        }
+        else
+        {
+            variant = NULL;
+        }
+        portEXIT_CRITICAL(&transform_cache_lock);
+    }
+
+    if (variant == NULL)
+    {
+        transform_cache_stats.misses++;
+        transform_cache_enqueue(&key);
+        return;
+    }
+    transform_cache_stats.hits++;
+
+    // Where lv_image would place the untransformed image
+    lv_area_t imageArea;
+    lv_area_set(&imageArea, obj->coords.x1, obj->coords.y1, obj->coords.x1 + img->w - 1, obj->coords.y1 + img->h - 1);
+    lv_area_align(&obj->coords, &imageArea, (lv_align_t)img->align, img->offset.x, img->offset.y);
+
+    lv_area_t coords;
+    coords.x1 = imageArea.x1 + offsetX;
+    coords.y1 = imageArea.y1 + offsetY;
+    coords.x2 = coords.x1 + variant->header.w - 1;
+    coords.y2 = coords.y1 + variant->header.h - 1;
+
+    lv_layer_t *layer = lv_event_get_layer(e);
+    lv_draw_image_dsc_t dsc;
+    lv_draw_image_dsc_init(&dsc);
+    dsc.base.layer = layer;
+    lv_obj_init_draw_image_dsc(obj, LV_PART_MAIN, &dsc);
+    dsc.src = variant;
+    dsc.blend_mode = (lv_blend_mode_t)img->blend_mode;
+    dsc.image_area = coords;
+    lv_draw_image(layer, &dsc, &coords);
+
+    lv_event_stop_processing(e);
+}
+
+/******************************************************************************
+ * Transform Cache
+ *****************************************************************************/
+
+/**
+ * @brief Register the Core 1 job and the eviction timer
+ * @return true if ready
+ */
+bool MAIN_initialise_transform_cache(void)
+{
+    if (transform_cache_ready)
+    {
+        return true;
+    }
+
+    memset(transform_cache_entries, 0, sizeof(transform_cache_entries));
+    memset(&transform_cache_stats, 0, sizeof(transform_cache_stats));
+
+    if (MAIN_job_add("xfcache", transform_cache_job, NULL, TRANSFORM_CACHE_JOB_MS, TRANSFORM_CACHE_JOB_MS,
+                     JOB_PRIORITY_LOW, 0) == JOB_INVALID)
+    {
+        Serial.println("[XFCACHE] ERROR: No job slot, transform cache disabled");
+        return false;
+    }
+    lv_timer_create(transform_cache_trim_timer, TRANSFORM_CACHE_TRIM_MS, NULL);
+
+    transform_cache_ready = true;
+#if EARS_DEBUG == 1
+    Serial.printf("[XFCACHE] %u variants, %lu KB in PSRAM, steps %d.%d deg and %d/256\n", TRANSFORM_CACHE_ENTRIES,
+                  (unsigned long)(TRANSFORM_CACHE_BYTES / 1024), TRANSFORM_CACHE_ANGLE_STEP / 10,
+                  TRANSFORM_CACHE_ANGLE_STEP % 10, TRANSFORM_CACHE_SCALE_STEP);
+#endif
+    return true;
+}
+
+/**
+ * @brief Draw an image from variants from now on
+ * @param image lv_image object
+ */
+void MAIN_transform_cache_track(lv_obj_t *image)
+{
+    if (!transform_cache_ready || image == NULL || !lv_obj_check_type(image, &lv_image_class))
+    {
+        return;
+    }
+
+    uint32_t count = lv_obj_get_event_count(image);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (lv_event_dsc_get_cb(lv_obj_get_event_dsc(image, i)) == transform_cache_event_cb)
+        {
+            return;
+        }
+    }
+
+    lv_obj_add_event_cb(image, transform_cache_event_cb, (lv_event_code_t)(LV_EVENT_DRAW_MAIN | LV_EVENT_PREPROCESS),
+                        NULL);
+    lv_obj_add_event_cb(image, transform_cache_event_cb, LV_EVENT_REFR_EXT_DRAW_SIZE, NULL);
+    lv_obj_refresh_ext_draw_size(image);
+}
+
+/**
+ * @brief Queue the variants between two keyframes
+ * @param image lv_image object
+ * @param angleFrom Start rotation
+ * @param angleTo End rotation
+ * @param scaleFrom Start scale
+ * @param scaleTo End scale
+ * @return uint16_t Variants queued
+ */
+uint16_t MAIN_transform_cache_prepare(lv_obj_t *image, int32_t angleFrom, int32_t angleTo, int32_t scaleFrom,
+                                      int32_t scaleTo)
+{
+    MAIN_transform_cache_track(image);
+    if (!transform_cache_ready || image == NULL || !lv_obj_check_type(image, &lv_image_class))
+    {
+        return 0;
+    }
+
+    transform_cache_key_t key;
+    if (!transform_cache_key_of(image, &key))
+    {
+        return 0;
+    }
+
+    // Steps along whichever of the two ranges needs more of them
+    int32_t angleSteps = LV_ABS(angleTo - angleFrom) / TRANSFORM_CACHE_ANGLE_STEP;
+    int32_t scaleSteps = LV_ABS(scaleTo - scaleFrom) / TRANSFORM_CACHE_SCALE_STEP;
+    int32_t steps = LV_MIN(LV_MAX(angleSteps, scaleSteps), TRANSFORM_CACHE_PREPARE_MAX - 1);
+
+    uint16_t queued = 0;
+    for (int32_t i = 0; i <= steps; i++)
+    {
+        int32_t angle = steps ? angleFrom + (angleTo - angleFrom) * i / steps : angleFrom;
+        int32_t scale = steps ? scaleFrom + (scaleTo - scaleFrom) * i / steps : scaleFrom;
+        transform_cache_quantise(angle, scale, &key);
+        if ((key.angle != 0 || key.scale != LV_SCALE_NONE) && transform_cache_enqueue(&key))
+        {
+            queued++;
+        }
+    }
+    return queued;
+}
+
+/**
+ * @brief Drop every variant and queued request
+ */
+void MAIN_transform_cache_clear(void)
+{
+    portENTER_CRITICAL(&transform_cache_lock);
+    transform_cache_queue_count = 0;
+    transform_cache_need = 0;
+    portEXIT_CRITICAL(&transform_cache_lock);
+
+    for (uint16_t i = 0; i < TRANSFORM_CACHE_ENTRIES; i++)
+    {
+        if (transform_cache_entries[i].state == TRANSFORM_SLOT_READY)
+        {
+            transform_cache_drop(&transform_cache_entries[i]);
+        }
+    }
+}
+
+/**
+ * @brief Cache counters
+ * @param stats Receives the counters
+ */
+void MAIN_transform_cache_get_stats(MAIN_transform_cache_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&transform_cache_lock);
+    *stats = transform_cache_stats;
+    stats->entries = 0;
+    for (uint16_t i = 0; i < TRANSFORM_CACHE_ENTRIES; i++)
+    {
+        stats->entries += transform_cache_entries[i].state == TRANSFORM_SLOT_READY ? 1 : 0;
+    }
+    stats->queued = transform_cache_queue_count;
+    stats->bytes = transform_cache_bytes;
+    portEXIT_CRITICAL(&transform_cache_lock);
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_TransformCache_getLibraryName() {
+    return MAIN_TransformCache::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_TransformCache_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_TransformCache::VERSION_MAJOR,
+                       MAIN_TransformCache::VERSION_MINOR,
+                       MAIN_TransformCache::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_TransformCache_getVersionDate() {
+    return MAIN_TransformCache::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_TransformCache_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_TransformCache_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_transformCacheLib.cpp
+ ******************************************************************************/
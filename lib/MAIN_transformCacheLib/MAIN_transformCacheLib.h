@@ -0,0 +1,156 @@
+/**
+ * @file MAIN_transformCacheLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Rotated and zoomed image variants, made once and drawn as blits
+ * @details An lv_image with a rotation or scale is resampled pixel by pixel
+ *          on every redraw. For the images this library tracks, each
+ *          transform is quantised (TRANSFORM_CACHE_ANGLE_STEP,
+ *          TRANSFORM_CACHE_SCALE_STEP) and the image is drawn from a
+ *          ready-made RGB565A8 variant of its source at that angle and
+ *          scale, with no transform left for LVGL to do.
+ *
+ *          Variants are made on Core 1 by a scheduler job:
+ *
+ *          - MAIN_transform_cache_prepare() queues every step between two
+ *            keyframes, ahead of an animation (the EEZ animImageAngle and
+ *            animImageZoom actions call it with their start and end)
+ *          - a tracked image drawn at a transform with no variant yet is
+ *            drawn by LVGL as before, and its variant is queued for later
+ *            frames (the EEZ imageSetAngle and imageSetZoom actions track
+ *            their image)
+ *
+ *          Variants live in the memory plan's transforms pool in PSRAM and
+ *          are evicted least recently drawn first, by an LVGL timer between
+ *          frames, so a variant is never freed while it is being drawn.
+ *
+ *          Only uncompressed lv_image_dsc_t sources in RGB565, RGB565A8,
+ *          ARGB8888 or XRGB8888, with equal X and Y scale, no inner
+ *          alignment that transforms, no bitmap mask and no background on
+ *          the image widget are served; anything else is drawn by LVGL.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_TRANSFORM_CACHE_LIB_H__
+#define __MAIN_TRANSFORM_CACHE_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+#include <lvgl.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_TransformCache
+{
+    constexpr const char* LIB_NAME = "MAIN_TransformCache";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_TransformCache_getLibraryName();
+uint32_t MAIN_TransformCache_getVersionEncoded();
+const char* MAIN_TransformCache_getVersionDate();
+void MAIN_TransformCache_getVersionString(char* buffer);
+
+/******************************************************************************
+ * Transform Cache Configuration
+ *****************************************************************************/
+
+// Quantisation: angle in 0.1 degree units (20 = 2 degrees), scale in 1/256
+#define TRANSFORM_CACHE_ANGLE_STEP 20
+#define TRANSFORM_CACHE_SCALE_STEP 16
+
+// Variants kept, and their total size in PSRAM (MEM_PLAN_TRANSFORMS)
+#define TRANSFORM_CACHE_ENTRIES 96
+#define TRANSFORM_CACHE_BYTES (768 * 1024U)
+
+// Largest side of a variant
+#define TRANSFORM_CACHE_MAX_SIDE 320
+
+// Variants waiting for Core 1, and most queued by one prepare
+#define TRANSFORM_CACHE_QUEUE 64
+#define TRANSFORM_CACHE_PREPARE_MAX 60
+
+// Core 1 job: period and variants made per run; LVGL eviction timer period
+#define TRANSFORM_CACHE_JOB_MS 10
+#define TRANSFORM_CACHE_JOB_BATCH 2
+#define TRANSFORM_CACHE_TRIM_MS 100
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint16_t entries;           // Variants in PSRAM now
+    uint16_t queued;            // Waiting for Core 1
+    uint32_t bytes;             // Variant bytes now
+    uint32_t hits;              // Draws served from a variant
+    uint32_t misses;            // Draws left to LVGL (no variant yet)
+    uint32_t generated;         // Variants made on Core 1
+    uint32_t evictions;
+    uint32_t dropped;           // Requests lost to a full queue
+    uint32_t unsupported;       // Draws of sources that cannot be served
+} MAIN_transform_cache_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Register the Core 1 job and the eviction timer
+ * @return true if ready
+ * @note LVGL task, after MAIN_initialise_lvgl().
+ */
+bool MAIN_initialise_transform_cache(void);
+
+/**
+ * @brief Draw an image from variants from now on
+ * @param image lv_image object (tracking twice is harmless)
+ * @note LVGL task.
+ */
+void MAIN_transform_cache_track(lv_obj_t *image);
+
+/**
+ * @brief Queue the variants an animation will draw, and track the image
+ * @param image lv_image object
+ * @param angleFrom Start rotation (0.1 degree)
+ * @param angleTo End rotation
+ * @param scaleFrom Start scale (256 = none)
+ * @param scaleTo End scale
+ * @return uint16_t Variants queued (those already cached are skipped)
+ * @note LVGL task. At most TRANSFORM_CACHE_PREPARE_MAX steps, spread
+ *       evenly over the range.
+ */
+uint16_t MAIN_transform_cache_prepare(lv_obj_t *image, int32_t angleFrom, int32_t angleTo, int32_t scaleFrom,
+                                      int32_t scaleTo);
+
+/**
+ * @brief Drop every variant and queued request (e.g. after image sources
+ *        were replaced)
+ * @note LVGL task, outside rendering.
+ */
+void MAIN_transform_cache_clear(void);
+
+/**
+ * @brief Cache counters
+ * @param stats Receives the counters
+ */
+void MAIN_transform_cache_get_stats(MAIN_transform_cache_stats_t *stats);
+
+#endif // __MAIN_TRANSFORM_CACHE_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_transformCacheLib.h
+ ******************************************************************************/
@@ -0,0 +1,390 @@
+/**
+ * @file MAIN_transitionLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Screen transitions from snapshots instead of live screens
+ * @version 1.0.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_transitionLib.h"
+#include "EARS_systemDef.h"
+#include "MAIN_memPlanLib.h"
+#include <esp_heap_caps.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+// Snapshot buffers
+enum
+{
+    TRANSITION_OUT = 0,
+    TRANSITION_IN,
+    TRANSITION_BUFFERS
+};
+
+typedef struct
+{
+    int8_t dx;     // Direction the moving snapshot travels (-1, 0, 1)
+    int8_t dy;
+    bool moveIn;   // Incoming slides in (OVER_..., MOVE_...)
+    bool moveOut;  // Outgoing slides out (MOVE_..., OUT_...)
+    bool fadeIn;   // Incoming fades in on top (FADE_IN, FADE_ON)
+    bool fadeOut;  // Outgoing fades out on top (FADE_OUT)
+} transition_motion_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static lv_draw_buf_t transition_bufs[TRANSITION_BUFFERS];
+static uint8_t *transition_memory[TRANSITION_BUFFERS] = {NULL, NULL};
+static bool transition_ready = false;
+
+static lv_obj_t *transition_screen = NULL;
+static lv_obj_t *transition_images[TRANSITION_BUFFERS] = {NULL, NULL};
+static lv_obj_t *transition_target = NULL; // Incoming screen, until loaded
+static transition_motion_t transition_motion;
+static int32_t transition_distance = 0;
+static bool transition_running = false;
+static uint32_t transition_start_ms = 0;
+
+static MAIN_transition_stats_t transition_stats;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief How the snapshots move for an LVGL screen animation
+ * @param anim LV_SCR_LOAD_ANIM_... type
+ * @param motion Receives the motion
+ * @return true if the type is drawn from snapshots
+ */
+static bool transition_motion_for(lv_screen_load_anim_t anim, transition_motion_t *motion)
+{
+    memset(motion, 0, sizeof(*motion));
+    switch (anim)
+    {
+    case LV_SCR_LOAD_ANIM_FADE_IN: // Also FADE_ON
+        motion->fadeIn = true;
+        return true;
+    case LV_SCR_LOAD_ANIM_FADE_OUT:
+        motion->fadeOut = true;
+        return true;
+    case LV_SCR_LOAD_ANIM_OVER_LEFT:
+    case LV_SCR_LOAD_ANIM_MOVE_LEFT:
+    case LV_SCR_LOAD_ANIM_OUT_LEFT:
+        motion->dx = -1;
+        break;
+    case LV_SCR_LOAD_ANIM_OVER_RIGHT:
+    case LV_SCR_LOAD_ANIM_MOVE_RIGHT:
+    case LV_SCR_LOAD_ANIM_OUT_RIGHT:
+        motion->dx = 1;
+        break;
+    case LV_SCR_LOAD_ANIM_OVER_TOP:
+    case LV_SCR_LOAD_ANIM_MOVE_TOP:
+    case LV_SCR_LOAD_ANIM_OUT_TOP:
+        motion->dy = -1;
+        break;
+    case LV_SCR_LOAD_ANIM_OVER_BOTTOM:
+    case LV_SCR_LOAD_ANIM_MOVE_BOTTOM:
+    case LV_SCR_LOAD_ANIM_OUT_BOTTOM:
+        motion->dy = 1;
+        break;
+    default:
+        return false;
+    }
+
+    // LVGL orders them OVER_..., MOVE_..., fades, OUT_...
+    motion->moveIn = anim <= LV_SCR_LOAD_ANIM_MOVE_BOTTOM;
+    motion->moveOut = anim >= LV_SCR_LOAD_ANIM_MOVE_LEFT;
+    return true;
+}
+
+/**
+ * @brief Load the incoming screen if the transition screen is still showing
+ * @details Something else (the screensaver) may have loaded over it; the
+ *          incoming screen then follows when the transition screen is
+ *          loaded back.
+ */
+static void transition_show_target(void)
+{
+    if (transition_target != NULL && lv_screen_active() == transition_screen)
+    {
+        lv_obj_t *target = transition_target;
+        transition_target = NULL;
+        lv_screen_load(target);
+    }
+}
+
+/**
+ * @brief Transition screen loaded back after the animation ended
+ */
+static void transition_screen_loaded_cb(lv_event_t *e)
+{
+    (void)e;
+    if (!transition_running)
+    {
+        transition_show_target();
+    }
+}
+
+/**
+ * @brief Create the transition screen and its two snapshot images once
+ */
+static void transition_create_screen(void)
+{
+    transition_screen = lv_obj_create(NULL);
+    lv_obj_remove_style_all(transition_screen);
+    lv_obj_remove_flag(transition_screen, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(transition_screen, transition_screen_loaded_cb, LV_EVENT_SCREEN_LOADED, NULL);
+
+    for (uint8_t i = 0; i < TRANSITION_BUFFERS; i++)
+    {
+        transition_images[i] = lv_image_create(transition_screen);
+        lv_obj_remove_flag(transition_images[i], LV_OBJ_FLAG_CLICKABLE);
+    }
+}
+
+/**
+ * @brief One animation step: move or fade the snapshots
+ * @param var Unused
+ * @param value Pixels travelled, or opacity for fades
+ */
+static void transition_step_cb(void *var, int32_t value)
+{
+    (void)var;
+    transition_stats.frames++;
+
+    const transition_motion_t *m = &transition_motion;
+    if (m->fadeIn)
+    {
+        lv_obj_set_style_image_opa(transition_images[TRANSITION_IN], (lv_opa_t)value, LV_PART_MAIN);
+        return;
+    }
+    if (m->fadeOut)
+    {
+        lv_obj_set_style_image_opa(transition_images[TRANSITION_OUT], (lv_opa_t)(LV_OPA_COVER - value), LV_PART_MAIN);
+        return;
+    }
+
+    // Incoming starts a full screen behind and arrives at 0, outgoing leaves
+    int32_t remaining = transition_distance - value;
+    if (m->moveIn)
+    {
+        lv_obj_set_pos(transition_images[TRANSITION_IN], -m->dx * remaining, -m->dy * remaining);
+    }
+    if (m->moveOut)
+    {
+        lv_obj_set_pos(transition_images[TRANSITION_OUT], m->dx * value, m->dy * value);
+    }
+}
+
+/**
+ * @brief Animation finished: record the rate and show the real screen
+ * @param anim Unused
+ */
+static void transition_completed_cb(lv_anim_t *anim)
+{
+    (void)anim;
+    transition_running = false;
+
+    uint32_t elapsed = lv_tick_elaps(transition_start_ms);
+    transition_stats.fps = elapsed ? transition_stats.frames * 1000 / elapsed : 0;
+
+    transition_show_target();
+}
+
+/**
+ * @brief Snapshot both screens and place the images for the first frame
+ * @param out Screen being left
+ * @param in Screen being loaded
+ * @return true if both snapshots were taken
+ */
+static bool transition_prepare(lv_obj_t *out, lv_obj_t *in)
+{
+    uint32_t start = lv_tick_get();
+
+    // A screen that has never been shown has not been laid out yet
+    lv_obj_update_layout(in);
+
+    if (lv_snapshot_take_to_draw_buf(out, LV_COLOR_FORMAT_RGB565, &transition_bufs[TRANSITION_OUT]) != LV_RESULT_OK ||
+        lv_snapshot_take_to_draw_buf(in, LV_COLOR_FORMAT_RGB565, &transition_bufs[TRANSITION_IN]) != LV_RESULT_OK)
+    {
+        return false;
+    }
+    transition_stats.snapshotMs = lv_tick_elaps(start);
+
+    for (uint8_t i = 0; i < TRANSITION_BUFFERS; i++)
+    {
+        // Same buffers every time: drop what the image cache knows of them
+        lv_image_cache_drop(&transition_bufs[i]);
+        lv_image_set_src(transition_images[i], &transition_bufs[i]);
+        lv_obj_set_pos(transition_images[i], 0, 0);
+        lv_obj_set_style_image_opa(transition_images[i], LV_OPA_COVER, LV_PART_MAIN);
+    }
+
+    // The moving or fading snapshot is drawn on top
+    bool inOnTop = transition_motion.fadeIn || transition_motion.moveIn;
+    lv_obj_move_foreground(transition_images[inOnTop ? TRANSITION_IN : TRANSITION_OUT]);
+
+    if (transition_motion.fadeIn)
+    {
+        lv_obj_set_style_image_opa(transition_images[TRANSITION_IN], LV_OPA_TRANSP, LV_PART_MAIN);
+    }
+    else if (transition_motion.moveIn)
+    {
+        lv_obj_set_pos(transition_images[TRANSITION_IN],
+                       -transition_motion.dx * transition_distance,
+                       -transition_motion.dy * transition_distance);
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+bool MAIN_initialise_transitions(void)
+{
+    if (transition_ready)
+    {
+        return true;
+    }
+
+    int32_t w = lv_display_get_horizontal_resolution(NULL);
+    int32_t h = lv_display_get_vertical_resolution(NULL);
+    uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+    uint32_t size = stride * h + LV_DRAW_BUF_ALIGN; // Room to align the start
+
+    for (uint8_t i = 0; i < TRANSITION_BUFFERS; i++)
+    {
+        transition_memory[i] = (uint8_t *)MAIN_mem_alloc(MEM_POOL_SNAPSHOTS, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (transition_memory[i] == NULL ||
+            lv_draw_buf_init(&transition_bufs[i], w, h, LV_COLOR_FORMAT_RGB565, stride,
+                             transition_memory[i], size) != LV_RESULT_OK)
+        {
+            Serial.println("[TRANSITION] ERROR: No PSRAM for snapshots, using LVGL screen animations");
+            for (uint8_t j = 0; j <= i; j++)
+            {
+                MAIN_mem_free(transition_memory[j]);
+                transition_memory[j] = NULL;
+            }
+            return false;
+        }
+    }
+
+    transition_create_screen();
+    transition_ready = true;
+
+#if EARS_DEBUG == 1
+    Serial.printf("[TRANSITION] 2 x %lu byte snapshot buffers in PSRAM\n", (unsigned long)size);
+#endif
+    return true;
+}
+
+void MAIN_transition_load(lv_obj_t *screen, lv_screen_load_anim_t anim, uint32_t time, uint32_t delay)
+{
+    if (screen == NULL)
+    {
+        return;
+    }
+
+    // A transition still running ends now, on its incoming screen
+    if (transition_running)
+    {
+        lv_anim_delete(&transition_motion, transition_step_cb);
+        transition_completed_cb(NULL);
+    }
+    transition_target = NULL;
+
+    lv_obj_t *out = lv_screen_active();
+    transition_motion_t motion;
+    if (!transition_ready || time == 0 || out == NULL || out == screen || out == transition_screen ||
+        !transition_motion_for(anim, &motion))
+    {
+        transition_stats.fallbacks++;
+        lv_screen_load_anim(screen, anim, time, delay, false);
+        return;
+    }
+
+    transition_motion = motion;
+    transition_distance = motion.dx ? lv_display_get_horizontal_resolution(NULL)
+                                    : lv_display_get_vertical_resolution(NULL);
+    if (!transition_prepare(out, screen))
+    {
+        transition_stats.fallbacks++;
+        lv_screen_load_anim(screen, anim, time, delay, false);
+        return;
+    }
+
+    transition_target = screen;
+    transition_running = true;
+    transition_stats.transitions++;
+    transition_stats.frames = 0;
+    transition_start_ms = lv_tick_get() + delay;
+    lv_screen_load(transition_screen);
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &transition_motion);
+    lv_anim_set_exec_cb(&a, transition_step_cb);
+    lv_anim_set_completed_cb(&a, transition_completed_cb);
+    lv_anim_set_values(&a, 0, (motion.fadeIn || motion.fadeOut) ? LV_OPA_COVER : transition_distance);
+    lv_anim_set_duration(&a, time);
+    lv_anim_set_delay(&a, delay);
+    lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+    lv_anim_start(&a);
+}
+
+bool MAIN_transition_busy(void)
+{
+    return transition_running || transition_target != NULL;
+}
+
+void MAIN_transition_get_stats(MAIN_transition_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+    *stats = transition_stats;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_Transition_getLibraryName() {
+    return MAIN_Transition::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_Transition_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_Transition::VERSION_MAJOR,
+                       MAIN_Transition::VERSION_MINOR,
+                       MAIN_Transition::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_Transition_getVersionDate() {
+    return MAIN_Transition::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_Transition_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_Transition_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_transitionLib.cpp
+ ******************************************************************************/
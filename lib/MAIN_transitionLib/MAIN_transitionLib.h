@@ -0,0 +1,118 @@
+/**
+ * @file MAIN_transitionLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Screen transitions from snapshots instead of live screens
+ * @details lv_screen_load_anim redraws both screens, every widget of each,
+ *          on every frame of a transition, and a fade blends two full
+ *          480x320 renders in software. Here the outgoing and incoming
+ *          screens are each drawn once, with lv_snapshot, into RGB565
+ *          buffers in PSRAM. A transition screen shows the two snapshots as
+ *          plain images and the animation only moves them (slides: offset
+ *          copies) or changes the top one's opacity (fades: one blend of
+ *          two prepared buffers). The real incoming screen is loaded at the
+ *          end.
+ *
+ *          MAIN_transition_load is a drop-in for lv_screen_load_anim with
+ *          auto_del false and takes the same animation types. Without the
+ *          buffers (no PSRAM, or a snapshot that does not fit) it calls
+ *          lv_screen_load_anim. Input is ignored while a transition runs;
+ *          a second load during one finishes the first at once.
+ *
+ *          The outgoing screen is frozen from the call, including any
+ *          delay. Called from the EEZ flow's replacePageHook and from the
+ *          non-flow loadScreen in src/ui/ui.c, so this header stays C.
+ *          UI task only.
+ * @version 1.0.1
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_TRANSITION_LIB_H__
+#define __MAIN_TRANSITION_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <lvgl.h>
+
+#ifdef __cplusplus
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_Transition
+{
+    constexpr const char* LIB_NAME = "MAIN_Transition";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "1";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_Transition_getLibraryName();
+uint32_t MAIN_Transition_getVersionEncoded();
+const char* MAIN_Transition_getVersionDate();
+void MAIN_Transition_getVersionString(char* buffer);
+
+extern "C" {
+#endif
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t transitions;   // Run from snapshots
+    uint32_t fallbacks;     // Handed to lv_screen_load_anim
+    uint32_t snapshotMs;    // Both snapshots of the last transition
+    uint32_t frames;        // Animation steps of the last transition
+    uint32_t fps;           // Of the last transition
+} MAIN_transition_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Allocate the two snapshot buffers in PSRAM (UI task, after LVGL)
+ * @return true if snapshot transitions are available
+ */
+bool MAIN_initialise_transitions(void);
+
+/**
+ * @brief Load a screen with a transition (UI task only)
+ * @param screen Screen to load (kept, as auto_del false)
+ * @param anim LV_SCR_LOAD_ANIM_... type
+ * @param time Duration in ms
+ * @param delay Wait before the animation starts in ms
+ */
+void MAIN_transition_load(lv_obj_t *screen, lv_screen_load_anim_t anim, uint32_t time, uint32_t delay);
+
+/**
+ * @brief Whether a transition is showing
+ * @return true from the call until the incoming screen is loaded
+ */
+bool MAIN_transition_busy(void);
+
+/**
+ * @brief Transition counters
+ * @param stats Receives the counters
+ */
+void MAIN_transition_get_stats(MAIN_transition_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MAIN_TRANSITION_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_transitionLib.h
+ ******************************************************************************/
@@ -0,0 +1,408 @@
+/**
+ * @file MAIN_uiCommandLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Typed UI command channel for tasks other than the UI task
+ * @version 1.0.2
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_uiCommandLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_placementDef.h"
+#include "EARS_mpscRingDef.h"
+#include <atomic>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint8_t type; // MAIN_ui_cmd_type_t
+    bool set;     // Add (true) or remove, animate for bars
+    lv_obj_t *obj;
+    union
+    {
+        int32_t value;
+        uint32_t bits;
+        struct
+        {
+            MAIN_ui_cmd_fn_t fn;
+            void *ctx;
+            uint32_t param;
+        } call;
+        char text[UI_CMD_TEXT_SIZE];
+    };
+} ui_cmd_slot_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static EARS_mpscRing<ui_cmd_slot_t, UI_CMD_QUEUE_SIZE> ui_cmd_ring; // UI task consumes
+static TaskHandle_t ui_cmd_task_handle = NULL;
+
+// Producer counters may be bumped from several tasks at once
+static std::atomic<uint32_t> ui_cmd_posted(0);
+static std::atomic<uint32_t> ui_cmd_dropped(0);
+static std::atomic<uint32_t> ui_cmd_truncated(0);
+static uint32_t ui_cmd_applied = 0;
+static uint16_t ui_cmd_peak = 0;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Claim the next free slot
+ * @return ui_cmd_slot_t* Slot to fill, or NULL if the queue is full
+ */
+static ui_cmd_slot_t EARS_HOT *ui_cmd_claim(void)
+{
+    ui_cmd_slot_t *slot = ui_cmd_ring.claim();
+    if (slot == NULL)
+    {
+        ui_cmd_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    return slot;
+}
+
+/**
+ * @brief Hand a filled slot to the UI task and wake it
+ * @param slot Slot from ui_cmd_claim()
+ */
+static void EARS_HOT ui_cmd_publish(ui_cmd_slot_t *slot)
+{
+    ui_cmd_ring.publish(slot);
+    ui_cmd_posted.fetch_add(1, std::memory_order_relaxed);
+
+    if (ui_cmd_task_handle != NULL)
+    {
+        xTaskNotifyGive(ui_cmd_task_handle);
+    }
+}
+
+/**
+ * @brief Queue a command that carries an object and one word
+ * @param type Command type
+ * @param obj Object
+ * @param bits Value, flags or states
+ * @param set Add/remove or animate
+ * @return true if queued
+ */
+static bool ui_cmd_post(MAIN_ui_cmd_type_t type, lv_obj_t *obj, uint32_t bits, bool set)
+{
+    if (obj == NULL)
+    {
+        return false;
+    }
+
+    ui_cmd_slot_t *slot = ui_cmd_claim();
+    if (slot == NULL)
+    {
+        return false;
+    }
+
+    slot->type = (uint8_t)type;
+    slot->obj = obj;
+    slot->bits = bits;
+    slot->set = set;
+    ui_cmd_publish(slot);
+    return true;
+}
+
+/**
+ * @brief Run one command (UI task)
+ * @param slot Copy of the slot
+ */
+static void ui_cmd_run(const ui_cmd_slot_t *slot)
+{
+    switch (slot->type)
+    {
+    case UI_CMD_CALL:
+        slot->call.fn(slot->call.ctx, slot->call.param);
+        break;
+
+    case UI_CMD_LABEL_TEXT:
+        lv_label_set_text(slot->obj, slot->text);
+        break;
+
+    case UI_CMD_BAR_VALUE:
+        lv_bar_set_value(slot->obj, slot->value, slot->set ? LV_ANIM_ON : LV_ANIM_OFF);
+        break;
+
+    case UI_CMD_ARC_VALUE:
+        lv_arc_set_value(slot->obj, slot->value);
+        break;
+
+    case UI_CMD_OBJ_FLAG:
+        if (slot->set)
+        {
+            lv_obj_add_flag(slot->obj, (lv_obj_flag_t)slot->bits);
+        }
+        else
+        {
+            lv_obj_remove_flag(slot->obj, (lv_obj_flag_t)slot->bits);
+        }
+        break;
+
+    case UI_CMD_OBJ_STATE:
+        if (slot->set)
+        {
+            lv_obj_add_state(slot->obj, (lv_state_t)slot->bits);
+        }
+        else
+        {
+            lv_obj_remove_state(slot->obj, (lv_state_t)slot->bits);
+        }
+        break;
+
+    case UI_CMD_LOAD_SCREEN:
+        lv_screen_load(slot->obj);
+        break;
+
+    case UI_CMD_DELETE:
+        lv_obj_delete(slot->obj);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/******************************************************************************
+ * Producers (any task)
+ *****************************************************************************/
+
+/**
+ * @brief Task woken when a command is posted
+ * @param task UI task handle
+ */
+void MAIN_ui_cmd_set_ui_task(TaskHandle_t task)
+{
+    ui_cmd_task_handle = task;
+}
+
+/**
+ * @brief Queue a label text (copied)
+ * @param label Label object
+ * @param text Text
+ * @return true if queued
+ */
+bool MAIN_ui_cmd_label_text(lv_obj_t *label, const char *text)
+{
+    if (label == NULL || text == NULL)
+    {
+        return false;
+    }
+
+    ui_cmd_slot_t *slot = ui_cmd_claim();
+    if (slot == NULL)
+    {
+        return false;
+    }
+
+    size_t len = strnlen(text, UI_CMD_TEXT_SIZE);
+    if (len == UI_CMD_TEXT_SIZE)
+    {
+        len = UI_CMD_TEXT_SIZE - 1;
+        ui_cmd_truncated.fetch_add(1, std::memory_order_relaxed);
+    }
+    memcpy(slot->text, text, len);
+    slot->text[len] = '\0';
+
+    slot->type = UI_CMD_LABEL_TEXT;
+    slot->obj = label;
+    ui_cmd_publish(slot);
+    return true;
+}
+
+/**
+ * @brief Queue a bar value
+ * @param bar Bar object
+ * @param value New value
+ * @param anim true to animate
+ * @return true if queued
+ */
+bool MAIN_ui_cmd_bar_value(lv_obj_t *bar, int32_t value, bool anim)
+{
+    return ui_cmd_post(UI_CMD_BAR_VALUE, bar, (uint32_t)value, anim);
+}
+
+/**
+ * @brief Queue an arc value
+ * @param arc Arc object
+ * @param value New value
+ * @return true if queued
+ */
+bool MAIN_ui_cmd_arc_value(lv_obj_t *arc, int32_t value)
+{
+    return ui_cmd_post(UI_CMD_ARC_VALUE, arc, (uint32_t)value, false);
+}
+
+/**
+ * @brief Queue adding or removing object flags
+ * @param obj Object
+ * @param flags LV_OBJ_FLAG_... bits
+ * @param set true to add
+ * @return true if queued
+ */
+bool MAIN_ui_cmd_obj_flag(lv_obj_t *obj, lv_obj_flag_t flags, bool set)
+{
+    return ui_cmd_post(UI_CMD_OBJ_FLAG, obj, (uint32_t)flags, set);
+}
+
+/**
+ * @brief Queue adding or removing object states
+ * @param obj Object
+ * @param states LV_STATE_... bits
+ * @param set true to add
+ * @return true if queued
+ */
+bool MAIN_ui_cmd_obj_state(lv_obj_t *obj, lv_state_t states, bool set)
+{
+    return ui_cmd_post(UI_CMD_OBJ_STATE, obj, (uint32_t)states, set);
+}
+
+/**
+ * @brief Queue a screen load
+ * @param screen Screen object
+ * @return true if queued
+ */
+bool MAIN_ui_cmd_load_screen(lv_obj_t *screen)
+{
+    return ui_cmd_post(UI_CMD_LOAD_SCREEN, screen, 0, false);
+}
+
+/**
+ * @brief Queue an object delete
+ * @param obj Object
+ * @return true if queued
+ */
+bool MAIN_ui_cmd_delete(lv_obj_t *obj)
+{
+    return ui_cmd_post(UI_CMD_DELETE, obj, 0, false);
+}
+
+/**
+ * @brief Queue a call on the UI task
+ * @param fn Function
+ * @param ctx Passed to fn
+ * @param param Passed to fn
+ * @return true if queued
+ */
+bool MAIN_ui_cmd_call(MAIN_ui_cmd_fn_t fn, void *ctx, uint32_t param)
+{
+    if (fn == NULL)
+    {
+        return false;
+    }
+
+    ui_cmd_slot_t *slot = ui_cmd_claim();
+    if (slot == NULL)
+    {
+        return false;
+    }
+
+    slot->type = UI_CMD_CALL;
+    slot->obj = NULL;
+    slot->call.fn = fn;
+    slot->call.ctx = ctx;
+    slot->call.param = param;
+    ui_cmd_publish(slot);
+    return true;
+}
+
+/******************************************************************************
+ * Consumer (UI task)
+ *****************************************************************************/
+
+/**
+ * @brief Run queued commands (UI task only)
+ * @param maxCommands Upper bound for this call
+ * @return uint16_t Commands run
+ */
+uint16_t MAIN_ui_cmd_apply(uint16_t maxCommands)
+{
+    uint16_t waiting = (uint16_t)ui_cmd_ring.pending();
+    if (waiting > ui_cmd_peak)
+    {
+        ui_cmd_peak = waiting;
+    }
+
+    uint16_t count = 0;
+    while (count < maxCommands)
+    {
+        // Empty, or the producer is still writing the next command
+        ui_cmd_slot_t *slot = ui_cmd_ring.peek();
+        if (slot == NULL)
+        {
+            break;
+        }
+
+        // Copy out, free the slot for the producers, then touch LVGL
+        ui_cmd_slot_t command = *slot;
+        ui_cmd_ring.pop();
+        count++;
+
+        ui_cmd_run(&command);
+    }
+
+    ui_cmd_applied += count;
+    return count;
+}
+
+/**
+ * @brief Channel counters
+ * @param stats Receives the counters
+ */
+void MAIN_ui_cmd_get_stats(MAIN_ui_cmd_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    stats->posted = ui_cmd_posted.load(std::memory_order_relaxed);
+    stats->applied = ui_cmd_applied;
+    stats->dropped = ui_cmd_dropped.load(std::memory_order_relaxed);
+    stats->truncated = ui_cmd_truncated.load(std::memory_order_relaxed);
+    stats->peak = ui_cmd_peak;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_UiCommand_getLibraryName() {
+    return MAIN_UiCommand::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_UiCommand_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_UiCommand::VERSION_MAJOR,
+                       MAIN_UiCommand::VERSION_MINOR,
+                       MAIN_UiCommand::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_UiCommand_getVersionDate() {
+    return MAIN_UiCommand::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_UiCommand_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_UiCommand_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_uiCommandLib.cpp
+ ******************************************************************************/
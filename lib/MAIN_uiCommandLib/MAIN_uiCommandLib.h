@@ -0,0 +1,193 @@
+/**
+ * @file MAIN_uiCommandLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Typed UI command channel for tasks other than the UI task
+ * @details LVGL is not thread safe: it runs only inside MAIN_core0_ui_task,
+ *          and xDisplayMutex guards the SPI bus in the flush callback, not
+ *          LVGL state. Core 1 work (MAIN_core1_background_task, jobs, the
+ *          flow worker) therefore never calls LVGL directly. It posts a typed
+ *          command instead - set label text, set a bar or arc value, load a
+ *          screen, change a flag or state, or call a function - and the UI
+ *          task applies up to UI_CMD_BATCH of them before each
+ *          lv_timer_handler.
+ *
+ *          The queue is a bounded lock-free MPSC ring (Vyukov): a post is one
+ *          compare-exchange and a copy into a preallocated slot, with no lock
+ *          shared with rendering and no heap. Label text is copied into the
+ *          slot (up to UI_CMD_TEXT_SIZE - 1 characters). A full queue refuses
+ *          the post and counts it.
+ *
+ *          Objects named in a command must outlive it: post only for widgets
+ *          the UI keeps (screens from ui_init, persistent labels), or delete
+ *          through a command so the order is kept.
+ * @version 1.0.2
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_UI_COMMAND_LIB_H__
+#define __MAIN_UI_COMMAND_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "EARS_versionDef.h"
+#include <lvgl.h>
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_UiCommand
+{
+    constexpr const char* LIB_NAME = "MAIN_UiCommand";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "2";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_UiCommand_getLibraryName();
+uint32_t MAIN_UiCommand_getVersionEncoded();
+const char* MAIN_UiCommand_getVersionDate();
+void MAIN_UiCommand_getVersionString(char* buffer);
+
+/******************************************************************************
+ * UI Command Configuration
+ *****************************************************************************/
+
+// Commands held (power of 2) and how many the UI task applies per frame
+#define UI_CMD_QUEUE_SIZE 64
+#define UI_CMD_BATCH 32
+
+// Label text copied into a command, including the terminator
+#define UI_CMD_TEXT_SIZE 32
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef enum
+{
+    UI_CMD_CALL = 0,     // fn(ctx, param)
+    UI_CMD_LABEL_TEXT,   // lv_label_set_text
+    UI_CMD_BAR_VALUE,    // lv_bar_set_value
+    UI_CMD_ARC_VALUE,    // lv_arc_set_value
+    UI_CMD_OBJ_FLAG,     // lv_obj_add_flag / lv_obj_remove_flag
+    UI_CMD_OBJ_STATE,    // lv_obj_add_state / lv_obj_remove_state
+    UI_CMD_LOAD_SCREEN,  // lv_screen_load
+    UI_CMD_DELETE        // lv_obj_delete
+} MAIN_ui_cmd_type_t;
+
+typedef void (*MAIN_ui_cmd_fn_t)(void *ctx, uint32_t param);
+
+typedef struct
+{
+    uint32_t posted;    // Commands queued
+    uint32_t applied;   // Commands run by the UI task
+    uint32_t dropped;   // Posts refused because the queue was full
+    uint32_t truncated; // Label texts cut to UI_CMD_TEXT_SIZE - 1
+    uint16_t peak;      // Most commands waiting at once
+} MAIN_ui_cmd_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Task woken when a command is posted
+ * @param task UI task handle
+ * @note Called by MAIN_create_core0_task().
+ */
+void MAIN_ui_cmd_set_ui_task(TaskHandle_t task);
+
+/**
+ * @brief Queue a label text (copied)
+ * @param label Label object
+ * @param text Text, cut to UI_CMD_TEXT_SIZE - 1 characters
+ * @return true if queued, false if the queue is full
+ */
+bool MAIN_ui_cmd_label_text(lv_obj_t *label, const char *text);
+
+/**
+ * @brief Queue a bar value
+ * @param bar Bar object
+ * @param value New value
+ * @param anim true to animate
+ * @return true if queued
+ */
+bool MAIN_ui_cmd_bar_value(lv_obj_t *bar, int32_t value, bool anim);
+
+/**
+ * @brief Queue an arc value
+ * @param arc Arc object
+ * @param value New value
+ * @return true if queued
+ */
+bool MAIN_ui_cmd_arc_value(lv_obj_t *arc, int32_t value);
+
+/**
+ * @brief Queue adding or removing object flags
+ * @param obj Object
+ * @param flags LV_OBJ_FLAG_... bits (e.g. LV_OBJ_FLAG_HIDDEN)
+ * @param set true to add, false to remove
+ * @return true if queued
+ */
+bool MAIN_ui_cmd_obj_flag(lv_obj_t *obj, lv_obj_flag_t flags, bool set);
+
+/**
+ * @brief Queue adding or removing object states
+ * @param obj Object
+ * @param states LV_STATE_... bits (e.g. LV_STATE_DISABLED)
+ * @param set true to add, false to remove
+ * @return true if queued
+ */
+bool MAIN_ui_cmd_obj_state(lv_obj_t *obj, lv_state_t states, bool set);
+
+/**
+ * @brief Queue a screen load
+ * @param screen Screen object
+ * @return true if queued
+ */
+bool MAIN_ui_cmd_load_screen(lv_obj_t *screen);
+
+/**
+ * @brief Queue an object delete
+ * @param obj Object (no later command may name it)
+ * @return true if queued
+ */
+bool MAIN_ui_cmd_delete(lv_obj_t *obj);
+
+/**
+ * @brief Queue a call on the UI task, for updates the typed commands lack
+ * @param fn Function run before lv_timer_handler
+ * @param ctx Passed to fn
+ * @param param Passed to fn
+ * @return true if queued
+ */
+bool MAIN_ui_cmd_call(MAIN_ui_cmd_fn_t fn, void *ctx, uint32_t param);
+
+/**
+ * @brief Run queued commands (UI task only)
+ * @param maxCommands Upper bound for this call
+ * @return uint16_t Commands run
+ */
+uint16_t MAIN_ui_cmd_apply(uint16_t maxCommands);
+
+/**
+ * @brief Channel counters
+ * @param stats Receives the counters
+ */
+void MAIN_ui_cmd_get_stats(MAIN_ui_cmd_stats_t *stats);
+
+#endif // __MAIN_UI_COMMAND_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_uiCommandLib.h
+ ******************************************************************************/
@@ -0,0 +1,217 @@
+/**
+ * @file MAIN_uiTxnLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief UI transactions: many widget changes, one layout and one invalidation
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_uiTxnLib.h"
+#include "EARS_systemDef.h"
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+// Open begins; 0 = no transaction
+static uint16_t txn_depth = 0;
+
+// Display whose invalidation the outermost begin switched off
+static lv_display_t *txn_display = NULL;
+
+// Roots to lay out and invalidate at the outermost commit
+static lv_obj_t *txn_roots[UI_TXN_ROOTS];
+static uint8_t txn_root_count = 0;
+static bool txn_overflow = false;
+
+static MAIN_ui_txn_stats_t txn_stats;
+
+/******************************************************************************
+ * Private Functions
+ *****************************************************************************/
+
+/**
+ * @brief Remember a root for the outermost commit
+ * @param root Root (NULL = the active screen)
+ */
+static void ui_txn_add_root(lv_obj_t *root)
+{
+    if (root == NULL)
+    {
+        root = lv_screen_active();
+    }
+
+    for (uint8_t i = 0; i < txn_root_count; i++)
+    {
+        if (txn_roots[i] == root)
+        {
+            return;
+        }
+    }
+
+    if (txn_root_count < UI_TXN_ROOTS)
+    {
+        txn_roots[txn_root_count++] = root;
+    }
+    else
+    {
+        txn_overflow = true;
+    }
+}
+
+/**
+ * @brief Turn invalidation back on, then one layout and one invalidation per root
+ */
+static void ui_txn_flush(void)
+{
+    if (txn_display != NULL)
+    {
+        lv_display_enable_invalidation(txn_display, true);
+        txn_display = NULL;
+    }
+
+    // Too many roots: the active screen holds all of them worth drawing
+    if (txn_overflow)
+    {
+        txn_roots[0] = lv_screen_active();
+        txn_root_count = 1;
+        txn_stats.overflows++;
+    }
+
+    for (uint8_t i = 0; i < txn_root_count; i++)
+    {
+        // Deleted inside the transaction: nothing left to draw
+        if (txn_roots[i] == NULL || !lv_obj_is_valid(txn_roots[i]))
+        {
+            continue;
+        }
+        lv_obj_update_layout(txn_roots[i]);
+        lv_obj_invalidate(txn_roots[i]);
+        txn_stats.roots++;
+    }
+
+    txn_root_count = 0;
+    txn_overflow = false;
+    txn_stats.transactions++;
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Start a transaction (or nest in the open one)
+ */
+void MAIN_ui_txn_begin(void)
+{
+    if (txn_depth > 0)
+    {
+        txn_depth++;
+        txn_stats.nested++;
+        return;
+    }
+
+    txn_depth = 1;
+    txn_root_count = 0;
+    txn_overflow = false;
+
+    txn_display = lv_display_get_default();
+    if (txn_display != NULL)
+    {
+        lv_display_enable_invalidation(txn_display, false);
+    }
+}
+
+/**
+ * @brief End a transaction; the outermost one lays out and invalidates
+ */
+void MAIN_ui_txn_commit(lv_obj_t *root)
+{
+    if (txn_depth == 0)
+    {
+        txn_stats.unbalanced++;
+#if EARS_DEBUG == 1
+        Serial.println("[UI_TXN] WARNING: Commit with no transaction open");
+#endif
+        return;
+    }
+
+    ui_txn_add_root(root);
+    if (--txn_depth == 0)
+    {
+        ui_txn_flush();
+    }
+}
+
+/**
+ * @brief Check for an open transaction
+ */
+bool MAIN_ui_txn_is_open(void)
+{
+    return txn_depth > 0;
+}
+
+/**
+ * @brief Commit whatever is still open, counting it as leaked
+ */
+void MAIN_ui_txn_close_all(void)
+{
+    if (txn_depth == 0)
+    {
+        return;
+    }
+
+#if EARS_DEBUG == 1
+    Serial.printf("[UI_TXN] WARNING: %u begin(s) never committed, closing\n", txn_depth);
+#endif
+    txn_stats.leaked++;
+    txn_depth = 0;
+
+    // The changes were made somewhere on screen, but where is not known
+    txn_overflow = true;
+    ui_txn_flush();
+}
+
+/**
+ * @brief Transaction counters
+ */
+void MAIN_ui_txn_get_stats(MAIN_ui_txn_stats_t *stats)
+{
+    *stats = txn_stats;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_UiTxn_getLibraryName() {
+    return MAIN_UiTxn::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_UiTxn_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_UiTxn::VERSION_MAJOR,
+                       MAIN_UiTxn::VERSION_MINOR,
+                       MAIN_UiTxn::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_UiTxn_getVersionDate() {
+    return MAIN_UiTxn::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_UiTxn_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_UiTxn_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/******************************************************************************
+ * End of MAIN_uiTxnLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,130 @@
+/**
+ * @file MAIN_uiTxnLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief UI transactions: many widget changes, one layout and one invalidation
+ * @details Every LVGL property change invalidates the object it touches
+ *          (a visibility walk up its parents, then a merge into the
+ *          display's dirty list) and marks its screen's layout dirty. Past
+ *          LV_INV_BUF_SIZE areas LVGL gives up and redraws the whole
+ *          screen. Building a screen or rebinding a list makes hundreds of
+ *          such changes.
+ *
+ *          Between MAIN_ui_txn_begin() and MAIN_ui_txn_commit() the
+ *          display's invalidation is switched off, so those changes cost
+ *          only the property writes. The commit runs lv_obj_update_layout
+ *          once for the root it is given and invalidates that root once.
+ *          Transactions nest; only the outermost commit does the work, for
+ *          up to UI_TXN_ROOTS roots (more falls back to the active screen).
+ *
+ *          Layout already waits for the next refresh in LVGL 9 unless a
+ *          call needs coordinates (scrolling, lv_obj_get_x), which still
+ *          lays out on the spot inside a transaction.
+ *
+ *          Begin and commit in the same UI task pass. The UI task closes
+ *          any transaction left open before lv_timer_handler, so a missing
+ *          commit cannot hide a frame's changes. Called from the EEZ screen
+ *          code in src/ui, so this header stays C. UI task only.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_UI_TXN_LIB_H__
+#define __MAIN_UI_TXN_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <lvgl.h>
+
+#ifdef __cplusplus
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_UiTxn
+{
+    constexpr const char* LIB_NAME = "MAIN_UiTxn";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_UiTxn_getLibraryName();
+uint32_t MAIN_UiTxn_getVersionEncoded();
+const char* MAIN_UiTxn_getVersionDate();
+void MAIN_UiTxn_getVersionString(char* buffer);
+
+extern "C" {
+#endif
+
+/******************************************************************************
+ * UI Transaction Configuration
+ *****************************************************************************/
+
+// Distinct roots one outermost transaction can commit
+#define UI_TXN_ROOTS 4
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t transactions;      // Outermost transactions committed
+    uint32_t nested;            // Inner begins folded into an outer one
+    uint32_t roots;             // Roots laid out and invalidated
+    uint32_t overflows;         // Commits that fell back to the active screen
+    uint32_t leaked;            // Left open and closed by the UI task
+    uint32_t unbalanced;        // Commits with no transaction open
+} MAIN_ui_txn_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Start a transaction (or nest in the open one)
+ */
+void MAIN_ui_txn_begin(void);
+
+/**
+ * @brief End a transaction; the outermost one lays out and invalidates
+ * @param root Object the changes were under (NULL = the active screen)
+ */
+void MAIN_ui_txn_commit(lv_obj_t *root);
+
+/**
+ * @brief Check for an open transaction
+ * @return true between begin and the outermost commit
+ */
+bool MAIN_ui_txn_is_open(void);
+
+/**
+ * @brief Commit whatever is still open, counting it as leaked
+ * @note Called by the UI task before each lv_timer_handler.
+ */
+void MAIN_ui_txn_close_all(void);
+
+/**
+ * @brief Transaction counters
+ * @param stats Receives the counters
+ */
+void MAIN_ui_txn_get_stats(MAIN_ui_txn_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MAIN_UI_TXN_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_uiTxnLib.h
+ ******************************************************************************/
@@ -0,0 +1,465 @@
+/**
+ * @file MAIN_usbMscLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief USB mass storage mode: the SD card as a drive on the host
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_usbMscLib.h"
+#include "EARS_systemDef.h"
+#include "EARS_sdCardLib.h"
+#include "MAIN_dialogLib.h"
+#include "MAIN_themeLib.h"
+
+#if EARS_USB_MSC == 1
+#include <USB.h>
+#include <USBMSC.h>
+#include <driver/sdmmc_host.h>
+#include <sdmmc_cmd.h>
+#include <freertos/semphr.h>
+#endif
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+// Written by MAIN_usb_msc_start() (IDLE to STARTING) and by the service
+static volatile MAIN_usb_msc_state_t usb_msc_state = USB_MSC_IDLE;
+static volatile bool usb_msc_stop_wanted = false;
+static volatile bool usb_msc_last_failed = false;
+
+static MAIN_usb_msc_stats_t usb_msc_stats = {};
+static volatile uint32_t usb_msc_read_sectors = 0;
+static volatile uint32_t usb_msc_write_sectors = 0;
+
+// Lock screen, UI task only
+static lv_obj_t *usb_msc_lock = NULL;
+static lv_obj_t *usb_msc_lock_text = NULL;
+static lv_obj_t *usb_msc_lock_eject = NULL;
+static lv_timer_t *usb_msc_lock_timer = NULL;
+
+#if EARS_USB_MSC == 1
+// Registers the interface with TinyUSB when constructed, before USB.begin()
+static USBMSC usb_msc;
+
+static sdmmc_card_t usb_msc_card;
+
+// Held by the TinyUSB task for each transfer and by Core 1 to release the host
+static SemaphoreHandle_t usb_msc_mutex = NULL;
+static StaticSemaphore_t usb_msc_mutex_buffer;
+#endif
+
+/******************************************************************************
+ * Static Functions
+ *****************************************************************************/
+
+#if EARS_USB_MSC == 1
+/**
+ * @brief Bring the card up as raw sectors on the bus setup EARS_sdCard used
+ * @return true if the card answered
+ */
+static bool usb_msc_card_init(void)
+{
+    bool mode4bit = using_sdcard().isBus4bit();
+    int frequencyKhz = using_sdcard().getBusFrequencyKhz();
+
+    sdmmc_host_t host = SDMMC_HOST_DEFAULT();
+    host.flags = mode4bit ? SDMMC_HOST_FLAG_4BIT : SDMMC_HOST_FLAG_1BIT;
+    host.max_freq_khz = frequencyKhz > 0 ? frequencyKhz : SDMMC_FREQ_DEFAULT;
+
+    sdmmc_slot_config_t slot = SDMMC_SLOT_CONFIG_DEFAULT();
+    slot.width = mode4bit ? 4 : 1;
+    slot.clk = (gpio_num_t)SDMMC_CLK;
+    slot.cmd = (gpio_num_t)SDMMC_CMD;
+    slot.d0 = (gpio_num_t)SDMMC_D0;
+    if (mode4bit)
+    {
+        slot.d1 = (gpio_num_t)SDMMC_D1;
+        slot.d2 = (gpio_num_t)SDMMC_D2;
+        slot.d3 = (gpio_num_t)SDMMC_D3;
+    }
+    slot.flags |= SDMMC_SLOT_FLAG_INTERNAL_PULLUP;
+
+    if (sdmmc_host_init() != ESP_OK)
+    {
+        return false;
+    }
+    if (sdmmc_host_init_slot(host.slot, &slot) != ESP_OK || sdmmc_card_init(&host, &usb_msc_card) != ESP_OK)
+    {
+        sdmmc_host_deinit();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Host read: whole sectors straight from the card
+ */
+static int32_t usb_msc_on_read(uint32_t lba, uint32_t offset, void *buffer, uint32_t bufsize)
+{
+    uint32_t sectorSize = usb_msc_card.csd.sector_size;
+    if (offset != 0 || bufsize % sectorSize != 0)
+    {
+        return -1;
+    }
+
+    xSemaphoreTake(usb_msc_mutex, portMAX_DELAY);
+    esp_err_t err = usb_msc_state == USB_MSC_ACTIVE
+                        ? sdmmc_read_sectors(&usb_msc_card, buffer, lba, bufsize / sectorSize)
+                        : ESP_ERR_INVALID_STATE;
+    xSemaphoreGive(usb_msc_mutex);
+
+    if (err != ESP_OK)
+    {
+        usb_msc_stats.errors++;
+        return -1;
+    }
+    usb_msc_read_sectors += bufsize / sectorSize;
+    return bufsize;
+}
+
+/**
+ * @brief Host write: whole sectors straight to the card
+ */
+static int32_t usb_msc_on_write(uint32_t lba, uint32_t offset, uint8_t *buffer, uint32_t bufsize)
+{
+    uint32_t sectorSize = usb_msc_card.csd.sector_size;
+    if (offset != 0 || bufsize % sectorSize != 0)
+    {
+        return -1;
+    }
+
+    xSemaphoreTake(usb_msc_mutex, portMAX_DELAY);
+    esp_err_t err = usb_msc_state == USB_MSC_ACTIVE
+                        ? sdmmc_write_sectors(&usb_msc_card, buffer, lba, bufsize / sectorSize)
+                        : ESP_ERR_INVALID_STATE;
+    xSemaphoreGive(usb_msc_mutex);
+
+    if (err != ESP_OK)
+    {
+        usb_msc_stats.errors++;
+        return -1;
+    }
+    usb_msc_write_sectors += bufsize / sectorSize;
+    return bufsize;
+}
+
+/**
+ * @brief Host eject: take the card back
+ */
+static bool usb_msc_on_start_stop(uint8_t power_condition, bool start, bool load_eject)
+{
+    (void)power_condition;
+    if (load_eject && !start)
+    {
+        MAIN_usb_msc_stop();
+    }
+    return true;
+}
+
+/**
+ * @brief Unmount the card and offer it to the host
+ */
+static void usb_msc_handover(void)
+{
+    uint32_t startMs = millis();
+
+    if (!using_sdcard().isAvailable())
+    {
+        usb_msc_stats.failed++;
+        usb_msc_last_failed = true;
+        usb_msc_state = USB_MSC_IDLE;
+        DEBUG_PRINTLN("[WARN] USB MSC: no card to hand over");
+        return;
+    }
+
+    // The directory index task still reads the card: next pass
+    if (!using_sdcard().suspend())
+    {
+        return;
+    }
+
+    if (!usb_msc_card_init())
+    {
+        using_sdcard().resume();
+        usb_msc_stats.failed++;
+        usb_msc_last_failed = true;
+        usb_msc_state = USB_MSC_IDLE;
+        DEBUG_PRINTLN("[WARN] USB MSC: card did not answer, taken back");
+        return;
+    }
+
+    usb_msc_read_sectors = 0;
+    usb_msc_write_sectors = 0;
+    usb_msc_stats.errors = 0;
+    usb_msc_stats.sessions++;
+    usb_msc_stats.handoverMs = millis() - startMs;
+    usb_msc_state = USB_MSC_ACTIVE;
+
+    usb_msc.begin(usb_msc_card.csd.capacity, usb_msc_card.csd.sector_size);
+    usb_msc.mediaPresent(true);
+
+    DEBUG_PRINTF("[OK] USB MSC: %lu MB offered to the host (%lu ms)\n",
+                 (unsigned long)((uint64_t)usb_msc_card.csd.capacity * usb_msc_card.csd.sector_size >> 20),
+                 (unsigned long)usb_msc_stats.handoverMs);
+}
+
+/**
+ * @brief Withdraw the media, release the host and remount the card
+ */
+static void usb_msc_takeback(void)
+{
+    usb_msc_state = USB_MSC_STOPPING;
+    usb_msc.mediaPresent(false);
+
+    // Waits out a transfer in progress; later ones see the state and fail
+    xSemaphoreTake(usb_msc_mutex, portMAX_DELAY);
+    sdmmc_host_deinit();
+    xSemaphoreGive(usb_msc_mutex);
+
+    if (!using_sdcard().resume())
+    {
+        DEBUG_PRINTLN("[WARN] USB MSC: card not remounted yet, service keeps trying");
+    }
+    usb_msc_stop_wanted = false;
+    usb_msc_state = USB_MSC_IDLE;
+
+    DEBUG_PRINTF("[OK] USB MSC: card taken back (read %lu KB, written %lu KB)\n",
+                 (unsigned long)(usb_msc_read_sectors * usb_msc_card.csd.sector_size / 1024),
+                 (unsigned long)(usb_msc_write_sectors * usb_msc_card.csd.sector_size / 1024));
+}
+#endif
+
+/**
+ * @brief Eject on the lock screen
+ */
+static void usb_msc_eject_cb(lv_event_t *e)
+{
+    (void)e;
+    lv_obj_add_state(usb_msc_lock_eject, LV_STATE_DISABLED);
+    MAIN_usb_msc_stop();
+}
+
+/**
+ * @brief Follow the state on the lock screen; remove it once the card is back
+ */
+static void usb_msc_lock_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    MAIN_usb_msc_state_t state = usb_msc_state;
+
+    if (state == USB_MSC_IDLE)
+    {
+        lv_timer_delete(usb_msc_lock_timer);
+        usb_msc_lock_timer = NULL;
+        lv_obj_delete(usb_msc_lock);
+        usb_msc_lock = NULL;
+
+        if (usb_msc_last_failed)
+        {
+            MAIN_dialog_message("USB storage", "The SD card could not be handed to USB.", NULL, NULL);
+        }
+        return;
+    }
+
+    MAIN_usb_msc_stats_t stats;
+    MAIN_usb_msc_get_stats(&stats);
+    switch (state)
+    {
+    case USB_MSC_STARTING:
+        lv_label_set_text_static(usb_msc_lock_text, "Finishing SD card writes...");
+        break;
+    case USB_MSC_ACTIVE:
+        lv_label_set_text_fmt(usb_msc_lock_text,
+                              "Connected as a USB drive.\nEject it on the computer, then here.\n\n"
+                              "Read %lu KB, written %lu KB",
+                              (unsigned long)stats.readKB, (unsigned long)stats.writeKB);
+        break;
+    default:
+        lv_label_set_text_static(usb_msc_lock_text, "Taking the SD card back...");
+        break;
+    }
+}
+
+/**
+ * @brief Full-screen panel on lv_layer_top that takes every touch
+ */
+static void usb_msc_lock_show(void)
+{
+    usb_msc_lock = lv_obj_create(lv_layer_top());
+    lv_style_t *style = MAIN_theme_get_style(THEME_STYLE_SCREEN);
+    if (style != NULL)
+    {
+        lv_obj_add_style(usb_msc_lock, style, 0);
+    }
+    lv_obj_set_size(usb_msc_lock, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_style_bg_opa(usb_msc_lock, LV_OPA_COVER, 0);
+    lv_obj_set_flex_flow(usb_msc_lock, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(usb_msc_lock, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_remove_flag(usb_msc_lock, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(usb_msc_lock, LV_OBJ_FLAG_CLICKABLE);
+
+    lv_obj_t *title = lv_label_create(usb_msc_lock);
+    style = MAIN_theme_get_style(THEME_STYLE_ACCENT);
+    if (style != NULL)
+    {
+        lv_obj_add_style(title, style, 0);
+    }
+    lv_label_set_text_static(title, "USB storage");
+
+    usb_msc_lock_text = lv_label_create(usb_msc_lock);
+    lv_obj_set_style_text_align(usb_msc_lock_text, LV_TEXT_ALIGN_CENTER, 0);
+
+    usb_msc_lock_eject = lv_button_create(usb_msc_lock);
+    style = MAIN_theme_get_style(THEME_STYLE_BUTTON);
+    if (style != NULL)
+    {
+        lv_obj_add_style(usb_msc_lock_eject, style, 0);
+    }
+    style = MAIN_theme_get_style(THEME_STYLE_PRESSED);
+    if (style != NULL)
+    {
+        lv_obj_add_style(usb_msc_lock_eject, style, LV_STATE_PRESSED);
+    }
+    lv_obj_add_event_cb(usb_msc_lock_eject, usb_msc_eject_cb, LV_EVENT_CLICKED, NULL);
+    lv_obj_t *label = lv_label_create(usb_msc_lock_eject);
+    lv_label_set_text_static(label, "Eject");
+    lv_obj_center(label);
+
+    usb_msc_lock_timer = lv_timer_create(usb_msc_lock_timer_cb, USB_MSC_LOCK_REFRESH_MS, NULL);
+    usb_msc_lock_timer_cb(usb_msc_lock_timer);
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Register the callbacks and start the USB device, media absent
+ */
+void MAIN_initialise_usb_msc(void)
+{
+#if EARS_USB_MSC == 1
+    usb_msc_mutex = xSemaphoreCreateMutexStatic(&usb_msc_mutex_buffer);
+
+    usb_msc.vendorID(USB_MSC_VENDOR);
+    usb_msc.productID(USB_MSC_PRODUCT);
+    usb_msc.productRevision(USB_MSC_REVISION);
+    usb_msc.onRead(usb_msc_on_read);
+    usb_msc.onWrite(usb_msc_on_write);
+    usb_msc.onStartStop(usb_msc_on_start_stop);
+    usb_msc.mediaPresent(false);
+
+    // Already running when the USB CDC console started it
+    USB.begin();
+
+    DEBUG_PRINTLN("[OK] USB MSC ready, card lent on request");
+#endif
+}
+
+/**
+ * @brief Show the lock screen and ask Core 1 for the card
+ */
+bool MAIN_usb_msc_start(void)
+{
+#if EARS_USB_MSC == 1
+    if (usb_msc_state != USB_MSC_IDLE || usb_msc_lock != NULL || !using_sdcard().isAvailable())
+    {
+        return false;
+    }
+
+    usb_msc_stop_wanted = false;
+    usb_msc_last_failed = false;
+    usb_msc_state = USB_MSC_STARTING;
+    usb_msc_lock_show();
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Ask Core 1 to take the card back
+ */
+void MAIN_usb_msc_stop(void)
+{
+    if (usb_msc_state != USB_MSC_IDLE)
+    {
+        usb_msc_stop_wanted = true;
+    }
+}
+
+/**
+ * @brief Hand the card over or take it back, whichever was asked for
+ */
+void MAIN_usb_msc_service(void)
+{
+#if EARS_USB_MSC == 1
+    if (usb_msc_state == USB_MSC_STARTING)
+    {
+        usb_msc_handover();
+    }
+    else if (usb_msc_state == USB_MSC_ACTIVE && usb_msc_stop_wanted)
+    {
+        usb_msc_takeback();
+    }
+#endif
+}
+
+/**
+ * @brief Current mode
+ */
+MAIN_usb_msc_state_t MAIN_usb_msc_get_state(void)
+{
+    return usb_msc_state;
+}
+
+/**
+ * @brief Copy the counters, transfers converted to KB
+ */
+void MAIN_usb_msc_get_stats(MAIN_usb_msc_stats_t *stats)
+{
+    *stats = usb_msc_stats;
+#if EARS_USB_MSC == 1
+    stats->readKB = (uint32_t)((uint64_t)usb_msc_read_sectors * usb_msc_card.csd.sector_size / 1024);
+    stats->writeKB = (uint32_t)((uint64_t)usb_msc_write_sectors * usb_msc_card.csd.sector_size / 1024);
+#endif
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_UsbMsc_getLibraryName() {
+    return MAIN_UsbMsc::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_UsbMsc_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_UsbMsc::VERSION_MAJOR,
+                       MAIN_UsbMsc::VERSION_MINOR,
+                       MAIN_UsbMsc::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_UsbMsc_getVersionDate() {
+    return MAIN_UsbMsc::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_UsbMsc_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_UsbMsc_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+
+/******************************************************************************
+ * End of MAIN_usbMscLib.cpp
+ ******************************************************************************/
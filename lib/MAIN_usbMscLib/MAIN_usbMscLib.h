@@ -0,0 +1,164 @@
+/**
+ * @file MAIN_usbMscLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief USB mass storage mode: the SD card as a drive on the host
+ * @details Logs, reports and exports leave the device today on the card
+ *          itself or as text over Serial. With -D EARS_USB_MSC=1 (the
+ *          usb_msc environment, which switches the native USB port to the
+ *          TinyUSB stack) the card can be lent to a USB host instead, at
+ *          USB full-speed rather than 115200 baud.
+ *
+ *          A FAT volume must have one owner, so the handover is:
+ *
+ *          - MAIN_usb_msc_start() (UI task) puts a lock screen on
+ *            lv_layer_top and asks Core 1 for the card
+ *          - MAIN_usb_msc_service() (Core 1, the SD job) calls
+ *            EARS_sdCard::suspend(): pending writes are committed, handles
+ *            closed and the card unmounted. Writes from then on queue in
+ *            RAM as if the card were pulled.
+ *          - the card is brought up again as raw sectors (SDMMC host and
+ *            sdmmc_card_init, no filesystem) and the USB drive reports
+ *            media present
+ *
+ *          Eject on the host, or Eject on the lock screen, reverses it:
+ *          media gone, SDMMC host released, EARS_sdCard::resume() remounts,
+ *          replays the queued writes and rebuilds the directory index (the
+ *          host may have changed anything). The lock screen goes once the
+ *          card is back.
+ *
+ *          With EARS_USB_MSC 0 the functions are stubs that refuse to start.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_USB_MSC_LIB_H__
+#define __MAIN_USB_MSC_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <lvgl.h>
+
+#ifdef __cplusplus
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_UsbMsc
+{
+    constexpr const char* LIB_NAME = "MAIN_UsbMsc";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+// Version information getters
+const char* MAIN_UsbMsc_getLibraryName();
+uint32_t MAIN_UsbMsc_getVersionEncoded();
+const char* MAIN_UsbMsc_getVersionDate();
+void MAIN_UsbMsc_getVersionString(char* buffer);
+
+extern "C" {
+#endif
+
+/******************************************************************************
+ * USB MSC Configuration
+ *****************************************************************************/
+
+// 1 = SD card offered as a USB drive on request (needs ARDUINO_USB_MODE=0)
+#ifndef EARS_USB_MSC
+#define EARS_USB_MSC 0
+#endif
+
+#if EARS_USB_MSC == 1 && defined(ARDUINO_USB_MODE) && ARDUINO_USB_MODE == 1
+#error "EARS_USB_MSC needs the TinyUSB stack: build with ARDUINO_USB_MODE=0 (pio run -e usb_msc)"
+#endif
+
+// SCSI inquiry strings shown by the host (8, 16 and 4 characters at most)
+#define USB_MSC_VENDOR "EARS"
+#define USB_MSC_PRODUCT "SD Card"
+#define USB_MSC_REVISION "1.0"
+
+// Lock screen refresh of the state and transfer counters
+#define USB_MSC_LOCK_REFRESH_MS 500
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef enum
+{
+    USB_MSC_IDLE = 0, // Card owned by EARS_sdCard
+    USB_MSC_STARTING, // Asked for, waiting on Core 1
+    USB_MSC_ACTIVE,   // Card is a USB drive
+    USB_MSC_STOPPING  // Eject asked for, waiting on Core 1
+} MAIN_usb_msc_state_t;
+
+typedef struct
+{
+    uint32_t sessions;   // Handovers to the host
+    uint32_t failed;     // Handovers refused (no card, index busy, card init)
+    uint32_t readKB;     // Read by the host, this session
+    uint32_t writeKB;    // Written by the host, this session
+    uint32_t errors;     // Sector reads or writes that failed, this session
+    uint32_t handoverMs; // Last unmount and raw card init
+} MAIN_usb_msc_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Start the USB device with the mass storage interface, media absent
+ * @note Boot, after the SD stage. Does nothing unless EARS_USB_MSC is 1.
+ */
+void MAIN_initialise_usb_msc(void);
+
+/**
+ * @brief Lock the UI and lend the SD card to the USB host
+ * @return true if the handover was asked for (false: not built in, already
+ *         active, or no card mounted)
+ * @note UI task (EEZ action or button).
+ */
+bool MAIN_usb_msc_start(void);
+
+/**
+ * @brief Take the card back from the USB host
+ * @note Any task. The host should eject the drive first.
+ */
+void MAIN_usb_msc_stop(void);
+
+/**
+ * @brief Carry out a start or stop asked for
+ * @note Core 1, from the SD card job right after EARS_sdCard::service(),
+ *       so nothing else is using the card.
+ */
+void MAIN_usb_msc_service(void);
+
+/**
+ * @brief Current mode
+ * @return State
+ */
+MAIN_usb_msc_state_t MAIN_usb_msc_get_state(void);
+
+/**
+ * @brief USB MSC counters
+ * @param stats Receives the counters
+ */
+void MAIN_usb_msc_get_stats(MAIN_usb_msc_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MAIN_USB_MSC_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_usbMscLib.h
+ ******************************************************************************/
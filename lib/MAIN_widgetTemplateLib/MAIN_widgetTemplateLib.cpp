@@ -0,0 +1,412 @@
+/**
+ * @file MAIN_widgetTemplateLib.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Widget templates: record a built subtree once, stamp copies fast
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_widgetTemplateLib.h"
+#include "EARS_systemDef.h"
+#include "MAIN_uiTxnLib.h"
+#include <lvgl_private.h>
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef enum
+{
+    TEMPLATE_CONTENT_NONE = 0,
+    TEMPLATE_CONTENT_LABEL,     // text: label text
+    TEMPLATE_CONTENT_IMAGE      // src: image source (text: path or symbol)
+} template_content_t;
+
+typedef struct
+{
+    const lv_obj_class_t *cls;
+    int16_t parent;             // Node index, -1 for the root
+    uint16_t styleFirst;        // Into the template's style list
+    uint16_t styleCount;
+    lv_obj_flag_t flags;
+    lv_state_t state;
+#if LV_OBJ_STYLE_CACHE
+    uint32_t mainPropIsSet;
+    uint32_t otherPropIsSet;
+#endif
+    uint8_t content;
+    uint8_t longMode;
+    const void *src;
+    const char *text;
+} template_node_t;
+
+struct MAIN_widget_template_s
+{
+    uint16_t nodeCount;
+    uint16_t styleCount;
+    uint16_t localCount;
+    template_node_t *nodes;
+    lv_obj_style_t *styles;     // Every node's list, back to back
+    lv_style_t *locals;         // Copies of the prototype's local styles
+};
+
+typedef struct
+{
+    uint16_t nodes;
+    uint16_t styles;
+    uint16_t locals;
+    size_t textBytes;
+} template_size_t;
+
+/******************************************************************************
+ * Static Variables (internal to library)
+ *****************************************************************************/
+
+static MAIN_widget_template_stats_t template_stats;
+
+/******************************************************************************
+ * Private Functions
+ *****************************************************************************/
+
+/**
+ * @brief Text a node keeps (label text, image path or symbol)
+ * @return const char* Text to copy, NULL for none
+ */
+static const char *widget_template_text(lv_obj_t *obj)
+{
+    if (lv_obj_check_type(obj, &lv_label_class))
+    {
+        return lv_label_get_text(obj);
+    }
+#if LV_USE_IMAGE
+    if (lv_obj_check_type(obj, &lv_image_class))
+    {
+        const void *src = lv_image_get_src(obj);
+        if (src != NULL && lv_image_src_get_type(src) != LV_IMAGE_SRC_VARIABLE)
+        {
+            return (const char *)src;
+        }
+    }
+#endif
+    return NULL;
+}
+
+/**
+ * @brief Count what a subtree needs
+ */
+static void widget_template_measure(lv_obj_t *obj, template_size_t *size)
+{
+    size->nodes++;
+    for (uint32_t i = 0; i < obj->style_cnt; i++)
+    {
+        if (obj->styles[i].is_trans)
+        {
+            continue;
+        }
+        size->styles++;
+        if (obj->styles[i].is_local)
+        {
+            size->locals++;
+        }
+    }
+
+    const char *text = widget_template_text(obj);
+    if (text != NULL)
+    {
+        size->textBytes += strlen(text) + 1;
+    }
+
+    uint32_t children = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < children; i++)
+    {
+        widget_template_measure(lv_obj_get_child(obj, (int32_t)i), size);
+    }
+}
+
+/**
+ * @brief Record a subtree, depth first, parents before children
+ * @param text Next free byte of the template's text area (advanced)
+ */
+static void widget_template_fill(MAIN_widget_template_t *tmpl, lv_obj_t *obj, int16_t parent, char **text)
+{
+    uint16_t index = tmpl->nodeCount++;
+    template_node_t *node = &tmpl->nodes[index];
+
+    node->cls = obj->class_p;
+    node->parent = parent;
+    node->flags = obj->flags;
+    node->state = obj->state;
+#if LV_OBJ_STYLE_CACHE
+    node->mainPropIsSet = obj->style_main_prop_is_set;
+    node->otherPropIsSet = obj->style_other_prop_is_set;
+#endif
+
+    // Same order, so the same precedence; local styles turn into shared copies
+    node->styleFirst = tmpl->styleCount;
+    for (uint32_t i = 0; i < obj->style_cnt; i++)
+    {
+        if (obj->styles[i].is_trans)
+        {
+            continue;
+        }
+        lv_obj_style_t *entry = &tmpl->styles[tmpl->styleCount++];
+        *entry = obj->styles[i];
+        if (entry->is_local)
+        {
+            lv_style_t *copy = &tmpl->locals[tmpl->localCount++];
+            lv_style_init(copy);
+            lv_style_copy(copy, obj->styles[i].style);
+            entry->style = copy;
+            entry->is_local = 0;
+        }
+    }
+    node->styleCount = tmpl->styleCount - node->styleFirst;
+
+    node->content = TEMPLATE_CONTENT_NONE;
+    node->src = NULL;
+    node->text = NULL;
+    const char *source = widget_template_text(obj);
+    if (source != NULL)
+    {
+        strcpy(*text, source);
+        node->text = *text;
+        *text += strlen(source) + 1;
+    }
+    if (lv_obj_check_type(obj, &lv_label_class))
+    {
+        node->content = TEMPLATE_CONTENT_LABEL;
+        node->longMode = (uint8_t)lv_label_get_long_mode(obj);
+    }
+#if LV_USE_IMAGE
+    else if (lv_obj_check_type(obj, &lv_image_class))
+    {
+        node->content = TEMPLATE_CONTENT_IMAGE;
+        node->src = node->text != NULL ? node->text : lv_image_get_src(obj);
+    }
+#endif
+
+    uint32_t children = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < children; i++)
+    {
+        widget_template_fill(tmpl, lv_obj_get_child(obj, (int32_t)i), (int16_t)index, text);
+    }
+}
+
+/**
+ * @brief Give a new object the node's style list in one allocation
+ */
+static void widget_template_link_styles(const MAIN_widget_template_t *tmpl, const template_node_t *node, lv_obj_t *obj)
+{
+    // Drop what the constructor and the theme added (refresh is off: no redraw)
+    lv_obj_remove_style_all(obj);
+    if (node->styleCount == 0)
+    {
+        return;
+    }
+
+    obj->styles = (lv_obj_style_t *)lv_malloc(node->styleCount * sizeof(lv_obj_style_t));
+    LV_ASSERT_MALLOC(obj->styles);
+    if (obj->styles == NULL)
+    {
+        return;
+    }
+    lv_memcpy(obj->styles, &tmpl->styles[node->styleFirst], node->styleCount * sizeof(lv_obj_style_t));
+    obj->style_cnt = node->styleCount;
+#if LV_OBJ_STYLE_CACHE
+    obj->style_main_prop_is_set = node->mainPropIsSet;
+    obj->style_other_prop_is_set = node->otherPropIsSet;
+#endif
+}
+
+/******************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Record a prototype and its descendants
+ */
+MAIN_widget_template_t *MAIN_widget_template_record(lv_obj_t *prototype)
+{
+    if (prototype == NULL)
+    {
+        return NULL;
+    }
+
+    uint32_t startUs = micros();
+    template_size_t size = {0, 0, 0, 0};
+    widget_template_measure(prototype, &size);
+    if (size.nodes > WIDGET_TEMPLATE_MAX_NODES)
+    {
+#if EARS_DEBUG == 1
+        Serial.printf("[WTMPL] ERROR: %u objects, limit %u\n", size.nodes, WIDGET_TEMPLATE_MAX_NODES);
+#endif
+        return NULL;
+    }
+
+    // Header, nodes, style lists, local copies and text in one block
+    size_t bytes = sizeof(MAIN_widget_template_t) + size.nodes * sizeof(template_node_t) +
+                   size.styles * sizeof(lv_obj_style_t) + size.locals * sizeof(lv_style_t) + size.textBytes;
+    uint8_t *block = (uint8_t *)lv_malloc(bytes);
+    if (block == NULL)
+    {
+        return NULL;
+    }
+
+    MAIN_widget_template_t *tmpl = (MAIN_widget_template_t *)block;
+    block += sizeof(MAIN_widget_template_t);
+    tmpl->nodes = (template_node_t *)block;
+    block += size.nodes * sizeof(template_node_t);
+    tmpl->styles = (lv_obj_style_t *)block;
+    block += size.styles * sizeof(lv_obj_style_t);
+    tmpl->locals = (lv_style_t *)block;
+    block += size.locals * sizeof(lv_style_t);
+    char *text = (char *)block;
+
+    tmpl->nodeCount = 0;
+    tmpl->styleCount = 0;
+    tmpl->localCount = 0;
+    widget_template_fill(tmpl, prototype, -1, &text);
+
+    template_stats.templates++;
+    uint32_t recordUs = micros() - startUs;
+    template_stats.recordUs += recordUs;
+
+#if EARS_DEBUG == 1
+    Serial.printf("[WTMPL] Recorded %u objects, %u styles (%u local) in %lu us\n", tmpl->nodeCount,
+                  tmpl->styleCount, tmpl->localCount, (unsigned long)recordUs);
+#endif
+    return tmpl;
+}
+
+/**
+ * @brief Create a copy of the recorded tree
+ */
+lv_obj_t *MAIN_widget_template_stamp(const MAIN_widget_template_t *tmpl, lv_obj_t *parent)
+{
+    if (tmpl == NULL || tmpl->nodeCount == 0)
+    {
+        return NULL;
+    }
+
+    uint32_t startUs = micros();
+    lv_obj_t *objs[WIDGET_TEMPLATE_MAX_NODES];
+
+    MAIN_ui_txn_begin();
+    lv_obj_enable_style_refresh(false);
+
+    for (uint16_t i = 0; i < tmpl->nodeCount; i++)
+    {
+        const template_node_t *node = &tmpl->nodes[i];
+        lv_obj_t *obj = lv_obj_class_create_obj(node->cls, node->parent < 0 ? parent : objs[node->parent]);
+        lv_obj_class_init_obj(obj);
+        objs[i] = obj;
+
+        widget_template_link_styles(tmpl, node, obj);
+
+        lv_obj_flag_t add = (lv_obj_flag_t)(node->flags & ~obj->flags);
+        lv_obj_flag_t remove = (lv_obj_flag_t)(obj->flags & ~node->flags);
+        if (remove != 0)
+        {
+            lv_obj_remove_flag(obj, remove);
+        }
+        if (add != 0)
+        {
+            lv_obj_add_flag(obj, add);
+        }
+        if (node->state != obj->state)
+        {
+            lv_obj_set_state(obj, (lv_state_t)(obj->state & ~node->state), false);
+            lv_obj_set_state(obj, node->state, true);
+        }
+
+        if (node->content == TEMPLATE_CONTENT_LABEL)
+        {
+            lv_label_set_long_mode(obj, (lv_label_long_mode_t)node->longMode);
+            lv_label_set_text(obj, node->text != NULL ? node->text : "");
+        }
+#if LV_USE_IMAGE
+        else if (node->content == TEMPLATE_CONTENT_IMAGE && node->src != NULL)
+        {
+            lv_image_set_src(obj, node->src);
+        }
+#endif
+    }
+
+    // The one refresh: what each add/set would have done, for the whole tree
+    lv_obj_enable_style_refresh(true);
+    for (uint16_t i = 0; i < tmpl->nodeCount; i++)
+    {
+        lv_obj_update_layer_type(objs[i]);
+        lv_obj_refresh_ext_draw_size(objs[i]);
+    }
+    lv_obj_refresh_style(objs[0], LV_PART_ANY, LV_STYLE_PROP_ANY);
+
+    MAIN_ui_txn_commit(parent);
+
+    template_stats.stamps++;
+    template_stats.objects += tmpl->nodeCount;
+    template_stats.stampUs += micros() - startUs;
+    return objs[0];
+}
+
+/**
+ * @brief Free a template
+ */
+void MAIN_widget_template_free(MAIN_widget_template_t *tmpl)
+{
+    if (tmpl == NULL)
+    {
+        return;
+    }
+
+    for (uint16_t i = 0; i < tmpl->localCount; i++)
+    {
+        lv_style_reset(&tmpl->locals[i]);
+    }
+    lv_free(tmpl);
+    template_stats.templates--;
+}
+
+/**
+ * @brief Template counters
+ */
+void MAIN_widget_template_get_stats(MAIN_widget_template_stats_t *stats)
+{
+    *stats = template_stats;
+}
+
+/******************************************************************************
+ * Library Version Information Getters
+ *****************************************************************************/
+
+// Get library name
+const char* MAIN_WidgetTemplate_getLibraryName() {
+    return MAIN_WidgetTemplate::LIB_NAME;
+}
+
+// Get encoded version as integer
+uint32_t MAIN_WidgetTemplate_getVersionEncoded() {
+    return VERS_ENCODE(MAIN_WidgetTemplate::VERSION_MAJOR,
+                       MAIN_WidgetTemplate::VERSION_MINOR,
+                       MAIN_WidgetTemplate::VERSION_PATCH);
+}
+
+// Get version date
+const char* MAIN_WidgetTemplate_getVersionDate() {
+    return MAIN_WidgetTemplate::VERSION_DATE;
+}
+
+// Format version as string
+void MAIN_WidgetTemplate_getVersionString(char* buffer) {
+    uint32_t encoded = MAIN_WidgetTemplate_getVersionEncoded();
+    VERS_FORMAT(encoded, buffer);
+}
+
+/******************************************************************************
+ * End of MAIN_widgetTemplateLib.cpp
+ ******************************************************************************/
@@ -0,0 +1,135 @@
+/**
+ * @file MAIN_widgetTemplateLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Widget templates: record a built subtree once, stamp copies fast
+ * @details The EEZ create_screen_* code (and any hand-built row or card)
+ *          makes each object call by call: create, set_pos, set_size,
+ *          remove_flag, add_style, set_style_*. Every one of those reallocs
+ *          the object's style list or its local style and refreshes the
+ *          style (invalidate, layout dirty, ext draw size, children), so a
+ *          row of three objects costs some thirty refreshes.
+ *
+ *          MAIN_widget_template_record() walks a prototype built the normal
+ *          way and keeps, per object, its class, flags, state and style
+ *          list; local styles become shared copies owned by the template,
+ *          and label text, long mode and image source are kept too. It
+ *          all goes in one allocation.
+ *
+ *          MAIN_widget_template_stamp() creates the same tree with style
+ *          refresh switched off: each object gets its whole style list in
+ *          one allocation, already linked to the shared styles, and the
+ *          new tree is refreshed once at the end, inside a UI transaction
+ *          (MAIN_uiTxnLib). Instances carry no local styles of their own
+ *          until something is set on them.
+ *
+ *          Not copied: event callbacks, user data, and widget state other
+ *          than label text and image source (a slider's value, a textarea's
+ *          text). Set those on the instance after stamping. Instances point
+ *          at the template's styles, so free a template only once every
+ *          instance is deleted.
+ *
+ *          C callable for EEZ user widgets in src/ui. UI task only.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __MAIN_WIDGET_TEMPLATE_LIB_H__
+#define __MAIN_WIDGET_TEMPLATE_LIB_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <lvgl.h>
+
+#ifdef __cplusplus
+#include <Arduino.h>
+#include "EARS_versionDef.h"
+
+/******************************************************************************
+ * Library Version Information
+ *****************************************************************************/
+namespace MAIN_WidgetTemplate
+{
+    constexpr const char* LIB_NAME = "MAIN_WidgetTemplate";
+    constexpr const char* VERSION_MAJOR = "1";
+    constexpr const char* VERSION_MINOR = "0";
+    constexpr const char* VERSION_PATCH = "0";
+    constexpr const char* VERSION_DATE = "2026-10-15";
+}
+
+
+// Version information getters
+const char* MAIN_WidgetTemplate_getLibraryName();
+uint32_t MAIN_WidgetTemplate_getVersionEncoded();
+const char* MAIN_WidgetTemplate_getVersionDate();
+void MAIN_WidgetTemplate_getVersionString(char* buffer);
+
+extern "C" {
+#endif
+
+/******************************************************************************
+ * Widget Template Configuration
+ *****************************************************************************/
+
+// Objects in one template (the prototype and all its descendants)
+#define WIDGET_TEMPLATE_MAX_NODES 48
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct MAIN_widget_template_s MAIN_widget_template_t;
+
+typedef struct
+{
+    uint16_t templates;         // Templates alive
+    uint32_t stamps;            // Instances stamped
+    uint32_t objects;           // Objects created by stamping
+    uint32_t recordUs;          // Time spent recording
+    uint32_t stampUs;           // Time spent stamping
+} MAIN_widget_template_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+
+/**
+ * @brief Record a prototype and its descendants
+ * @param prototype Built object (left as it is; keep it or delete it)
+ * @return MAIN_widget_template_t* Template, NULL if too large or out of memory
+ */
+MAIN_widget_template_t *MAIN_widget_template_record(lv_obj_t *prototype);
+
+/**
+ * @brief Create a copy of the recorded tree
+ * @param tmpl Template
+ * @param parent Parent of the new root
+ * @return lv_obj_t* New root; its descendants are in the prototype's order
+ *         (lv_obj_get_child), NULL if tmpl is NULL
+ */
+lv_obj_t *MAIN_widget_template_stamp(const MAIN_widget_template_t *tmpl, lv_obj_t *parent);
+
+/**
+ * @brief Free a template
+ * @param tmpl Template (every instance must be deleted already)
+ */
+void MAIN_widget_template_free(MAIN_widget_template_t *tmpl);
+
+/**
+ * @brief Template counters
+ * @param stats Receives the counters
+ */
+void MAIN_widget_template_get_stats(MAIN_widget_template_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MAIN_WIDGET_TEMPLATE_LIB_H__
+
+/******************************************************************************
+ * End of MAIN_widgetTemplateLib.h
+ ******************************************************************************/
@@ -0,0 +1,25 @@
+/* ThorVG build configuration for LVGL's bundled copy. Upstream ThorVG
+ * generates this file from meson options; LVGL ships it pre-made.
+ * It is force-added because lib/lvgl/.gitignore ignores config.h. */
+#ifndef THORVG_CONFIG_H
+#define THORVG_CONFIG_H
+
+#include "../../lv_conf_internal.h"
+
+#if LV_USE_THORVG_INTERNAL
+
+#define THORVG_SW_RASTER_SUPPORT
+
+#if LV_USE_SVG
+#define THORVG_SVG_LOADER_SUPPORT
+#endif
+
+#if LV_USE_LOTTIE
+#define THORVG_LOTTIE_LOADER_SUPPORT
+#endif
+
+#define THORVG_VERSION_STRING "0.15.3"
+
+#endif /* LV_USE_THORVG_INTERNAL */
+
+#endif /* THORVG_CONFIG_H */
@@ -0,0 +1,146 @@
+"""
+Asset Pack Builder
+Packs LVGL binary images (scripts/convert_images.py output), binary fonts
+(lv_font_conv --format bin) and language packs (scripts/generate_lang_packs.py
+output, entries "lang_<code>") into one image for the "assets" flash partition,
+which the firmware memory-maps at boot (MAIN_assetPackLib). The EEZ Flow
+assets blob from src/ui/ui.c is added as the raw entry "eez_assets", used
+in place by builds with -D EEZ_FLOW_ASSETS_FROM_PACK=1
+Run on the host: python scripts/build_asset_pack.py [--flash] [--port COM9]
+"""
+
+import argparse
+import csv
+import re
+import struct
+import subprocess
+import sys
+import zlib
+from pathlib import Path
+
+# Sources: directory -> entry type (MAIN_asset_type_t)
+SOURCES = [
+    ("data/images", 1),  # ASSET_TYPE_IMAGE: LVGL .bin image
+    ("assets/fonts", 2), # ASSET_TYPE_FONT: lv_binfont file
+    ("assets/lang", 0),  # ASSET_TYPE_RAW: language pack (scripts/generate_lang_packs.py)
+]
+EEZ_UI_FILE = "src/ui/ui.c"
+EEZ_ENTRY_NAME = "eez_assets"
+OUTPUT_FILE = ".pio/assets/assets.bin"
+PARTITIONS_FILE = "partitions_ears.csv"
+PARTITION_NAME = "assets"
+
+# Layout shared with MAIN_assetPackLib.h
+MAGIC = b"EARSPAK1"
+VERSION = 1
+HEADER = struct.Struct("<8sIIII8x")   # magic, version, count, totalSize, crc32 (32 bytes)
+ENTRY = struct.Struct("<24sB3xII")    # name, type, offset, size (36 bytes)
+NAME_LEN = 24
+DATA_ALIGN = 16
+
+
+def align(value, to=DATA_ALIGN):
+    return (value + to - 1) & ~(to - 1)
+
+
+def find_partition(csv_file, name):
+    """Return (offset, size) of a partition in the CSV table"""
+    with open(csv_file, newline='', encoding='utf-8') as f:
+        rows = [r for r in csv.reader(line for line in f if not line.lstrip().startswith('#'))]
+    for row in rows:
+        fields = [c.strip() for c in row]
+        if fields and fields[0] == name:
+            return int(fields[3], 0), int(fields[4], 0)
+    raise ValueError(f"partition '{name}' not in {csv_file}")
+
+
+def read_eez_assets(ui_file):
+    """Bytes of the generated 'const uint8_t assets[N] = { ... }' array, or None"""
+    path = Path(ui_file)
+    if not path.is_file():
+        return None
+    match = re.search(r"const\s+uint8_t\s+assets\[(\d+)\]\s*=\s*\{([^}]*)\}", path.read_text(encoding="utf-8"))
+    if not match:
+        return None
+    data = bytes(int(value, 0) for value in match.group(2).replace("\n", " ").split(",") if value.strip())
+    if len(data) != int(match.group(1)):
+        print(f"✗ ERROR: {ui_file} assets[] holds {len(data)} of {match.group(1)} bytes")
+        return None
+    return data
+
+
+def build_asset_pack(output_file, max_size):
+    """Collect sources and write the pack, return its size"""
+
+    print("=" * 70)
+    print("  ASSET PACK BUILDER")
+    print("=" * 70)
+
+    files = []
+    for directory, entry_type in SOURCES:
+        source = Path(directory)
+        if not source.is_dir():
+            print(f"  (skipped {directory}: not found)")
+            continue
+        for path in sorted(source.glob("*.bin")):
+            name = path.stem
+            if len(name.encode()) >= NAME_LEN:
+                print(f"✗ ERROR: name too long (max {NAME_LEN - 1}): {name}")
+                return 0
+            files.append((name, entry_type, path.read_bytes()))
+
+    eez_assets = read_eez_assets(EEZ_UI_FILE)
+    if eez_assets is None:
+        print(f"  (skipped {EEZ_ENTRY_NAME}: no assets[] in {EEZ_UI_FILE})")
+    else:
+        files.append((EEZ_ENTRY_NAME, 0, eez_assets))
+
+    table_end = HEADER.size + ENTRY.size * len(files)
+    offset = align(table_end)
+    entries = bytearray()
+    blobs = bytearray(offset - table_end)
+
+    for name, entry_type, data in files:
+        entries += ENTRY.pack(name.encode(), entry_type, offset, len(data))
+        padded = align(len(data))
+        blobs += data + bytes(padded - len(data))
+        print(f"✓ {name}: {len(data)} bytes at 0x{offset:06x} ({('raw', 'image', 'font')[entry_type]})")
+        offset += padded
+
+    body = bytes(entries) + bytes(blobs)
+    total = HEADER.size + len(body)
+    if total > max_size:
+        print(f"✗ ERROR: pack is {total} bytes, partition holds {max_size}")
+        return 0
+
+    header = HEADER.pack(MAGIC, VERSION, len(files), total, zlib.crc32(body) & 0xFFFFFFFF)
+
+    output = Path(output_file)
+    output.parent.mkdir(parents=True, exist_ok=True)
+    output.write_bytes(header + body)
+    print(f"✓ Pack: {output_file} ({len(files)} entries, {total} of {max_size} bytes)")
+    print("=" * 70)
+    return total
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build the assets partition image")
+    parser.add_argument("--output", default=OUTPUT_FILE, help="Pack file to write")
+    parser.add_argument("--flash", action="store_true", help="Write the pack with esptool")
+    parser.add_argument("--port", default="COM9", help="Serial port for --flash")
+    args = parser.parse_args()
+
+    offset, size = find_partition(PARTITIONS_FILE, PARTITION_NAME)
+    if not build_asset_pack(args.output, size):
+        sys.exit(1)
+
+    if args.flash:
+        # Only the asset partition is written; the app is untouched
+        subprocess.run([sys.executable, "-m", "esptool", "--chip", "esp32s3", "--port", args.port,
+                        "write_flash", f"0x{offset:x}", args.output], check=True)
+    else:
+        print(f"  Flash with: python -m esptool --chip esp32s3 write_flash 0x{offset:x} {args.output}")
+
+
+if __name__ == "__main__":
+    main()
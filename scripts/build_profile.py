@@ -0,0 +1,165 @@
+# ==============================================================================
+# Build Profile Script for PlatformIO
+# ==============================================================================
+# Description: Applies an environment's performance options and records the
+#              size of its firmware:
+#              - custom_hot_opt: optimisation level (e.g. -O2) for sources
+#                under custom_hot_paths; everything else keeps the
+#                framework's -Os
+#              - custom_lto = yes: link-time optimisation of the project and
+#                its libraries (set lib_archive = no with it, so the linker
+#                sees the LTO objects rather than archives of them)
+#
+#              After the link, flash, IRAM and DRAM use is written to
+#              size_summary.json in the build directory and compared with
+#              the summaries of the other environments already built.
+#              Speed is compared on the target: see compare_bench.py.
+#
+# Author:      Auto-generated for EARS Project
+# Version:     1.0.0
+# ==============================================================================
+
+Import("env")  # type: ignore
+import glob
+import json
+import os
+import subprocess
+
+SUMMARY_FILE = "size_summary.json"
+
+
+def print_banner(message):
+    """Print a visible banner message"""
+    banner = "=" * 70
+    print(f"\n{banner}")
+    print(f"  {message}")
+    print(f"{banner}\n")
+
+
+def option(name, default=""):
+    """Project option of the current environment"""
+    return env.GetProjectOption(name, default)
+
+
+def is_yes(value):
+    return str(value).strip().lower() in ("yes", "true", "1")
+
+
+# ============================================================================
+# HOT PATH OPTIMISATION
+# ============================================================================
+hot_opt = option("custom_hot_opt").strip()
+hot_paths = [path.strip().replace("\\", "/") for path in option("custom_hot_paths").split() if path.strip()]
+
+
+def without_opt_level(flags):
+    """Flags with any -O level removed"""
+    return [flag for flag in flags if not (isinstance(flag, str) and flag.startswith("-O"))]
+
+
+def optimise_hot(build_env, node):
+    """Compile sources under the hot paths at hot_opt"""
+    path = node.srcnode().get_abspath().replace("\\", "/")
+    if not any("/" + hot + "/" in path for hot in hot_paths):
+        return node
+    return build_env.Object(
+        node,
+        CCFLAGS=without_opt_level(build_env.get("CCFLAGS", [])) + [hot_opt],
+        CFLAGS=without_opt_level(build_env.get("CFLAGS", [])),
+        CXXFLAGS=without_opt_level(build_env.get("CXXFLAGS", [])),
+    )
+
+
+if hot_opt and hot_paths:
+    env.AddBuildMiddleware(optimise_hot, "*")
+
+# ============================================================================
+# LINK-TIME OPTIMISATION
+# ============================================================================
+lto = is_yes(option("custom_lto", "no"))
+if lto:
+    env.Append(CCFLAGS=["-flto"], LINKFLAGS=["-flto"])
+
+if hot_opt or lto:
+    print_banner("Build Profile")
+    print(f"  Hot paths at {hot_opt or 'default'}: {', '.join(hot_paths) or 'none'}")
+    print(f"  Link-time optimisation: {'on' if lto else 'off'}")
+    if lto and is_yes(option("lib_archive", "yes")):
+        print("  WARNING: custom_lto needs lib_archive = no")
+    print()
+
+
+# ============================================================================
+# SIZE SUMMARY
+# ============================================================================
+def toolchain_tool(name):
+    """Path of a binutils tool next to the compiler"""
+    cc = env.subst("$CC")
+    if cc.endswith("gcc"):
+        return cc[:-3] + name
+    return name
+
+
+def size_summary(elf):
+    """Flash, IRAM and DRAM bytes of the firmware from size -A"""
+    output = subprocess.check_output([toolchain_tool("size"), "-A", "-d", elf], text=True)
+    summary = {"flash": 0, "iram": 0, "dram": 0}
+    for line in output.splitlines():
+        parts = line.split()
+        if len(parts) != 3 or not parts[1].isdigit():
+            continue
+        name, size = parts[0], int(parts[1])
+        if name.startswith(".flash"):
+            summary["flash"] += size
+        elif name.startswith(".iram0"):
+            summary["iram"] += size
+        elif name.startswith(".dram0"):
+            summary["dram"] += size
+    return summary
+
+
+def percent(value, reference):
+    if not reference:
+        return ""
+    return f"{(value - reference) * 100.0 / reference:+.1f}%"
+
+
+def size_report(source, target, env):
+    """Record this environment's sizes and compare them with the others"""
+    elf = str(target[0])
+    build_dir = env.subst("$BUILD_DIR")
+    this_env = env.subst("$PIOENV")
+
+    try:
+        summary = size_summary(elf)
+    except (OSError, subprocess.CalledProcessError) as error:
+        print(f"  Size summary skipped: {error}")
+        return
+
+    summary["hot_opt"] = hot_opt
+    summary["hot_paths"] = hot_paths
+    summary["lto"] = lto
+    with open(os.path.join(build_dir, SUMMARY_FILE), "w") as file:
+        json.dump(summary, file, indent=2)
+
+    print_banner(f"Size Comparison ({this_env})")
+    print(f"  {'environment':<20} {'flash':>10} {'iram':>10} {'dram':>10}")
+    print(f"  {this_env:<20} {summary['flash']:>10} {summary['iram']:>10} {summary['dram']:>10}")
+
+    for path in sorted(glob.glob(os.path.join(os.path.dirname(build_dir), "*", SUMMARY_FILE))):
+        other_env = os.path.basename(os.path.dirname(path))
+        if other_env == this_env:
+            continue
+        try:
+            with open(path) as file:
+                other = json.load(file)
+        except (OSError, ValueError):
+            continue
+        print(f"  {other_env:<20} {other['flash']:>10} {other['iram']:>10} {other['dram']:>10}"
+              f"   this build: flash {percent(summary['flash'], other['flash'])},"
+              f" iram {percent(summary['iram'], other['iram'])},"
+              f" dram {percent(summary['dram'], other['dram'])}")
+    print()
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", size_report)
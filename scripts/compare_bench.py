@@ -0,0 +1,57 @@
+"""
+Benchmark Comparison
+Compares two builds' rows of the MAIN_benchmark results file (/bench/results.csv)
+Run on the host: python scripts/compare_bench.py results.csv [BASE_BUILD NEW_BUILD]
+Without build stamps the last two builds in the file are compared, so flash
+the development benchmark, then the production benchmark, and run both.
+"""
+
+import csv
+import sys
+from pathlib import Path
+
+
+def read_runs(path):
+    """Rows grouped by build stamp, in file order; the last run of a test wins"""
+    runs = {}
+    with Path(path).open(newline="") as file:
+        for row in csv.DictReader(file):
+            runs.setdefault(row["build"], {})[row["test"]] = row
+    return runs
+
+
+def main():
+    if len(sys.argv) not in (2, 4):
+        print(__doc__.strip(), file=sys.stderr)
+        return 1
+
+    runs = read_runs(sys.argv[1])
+    if len(sys.argv) == 4:
+        base, new = sys.argv[2], sys.argv[3]
+    elif len(runs) >= 2:
+        base, new = list(runs)[-2:]
+    else:
+        print("Need two builds in the results file", file=sys.stderr)
+        return 1
+
+    for build in (base, new):
+        if build not in runs:
+            print(f"Build {build} not in the results file", file=sys.stderr)
+            return 1
+
+    print(f"base {base} ({next(iter(runs[base].values()))['version']}), "
+          f"new {new} ({next(iter(runs[new].values()))['version']})")
+    print(f"{'test':<24} {'base us/op':>12} {'new us/op':>12} {'change':>9}")
+    for test, row in runs[base].items():
+        other = runs[new].get(test)
+        if other is None:
+            continue
+        before = float(row["per_op_us"])
+        after = float(other["per_op_us"])
+        change = f"{(after - before) * 100.0 / before:+.1f}%" if before else ""
+        print(f"{test:<24} {before:>12.1f} {after:>12.1f} {change:>9}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,192 @@
+"""
+Image Asset Converter
+Converts the source images under "Development Images/Processed" into LVGL 9
+native binary images (.bin, RGB565 or RGB565A8, optionally RLE compressed)
+plus a manifest.json, ready to copy to the SD card /images directory
+Run on the host: python scripts/convert_images.py [--compress] [--format auto|rgb565|rgb565a8]
+Needs Pillow, and for SVG sources cairosvg or rsvg-convert or inkscape
+"""
+
+import argparse
+import io
+import json
+import shutil
+import struct
+import subprocess
+import sys
+from pathlib import Path
+
+SOURCE_DIR = "Development Images/Processed"
+OUTPUT_DIR = "data/images"
+NAME_PREFIX = "no_padding_"  # Dropped from file names
+
+# lv_image_header_t / lv_image_compressed_t (lv_image_dsc.h, lv_bin_decoder.c)
+LV_IMAGE_HEADER_MAGIC = 0x19
+LV_COLOR_FORMAT_RGB565 = 0x12
+LV_COLOR_FORMAT_RGB565A8 = 0x14
+LV_IMAGE_FLAGS_COMPRESSED = 0x0008
+LV_IMAGE_COMPRESS_RLE = 1
+
+FORMAT_NAMES = {LV_COLOR_FORMAT_RGB565: "RGB565", LV_COLOR_FORMAT_RGB565A8: "RGB565A8"}
+SOURCE_TYPES = (".svg", ".png", ".jpg", ".jpeg", ".bmp")
+
+
+def load_rgba(path):
+    """Rasterise or load an image as a Pillow RGBA image"""
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit("✗ ERROR: Pillow is required (pip install pillow)")
+
+    if path.suffix.lower() != ".svg":
+        return Image.open(path).convert("RGBA")
+
+    # SVG: first rasteriser found wins
+    try:
+        import cairosvg
+        return Image.open(io.BytesIO(cairosvg.svg2png(url=str(path)))).convert("RGBA")
+    except ImportError:
+        pass
+
+    if shutil.which("rsvg-convert"):
+        png = subprocess.run(["rsvg-convert", str(path)], check=True, capture_output=True).stdout
+        return Image.open(io.BytesIO(png)).convert("RGBA")
+
+    if shutil.which("inkscape"):
+        png = subprocess.run(["inkscape", str(path), "--export-type=png", "--export-filename=-"],
+                             check=True, capture_output=True).stdout
+        return Image.open(io.BytesIO(png)).convert("RGBA")
+
+    raise RuntimeError("no SVG rasteriser (install cairosvg, rsvg-convert or inkscape)")
+
+
+def to_lvgl(image, fmt):
+    """Pixel data in LVGL layout, returns (cf, stride, data)"""
+    width, height = image.size
+    pixels = list(image.getdata())
+
+    if fmt == "auto":
+        fmt = "rgb565a8" if any(a < 255 for _, _, _, a in pixels) else "rgb565"
+
+    colour = bytearray()
+    for r, g, b, _ in pixels:
+        colour += struct.pack("<H", ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3))
+
+    if fmt == "rgb565":
+        return LV_COLOR_FORMAT_RGB565, width * 2, bytes(colour)
+
+    # RGB565A8: colour plane followed by an 8-bit alpha plane
+    alpha = bytes(a for _, _, _, a in pixels)
+    return LV_COLOR_FORMAT_RGB565A8, width * 2, bytes(colour) + alpha
+
+
+def rle_compress(data, block):
+    """LVGL RLE (lv_rle.c): ctrl < 0x80 repeats the next block ctrl times,
+    ctrl >= 0x80 copies (ctrl & 0x7F) literal blocks"""
+    blocks = [data[i:i + block] for i in range(0, len(data), block)]
+    out = bytearray()
+    i = 0
+    while i < len(blocks):
+        run = 1
+        while i + run < len(blocks) and run < 127 and blocks[i + run] == blocks[i]:
+            run += 1
+        if run >= 2:
+            out.append(run)
+            out += blocks[i]
+            i += run
+            continue
+
+        start = i
+        while i < len(blocks) and i - start < 127:
+            if i + 1 < len(blocks) and blocks[i + 1] == blocks[i]:
+                break
+            i += 1
+        out.append(0x80 | (i - start))
+        for b in blocks[start:i]:
+            out += b
+    return bytes(out)
+
+
+def build_bin(width, height, cf, stride, data, compress):
+    """Assemble an LVGL .bin file, returns (bytes, compressed)"""
+    flags = 0
+    payload = data
+
+    if compress:
+        packed = rle_compress(data, 2)  # RGB565 and RGB565A8 compress in 2-byte blocks
+        if len(packed) + 12 < len(data):
+            flags |= LV_IMAGE_FLAGS_COMPRESSED
+            payload = struct.pack("<III", LV_IMAGE_COMPRESS_RLE, len(packed), len(data)) + packed
+
+    header = struct.pack("<BBHHHHH", LV_IMAGE_HEADER_MAGIC, cf, flags, width, height, stride, 0)
+    return header + payload, bool(flags & LV_IMAGE_FLAGS_COMPRESSED)
+
+
+def convert_images(source_dir, output_dir, fmt, compress):
+    """Convert every source image and write the manifest"""
+
+    print("=" * 70)
+    print("  IMAGE ASSET CONVERTER")
+    print("=" * 70)
+
+    source = Path(source_dir)
+    if not source.is_dir():
+        print(f"✗ ERROR: {source_dir} not found")
+        return False
+
+    output = Path(output_dir)
+    output.mkdir(parents=True, exist_ok=True)
+
+    entries = []
+    for path in sorted(p for p in source.iterdir() if p.suffix.lower() in SOURCE_TYPES):
+        name = path.stem
+        if name.startswith(NAME_PREFIX):
+            name = name[len(NAME_PREFIX):]
+
+        try:
+            image = load_rgba(path)
+        except Exception as e:
+            print(f"✗ ERROR: {path.name}: {e}")
+            continue
+
+        cf, stride, data = to_lvgl(image, fmt)
+        width, height = image.size
+        blob, packed = build_bin(width, height, cf, stride, data, compress)
+
+        file_name = f"{name}.bin"
+        (output / file_name).write_bytes(blob)
+        entries.append({
+            "name": name,
+            "file": file_name,
+            "w": width,
+            "h": height,
+            "cf": FORMAT_NAMES[cf],
+            "size": len(blob),
+            "compressed": packed,
+        })
+        print(f"✓ {file_name}: {width}x{height} {FORMAT_NAMES[cf]}, {len(blob)} bytes"
+              f"{' (RLE)' if packed else ''}")
+
+    manifest = {"version": 1, "images": entries}
+    (output / "manifest.json").write_text(json.dumps(manifest, indent=2) + "\n", encoding="utf-8")
+    print(f"✓ Manifest: {output / 'manifest.json'} ({len(entries)} images)")
+    print(f"  Copy {output_dir}/ to the SD card as /images")
+    print("=" * 70)
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert images to LVGL binary assets")
+    parser.add_argument("--source", default=SOURCE_DIR, help="Source image directory")
+    parser.add_argument("--output", default=OUTPUT_DIR, help="Output directory (SD /images)")
+    parser.add_argument("--format", default="auto", choices=["auto", "rgb565", "rgb565a8"],
+                        help="auto picks RGB565A8 only for images with transparency")
+    parser.add_argument("--compress", action="store_true", help="RLE compress when smaller")
+    args = parser.parse_args()
+
+    if not convert_images(args.source, args.output, args.format, args.compress):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
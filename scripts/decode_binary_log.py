@@ -0,0 +1,170 @@
+"""
+Binary Log Decoder
+Converts EARS_logger binary log files (logger "binary": true) back into text
+Run on the host: python scripts/decode_binary_log.py debug.log [debug.log.1 ...]
+Compressed rotated files (debug.log.2.hs) are expanded first
+"""
+
+import re
+import struct
+import sys
+from pathlib import Path
+
+from decompress_log import SUFFIX, decompress
+
+MAGIC = b"EARSBLG1"
+HEADER = struct.Struct("<BBHII")  # type, level, length, timestampMs, formatId
+
+REC_TEXT = 1
+REC_FORMAT = 2
+REC_MESSAGE = 3
+
+LEVELS = {0: "NONE", 1: "ERROR", 2: "WARN", 3: "INFO", 4: "DEBUG"}
+
+# Mirrors encodeBinaryArgs() in EARS_loggerLib.cpp
+SPEC = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?([hlLzjt]*)([diouxXcfFeEgGaAspn%])")
+
+
+def unpack_args(fmt, payload):
+    """Render one MESSAGE payload with its format string"""
+    pos = 0
+    truncated = False
+
+    def take(size, code):
+        nonlocal pos, truncated
+        if pos + size > len(payload):
+            truncated = True
+            return None
+        value = struct.unpack_from(code, payload, pos)[0]
+        pos += size
+        return value
+
+    def render(match):
+        nonlocal pos, truncated
+        flags, width, precision, length, conv = match.groups()
+        if conv == "%":
+            return "%"
+        if truncated:
+            return match.group(0)
+
+        if width == "*":
+            width = take(4, "<i")
+            width = "" if width is None else str(width)
+        if precision == "*":
+            precision = take(4, "<i")
+            precision = "" if precision is None else str(precision)
+
+        spec = "%" + flags + (width or "") + ("." + precision if precision is not None else "")
+
+        if conv in "diouxXc":
+            longs = 2 if ("ll" in length or "j" in length) else 0
+            value = take(8, "<q") if longs else take(4, "<i")
+            if value is None:
+                return match.group(0)
+            if conv in "ouxX":
+                value &= (1 << (64 if longs else 32)) - 1
+            if conv == "c":
+                return (spec + "c") % chr(value & 0xFF)
+            return (spec + ("d" if conv == "i" else conv)) % value
+
+        if conv in "fFeEgGaA":
+            value = take(8, "<d")
+            if value is None:
+                return match.group(0)
+            if conv in "aA":
+                return value.hex()
+            return (spec + conv) % value
+
+        if conv == "s":
+            if pos >= len(payload):
+                truncated = True
+                return match.group(0)
+            size = payload[pos]
+            pos += 1
+            text = payload[pos:pos + size].decode("utf-8", errors="replace")
+            pos += size
+            return (spec + "s") % text
+
+        if conv == "p":
+            value = take(4, "<I")
+            return match.group(0) if value is None else f"0x{value:08x}"
+
+        return ""  # %n writes nothing
+
+    text = SPEC.sub(render, fmt)
+    if truncated:
+        text += " <truncated>"
+    return text
+
+
+def decode_file(path, out):
+    """Decode one binary log file, returns number of records"""
+    data = Path(path).read_bytes()
+    if str(path).endswith(SUFFIX):
+        data = decompress(data)
+    formats = {}
+    count = 0
+
+    start = data.find(MAGIC)
+    if start < 0:
+        print(f"✗ ERROR: {path}: no binary log magic found", file=sys.stderr)
+        return 0
+    if start > 0:
+        print(f"⚠ WARNING: {path}: skipped {start} leading bytes", file=sys.stderr)
+    pos = start + len(MAGIC)
+
+    while pos + HEADER.size <= len(data):
+        # A later magic means a new dictionary (file was cleared and reused)
+        if data[pos:pos + len(MAGIC)] == MAGIC:
+            formats.clear()
+            pos += len(MAGIC)
+            continue
+
+        rec_type, level, length, ms, fmt_id = HEADER.unpack_from(data, pos)
+        if rec_type == 0:
+            break  # Zero padding from a preallocated file that was not trimmed
+        pos += HEADER.size
+        payload = data[pos:pos + length]
+        pos += length
+
+        if rec_type == REC_FORMAT:
+            formats[fmt_id] = payload.decode("utf-8", errors="replace")
+            continue
+
+        if rec_type == REC_TEXT:
+            message = payload.decode("utf-8", errors="replace").rstrip("\n")
+        elif rec_type == REC_MESSAGE:
+            fmt = formats.get(fmt_id)
+            if fmt is None:
+                message = f"<unknown format 0x{fmt_id:08x}> {payload.hex()}"
+            else:
+                message = unpack_args(fmt, payload)
+        else:
+            print(f"✗ ERROR: {path}: bad record type {rec_type} at offset {pos - length - HEADER.size}",
+                  file=sys.stderr)
+            break
+
+        out.write(f"[{ms // 1000:>6}.{ms % 1000:03d}] [{LEVELS.get(level, '?')}] {message}\n")
+        count += 1
+
+    return count
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: python decode_binary_log.py <logfile> [logfile ...]")
+        sys.exit(1)
+
+    total = 0
+    for path in sys.argv[1:]:
+        try:
+            total += decode_file(path, sys.stdout)
+        except FileNotFoundError:
+            print(f"✗ ERROR: File not found: {path}", file=sys.stderr)
+            sys.exit(1)
+
+    print(f"✓ {total} records decoded", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,101 @@
+"""
+Telemetry Decoder
+Converts MAIN_telemetry SD card files (/logs/telemetry.bin) into CSV
+Run on the host: python scripts/decode_telemetry.py telemetry.bin.1 telemetry.bin > trend.csv
+"""
+
+import struct
+import sys
+import zlib
+from pathlib import Path
+
+MAGIC = 0x4D4C5445  # "ETLM"
+HEADER = struct.Struct("<IBBHIII")  # magic, fields, reserved, count, periodMs, length, crc
+
+# Mirrors MAIN_telemetry_field_t in MAIN_telemetryLib.h (append only)
+FIELDS = [
+    "uptime_s",
+    "heap_free",
+    "heap_largest",
+    "psram_free",
+    "cpu0",
+    "cpu1",
+    "fps_tenths",
+    "sd_pending",
+    "battery",
+]
+
+UNKNOWN = 255
+MAYBE_UNKNOWN = {"cpu0", "cpu1", "battery"}
+
+
+def read_varint(data, pos):
+    """One zigzag varint, returned as a signed value and the next position"""
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise ValueError("varint runs past the block")
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            break
+        shift += 7
+    return (value >> 1) ^ -(value & 1), pos
+
+
+def decode_block(payload, fields, count):
+    """Yield the samples of one block as lists of field values"""
+    previous = [0] * fields
+    pos = 0
+    for _ in range(count):
+        sample = []
+        for f in range(fields):
+            delta, pos = read_varint(payload, pos)
+            previous[f] = (previous[f] + delta) & 0xFFFFFFFF
+            sample.append(previous[f])
+        yield sample
+
+
+def decode_file(path, out, boot):
+    """Write every intact block of one file; returns the boot number reached"""
+    data = Path(path).read_bytes()
+    pos = 0
+    last_uptime = None
+    while pos + HEADER.size <= len(data):
+        magic, fields, _, count, period_ms, length, crc = HEADER.unpack_from(data, pos)
+        payload = data[pos + HEADER.size:pos + HEADER.size + length]
+        if magic != MAGIC or len(payload) != length or zlib.crc32(payload) != crc:
+            print(f"{path}: bad block at offset {pos}, skipping the rest", file=sys.stderr)
+            break
+        pos += HEADER.size + length
+
+        for sample in decode_block(payload, fields, count):
+            # Uptime going backwards means the unit restarted
+            if last_uptime is not None and sample[0] < last_uptime:
+                boot += 1
+            last_uptime = sample[0]
+
+            cells = [str(boot)]
+            for name, value in zip(FIELDS, sample):
+                cells.append("" if name in MAYBE_UNKNOWN and value == UNKNOWN else str(value))
+            out.write(",".join(cells) + "\n")
+    return boot
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__.strip(), file=sys.stderr)
+        return 1
+
+    out = sys.stdout
+    out.write("boot," + ",".join(FIELDS) + "\n")
+    boot = 0
+    for path in sys.argv[1:]:
+        boot = decode_file(path, out, boot)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,76 @@
+"""
+Rotated Log Decompressor
+Expands the .hs files EARS_logger leaves for rotated logs ("compress_rotated": true)
+Heatshrink stream, window 12 bits, lookahead 5 bits (heatshrink -d -w 12 -l 5 reads them too)
+Run on the host: python scripts/decompress_log.py debug.log.1.hs [debug.log.2.hs ...]
+Each file is written beside its input without the .hs suffix
+"""
+
+import sys
+from pathlib import Path
+
+# Mirrors LOGGER_HS_WINDOW_BITS and LOGGER_HS_LOOKAHEAD_BITS in EARS_loggerLib.h
+WINDOW_BITS = 12
+LOOKAHEAD_BITS = 5
+SUFFIX = ".hs"
+
+
+def decompress(data):
+    """Expand one heatshrink stream, returns bytes"""
+    out = bytearray()
+    total_bits = len(data) * 8
+    pos = 0
+
+    def take(count):
+        nonlocal pos
+        value = 0
+        for _ in range(count):
+            value = (value << 1) | ((data[pos >> 3] >> (7 - (pos & 7))) & 1)
+            pos += 1
+        return value
+
+    # The last byte is padded with zero bits, too few for a back-reference
+    while total_bits - pos >= 9:
+        if take(1):
+            out.append(take(8))
+            continue
+        if total_bits - pos < WINDOW_BITS + LOOKAHEAD_BITS:
+            break
+        distance = take(WINDOW_BITS) + 1
+        length = take(LOOKAHEAD_BITS) + 1
+        if distance > len(out):
+            raise ValueError(f"back-reference {distance} before start at output byte {len(out)}")
+        for _ in range(length):
+            out.append(out[-distance])
+
+    return bytes(out)
+
+
+def decompress_file(path):
+    """Decompress one .hs file beside itself, returns the output path"""
+    source = Path(path)
+    target = source.with_name(source.name[:-len(SUFFIX)]) if source.name.endswith(SUFFIX) \
+        else source.with_name(source.name + ".out")
+    target.write_bytes(decompress(source.read_bytes()))
+    return target
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: python decompress_log.py <logfile.hs> [logfile.hs ...]")
+        sys.exit(1)
+
+    for path in sys.argv[1:]:
+        try:
+            target = decompress_file(path)
+        except FileNotFoundError:
+            print(f"✗ ERROR: File not found: {path}", file=sys.stderr)
+            sys.exit(1)
+        except ValueError as e:
+            print(f"✗ ERROR: {path}: {e}", file=sys.stderr)
+            sys.exit(1)
+        print(f"✓ {path} -> {target}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
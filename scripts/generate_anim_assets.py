@@ -0,0 +1,236 @@
+Import("env")
+
+import re
+from pathlib import Path
+
+# Opcodes (top two bits), count in the low six bits is n - 1
+OP_LITERAL = 0x00  # n pixels follow
+OP_RUN = 0x40      # one pixel follows, repeated n times
+OP_SKIP = 0x80     # n pixels unchanged from the previous frame
+OP_MAX_COUNT = 64
+
+# LVGL image converter output: the map array and the header fields we need
+MAP_PATTERN = re.compile(r'uint8_t\s+(\w+)_map\[\]\s*=\s*\{(.*?)\};', re.S)
+FIELD_PATTERN = r'\.header\.{0}\s*=\s*(\w+)'
+
+
+def natural_key(path):
+    """Sort frame2 before frame10"""
+    return [int(part) if part.isdigit() else part for part in re.split(r'(\d+)', path.name)]
+
+
+def load_frame(c_file):
+    """Read an LVGL RGB565 image C file, return (width, height, pixels)"""
+    text = c_file.read_text(encoding='utf-8')
+
+    match = MAP_PATTERN.search(text)
+    if not match:
+        raise ValueError("no _map[] array")
+
+    cf = re.search(FIELD_PATTERN.format('cf'), text)
+    if not cf or cf.group(1) != 'LV_COLOR_FORMAT_RGB565':
+        raise ValueError("only LV_COLOR_FORMAT_RGB565 frames are supported")
+
+    width = int(re.search(FIELD_PATTERN.format('w'), text).group(1))
+    height = int(re.search(FIELD_PATTERN.format('h'), text).group(1))
+
+    data = bytes(int(b, 16) for b in re.findall(r'0x[0-9a-fA-F]{2}', match.group(2)))
+    if len(data) != width * height * 2:
+        raise ValueError(f"{len(data)} bytes, expected {width * height * 2}")
+
+    pixels = [data[i] | (data[i + 1] << 8) for i in range(0, len(data), 2)]
+    return width, height, pixels
+
+
+def encode_row(row, prev):
+    """Encode one row; prev is the same row of the previous frame or None"""
+    out = bytearray()
+    n = len(row)
+    i = 0
+
+    def unchanged(k):
+        return prev is not None and row[k] == prev[k]
+
+    while i < n:
+        # Unchanged pixels cost one byte per 64
+        if unchanged(i):
+            j = i
+            while j < n and j - i < OP_MAX_COUNT and unchanged(j):
+                j += 1
+            out.append(OP_SKIP | (j - i - 1))
+            i = j
+            continue
+
+        # Runs of one colour
+        j = i
+        while j < n and j - i < OP_MAX_COUNT and row[j] == row[i] and not unchanged(j):
+            j += 1
+        if j - i >= 2:
+            out.append(OP_RUN | (j - i - 1))
+            out += row[i].to_bytes(2, 'little')
+            i = j
+            continue
+
+        # Literals up to the next run or unchanged pixel
+        j = i + 1
+        while (j < n and j - i < OP_MAX_COUNT and not unchanged(j)
+               and not (j + 1 < n and row[j] == row[j + 1])):
+            j += 1
+        out.append(OP_LITERAL | (j - i - 1))
+        for k in range(i, j):
+            out += row[k].to_bytes(2, 'little')
+        i = j
+
+    return out
+
+
+def encode_frame(pixels, width, height, prev):
+    """Encode a frame row by row (rows never share an opcode)"""
+    out = bytearray()
+    for y in range(height):
+        row = pixels[y * width:(y + 1) * width]
+        prev_row = prev[y * width:(y + 1) * width] if prev is not None else None
+        out += encode_row(row, prev_row)
+    return out
+
+
+def dirty_box(pixels, prev, width, height):
+    """Bounding box (x, y, w, h) of pixels that differ from prev"""
+    x1, y1, x2, y2 = width, height, -1, -1
+    for y in range(height):
+        base = y * width
+        for x in range(width):
+            if pixels[base + x] != prev[base + x]:
+                x1, x2 = min(x1, x), max(x2, x)
+                y1, y2 = min(y1, y), max(y2, y)
+    if x2 < 0:
+        return 0, 0, 0, 0
+    return x1, y1, x2 - x1 + 1, y2 - y1 + 1
+
+
+def c_bytes(data, indent="    "):
+    """Format bytes as C initialiser lines"""
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ", ".join(f"0x{b:02x}" for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def generate_anim_assets(source_dir, header_file):
+    """Compress the animation frames in source_dir into header_file"""
+
+    print("=" * 70)
+    print("  ANIMATION ASSET GENERATOR")
+    print("=" * 70)
+
+    source = Path(source_dir)
+    if not source.is_dir():
+        print(f"✗ WARNING: {source_dir} not found, keeping existing assets")
+        return
+
+    blocks = []
+    assets = []
+
+    for anim_dir in sorted(p for p in source.iterdir() if p.is_dir()):
+        name = anim_dir.name
+        frame_files = sorted(anim_dir.glob("*.c"), key=natural_key)
+        if not frame_files:
+            continue
+
+        frames = []
+        try:
+            for frame_file in frame_files:
+                frames.append(load_frame(frame_file))
+        except Exception as e:
+            print(f"✗ ERROR: {name}: could not read {frame_file.name}: {e}")
+            continue
+
+        width, height = frames[0][0], frames[0][1]
+        if any(f[0] != width or f[1] != height for f in frames):
+            print(f"✗ ERROR: {name}: frames differ in size, skipped")
+            continue
+
+        raw_size = width * height * 2
+        encoded_total = 0
+        frame_rows = []
+        prev = None
+
+        for index, (_, _, pixels) in enumerate(frames):
+            # Changed region against the frame shown before it (frame 0
+            # follows the last frame when the animation loops)
+            box = dirty_box(pixels, frames[index - 1][2], width, height)
+
+            # Frame 0 is always a key frame so playback can restart there
+            encoded = encode_frame(pixels, width, height, None)
+            is_delta = 0
+            if prev is not None:
+                delta = encode_frame(pixels, width, height, prev)
+                if len(delta) < len(encoded):
+                    encoded, is_delta = delta, 1
+
+            symbol = f"MAIN_anim_{name}_frame{index}"
+            blocks.append(f"static const uint8_t {symbol}[{len(encoded)}] = {{\n{c_bytes(encoded)}\n}};\n")
+            frame_rows.append(f"    {{{symbol}, {len(encoded)}, {is_delta}, "
+                              f"{{{box[0]}, {box[1]}, {box[2]}, {box[3]}}}}},")
+            encoded_total += len(encoded)
+            prev = pixels
+
+            print(f"  {name}[{index}]: {raw_size} -> {len(encoded)} bytes "
+                  f"({'delta' if is_delta else 'key'}), dirty {box[2]}x{box[3]} at {box[0]},{box[1]}")
+
+        blocks.append(f"static const MAIN_anim_frame_t MAIN_anim_{name}_frames[] = {{\n"
+                      + "\n".join(frame_rows) + "\n};\n")
+        assets.append(f"    {{\"{name}\", {width}, {height}, {len(frames)}, MAIN_anim_{name}_frames}},")
+
+        print(f"✓ {name}: {len(frames)} frames, {raw_size * len(frames)} -> {encoded_total} bytes")
+
+    if not assets:
+        print(f"✗ WARNING: No frames found in {source_dir}, keeping existing assets")
+        print("=" * 70)
+        print("")
+        return
+
+    data = "\n".join(blocks)
+    table = "\n".join(assets)
+
+    content = f"""/**
+ * @file MAIN_animAssets.h
+ * @brief Compressed animation frames generated from assets/animation
+ * @details Written by scripts/generate_anim_assets.py before every build;
+ *          replace the frame files under assets/animation/<name>/, not this
+ *          file. Included by MAIN_animationLib.cpp only. Data lives in
+ *          flash (.rodata).
+ */
+
+#pragma once
+#ifndef __MAIN_ANIM_ASSETS_H__
+#define __MAIN_ANIM_ASSETS_H__
+
+#include "MAIN_animationLib.h"
+
+{data}
+static const MAIN_anim_asset_t MAIN_ANIM_ASSETS[] = {{
+{table}
+}};
+
+static const size_t MAIN_ANIM_ASSET_COUNT = sizeof(MAIN_ANIM_ASSETS) / sizeof(MAIN_ANIM_ASSETS[0]);
+
+#endif // __MAIN_ANIM_ASSETS_H__
+"""
+
+    # Only touch the header when the data changed (avoids needless rebuilds)
+    header = Path(header_file)
+    if header.exists() and header.read_text(encoding='utf-8') == content:
+        print(f"✓ Assets unchanged: {header_file}")
+    else:
+        try:
+            header.write_text(content, encoding='utf-8')
+            print(f"✓ File updated: {header_file} ({len(assets)} animations)")
+        except Exception as e:
+            print(f"✗ ERROR: Could not write to {header_file}: {e}")
+
+    print("=" * 70)
+    print("")
+
+# Run the generator
+generate_anim_assets('assets/animation', 'lib/MAIN_animationLib/MAIN_animAssets.h')
@@ -0,0 +1,227 @@
+Import("env")
+
+import re
+from pathlib import Path
+
+# EEZ Studio style functions in src/ui/styles.c
+INIT_PATTERN = re.compile(r'void init_style_(\w+)\(lv_style_t \*style\) \{\n(.*?)\n\};\n*', re.S)
+GET_PATTERN = re.compile(r'lv_style_t \*get_style_(\w+)\(\) \{\n.*?\n\};', re.S)
+SET_PATTERN = re.compile(r'^\s*lv_style_set_(\w+)\(style, (.*)\);\s*$')
+STYLE_NAMES_PATTERN = re.compile(r'style_names\[\]\s*=\s*\{(.*?)\};', re.S)
+
+# Runtime helpers with a constant-expression equivalent
+COLOR_HEX = re.compile(r'lv_color_hex\(0x([0-9a-fA-F]{6,8})\)')
+PCT = re.compile(r'lv_pct\(([^()]+)\)')
+FUNCTION_CALL = re.compile(r'\b[a-z_]\w*\s*\(')
+
+
+def const_value(value):
+    """The value as a constant expression, or None if it needs code"""
+    def color(match):
+        rgb = int(match.group(1), 16) & 0xFFFFFF
+        return f"LV_COLOR_MAKE(0x{rgb >> 16:02x}, 0x{(rgb >> 8) & 0xFF:02x}, 0x{rgb & 0xFF:02x})"
+
+    value = COLOR_HEX.sub(color, value)
+    value = PCT.sub(r'LV_PCT(\1)', value)
+    return None if FUNCTION_CALL.search(value) else value
+
+
+def const_props(body):
+    """LV_STYLE_CONST_* lines for an init function body, or None"""
+    props = []
+    for line in body.splitlines():
+        if not line.strip():
+            continue
+        match = SET_PATTERN.match(line)
+        value = const_value(match.group(2)) if match else None
+        if value is None:
+            return None
+        props.append(f"    LV_STYLE_CONST_{match.group(1).upper()}({value}),")
+    return props
+
+
+def theme_tables(suffixes, style_names):
+    """Enum and tables of the styles that exist in more than one theme
+
+    EEZ names theme variants <Theme>_<Style> (Light_Default_Screen and
+    Dark_Default_Screen); a table per theme lists them in the same order.
+    """
+    themes = {}
+    for name in style_names:
+        if "_" in name:
+            theme, base = name.split("_", 1)
+            themes.setdefault(theme, {})[base] = name.lower()
+
+    bases = []
+    for theme_styles in themes.values():
+        for base in theme_styles:
+            shared = sum(base in other for other in themes.values()) > 1
+            if shared and base not in bases:
+                bases.append(base)
+    if not bases:
+        return "", ""
+
+    themes = {theme: styles for theme, styles in themes.items() if any(b in styles for b in bases)}
+
+    # Every part/state of a style gets its own entry
+    entries = []
+    for base in bases:
+        for theme_styles in themes.values():
+            prefix = theme_styles.get(base, "") + "_"
+            for suffix in suffixes:
+                entry = (base, suffix[len(prefix):])
+                if base in theme_styles and suffix.startswith(prefix) and entry not in entries:
+                    entries.append(entry)
+
+    ids = [f"UI_STYLE_{base.upper()}_{selector}" for base, selector in entries]
+    header = "typedef enum\n{\n"
+    header += "".join(f"    UI_STYLE_THEME_{theme.upper()},\n" for theme in themes)
+    header += "    UI_STYLE_THEME_COUNT\n} ui_style_theme_t;\n\n"
+    header += "typedef enum\n{\n" + "".join(f"    {id},\n" for id in ids)
+    header += "    UI_STYLE_COUNT\n} ui_style_id_t;\n\n"
+    header += ("/**\n * @brief One style of a theme\n"
+               " * @return The constant style, NULL if the theme has no such style\n */\n"
+               "const lv_style_t *ui_style_get(ui_style_theme_t theme, ui_style_id_t id);\n")
+
+    source = ""
+    for theme, theme_styles in themes.items():
+        source += f"static const lv_style_t *const ui_styles_{theme.lower()}[UI_STYLE_COUNT] = {{\n"
+        for base, selector in entries:
+            suffix = f"{theme_styles[base]}_{selector}" if base in theme_styles else None
+            source += f"    &style_{suffix},\n" if suffix in suffixes else "    NULL,\n"
+        source += "};\n\n"
+    source += "static const lv_style_t *const *const ui_style_themes[UI_STYLE_THEME_COUNT] = {\n"
+    source += "".join(f"    ui_styles_{theme.lower()},\n" for theme in themes) + "};\n\n"
+    source += ("const lv_style_t *ui_style_get(ui_style_theme_t theme, ui_style_id_t id) {\n"
+               "    if (theme >= UI_STYLE_THEME_COUNT || id >= UI_STYLE_COUNT) {\n"
+               "        return NULL;\n"
+               "    }\n"
+               "    return ui_style_themes[theme][id];\n"
+               "}\n")
+    return header, source
+
+
+def write_if_changed(path, content):
+    """Only touch the file when the text changed (avoids needless rebuilds)"""
+    target = Path(path)
+    if target.exists() and target.read_text(encoding='utf-8') == content:
+        print(f"✓ Styles unchanged: {path}")
+        return
+    try:
+        target.write_text(content, encoding='utf-8')
+        print(f"✓ File updated: {path}")
+    except Exception as e:
+        print(f"✗ ERROR: Could not write to {path}: {e}")
+
+
+def generate_const_styles(styles_file, screens_file, source_file, header_file):
+    """Turn the EEZ styles in styles_file into constant styles in source_file"""
+
+    print("=" * 70)
+    print("  CONSTANT STYLE GENERATOR")
+    print("=" * 70)
+
+    styles = Path(styles_file)
+    if not styles.is_file():
+        print(f"✗ WARNING: {styles_file} not found, keeping existing styles")
+        print("=" * 70)
+        print("")
+        return
+    text = styles.read_text(encoding='utf-8')
+
+    blocks = []
+    suffixes = []
+    runtime = []
+    for match in INIT_PATTERN.finditer(text):
+        suffix, body = match.group(1), match.group(2)
+        suffixes.append(suffix)
+        props = const_props(body)
+        if props is None:
+            # Kept as code: a static style filled in on first use
+            runtime.append(suffix)
+            blocks.append(f"static lv_style_t style_{suffix};\n\n" + match.group(0).rstrip() + "\n")
+            print(f"  {suffix}: runtime (a value is not a constant expression)")
+            continue
+        blocks.append(f"static const lv_style_const_prop_t style_{suffix}_props[] = {{\n"
+                      + "\n".join(props) + "\n    LV_STYLE_CONST_PROPS_END\n};\n\n"
+                      + f"static LV_STYLE_CONST_INIT(style_{suffix}, style_{suffix}_props);\n")
+        print(f"  {suffix}: {len(props)} properties in flash")
+
+    def getter(match):
+        suffix = match.group(1)
+        if suffix in runtime:
+            return (f"lv_style_t *get_style_{suffix}() {{\n"
+                    f"    static bool ready;\n"
+                    f"    if (!ready) {{\n"
+                    f"        lv_style_init(&style_{suffix});\n"
+                    f"        init_style_{suffix}(&style_{suffix});\n"
+                    f"        ready = true;\n"
+                    f"    }}\n"
+                    f"    return &style_{suffix};\n"
+                    f"}};")
+        return (f"lv_style_t *get_style_{suffix}() {{\n"
+                f"    return (lv_style_t *)&style_{suffix};\n"
+                f"}};")
+
+    # Each style's definition goes where EEZ put its init function
+    index = iter(blocks)
+    body = INIT_PATTERN.sub(lambda m: next(index) + "\n", text)
+    body = GET_PATTERN.sub(getter, body)
+
+    style_names = []
+    screens = Path(screens_file)
+    if screens.is_file():
+        names = STYLE_NAMES_PATTERN.search(screens.read_text(encoding='utf-8'))
+        if names:
+            style_names = re.findall(r'"(\w+)"', names.group(1))
+    theme_header, theme_source = theme_tables(suffixes, style_names)
+
+    banner = f"""/**
+ * @file {Path(source_file).name}
+ * @brief EEZ Studio styles as constant LVGL styles
+ * @details Written by scripts/generate_const_styles.py before every build
+ *          from styles.c, which EEZ Studio exports and the build leaves out;
+ *          edit the styles in EEZ Studio, not this file. Property lists and
+ *          styles live in flash (LV_STYLE_CONST_INIT), so no style takes
+ *          LVGL heap; a style with a value that is not a constant
+ *          expression is filled in on first use instead.
+ */
+"""
+    source = banner + '#include "styles_const.h"\n' + body.rstrip() + "\n"
+    if theme_source:
+        source += "\n//\n// Theme variants\n//\n\n" + theme_source
+
+    header = f"""/**
+ * @file {Path(header_file).name}
+ * @brief Theme variants of the constant EEZ styles
+ * @details Written by scripts/generate_const_styles.py before every build.
+ *          Styles named <Theme>_<Style> in EEZ Studio are listed per theme
+ *          in the same order, so switching theme swaps one table for another.
+ */
+#ifndef EEZ_LVGL_UI_STYLES_CONST_H
+#define EEZ_LVGL_UI_STYLES_CONST_H
+
+#include "styles.h"
+
+#ifdef __cplusplus
+extern "C" {{
+#endif
+
+{theme_header}
+#ifdef __cplusplus
+}}
+#endif
+
+#endif /*EEZ_LVGL_UI_STYLES_CONST_H*/
+"""
+
+    write_if_changed(source_file, source)
+    write_if_changed(header_file, header)
+    print(f"✓ {len(suffixes) - len(runtime)} of {len(suffixes)} styles constant")
+    print("=" * 70)
+    print("")
+
+
+# Run the generator
+generate_const_styles('src/ui/styles.c', 'src/ui/screens.c',
+                      'src/ui/styles_const.c', 'src/ui/styles_const.h')
@@ -0,0 +1,108 @@
+Import("env")
+
+import json
+from pathlib import Path
+
+# Level names in errors.json -> EARS_errors::ErrorLevel values
+LEVELS = {"NONE": 0, "WARN": 1, "WARNING": 1, "ERROR": 2}
+
+
+def c_string(text):
+    """Escape text as a C string literal"""
+    out = []
+    for ch in text:
+        if ch == '\\':
+            out.append('\\\\')
+        elif ch == '"':
+            out.append('\\"')
+        elif ch == '\n':
+            out.append('\\n')
+        elif ord(ch) < 0x20:
+            out.append(f'\\x{ord(ch):02x}')
+        else:
+            out.append(ch)
+    return '"' + ''.join(out) + '"'
+
+
+def generate_error_table(json_file, header_file):
+    """Generate the sorted flash error table from errors.json"""
+
+    print("=" * 70)
+    print("  ERROR TABLE GENERATOR")
+    print("=" * 70)
+
+    try:
+        with open(json_file, 'r', encoding='utf-8') as f:
+            errors = json.load(f).get("errors", [])
+        print(f"✓ File read: {json_file} ({len(errors)} entries)")
+    except FileNotFoundError:
+        print(f"✗ WARNING: {json_file} not found, keeping existing table")
+        return
+    except Exception as e:
+        print(f"✗ ERROR: Could not parse {json_file}: {e}")
+        return
+
+    entries = {}
+    for error in errors:
+        code = int(error["code"])
+        if code in entries:
+            print(f"✗ WARNING: Duplicate code {code}, keeping the first entry")
+            continue
+        level = LEVELS.get(str(error.get("level", "ERROR")).upper(), 2)
+        entries[code] = (level, str(error.get("message", "")))
+
+    rows = "\n".join(
+        f"    {{{code}, {level}, {c_string(message)}}},"
+        for code, (level, message) in sorted(entries.items())
+    )
+
+    content = f"""/**
+ * @file EARS_errorTable.h
+ * @brief Built-in error code table generated from data/config/errors.json
+ * @details Written by scripts/generate_error_table.py before every build; edit
+ *          errors.json, not this file. Entries are sorted by code for binary
+ *          search and live in flash (.rodata).
+ */
+
+#pragma once
+#ifndef __EARS_ERROR_TABLE_H__
+#define __EARS_ERROR_TABLE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @struct EARS_errorTableEntry
+ * @brief One built-in error code
+ */
+struct EARS_errorTableEntry {{
+    uint16_t code;        // Error code
+    uint8_t level;        // Default EARS_errors::ErrorLevel
+    const char* message;  // Human-readable message
+}};
+
+constexpr EARS_errorTableEntry EARS_ERROR_TABLE[] = {{
+{rows}
+}};
+
+constexpr size_t EARS_ERROR_TABLE_SIZE = sizeof(EARS_ERROR_TABLE) / sizeof(EARS_ERROR_TABLE[0]);
+
+#endif // __EARS_ERROR_TABLE_H__
+"""
+
+    # Only touch the header when the table changed (avoids needless rebuilds)
+    header = Path(header_file)
+    if header.exists() and header.read_text(encoding='utf-8') == content:
+        print(f"✓ Table unchanged: {header_file}")
+    else:
+        try:
+            header.write_text(content, encoding='utf-8')
+            print(f"✓ File updated: {header_file} ({len(entries)} codes)")
+        except Exception as e:
+            print(f"✗ ERROR: Could not write to {header_file}: {e}")
+
+    print("=" * 70)
+    print("")
+
+# Run the generator
+generate_error_table('data/config/errors.json', 'lib/EARS_errorsLib/EARS_errorTable.h')
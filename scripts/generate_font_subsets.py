@@ -0,0 +1,176 @@
+"""
+Font Subset Generator
+Builds subset Montserrat fonts holding only the glyphs the firmware draws:
+text in the EEZ projects and label literals, error messages (data/config/errors.json),
+LV_SYMBOL_* used by the project code, and the extras in
+assets/fonts/font_subsets.json
+Compiled sizes become src/fonts/ears_font_montserrat_NN.c; on-demand sizes
+become assets/fonts/montserrat_NN.bin for the asset pack or SD card /fonts
+Run on the host: python scripts/generate_font_subsets.py
+Needs Node.js (npx lv_font_conv); then build with -D EARS_FONT_SUBSETS=1
+"""
+
+import argparse
+import json
+import re
+import subprocess
+import sys
+from pathlib import Path
+
+CONFIG_FILE = "assets/fonts/font_subsets.json"
+C_OUTPUT_DIR = "src/fonts"
+BIN_OUTPUT_DIR = "assets/fonts"
+SYMBOL_DEF = "lib/lvgl/src/font/lv_symbol_def.h"
+ERRORS_FILE = "data/config/errors.json"
+LANG_DIR = "assets/lang"
+
+# Project code scanned for label text and LV_SYMBOL_* names
+CODE_GLOBS = ["src/**/*.c", "src/**/*.cpp", "lib/MAIN_*/*.cpp", "lib/MAIN_*/*.h", "lib/EARS_*/*.cpp", "lib/EARS_*/*.h"]
+LABEL_RE = re.compile(r'lv_label_set_text(?:_static)?\s*\([^,]+,\s*"((?:[^"\\\n]|\\.)*)"')
+SYMBOL_RE = re.compile(r'\bLV_SYMBOL_[A-Z0-9_]+\b')
+ASCII = "".join(chr(c) for c in range(0x20, 0x7F))
+
+
+def symbol_codepoints():
+    """Map LV_SYMBOL_* names to their codepoints"""
+    table = {}
+    for line in Path(SYMBOL_DEF).read_text(encoding='utf-8').splitlines():
+        m = re.match(r'#define\s+(LV_SYMBOL_\w+)\s+"[^"]*"\s*/\*(\d+)', line)
+        if m:
+            table[m.group(1)] = int(m.group(2))
+    return table
+
+
+def collect_text(project_dirs):
+    """Characters from UI text and error messages, plus symbols used in code"""
+    chars = set()
+    symbols = set()
+
+    # EEZ projects: every string value under a "text" key
+    def walk(node):
+        if isinstance(node, dict):
+            for key, value in node.items():
+                if key == "text" and isinstance(value, str):
+                    chars.update(value)
+                else:
+                    walk(value)
+        elif isinstance(node, list):
+            for item in node:
+                walk(item)
+
+    for directory in project_dirs:
+        for project in Path(directory).glob("*.eez-project"):
+            walk(json.loads(project.read_text(encoding='utf-8')))
+
+    try:
+        for error in json.loads(Path(ERRORS_FILE).read_text(encoding='utf-8')).get("errors", []):
+            chars.update(str(error.get("message", "")))
+    except FileNotFoundError:
+        pass
+
+    # Localised strings and error messages (scripts/generate_lang_packs.py)
+    for lang_file in Path(LANG_DIR).glob("*.json"):
+        lang = json.loads(lang_file.read_text(encoding='utf-8'))
+        for value in list(lang.get("strings", {}).values()) + list(lang.get("errors", {}).values()):
+            chars.update(str(value))
+
+    # Literal label text in the project code (runtime text needs "ascii" or extras)
+    for pattern in CODE_GLOBS:
+        for path in Path(".").glob(pattern):
+            if "fonts" in path.parts:
+                continue
+            source = path.read_text(encoding='utf-8', errors='ignore')
+            for literal in LABEL_RE.findall(source):
+                chars.update(c for c in literal if c.isprintable())
+            symbols.update(SYMBOL_RE.findall(source))
+
+    return chars, symbols
+
+
+def ranges(codepoints):
+    """Comma separated codepoint list for lv_font_conv -r"""
+    return ",".join(f"0x{c:X}" for c in sorted(codepoints))
+
+
+def generate_font(config, size, options, text, symbols, dry_run):
+    """Run lv_font_conv for one size, returns the output path"""
+    on_demand = options.get("on_demand", False)
+    chars = set(text) | set(config.get("extras", ""))
+    if options.get("ascii", False):
+        chars |= set(ASCII)
+    chars.add(" ")
+
+    if on_demand:
+        output = Path(BIN_OUTPUT_DIR) / f"montserrat_{size}.bin"
+    else:
+        output = Path(C_OUTPUT_DIR) / f"ears_font_montserrat_{size}.c"
+    output.parent.mkdir(parents=True, exist_ok=True)
+
+    cmd = ["npx", "--yes", "lv_font_conv", "--no-compress", "--no-prefilter",
+           "--bpp", str(config.get("bpp", 4)), "--size", str(size),
+           "--font", config["font"], "-r", ranges(ord(c) for c in chars)]
+    if symbols:
+        cmd += ["--font", config["symbol_font"], "-r", ranges(symbols)]
+    cmd += ["--format", "bin" if on_demand else "lvgl", "-o", str(output), "--force-fast-kern-format"]
+    if not on_demand:
+        cmd += ["--lv-font-name", f"ears_font_montserrat_{size}"]
+
+    print(f"✓ {size} px: {len(chars)} glyphs + {len(symbols)} symbols -> {output}"
+          f"{' (on demand)' if on_demand else ''}")
+    if dry_run:
+        return output
+
+    subprocess.run(cmd, check=True, shell=(sys.platform == "win32"))
+
+    if not on_demand:
+        # Only compiled in when the subsets are selected, see lv_conf.h
+        source = output.read_text(encoding='utf-8')
+        output.write_text("#if EARS_FONT_SUBSETS == 1\n" + source + "\n#endif /*EARS_FONT_SUBSETS*/\n",
+                          encoding='utf-8')
+    return output
+
+
+def generate_font_subsets(config_file, project_dirs, dry_run):
+    """Generate every configured size"""
+
+    print("=" * 70)
+    print("  FONT SUBSET GENERATOR")
+    print("=" * 70)
+
+    try:
+        config = json.loads(Path(config_file).read_text(encoding='utf-8'))
+    except Exception as e:
+        print(f"✗ ERROR: Could not read {config_file}: {e}")
+        return False
+
+    text, names = collect_text(project_dirs)
+    table = symbol_codepoints()
+    symbols = {table[n] for n in names if n in table}
+    print(f"✓ {len(text)} distinct characters, {len(symbols)} symbols in use")
+
+    for size, options in sorted(config["sizes"].items(), key=lambda item: int(item[0])):
+        try:
+            generate_font(config, int(size), options, text, symbols, dry_run)
+        except (subprocess.CalledProcessError, FileNotFoundError) as e:
+            print(f"✗ ERROR: lv_font_conv failed for {size} px: {e}")
+            return False
+
+    print("  Build with -D EARS_FONT_SUBSETS=1; pack on-demand fonts with build_asset_pack.py")
+    print("=" * 70)
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate subset Montserrat fonts")
+    parser.add_argument("--config", default=CONFIG_FILE, help="Subset configuration")
+    parser.add_argument("--projects", nargs="*", default=["EARS-PIO-WSS3-LVGL-002", "eez studio"],
+                        help="Directories holding .eez-project files")
+    parser.add_argument("--dry-run", action="store_true", help="Report glyph counts only")
+    args = parser.parse_args()
+
+    if not generate_font_subsets(args.config, args.projects, args.dry_run):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,179 @@
+Import("env")
+
+import json
+import re
+import struct
+import zlib
+from pathlib import Path
+
+# Layout shared with MAIN_i18nLib.h (little endian)
+MAGIC = b"EARSLNG1"
+VERSION = 1
+HEADER = struct.Struct("<8sIHH8sII")  # magic, version, count, errorCount, language, keysHash, dataSize (32 bytes)
+ERROR_ENTRY = struct.Struct("<H2xI")  # code, offset into the string data
+UNTRANSLATED = 0xFFFFFFFF
+
+MASTER_LANGUAGE = "en"
+KEY_PATTERN = re.compile(r'^[A-Z][A-Z0-9_]*$')
+
+
+def load_language(path):
+    """Read one assets/lang/<code>.json, return (code, strings, errors)"""
+    doc = json.loads(path.read_text(encoding='utf-8'))
+    code = doc.get("language", path.stem)
+    if len(code.encode('utf-8')) > 7:
+        raise ValueError(f"language code '{code}' longer than 7 bytes")
+    strings = doc.get("strings", {})
+    errors = {int(k): v for k, v in doc.get("errors", {}).items()}
+    return code, strings, errors
+
+
+def build_pack(code, keys, keys_hash, strings, errors):
+    """Pack the strings in key order and the sorted error messages"""
+    data = bytearray()
+    seen = {}
+
+    def add(text):
+        # Identical strings share one copy
+        if text not in seen:
+            seen[text] = len(data)
+            data.extend(text.encode('utf-8') + b"\0")
+        return seen[text]
+
+    offsets = [add(strings[key]) if key in strings else UNTRANSLATED for key in keys]
+    error_index = [(c, add(errors[c])) for c in sorted(errors)]
+
+    out = bytearray(HEADER.pack(MAGIC, VERSION, len(keys), len(error_index),
+                                code.encode('utf-8'), keys_hash, len(data)))
+    out += struct.pack(f"<{len(keys)}I", *offsets)
+    for c, offset in error_index:
+        out += ERROR_ENTRY.pack(c, offset)
+    out += data
+    return bytes(out), offsets.count(UNTRANSLATED)
+
+
+def c_bytes(data, indent="    "):
+    """Format bytes as C initialiser lines"""
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ", ".join(f"0x{b:02x}" for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def write_if_changed(path, content, what):
+    """Only touch a file when its contents changed (avoids needless rebuilds)"""
+    mode = 'b' if isinstance(content, bytes) else ''
+    if path.exists() and (path.read_bytes() if mode else path.read_text(encoding='utf-8')) == content:
+        print(f"✓ {what} unchanged: {path}")
+        return
+    try:
+        if mode:
+            path.write_bytes(content)
+        else:
+            path.write_text(content, encoding='utf-8')
+        print(f"✓ File updated: {path}")
+    except Exception as e:
+        print(f"✗ ERROR: Could not write to {path}: {e}")
+
+
+def generate_lang_packs(source_dir, ids_header, builtin_header):
+    """String IDs and the builtin pack from the master language, a .bin per other language"""
+
+    print("=" * 70)
+    print("  LANGUAGE PACK GENERATOR")
+    print("=" * 70)
+
+    source = Path(source_dir)
+    master_file = source / f"{MASTER_LANGUAGE}.json"
+    if not master_file.is_file():
+        print(f"✗ WARNING: {master_file} not found, keeping existing string tables")
+        print("=" * 70)
+        print("")
+        return
+
+    try:
+        _, master, master_errors = load_language(master_file)
+    except Exception as e:
+        print(f"✗ ERROR: {master_file}: {e}")
+        print("=" * 70)
+        print("")
+        return
+
+    # The master file fixes the IDs: its key order is the enum order
+    keys = [k for k in master if KEY_PATTERN.match(k)]
+    for bad in (k for k in master if not KEY_PATTERN.match(k)):
+        print(f"✗ WARNING: key '{bad}' is not UPPER_CASE, skipped")
+    keys_hash = zlib.crc32("\n".join(keys).encode('utf-8')) & 0xFFFFFFFF
+
+    # IDs header
+    enum_lines = "\n".join(f"    STR_{k}," for k in keys)
+    write_if_changed(Path(ids_header), f"""/**
+ * @file MAIN_i18nStrings.h
+ * @brief String IDs generated from {source_dir}/{MASTER_LANGUAGE}.json
+ * @details Written by scripts/generate_lang_packs.py before every build; add
+ *          strings to the master language file, not here. Packs built with
+ *          a different key list carry a different I18N_KEYS_HASH and are
+ *          refused at load.
+ */
+
+#pragma once
+#ifndef __MAIN_I18N_STRINGS_H__
+#define __MAIN_I18N_STRINGS_H__
+
+#define I18N_KEYS_HASH 0x{keys_hash:08X}UL
+
+typedef enum
+{{
+{enum_lines}
+    STR_COUNT
+}} MAIN_string_id_t;
+
+#endif // __MAIN_I18N_STRINGS_H__
+""", "String IDs")
+
+    # Builtin (master) pack, in flash; error messages come from EARS_errors
+    builtin, _ = build_pack(MASTER_LANGUAGE, keys, keys_hash, master, master_errors)
+    write_if_changed(Path(builtin_header), f"""/**
+ * @file MAIN_i18nBuiltin.h
+ * @brief Builtin language pack generated from {source_dir}/{MASTER_LANGUAGE}.json
+ * @details Written by scripts/generate_lang_packs.py before every build.
+ *          Included by MAIN_i18nLib.cpp only. Data lives in flash (.rodata).
+ */
+
+#pragma once
+#ifndef __MAIN_I18N_BUILTIN_H__
+#define __MAIN_I18N_BUILTIN_H__
+
+#include <stdint.h>
+
+alignas(4) static const uint8_t MAIN_I18N_BUILTIN_PACK[{len(builtin)}] = {{
+{c_bytes(builtin)}
+}};
+
+#endif // __MAIN_I18N_BUILTIN_H__
+""", "Builtin pack")
+    print(f"✓ {MASTER_LANGUAGE}: {len(keys)} strings, {len(builtin)} bytes (builtin)")
+
+    # Other languages go to the asset pack as lang_<code>
+    for lang_file in sorted(source.glob("*.json")):
+        if lang_file == master_file:
+            continue
+        try:
+            code, strings, errors = load_language(lang_file)
+        except Exception as e:
+            print(f"✗ ERROR: {lang_file.name}: {e}")
+            continue
+
+        for extra in (k for k in strings if k not in keys):
+            print(f"✗ WARNING: {code}: '{extra}' is not in {master_file.name}, ignored")
+
+        pack, missing = build_pack(code, keys, keys_hash, strings, errors)
+        write_if_changed(source / f"lang_{code}.bin", pack, "Pack")
+        print(f"✓ {code}: {len(keys) - missing}/{len(keys)} strings, {len(errors)} errors, {len(pack)} bytes"
+              + (f" ({missing} fall back to {MASTER_LANGUAGE})" if missing else ""))
+
+    print("=" * 70)
+    print("")
+
+# Run the generator
+generate_lang_packs('assets/lang', 'lib/MAIN_i18nLib/MAIN_i18nStrings.h', 'lib/MAIN_i18nLib/MAIN_i18nBuiltin.h')
@@ -2,6 +2,11 @@ Import("env")
 
 import re
 from datetime import datetime
+from pathlib import Path
+
+# namespace <Lib> { ... LIB_NAME = "..."; VERSION_MAJOR = "..."; ... } in each library header
+NAMESPACE_PATTERN = re.compile(r'namespace\s+\w+\s*\{([^{}]*)\}')
+FIELD_PATTERN = r'constexpr\s+const\s+char\s*\*\s*{}\s*=\s*"([^"]*)"'
 
 def increment_build(header_file):
     """Increment patch version and update timestamp in EARS_versionDef.h"""
@@ -56,5 +61,93 @@ def increment_build(header_file):
     print("=" * 70)
     print("")
 
-# Run the increment
-increment_build('include/EARS_versionDef.h')
\ No newline at end of file
+def read_lib_versions(lib_dir):
+    """Collect (name, major, minor, patch, date) from every library header"""
+    versions = {}
+    for header in sorted(Path(lib_dir).glob('*/*.h')):
+        try:
+            text = header.read_text(encoding='utf-8', errors='ignore')
+        except Exception:
+            continue
+        for block in NAMESPACE_PATTERN.findall(text):
+            fields = [re.search(FIELD_PATTERN.format(key), block)
+                      for key in ('LIB_NAME', 'VERSION_MAJOR', 'VERSION_MINOR', 'VERSION_PATCH', 'VERSION_DATE')]
+            if all(fields):
+                name, major, minor, patch, date = (field.group(1) for field in fields)
+                versions.setdefault(name, (int(major), int(minor), int(patch), date))
+    return versions
+
+
+def generate_lib_versions(version_header, lib_dir, table_header):
+    """Write the app and library version table read by the boot report"""
+
+    try:
+        with open(version_header, 'r', encoding='utf-8') as f:
+            content = f.read()
+        app = [int(re.search(rf'#define\s+EARS_APP_VERSION_{part}\s+"(\d+)"', content).group(1))
+               for part in ('MAJOR', 'MINOR', 'PATCH')]
+    except Exception as e:
+        print(f"✗ ERROR: Could not read the app version from {version_header}: {e}")
+        return
+
+    versions = read_lib_versions(lib_dir)
+    rows = "\n".join(
+        f'    {{"{name}", {major * 1000000 + minor * 1000 + patch}UL, "{major}.{minor}.{patch}", "{date}"}},'
+        for name, (major, minor, patch, date) in sorted(versions.items(), key=lambda item: item[0].lower())
+    )
+
+    table = f"""/**
+ * @file EARS_libVersionsDef.h
+ * @brief Application and library versions, generated at build time
+ * @details Written by scripts/increment_build.py before every build from
+ *          EARS_versionDef.h and the version namespace of each library
+ *          header; edit those, not this file. Versions are preformatted, so
+ *          printing them costs no parsing or formatting at runtime.
+ */
+
+#pragma once
+#ifndef __EARS_LIB_VERSIONS_DEF_H__
+#define __EARS_LIB_VERSIONS_DEF_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define EARS_APP_VERSION_STRING "{app[0]}.{app[1]}.{app[2]}"
+
+/**
+ * @struct EARS_libVersionEntry
+ * @brief One library version
+ */
+struct EARS_libVersionEntry {{
+    const char* name;     // LIB_NAME
+    uint32_t encoded;     // VERS_ENCODE of the version
+    const char* version;  // "major.minor.patch"
+    const char* date;     // VERSION_DATE
+}};
+
+constexpr EARS_libVersionEntry EARS_LIB_VERSIONS[] = {{
+{rows}
+}};
+
+constexpr size_t EARS_LIB_VERSIONS_COUNT = sizeof(EARS_LIB_VERSIONS) / sizeof(EARS_LIB_VERSIONS[0]);
+
+#endif // __EARS_LIB_VERSIONS_DEF_H__
+"""
+
+    # Only touch the header when a version changed (avoids needless rebuilds)
+    header = Path(table_header)
+    if header.exists() and header.read_text(encoding='utf-8') == table:
+        print(f"✓ Version table unchanged: {table_header}")
+    else:
+        try:
+            header.write_text(table, encoding='utf-8')
+            print(f"✓ File updated: {table_header} ({len(versions)} libraries)")
+        except Exception as e:
+            print(f"✗ ERROR: Could not write to {table_header}: {e}")
+
+    print("=" * 70)
+    print("")
+
+# Run the increment, then regenerate the version table from the new patch
+increment_build('include/EARS_versionDef.h')
+generate_lib_versions('include/EARS_versionDef.h', 'lib', 'include/EARS_libVersionsDef.h')
\ No newline at end of file
@@ -0,0 +1,120 @@
+# ==============================================================================
+# IRAM Budget Report for PlatformIO
+# ==============================================================================
+# Description: Runs after each link and reports the internal RAM taken by
+#              code placed in IRAM (IRAM_ATTR, EARS_HOT and LVGL's
+#              LV_ATTRIBUTE_FAST_MEM, see include/EARS_placementDef.h) and by
+#              static data in DRAM, with the largest IRAM functions.
+#
+#              IRAM and DRAM share the S3's internal SRAM, so every byte of
+#              hot code is a byte less heap. Warns when the IRAM sections
+#              pass custom_iram_budget (bytes); with
+#              custom_iram_budget_strict = yes the build fails instead.
+#
+# Author:      Auto-generated for EARS Project
+# Version:     1.0.0
+# ==============================================================================
+
+Import("env")  # type: ignore
+import os
+import subprocess
+
+DEFAULT_BUDGET = 128 * 1024
+TOP_SYMBOLS = 12
+
+
+def print_banner(message):
+    """Print a visible banner message"""
+    banner = "=" * 70
+    print(f"\n{banner}")
+    print(f"  {message}")
+    print(f"{banner}\n")
+
+
+def toolchain_tool(name):
+    """Path of a binutils tool next to the compiler"""
+    cc = env.subst("$CC")
+    if cc.endswith("gcc"):
+        return cc[:-3] + name
+    return name
+
+
+def read_sections(elf):
+    """Section name -> (size, address) from size -A"""
+    output = subprocess.check_output([toolchain_tool("size"), "-A", "-d", elf], text=True)
+    sections = {}
+    for line in output.splitlines():
+        parts = line.split()
+        if len(parts) == 3 and parts[0].startswith(".") and parts[1].isdigit():
+            sections[parts[0]] = (int(parts[1]), int(parts[2]))
+    return sections
+
+
+def largest_in(elf, ranges):
+    """Largest symbols whose address falls in one of the ranges"""
+    output = subprocess.check_output(
+        [toolchain_tool("nm"), "-S", "-C", "--size-sort", "--defined-only", elf], text=True)
+    symbols = []
+    for line in output.splitlines():
+        parts = line.split(None, 3)
+        if len(parts) < 4:
+            continue
+        try:
+            address = int(parts[0], 16)
+            size = int(parts[1], 16)
+        except ValueError:
+            continue
+        if any(start <= address < end for start, end in ranges):
+            symbols.append((size, parts[3]))
+    symbols.sort(reverse=True)
+    return symbols[:TOP_SYMBOLS]
+
+
+def iram_report(source, target, env):
+    """Print the IRAM and DRAM totals of the linked firmware"""
+    elf = str(target[0])
+    if not os.path.isfile(elf):
+        return
+
+    print_banner("IRAM Budget Report")
+
+    try:
+        sections = read_sections(elf)
+    except (OSError, subprocess.CalledProcessError) as error:
+        print(f"  Could not read sections: {error}")
+        return
+
+    iram = {name: value for name, value in sections.items() if name.startswith(".iram0")}
+    dram = {name: value for name, value in sections.items() if name.startswith(".dram0")}
+    iram_total = sum(size for size, _ in iram.values())
+    dram_total = sum(size for size, _ in dram.values())
+
+    for name, (size, _) in sorted(iram.items()) + sorted(dram.items()):
+        print(f"  {name:<20} {size:>8} bytes")
+    print(f"  {'IRAM total':<20} {iram_total:>8} bytes")
+    print(f"  {'DRAM static':<20} {dram_total:>8} bytes")
+
+    budget = int(env.GetProjectOption("custom_iram_budget", str(DEFAULT_BUDGET)))
+    print(f"  {'IRAM budget':<20} {budget:>8} bytes ({iram_total * 100 // max(budget, 1)}% used)")
+
+    text = [(address, address + size) for name, (size, address) in iram.items() if name.endswith(".text")]
+    try:
+        top = largest_in(elf, text)
+    except (OSError, subprocess.CalledProcessError):
+        top = []
+    if top:
+        print("\n  Largest IRAM functions:")
+        for size, name in top:
+            print(f"  {size:>8}  {name}")
+
+    if iram_total > budget:
+        message = (f"IRAM {iram_total} bytes is over the {budget} byte budget: "
+                   "build with -D EARS_LVGL_IRAM=0 or move EARS_HOT code back to flash")
+        if env.GetProjectOption("custom_iram_budget_strict", "no").lower() in ("yes", "true", "1"):
+            print(f"\n  ERROR: {message}\n")
+            env.Exit(1)
+        print(f"\n  WARNING: {message}")
+    print()
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", iram_report)
@@ -0,0 +1,80 @@
+"""
+Audit Trail Verifier
+Walks the hash chain of an EARS audit log (EARS_auditLib) from genesis and lists its entries
+Each entry's hash is SHA-256(previous hash || the entry up to its hash), starting from 32 zero bytes
+Checkpoint signatures need the device key and are checked on the unit, not here
+Run on the host: python scripts/verify_audit.py audit.log [--list]
+"""
+
+import hashlib
+import struct
+import sys
+from datetime import datetime, timezone
+
+# Mirrors EARS_auditEntry in EARS_auditLib.h
+HEADER = struct.Struct("<IIHBBIH2x")
+DATA_SIZE = 128
+HASH_SIZE = 32
+ENTRY_SIZE = HEADER.size + DATA_SIZE + HASH_SIZE
+
+EVENTS = {0: "genesis", 1: "create", 2: "update", 3: "delete", 4: "import"}
+RECORD_TYPES = {1: "equipment", 2: "ammunition"}
+
+
+def describe(index, time, event, record_type, flags, subject, length, data):
+    """One line for an entry"""
+    when = datetime.fromtimestamp(time, timezone.utc).strftime("%Y-%m-%d %H:%M:%S") if time else "-"
+    name = EVENTS.get(event, f"event {event}")
+    text = f"{index:8d}  {when}  {name:8s}"
+    if event == 4:
+        first, end = struct.unpack_from("<II", data)
+        text += f"  {RECORD_TYPES.get(record_type, '?')} journal records {first}..{end - 1}"
+    elif subject or record_type:
+        text += f"  {RECORD_TYPES.get(record_type, '?')} ID {subject} flags 0x{flags:02x}"
+    elif length:
+        text += f"  {length} bytes"
+    return text
+
+
+def verify(data, listing):
+    """Check every link, returns (entries, first bad index or None)"""
+    if len(data) % ENTRY_SIZE:
+        print(f"  torn last entry: {len(data) % ENTRY_SIZE} bytes ignored", file=sys.stderr)
+
+    previous = bytes(HASH_SIZE)
+    count = len(data) // ENTRY_SIZE
+    for i in range(count):
+        entry = data[i * ENTRY_SIZE:(i + 1) * ENTRY_SIZE]
+        hashed = entry[:-HASH_SIZE]
+        fields = HEADER.unpack_from(hashed)
+        digest = hashlib.sha256(previous + hashed).digest()
+        if fields[0] != i or digest != entry[-HASH_SIZE:]:
+            return count, i
+        if listing:
+            print(describe(*fields, hashed[HEADER.size:]))
+        previous = digest
+    return count, None
+
+
+def main():
+    args = [a for a in sys.argv[1:] if not a.startswith("--")]
+    if len(args) != 1:
+        print("Usage: python verify_audit.py <audit.log> [--list]")
+        sys.exit(1)
+
+    try:
+        with open(args[0], "rb") as f:
+            data = f.read()
+    except FileNotFoundError:
+        print(f"✗ ERROR: File not found: {args[0]}", file=sys.stderr)
+        sys.exit(1)
+
+    count, bad = verify(data, "--list" in sys.argv)
+    if bad is not None:
+        print(f"✗ {args[0]}: chain broken at entry {bad} of {count}", file=sys.stderr)
+        sys.exit(2)
+    print(f"✓ {args[0]}: {count} entries, chain intact", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,278 @@
+/**
+ * @file bench_main.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Headless UI benchmarks for the native_bench environment
+ * @details Runs the EEZ UI, the flow runtime and MAIN_lvglLib on the host with
+ *          the in-memory panel from sim/stubs, and reports:
+ *          - screen creation: ui_init() (EEZ screens plus flow start)
+ *          - flow tick: ui_tick() with nothing to redraw
+ *          - redraw: a full-screen invalidate rendered and flushed
+ *          - number format: MAIN_numberFormatLib checked against snprintf
+ *            on hard roundings (halves, values near one) and a seeded sweep
+ *          One "BENCH" line per benchmark is printed for CI to compare, and
+ *          the process exits non-zero if the UI could not be brought up or
+ *          a formatter disagreed with snprintf.
+ *
+ *          Host timings are not device timings; compare runs of the same
+ *          machine against each other, not against the ESP32-S3.
+ *
+ *          Usage: program [iterations]   (default BENCH_DEFAULT_ITERATIONS)
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <lvgl.h>
+#include "EARS_ws35tlcdPins.h"
+#include "MAIN_flowHeapLib.h"
+#include "MAIN_lvglLib.h"
+#include "MAIN_numberFormatLib.h"
+#include "ui/ui.h"
+
+/******************************************************************************
+ * Benchmark Configuration
+ *****************************************************************************/
+
+#define BENCH_DEFAULT_ITERATIONS 200
+
+// Seeded values per number format check, and mismatches printed
+#define BENCH_FORMAT_VALUES 200000
+#define BENCH_FORMAT_SHOWN 10
+
+/******************************************************************************
+ * Type Definitions
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t iterations;
+    uint64_t totalUs;
+    uint32_t minUs;
+    uint32_t maxUs;
+} bench_result_t;
+
+/******************************************************************************
+ * Internal Functions
+ *****************************************************************************/
+
+/**
+ * @brief Start an empty result
+ */
+static void bench_reset(bench_result_t *r)
+{
+    r->iterations = 0;
+    r->totalUs = 0;
+    r->minUs = UINT32_MAX;
+    r->maxUs = 0;
+}
+
+/**
+ * @brief Add one timed run
+ */
+static void bench_add(bench_result_t *r, uint32_t us)
+{
+    r->iterations++;
+    r->totalUs += us;
+    r->minUs = (us < r->minUs) ? us : r->minUs;
+    r->maxUs = (us > r->maxUs) ? us : r->maxUs;
+}
+
+/**
+ * @brief Print one machine-readable result line
+ */
+static void bench_report(const char *name, const bench_result_t *r)
+{
+    uint32_t avgUs = r->iterations ? (uint32_t)(r->totalUs / r->iterations) : 0;
+    printf("BENCH %-14s iterations=%lu avg_us=%lu min_us=%lu max_us=%lu\n", name, (unsigned long)r->iterations,
+           (unsigned long)avgUs, (unsigned long)(r->iterations ? r->minUs : 0), (unsigned long)r->maxUs);
+}
+
+/**
+ * @brief Time ui_init(): EEZ screen creation and flow start
+ */
+static void bench_screen_create(void)
+{
+    bench_result_t r;
+    bench_reset(&r);
+
+    int64_t start = esp_timer_get_time();
+    ui_init();
+    bench_add(&r, (uint32_t)(esp_timer_get_time() - start));
+
+    bench_report("screen_create", &r);
+}
+
+/**
+ * @brief Time ui_tick() with the screen already drawn
+ */
+static void bench_flow_tick(uint32_t iterations)
+{
+    bench_result_t r;
+    bench_reset(&r);
+
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        int64_t start = esp_timer_get_time();
+        ui_tick();
+        bench_add(&r, (uint32_t)(esp_timer_get_time() - start));
+    }
+
+    bench_report("flow_tick", &r);
+}
+
+/**
+ * @brief Time a full-screen render and flush to the in-memory panel
+ */
+static void bench_redraw(lv_display_t *disp, uint32_t iterations)
+{
+    bench_result_t r;
+    bench_reset(&r);
+
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        lv_obj_invalidate(lv_screen_active());
+        int64_t start = esp_timer_get_time();
+        lv_refr_now(disp);
+        bench_add(&r, (uint32_t)(esp_timer_get_time() - start));
+    }
+
+    bench_report("redraw_full", &r);
+}
+
+/**
+ * @brief Compare one value's fixed and %g text with snprintf
+ * @return uint32_t Mismatches (0 to 2)
+ */
+static uint32_t bench_format_check(double value, int decimals, uint32_t shown)
+{
+    char ours[64];
+    char libc[64];
+    uint32_t bad = 0;
+
+    MAIN_format_fixed(ours, sizeof(ours), value, decimals);
+    snprintf(libc, sizeof(libc), "%.*f", decimals, value);
+    if (strcmp(ours, libc) != 0)
+    {
+        if (shown + bad < BENCH_FORMAT_SHOWN)
+            printf("BENCH MISMATCH fixed %.17g %d: %s, snprintf %s\n", value, decimals, ours, libc);
+        bad++;
+    }
+
+    MAIN_format_general(ours, sizeof(ours), value);
+    snprintf(libc, sizeof(libc), "%g", value);
+    if (strcmp(ours, libc) != 0)
+    {
+        if (shown + bad < BENCH_FORMAT_SHOWN)
+            printf("BENCH MISMATCH general %.17g: %s, snprintf %s\n", value, ours, libc);
+        bad++;
+    }
+    return bad;
+}
+
+/**
+ * @brief Check MAIN_numberFormatLib against snprintf, then time it
+ * @details Values are decimal fractions and exact halves at each scale,
+ *          where a once-rounded product lands on or next to .5, plus
+ *          magnitudes either side of the 2^53 fast-path limit. The seed is
+ *          fixed, so a mismatch reproduces.
+ * @return uint32_t Mismatches
+ */
+static uint32_t bench_number_format(uint32_t iterations)
+{
+    static const double edges[] = {0.05, -0.005, 0.015, 2.5, 0.125, 1.0005, 9007199254740991.0,
+                                   9007199254740993.0, 1e17 + 8, 123456789012.345678, 0.0, -0.0};
+    uint32_t bad = 0;
+
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++)
+    {
+        for (int decimals = 0; decimals <= NUMBER_FORMAT_MAX_DECIMALS; decimals++)
+        {
+            bad += bench_format_check(edges[i], decimals, bad);
+        }
+    }
+
+    uint64_t seed = 0x2545F4914F6CDD1DULL;
+    for (uint32_t i = 0; i < BENCH_FORMAT_VALUES; i++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        int64_t digits = (int64_t)(seed % 2000001) - 1000000;
+        int scale = (int)((seed >> 32) % 10);
+        double value = (i & 1) ? digits / pow(10.0, scale) : digits * 0.5 / pow(10.0, scale);
+        bad += bench_format_check(value, (int)((seed >> 40) % (NUMBER_FORMAT_MAX_DECIMALS + 1)), bad);
+    }
+
+    bench_result_t r;
+    bench_reset(&r);
+    char text[32];
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        int64_t start = esp_timer_get_time();
+        for (int j = 0; j < 100; j++)
+        {
+            MAIN_format_fixed(text, sizeof(text), j * 1.25 - 40.0, 2);
+        }
+        bench_add(&r, (uint32_t)(esp_timer_get_time() - start));
+    }
+    bench_report("number_format", &r);
+    printf("BENCH %-14s checked=%lu mismatches=%lu\n", "format_check",
+           (unsigned long)(BENCH_FORMAT_VALUES + sizeof(edges) / sizeof(edges[0]) * (NUMBER_FORMAT_MAX_DECIMALS + 1)),
+           (unsigned long)bad);
+    return bad;
+}
+
+/******************************************************************************
+ * Entry Point
+ *****************************************************************************/
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_ITERATIONS;
+    if (iterations == 0)
+    {
+        iterations = BENCH_DEFAULT_ITERATIONS;
+    }
+
+    static Arduino_GFX panel(TFT_WIDTH, TFT_HEIGHT);
+    static uint8_t unused_mutex_token;
+    SemaphoreHandle_t displayMutex = (SemaphoreHandle_t)&unused_mutex_token;
+
+    if (!MAIN_initialise_lvgl(&panel, displayMutex, TFT_WIDTH, TFT_HEIGHT))
+    {
+        printf("BENCH ERROR: LVGL initialisation failed\n");
+        return 1;
+    }
+
+    bench_screen_create();
+
+    // Settle the first frame so the tick benchmark sees a clean screen
+    lv_refr_now(MAIN_get_lvgl_display());
+    MAIN_lvgl_reset_stats();
+
+    bench_flow_tick(iterations);
+    bench_redraw(MAIN_get_lvgl_display(), iterations);
+
+    MAIN_lvgl_stats_t s;
+    MAIN_lvgl_get_stats(&s);
+    uint32_t avgFlushUs = s.flushCalls ? (uint32_t)(s.totalFlushUs / s.flushCalls) : 0;
+    printf("BENCH %-14s calls=%lu avg_us=%lu max_us=%lu bytes=%llu pixels=%llu\n", "flush", (unsigned long)s.flushCalls,
+           (unsigned long)avgFlushUs, (unsigned long)s.maxFlushUs, (unsigned long long)s.bytesFlushed,
+           (unsigned long long)panel.pixelsWritten());
+
+    MAIN_flow_heap_stats_t heap;
+    MAIN_flow_heap_get_stats(&heap);
+    printf("BENCH %-14s pooled_peak=%lu large_peak=%lu failures=%lu\n", "flow_heap", (unsigned long)heap.pooledPeak,
+           (unsigned long)heap.largePeak, (unsigned long)heap.failures);
+
+    return (bench_number_format(iterations) == 0) ? 0 : 1;
+}
+
+/******************************************************************************
+ * End of bench_main.cpp
+ ******************************************************************************/
@@ -0,0 +1,58 @@
+/**
+ * @file EARS_loggerLib.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Host stand-in for the SD card logger (native_bench only)
+ * @details Same class and calls as lib/EARS_loggerLib for the parts the UI
+ *          libraries use. There is no card: entries at or above the level go
+ *          to stdout.
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __EARS_LOGGER_LIB_H__
+#define __EARS_LOGGER_LIB_H__
+
+#include <Arduino.h>
+
+enum class LogLevel {
+    NONE = 0,   // No logging
+    ERROR = 1,  // Only errors
+    WARN = 2,   // Warnings and above
+    INFO = 3,   // Info and above
+    DEBUG = 4   // Everything (most verbose)
+};
+
+class EARS_logger {
+public:
+    static EARS_logger& getInstance()
+    {
+        static EARS_logger instance;
+        return instance;
+    }
+
+    void setLogLevel(LogLevel level) { _level = level; }
+    bool wouldLog(LogLevel level) const { return level != LogLevel::NONE && level <= _level; }
+
+    void error(const char* message) { write(LogLevel::ERROR, "ERROR", message); }
+    void warn(const char* message) { write(LogLevel::WARN, "WARN", message); }
+    void info(const char* message) { write(LogLevel::INFO, "INFO", message); }
+    void debug(const char* message) { write(LogLevel::DEBUG, "DEBUG", message); }
+
+private:
+    EARS_logger() : _level(LogLevel::NONE) {}
+
+    void write(LogLevel level, const char* tag, const char* message)
+    {
+        if (wouldLog(level))
+        {
+            Serial.printf("[%s] %s\n", tag, message);
+        }
+    }
+
+    LogLevel _level;
+};
+
+#endif // __EARS_LOGGER_LIB_H__
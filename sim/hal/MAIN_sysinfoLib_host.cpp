@@ -0,0 +1,79 @@
+/**
+ * @file MAIN_sysinfoLib_host.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Host stand-in for MAIN_sysinfoLib (native_bench only)
+ * @details Implements the part of lib/MAIN_sysinfoLib/MAIN_sysinfoLib.h the
+ *          UI libraries call, against the real header. The host has no
+ *          PSRAM and no touch panel, so the latency probe records nothing.
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MAIN_sysinfoLib.h"
+#include <esp_heap_caps.h>
+
+/******************************************************************************
+ * Memory Information Functions
+ *****************************************************************************/
+
+uint32_t MAIN_sysinfo_get_free_heap(void)
+{
+    return (uint32_t)heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+}
+
+uint32_t MAIN_sysinfo_get_free_psram(void)
+{
+    return 0;
+}
+
+bool MAIN_sysinfo_has_psram(void)
+{
+    return false;
+}
+
+/******************************************************************************
+ * Latency Probe Functions
+ *****************************************************************************/
+
+void MAIN_sysinfo_latency_input(uint32_t inputUs, uint32_t dispatchUs)
+{
+    (void)inputUs;
+    (void)dispatchUs;
+}
+
+void MAIN_sysinfo_latency_frame(uint32_t renderStartUs, uint32_t doneUs)
+{
+    (void)renderStartUs;
+    (void)doneUs;
+}
+
+/******************************************************************************
+ * Helper Functions
+ *****************************************************************************/
+
+String MAIN_sysinfo_format_bytes(uint32_t bytes)
+{
+    char text[24];
+    if (bytes >= 1024UL * 1024UL)
+    {
+        snprintf(text, sizeof(text), "%.2f MB", bytes / (1024.0f * 1024.0f));
+    }
+    else if (bytes >= 1024UL)
+    {
+        snprintf(text, sizeof(text), "%.2f KB", bytes / 1024.0f);
+    }
+    else
+    {
+        snprintf(text, sizeof(text), "%lu B", (unsigned long)bytes);
+    }
+    return String(text);
+}
+
+/******************************************************************************
+ * End of MAIN_sysinfoLib_host.cpp
+ ******************************************************************************/
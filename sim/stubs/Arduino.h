@@ -0,0 +1,123 @@
+/**
+ * @file Arduino.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Host stand-in for the arduino-esp32 core (native_bench only)
+ * @details Just enough of the core for the UI, flow and LVGL libraries to
+ *          build on a desktop: time from the monotonic clock, a String that
+ *          wraps std::string and a Serial that writes to stdout.
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __SIM_ARDUINO_H__
+#define __SIM_ARDUINO_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdarg.h>
+
+#ifdef __cplusplus
+#include <string>
+#endif
+
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/******************************************************************************
+ * Time
+ *****************************************************************************/
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+/******************************************************************************
+ * String
+ *****************************************************************************/
+
+class String
+{
+public:
+    String() {}
+    String(const char *text) : _text(text ? text : "") {}
+    String(const std::string &text) : _text(text) {}
+    String(int value) : _text(std::to_string(value)) {}
+    String(unsigned int value) : _text(std::to_string(value)) {}
+    String(long value) : _text(std::to_string(value)) {}
+    String(unsigned long value) : _text(std::to_string(value)) {}
+
+    const char *c_str() const { return _text.c_str(); }
+    size_t length() const { return _text.length(); }
+    String &operator+=(const String &other)
+    {
+        _text += other._text;
+        return *this;
+    }
+    String operator+(const String &other) const { return String(_text + other._text); }
+    bool operator==(const String &other) const { return _text == other._text; }
+
+private:
+    std::string _text;
+};
+
+/******************************************************************************
+ * Serial
+ *****************************************************************************/
+
+class HostSerial
+{
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    size_t print(const char *text) { return fputs(text, stdout) >= 0 ? strlen(text) : 0; }
+    size_t print(const String &text) { return print(text.c_str()); }
+    size_t print(long value) { return printf("%ld", value); }
+    size_t println(void) { return print("\n"); }
+    size_t println(const char *text) { return print(text) + println(); }
+    size_t println(const String &text) { return println(text.c_str()); }
+    size_t println(long value) { return print(value) + println(); }
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)))
+    {
+        va_list args;
+        va_start(args, format);
+        int written = vprintf(format, args);
+        va_end(args);
+        return (written > 0) ? (size_t)written : 0;
+    }
+    size_t write(uint8_t c) { return (fputc(c, stdout) != EOF) ? 1 : 0; }
+    void flush(void) { fflush(stdout); }
+    operator bool() const { return true; }
+};
+
+extern HostSerial Serial;
+
+#endif // __cplusplus
+
+#endif // __SIM_ARDUINO_H__
+
+/******************************************************************************
+ * End of Arduino.h
+ ******************************************************************************/
@@ -0,0 +1,108 @@
+/**
+ * @file Arduino_GFX_Library.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Headless display for the host (native_bench only)
+ * @details Stands in for the GFX Library for Arduino panel driver that
+ *          MAIN_lvglLib flushes to. Bitmaps are copied into an RGB565 frame
+ *          buffer in RAM, so the flush path does its real work (one copy
+ *          per pixel) without a window, and the frame can be checked or
+ *          dumped after a benchmark.
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __SIM_ARDUINO_GFX_LIBRARY_H__
+#define __SIM_ARDUINO_GFX_LIBRARY_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+class Arduino_GFX
+{
+public:
+    Arduino_GFX(int16_t w, int16_t h) : _width(w), _height(h), _pixelsWritten(0)
+    {
+        _frame = (uint16_t *)calloc((size_t)w * h, sizeof(uint16_t));
+    }
+    virtual ~Arduino_GFX() { free(_frame); }
+
+    bool begin(int32_t speed = 0)
+    {
+        (void)speed;
+        return _frame != NULL;
+    }
+
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+
+    /**
+     * @brief Copy a bitmap into the frame buffer (clipped to the panel)
+     */
+    void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h)
+    {
+        for (int16_t row = 0; row < h; row++)
+        {
+            int32_t py = y + row;
+            if (py < 0 || py >= _height)
+            {
+                continue;
+            }
+
+            int32_t x0 = (x < 0) ? 0 : x;
+            int32_t x1 = (x + w > _width) ? _width : x + w;
+            if (x1 > x0)
+            {
+                memcpy(&_frame[py * _width + x0], &bitmap[row * w + (x0 - x)], (size_t)(x1 - x0) * 2);
+                _pixelsWritten += (uint64_t)(x1 - x0);
+            }
+        }
+    }
+
+    /**
+     * @brief Copy a big-endian bitmap (LVGL RGB565_SWAPPED) into the frame
+     * @details The host frame stays native RGB565, so this swaps each pixel
+     *          back; the device driver writes the bytes out unchanged.
+     */
+    void draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h)
+    {
+        for (int16_t row = 0; row < h; row++)
+        {
+            int32_t py = y + row;
+            if (py < 0 || py >= _height)
+            {
+                continue;
+            }
+
+            for (int32_t px = (x < 0) ? 0 : x; px < x + w && px < _width; px++)
+            {
+                uint16_t v = bitmap[row * w + (px - x)];
+                _frame[py * _width + px] = (uint16_t)((v >> 8) | (v << 8));
+                _pixelsWritten++;
+            }
+        }
+    }
+
+    void fillScreen(uint16_t color)
+    {
+        for (int32_t i = 0; i < (int32_t)_width * _height; i++)
+        {
+            _frame[i] = color;
+        }
+    }
+
+    // Host-only: what reached the "panel"
+    const uint16_t *frame() const { return _frame; }
+    uint64_t pixelsWritten() const { return _pixelsWritten; }
+
+private:
+    int16_t _width;
+    int16_t _height;
+    uint16_t *_frame;
+    uint64_t _pixelsWritten;
+};
+
+#endif // __SIM_ARDUINO_GFX_LIBRARY_H__
@@ -0,0 +1,38 @@
+/**
+ * @file Preferences.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Host stand-in for the Arduino NVS preferences (native_bench only)
+ * @details The host has no NVS: begin() fails, reads return the default
+ *          and writes store nothing, as on a board with an unreadable
+ *          partition.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class Preferences
+{
+public:
+    bool begin(const char *name, bool readOnly = false, const char *partition = NULL)
+    {
+        (void)name;
+        (void)readOnly;
+        (void)partition;
+        return false;
+    }
+    void end() {}
+
+    bool getBool(const char *key, bool defaultValue = false) { (void)key; return defaultValue; }
+    uint8_t getUChar(const char *key, uint8_t defaultValue = 0) { (void)key; return defaultValue; }
+    uint32_t getUInt(const char *key, uint32_t defaultValue = 0) { (void)key; return defaultValue; }
+
+    size_t putBool(const char *key, bool value) { (void)key; (void)value; return 0; }
+    size_t putUChar(const char *key, uint8_t value) { (void)key; (void)value; return 0; }
+    size_t putUInt(const char *key, uint32_t value) { (void)key; (void)value; return 0; }
+};
@@ -0,0 +1,16 @@
+/**
+ * @file esp_attr.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Host stand-in for ESP-IDF section attributes (native_bench only)
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+
+// There is one kind of RAM on the host
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_NOINIT_ATTR
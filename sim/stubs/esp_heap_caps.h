@@ -0,0 +1,44 @@
+/**
+ * @file esp_heap_caps.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Host stand-in for the ESP-IDF capability heaps (native_bench only)
+ * @details Every capability is served by malloc. There is no PSRAM, so
+ *          MALLOC_CAP_SPIRAM requests fail and the libraries take their
+ *          internal-RAM paths, as on a board without PSRAM.
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_EXEC (1 << 0)
+#define MALLOC_CAP_32BIT (1 << 1)
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void *heap_caps_malloc(size_t size, uint32_t caps);
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps);
+void *heap_caps_realloc(void *ptr, size_t size, uint32_t caps);
+void heap_caps_free(void *ptr);
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+void heap_caps_malloc_extmem_enable(size_t limit);
+bool heap_caps_check_integrity_all(bool print_errors);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,20 @@
+/**
+ * @file esp_memory_utils.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Host stand-in for the ESP-IDF address checks (native_bench only)
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+// No PSRAM on the host
+static inline bool esp_ptr_external_ram(const void *p)
+{
+    (void)p;
+    return false;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file esp_partition.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Host stand-in for the ESP-IDF partition API (native_bench only)
+ * @details There is no flash: no partition is ever found, so
+ *          MAIN_assetPackLib reports an empty pack and its users fall back.
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+
+typedef enum
+{
+    ESP_PARTITION_TYPE_APP = 0x00,
+    ESP_PARTITION_TYPE_DATA = 0x01
+} esp_partition_type_t;
+
+typedef int esp_partition_subtype_t;
+
+typedef enum
+{
+    SPI_FLASH_MMAP_DATA,
+    SPI_FLASH_MMAP_INST
+} spi_flash_mmap_memory_t;
+
+typedef uint32_t spi_flash_mmap_handle_t;
+
+typedef struct
+{
+    esp_partition_type_t type;
+    esp_partition_subtype_t subtype;
+    uint32_t address;
+    uint32_t size;
+    char label[17];
+} esp_partition_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char *label);
+esp_err_t esp_partition_read(const esp_partition_t *partition, size_t offset, void *dst, size_t size);
+esp_err_t esp_partition_mmap(const esp_partition_t *partition, size_t offset, size_t size,
+                             spi_flash_mmap_memory_t memory, const void **outPtr,
+                             spi_flash_mmap_handle_t *outHandle);
+void spi_flash_munmap(spi_flash_mmap_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
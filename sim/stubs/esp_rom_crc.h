@@ -0,0 +1,31 @@
+/**
+ * @file esp_rom_crc.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Host stand-in for the ESP32 ROM CRC routines (native_bench only)
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief CRC-32 (little-endian, as the ROM computes it)
+ * @param crc Running CRC (0 to start)
+ * @param buf Data
+ * @param len Bytes
+ * @return uint32_t Updated CRC
+ */
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
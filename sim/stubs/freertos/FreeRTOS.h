@@ -0,0 +1,70 @@
+/**
+ * @file FreeRTOS.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Host stand-in for FreeRTOS (native_bench only)
+ * @details The benchmarks run in one thread, so there is nothing to
+ *          schedule: task creation fails (the libraries fall back to doing
+ *          the work inline, e.g. MAIN_lvglLib's blocking flush), queues are
+ *          not available, and mutexes and semaphores always succeed. The
+ *          *CreateStatic calls behave the same; their Static*_t buffers
+ *          are only sized placeholders, never touched.
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __SIM_FREERTOS_H__
+#define __SIM_FREERTOS_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Types and Constants
+ *****************************************************************************/
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL pdFALSE
+#define pdPASS pdTRUE
+
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define configTICK_RATE_HZ 1000
+#define configMAX_TASK_NAME_LEN 16
+#define configMAX_PRIORITIES 25
+
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+// Caller-provided memory for the *CreateStatic calls
+typedef struct
+{
+    void *dummy[16];
+} StaticTask_t;
+typedef struct
+{
+    void *dummy[8];
+} StaticQueue_t;
+typedef StaticQueue_t StaticSemaphore_t;
+
+// Critical sections guard nothing in a single thread
+typedef struct
+{
+    int owner;
+} portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {0}
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+#define portENTER_CRITICAL_ISR(mux) ((void)(mux))
+#define portEXIT_CRITICAL_ISR(mux) ((void)(mux))
+#define portYIELD_FROM_ISR() ((void)0)
+
+#endif // __SIM_FREERTOS_H__
@@ -0,0 +1,38 @@
+/**
+ * @file queue.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Host stand-in for FreeRTOS queues (native_bench only)
+ * @version 1.1.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __SIM_FREERTOS_QUEUE_H__
+#define __SIM_FREERTOS_QUEUE_H__
+
+#include "FreeRTOS.h"
+
+typedef struct sim_queue *QueueHandle_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Always NULL: a queue needs a consumer task, and there is none
+ */
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+QueueHandle_t xQueueCreateStatic(UBaseType_t length, UBaseType_t itemSize, uint8_t *storage,
+                                 StaticQueue_t *buffer);
+void vQueueDelete(QueueHandle_t queue);
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks);
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SIM_FREERTOS_QUEUE_H__
@@ -0,0 +1,55 @@
+/**
+ * @file task.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Host stand-in for FreeRTOS tasks (native_bench only)
+ * @version 1.2.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+#ifndef __SIM_FREERTOS_TASK_H__
+#define __SIM_FREERTOS_TASK_H__
+
+#include "FreeRTOS.h"
+
+typedef struct sim_task *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+// Single-threaded host: critical sections reduce to the port no-ops
+#define taskENTER_CRITICAL(mux) portENTER_CRITICAL(mux)
+#define taskEXIT_CRITICAL(mux) portEXIT_CRITICAL(mux)
+#define taskENTER_CRITICAL_ISR(mux) portENTER_CRITICAL_ISR(mux)
+#define taskEXIT_CRITICAL_ISR(mux) portEXIT_CRITICAL_ISR(mux)
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Always fails: the host runs every benchmark in one thread
+ */
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char *name, uint32_t stackDepth, void *parameter,
+                                   UBaseType_t priority, TaskHandle_t *handle, BaseType_t core);
+BaseType_t xTaskCreate(TaskFunction_t code, const char *name, uint32_t stackDepth, void *parameter,
+                       UBaseType_t priority, TaskHandle_t *handle);
+TaskHandle_t xTaskCreateStaticPinnedToCore(TaskFunction_t code, const char *name, uint32_t stackDepth,
+                                           void *parameter, UBaseType_t priority, StackType_t *stack,
+                                           StaticTask_t *tcb, BaseType_t core);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t *previousWake, TickType_t period);
+TickType_t xTaskGetTickCount(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+BaseType_t xPortGetCoreID(void);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SIM_FREERTOS_TASK_H__
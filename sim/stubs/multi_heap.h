@@ -0,0 +1,33 @@
+/**
+ * @file multi_heap.h
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Host stand-in for the ESP-IDF region heap (native_bench only)
+ * @details A registered region only sets the budget: blocks come from
+ *          malloc, counted against the region's size, so a full flow heap
+ *          fails as it would on the board.
+ * @version 1.0.0
+ * @date 20261015
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct multi_heap_info *multi_heap_handle_t;
+
+multi_heap_handle_t multi_heap_register(void *start, size_t size);
+void *multi_heap_malloc(multi_heap_handle_t heap, size_t size);
+void multi_heap_free(multi_heap_handle_t heap, void *p);
+size_t multi_heap_get_allocated_size(multi_heap_handle_t heap, void *p);
+size_t multi_heap_free_size(multi_heap_handle_t heap);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,409 @@
+/**
+ * @file sim_platform.cpp
+ * @author Julian (51fiftyone51fiftyone@gmail.com)
+ * @brief Host implementations behind the native_bench framework stand-ins
+ * @version 1.0.0
+ * @date 20261014
+ *
+ * @copyright Copyright (c) 2026 JTB. All rights reserved.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <multi_heap.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+#include <freertos/semphr.h>
+#include <chrono>
+#include <thread>
+
+/******************************************************************************
+ * Static Variables (internal to the stand-ins)
+ *****************************************************************************/
+
+HostSerial Serial;
+
+static const std::chrono::steady_clock::time_point sim_start = std::chrono::steady_clock::now();
+
+// Any non-NULL handle will do; nothing is ever contended
+static int sim_semaphore_token;
+static int sim_task_token;
+
+/******************************************************************************
+ * Time
+ *****************************************************************************/
+
+int64_t esp_timer_get_time(void)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sim_start)
+        .count();
+}
+
+unsigned long millis(void)
+{
+    return (unsigned long)(esp_timer_get_time() / 1000);
+}
+
+unsigned long micros(void)
+{
+    return (unsigned long)esp_timer_get_time();
+}
+
+void delay(uint32_t ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+/******************************************************************************
+ * Heap
+ *****************************************************************************/
+
+void *heap_caps_malloc(size_t size, uint32_t caps)
+{
+    // No PSRAM on the host
+    return (caps & MALLOC_CAP_SPIRAM) ? NULL : malloc(size);
+}
+
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps)
+{
+    return (caps & MALLOC_CAP_SPIRAM) ? NULL : calloc(n, size);
+}
+
+void *heap_caps_realloc(void *ptr, size_t size, uint32_t caps)
+{
+    return (caps & MALLOC_CAP_SPIRAM) ? NULL : realloc(ptr, size);
+}
+
+void heap_caps_free(void *ptr)
+{
+    free(ptr);
+}
+
+size_t heap_caps_get_free_size(uint32_t caps)
+{
+    return (caps & MALLOC_CAP_SPIRAM) ? 0 : 8 * 1024 * 1024;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps)
+{
+    return heap_caps_get_free_size(caps);
+}
+
+void heap_caps_malloc_extmem_enable(size_t limit)
+{
+    (void)limit;
+}
+
+bool heap_caps_check_integrity_all(bool print_errors)
+{
+    (void)print_errors;
+    return true;
+}
+
+// Region heap: the region holds only the budget, blocks come from malloc
+struct multi_heap_info
+{
+    size_t size;
+    size_t used;
+};
+
+// Block header, two words so payloads keep malloc's alignment
+#define SIM_HEAP_HEADER (2 * sizeof(size_t))
+
+multi_heap_handle_t multi_heap_register(void *start, size_t size)
+{
+    if (start == NULL || size < sizeof(multi_heap_info))
+    {
+        return NULL;
+    }
+    multi_heap_info *heap = (multi_heap_info *)start;
+    heap->size = size - sizeof(multi_heap_info);
+    heap->used = 0;
+    return heap;
+}
+
+void *multi_heap_malloc(multi_heap_handle_t heap, size_t size)
+{
+    if (heap == NULL || size > heap->size - heap->used)
+    {
+        return NULL;
+    }
+    size_t *block = (size_t *)malloc(SIM_HEAP_HEADER + size);
+    if (block == NULL)
+    {
+        return NULL;
+    }
+    block[0] = size;
+    heap->used += size;
+    return (uint8_t *)block + SIM_HEAP_HEADER;
+}
+
+void multi_heap_free(multi_heap_handle_t heap, void *p)
+{
+    if (p == NULL)
+    {
+        return;
+    }
+    size_t *block = (size_t *)((uint8_t *)p - SIM_HEAP_HEADER);
+    heap->used -= block[0];
+    free(block);
+}
+
+size_t multi_heap_get_allocated_size(multi_heap_handle_t heap, void *p)
+{
+    (void)heap;
+    return ((size_t *)((uint8_t *)p - SIM_HEAP_HEADER))[0];
+}
+
+size_t multi_heap_free_size(multi_heap_handle_t heap)
+{
+    return heap->size - heap->used;
+}
+
+/******************************************************************************
+ * FreeRTOS
+ *****************************************************************************/
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char *name, uint32_t stackDepth, void *parameter,
+                                   UBaseType_t priority, TaskHandle_t *handle, BaseType_t core)
+{
+    (void)code;
+    (void)name;
+    (void)stackDepth;
+    (void)parameter;
+    (void)priority;
+    (void)core;
+    if (handle != NULL)
+    {
+        *handle = NULL;
+    }
+    return pdFAIL;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char *name, uint32_t stackDepth, void *parameter,
+                       UBaseType_t priority, TaskHandle_t *handle)
+{
+    return xTaskCreatePinnedToCore(code, name, stackDepth, parameter, priority, handle, tskNO_AFFINITY);
+}
+
+TaskHandle_t xTaskCreateStaticPinnedToCore(TaskFunction_t code, const char *name, uint32_t stackDepth,
+                                           void *parameter, UBaseType_t priority, StackType_t *stack,
+                                           StaticTask_t *tcb, BaseType_t core)
+{
+    (void)stack;
+    (void)tcb;
+    TaskHandle_t handle;
+    xTaskCreatePinnedToCore(code, name, stackDepth, parameter, priority, &handle, core);
+    return handle;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task)
+{
+    (void)task;
+    return 0;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    (void)task;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    delay(ticks);
+}
+
+void vTaskDelayUntil(TickType_t *previousWake, TickType_t period)
+{
+    TickType_t wake = *previousWake + period;
+    TickType_t now = xTaskGetTickCount();
+    if ((int32_t)(wake - now) > 0)
+    {
+        delay(wake - now);
+    }
+    *previousWake = wake;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)millis();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return (TaskHandle_t)&sim_task_token;
+}
+
+BaseType_t xPortGetCoreID(void)
+{
+    return 0;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    (void)task;
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks)
+{
+    (void)clearOnExit;
+    (void)ticks;
+    return 1;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+    (void)length;
+    (void)itemSize;
+    return NULL;
+}
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t length, UBaseType_t itemSize, uint8_t *storage,
+                                 StaticQueue_t *buffer)
+{
+    (void)storage;
+    (void)buffer;
+    return xQueueCreate(length, itemSize);
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    (void)queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks)
+{
+    (void)queue;
+    (void)item;
+    (void)ticks;
+    return pdFAIL;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks)
+{
+    (void)queue;
+    (void)item;
+    (void)ticks;
+    return pdFAIL;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return (SemaphoreHandle_t)&sim_semaphore_token;
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void)
+{
+    return (SemaphoreHandle_t)&sim_semaphore_token;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return (SemaphoreHandle_t)&sim_semaphore_token;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *buffer)
+{
+    (void)buffer;
+    return xSemaphoreCreateBinary();
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount)
+{
+    (void)maxCount;
+    (void)initialCount;
+    return (SemaphoreHandle_t)&sim_semaphore_token;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks)
+{
+    (void)ticks;
+    return (semaphore != NULL) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    return (semaphore != NULL) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t semaphore, TickType_t ticks)
+{
+    return xSemaphoreTake(semaphore, ticks);
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t semaphore)
+{
+    return xSemaphoreGive(semaphore);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore)
+{
+    (void)semaphore;
+}
+
+/******************************************************************************
+ * Flash
+ *****************************************************************************/
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char *label)
+{
+    (void)type;
+    (void)subtype;
+    (void)label;
+    return NULL;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *partition, size_t offset, void *dst, size_t size)
+{
+    (void)partition;
+    (void)offset;
+    (void)dst;
+    (void)size;
+    return ESP_FAIL;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t *partition, size_t offset, size_t size,
+                             spi_flash_mmap_memory_t memory, const void **outPtr,
+                             spi_flash_mmap_handle_t *outHandle)
+{
+    (void)partition;
+    (void)offset;
+    (void)size;
+    (void)memory;
+    (void)outPtr;
+    (void)outHandle;
+    return ESP_FAIL;
+}
+
+void spi_flash_munmap(spi_flash_mmap_handle_t handle)
+{
+    (void)handle;
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    crc = ~crc;
+    for (uint32_t i = 0; i < len; i++)
+    {
+        crc ^= buf[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+/******************************************************************************
+ * End of sim_platform.cpp
+ ******************************************************************************/
@@ -41,39 +41,84 @@
 
 // 4. EARS LIBRARY HEADERS (alphabetical within group)
 #include "EARS_backLightManagerLib.h"
+#include "EARS_bleTransferLib.h"
+#include "EARS_configLib.h"
 #include "EARS_hapticLib.h"
 #include "EARS_nvsEepromLib.h"
+#include "EARS_otaLib.h"
+#include "EARS_rtosTraceLib.h"
 #include "EARS_screenSaverLib.h"
 #include "EARS_sdCardLib.h"
+#include "EARS_taskPlanLib.h"
+#include "EARS_timeLib.h"
 #include "EARS_touchLib.h"
+#include "EARS_traceLib.h"
 
 // 5. MAIN LIBRARY HEADERS (alphabetical)
-// #include "MAIN_animationLib.h" // NEW! Startup animation
+#include "MAIN_animationLib.h"
+#include "MAIN_assetPackLib.h"
+#include "MAIN_benchmarkLib.h"
+#include "MAIN_bootProfilerLib.h"
+#include "MAIN_consoleLib.h"
 #include "MAIN_core0TasksLib.h"
 #include "MAIN_core1TasksLib.h"
+#include "MAIN_crashLib.h"
+#include "MAIN_developmentFeaturesLib.h"
+#include "MAIN_displayEspLcd.h"
 #include "MAIN_displayLib.h"
 #include "MAIN_drawingLib.h"
+#include "MAIN_flowTaskLib.h"
+#include "MAIN_glyphCacheLib.h"
+#include "MAIN_healthLib.h"
+#include "MAIN_i18nLib.h"
+#include "MAIN_imageAssetsLib.h"
+#include "MAIN_imageCacheLib.h"
+#include "MAIN_inputReplayLib.h"
 #include "MAIN_initializationLib.h"
+#include "MAIN_jpegDecoderLib.h"
 #include "MAIN_lvglLib.h"
+#include "MAIN_lvglLogLib.h"
+#include "MAIN_lvglMemLib.h"
+#include "MAIN_memPlanLib.h"
+#include "MAIN_memTelemetryLib.h"
+#include "MAIN_mirrorLib.h"
+#include "MAIN_pngDecoderLib.h"
+#include "MAIN_powerLib.h"
+#include "MAIN_powerMonitorLib.h"
+#include "MAIN_rtosStaticLib.h"
+#include "MAIN_scannerLib.h"
+#include "MAIN_sdFsLib.h"
+#include "MAIN_soakLib.h"
+#include "MAIN_splashLib.h"
+#include "MAIN_resumeLib.h"
+#include "MAIN_statusBarLib.h"
+#include "MAIN_dialogLib.h"
+#include "MAIN_lockLib.h"
+#include "MAIN_svgCacheLib.h"
 #include "MAIN_sysinfoLib.h"
+#include "MAIN_telemetryLib.h"
+#include "MAIN_themeLib.h"
+#include "MAIN_transformCacheLib.h"
+#include "MAIN_transitionLib.h"
+#include "MAIN_usbMscLib.h"
 
 // 6. DEVELOPMENT TOOLS (compile out in production)
 #if EARS_DEBUG == 1
 #include "MAIN_ledLib.h"
-#include "MAIN_developmentFeaturesLib.h"
 #endif
 
-// ============================================================================
-// DISPLAY SETTINGS
-// ============================================================================
-static const uint32_t screenWidth = TFT_WIDTH;
-static const uint32_t screenHeight = TFT_HEIGHT;
-
 // ============================================================================
 // ARDUINO GFX DISPLAY OBJECT
 // ============================================================================
+#if EARS_DISPLAY_BACKEND == EARS_DISPLAY_BACKEND_ESP_LCD
+// esp_lcd queued DMA backend; no Arduino_DataBus, so no SPI calibration
+Arduino_DataBus *bus = NULL;
+Arduino_GFX *gfx = new MAIN_EspLcdGFX(LCD_DC, LCD_CS, SPI_SCLK, SPI_MOSI, SPI_MISO, TFT_HEIGHT, TFT_WIDTH,
+                                      MAIN_DISPLAY_ROTATION, true);
+#else
 Arduino_DataBus *bus = new Arduino_ESP32SPI(LCD_DC, LCD_CS, SPI_SCLK, SPI_MOSI, SPI_MISO);
-Arduino_GFX *gfx = new Arduino_ST7796(bus, LCD_RST, 1, true, TFT_HEIGHT, TFT_WIDTH);
+Arduino_GFX *gfx = new Arduino_ST7796(bus, LCD_RST, MAIN_DISPLAY_ROTATION, true, TFT_HEIGHT, TFT_WIDTH);
+#endif
 
 // ============================================================================
 // FREERTOS CONFIGURATION
@@ -81,17 +126,251 @@ Arduino_GFX *gfx = new Arduino_ST7796(bus, LCD_RST, 1, true, TFT_HEIGHT, TFT_WID
 TaskHandle_t Core0_Task_Handle = NULL;
 TaskHandle_t Core1_Task_Handle = NULL;
 SemaphoreHandle_t xDisplayMutex = NULL;
+static StaticSemaphore_t xDisplayMutexBuffer;
 
 // ============================================================================
-// GLOBAL ANIMATION OBJECT (shared between setup and Core0 task)
+// BOOT STAGES - Run by MAIN_boot_run(), Core 1 and a Core 0 worker
 // ============================================================================
-// lv_obj_t *g_animation_img = NULL;
+enum BootStage
+{
+    BOOT_DISPLAY,
+    BOOT_LVGL,
+    BOOT_GRAPHICS,
+    BOOT_TOUCH_PROBE,
+    BOOT_TOUCH,
+    BOOT_CLOCK,
+    BOOT_POWER,
+    BOOT_NVS,
+    BOOT_FLASHFS,
+    BOOT_SD,
+    BOOT_ERRORS,
+    BOOT_RECORDS,
+    BOOT_IMAGES,
+    BOOT_THEME,
+    BOOT_LANGUAGE,
+    BOOT_STAGE_COUNT
+};
+
+// STEP 1 + STEP 6: Initialize display with PWM backlight. setup() has
+// normally done this already, to show the splash before the Serial wait
+static bool display_ready = false;
+
+static bool boot_display()
+{
+    if (!display_ready)
+    {
+        display_ready = MAIN_initialise_display(gfx, bus);
+    }
+    return display_ready;
+}
+
+// STEP 2: Initialize LVGL
+static bool boot_lvgl()
+{
+    // Width and height follow the rotation boot_display() wrote to MADCTL
+    if (!MAIN_initialise_lvgl(gfx, xDisplayMutex, gfx->width(), gfx->height()))
+    {
+        return false;
+    }
+
+    // LVGL messages go to EARS_logger, rate limited (level from ears.config below)
+    MAIN_initialise_lvgl_log();
+
+    // 'S' drive on the SD card, usable once the sd stage has mounted it
+    MAIN_initialise_sd_fs();
+    return true;
+}
+
+static bool boot_graphics()
+{
+    // Decoded SD images are kept in PSRAM instead of decoded on every redraw
+    MAIN_initialise_image_cache();
+
+    // SVG icons are rasterised once per size and blitted after that
+    MAIN_initialise_svg_cache();
+
+    // Rotated and zoomed images are drawn from variants made on Core 1
+    MAIN_initialise_transform_cache();
+
+    // Expanded large-font glyphs are kept in PSRAM (see MAIN_fontLib)
+    MAIN_initialise_glyph_cache();
+
+    // JPEG pictures decoded by the ROM TJpgDec straight into RGB565
+    MAIN_initialise_jpeg_decoder();
+
+    // PNG pictures inflated a scanline at a time, no full-size intermediate
+    MAIN_initialise_png_decoder();
+
+    // An asset pack downloaded by the OTA task is copied into place first
+    using_ota().applyStagedAssets();
+
+    // Packed images and fonts, mapped from the assets flash partition
+    MAIN_initialise_asset_pack();
+
+    // Screen changes animate snapshots held in PSRAM (see MAIN_transitionLib)
+    MAIN_initialise_transitions();
+
+    // Screen background and text from the shared theme styles (TRUE_BLACK
+    // background); the ears.config theme is applied once the config is read
+    MAIN_initialise_theme();
+    MAIN_theme_apply_screen(lv_screen_active());
+
+#if EARS_DEBUG == 1
+    Serial.println("[OK] Screen styled by the theme");
+#endif
+    return true;
+}
+
+// STEP 7: Touch controller over I2C, then its LVGL input device
+static bool boot_touch_probe()
+{
+    MAIN_probe_touch();
+    return true;
+}
+
+// Wall clock from the RTC on the touch I2C bus; NTP once Wi-Fi is up
+static bool boot_clock()
+{
+    using_time().begin(TOUCH_SDA, TOUCH_SCL);
+    return true;
+}
+
+static bool boot_touch()
+{
+    MAIN_initialise_touch();
+    return true;
+}
+
+// Screensaver owns idle detection; the power lib supplies its deep idle
+// hooks (panel sleep, CPU scaling, light sleep)
+static bool boot_power()
+{
+    using_screensaver().begin(MAIN_get_lvgl_display());
+    MAIN_initialise_power(gfx, xDisplayMutex);
+
+    // Panel frame rate, idle mode and backlight scale follow the refresh governor
+    MAIN_initialise_display_power(gfx, bus, xDisplayMutex);
+    return true;
+}
+
+// STEP 4: Initialize NVS (validation with CRC)
+static bool boot_nvs()
+{
+    MAIN_initialise_nvs();
+    return true;
+}
+
+// ears.config from LittleFS in internal flash: no card, no SD_MMC wait
+static bool boot_flashfs()
+{
+    MAIN_initialise_flashfs();
+    return true;
+}
+
+// STEP 5: Initialize SD Card (mount, CID read)
+static bool boot_sd()
+{
+    MAIN_initialise_sd();
+
+    // Firmware and asset pack updates from a URL or the card
+    using_ota().begin(&using_sdcard());
+
+    // USB drive interface, media absent until the card is lent (usb_msc build)
+    MAIN_initialise_usb_msc();
+    return true;
+}
+
+// Error messages from errors.json (built-in table without a card)
+static bool boot_errors()
+{
+    MAIN_initialise_errors();
+    return true;
+}
+
+// Equipment and ammunition stores (index checkpoint + replay)
+static bool boot_records()
+{
+    MAIN_initialise_records();
+
+#if EARS_SCANNER == 1
+    // Barcode scans are looked up in the stores just opened
+    MAIN_initialise_scanner();
+#endif
+    return true;
+}
+
+// Native LVGL images from the SD card's /images (no decode at draw time)
+static bool boot_images()
+{
+    MAIN_initialise_image_assets();
+    return true;
+}
+
+// ears.config display.theme: one style pointer swap, one refresh
+static bool boot_theme()
+{
+    if (using_config().isLoaded())
+    {
+        MAIN_theme_set_by_name(using_config().display().theme);
+        MAIN_lvgl_log_set_level_name(using_config().logger().lvglLogLevel);
+    }
+    return true;
+}
+
+// ears.config application.language: packs are in the asset partition
+static bool boot_language()
+{
+    MAIN_initialise_i18n(using_config().isLoaded() ? using_config().application().language : NULL);
+    return true;
+}
+
+// Latency probe start point: INT edge or I2C read of the last touch sample
+static uint32_t touch_input_us()
+{
+    return using_touch().getLastInputUs();
+}
+
+static const MAIN_boot_stage_t boot_stages[BOOT_STAGE_COUNT] = {
+    {"display", boot_display, 0, BOOT_MAIN_TASK | BOOT_CRITICAL},
+    {"lvgl", boot_lvgl, BOOT_AFTER(BOOT_DISPLAY), BOOT_MAIN_TASK | BOOT_CRITICAL},
+    {"graphics", boot_graphics, BOOT_AFTER(BOOT_LVGL), BOOT_MAIN_TASK},
+    {"touch probe", boot_touch_probe, 0, 0},
+    {"touch indev", boot_touch, BOOT_AFTER(BOOT_LVGL) | BOOT_AFTER(BOOT_TOUCH_PROBE), BOOT_MAIN_TASK},
+    {"clock", boot_clock, BOOT_AFTER(BOOT_TOUCH_PROBE), 0},
+    {"screensaver", boot_power, BOOT_AFTER(BOOT_LVGL) | BOOT_AFTER(BOOT_TOUCH), BOOT_MAIN_TASK},
+    {"nvs", boot_nvs, 0, 0},
+    {"flashfs", boot_flashfs, 0, 0},
+    {"sd", boot_sd, 0, 0},
+    {"errors", boot_errors, BOOT_AFTER(BOOT_SD) | BOOT_AFTER(BOOT_FLASHFS), 0},
+    {"records", boot_records, BOOT_AFTER(BOOT_SD), 0},
+    {"images", boot_images, BOOT_AFTER(BOOT_LVGL) | BOOT_AFTER(BOOT_SD), BOOT_MAIN_TASK},
+    {"theme", boot_theme, BOOT_AFTER(BOOT_GRAPHICS) | BOOT_AFTER(BOOT_FLASHFS), BOOT_MAIN_TASK},
+    {"language", boot_language, BOOT_AFTER(BOOT_GRAPHICS) | BOOT_AFTER(BOOT_FLASHFS), 0},
+};
 
 // ============================================================================
 // ARDUINO SETUP - Runs once on Core 1
 // ============================================================================
 void setup()
 {
+    // Timeline in RTC memory, persisted to the SD card after the first frame
+    MAIN_boot_profile_begin();
+
+    // PSRAM malloc() threshold, and the pool budgets checked before any buffer
+    MAIN_initialise_mem_plan();
+
+    // Chip, MAC, flash and SDK strings, formatted once
+    MAIN_initialise_sysinfo();
+
+    // Core and priority of every task, fixed before the first is created
+    using_taskplan().begin();
+
+#if EARS_SPLASH == 1
+    // First light: panel up with the splash on it (MAIN_splashLib) while the
+    // rest of boot runs; the display stage below finds it ready
+    boot_display();
+#endif
+
 #if EARS_DEBUG == 1
     Serial.begin(EARS_DEBUG_BAUD_RATE);
     delay(500);
@@ -101,6 +380,10 @@ void setup()
 
     DEV_print_boot_banner();
     DEV_print_system_info();
+    using_taskplan().print();
+
+    // DEBUG_PRINT* output from here on is printed by a low-priority task
+    using_trace().begin();
 
     Serial.println("[INIT] Initializing development LEDs...");
     MAIN_led_init();
@@ -113,7 +396,7 @@ void setup()
     Serial.println("[INIT] Creating synchronization primitives...");
 #endif
 
-    xDisplayMutex = xSemaphoreCreateMutex();
+    xDisplayMutex = xSemaphoreCreateMutexStatic(&xDisplayMutexBuffer);
     if (xDisplayMutex == NULL)
     {
 #if EARS_DEBUG == 1
@@ -129,45 +412,59 @@ void setup()
     Serial.println("[OK] Synchronization primitives created");
 #endif
 
-    // STEP 1 + STEP 6: Initialize display with PWM backlight
-    if (!MAIN_initialise_display(gfx))
+    // STEPS 1, 2, 4, 5, 7: Display, LVGL, touch, NVS and SD, in parallel where
+    // they do not depend on each other (stage table above, report below)
+    if (!MAIN_boot_run(boot_stages, BOOT_STAGE_COUNT))
     {
 #if EARS_DEBUG == 1
-        Serial.println("[ERROR] Display initialization failed!");
+        Serial.println("[ERROR] Display or LVGL initialization failed!");
+        MAIN_boot_print_report();
         MAIN_led_red_on();
 #endif
         while (1)
             delay(1000);
     }
 
-    // STEP 2: Initialize LVGL
-    if (!MAIN_initialise_lvgl(gfx, xDisplayMutex, screenWidth, screenHeight))
-    {
 #if EARS_DEBUG == 1
-        Serial.println("[ERROR] LVGL initialization failed!");
-        MAIN_led_red_on();
+    MAIN_boot_print_report();
+    MAIN_mem_plan_print_report();
+    MAIN_lvgl_mem_print_report();
 #endif
-        while (1)
-            delay(1000);
-    }
 
-    // Set screen background to TRUE_BLACK
-    lv_obj_t *screen = lv_screen_active();
-    lv_obj_set_style_bg_color(screen, lv_color_hex(EARS_RGB888_TRUE_BLACK), LV_PART_MAIN);
+    // Clock, sync, SD and battery above every screen, sampled by Core 1
+    MAIN_initialise_status_bar();
+
+    // Message, confirm, keypad and keyboard built now, shown later without a build
+    MAIN_initialise_dialogs(DIALOG_BUILD_ALL);
+
+    // Performance HUD overlay, hidden until a long press in the top-left corner
+    DEV_hud_init();
 
+    // PIN lock over everything else, built hidden; locks after auto_lock_minutes
+    MAIN_initialise_lock();
+
+    // Touch-to-photon probe, recording once enabled (the HUD enables it too)
+    MAIN_lvgl_latency_attach(using_touch().getInputDevice(), touch_input_us);
 #if EARS_DEBUG == 1
-    Serial.println("[OK] Screen background set to EARS_RGB888_TRUE_BLACK");
+    MAIN_sysinfo_latency_enable(true);
 #endif
 
-    // STEP 7: Initialize Touch Controller (via MAIN_initializationLib)
-    MAIN_initialise_touch();
-
-    // STEP 4: Initialize NVS (via MAIN_initializationLib)
-    MAIN_initialise_nvs();
+#if EARS_INPUT_REPLAY != INPUT_REPLAY_OFF
+    // Input script recorded from here, or replayed from here with the frame stats
+    MAIN_initialise_input_replay(using_touch().getInputDevice(), EARS_INPUT_REPLAY);
+#endif
 
-    // STEP 5: Initialize SD Card (via MAIN_initializationLib)
-    MAIN_initialise_sd();
+#if EARS_BENCHMARK == 1
+    // Benchmark build: one pass while display, LVGL and the buses are ours
+    MAIN_benchmark_run(gfx, xDisplayMutex);
+#endif
 
+#if EARS_LVGL_BENCHMARK == 1
+    // LVGL benchmark build: lv_demo_benchmark in place of the startup
+    // animation and UI, kept awake so the screensaver cannot cut a scene short
+    using_screensaver().setEnabled(false);
+    MAIN_benchmark_lvgl_demo_start();
+#else
     // ========================================================================
     // STEP 8: Create Startup Animation - NEW!
     // ========================================================================
@@ -175,22 +472,34 @@ void setup()
     Serial.println("[INIT] Creating startup animation...");
 #endif
 
-    // g_animation_img = MAIN_create_startup_animation();
-
-    /*     if (g_animation_img == NULL)
-        {
-    #if EARS_DEBUG == 1
-            Serial.println("[WARNING] Failed to create startup animation");
-            Serial.println("          Continuing without animation");
-    #endif
-        }
-        else
-        {
-    #if EARS_DEBUG == 1
-            Serial.println("[OK] Startup animation created");
-    #endif
-        }
-     */
+    // Woken from deep sleep: the screen it slept on stays up instead, as
+    // the splash drew it (MAIN_resumeLib)
+    if (MAIN_resume_attach_snapshot(lv_screen_active()))
+    {
+#if EARS_DEBUG == 1
+        Serial.println("[OK] Resumed from deep sleep, startup animation skipped");
+#endif
+    }
+    // Paced by its own LVGL timer; deletes itself after
+    // ANIM_STARTUP_DURATION_MS (tasks are not running yet, so LVGL is ours)
+    else if (MAIN_create_startup_animation() == NULL)
+    {
+#if EARS_DEBUG == 1
+        Serial.println("[WARNING] Failed to create startup animation");
+        Serial.println("          Continuing without animation");
+#endif
+    }
+    else
+    {
+#if EARS_DEBUG == 1
+        Serial.println("[OK] Startup animation created");
+#endif
+    }
+#endif
+
+    // Task watchdog and heartbeat monitor; reports a stall left by the last boot
+    MAIN_initialise_health();
+
     // STEP 3: Create FreeRTOS tasks
 #if EARS_DEBUG == 1
     Serial.println("[INIT] Creating FreeRTOS tasks...");
@@ -218,7 +527,51 @@ void setup()
             delay(1000);
     }
 
+    // EEZ Flow worker on Core 1 (only with -D EARS_FLOW_TASK=1)
+    MAIN_initialise_flow_task();
+
+    MAIN_boot_profile_mark("tasks");
+    MAIN_boot_profile_complete();
+
+    // Heap fragmentation trend, sampled by Core 1
+    MAIN_initialise_mem_telemetry();
+
+    // Battery voltage by ADC DMA; charge and state go out as EVENT_BATTERY
+    MAIN_initialise_power_monitor();
+
+    // Long-run heap, CPU, frame rate, SD and battery history
+    MAIN_initialise_telemetry();
+
+    // Last seconds before a crash in RTC memory; core dump and timeline to the SD card
+    MAIN_initialise_crash();
+
+    // Serial commands (help, stats, heap, tasks, log, sdbench, screenshot, mirror) on a production unit
+    MAIN_initialise_console();
+
+    // Screen mirror and remote touch over Wi-Fi ("mirror on", or EARS_MIRROR=1)
+    MAIN_initialise_mirror(using_touch().getInputDevice());
+
+#if EARS_BLE_TRANSFER == 1
+    // Reports to a companion phone over BLE where there is no Wi-Fi
+    using_bletransfer().begin();
+#endif
+
+#if EARS_RTOS_TRACE == 1
+    // Task runs per core and flush/mutex/touch/log events, saved to /bench/trace.json
+    using_rtostrace().begin(RTOS_TRACE_ONE_SHOT);
+#endif
+
+#if EARS_SOAK == 1
+    // Sustained log, record, NVS and SD load with snapshots to /bench/soak.csv
+    MAIN_initialise_soak();
+#endif
+
 #if EARS_DEBUG == 1
+    // CPU per core and task stacks, reported periodically by Core 1
+    MAIN_sysinfo_profiler_watch_task(Core0_Task_Handle, CORE0_STACK_SIZE);
+    MAIN_sysinfo_profiler_watch_task(Core1_Task_Handle, CORE1_STACK_SIZE);
+    MAIN_sysinfo_profiler_begin(SYSINFO_PROFILE_PERIOD_MS);
+
     Serial.println("[OK] All tasks created");
     Serial.println("[INIT] System initialization complete");
     Serial.println("[ANIM] Marching soldier animation running!\n");
@@ -230,7 +583,8 @@ void setup()
 // ============================================================================
 void loop()
 {
-    delay(1000);
+    // setup() is done: return the loop task's stack to the heap
+    MAIN_rtos_end_loop_task();
 }
 
 // ============================================================================
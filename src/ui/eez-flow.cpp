@@ -45,40 +45,40 @@ void executeActionFunction(int actionId) {
 #include <math.h>
 #include <assert.h>
 #include <string.h>
+#if defined(EEZ_FOR_LVGL)
+#include "MAIN_flowHeapLib.h"
+#include "MAIN_flowTaskLib.h"
+#include "MAIN_transformCacheLib.h"
+#include "MAIN_transitionLib.h"
+#endif
+#if defined(EEZ_FOR_LVGL)
+#include "MAIN_jsonTapeLib.h"
+#endif
+#include "EARS_profileLib.h"
+#if defined(EEZ_MQTT_ADAPTER)
+#include "MAIN_mqttLib.h"
+#endif
 namespace eez {
 #if defined(EEZ_FOR_LVGL)
+// EARS: size-class pools on the flow's own heap (MAIN_flowHeapLib), not lv_malloc
 void initAllocHeap(uint8_t *heap, size_t heapSize) {
     EEZ_UNUSED(heap);
     EEZ_UNUSED(heapSize);
+    MAIN_initialise_flow_heap();
 }
 void *alloc(size_t size, uint32_t id) {
     EEZ_UNUSED(id);
-#if LVGL_VERSION_MAJOR >= 9
-    return lv_malloc(size);
-#else
-    return lv_mem_alloc(size);
-#endif
+    return MAIN_flow_heap_alloc(size);
 }
 void free(void *ptr) {
-#if LVGL_VERSION_MAJOR >= 9
-    lv_free(ptr);
-#else
-    lv_mem_free(ptr);
-#endif
+    MAIN_flow_heap_free(ptr);
 }
 template<typename T> void freeObject(T *ptr) {
 	ptr->~T();
-#if LVGL_VERSION_MAJOR >= 9
-    lv_free(ptr);
-#else
-	lv_mem_free(ptr);
-#endif
+    MAIN_flow_heap_free(ptr);
 }
 void getAllocInfo(uint32_t &free, uint32_t &alloc) {
-    lv_mem_monitor_t mon;
-    lv_mem_monitor(&mon);
-	free = mon.free_size;
-	alloc = mon.total_size - mon.free_size;
+    MAIN_flow_heap_get_info(&free, &alloc);
 }
 #elif defined(EEZ_DASHBOARD_API)
 #include <emscripten/heap.h>
@@ -347,7 +347,12 @@ static void allocMemoryForDecompressedAssets(const uint8_t *assetsData, uint32_t
     assert (header->tag == HEADER_TAG_COMPRESSED);
     uint32_t decompressedSize = header->decompressedSize;
     decompressedAssetsMemoryBufferSize = decompressedDataOffset + decompressedSize;
+#if defined(EEZ_FOR_LVGL)
+    // EARS: decompressed assets live as long as the flow, in PSRAM when present
+    decompressedAssetsMemoryBuffer = (uint8_t *)MAIN_flow_heap_alloc_bulk(decompressedAssetsMemoryBufferSize, nullptr);
+#else
     decompressedAssetsMemoryBuffer = (uint8_t *)eez::alloc(decompressedAssetsMemoryBufferSize, 0x587da194);
+#endif
 }
 #endif
 void loadMainAssets(const uint8_t *assets, uint32_t assetsSize) {
@@ -569,9 +574,7 @@ void initMemory() {
 #endif
 void initAssetsMemory() {
 #if defined(EEZ_FOR_LVGL)
-#if defined(LV_MEM_SIZE)
-    ALLOC_BUFFER_SIZE = LV_MEM_SIZE;
-#endif
+    ALLOC_BUFFER_SIZE = FLOW_HEAP_SIZE;
 #elif defined(EEZ_DASHBOARD_API)
     ALLOC_BUFFER_SIZE = emscripten_get_heap_max();
 #else
@@ -603,11 +606,7 @@ void initOtherMemory() {
 }
 uint8_t *allocBuffer(uint32_t size) {
 #if defined(EEZ_FOR_LVGL)
-#if LVGL_VERSION_MAJOR >= 9
-    return (uint8_t *)lv_malloc(size);
-#else
-    return (uint8_t *)lv_mem_alloc(size);
-#endif
+    return (uint8_t *)MAIN_flow_heap_alloc(size);
 #elif defined(EEZ_DASHBOARD_API)
     return (uint8_t *)::malloc(size);
 #else
@@ -660,6 +659,16 @@ uint32_t millis() {
     #error "Missing millis implementation";
 #endif
 }
+// EARS: microsecond clock for the flow tick budget
+uint32_t micros() {
+#if defined(EEZ_PLATFORM_ESP32)
+    return (uint32_t)esp_timer_get_time();
+#elif defined(ARDUINO)
+    return ::micros();
+#else
+    return millis() * 1000;
+#endif
+}
 } 
 // -----------------------------------------------------------------------------
 // core/unit.cpp
@@ -941,6 +950,17 @@ Unit getSmallestUnit(Unit unit, float min, float precision) {
 #if defined(EEZ_PLATFORM_STM32) && !defined(EEZ_FOR_LVGL)
 #include <crc.h>
 #endif
+// EARS: numbers are formatted by MAIN_numberFormatLib, without snprintf
+#if !defined(EEZ_FAST_NUMBER_FORMAT)
+#if defined(EEZ_FOR_LVGL)
+#define EEZ_FAST_NUMBER_FORMAT 1
+#else
+#define EEZ_FAST_NUMBER_FORMAT 0
+#endif
+#endif
+#if EEZ_FAST_NUMBER_FORMAT
+#include "MAIN_numberFormatLib.h"
+#endif
 namespace eez {
 float remap(float x, float x1, float y1, float x2, float y2) {
     return y1 + (x - x1) * (y2 - y1) / (x2 - x1);
@@ -1018,6 +1038,70 @@ void stringAppendStringLength(char *str, size_t maxStrLength, const char *value,
         strncat(str, value, n);
     }
 }
+#if EEZ_FAST_NUMBER_FORMAT
+void stringAppendInt(char *str, size_t maxStrLength, int value) {
+    auto n = strlen(str);
+    MAIN_format_int32(str + n, maxStrLength - n, value);
+}
+void stringAppendUInt32(char *str, size_t maxStrLength, uint32_t value) {
+    auto n = strlen(str);
+    MAIN_format_uint32(str + n, maxStrLength - n, value);
+}
+void stringAppendInt64(char *str, size_t maxStrLength, int64_t value) {
+    auto n = strlen(str);
+    MAIN_format_int64(str + n, maxStrLength - n, value);
+}
+void stringAppendUInt64(char *str, size_t maxStrLength, uint64_t value) {
+    auto n = strlen(str);
+    MAIN_format_uint64(str + n, maxStrLength - n, value);
+}
+void stringAppendFloat(char *str, size_t maxStrLength, float value) {
+    auto n = strlen(str);
+    MAIN_format_general(str + n, maxStrLength - n, value);
+}
+void stringAppendFloat(char *str, size_t maxStrLength, float value, int numDecimalPlaces) {
+    auto n = strlen(str);
+    MAIN_format_fixed(str + n, maxStrLength - n, value, numDecimalPlaces);
+}
+void stringAppendDouble(char *str, size_t maxStrLength, double value) {
+    auto n = strlen(str);
+    MAIN_format_general(str + n, maxStrLength - n, value);
+}
+void stringAppendDouble(char *str, size_t maxStrLength, double value, int numDecimalPlaces) {
+    auto n = strlen(str);
+    MAIN_format_fixed(str + n, maxStrLength - n, value, numDecimalPlaces);
+}
+void stringAppendVoltage(char *str, size_t maxStrLength, float value) {
+    auto n = strlen(str);
+    MAIN_format_with_unit(str + n, maxStrLength - n, value, "V");
+}
+void stringAppendCurrent(char *str, size_t maxStrLength, float value) {
+    auto n = strlen(str);
+    MAIN_format_with_unit(str + n, maxStrLength - n, value, "A");
+}
+void stringAppendPower(char *str, size_t maxStrLength, float value) {
+    auto n = strlen(str);
+    MAIN_format_with_unit(str + n, maxStrLength - n, value, "W");
+}
+void stringAppendDuration(char *str, size_t maxStrLength, float value) {
+    auto n = strlen(str);
+    if (value > 0.1) {
+        MAIN_format_with_unit(str + n, maxStrLength - n, value, "s");
+    } else {
+        MAIN_format_with_unit(str + n, maxStrLength - n, value * 1000, "ms");
+    }
+}
+void stringAppendLoad(char *str, size_t maxStrLength, float value) {
+    auto n = strlen(str);
+    if (value < 1000) {
+        MAIN_format_with_unit(str + n, maxStrLength - n, value, "ohm");
+    } else if (value < 1000000) {
+        MAIN_format_with_unit(str + n, maxStrLength - n, value / 1000, "Kohm");
+    } else {
+        MAIN_format_with_unit(str + n, maxStrLength - n, value / 1000000, "Mohm");
+    }
+}
+#else
 void stringAppendInt(char *str, size_t maxStrLength, int value) {
     auto n = strlen(str);
     snprintf(str + n, maxStrLength - n, "%d", value);
@@ -1080,6 +1164,7 @@ void stringAppendLoad(char *str, size_t maxStrLength, float value) {
         snprintf(str + n, maxStrLength - n, "%g Mohm", value / 1000000);
     }
 }
+#endif
 #if defined(EEZ_PLATFORM_STM32) && !defined(EEZ_FOR_LVGL)
 uint32_t crc32(const uint8_t *mem_block, size_t block_size) {
 	return HAL_CRC_Calculate(&hcrc, (uint32_t *)mem_block, block_size);
@@ -2053,6 +2138,16 @@ static const char *STRING_REF_value_type_name(const Value &value) {
     EEZ_UNUSED(value);
     return "string";
 }
+static bool compare_STRING_INLINE_value(const Value &a, const Value &b) {
+	return compare_STRING_value(a, b);
+}
+static void STRING_INLINE_value_to_text(const Value &value, char *text, int count) {
+	STRING_value_to_text(value, text, count);
+}
+static const char *STRING_INLINE_value_type_name(const Value &value) {
+    EEZ_UNUSED(value);
+    return "string";
+}
 static bool compare_BLOB_REF_value(const Value &a, const Value &b) {
     return a.type == b.type && a.refValue == b.refValue;
 }
@@ -2091,11 +2186,197 @@ static const char *WIDGET_value_type_name(const Value &value) {
     EEZ_UNUSED(value);
     return "widget";
 }
+#if defined(EEZ_FOR_LVGL)
+// EARS: JSON values are read-only. A string assigned to a json variable is kept as it is
+// and indexed into a tape (MAIN_jsonTapeLib) on the first member access; members resolve to
+// tape nodes, and only the scalars read are converted. The value's int is
+// generation:7 | slot:4 | node:20, so a stale value never reads a reused slot.
+#define JSON_TAPE_SLOTS 8
+#define JSON_TAPE_NODE_BITS 20
+#define JSON_TAPE_SLOT_BITS 4
+namespace flow {
+struct JsonTapeSlot {
+    Value source;
+    MAIN_json_tape_t tape;
+    uint16_t refs;
+    uint8_t generation;
+    bool indexed;
+    bool valid;
+};
+static JsonTapeSlot g_jsonTapes[JSON_TAPE_SLOTS];
+static JsonTapeSlot *jsonTapeSlot(int json, uint32_t &node) {
+    uint32_t id = (uint32_t)json;
+    uint32_t slotIndex = (id >> JSON_TAPE_NODE_BITS) & ((1U << JSON_TAPE_SLOT_BITS) - 1);
+    uint8_t generation = (uint8_t)(id >> (JSON_TAPE_NODE_BITS + JSON_TAPE_SLOT_BITS));
+    if (generation == 0 || slotIndex >= JSON_TAPE_SLOTS || g_jsonTapes[slotIndex].generation != generation || g_jsonTapes[slotIndex].refs == 0) {
+        return nullptr;
+    }
+    node = id & ((1U << JSON_TAPE_NODE_BITS) - 1);
+    return &g_jsonTapes[slotIndex];
+}
+static JsonTapeSlot *jsonTapeIndexed(int json, uint32_t &node) {
+    auto slot = jsonTapeSlot(json, node);
+    if (!slot) {
+        return nullptr;
+    }
+    if (!slot->indexed) {
+        const char *text = slot->source.getString();
+        slot->indexed = true;
+        slot->valid = MAIN_json_tape_index(&slot->tape, text, (uint32_t)strlen(text));
+    }
+    return slot->valid && node < slot->tape.count ? slot : nullptr;
+}
+static Value makeJsonTapeValue(JsonTapeSlot *slot, uint32_t node) {
+    if (node >= (1U << JSON_TAPE_NODE_BITS)) {
+        return Value::makeError();
+    }
+    slot->refs++;
+    uint32_t slotIndex = (uint32_t)(slot - g_jsonTapes);
+    return Value((int)(((uint32_t)slot->generation << (JSON_TAPE_NODE_BITS + JSON_TAPE_SLOT_BITS)) | (slotIndex << JSON_TAPE_NODE_BITS) | node), VALUE_TYPE_JSON);
+}
+static Value jsonTapeValue(JsonTapeSlot *slot, uint32_t node) {
+    auto tape = &slot->tape;
+    switch (MAIN_json_tape_type(tape, node)) {
+    case JSON_TAPE_FALSE:
+        return Value(false, VALUE_TYPE_BOOLEAN);
+    case JSON_TAPE_TRUE:
+        return Value(true, VALUE_TYPE_BOOLEAN);
+    case JSON_TAPE_NUMBER: {
+        double number;
+        bool isInteger;
+        MAIN_json_tape_number(tape, node, &number, &isInteger);
+        return isInteger ? Value((int)number, VALUE_TYPE_INT32) : Value(number, VALUE_TYPE_DOUBLE);
+    }
+    case JSON_TAPE_STRING: {
+        uint32_t length;
+        const char *raw = MAIN_json_tape_raw(tape, node, &length);
+        if (!memchr(raw, '\\', length)) {
+            return Value::makeStringRef(raw, (int)length, 0x3b0e51a4);
+        }
+        char *str = (char *)eez::alloc(length + 1, 0x3b0e51a5);
+        if (!str) {
+            return Value::makeError();
+        }
+        int32_t unescaped = MAIN_json_tape_string(tape, node, str, length + 1);
+        Value value = Value::makeStringRef(str, unescaped, 0x3b0e51a4);
+        eez::free(str);
+        return value;
+    }
+    case JSON_TAPE_ARRAY:
+    case JSON_TAPE_OBJECT:
+        return makeJsonTapeValue(slot, node);
+    default:
+        return Value(0, VALUE_TYPE_NULL);
+    }
+}
+void jsonTapeIncRef(int json) {
+    uint32_t node;
+    auto slot = jsonTapeSlot(json, node);
+    if (slot) {
+        slot->refs++;
+    }
+}
+void jsonTapeDecRef(int json) {
+    uint32_t node;
+    auto slot = jsonTapeSlot(json, node);
+    if (slot && --slot->refs == 0) {
+        MAIN_json_tape_free(&slot->tape);
+        slot->source = Value();
+        slot->indexed = false;
+        slot->valid = false;
+    }
+}
+Value convertToJson(const Value *value) {
+    if (!value->isString()) {
+        return Value::makeError();
+    }
+    for (uint32_t slotIndex = 0; slotIndex < JSON_TAPE_SLOTS; slotIndex++) {
+        auto slot = &g_jsonTapes[slotIndex];
+        if (slot->refs == 0) {
+            slot->source = *value;
+            slot->generation = (uint8_t)(slot->generation % 127 + 1);
+            slot->indexed = false;
+            slot->valid = false;
+            return makeJsonTapeValue(slot, 0);
+        }
+    }
+    return Value::makeError();
+}
+Value operationJsonGet(int json, const char *property) {
+    uint32_t node;
+    auto slot = jsonTapeIndexed(json, node);
+    if (!slot) {
+        return Value::makeError();
+    }
+    uint32_t member;
+    if (MAIN_json_tape_type(&slot->tape, node) == JSON_TAPE_ARRAY) {
+        char *end;
+        unsigned long index = strtoul(property, &end, 10);
+        member = (*property && !*end) ? MAIN_json_tape_element(&slot->tape, node, (uint32_t)index) : JSON_TAPE_NONE;
+    } else {
+        member = MAIN_json_tape_member(&slot->tape, node, property);
+    }
+    return member == JSON_TAPE_NONE ? Value() : jsonTapeValue(slot, member);
+}
+int operationJsonArrayLength(int json) {
+    uint32_t node;
+    auto slot = jsonTapeIndexed(json, node);
+    if (!slot || MAIN_json_tape_type(&slot->tape, node) != JSON_TAPE_ARRAY) {
+        return -1;
+    }
+    return MAIN_json_tape_size(&slot->tape, node);
+}
+Value convertFromJson(int json, uint32_t toType) {
+    uint32_t node;
+    auto slot = jsonTapeIndexed(json, node);
+    if (!slot) {
+        return Value::makeError();
+    }
+    auto type = MAIN_json_tape_type(&slot->tape, node);
+    if (type == JSON_TAPE_ARRAY || type == JSON_TAPE_OBJECT) {
+        if (toType != VALUE_TYPE_STRING) {
+            return Value::makeError();
+        }
+        uint32_t length;
+        const char *raw = MAIN_json_tape_raw(&slot->tape, node, &length);
+        return Value::makeStringRef(raw, (int)length, 0x3b0e51a6);
+    }
+    Value value = jsonTapeValue(slot, node);
+    if (toType == VALUE_TYPE_BOOLEAN) {
+        return Value(value.toBool(), VALUE_TYPE_BOOLEAN);
+    } else if (Value::isInt32OrLess(toType)) {
+        return Value((int)value.toInt32(), (ValueType)toType);
+    } else if (toType == VALUE_TYPE_FLOAT) {
+        return Value(value.toFloat(), VALUE_TYPE_FLOAT);
+    } else if (toType == VALUE_TYPE_DOUBLE) {
+        return Value(value.toDouble(), VALUE_TYPE_DOUBLE);
+    } else if (toType == VALUE_TYPE_STRING) {
+        return value.toString(0x3b0e51a7);
+    }
+    return value;
+}
+void jsonTapeToText(int json, char *text, int count) {
+    uint32_t node;
+    auto slot = jsonTapeIndexed(json, node);
+    if (!slot) {
+        snprintf(text, count, "json (id=%d)", json);
+        return;
+    }
+    uint32_t length;
+    const char *raw = MAIN_json_tape_raw(&slot->tape, node, &length);
+    snprintf(text, count, "%.*s", (int)length, raw);
+}
+} 
+#endif
 static bool compare_JSON_value(const Value &a, const Value &b) {
     return a.type == b.type && a.int32Value == b.int32Value;
 }
 static void JSON_value_to_text(const Value &value, char *text, int count) {
+#if defined(EEZ_FOR_LVGL)
+    flow::jsonTapeToText(value.getInt(), text, count);
+#else
     snprintf(text, count, "json (id=%d)", value.getInt());
+#endif
 }
 static const char *JSON_value_type_name(const Value &value) {
     EEZ_UNUSED(value);
@@ -2376,7 +2657,7 @@ bool assignValue(Value &dstValue, const Value &srcValue, uint32_t dstValueType)
         dstValue = Value(srcValue.toDouble(), VALUE_TYPE_DOUBLE);
     } else if (dstValueType == VALUE_TYPE_STRING) {
         dstValue = srcValue.toString(0x30a91156);
-#if defined(EEZ_DASHBOARD_API)
+#if defined(EEZ_DASHBOARD_API) || defined(EEZ_FOR_LVGL)
     } else if (dstValueType == VALUE_TYPE_JSON) {
         if (srcValue.isJson()) {
             dstValue = srcValue;
@@ -2426,6 +2707,14 @@ Value MakeEnumDefinitionValue(uint8_t enumValue, uint8_t enumDefinition) {
     return value;
 }
 const char *Value::getString() const {
+    // EARS: an inline string lives in the Value holding it, so look through pointers
+    // to that Value rather than at a copy of it
+    if (type == VALUE_TYPE_STRING_INLINE) {
+        return strInlineValue;
+    }
+    if (type == VALUE_TYPE_VALUE_PTR) {
+        return pValueValue->getString();
+    }
     auto value = getValue(); 
 	if (value.type == VALUE_TYPE_STRING_REF) {
 		return ((StringRef *)value.refValue)->str;
@@ -2433,6 +2722,14 @@ const char *Value::getString() const {
 	if (value.type == VALUE_TYPE_STRING) {
 		return value.strValue;
 	}
+    if (value.type == VALUE_TYPE_STRING_INLINE) {
+        // Only a temporary holds it (array element, native variable, property ref)
+        static char inlineStrings[4][EEZ_VALUE_INLINE_STRING_SIZE];
+        static uint8_t nextInlineString;
+        char *str = inlineStrings[nextInlineString++ % 4];
+        memcpy(str, value.strInlineValue, EEZ_VALUE_INLINE_STRING_SIZE);
+        return str;
+    }
 	return nullptr;
 }
 const ArrayValue *Value::getArray() const {
@@ -2745,6 +3042,31 @@ Value Value::toString(uint32_t id) const {
 		return *this;
 	}
     char tempStr[64];
+#if EEZ_FAST_NUMBER_FORMAT
+    if (type == VALUE_TYPE_DOUBLE) {
+        MAIN_format_general(tempStr, sizeof(tempStr), doubleValue);
+    } else if (type == VALUE_TYPE_FLOAT) {
+        MAIN_format_general(tempStr, sizeof(tempStr), floatValue);
+    } else if (type == VALUE_TYPE_INT8) {
+        MAIN_format_int32(tempStr, sizeof(tempStr), int8Value);
+    } else if (type == VALUE_TYPE_UINT8) {
+        MAIN_format_uint32(tempStr, sizeof(tempStr), uint8Value);
+    } else if (type == VALUE_TYPE_INT16) {
+        MAIN_format_int32(tempStr, sizeof(tempStr), int16Value);
+    } else if (type == VALUE_TYPE_UINT16) {
+        MAIN_format_uint32(tempStr, sizeof(tempStr), uint16Value);
+    } else if (type == VALUE_TYPE_INT32) {
+        MAIN_format_int32(tempStr, sizeof(tempStr), int32Value);
+    } else if (type == VALUE_TYPE_UINT32) {
+        MAIN_format_uint32(tempStr, sizeof(tempStr), uint32Value);
+    } else if (type == VALUE_TYPE_INT64) {
+        MAIN_format_int64(tempStr, sizeof(tempStr), int64Value);
+    } else if (type == VALUE_TYPE_UINT64) {
+        MAIN_format_uint64(tempStr, sizeof(tempStr), uint64Value);
+    } else {
+        toText(tempStr, sizeof(tempStr));
+    }
+#else
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable : 4474)
@@ -2782,17 +3104,90 @@ Value Value::toString(uint32_t id) const {
     }
 #ifdef _MSC_VER
 #pragma warning(pop)
+#endif
 #endif
 	return makeStringRef(tempStr, strlen(tempStr), id);
 }
+// EARS: short strings are stored inline; strings up to EEZ_VALUE_STRING_INTERN_MAX_LEN
+// share one StringRef through a direct-mapped table of EEZ_VALUE_STRING_INTERN_SIZE
+// entries, so repeated units, enum names and labels are allocated once. A slot is
+// only taken over once no Value but the table uses its string.
+#if !defined(EEZ_VALUE_STRING_INTERN_SIZE)
+#define EEZ_VALUE_STRING_INTERN_SIZE 64
+#endif
+#if !defined(EEZ_VALUE_STRING_INTERN_MAX_LEN)
+#define EEZ_VALUE_STRING_INTERN_MAX_LEN 32
+#endif
+static Value makeInlineString(const char *str, int len) {
+    Value value;
+    value.type = VALUE_TYPE_STRING_INLINE;
+    stringCopyLength(value.strInlineValue, len, str, len);
+    value.strInlineValue[len] = 0;
+    return value;
+}
+#if EEZ_VALUE_STRING_INTERN_SIZE > 0
+static Value g_internedStrings[EEZ_VALUE_STRING_INTERN_SIZE];
+static uint32_t g_internedStringHashes[EEZ_VALUE_STRING_INTERN_SIZE];
+static uint32_t hashInternedString(const char *str, int len) {
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < len; i++) {
+        hash = (hash ^ (uint8_t)str[i]) * 16777619u;
+    }
+    return hash;
+}
+static bool isInternableString(const char *str, int len) {
+    // Callers passing a shorter str fill the buffer in themselves; never share those
+    return len <= EEZ_VALUE_STRING_INTERN_MAX_LEN && memchr(str, 0, len) == nullptr;
+}
+static Value *findInternedString(const char *str, int len, uint32_t hash) {
+    auto &interned = g_internedStrings[hash % EEZ_VALUE_STRING_INTERN_SIZE];
+    if (
+        interned.type == VALUE_TYPE_STRING_REF &&
+        g_internedStringHashes[hash % EEZ_VALUE_STRING_INTERN_SIZE] == hash &&
+        strncmp(((StringRef *)interned.refValue)->str, str, len) == 0 &&
+        ((StringRef *)interned.refValue)->str[len] == 0
+    ) {
+        return &interned;
+    }
+    return nullptr;
+}
+static void internString(const Value &value, uint32_t hash) {
+    auto &interned = g_internedStrings[hash % EEZ_VALUE_STRING_INTERN_SIZE];
+    if (interned.type != VALUE_TYPE_STRING_REF || interned.refValue->refCounter == 1) {
+        interned = value;
+        g_internedStringHashes[hash % EEZ_VALUE_STRING_INTERN_SIZE] = hash;
+    }
+}
+#endif
+void Value::freeInternedStrings() {
+#if EEZ_VALUE_STRING_INTERN_SIZE > 0
+    for (unsigned i = 0; i < EEZ_VALUE_STRING_INTERN_SIZE; i++) {
+        g_internedStrings[i] = Value();
+    }
+#endif
+}
 Value Value::makeStringRef(const char *str, int len, uint32_t id) {
+	if (len == -1) {
+		len = strlen(str);
+	}
+    if (len < EEZ_VALUE_INLINE_STRING_SIZE) {
+        return makeInlineString(str, len);
+    }
+#if EEZ_VALUE_STRING_INTERN_SIZE > 0
+    bool internable = isInternableString(str, len);
+    uint32_t hash = 0;
+    if (internable) {
+        hash = hashInternedString(str, len);
+        auto interned = findInternedString(str, len, hash);
+        if (interned) {
+            return *interned;
+        }
+    }
+#endif
     auto stringRef = ObjectAllocator<StringRef>::allocate(id);
 	if (stringRef == nullptr) {
 		return Value(0, VALUE_TYPE_NULL);
 	}
-	if (len == -1) {
-		len = strlen(str);
-	}
     stringRef->str = (char *)alloc(len + 1, id + 1);
     if (stringRef->str == nullptr) {
         ObjectAllocator<StringRef>::deallocate(stringRef);
@@ -2805,9 +3200,23 @@ Value Value::makeStringRef(const char *str, int len, uint32_t id) {
     value.type = VALUE_TYPE_STRING_REF;
     value.options = VALUE_OPTIONS_REF;
     value.refValue = stringRef;
+#if EEZ_VALUE_STRING_INTERN_SIZE > 0
+    if (internable) {
+        internString(value, hash);
+    }
+#endif
 	return value;
 }
 Value Value::concatenateString(const Value &str1, const Value &str2) {
+    auto len1 = strlen(str1.getString());
+    auto len2 = strlen(str2.getString());
+    if (len1 + len2 <= EEZ_VALUE_STRING_INTERN_MAX_LEN) {
+        char str[EEZ_VALUE_STRING_INTERN_MAX_LEN + 1];
+        memcpy(str, str1.getString(), len1);
+        memcpy(str + len1, str2.getString(), len2);
+        str[len1 + len2] = 0;
+        return makeStringRef(str, len1 + len2, 0xbab14c6a);
+    }
     auto stringRef = ObjectAllocator<StringRef>::allocate(0xbab14c6a);;
 	if (stringRef == nullptr) {
 		return Value(0, VALUE_TYPE_NULL);
@@ -3024,6 +3433,7 @@ void setVar(int16_t id, const Value& value) {
         auto set = (void (*)(const char *))native_var.set;
         set(value.getString());
     }
+    flow::onNativeVariableChanged(id);
 }
 #endif 
 #endif 
@@ -3154,8 +3564,121 @@ void registerComponent(ComponentTypes componentType, ExecuteComponentFunctionTyp
 		g_executeComponentFunctions[componentType - defs_v3::COMPONENT_TYPE_START_ACTION] = executeComponentFunction;
 	}
 }
+#if defined(EEZ_FOR_LVGL)
+// EARS: with the flow worker task (MAIN_flowTaskLib) components that touch LVGL are
+// not run on the worker. They are posted to the UI task, which runs them under the
+// flow lock before lv_timer_handler; their outputs propagate from there as usual.
+// g_flowRunId tags each post so a command outliving a flow stop is dropped.
+static uint16_t g_flowRunId;
+static bool isUiComponent(FlowState *flowState, Component *component) {
+    if (component->type < defs_v3::COMPONENT_TYPE_START_ACTION || component->type >= defs_v3::FIRST_DASHBOARD_ACTION_COMPONENT_TYPE) {
+        return false;
+    }
+    auto executeComponentFunction = g_executeComponentFunctions[component->type - defs_v3::COMPONENT_TYPE_START_ACTION];
+    if (executeComponentFunction == executeCallActionComponent) {
+        return ((CallActionActionComponent *)component)->flowIndex >= (int)flowState->assets->flowDefinition->flows.count;
+    }
+    return
+        executeComponentFunction == executeShowPageComponent ||
+        executeComponentFunction == executeSelectLanguageComponent ||
+#if EEZ_OPTION_GUI
+        executeComponentFunction == executeSetPageDirectionComponent ||
+#endif
+        executeComponentFunction == executeAnimateComponent ||
+        executeComponentFunction == executeLVGLComponent ||
+        executeComponentFunction == executeLVGLUserWidgetComponent ||
+        executeComponentFunction == executeLVGLApiComponent ||
+        executeComponentFunction == executeSetColorThemeComponent;
+}
+static void executeDeferredUiComponent(void *ctx, uint32_t param) {
+    if (!MAIN_flow_lock(FLOW_LOCK_FOREVER)) {
+        return;
+    }
+    auto flowState = (FlowState *)ctx;
+    unsigned componentIndex = param & 0xFFFF;
+    if ((uint16_t)(param >> 16) == g_flowRunId && !isFlowStopped()) {
+        flowState->executingComponentIndex = componentIndex;
+        if (!flowState->error) {
+            executeComponent(flowState, componentIndex);
+        }
+        resetSequenceInputs(flowState);
+        decRefCounterForFlowState(flowState);
+        do {
+            if (!canFreeFlowState(flowState)) {
+                break;
+            }
+            auto temp = flowState->parentFlowState;
+            freeFlowState(flowState);
+            flowState = temp;
+        } while (flowState);
+    }
+    MAIN_flow_unlock();
+}
+static void deferUiComponent(FlowState *flowState, unsigned componentIndex) {
+    incRefCounterForFlowState(flowState);
+    if (!MAIN_flow_post_ui(executeDeferredUiComponent, flowState, componentIndex | ((uint32_t)g_flowRunId << 16))) {
+        decRefCounterForFlowState(flowState);
+        addToQueue(flowState, componentIndex, -1, -1, -1, true);
+    }
+}
+#endif
+#if EEZ_FLOW_PROFILER
+// EARS: per-component profiler (-D EEZ_FLOW_PROFILER=1). initProfile() lays out one
+// entry per component of every flow of the main assets (flow base + component index,
+// the indices EEZ Studio's debugger uses); each executeComponent() adds its time and
+// tick() adds how long the task waited in the queue. The table outlives stop() so a
+// dump after the flow has stopped still reads it; eez_flow_profile_write() streams it
+// as JSON.
+static Assets *g_profileAssets;
+static uint32_t *g_profileFlowBase;
+static ComponentProfile *g_profile;
+static uint32_t g_profileNumFlows;
+static uint32_t g_profileNumComponents;
+static uint32_t g_profileStartUs;
+static ComponentProfile *findComponentProfile(FlowState *flowState, unsigned componentIndex) {
+    if (!g_profile || flowState->assets != g_profileAssets || flowState->flowIndex >= g_profileNumFlows) {
+        return nullptr;
+    }
+    uint32_t entry = g_profileFlowBase[flowState->flowIndex] + componentIndex;
+    return entry < g_profileNumComponents ? &g_profile[entry] : nullptr;
+}
+static void recordComponentWait(FlowState *flowState, unsigned componentIndex, uint32_t waitUs) {
+    auto profile = findComponentProfile(flowState, componentIndex);
+    if (profile) {
+        profile->waitUs += waitUs;
+    }
+}
+struct ComponentProfileScope {
+    FlowState *flowState;
+    unsigned componentIndex;
+    uint32_t startUs;
+    ComponentProfileScope(FlowState *flowState_, unsigned componentIndex_)
+        : flowState(flowState_), componentIndex(componentIndex_), startUs(micros()) {}
+    ~ComponentProfileScope() {
+        uint32_t durationUs = micros() - startUs;
+        auto profile = findComponentProfile(flowState, componentIndex);
+        if (profile) {
+            profile->count++;
+            profile->totalUs += durationUs;
+            if (durationUs > profile->maxUs) {
+                profile->maxUs = durationUs;
+            }
+        }
+    }
+};
+#endif
 void executeComponent(FlowState *flowState, unsigned componentIndex) {
 	auto component = flowState->flow->components[componentIndex];
+#if defined(EEZ_FOR_LVGL)
+    if (MAIN_flow_task_is_current() && isUiComponent(flowState, component)) {
+        deferUiComponent(flowState, componentIndex);
+        return;
+    }
+#endif
+#if EEZ_FLOW_PROFILER
+    // Deferred components are timed when the UI task runs them
+    ComponentProfileScope profileScope(flowState, componentIndex);
+#endif
 	if (component->type >= defs_v3::FIRST_DASHBOARD_ACTION_COMPONENT_TYPE) {
 #if defined(EEZ_DASHBOARD_API)
         executeDashboardComponent(component->type, getFlowStateIndex(flowState), componentIndex);
@@ -3982,7 +4505,8 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
                     return;
                 }
                 if (specific->property == IMAGE_IMAGE || specific->property == LABEL_TEXT) {
-                    const char *strValue = value.toString(0xe42b3ca2).getString();
+                    value = value.toString(0xe42b3ca2);
+                    const char *strValue = value.getString();
                     if (specific->property == IMAGE_IMAGE) {
                         const void *src = getLvglImageByNameHook(strValue);
                         if (src) {
@@ -4254,7 +4778,8 @@ const char *getFullObjectName(FlowState *flowState, const char *objectName) {
         return; \
     }\
     propIndex++; \
-    const char *NAME = NAME##Value.toString(0xe42b3ca2).getString();
+    NAME##Value = NAME##Value.toString(0xe42b3ca2); \
+    const char *NAME = NAME##Value.getString();
 #define SCREEN_PROP(NAME) \
     Value NAME##Value; \
     if (!evalExpression(flowState, componentIndex, properties[propIndex]->evalInstructions, NAME##Value, FlowError::PropertyInAction(#NAME, actionName, actionIndex))) { \
@@ -4545,11 +5070,14 @@ ACTION_START(imageSetAngle)
     WIDGET_PROP(obj);
     INT16_PROP(angle);
     lv_img_set_angle(obj, angle);
+    // EARS: drawn from a pre-rotated variant once Core 1 has made it (MAIN_transformCacheLib)
+    MAIN_transform_cache_track(obj);
 ACTION_END
 ACTION_START(imageSetZoom)
     WIDGET_PROP(obj);
     UINT16_PROP(zoom);
     lv_img_set_zoom(obj, zoom);
+    MAIN_transform_cache_track(obj);
 ACTION_END
 ACTION_START(labelSetText)
     WIDGET_PROP(obj);
@@ -4688,10 +5216,21 @@ ACTION_START(animOpacity)
 ACTION_END
 ACTION_START(animImageZoom)
     ANIM_PROPS;
+    // EARS: the keyframes are known, so Core 1 makes the zoomed variants ahead of the frames
+    {
+        int32_t base = relative ? lv_img_get_zoom(obj) : 0;
+        int32_t angle = lv_img_get_angle(obj);
+        MAIN_transform_cache_prepare(obj, angle, angle, base + start, base + end);
+    }
     playAnimation(obj, start, end, delay, time, relative, instant, path, anim_callback_set_image_zoom, anim_callback_get_image_zoom);
 ACTION_END
 ACTION_START(animImageAngle)
     ANIM_PROPS;
+    {
+        int32_t base = relative ? lv_img_get_angle(obj) : 0;
+        int32_t zoom = lv_img_get_zoom(obj);
+        MAIN_transform_cache_prepare(obj, base + start, base + end, zoom, zoom);
+    }
     playAnimation(obj, start, end, delay, time, relative, instant, path, anim_callback_set_image_angle, anim_callback_get_image_angle);
 ACTION_END
 ACTION_START(createScreen)
@@ -5375,6 +5914,8 @@ int eez_mqtt_publish(void *handle, const char *topic, const char *payload) {
     }, eez::flow::g_wasmModuleId, handle, topic, payload);
 }
 }
+#endif
+#if defined(EEZ_STUDIO_FLOW_RUNTIME) || defined(EEZ_MQTT_ADAPTER)
 void eez_mqtt_on_event_callback(void *handle, EEZ_MQTT_Event event, void *eventData) {
     using namespace eez;
     using namespace eez::flow;
@@ -5427,6 +5968,21 @@ void eez_mqtt_on_event_callback(void *handle, EEZ_MQTT_Event event, void *eventD
         }
     }
 }
+#endif
+#if defined(EEZ_MQTT_ADAPTER)
+// EARS: MAIN_mqttLib queues esp-mqtt events; they are delivered here, on the flow's task
+static void deliverMqttEvent(void *handle, MAIN_mqtt_event_t event, const char *topic, const char *text) {
+    if (event == MAIN_MQTT_EVENT_MESSAGE) {
+        EEZ_MQTT_MessageEvent messageEvent;
+        messageEvent.topic = topic;
+        messageEvent.payload = text;
+        eez_mqtt_on_event_callback(handle, EEZ_MQTT_EVENT_MESSAGE, &messageEvent);
+    } else {
+        eez_mqtt_on_event_callback(handle, (EEZ_MQTT_Event)event, (void *)text);
+    }
+}
+#endif
+#ifdef EEZ_STUDIO_FLOW_RUNTIME
 EM_PORT_API(void) onMqttEvent(void *handle, EEZ_MQTT_Event event, void *eventDataPtr1, void *eventDataPtr2) {
     void *eventData;
     if (eventDataPtr1 && eventDataPtr2)  {
@@ -5652,6 +6208,7 @@ void executeShowPageComponent(FlowState *flowState, unsigned componentIndex) {
 // -----------------------------------------------------------------------------
 #include <string.h>
 #include <stdlib.h>
+#include <algorithm>
 namespace eez {
 namespace flow {
 SortArrayActionComponent *g_sortArrayActionComponent;
@@ -5701,21 +6258,233 @@ static int elementCompare(const void *a, const void *b) {
     }
     return result;
 }
-void sortArray(SortArrayActionComponent *component, ArrayValue *array) {
-    g_sortArrayActionComponent = component;
-    qsort(&array->values[0], array->arraySize, sizeof(Value), elementCompare);
-}
-void executeSortArrayComponent(FlowState *flowState, unsigned componentIndex) {
-    auto component = (SortArrayActionComponent *)flowState->flow->components[componentIndex];
-    Value srcArrayValue;
-    if (!evalProperty(flowState, componentIndex, defs_v3::SORT_ARRAY_ACTION_COMPONENT_PROPERTY_ARRAY, srcArrayValue, FlowError::Property("SortArray", "Array"))) {
-        return;
+// EARS: sort kernels by key type. The keys are pulled into one contiguous array
+// next to their element index and sorted there: int32 and float keys as
+// order-preserving uint32 by radix sort (stable, four byte passes), doubles and
+// strings by std::sort (introsort). The Values are then moved once by the
+// resulting permutation. An array whose keys are not all of one kind, or a
+// failed allocation, falls back to qsort with elementCompare as before.
+enum SortKeyKind {
+    SORT_KEY_NONE,
+    SORT_KEY_INT32,
+    SORT_KEY_FLOAT,
+    SORT_KEY_DOUBLE,
+    SORT_KEY_STRING
+};
+// Below this many elements std::sort of the keys beats four radix passes
+#define SORT_ARRAY_RADIX_MIN 64
+struct SortKeyU32 {
+    uint32_t key;
+    uint32_t index;
+};
+struct SortKeyDouble {
+    double key;
+    uint32_t index;
+};
+struct SortKeyString {
+    const char *key;
+    uint32_t index;
+};
+static const Value *sortKeyOf(const SortArrayActionComponent *component, const Value &element) {
+    if (component->arrayType == -1) {
+        return &element;
     }
-    if (!srcArrayValue.isArray()) {
-        throwError(flowState, componentIndex, FlowError::Plain("SortArray: not an array\n"));
-        return;
+    if (!element.isArray()) {
+        return nullptr;
     }
-    auto arrayValue = srcArrayValue.clone();
+    auto elementArray = element.getArray();
+    if ((uint32_t)component->structFieldIndex >= elementArray->arraySize) {
+        return nullptr;
+    }
+    return &elementArray->values[component->structFieldIndex];
+}
+static SortKeyKind sortKeyKindOf(const Value &key) {
+    if (key.type == VALUE_TYPE_INT32 || key.type == VALUE_TYPE_BOOLEAN) {
+        return SORT_KEY_INT32;
+    }
+    if (key.isFloat()) {
+        return SORT_KEY_FLOAT;
+    }
+    if (key.isString()) {
+        return SORT_KEY_STRING;
+    }
+    int err;
+    key.toDouble(&err);
+    return err ? SORT_KEY_NONE : SORT_KEY_DOUBLE;
+}
+static uint32_t sortKeyU32(const Value &key, SortKeyKind kind) {
+    if (kind == SORT_KEY_INT32) {
+        return (uint32_t)key.getInt32() ^ 0x80000000u;
+    }
+    uint32_t bits;
+    float value = key.getFloat();
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+static void sortRadixU32(SortKeyU32 *keys, SortKeyU32 *scratch, uint32_t n) {
+    for (uint32_t shift = 0; shift < 32; shift += 8) {
+        uint32_t counts[256] = {0};
+        for (uint32_t i = 0; i < n; i++) {
+            counts[(keys[i].key >> shift) & 0xFF]++;
+        }
+        // Every key has the same byte here: nothing to move
+        if (counts[(keys[0].key >> shift) & 0xFF] == n) {
+            continue;
+        }
+        uint32_t offset = 0;
+        for (uint32_t b = 0; b < 256; b++) {
+            uint32_t count = counts[b];
+            counts[b] = offset;
+            offset += count;
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            scratch[counts[(keys[i].key >> shift) & 0xFF]++] = keys[i];
+        }
+        memcpy(keys, scratch, n * sizeof(SortKeyU32));
+    }
+}
+static bool sortArrayByKeys(SortArrayActionComponent *component, ArrayValue *array) {
+    uint32_t n = array->arraySize;
+    bool ascending = (component->flags & SORT_ARRAY_FLAG_ASCENDING) != 0;
+    bool ignoreCase = (component->flags & SORT_ARRAY_FLAG_IGNORE_CASE) != 0;
+    SortKeyKind kind = SORT_KEY_NONE;
+    for (uint32_t i = 0; i < n; i++) {
+        auto key = sortKeyOf(component, array->values[i]);
+        SortKeyKind keyKind = key ? sortKeyKindOf(*key) : SORT_KEY_NONE;
+        if (keyKind == SORT_KEY_NONE) {
+            return false;
+        }
+        if (i == 0 || keyKind == kind) {
+            kind = keyKind;
+        } else if (kind != SORT_KEY_STRING && keyKind != SORT_KEY_STRING) {
+            kind = SORT_KEY_DOUBLE;
+        } else {
+            return false;
+        }
+    }
+    size_t keySize = kind == SORT_KEY_DOUBLE ? sizeof(SortKeyDouble) : kind == SORT_KEY_STRING ? sizeof(SortKeyString) : sizeof(SortKeyU32);
+    // Large blocks go to PSRAM (MAIN_memPlanLib's malloc threshold)
+    uint8_t *keys = (uint8_t *)malloc(2 * n * keySize);
+    Value *moved = (Value *)malloc(n * sizeof(Value));
+    if (!keys || !moved) {
+        free(keys);
+        free(moved);
+        return false;
+    }
+    uint32_t *order = (uint32_t *)(keys + n * keySize);
+    if (kind == SORT_KEY_INT32 || kind == SORT_KEY_FLOAT) {
+        auto u32 = (SortKeyU32 *)keys;
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t key = sortKeyU32(*sortKeyOf(component, array->values[i]), kind);
+            u32[i].key = ascending ? key : ~key;
+            u32[i].index = i;
+        }
+        if (n >= SORT_ARRAY_RADIX_MIN) {
+            sortRadixU32(u32, (SortKeyU32 *)order, n);
+        } else {
+            std::stable_sort(u32, u32 + n, [](const SortKeyU32 &a, const SortKeyU32 &b) { return a.key < b.key; });
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            order[i] = u32[i].index;
+        }
+    } else if (kind == SORT_KEY_DOUBLE) {
+        auto dbl = (SortKeyDouble *)keys;
+        for (uint32_t i = 0; i < n; i++) {
+            int err;
+            dbl[i].key = sortKeyOf(component, array->values[i])->toDouble(&err);
+            dbl[i].index = i;
+        }
+        if (ascending) {
+            std::sort(dbl, dbl + n, [](const SortKeyDouble &a, const SortKeyDouble &b) { return a.key < b.key; });
+        } else {
+            std::sort(dbl, dbl + n, [](const SortKeyDouble &a, const SortKeyDouble &b) { return a.key > b.key; });
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            order[i] = dbl[i].index;
+        }
+    } else {
+        auto str = (SortKeyString *)keys;
+        for (uint32_t i = 0; i < n; i++) {
+            str[i].key = sortKeyOf(component, array->values[i])->getString();
+            str[i].index = i;
+        }
+        std::sort(str, str + n, [ascending, ignoreCase](const SortKeyString &a, const SortKeyString &b) {
+            int result = ignoreCase ? utf8casecmp(a.key, b.key) : utf8cmp(a.key, b.key);
+            return ascending ? result < 0 : result > 0;
+        });
+        for (uint32_t i = 0; i < n; i++) {
+            order[i] = str[i].index;
+        }
+    }
+    // Values move as raw bytes, the same way qsort swaps them
+    for (uint32_t i = 0; i < n; i++) {
+        memcpy((void *)&moved[i], (const void *)&array->values[order[i]], sizeof(Value));
+    }
+    memcpy((void *)&array->values[0], (const void *)moved, n * sizeof(Value));
+    free(moved);
+    free(keys);
+    return true;
+}
+void sortArray(SortArrayActionComponent *component, ArrayValue *array) {
+    if (array->arraySize < 2 || sortArrayByKeys(component, array)) {
+        return;
+    }
+    g_sortArrayActionComponent = component;
+    qsort(&array->values[0], array->arraySize, sizeof(Value), elementCompare);
+}
+// EARS: lookup in an array sorted by sortArray with the same type, field and flags
+int32_t sortedArrayFind(const ArrayValue *array, int32_t structFieldIndex, uint32_t flags, const Value &key) {
+    SortArrayActionComponent component;
+    component.arrayType = structFieldIndex < 0 ? -1 : 0;
+    component.structFieldIndex = structFieldIndex;
+    component.flags = flags;
+    bool ascending = (flags & SORT_ARRAY_FLAG_ASCENDING) != 0;
+    bool keyIsString = key.isString();
+    int err;
+    double keyNumber = keyIsString ? 0 : key.toDouble(&err);
+    if (!keyIsString && err) {
+        return -1;
+    }
+    int32_t low = 0;
+    int32_t high = (int32_t)array->arraySize - 1;
+    while (low <= high) {
+        int32_t mid = low + (high - low) / 2;
+        auto element = sortKeyOf(&component, array->values[mid]);
+        if (!element || element->isString() != keyIsString) {
+            return -1;
+        }
+        int result;
+        if (keyIsString) {
+            result = (flags & SORT_ARRAY_FLAG_IGNORE_CASE) ? utf8casecmp(element->getString(), key.getString()) : utf8cmp(element->getString(), key.getString());
+        } else {
+            double number = element->toDouble(&err);
+            result = number < keyNumber ? -1 : number > keyNumber ? 1 : 0;
+        }
+        if (!ascending) {
+            result = -result;
+        }
+        if (result == 0) {
+            return mid;
+        }
+        if (result < 0) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return -1;
+}
+void executeSortArrayComponent(FlowState *flowState, unsigned componentIndex) {
+    auto component = (SortArrayActionComponent *)flowState->flow->components[componentIndex];
+    Value srcArrayValue;
+    if (!evalProperty(flowState, componentIndex, defs_v3::SORT_ARRAY_ACTION_COMPONENT_PROPERTY_ARRAY, srcArrayValue, FlowError::Property("SortArray", "Array"))) {
+        return;
+    }
+    if (!srcArrayValue.isArray()) {
+        throwError(flowState, componentIndex, FlowError::Plain("SortArray: not an array\n"));
+        return;
+    }
+    auto arrayValue = srcArrayValue.clone();
     auto array = arrayValue.getArray();
     if (component->arrayType != -1) {
         if (array->arrayType != (uint32_t)component->arrayType) {
@@ -6380,6 +7149,7 @@ static void writeValue(const Value &value) {
 	case VALUE_TYPE_STRING:
     case VALUE_TYPE_STRING_ASSET:
 	case VALUE_TYPE_STRING_REF:
+	case VALUE_TYPE_STRING_INLINE:
 		writeString(value.getString());
 		return;
 	case VALUE_TYPE_ARRAY:
@@ -6481,6 +7251,9 @@ void onRemoveFromQueue() {
     }
 }
 void onValueChanged(const Value *pValue) {
+    if (g_globalVariables && pValue >= g_globalVariables->values && pValue < g_globalVariables->values + g_globalVariables->count) {
+        onGlobalVariableChanged(pValue - g_globalVariables->values);
+    }
     if (isSubscribedTo(MESSAGE_TO_DEBUGGER_VALUE_CHANGED)) {
         char buffer[256];
 		snprintf(buffer, sizeof(buffer), "%d\t%p\t",
@@ -6951,6 +7724,220 @@ bool evalAssignableExpression(FlowState *flowState, int componentIndex, const ui
     throwError(flowState, componentIndex, errorMessage);
 	return false;
 }
+// EARS: evalProperty result cache. start() finds the properties built only from
+// constants, global variables and pure operations; their last result is reused until
+// a global variable they read is written. A 64-bit bitmap (index % 64) records the
+// globals a property reads, and each bit keeps the clock of its last write.
+// With EEZ_FLOW_NATIVE_VAR_NOTIFY native variables are dependencies too (bit =
+// their PUSH_GLOBAL_VAR index % 64) and must report writes through
+// eez_flow_native_var_changed(). beginExpressionCapture() collects the bits read
+// by a whole screen tick, so eez_flow_tick_screen() can skip unchanged screens.
+#if !defined(EEZ_FLOW_EXPR_CACHE)
+#define EEZ_FLOW_EXPR_CACHE 1
+#endif
+#if !defined(EEZ_FLOW_NATIVE_VAR_NOTIFY)
+#define EEZ_FLOW_NATIVE_VAR_NOTIFY 0
+#endif
+static const uint16_t EXPR_CACHE_NO_SLOT = 0xFFFF;
+struct ExprCacheEntry {
+    Value value;
+    uint64_t deps;
+    uint32_t stamp;
+    bool valid;
+};
+static Assets *g_exprCacheAssets;
+static uint32_t *g_exprCacheFlowBase;
+static uint32_t *g_exprCacheComponentBase;
+static uint16_t *g_exprCacheSlots;
+static ExprCacheEntry *g_exprCacheEntries;
+static uint32_t g_exprCacheNumEntries;
+static uint32_t g_exprCacheClock;
+static uint32_t g_exprCacheWriteStamps[64];
+static uint32_t g_exprCacheEpoch;
+static bool g_exprCaptureActive;
+static bool g_exprCaptureVolatile;
+static uint64_t g_exprCaptureDeps;
+static bool isCacheableExpression(const uint8_t *instructions, uint64_t &deps) {
+    deps = 0;
+    for (int i = 0; ; i += 2) {
+        uint16_t instruction = instructions[i] + (instructions[i + 1] << 8);
+        auto instructionType = instruction & EXPR_EVAL_INSTRUCTION_TYPE_MASK;
+        auto instructionArg = instruction & EXPR_EVAL_INSTRUCTION_PARAM_MASK;
+        if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_CONSTANT || instructionType == EXPR_EVAL_INSTRUCTION_ARRAY_ELEMENT) {
+            continue;
+        } else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_GLOBAL_VAR) {
+#if !EEZ_FLOW_NATIVE_VAR_NOTIFY
+            if ((uint32_t)instructionArg >= g_globalVariables->count) {
+                return false;
+            }
+#endif
+            deps |= 1ULL << (instructionArg % 64);
+        } else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_OPERATION) {
+            if (!isPureOperation(instructionArg)) {
+                return false;
+            }
+        } else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_END) {
+            return true;
+        } else {
+            return false;
+        }
+    }
+}
+static uint32_t nextExpressionCacheClock() {
+    if (++g_exprCacheClock == 0) {
+        for (uint32_t i = 0; i < g_exprCacheNumEntries; i++) {
+            g_exprCacheEntries[i].valid = false;
+        }
+        memset(g_exprCacheWriteStamps, 0, sizeof(g_exprCacheWriteStamps));
+        g_exprCacheClock = 1;
+        g_exprCacheEpoch++;
+    }
+    return g_exprCacheClock;
+}
+void initExpressionCache(Assets *assets) {
+    freeExpressionCache();
+    if (assets->external || !g_globalVariables) {
+        return;
+    }
+    auto flowDefinition = static_cast<FlowDefinition *>(assets->flowDefinition);
+    uint32_t numComponents = 0;
+    uint32_t numProperties = 0;
+    for (uint32_t flowIndex = 0; flowIndex < flowDefinition->flows.count; flowIndex++) {
+        auto flow = flowDefinition->flows[flowIndex];
+        numComponents += flow->components.count;
+        for (uint32_t componentIndex = 0; componentIndex < flow->components.count; componentIndex++) {
+            numProperties += flow->components[componentIndex]->properties.count;
+        }
+    }
+    if (numProperties == 0) {
+        return;
+    }
+    g_exprCacheFlowBase = (uint32_t *)alloc(flowDefinition->flows.count * sizeof(uint32_t), 0x4d1c7a02);
+    g_exprCacheComponentBase = (uint32_t *)alloc(numComponents * sizeof(uint32_t), 0x9b3e51c6);
+    g_exprCacheSlots = (uint16_t *)alloc(numProperties * sizeof(uint16_t), 0x27f08d3b);
+    if (!g_exprCacheFlowBase || !g_exprCacheComponentBase || !g_exprCacheSlots) {
+        freeExpressionCache();
+        return;
+    }
+    uint32_t componentBase = 0;
+    uint32_t propertyBase = 0;
+    uint32_t numEntries = 0;
+    for (uint32_t flowIndex = 0; flowIndex < flowDefinition->flows.count; flowIndex++) {
+        auto flow = flowDefinition->flows[flowIndex];
+        g_exprCacheFlowBase[flowIndex] = componentBase;
+        for (uint32_t componentIndex = 0; componentIndex < flow->components.count; componentIndex++) {
+            auto component = flow->components[componentIndex];
+            g_exprCacheComponentBase[componentBase++] = propertyBase;
+            for (uint32_t propertyIndex = 0; propertyIndex < component->properties.count; propertyIndex++) {
+                uint64_t deps;
+                if (numEntries < EXPR_CACHE_NO_SLOT && isCacheableExpression(component->properties[propertyIndex]->evalInstructions, deps)) {
+                    g_exprCacheSlots[propertyBase++] = (uint16_t)numEntries++;
+                } else {
+                    g_exprCacheSlots[propertyBase++] = EXPR_CACHE_NO_SLOT;
+                }
+            }
+        }
+    }
+    if (numEntries == 0) {
+        freeExpressionCache();
+        return;
+    }
+    g_exprCacheEntries = (ExprCacheEntry *)alloc(numEntries * sizeof(ExprCacheEntry), 0xe6a9135f);
+    if (!g_exprCacheEntries) {
+        freeExpressionCache();
+        return;
+    }
+    g_exprCacheNumEntries = numEntries;
+    uint32_t entryIndex = 0;
+    for (uint32_t flowIndex = 0; flowIndex < flowDefinition->flows.count; flowIndex++) {
+        auto flow = flowDefinition->flows[flowIndex];
+        for (uint32_t componentIndex = 0; componentIndex < flow->components.count; componentIndex++) {
+            auto component = flow->components[componentIndex];
+            for (uint32_t propertyIndex = 0; propertyIndex < component->properties.count; propertyIndex++) {
+                uint64_t deps;
+                if (entryIndex < numEntries && isCacheableExpression(component->properties[propertyIndex]->evalInstructions, deps)) {
+                    auto entry = g_exprCacheEntries + entryIndex++;
+                    new (&entry->value) Value();
+                    entry->deps = deps;
+                    entry->stamp = 0;
+                    entry->valid = false;
+                }
+            }
+        }
+    }
+    g_exprCacheAssets = assets;
+    g_exprCacheClock = 0;
+    g_exprCacheEpoch++;
+    memset(g_exprCacheWriteStamps, 0, sizeof(g_exprCacheWriteStamps));
+}
+void freeExpressionCache() {
+    for (uint32_t i = 0; i < g_exprCacheNumEntries; i++) {
+        g_exprCacheEntries[i].value.~Value();
+    }
+    free(g_exprCacheEntries);
+    free(g_exprCacheSlots);
+    free(g_exprCacheComponentBase);
+    free(g_exprCacheFlowBase);
+    g_exprCacheEntries = nullptr;
+    g_exprCacheSlots = nullptr;
+    g_exprCacheComponentBase = nullptr;
+    g_exprCacheFlowBase = nullptr;
+    g_exprCacheNumEntries = 0;
+    g_exprCacheAssets = nullptr;
+}
+void onGlobalVariableChanged(uint32_t globalVariableIndex) {
+    if (g_exprCacheEntries) {
+        g_exprCacheWriteStamps[globalVariableIndex % 64] = nextExpressionCacheClock();
+    }
+}
+void onNativeVariableChanged(int16_t nativeVariableId) {
+    if (g_exprCacheEntries) {
+        auto flowDefinition = static_cast<FlowDefinition *>(g_exprCacheAssets->flowDefinition);
+        onGlobalVariableChanged(flowDefinition->globalVariables.count + nativeVariableId - 1);
+    }
+}
+void invalidateExpressionCache() {
+    if (g_exprCacheEntries) {
+        auto clock = nextExpressionCacheClock();
+        for (int i = 0; i < 64; i++) {
+            g_exprCacheWriteStamps[i] = clock;
+        }
+    }
+}
+static ExprCacheEntry *getExpressionCacheEntry(FlowState *flowState, int componentIndex, int propertyIndex) {
+    if (!g_exprCacheEntries || flowState->assets != g_exprCacheAssets) {
+        return nullptr;
+    }
+    auto slot = g_exprCacheSlots[g_exprCacheComponentBase[g_exprCacheFlowBase[flowState->flowIndex] + componentIndex] + propertyIndex];
+    return slot != EXPR_CACHE_NO_SLOT ? g_exprCacheEntries + slot : nullptr;
+}
+bool isExpressionCacheChanged(uint64_t deps, uint32_t stamp) {
+    for (; deps; deps &= deps - 1) {
+        if (g_exprCacheWriteStamps[__builtin_ctzll(deps)] > stamp) {
+            return true;
+        }
+    }
+    return false;
+}
+uint32_t getExpressionCacheClock() {
+    return g_exprCacheClock;
+}
+uint32_t getExpressionCacheEpoch() {
+    return g_exprCacheEpoch;
+}
+void beginExpressionCapture() {
+    g_exprCaptureActive = true;
+    g_exprCaptureVolatile = false;
+    g_exprCaptureDeps = 0;
+}
+bool endExpressionCapture(uint64_t &deps) {
+    g_exprCaptureActive = false;
+    deps = g_exprCaptureDeps;
+    return !g_exprCaptureVolatile;
+}
+static bool isExpressionCacheEntryValid(const ExprCacheEntry *entry) {
+    return entry->valid && !isExpressionCacheChanged(entry->deps, entry->stamp);
+}
 #if EEZ_OPTION_GUI
 bool evalProperty(FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const FlowError &errorMessage, int *numInstructionBytes, const int32_t *iterators, DataOperationEnum operation) {
 #else
@@ -6971,11 +7958,34 @@ bool evalProperty(FlowState *flowState, int componentIndex, int propertyIndex, V
         throwError(flowState, componentIndex, flowError);
         return false;
     }
+    ExprCacheEntry *cacheEntry = numInstructionBytes ? nullptr : getExpressionCacheEntry(flowState, componentIndex, propertyIndex);
+#if EEZ_OPTION_GUI
+    if (operation != DATA_OPERATION_GET) {
+        cacheEntry = nullptr;
+    }
+#endif
+    if (g_exprCaptureActive) {
+        if (cacheEntry) {
+            g_exprCaptureDeps |= cacheEntry->deps;
+        } else {
+            g_exprCaptureVolatile = true;
+        }
+    }
+    if (cacheEntry && isExpressionCacheEntryValid(cacheEntry)) {
+        result = cacheEntry->value;
+        return true;
+    }
 #if EEZ_OPTION_GUI
-    return evalExpression(flowState, componentIndex, component->properties[propertyIndex]->evalInstructions, result, errorMessage, numInstructionBytes, iterators, operation);
+    bool ok = evalExpression(flowState, componentIndex, component->properties[propertyIndex]->evalInstructions, result, errorMessage, numInstructionBytes, iterators, operation);
 #else
-    return evalExpression(flowState, componentIndex, component->properties[propertyIndex]->evalInstructions, result, errorMessage, numInstructionBytes, iterators);
+    bool ok = evalExpression(flowState, componentIndex, component->properties[propertyIndex]->evalInstructions, result, errorMessage, numInstructionBytes, iterators);
 #endif
+    if (ok && cacheEntry) {
+        cacheEntry->value = result;
+        cacheEntry->stamp = g_exprCacheClock;
+        cacheEntry->valid = true;
+    }
+    return ok;
 }
 bool evalAssignableProperty(FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const FlowError &errorMessage, int *numInstructionBytes, const int32_t *iterators) {
     if (componentIndex < 0 || componentIndex >= (int)flowState->flow->components.count) {
@@ -7048,7 +8058,75 @@ uint32_t g_wasmModuleId = 0;
 #define EEZ_FLOW_TICK_MAX_DURATION_MS 5
 #endif
 static const uint32_t FLOW_TICK_MAX_DURATION_MS = EEZ_FLOW_TICK_MAX_DURATION_MS;
+// EARS: the budget is checked after every component, in microseconds; components
+// left in the queue run on the next tick
+#if !defined(EEZ_FLOW_TICK_MAX_DURATION_US)
+#define EEZ_FLOW_TICK_MAX_DURATION_US (EEZ_FLOW_TICK_MAX_DURATION_MS * 1000)
+#endif
+static const uint32_t FLOW_TICK_MAX_DURATION_US = EEZ_FLOW_TICK_MAX_DURATION_US;
+#if !defined(EEZ_FLOW_COMPONENT_STATS)
+#define EEZ_FLOW_COMPONENT_STATS 1
+#endif
+static const unsigned COMPONENT_STATS_SIZE = 32;
 static unsigned g_tick_max_duration_count = 0;
+static uint32_t g_lastTickDurationUs = 0;
+static uint32_t g_maxTickDurationUs = 0;
+#if EEZ_FLOW_COMPONENT_STATS
+static ComponentExecutionStats g_componentStats[COMPONENT_STATS_SIZE];
+static void recordComponentExecution(FlowState *flowState, unsigned componentIndex, uint32_t durationUs) {
+    uint16_t componentType = flowState->flow->components[componentIndex]->type;
+    unsigned slot = (componentType * 2654435761u) % COMPONENT_STATS_SIZE;
+    for (unsigned i = 0; i < COMPONENT_STATS_SIZE; i++) {
+        auto &stats = g_componentStats[(slot + i) % COMPONENT_STATS_SIZE];
+        if (stats.count == 0 || stats.componentType == componentType) {
+            stats.componentType = componentType;
+            stats.count++;
+            stats.totalUs += durationUs;
+            if (durationUs > stats.maxUs) {
+                stats.maxUs = durationUs;
+                stats.slowestFlowIndex = flowState->flowIndex;
+                stats.slowestComponentIndex = componentIndex;
+            }
+            return;
+        }
+    }
+}
+#endif
+#if EEZ_FLOW_PROFILER
+static void freeProfile() {
+    free(g_profile);
+    free(g_profileFlowBase);
+    g_profile = nullptr;
+    g_profileFlowBase = nullptr;
+    g_profileNumFlows = 0;
+    g_profileNumComponents = 0;
+    g_profileAssets = nullptr;
+}
+static void initProfile(Assets *assets) {
+    freeProfile();
+    auto flowDefinition = static_cast<FlowDefinition *>(assets->flowDefinition);
+    uint32_t numComponents = 0;
+    for (uint32_t flowIndex = 0; flowIndex < flowDefinition->flows.count; flowIndex++) {
+        numComponents += flowDefinition->flows[flowIndex]->components.count;
+    }
+    g_profileFlowBase = (uint32_t *)alloc(flowDefinition->flows.count * sizeof(uint32_t), 0x71c3e8a4);
+    g_profile = (ComponentProfile *)alloc(numComponents * sizeof(ComponentProfile), 0xa85f20d9);
+    if (!g_profileFlowBase || !g_profile) {
+        freeProfile();
+        return;
+    }
+    uint32_t componentBase = 0;
+    for (uint32_t flowIndex = 0; flowIndex < flowDefinition->flows.count; flowIndex++) {
+        g_profileFlowBase[flowIndex] = componentBase;
+        componentBase += flowDefinition->flows[flowIndex]->components.count;
+    }
+    memset(g_profile, 0, numComponents * sizeof(ComponentProfile));
+    g_profileNumFlows = flowDefinition->flows.count;
+    g_profileNumComponents = numComponents;
+    g_profileAssets = assets;
+    g_profileStartUs = micros();
+}
+#endif
 int g_selectedLanguage = 0;
 FlowState *g_firstFlowState;
 FlowState *g_lastFlowState;
@@ -7066,6 +8144,12 @@ unsigned start(Assets *assets) {
     if (!assets->external) {
 	    queueReset();
         watchListReset();
+#if EEZ_FLOW_EXPR_CACHE
+        initExpressionCache(assets);
+#endif
+#if EEZ_FLOW_PROFILER
+        initProfile(assets);
+#endif
     }
     scpiComponentInitHook();
 	onStarted(assets);
@@ -7079,7 +8163,7 @@ void tick() {
         doStop();
         return;
     }
-	uint32_t startTickCount = millis();
+	uint32_t startTickTime = micros();
     visitWatchList();
     auto queueSizeAtTickStart = getQueueSize();
     for (size_t i = 0; i < queueSizeAtTickStart || g_numNonContinuousTaskInQueue > 0; i++) {
@@ -7096,19 +8180,24 @@ void tick() {
 		if (!continuousTask && !canExecuteStep(flowState, componentIndex)) {
 			break;
 		}
+#if EEZ_FLOW_PROFILER
+        recordComponentWait(flowState, componentIndex, getNextTaskQueueWaitUs());
+#endif
 		removeNextTaskFromQueue();
         flowState->executingComponentIndex = componentIndex;
         if (flowState->error) {
             deallocateComponentExecutionState(flowState, componentIndex);
         } else {
-            if (continuousTask) {
-                if (i < queueSizeAtTickStart) {
-                    executeComponent(flowState, componentIndex);
-                } else {
-                    addToQueue(flowState, componentIndex, -1, -1, -1, true);
-                }
-            } else {
+            if (!continuousTask || i < queueSizeAtTickStart) {
+#if EEZ_FLOW_COMPONENT_STATS
+                uint32_t componentStartTime = micros();
                 executeComponent(flowState, componentIndex);
+                recordComponentExecution(flowState, componentIndex, micros() - componentStartTime);
+#else
+                executeComponent(flowState, componentIndex);
+#endif
+            } else {
+                addToQueue(flowState, componentIndex, -1, -1, -1, true);
             }
         }
         if (isFlowStopped() || g_isStopping) {
@@ -7118,13 +8207,15 @@ void tick() {
         if (canFreeFlowState(flowState)) {
             freeFlowState(flowState);
         }
-        if ((i + 1) % 5 == 0) {
-            if (millis() - startTickCount >= FLOW_TICK_MAX_DURATION_MS) {
-                g_tick_max_duration_count++;
-                break;
-            }
+        if (micros() - startTickTime >= FLOW_TICK_MAX_DURATION_US) {
+            g_tick_max_duration_count++;
+            break;
         }
 	}
+    g_lastTickDurationUs = micros() - startTickTime;
+    if (g_lastTickDurationUs > g_maxTickDurationUs) {
+        g_maxTickDurationUs = g_lastTickDurationUs;
+    }
 	finishToDebuggerMessageHook();
     for (FlowState *flowState = g_firstFlowState; flowState; ) {
         FlowState* nextFlowState = flowState->nextSibling;
@@ -7158,6 +8249,11 @@ void doStop() {
     g_isStopped = true;
 	queueReset();
     watchListReset();
+    freeExpressionCache();
+    Value::freeInternedStrings();
+#if defined(EEZ_FOR_LVGL)
+    g_flowRunId++;
+#endif
 }
 bool isFlowStopped() {
     return g_isStopped;
@@ -7165,6 +8261,105 @@ bool isFlowStopped() {
 unsigned getTickMaxDurationCounter() {
     return g_tick_max_duration_count;
 }
+void getTickDurationStats(uint32_t &lastTickDurationUs, uint32_t &maxTickDurationUs) {
+    lastTickDurationUs = g_lastTickDurationUs;
+    maxTickDurationUs = g_maxTickDurationUs;
+}
+unsigned getComponentExecutionStats(ComponentExecutionStats *stats, unsigned maxStats) {
+    unsigned numStats = 0;
+#if EEZ_FLOW_COMPONENT_STATS
+    for (unsigned i = 0; i < COMPONENT_STATS_SIZE && numStats < maxStats; i++) {
+        if (g_componentStats[i].count > 0) {
+            stats[numStats++] = g_componentStats[i];
+        }
+    }
+#else
+    EEZ_UNUSED(stats);
+    EEZ_UNUSED(maxStats);
+#endif
+    return numStats;
+}
+void resetComponentExecutionStats() {
+#if EEZ_FLOW_COMPONENT_STATS
+    memset(g_componentStats, 0, sizeof(g_componentStats));
+#endif
+    g_tick_max_duration_count = 0;
+    g_maxTickDurationUs = 0;
+}
+const ComponentProfile *getComponentProfile(unsigned flowIndex, unsigned componentIndex) {
+#if EEZ_FLOW_PROFILER
+    if (g_profile && flowIndex < g_profileNumFlows) {
+        uint32_t entry = g_profileFlowBase[flowIndex] + componentIndex;
+        uint32_t end = flowIndex + 1 < g_profileNumFlows ? g_profileFlowBase[flowIndex + 1] : g_profileNumComponents;
+        if (entry < end) {
+            return &g_profile[entry];
+        }
+    }
+#else
+    EEZ_UNUSED(flowIndex);
+    EEZ_UNUSED(componentIndex);
+#endif
+    return nullptr;
+}
+void resetProfile() {
+#if EEZ_FLOW_PROFILER
+    if (g_profile) {
+        memset(g_profile, 0, g_profileNumComponents * sizeof(ComponentProfile));
+    }
+    g_profileStartUs = micros();
+#endif
+}
+#if EEZ_FLOW_PROFILER
+// {"elapsedUs", tick stats, "flows": [{"flow", totals, "components": [{"component", "type", ...}]}]},
+// flows and components that never ran are left out
+static size_t writeProfileJson(eez_flow_profile_writer_t write, void *ctx) {
+    char text[192];
+    size_t total = 0;
+    auto emit = [&](int length) {
+        if (length > 0) {
+            length = length < (int)sizeof(text) ? length : (int)sizeof(text) - 1;
+            write(text, (size_t)length, ctx);
+            total += (size_t)length;
+        }
+    };
+    emit(snprintf(text, sizeof(text), "{\"eezFlowProfile\":1,\"elapsedUs\":%lu,\"maxTickUs\":%lu,\"ticksOverBudget\":%u,\"flows\":[",
+        (unsigned long)(micros() - g_profileStartUs), (unsigned long)g_maxTickDurationUs, g_tick_max_duration_count));
+    bool firstFlow = true;
+    auto flowDefinition = g_profileAssets ? static_cast<FlowDefinition *>(g_profileAssets->flowDefinition) : nullptr;
+    for (uint32_t flowIndex = 0; g_profile && flowIndex < g_profileNumFlows; flowIndex++) {
+        auto flow = flowDefinition->flows[flowIndex];
+        auto entries = g_profile + g_profileFlowBase[flowIndex];
+        uint32_t count = 0;
+        uint32_t totalUs = 0;
+        uint32_t waitUs = 0;
+        for (uint32_t componentIndex = 0; componentIndex < flow->components.count; componentIndex++) {
+            count += entries[componentIndex].count;
+            totalUs += entries[componentIndex].totalUs;
+            waitUs += entries[componentIndex].waitUs;
+        }
+        if (count == 0) {
+            continue;
+        }
+        emit(snprintf(text, sizeof(text), "%s{\"flow\":%lu,\"count\":%lu,\"totalUs\":%lu,\"waitUs\":%lu,\"components\":[",
+            firstFlow ? "" : ",", (unsigned long)flowIndex, (unsigned long)count, (unsigned long)totalUs, (unsigned long)waitUs));
+        firstFlow = false;
+        bool firstComponent = true;
+        for (uint32_t componentIndex = 0; componentIndex < flow->components.count; componentIndex++) {
+            auto &entry = entries[componentIndex];
+            if (entry.count == 0) {
+                continue;
+            }
+            emit(snprintf(text, sizeof(text), "%s{\"component\":%lu,\"type\":%u,\"count\":%lu,\"totalUs\":%lu,\"maxUs\":%lu,\"waitUs\":%lu}",
+                firstComponent ? "" : ",", (unsigned long)componentIndex, (unsigned)flow->components[componentIndex]->type,
+                (unsigned long)entry.count, (unsigned long)entry.totalUs, (unsigned long)entry.maxUs, (unsigned long)entry.waitUs));
+            firstComponent = false;
+        }
+        emit(snprintf(text, sizeof(text), "]}"));
+    }
+    emit(snprintf(text, sizeof(text), "]}\n"));
+    return total;
+}
+#endif
 #if EEZ_OPTION_GUI
 FlowState *getPageFlowState(Assets *assets, int16_t pageIndex, const WidgetCursor &widgetCursor) {
 	if (!assets->flowDefinition) {
@@ -7253,6 +8448,7 @@ void setGlobalVariable(Assets *assets, uint32_t globalVariableIndex, const Value
     if (globalVariableIndex < assets->flowDefinition->globalVariables.count) {
         if (g_globalVariables && !assets->external) {
             g_globalVariables->values[globalVariableIndex] = value;
+            onGlobalVariableChanged(globalVariableIndex);
         } else {
             *assets->flowDefinition->globalVariables[globalVariableIndex] = value;
         }
@@ -7777,24 +8973,160 @@ unsigned g_screenStackPosition = 0;
 extern "C" int16_t eez_flow_get_current_screen() {
     return g_currentScreen + 1;
 }
+// EARS: a screen's bindings are re-run only when a variable they read has changed,
+// or every EEZ_FLOW_BINDINGS_REFRESH_MS; screens with any uncacheable binding
+// (locals, inputs, Date.now, ...) are still ticked every frame
+#if !defined(EEZ_FLOW_BINDINGS_REFRESH_MS)
+#define EEZ_FLOW_BINDINGS_REFRESH_MS 1000
+#endif
+#if !defined(EEZ_FLOW_MAX_TRACKED_SCREENS)
+#define EEZ_FLOW_MAX_TRACKED_SCREENS 32
+#endif
+// EARS: LVGL callbacks into the flow hold the flow lock, so they never run alongside
+// a tick on the flow worker task (no-op when the flow ticks on the UI task)
+struct FlowLockGuard {
+    FlowLockGuard() { MAIN_flow_lock(FLOW_LOCK_FOREVER); }
+    ~FlowLockGuard() { MAIN_flow_unlock(); }
+};
+struct ScreenBindings {
+    uint64_t deps;
+    uint32_t stamp;
+    uint32_t epoch;
+    uint32_t lastTickTime;
+    bool clean;
+};
+static ScreenBindings g_screenBindings[EEZ_FLOW_MAX_TRACKED_SCREENS];
+static void invalidateScreenBindings(int screenIndex) {
+    if (screenIndex >= 0 && screenIndex < EEZ_FLOW_MAX_TRACKED_SCREENS) {
+        g_screenBindings[screenIndex].clean = false;
+    }
+}
+extern "C" void eez_flow_tick_screen(int screenIndex) {
+    if (screenIndex < 0 || screenIndex >= EEZ_FLOW_MAX_TRACKED_SCREENS) {
+        tick_screen(screenIndex);
+        return;
+    }
+    // Skip a frame rather than stall rendering behind a long flow tick
+    if (!MAIN_flow_lock(0)) {
+        MAIN_flow_task_note_lock_miss();
+        return;
+    }
+    auto &bindings = g_screenBindings[screenIndex];
+    uint32_t now = eez::millis();
+    if (
+        bindings.clean &&
+        bindings.epoch == eez::flow::getExpressionCacheEpoch() &&
+        !eez::flow::isExpressionCacheChanged(bindings.deps, bindings.stamp) &&
+        now - bindings.lastTickTime < EEZ_FLOW_BINDINGS_REFRESH_MS
+    ) {
+        MAIN_flow_unlock();
+        return;
+    }
+    bindings.stamp = eez::flow::getExpressionCacheClock();
+    bindings.epoch = eez::flow::getExpressionCacheEpoch();
+    bindings.lastTickTime = now;
+    eez::flow::beginExpressionCapture();
+    tick_screen(screenIndex);
+    bindings.clean = eez::flow::endExpressionCapture(bindings.deps);
+    MAIN_flow_unlock();
+}
+extern "C" void eez_flow_native_var_changed(int16_t nativeVariableId) {
+    FlowLockGuard lock;
+    eez::flow::onNativeVariableChanged(nativeVariableId);
+}
+// EARS: screens are created on first load and kept as an LRU cache. Once a load has
+// completed, inactive screens are deleted, least recently shown first and those on
+// g_screenStack last, until the rest fit in EEZ_LVGL_SCREEN_CACHE_BYTES of LVGL heap
+#if !defined(EEZ_LVGL_SCREEN_CACHE_BYTES)
+#define EEZ_LVGL_SCREEN_CACHE_BYTES (16 * 1024)
+#endif
+static uint32_t g_screenBytes[EEZ_FLOW_MAX_TRACKED_SCREENS];
+static uint32_t g_screenLastUse[EEZ_FLOW_MAX_TRACKED_SCREENS];
+static uint32_t g_screenUseClock;
+static bool g_screenTrimPending;
+static uint32_t getLvglHeapUsed() {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
 static bool isScreenCreated(int screenIndex) {
     return eez::flow::getLvglObjectFromIndexHook(screenIndex) != 0;
 }
+static bool isScreenOnStack(int screenIndex) {
+    for (unsigned i = 0; i < g_screenStackPosition; i++) {
+        if (g_screenStack[i] == screenIndex + 1) {
+            return true;
+        }
+    }
+    return false;
+}
+static void deleteScreen(int screenIndex);
+static void trimScreenCache(void *userData) {
+    EEZ_UNUSED(userData);
+    FlowLockGuard lock;
+    g_screenTrimPending = false;
+    if (!g_deleteScreenFunc) {
+        return;
+    }
+    lv_obj_t *activeScreen = lv_screen_active();
+    lv_obj_t *prevScreen = lv_display_get_screen_prev(NULL);
+    while (true) {
+        uint32_t cachedBytes = 0;
+        int victim = -1;
+        bool victimOnStack = false;
+        for (int i = 0; i < (int)g_numScreens && i < EEZ_FLOW_MAX_TRACKED_SCREENS; i++) {
+            lv_obj_t *screen = eez::flow::getLvglObjectFromIndexHook(i);
+            if (!screen || i == g_currentScreen || screen == activeScreen || screen == prevScreen) {
+                continue;
+            }
+            cachedBytes += g_screenBytes[i];
+            bool onStack = isScreenOnStack(i);
+            if (victim == -1 || (victimOnStack && !onStack) || (victimOnStack == onStack && g_screenLastUse[i] < g_screenLastUse[victim])) {
+                victim = i;
+                victimOnStack = onStack;
+            }
+        }
+        if (victim == -1 || cachedBytes <= EEZ_LVGL_SCREEN_CACHE_BYTES) {
+            return;
+        }
+        deleteScreen(victim);
+    }
+}
+static void on_screen_loaded(lv_event_t *e) {
+    if (lv_event_get_code(e) == LV_EVENT_SCREEN_LOADED && !g_screenTrimPending) {
+        g_screenTrimPending = true;
+        lv_async_call(trimScreenCache, 0);
+    }
+}
 static void createScreen(int screenIndex) {
     if (g_createScreenFunc && !isScreenCreated(screenIndex)) {
+        uint32_t heapUsed = getLvglHeapUsed();
         g_createScreenFunc(screenIndex);
+        invalidateScreenBindings(screenIndex);
+        lv_obj_t *screen = eez::flow::getLvglObjectFromIndexHook(screenIndex);
+        if (screen && screenIndex >= 0 && screenIndex < EEZ_FLOW_MAX_TRACKED_SCREENS) {
+            uint32_t heapUsedAfter = getLvglHeapUsed();
+            g_screenBytes[screenIndex] = heapUsedAfter > heapUsed ? heapUsedAfter - heapUsed : 0;
+            lv_obj_add_event_cb(screen, on_screen_loaded, LV_EVENT_SCREEN_LOADED, 0);
+        }
+    }
+    if (screenIndex >= 0 && screenIndex < EEZ_FLOW_MAX_TRACKED_SCREENS) {
+        g_screenLastUse[screenIndex] = ++g_screenUseClock;
     }
 }
 static void deleteScreen(int screenIndex) {
     if (g_deleteScreenFunc && isScreenCreated(screenIndex)) {
         g_deleteScreenFunc(screenIndex);
+        invalidateScreenBindings(screenIndex);
     }
 }
 extern "C" void eez_flow_set_screen(int16_t screenId, lv_scr_load_anim_t animType, uint32_t speed, uint32_t delay) {
+    FlowLockGuard lock;
     g_screenStackPosition = 0;
     eez::flow::replacePageHook(screenId, animType, speed, delay);
 }
 extern "C" void eez_flow_push_screen(int16_t screenId, lv_scr_load_anim_t animType, uint32_t speed, uint32_t delay) {
+    FlowLockGuard lock;
     if (g_screenStackPosition == EEZ_LVGL_SCREEN_STACK_SIZE) {
         for (unsigned i = 1; i < EEZ_LVGL_SCREEN_STACK_SIZE; i++) {
             g_screenStack[i - 1] = g_screenStack[i];
@@ -7805,6 +9137,7 @@ extern "C" void eez_flow_push_screen(int16_t screenId, lv_scr_load_anim_t animTy
     eez::flow::replacePageHook(screenId, animType, speed, delay);
 }
 extern "C" void eez_flow_pop_screen(lv_scr_load_anim_t animType, uint32_t speed, uint32_t delay) {
+    FlowLockGuard lock;
     if (g_screenStackPosition > 0) {
         g_screenStackPosition--;
         eez::flow::replacePageHook(g_screenStack[g_screenStackPosition], animType, speed, delay);
@@ -7836,6 +9169,51 @@ void eez_flow_delete_screen_on_unload(int screenIndex) {
         (void*)(lv_uintptr_t)(screenIndex)
     );
 }
+// EARS: the assets blob is used in place when uncompressed (it is already in mapped
+// flash) and decompressed once into PSRAM when built with LZ4. With
+// EEZ_FLOW_ASSETS_FROM_PACK the blob is taken from the asset partition entry written
+// by scripts/build_asset_pack.py, which must be rebuilt with every UI change.
+// The load time of whichever path ran is kept for the boot report.
+#if !defined(EEZ_FLOW_ASSETS_FROM_PACK)
+#define EEZ_FLOW_ASSETS_FROM_PACK 0
+#endif
+#if !defined(EEZ_FLOW_ASSETS_PACK_ENTRY)
+#define EEZ_FLOW_ASSETS_PACK_ENTRY "eez_assets"
+#endif
+#if EEZ_FLOW_ASSETS_FROM_PACK
+#include "MAIN_assetPackLib.h"
+#endif
+static uint32_t g_assetsLoadTimeUs;
+static uint8_t g_assetsSource;
+static const uint8_t *selectAssets(const uint8_t *assets, uint32_t &assetsSize) {
+    g_assetsSource = EEZ_FLOW_ASSETS_SOURCE_EMBEDDED;
+#if EEZ_FLOW_ASSETS_FROM_PACK
+    uint32_t packedSize = 0;
+    const uint8_t *packed = MAIN_asset_pack_find(EEZ_FLOW_ASSETS_PACK_ENTRY, &packedSize);
+    if (packed && packedSize >= sizeof(eez::Header)) {
+        auto tag = ((const eez::Header *)packed)->tag;
+        if (tag == eez::HEADER_TAG || tag == eez::HEADER_TAG_COMPRESSED) {
+            g_assetsSource = EEZ_FLOW_ASSETS_SOURCE_PACK;
+            assetsSize = packedSize;
+            return packed;
+        }
+    }
+#else
+    EEZ_UNUSED(assetsSize);
+#endif
+    return assets;
+}
+extern "C" void eez_flow_get_assets_load_info(uint32_t *loadTimeUs, uint8_t *source, bool *decompressed) {
+    if (loadTimeUs) {
+        *loadTimeUs = g_assetsLoadTimeUs;
+    }
+    if (source) {
+        *source = g_assetsSource;
+    }
+    if (decompressed) {
+        *decompressed = eez::g_mainAssetsAreMutable;
+    }
+}
 extern "C" void eez_flow_init(const uint8_t *assets, uint32_t assetsSize, lv_obj_t **objects, size_t numObjects, const ext_img_desc_t *images, size_t numImages, ActionExecFunc *actions) {
     g_objects = objects;
     g_numObjects = numObjects;
@@ -7843,7 +9221,10 @@ extern "C" void eez_flow_init(const uint8_t *assets, uint32_t assetsSize, lv_obj
     g_numImages = numImages;
     g_actions = actions;
     eez::initAssetsMemory();
+    assets = selectAssets(assets, assetsSize);
+    uint32_t loadStartTime = eez::micros();
     eez::loadMainAssets(assets, assetsSize);
+    g_assetsLoadTimeUs = eez::micros() - loadStartTime;
     eez::initOtherMemory();
     eez::initAllocHeap(eez::ALLOC_BUFFER, eez::ALLOC_BUFFER_SIZE);
     eez::flow::replacePageHook = replacePageHook;
@@ -7889,11 +9270,46 @@ void eez_flow_init_style_names(const char **styleNames, size_t numStyles) {
     g_numStyles = numStyles;
 }
 extern "C" void eez_flow_tick() {
+    // EARS: with the flow worker task running, ui_tick leaves the flow to it
+    if (MAIN_flow_task_is_running() && !MAIN_flow_task_is_current()) {
+        return;
+    }
+    // EARS: paused while the lock screen covers the UI, flow state kept
+    if (MAIN_flow_is_paused()) {
+        return;
+    }
+    // EARS: cycle counts with -D EARS_PROFILE=1
+    EARS_PROFILE_ZONE("flow tick");
+#if defined(EEZ_MQTT_ADAPTER)
+    // EARS: queued MQTT events enter the flow before its components run
+    MAIN_mqtt_dispatch(deliverMqttEvent);
+#endif
     eez::flow::tick();
 }
 extern "C" bool eez_flow_is_stopped() {
     return eez::flow::isFlowStopped();
 }
+// EARS: the profile is read under the flow lock, so it is not torn by a running tick
+extern "C" size_t eez_flow_profile_write(eez_flow_profile_writer_t write, void *ctx) {
+#if EEZ_FLOW_PROFILER
+    if (!MAIN_flow_lock(FLOW_LOCK_FOREVER)) {
+        return 0;
+    }
+    size_t length = eez::flow::writeProfileJson(write, ctx);
+    MAIN_flow_unlock();
+    return length;
+#else
+    (void)write;
+    (void)ctx;
+    return 0;
+#endif
+}
+extern "C" void eez_flow_profile_reset() {
+    if (MAIN_flow_lock(FLOW_LOCK_FOREVER)) {
+        eez::flow::resetProfile();
+        MAIN_flow_unlock();
+    }
+}
 namespace eez {
 ActionExecFunc g_actionExecFunctions[] = { 0 };
 }
@@ -7906,21 +9322,26 @@ void replacePageHook(int16_t pageId, uint32_t animType, uint32_t speed, uint32_t
     }
     eez::flow::onPageChanged(g_currentScreen + 1, pageId);
     g_currentScreen = screenIndex;
-    lv_scr_load_anim(screen, (lv_scr_load_anim_t)animType, speed, delay, false);
+    // EARS: animated from snapshots of both screens (MAIN_transitionLib)
+    MAIN_transition_load(screen, (lv_screen_load_anim_t)animType, speed, delay);
 }
 extern "C" void flowOnPageLoaded(unsigned pageIndex) {
     eez::flow::getPageFlowState(eez::g_mainAssets, pageIndex);
 }
 extern "C" void flowPropagateValue(void *flowState, unsigned componentIndex, unsigned outputIndex) {
+    FlowLockGuard lock;
     eez::flow::propagateValue((eez::flow::FlowState *)flowState, componentIndex, outputIndex);
 }
 extern "C" void flowPropagateValueInt32(void *flowState, unsigned componentIndex, unsigned outputIndex, int32_t value) {
+    FlowLockGuard lock;
     eez::flow::propagateValue((eez::flow::FlowState *)flowState, componentIndex, outputIndex, eez::Value((int)value, eez::VALUE_TYPE_INT32));
 }
 extern "C" void flowPropagateValueUint32(void *flowState, unsigned componentIndex, unsigned outputIndex, uint32_t value) {
+    FlowLockGuard lock;
     eez::flow::propagateValue((eez::flow::FlowState *)flowState, componentIndex, outputIndex, eez::Value(value, eez::VALUE_TYPE_UINT32));
 }
 extern "C" void flowPropagateValueLVGLEvent(void *flowState, unsigned componentIndex, unsigned outputIndex, lv_event_t *event) {
+    FlowLockGuard lock;
     lv_event_code_t event_code = lv_event_get_code(event);
     uint32_t code = (uint32_t)event_code;
     void *currentTarget = (void *)lv_event_get_current_target(event);
@@ -8052,6 +9473,7 @@ const char *_evalStringArrayPropertyAndJoin(void *flowState, unsigned componentI
     return "";
 }
 extern "C" void _assignStringProperty(void *flowState, unsigned componentIndex, unsigned propertyIndex, const char *value, const char *errorMessage, const char *file, int line) {
+    FlowLockGuard lock;
     auto component = ((eez::flow::FlowState *)flowState)->flow->components[componentIndex];
     eez::Value dstValue;
     if (!eez::flow::evalAssignableExpression((eez::flow::FlowState *)flowState, componentIndex, component->properties[propertyIndex]->evalInstructions, dstValue, eez::flow::FlowError::Plain(errorMessage, file, line))) {
@@ -8061,6 +9483,7 @@ extern "C" void _assignStringProperty(void *flowState, unsigned componentIndex,
     eez::flow::assignValue((eez::flow::FlowState *)flowState, componentIndex, dstValue, srcValue);
 }
 extern "C" void _assignIntegerProperty(void *flowState, unsigned componentIndex, unsigned propertyIndex, int32_t value, const char *errorMessage, const char *file, int line) {
+    FlowLockGuard lock;
     auto component = ((eez::flow::FlowState *)flowState)->flow->components[componentIndex];
     eez::Value dstValue;
     if (!eez::flow::evalAssignableExpression((eez::flow::FlowState *)flowState, componentIndex, component->properties[propertyIndex]->evalInstructions, dstValue, eez::flow::FlowError::Plain(errorMessage, file, line))) {
@@ -8070,6 +9493,7 @@ extern "C" void _assignIntegerProperty(void *flowState, unsigned componentIndex,
     eez::flow::assignValue((eez::flow::FlowState *)flowState, componentIndex, dstValue, srcValue);
 }
 extern "C" void _assignBooleanProperty(void *flowState, unsigned componentIndex, unsigned propertyIndex, bool value, const char *errorMessage, const char *file, int line) {
+    FlowLockGuard lock;
     auto component = ((eez::flow::FlowState *)flowState)->flow->components[componentIndex];
     eez::Value dstValue;
     if (!eez::flow::evalAssignableExpression((eez::flow::FlowState *)flowState, componentIndex, component->properties[propertyIndex]->evalInstructions, dstValue, eez::flow::FlowError::Plain(errorMessage, file, line))) {
@@ -9939,7 +11363,7 @@ static void do_OPERATION_TYPE_ARRAY_LENGTH(EvalStack &stack) {
         stack.push(Value(blobRef->len, VALUE_TYPE_UINT32));
         return;
     }
-#if defined(EEZ_DASHBOARD_API)
+#if defined(EEZ_DASHBOARD_API) || defined(EEZ_FOR_LVGL)
     if (a.isJson()) {
         int length = operationJsonArrayLength(a.getInt());
         if (length >= 0) {
@@ -10230,7 +11654,7 @@ static void do_OPERATION_TYPE_BLOB_TO_STRING(EvalStack &stack) {
 #endif
 }
 static void do_OPERATION_TYPE_JSON_GET(EvalStack &stack) {
-#if defined(EEZ_DASHBOARD_API)
+#if defined(EEZ_DASHBOARD_API) || defined(EEZ_FOR_LVGL)
     auto jsonValue = stack.pop().getValue();
     auto propertyValue = stack.pop();
     if (jsonValue.isError()) {
@@ -10251,7 +11675,7 @@ static void do_OPERATION_TYPE_JSON_GET(EvalStack &stack) {
 #endif
 }
 static void do_OPERATION_TYPE_JSON_CLONE(EvalStack &stack) {
-#if defined(EEZ_DASHBOARD_API)
+#if defined(EEZ_DASHBOARD_API) || defined(EEZ_FOR_LVGL)
     auto jsonValue = stack.pop().getValue();
     if (jsonValue.isError()) {
         stack.push(jsonValue);
@@ -10261,7 +11685,12 @@ static void do_OPERATION_TYPE_JSON_CLONE(EvalStack &stack) {
         stack.push(Value::makeError());
         return;
     }
+#if defined(EEZ_FOR_LVGL)
+    // EARS: read-only, so the clone can share the tape
+    stack.push(jsonValue);
+#else
     stack.push(operationJsonClone(jsonValue.getInt()));
+#endif
 #else
     stack.push(Value::makeError());
 #endif
@@ -10449,6 +11878,51 @@ EvalOperation g_evalOperations[] = {
     do_OPERATION_TYPE_BLOB_TO_STRING,
     do_OPERATION_TYPE_FLOW_THEMES,
 };
+// EARS: operations whose result depends on more than their operands, or that return
+// a fresh mutable array; properties using them are never cached
+static const EvalOperation g_impureOperations[] = {
+    do_OPERATION_TYPE_SYSTEM_GET_TICK,
+    do_OPERATION_TYPE_FLOW_INDEX,
+    do_OPERATION_TYPE_FLOW_IS_PAGE_ACTIVE,
+    do_OPERATION_TYPE_FLOW_PAGE_TIMELINE_POSITION,
+    do_OPERATION_TYPE_FLOW_MAKE_ARRAY_VALUE,
+    do_OPERATION_TYPE_FLOW_LANGUAGES,
+    do_OPERATION_TYPE_FLOW_TRANSLATE,
+    do_OPERATION_TYPE_DATE_NOW,
+    do_OPERATION_TYPE_DATE_TO_LOCALE_STRING,
+    do_OPERATION_TYPE_STRING_SPLIT,
+    do_OPERATION_TYPE_ARRAY_SLICE,
+    do_OPERATION_TYPE_ARRAY_ALLOCATE,
+    do_OPERATION_TYPE_ARRAY_APPEND,
+    do_OPERATION_TYPE_ARRAY_INSERT,
+    do_OPERATION_TYPE_ARRAY_REMOVE,
+    do_OPERATION_TYPE_ARRAY_CLONE,
+    do_OPERATION_TYPE_LVGL_METER_TICK_INDEX,
+    do_OPERATION_TYPE_FLOW_GET_BITMAP_INDEX,
+    do_OPERATION_TYPE_BLOB_ALLOCATE,
+    do_OPERATION_TYPE_JSON_GET,
+    do_OPERATION_TYPE_JSON_CLONE,
+    do_OPERATION_TYPE_FLOW_GET_BITMAP_AS_DATA_URL,
+    do_OPERATION_TYPE_EVENT_GET_CODE,
+    do_OPERATION_TYPE_EVENT_GET_CURRENT_TARGET,
+    do_OPERATION_TYPE_EVENT_GET_TARGET,
+    do_OPERATION_TYPE_EVENT_GET_USER_DATA,
+    do_OPERATION_TYPE_EVENT_GET_KEY,
+    do_OPERATION_TYPE_EVENT_GET_GESTURE_DIR,
+    do_OPERATION_TYPE_EVENT_GET_ROTARY_DIFF,
+    do_OPERATION_TYPE_FLOW_THEMES,
+};
+bool isPureOperation(uint16_t operationIndex) {
+    if (operationIndex >= sizeof(g_evalOperations) / sizeof(g_evalOperations[0])) {
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(g_impureOperations) / sizeof(g_impureOperations[0]); i++) {
+        if (g_evalOperations[operationIndex] == g_impureOperations[i]) {
+            return false;
+        }
+    }
+    return true;
+}
 } 
 } 
 // -----------------------------------------------------------------------------
@@ -10485,6 +11959,7 @@ void initGlobalVariables(Assets *assets) {
         (numVars > 0 ? numVars - 1 : 0) * sizeof(Value),
         0xcc34ca8e
     );
+    g_globalVariables->count = numVars;
     for (uint32_t i = 0; i < numVars; i++) {
 		new (g_globalVariables->values + i) Value();
         g_globalVariables->values[i] = flowDefinition->globalVariables[i]->clone();
@@ -10825,6 +12300,7 @@ void assignValue(FlowState *flowState, int componentIndex, Value &dstValue, cons
         uint32_t dstValueType = VALUE_TYPE_UNDEFINED;
         if (dstValue.getType() == VALUE_TYPE_ARRAY_ELEMENT_VALUE) {
             auto arrayElementValue = (ArrayElementValue *)dstValue.refValue;
+            invalidateExpressionCache();
             if (arrayElementValue->arrayValue.isBlob()) {
                 auto blobRef = arrayElementValue->arrayValue.getBlob();
                 if (arrayElementValue->elementIndex < 0 || arrayElementValue->elementIndex >= (int)blobRef->len) {
@@ -11147,6 +12623,9 @@ static struct {
 	FlowState *flowState;
 	unsigned componentIndex;
     bool continuousTask;
+#if EEZ_FLOW_PROFILER
+    uint32_t queuedUs;
+#endif
 } g_queue[QUEUE_SIZE];
 static unsigned g_queueHead;
 static unsigned g_queueTail;
@@ -11183,6 +12662,9 @@ bool addToQueue(FlowState *flowState, unsigned componentIndex, int sourceCompone
 	g_queue[g_queueTail].flowState = flowState;
 	g_queue[g_queueTail].componentIndex = componentIndex;
     g_queue[g_queueTail].continuousTask = continuousTask;
+#if EEZ_FLOW_PROFILER
+    g_queue[g_queueTail].queuedUs = micros();
+#endif
 	g_queueTail = (g_queueTail + 1) % QUEUE_SIZE;
 	if (g_queueHead == g_queueTail) {
 		g_queueIsFull = true;
@@ -11205,6 +12687,11 @@ bool peekNextTaskFromQueue(FlowState *&flowState, unsigned &componentIndex, bool
     continuousTask = g_queue[g_queueHead].continuousTask;
 	return true;
 }
+#if EEZ_FLOW_PROFILER
+uint32_t getNextTaskQueueWaitUs() {
+	return micros() - g_queue[g_queueHead].queuedUs;
+}
+#endif
 void removeNextTaskFromQueue() {
 	auto flowState = g_queue[g_queueHead].flowState;
     decRefCounterForFlowState(flowState);
@@ -219,6 +219,7 @@ Unit getSmallestUnit(Unit unit, float min, float precision);
     VALUE_TYPE(JSON_MEMBER_VALUE)                   \
     VALUE_TYPE(EVENT)                               \
     VALUE_TYPE(PROPERTY_REF)                        \
+    VALUE_TYPE(STRING_INLINE)                       \
     CUSTOM_VALUE_TYPES
 namespace eez {
 #define VALUE_TYPE(NAME) VALUE_TYPE_##NAME,
@@ -961,7 +962,17 @@ namespace flow {
     extern void dashboardObjectValueIncRef(int json);
     extern void dashboardObjectValueDecRef(int json);
 }
+#elif defined(EEZ_FOR_LVGL)
+// EARS: a JSON value is a node of a tape over the string it was made from (MAIN_jsonTapeLib);
+// the string and its tape are kept while any value refers to them
+namespace flow {
+    extern void jsonTapeIncRef(int json);
+    extern void jsonTapeDecRef(int json);
+}
 #endif
+// EARS: strings shorter than EEZ_VALUE_INLINE_STRING_SIZE are kept inside the Value
+// (VALUE_TYPE_STRING_INLINE) instead of in a StringRef on the heap
+#define EEZ_VALUE_INLINE_STRING_SIZE 8
 struct Value {
   public:
     Value()
@@ -1076,6 +1087,10 @@ struct Value {
         if (type == VALUE_TYPE_JSON || type == VALUE_TYPE_STREAM) {
             flow::dashboardObjectValueDecRef(int32Value);
         }
+#elif defined(EEZ_FOR_LVGL)
+        if (type == VALUE_TYPE_JSON) {
+            flow::jsonTapeDecRef(int32Value);
+        }
 #endif
     }
     Value& operator = (const Value &value) {
@@ -1109,6 +1124,10 @@ struct Value {
             if (type == VALUE_TYPE_JSON || type == VALUE_TYPE_STREAM) {
                 flow::dashboardObjectValueIncRef(value.int32Value);;
             }
+#elif defined(EEZ_FOR_LVGL)
+            if (type == VALUE_TYPE_JSON) {
+                flow::jsonTapeIncRef(value.int32Value);
+            }
 #endif
         }
         return *this;
@@ -1157,7 +1176,7 @@ struct Value {
 		return type == VALUE_TYPE_BOOLEAN;
 	}
 	bool isString() const {
-        return type == VALUE_TYPE_STRING || type == VALUE_TYPE_STRING_ASSET || type == VALUE_TYPE_STRING_REF;
+        return type == VALUE_TYPE_STRING || type == VALUE_TYPE_STRING_ASSET || type == VALUE_TYPE_STRING_REF || type == VALUE_TYPE_STRING_INLINE;
     }
     bool isArray() const {
         return type == VALUE_TYPE_ARRAY || type == VALUE_TYPE_ARRAY_ASSET || type == VALUE_TYPE_ARRAY_REF;
@@ -1287,6 +1306,7 @@ struct Value {
 	Value toString(uint32_t id) const;
 	static Value makeStringRef(const char *str, int len, uint32_t id);
 	static Value concatenateString(const Value &str1, const Value &str2);
+    static void freeInternedStrings();
     static Value makeArrayRef(int arraySize, int arrayType, uint32_t id);
     static Value makeArrayElementRef(Value arrayValue, int elementIndex, uint32_t id);
     static Value makeJsonMemberRef(Value jsonValue, Value propertyName, uint32_t id);
@@ -1329,6 +1349,7 @@ struct Value {
 		PairOfUint8Value pairOfUint8Value;
 		PairOfUint16Value pairOfUint16Value;
 		PairOfInt16Value pairOfInt16Value;
+		char strInlineValue[EEZ_VALUE_INLINE_STRING_SIZE];
 	};
 };
 struct StringRef : public Ref {
@@ -1397,6 +1418,14 @@ namespace flow {
     extern Value operationJsonGet(int json, const char *property);
     extern Value getObjectVariableMemberValue(Value *objectValue, int memberIndex);
 }
+#elif defined(EEZ_FOR_LVGL)
+namespace flow {
+    extern Value operationJsonGet(int json, const char *property);
+    extern int operationJsonArrayLength(int json);
+    extern Value convertToJson(const Value *value);
+    extern Value convertFromJson(int json, uint32_t toType);
+    extern void jsonTapeToText(int json, char *text, int count);
+}
 #endif
 inline Value Value::getValue() const {
     if (type == VALUE_TYPE_VALUE_PTR) {
@@ -1431,7 +1460,7 @@ inline Value Value::getValue() const {
             return array->values[arrayElementValue->elementIndex];
         }
     }
-#if defined(EEZ_DASHBOARD_API)
+#if defined(EEZ_DASHBOARD_API) || defined(EEZ_FOR_LVGL)
     else if (type == VALUE_TYPE_JSON_MEMBER_VALUE) {
         auto jsonMemberValue = (JsonMemberValue *)refValue;
         return flow::operationJsonGet(jsonMemberValue->jsonValue.getInt(), jsonMemberValue->propertyName.getString());
@@ -2034,6 +2063,7 @@ enum TestResult {
 	TEST_WARNING
 };
 uint32_t millis();
+uint32_t micros();
 #if EEZ_OPTION_THREADS
 extern bool g_shutdown;
 #endif
@@ -2621,6 +2651,16 @@ bool evalProperty(FlowState *flowState, int componentIndex, int propertyIndex, V
 bool evalProperty(FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const FlowError &errorMessage, int *numInstructionBytes = nullptr, const int32_t *iterators = nullptr);
 #endif
 bool evalAssignableProperty(FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const FlowError &errorMessage, int *numInstructionBytes = nullptr, const int32_t *iterators = nullptr);
+void initExpressionCache(Assets *assets);
+void freeExpressionCache();
+void onGlobalVariableChanged(uint32_t globalVariableIndex);
+void onNativeVariableChanged(int16_t nativeVariableId);
+void invalidateExpressionCache();
+bool isExpressionCacheChanged(uint64_t deps, uint32_t stamp);
+uint32_t getExpressionCacheClock();
+uint32_t getExpressionCacheEpoch();
+void beginExpressionCapture();
+bool endExpressionCapture(uint64_t &deps);
 } 
 } 
 // -----------------------------------------------------------------------------
@@ -2640,6 +2680,29 @@ void tick();
 void stop(Assets* assets = nullptr);
 bool isFlowStopped();
 unsigned getTickMaxDurationCounter();
+struct ComponentExecutionStats {
+    uint16_t componentType;
+    uint16_t slowestFlowIndex;
+    uint16_t slowestComponentIndex;
+    uint32_t count;
+    uint32_t totalUs;
+    uint32_t maxUs;
+};
+void getTickDurationStats(uint32_t &lastTickDurationUs, uint32_t &maxTickDurationUs);
+unsigned getComponentExecutionStats(ComponentExecutionStats *stats, unsigned maxStats);
+void resetComponentExecutionStats();
+// EARS: per-component profile of the main assets, by flow and component index
+#if !defined(EEZ_FLOW_PROFILER)
+#define EEZ_FLOW_PROFILER 0
+#endif
+struct ComponentProfile {
+    uint32_t count;
+    uint32_t totalUs;
+    uint32_t maxUs;
+    uint32_t waitUs;
+};
+const ComponentProfile *getComponentProfile(unsigned flowIndex, unsigned componentIndex);
+void resetProfile();
 #if EEZ_OPTION_GUI
 FlowState *getPageFlowState(Assets *assets, int16_t pageIndex, const WidgetCursor &widgetCursor);
 #else
@@ -2718,6 +2781,7 @@ namespace eez {
 namespace flow {
 typedef void (*EvalOperation)(EvalStack &);
 extern EvalOperation g_evalOperations[];
+bool isPureOperation(uint16_t operationIndex);
 Value op_add(const Value& a1, const Value& b1);
 Value op_sub(const Value& a1, const Value& b1);
 Value op_mul(const Value& a1, const Value& b1);
@@ -2749,6 +2813,9 @@ bool addToQueue(FlowState *flowState, unsigned componentIndex,
     int sourceComponentIndex, int sourceOutputIndex, int targetInputIndex,
     bool continuousTask);
 bool peekNextTaskFromQueue(FlowState *&flowState, unsigned &componentIndex, bool &continuousTask);
+#if EEZ_FLOW_PROFILER
+uint32_t getNextTaskQueueWaitUs();
+#endif
 void removeNextTaskFromQueue();
 bool isInQueue(FlowState *flowState, unsigned componentIndex);
 void removeTasksFromQueueForFlowState(FlowState *flowState);
@@ -2977,6 +3044,9 @@ struct SortArrayActionComponent : public Component {
     uint32_t flags;
 };
 void sortArray(SortArrayActionComponent *component, ArrayValue *array);
+// EARS: binary search of an array sorted by sortArray with the same struct field
+// (-1 for a plain array) and SORT_ARRAY_FLAG_* flags; element index or -1
+int32_t sortedArrayFind(const ArrayValue *array, int32_t structFieldIndex, uint32_t flags, const Value &key);
 } 
 } 
 // -----------------------------------------------------------------------------
@@ -3044,6 +3114,12 @@ typedef struct _ext_img_desc_t {
 #endif
 typedef void (*ActionExecFunc)(lv_event_t * e);
 void eez_flow_init(const uint8_t *assets, uint32_t assetsSize, lv_obj_t **objects, size_t numObjects, const ext_img_desc_t *images, size_t numImages, ActionExecFunc *actions);
+#define EEZ_FLOW_ASSETS_SOURCE_EMBEDDED 0
+#define EEZ_FLOW_ASSETS_SOURCE_PACK 1
+void eez_flow_get_assets_load_info(uint32_t *loadTimeUs, uint8_t *source, bool *decompressed);
+typedef void (*eez_flow_profile_writer_t)(const char *text, size_t length, void *ctx);
+size_t eez_flow_profile_write(eez_flow_profile_writer_t write, void *ctx);
+void eez_flow_profile_reset();
 void eez_flow_init_styles(
     void (*add_style)(lv_obj_t *obj, int32_t styleIndex),
     void (*remove_style)(lv_obj_t *obj, int32_t styleIndex)
@@ -3057,6 +3133,8 @@ void eez_flow_init_themes(const char **themeNames, size_t numThemes, void (*chan
 void eez_flow_set_create_screen_func(void (*createScreenFunc)(int screenIndex));
 void eez_flow_set_delete_screen_func(void (*deleteScreenFunc)(int screenIndex));
 void eez_flow_tick();
+void eez_flow_tick_screen(int screenIndex);
+void eez_flow_native_var_changed(int16_t nativeVariableId);
 bool eez_flow_is_stopped();
 extern int16_t g_currentScreen;
 int16_t eez_flow_get_current_screen();
@@ -7,6 +7,8 @@
 #include "vars.h"
 #include "styles.h"
 #include "ui.h"
+#include "MAIN_marqueeLib.h"
+#include "MAIN_uiTxnLib.h"
 
 #include <string.h>
 
@@ -26,19 +28,27 @@ void create_screen_screen_start() {
         lv_obj_t *parent_obj = obj;
         {
             // Label_Trash_0
-            lv_obj_t *obj = lv_label_create(parent_obj);
+            // EARS: a marquee (MAIN_marqueeLib) scrolls a strip rendered once, in place of
+            // an LV_LABEL_LONG_SCROLL_CIRCULAR label re-rendered on every step
+            lv_obj_t *obj = MAIN_marquee_create(parent_obj);
             objects.label_trash_0 = obj;
             lv_obj_set_pos(obj, 121, 152);
             lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-            lv_label_set_long_mode(obj, LV_LABEL_LONG_SCROLL_CIRCULAR);
             lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICK_FOCUSABLE|LV_OBJ_FLAG_GESTURE_BUBBLE|LV_OBJ_FLAG_PRESS_LOCK|LV_OBJ_FLAG_SCROLLABLE|LV_OBJ_FLAG_SCROLL_CHAIN_HOR|LV_OBJ_FLAG_SCROLL_CHAIN_VER|LV_OBJ_FLAG_SCROLL_ELASTIC|LV_OBJ_FLAG_SCROLL_MOMENTUM|LV_OBJ_FLAG_SCROLL_WITH_ARROW|LV_OBJ_FLAG_SNAPPABLE);
-            lv_label_set_text(obj, "This screen should never appear.");
+            MAIN_marquee_set_text(obj, "This screen should never appear.");
         }
     }
     
     tick_screen_screen_start();
 }
 
+void delete_screen_screen_start() {
+    lv_obj_delete(objects.screen_start);
+    objects.screen_start = 0;
+    objects.label_trash_0 = 0;
+    deletePageFlowState(0);
+}
+
 void tick_screen_screen_start() {
     void *flowState = getFlowState(0, 0);
     (void)flowState;
@@ -68,6 +78,13 @@ void create_screen_screen_config() {
     tick_screen_screen_config();
 }
 
+void delete_screen_screen_config() {
+    lv_obj_delete(objects.screen_config);
+    objects.screen_config = 0;
+    objects.label_trash_1 = 0;
+    deletePageFlowState(1);
+}
+
 void tick_screen_screen_config() {
     void *flowState = getFlowState(0, 1);
     (void)flowState;
@@ -97,6 +114,13 @@ void create_screen_screen_main() {
     tick_screen_screen_main();
 }
 
+void delete_screen_screen_main() {
+    lv_obj_delete(objects.screen_main);
+    objects.screen_main = 0;
+    objects.label_trash_2 = 0;
+    deletePageFlowState(2);
+}
+
 void tick_screen_screen_main() {
     void *flowState = getFlowState(0, 2);
     (void)flowState;
@@ -124,6 +148,36 @@ void tick_screen_by_id(enum ScreensEnum screenId) {
     tick_screen_funcs[screenId - 1]();
 }
 
+typedef void (*create_screen_func_t)();
+create_screen_func_t create_screen_funcs[] = {
+    create_screen_screen_start,
+    create_screen_screen_config,
+    create_screen_screen_main,
+};
+// EARS: a screen's widgets are built in one UI transaction (MAIN_uiTxnLib), so
+// they cost one layout and one invalidation of the screen, not one per property
+void create_screen(int screen_index) {
+    MAIN_ui_txn_begin();
+    create_screen_funcs[screen_index]();
+    MAIN_ui_txn_commit(((lv_obj_t **)&objects)[screen_index]);
+}
+void create_screen_by_id(enum ScreensEnum screenId) {
+    create_screen(screenId - 1);
+}
+
+typedef void (*delete_screen_func_t)();
+delete_screen_func_t delete_screen_funcs[] = {
+    delete_screen_screen_start,
+    delete_screen_screen_config,
+    delete_screen_screen_main,
+};
+void delete_screen(int screen_index) {
+    delete_screen_funcs[screen_index]();
+}
+void delete_screen_by_id(enum ScreensEnum screenId) {
+    delete_screen_funcs[screenId - 1]();
+}
+
 void create_screens() {
     eez_flow_init_styles(add_style, remove_style);
     
@@ -131,11 +185,10 @@ void create_screens() {
     eez_flow_init_object_names(object_names, sizeof(object_names) / sizeof(const char *));
     eez_flow_init_style_names(style_names, sizeof(style_names) / sizeof(const char *));
     
+    eez_flow_set_create_screen_func(create_screen);
+    eez_flow_set_delete_screen_func(delete_screen);
+    
     lv_disp_t *dispp = lv_disp_get_default();
     lv_theme_t *theme = lv_theme_default_init(dispp, lv_palette_main(LV_PALETTE_BLUE), lv_palette_main(LV_PALETTE_RED), false, LV_FONT_DEFAULT);
     lv_disp_set_theme(dispp, theme);
-    
-    create_screen_screen_start();
-    create_screen_screen_config();
-    create_screen_screen_main();
 }
@@ -25,17 +25,26 @@ enum ScreensEnum {
 };
 
 void create_screen_screen_start();
+void delete_screen_screen_start();
 void tick_screen_screen_start();
 
 void create_screen_screen_config();
+void delete_screen_screen_config();
 void tick_screen_screen_config();
 
 void create_screen_screen_main();
+void delete_screen_screen_main();
 void tick_screen_screen_main();
 
 void tick_screen_by_id(enum ScreensEnum screenId);
 void tick_screen(int screen_index);
 
+void create_screen_by_id(enum ScreensEnum screenId);
+void create_screen(int screen_index);
+
+void delete_screen_by_id(enum ScreensEnum screenId);
+void delete_screen(int screen_index);
+
 void create_screens();
 
 
@@ -0,0 +1,115 @@
+/**
+ * @file styles_const.c
+ * @brief EEZ Studio styles as constant LVGL styles
+ * @details Written by scripts/generate_const_styles.py before every build
+ *          from styles.c, which EEZ Studio exports and the build leaves out;
+ *          edit the styles in EEZ Studio, not this file. Property lists and
+ *          styles live in flash (LV_STYLE_CONST_INIT), so no style takes
+ *          LVGL heap; a style with a value that is not a constant
+ *          expression is filled in on first use instead.
+ */
+#include "styles_const.h"
+#include "styles.h"
+#include "images.h"
+#include "fonts.h"
+
+#include "ui.h"
+#include "screens.h"
+
+//
+// Style: Light_Default_Screen
+//
+
+static const lv_style_const_prop_t style_light_default_screen_MAIN_DEFAULT_props[] = {
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x0a, 0x0b, 0x0b)),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0x9e, 0x9a, 0x75)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT(style_light_default_screen_MAIN_DEFAULT, style_light_default_screen_MAIN_DEFAULT_props);
+
+lv_style_t *get_style_light_default_screen_MAIN_DEFAULT() {
+    return (lv_style_t *)&style_light_default_screen_MAIN_DEFAULT;
+};
+
+void add_style_light_default_screen(lv_obj_t *obj) {
+    (void)obj;
+    lv_obj_add_style(obj, get_style_light_default_screen_MAIN_DEFAULT(), LV_PART_MAIN | LV_STATE_DEFAULT);
+};
+
+void remove_style_light_default_screen(lv_obj_t *obj) {
+    (void)obj;
+    lv_obj_remove_style(obj, get_style_light_default_screen_MAIN_DEFAULT(), LV_PART_MAIN | LV_STATE_DEFAULT);
+};
+
+//
+// Style: Dark_Default_Screen
+//
+
+static const lv_style_const_prop_t style_dark_default_screen_MAIN_DEFAULT_props[] = {
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x0a, 0x0b, 0x0b)),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xff, 0x6b, 0x6b)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT(style_dark_default_screen_MAIN_DEFAULT, style_dark_default_screen_MAIN_DEFAULT_props);
+
+lv_style_t *get_style_dark_default_screen_MAIN_DEFAULT() {
+    return (lv_style_t *)&style_dark_default_screen_MAIN_DEFAULT;
+};
+
+void add_style_dark_default_screen(lv_obj_t *obj) {
+    (void)obj;
+    lv_obj_add_style(obj, get_style_dark_default_screen_MAIN_DEFAULT(), LV_PART_MAIN | LV_STATE_DEFAULT);
+};
+
+void remove_style_dark_default_screen(lv_obj_t *obj) {
+    (void)obj;
+    lv_obj_remove_style(obj, get_style_dark_default_screen_MAIN_DEFAULT(), LV_PART_MAIN | LV_STATE_DEFAULT);
+};
+
+//
+//
+//
+
+void add_style(lv_obj_t *obj, int32_t styleIndex) {
+    typedef void (*AddStyleFunc)(lv_obj_t *obj);
+    static const AddStyleFunc add_style_funcs[] = {
+        add_style_light_default_screen,
+        add_style_dark_default_screen,
+    };
+    add_style_funcs[styleIndex](obj);
+}
+
+void remove_style(lv_obj_t *obj, int32_t styleIndex) {
+    typedef void (*RemoveStyleFunc)(lv_obj_t *obj);
+    static const RemoveStyleFunc remove_style_funcs[] = {
+        remove_style_light_default_screen,
+        remove_style_dark_default_screen,
+    };
+    remove_style_funcs[styleIndex](obj);
+}
+
+//
+// Theme variants
+//
+
+static const lv_style_t *const ui_styles_light[UI_STYLE_COUNT] = {
+    &style_light_default_screen_MAIN_DEFAULT,
+};
+
+static const lv_style_t *const ui_styles_dark[UI_STYLE_COUNT] = {
+    &style_dark_default_screen_MAIN_DEFAULT,
+};
+
+static const lv_style_t *const *const ui_style_themes[UI_STYLE_THEME_COUNT] = {
+    ui_styles_light,
+    ui_styles_dark,
+};
+
+const lv_style_t *ui_style_get(ui_style_theme_t theme, ui_style_id_t id) {
+    if (theme >= UI_STYLE_THEME_COUNT || id >= UI_STYLE_COUNT) {
+        return NULL;
+    }
+    return ui_style_themes[theme][id];
+}
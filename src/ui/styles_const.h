@@ -0,0 +1,40 @@
+/**
+ * @file styles_const.h
+ * @brief Theme variants of the constant EEZ styles
+ * @details Written by scripts/generate_const_styles.py before every build.
+ *          Styles named <Theme>_<Style> in EEZ Studio are listed per theme
+ *          in the same order, so switching theme swaps one table for another.
+ */
+#ifndef EEZ_LVGL_UI_STYLES_CONST_H
+#define EEZ_LVGL_UI_STYLES_CONST_H
+
+#include "styles.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+    UI_STYLE_THEME_LIGHT,
+    UI_STYLE_THEME_DARK,
+    UI_STYLE_THEME_COUNT
+} ui_style_theme_t;
+
+typedef enum
+{
+    UI_STYLE_DEFAULT_SCREEN_MAIN_DEFAULT,
+    UI_STYLE_COUNT
+} ui_style_id_t;
+
+/**
+ * @brief One style of a theme
+ * @return The constant style, NULL if the theme has no such style
+ */
+const lv_style_t *ui_style_get(ui_style_theme_t theme, ui_style_id_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*EEZ_LVGL_UI_STYLES_CONST_H*/
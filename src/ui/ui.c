@@ -7,6 +7,7 @@
 #include "images.h"
 #include "actions.h"
 #include "vars.h"
+#include "MAIN_transitionLib.h"
 
 // ASSETS DEFINITION
 const uint8_t assets[676] = {
@@ -73,7 +74,7 @@ void ui_init() {
 
 void ui_tick() {
     eez_flow_tick();
-    tick_screen(g_currentScreen);
+    eez_flow_tick_screen(g_currentScreen);
 }
 
 #else
@@ -89,8 +90,11 @@ static lv_obj_t *getLvglObjectFromIndex(int32_t index) {
 
 void loadScreen(enum ScreensEnum screenId) {
     currentScreen = screenId - 1;
+    if (!getLvglObjectFromIndex(currentScreen)) {
+        create_screen(currentScreen);
+    }
     lv_obj_t *screen = getLvglObjectFromIndex(currentScreen);
-    lv_scr_load_anim(screen, LV_SCR_LOAD_ANIM_FADE_IN, 200, 0, false);
+    MAIN_transition_load(screen, LV_SCR_LOAD_ANIM_FADE_IN, 200, 0);
 }
 
 void ui_init() {